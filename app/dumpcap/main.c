@@ -50,6 +50,7 @@
 #define MBUF_POOL_CACHE_SIZE 32
 #define BURST_SIZE 32
 #define SLEEP_THRESHOLD 1000
+#define DIRECT_IO_BUFFER (1024 * 1024)
 
 /* command line flags */
 static const char *progname;
@@ -57,6 +58,9 @@ static RTE_ATOMIC(bool) quit_signal;
 static bool group_read;
 static bool quiet;
 static bool use_pcapng = true;
+static bool zero_copy;
+static unsigned int write_buffer;
+static bool direct_io;
 static char *output_name;
 static const char *tmp_dir = "/tmp";
 static unsigned int ring_size = 2048;
@@ -74,10 +78,20 @@ static struct {
 	size_t size;		/* file size (bytes) */
 } stop;
 
+/* ring buffer options */
+static struct {
+	time_t duration;	/* seconds */
+	size_t size;		/* file size (bytes) */
+	unsigned int files;	/* number of files kept */
+} rotate;
+
 /* Running state */
 static time_t start_time;
 static uint64_t packets_received;
 static size_t file_size;
+static time_t file_start;
+static unsigned int file_count;
+static char **file_names;
 
 /* capture options */
 struct capture_options {
@@ -136,6 +150,10 @@ static void usage(void)
 	       "                            packets:NUM - stop after NUM packets\n"
 	       "Output (files):\n"
 	       "  -w <filename>            name of file to save (def: tempfile)\n"
+	       "  -b <ringbuffer opt.> ..., --ring-buffer <ringbuffer opt.>\n"
+	       "                           duration:NUM - switch to next file after NUM secs\n"
+	       "                           filesize:NUM - switch to next file after NUM kB\n"
+	       "                              files:NUM - ringbuffer: replace after NUM files\n"
 	       "  -g                       enable group read access on the output file(s)\n"
 	       "  -n                       use pcapng format instead of pcap (default)\n"
 	       "  -P                       use libpcap format instead of pcapng\n"
@@ -143,11 +161,14 @@ static void usage(void)
 	       "                           add a capture comment to the output file\n"
 	       "  --temp-dir <directory>   write temporary files to this directory\n"
 	       "                           (default: /tmp)\n"
+	       "  --write-buffer <size>    write the file by blocks of size kB\n"
+	       "  --direct-io              write the pcapng file bypassing the page cache\n"
 	       "\n"
 	       "Miscellaneous:\n"
 	       "  --lcore=<core>           CPU core to run on (default: any)\n"
 	       "  --file-prefix=<prefix>   prefix to use for multi-process\n"
 	       "  -q                       don't report packet capture counts\n"
+	       "  --zero-copy              reference packets instead of copying them\n"
 	       "  -v, --version            print version information and exit\n"
 	       "  -h, --help               display this help and exit\n"
 	       "\n"
@@ -211,6 +232,28 @@ static void auto_stop(char *opt)
 	}
 }
 
+/* Set ring buffer values */
+static void ring_buffer(char *opt)
+{
+	char *value;
+
+	value = strchr(opt, ':');
+	if (value == NULL)
+		rte_exit(EXIT_FAILURE,
+			 "Missing colon in ring buffer parameter\n");
+
+	*value++ = '\0';
+	if (strcmp(opt, "duration") == 0)
+		rotate.duration = get_uint(value, "duration", 0);
+	else if (strcmp(opt, "filesize") == 0)
+		rotate.size = get_uint(value, "filesize", 0) * 1024;
+	else if (strcmp(opt, "files") == 0)
+		rotate.files = get_uint(value, "files", 0);
+	else
+		rte_exit(EXIT_FAILURE,
+			 "Unknown ring buffer parameter \"%s\"\n", opt);
+}
+
 /* Add interface to list of interfaces to capture */
 static struct interface *add_interface(const char *name)
 {
@@ -341,6 +384,7 @@ static void parse_opts(int argc, char **argv)
 	static const struct option long_options[] = {
 		{ "autostop",        required_argument, NULL, 'a' },
 		{ "capture-comment", required_argument, NULL, 0 },
+		{ "direct-io",       no_argument,       NULL, 0 },
 		{ "file-prefix",     required_argument, NULL, 0 },
 		{ "help",            no_argument,       NULL, 'h' },
 		{ "ifdescr",	     required_argument, NULL, 0 },
@@ -354,6 +398,8 @@ static void parse_opts(int argc, char **argv)
 		{ "snapshot-length", required_argument, NULL, 's' },
 		{ "temp-dir",        required_argument, NULL, 0 },
 		{ "version",         no_argument,       NULL, 'v' },
+		{ "write-buffer",    required_argument, NULL, 0 },
+		{ "zero-copy",       no_argument,       NULL, 0 },
 		{ NULL },
 	};
 	int option_index, c;
@@ -379,6 +425,13 @@ static void parse_opts(int argc, char **argv)
 				file_prefix = optarg;
 			} else if (!strcmp(longopt, "temp-dir")) {
 				tmp_dir = optarg;
+			} else if (!strcmp(longopt, "zero-copy")) {
+				zero_copy = true;
+			} else if (!strcmp(longopt, "write-buffer")) {
+				write_buffer = get_uint(optarg, "write-buffer",
+							UINT32_MAX / 1024) * 1024;
+			} else if (!strcmp(longopt, "direct-io")) {
+				direct_io = true;
 			} else if (!strcmp(longopt, "ifdescr")) {
 				if (last_intf == NULL)
 					rte_exit(EXIT_FAILURE,
@@ -399,8 +452,7 @@ static void parse_opts(int argc, char **argv)
 			auto_stop(optarg);
 			break;
 		case 'b':
-			rte_exit(EXIT_FAILURE,
-				 "multiple files not implemented\n");
+			ring_buffer(optarg);
 			break;
 		case 'c':
 			stop.packets = get_uint(optarg, "packet_count", 0);
@@ -476,6 +528,23 @@ static void parse_opts(int argc, char **argv)
 			exit(1);
 		}
 	}
+
+	if (rotate.duration == 0 && rotate.size == 0) {
+		if (rotate.files != 0)
+			rte_exit(EXIT_FAILURE,
+				 "Ring buffer requires duration or filesize\n");
+	} else if (output_name != NULL && strcmp(output_name, "-") == 0) {
+		rte_exit(EXIT_FAILURE,
+			 "Ring buffer can not be used with standard output\n");
+	}
+
+	if (direct_io) {
+		if (!use_pcapng)
+			rte_exit(EXIT_FAILURE,
+				 "Direct I/O requires pcapng format\n");
+		if (write_buffer == 0)
+			write_buffer = DIRECT_IO_BUFFER;
+	}
 }
 
 static void
@@ -727,6 +796,13 @@ static struct rte_mempool *create_mempool(void)
 			data_size = mbuf_size;
 	}
 
+	/*
+	 * With zero copy, a pcapng packet uses an mbuf for its header,
+	 * one per segment and one for its options.
+	 */
+	if (zero_copy && use_pcapng)
+		num_mbufs *= 3;
+
 	mp = rte_pktmbuf_pool_create_by_ops(pool_name, num_mbufs,
 					    MBUF_POOL_CACHE_SIZE, 0,
 					    data_size,
@@ -758,27 +834,28 @@ static char *get_os_info(void)
 	return osname;
 }
 
-static dumpcap_out_t create_output(void)
+/* Make the name of the next output file */
+static const char *output_file_name(void)
 {
-	dumpcap_out_t ret;
 	static char tmp_path[PATH_MAX];
-	int fd;
+	static char path[PATH_MAX];
+	const char *slash, *dot;
+	struct tm *tm;
+	time_t now;
+	char ts[32];
+
+	now = time(NULL);
+	tm = localtime(&now);
+	if (!tm)
+		rte_panic("localtime failed\n");
+
+	strftime(ts, sizeof(ts), "%Y%m%d%H%M%S", tm);
 
 	/* If no filename specified make a tempfile name */
 	if (output_name == NULL) {
 		struct interface *intf;
-		struct tm *tm;
-		time_t now;
-		char ts[32];
 
 		intf = TAILQ_FIRST(&interfaces);
-		now = time(NULL);
-		tm = localtime(&now);
-		if (!tm)
-			rte_panic("localtime failed\n");
-
-		strftime(ts, sizeof(ts), "%Y%m%d%H%M%S", tm);
-
 		snprintf(tmp_path, sizeof(tmp_path),
 			 "%s/%s_%u_%s_%s.%s", tmp_dir,
 			 progname, intf->port, intf->name, ts,
@@ -786,24 +863,78 @@ static dumpcap_out_t create_output(void)
 		output_name = tmp_path;
 	}
 
-	if (strcmp(output_name, "-") == 0)
+	if (rotate.duration == 0 && rotate.size == 0)
+		return output_name;
+
+	/* Like Wireshark, insert file number and time before the suffix */
+	slash = strrchr(output_name, '/');
+	dot = strrchr(output_name, '.');
+	if (dot == NULL || (slash != NULL && dot < slash))
+		dot = output_name + strlen(output_name);
+
+	snprintf(path, sizeof(path), "%.*s_%05u_%s%s",
+		 (int)(dot - output_name), output_name, file_count + 1, ts, dot);
+	return path;
+}
+
+/* Remove the oldest file of the ring buffer */
+static void ring_buffer_add(const char *name)
+{
+	unsigned int slot;
+
+	if (rotate.files == 0)
+		return;
+
+	if (file_names == NULL) {
+		file_names = calloc(rotate.files, sizeof(char *));
+		if (file_names == NULL)
+			rte_exit(EXIT_FAILURE, "no memory for ring buffer\n");
+	}
+
+	slot = file_count % rotate.files;
+	if (file_names[slot] != NULL) {
+		unlink(file_names[slot]);
+		free(file_names[slot]);
+	}
+	file_names[slot] = strdup(name);
+}
+
+static dumpcap_out_t create_output(void)
+{
+	dumpcap_out_t ret;
+	const char *name;
+	int fd;
+
+	name = output_file_name();
+
+	if (strcmp(name, "-") == 0)
 		fd = STDOUT_FILENO;
 	else {
 		mode_t mode = group_read ? 0640 : 0600;
 
-		fprintf(stderr, "File: %s\n", output_name);
-		fd = open(output_name, O_WRONLY | O_CREAT, mode);
+		fprintf(stderr, "File: %s\n", name);
+		fd = open(name, O_WRONLY | O_CREAT, mode);
 		if (fd < 0)
 			rte_exit(EXIT_FAILURE, "Can not open \"%s\": %s\n",
-				 output_name, strerror(errno));
+				 name, strerror(errno));
+		ring_buffer_add(name);
 	}
 
+	file_count++;
+	file_start = time(NULL);
+	file_size = 0;
+
 	if (use_pcapng) {
 		struct interface *intf;
 		char *os = get_os_info();
 
-		ret.pcapng = rte_pcapng_fdopen(fd, os, NULL,
-					   version(), capture_comment);
+		if (write_buffer != 0)
+			ret.pcapng = rte_pcapng_fdopen_buffered(fd, write_buffer,
+					direct_io ? RTE_PCAPNG_F_DIRECT_IO : 0,
+					os, NULL, version(), capture_comment);
+		else
+			ret.pcapng = rte_pcapng_fdopen(fd, os, NULL,
+						   version(), capture_comment);
 		if (ret.pcapng == NULL)
 			rte_exit(EXIT_FAILURE, "pcapng_fdopen failed: %s\n",
 				 strerror(rte_errno));
@@ -818,6 +949,7 @@ static dumpcap_out_t create_output(void)
 		}
 	} else {
 		pcap_t *pcap;
+		FILE *f;
 
 		pcap = pcap_open_dead_with_tstamp_precision(DLT_EN10MB,
 							    capture.snap_len,
@@ -825,7 +957,11 @@ static dumpcap_out_t create_output(void)
 		if (pcap == NULL)
 			rte_exit(EXIT_FAILURE, "pcap_open_dead failed\n");
 
-		ret.dumper = pcap_dump_fopen(pcap, fdopen(fd, "w"));
+		f = fdopen(fd, "w");
+		if (f != NULL && write_buffer != 0)
+			setvbuf(f, NULL, _IOFBF, write_buffer);
+
+		ret.dumper = pcap_dump_fopen(pcap, f);
 		if (ret.dumper == NULL)
 			rte_exit(EXIT_FAILURE, "pcap_dump_fopen failed: %s\n",
 				 pcap_geterr(pcap));
@@ -834,6 +970,24 @@ static dumpcap_out_t create_output(void)
 	return ret;
 }
 
+static void close_output(dumpcap_out_t out)
+{
+	if (use_pcapng)
+		rte_pcapng_close(out.pcapng);
+	else
+		pcap_dump_close(out.dumper);
+}
+
+/* Switch to the next file of the ring buffer when it is time */
+static bool rotate_output(void)
+{
+	if (rotate.size != 0 && file_size >= rotate.size)
+		return true;
+
+	return rotate.duration != 0 &&
+		time(NULL) - file_start >= rotate.duration;
+}
+
 static void enable_pdump(struct rte_ring *r, struct rte_mempool *mp)
 {
 	struct interface *intf;
@@ -844,6 +998,8 @@ static void enable_pdump(struct rte_ring *r, struct rte_mempool *mp)
 	flags = RTE_PDUMP_FLAG_RXTX;
 	if (use_pcapng)
 		flags |= RTE_PDUMP_FLAG_PCAPNG;
+	if (zero_copy)
+		flags |= RTE_PDUMP_FLAG_ZEROCOPY;
 
 	TAILQ_FOREACH(intf, &interfaces, next) {
 		ret = rte_pdump_enable_bpf(intf->port, RTE_PDUMP_ALL_QUEUES,
@@ -1051,6 +1207,11 @@ int main(int argc, char **argv)
 		if (stop.size && file_size >= stop.size)
 			break;
 
+		if (rotate_output()) {
+			close_output(out);
+			out = create_output();
+		}
+
 		if (stop.packets && packets_received >= stop.packets)
 			break;
 
@@ -1064,10 +1225,7 @@ int main(int argc, char **argv)
 	if (rte_eal_primary_proc_alive(NULL))
 		report_packet_stats(out);
 
-	if (use_pcapng)
-		rte_pcapng_close(out.pcapng);
-	else
-		pcap_dump_close(out.dumper);
+	close_output(out);
 
 	/* If primary has exited, do not try and communicate with it */
 	if (!rte_eal_primary_proc_alive(NULL))
@@ -7,6 +7,7 @@
 
 #include <rte_graph.h>
 #include <rte_node_eth_api.h>
+#include <rte_stdatomic.h>
 
 #define ETHDEV_RX_LCORE_PARAMS_MAX 1024
 #define ETHDEV_RX_QUEUE_PER_LCORE_MAX 16
@@ -20,9 +21,12 @@ struct lcore_rx_queue {
 struct __rte_cache_aligned lcore_conf {
 	uint16_t n_rx_queue;
 	struct lcore_rx_queue rx_queue_list[ETHDEV_RX_QUEUE_PER_LCORE_MAX];
-	struct rte_graph *graph;
+	RTE_ATOMIC(struct rte_graph *) graph;
 	char name[RTE_GRAPH_NAMESIZE];
 	rte_graph_t graph_id;
+	/* graph created on reload, not yet walked by the worker */
+	struct rte_graph *next_graph;
+	rte_graph_t next_graph_id;
 };
 
 uint8_t ethdev_rx_num_rx_queues_get(uint16_t port);
@@ -14,6 +14,9 @@
 #include <rte_graph_worker.h>
 #include <rte_graph_feature_arc_worker.h>
 #include <rte_log.h>
+#include <rte_malloc.h>
+#include <rte_rcu_qsbr.h>
+#include <rte_stdatomic.h>
 
 #include "graph_priv.h"
 #include "module_api.h"
@@ -29,6 +32,11 @@ static const char * const supported_usecases[] = {"l3fwd", "l2fwd"};
 struct graph_config graph_config;
 bool graph_started;
 
+/* Workers report a quiescent state after each walk of their graph */
+static struct rte_rcu_qsbr *graph_qsv;
+/* Incremented on each reload, to name the graphs of the new version */
+static uint32_t graph_version;
+
 /* Check the link rc of all ports in up to 9s, and print them finally */
 static void
 check_all_ports_link_status(uint32_t port_mask)
@@ -258,6 +266,107 @@ graph_status_get(void)
 	return graph_started;
 }
 
+static int
+graph_qsbr_init(void)
+{
+	size_t sz;
+
+	if (graph_qsv != NULL)
+		return 0;
+
+	sz = rte_rcu_qsbr_get_memsize(RTE_MAX_LCORE);
+	graph_qsv = rte_zmalloc("graph_qsbr", sz, RTE_CACHE_LINE_SIZE);
+	if (graph_qsv == NULL)
+		return -ENOMEM;
+
+	return rte_rcu_qsbr_init(graph_qsv, RTE_MAX_LCORE);
+}
+
+int
+graph_worker_create(uint32_t lcore_id, struct rte_graph_param *graph_conf)
+{
+	struct lcore_conf *qconf = &lcore_conf[lcore_id];
+	char name[RTE_GRAPH_NAMESIZE];
+	rte_graph_t graph_id;
+
+	/* Graphs of a reload coexist with the running ones until published */
+	if (graph_version == 0)
+		snprintf(name, sizeof(name), "worker_%u", lcore_id);
+	else
+		snprintf(name, sizeof(name), "worker_%u_v%u", lcore_id, graph_version);
+
+	graph_id = rte_graph_create(name, graph_conf);
+	if (graph_id == RTE_GRAPH_ID_INVALID)
+		return -EINVAL;
+
+	qconf->next_graph = rte_graph_lookup(name);
+	if (qconf->next_graph == NULL) {
+		rte_graph_destroy(graph_id);
+		return -ENOENT;
+	}
+	qconf->next_graph_id = graph_id;
+
+	return 0;
+}
+
+void
+graph_worker_discard(void)
+{
+	struct lcore_conf *qconf;
+	uint32_t lcore_id;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		qconf = &lcore_conf[lcore_id];
+		if (qconf->next_graph == NULL)
+			continue;
+
+		rte_graph_destroy(qconf->next_graph_id);
+		qconf->next_graph = NULL;
+	}
+}
+
+int
+graph_worker_publish(void)
+{
+	rte_graph_t old_ids[RTE_MAX_LCORE];
+	struct lcore_conf *qconf;
+	uint32_t lcore_id;
+	bool old = false;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		qconf = &lcore_conf[lcore_id];
+		old_ids[lcore_id] = RTE_GRAPH_ID_INVALID;
+		if (qconf->next_graph == NULL)
+			continue;
+
+		if (rte_atomic_load_explicit(&qconf->graph,
+				rte_memory_order_relaxed) != NULL) {
+			old_ids[lcore_id] = qconf->graph_id;
+			old = true;
+		}
+
+		qconf->graph_id = qconf->next_graph_id;
+		rte_strscpy(qconf->name, rte_graph_id_to_name(qconf->graph_id),
+			    sizeof(qconf->name));
+		rte_atomic_store_explicit(&qconf->graph, qconf->next_graph,
+					  rte_memory_order_release);
+		qconf->next_graph = NULL;
+	}
+
+	if (!old)
+		return 0;
+
+	/* Wait for the workers to leave the old graphs before destroying them */
+	rte_rcu_qsbr_synchronize(graph_qsv, RTE_QSBR_THRID_INVALID);
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		if (old_ids[lcore_id] != RTE_GRAPH_ID_INVALID)
+			rte_graph_destroy(old_ids[lcore_id]);
+	}
+
+	return 0;
+}
+
 void
 cmd_graph_start_parsed(__rte_unused void *parsed_result, __rte_unused struct cmdline *cl,
 		__rte_unused void *data)
@@ -266,6 +375,11 @@ cmd_graph_start_parsed(__rte_unused void *parsed_result, __rte_unused struct cmd
 	uint32_t nb_graphs = 0, nb_conf, i;
 	int rc = -EINVAL;
 
+	if (graph_qsbr_init() < 0) {
+		printf(MSG_CMD_FAIL, "graph start");
+		return;
+	}
+
 	if (app_graph_feature_arc_enabled())
 		rte_graph_feature_arc_init(0);
 
@@ -289,6 +403,37 @@ cmd_graph_start_parsed(__rte_unused void *parsed_result, __rte_unused struct cmd
 		graph_started = true;
 }
 
+void
+cmd_graph_reload_parsed(__rte_unused void *parsed_result, __rte_unused struct cmdline *cl,
+		__rte_unused void *data)
+{
+	int rc = -EINVAL;
+	uint32_t i;
+
+	if (!graph_started) {
+		printf(MSG_CMD_FAIL, "graph reload");
+		return;
+	}
+
+	graph_version++;
+	for (i = 0; i < MAX_GRAPH_USECASES; i++) {
+		if (!graph_config.usecases[i].enabled)
+			continue;
+
+		if (!strcmp(graph_config.usecases[i].name, "l3fwd")) {
+			rc = usecase_l3fwd_reload();
+			break;
+		}
+		if (!strcmp(graph_config.usecases[i].name, "l2fwd")) {
+			rc = usecase_l2fwd_reload();
+			break;
+		}
+	}
+
+	if (rc < 0)
+		printf(MSG_CMD_FAIL, "graph reload");
+}
+
 static int
 graph_config_add(char *usecases, struct graph_config *config)
 {
@@ -344,7 +489,7 @@ graph_walk_start(void *conf)
 
 	lcore_id = rte_lcore_id();
 	qconf = &lcore_conf[lcore_id];
-	graph = qconf->graph;
+	graph = rte_atomic_load_explicit(&qconf->graph, rte_memory_order_acquire);
 
 	if (!graph) {
 		RTE_LOG(INFO, APP_GRAPH, "Lcore %u has nothing to do\n", lcore_id);
@@ -354,8 +499,18 @@ graph_walk_start(void *conf)
 	RTE_LOG(INFO, APP_GRAPH, "Entering main loop on lcore %u, graph %s(%p)\n", lcore_id,
 		qconf->name, graph);
 
-	while (likely(!force_quit))
+	rte_rcu_qsbr_thread_register(graph_qsv, lcore_id);
+	rte_rcu_qsbr_thread_online(graph_qsv, lcore_id);
+
+	/* The graph is replaced on reload, and the old one released once quiescent */
+	while (likely(!force_quit)) {
+		graph = rte_atomic_load_explicit(&qconf->graph, rte_memory_order_acquire);
 		rte_graph_walk(graph);
+		rte_rcu_qsbr_quiescent(graph_qsv, lcore_id);
+	}
+
+	rte_rcu_qsbr_thread_offline(graph_qsv, lcore_id);
+	rte_rcu_qsbr_thread_unregister(graph_qsv, lcore_id);
 
 	return 0;
 }
@@ -442,9 +597,9 @@ cmd_help_graph_parsed(__rte_unused void *parsed_result, __rte_unused struct cmdl
 
 	len = strlen(conn->msg_out);
 	conn->msg_out += len;
-	snprintf(conn->msg_out, conn->msg_out_len_max, "\n%s\n%s\n%s\n%s\n",
+	snprintf(conn->msg_out, conn->msg_out_len_max, "\n%s\n%s\n%s\n%s\n%s\n",
 		 "----------------------------- graph command help -----------------------------",
-		 cmd_graph_help, "graph start", "graph stats show");
+		 cmd_graph_help, "graph start", "graph reload", "graph stats show");
 
 	len = strlen(conn->msg_out);
 	conn->msg_out_len_max -= len;
@@ -6,8 +6,12 @@
 #define APP_GRAPH_H
 
 #include <cmdline_parse.h>
+#include <rte_graph.h>
 
 int graph_walk_start(void *conf);
+int graph_worker_create(uint32_t lcore_id, struct rte_graph_param *graph_conf);
+void graph_worker_discard(void);
+int graph_worker_publish(void);
 void graph_stats_print(void);
 void graph_pcap_config_get(uint8_t *pcap_ena, uint64_t *num_pkts, char **file);
 uint64_t graph_coremask_get(void);
@@ -18,8 +18,9 @@
 
 #include "module_api.h"
 
+/* Create the graphs of the workers, and publish them */
 static int
-l2fwd_pattern_configure(void)
+l2fwd_graphs_create(void)
 {
 	struct rte_graph_param graph_conf;
 	const char **node_patterns;
@@ -29,6 +30,7 @@ l2fwd_pattern_configure(void)
 	uint8_t pcap_ena;
 	char *pcap_file;
 	int lcore_id;
+	int rc;
 
 	nb_patterns = 0;
 	node_patterns = malloc((ETHDEV_RX_QUEUE_PER_LCORE_MAX + nb_patterns) *
@@ -43,10 +45,9 @@ l2fwd_pattern_configure(void)
 	graph_pcap_config_get(&pcap_ena, &pcap_pkts_count, &pcap_file);
 	graph_conf.pcap_enable = pcap_ena;
 	graph_conf.num_pkt_to_capture = pcap_pkts_count;
-	graph_conf.pcap_filename = strdup(pcap_file);
+	graph_conf.pcap_filename = pcap_file;
 
 	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
-		rte_graph_t graph_id;
 		rte_edge_t i;
 
 		if (rte_lcore_is_enabled(lcore_id) == 0)
@@ -67,24 +68,29 @@ l2fwd_pattern_configure(void)
 		graph_conf.nb_node_patterns = nb_patterns + i;
 		graph_conf.socket_id = rte_lcore_to_socket_id(lcore_id);
 
-		snprintf(qconf->name, sizeof(qconf->name), "worker_%u",
-				lcore_id);
-
-		graph_id = rte_graph_create(qconf->name, &graph_conf);
-		if (graph_id == RTE_GRAPH_ID_INVALID)
-			rte_exit(EXIT_FAILURE,
-					"rte_graph_create(): graph_id invalid"
-					" for lcore %u\n", lcore_id);
-
-		qconf->graph_id = graph_id;
-		qconf->graph = rte_graph_lookup(qconf->name);
+		rc = graph_worker_create(lcore_id, &graph_conf);
 		/* >8 End of graph initialization. */
-		if (!qconf->graph)
-			rte_exit(EXIT_FAILURE,
-					"rte_graph_lookup(): graph %s not found\n",
-					qconf->name);
+		if (rc < 0) {
+			printf("Unable to create graph for lcore %u\n", lcore_id);
+			graph_worker_discard();
+			free(node_patterns);
+			return rc;
+		}
 	}
 
+	free(node_patterns);
+	return graph_worker_publish();
+}
+
+static int
+l2fwd_pattern_configure(void)
+{
+	int rc;
+
+	rc = l2fwd_graphs_create();
+	if (rc < 0)
+		rte_exit(EXIT_FAILURE, "Unable to create l2fwd graphs: err=%d\n", rc);
+
 	/* Launch per-lcore init on every worker lcore */
 	rte_eal_mp_remote_launch(graph_walk_start, NULL, SKIP_MAIN);
 
@@ -114,6 +120,10 @@ ethdev_rx_to_tx_node_link(uint32_t lcore_id)
 		if (txport >= 0) {
 			rx_id = rte_node_from_name(qconf->rx_queue_list[queue].node_name);
 			snprintf(name, sizeof(name), "ethdev_tx-%u", txport);
+			/* The edge may exist from the previous graphs */
+			rc = rte_node_ethdev_rx_next_update(rx_id, name);
+			if (rc == 0)
+				continue;
 			rte_node_edge_update(rx_id, RTE_EDGE_ID_INVALID, &next_node, 1);
 			rc = rte_node_ethdev_rx_next_update(rx_id, name);
 			if (rc)
@@ -150,3 +160,19 @@ usecase_l2fwd_configure(struct rte_node_ethdev_config *conf, uint16_t nb_confs,
 
 	return rc;
 }
+
+int
+usecase_l2fwd_reload(void)
+{
+	uint32_t lcore_id;
+	int rc;
+
+	/* Apply the Rx to Tx ports mapping changes */
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		rc = ethdev_rx_to_tx_node_link(lcore_id);
+		if (rc)
+			return rc;
+	}
+
+	return l2fwd_graphs_create();
+}
@@ -7,5 +7,6 @@
 
 int usecase_l2fwd_configure(struct rte_node_ethdev_config *conf, uint16_t nb_conf,
 			    uint16_t nb_graphs);
+int usecase_l2fwd_reload(void);
 
 #endif
@@ -54,8 +54,37 @@ setup_fib6(int socket)
 	return rte_node_ip6_fib_create(socket, &conf);
 }
 
+static void
+l3fwd_lookup_edges_update(void)
+{
+	const char *fib6_n = "ip6_lookup_fib";
+	const char *fib_n = "ip4_lookup_fib";
+	const char *lpm6_n = "ip6_lookup";
+	const char *lpm_n = "ip4_lookup";
+	rte_node_t pkt_cls;
+
+	/* Both ways, as the lookup mode may have changed since the last graphs */
+	pkt_cls = rte_node_from_name("pkt_cls");
+	if (ip4_lookup_m == IP4_LOOKUP_FIB) {
+		rte_node_edge_update(pkt_cls, RTE_NODE_PKT_CLS_NEXT_IP4_LOOKUP, &fib_n, 1);
+		rte_node_edge_update(pkt_cls, RTE_NODE_PKT_CLS_NEXT_IP4_LOOKUP_FIB, &lpm_n, 1);
+	} else {
+		rte_node_edge_update(pkt_cls, RTE_NODE_PKT_CLS_NEXT_IP4_LOOKUP, &lpm_n, 1);
+		rte_node_edge_update(pkt_cls, RTE_NODE_PKT_CLS_NEXT_IP4_LOOKUP_FIB, &fib_n, 1);
+	}
+
+	if (ip6_lookup_m == IP6_LOOKUP_FIB) {
+		rte_node_edge_update(pkt_cls, RTE_NODE_PKT_CLS_NEXT_IP6_LOOKUP, &fib6_n, 1);
+		rte_node_edge_update(pkt_cls, RTE_NODE_PKT_CLS_NEXT_IP6_LOOKUP_FIB, &lpm6_n, 1);
+	} else {
+		rte_node_edge_update(pkt_cls, RTE_NODE_PKT_CLS_NEXT_IP6_LOOKUP, &lpm6_n, 1);
+		rte_node_edge_update(pkt_cls, RTE_NODE_PKT_CLS_NEXT_IP6_LOOKUP_FIB, &fib6_n, 1);
+	}
+}
+
+/* Create the graphs of the workers, and publish them once the tables are set */
 static int
-l3fwd_pattern_configure(void)
+l3fwd_graphs_create(void)
 {
 	/* Graph initialization. 8< */
 	static const char * const default_patterns[] = {
@@ -87,30 +116,11 @@ l3fwd_pattern_configure(void)
 	graph_pcap_config_get(&pcap_ena, &pcap_pkts_count, &pcap_file);
 	graph_conf.pcap_enable = pcap_ena;
 	graph_conf.num_pkt_to_capture = pcap_pkts_count;
-	graph_conf.pcap_filename = strdup(pcap_file);
-
-	if (ip4_lookup_m == IP4_LOOKUP_FIB) {
-		const char *fib_n = "ip4_lookup_fib";
-		const char *lpm_n = "ip4_lookup";
-		rte_node_t pkt_cls;
-
-		pkt_cls = rte_node_from_name("pkt_cls");
-		rte_node_edge_update(pkt_cls, RTE_NODE_PKT_CLS_NEXT_IP4_LOOKUP, &fib_n, 1);
-		rte_node_edge_update(pkt_cls, RTE_NODE_PKT_CLS_NEXT_IP4_LOOKUP_FIB, &lpm_n, 1);
-	}
-
-	if (ip6_lookup_m == IP6_LOOKUP_FIB) {
-		const char *fib6_n = "ip6_lookup_fib";
-		const char *lpm6_n = "ip6_lookup";
-		rte_node_t pkt_cls;
+	graph_conf.pcap_filename = pcap_file;
 
-		pkt_cls = rte_node_from_name("pkt_cls");
-		rte_node_edge_update(pkt_cls, RTE_NODE_PKT_CLS_NEXT_IP6_LOOKUP, &fib6_n, 1);
-		rte_node_edge_update(pkt_cls, RTE_NODE_PKT_CLS_NEXT_IP6_LOOKUP_FIB, &lpm6_n, 1);
-	}
+	l3fwd_lookup_edges_update();
 
 	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
-		rte_graph_t graph_id;
 		rte_edge_t i;
 
 		if (rte_lcore_is_enabled(lcore_id) == 0)
@@ -131,53 +141,73 @@ l3fwd_pattern_configure(void)
 		graph_conf.nb_node_patterns = nb_patterns + i;
 		graph_conf.socket_id = rte_lcore_to_socket_id(lcore_id);
 
-		snprintf(qconf->name, sizeof(qconf->name), "worker_%u",
-				lcore_id);
-
 		if (ip4_lookup_m == IP4_LOOKUP_FIB) {
 			rc = setup_fib(graph_conf.socket_id);
-			if (rc < 0)
-				rte_exit(EXIT_FAILURE, "Unable to setup fib for socket %u\n",
-						graph_conf.socket_id);
+			if (rc < 0) {
+				printf("Unable to setup fib for socket %u\n",
+				       graph_conf.socket_id);
+				goto fail;
+			}
 		}
 
 		if (ip6_lookup_m == IP6_LOOKUP_FIB) {
 			rc = setup_fib6(graph_conf.socket_id);
-			if (rc < 0)
-				rte_exit(EXIT_FAILURE, "Unable to setup fib6 for socket %u\n",
-						graph_conf.socket_id);
+			if (rc < 0) {
+				printf("Unable to setup fib6 for socket %u\n",
+				       graph_conf.socket_id);
+				goto fail;
+			}
 		}
 
-		graph_id = rte_graph_create(qconf->name, &graph_conf);
-		if (graph_id == RTE_GRAPH_ID_INVALID)
-			rte_exit(EXIT_FAILURE,
-					"rte_graph_create(): graph_id invalid"
-					" for lcore %u\n", lcore_id);
-
-		qconf->graph_id = graph_id;
-		qconf->graph = rte_graph_lookup(qconf->name);
+		rc = graph_worker_create(lcore_id, &graph_conf);
 		/* >8 End of graph initialization. */
-		if (!qconf->graph)
-			rte_exit(EXIT_FAILURE,
-					"rte_graph_lookup(): graph %s not found\n",
-					qconf->name);
+		if (rc < 0) {
+			printf("Unable to create graph for lcore %u\n", lcore_id);
+			goto fail;
+		}
 	}
 
 	rc = route_ip4_add_to_lookup();
-	if (rc < 0)
-		rte_exit(EXIT_FAILURE, "Unable to add v4 route to lookup table\n");
+	if (rc < 0) {
+		printf("Unable to add v4 route to lookup table\n");
+		goto fail;
+	}
 
 	rc = route_ip6_add_to_lookup();
-	if (rc < 0)
-		rte_exit(EXIT_FAILURE, "Unable to add v6 route to lookup table\n");
+	if (rc < 0) {
+		printf("Unable to add v6 route to lookup table\n");
+		goto fail;
+	}
 
 	rc = neigh_ip4_add_to_rewrite();
-	if (rc < 0)
-		rte_exit(EXIT_FAILURE, "Unable to add v4 to rewrite node\n");
+	if (rc < 0) {
+		printf("Unable to add v4 to rewrite node\n");
+		goto fail;
+	}
 
 	rc = neigh_ip6_add_to_rewrite();
+	if (rc < 0) {
+		printf("Unable to add v6 to rewrite node\n");
+		goto fail;
+	}
+
+	free(node_patterns);
+	return graph_worker_publish();
+
+fail:
+	graph_worker_discard();
+	free(node_patterns);
+	return rc;
+}
+
+static int
+l3fwd_pattern_configure(void)
+{
+	int rc;
+
+	rc = l3fwd_graphs_create();
 	if (rc < 0)
-		rte_exit(EXIT_FAILURE, "Unable to add v6 to rewrite node\n");
+		rte_exit(EXIT_FAILURE, "Unable to create l3fwd graphs: err=%d\n", rc);
 
 	/* Launch per-lcore init on every worker lcore */
 	rte_eal_mp_remote_launch(graph_walk_start, NULL, SKIP_MAIN);
@@ -204,3 +234,9 @@ usecase_l3fwd_configure(struct rte_node_ethdev_config *conf, uint16_t nb_confs,
 
 	return rc;
 }
+
+int
+usecase_l3fwd_reload(void)
+{
+	return l3fwd_graphs_create();
+}
@@ -7,5 +7,6 @@
 
 int usecase_l3fwd_configure(struct rte_node_ethdev_config *conf, uint16_t nb_conf,
 			    uint16_t nb_graphs);
+int usecase_l3fwd_reload(void);
 
 #endif
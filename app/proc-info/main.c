@@ -41,6 +41,13 @@
 #include <rte_hexdump.h>
 #include <rte_version.h>
 #include <rte_eventdev.h>
+#ifdef RTE_LIB_SAMPLER
+#include <signal.h>
+#include <rte_sampler.h>
+#include <rte_sampler_cryptodev.h>
+#include <rte_sampler_ethdev.h>
+#include <rte_sampler_eventdev.h>
+#endif
 
 /* Maximum long option length for option parsing. */
 #define MAX_LONG_OPT_SZ 64
@@ -123,6 +130,14 @@ static uint32_t enable_shw_module_eeprom;
 static uint32_t enable_shw_rx_desc_dump;
 static uint32_t enable_shw_tx_desc_dump;
 
+#ifdef RTE_LIB_SAMPLER
+/* Enable monitor mode, with the sampling interval in ms. */
+static uint64_t monitor_interval_ms;
+/* Display rates per second rather than deltas in monitor mode. */
+static uint32_t enable_monitor_rate;
+static volatile bool monitor_quit;
+#endif
+
 /* Note: Port_queue_id in xstats APIs is 8 bits, so we have a maximum of
  * 256 ports and queues for event_Dev
  */
@@ -155,6 +170,11 @@ static struct desc_param tx_desc_param;
 
 #define RSS_HASH_KEY_SIZE 64
 
+#ifdef RTE_LIB_SAMPLER
+/* Period at which the sampler session is polled in monitor mode. */
+#define MONITOR_POLL_US 1000
+#endif
+
 /* display usage */
 static void
 proc_info_usage(const char *prgname)
@@ -200,7 +220,13 @@ proc_info_usage(const char *prgname)
 		"  --show-edev-port-xstats=port_num:evdev_id or *:evdev_id to get queue xstats for specified port or all ports;\n"
 		"  --edev-dump-xstats=evdev_id to dump all event_dev xstats for specified eventdev device;\n"
 		"  --edev-reset-xstats=evdev_id to reset event_dev xstats after reading;\n"
-		"  --show-edev-device-xstats=evdev_id to get event_dev device xstats for specified eventdev device;\n",
+		"  --show-edev-device-xstats=evdev_id to get event_dev device xstats for specified eventdev device;\n"
+#ifdef RTE_LIB_SAMPLER
+		"  --monitor=interval_ms: to stay attached and display xstats deltas of ports, "
+			"eventdev and cryptodev devices every interval_ms, until interrupted\n"
+		"  --monitor-rate: to display rates per second rather than deltas in monitor mode\n"
+#endif
+		,
 		prgname);
 }
 
@@ -454,6 +480,10 @@ proc_info_parse_args(int argc, char **argv)
 		{"edev-dump-xstats", required_argument, NULL, 0},
 		{"edev-reset-xstats", required_argument, NULL, 0},
 		{"show-edev-device-xstats", required_argument, NULL, 0},
+#ifdef RTE_LIB_SAMPLER
+		{"monitor", required_argument, NULL, 0},
+		{"monitor-rate", 0, NULL, 0},
+#endif
 		{NULL, 0, 0, 0}
 	};
 
@@ -542,6 +572,23 @@ proc_info_parse_args(int argc, char **argv)
 			else if (!strncmp(long_option[option_index].name,
 					"show-module-eeprom", MAX_LONG_OPT_SZ))
 				enable_shw_module_eeprom = 1;
+#ifdef RTE_LIB_SAMPLER
+			else if (!strncmp(long_option[option_index].name,
+					"monitor", MAX_LONG_OPT_SZ)) {
+				char *end = NULL;
+
+				errno = 0;
+				monitor_interval_ms = strtoull(optarg, &end, 10);
+				if (errno != 0 || end == optarg || *end != '\0' ||
+						monitor_interval_ms == 0) {
+					fprintf(stderr, "Invalid monitor interval '%s'\n",
+						optarg);
+					return -1;
+				}
+			} else if (!strncmp(long_option[option_index].name,
+					"monitor-rate", MAX_LONG_OPT_SZ))
+				enable_monitor_rate = 1;
+#endif
 			else if (!strncmp(long_option[option_index].name,
 					"edev-dump-xstats", MAX_LONG_OPT_SZ)) {
 				int ret = parse_eventdev_dump_xstats_params(optarg);
@@ -2116,6 +2163,114 @@ eventdev_xstats(void)
 	return count;
 }
 
+#ifdef RTE_LIB_SAMPLER
+static void
+monitor_signal_handler(int signum __rte_unused)
+{
+	monitor_quit = true;
+}
+
+static int
+monitor_output(const char *source_name, uint16_t source_id __rte_unused,
+	       const struct rte_sampler_xstats_name *xstats_names,
+	       const uint64_t *ids __rte_unused, const uint64_t *values,
+	       unsigned int n, void *user_data __rte_unused)
+{
+	unsigned int i;
+
+	printf("###### %s %s ######\n", source_name,
+		enable_monitor_rate ? "rates per second" : "deltas");
+	for (i = 0; i < n; i++) {
+		if (enable_xstats_hide_zero && values[i] == 0)
+			continue;
+		printf("%s: %"PRIu64"\n", xstats_names[i].name, values[i]);
+	}
+	fflush(stdout);
+
+	return 0;
+}
+
+/*
+ * Stay attached and sample the xstats of the enabled ports, and of all the
+ * eventdev and cryptodev devices, every monitor_interval_ms.
+ * The sampler resolves the xstats ids once per source, so that each sample
+ * only reads the values, and computes the deltas or rates itself.
+ */
+static void
+monitor_run(void)
+{
+	const struct rte_sampler_session_conf conf = {
+		.sample_interval_ms = monitor_interval_ms,
+		.name = "proc-info",
+	};
+	const struct rte_sampler_sink_ops ops = {
+		.output = monitor_output,
+		.flags = enable_monitor_rate ? RTE_SAMPLER_SINK_F_RATE :
+			RTE_SAMPLER_SINK_F_DELTA,
+	};
+	const struct rte_sampler_ethdev_conf eth_conf = {
+		.mode = RTE_SAMPLER_ETHDEV_PORT,
+	};
+	const struct rte_sampler_eventdev_conf ev_conf = {
+		.mode = RTE_SAMPLER_EVENTDEV_DEVICE,
+	};
+	struct rte_sampler_session *session;
+	unsigned int nb_sources = 0;
+	uint16_t i;
+
+	session = rte_sampler_session_create(&conf);
+	if (session == NULL)
+		rte_exit(EXIT_FAILURE, "Cannot create sampler session\n");
+
+	if (rte_sampler_session_register_sink(session, "stdout", &ops,
+			NULL) == NULL)
+		rte_exit(EXIT_FAILURE, "Cannot register sampler sink\n");
+
+	RTE_ETH_FOREACH_DEV(i) {
+		if ((enabled_port_mask & (1ul << i)) == 0)
+			continue;
+		if (rte_sampler_ethdev_source_register(session, i,
+				&eth_conf) == NULL)
+			printf("Cannot sample port %u\n", i);
+		else
+			nb_sources++;
+	}
+
+	for (i = 0; i < rte_event_dev_count(); i++) {
+		if (rte_sampler_eventdev_source_register(session, i,
+				&ev_conf) == NULL)
+			printf("Cannot sample eventdev %u\n", i);
+		else
+			nb_sources++;
+	}
+
+	for (i = 0; i < rte_cryptodev_count(); i++) {
+		if (rte_sampler_cryptodev_source_register(session, i) == NULL)
+			printf("Cannot sample cryptodev %u\n", i);
+		else
+			nb_sources++;
+	}
+
+	if (nb_sources == 0)
+		rte_exit(EXIT_FAILURE, "No device to monitor\n");
+
+	signal(SIGINT, monitor_signal_handler);
+	signal(SIGTERM, monitor_signal_handler);
+
+	/* the first sample is only a reference for the deltas */
+	if (rte_sampler_session_start(session, 0) < 0)
+		rte_exit(EXIT_FAILURE, "Cannot start sampler session\n");
+
+	while (!monitor_quit) {
+		rte_sampler_poll();
+		rte_delay_us_sleep(MONITOR_POLL_US);
+	}
+
+	rte_sampler_session_stop(session);
+	rte_sampler_session_free(session);
+}
+#endif
+
 int
 main(int argc, char **argv)
 {
@@ -2169,6 +2324,16 @@ main(int argc, char **argv)
 	if (eventdev_xstats() > 0)
 		goto cleanup;
 
+#ifdef RTE_LIB_SAMPLER
+	if (monitor_interval_ms != 0) {
+		/* If no port mask was specified, then monitor all ports */
+		if (enabled_port_mask == 0)
+			enabled_port_mask = ~0ul;
+		monitor_run();
+		goto close_ports;
+	}
+#endif
+
 	nb_ports = rte_eth_dev_count_avail();
 	if (nb_ports == 0)
 		rte_exit(EXIT_FAILURE, "No Ethernet ports - bye\n");
@@ -2245,6 +2410,9 @@ main(int argc, char **argv)
 	if (enable_shw_module_eeprom)
 		show_module_eeprom_info();
 
+#ifdef RTE_LIB_SAMPLER
+close_ports:
+#endif
 	RTE_ETH_FOREACH_DEV(i)
 		rte_eth_dev_close(i);
 
@@ -415,14 +415,17 @@ cperf_throughput_test_runner(void *test_ctx)
 	exp = 0;
 	if (rte_atomic_compare_exchange_strong_explicit(&display_once, &exp, 1,
 			rte_memory_order_relaxed, rte_memory_order_relaxed)) {
-		printf("\n%12s%6s%12s%17s%15s%16s\n",
-			"lcore id", "Level", "Comp size", "Comp ratio [%]",
-			"Comp [Gbps]", "Decomp [Gbps]");
+		printf("\n%12s%6s%10s%12s%17s%15s%16s\n",
+			"lcore id", "Level", "Op size", "Comp size",
+			"Comp ratio [%]", "Comp [Gbps]", "Decomp [Gbps]");
 	}
 
-	printf("%12u%6u%12zu%17.2f%15.2f%16.2f\n",
+	/* Average input size of an operation, throughput depends on it */
+	printf("%12u%6u%10zu%12zu%17.2f%15.2f%16.2f\n",
 		ctx->ver.mem.lcore_id,
-		test_data->level, ctx->ver.comp_data_sz, ctx->ver.ratio,
+		test_data->level,
+		test_data->input_data_sz / ctx->ver.mem.total_bufs,
+		ctx->ver.comp_data_sz, ctx->ver.ratio,
 		ctx->comp_gbps,
 		ctx->decomp_gbps);
 
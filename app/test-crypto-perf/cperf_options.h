@@ -33,6 +33,7 @@
 #define CPERF_OUT_OF_PLACE	("out-of-place")
 #define CPERF_TEST_FILE		("test-file")
 #define CPERF_TEST_NAME		("test-name")
+#define CPERF_MIXED_FILE	("mixed-file")
 
 #define CPERF_LOW_PRIO_QP_MASK	("low-prio-qp-mask")
 
@@ -76,7 +77,8 @@ enum cperf_perf_test_type {
 	CPERF_TEST_TYPE_THROUGHPUT,
 	CPERF_TEST_TYPE_LATENCY,
 	CPERF_TEST_TYPE_VERIFY,
-	CPERF_TEST_TYPE_PMDCC
+	CPERF_TEST_TYPE_PMDCC,
+	CPERF_TEST_TYPE_MIXED
 };
 
 
@@ -106,6 +108,8 @@ enum cperf_op_type {
 
 extern const char *cperf_op_type_strs[];
 
+struct cperf_mixed_class;
+
 struct cperf_options {
 	enum cperf_perf_test_type test;
 
@@ -192,6 +196,12 @@ struct cperf_options {
 	struct cperf_rsa_test_data *rsa_data;
 	uint16_t rsa_modlen;
 	uint8_t rsa_keytype;
+
+	/* mixed specific options */
+	char *mixed_file;
+	struct cperf_mixed_class *mixed_classes;
+	uint8_t nb_mixed_classes;
+	uint32_t nb_mixed_sessions;
 };
 
 void
@@ -201,6 +211,10 @@ int
 cperf_options_parse(struct cperf_options *options,
 		int argc, char **argv);
 
+int
+cperf_options_parse_arg(struct cperf_options *options,
+		const char *name, const char *arg);
+
 int
 cperf_options_check(struct cperf_options *options);
 
@@ -27,7 +27,7 @@ usage(char *progname)
 {
 	printf("%s [EAL options] --\n"
 		" --silent: disable options dump\n"
-		" --ptest throughput / latency / verify / pmd-cyclecount :"
+		" --ptest throughput / latency / verify / pmd-cyclecount / mixed :"
 		" set test type\n"
 		" --pool_sz N: set the number of crypto ops/mbufs allocated\n"
 		" --total-ops N: set the number of total operations performed\n"
@@ -47,6 +47,7 @@ usage(char *progname)
 		" --out-of-place: enable out-of-place crypto operations\n"
 		" --test-file NAME: set the test vector file path\n"
 		" --test-name NAME: set specific test name section in test file\n"
+		" --mixed-file NAME: set the traffic classes file of the mixed test\n"
 		" --cipher-algo ALGO: set cipher algorithm\n"
 		" --cipher-op encrypt / decrypt: set the cipher operation\n"
 		" --cipher-key-sz N: set the cipher key size\n"
@@ -116,6 +117,10 @@ parse_cperf_test_type(struct cperf_options *opts, const char *arg)
 		{
 			cperf_test_type_strs[CPERF_TEST_TYPE_PMDCC],
 			CPERF_TEST_TYPE_PMDCC
+		},
+		{
+			cperf_test_type_strs[CPERF_TEST_TYPE_MIXED],
+			CPERF_TEST_TYPE_MIXED
 		}
 	};
 
@@ -636,6 +641,24 @@ parse_test_name(struct cperf_options *opts,
 	return 0;
 }
 
+static int
+parse_mixed_file(struct cperf_options *opts,
+		const char *arg)
+{
+	opts->mixed_file = strdup(arg);
+	if (opts->mixed_file == NULL) {
+		RTE_LOG(ERR, USER1, "Dup mixed file failed!\n");
+		return -1;
+	}
+	if (access(opts->mixed_file, F_OK) != -1)
+		return 0;
+	RTE_LOG(ERR, USER1, "Mixed file doesn't exist\n");
+	free(opts->mixed_file);
+	opts->mixed_file = NULL;
+
+	return -1;
+}
+
 static int
 parse_silent(struct cperf_options *opts,
 		const char *arg __rte_unused)
@@ -1058,6 +1081,7 @@ static struct option lgopts[] = {
 	{ CPERF_OUT_OF_PLACE, no_argument, 0, 0 },
 	{ CPERF_TEST_FILE, required_argument, 0, 0 },
 	{ CPERF_TEST_NAME, required_argument, 0, 0 },
+	{ CPERF_MIXED_FILE, required_argument, 0, 0 },
 
 	{ CPERF_CIPHER_ALGO, required_argument, 0, 0 },
 	{ CPERF_CIPHER_OP, required_argument, 0, 0 },
@@ -1134,6 +1158,7 @@ cperf_options_default(struct cperf_options *opts)
 	opts->silent = 0;
 	opts->test_file = NULL;
 	opts->test_name = NULL;
+	opts->mixed_file = NULL;
 	opts->sessionless = 0;
 	opts->out_of_place = 0;
 	opts->csv = 0;
@@ -1177,8 +1202,9 @@ cperf_options_default(struct cperf_options *opts)
 	opts->asym_op_type = RTE_CRYPTO_ASYM_OP_ENCRYPT;
 }
 
-static int
-cperf_opts_parse_long(int opt_idx, struct cperf_options *opts)
+int
+cperf_options_parse_arg(struct cperf_options *opts, const char *name,
+		const char *arg)
 {
 	struct long_opt_parser parsermap[] = {
 		{ CPERF_PTEST_TYPE,	parse_cperf_test_type },
@@ -1201,6 +1227,7 @@ cperf_opts_parse_long(int opt_idx, struct cperf_options *opts)
 		{ CPERF_IMIX,		parse_imix },
 		{ CPERF_TEST_FILE,	parse_test_file },
 		{ CPERF_TEST_NAME,	parse_test_name },
+		{ CPERF_MIXED_FILE,	parse_mixed_file },
 		{ CPERF_CIPHER_ALGO,	parse_cipher_algo },
 		{ CPERF_CIPHER_OP,	parse_cipher_op },
 		{ CPERF_CIPHER_KEY_SZ,	parse_cipher_key_sz },
@@ -1230,14 +1257,19 @@ cperf_opts_parse_long(int opt_idx, struct cperf_options *opts)
 	unsigned int i;
 
 	for (i = 0; i < RTE_DIM(parsermap); i++) {
-		if (strncmp(lgopts[opt_idx].name, parsermap[i].lgopt_name,
-				strlen(lgopts[opt_idx].name)) == 0)
-			return parsermap[i].parser_fn(opts, optarg);
+		if (strcmp(name, parsermap[i].lgopt_name) == 0)
+			return parsermap[i].parser_fn(opts, arg);
 	}
 
 	return -EINVAL;
 }
 
+static int
+cperf_opts_parse_long(int opt_idx, struct cperf_options *opts)
+{
+	return cperf_options_parse_arg(opts, lgopts[opt_idx].name, optarg);
+}
+
 int
 cperf_options_parse(struct cperf_options *options, int argc, char **argv)
 {
@@ -1506,6 +1538,13 @@ cperf_options_check(struct cperf_options *options)
 		return -EINVAL;
 	}
 
+	if (options->test == CPERF_TEST_TYPE_MIXED &&
+			options->mixed_file == NULL) {
+		RTE_LOG(ERR, USER1, "Define path to the file with traffic"
+				" classes.\n");
+		return -EINVAL;
+	}
+
 	if (options->test == CPERF_TEST_TYPE_PMDCC &&
 			options->pool_sz < options->nb_descriptors) {
 		RTE_LOG(ERR, USER1, "For pmd cyclecount benchmarks, pool size "
@@ -1747,6 +1786,8 @@ cperf_options_dump(struct cperf_options *opts)
 	printf("# out of place: %s\n", opts->out_of_place ? "yes" : "no");
 	if (opts->test == CPERF_TEST_TYPE_PMDCC)
 		printf("# inter-burst delay: %u ms\n", opts->pmdcc_delay);
+	if (opts->test == CPERF_TEST_TYPE_MIXED)
+		printf("# mixed file: %s\n", opts->mixed_file);
 
 	printf("#\n");
 
@@ -146,6 +146,7 @@ cperf_alloc_common_memory(const struct cperf_options *options,
 {
 	const char *mp_ops_name;
 	char pool_name[32] = "";
+	unsigned int i;
 	int ret;
 
 	/* Calculate the object size */
@@ -208,6 +209,10 @@ cperf_alloc_common_memory(const struct cperf_options *options,
 
 	snprintf(pool_name, sizeof(pool_name), "pool_cdev_%u_qp_%u",
 			dev_id, qp_id);
+	/* The mixed test allocates a pool per traffic class */
+	for (i = 1; rte_mempool_lookup(pool_name) != NULL; i++)
+		snprintf(pool_name, sizeof(pool_name), "pool_cdev_%u_qp_%u_%u",
+				dev_id, qp_id, i);
 
 	*src_buf_offset = crypto_op_total_size_padded;
 
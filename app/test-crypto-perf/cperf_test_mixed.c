@@ -0,0 +1,672 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_malloc.h>
+#include <rte_cycles.h>
+#include <rte_crypto.h>
+#include <rte_cryptodev.h>
+#include <rte_random.h>
+
+#include "cperf_test_mixed.h"
+#include "cperf_ops.h"
+#include "cperf_test_common.h"
+#include "cperf_test_vector_parsing.h"
+
+/* Length of the random sequence of classes of the operations */
+#define MIXED_SEQ_SIZE		4096
+#define MIXED_SEQ_MASK		(MIXED_SEQ_SIZE - 1)
+
+/*
+ * Log-linear latency histogram: 8 buckets per power of two of cycles,
+ * i.e. a precision of 12.5%.
+ */
+#define MIXED_HIST_SUB_SHIFT	3
+#define MIXED_HIST_SUB_NB	(1 << MIXED_HIST_SUB_SHIFT)
+#define MIXED_HIST_NB_BUCKETS	((64 - MIXED_HIST_SUB_SHIFT + 1) * \
+				 MIXED_HIST_SUB_NB)
+
+/* Private data of the operations, placed before the IV */
+struct cperf_mixed_op_priv {
+	uint64_t tsc;
+	uint32_t class_id;
+};
+
+struct cperf_mixed_class_ctx {
+	const struct cperf_mixed_class *class;
+
+	struct rte_mempool *pool;
+	uint32_t src_buf_offset;
+	uint32_t dst_buf_offset;
+
+	void **sess;
+	uint32_t nb_sess;
+
+	uint64_t ops;
+	uint64_t errors;
+	uint64_t tsc_total;
+	uint64_t hist[MIXED_HIST_NB_BUCKETS];
+};
+
+struct cperf_mixed_ctx {
+	uint8_t dev_id;
+	uint16_t qp_id;
+	uint8_t lcore_id;
+
+	const struct cperf_options *options;
+
+	struct cperf_mixed_class_ctx *classes;
+	uint8_t nb_classes;
+	uint8_t seq[MIXED_SEQ_SIZE];
+};
+
+/* Class keys handled by the mixed test, not by the options parser */
+#define MIXED_CLASS_SESSIONS	("sessions")
+#define MIXED_CLASS_WEIGHT	("weight")
+
+static const char * const mixed_denied_keys[] = {
+	CPERF_PTEST_TYPE,
+	CPERF_DEVTYPE,
+	CPERF_TEST_FILE,
+	CPERF_TEST_NAME,
+	CPERF_MIXED_FILE,
+	CPERF_IMIX,
+	CPERF_SESSIONLESS,
+	CPERF_SHARED_SESSION,
+	CPERF_TOTAL_OPS,
+	CPERF_BURST_SIZE,
+	CPERF_DESC_NB,
+};
+
+static int
+mixed_parse_uint32(const char *arg, uint32_t *val)
+{
+	char *end = NULL;
+	unsigned long n;
+
+	errno = 0;
+	n = strtoul(arg, &end, 10);
+	if (errno != 0 || end == arg || *end != '\0' || n == 0 ||
+			n > UINT32_MAX)
+		return -1;
+	*val = n;
+
+	return 0;
+}
+
+static int
+mixed_class_parse(struct cperf_mixed_class *class,
+		const struct rte_cfgfile_entry *entries, int nb_entries)
+{
+	unsigned int j;
+	int i;
+
+	for (i = 0; i < nb_entries; i++) {
+		const char *name = entries[i].name;
+		const char *value = entries[i].value;
+
+		if (strcmp(name, MIXED_CLASS_SESSIONS) == 0) {
+			if (mixed_parse_uint32(value, &class->nb_sessions) < 0)
+				goto invalid;
+			continue;
+		}
+		if (strcmp(name, MIXED_CLASS_WEIGHT) == 0) {
+			if (mixed_parse_uint32(value, &class->weight) < 0)
+				goto invalid;
+			continue;
+		}
+
+		for (j = 0; j < RTE_DIM(mixed_denied_keys); j++)
+			if (strcmp(name, mixed_denied_keys[j]) == 0)
+				break;
+		if (j != RTE_DIM(mixed_denied_keys)) {
+			RTE_LOG(ERR, USER1, "Class %s: %s is not allowed in a "
+					"traffic class\n", class->name, name);
+			return -EINVAL;
+		}
+
+		/* Options without argument are enabled by any value */
+		if (cperf_options_parse_arg(&class->opts, name, value) < 0)
+			goto invalid;
+	}
+
+	return 0;
+
+invalid:
+	RTE_LOG(ERR, USER1, "Class %s: invalid %s = %s\n", class->name,
+			entries[i].name, entries[i].value);
+	return -EINVAL;
+}
+
+static int
+mixed_class_check(struct cperf_mixed_class *class)
+{
+	struct cperf_options *opts = &class->opts;
+
+	switch (opts->op_type) {
+	case CPERF_CIPHER_ONLY:
+	case CPERF_AUTH_ONLY:
+	case CPERF_CIPHER_THEN_AUTH:
+	case CPERF_AUTH_THEN_CIPHER:
+	case CPERF_AEAD:
+		break;
+	default:
+		RTE_LOG(ERR, USER1, "Class %s: only symmetric crypto "
+				"operations are supported\n", class->name);
+		return -EINVAL;
+	}
+
+	if (opts->aead_op == RTE_CRYPTO_AEAD_OP_DECRYPT ||
+			opts->auth_op == RTE_CRYPTO_AUTH_OP_VERIFY) {
+		RTE_LOG(ERR, USER1, "Class %s: decryption and digest "
+				"verification are not supported\n", class->name);
+		return -EINVAL;
+	}
+
+	if (opts->inc_buffer_size != 0 || opts->buffer_size_count > 1) {
+		RTE_LOG(ERR, USER1, "Class %s: only one buffer size is "
+				"allowed\n", class->name);
+		return -EINVAL;
+	}
+
+	if (cperf_options_check(opts) < 0) {
+		RTE_LOG(ERR, USER1, "Class %s: invalid options\n", class->name);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int
+cperf_mixed_classes_load(struct cperf_options *options)
+{
+	struct cperf_mixed_class *classes = NULL;
+	struct rte_cfgfile_entry *entries = NULL;
+	struct rte_cfgfile *cfg;
+	uint32_t nb_sessions = 0;
+	int nb_classes, nb_entries, i;
+	int ret = -EINVAL;
+
+	if (options->test != CPERF_TEST_TYPE_MIXED)
+		return 0;
+
+	if (options->imix_distribution_count != 0 || options->sessionless ||
+			options->shared_session) {
+		RTE_LOG(ERR, USER1, "IMIX, sessionless and shared session are "
+				"not allowed in the mixed test\n");
+		return -EINVAL;
+	}
+
+	cfg = rte_cfgfile_load(options->mixed_file, 0);
+	if (cfg == NULL) {
+		RTE_LOG(ERR, USER1, "Cannot load mixed file %s\n",
+				options->mixed_file);
+		return -EINVAL;
+	}
+
+	nb_classes = rte_cfgfile_num_sections(cfg, NULL, 0);
+	if (nb_classes <= 0 || nb_classes > CPERF_MIXED_MAX_CLASSES) {
+		RTE_LOG(ERR, USER1, "Mixed file must define 1 to %u traffic "
+				"classes\n", CPERF_MIXED_MAX_CLASSES);
+		goto out;
+	}
+
+	classes = rte_zmalloc(NULL, sizeof(*classes) * nb_classes, 0);
+	if (classes == NULL) {
+		ret = -ENOMEM;
+		goto out;
+	}
+
+	for (i = 0; i < nb_classes; i++) {
+		struct cperf_mixed_class *class = &classes[i];
+		struct cperf_options *opts = &class->opts;
+
+		/* Classes inherit the test options, with a single buffer size */
+		*opts = *options;
+		opts->test_file = NULL;
+		opts->test_name = NULL;
+		opts->segment_sz = 0;
+		opts->buffer_size_list[0] = options->min_buffer_size;
+		opts->buffer_size_count = 1;
+		opts->max_buffer_size = options->min_buffer_size;
+		opts->inc_buffer_size = 0;
+		class->nb_sessions = 1;
+		class->weight = 1;
+
+		nb_entries = rte_cfgfile_section_num_entries_by_index(cfg,
+				class->name, i);
+		if (nb_entries > 0) {
+			entries = malloc(sizeof(*entries) * nb_entries);
+			if (entries == NULL) {
+				ret = -ENOMEM;
+				goto out;
+			}
+			rte_cfgfile_section_entries_by_index(cfg, i,
+					class->name, entries, nb_entries);
+			ret = mixed_class_parse(class, entries, nb_entries);
+			free(entries);
+			entries = NULL;
+			if (ret < 0)
+				goto out;
+		}
+
+		ret = mixed_class_check(class);
+		if (ret < 0)
+			goto out;
+		nb_sessions += class->nb_sessions;
+	}
+
+	options->mixed_classes = classes;
+	options->nb_mixed_classes = nb_classes;
+	options->nb_mixed_sessions = nb_sessions;
+	/* The buffer sizes are set per class, run the test once */
+	options->buffer_size_list[0] = options->min_buffer_size;
+	options->buffer_size_count = 1;
+	options->max_buffer_size = options->min_buffer_size;
+	options->inc_buffer_size = 0;
+	classes = NULL;
+	ret = 0;
+
+out:
+	rte_free(classes);
+	rte_cfgfile_close(cfg);
+
+	return ret;
+}
+
+int
+cperf_mixed_classes_setup(struct cperf_options *options)
+{
+	uint8_t i;
+
+	for (i = 0; i < options->nb_mixed_classes; i++) {
+		struct cperf_mixed_class *class = &options->mixed_classes[i];
+		struct cperf_options *opts = &class->opts;
+
+		/* Apply the device requirements set on the test options */
+		opts->headroom_sz = options->headroom_sz;
+		opts->tailroom_sz = options->tailroom_sz;
+		opts->nb_qps = options->nb_qps;
+		opts->segment_sz += opts->headroom_sz + opts->tailroom_sz;
+		opts->test_buffer_size = opts->min_buffer_size;
+
+		class->t_vec = cperf_test_vector_get_dummy(opts);
+		if (class->t_vec == NULL) {
+			RTE_LOG(ERR, USER1, "Class %s: failed to create test "
+					"vector\n", class->name);
+			return -1;
+		}
+
+		if (cperf_get_op_functions(opts, &class->op_fns) < 0) {
+			RTE_LOG(ERR, USER1, "Class %s: failed to find function "
+					"ops set\n", class->name);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+void
+cperf_mixed_classes_free(struct cperf_options *options)
+{
+	uint8_t i;
+
+	for (i = 0; i < options->nb_mixed_classes; i++)
+		free_test_vector(options->mixed_classes[i].t_vec,
+				&options->mixed_classes[i].opts);
+
+	rte_free(options->mixed_classes);
+	options->mixed_classes = NULL;
+	options->nb_mixed_classes = 0;
+	free(options->mixed_file);
+	options->mixed_file = NULL;
+}
+
+static void
+cperf_mixed_test_free(struct cperf_mixed_ctx *ctx)
+{
+	uint32_t i, j;
+
+	if (!ctx)
+		return;
+
+	if (ctx->classes != NULL) {
+		for (i = 0; i < ctx->nb_classes; i++) {
+			struct cperf_mixed_class_ctx *cc = &ctx->classes[i];
+
+			for (j = 0; j < cc->nb_sess; j++)
+				rte_cryptodev_sym_session_free(ctx->dev_id,
+						cc->sess[j]);
+			rte_free(cc->sess);
+			rte_mempool_free(cc->pool);
+		}
+		rte_free(ctx->classes);
+	}
+
+	rte_free(ctx);
+}
+
+void *
+cperf_mixed_test_constructor(struct rte_mempool *sess_mp,
+		uint8_t dev_id, uint16_t qp_id,
+		const struct cperf_options *options,
+		const struct cperf_test_vector *test_vector __rte_unused,
+		const struct cperf_op_fns *op_fns __rte_unused,
+		void **sess __rte_unused)
+{
+	struct cperf_mixed_ctx *ctx = NULL;
+	uint32_t weight_total = 0, w;
+	uint32_t i, j;
+
+	/* IV goes at the end of the crypto operation */
+	uint16_t iv_offset = sizeof(struct rte_crypto_op) +
+		sizeof(struct rte_crypto_sym_op) +
+		sizeof(struct cperf_mixed_op_priv);
+
+	ctx = rte_zmalloc(NULL, sizeof(struct cperf_mixed_ctx), 0);
+	if (ctx == NULL)
+		goto err;
+
+	ctx->dev_id = dev_id;
+	ctx->qp_id = qp_id;
+	ctx->options = options;
+
+	ctx->classes = rte_zmalloc(NULL, sizeof(*ctx->classes) *
+			options->nb_mixed_classes, 0);
+	if (ctx->classes == NULL)
+		goto err;
+	ctx->nb_classes = options->nb_mixed_classes;
+
+	for (i = 0; i < ctx->nb_classes; i++) {
+		const struct cperf_mixed_class *class =
+				&options->mixed_classes[i];
+		struct cperf_mixed_class_ctx *cc = &ctx->classes[i];
+
+		cc->class = class;
+		cc->sess = rte_zmalloc(NULL,
+				sizeof(*cc->sess) * class->nb_sessions, 0);
+		if (cc->sess == NULL)
+			goto err;
+
+		for (j = 0; j < class->nb_sessions; j++) {
+			cc->sess[j] = class->op_fns.sess_create(sess_mp, dev_id,
+					&class->opts, class->t_vec, iv_offset);
+			if (cc->sess[j] == NULL)
+				goto err;
+			cc->nb_sess++;
+		}
+
+		if (cperf_alloc_common_memory(&class->opts, class->t_vec,
+				dev_id, qp_id,
+				sizeof(struct cperf_mixed_op_priv),
+				&cc->src_buf_offset, &cc->dst_buf_offset,
+				&cc->pool) < 0)
+			goto err;
+
+		weight_total += class->weight;
+	}
+
+	/* Random sequence of classes, based on their weights */
+	for (i = 0; i < MIXED_SEQ_SIZE; i++) {
+		w = rte_rand_max(weight_total);
+		for (j = 0; j < ctx->nb_classes - 1u; j++) {
+			if (w < options->mixed_classes[j].weight)
+				break;
+			w -= options->mixed_classes[j].weight;
+		}
+		ctx->seq[i] = j;
+	}
+
+	return ctx;
+err:
+	cperf_mixed_test_free(ctx);
+
+	return NULL;
+}
+
+static inline uint32_t
+mixed_hist_bucket(uint64_t cycles)
+{
+	uint32_t msb;
+
+	if (cycles < MIXED_HIST_SUB_NB)
+		return cycles;
+
+	msb = 63 - rte_clz64(cycles);
+
+	return ((msb - MIXED_HIST_SUB_SHIFT + 1) << MIXED_HIST_SUB_SHIFT) +
+		((cycles >> (msb - MIXED_HIST_SUB_SHIFT)) &
+		 (MIXED_HIST_SUB_NB - 1));
+}
+
+static inline uint64_t
+mixed_hist_bucket_cycles(uint32_t bucket)
+{
+	uint32_t msb;
+
+	if (bucket < MIXED_HIST_SUB_NB)
+		return bucket;
+
+	msb = (bucket >> MIXED_HIST_SUB_SHIFT) + MIXED_HIST_SUB_SHIFT - 1;
+
+	return (uint64_t)(MIXED_HIST_SUB_NB +
+		(bucket & (MIXED_HIST_SUB_NB - 1))) <<
+		(msb - MIXED_HIST_SUB_SHIFT);
+}
+
+/* Latency in microseconds under which the given permille of ops completed */
+static double
+mixed_hist_percentile(const struct cperf_mixed_class_ctx *cc,
+		uint32_t permille)
+{
+	uint64_t target = (cc->ops * permille + 999) / 1000;
+	uint64_t count = 0;
+	uint32_t i;
+
+	for (i = 0; i < MIXED_HIST_NB_BUCKETS; i++) {
+		count += cc->hist[i];
+		if (count >= target && count != 0)
+			break;
+	}
+	if (i == MIXED_HIST_NB_BUCKETS)
+		return 0;
+
+	return (double)mixed_hist_bucket_cycles(i) * 1000000 /
+		rte_get_tsc_hz();
+}
+
+static inline void
+mixed_ops_complete(struct cperf_mixed_ctx *ctx, struct rte_crypto_op **ops,
+		uint16_t nb_ops)
+{
+	struct cperf_mixed_class_ctx *cc;
+	struct cperf_mixed_op_priv *priv;
+	uint64_t tsc = rte_rdtsc();
+	uint64_t cycles;
+	uint16_t i;
+
+	for (i = 0; i < nb_ops; i++) {
+		priv = (struct cperf_mixed_op_priv *)(ops[i]->sym + 1);
+		cc = &ctx->classes[priv->class_id];
+
+		cycles = tsc - priv->tsc;
+		cc->hist[mixed_hist_bucket(cycles)]++;
+		cc->tsc_total += cycles;
+		cc->ops++;
+		if (ops[i]->status != RTE_CRYPTO_OP_STATUS_SUCCESS)
+			cc->errors++;
+
+		rte_mempool_put(cc->pool, ops[i]);
+	}
+}
+
+static void
+mixed_report(struct cperf_mixed_ctx *ctx, uint16_t burst_size,
+		uint64_t tsc_duration)
+{
+	static RTE_ATOMIC(uint16_t) display_once;
+	double duration = (double)tsc_duration / rte_get_tsc_hz();
+	uint16_t exp = 0;
+	uint32_t i;
+
+	if (rte_atomic_compare_exchange_strong_explicit(&display_once, &exp, 1,
+			rte_memory_order_relaxed, rte_memory_order_relaxed)) {
+		if (!ctx->options->csv)
+			printf("%12s%16s%12s%12s%12s%12s%12s%12s%12s%12s%12s"
+				"%12s%12s\n\n",
+				"lcore id", "Class", "Buf Size", "Burst Size",
+				"Sessions", "Ops", "Errors", "MOps", "Gbps",
+				"Avg us", "P50 us", "P99 us", "P99.9 us");
+		else
+			printf("#lcore id,Class,Buffer Size(B),Burst Size,"
+				"Sessions,Ops,Errors,Ops(Millions),"
+				"Throughput(Gbps),Avg Latency(us),"
+				"P50 Latency(us),P99 Latency(us),"
+				"P99.9 Latency(us)\n\n");
+	}
+
+	for (i = 0; i < ctx->nb_classes; i++) {
+		const struct cperf_mixed_class_ctx *cc = &ctx->classes[i];
+		const struct cperf_mixed_class *class = cc->class;
+		double ops_per_second = cc->ops / duration;
+		double throughput_gbps = ops_per_second *
+				class->opts.test_buffer_size * 8 / 1000000000;
+		double avg_us = cc->ops == 0 ? 0 :
+				(double)cc->tsc_total / cc->ops * 1000000 /
+				rte_get_tsc_hz();
+
+		printf(ctx->options->csv ?
+				"%u,%s,%u,%u,%u,%"PRIu64",%"PRIu64",%.6f,%.6f,"
+				"%.3f,%.3f,%.3f,%.3f\n" :
+				"%12u%16s%12u%12u%12u%12"PRIu64"%12"PRIu64
+				"%12.6f%12.6f%12.3f%12.3f%12.3f%12.3f\n",
+				ctx->lcore_id, class->name,
+				class->opts.test_buffer_size, burst_size,
+				class->nb_sessions, cc->ops, cc->errors,
+				ops_per_second / 1000000, throughput_gbps,
+				avg_us, mixed_hist_percentile(cc, 500),
+				mixed_hist_percentile(cc, 990),
+				mixed_hist_percentile(cc, 999));
+	}
+}
+
+int
+cperf_mixed_test_runner(void *test_ctx)
+{
+	struct cperf_mixed_ctx *ctx = test_ctx;
+	const struct cperf_options *options = ctx->options;
+	struct cperf_mixed_class_ctx *cc;
+	struct cperf_mixed_op_priv *priv;
+	uint64_t ops_enqd_total = 0, ops_deqd_total = 0;
+	uint64_t tsc_start, tsc_end, tsc;
+	uint16_t burst_size, test_burst_size;
+	uint16_t ops_enqd, ops_deqd, ops_unused = 0;
+	uint32_t seq_idx = 0, imix_idx = 0;
+	uint64_t i;
+	void *sess;
+
+	struct rte_crypto_op *ops[options->max_burst_size];
+	struct rte_crypto_op *ops_processed[options->max_burst_size];
+
+	uint16_t iv_offset = sizeof(struct rte_crypto_op) +
+		sizeof(struct rte_crypto_sym_op) +
+		sizeof(struct cperf_mixed_op_priv);
+
+	ctx->lcore_id = rte_lcore_id();
+
+	/* The classes share the burst, only its first size is used */
+	if (options->inc_burst_size != 0)
+		test_burst_size = options->min_burst_size;
+	else
+		test_burst_size = options->burst_size_list[0];
+
+	for (i = 0; i < ctx->nb_classes; i++) {
+		cc = &ctx->classes[i];
+		cc->ops = 0;
+		cc->errors = 0;
+		cc->tsc_total = 0;
+		memset(cc->hist, 0, sizeof(cc->hist));
+	}
+
+	/* Warm up the host CPU before starting the test */
+	for (i = 0; i < options->total_ops; i++)
+		rte_cryptodev_enqueue_burst(ctx->dev_id, ctx->qp_id, NULL, 0);
+
+	tsc_start = rte_rdtsc_precise();
+
+	while (ops_enqd_total < options->total_ops) {
+		burst_size = RTE_MIN((uint64_t)test_burst_size,
+				options->total_ops - ops_enqd_total);
+
+		/* The ops not enqueued in the previous round are at the front */
+		tsc = rte_rdtsc();
+		for (i = ops_unused; i < burst_size; i++) {
+			cc = &ctx->classes[ctx->seq[seq_idx++ & MIXED_SEQ_MASK]];
+
+			if (rte_mempool_get(cc->pool, (void **)&ops[i]) != 0) {
+				RTE_LOG(ERR, USER1,
+					"Failed to allocate more crypto operations "
+					"from the crypto operation pool.\n"
+					"Consider increasing the pool size "
+					"with --pool-sz\n");
+				return -1;
+			}
+
+			sess = cc->sess[rte_rand_max(cc->nb_sess)];
+			(cc->class->op_fns.populate_ops)(&ops[i],
+					cc->src_buf_offset, cc->dst_buf_offset,
+					1, sess, &cc->class->opts,
+					cc->class->t_vec, iv_offset, &imix_idx,
+					NULL);
+
+			priv = (struct cperf_mixed_op_priv *)(ops[i]->sym + 1);
+			priv->tsc = tsc;
+			priv->class_id = cc - ctx->classes;
+		}
+
+		ops_enqd = rte_cryptodev_enqueue_burst(ctx->dev_id, ctx->qp_id,
+				ops, burst_size);
+		ops_unused = burst_size - ops_enqd;
+		ops_enqd_total += ops_enqd;
+		if (unlikely(ops_unused != 0))
+			memmove(ops, &ops[ops_enqd], ops_unused * sizeof(ops[0]));
+
+		ops_deqd = rte_cryptodev_dequeue_burst(ctx->dev_id, ctx->qp_id,
+				ops_processed, test_burst_size);
+		mixed_ops_complete(ctx, ops_processed, ops_deqd);
+		ops_deqd_total += ops_deqd;
+	}
+
+	/* Dequeue any operations still in the crypto device */
+	while (ops_deqd_total < ops_enqd_total) {
+		/* Sending 0 length burst to flush sw crypto device */
+		rte_cryptodev_enqueue_burst(ctx->dev_id, ctx->qp_id, NULL, 0);
+
+		ops_deqd = rte_cryptodev_dequeue_burst(ctx->dev_id, ctx->qp_id,
+				ops_processed, test_burst_size);
+		mixed_ops_complete(ctx, ops_processed, ops_deqd);
+		ops_deqd_total += ops_deqd;
+	}
+
+	tsc_end = rte_rdtsc_precise();
+
+	mixed_report(ctx, test_burst_size, tsc_end - tsc_start);
+
+	return 0;
+}
+
+void
+cperf_mixed_test_destructor(void *arg)
+{
+	struct cperf_mixed_ctx *ctx = arg;
+
+	if (ctx == NULL)
+		return;
+
+	cperf_mixed_test_free(ctx);
+}
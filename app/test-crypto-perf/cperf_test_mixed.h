@@ -0,0 +1,58 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _CPERF_MIXED_
+#define _CPERF_MIXED_
+
+#include <stdint.h>
+
+#include <rte_cfgfile.h>
+#include <rte_mbuf.h>
+
+#include "cperf.h"
+#include "cperf_ops.h"
+#include "cperf_options.h"
+#include "cperf_test_vectors.h"
+
+#define CPERF_MIXED_MAX_CLASSES	32
+
+/* Traffic class of the mixed test, i.e. a section of the mixed file */
+struct cperf_mixed_class {
+	char name[CFG_NAME_LEN];
+	/* Options of the class, the test options overridden by the section */
+	struct cperf_options opts;
+	struct cperf_test_vector *t_vec;
+	struct cperf_op_fns op_fns;
+	/* Sessions per queue pair, each operation uses a random one */
+	uint32_t nb_sessions;
+	/* Share of the operations of the class */
+	uint32_t weight;
+};
+
+int
+cperf_mixed_classes_load(struct cperf_options *options);
+
+int
+cperf_mixed_classes_setup(struct cperf_options *options);
+
+void
+cperf_mixed_classes_free(struct cperf_options *options);
+
+void *
+cperf_mixed_test_constructor(
+		struct rte_mempool *sess_mp,
+		uint8_t dev_id,
+		uint16_t qp_id,
+		const struct cperf_options *options,
+		const struct cperf_test_vector *test_vector,
+		const struct cperf_op_fns *ops_fn,
+		void **sess);
+
+int
+cperf_mixed_test_runner(void *test_ctx);
+
+void
+cperf_mixed_test_destructor(void *test_ctx);
+
+#endif /* _CPERF_MIXED_ */
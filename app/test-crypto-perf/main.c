@@ -23,6 +23,7 @@
 #include "cperf_test_latency.h"
 #include "cperf_test_verify.h"
 #include "cperf_test_pmd_cyclecount.h"
+#include "cperf_test_mixed.h"
 
 static struct {
 	struct rte_mempool *sess_mp;
@@ -32,7 +33,8 @@ const char *cperf_test_type_strs[] = {
 	[CPERF_TEST_TYPE_THROUGHPUT] = "throughput",
 	[CPERF_TEST_TYPE_LATENCY] = "latency",
 	[CPERF_TEST_TYPE_VERIFY] = "verify",
-	[CPERF_TEST_TYPE_PMDCC] = "pmd-cyclecount"
+	[CPERF_TEST_TYPE_PMDCC] = "pmd-cyclecount",
+	[CPERF_TEST_TYPE_MIXED] = "mixed"
 };
 
 const char *cperf_op_type_strs[] = {
@@ -81,6 +83,11 @@ const struct cperf_test cperf_testmap[] = {
 				cperf_pmd_cyclecount_test_constructor,
 				cperf_pmd_cyclecount_test_runner,
 				cperf_pmd_cyclecount_test_destructor
+		},
+		[CPERF_TEST_TYPE_MIXED] = {
+				cperf_mixed_test_constructor,
+				cperf_mixed_test_runner,
+				cperf_mixed_test_destructor
 		}
 };
 
@@ -301,6 +308,10 @@ cperf_initialize_cryptodev(struct cperf_options *opts, uint8_t *enabled_cdevs)
 		} else
 			sessions_needed = enabled_cdev_count * opts->nb_qps;
 
+		/* The mixed test creates the sessions of all its classes */
+		if (opts->test == CPERF_TEST_TYPE_MIXED)
+			sessions_needed *= opts->nb_mixed_sessions;
+
 		/*
 		 * A single session is required per queue pair
 		 * in each device
@@ -740,6 +751,12 @@ main(int argc, char **argv)
 		goto err;
 	}
 
+	ret = cperf_mixed_classes_load(&opts);
+	if (ret) {
+		RTE_LOG(ERR, USER1, "Loading the traffic classes failed\n");
+		goto err;
+	}
+
 	nb_cryptodevs = cperf_initialize_cryptodev(&opts, enabled_cdevs);
 
 	if (!opts.silent)
@@ -754,6 +771,10 @@ main(int argc, char **argv)
 
 	ret = cperf_verify_devices_capabilities(&opts, enabled_cdevs,
 			nb_cryptodevs);
+	for (i = 0; ret == 0 && i < opts.nb_mixed_classes; i++)
+		ret = cperf_verify_devices_capabilities(
+				&opts.mixed_classes[i].opts, enabled_cdevs,
+				nb_cryptodevs);
 	if (ret) {
 		RTE_LOG(ERR, USER1, "Crypto device type does not support "
 				"capabilities requested\n");
@@ -792,8 +813,15 @@ main(int argc, char **argv)
 		goto err;
 	}
 
+	ret = cperf_mixed_classes_setup(&opts);
+	if (ret) {
+		RTE_LOG(ERR, USER1, "Failed to set up the traffic classes\n");
+		goto err;
+	}
+
 	if (!opts.silent && opts.test != CPERF_TEST_TYPE_THROUGHPUT &&
-			opts.test != CPERF_TEST_TYPE_LATENCY)
+			opts.test != CPERF_TEST_TYPE_LATENCY &&
+			opts.test != CPERF_TEST_TYPE_MIXED)
 		show_test_vector(t_vec);
 
 	total_nb_qps = nb_cryptodevs * opts.nb_qps;
@@ -968,6 +996,7 @@ main(int argc, char **argv)
 					"Crypto device close error %d\n", ret);
 	}
 
+	cperf_mixed_classes_free(&opts);
 	free_test_vector(t_vec, &opts);
 
 	printf("\n");
@@ -994,6 +1023,7 @@ main(int argc, char **argv)
 
 	}
 	rte_free(opts.imix_buffer_sizes);
+	cperf_mixed_classes_free(&opts);
 	free_test_vector(t_vec, &opts);
 
 	if (rte_errno == ENOTSUP || cap_unsupported) {
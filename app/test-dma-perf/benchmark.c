@@ -7,6 +7,7 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include <rte_bitops.h>
 #include <rte_time.h>
 #include <rte_mbuf.h>
 #include <rte_dmadev.h>
@@ -20,11 +21,17 @@
 
 #define TEST_WAIT_U_SECOND 10000
 
-#define CSV_LINE_DMA_FMT "Scenario %u,%u,%s,%u,%u,%u,%u,%.2lf,%" PRIu64 ",%.3lf,%.3lf\n"
+#define CSV_LINE_DMA_FMT "Scenario %u,%u,%s,%u,%u,%u,%u,%.2lf,%" PRIu64 ",%.3lf,%.3lf%s\n"
 #define CSV_LINE_CPU_FMT "Scenario %u,%u,NA,NA,NA,%u,%u,%.2lf,%" PRIu64 ",%.3lf,%.3lf\n"
 
 #define CSV_TOTAL_LINE_FMT "Scenario %u Summary, , , , , ,%u,%.2lf,%.1lf,%.3lf,%.3lf\n"
 
+/* Log-linear histogram of the completion latencies in cycles */
+#define LAT_HIST_SUB_BITS 3
+#define LAT_HIST_BUCKETS (64 << LAT_HIST_SUB_BITS)
+/* Completion indexes of the DMA operations wrap at 16 bits */
+#define LAT_IDX_NB (UINT16_MAX + 1)
+
 struct worker_info {
 	bool ready_flag;
 	bool start_flag;
@@ -46,14 +53,18 @@ struct lcore_params {
 	char *dma_name;
 	uint16_t worker_id;
 	uint16_t dev_id;
+	uint16_t vchan;
 	uint32_t nr_buf;
 	uint16_t kick_batch;
 	uint32_t buf_size;
+	uint32_t *sizes;
 	uint16_t test_secs;
 	struct rte_mbuf **srcs;
 	struct rte_mbuf **dsts;
 	struct sge_info sge;
 	struct rte_dma_op **dma_ops;
+	uint64_t *enq_tsc;
+	uint64_t *lat_hist;
 	volatile struct worker_info worker_info;
 };
 
@@ -79,10 +90,52 @@ print_err(const char *func, int lineno, const char *format, ...)
 	return ret;
 }
 
+static inline unsigned int
+lat_hist_idx(uint64_t cycles)
+{
+	unsigned int msb;
+
+	if (cycles < (1 << LAT_HIST_SUB_BITS))
+		return cycles;
+	msb = rte_fls_u64(cycles) - 1;
+	return ((msb - LAT_HIST_SUB_BITS + 1) << LAT_HIST_SUB_BITS) |
+		((cycles >> (msb - LAT_HIST_SUB_BITS)) & ((1 << LAT_HIST_SUB_BITS) - 1));
+}
+
+static inline uint64_t
+lat_hist_val(unsigned int idx)
+{
+	unsigned int shift;
+
+	if (idx < (1 << LAT_HIST_SUB_BITS))
+		return idx;
+	shift = (idx >> LAT_HIST_SUB_BITS) - 1;
+	return ((uint64_t)(idx & ((1 << LAT_HIST_SUB_BITS) - 1)) |
+		(1 << LAT_HIST_SUB_BITS)) << shift;
+}
+
+/* Upper bound in microseconds of the bucket holding a percentile */
+static double
+lat_hist_percentile(const uint64_t *hist, double percentile)
+{
+	uint64_t total = 0, sum = 0;
+	unsigned int idx;
+
+	for (idx = 0; idx < LAT_HIST_BUCKETS; idx++)
+		total += hist[idx];
+	if (total == 0)
+		return 0;
+
+	for (idx = 0; sum + hist[idx] < total * percentile / 100; idx++)
+		sum += hist[idx];
+
+	return (double)lat_hist_val(idx + 1) * 1000000 / rte_get_tsc_hz();
+}
+
 static inline void
-calc_result(uint32_t buf_size, uint32_t nr_buf, uint16_t nb_workers, uint16_t test_secs,
-				uint32_t total_cnt, float *memory, uint32_t *ave_cycle,
-				float *bandwidth, float *mops)
+calc_result(uint32_t buf_size, uint32_t op_size, uint32_t nr_buf, uint16_t nb_workers,
+				uint16_t test_secs, uint32_t total_cnt, float *memory,
+				uint32_t *ave_cycle, float *bandwidth, float *mops)
 {
 	float ops;
 
@@ -90,18 +143,22 @@ calc_result(uint32_t buf_size, uint32_t nr_buf, uint16_t nb_workers, uint16_t te
 	*ave_cycle = test_secs * rte_get_timer_hz() / total_cnt;
 	ops = (float)total_cnt / test_secs;
 	*mops = ops / (1000 * 1000);
-	*bandwidth = (ops * buf_size * 8) / (1000 * 1000 * 1000);
+	*bandwidth = (ops * op_size * 8) / (1000 * 1000 * 1000);
 }
 
 static void
 output_result(struct test_configure *cfg, struct lcore_params *para,
 			uint16_t kick_batch, uint64_t ave_cycle, uint32_t buf_size,
-			uint32_t nr_buf, float memory, float bandwidth, float mops)
+			uint32_t nr_buf, float memory, float bandwidth, float mops,
+			float cpu_bandwidth, float cpu_mops)
 {
 	uint16_t ring_size = cfg->ring_size.cur;
 	uint8_t scenario_id = cfg->scenario_id;
 	uint32_t lcore_id = para->lcore_id;
 	char *dma_name = para->dma_name;
+	char extra[128] = "";
+	double p50, p99, p999;
+	int len = 0;
 
 	if (cfg->test_type == TEST_TYPE_DMA_MEM_COPY) {
 		printf("lcore %u, DMA %s, DMA Ring Size: %u, Kick Batch Size: %u", lcore_id,
@@ -118,10 +175,27 @@ output_result(struct test_configure *cfg, struct lcore_params *para,
 			ave_cycle, buf_size, nr_buf, memory, rte_get_timer_hz()/1000000000.0);
 	printf("Average Bandwidth: %.3lf Gbps, MOps: %.3lf\n", bandwidth, mops);
 
+	if (cfg->cpu_compare) {
+		printf("CPU Bandwidth: %.3lf Gbps, CPU MOps: %.3lf\n", cpu_bandwidth, cpu_mops);
+		len += snprintf(extra + len, sizeof(extra) - len, ",%.3lf,%.3lf",
+			cpu_bandwidth, cpu_mops);
+	} else if (cfg->lat_hist) {
+		len += snprintf(extra + len, sizeof(extra) - len, ",,");
+	}
+
+	if (cfg->lat_hist) {
+		p50 = lat_hist_percentile(para->lat_hist, 50);
+		p99 = lat_hist_percentile(para->lat_hist, 99);
+		p999 = lat_hist_percentile(para->lat_hist, 99.9);
+		printf("Completion latency p50: %.3lf us, p99: %.3lf us, p99.9: %.3lf us\n",
+			p50, p99, p999);
+		snprintf(extra + len, sizeof(extra) - len, ",%.3lf,%.3lf,%.3lf", p50, p99, p999);
+	}
+
 	if (cfg->test_type == TEST_TYPE_DMA_MEM_COPY)
 		output_csv(CSV_LINE_DMA_FMT,
 			scenario_id, lcore_id, dma_name, ring_size, kick_batch, buf_size,
-			nr_buf, memory, ave_cycle, bandwidth, mops);
+			nr_buf, memory, ave_cycle, bandwidth, mops, extra);
 	else
 		output_csv(CSV_LINE_CPU_FMT,
 			scenario_id, lcore_id, buf_size,
@@ -185,22 +259,24 @@ vchan_data_populate(uint32_t dev_id, struct rte_dma_vchan_conf *qconf,
 	return 0;
 }
 
-/* Configuration of device. */
+/* Configuration of device, with a vchan for each of the workers sharing it. */
 static void
 configure_dmadev_queue(uint32_t dev_id, struct test_configure *cfg, uint8_t sges_max,
-		       uint16_t dev_num)
+		       uint16_t nb_vchans)
 {
-	uint16_t vchan = 0;
+	struct lcore_dma_map_t *ldm;
 	struct rte_dma_info info;
-	struct rte_dma_conf dev_config = { .nb_vchans = 1 };
-	struct rte_dma_vchan_conf qconf = { 0 };
-
-	if (vchan_data_populate(dev_id, &qconf, cfg, dev_num) != 0)
-		rte_exit(EXIT_FAILURE, "Error with vchan data populate.\n");
+	struct rte_dma_conf dev_config = { .nb_vchans = nb_vchans };
+	struct rte_dma_vchan_conf qconf;
+	uint16_t i;
 
 	if (rte_dma_info_get(dev_id, &info) != 0)
 		rte_exit(EXIT_FAILURE, "Error with getting device info.\n");
 
+	if (info.max_vchans < nb_vchans)
+		rte_exit(EXIT_FAILURE, "Error with device %s supporting %u vchans only.\n",
+			 info.dev_name, info.max_vchans);
+
 	if (cfg->use_ops && !(info.dev_capa & RTE_DMA_CAPA_OPS_ENQ_DEQ))
 		rte_exit(EXIT_FAILURE, "Error with device %s not support enq_deq ops.\n",
 			 info.dev_name);
@@ -211,13 +287,23 @@ configure_dmadev_queue(uint32_t dev_id, struct test_configure *cfg, uint8_t sges
 	if (rte_dma_configure(dev_id, &dev_config) != 0)
 		rte_exit(EXIT_FAILURE, "Error with dma configure.\n");
 
-	if (rte_dma_vchan_setup(dev_id, vchan, &qconf) != 0)
-		rte_exit(EXIT_FAILURE, "Error with queue configuration.\n");
+	for (i = 0; i < cfg->num_worker; i++) {
+		ldm = &cfg->dma_config[i].lcore_dma_map;
+		if (ldm->dma_id != (int16_t)dev_id)
+			continue;
+
+		memset(&qconf, 0, sizeof(qconf));
+		if (vchan_data_populate(dev_id, &qconf, cfg, i) != 0)
+			rte_exit(EXIT_FAILURE, "Error with vchan data populate.\n");
+
+		if (rte_dma_vchan_setup(dev_id, ldm->vchan, &qconf) != 0)
+			rte_exit(EXIT_FAILURE, "Error with queue configuration.\n");
+	}
 
 	if (rte_dma_info_get(dev_id, &info) != 0)
 		rte_exit(EXIT_FAILURE, "Error with getting device info.\n");
 
-	if (info.nb_vchans != 1)
+	if (info.nb_vchans != nb_vchans)
 		rte_exit(EXIT_FAILURE, "Error, no configured queues reported on device id. %u\n",
 				dev_id);
 
@@ -234,9 +320,10 @@ config_dmadevs(struct test_configure *cfg)
 {
 	uint32_t nb_workers = cfg->num_worker;
 	struct lcore_dma_map_t *ldm;
-	uint32_t i;
+	uint32_t i, j;
 	int dev_id;
 	uint16_t nb_dmadevs = 0;
+	uint16_t nb_vchans;
 	uint8_t nb_sges = 0;
 	char *dma_name;
 
@@ -252,18 +339,30 @@ config_dmadevs(struct test_configure *cfg)
 		dev_id = rte_dma_get_dev_id_by_name(dma_name);
 		if (dev_id < 0) {
 			fprintf(stderr, "Error: Fail to find DMA %s.\n", dma_name);
-			goto end;
+			printf("Not enough dmadevs for all workers (%u).\n", nb_workers);
+			return -1;
 		}
 
+		/* The workers sharing a device use a vchan each */
 		ldm->dma_id = dev_id;
-		configure_dmadev_queue(dev_id, cfg, nb_sges, nb_dmadevs);
-		++nb_dmadevs;
+		ldm->vchan = 0;
+		for (j = 0; j < i; j++)
+			if (cfg->dma_config[j].lcore_dma_map.dma_id == dev_id)
+				ldm->vchan++;
 	}
 
-end:
-	if (nb_dmadevs < nb_workers) {
-		printf("Not enough dmadevs (%u) for all workers (%u).\n", nb_dmadevs, nb_workers);
-		return -1;
+	for (i = 0; i < nb_workers; i++) {
+		ldm = &cfg->dma_config[i].lcore_dma_map;
+		if (ldm->vchan != 0)
+			continue;
+
+		nb_vchans = 1;
+		for (j = i + 1; j < nb_workers; j++)
+			if (cfg->dma_config[j].lcore_dma_map.dma_id == ldm->dma_id)
+				nb_vchans++;
+
+		configure_dmadev_queue(ldm->dma_id, cfg, nb_sges, nb_vchans);
+		++nb_dmadevs;
 	}
 
 	printf("Number of used dmadevs: %u.\n", nb_dmadevs);
@@ -283,6 +382,8 @@ stop_dmadev(struct test_configure *cfg, bool *stopped)
 	if (cfg->test_type == TEST_TYPE_DMA_MEM_COPY) {
 		for (i = 0; i < cfg->num_worker; i++) {
 			lcore_dma_map = &cfg->dma_config[i].lcore_dma_map;
+			if (lcore_dma_map->vchan != 0)
+				continue;
 			printf("Stopping dmadev %d\n", lcore_dma_map->dma_id);
 			rte_dma_stop(lcore_dma_map->dma_id);
 		}
@@ -299,23 +400,37 @@ error_exit(int dev_id)
 }
 
 static inline void
-do_dma_submit_and_poll(uint16_t dev_id, uint64_t *async_cnt,
-			volatile struct worker_info *worker_info)
+record_latency(struct lcore_params *para, uint16_t last_idx, uint16_t nr_cpl)
 {
-	int ret;
+	uint64_t now = rte_rdtsc();
+	uint16_t i;
+
+	for (i = 0; i < nr_cpl; i++)
+		para->lat_hist[lat_hist_idx(now - para->enq_tsc[(uint16_t)(last_idx - i)])]++;
+}
+
+static inline void
+do_dma_submit_and_poll(struct lcore_params *para, uint64_t *async_cnt)
+{
+	const uint16_t dev_id = para->dev_id;
+	const uint16_t vchan = para->vchan;
+	uint16_t last_idx;
 	uint16_t nr_cpl;
+	int ret;
 
-	ret = rte_dma_submit(dev_id, 0);
+	ret = rte_dma_submit(dev_id, vchan);
 	if (ret < 0)
 		error_exit(dev_id);
 
-	nr_cpl = rte_dma_completed(dev_id, 0, MAX_DMA_CPL_NB, NULL, NULL);
+	nr_cpl = rte_dma_completed(dev_id, vchan, MAX_DMA_CPL_NB, &last_idx, NULL);
+	if (para->lat_hist != NULL && nr_cpl != 0)
+		record_latency(para, last_idx, nr_cpl);
 	*async_cnt -= nr_cpl;
-	worker_info->total_cpl += nr_cpl;
+	para->worker_info.total_cpl += nr_cpl;
 }
 
 static int
-do_dma_submit_and_wait_cpl(uint16_t dev_id, uint64_t async_cnt, bool use_ops)
+do_dma_submit_and_wait_cpl(uint16_t dev_id, uint16_t vchan, uint64_t async_cnt, bool use_ops)
 {
 #define MAX_WAIT_MSEC	1000
 #define MAX_POLL	1000
@@ -327,24 +442,24 @@ do_dma_submit_and_wait_cpl(uint16_t dev_id, uint64_t async_cnt, bool use_ops)
 	uint16_t nr_cpl;
 
 	if (!use_ops)
-		rte_dma_submit(dev_id, 0);
+		rte_dma_submit(dev_id, vchan);
 
-	if (rte_dma_vchan_status(dev_id, 0, &st) < 0) {
+	if (rte_dma_vchan_status(dev_id, vchan, &st) < 0) {
 		rte_delay_ms(MAX_WAIT_MSEC);
 		goto wait_cpl;
 	}
 
 	while (st == RTE_DMA_VCHAN_ACTIVE && wait_ms++ < MAX_WAIT_MSEC) {
 		rte_delay_ms(1);
-		rte_dma_vchan_status(dev_id, 0, &st);
+		rte_dma_vchan_status(dev_id, vchan, &st);
 	}
 
 wait_cpl:
 	while ((async_cnt > 0) && (poll_cnt++ < MAX_POLL)) {
 		if (use_ops)
-			nr_cpl = rte_dma_dequeue_ops(dev_id, 0, op, DEQ_SZ);
+			nr_cpl = rte_dma_dequeue_ops(dev_id, vchan, op, DEQ_SZ);
 		else
-			nr_cpl = rte_dma_completed(dev_id, 0, MAX_DMA_CPL_NB, NULL, NULL);
+			nr_cpl = rte_dma_completed(dev_id, vchan, MAX_DMA_CPL_NB, NULL, NULL);
 		async_cnt -= nr_cpl;
 	}
 	if (async_cnt > 0)
@@ -359,9 +474,12 @@ do_dma_plain_mem_copy(void *p)
 	struct lcore_params *para = (struct lcore_params *)p;
 	volatile struct worker_info *worker_info = &(para->worker_info);
 	const uint16_t dev_id = para->dev_id;
+	const uint16_t vchan = para->vchan;
 	const uint32_t nr_buf = para->nr_buf;
 	const uint16_t kick_batch = para->kick_batch;
 	const uint32_t buf_size = para->buf_size;
+	const uint32_t *sizes = para->sizes;
+	uint64_t *enq_tsc = para->enq_tsc;
 	struct rte_mbuf **srcs = para->srcs;
 	struct rte_mbuf **dsts = para->dsts;
 	uint64_t async_cnt = 0;
@@ -377,26 +495,29 @@ do_dma_plain_mem_copy(void *p)
 	while (1) {
 		for (i = 0; i < nr_buf; i++) {
 dma_copy:
-			ret = rte_dma_copy(dev_id, 0, rte_mbuf_data_iova(srcs[i]),
-				rte_mbuf_data_iova(dsts[i]), buf_size, 0);
+			ret = rte_dma_copy(dev_id, vchan, rte_mbuf_data_iova(srcs[i]),
+				rte_mbuf_data_iova(dsts[i]),
+				sizes != NULL ? sizes[i] : buf_size, 0);
 			if (unlikely(ret < 0)) {
 				if (ret == -ENOSPC) {
-					do_dma_submit_and_poll(dev_id, &async_cnt, worker_info);
+					do_dma_submit_and_poll(para, &async_cnt);
 					goto dma_copy;
 				} else
 					error_exit(dev_id);
 			}
+			if (enq_tsc != NULL)
+				enq_tsc[ret] = rte_rdtsc();
 			async_cnt++;
 
 			if ((async_cnt % kick_batch) == 0)
-				do_dma_submit_and_poll(dev_id, &async_cnt, worker_info);
+				do_dma_submit_and_poll(para, &async_cnt);
 		}
 
 		if (worker_info->stop_flag)
 			break;
 	}
 
-	return do_dma_submit_and_wait_cpl(dev_id, async_cnt, false);
+	return do_dma_submit_and_wait_cpl(dev_id, vchan, async_cnt, false);
 }
 
 static inline int
@@ -410,6 +531,8 @@ do_dma_sg_mem_copy(void *p)
 	const uint8_t nb_dst_sges = para->sge.nb_dsts;
 	const uint16_t kick_batch = para->kick_batch;
 	const uint16_t dev_id = para->dev_id;
+	const uint16_t vchan = para->vchan;
+	uint64_t *enq_tsc = para->enq_tsc;
 	uint32_t nr_buf = para->nr_buf;
 	uint64_t async_cnt = 0;
 	uint32_t i, j;
@@ -426,28 +549,30 @@ do_dma_sg_mem_copy(void *p)
 		j = 0;
 		for (i = 0; i < nr_buf; i++) {
 dma_copy:
-			ret = rte_dma_copy_sg(dev_id, 0,
+			ret = rte_dma_copy_sg(dev_id, vchan,
 				&src_sges[i * nb_src_sges], &dst_sges[j * nb_dst_sges],
 				nb_src_sges, nb_dst_sges, 0);
 			if (unlikely(ret < 0)) {
 				if (ret == -ENOSPC) {
-					do_dma_submit_and_poll(dev_id, &async_cnt, worker_info);
+					do_dma_submit_and_poll(para, &async_cnt);
 					goto dma_copy;
 				} else
 					error_exit(dev_id);
 			}
+			if (enq_tsc != NULL)
+				enq_tsc[ret] = rte_rdtsc();
 			async_cnt++;
 			j++;
 
 			if ((async_cnt % kick_batch) == 0)
-				do_dma_submit_and_poll(dev_id, &async_cnt, worker_info);
+				do_dma_submit_and_poll(para, &async_cnt);
 		}
 
 		if (worker_info->stop_flag)
 			break;
 	}
 
-	return do_dma_submit_and_wait_cpl(dev_id, async_cnt, false);
+	return do_dma_submit_and_wait_cpl(dev_id, vchan, async_cnt, false);
 }
 
 static inline int
@@ -459,6 +584,7 @@ do_dma_enq_deq_mem_copy(void *p)
 	struct rte_dma_op **dma_ops = para->dma_ops;
 	uint16_t kick_batch = para->kick_batch, sz;
 	const uint16_t dev_id = para->dev_id;
+	const uint16_t vchan = para->vchan;
 	uint32_t nr_buf = para->nr_buf;
 	struct rte_dma_op *op[DEQ_SZ];
 	uint64_t tenq, tdeq;
@@ -479,13 +605,14 @@ do_dma_enq_deq_mem_copy(void *p)
 	while (1) {
 		for (i = 0; i < nr_buf; i += kick_batch) {
 			sz = RTE_MIN(nr_buf - i, kick_batch);
-			enq = rte_dma_enqueue_ops(dev_id, 0, &dma_ops[i], sz);
+			enq = rte_dma_enqueue_ops(dev_id, vchan, &dma_ops[i], sz);
 			while (enq < sz) {
 				do {
-					deq = rte_dma_dequeue_ops(dev_id, 0, op, DEQ_SZ);
+					deq = rte_dma_dequeue_ops(dev_id, vchan, op, DEQ_SZ);
 					tdeq += deq;
 				} while (deq);
-				enq += rte_dma_enqueue_ops(dev_id, 0, &dma_ops[i + enq], sz - enq);
+				enq += rte_dma_enqueue_ops(dev_id, vchan, &dma_ops[i + enq],
+					sz - enq);
 				if (worker_info->stop_flag)
 					break;
 			}
@@ -498,7 +625,7 @@ do_dma_enq_deq_mem_copy(void *p)
 			break;
 	}
 
-	return do_dma_submit_and_wait_cpl(dev_id, tenq - tdeq, true);
+	return do_dma_submit_and_wait_cpl(dev_id, vchan, tenq - tdeq, true);
 }
 
 static inline int
@@ -508,6 +635,7 @@ do_cpu_mem_copy(void *p)
 	volatile struct worker_info *worker_info = &(para->worker_info);
 	const uint32_t nr_buf = para->nr_buf;
 	const uint32_t buf_size = para->buf_size;
+	const uint32_t *sizes = para->sizes;
 	struct rte_mbuf **srcs = para->srcs;
 	struct rte_mbuf **dsts = para->dsts;
 	uint32_t i;
@@ -524,7 +652,7 @@ do_cpu_mem_copy(void *p)
 			void *dst = rte_pktmbuf_mtod(srcs[i], void *);
 
 			/* copy buffer form src to dst */
-			rte_memcpy(dst, src, (size_t)buf_size);
+			rte_memcpy(dst, src, sizes != NULL ? sizes[i] : (size_t)buf_size);
 			worker_info->total_cpl++;
 		}
 		if (worker_info->stop_flag)
@@ -684,6 +812,34 @@ setup_memory_env(struct test_configure *cfg, uint32_t nr_buf,
 	return 0;
 }
 
+/* Pick the size of each buffer copy following the weights of the profile */
+static uint32_t *
+gen_sizes(const struct size_profile *profile, uint32_t nr_buf)
+{
+	uint32_t total = 0;
+	uint32_t *sizes;
+	uint32_t i, j;
+	uint64_t r;
+
+	for (j = 0; j < profile->nb_sizes; j++)
+		total += profile->weights[j];
+
+	sizes = rte_malloc(NULL, nr_buf * sizeof(*sizes), 0);
+	if (sizes == NULL) {
+		printf("Error: sizes malloc failed.\n");
+		return NULL;
+	}
+
+	for (i = 0; i < nr_buf; i++) {
+		r = rte_rand_max(total);
+		for (j = 0; r >= profile->weights[j]; j++)
+			r -= profile->weights[j];
+		sizes[i] = profile->sizes[j];
+	}
+
+	return sizes;
+}
+
 static void
 teardown_memory_env(uint32_t nr_buf, struct rte_mbuf **srcs, struct rte_mbuf **dsts,
 		    struct rte_dma_sge *src_sges, struct rte_dma_sge *dst_sges,
@@ -848,7 +1004,7 @@ attach_ext_buffer(struct vchan_dev_config *vchan_dev, struct lcore_params *lcore
 
 static int
 verify_data(struct test_configure *cfg, struct rte_mbuf **srcs, struct rte_mbuf **dsts,
-	    uint32_t nr_buf)
+	    const uint32_t *sizes, uint32_t nr_buf)
 {
 	struct rte_mbuf **src_buf = NULL, **dst_buf = NULL;
 	uint32_t nr_buf_pt = nr_buf / cfg->num_worker;
@@ -866,6 +1022,7 @@ verify_data(struct test_configure *cfg, struct rte_mbuf **srcs, struct rte_mbuf
 			for (i = 0; i < nr_buf_pt; i++) {
 				if (memcmp(rte_pktmbuf_mtod(src_buf[i], void *),
 							    rte_pktmbuf_mtod(dst_buf[i], void *),
+							    sizes != NULL ? sizes[offset + i] :
 							    cfg->buf_size.cur) != 0) {
 					printf("Copy validation fails for buffer number %d\n", i);
 					return -1;
@@ -923,7 +1080,7 @@ static int
 setup_worker(struct test_configure *cfg, uint32_t nr_buf,
 	     struct rte_mbuf **srcs, struct rte_mbuf **dsts,
 	     struct rte_dma_sge *src_sges, struct rte_dma_sge *dst_sges,
-	     struct rte_dma_op **dma_ops,
+	     struct rte_dma_op **dma_ops, uint32_t *sizes,
 	     uint32_t nr_sgsrc, uint32_t nr_sgdst)
 {
 	struct lcore_dma_map_t *lcore_dma_map = NULL;
@@ -943,7 +1100,7 @@ setup_worker(struct test_configure *cfg, uint32_t nr_buf,
 
 		lcore_id = lcore_dma_map->lcore;
 		offset = nr_buf / nb_workers * i;
-		lcores[i] = rte_malloc(NULL, sizeof(struct lcore_params), 0);
+		lcores[i] = rte_zmalloc(NULL, sizeof(struct lcore_params), 0);
 		if (lcores[i] == NULL) {
 			printf("lcore parameters malloc failure for lcore %d\n", lcore_id);
 			return -1;
@@ -951,9 +1108,27 @@ setup_worker(struct test_configure *cfg, uint32_t nr_buf,
 		if (cfg->test_type == TEST_TYPE_DMA_MEM_COPY) {
 			lcores[i]->dma_name = lcore_dma_map->dma_names;
 			lcores[i]->dev_id = lcore_dma_map->dma_id;
+			lcores[i]->vchan = lcore_dma_map->vchan;
 			lcores[i]->kick_batch = kick_batch;
 		}
 
+		if (cfg->lat_hist) {
+			lcores[i]->enq_tsc = rte_zmalloc_socket(NULL,
+				LAT_IDX_NB * sizeof(uint64_t), RTE_CACHE_LINE_SIZE,
+				rte_lcore_to_socket_id(lcore_id));
+			lcores[i]->lat_hist = rte_zmalloc_socket(NULL,
+				LAT_HIST_BUCKETS * sizeof(uint64_t), RTE_CACHE_LINE_SIZE,
+				rte_lcore_to_socket_id(lcore_id));
+			if (lcores[i]->enq_tsc == NULL || lcores[i]->lat_hist == NULL) {
+				printf("latency histogram malloc failure for lcore %d\n",
+					lcore_id);
+				return -1;
+			}
+		}
+
+		if (sizes != NULL)
+			lcores[i]->sizes = sizes + offset;
+
 		lcores[i]->worker_id = i;
 		lcores[i]->nr_buf = (uint32_t)(nr_buf / nb_workers);
 		lcores[i]->buf_size = buf_size;
@@ -992,7 +1167,7 @@ setup_worker(struct test_configure *cfg, uint32_t nr_buf,
 
 				lcores[i]->dma_ops[j]->nb_src = cfg->nb_src_sges;
 				lcores[i]->dma_ops[j]->nb_dst = cfg->nb_dst_sges;
-				lcores[i]->dma_ops[j]->vchan = 0;
+				lcores[i]->dma_ops[j]->vchan = lcores[i]->vchan;
 			}
 		}
 
@@ -1033,11 +1208,72 @@ teardown_worker_res(struct test_configure *cfg, uint32_t nr_buf,
 				rte_free(m[0]->shinfo);
 		}
 
+		if (lcores[i] != NULL) {
+			rte_free(lcores[i]->enq_tsc);
+			rte_free(lcores[i]->lat_hist);
+		}
 		rte_free(lcores[i]);
 		lcores[i] = NULL;
 	}
 }
 
+/* Start the launched workers and count their completions during the test. */
+static void
+run_workers(uint16_t nb_workers, uint16_t test_secs)
+{
+	uint32_t i;
+
+	while (1) {
+		bool ready = true;
+		for (i = 0; i < nb_workers; i++) {
+			if (lcores[i]->worker_info.ready_flag == false) {
+				ready = 0;
+				break;
+			}
+		}
+		if (ready)
+			break;
+	}
+
+	for (i = 0; i < nb_workers; i++)
+		lcores[i]->worker_info.start_flag = true;
+
+	usleep(TEST_WAIT_U_SECOND);
+	for (i = 0; i < nb_workers; i++)
+		lcores[i]->worker_info.test_cpl = lcores[i]->worker_info.total_cpl;
+
+	usleep(test_secs * 1000 * 1000);
+	for (i = 0; i < nb_workers; i++)
+		lcores[i]->worker_info.test_cpl = lcores[i]->worker_info.total_cpl -
+						lcores[i]->worker_info.test_cpl;
+
+	for (i = 0; i < nb_workers; i++)
+		lcores[i]->worker_info.stop_flag = true;
+
+	rte_eal_mp_wait_lcore();
+}
+
+/* Copy the same buffers with the CPU on the lcores of the DMA workers. */
+static void
+run_cpu_compare(struct test_configure *cfg, uint32_t *cpu_cpl)
+{
+	uint16_t nb_workers = cfg->num_worker;
+	uint32_t i;
+
+	printf("Start CPU comparison....\n");
+	for (i = 0; i < nb_workers; i++) {
+		lcores[i]->worker_info.ready_flag = false;
+		lcores[i]->worker_info.start_flag = false;
+		lcores[i]->worker_info.total_cpl = 0;
+		rte_eal_remote_launch(do_cpu_mem_copy, (void *)(lcores[i]), lcores[i]->lcore_id);
+	}
+
+	run_workers(nb_workers, global_cfg.test_secs);
+
+	for (i = 0; i < nb_workers; i++)
+		cpu_cpl[i] = lcores[i]->worker_info.test_cpl;
+}
+
 int
 mem_copy_benchmark(struct test_configure *cfg)
 {
@@ -1051,10 +1287,15 @@ mem_copy_benchmark(struct test_configure *cfg)
 	uint32_t nr_sgsrc = 0, nr_sgdst = 0;
 	struct rte_dma_op **dma_ops = NULL;
 	float bandwidth, bandwidth_total;
+	uint32_t cpu_cpl[MAX_WORKER_NB];
+	float cpu_bandwidth = 0, cpu_mops = 0;
 	uint32_t avg_cycles_total;
 	bool dev_stopped = false;
 	uint32_t avg_cycles = 0;
+	uint32_t *sizes = NULL;
 	float mops, mops_total;
+	uint32_t op_size, j;
+	uint64_t bytes;
 	float memory = 0;
 	uint32_t nr_buf;
 	int ret = -1;
@@ -1065,6 +1306,12 @@ mem_copy_benchmark(struct test_configure *cfg)
 	if (setup_memory_env(cfg, nr_buf, &srcs, &dsts, &src_sges, &dst_sges, &dma_ops) < 0)
 		goto out;
 
+	if (cfg->size_profile.nb_sizes != 0) {
+		sizes = gen_sizes(&cfg->size_profile, nr_buf);
+		if (sizes == NULL)
+			goto out;
+	}
+
 	if (config_dmadevs(cfg) < 0)
 		goto out;
 
@@ -1076,58 +1323,56 @@ mem_copy_benchmark(struct test_configure *cfg)
 
 	printf("Start testing....\n");
 
-	ret = setup_worker(cfg, nr_buf, srcs, dsts, src_sges, dst_sges, dma_ops,
+	ret = setup_worker(cfg, nr_buf, srcs, dsts, src_sges, dst_sges, dma_ops, sizes,
 			   nr_sgsrc, nr_sgdst);
 	if (ret != 0)
 		goto stop_dmadev;
 
-	while (1) {
-		bool ready = true;
-		for (i = 0; i < nb_workers; i++) {
-			if (lcores[i]->worker_info.ready_flag == false) {
-				ready = 0;
-				break;
-			}
-		}
-		if (ready)
-			break;
-	}
-
-	for (i = 0; i < nb_workers; i++)
-		lcores[i]->worker_info.start_flag = true;
-
-	usleep(TEST_WAIT_U_SECOND);
-	for (i = 0; i < nb_workers; i++)
-		lcores[i]->worker_info.test_cpl = lcores[i]->worker_info.total_cpl;
-
-	usleep(test_secs * 1000 * 1000);
-	for (i = 0; i < nb_workers; i++)
-		lcores[i]->worker_info.test_cpl = lcores[i]->worker_info.total_cpl -
-						lcores[i]->worker_info.test_cpl;
-
-	for (i = 0; i < nb_workers; i++)
-		lcores[i]->worker_info.stop_flag = true;
-
-	rte_eal_mp_wait_lcore();
+	run_workers(nb_workers, test_secs);
 
 	stop_dmadev(cfg, &dev_stopped);
 
-	ret = verify_data(cfg, srcs, dsts, nr_buf);
+	ret = verify_data(cfg, srcs, dsts, sizes, nr_buf);
 	if (ret != 0)
 		goto out;
 
+	if (cfg->test_type == TEST_TYPE_DMA_MEM_COPY && cfg->cpu_compare) {
+		for (i = 0; i < nb_workers; i++)
+			cpu_cpl[i] = lcores[i]->worker_info.test_cpl;
+		run_cpu_compare(cfg, cpu_cpl);
+	}
+
 	mops_total = 0;
 	bandwidth_total = 0;
 	avg_cycles_total = 0;
 	for (i = 0; i < nb_workers; i++) {
 		vchan_dev = &cfg->dma_config[i].vchan_dev;
-		calc_result(buf_size, nr_buf, nb_workers, test_secs,
+
+		/* Average size of the operations of a profile */
+		op_size = buf_size;
+		if (sizes != NULL) {
+			bytes = 0;
+			for (j = 0; j < lcores[i]->nr_buf; j++)
+				bytes += lcores[i]->sizes[j];
+			op_size = bytes / lcores[i]->nr_buf;
+		}
+
+		if (cfg->test_type == TEST_TYPE_DMA_MEM_COPY && cfg->cpu_compare) {
+			calc_result(buf_size, op_size, nr_buf, nb_workers, test_secs,
+				lcores[i]->worker_info.test_cpl,
+				&memory, &avg_cycles, &cpu_bandwidth, &cpu_mops);
+			/* DMA completions were saved before the CPU run */
+			lcores[i]->worker_info.test_cpl = cpu_cpl[i];
+		}
+
+		calc_result(buf_size, op_size, nr_buf, nb_workers, test_secs,
 			lcores[i]->worker_info.test_cpl,
 			&memory, &avg_cycles, &bandwidth, &mops);
 		printf("Direction: %s\n", vchan_dev->tdir == 0 ? "mem2mem" :
 			vchan_dev->tdir == 1 ? "mem2dev" : "dev2mem");
-		output_result(cfg, lcores[i], kick_batch, avg_cycles, buf_size,
-			nr_buf / nb_workers, memory, bandwidth, mops);
+		output_result(cfg, lcores[i], kick_batch, avg_cycles, op_size,
+			nr_buf / nb_workers, memory, bandwidth, mops,
+			cpu_bandwidth, cpu_mops);
 		mops_total += mops;
 		bandwidth_total += bandwidth;
 		avg_cycles_total += avg_cycles;
@@ -1143,6 +1388,7 @@ mem_copy_benchmark(struct test_configure *cfg)
 out:
 	teardown_worker_res(cfg, nr_buf, srcs, dsts);
 	teardown_memory_env(nr_buf, srcs, dsts, src_sges, dst_sges, dma_ops);
+	rte_free(sizes);
 
 	return ret;
 }
@@ -22,7 +22,7 @@
 
 #include "main.h"
 
-#define CSV_HDR_FMT "Case %u : %s,lcore,DMA,DMA ring size,kick batch size,buffer size(B),number of buffers,memory(MB),average cycle,bandwidth(Gbps),MOps\n"
+#define CSV_HDR_FMT "Case %u : %s,lcore,DMA,DMA ring size,kick batch size,buffer size(B),number of buffers,memory(MB),average cycle,bandwidth(Gbps),MOps,CPU bandwidth(Gbps),CPU MOps,latency p50(us),latency p99(us),latency p99.9(us)\n"
 
 #define DMA_MEM_COPY "DMA_MEM_COPY"
 #define CPU_MEM_COPY "CPU_MEM_COPY"
@@ -253,6 +253,36 @@ parse_entry(const char *value, struct test_configure_entry *entry)
 	return args_nr;
 }
 
+/* Parse the "size:weight,..." sizes of the operations. */
+static int
+parse_size_profile(const char *value, struct size_profile *profile)
+{
+	char input[255] = {0};
+	char *args[MAX_PROFILE_SIZES + 1];
+	char *size, *weight;
+	int nb, i;
+
+	strlcpy(input, value, sizeof(input));
+	nb = rte_strsplit(input, strlen(input), args, RTE_DIM(args), ',');
+	if (nb <= 0 || nb > MAX_PROFILE_SIZES)
+		return -1;
+
+	for (i = 0; i < nb; i++) {
+		size = args[i];
+		weight = strchr(size, ':');
+		if (weight == NULL)
+			return -1;
+		*weight++ = '\0';
+		profile->sizes[i] = (uint32_t)atoi(size);
+		profile->weights[i] = (uint32_t)atoi(weight);
+		if (profile->sizes[i] == 0 || profile->weights[i] == 0)
+			return -1;
+	}
+	profile->nb_sizes = nb;
+
+	return 0;
+}
+
 static int populate_dma_dev_config(const char *key, const char *value, void *test)
 {
 	struct lcore_dma_config *dma_config = (struct lcore_dma_config *)test;
@@ -292,6 +322,7 @@ parse_dma_config(struct test_configure *test_case, int case_id,
 		     struct rte_cfgfile *cfgfile, char *section_name, int *nb_vp)
 {
 	const char *ring_size_str, *kick_batch_str, *src_sges_str, *dst_sges_str, *use_dma_ops;
+	const char *lat_hist, *cpu_compare;
 	char lc_dma[RTE_DEV_NAME_MAX_LEN];
 	struct rte_kvargs *kvlist;
 	const char *lcore_dma;
@@ -300,6 +331,10 @@ parse_dma_config(struct test_configure *test_case, int case_id,
 
 	use_dma_ops = rte_cfgfile_get_entry(cfgfile, section_name, "use_enq_deq_ops");
 	test_case->use_ops = (use_dma_ops != NULL && (atoi(use_dma_ops) == 1));
+	lat_hist = rte_cfgfile_get_entry(cfgfile, section_name, "lat_hist");
+	test_case->lat_hist = (lat_hist != NULL && (atoi(lat_hist) == 1));
+	cpu_compare = rte_cfgfile_get_entry(cfgfile, section_name, "cpu_compare");
+	test_case->cpu_compare = (cpu_compare != NULL && (atoi(cpu_compare) == 1));
 
 	ring_size_str = get_cfgfile_entry(cfgfile, section_name, "dma_ring_size");
 	args_nr = parse_entry(ring_size_str, &test_case->ring_size);
@@ -370,6 +405,31 @@ parse_dma_config(struct test_configure *test_case, int case_id,
 	if (test_case->num_worker == 0) {
 		printf("Error: Parsing %s Failed\n", lc_dma);
 		test_case->is_valid = false;
+		return;
+	}
+
+	if (test_case->lat_hist && test_case->use_ops) {
+		printf("lat_hist is not supported with use_enq_deq_ops in case %d.\n", case_id);
+		test_case->is_valid = false;
+		return;
+	}
+
+	if (test_case->size_profile.nb_sizes != 0 && test_case->is_sg) {
+		printf("buf_size_profile is not supported with scatter-gather in case %d.\n",
+			case_id);
+		test_case->is_valid = false;
+		return;
+	}
+
+	/* The CPU copies the same buffers in local memory */
+	for (i = 0; test_case->cpu_compare && i < test_case->num_worker; i++) {
+		if (test_case->is_sg ||
+		    test_case->dma_config[i].vchan_dev.tdir != RTE_DMA_DIR_MEM_TO_MEM) {
+			printf("cpu_compare is only supported for mem2mem copy in case %d.\n",
+				case_id);
+			test_case->is_valid = false;
+			return;
+		}
 	}
 }
 
@@ -414,7 +474,7 @@ parse_global_config(struct rte_cfgfile *cfgfile)
 static uint16_t
 load_configs(const char *path)
 {
-	const char *mem_size_str, *buf_size_str;
+	const char *mem_size_str, *buf_size_str, *profile_str;
 	struct test_configure *test_case;
 	char section_name[CFG_NAME_LEN];
 	struct rte_cfgfile *cfgfile;
@@ -475,14 +535,33 @@ load_configs(const char *path)
 		} else if (args_nr == 4)
 			nb_vp++;
 
-		buf_size_str = get_cfgfile_entry(cfgfile, section_name, "buf_size");
-		args_nr = parse_entry(buf_size_str, &test_case->buf_size);
-		if (args_nr < 0) {
-			printf("parse error in case %d.\n", i + 1);
-			test_case->is_valid = false;
-			continue;
-		} else if (args_nr == 4)
-			nb_vp++;
+		/* The buffers fit the largest size of a profile */
+		profile_str = rte_cfgfile_get_entry(cfgfile, section_name, "buf_size_profile");
+		if (profile_str != NULL) {
+			struct size_profile *profile = &test_case->size_profile;
+			uint32_t j;
+
+			if (parse_size_profile(profile_str, profile) < 0) {
+				printf("parse buf_size_profile error in case %d.\n", i + 1);
+				test_case->is_valid = false;
+				continue;
+			}
+			test_case->buf_size.first = 0;
+			for (j = 0; j < profile->nb_sizes; j++)
+				test_case->buf_size.first = RTE_MAX(test_case->buf_size.first,
+					profile->sizes[j]);
+			test_case->buf_size.cur = test_case->buf_size.first;
+			test_case->buf_size.op = OP_NONE;
+		} else {
+			buf_size_str = get_cfgfile_entry(cfgfile, section_name, "buf_size");
+			args_nr = parse_entry(buf_size_str, &test_case->buf_size);
+			if (args_nr < 0) {
+				printf("parse error in case %d.\n", i + 1);
+				test_case->is_valid = false;
+				continue;
+			} else if (args_nr == 4)
+				nb_vp++;
+		}
 
 		if (test_case->test_type == TEST_TYPE_DMA_MEM_COPY)
 			parse_dma_config(test_case, i + 1, cfgfile, section_name, &nb_vp);
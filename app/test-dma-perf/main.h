@@ -11,6 +11,7 @@
 #include <rte_dev.h>
 
 #define MAX_WORKER_NB 128
+#define MAX_PROFILE_SIZES 16
 
 enum {
 	TEST_TYPE_NONE = 0,
@@ -36,6 +37,14 @@ struct lcore_dma_map_t {
 	char dma_names[RTE_DEV_NAME_MAX_LEN];
 	uint32_t lcore;
 	int16_t dma_id;
+	uint16_t vchan;
+};
+
+/* Sizes of the operations, picked in proportion to their weights */
+struct size_profile {
+	uint32_t nb_sizes;
+	uint32_t sizes[MAX_PROFILE_SIZES];
+	uint32_t weights[MAX_PROFILE_SIZES];
 };
 
 struct vchan_dev_config {
@@ -66,6 +75,9 @@ struct test_configure {
 	uint8_t nb_dst_sges;
 	bool is_sg;
 	uint8_t scenario_id;
+	struct size_profile size_profile;
+	bool lat_hist;
+	bool cpu_compare;
 };
 
 #define MAX_EAL_ARGV_NB 100
@@ -85,6 +85,7 @@ struct evt_options {
 	uint32_t ena_vector : 1;
 	uint64_t nb_pkts;
 	uint64_t nb_timers;
+	uint64_t prod_rate;
 	uint64_t expiry_nsec;
 	uint64_t max_tmo_nsec;
 	uint64_t vector_tmo_nsec;
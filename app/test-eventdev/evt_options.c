@@ -474,6 +474,16 @@ evt_parse_prod_enq_burst_sz(struct evt_options *opt, const char *arg)
 	return ret;
 }
 
+static int
+evt_parse_prod_rate(struct evt_options *opt, const char *arg)
+{
+	int ret;
+
+	ret = parser_read_uint64(&(opt->prod_rate), arg);
+
+	return ret;
+}
+
 static void
 usage(char *program)
 {
@@ -520,6 +530,8 @@ usage(char *program)
 		"\t--mbuf_sz          : packet mbuf size.\n"
 		"\t--max_pkt_sz       : max packet size.\n"
 		"\t--prod_enq_burst_sz : producer enqueue burst size.\n"
+		"\t--prod_rate        : events per second of each synthetic\n"
+		"\t                     producer, in open loop.\n"
 		"\t--nb_eth_queues    : number of ethernet Rx queues.\n"
 		"\t--enable_vector    : enable event vectorization.\n"
 		"\t--vector_size      : Max vector size.\n"
@@ -614,6 +626,7 @@ static struct option lgopts[] = {
 	{ EVT_MBUF_SZ,             1, 0, 0 },
 	{ EVT_MAX_PKT_SZ,          1, 0, 0 },
 	{ EVT_PROD_ENQ_BURST_SZ,   1, 0, 0 },
+	{ EVT_PROD_RATE,           1, 0, 0 },
 	{ EVT_NB_ETH_QUEUES,       1, 0, 0 },
 	{ EVT_ENA_VECTOR,          0, 0, 0 },
 	{ EVT_VECTOR_SZ,           1, 0, 0 },
@@ -666,6 +679,7 @@ evt_opts_parse_long(int opt_idx, struct evt_options *opt)
 		{ EVT_MBUF_SZ, evt_parse_mbuf_sz},
 		{ EVT_MAX_PKT_SZ, evt_parse_max_pkt_sz},
 		{ EVT_PROD_ENQ_BURST_SZ, evt_parse_prod_enq_burst_sz},
+		{ EVT_PROD_RATE, evt_parse_prod_rate},
 		{ EVT_NB_ETH_QUEUES, evt_parse_eth_queues},
 		{ EVT_ENA_VECTOR, evt_parse_ena_vector},
 		{ EVT_VECTOR_SZ, evt_parse_vector_size},
@@ -95,6 +95,35 @@ modex_test_data modex_test_case = {
 	.result_len = 128,
 };
 
+static void
+perf_lat_hist_dump(const char *name, const uint64_t *hist)
+{
+	static const double percentiles[] = {50, 90, 99, 99.9, 99.99};
+	const double freq_mhz = rte_get_timer_hz() / 1E6;
+	uint64_t total = 0, sum = 0;
+	unsigned int b, i = 0, max = 0;
+
+	for (b = 0; b < PERF_LAT_NB_BUCKETS; b++) {
+		total += hist[b];
+		if (hist[b] != 0)
+			max = b;
+	}
+	if (total == 0)
+		return;
+
+	printf("%s latency us:", name);
+	for (b = 0; b <= max; b++) {
+		sum += hist[b];
+		while (i < RTE_DIM(percentiles) &&
+		       sum >= ceil(total * percentiles[i] / 100)) {
+			printf(" p%g " CLGRN "%.3f" CLNRM, percentiles[i],
+			       perf_lat_bucket_max(b) / freq_mhz);
+			i++;
+		}
+	}
+	printf(" max " CLGRN "%.3f" CLNRM "\n", perf_lat_bucket_max(max) / freq_mhz);
+}
+
 int
 perf_test_result(struct evt_test *test, struct evt_options *opt)
 {
@@ -117,9 +146,39 @@ perf_test_result(struct evt_test *test, struct evt_options *opt)
 			total) *
 			       100);
 
+	if (opt->fwd_latency) {
+		uint64_t hist[PERF_LAT_NB_BUCKETS] = {0};
+		char name[32];
+		unsigned int b;
+
+		for (i = 0; i < t->nb_workers; i++)
+			for (b = 0; b < PERF_LAT_NB_BUCKETS; b++)
+				hist[b] += t->worker[i].lat_hist[b];
+		perf_lat_hist_dump("Fwd", hist);
+		for (i = 0; i < t->nb_workers; i++) {
+			snprintf(name, sizeof(name), "Worker %d fwd", i);
+			perf_lat_hist_dump(name, t->worker[i].lat_hist);
+		}
+	}
+
 	return t->result;
 }
 
+/*
+ * Wait for the send time of an event in open loop mode, and return it.
+ * A late event is still stamped with its send time, not to hide the delay.
+ */
+static inline uint64_t
+perf_producer_pace(uint64_t start, double cycles_per_ev, uint64_t seq)
+{
+	const uint64_t send = start + (uint64_t)(seq * cycles_per_ev);
+
+	while (rte_get_timer_cycles() < send)
+		rte_pause();
+
+	return send;
+}
+
 static inline int
 perf_producer(void *arg)
 {
@@ -135,10 +194,15 @@ perf_producer(void *arg)
 	uint32_t flow_counter = 0;
 	uint64_t count = 0;
 	struct perf_elt *m[BURST_SIZE + 1] = {NULL};
+	const uint64_t rate = opt->prod_rate;
+	double cycles_per_ev = 0;
 	uint8_t enable_fwd_latency;
+	uint64_t start, timestamp;
 	struct rte_event ev;
 
 	enable_fwd_latency = opt->fwd_latency;
+	if (rate)
+		cycles_per_ev = (double)rte_get_timer_hz() / rate;
 	if (opt->verbose_level > 1)
 		printf("%s(): lcore %d dev_id %d port=%d queue %d\n", __func__,
 				rte_lcore_id(), dev_id, port, p->queue_id);
@@ -151,20 +215,25 @@ perf_producer(void *arg)
 	ev.event_type =  RTE_EVENT_TYPE_CPU;
 	ev.sub_event_type = 0; /* stage 0 */
 
+	start = rte_get_timer_cycles();
 	while (count < nb_pkts && t->done == false) {
 		if (rte_mempool_get_bulk(pool, (void **)m, BURST_SIZE) < 0)
 			continue;
 		for (i = 0; i < BURST_SIZE; i++) {
 			ev.flow_id = flow_counter++ % nb_flows;
 			ev.event_ptr = m[i];
+			if (rate)
+				timestamp = perf_producer_pace(start, cycles_per_ev, count + i);
+			else
+				timestamp = rte_get_timer_cycles();
 			if (enable_fwd_latency)
-				m[i]->timestamp = rte_get_timer_cycles();
+				m[i]->timestamp = timestamp;
 			while (rte_event_enqueue_new_burst(dev_id, port, &ev,
 							   1) != 1) {
 				if (t->done)
 					break;
 				rte_pause();
-				if (enable_fwd_latency)
+				if (enable_fwd_latency && !rate)
 					m[i]->timestamp =
 						rte_get_timer_cycles();
 			}
@@ -194,9 +263,14 @@ perf_producer_burst(void *arg)
 	struct perf_elt *m[opt->prod_enq_burst_sz + 1];
 	struct rte_event ev[opt->prod_enq_burst_sz + 1];
 	uint32_t burst_size = opt->prod_enq_burst_sz;
+	const uint64_t rate = opt->prod_rate;
+	double cycles_per_ev = 0;
 	uint8_t enable_fwd_latency;
+	uint64_t start;
 
 	enable_fwd_latency = opt->fwd_latency;
+	if (rate)
+		cycles_per_ev = (double)rte_get_timer_hz() / rate;
 	memset(m, 0, sizeof(*m) * (opt->prod_enq_burst_sz + 1));
 	if (opt->verbose_level > 1)
 		printf("%s(): lcore %d dev_id %d port=%d queue %d\n", __func__,
@@ -211,15 +285,20 @@ perf_producer_burst(void *arg)
 		ev[i].sub_event_type = 0; /* stage 0 */
 	}
 
+	start = rte_get_timer_cycles();
 	while (count < nb_pkts && t->done == false) {
 		if (rte_mempool_get_bulk(pool, (void **)m, burst_size) < 0)
 			continue;
+		/* In open loop, the burst is sent with its last event */
+		if (rate)
+			perf_producer_pace(start, cycles_per_ev, count + burst_size - 1);
 		timestamp = rte_get_timer_cycles();
 		for (i = 0; i < burst_size; i++) {
 			ev[i].flow_id = flow_counter++ % nb_flows;
 			ev[i].event_ptr = m[i];
 			if (enable_fwd_latency)
-				m[i]->timestamp = timestamp;
+				m[i]->timestamp = rate ? start +
+					(uint64_t)((count + i) * cycles_per_ev) : timestamp;
 		}
 		enq = rte_event_enqueue_new_burst(dev_id, port, ev, burst_size);
 		while (enq < burst_size) {
@@ -228,7 +307,7 @@ perf_producer_burst(void *arg)
 			if (t->done)
 				break;
 			rte_pause();
-			if (enable_fwd_latency) {
+			if (enable_fwd_latency && !rate) {
 				timestamp = rte_get_timer_cycles();
 				for (i = enq; i < burst_size; i++)
 					m[i]->timestamp = timestamp;
@@ -1451,6 +1530,15 @@ perf_event_dev_port_setup(struct evt_test *test, struct evt_options *opt,
 		w->t = t;
 		w->processed_pkts = 0;
 		w->latency = 0;
+		if (opt->fwd_latency && w->lat_hist == NULL) {
+			w->lat_hist = rte_zmalloc_socket(NULL,
+					PERF_LAT_NB_BUCKETS * sizeof(uint64_t),
+					RTE_CACHE_LINE_SIZE, opt->socket_id);
+			if (w->lat_hist == NULL) {
+				evt_err("failed to allocate latency histogram");
+				return -ENOMEM;
+			}
+		}
 
 		struct rte_event_port_conf conf = *port_conf;
 		conf.event_port_cfg |= RTE_EVENT_PORT_CFG_HINT_WORKER;
@@ -1790,6 +1878,11 @@ perf_opt_check(struct evt_options *opt, uint64_t nb_queues)
 		opt->fwd_latency = 0;
 	}
 
+	if (opt->prod_rate && opt->prod_type != EVT_PROD_TYPE_SYNT) {
+		evt_info("prod_rate is valid with synthetic producers, disabling");
+		opt->prod_rate = 0;
+	}
+
 	if (opt->fwd_latency && !opt->q_priority) {
 		evt_info("enabled queue priority for latency measurement");
 		opt->q_priority = 1;
@@ -1814,6 +1907,8 @@ perf_opt_dump(struct evt_options *opt, uint8_t nb_queues)
 	evt_dump_sched_type_list(opt);
 	evt_dump_producer_type(opt);
 	evt_dump("prod_enq_burst_sz", "%d", opt->prod_enq_burst_sz);
+	if (opt->prod_rate)
+		evt_dump("prod_rate", "%" PRIu64, opt->prod_rate);
 }
 
 static void
@@ -2323,7 +2418,12 @@ perf_test_setup(struct evt_test *test, struct evt_options *opt)
 void
 perf_test_destroy(struct evt_test *test, struct evt_options *opt)
 {
+	struct test_perf *t = evt_test_priv(test);
+	unsigned int i;
+
 	RTE_SET_USED(opt);
 
+	for (i = 0; i < RTE_DIM(t->worker); i++)
+		rte_free(t->worker[i].lat_hist);
 	rte_free(test->test_priv);
 }
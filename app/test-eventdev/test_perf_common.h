@@ -9,6 +9,7 @@
 #include <stdbool.h>
 #include <unistd.h>
 
+#include <rte_bitops.h>
 #include <rte_cryptodev.h>
 #include <rte_cycles.h>
 #include <rte_ethdev.h>
@@ -36,6 +37,7 @@ struct __rte_cache_aligned worker_data {
 	uint64_t processed_pkts;
 	uint64_t processed_vecs;
 	uint64_t latency;
+	uint64_t *lat_hist;
 	uint8_t dev_id;
 	uint8_t port_id;
 	struct test_perf *t;
@@ -99,6 +101,15 @@ struct __rte_cache_aligned perf_elt {
 	};
 };
 
+/*
+ * Latency histogram in cycles: exact below PERF_LAT_SUB, then PERF_LAT_SUB
+ * buckets per power of two, so the percentiles are within 1/PERF_LAT_SUB.
+ */
+#define PERF_LAT_SUB_BITS 4
+#define PERF_LAT_SUB (1 << PERF_LAT_SUB_BITS)
+#define PERF_LAT_MAX_BITS 40
+#define PERF_LAT_NB_BUCKETS ((PERF_LAT_MAX_BITS - PERF_LAT_SUB_BITS + 1) * PERF_LAT_SUB)
+
 #define BURST_SIZE 16
 #define MAX_PROD_ENQ_BURST_SIZE 128
 
@@ -108,8 +119,8 @@ struct __rte_cache_aligned perf_elt {
 	struct evt_options *opt = t->opt;\
 	const uint8_t dev = w->dev_id;\
 	const uint8_t port = w->port_id;\
-	const uint8_t prod_timer_type = \
-		opt->prod_type == EVT_PROD_TYPE_EVENT_TIMER_ADPTR;\
+	const uint8_t prod_timestamp = \
+		opt->prod_type == EVT_PROD_TYPE_EVENT_TIMER_ADPTR || opt->prod_rate;\
 	uint8_t *const sched_type_list = &t->sched_type_list[0];\
 	const enum evt_prod_type prod_type = opt->prod_type;\
 	struct rte_mempool *const pool = t->pool;\
@@ -124,6 +135,39 @@ struct __rte_cache_aligned perf_elt {
 		printf("%s(): lcore %d dev_id %d port=%d\n", __func__,\
 				rte_lcore_id(), dev, port)
 
+static __rte_always_inline unsigned int
+perf_lat_bucket(uint64_t latency)
+{
+	unsigned int shift;
+
+	if (latency < PERF_LAT_SUB)
+		return latency;
+	latency = RTE_MIN(latency, (UINT64_C(1) << PERF_LAT_MAX_BITS) - 1);
+	shift = rte_fls_u64(latency) - 1 - PERF_LAT_SUB_BITS;
+
+	return (shift + 1) * PERF_LAT_SUB + (latency >> shift) - PERF_LAT_SUB;
+}
+
+/* Highest latency of a histogram bucket. */
+static inline uint64_t
+perf_lat_bucket_max(unsigned int bucket)
+{
+	unsigned int shift;
+
+	if (bucket < PERF_LAT_SUB)
+		return bucket;
+	shift = bucket / PERF_LAT_SUB - 1;
+
+	return ((uint64_t)(bucket % PERF_LAT_SUB + PERF_LAT_SUB + 1) << shift) - 1;
+}
+
+static __rte_always_inline void
+perf_lat_record(struct worker_data *const w, uint64_t latency)
+{
+	w->latency += latency;
+	w->lat_hist[perf_lat_bucket(latency)]++;
+}
+
 static __rte_always_inline void
 perf_mark_fwd_latency(enum evt_prod_type prod_type, struct rte_event *const ev)
 {
@@ -315,7 +359,7 @@ perf_process_last_stage_latency(struct rte_mempool *const pool, enum evt_prod_ty
 	}
 
 	latency = rte_get_timer_cycles() - tstamp;
-	w->latency += latency;
+	perf_lat_record(w, latency);
 
 	bufs[count++] = to_free_in_bulk;
 	if (unlikely(count == buf_sz)) {
@@ -347,7 +391,7 @@ perf_process_crypto_vector_last_stage(struct rte_mempool *const pool,
 	if (enable_fwd_latency) {
 		pe = perf_elt_from_vec_get(vec);
 		latency = rte_get_timer_cycles() - pe->timestamp;
-		w->latency += latency;
+		perf_lat_record(w, latency);
 	}
 
 	for (i = 0; i < vec->nb_elem; i++) {
@@ -60,7 +60,7 @@ perf_queue_worker(void *arg, const int enable_fwd_latency)
 		}
 
 		stage = ev.queue_id % nb_stages;
-		if (enable_fwd_latency && !prod_timer_type && stage == 0)
+		if (enable_fwd_latency && !prod_timestamp && stage == 0)
 			/* first q in pipeline, mark timestamp to compute fwd latency */
 			perf_mark_fwd_latency(prod_type, &ev);
 
@@ -111,7 +111,7 @@ perf_queue_worker_burst(void *arg, const int enable_fwd_latency)
 			}
 
 			stage = ev[i].queue_id % nb_stages;
-			if (enable_fwd_latency && !prod_timer_type && stage == 0) {
+			if (enable_fwd_latency && !prod_timestamp && stage == 0) {
 				rte_prefetch0(ev[i+1].event_ptr);
 				/* first queue in pipeline.
 				 * mark time stamp to compute fwd latency
@@ -168,7 +168,7 @@ perf_queue_worker_crypto_vector(void *arg, const int enable_fwd_latency)
 
 		stage = ev.queue_id % nb_stages;
 		/* First q in pipeline, mark timestamp to compute fwd latency */
-		if (enable_fwd_latency && !prod_timer_type && stage == 0)
+		if (enable_fwd_latency && !prod_timestamp && stage == 0)
 			pe->timestamp = rte_get_timer_cycles();
 
 		/* Last stage in pipeline */
@@ -199,7 +199,7 @@ perf_queue_worker_vector(void *arg, const int enable_fwd_latency)
 	RTE_SET_USED(sz);
 	RTE_SET_USED(cnt);
 	RTE_SET_USED(prod_type);
-	RTE_SET_USED(prod_timer_type);
+	RTE_SET_USED(prod_timestamp);
 
 	while (t->done == false) {
 		deq = rte_event_dequeue_burst(dev, port, &ev, 1, 0);
@@ -220,7 +220,7 @@ perf_queue_worker_vector(void *arg, const int enable_fwd_latency)
 		if (unlikely(stage == laststage)) {
 			w->processed_vecs++;
 			if (enable_fwd_latency)
-				w->latency += rte_get_timer_cycles() - ev.vec->u64s[0];
+				perf_lat_record(w, rte_get_timer_cycles() - ev.vec->u64s[0]);
 			rte_mempool_put(pool, ev.event_ptr);
 		} else {
 			fwd_event_vector(&ev, sched_type_list, nb_stages);
@@ -3,12 +3,19 @@
  */
 
 #include <getopt.h>
+#include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#ifndef RTE_EXEC_ENV_WINDOWS
+#include <unistd.h>
+#endif
 
+#include <rte_byteorder.h>
 #include <rte_cycles.h>
 #include <rte_errno.h>
 #include <rte_ip.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
 #include <rte_random.h>
 #include <rte_malloc.h>
 #include <rte_lpm.h>
@@ -49,6 +56,29 @@
 #define FIB_TYPE_MASK		(FIB_RIB_TYPE|FIB_V4_DIR_TYPE|FIB_V6_TRIE_TYPE)
 #define SHUFFLE_FLAG		(1 << 7)
 #define DRY_RUN_FLAG		(1 << 8)
+#define MRT_FLAG		(1 << 9)
+#define LOOKUP_NUM_FLAG		(1 << 10)
+
+/* MRT TABLE_DUMP_V2 records of RIB entries, RFC 6396 */
+#define MRT_TABLE_DUMP_V2	13
+#define MRT_RIB_IPV4_UNICAST	2
+#define MRT_RIB_IPV6_UNICAST	4
+
+/* cache-cold lookup tables are at least that much larger than the LLC */
+#define LLC_LOOKUP_RATIO	4
+
+enum {
+	LOOKUP_SEQ,	/* routes in order */
+	LOOKUP_RND,	/* uniformly random routes */
+	LOOKUP_ZIPF,	/* Zipf distributed routes */
+};
+
+enum {
+	LOOKUP_FIB4,
+	LOOKUP_LPM4,
+	LOOKUP_FIB6,
+	LOOKUP_LPM6,
+};
 
 static char *distrib_string;
 static char line[LINE_MAX];
@@ -82,10 +112,13 @@ static struct {
 	uint32_t	nb_routes_per_depth[128 + 1];
 	uint32_t	flags;
 	uint32_t	tbl8;
+	uint32_t	nb_lookup_lcores;
+	double		zipf_s;
 	uint8_t		ent_sz;
 	uint8_t		rnd_lookup_ips_ratio;
 	uint8_t		print_fract;
 	uint8_t		lookup_fn;
+	uint8_t		lookup_pattern;
 } config = {
 	.routes_file = NULL,
 	.lookup_ips_file = NULL,
@@ -98,7 +131,9 @@ static struct {
 	.ent_sz = 4,
 	.rnd_lookup_ips_ratio = 0,
 	.print_fract = 10,
-	.lookup_fn = 0
+	.lookup_fn = 0,
+	.nb_lookup_lcores = 1,
+	.lookup_pattern = LOOKUP_SEQ
 };
 
 struct rt_rule_4 {
@@ -113,6 +148,30 @@ struct rt_rule_6 {
 	uint64_t	nh;
 };
 
+struct mrt_hdr {
+	rte_be32_t	timestamp;
+	rte_be16_t	type;
+	rte_be16_t	subtype;
+	rte_be32_t	length;
+};
+
+/* Zipf distribution of the ranks of the routes */
+struct zipf_dist {
+	double		*cdf;
+	uint32_t	*rank_rt;
+	uint32_t	n;
+};
+
+struct __rte_cache_aligned lookup_lcore {
+	void		*obj;
+	int		type;
+	uint32_t	first_burst;
+	uint32_t	nb_lookups;
+	uint64_t	cycles;
+};
+
+static struct lookup_lcore lookup_lcores[RTE_MAX_LCORE];
+
 static uint64_t
 get_rnd_rng(uint64_t l, uint64_t u)
 {
@@ -395,27 +454,87 @@ set_rnd_ipv6(struct rte_ipv6_addr *addr, struct rte_ipv6_addr *route, int depth)
 }
 
 static void
+zipf_free(struct zipf_dist *z)
+{
+	rte_free(z->cdf);
+	rte_free(z->rank_rt);
+}
+
+static int
+zipf_init(struct zipf_dist *z, uint32_t n, double s)
+{
+	double sum = 0;
+	uint32_t i, j, tmp;
+
+	z->n = n;
+	z->cdf = rte_malloc(NULL, sizeof(*z->cdf) * n, 0);
+	z->rank_rt = rte_malloc(NULL, sizeof(*z->rank_rt) * n, 0);
+	if (z->cdf == NULL || z->rank_rt == NULL) {
+		zipf_free(z);
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < n; i++) {
+		sum += 1 / pow(i + 1, s);
+		z->cdf[i] = sum;
+		z->rank_rt[i] = i;
+	}
+
+	/* popular routes are not the first ones of the table */
+	for (i = n - 1; i > 0; i--) {
+		j = rte_rand_max(i + 1);
+		tmp = z->rank_rt[i];
+		z->rank_rt[i] = z->rank_rt[j];
+		z->rank_rt[j] = tmp;
+	}
+	return 0;
+}
+
+static uint32_t
+zipf_next(const struct zipf_dist *z)
+{
+	double u = rte_drand() * z->cdf[z->n - 1];
+	uint32_t l = 0, h = z->n - 1, m;
+
+	while (l < h) {
+		m = l + (h - l) / 2;
+		if (z->cdf[m] < u)
+			l = m + 1;
+		else
+			h = m;
+	}
+	return z->rank_rt[l];
+}
+
+static int
 gen_rnd_lookup_tbl(int af)
 {
 	uint32_t *tbl4 = config.lookup_tbl;
 	struct rte_ipv6_addr *tbl6 = config.lookup_tbl;
 	struct rt_rule_4 *rt4 = (struct rt_rule_4 *)config.rt;
 	struct rt_rule_6 *rt6 = (struct rt_rule_6 *)config.rt;
+	struct zipf_dist zipf;
 	uint32_t i, j;
 
-	if (af == AF_INET) {
-		for (i = 0, j = 0; i < config.nb_lookup_ips;
-				i++, j = (j + 1) % config.nb_routes) {
+	if (config.lookup_pattern == LOOKUP_ZIPF &&
+			zipf_init(&zipf, config.nb_routes, config.zipf_s) != 0)
+		return -ENOMEM;
+
+	for (i = 0, j = 0; i < config.nb_lookup_ips;
+			i++, j = (j + 1) % config.nb_routes) {
+		if (config.lookup_pattern == LOOKUP_RND)
+			j = rte_rand_max(config.nb_routes);
+		else if (config.lookup_pattern == LOOKUP_ZIPF)
+			j = zipf_next(&zipf);
+
+		if (af == AF_INET) {
 			if ((rte_rand() % 100) < config.rnd_lookup_ips_ratio) {
 				tbl4[i] = rte_rand();
 				config.nb_lookup_ips_rnd++;
 			} else
 				tbl4[i] = rt4[j].addr | (rte_rand() &
 					((1ULL << (32 - rt4[j].depth)) - 1));
-		}
-	} else {
-		for (i = 0, j = 0; i < config.nb_lookup_ips;
-				i++, j = (j + 1) % config.nb_routes) {
+		} else {
 			if ((rte_rand() % 100) < config.rnd_lookup_ips_ratio) {
 				set_rnd_ipv6(&tbl6[i], &rt6[j].addr, 0);
 				config.nb_lookup_ips_rnd++;
@@ -424,6 +543,10 @@ gen_rnd_lookup_tbl(int af)
 			}
 		}
 	}
+
+	if (config.lookup_pattern == LOOKUP_ZIPF)
+		zipf_free(&zipf);
+	return 0;
 }
 
 static int
@@ -520,6 +643,89 @@ parse_rt_6(FILE *f)
 	return 0;
 }
 
+/*
+ * Parse the RIB entries of an MRT TABLE_DUMP_V2 file as dumped by the
+ * BGP route collectors, with the peer index of the first entry of each
+ * prefix as next hop. Only counts the routes if fill is 0.
+ */
+static int
+parse_mrt(FILE *f, int af, int fill)
+{
+	struct rt_rule_4 *rt4 = (struct rt_rule_4 *)config.rt;
+	struct rt_rule_6 *rt6 = (struct rt_rule_6 *)config.rt;
+	uint64_t max_nh = get_max_nh(rte_ctz32(config.ent_sz));
+	uint8_t max_depth = (af == AF_INET) ? 32 : 128;
+	uint16_t subtype = (af == AF_INET) ? MRT_RIB_IPV4_UNICAST :
+		MRT_RIB_IPV6_UNICAST;
+	uint8_t *rec = NULL, *tmp;
+	uint32_t len, rec_sz = 0;
+	uint32_t addr, nb = 0;
+	struct mrt_hdr hdr;
+	uint8_t depth, nb_bytes;
+	uint16_t peer;
+	int ret = 0;
+
+	while (fread(&hdr, sizeof(hdr), 1, f) == 1) {
+		len = rte_be_to_cpu_32(hdr.length);
+		if (rte_be_to_cpu_16(hdr.type) != MRT_TABLE_DUMP_V2 ||
+				rte_be_to_cpu_16(hdr.subtype) != subtype) {
+			if (fseek(f, len, SEEK_CUR) != 0) {
+				ret = -errno;
+				break;
+			}
+			continue;
+		}
+
+		if (len > rec_sz) {
+			tmp = realloc(rec, len);
+			if (tmp == NULL) {
+				ret = -ENOMEM;
+				break;
+			}
+			rec = tmp;
+			rec_sz = len;
+		}
+		if (fread(rec, len, 1, f) != 1) {
+			ret = -EINVAL;
+			break;
+		}
+
+		/* sequence number, prefix length, prefix, entry count */
+		depth = len > 4 ? rec[4] : UINT8_MAX;
+		nb_bytes = (depth + 7) / 8;
+		if (depth > max_depth || len < 5U + nb_bytes + 2) {
+			ret = -EINVAL;
+			break;
+		}
+
+		if (fill && nb < config.nb_routes) {
+			/* first entry: peer index, originated time, attributes */
+			peer = 0;
+			if (len >= 5U + nb_bytes + 4)
+				peer = rec[5 + nb_bytes + 2] << 8 |
+					rec[5 + nb_bytes + 3];
+
+			if (af == AF_INET) {
+				addr = 0;
+				memcpy(&addr, &rec[5], nb_bytes);
+				rt4[nb].addr = rte_be_to_cpu_32(addr);
+				rt4[nb].depth = depth;
+				rt4[nb].nh = peer & max_nh;
+			} else {
+				memset(&rt6[nb].addr, 0, sizeof(rt6[nb].addr));
+				memcpy(&rt6[nb].addr, &rec[5], nb_bytes);
+				rt6[nb].depth = depth;
+				rt6[nb].nh = peer & max_nh;
+			}
+			config.nb_routes_per_depth[depth]++;
+		}
+		nb++;
+	}
+
+	free(rec);
+	return ret != 0 ? ret : (int)nb;
+}
+
 static int
 parse_lookup(FILE *f, int af)
 {
@@ -602,6 +808,7 @@ print_usage(void)
 	fprintf(stdout,
 		PRINT_USAGE_START
 		"[-f <routes file>]\n"
+		"[-m <MRT TABLE_DUMP_V2 routes file>]\n"
 		"[-t <ip's file for lookup>]\n"
 		"[-n <number of routes (if -f is not specified)>]\n"
 		"[-l <number of ip's for lookup (if -t is not specified)>]\n"
@@ -609,6 +816,12 @@ print_usage(void)
 		"(if -f is not specified)>]\n"
 		"[-r <percentage ratio of random ip's to lookup"
 		"(if -t is not specified)>]\n"
+		"[-p <pattern of routes for ip's to lookup"
+		"(if -t is not specified)>]\n"
+		"\tseq - routes in order (default)\n"
+		"\trnd - random routes, at least %u times the LLC size\n"
+		"\tzipf=<s> - Zipf distributed routes with exponent s\n"
+		"[-j <number of lcores doing lookups (default 1)>]\n"
 		"[-c <do comparison with LPM library>]\n"
 		"[-6 <do tests with ipv6 (default ipv4)>]\n"
 		"[-s <shuffle randomly generated routes>]\n"
@@ -627,10 +840,10 @@ print_usage(void)
 		"[-w <path to the file to dump routing table>]\n"
 		"[-u <path to the file to dump ip's for lookup>]\n"
 		"[-v <type of lookup function:"
-		"\ts1, s2, s3 (3 types of scalar), v (vector) -"
+		"\ts1, s2, s3 (3 types of scalar), v (vector), v2 (AVX2) -"
 		" for DIR24_8 based FIB\n"
 		"\ts, v - for TRIE based ipv6 FIB>]\n",
-		config.prgname);
+		config.prgname, LLC_LOOKUP_RATIO);
 }
 
 static int
@@ -663,6 +876,12 @@ check_config(void)
 		printf("-e 1 is valid only for ipv4\n");
 		return -1;
 	}
+
+	if (config.nb_lookup_lcores > rte_lcore_count()) {
+		printf("-j %u is bigger than the number of lcores %u\n",
+			config.nb_lookup_lcores, rte_lcore_count());
+		return -1;
+	}
 	return 0;
 }
 
@@ -672,11 +891,16 @@ parse_opts(int argc, char **argv)
 	int opt;
 	char *endptr;
 
-	while ((opt = getopt(argc, argv, "f:t:n:d:l:r:c6ab:e:g:w:u:sv:")) !=
-			-1) {
+	while ((opt = getopt(argc, argv,
+			"f:m:t:n:d:l:r:p:j:c6ab:e:g:w:u:sv:")) != -1) {
 		switch (opt) {
 		case 'f':
 			config.routes_file = optarg;
+			config.flags &= ~MRT_FLAG;
+			break;
+		case 'm':
+			config.routes_file = optarg;
+			config.flags |= MRT_FLAG;
 			break;
 		case 't':
 			config.lookup_ips_file = optarg;
@@ -711,6 +935,34 @@ parse_opts(int argc, char **argv)
 				print_usage();
 				rte_exit(-EINVAL, "Invalid option -l\n");
 			}
+			config.flags |= LOOKUP_NUM_FLAG;
+			break;
+		case 'p':
+			if (strcmp(optarg, "seq") == 0)
+				config.lookup_pattern = LOOKUP_SEQ;
+			else if (strcmp(optarg, "rnd") == 0)
+				config.lookup_pattern = LOOKUP_RND;
+			else if (strncmp(optarg, "zipf=", 5) == 0) {
+				config.lookup_pattern = LOOKUP_ZIPF;
+				errno = 0;
+				config.zipf_s = strtod(optarg + 5, &endptr);
+				if ((errno != 0) || (*endptr != '\0') ||
+						(config.zipf_s <= 0)) {
+					print_usage();
+					rte_exit(-EINVAL, "Invalid option -p\n");
+				}
+			} else {
+				print_usage();
+				rte_exit(-EINVAL, "Invalid option -p\n");
+			}
+			break;
+		case 'j':
+			errno = 0;
+			config.nb_lookup_lcores = strtoul(optarg, &endptr, 10);
+			if ((errno != 0) || (config.nb_lookup_lcores == 0)) {
+				print_usage();
+				rte_exit(-EINVAL, "Invalid option -j\n");
+			}
 			break;
 		case 'r':
 			errno = 0;
@@ -778,6 +1030,9 @@ parse_opts(int argc, char **argv)
 			} else if (strcmp(optarg, "s3") == 0) {
 				config.lookup_fn = 4;
 				break;
+			} else if (strcmp(optarg, "v2") == 0) {
+				config.lookup_fn = 5;
+				break;
 			}
 			print_usage();
 			rte_exit(-EINVAL, "Invalid option -v %s\n", optarg);
@@ -788,6 +1043,109 @@ parse_opts(int argc, char **argv)
 	}
 }
 
+static size_t
+get_llc_size(void)
+{
+#ifdef _SC_LEVEL3_CACHE_SIZE
+	long sz = sysconf(_SC_LEVEL3_CACHE_SIZE);
+
+	if (sz > 0)
+		return sz;
+#endif
+	return 0;
+}
+
+static int
+lookup_lcore(void *arg)
+{
+	struct lookup_lcore *lc = arg;
+	uint32_t *tbl4 = config.lookup_tbl;
+	struct rte_ipv6_addr *tbl6 = config.lookup_tbl;
+	uint32_t nb_bursts = config.nb_lookup_ips / BURST_SZ;
+	uint64_t fib_nh[BURST_SZ];
+	uint32_t lpm_nh[BURST_SZ];
+	int32_t lpm6_nh[BURST_SZ];
+	uint64_t start;
+	uint32_t i, n;
+	int ret = 0;
+
+	start = rte_rdtsc_precise();
+	for (n = 0; n < nb_bursts && ret == 0; n++) {
+		i = ((lc->first_burst + n) % nb_bursts) * BURST_SZ;
+		switch (lc->type) {
+		case LOOKUP_FIB4:
+			ret = rte_fib_lookup_bulk(lc->obj, tbl4 + i, fib_nh,
+				BURST_SZ);
+			break;
+		case LOOKUP_LPM4:
+			ret = rte_lpm_lookup_bulk(lc->obj, tbl4 + i, lpm_nh,
+				BURST_SZ);
+			break;
+		case LOOKUP_FIB6:
+			ret = rte_fib6_lookup_bulk(lc->obj, &tbl6[i], fib_nh,
+				BURST_SZ);
+			break;
+		case LOOKUP_LPM6:
+			ret = rte_lpm6_lookup_bulk_func(lc->obj, &tbl6[i],
+				lpm6_nh, BURST_SZ);
+			break;
+		}
+	}
+	lc->cycles = rte_rdtsc_precise() - start;
+	lc->nb_lookups = n * BURST_SZ;
+
+	return ret;
+}
+
+/*
+ * Run the lookups concurrently on several lcores, each of them going
+ * through the whole table of ip's from a different place.
+ */
+static int
+run_lookup_lcores(const char *name, int type, void *obj)
+{
+	uint32_t nb_bursts = config.nb_lookup_ips / BURST_SZ;
+	uint32_t n = config.nb_lookup_lcores;
+	uint64_t cycles = 0, max_cycles = 0, nb = 0;
+	unsigned int lcore_id;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < n; i++) {
+		lookup_lcores[i].obj = obj;
+		lookup_lcores[i].type = type;
+		lookup_lcores[i].first_burst = (uint64_t)nb_bursts * i / n;
+	}
+
+	i = 1;
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (i == n)
+			break;
+		rte_eal_remote_launch(lookup_lcore, &lookup_lcores[i++],
+			lcore_id);
+	}
+	ret = lookup_lcore(&lookup_lcores[0]);
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (rte_eal_wait_lcore(lcore_id) != 0)
+			ret = -1;
+	}
+	if (ret != 0) {
+		printf("%s lookup fails, err %d\n", name, ret);
+		return ret;
+	}
+
+	for (i = 0; i < n; i++) {
+		cycles += lookup_lcores[i].cycles;
+		nb += lookup_lcores[i].nb_lookups;
+		max_cycles = RTE_MAX(max_cycles, lookup_lcores[i].cycles);
+	}
+	printf("AVG %s lookup %.1f on %u lcores, %.1f Mlookups/s\n", name,
+		(double)cycles / (double)nb, n,
+		(double)nb * rte_get_tsc_hz() / max_cycles / 1E6);
+
+	return 0;
+}
+
 static int
 dump_rt_4(struct rt_rule_4 *rt)
 {
@@ -872,6 +1230,9 @@ run_v4(void)
 		else if (config.lookup_fn == 4)
 			ret = rte_fib_select_lookup(fib,
 				RTE_FIB_LOOKUP_DIR24_8_SCALAR_UNI);
+		else if (config.lookup_fn == 5)
+			ret = rte_fib_select_lookup(fib,
+				RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX2);
 		else
 			ret = -EINVAL;
 		if (ret != 0) {
@@ -925,31 +1286,46 @@ run_v4(void)
 		}
 	}
 
-	acc = 0;
-	for (i = 0; i < config.nb_lookup_ips; i += BURST_SZ) {
-		start = rte_rdtsc_precise();
-		ret = rte_fib_lookup_bulk(fib, tbl4 + i, fib_nh, BURST_SZ);
-		acc += rte_rdtsc_precise() - start;
-		if (ret != 0) {
-			printf("FIB lookup fails, err %d\n", ret);
+	if (config.nb_lookup_lcores > 1) {
+		ret = run_lookup_lcores("FIB", LOOKUP_FIB4, fib);
+		if (ret != 0)
 			return -ret;
-		}
-	}
-	printf("AVG FIB lookup %.1f\n", (double)acc / (double)i);
-
-	if (config.flags & CMP_FLAG) {
+	} else {
 		acc = 0;
 		for (i = 0; i < config.nb_lookup_ips; i += BURST_SZ) {
 			start = rte_rdtsc_precise();
-			ret = rte_lpm_lookup_bulk(lpm, tbl4 + i, lpm_nh,
+			ret = rte_fib_lookup_bulk(fib, tbl4 + i, fib_nh,
 				BURST_SZ);
 			acc += rte_rdtsc_precise() - start;
 			if (ret != 0) {
-				printf("LPM lookup fails, err %d\n", ret);
+				printf("FIB lookup fails, err %d\n", ret);
 				return -ret;
 			}
 		}
-		printf("AVG LPM lookup %.1f\n", (double)acc / (double)i);
+		printf("AVG FIB lookup %.1f\n", (double)acc / (double)i);
+	}
+
+	if (config.flags & CMP_FLAG) {
+		if (config.nb_lookup_lcores > 1) {
+			ret = run_lookup_lcores("LPM", LOOKUP_LPM4, lpm);
+			if (ret != 0)
+				return -ret;
+		} else {
+			acc = 0;
+			for (i = 0; i < config.nb_lookup_ips; i += BURST_SZ) {
+				start = rte_rdtsc_precise();
+				ret = rte_lpm_lookup_bulk(lpm, tbl4 + i,
+					lpm_nh, BURST_SZ);
+				acc += rte_rdtsc_precise() - start;
+				if (ret != 0) {
+					printf("LPM lookup fails, err %d\n",
+						ret);
+					return -ret;
+				}
+			}
+			printf("AVG LPM lookup %.1f\n",
+				(double)acc / (double)i);
+		}
 
 		for (i = 0; i < config.nb_lookup_ips; i += BURST_SZ) {
 			rte_fib_lookup_bulk(fib, tbl4 + i, fib_nh, BURST_SZ);
@@ -1120,33 +1496,47 @@ run_v6(void)
 		}
 	}
 
-	acc = 0;
-	for (i = 0; i < config.nb_lookup_ips; i += BURST_SZ) {
-		start = rte_rdtsc_precise();
-		ret = rte_fib6_lookup_bulk(fib, &tbl6[i],
-			fib_nh, BURST_SZ);
-		acc += rte_rdtsc_precise() - start;
-		if (ret != 0) {
-			printf("FIB lookup fails, err %d\n", ret);
+	if (config.nb_lookup_lcores > 1) {
+		ret = run_lookup_lcores("FIB", LOOKUP_FIB6, fib);
+		if (ret != 0)
 			return -ret;
-		}
-	}
-	printf("AVG FIB lookup %.1f\n", (double)acc / (double)i);
-
-	if (config.flags & CMP_FLAG) {
+	} else {
 		acc = 0;
 		for (i = 0; i < config.nb_lookup_ips; i += BURST_SZ) {
 			start = rte_rdtsc_precise();
-			ret = rte_lpm6_lookup_bulk_func(lpm,
-				&tbl6[i],
-				lpm_nh, BURST_SZ);
+			ret = rte_fib6_lookup_bulk(fib, &tbl6[i],
+				fib_nh, BURST_SZ);
 			acc += rte_rdtsc_precise() - start;
 			if (ret != 0) {
-				printf("LPM lookup fails, err %d\n", ret);
+				printf("FIB lookup fails, err %d\n", ret);
+				return -ret;
+			}
+		}
+		printf("AVG FIB lookup %.1f\n", (double)acc / (double)i);
+	}
+
+	if (config.flags & CMP_FLAG) {
+		if (config.nb_lookup_lcores > 1) {
+			ret = run_lookup_lcores("LPM", LOOKUP_LPM6, lpm);
+			if (ret != 0)
 				return -ret;
+		} else {
+			acc = 0;
+			for (i = 0; i < config.nb_lookup_ips; i += BURST_SZ) {
+				start = rte_rdtsc_precise();
+				ret = rte_lpm6_lookup_bulk_func(lpm,
+					&tbl6[i],
+					lpm_nh, BURST_SZ);
+				acc += rte_rdtsc_precise() - start;
+				if (ret != 0) {
+					printf("LPM lookup fails, err %d\n",
+						ret);
+					return -ret;
+				}
 			}
+			printf("AVG LPM lookup %.1f\n",
+				(double)acc / (double)i);
 		}
-		printf("AVG LPM lookup %.1f\n", (double)acc / (double)i);
 
 		for (i = 0; i < config.nb_lookup_ips; i += BURST_SZ) {
 			rte_fib6_lookup_bulk(fib,
@@ -1229,8 +1619,17 @@ main(int argc, char **argv)
 				config.routes_file);
 
 		config.nb_routes = 0;
-		while (fgets(line, sizeof(line), fr) != NULL)
-			config.nb_routes++;
+		if (config.flags & MRT_FLAG) {
+			ret = parse_mrt(fr, af, 0);
+			if (ret <= 0)
+				rte_exit(ret < 0 ? -ret : EINVAL,
+					"failed to parse MRT file %s\n",
+					config.routes_file);
+			config.nb_routes = ret;
+		} else {
+			while (fgets(line, sizeof(line), fr) != NULL)
+				config.nb_routes++;
+		}
 
 		if (config.nb_routes < config.print_fract)
 			config.print_fract = config.nb_routes;
@@ -1249,6 +1648,12 @@ main(int argc, char **argv)
 		while (fgets(line, sizeof(line), fl) != NULL)
 			config.nb_lookup_ips++;
 		rewind(fl);
+	} else if ((config.lookup_pattern == LOOKUP_RND) &&
+			!(config.flags & LOOKUP_NUM_FLAG)) {
+		/* make the random lookups miss the cache */
+		config.nb_lookup_ips = RTE_MAX(config.nb_lookup_ips,
+			RTE_ALIGN_CEIL(LLC_LOOKUP_RATIO * get_llc_size() /
+			lookup_ent_sz, BURST_SZ));
 	}
 
 	/* Alloc routes table*/
@@ -1287,7 +1692,9 @@ main(int argc, char **argv)
 				shuffle_rt_6(config.rt, config.nb_routes);
 		}
 	} else {
-		if (af == AF_INET)
+		if (config.flags & MRT_FLAG)
+			ret = RTE_MIN(parse_mrt(fr, af, 1), 0);
+		else if (af == AF_INET)
 			ret = parse_rt_4(fr);
 		else
 			ret = parse_rt_6(fr);
@@ -1299,9 +1706,11 @@ main(int argc, char **argv)
 	}
 
 	/* Fill lookup table with ip's*/
-	if (fl == NULL)
-		gen_rnd_lookup_tbl(af);
-	else {
+	if (fl == NULL) {
+		ret = gen_rnd_lookup_tbl(af);
+		if (ret != 0)
+			rte_exit(-ret, "Can not generate lookup table\n");
+	} else {
 		ret = parse_lookup(fl, af);
 		if (ret != 0)
 			rte_exit(-ret, "failed to parse lookup file\n");
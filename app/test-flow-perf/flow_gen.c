@@ -7,6 +7,9 @@
  *
  * After the generation. The rule goes to validation then
  * creation state and then return the results.
+ *
+ * The rules can also be enqueued to the flow queues of a port,
+ * in a template table built from the same items and actions.
  */
 
 #include <stdint.h>
@@ -74,3 +77,119 @@ generate_flow(uint16_t port_id,
 	flow = rte_flow_create(port_id, &attr, items, actions, error);
 	return flow;
 }
+
+struct rte_flow_template_table *
+generate_template_table(uint16_t port_id,
+	uint16_t group,
+	uint64_t *flow_attrs,
+	uint64_t *flow_items,
+	uint64_t *flow_actions,
+	uint16_t next_table,
+	uint16_t hairpinq,
+	uint64_t encap_data,
+	uint64_t decap_data,
+	uint16_t dst_port,
+	uint8_t rx_queues_count,
+	bool unique_data,
+	uint32_t nb_flows,
+	struct rte_flow_error *error)
+{
+	struct rte_flow_pattern_template_attr pattern_attr;
+	struct rte_flow_actions_template_attr actions_attr;
+	struct rte_flow_template_table_attr table_attr;
+	struct rte_flow_item items[MAX_ITEMS_NUM];
+	struct rte_flow_action actions[MAX_ACTIONS_NUM];
+	struct rte_flow_action masks[MAX_ACTIONS_NUM];
+	struct rte_flow_pattern_template *pattern_template;
+	struct rte_flow_actions_template *actions_template;
+	struct rte_flow_template_table *table;
+	uint8_t i;
+
+	memset(items, 0, sizeof(items));
+	memset(actions, 0, sizeof(actions));
+	memset(masks, 0, sizeof(masks));
+	memset(&pattern_attr, 0, sizeof(pattern_attr));
+	memset(&actions_attr, 0, sizeof(actions_attr));
+	memset(&table_attr, 0, sizeof(table_attr));
+
+	/* All the rules of a table share one priority */
+	fill_attributes(&table_attr.flow_attr, flow_attrs, group, 1);
+	table_attr.nb_flows = nb_flows;
+	pattern_attr.ingress = table_attr.flow_attr.ingress;
+	pattern_attr.egress = table_attr.flow_attr.egress;
+	pattern_attr.transfer = table_attr.flow_attr.transfer;
+	actions_attr.ingress = table_attr.flow_attr.ingress;
+	actions_attr.egress = table_attr.flow_attr.egress;
+	actions_attr.transfer = table_attr.flow_attr.transfer;
+
+	fill_items(items, flow_items, 0, 0);
+	fill_actions(actions, flow_actions, 0, next_table, hairpinq,
+		encap_data, decap_data, 0, unique_data, rx_queues_count,
+		dst_port);
+
+	/* Actions configuration is given by each rule */
+	for (i = 0; i < MAX_ACTIONS_NUM; i++) {
+		masks[i].type = actions[i].type;
+		if (actions[i].type == RTE_FLOW_ACTION_TYPE_END)
+			break;
+	}
+
+	pattern_template = rte_flow_pattern_template_create(port_id,
+		&pattern_attr, items, error);
+	if (pattern_template == NULL)
+		return NULL;
+
+	actions_template = rte_flow_actions_template_create(port_id,
+		&actions_attr, actions, masks, error);
+	if (actions_template == NULL)
+		goto err_pattern;
+
+	table = rte_flow_template_table_create(port_id, &table_attr,
+		&pattern_template, 1, &actions_template, 1, error);
+	if (table == NULL)
+		goto err_actions;
+
+	return table;
+
+err_actions:
+	rte_flow_actions_template_destroy(port_id, actions_template, NULL);
+err_pattern:
+	rte_flow_pattern_template_destroy(port_id, pattern_template, NULL);
+	return NULL;
+}
+
+struct rte_flow *
+generate_async_flow(uint16_t port_id,
+	uint32_t queue_id,
+	struct rte_flow_template_table *table,
+	uint64_t *flow_items,
+	uint64_t *flow_actions,
+	uint16_t next_table,
+	uint32_t outer_ip_src,
+	uint16_t hairpinq,
+	uint64_t encap_data,
+	uint64_t decap_data,
+	uint16_t dst_port,
+	uint8_t core_idx,
+	uint8_t rx_queues_count,
+	bool unique_data,
+	void *user_data,
+	struct rte_flow_error *error)
+{
+	const struct rte_flow_op_attr op_attr = { .postpone = 1 };
+	struct rte_flow_item items[MAX_ITEMS_NUM];
+	struct rte_flow_action actions[MAX_ACTIONS_NUM];
+
+	memset(items, 0, sizeof(items));
+	memset(actions, 0, sizeof(actions));
+
+	fill_actions(actions, flow_actions,
+		outer_ip_src, next_table, hairpinq,
+		encap_data, decap_data, core_idx,
+		unique_data, rx_queues_count, dst_port);
+
+	fill_items(items, flow_items, outer_ip_src, core_idx);
+
+	return rte_flow_async_create(port_id, queue_id, &op_attr, table,
+		items, 0, actions, 0, user_data, error);
+}
@@ -14,6 +14,11 @@
  * results, after that the application will go into forwarding packets mode
  * it will start receiving traffic if any and then forwarding it back and
  * gives packet per second measurement.
+ *
+ * In churn mode, the rules are instead inserted, deleted and queried
+ * continuously through the asynchronous flow queues while packets are
+ * forwarded, to measure the rule update latencies and the impact
+ * on the forwarding throughput.
  */
 
 #include <locale.h>
@@ -29,6 +34,7 @@
 #include <signal.h>
 #include <unistd.h>
 
+#include <rte_bitops.h>
 #include <rte_malloc.h>
 #include <rte_mempool.h>
 #include <rte_mbuf.h>
@@ -99,10 +105,12 @@ static uint32_t nb_lcores;
 static uint8_t max_priority;
 static uint32_t rand_seed;
 static uint64_t meter_profile_values[3]; /* CIR CBS EBS values. */
+static uint32_t churn_time; /* seconds of churn workload, 0 if disabled */
 
 #define MAX_PKT_BURST    32
 #define LCORE_MODE_PKT    1
 #define LCORE_MODE_STATS  2
+#define LCORE_MODE_CHURN  3
 #define MAX_STREAMS      64
 #define METER_CREATE	  1
 #define METER_DELETE	  2
@@ -116,6 +124,7 @@ struct stream {
 
 struct __rte_cache_aligned lcore_info {
 	int mode;
+	uint8_t churn_idx; /* index of the flow queue used in churn mode */
 	int streams_nb;
 	struct stream streams[MAX_STREAMS];
 	/* stats */
@@ -146,6 +155,49 @@ static struct multi_cores_pool mc_pool = {
 	.cores_count = 1,
 };
 
+#define CHURN_QUEUE_SIZE     1024
+#define CHURN_BURST            32
+#define CHURN_WARMUP_SEC        1
+#define CHURN_HIST_SUB_BITS     3
+#define CHURN_HIST_BUCKETS   (64 << CHURN_HIST_SUB_BITS)
+
+enum churn_op {
+	CHURN_OP_INSERT,
+	CHURN_OP_DELETE,
+	CHURN_OP_QUERY,
+	CHURN_OP_NUM,
+};
+
+static const char * const churn_op_names[CHURN_OP_NUM] = {
+	[CHURN_OP_INSERT] = "insertion",
+	[CHURN_OP_DELETE] = "deletion",
+	[CHURN_OP_QUERY] = "query",
+};
+
+/* Pending operation of a flow queue */
+struct churn_op_ctx {
+	uint64_t start;
+	enum churn_op op;
+	struct rte_flow **flow;
+};
+
+/* Rules and latency histograms of a churn core */
+struct churn_core {
+	struct rte_flow **flows[MAX_PORTS];
+	uint64_t failures;
+	uint64_t hist[CHURN_OP_NUM][CHURN_HIST_BUCKETS];
+};
+
+/* Template table of a port in churn mode */
+static struct churn_port {
+	struct rte_flow_template_table *table;
+	uint16_t dst_port;
+} churn_ports[MAX_PORTS];
+
+static struct churn_core *churn_cores[RTE_MAX_LCORE];
+static RTE_ATOMIC(uint32_t) churn_ready;
+static volatile bool churn_running;
+
 static const struct option_dict {
 	const char *str;
 	const uint64_t mask;
@@ -494,6 +546,8 @@ usage(char *progname)
 	printf("  --dump-socket-mem: To dump all socket memory\n");
 	printf("  --enable-fwd: To enable packets forwarding"
 		" after insertion\n");
+	printf("  --churn=N: insert, delete and query rules through flow"
+		" queues for N seconds while forwarding packets\n");
 	printf("  --portmask=N: hexadecimal bitmask of ports used\n");
 	printf("  --hairpin-conf=0xXXXX: hexadecimal bitmask of hairpin queue configuration\n");
 	printf("  --random-priority=N,S: use random priority levels "
@@ -663,6 +717,7 @@ args_parse(int argc, char **argv)
 		{ "query-rate",                 0, 0, 0 },
 		{ "dump-socket-mem",            0, 0, 0 },
 		{ "enable-fwd",                 0, 0, 0 },
+		{ "churn",                      1, 0, 0 },
 		{ "unique-data",                0, 0, 0 },
 		{ "portmask",                   1, 0, 0 },
 		{ "hairpin-conf",               1, 0, 0 },
@@ -897,6 +952,13 @@ args_parse(int argc, char **argv)
 			if (strcmp(lgopts[opt_idx].name,
 					"enable-fwd") == 0)
 				enable_fwd = true;
+			if (strcmp(lgopts[opt_idx].name, "churn") == 0) {
+				n = atoi(optarg);
+				if (n <= 0)
+					rte_exit(EXIT_FAILURE,
+						"churn time should be > 0\n");
+				churn_time = n;
+			}
 			if (strcmp(lgopts[opt_idx].name,
 					"portmask") == 0) {
 				/* parse hexadecimal string */
@@ -1086,20 +1148,25 @@ print_rules_batches(double *cpu_time_per_batch)
 }
 
 static inline int
-has_meter(void)
+has_action(enum rte_flow_action_type type)
 {
 	int i;
 
 	for (i = 0; i < MAX_ACTIONS_NUM; i++) {
 		if (flow_actions[i] == 0)
 			break;
-		if (flow_actions[i]
-				& FLOW_ACTION_MASK(RTE_FLOW_ACTION_TYPE_METER))
+		if (flow_actions[i] & FLOW_ACTION_MASK(type))
 			return 1;
 	}
 	return 0;
 }
 
+static inline int
+has_meter(void)
+{
+	return has_action(RTE_FLOW_ACTION_TYPE_METER);
+}
+
 static void
 create_meter_policy(void)
 {
@@ -1822,6 +1889,65 @@ run_rte_flow_handler_cores(void *data __rte_unused)
 	return 0;
 }
 
+static void
+create_churn_tables(void)
+{
+	uint64_t global_items[MAX_ITEMS_NUM] = { 0 };
+	uint64_t global_actions[MAX_ACTIONS_NUM] = { 0 };
+	struct rte_flow_template_table *table;
+	struct rte_flow_op_result res;
+	struct rte_flow_error error;
+	uint16_t port_idx = 0;
+	uint16_t port_id;
+	int ret;
+
+	global_items[0] = FLOW_ITEM_MASK(RTE_FLOW_ITEM_TYPE_ETH);
+	global_actions[0] = FLOW_ITEM_MASK(RTE_FLOW_ACTION_TYPE_JUMP);
+
+	RTE_ETH_FOREACH_DEV(port_id) {
+		/* If port outside portmask */
+		if (!((ports_mask >> port_id) & 0x1))
+			continue;
+		churn_ports[port_id].dst_port = dst_ports[port_idx++];
+
+		if (flow_group > 0) {
+			/*
+			 * Global rule to jump into flow_group:
+			 * group 0 eth / end actions jump group <flow_group>
+			 */
+			table = generate_template_table(port_id, 0, flow_attrs,
+				global_items, global_actions, flow_group, 0, 0,
+				0, churn_ports[port_id].dst_port,
+				rx_queues_count, unique_data, 1, &error);
+			if (table == NULL ||
+			    generate_async_flow(port_id, 0, table, global_items,
+					global_actions, flow_group, 0, 0, 0, 0,
+					churn_ports[port_id].dst_port, 0,
+					rx_queues_count, unique_data, NULL,
+					&error) == NULL ||
+			    rte_flow_push(port_id, 0, &error)) {
+				print_flow_error(error);
+				rte_exit(EXIT_FAILURE, "Error in creating flow\n");
+			}
+			do {
+				ret = rte_flow_pull(port_id, 0, &res, 1, &error);
+			} while (ret == 0);
+			if (ret < 0 || res.status != RTE_FLOW_OP_SUCCESS)
+				rte_exit(EXIT_FAILURE, "Error in creating flow\n");
+		}
+
+		churn_ports[port_id].table = generate_template_table(port_id,
+			flow_group, flow_attrs, flow_items, flow_actions,
+			JUMP_ACTION_TABLE, hairpin_queues_num, encap_data,
+			decap_data, churn_ports[port_id].dst_port,
+			rx_queues_count, unique_data, rules_count, &error);
+		if (churn_ports[port_id].table == NULL) {
+			print_flow_error(error);
+			rte_exit(EXIT_FAILURE, "Error in creating template table\n");
+		}
+	}
+}
+
 static void
 signal_handler(int signum)
 {
@@ -1922,6 +2048,295 @@ packet_per_second_stats(void)
 	}
 }
 
+static inline unsigned int
+churn_hist_idx(uint64_t cycles)
+{
+	unsigned int msb;
+
+	/* 8 linear sub-buckets for each power of 2 */
+	if (cycles < (1 << CHURN_HIST_SUB_BITS))
+		return cycles;
+	msb = rte_fls_u64(cycles) - 1;
+	return ((msb - CHURN_HIST_SUB_BITS + 1) << CHURN_HIST_SUB_BITS) |
+		((cycles >> (msb - CHURN_HIST_SUB_BITS)) &
+		 ((1 << CHURN_HIST_SUB_BITS) - 1));
+}
+
+static inline uint64_t
+churn_hist_val(unsigned int idx)
+{
+	unsigned int shift;
+
+	if (idx < (1 << CHURN_HIST_SUB_BITS))
+		return idx;
+	shift = (idx >> CHURN_HIST_SUB_BITS) - 1;
+	return ((uint64_t)(idx & ((1 << CHURN_HIST_SUB_BITS) - 1)) |
+		(1 << CHURN_HIST_SUB_BITS)) << shift;
+}
+
+/* Push the enqueued operations and wait for all of them to complete */
+static void
+churn_pull(uint16_t port_id, uint32_t queue_id, struct churn_core *cc,
+	uint32_t pending)
+{
+	struct rte_flow_op_result res[CHURN_BURST];
+	struct rte_flow_error error;
+	struct churn_op_ctx *ctx;
+	uint64_t now;
+	int i, n;
+
+	if (rte_flow_push(port_id, queue_id, &error)) {
+		print_flow_error(error);
+		rte_exit(EXIT_FAILURE, "Error in pushing flow operations\n");
+	}
+
+	while (pending != 0) {
+		n = rte_flow_pull(port_id, queue_id, res, CHURN_BURST, &error);
+		if (n < 0) {
+			print_flow_error(error);
+			rte_exit(EXIT_FAILURE, "Error in pulling flow operations\n");
+		}
+
+		now = rte_get_timer_cycles();
+		for (i = 0; i < n; i++) {
+			ctx = res[i].user_data;
+			if (res[i].status != RTE_FLOW_OP_SUCCESS) {
+				cc->failures++;
+				if (ctx->op == CHURN_OP_INSERT)
+					*ctx->flow = NULL;
+				continue;
+			}
+			if (ctx->op == CHURN_OP_DELETE)
+				*ctx->flow = NULL;
+			cc->hist[ctx->op][churn_hist_idx(now - ctx->start)]++;
+		}
+		pending -= n;
+	}
+}
+
+/* Destroy then re-insert the rules of nb slots from slot base */
+static void
+churn_burst(uint16_t port_id, uint8_t churn_idx, struct churn_core *cc,
+	uint32_t nb_slots, uint32_t base, uint32_t nb, bool destroy)
+{
+	const struct rte_flow_op_attr op_attr = { .postpone = 1 };
+	struct churn_op_ctx ctx[CHURN_BURST];
+	struct rte_flow **flows = cc->flows[port_id];
+	struct rte_flow_error error;
+	uint32_t pending = 0;
+	uint32_t i, slot;
+
+	if (destroy) {
+		for (i = 0; i < nb; i++) {
+			slot = (base + i) % nb_slots;
+			if (flows[slot] == NULL)
+				continue;
+			ctx[i].op = CHURN_OP_DELETE;
+			ctx[i].flow = &flows[slot];
+			ctx[i].start = rte_get_timer_cycles();
+			if (rte_flow_async_destroy(port_id, churn_idx, &op_attr,
+					flows[slot], &ctx[i], &error))
+				cc->failures++;
+			else
+				pending++;
+		}
+		churn_pull(port_id, churn_idx, cc, pending);
+		pending = 0;
+	}
+
+	for (i = 0; i < nb; i++) {
+		slot = (base + i) % nb_slots;
+		if (flows[slot] != NULL)
+			continue;
+		ctx[i].op = CHURN_OP_INSERT;
+		ctx[i].flow = &flows[slot];
+		ctx[i].start = rte_get_timer_cycles();
+		flows[slot] = generate_async_flow(port_id, churn_idx,
+			churn_ports[port_id].table, flow_items, flow_actions,
+			JUMP_ACTION_TABLE, churn_idx * nb_slots + slot,
+			hairpin_queues_num, encap_data, decap_data,
+			churn_ports[port_id].dst_port, churn_idx,
+			rx_queues_count, unique_data, &ctx[i], &error);
+		if (flows[slot] == NULL)
+			cc->failures++;
+		else
+			pending++;
+	}
+	churn_pull(port_id, churn_idx, cc, pending);
+}
+
+static void
+churn_query(uint16_t port_id, struct churn_core *cc, uint32_t nb_slots)
+{
+	struct rte_flow *rule = cc->flows[port_id][rte_rand_max(nb_slots)];
+	struct rte_flow_query_count count;
+	struct rte_flow_error error;
+	struct rte_flow_action count_action[] = {
+		{
+			.type = RTE_FLOW_ACTION_TYPE_COUNT,
+			.conf = NULL,
+		},
+		{
+			.type = RTE_FLOW_ACTION_TYPE_END,
+		},
+	};
+	uint64_t start;
+
+	if (rule == NULL)
+		return;
+
+	memset(&count, 0, sizeof(count));
+	start = rte_get_timer_cycles();
+	if (rte_flow_query(port_id, rule, count_action, &count, &error))
+		cc->failures++;
+	else
+		cc->hist[CHURN_OP_QUERY][churn_hist_idx(rte_get_timer_cycles() -
+			start)]++;
+}
+
+static void
+churn_rules(struct lcore_info *li)
+{
+	struct churn_core *cc;
+	uint32_t nb_slots, nb, slot;
+	uint16_t port_id;
+
+	nb_slots = rules_count / mc_pool.cores_count;
+	nb = RTE_MIN(nb_slots, (uint32_t)CHURN_BURST);
+
+	cc = rte_zmalloc("churn_core", sizeof(*cc), RTE_CACHE_LINE_SIZE);
+	if (cc == NULL)
+		rte_exit(EXIT_FAILURE, "No Memory available!\n");
+	churn_cores[li->churn_idx] = cc;
+
+	/* Fill the tables before measuring */
+	RTE_ETH_FOREACH_DEV(port_id) {
+		if (!((ports_mask >> port_id) & 0x1))
+			continue;
+
+		cc->flows[port_id] = rte_zmalloc("churn_flows",
+			sizeof(struct rte_flow *) * nb_slots, 0);
+		if (cc->flows[port_id] == NULL)
+			rte_exit(EXIT_FAILURE, "No Memory available!\n");
+
+		for (slot = 0; slot < nb_slots && !force_quit; slot += nb)
+			churn_burst(port_id, li->churn_idx, cc, nb_slots, slot,
+				RTE_MIN(nb, nb_slots - slot), false);
+	}
+	cc->failures = 0;
+	memset(cc->hist, 0, sizeof(cc->hist));
+
+	rte_atomic_fetch_add_explicit(&churn_ready, 1, rte_memory_order_release);
+	while (!churn_running && !force_quit)
+		rte_pause();
+
+	while (churn_running && !force_quit) {
+		RTE_ETH_FOREACH_DEV(port_id) {
+			if (cc->flows[port_id] == NULL)
+				continue;
+
+			churn_burst(port_id, li->churn_idx, cc, nb_slots,
+				rte_rand_max(nb_slots), nb, true);
+			if (query_flag)
+				churn_query(port_id, cc, nb_slots);
+		}
+	}
+}
+
+static uint64_t
+churn_tx_pkts(void)
+{
+	uint64_t tx_pkts = 0;
+	int i;
+
+	for (i = 0; i < RTE_MAX_LCORE; i++)
+		if (lcore_infos[i].mode == LCORE_MODE_PKT)
+			tx_pkts += lcore_infos[i].tx_pkts;
+	return tx_pkts;
+}
+
+static void
+churn_print_latency(int op, double elapsed)
+{
+	static const double percentiles[] = { 50, 90, 99, 99.9 };
+	uint64_t hist[CHURN_HIST_BUCKETS] = { 0 };
+	uint64_t total = 0, sum;
+	double us_per_cycle;
+	unsigned int i, p, idx;
+
+	for (i = 0; i < mc_pool.cores_count; i++)
+		for (idx = 0; idx < CHURN_HIST_BUCKETS; idx++)
+			hist[idx] += churn_cores[i]->hist[op][idx];
+	for (idx = 0; idx < CHURN_HIST_BUCKETS; idx++)
+		total += hist[idx];
+	if (total == 0)
+		return;
+
+	us_per_cycle = (double)US_PER_S / rte_get_timer_hz();
+	printf(":: %-9s :: %" PRIu64 " ops :: %.1f K ops/sec ::",
+		churn_op_names[op], total, total / elapsed / 1000);
+
+	/* Report the upper bound of the bucket holding the percentile */
+	sum = 0;
+	idx = 0;
+	for (p = 0; p < RTE_DIM(percentiles); p++) {
+		while (sum + hist[idx] < total * percentiles[p] / 100)
+			sum += hist[idx++];
+		printf(" p%g %.2f us", percentiles[p],
+			churn_hist_val(idx + 1) * us_per_cycle);
+	}
+	printf("\n");
+}
+
+static void
+churn_stats(void)
+{
+	uint64_t start_pkts, start_tsc, failures = 0;
+	double baseline, churn_rate, elapsed;
+	uint32_t i;
+	int op;
+
+	while (rte_atomic_load_explicit(&churn_ready,
+			rte_memory_order_acquire) < mc_pool.cores_count) {
+		if (force_quit)
+			return;
+		rte_delay_us_sleep(1000);
+	}
+
+	printf(":: %u rules per port installed, measuring forwarding rate\n",
+		rules_count / mc_pool.cores_count * mc_pool.cores_count);
+	start_pkts = churn_tx_pkts();
+	rte_delay_us_sleep(CHURN_WARMUP_SEC * US_PER_S);
+	baseline = (double)(churn_tx_pkts() - start_pkts) / CHURN_WARMUP_SEC;
+
+	printf(":: churning rules for %u seconds on %u cores\n",
+		churn_time, mc_pool.cores_count);
+	start_pkts = churn_tx_pkts();
+	start_tsc = rte_get_timer_cycles();
+	churn_running = true;
+	for (i = 0; i < churn_time && !force_quit; i++)
+		rte_delay_us_sleep(US_PER_S);
+	elapsed = (double)(rte_get_timer_cycles() - start_tsc) /
+		rte_get_timer_hz();
+	churn_rate = (double)(churn_tx_pkts() - start_pkts) / elapsed;
+	churn_running = false;
+	force_quit = true;
+
+	/* Wait for the churn cores to complete their last operations */
+	rte_eal_mp_wait_lcore();
+
+	for (op = 0; op < CHURN_OP_NUM; op++)
+		churn_print_latency(op, elapsed);
+	for (i = 0; i < mc_pool.cores_count; i++)
+		failures += churn_cores[i]->failures;
+	printf(":: failed operations :: %" PRIu64 "\n", failures);
+	printf(":: forwarding :: %.3f Mpps before churn :: %.3f Mpps during churn",
+		baseline / 1000000, churn_rate / 1000000);
+	if (baseline != 0)
+		printf(" :: %+.2f%%", (churn_rate - baseline) * 100 / baseline);
+	printf("\n");
+}
+
 static int
 start_forwarding(void *data __rte_unused)
 {
@@ -1935,7 +2350,16 @@ start_forwarding(void *data __rte_unused)
 
 	if (li->mode == LCORE_MODE_STATS) {
 		printf(":: started stats on lcore %u\n", lcore);
-		packet_per_second_stats();
+		if (churn_time)
+			churn_stats();
+		else
+			packet_per_second_stats();
+		return 0;
+	}
+
+	if (li->mode == LCORE_MODE_CHURN) {
+		printf(":: started rules churn on lcore %u\n", lcore);
+		churn_rules(li);
 		return 0;
 	}
 
@@ -1956,7 +2380,7 @@ start_forwarding(void *data __rte_unused)
 }
 
 static void
-init_lcore_info(void)
+init_lcore_info(uint32_t nr_lcores)
 {
 	int i, j;
 	unsigned int lcore;
@@ -1995,15 +2419,15 @@ init_lcore_info(void)
 	 * stats prints.
 	 */
 	nb_fwd_streams = nr_port * rx_queues_count;
-	if ((int)(nb_lcores - 1) >= nb_fwd_streams)
-		for (i = 0; i < (int)(nb_lcores - 1); i++) {
+	if ((int)(nr_lcores - 1) >= nb_fwd_streams)
+		for (i = 0; i < (int)(nr_lcores - 1); i++) {
 			lcore = rte_get_next_lcore(lcore, 0, 0);
 			lcore_infos[lcore].streams_nb = 1;
 		}
 	else {
-		streams_per_core = nb_fwd_streams / (nb_lcores - 1);
-		unassigned_streams = nb_fwd_streams % (nb_lcores - 1);
-		for (i = 0; i < (int)(nb_lcores - 1); i++) {
+		streams_per_core = nb_fwd_streams / (nr_lcores - 1);
+		unassigned_streams = nb_fwd_streams % (nr_lcores - 1);
+		for (i = 0; i < (int)(nr_lcores - 1); i++) {
 			lcore = rte_get_next_lcore(lcore, 0, 0);
 			lcore_infos[lcore].streams_nb = streams_per_core;
 			if (unassigned_streams) {
@@ -2039,6 +2463,18 @@ init_lcore_info(void)
 		}
 	}
 
+	/* The cores left churn the rules, one flow queue each */
+	if (churn_time) {
+		lcore = rte_get_next_lcore(-1, 0, 0);
+		for (i = 1; i < (int)nr_lcores; i++)
+			lcore = rte_get_next_lcore(lcore, 0, 0);
+		for (i = 0; i < (int)mc_pool.cores_count; i++) {
+			lcore = rte_get_next_lcore(lcore, 0, 0);
+			lcore_infos[lcore].mode = LCORE_MODE_CHURN;
+			lcore_infos[lcore].churn_idx = i;
+		}
+	}
+
 	/* Print all streams */
 	printf(":: Stream -> core id[N]: (rx_port, rx_queue)->(tx_port, tx_queue)\n");
 	for (i = 0; i < RTE_MAX_LCORE; i++)
@@ -2212,6 +2648,29 @@ init_port(void)
 			}
 		}
 
+		if (churn_time) {
+			const struct rte_flow_queue_attr queue_attr = {
+				.size = CHURN_QUEUE_SIZE,
+			};
+			const struct rte_flow_queue_attr *queue_attrs[RTE_MAX_LCORE];
+			struct rte_flow_port_attr port_attr = {
+				.nb_counters = has_action(RTE_FLOW_ACTION_TYPE_COUNT) ?
+					rules_count : 0,
+			};
+			struct rte_flow_error error;
+
+			for (std_queue = 0; std_queue < mc_pool.cores_count; std_queue++)
+				queue_attrs[std_queue] = &queue_attr;
+			ret = rte_flow_configure(port_id, &port_attr,
+				mc_pool.cores_count, queue_attrs, &error);
+			if (ret != 0) {
+				print_flow_error(error);
+				rte_exit(EXIT_FAILURE,
+					":: flow queues configuration failed: err=%d, port=%u\n",
+					ret, port_id);
+			}
+		}
+
 		ret = rte_eth_dev_start(port_id);
 		if (ret < 0)
 			rte_exit(EXIT_FAILURE,
@@ -2277,11 +2736,25 @@ main(int argc, char **argv)
 		if (policy_mtr)
 			create_meter_policy();
 	}
-	rte_eal_mp_remote_launch(run_rte_flow_handler_cores, NULL, CALL_MAIN);
-
-	if (enable_fwd) {
-		init_lcore_info();
+	if (churn_time) {
+		if (nb_lcores < mc_pool.cores_count + 2)
+			rte_exit(EXIT_FAILURE,
+				"Churn mode needs %u cores: stats, forwarding and %u churn cores\n",
+				mc_pool.cores_count + 2, mc_pool.cores_count);
+		if (has_meter() || rules_count < mc_pool.cores_count)
+			rte_exit(EXIT_FAILURE,
+				"Churn mode needs a rule per core and no meter\n");
+		create_churn_tables();
+		init_lcore_info(nb_lcores - mc_pool.cores_count);
 		rte_eal_mp_remote_launch(start_forwarding, NULL, CALL_MAIN);
+	} else {
+		rte_eal_mp_remote_launch(run_rte_flow_handler_cores, NULL,
+			CALL_MAIN);
+
+		if (enable_fwd) {
+			init_lcore_info(nb_lcores);
+			rte_eal_mp_remote_launch(start_forwarding, NULL, CALL_MAIN);
+		}
 	}
 	if (has_meter() && delete_flag) {
 		destroy_meter_profile();
@@ -421,6 +421,88 @@ create_update_comm_list(uint16_t gpu_id)
 	return -1;
 }
 
+static int
+create_update_comm_ring(uint16_t gpu_id)
+{
+	struct rte_gpu_comm_ring *comm_ring = NULL;
+	enum rte_gpu_comm_list_status status[10];
+	struct rte_mbuf *mbufs[10], *done[10];
+	uint32_t ring_size = 8;
+	uint32_t num;
+	int i = 0;
+
+	printf("\n=======> TEST: Communication ring\n\n");
+
+	comm_ring = rte_gpu_comm_create_ring(gpu_id, ring_size);
+	if (comm_ring == NULL) {
+		fprintf(stderr, "rte_gpu_comm_create_ring returned error %d\n", rte_errno);
+		goto error;
+	}
+
+	for (i = 0; i < 10; i++) {
+		mbufs[i] = rte_zmalloc(NULL, sizeof(struct rte_mbuf), 0);
+		if (mbufs[i] == NULL) {
+			fprintf(stderr, "Failed to allocate fake mbufs in CPU memory.\n");
+			goto error;
+		}
+	}
+
+	num = rte_gpu_comm_enqueue_burst(comm_ring, mbufs, 10);
+	if (num != ring_size) {
+		fprintf(stderr, "rte_gpu_comm_enqueue_burst enqueued %u packets in a ring of %u\n",
+				num, ring_size);
+		goto error;
+	}
+
+	num = rte_gpu_comm_dequeue_burst(comm_ring, done, status, 10);
+	if (num != 0) {
+		fprintf(stderr, "rte_gpu_comm_dequeue_burst erroneously dequeued packets not consumed yet\n");
+		goto error;
+	}
+	printf("Communication ring not dequeued because packets have not been consumed yet.\n");
+
+	/*
+	 * Simulate a GPU task completing the packets up to the doorbell.
+	 * A real GPU workload should write the status and the consumer index
+	 * from GPU specific code.
+	 */
+	printf("Consuming packets...\n");
+	for (num = 0; num < *comm_ring->prod_h; num++)
+		comm_ring->status[num & (ring_size - 1)] = RTE_GPU_COMM_LIST_DONE;
+	rte_wmb();
+	RTE_GPU_VOLATILE(*comm_ring->cons) = *comm_ring->prod_h;
+
+	num = rte_gpu_comm_dequeue_burst(comm_ring, done, status, 10);
+	if (num != ring_size || done[0] != mbufs[0] ||
+			status[ring_size - 1] != RTE_GPU_COMM_LIST_DONE) {
+		fprintf(stderr, "rte_gpu_comm_dequeue_burst returned %u packets\n", num);
+		goto error;
+	}
+	printf("Communication ring dequeued because packets have been consumed now.\n");
+
+	num = rte_gpu_comm_enqueue_burst(comm_ring, &mbufs[ring_size], 10 - ring_size);
+	if (num != 10 - ring_size) {
+		fprintf(stderr, "rte_gpu_comm_enqueue_burst failed to reuse dequeued entries\n");
+		goto error;
+	}
+
+	rte_gpu_comm_destroy_ring(comm_ring);
+	for (i = 0; i < 10; i++)
+		rte_free(mbufs[i]);
+
+	printf("\n=======> TEST: PASSED\n");
+	return 0;
+
+error:
+
+	if (comm_ring != NULL)
+		rte_gpu_comm_destroy_ring(comm_ring);
+	while (i-- > 0)
+		rte_free(mbufs[i]);
+	printf("\n=======> TEST: FAILED\n");
+	return -1;
+}
+
 int
 main(int argc, char **argv)
 {
@@ -477,6 +559,7 @@ main(int argc, char **argv)
 	 */
 	create_update_comm_flag(gpu_id);
 	create_update_comm_list(gpu_id);
+	create_update_comm_ring(gpu_id);
 
 	/* clean up the EAL */
 	rte_eal_cleanup();
@@ -30,6 +30,8 @@ ml_options_default(struct ml_options *opt)
 	opt->queue_pairs = 1;
 	opt->queue_size = 1;
 	opt->tolerance = 0.0;
+	opt->batch_size = 1;
+	opt->batch_deadline = 0;
 	opt->stats = false;
 	opt->debug = false;
 }
@@ -221,6 +223,30 @@ ml_parse_tolerance(struct ml_options *opt, const char *arg)
 	return 0;
 }
 
+static int
+ml_parse_batch_size(struct ml_options *opt, const char *arg)
+{
+	int ret;
+
+	ret = parser_read_uint16(&opt->batch_size, arg);
+	if (ret != 0)
+		ml_err("Invalid option, batch_size = %s\n", arg);
+
+	return ret;
+}
+
+static int
+ml_parse_batch_deadline(struct ml_options *opt, const char *arg)
+{
+	int ret;
+
+	ret = parser_read_uint64(&opt->batch_deadline, arg);
+	if (ret != 0)
+		ml_err("Invalid option, batch_deadline = %s\n", arg);
+
+	return ret;
+}
+
 static void
 ml_dump_test_options(const char *testname)
 {
@@ -248,6 +274,19 @@ ml_dump_test_options(const char *testname)
 		       "\t\t--quantized_io     : skip input/output quantization\n");
 		printf("\n");
 	}
+
+	if (strcmp(testname, "inference_batched") == 0) {
+		printf("\t\t--filelist         : comma separated list of model, input, output and reference\n"
+		       "\t\t--repetitions      : number of inference repetitions per batch size\n"
+		       "\t\t--burst_size       : inferences in flight per worker\n"
+		       "\t\t--queue_size       : size of queue-pair\n"
+		       "\t\t--batch_size       : maximum number of inferences per request\n"
+		       "\t\t--batch_deadline   : maximum wait (us) of an inference before its request is sent\n"
+		       "\t\t--tolerance        : maximum tolerance (%%) for output validation\n"
+		       "\t\t--stats            : enable reporting device and model statistics\n"
+		       "\t\t--quantized_io     : skip input/output quantization\n");
+		printf("\n");
+	}
 }
 
 static void
@@ -277,6 +316,8 @@ static struct option lgopts[] = {
 	{ML_QUEUE_PAIRS, 1, 0, 0},
 	{ML_QUEUE_SIZE, 1, 0, 0},
 	{ML_TOLERANCE, 1, 0, 0},
+	{ML_BATCH_SIZE, 1, 0, 0},
+	{ML_BATCH_DEADLINE, 1, 0, 0},
 	{ML_STATS, 0, 0, 0},
 	{ML_DEBUG, 0, 0, 0},
 	{ML_HELP, 0, 0, 0},
@@ -298,6 +339,8 @@ ml_opts_parse_long(int opt_idx, struct ml_options *opt)
 		{ML_QUEUE_PAIRS, ml_parse_queue_pairs},
 		{ML_QUEUE_SIZE, ml_parse_queue_size},
 		{ML_TOLERANCE, ml_parse_tolerance},
+		{ML_BATCH_SIZE, ml_parse_batch_size},
+		{ML_BATCH_DEADLINE, ml_parse_batch_deadline},
 	};
 
 	for (i = 0; i < RTE_DIM(parsermap); i++) {
@@ -23,6 +23,8 @@
 #define ML_QUEUE_PAIRS	("queue_pairs")
 #define ML_QUEUE_SIZE	("queue_size")
 #define ML_TOLERANCE	("tolerance")
+#define ML_BATCH_SIZE	("batch_size")
+#define ML_BATCH_DEADLINE ("batch_deadline")
 #define ML_STATS	("stats")
 #define ML_DEBUG	("debug")
 #define ML_HELP		("help")
@@ -45,6 +47,8 @@ struct ml_options {
 	uint16_t queue_pairs;
 	uint16_t queue_size;
 	float tolerance;
+	uint16_t batch_size;
+	uint64_t batch_deadline;
 	bool stats;
 	bool debug;
 	bool quantized_io;
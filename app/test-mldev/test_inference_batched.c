@@ -0,0 +1,389 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_errno.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_mldev_batch.h>
+
+#include "ml_common.h"
+#include "test_inference_common.h"
+#include "test_stats.h"
+
+/* Prepare an inference of one batch unit */
+static int
+ml_batched_op_get(struct test_inference *t, uint16_t fid, struct rte_ml_op **op_ptr)
+{
+	struct ml_model *model = &t->model[fid];
+	struct ml_request *req;
+	struct rte_ml_op *op;
+	uint64_t offset;
+	uint64_t bufsz;
+	uint32_t i;
+
+	if (rte_mempool_get(t->op_pool, (void **)&op) != 0)
+		return -ENOBUFS;
+
+	if (rte_mempool_get(model->io_pool, (void **)&req) != 0)
+		goto put_op;
+
+	if (rte_mempool_get_bulk(t->buf_seg_pool, (void **)req->inp_buf_segs,
+				 model->info.nb_inputs) != 0)
+		goto put_req;
+
+	if (rte_mempool_get_bulk(t->buf_seg_pool, (void **)req->out_buf_segs,
+				 model->info.nb_outputs) != 0) {
+		rte_mempool_put_bulk(t->buf_seg_pool, (void **)req->inp_buf_segs,
+				     model->info.nb_inputs);
+		goto put_req;
+	}
+
+	op->model_id = model->id;
+	op->nb_batches = model->info.min_batches;
+	op->mempool = t->op_pool;
+	op->input = req->inp_buf_segs;
+	op->output = req->out_buf_segs;
+	op->user_ptr = req;
+
+	if (model->info.io_layout == RTE_ML_IO_LAYOUT_PACKED) {
+		op->input[0]->addr = req->input;
+		op->input[0]->iova_addr = rte_mem_virt2iova(req->input);
+		op->input[0]->length = model->inp_qsize;
+		op->input[0]->next = NULL;
+
+		op->output[0]->addr = req->output;
+		op->output[0]->iova_addr = rte_mem_virt2iova(req->output);
+		op->output[0]->length = model->out_qsize;
+		op->output[0]->next = NULL;
+	} else {
+		offset = 0;
+		for (i = 0; i < model->info.nb_inputs; i++) {
+			bufsz = RTE_ALIGN_CEIL(model->info.input_info[i].size,
+					       t->cmn.dev_info.align_size);
+			op->input[i]->addr = req->input + offset;
+			op->input[i]->iova_addr = rte_mem_virt2iova(req->input + offset);
+			op->input[i]->length = bufsz;
+			op->input[i]->next = NULL;
+			offset += bufsz;
+		}
+
+		offset = 0;
+		for (i = 0; i < model->info.nb_outputs; i++) {
+			bufsz = RTE_ALIGN_CEIL(model->info.output_info[i].size,
+					       t->cmn.dev_info.align_size);
+			op->output[i]->addr = req->output + offset;
+			op->output[i]->iova_addr = rte_mem_virt2iova(req->output + offset);
+			op->output[i]->length = bufsz;
+			op->output[i]->next = NULL;
+			offset += bufsz;
+		}
+	}
+
+	req->niters++;
+	req->fid = fid;
+	*op_ptr = op;
+
+	return 0;
+
+put_req:
+	rte_mempool_put(model->io_pool, req);
+put_op:
+	rte_mempool_put(t->op_pool, op);
+
+	return -ENOBUFS;
+}
+
+static void
+ml_batched_op_put(struct test_inference *t, struct rte_ml_op *op)
+{
+	struct ml_request *req = (struct ml_request *)op->user_ptr;
+
+	rte_mempool_put_bulk(t->buf_seg_pool, (void **)op->input,
+			     t->model[req->fid].info.nb_inputs);
+	rte_mempool_put_bulk(t->buf_seg_pool, (void **)op->output,
+			     t->model[req->fid].info.nb_outputs);
+	rte_mempool_put(t->model[req->fid].io_pool, req);
+	rte_mempool_put(t->op_pool, op);
+}
+
+/* Enqueue and dequeue inferences through the batching context, keeping up to burst_size
+ * inferences in flight.
+ */
+static int
+ml_batched_worker(void *arg)
+{
+	struct test_inference *t = ml_test_priv((struct ml_test *)arg);
+	struct ml_core_args *args;
+	struct rte_ml_op *op;
+	uint64_t start_cycle;
+	uint64_t end_cycle;
+	uint64_t nb_enq = 0;
+	uint64_t nb_deq = 0;
+	uint32_t lcore_id;
+	uint16_t burst_deq;
+	uint16_t i;
+
+	lcore_id = rte_lcore_id();
+	args = &t->args[lcore_id];
+	args->start_cycles = 0;
+	args->end_cycles = 0;
+
+	while (nb_deq < args->nb_reqs) {
+		if (nb_enq < args->nb_reqs && nb_enq - nb_deq < t->cmn.opt->burst_size &&
+		    ml_batched_op_get(t, args->start_fid, &op) == 0) {
+			start_cycle = rte_get_tsc_cycles();
+			if (rte_ml_batch_enqueue(t->batch, &op, 1) == 1) {
+				args->start_cycles += start_cycle;
+				nb_enq++;
+			} else {
+				ml_batched_op_put(t, op);
+			}
+		}
+
+		burst_deq = rte_ml_batch_dequeue(t->batch, args->deq_ops, t->cmn.opt->burst_size);
+		end_cycle = rte_get_tsc_cycles();
+		args->end_cycles += burst_deq * end_cycle;
+		nb_deq += burst_deq;
+
+		for (i = 0; i < burst_deq; i++) {
+			if (unlikely(args->deq_ops[i]->status == RTE_ML_OP_STATUS_ERROR)) {
+				ml_err("inference failed, lcore_id = %u\n", lcore_id);
+				t->error_count[lcore_id]++;
+			}
+			ml_batched_op_put(t, args->deq_ops[i]);
+		}
+	}
+
+	return 0;
+}
+
+/* Run the inferences of a model with a batch size, returning the wall clock cycles. */
+static int
+ml_batched_run(struct ml_test *test, struct ml_options *opt, uint16_t fid, uint16_t batch_size,
+	       uint64_t *cycles)
+{
+	struct test_inference *t = ml_test_priv(test);
+	struct rte_ml_batch_conf conf;
+	uint64_t start_cycle;
+	uint64_t nb_done = 0;
+	uint32_t nb_workers;
+	uint32_t lcore_id;
+	uint64_t nb_reqs;
+	uint32_t id = 0;
+
+	nb_workers = rte_lcore_count() - 1;
+
+	conf.name = "ml_test_batch";
+	conf.dev_id = opt->dev_id;
+	conf.qp_id = 0;
+	conf.model_id = t->model[fid].id;
+	conf.batch_size = batch_size;
+	conf.nb_requests = opt->queue_size;
+	conf.nb_ops = nb_workers * opt->burst_size;
+	conf.deadline_us = opt->batch_deadline;
+	conf.socket_id = opt->socket_id;
+
+	t->batch = rte_ml_batch_create(&conf);
+	if (t->batch == NULL) {
+		ml_err("Failed to create batching context, batch_size = %u\n", batch_size);
+		return -rte_errno;
+	}
+
+	nb_reqs = opt->repetitions / nb_workers;
+	start_cycle = rte_get_tsc_cycles();
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		t->args[lcore_id].nb_reqs = nb_reqs;
+		if (id == 0)
+			t->args[lcore_id].nb_reqs += opt->repetitions - nb_reqs * nb_workers;
+		t->args[lcore_id].start_fid = fid;
+		t->args[lcore_id].end_fid = fid;
+		t->args[lcore_id].start_cycles = 0;
+		t->args[lcore_id].end_cycles = 0;
+		if (t->args[lcore_id].nb_reqs != 0)
+			rte_eal_remote_launch(ml_batched_worker, test, lcore_id);
+		id++;
+	}
+
+	while (nb_done < opt->repetitions)
+		nb_done += rte_ml_batch_process(t->batch);
+
+	*cycles = rte_get_tsc_cycles() - start_cycle;
+
+	rte_eal_mp_wait_lcore();
+
+	rte_ml_batch_free(t->batch);
+	t->batch = NULL;
+
+	return 0;
+}
+
+static void
+ml_batched_print(struct test_inference *t, struct ml_options *opt, uint16_t batch_size,
+		 uint64_t cycles)
+{
+	uint64_t total_cycles = 0;
+	uint32_t lcore_id;
+	uint64_t freq;
+
+	freq = rte_get_tsc_hz();
+	RTE_LCORE_FOREACH_WORKER(lcore_id)
+		total_cycles += t->args[lcore_id].end_cycles - t->args[lcore_id].start_cycles;
+
+	printf(" %-12u %-24.3f %-24.0f\n", batch_size,
+	       (double)total_cycles * US_PER_S / freq / opt->repetitions,
+	       (double)opt->repetitions * freq / cycles);
+}
+
+static int
+test_inference_batched_driver(struct ml_test *test, struct ml_options *opt)
+{
+	struct test_inference *t;
+	uint16_t batch_size;
+	uint64_t cycles;
+	uint16_t fid = 0;
+	int ret = 0;
+
+	t = ml_test_priv(test);
+
+	ret = ml_inference_mldev_setup(test, opt);
+	if (ret != 0)
+		return ret;
+
+	ret = ml_inference_mem_setup(test, opt);
+	if (ret != 0)
+		return ret;
+
+next_model:
+	/* load model */
+	ret = ml_model_load(test, opt, &t->model[fid], fid);
+	if (ret != 0)
+		goto error;
+
+	/* start model */
+	ret = ml_model_start(test, opt, &t->model[fid], fid);
+	if (ret != 0)
+		goto error;
+
+	ret = ml_inference_iomem_setup(test, opt, fid);
+	if (ret != 0)
+		goto error;
+
+	ml_print_line(64);
+	printf(" Model: %s\n", opt->filelist[fid].model);
+	printf(" %-12s %-24s %-24s\n", "batch_size", "latency (us)",
+	       "throughput (inf/s)");
+	ml_print_line(64);
+
+	/* sweep the batch size by powers of 2 */
+	batch_size = 1;
+	for (;;) {
+		ret = ml_batched_run(test, opt, fid, batch_size, &cycles);
+		if (ret != 0)
+			goto error;
+
+		ml_batched_print(t, opt, batch_size, cycles);
+
+		if (batch_size >= opt->batch_size)
+			break;
+		batch_size = RTE_MIN(batch_size * 2, opt->batch_size);
+	}
+	ml_print_line(64);
+
+	ret = ml_inference_result(test, opt, fid);
+	if (ret != ML_TEST_SUCCESS)
+		goto error;
+
+	ml_inference_iomem_destroy(test, opt, fid);
+	ml_stats_get(test, opt, RTE_ML_DEV_XSTATS_MODEL, fid);
+
+	/* stop model */
+	ret = ml_model_stop(test, opt, &t->model[fid], fid);
+	if (ret != 0)
+		goto error;
+
+	/* unload model */
+	ret = ml_model_unload(test, opt, &t->model[fid], fid);
+	if (ret != 0)
+		goto error;
+
+	fid++;
+	if (fid < opt->nb_filelist)
+		goto next_model;
+
+	ml_stats_get(test, opt, RTE_ML_DEV_XSTATS_DEVICE, -1);
+	ml_inference_mem_destroy(test, opt);
+
+	ret = ml_inference_mldev_destroy(test, opt);
+	if (ret != 0)
+		return ret;
+
+	t->cmn.result = ML_TEST_SUCCESS;
+
+	return 0;
+
+error:
+	ml_inference_iomem_destroy(test, opt, fid);
+	ml_inference_mem_destroy(test, opt);
+	ml_model_stop(test, opt, &t->model[fid], fid);
+	ml_model_unload(test, opt, &t->model[fid], fid);
+
+	t->cmn.result = ML_TEST_FAILED;
+
+	return ret;
+}
+
+static int
+test_inference_batched_opt_check(struct ml_options *opt)
+{
+	int ret;
+
+	ret = test_inference_opt_check(opt);
+	if (ret != 0)
+		return ret;
+
+	if (opt->batch_size == 0) {
+		ml_err("Invalid option, batch_size = %u\n", opt->batch_size);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static void
+test_inference_batched_opt_dump(struct ml_options *opt)
+{
+	test_inference_opt_dump(opt);
+
+	ml_dump("batch_size", "%u", opt->batch_size);
+	ml_dump("batch_deadline", "%" PRIu64, opt->batch_deadline);
+}
+
+static int
+test_inference_batched_result(struct ml_test *test, struct ml_options *opt)
+{
+	struct test_inference *t;
+
+	RTE_SET_USED(opt);
+
+	t = ml_test_priv(test);
+
+	return t->cmn.result;
+}
+
+static const struct ml_test_ops inference_batched = {
+	.cap_check = test_inference_cap_check,
+	.opt_check = test_inference_batched_opt_check,
+	.opt_dump = test_inference_batched_opt_dump,
+	.test_setup = test_inference_setup,
+	.test_destroy = test_inference_destroy,
+	.test_driver = test_inference_batched_driver,
+	.test_result = test_inference_batched_result,
+};
+
+ML_TEST_REGISTER(inference_batched);
@@ -53,6 +53,9 @@ struct __rte_cache_aligned test_inference {
 	int (*enqueue)(void *arg);
 	int (*dequeue)(void *arg);
 
+	/* inference_batched */
+	struct rte_ml_batch *batch;
+
 	struct ml_core_args args[RTE_MAX_LCORE];
 	uint64_t error_count[RTE_MAX_LCORE];
 
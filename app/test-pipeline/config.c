@@ -84,6 +84,46 @@ app_parse_port_mask(const char *arg)
 	return 0;
 }
 
+static int
+app_parse_swx_sizes(const char *arg)
+{
+	char *end = NULL;
+	uint64_t size;
+
+	app.n_swx_sizes = 0;
+	do {
+		if (app.n_swx_sizes >= APP_SWX_MAX_SIZES)
+			return -1;
+
+		size = strtoul(arg, &end, 0);
+		if (end == arg)
+			return -2;
+
+		switch (*end) {
+		case 'K':
+		case 'k':
+			size <<= 10;
+			end++;
+			break;
+		case 'M':
+		case 'm':
+			size <<= 20;
+			end++;
+			break;
+		}
+
+		if (size == 0 || size > (1U << 30) ||
+				(*end != ',' && *end != '\0'))
+			return -3;
+
+		/* Rounded up, as the tables are sized by powers of 2 */
+		app.swx_sizes[app.n_swx_sizes++] = rte_align32pow2(size);
+		arg = end + 1;
+	} while (*end == ',');
+
+	return 0;
+}
+
 struct {
 	const char *name;
 	uint32_t value;
@@ -114,6 +154,10 @@ struct {
 	{"hash-cuckoo-96", e_APP_PIPELINE_HASH_CUCKOO_KEY96},
 	{"hash-cuckoo-112", e_APP_PIPELINE_HASH_CUCKOO_KEY112},
 	{"hash-cuckoo-128", e_APP_PIPELINE_HASH_CUCKOO_KEY128},
+	{"swx-em", e_APP_PIPELINE_SWX_EM},
+	{"swx-wm", e_APP_PIPELINE_SWX_WM},
+	{"swx-learner", e_APP_PIPELINE_SWX_LEARNER},
+	{"swx-selector", e_APP_PIPELINE_SWX_SELECTOR},
 };
 
 int
@@ -150,9 +194,14 @@ app_parse_args(int argc, char **argv)
 		{"hash-cuckoo-96", 0, 0, 0},
 		{"hash-cuckoo-112", 0, 0, 0},
 		{"hash-cuckoo-128", 0, 0, 0},
+		{"swx-em", 0, 0, 0},
+		{"swx-wm", 0, 0, 0},
+		{"swx-learner", 0, 0, 0},
+		{"swx-selector", 0, 0, 0},
+		{"swx-sizes", 1, 0, 0},
 		{NULL, 0, 0, 0}
 	};
-	uint32_t lcores[3], n_lcores, lcore_id, pipeline_type_provided;
+	uint32_t lcores[3] = {0}, n_lcores, lcore_id, pipeline_type_provided;
 
 	/* EAL args */
 	n_lcores = 0;
@@ -160,26 +209,11 @@ app_parse_args(int argc, char **argv)
 		if (rte_lcore_is_enabled(lcore_id) == 0)
 			continue;
 
-		if (n_lcores >= 3) {
-			RTE_LOG(ERR, USER1, "Number of cores must be 3\n");
-			app_print_usage();
-			return -1;
-		}
-
-		lcores[n_lcores] = lcore_id;
+		if (n_lcores < 3)
+			lcores[n_lcores] = lcore_id;
 		n_lcores++;
 	}
 
-	if (n_lcores != 3) {
-		RTE_LOG(ERR, USER1, "Number of cores must be 3\n");
-		app_print_usage();
-		return -1;
-	}
-
-	app.core_rx = lcores[0];
-	app.core_worker = lcores[1];
-	app.core_tx = lcores[2];
-
 	/* Non-EAL args */
 	argvopt = argv;
 
@@ -197,6 +231,14 @@ app_parse_args(int argc, char **argv)
 			break;
 
 		case 0: /* long options */
+			if (!strcmp(lgopts[option_index].name, "swx-sizes")) {
+				if (app_parse_swx_sizes(optarg) < 0) {
+					app_print_usage();
+					return -1;
+				}
+				break;
+			}
+
 			if (!pipeline_type_provided) {
 				uint32_t i;
 
@@ -221,6 +263,25 @@ app_parse_args(int argc, char **argv)
 		}
 	}
 
+	/* The SWX benchmarks run one pipeline instance per lcore */
+	if (APP_PIPELINE_IS_SWX(app.pipeline_type)) {
+		if (app.n_swx_sizes == 0) {
+			app.swx_sizes[0] = 1 << 10;
+			app.swx_sizes[1] = 1 << 16;
+			app.swx_sizes[2] = 1 << 20;
+			app.swx_sizes[3] = 1 << 24;
+			app.n_swx_sizes = 4;
+		}
+	} else if (n_lcores != 3) {
+		RTE_LOG(ERR, USER1, "Number of cores must be 3\n");
+		app_print_usage();
+		return -1;
+	}
+
+	app.core_rx = lcores[0];
+	app.core_worker = lcores[1];
+	app.core_tx = lcores[2];
+
 	if (optind >= 0)
 		argv[optind - 1] = prgname;
 
@@ -76,6 +76,13 @@ main(int argc, char **argv)
 		return -1;
 	}
 
+	/* The SWX benchmarks do not use the NIC ports */
+	if (APP_PIPELINE_IS_SWX(app.pipeline_type)) {
+		app_main_swx();
+		rte_eal_cleanup();
+		return 0;
+	}
+
 	/* Init */
 	app_init();
 
@@ -18,6 +18,10 @@ struct app_mbuf_array {
 #define APP_MAX_PORTS 4
 #endif
 
+#ifndef APP_SWX_MAX_SIZES
+#define APP_SWX_MAX_SIZES 16
+#endif
+
 struct __rte_cache_aligned app_params {
 	/* CPU cores */
 	uint32_t core_rx;
@@ -56,6 +60,10 @@ struct __rte_cache_aligned app_params {
 
 	/* App behavior */
 	uint32_t pipeline_type;
+
+	/* SWX table sizes */
+	uint32_t swx_sizes[APP_SWX_MAX_SIZES];
+	uint32_t n_swx_sizes;
 };
 
 extern struct app_params app;
@@ -99,6 +107,11 @@ enum {
 	e_APP_PIPELINE_HASH_CUCKOO_KEY96,
 	e_APP_PIPELINE_HASH_CUCKOO_KEY112,
 	e_APP_PIPELINE_HASH_CUCKOO_KEY128,
+
+	e_APP_PIPELINE_SWX_EM,
+	e_APP_PIPELINE_SWX_WM,
+	e_APP_PIPELINE_SWX_LEARNER,
+	e_APP_PIPELINE_SWX_SELECTOR,
 	e_APP_PIPELINES
 };
 
@@ -122,6 +135,11 @@ void app_main_loop_worker_pipeline_lpm_ipv6(void);
 
 void app_main_loop_tx(void);
 
+#define APP_PIPELINE_IS_SWX(type) \
+	((type) >= e_APP_PIPELINE_SWX_EM && (type) <= e_APP_PIPELINE_SWX_SELECTOR)
+
+void app_main_swx(void);
+
 #define APP_FLUSH 0
 #ifndef APP_FLUSH
 #define APP_FLUSH 0x3FF
@@ -0,0 +1,520 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_log.h>
+#include <rte_mbuf.h>
+#include <rte_random.h>
+#include <rte_ring.h>
+#include <rte_stdatomic.h>
+#include <rte_swx_port_ring.h>
+#include <rte_swx_pipeline.h>
+#include <rte_swx_ctl.h>
+
+#include "main.h"
+
+/* Packets looping through the ring of each pipeline */
+#ifndef APP_SWX_N_PKTS
+#define APP_SWX_N_PKTS 1024
+#endif
+
+#ifndef APP_SWX_RING_SIZE
+#define APP_SWX_RING_SIZE 2048
+#endif
+
+#ifndef APP_SWX_BURST_SIZE
+#define APP_SWX_BURST_SIZE 32
+#endif
+
+/* Duration of each measurement */
+#ifndef APP_SWX_RUN_MS
+#define APP_SWX_RUN_MS 1000
+#endif
+
+/* Instructions executed between two time checks */
+#define APP_SWX_RUN_INSTR 1024
+
+/* Table entries added per commit */
+#define APP_SWX_COMMIT_SIZE (64 * 1024)
+
+/* Action IDs, in the order of the actions configuration */
+#define APP_SWX_ACTION_FWD 0
+
+enum {
+	APP_SWX_BUILD_INTERP = 0,
+	APP_SWX_BUILD_INPROC,
+	APP_SWX_BUILDS
+};
+
+static const char * const app_swx_build_names[] = {
+	[APP_SWX_BUILD_INTERP] = "interp",
+	[APP_SWX_BUILD_INPROC] = "inproc",
+};
+
+struct app_swx_result {
+	/* ns per packet without and with the table stage */
+	double ns_base[APP_SWX_BUILDS];
+	double ns_table[APP_SWX_BUILDS];
+};
+
+static struct rte_ring *app_swx_rings[RTE_MAX_LCORE][2];
+static struct app_swx_result app_swx_results[RTE_MAX_LCORE];
+static RTE_ATOMIC(uint32_t) app_swx_ready;
+
+static struct rte_swx_field_params ethernet_h[] = {
+	{"dst_addr", 48},
+	{"src_addr", 48},
+	{"ethertype", 16},
+};
+
+static struct rte_swx_field_params ipv4_h[] = {
+	{"ver_ihl", 8},
+	{"diffserv", 8},
+	{"total_len", 16},
+	{"identification", 16},
+	{"flags_offset", 16},
+	{"ttl", 8},
+	{"protocol", 8},
+	{"hdr_checksum", 16},
+	{"src_addr", 32},
+	{"dst_addr", 32},
+};
+
+static struct rte_swx_field_params metadata_t[] = {
+	{"port_in", 32},
+	{"port_out", 32},
+	{"key", 32},
+	{"group_id", 32},
+	{"timeout_id", 32},
+};
+
+static struct rte_swx_field_params fwd_args_t[] = {
+	{"port_out", 32},
+};
+
+static const char *fwd_instructions[] = {
+	"mov m.port_out t.port_out",
+	"return",
+};
+
+static const char *learn_fwd_instructions[] = {
+	"learn fwd m.port_out m.timeout_id",
+	"return",
+};
+
+static const char *
+app_swx_table_name(uint32_t type)
+{
+	switch (type) {
+	case e_APP_PIPELINE_SWX_EM:
+		return "em";
+	case e_APP_PIPELINE_SWX_WM:
+		return "wm";
+	case e_APP_PIPELINE_SWX_LEARNER:
+		return "learner";
+	default:
+		return "selector";
+	}
+}
+
+static void
+app_swx_table_config(struct rte_swx_pipeline *p, uint32_t type,
+	uint32_t size)
+{
+	struct rte_swx_match_field_params match_fields[] = {
+		{"m.key", type == e_APP_PIPELINE_SWX_EM ?
+			RTE_SWX_TABLE_MATCH_EXACT : RTE_SWX_TABLE_MATCH_WILDCARD},
+	};
+	const char *action_names[] = {"fwd", "learn_fwd"};
+	const char *key_field_names[] = {"m.key"};
+	int action_is_for_table_entries[] = {1, 0};
+	int action_is_for_default_entry[] = {0, 1};
+	uint32_t timeout = 3600;
+	int status;
+
+	switch (type) {
+	case e_APP_PIPELINE_SWX_EM:
+	case e_APP_PIPELINE_SWX_WM:
+	{
+		struct rte_swx_pipeline_table_params params = {
+			.fields = match_fields,
+			.n_fields = RTE_DIM(match_fields),
+			.action_names = action_names,
+			.n_actions = 1,
+			.default_action_name = "fwd",
+			.default_action_args = "port_out 0",
+		};
+
+		status = rte_swx_pipeline_table_config(p, "t", &params, NULL,
+			NULL, size);
+		break;
+	}
+
+	case e_APP_PIPELINE_SWX_LEARNER:
+	{
+		/* Missed keys are learned by the default action */
+		struct rte_swx_pipeline_learner_params params = {
+			.field_names = key_field_names,
+			.n_fields = RTE_DIM(key_field_names),
+			.action_names = action_names,
+			.action_is_for_table_entries = action_is_for_table_entries,
+			.action_is_for_default_entry = action_is_for_default_entry,
+			.n_actions = RTE_DIM(action_names),
+			.default_action_name = "learn_fwd",
+		};
+
+		status = rte_swx_pipeline_learner_config(p, "t", &params, size,
+			&timeout, 1);
+		break;
+	}
+
+	default:
+	{
+		/* One group per entry, with a single member each */
+		struct rte_swx_pipeline_selector_params params = {
+			.group_id_field_name = "m.group_id",
+			.selector_field_names = key_field_names,
+			.n_selector_fields = RTE_DIM(key_field_names),
+			.member_id_field_name = "m.port_out",
+			.n_groups_max = size,
+			.n_members_per_group_max = 1,
+		};
+
+		status = rte_swx_pipeline_selector_config(p, "t", &params);
+		break;
+	}
+	}
+
+	if (status)
+		rte_panic("Unable to configure the %s table (%d)\n",
+			app_swx_table_name(type), status);
+}
+
+/*
+ * The lookup key is derived from a hash of the destination IPv4 address, which
+ * is then overwritten by the hash, so that each trip of a packet through the
+ * ring looks a different key up.
+ */
+static struct rte_swx_pipeline *
+app_swx_pipeline_create(const char *name, struct rte_ring *r, uint32_t type,
+	uint32_t size, int with_table)
+{
+	struct rte_swx_port_ring_reader_params reader_params = {
+		.name = r->name,
+		.burst_size = APP_SWX_BURST_SIZE,
+	};
+	struct rte_swx_port_ring_writer_params writer_params = {
+		.name = r->name,
+		.burst_size = APP_SWX_BURST_SIZE,
+	};
+	char key_mask[32];
+	const char *instructions[] = {
+		"rx m.port_in",
+		"extract h.ethernet",
+		"extract h.ipv4",
+		"hash jhash m.key h.ipv4.dst_addr h.ipv4.dst_addr",
+		"mov h.ipv4.dst_addr m.key",
+		key_mask,
+		"mov m.group_id m.key",
+		"mov m.port_out 0",
+		"mov m.timeout_id 0",
+		"table t",
+		"emit h.ethernet",
+		"emit h.ipv4",
+		"tx m.port_out",
+	};
+	struct rte_swx_pipeline *p;
+	uint32_t i;
+	int status;
+
+	status = rte_swx_pipeline_config(&p, name, rte_socket_id());
+	if (status)
+		rte_panic("Unable to configure pipeline %s (%d)\n", name,
+			status);
+
+	status = rte_swx_pipeline_port_in_config(p, 0, "ring", &reader_params);
+	status |= rte_swx_pipeline_port_out_config(p, 0, "ring",
+		&writer_params);
+	status |= rte_swx_pipeline_struct_type_register(p, "ethernet_h",
+		ethernet_h, RTE_DIM(ethernet_h), 0);
+	status |= rte_swx_pipeline_struct_type_register(p, "ipv4_h",
+		ipv4_h, RTE_DIM(ipv4_h), 0);
+	status |= rte_swx_pipeline_struct_type_register(p, "metadata_t",
+		metadata_t, RTE_DIM(metadata_t), 0);
+	status |= rte_swx_pipeline_struct_type_register(p, "fwd_args_t",
+		fwd_args_t, RTE_DIM(fwd_args_t), 0);
+	status |= rte_swx_pipeline_packet_header_register(p, "ethernet",
+		"ethernet_h");
+	status |= rte_swx_pipeline_packet_header_register(p, "ipv4",
+		"ipv4_h");
+	status |= rte_swx_pipeline_packet_metadata_register(p, "metadata_t");
+	status |= rte_swx_pipeline_action_config(p, "fwd", "fwd_args_t",
+		fwd_instructions, RTE_DIM(fwd_instructions));
+	status |= rte_swx_pipeline_action_config(p, "learn_fwd", NULL,
+		learn_fwd_instructions, RTE_DIM(learn_fwd_instructions));
+	if (status)
+		rte_panic("Unable to configure pipeline %s\n", name);
+
+	if (with_table)
+		app_swx_table_config(p, type, size);
+
+	/* The baseline pipeline does everything but the table lookup */
+	snprintf(key_mask, sizeof(key_mask), "and m.key %u", size - 1);
+	if (!with_table)
+		for (i = RTE_DIM(instructions) - 4; i < RTE_DIM(instructions) - 1; i++)
+			instructions[i] = instructions[i + 1];
+
+	status = rte_swx_pipeline_instructions_config(p, instructions,
+		RTE_DIM(instructions) - !with_table);
+	if (status)
+		rte_panic("Unable to configure pipeline %s instructions (%d)\n",
+			name, status);
+
+	status = rte_swx_pipeline_build(p);
+	if (status)
+		rte_panic("Unable to build pipeline %s (%d)\n", name, status);
+
+	return p;
+}
+
+static void
+app_swx_table_populate(struct rte_swx_pipeline *p, uint32_t type,
+	uint32_t size)
+{
+	struct rte_swx_ctl_pipeline *ctl;
+	uint32_t action_data = 0, group_id, i;
+	int status = 0;
+
+	/* The learner table is filled by the packets */
+	if (type == e_APP_PIPELINE_SWX_LEARNER)
+		return;
+
+	ctl = rte_swx_ctl_pipeline_create(p);
+	if (ctl == NULL)
+		rte_panic("Unable to create the pipeline control\n");
+
+	for (i = 0; i < size && !status; i++) {
+		if (type == e_APP_PIPELINE_SWX_SELECTOR) {
+			status = rte_swx_ctl_pipeline_selector_group_add(ctl,
+				"t", &group_id);
+			if (!status)
+				status = rte_swx_ctl_pipeline_selector_group_member_add(
+					ctl, "t", group_id, 0, 1);
+		} else {
+			struct rte_swx_table_entry entry = {
+				.key = (uint8_t *)&i,
+				.action_id = APP_SWX_ACTION_FWD,
+				.action_data = (uint8_t *)&action_data,
+			};
+
+			status = rte_swx_ctl_pipeline_table_entry_add(ctl, "t",
+				&entry);
+		}
+
+		if (!status && ((i + 1) % APP_SWX_COMMIT_SIZE == 0 ||
+				i + 1 == size))
+			status = rte_swx_ctl_pipeline_commit(ctl, 1);
+	}
+
+	if (status)
+		rte_panic("Unable to add %s table entry %u (%d)\n",
+			app_swx_table_name(type), i - 1, status);
+
+	rte_swx_ctl_pipeline_free(ctl);
+}
+
+static void
+app_swx_ring_fill(struct rte_ring *r)
+{
+	uint32_t i;
+
+	for (i = 0; i < APP_SWX_N_PKTS; i++) {
+		struct rte_ether_hdr *eth;
+		struct rte_ipv4_hdr *ip;
+		struct rte_mbuf *m;
+
+		m = rte_pktmbuf_alloc(app.pool);
+		if (m == NULL)
+			rte_panic("Unable to allocate packets\n");
+
+		eth = rte_pktmbuf_mtod(m, struct rte_ether_hdr *);
+		memset(eth, 0, sizeof(*eth) + sizeof(*ip));
+		eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+
+		ip = (struct rte_ipv4_hdr *)(eth + 1);
+		ip->version_ihl = RTE_IPV4_VHL_DEF;
+		ip->dst_addr = (uint32_t)rte_rand();
+
+		m->data_len = sizeof(*eth) + sizeof(*ip);
+		m->pkt_len = m->data_len;
+		rte_ring_enqueue(r, m);
+	}
+}
+
+static void
+app_swx_ring_drain(struct rte_ring *r)
+{
+	void *m;
+
+	while (rte_ring_dequeue(r, &m) == 0)
+		rte_pktmbuf_free(m);
+}
+
+/* Returns the ns per packet for the given number of TSC cycles */
+static double
+app_swx_measure(struct rte_swx_pipeline *p, uint64_t cycles)
+{
+	struct rte_swx_port_in_stats stats;
+	uint64_t n_pkts, start, end;
+
+	rte_swx_ctl_pipeline_port_in_stats_read(p, 0, &stats);
+	n_pkts = stats.n_pkts;
+
+	start = rte_rdtsc();
+	do {
+		rte_swx_pipeline_run(p, APP_SWX_RUN_INSTR);
+		end = rte_rdtsc();
+	} while (end - start < cycles && !force_quit);
+
+	rte_swx_ctl_pipeline_port_in_stats_read(p, 0, &stats);
+	n_pkts = stats.n_pkts - n_pkts;
+	if (n_pkts == 0)
+		return 0;
+
+	return (double)(end - start) * 1E9 / rte_get_tsc_hz() / n_pkts;
+}
+
+static int
+app_swx_instance(void *arg)
+{
+	uint32_t size = *(uint32_t *)arg;
+	uint32_t lcore = rte_lcore_id();
+	struct app_swx_result *res = &app_swx_results[lcore];
+	uint64_t cycles = rte_get_tsc_hz() * APP_SWX_RUN_MS / 1000;
+	struct rte_swx_pipeline *base, *table;
+	char name[32];
+	uint32_t i;
+
+	app_swx_ring_fill(app_swx_rings[lcore][0]);
+	app_swx_ring_fill(app_swx_rings[lcore][1]);
+
+	snprintf(name, sizeof(name), "swx_base_%u", lcore);
+	base = app_swx_pipeline_create(name, app_swx_rings[lcore][0],
+		app.pipeline_type, size, 0);
+	snprintf(name, sizeof(name), "swx_table_%u", lcore);
+	table = app_swx_pipeline_create(name, app_swx_rings[lcore][1],
+		app.pipeline_type, size, 1);
+	app_swx_table_populate(table, app.pipeline_type, size);
+
+	/* The instances are measured together */
+	rte_atomic_fetch_add_explicit(&app_swx_ready, 1,
+		rte_memory_order_acq_rel);
+	while (rte_atomic_load_explicit(&app_swx_ready,
+			rte_memory_order_acquire) != rte_lcore_count())
+		rte_pause();
+
+	for (i = 0; i < APP_SWX_BUILDS; i++) {
+		if (i == APP_SWX_BUILD_INPROC &&
+				(rte_swx_pipeline_build_inproc(base) ||
+				rte_swx_pipeline_build_inproc(table)))
+			rte_panic("Unable to build the pipelines in-process\n");
+
+		/* Warm up, which also fills the learner table */
+		app_swx_measure(base, cycles / 4);
+		app_swx_measure(table, cycles / 4);
+
+		res->ns_base[i] = app_swx_measure(base, cycles);
+		res->ns_table[i] = app_swx_measure(table, cycles);
+	}
+
+	rte_swx_pipeline_free(base);
+	rte_swx_pipeline_free(table);
+	app_swx_ring_drain(app_swx_rings[lcore][0]);
+	app_swx_ring_drain(app_swx_rings[lcore][1]);
+
+	return 0;
+}
+
+static void
+app_swx_print(uint32_t size)
+{
+	double mpps[APP_SWX_BUILDS] = {0};
+	uint32_t lcore, i;
+
+	printf("\nSWX %s table, %u entries, %u instance(s)\n",
+		app_swx_table_name(app.pipeline_type), size,
+		rte_lcore_count());
+	printf("%-6s %-7s %12s %12s %12s %10s\n", "lcore", "build",
+		"base ns/pkt", "ns/pkt", "table ns", "Mpps");
+
+	RTE_LCORE_FOREACH(lcore) {
+		struct app_swx_result *res = &app_swx_results[lcore];
+
+		for (i = 0; i < APP_SWX_BUILDS; i++) {
+			double rate = res->ns_table[i] ?
+				1E3 / res->ns_table[i] : 0;
+
+			printf("%-6u %-7s %12.2f %12.2f %12.2f %10.2f\n",
+				lcore, app_swx_build_names[i],
+				res->ns_base[i], res->ns_table[i],
+				res->ns_table[i] - res->ns_base[i], rate);
+			mpps[i] += rate;
+		}
+	}
+
+	for (i = 0; i < APP_SWX_BUILDS; i++)
+		printf("%-6s %-7s %12s %12s %12s %10.2f\n", "total",
+			app_swx_build_names[i], "", "", "", mpps[i]);
+}
+
+void
+app_main_swx(void)
+{
+	uint32_t lcore, i;
+
+	RTE_LOG(INFO, USER1, "Running the SWX %s table benchmark on %u "
+		"lcore(s)\n", app_swx_table_name(app.pipeline_type),
+		rte_lcore_count());
+
+	/* Two rings of packets per lcore, plus the ones lost in flight */
+	app.pool = rte_pktmbuf_pool_create("mempool",
+		rte_lcore_count() * 4 * APP_SWX_N_PKTS, app.pool_cache_size,
+		0, app.pool_buffer_size, rte_socket_id());
+	if (app.pool == NULL)
+		rte_panic("Cannot create mbuf pool\n");
+
+	RTE_LCORE_FOREACH(lcore) {
+		for (i = 0; i < 2; i++) {
+			char name[32];
+
+			snprintf(name, sizeof(name), "app_swx_ring_%u_%u",
+				lcore, i);
+			app_swx_rings[lcore][i] = rte_ring_create(name,
+				APP_SWX_RING_SIZE, rte_lcore_to_socket_id(lcore),
+				RING_F_SP_ENQ | RING_F_SC_DEQ);
+			if (app_swx_rings[lcore][i] == NULL)
+				rte_panic("Cannot create SWX ring %u\n", i);
+		}
+	}
+
+	for (i = 0; i < app.n_swx_sizes && !force_quit; i++) {
+		rte_atomic_store_explicit(&app_swx_ready, 0,
+			rte_memory_order_release);
+		rte_eal_mp_remote_launch(app_swx_instance, &app.swx_sizes[i],
+			CALL_MAIN);
+		rte_eal_mp_wait_lcore();
+
+		app_swx_print(app.swx_sizes[i]);
+	}
+}
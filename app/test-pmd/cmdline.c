@@ -384,6 +384,18 @@ static void cmd_help_long_parsed(void *parsed_result,
 			"    Set the scheduling on timestamps"
 			" timings for the TXONLY mode\n\n"
 
+			"set gen rate (pps|bps) (rate)\n"
+			"    Set the rate of each Tx queue in GEN mode,"
+			" 0 for maximum rate.\n\n"
+
+			"set gen flows (src-ip|dst-ip|src-port|dst-port) (n)\n"
+			"    Set the number of values of a 5-tuple field"
+			" in GEN mode.\n\n"
+
+			"set gen probe (n)\n"
+			"    Send a latency probe every n packets in GEN mode,"
+			" 0 to disable.\n\n"
+
 			"set corelist (x[,y]*)\n"
 			"    Set the list of forwarding cores.\n\n"
 
@@ -4612,6 +4624,164 @@ static cmdline_parse_inst_t cmd_set_txtimes = {
 	},
 };
 
+/* *** SET RATE, FLOWS AND PROBES OF GEN MODE *** */
+
+struct cmd_set_gen_rate_result {
+	cmdline_fixed_string_t set;
+	cmdline_fixed_string_t gen;
+	cmdline_fixed_string_t rate;
+	cmdline_fixed_string_t unit;
+	uint64_t value;
+};
+
+static void
+cmd_set_gen_rate_parsed(void *parsed_result,
+			__rte_unused struct cmdline *cl,
+			__rte_unused void *data)
+{
+	struct cmd_set_gen_rate_result *res = parsed_result;
+
+	gen_rate = res->value;
+	gen_rate_bps = strcmp(res->unit, "bps") == 0;
+}
+
+static cmdline_parse_token_string_t cmd_set_gen_rate_set =
+	TOKEN_STRING_INITIALIZER(struct cmd_set_gen_rate_result, set, "set");
+static cmdline_parse_token_string_t cmd_set_gen_rate_gen =
+	TOKEN_STRING_INITIALIZER(struct cmd_set_gen_rate_result, gen, "gen");
+static cmdline_parse_token_string_t cmd_set_gen_rate_rate =
+	TOKEN_STRING_INITIALIZER(struct cmd_set_gen_rate_result, rate, "rate");
+static cmdline_parse_token_string_t cmd_set_gen_rate_unit =
+	TOKEN_STRING_INITIALIZER(struct cmd_set_gen_rate_result, unit,
+				 "pps#bps");
+static cmdline_parse_token_num_t cmd_set_gen_rate_value =
+	TOKEN_NUM_INITIALIZER(struct cmd_set_gen_rate_result, value,
+			      RTE_UINT64);
+
+static cmdline_parse_inst_t cmd_set_gen_rate = {
+	.f = cmd_set_gen_rate_parsed,
+	.data = NULL,
+	.help_str = "set gen rate pps|bps <rate>: "
+		"Set the rate of each Tx queue in gen mode, 0 for maximum rate",
+	.tokens = {
+		(void *)&cmd_set_gen_rate_set,
+		(void *)&cmd_set_gen_rate_gen,
+		(void *)&cmd_set_gen_rate_rate,
+		(void *)&cmd_set_gen_rate_unit,
+		(void *)&cmd_set_gen_rate_value,
+		NULL,
+	},
+};
+
+struct cmd_set_gen_flows_result {
+	cmdline_fixed_string_t set;
+	cmdline_fixed_string_t gen;
+	cmdline_fixed_string_t flows;
+	cmdline_fixed_string_t field;
+	uint32_t value;
+};
+
+static void
+cmd_set_gen_flows_parsed(void *parsed_result,
+			 __rte_unused struct cmdline *cl,
+			 __rte_unused void *data)
+{
+	struct cmd_set_gen_flows_result *res = parsed_result;
+	static const char * const fields[GEN_TUPLE_NUM] = {
+		[GEN_TUPLE_SRC_IP] = "src-ip",
+		[GEN_TUPLE_DST_IP] = "dst-ip",
+		[GEN_TUPLE_SRC_PORT] = "src-port",
+		[GEN_TUPLE_DST_PORT] = "dst-port",
+	};
+	unsigned int i;
+
+	for (i = 0; i < GEN_TUPLE_NUM; i++)
+		if (strcmp(res->field, fields[i]) == 0)
+			break;
+	if (i == GEN_TUPLE_NUM)
+		return;
+
+	if (res->value == 0 || ((i == GEN_TUPLE_SRC_PORT ||
+	    i == GEN_TUPLE_DST_PORT) && res->value > UINT16_MAX + 1)) {
+		fprintf(stderr, "Invalid number of %s values %u\n",
+			res->field, res->value);
+		return;
+	}
+
+	gen_flows[i] = res->value;
+}
+
+static cmdline_parse_token_string_t cmd_set_gen_flows_set =
+	TOKEN_STRING_INITIALIZER(struct cmd_set_gen_flows_result, set, "set");
+static cmdline_parse_token_string_t cmd_set_gen_flows_gen =
+	TOKEN_STRING_INITIALIZER(struct cmd_set_gen_flows_result, gen, "gen");
+static cmdline_parse_token_string_t cmd_set_gen_flows_flows =
+	TOKEN_STRING_INITIALIZER(struct cmd_set_gen_flows_result, flows,
+				 "flows");
+static cmdline_parse_token_string_t cmd_set_gen_flows_field =
+	TOKEN_STRING_INITIALIZER(struct cmd_set_gen_flows_result, field,
+				 "src-ip#dst-ip#src-port#dst-port");
+static cmdline_parse_token_num_t cmd_set_gen_flows_value =
+	TOKEN_NUM_INITIALIZER(struct cmd_set_gen_flows_result, value,
+			      RTE_UINT32);
+
+static cmdline_parse_inst_t cmd_set_gen_flows = {
+	.f = cmd_set_gen_flows_parsed,
+	.data = NULL,
+	.help_str = "set gen flows src-ip|dst-ip|src-port|dst-port <n>: "
+		"Set the number of values of a 5-tuple field in gen mode",
+	.tokens = {
+		(void *)&cmd_set_gen_flows_set,
+		(void *)&cmd_set_gen_flows_gen,
+		(void *)&cmd_set_gen_flows_flows,
+		(void *)&cmd_set_gen_flows_field,
+		(void *)&cmd_set_gen_flows_value,
+		NULL,
+	},
+};
+
+struct cmd_set_gen_probe_result {
+	cmdline_fixed_string_t set;
+	cmdline_fixed_string_t gen;
+	cmdline_fixed_string_t probe;
+	uint32_t interval;
+};
+
+static void
+cmd_set_gen_probe_parsed(void *parsed_result,
+			 __rte_unused struct cmdline *cl,
+			 __rte_unused void *data)
+{
+	struct cmd_set_gen_probe_result *res = parsed_result;
+
+	gen_probe_interval = res->interval;
+}
+
+static cmdline_parse_token_string_t cmd_set_gen_probe_set =
+	TOKEN_STRING_INITIALIZER(struct cmd_set_gen_probe_result, set, "set");
+static cmdline_parse_token_string_t cmd_set_gen_probe_gen =
+	TOKEN_STRING_INITIALIZER(struct cmd_set_gen_probe_result, gen, "gen");
+static cmdline_parse_token_string_t cmd_set_gen_probe_probe =
+	TOKEN_STRING_INITIALIZER(struct cmd_set_gen_probe_result, probe,
+				 "probe");
+static cmdline_parse_token_num_t cmd_set_gen_probe_interval =
+	TOKEN_NUM_INITIALIZER(struct cmd_set_gen_probe_result, interval,
+			      RTE_UINT32);
+
+static cmdline_parse_inst_t cmd_set_gen_probe = {
+	.f = cmd_set_gen_probe_parsed,
+	.data = NULL,
+	.help_str = "set gen probe <n>: "
+		"Send a latency probe every n packets in gen mode, 0 to disable",
+	.tokens = {
+		(void *)&cmd_set_gen_probe_set,
+		(void *)&cmd_set_gen_probe_gen,
+		(void *)&cmd_set_gen_probe_probe,
+		(void *)&cmd_set_gen_probe_interval,
+		NULL,
+	},
+};
+
 /* *** ADD/REMOVE ALL VLAN IDENTIFIERS TO/FROM A PORT VLAN RX FILTER *** */
 struct cmd_rx_vlan_filter_all_result {
 	cmdline_fixed_string_t rx_vlan;
@@ -14102,6 +14272,9 @@ static cmdline_parse_ctx_t builtin_ctx[] = {
 	&cmd_set_txpkts,
 	&cmd_set_txsplit,
 	&cmd_set_txtimes,
+	&cmd_set_gen_rate,
+	&cmd_set_gen_flows,
+	&cmd_set_gen_probe,
 	&cmd_set_fwd_list,
 	&cmd_set_fwd_mask,
 	&cmd_set_fwd_mode,
@@ -0,0 +1,372 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_bitops.h>
+#include <rte_byteorder.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_ether.h>
+#include <rte_ethdev.h>
+#include <rte_ip.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+#include <rte_mempool.h>
+#include <rte_udp.h>
+
+#include "testpmd.h"
+
+#define IP_DEFTTL  64   /* from RFC 1340. */
+
+/* Preamble, start of frame delimiter and inter-frame gap, in bytes */
+#define GEN_L1_OVERHEAD 20
+/* Bits of fraction of the TSC cycles between two packets */
+#define GEN_FRAC_SHIFT 16
+
+#define GEN_PROBE_MAGIC 0x70726f62 /* "prob" */
+
+/* UDP payload of the generated packets, the magic is only set in probes */
+struct gen_probe {
+	rte_be32_t magic;
+	uint32_t reserved;
+	uint64_t tsc; /**< TSC when the probe was built */
+};
+
+#define GEN_PROBE_OFF (sizeof(struct rte_ether_hdr) + \
+	sizeof(struct rte_ipv4_hdr) + sizeof(struct rte_udp_hdr))
+#define GEN_PROBE_LEN (GEN_PROBE_OFF + sizeof(struct gen_probe))
+
+/* TSC cycles between two packets of a queue, with GEN_FRAC_SHIFT fraction */
+static uint64_t gen_interval;
+/* Lag after which a queue gives up sending the late packets */
+static uint64_t gen_max_lag;
+
+static void
+gen_latency_reset(struct gen_latency *lat)
+{
+	memset(lat, 0, sizeof(*lat));
+	lat->min = UINT64_MAX;
+}
+
+/* Record the round trip times of the probes of a received burst */
+static void
+gen_probes_match(struct fwd_stream *fs, struct rte_mbuf **pkts,
+		 uint16_t nb_pkts)
+{
+	struct gen_latency *lat = &fs->latency;
+	struct rte_ether_hdr *eth_hdr;
+	struct rte_ipv4_hdr *ip_hdr;
+	struct gen_probe probe;
+	uint64_t now, rtt;
+	uint16_t i;
+
+	now = rte_rdtsc();
+	for (i = 0; i < nb_pkts; i++) {
+		if (pkts[i]->data_len < GEN_PROBE_LEN)
+			continue;
+
+		eth_hdr = rte_pktmbuf_mtod(pkts[i], struct rte_ether_hdr *);
+		ip_hdr = (struct rte_ipv4_hdr *)(eth_hdr + 1);
+		if (eth_hdr->ether_type != rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4) ||
+		    ip_hdr->version_ihl != RTE_IPV4_VHL_DEF ||
+		    ip_hdr->next_proto_id != IPPROTO_UDP)
+			continue;
+
+		/* The payload is not aligned */
+		memcpy(&probe, rte_pktmbuf_mtod_offset(pkts[i], void *,
+			GEN_PROBE_OFF), sizeof(probe));
+		if (probe.magic != RTE_BE32(GEN_PROBE_MAGIC) || probe.tsc > now)
+			continue;
+
+		rtt = now - probe.tsc;
+		lat->probes++;
+		lat->sum += rtt;
+		if (rtt < lat->min)
+			lat->min = rtt;
+		if (rtt > lat->max)
+			lat->max = rtt;
+		lat->hist[rtt == 0 ? 0 : rte_fls_u64(rtt) - 1]++;
+	}
+}
+
+/* Number of packets due on the queue of the stream */
+static inline uint16_t
+gen_pkts_due(struct fwd_stream *fs, uint64_t now)
+{
+	uint64_t frac;
+	uint16_t nb_pkts;
+
+	if (gen_interval == 0)
+		return nb_pkt_per_burst;
+
+	for (nb_pkts = 0; nb_pkts < nb_pkt_per_burst &&
+			fs->gen_deadline <= now; nb_pkts++) {
+		frac = fs->gen_frac +
+			(gen_interval & RTE_LEN2MASK(GEN_FRAC_SHIFT, uint64_t));
+		fs->gen_deadline += (gen_interval >> GEN_FRAC_SHIFT) +
+			(frac >> GEN_FRAC_SHIFT);
+		fs->gen_frac = (uint16_t)frac;
+	}
+
+	/* Do not burst to catch up once the queue could not keep the rate */
+	if (fs->gen_deadline + gen_max_lag < now)
+		fs->gen_deadline = now;
+
+	return nb_pkts;
+}
+
+static inline void
+gen_flow_next(struct fwd_stream *fs)
+{
+	unsigned int i;
+
+	for (i = 0; i < GEN_TUPLE_NUM; i++) {
+		if (++fs->gen_tuple[i] < gen_flows[i])
+			return;
+		fs->gen_tuple[i] = 0;
+	}
+}
+
+static inline void
+gen_pkt_setup(struct fwd_stream *fs, struct rte_mbuf *pkt, uint16_t pkt_size,
+	      uint64_t ol_flags)
+{
+	struct rte_ether_hdr *eth_hdr;
+	struct rte_ipv4_hdr *ip_hdr;
+	struct rte_udp_hdr *udp_hdr;
+	struct gen_probe probe;
+
+	eth_hdr = rte_pktmbuf_mtod(pkt, struct rte_ether_hdr *);
+	rte_ether_addr_copy(&peer_eth_addrs[fs->peer_addr], &eth_hdr->dst_addr);
+	rte_ether_addr_copy(&ports[fs->tx_port].eth_addr, &eth_hdr->src_addr);
+	eth_hdr->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+
+	ip_hdr = (struct rte_ipv4_hdr *)(eth_hdr + 1);
+	memset(ip_hdr, 0, sizeof(*ip_hdr));
+	ip_hdr->version_ihl	= RTE_IPV4_VHL_DEF;
+	ip_hdr->time_to_live	= IP_DEFTTL;
+	ip_hdr->next_proto_id	= IPPROTO_UDP;
+	ip_hdr->src_addr	= rte_cpu_to_be_32(tx_ip_src_addr +
+					fs->gen_tuple[GEN_TUPLE_SRC_IP]);
+	ip_hdr->dst_addr	= rte_cpu_to_be_32(tx_ip_dst_addr +
+					fs->gen_tuple[GEN_TUPLE_DST_IP]);
+	ip_hdr->total_length	= rte_cpu_to_be_16(pkt_size -
+					sizeof(*eth_hdr));
+	ip_hdr->hdr_checksum	= rte_ipv4_cksum(ip_hdr);
+
+	udp_hdr = (struct rte_udp_hdr *)(ip_hdr + 1);
+	udp_hdr->src_port	= rte_cpu_to_be_16(tx_udp_src_port +
+					fs->gen_tuple[GEN_TUPLE_SRC_PORT]);
+	udp_hdr->dst_port	= rte_cpu_to_be_16(tx_udp_dst_port +
+					fs->gen_tuple[GEN_TUPLE_DST_PORT]);
+	udp_hdr->dgram_cksum	= 0; /* No UDP checksum. */
+	udp_hdr->dgram_len	= rte_cpu_to_be_16(pkt_size -
+					sizeof(*eth_hdr) - sizeof(*ip_hdr));
+
+	/* Recycled mbufs may hold an old probe, clear the magic anyway */
+	if (pkt_size >= GEN_PROBE_LEN) {
+		probe.magic = 0;
+		probe.reserved = 0;
+		probe.tsc = 0;
+		if (gen_probe_interval != 0 &&
+		    ++fs->gen_probe_cnt >= gen_probe_interval) {
+			fs->gen_probe_cnt = 0;
+			probe.magic = RTE_BE32(GEN_PROBE_MAGIC);
+			probe.tsc = rte_rdtsc();
+		}
+		memcpy(rte_pktmbuf_mtod_offset(pkt, void *, GEN_PROBE_OFF),
+			&probe, sizeof(probe));
+	}
+
+	pkt->data_len		= pkt_size;
+	pkt->pkt_len		= pkt_size;
+	pkt->ol_flags		|= ol_flags;
+	pkt->vlan_tci		= ports[fs->tx_port].tx_vlan_id;
+	pkt->vlan_tci_outer	= ports[fs->tx_port].tx_vlan_id_outer;
+	pkt->l2_len		= sizeof(struct rte_ether_hdr);
+	pkt->l3_len		= sizeof(struct rte_ipv4_hdr);
+
+	gen_flow_next(fs);
+}
+
+/*
+ * Traffic generation mode.
+ *
+ * Each stream sends packets paced to the configured rate, cycling over
+ * the configured ranges of the 5-tuple fields, and receives packets
+ * to measure the round trip time of the probes among them.
+ */
+static bool
+pkt_burst_gen(struct fwd_stream *fs)
+{
+	unsigned int pkt_size = tx_pkt_length - 4;	/* Adjust FCS */
+	struct rte_mbuf *pkts_burst[MAX_PKT_BURST];
+	uint64_t ol_flags = 0;
+	uint64_t tx_offloads;
+	uint16_t nb_rx;
+	uint16_t nb_pkt;
+	uint16_t i;
+
+	nb_rx = common_fwd_stream_receive(fs, pkts_burst, nb_pkt_per_burst);
+	if (nb_rx != 0) {
+		gen_probes_match(fs, pkts_burst, nb_rx);
+		rte_pktmbuf_free_bulk(pkts_burst, nb_rx);
+	}
+
+	nb_pkt = gen_pkts_due(fs, rte_rdtsc());
+	if (nb_pkt == 0)
+		return nb_rx != 0;
+
+	if (rte_pktmbuf_alloc_bulk(current_fwd_lcore()->mbp, pkts_burst,
+			nb_pkt) != 0)
+		return nb_rx != 0;
+
+	tx_offloads = ports[fs->tx_port].dev_conf.txmode.offloads;
+	if (tx_offloads & RTE_ETH_TX_OFFLOAD_VLAN_INSERT)
+		ol_flags |= RTE_MBUF_F_TX_VLAN;
+	if (tx_offloads & RTE_ETH_TX_OFFLOAD_QINQ_INSERT)
+		ol_flags |= RTE_MBUF_F_TX_QINQ;
+	if (tx_offloads & RTE_ETH_TX_OFFLOAD_MACSEC_INSERT)
+		ol_flags |= RTE_MBUF_F_TX_MACSEC;
+
+	for (i = 0; i < nb_pkt; i++)
+		gen_pkt_setup(fs, pkts_burst[i], pkt_size, ol_flags);
+
+	common_fwd_stream_transmit(fs, pkts_burst, nb_pkt);
+
+	return true;
+}
+
+static int
+gen_begin(portid_t pi)
+{
+	uint64_t pps = gen_rate;
+
+	if (gen_probe_interval != 0 && tx_pkt_length - 4u < GEN_PROBE_LEN) {
+		fprintf(stderr, "gen mode: packets of %u bytes too short for probes of %zu bytes\n",
+			tx_pkt_length, GEN_PROBE_LEN + 4);
+		return -EINVAL;
+	}
+
+	if (gen_rate_bps)
+		pps = gen_rate / ((tx_pkt_length + GEN_L1_OVERHEAD) * CHAR_BIT);
+	if (gen_rate != 0 && pps == 0) {
+		fprintf(stderr, "gen mode: rate below one packet per second\n");
+		return -EINVAL;
+	}
+
+	gen_interval = pps != 0 ? (rte_get_tsc_hz() << GEN_FRAC_SHIFT) / pps : 0;
+	gen_max_lag = (gen_interval >> GEN_FRAC_SHIFT) * nb_pkt_per_burst;
+
+	printf("  gen mode port %u: %"PRIu64" packet/s per Tx queue, "
+	       "flows %u/%u/%u/%u, one probe per %u packets\n", pi, pps,
+	       gen_flows[GEN_TUPLE_SRC_IP], gen_flows[GEN_TUPLE_DST_IP],
+	       gen_flows[GEN_TUPLE_SRC_PORT], gen_flows[GEN_TUPLE_DST_PORT],
+	       gen_probe_interval);
+	return 0;
+}
+
+/* Display the round trip times of the probes received by a port */
+static void
+gen_end(portid_t pi)
+{
+	double us_per_cycle = 1E6 / rte_get_tsc_hz();
+	struct gen_latency lat;
+	struct fwd_stream *fs;
+	streamid_t sm_id;
+	unsigned int i;
+
+	gen_latency_reset(&lat);
+	for (sm_id = 0; sm_id < cur_fwd_config.nb_fwd_streams; sm_id++) {
+		fs = fwd_streams[sm_id];
+		if (fs->rx_port != pi)
+			continue;
+
+		lat.probes += fs->latency.probes;
+		lat.sum += fs->latency.sum;
+		lat.min = RTE_MIN(lat.min, fs->latency.min);
+		lat.max = RTE_MAX(lat.max, fs->latency.max);
+		for (i = 0; i < GEN_LATENCY_BUCKETS; i++)
+			lat.hist[i] += fs->latency.hist[i];
+	}
+
+	if (lat.probes == 0) {
+		printf("  port %u: no latency probe received\n", pi);
+		return;
+	}
+
+	printf("  port %u: %"PRIu64" latency probes, min/avg/max "
+	       "%.3f/%.3f/%.3f us\n", pi, lat.probes, lat.min * us_per_cycle,
+	       (double)lat.sum / lat.probes * us_per_cycle,
+	       lat.max * us_per_cycle);
+	for (i = 0; i < GEN_LATENCY_BUCKETS; i++) {
+		if (lat.hist[i] == 0)
+			continue;
+		printf("    [%.3f, %.3f) us: %"PRIu64"\n",
+		       (double)(UINT64_C(1) << i) * us_per_cycle,
+		       (double)(UINT64_C(1) << i) * 2 * us_per_cycle,
+		       lat.hist[i]);
+	}
+}
+
+static void
+gen_stream_init(struct fwd_stream *fs)
+{
+	common_fwd_stream_init(fs);
+	fs->gen_deadline = rte_rdtsc();
+	fs->gen_frac = 0;
+	fs->gen_probe_cnt = 0;
+	memset(fs->gen_tuple, 0, sizeof(fs->gen_tuple));
+	gen_latency_reset(&fs->latency);
+}
+
+struct fwd_engine gen_engine = {
+	.fwd_mode_name  = "gen",
+	.port_fwd_begin = gen_begin,
+	.port_fwd_end   = gen_end,
+	.stream_init    = gen_stream_init,
+	.packet_fwd     = pkt_burst_gen,
+};
+
+/*
+ * Latency mode: receive the packets of "gen" mode and measure the round
+ * trip time of their probes. The probes hold the TSC of the generator,
+ * which must run on the same host.
+ */
+static bool
+pkt_burst_latency(struct fwd_stream *fs)
+{
+	struct rte_mbuf *pkts_burst[MAX_PKT_BURST];
+	uint16_t nb_rx;
+
+	nb_rx = common_fwd_stream_receive(fs, pkts_burst, nb_pkt_per_burst);
+	if (unlikely(nb_rx == 0))
+		return false;
+
+	gen_probes_match(fs, pkts_burst, nb_rx);
+	rte_pktmbuf_free_bulk(pkts_burst, nb_rx);
+
+	return true;
+}
+
+static void
+latency_stream_init(struct fwd_stream *fs)
+{
+	fs->disabled = ports[fs->rx_port].rxq[fs->rx_queue].state ==
+						RTE_ETH_QUEUE_STATE_STOPPED;
+	gen_latency_reset(&fs->latency);
+}
+
+struct fwd_engine latency_engine = {
+	.fwd_mode_name  = "latency",
+	.port_fwd_end   = gen_end,
+	.stream_init    = latency_stream_init,
+	.packet_fwd     = pkt_burst_latency,
+};
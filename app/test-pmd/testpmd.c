@@ -208,6 +208,8 @@ struct fwd_engine * fwd_engines[] = {
 	&ieee1588_fwd_engine,
 #endif
 	&shared_rxq_engine,
+	&gen_engine,
+	&latency_engine,
 	NULL,
 };
 
@@ -287,6 +289,18 @@ enum tx_pkt_split tx_pkt_split = TX_PKT_SPLIT_OFF;
 uint8_t txonly_multi_flow;
 /**< Whether multiple flows are generated in TXONLY mode. */
 
+uint64_t gen_rate;
+/**< Rate of each Tx queue in GEN mode, 0 to send at maximum rate. */
+
+uint8_t gen_rate_bps;
+/**< Whether gen_rate is in bit/s, layer 1 overhead included. */
+
+uint32_t gen_flows[GEN_TUPLE_NUM] = { 1, 1, 1, 1 };
+/**< Number of values taken by each 5-tuple field in GEN mode. */
+
+uint32_t gen_probe_interval;
+/**< Number of packets per latency probe in GEN mode, 0 for no probes. */
+
 uint32_t tx_pkt_times_inter;
 /**< Timings for send scheduling in TXONLY mode, time between bursts. */
 
@@ -2141,7 +2155,8 @@ fwd_stats_display(void)
 		if (total_recv > 0 || total_xmit > 0) {
 			uint64_t total_pkts = 0;
 			if (strcmp(cur_fwd_eng->fwd_mode_name, "txonly") == 0 ||
-			    strcmp(cur_fwd_eng->fwd_mode_name, "flowgen") == 0)
+			    strcmp(cur_fwd_eng->fwd_mode_name, "flowgen") == 0 ||
+			    strcmp(cur_fwd_eng->fwd_mode_name, "gen") == 0)
 				total_pkts = total_xmit;
 			else
 				total_pkts = total_recv;
@@ -2482,13 +2497,16 @@ start_packet_forwarding(int with_tx_first)
 	stream_init_t stream_init = cur_fwd_eng->stream_init;
 	unsigned int i;
 
-	if (strcmp(cur_fwd_eng->fwd_mode_name, "rxonly") == 0 && !nb_rxq)
-		rte_exit(EXIT_FAILURE, "rxq are 0, cannot use rxonly fwd mode\n");
+	if ((strcmp(cur_fwd_eng->fwd_mode_name, "rxonly") == 0 ||
+		strcmp(cur_fwd_eng->fwd_mode_name, "latency") == 0) && !nb_rxq)
+		rte_exit(EXIT_FAILURE, "rxq are 0, cannot use %s fwd mode\n",
+			cur_fwd_eng->fwd_mode_name);
 
 	if (strcmp(cur_fwd_eng->fwd_mode_name, "txonly") == 0 && !nb_txq)
 		rte_exit(EXIT_FAILURE, "txq are 0, cannot use txonly fwd mode\n");
 
 	if ((strcmp(cur_fwd_eng->fwd_mode_name, "rxonly") != 0 &&
+		strcmp(cur_fwd_eng->fwd_mode_name, "latency") != 0 &&
 		strcmp(cur_fwd_eng->fwd_mode_name, "txonly") != 0) &&
 		(!nb_rxq || !nb_txq))
 		rte_exit(EXIT_FAILURE,
@@ -175,6 +175,30 @@ extern const struct rss_type_info rss_type_table[];
  */
 extern char dynf_names[64][RTE_MBUF_DYN_NAMESIZE];
 
+/*
+ * Fields of the 5-tuple varied by the "gen" processing engine.
+ */
+enum gen_tuple {
+	GEN_TUPLE_SRC_IP,
+	GEN_TUPLE_DST_IP,
+	GEN_TUPLE_SRC_PORT,
+	GEN_TUPLE_DST_PORT,
+	GEN_TUPLE_NUM,
+};
+
+#define GEN_LATENCY_BUCKETS 64
+
+/**
+ * Round trip times of the probes received in "gen" and "latency" modes.
+ */
+struct gen_latency {
+	uint64_t probes; /**< received probes */
+	uint64_t sum;    /**< sum of the times, in TSC cycles */
+	uint64_t min;    /**< minimum time */
+	uint64_t max;    /**< maximum time */
+	uint64_t hist[GEN_LATENCY_BUCKETS]; /**< log2 histogram of the times */
+};
+
 /**
  * The data structure associated with a forwarding stream between a receive
  * port/queue and a transmit port/queue.
@@ -201,6 +225,11 @@ struct fwd_stream {
 	uint64_t rx_bad_outer_ip_csum;
 	/**< received packets having bad outer ip checksum */
 	uint64_t ts_skew; /**< TX scheduling timestamp */
+	uint64_t gen_deadline; /**< TSC of the next packet in gen mode */
+	uint16_t gen_frac; /**< fraction of TSC cycle of gen_deadline */
+	uint32_t gen_probe_cnt; /**< packets sent since the last probe */
+	uint32_t gen_tuple[GEN_TUPLE_NUM]; /**< next flow in gen mode */
+	struct gen_latency latency; /**< probes received in gen/latency modes */
 #ifdef RTE_LIB_GRO
 	unsigned int gro_times;	/**< GRO operation times */
 #endif
@@ -480,6 +509,8 @@ extern struct fwd_engine recycle_mbufs_engine;
 extern struct fwd_engine ieee1588_fwd_engine;
 #endif
 extern struct fwd_engine shared_rxq_engine;
+extern struct fwd_engine gen_engine;
+extern struct fwd_engine latency_engine;
 
 extern struct fwd_engine * fwd_engines[]; /**< NULL terminated array. */
 extern cmdline_parse_inst_t cmd_set_raw;
@@ -674,6 +705,14 @@ extern enum tx_pkt_split tx_pkt_split;
 
 extern uint8_t txonly_multi_flow;
 
+/*
+ * Configuration of the "gen" processing engine.
+ */
+extern uint64_t gen_rate; /**< Rate of each Tx queue, 0 for no pacing */
+extern uint8_t gen_rate_bps; /**< gen_rate is in bit/s rather than packet/s */
+extern uint32_t gen_flows[GEN_TUPLE_NUM]; /**< Values of each tuple field */
+extern uint32_t gen_probe_interval; /**< Packets per probe, 0 for none */
+
 extern uint32_t rxq_share;
 
 extern uint16_t nb_pkt_per_burst;
@@ -2,6 +2,7 @@
  * Copyright(c) 2010-2014 Intel Corporation
  */
 
+#include <stdlib.h>
 #include <string.h>
 #include <errno.h>
 
@@ -11,6 +12,7 @@
 #include <rte_mbuf.h>
 #include <rte_byteorder.h>
 #include <rte_ip.h>
+#include <rte_random.h>
 
 #ifdef RTE_EXEC_ENV_WINDOWS
 static int
@@ -1721,6 +1723,385 @@ test_u32_range(void)
 	return rc;
 }
 
+#define	TEST_BUILD_MT_RULES	0x1000
+#define	TEST_BUILD_MT_DATA	0x400
+#define	TEST_BUILD_MT_WORKERS	4
+
+static uint32_t
+build_mt_mask(uint32_t len)
+{
+	return (len == 0) ? 0 : UINT32_MAX << (32 - len);
+}
+
+static void
+fill_build_mt_rule(struct rte_acl_ipv4vlan_rule *r, uint32_t i)
+{
+	uint16_t p;
+
+	memset(r, 0, sizeof(*r));
+	r->data.userdata = i + 1;
+	r->data.priority = i + 1;
+	r->data.category_mask = RTE_BIT32(i % RTE_ACL_MAX_CATEGORIES);
+	r->proto = (rte_rand() & 1) ? IPPROTO_TCP : IPPROTO_UDP;
+	r->proto_mask = UINT8_MAX;
+	r->src_mask_len = rte_rand_max(33);
+	r->src_addr = rte_rand() & build_mt_mask(r->src_mask_len);
+	r->dst_mask_len = rte_rand_max(33);
+	r->dst_addr = rte_rand() & build_mt_mask(r->dst_mask_len);
+	p = rte_rand();
+	r->src_port_low = p;
+	r->src_port_high = p + rte_rand_max(UINT16_MAX - p + 1);
+	p = rte_rand();
+	r->dst_port_low = p;
+	r->dst_port_high = p + rte_rand_max(UINT16_MAX - p + 1);
+}
+
+/* Generate a tuple matching the given rule. */
+static void
+fill_build_mt_data(struct ipv4_7tuple *d, const struct rte_acl_ipv4vlan_rule *r)
+{
+	uint32_t m;
+
+	memset(d, 0, sizeof(*d));
+	d->proto = r->proto;
+	m = build_mt_mask(r->src_mask_len);
+	d->ip_src = r->src_addr | (rte_rand() & ~m);
+	m = build_mt_mask(r->dst_mask_len);
+	d->ip_dst = r->dst_addr | (rte_rand() & ~m);
+	d->port_src = r->src_port_low +
+		rte_rand_max(r->src_port_high - r->src_port_low + 1);
+	d->port_dst = r->dst_port_low +
+		rte_rand_max(r->dst_port_high - r->dst_port_low + 1);
+}
+
+/*
+ * Test that building a large rule-set with worker threads
+ * gives the same results as rte_acl_build().
+ */
+static int
+test_build_mt(void)
+{
+	struct rte_acl_ctx *acx[2];
+	struct rte_acl_config cfg;
+	struct rte_acl_param param;
+	struct rte_acl_ipv4vlan_rule *rules;
+	struct ipv4_7tuple *tdata;
+	const uint8_t **data;
+	uint32_t *res[2];
+	uint32_t i, k;
+	int ret;
+
+	rules = calloc(TEST_BUILD_MT_RULES, sizeof(rules[0]));
+	tdata = calloc(TEST_BUILD_MT_DATA, sizeof(tdata[0]));
+	data = calloc(TEST_BUILD_MT_DATA, sizeof(data[0]));
+	res[0] = calloc(TEST_BUILD_MT_DATA * RTE_ACL_MAX_CATEGORIES,
+		sizeof(res[0][0]));
+	res[1] = calloc(TEST_BUILD_MT_DATA * RTE_ACL_MAX_CATEGORIES,
+		sizeof(res[1][0]));
+	acx[0] = NULL;
+	acx[1] = NULL;
+	ret = -ENOMEM;
+	if (rules == NULL || tdata == NULL || data == NULL ||
+			res[0] == NULL || res[1] == NULL) {
+		printf("Line %i: Error allocating memory!\n", __LINE__);
+		goto err;
+	}
+
+	for (i = 0; i != TEST_BUILD_MT_RULES; i++)
+		fill_build_mt_rule(rules + i, i);
+
+	/* half of the tuples match a rule, the other half are random */
+	for (i = 0; i != TEST_BUILD_MT_DATA; i++) {
+		fill_build_mt_data(tdata + i,
+			rules + rte_rand_max(TEST_BUILD_MT_RULES));
+		if ((i & 1) != 0) {
+			tdata[i].ip_src = rte_rand();
+			tdata[i].ip_dst = rte_rand();
+		}
+	}
+
+	acl_ipv4vlan_config(&cfg, ipv4_7tuple_layout, RTE_ACL_MAX_CATEGORIES);
+	memcpy(&param, &acl_param, sizeof(param));
+
+	for (k = 0; k != RTE_DIM(acx); k++) {
+		param.name = (k == 0) ? "acl_ctx" : "acl_ctx_mt";
+		acx[k] = rte_acl_create(&param);
+		if (acx[k] == NULL) {
+			printf("Line %i: Error creating ACL context!\n",
+				__LINE__);
+			ret = -1;
+			goto err;
+		}
+		ret = rte_acl_ipv4vlan_add_rules(acx[k], rules,
+			TEST_BUILD_MT_RULES);
+		if (ret != 0) {
+			printf("Line %i: Adding rules failed!\n", __LINE__);
+			goto err;
+		}
+	}
+
+	ret = rte_acl_build(acx[0], &cfg);
+	if (ret == 0)
+		ret = rte_acl_build_mt(acx[1], &cfg, TEST_BUILD_MT_WORKERS);
+	if (ret != 0) {
+		printf("Line %i: Building ACL context failed!\n", __LINE__);
+		goto err;
+	}
+
+	bswap_test_data(tdata, TEST_BUILD_MT_DATA, 1);
+	for (i = 0; i != TEST_BUILD_MT_DATA; i++)
+		data[i] = (uint8_t *)&tdata[i];
+
+	for (k = 0; k != RTE_DIM(acx) && ret == 0; k++)
+		ret = rte_acl_classify(acx[k], data, res[k],
+			TEST_BUILD_MT_DATA, RTE_ACL_MAX_CATEGORIES);
+	if (ret != 0) {
+		printf("Line %i: classify failed!\n", __LINE__);
+		goto err;
+	}
+
+	for (i = 0; i != TEST_BUILD_MT_DATA * RTE_ACL_MAX_CATEGORIES; i++) {
+		if (res[0][i] != res[1][i]) {
+			printf("Line %i: Error in results at %u "
+				"(expected %"PRIu32" got %"PRIu32")!\n",
+				__LINE__, i, res[0][i], res[1][i]);
+			ret = -EINVAL;
+			break;
+		}
+	}
+
+err:
+	rte_acl_free(acx[0]);
+	rte_acl_free(acx[1]);
+	free(res[1]);
+	free(res[0]);
+	free(data);
+	free(tdata);
+	free(rules);
+	return ret;
+}
+
+/*
+ * Classify the test data with the incremental context and with a context
+ * built from the live rules, and compare the results.
+ */
+static int
+test_incremental_check(const struct rte_acl_incr *incr, const uint8_t *live)
+{
+	struct rte_acl_ctx *acx;
+	uint32_t i, n;
+	int ret;
+	const uint8_t *data[RTE_DIM(acl_test_data)];
+	uint32_t res[RTE_DIM(acl_test_data) * RTE_ACL_MAX_CATEGORIES];
+	uint32_t ref[RTE_DIM(acl_test_data) * RTE_ACL_MAX_CATEGORIES];
+
+	acx = rte_acl_create(&acl_param);
+	if (acx == NULL) {
+		printf("Line %i: Error creating ACL context!\n", __LINE__);
+		return -1;
+	}
+
+	ret = 0;
+	n = 0;
+	for (i = 0; i != RTE_DIM(acl_test_rules) && ret == 0; i++) {
+		if (live[i] != 0) {
+			ret = rte_acl_ipv4vlan_add_rules(acx,
+				acl_test_rules + i, 1);
+			n++;
+		}
+	}
+	if (ret == 0 && n != 0)
+		ret = rte_acl_ipv4vlan_build(acx, ipv4_7tuple_layout,
+			RTE_ACL_MAX_CATEGORIES);
+	if (ret != 0) {
+		printf("Line %i: Building ACL context failed!\n", __LINE__);
+		rte_acl_free(acx);
+		return ret;
+	}
+
+	bswap_test_data(acl_test_data, RTE_DIM(acl_test_data), 1);
+	for (i = 0; i != RTE_DIM(acl_test_data); i++)
+		data[i] = (uint8_t *)&acl_test_data[i];
+
+	memset(ref, 0, sizeof(ref));
+	if (n != 0)
+		ret = rte_acl_classify(acx, data, ref, RTE_DIM(data),
+			RTE_ACL_MAX_CATEGORIES);
+	if (ret == 0)
+		ret = rte_acl_incr_classify(incr, data, res, RTE_DIM(data),
+			RTE_ACL_MAX_CATEGORIES);
+	bswap_test_data(acl_test_data, RTE_DIM(acl_test_data), 0);
+	rte_acl_free(acx);
+
+	if (ret != 0) {
+		printf("Line %i: classify failed!\n", __LINE__);
+		return ret;
+	}
+
+	for (i = 0; i != RTE_DIM(res); i++) {
+		if (res[i] != ref[i]) {
+			printf("Line %i: Error in results at %u "
+				"(expected %"PRIu32" got %"PRIu32")!\n",
+				__LINE__, i, ref[i], res[i]);
+			return -EINVAL;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Test adding and deleting rules of an incremental ACL context.
+ */
+static int
+test_incremental(void)
+{
+	struct rte_acl_incr_param prm;
+	struct rte_acl_config cfg;
+	struct rte_acl_incr *incr;
+	uint32_t i, half, num;
+	int ret;
+	uint8_t live[RTE_DIM(acl_test_rules)];
+	uint32_t userdata[RTE_DIM(acl_test_rules)];
+	struct acl_ipv4vlan_rule rules[RTE_DIM(acl_test_rules)];
+
+	num = RTE_DIM(acl_test_rules);
+	half = num / 2;
+
+	acl_ipv4vlan_config(&cfg, ipv4_7tuple_layout, RTE_ACL_MAX_CATEGORIES);
+	for (i = 0; i != num; i++) {
+		acl_ipv4vlan_convert_rule(acl_test_rules + i, rules + i);
+		userdata[i] = acl_test_rules[i].data.userdata;
+	}
+
+	memset(&prm, 0, sizeof(prm));
+	prm.name = "acl_incr";
+	prm.socket_id = SOCKET_ID_ANY;
+	prm.rule_size = sizeof(rules[0]);
+	prm.max_rule_num = num;
+	prm.cfg = &cfg;
+
+	/* invalid parameters */
+	if (rte_acl_incr_create(NULL) != NULL) {
+		printf("Line %i: created context with NULL param!\n",
+			__LINE__);
+		return -1;
+	}
+	prm.max_rule_num = 0;
+	if (rte_acl_incr_create(&prm) != NULL) {
+		printf("Line %i: created context with no rules!\n",
+			__LINE__);
+		return -1;
+	}
+	prm.max_rule_num = num;
+
+	incr = rte_acl_incr_create(&prm);
+	if (incr == NULL) {
+		printf("Line %i: Error creating incremental context!\n",
+			__LINE__);
+		return -1;
+	}
+
+	memset(live, 0, sizeof(live));
+	ret = test_incremental_check(incr, live);
+	if (ret != 0)
+		goto err;
+
+	/* first half goes to the main trie */
+	ret = rte_acl_incr_add_rules(incr, (struct rte_acl_rule *)rules, half);
+	if (ret != 0) {
+		printf("Line %i: Adding rules failed!\n", __LINE__);
+		goto err;
+	}
+	memset(live, 1, half);
+	ret = test_incremental_check(incr, live);
+	if (ret != 0)
+		goto err;
+
+	ret = rte_acl_incr_merge(incr);
+	if (ret != 0 || rte_acl_incr_delta_count(incr) != 0) {
+		printf("Line %i: Merging rules failed!\n", __LINE__);
+		ret = -1;
+		goto err;
+	}
+
+	/* duplicate user data */
+	ret = rte_acl_incr_add_rules(incr, (struct rte_acl_rule *)rules, 1);
+	if (ret != -EEXIST) {
+		printf("Line %i: Adding duplicate rule returned %d!\n",
+			__LINE__, ret);
+		ret = -1;
+		goto err;
+	}
+
+	/* second half goes to the delta trie */
+	ret = rte_acl_incr_add_rules(incr,
+		(struct rte_acl_rule *)(rules + half), num - half);
+	if (ret != 0 || rte_acl_incr_delta_count(incr) != num - half) {
+		printf("Line %i: Adding rules failed!\n", __LINE__);
+		ret = -1;
+		goto err;
+	}
+	memset(live, 1, num);
+	ret = test_incremental_check(incr, live);
+	if (ret != 0)
+		goto err;
+
+	/* context is full */
+	ret = rte_acl_incr_add_rules(incr, (struct rte_acl_rule *)rules, 1);
+	if (ret != -ENOMEM) {
+		printf("Line %i: Adding rule to full context returned %d!\n",
+			__LINE__, ret);
+		ret = -1;
+		goto err;
+	}
+
+	/* delete every other rule, from both tries */
+	for (i = 0; i < num; i += 2) {
+		ret = rte_acl_incr_del_rules(incr, userdata + i, 1);
+		if (ret != 0) {
+			printf("Line %i: Deleting rule %u failed!\n",
+				__LINE__, userdata[i]);
+			goto err;
+		}
+		live[i] = 0;
+	}
+	ret = test_incremental_check(incr, live);
+	if (ret != 0)
+		goto err;
+
+	ret = rte_acl_incr_del_rules(incr, userdata, 1);
+	if (ret != -ENOENT) {
+		printf("Line %i: Deleting missing rule returned %d!\n",
+			__LINE__, ret);
+		ret = -1;
+		goto err;
+	}
+
+	ret = rte_acl_incr_merge(incr);
+	if (ret != 0 || rte_acl_incr_delta_count(incr) != 0) {
+		printf("Line %i: Merging rules failed!\n", __LINE__);
+		ret = -1;
+		goto err;
+	}
+	ret = test_incremental_check(incr, live);
+	if (ret != 0)
+		goto err;
+
+	/* the slots of the deleted rules are free again */
+	ret = rte_acl_incr_add_rules(incr, (struct rte_acl_rule *)rules, 1);
+	if (ret != 0) {
+		printf("Line %i: Adding rule after merge failed!\n",
+			__LINE__);
+		goto err;
+	}
+	live[0] = 1;
+	ret = test_incremental_check(incr, live);
+
+err:
+	rte_acl_incr_free(incr);
+	return ret;
+}
+
 static int
 test_acl(void)
 {
@@ -1742,6 +2123,10 @@ test_acl(void)
 		return -1;
 	if (test_u32_range() < 0)
 		return -1;
+	if (test_build_mt() < 0)
+		return -1;
+	if (test_incremental() < 0)
+		return -1;
 
 	return 0;
 }
@@ -148,6 +148,76 @@ test_stats_bitrate_calc(void)
 	return TEST_SUCCESS;
 }
 
+/* Get the bit rate metrics of a port, in registration order */
+static int
+test_bitrate_values_get(uint16_t port, uint64_t *bits)
+{
+	struct rte_metric_name names[RTE_METRICS_MAX_METRICS];
+	struct rte_metric_value values[RTE_METRICS_MAX_METRICS];
+	int count;
+	int i;
+
+	count = rte_metrics_get_names(names, RTE_DIM(names));
+	if (count < 0 || count > (int)RTE_DIM(names))
+		return -1;
+	if (rte_metrics_get_values(port, values, RTE_DIM(values)) != count)
+		return -1;
+
+	for (i = 0; i + 6 <= count; i++) {
+		if (strcmp(names[i].name, "ewma_bits_in") == 0) {
+			bits[0] = values[i].value;
+			bits[1] = values[i + 1].value;
+			bits[2] = values[i + 2].value;
+			bits[3] = values[i + 3].value;
+			bits[4] = values[i + 4].value;
+			bits[5] = values[i + 5].value;
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+/* To test the bit rate calculation from byte counters of the caller */
+static int
+test_stats_bitrate_calc_bytes(void)
+{
+	uint16_t port = RTE_MAX_ETHPORTS - 1;
+	uint64_t bits[6];
+	int ret = 0;
+
+	ret = rte_stats_bitrate_calc_bytes(NULL, port, 0, 0);
+	TEST_ASSERT(ret == -EINVAL, "Test Failed: Expected -%d for invalid "
+			"bitrate data rte_stats_bitrate_calc_bytes ret:%d",
+			EINVAL, ret);
+
+	ret = rte_stats_bitrate_calc_bytes(bitrate_data, RTE_MAX_ETHPORTS,
+			0, 0);
+	TEST_ASSERT(ret == -EINVAL, "Test Failed: Expected -%d for higher "
+			"portid rte_stats_bitrate_calc_bytes ret:%d",
+			EINVAL, ret);
+
+	/* No ethdev needed, the port only selects the metrics */
+	ret = rte_stats_bitrate_calc_bytes(bitrate_data, port, 1000, 500);
+	TEST_ASSERT(ret >= 0, "Test Failed: Expected >=0 for valid portid "
+			"rte_stats_bitrate_calc_bytes ret:%d", ret);
+	ret = rte_stats_bitrate_calc_bytes(bitrate_data, port, 2000, 1000);
+	TEST_ASSERT(ret >= 0, "Test Failed: Expected >=0 for valid portid "
+			"rte_stats_bitrate_calc_bytes ret:%d", ret);
+
+	ret = test_bitrate_values_get(port, bits);
+	TEST_ASSERT(ret == 0, "Test Failed: bit rate metrics not found");
+	/* EWMA of 20% on 8000 then 8000 bits in, 4000 then 4000 out */
+	TEST_ASSERT(bits[0] == 2880 && bits[1] == 1440,
+			"Test Failed: wrong EWMA bit rates");
+	TEST_ASSERT(bits[2] == 8000 && bits[3] == 4000,
+			"Test Failed: wrong mean bit rates");
+	TEST_ASSERT(bits[4] == 8000 && bits[5] == 4000,
+			"Test Failed: wrong peak bit rates");
+
+	return TEST_SUCCESS;
+}
+
 static int
 test_bit_packet_forward(void)
 {
@@ -238,7 +308,13 @@ unit_test_suite bitratestats_testsuite  = {
 		 */
 		TEST_CASE_ST(test_bit_packet_forward, NULL,
 				test_stats_bitrate_calc),
-		/* TEST CASE 9: Test to do the cleanup w.r.t create */
+
+		/* TEST CASE 9: Test to calculate bit rate data metrics
+		 * from byte counters with valid and invalid arguments
+		 */
+		TEST_CASE(test_stats_bitrate_calc_bytes),
+
+		/* TEST CASE 10: Test to do the cleanup w.r.t create */
 		TEST_CASE(test_stats_bitrate_free),
 		TEST_CASES_END()
 	}
@@ -30,6 +30,7 @@ test_bpf(void)
 #else
 
 #include <rte_bpf.h>
+#include <rte_bpf_map.h>
 #include <rte_ether.h>
 #include <rte_ip.h>
 
@@ -3474,7 +3475,10 @@ run_test(const struct bpf_test *tst)
 	int64_t rc;
 	struct rte_bpf *bpf;
 	struct rte_bpf_jit jit;
+	struct rte_bpf_jit_burst jit_burst;
 	uint8_t tbuf[tst->arg_sz];
+	void *ctx[1];
+	uint64_t brc[1];
 
 	printf("%s(%s) start\n", __func__, tst->name);
 
@@ -3509,6 +3513,27 @@ run_test(const struct bpf_test *tst)
 		}
 	}
 
+	/* and with burst jit, when possible */
+	rte_bpf_get_jit_burst(bpf, &jit_burst);
+	if (jit_burst.func != NULL) {
+
+		tst->prepare(tbuf);
+		ctx[0] = tbuf;
+		if (jit_burst.func(ctx, brc, 1) != 1) {
+			printf("%s@%d: burst jit(%s) failed to process input;\n",
+				__func__, __LINE__, tst->name);
+			ret |= -1;
+		}
+		rv = tst->check_result(brc[0], tbuf);
+		ret |= rv;
+		if (rv != 0) {
+			printf("%s@%d: burst check_result(%s) failed, "
+				"error: %d(%s);\n",
+				__func__, __LINE__, tst->name,
+				rv, strerror(rv));
+		}
+	}
+
 	rte_bpf_destroy(bpf);
 	return ret;
 
@@ -5072,3 +5097,263 @@ test_atomic_imms(void)
 }
 
 REGISTER_FAST_TEST(bpf_atomic_imms_autotest, NOHUGE_OK, ASAN_OK, test_atomic_imms);
+
+/*
+ * Test maps: count the packets of a flow in a hash map with a call,
+ * and per index in an array map with an inline lookup.
+ */
+
+#define MAP_TEST_KEY	7
+#define MAP_TEST_IDX	2
+#define MAP_TEST_ENTRIES	4
+
+struct map_arg {
+	uint32_t key;
+	uint32_t idx;
+};
+
+static int
+run_map_test(struct rte_bpf_map *hmap, struct rte_bpf_map *amap)
+{
+	struct rte_bpf_xsym xsym[2 * RTE_BPF_MAP_XSYM_NUM];
+	struct ebpf_insn ins[] = {
+		{
+			.code = (EBPF_ALU64 | EBPF_MOV | BPF_X),
+			.dst_reg = EBPF_REG_6,
+			.src_reg = EBPF_REG_1,
+		},
+		{
+			/* key on the stack */
+			.code = (BPF_LDX | BPF_MEM | BPF_W),
+			.dst_reg = EBPF_REG_2,
+			.src_reg = EBPF_REG_6,
+			.off = offsetof(struct map_arg, key),
+		},
+		{
+			.code = (BPF_STX | BPF_MEM | BPF_W),
+			.dst_reg = EBPF_REG_10,
+			.src_reg = EBPF_REG_2,
+			.off = -(int16_t)sizeof(uint64_t),
+		},
+		{
+			/* hash map handle, filled below */
+			.code = (BPF_LD | BPF_IMM | EBPF_DW),
+			.dst_reg = EBPF_REG_1,
+		},
+		{
+			.imm = 0,
+		},
+		{
+			.code = (EBPF_ALU64 | EBPF_MOV | BPF_X),
+			.dst_reg = EBPF_REG_2,
+			.src_reg = EBPF_REG_10,
+		},
+		{
+			.code = (EBPF_ALU64 | BPF_ADD | BPF_K),
+			.dst_reg = EBPF_REG_2,
+			.imm = -(int32_t)sizeof(uint64_t),
+		},
+		{
+			.code = (BPF_JMP | EBPF_CALL),
+			.imm = RTE_BPF_MAP_XSYM_LOOKUP,
+		},
+		{
+			/* unknown flow */
+			.code = (BPF_JMP | BPF_JEQ | BPF_K),
+			.dst_reg = EBPF_REG_0,
+			.off = 12,
+		},
+		{
+			.code = (EBPF_ALU64 | EBPF_MOV | BPF_K),
+			.dst_reg = EBPF_REG_1,
+			.imm = 1,
+		},
+		{
+			.code = (BPF_STX | EBPF_ATOMIC | EBPF_DW),
+			.dst_reg = EBPF_REG_0,
+			.src_reg = EBPF_REG_1,
+			.imm = BPF_ATOMIC_ADD,
+		},
+		{
+			/* array index, bounded by the map size */
+			.code = (BPF_LDX | BPF_MEM | BPF_W),
+			.dst_reg = EBPF_REG_2,
+			.src_reg = EBPF_REG_6,
+			.off = offsetof(struct map_arg, idx),
+		},
+		{
+			.code = (EBPF_ALU64 | BPF_AND | BPF_K),
+			.dst_reg = EBPF_REG_2,
+			.imm = MAP_TEST_ENTRIES - 1,
+		},
+		{
+			.code = (EBPF_ALU64 | BPF_LSH | BPF_K),
+			.dst_reg = EBPF_REG_2,
+			.imm = 3,
+		},
+		{
+			/* array map values, filled below */
+			.code = (BPF_LD | BPF_IMM | EBPF_DW),
+			.dst_reg = EBPF_REG_1,
+		},
+		{
+			.imm = 0,
+		},
+		{
+			.code = (EBPF_ALU64 | BPF_ADD | BPF_X),
+			.dst_reg = EBPF_REG_1,
+			.src_reg = EBPF_REG_2,
+		},
+		{
+			.code = (EBPF_ALU64 | EBPF_MOV | BPF_K),
+			.dst_reg = EBPF_REG_3,
+			.imm = 1,
+		},
+		{
+			.code = (BPF_STX | EBPF_ATOMIC | EBPF_DW),
+			.dst_reg = EBPF_REG_1,
+			.src_reg = EBPF_REG_3,
+			.imm = BPF_ATOMIC_ADD,
+		},
+		{
+			.code = (EBPF_ALU64 | EBPF_MOV | BPF_K),
+			.dst_reg = EBPF_REG_0,
+			.imm = 1,
+		},
+		{
+			.code = (BPF_JMP | EBPF_EXIT),
+		},
+		{
+			.code = (EBPF_ALU64 | EBPF_MOV | BPF_K),
+			.dst_reg = EBPF_REG_0,
+			.imm = 0,
+		},
+		{
+			.code = (BPF_JMP | EBPF_EXIT),
+		},
+	};
+	struct rte_bpf_prm prm = {
+		.ins = ins,
+		.nb_ins = RTE_DIM(ins),
+		.xsym = xsym,
+		.prog_arg = {
+			.type = RTE_BPF_ARG_PTR,
+			.size = sizeof(struct map_arg),
+		},
+	};
+	struct map_arg arg = {
+		.key = MAP_TEST_KEY,
+		.idx = MAP_TEST_IDX,
+	};
+	struct rte_bpf_jit jit;
+	struct rte_bpf *bpf;
+	uint64_t *hval, *aval;
+	uint64_t rc, runs;
+	uint32_t n, key;
+	uintptr_t p;
+
+	n = rte_bpf_map_xsym_get(hmap, xsym);
+	RTE_TEST_ASSERT_EQUAL(n, RTE_BPF_MAP_XSYM_VALUES,
+		"expect no values symbol for a hash map, found %u symbols", n);
+	prm.nb_xsym = n + rte_bpf_map_xsym_get(amap, xsym + n);
+	RTE_TEST_ASSERT_EQUAL(prm.nb_xsym, n + RTE_BPF_MAP_XSYM_NUM,
+		"expect a values symbol for an array map");
+
+	p = (uintptr_t)xsym[RTE_BPF_MAP_XSYM_MAP].var.val;
+	ins[3].imm = (uint32_t)p;
+	ins[4].imm = (uint64_t)p >> 32;
+	p = (uintptr_t)xsym[n + RTE_BPF_MAP_XSYM_VALUES].var.val;
+	ins[14].imm = (uint32_t)p;
+	ins[15].imm = (uint64_t)p >> 32;
+
+	bpf = rte_bpf_load(&prm);
+	RTE_TEST_ASSERT_NOT_NULL(bpf, "failed to load bpf code, error=%d(%s)",
+		rte_errno, strerror(rte_errno));
+
+	rc = rte_bpf_exec(bpf, &arg);
+	RTE_TEST_ASSERT_EQUAL(rc, 1, "expect a known flow");
+	runs = 1;
+
+	rte_bpf_get_jit(bpf, &jit);
+	if (jit.func != NULL) {
+		rc = jit.func(&arg);
+		RTE_TEST_ASSERT_EQUAL(rc, 1, "expect a known flow with jit");
+		runs++;
+	}
+
+	key = MAP_TEST_KEY;
+	hval = rte_bpf_map_lookup_elem(hmap, &key);
+	RTE_TEST_ASSERT_NOT_NULL(hval, "expect flow in the hash map");
+	RTE_TEST_ASSERT_EQUAL(*hval, runs, "expect hash map counter %" PRIu64
+		", found %" PRIu64, runs, *hval);
+
+	key = MAP_TEST_IDX;
+	aval = rte_bpf_map_lookup_elem(amap, &key);
+	RTE_TEST_ASSERT_NOT_NULL(aval, "expect index in the array map");
+	RTE_TEST_ASSERT_EQUAL(*aval, runs, "expect array map counter %" PRIu64
+		", found %" PRIu64, runs, *aval);
+
+	/* unknown flow once deleted */
+	key = MAP_TEST_KEY;
+	RTE_TEST_ASSERT_SUCCESS(rte_bpf_map_delete_elem(hmap, &key),
+		"expect flow deletion to succeed");
+	rc = rte_bpf_exec(bpf, &arg);
+	RTE_TEST_ASSERT_EQUAL(rc, 0, "expect an unknown flow");
+	if (jit.func != NULL) {
+		rc = jit.func(&arg);
+		RTE_TEST_ASSERT_EQUAL(rc, 0, "expect an unknown flow with jit");
+	}
+
+	rte_bpf_destroy(bpf);
+	return TEST_SUCCESS;
+}
+
+static int
+test_bpf_map(void)
+{
+	struct rte_bpf_map_params mprm = {
+		.name = "test_hmap",
+		.type = RTE_BPF_MAP_TYPE_HASH,
+		.key_size = sizeof(uint32_t),
+		.value_size = sizeof(uint64_t),
+		.max_entries = 16,
+		.socket_id = SOCKET_ID_ANY,
+	};
+	struct rte_bpf_map *hmap, *amap;
+	const uint64_t zero = 0;
+	uint32_t key;
+	int ret;
+
+	hmap = rte_bpf_map_create(&mprm);
+	RTE_TEST_ASSERT_NOT_NULL(hmap, "failed to create hash map, error=%d",
+		rte_errno);
+
+	mprm.name = "test_amap";
+	mprm.type = RTE_BPF_MAP_TYPE_ARRAY;
+	mprm.max_entries = MAP_TEST_ENTRIES;
+	amap = rte_bpf_map_create(&mprm);
+	if (amap == NULL) {
+		rte_bpf_map_free(hmap);
+		RTE_TEST_ASSERT_NOT_NULL(amap,
+			"failed to create array map, error=%d", rte_errno);
+	}
+
+	key = MAP_TEST_ENTRIES;
+	ret = rte_bpf_map_update_elem(amap, &key, &zero);
+	if (ret == -ENOENT) {
+		key = MAP_TEST_KEY;
+		ret = rte_bpf_map_update_elem(hmap, &key, &zero);
+		if (ret == 0)
+			ret = run_map_test(hmap, amap);
+	} else {
+		printf("%s@%d: expect out of array update to fail, ret=%d\n",
+			__func__, __LINE__, ret);
+		ret = TEST_FAILED;
+	}
+
+	rte_bpf_map_free(amap);
+	rte_bpf_map_free(hmap);
+	return ret;
+}
+
+REGISTER_FAST_TEST(bpf_map_autotest, NOHUGE_OK, ASAN_OK, test_bpf_map);
@@ -10,6 +10,7 @@
 #include <rte_net.h>
 #include <rte_mbuf.h>
 #include <rte_ip.h>
+#include <rte_random.h>
 
 #include "test.h"
 
@@ -223,6 +224,212 @@ test_l4_cksum(struct rte_mempool *pktmbuf_pool, const char *pktdata, size_t len)
 	return -1;
 }
 
+/* reference sum of 16-bit words, one byte at a time */
+static uint16_t
+test_raw_cksum_ref(const uint8_t *buf, size_t len)
+{
+	uint64_t sum = 0;
+	size_t i;
+
+	for (i = 0; i < len; i++)
+		sum += (uint16_t)(buf[i] << (8 * ((i & 1) ^
+			(RTE_BYTE_ORDER == RTE_BIG_ENDIAN))));
+	while (sum >> 16)
+		sum = (sum & 0xffff) + (sum >> 16);
+	return (uint16_t)sum;
+}
+
+static int
+test_raw_cksum_large(void)
+{
+	static uint8_t buf[9001 + 3];
+	uint16_t cksum, ref;
+	unsigned int i, off;
+	size_t len;
+
+	for (i = 0; i < sizeof(buf); i++)
+		buf[i] = rte_rand();
+
+	/* cover the vector, tail and odd length cases */
+	for (off = 0; off < 3; off++) {
+		for (len = 250; len <= 9001; len += 583) {
+			cksum = rte_raw_cksum(buf + off, len);
+			ref = test_raw_cksum_ref(buf + off, len);
+			if (cksum != ref && (uint16_t)(cksum + ref) != 0xffff)
+				GOTO_FAIL("raw checksum %#x, expected %#x (len %zu, off %u)",
+					  cksum, ref, len, off);
+		}
+	}
+
+	return 0;
+
+fail:
+	return -1;
+}
+
+static int
+test_cksum_update(void)
+{
+	char pkt[sizeof(test_cksum_ipv4_tcp)];
+	struct rte_ipv4_hdr *ip;
+	struct rte_tcp_hdr *tcp;
+	rte_be32_t old_addr, new_addr = RTE_BE32(RTE_IPV4(192, 168, 0, 1));
+	rte_be16_t old_port, new_port = RTE_BE16(1234);
+
+	memcpy(pkt, test_cksum_ipv4_tcp, sizeof(pkt));
+	ip = (struct rte_ipv4_hdr *)(pkt + sizeof(struct rte_ether_hdr));
+	tcp = (struct rte_tcp_hdr *)(ip + 1);
+
+	/* source NAT: the address is in both checksums, the port in TCP only */
+	old_addr = ip->src_addr;
+	ip->src_addr = new_addr;
+	ip->hdr_checksum = rte_cksum_update32(ip->hdr_checksum,
+			old_addr, new_addr);
+	tcp->cksum = rte_cksum_update32(tcp->cksum, old_addr, new_addr);
+	old_port = tcp->src_port;
+	tcp->src_port = new_port;
+	tcp->cksum = rte_cksum_update16(tcp->cksum, old_port, new_port);
+
+	if (rte_ipv4_cksum(ip) != 0)
+		GOTO_FAIL("invalid IPv4 checksum after update");
+	if (rte_ipv4_udptcp_cksum_verify(ip, tcp) != 0)
+		GOTO_FAIL("invalid TCP checksum after update");
+
+	/* the same update, as a buffer */
+	tcp->cksum = rte_cksum_update(tcp->cksum, &new_addr, &old_addr,
+			sizeof(old_addr));
+	ip->src_addr = old_addr;
+	tcp->cksum = rte_cksum_update16(tcp->cksum, new_port, old_port);
+	tcp->src_port = old_port;
+	if (memcmp(pkt + sizeof(*ip) + sizeof(struct rte_ether_hdr),
+			test_cksum_ipv4_tcp + sizeof(*ip) +
+			sizeof(struct rte_ether_hdr), sizeof(*tcp)) != 0)
+		GOTO_FAIL("invalid TCP checksum after reverse update");
+
+	return 0;
+
+fail:
+	return -1;
+}
+
+static int
+test_cksum_bulk(struct rte_mempool *pktmbuf_pool)
+{
+	struct rte_mbuf *m = NULL;
+	struct rte_ipv4_hdr *ip;
+	struct rte_tcp_hdr *tcp;
+	char *data;
+
+	m = rte_pktmbuf_alloc(pktmbuf_pool);
+	if (m == NULL)
+		GOTO_FAIL("Cannot allocate mbuf");
+
+	data = rte_pktmbuf_append(m, sizeof(test_cksum_ipv4_tcp));
+	if (data == NULL)
+		GOTO_FAIL("Cannot append data");
+	memcpy(data, test_cksum_ipv4_tcp, sizeof(test_cksum_ipv4_tcp));
+	ip = (struct rte_ipv4_hdr *)(data + sizeof(struct rte_ether_hdr));
+	tcp = (struct rte_tcp_hdr *)(ip + 1);
+	ip->hdr_checksum = 0;
+	tcp->cksum = 0;
+
+	m->l2_len = sizeof(struct rte_ether_hdr);
+	m->l3_len = sizeof(*ip);
+	m->l4_len = sizeof(*tcp);
+	m->ol_flags = RTE_MBUF_F_TX_IPV4 | RTE_MBUF_F_TX_IP_CKSUM |
+		RTE_MBUF_F_TX_TCP_CKSUM;
+
+	if (rte_net_ipv4_cksum_bulk(&m, 1) != 1)
+		GOTO_FAIL("IPv4 bulk checksum failed");
+	if (rte_net_l4_cksum_bulk(&m, 1) != 1)
+		GOTO_FAIL("L4 bulk checksum failed");
+	if (memcmp(data, test_cksum_ipv4_tcp, sizeof(test_cksum_ipv4_tcp)) != 0)
+		GOTO_FAIL("invalid bulk checksums");
+
+	rte_pktmbuf_free(m);
+
+	return 0;
+
+fail:
+	rte_pktmbuf_free(m);
+
+	return -1;
+}
+
+/* test bulk packet type parsing against the single packet parser */
+static int
+test_ptype_bulk(struct rte_mempool *pktmbuf_pool)
+{
+	static const struct {
+		const char *data;
+		size_t len;
+	} pkts_data[] = {
+		{ test_cksum_ipv4_tcp, sizeof(test_cksum_ipv4_tcp) },
+		{ test_cksum_ipv6_tcp, sizeof(test_cksum_ipv6_tcp) },
+		{ test_cksum_ipv4_udp, sizeof(test_cksum_ipv4_udp) },
+		{ test_cksum_ipv6_udp, sizeof(test_cksum_ipv6_udp) },
+		{ test_cksum_ipv4_opts_udp, sizeof(test_cksum_ipv4_opts_udp) },
+		/* truncated IPv4 header, not parsed by the vector path */
+		{ test_cksum_ipv4_tcp, sizeof(struct rte_ether_hdr) + 8 },
+	};
+	static const uint32_t layers[] = {
+		RTE_PTYPE_ALL_MASK,
+		RTE_PTYPE_L2_MASK | RTE_PTYPE_L3_MASK | RTE_PTYPE_L4_MASK,
+		RTE_PTYPE_L2_MASK | RTE_PTYPE_L3_MASK,
+	};
+	/* two full vectors and a scalar tail */
+	struct rte_mbuf *m[19] = { NULL };
+	struct rte_net_hdr_lens hdr_lens;
+	uint32_t packet_type;
+	unsigned int i, l;
+	char *data;
+
+	for (i = 0; i < RTE_DIM(m); i++) {
+		m[i] = rte_pktmbuf_alloc(pktmbuf_pool);
+		if (m[i] == NULL)
+			GOTO_FAIL("Cannot allocate mbuf");
+		data = rte_pktmbuf_append(m[i],
+				pkts_data[i % RTE_DIM(pkts_data)].len);
+		if (data == NULL)
+			GOTO_FAIL("Cannot append data");
+		memcpy(data, pkts_data[i % RTE_DIM(pkts_data)].data,
+				pkts_data[i % RTE_DIM(pkts_data)].len);
+	}
+
+	for (l = 0; l < RTE_DIM(layers); l++) {
+		for (i = 0; i < RTE_DIM(m); i++) {
+			m[i]->packet_type = 0;
+			m[i]->l2_len = 0;
+			m[i]->l3_len = 0;
+			m[i]->l4_len = 0;
+		}
+
+		rte_net_get_ptype_bulk(m, RTE_DIM(m), layers[l]);
+
+		for (i = 0; i < RTE_DIM(m); i++) {
+			memset(&hdr_lens, 0, sizeof(hdr_lens));
+			packet_type = rte_net_get_ptype(m[i], &hdr_lens,
+					layers[l]);
+			if (m[i]->packet_type != packet_type ||
+			    m[i]->l2_len != hdr_lens.l2_len ||
+			    m[i]->l3_len != hdr_lens.l3_len ||
+			    m[i]->l4_len != hdr_lens.l4_len)
+				GOTO_FAIL("invalid bulk ptype of packet %u, layers %#x",
+					  i, layers[l]);
+		}
+	}
+
+	rte_pktmbuf_free_bulk(m, RTE_DIM(m));
+
+	return 0;
+
+fail:
+	for (i = 0; i < RTE_DIM(m); i++)
+		rte_pktmbuf_free(m[i]);
+
+	return -1;
+}
+
 static int
 test_cksum(void)
 {
@@ -256,6 +463,18 @@ test_cksum(void)
 			  sizeof(test_cksum_ipv4_opts_udp)) < 0)
 		GOTO_FAIL("checksum error on ipv4_opts_udp");
 
+	if (test_raw_cksum_large() < 0)
+		GOTO_FAIL("checksum error on large buffer");
+
+	if (test_cksum_update() < 0)
+		GOTO_FAIL("checksum error on incremental update");
+
+	if (test_cksum_bulk(pktmbuf_pool) < 0)
+		GOTO_FAIL("checksum error on bulk computation");
+
+	if (test_ptype_bulk(pktmbuf_pool) < 0)
+		GOTO_FAIL("packet type error on bulk parsing");
+
 	rte_mempool_free(pktmbuf_pool);
 
 	return 0;
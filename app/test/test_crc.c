@@ -14,6 +14,7 @@
 #define CRC32_VEC_LEN2     348
 #define CRC16_VEC_LEN1     12
 #define CRC16_VEC_LEN2     2
+#define CRC_BULK_NUM       37
 
 /* CRC test vector */
 static const uint8_t crc_vec[CRC_VEC_LEN] = {
@@ -86,6 +87,16 @@ crc_all_algs(const char *desc, enum rte_net_crc_type type,
 	}
 	rte_net_crc_free(ctx);
 
+	ctx = rte_net_crc_set_alg(RTE_NET_CRC_AVX2, type);
+	TEST_ASSERT_NOT_NULL(ctx, "cannot allocate the CRC context");
+	crc = rte_net_crc_calc(ctx, data, data_len);
+	if (crc != res) {
+		RTE_LOG(ERR, USER1, "TEST FAILED: %s AVX2\n", desc);
+		debug_hexdump(stdout, "AVX2", &crc, 4);
+		ret = TEST_FAILED;
+	}
+	rte_net_crc_free(ctx);
+
 	ctx = rte_net_crc_set_alg(RTE_NET_CRC_NEON, type);
 	TEST_ASSERT_NOT_NULL(ctx, "cannot allocate the CRC context");
 	crc = rte_net_crc_calc(ctx, data, data_len);
@@ -99,6 +110,47 @@ crc_all_algs(const char *desc, enum rte_net_crc_type type,
 	return ret;
 }
 
+/* Check the bulk API against the single buffer API, for each algorithm */
+static int
+crc_bulk_all_algs(const char *desc, enum rte_net_crc_type type,
+	const uint8_t *data, uint32_t data_len)
+{
+	static const enum rte_net_crc_alg algs[] = {
+		RTE_NET_CRC_SCALAR, RTE_NET_CRC_SSE42, RTE_NET_CRC_NEON,
+		RTE_NET_CRC_AVX512, RTE_NET_CRC_AVX2,
+	};
+	const void *bufs[CRC_BULK_NUM];
+	uint32_t lens[CRC_BULK_NUM];
+	uint32_t crc[CRC_BULK_NUM];
+	struct rte_net_crc *ctx;
+	uint32_t i, j;
+	int ret = TEST_SUCCESS;
+
+	/* buffers of various offsets and lengths, including empty ones */
+	for (i = 0; i < CRC_BULK_NUM; i++) {
+		lens[i] = (i * i * 7) % (data_len / 2);
+		bufs[i] = &data[(i * 13) % (data_len / 2)];
+	}
+
+	for (i = 0; i < RTE_DIM(algs); i++) {
+		ctx = rte_net_crc_set_alg(algs[i], type);
+		TEST_ASSERT_NOT_NULL(ctx, "cannot allocate the CRC context");
+		rte_net_crc_calc_bulk(ctx, bufs, lens, crc, CRC_BULK_NUM);
+		for (j = 0; j < CRC_BULK_NUM; j++) {
+			if (crc[j] != rte_net_crc_calc(ctx, bufs[j], lens[j])) {
+				RTE_LOG(ERR, USER1,
+					"TEST FAILED: %s alg %d buffer %u\n",
+					desc, algs[i], j);
+				ret = TEST_FAILED;
+				break;
+			}
+		}
+		rte_net_crc_free(ctx);
+	}
+
+	return ret;
+}
+
 static int
 crc_autotest(void)
 {	uint8_t *test_data;
@@ -137,6 +189,15 @@ crc_autotest(void)
 	ret |= crc_all_algs("16-bit CCITT CRC:  Test 6", RTE_NET_CRC16_CCITT, crc16_vec2,
 		CRC16_VEC_LEN2, crc16_vec2_res);
 
+	/* Bulk API */
+	for (i = 0; i < CRC32_VEC_LEN1; i++)
+		test_data[i] = i * 31 + 7;
+	ret |= crc_bulk_all_algs("32-bit ethernet CRC: Test 7", RTE_NET_CRC32_ETH,
+		test_data, CRC32_VEC_LEN1);
+	ret |= crc_bulk_all_algs("16-bit CCITT CRC:  Test 8", RTE_NET_CRC16_CCITT,
+		test_data, CRC32_VEC_LEN1);
+	rte_free(test_data);
+
 	return ret;
 }
 
@@ -17901,6 +17901,15 @@ test_scheduler_mode_pkt_size_distr_op(void)
 	return 0;
 }
 
+static int
+test_scheduler_mode_load_balance_op(void)
+{
+	TEST_ASSERT(test_scheduler_mode_op(CDEV_SCHED_MODE_LOAD_BALANCE) ==
+			0, "Failed to set load balance mode");
+
+	return 0;
+}
+
 static int
 scheduler_multicore_testsuite_setup(void)
 {
@@ -17941,6 +17950,16 @@ scheduler_pkt_size_distr_testsuite_setup(void)
 	return 0;
 }
 
+static int
+scheduler_load_balance_testsuite_setup(void)
+{
+	if (test_scheduler_attach_worker_op() < 0)
+		return TEST_SKIPPED;
+	if (test_scheduler_mode_op(CDEV_SCHED_MODE_LOAD_BALANCE) < 0)
+		return TEST_SKIPPED;
+	return 0;
+}
+
 static void
 scheduler_mode_testsuite_teardown(void)
 {
@@ -20713,11 +20732,18 @@ test_cryptodev_scheduler(void)
 		.teardown = scheduler_mode_testsuite_teardown,
 		.unit_test_cases = {TEST_CASES_END()}
 	};
+	static struct unit_test_suite scheduler_load_balance = {
+		.suite_name = "Scheduler Load Balance Unit Test Suite",
+		.setup = scheduler_load_balance_testsuite_setup,
+		.teardown = scheduler_mode_testsuite_teardown,
+		.unit_test_cases = {TEST_CASES_END()}
+	};
 	struct unit_test_suite *sched_mode_suites[] = {
 		&scheduler_multicore,
 		&scheduler_round_robin,
 		&scheduler_failover,
-		&scheduler_pkt_size_distr
+		&scheduler_pkt_size_distr,
+		&scheduler_load_balance
 	};
 	static struct unit_test_suite scheduler_config = {
 		.suite_name = "Crypto Device Scheduler Config Unit Test Suite",
@@ -20727,6 +20753,7 @@ test_cryptodev_scheduler(void)
 			TEST_CASE(test_scheduler_mode_roundrobin_op),
 			TEST_CASE(test_scheduler_mode_failover_op),
 			TEST_CASE(test_scheduler_mode_pkt_size_distr_op),
+			TEST_CASE(test_scheduler_mode_load_balance_op),
 			TEST_CASE(test_scheduler_detach_worker_op),
 
 			TEST_CASES_END() /**< NULL terminate array */
@@ -943,6 +943,42 @@ test_drop(void)
 	return TEST_SUCCESS;
 }
 
+static int
+test_match_table(void)
+{
+	int rc;
+	int i;
+
+	/* Move every other queue from a match callback to a table */
+	for (i = 0; i < NUM_QUEUES; i += 2) {
+		struct app_queue *app_queue = &test_app->queues[i];
+		int reg_id;
+
+		rc = test_app_unregister_callback(test_app, i);
+		if (rc != TEST_SUCCESS)
+			return rc;
+
+		reg_id = rte_dispatcher_register_match(test_app->dispatcher,
+				RTE_DISPATCHER_MATCH_QUEUE_ID,
+				app_queue->queue_id, test_app_process_queue,
+				app_queue);
+
+		TEST_ASSERT(reg_id >= 0, "Unable to register table handler "
+			    "for queue %d", i);
+
+		app_queue->dispatcher_reg_id = reg_id;
+	}
+
+	rc = rte_dispatcher_register_match(test_app->dispatcher,
+					   RTE_DISPATCHER_MATCH_QUEUE_ID,
+					   test_app->queues[0].queue_id,
+					   test_app_process_queue,
+					   &test_app->queues[0]);
+	TEST_ASSERT_EQUAL(rc, -EEXIST, "Duplicate table handler registered");
+
+	return test_basic();
+}
+
 #define MORE_THAN_MAX_HANDLERS 1000
 #define MIN_HANDLERS 32
 
@@ -1039,6 +1075,7 @@ static struct unit_test_suite test_suite = {
 	.unit_test_cases = {
 		TEST_CASE_ST(test_setup, test_teardown, test_basic),
 		TEST_CASE_ST(test_setup, test_teardown, test_drop),
+		TEST_CASE_ST(test_setup, test_teardown, test_match_table),
 		TEST_CASE_ST(test_setup, test_teardown,
 			     test_many_handler_registrations),
 		TEST_CASE_ST(test_setup, test_teardown,
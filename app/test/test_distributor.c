@@ -938,6 +938,27 @@ test_distributor(void)
 
 	}
 
+	/* burst distributor preferring the local workers, adaptive limit */
+	if (rte_distributor_socket_set(ds, rte_socket_id()) != -ENOTSUP ||
+			rte_distributor_socket_set(db, RTE_MAX_NUMA_NODES) !=
+			-EINVAL) {
+		printf("rte_distributor_socket_set parameter check failed\n");
+		return -1;
+	}
+	if (rte_distributor_socket_set(db, rte_socket_id()) != 0 ||
+			rte_distributor_adaptive_set(db, true) != 0) {
+		printf("Error setting NUMA aware adaptive mode\n");
+		return -1;
+	}
+	worker_params.dist = db;
+	strlcpy(worker_params.name, "burst_numa", sizeof(worker_params.name));
+	rte_eal_mp_remote_launch(handle_work, &worker_params, SKIP_MAIN);
+	if (sanity_test(&worker_params, p) < 0)
+		goto err;
+	quit_workers(&worker_params, p);
+	rte_distributor_socket_set(db, SOCKET_ID_ANY);
+	rte_distributor_adaptive_set(db, false);
+
 	if (test_error_distributor_create_numworkers() == -1 ||
 			test_error_distributor_create_name() == -1) {
 		printf("rte_distributor_create parameter check tests failed");
@@ -0,0 +1,237 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include "test.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include <rte_bus_vdev.h>
+#include <rte_common.h>
+#include <rte_dma_memcpy.h>
+#include <rte_dmadev.h>
+#include <rte_malloc.h>
+#include <rte_memory.h>
+#include <rte_random.h>
+
+#define NB_CHANS 2
+#define BUF_SIZE (256 * 1024)
+#define STRIPE_SIZE (32 * 1024)
+#define CPU_THRESHOLD 1024
+
+static const char * const dm_vdev[NB_CHANS] = {
+	"dma_skeleton_dm0",
+	"dma_skeleton_dm1",
+};
+static struct rte_dma_memcpy_chan dm_chans[NB_CHANS];
+static uint8_t *src_buf;
+static uint8_t *dst_buf;
+
+static int
+dm_test_check(uint32_t offset, uint32_t length)
+{
+	TEST_ASSERT_BUFFERS_ARE_EQUAL(src_buf + offset, dst_buf + offset,
+			length, "data mismatch at offset %u", offset);
+	return TEST_SUCCESS;
+}
+
+static void
+dm_test_reset(void)
+{
+	uint32_t i;
+
+	for (i = 0; i != BUF_SIZE; i++)
+		src_buf[i] = rte_rand();
+	memset(dst_buf, 0, BUF_SIZE);
+}
+
+static struct rte_dma_memcpy *
+dm_test_create(uint32_t nb_futures)
+{
+	struct rte_dma_memcpy_params params = {
+		.name = "test_dma_memcpy",
+		.socket_id = SOCKET_ID_ANY,
+		.chans = dm_chans,
+		.nb_chans = NB_CHANS,
+		.nb_futures = nb_futures,
+		.cpu_threshold = CPU_THRESHOLD,
+		.stripe_size = STRIPE_SIZE,
+	};
+
+	return rte_dma_memcpy_create(&params);
+}
+
+static int
+test_dma_memcpy_single(void)
+{
+	struct rte_dma_memcpy_stats stats;
+	struct rte_dma_memcpy *dm;
+	uint32_t fut;
+
+	dm = dm_test_create(0);
+	TEST_ASSERT_NOT_NULL(dm, "failed to create memcpy handle");
+	dm_test_reset();
+
+	/* A small copy is done by the CPU at once */
+	TEST_ASSERT_SUCCESS(rte_dma_memcpy_async(dm, dst_buf, src_buf,
+			CPU_THRESHOLD - 1, &fut), "failed to copy");
+	TEST_ASSERT_SUCCESS(rte_dma_memcpy_status(dm, fut),
+			"small copy not done at once");
+	TEST_ASSERT_SUCCESS(dm_test_check(0, CPU_THRESHOLD - 1), "bad copy");
+
+	/* A large copy is striped across the channels */
+	TEST_ASSERT_SUCCESS(rte_dma_memcpy_async(dm, dst_buf, src_buf,
+			BUF_SIZE, &fut), "failed to copy");
+	TEST_ASSERT_SUCCESS(rte_dma_memcpy_wait(dm, fut), "copy failed");
+	TEST_ASSERT_SUCCESS(dm_test_check(0, BUF_SIZE), "bad copy");
+
+	rte_dma_memcpy_stats_get(dm, &stats);
+	TEST_ASSERT_EQUAL(stats.cpu_copies, 1, "%"PRIu64" CPU copies",
+			stats.cpu_copies);
+	TEST_ASSERT_EQUAL(stats.dma_copies + stats.fallbacks, NB_CHANS,
+			"copy not striped");
+	TEST_ASSERT_EQUAL(stats.dma_errors, 0, "DMA errors");
+
+	rte_dma_memcpy_free(dm);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_dma_memcpy_bulk(void)
+{
+	const uint32_t offsets[] = { 0, 100, 4096, 65536, 131072 };
+	const uint32_t lengths[] = { 64, 3000, 60000, 65536, BUF_SIZE - 131072 };
+	struct rte_dma_memcpy_seg segs[RTE_DIM(offsets)];
+	struct rte_dma_memcpy *dm;
+	uint32_t fut, i;
+
+	dm = dm_test_create(0);
+	TEST_ASSERT_NOT_NULL(dm, "failed to create memcpy handle");
+	dm_test_reset();
+
+	for (i = 0; i != RTE_DIM(segs); i++) {
+		segs[i].dst = dst_buf + offsets[i];
+		segs[i].src = src_buf + offsets[i];
+		segs[i].length = lengths[i];
+	}
+	TEST_ASSERT_SUCCESS(rte_dma_memcpy_bulk_async(dm, segs, RTE_DIM(segs),
+			&fut), "failed to copy");
+	TEST_ASSERT_SUCCESS(rte_dma_memcpy_wait(dm, fut), "copy failed");
+	for (i = 0; i != RTE_DIM(segs); i++)
+		TEST_ASSERT_SUCCESS(dm_test_check(offsets[i], lengths[i]),
+				"bad copy of segment %u", i);
+
+	rte_dma_memcpy_free(dm);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_dma_memcpy_futures(void)
+{
+	struct rte_dma_memcpy *dm;
+	uint32_t fut[5], i;
+
+	dm = dm_test_create(4);
+	TEST_ASSERT_NOT_NULL(dm, "failed to create memcpy handle");
+	dm_test_reset();
+
+	/* Only 4 futures can be pending */
+	for (i = 0; i != 4; i++)
+		TEST_ASSERT_SUCCESS(rte_dma_memcpy_async(dm, dst_buf + i * 4096,
+				src_buf + i * 4096, 4096, &fut[i]),
+				"failed to copy");
+	TEST_ASSERT_EQUAL(rte_dma_memcpy_status(dm, fut[0]), -EAGAIN,
+			"copy done before polling");
+	TEST_ASSERT_EQUAL(rte_dma_memcpy_async(dm, dst_buf, src_buf, 4096,
+			&fut[4]), -ENOSPC, "too many futures");
+	for (i = 0; i != 4; i++)
+		TEST_ASSERT_SUCCESS(rte_dma_memcpy_wait(dm, fut[i]),
+				"copy %u failed", i);
+	TEST_ASSERT_SUCCESS(dm_test_check(0, 4 * 4096), "bad copy");
+
+	/* The status of a future is lost once its slot is reused */
+	TEST_ASSERT_SUCCESS(rte_dma_memcpy_async(dm, dst_buf, src_buf,
+			4096, &fut[4]), "failed to copy");
+	TEST_ASSERT_EQUAL(rte_dma_memcpy_status(dm, fut[0]), -ESTALE,
+			"status of a reused future");
+	TEST_ASSERT_SUCCESS(rte_dma_memcpy_wait(dm, fut[4]), "copy failed");
+
+	rte_dma_memcpy_free(dm);
+
+	return TEST_SUCCESS;
+}
+
+static int
+dm_testsuite_setup(void)
+{
+	const struct rte_dma_conf conf = { .nb_vchans = 1 };
+	const struct rte_dma_vchan_conf qconf = {
+		.direction = RTE_DMA_DIR_MEM_TO_MEM,
+		.nb_desc = 1024,
+	};
+	int16_t dev_id;
+	unsigned int i;
+
+	/* The skeleton device copies with the IOVA as the virtual address */
+	if (rte_eal_iova_mode() != RTE_IOVA_VA)
+		return TEST_SKIPPED;
+
+	for (i = 0; i != NB_CHANS; i++) {
+		if (rte_vdev_init(dm_vdev[i], NULL) != 0)
+			return TEST_SKIPPED;
+		dev_id = rte_dma_get_dev_id_by_name(dm_vdev[i]);
+		TEST_ASSERT(dev_id >= 0, "no DMA device %s", dm_vdev[i]);
+		TEST_ASSERT_SUCCESS(rte_dma_configure(dev_id, &conf),
+				"failed to configure %s", dm_vdev[i]);
+		TEST_ASSERT_SUCCESS(rte_dma_vchan_setup(dev_id, 0, &qconf),
+				"failed to setup %s", dm_vdev[i]);
+		TEST_ASSERT_SUCCESS(rte_dma_start(dev_id),
+				"failed to start %s", dm_vdev[i]);
+		dm_chans[i].dev_id = dev_id;
+		dm_chans[i].vchan = 0;
+	}
+
+	src_buf = rte_malloc(NULL, BUF_SIZE, RTE_CACHE_LINE_SIZE);
+	dst_buf = rte_malloc(NULL, BUF_SIZE, RTE_CACHE_LINE_SIZE);
+	TEST_ASSERT(src_buf != NULL && dst_buf != NULL,
+			"failed to allocate buffers");
+
+	return TEST_SUCCESS;
+}
+
+static void
+dm_testsuite_teardown(void)
+{
+	unsigned int i;
+
+	rte_free(src_buf);
+	rte_free(dst_buf);
+	src_buf = NULL;
+	dst_buf = NULL;
+	for (i = 0; i != NB_CHANS; i++)
+		rte_vdev_uninit(dm_vdev[i]);
+}
+
+static struct unit_test_suite dma_memcpy_testsuite = {
+	.suite_name = "DMA memcpy offload autotest",
+	.setup = dm_testsuite_setup,
+	.teardown = dm_testsuite_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_dma_memcpy_single),
+		TEST_CASE(test_dma_memcpy_bulk),
+		TEST_CASE(test_dma_memcpy_futures),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_dma_memcpy(void)
+{
+	return unit_test_suite_runner(&dma_memcpy_testsuite);
+}
+
+REGISTER_FAST_TEST(dma_memcpy_autotest, NOHUGE_SKIP, ASAN_OK, test_dma_memcpy);
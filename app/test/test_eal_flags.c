@@ -1015,6 +1015,10 @@ test_misc_flags(void)
 	const char * const argv28[] = {prgname, prefix, mp_flag,
 				       "--log-color=invalid" };
 
+	/* Try running with --malloc-cache */
+	const char * const argv29[] = {prgname, prefix, mp_flag,
+				       "--malloc-cache" };
+
 	/* run all tests also applicable to FreeBSD first */
 
 	if (launch_proc(argv0) == 0) {
@@ -1161,6 +1165,11 @@ test_misc_flags(void)
 			__LINE__);
 		goto fail;
 	}
+	if (launch_proc(argv29) != 0) {
+		printf("Error (line %d) - process did not run ok with --malloc-cache parameter\n",
+			__LINE__);
+		goto fail;
+	}
 
 	rmdir(hugepath_dir3);
 	rmdir(hugepath_dir2);
@@ -20,6 +20,7 @@ test_efd(void)
 #include <rte_random.h>
 #include <rte_debug.h>
 #include <rte_ip.h>
+#include <rte_rcu_qsbr.h>
 
 #define EFD_TEST_KEY_LEN 8
 #define TABLE_SIZE (1 << 21)
@@ -325,6 +326,109 @@ static int test_five_keys(void)
 	return 0;
 }
 
+/*
+ * Bulk insert and update of many keys, optionally with RCU:
+ *      - add all keys
+ *      - lookup: hit
+ *      - update half of the keys, with duplicate keys in the same call
+ *      - lookup: hit (updated data)
+ */
+#define BULK_NUM_KEYS (1 << 15)
+static uint64_t bulk_keys[BULK_NUM_KEYS];
+static const void *bulk_key_ptrs[BULK_NUM_KEYS];
+static efd_value_t bulk_values[BULK_NUM_KEYS];
+
+static int test_update_bulk(int use_rcu)
+{
+	struct rte_efd_table *handle;
+	struct rte_rcu_qsbr *qsv = NULL;
+	struct rte_efd_rcu_config rcu_cfg = {0};
+	unsigned int i;
+	int ret = -1;
+
+	printf("Entering %s, RCU %s\n", __func__, use_rcu ? "on" : "off");
+
+	handle = rte_efd_create("test_update_bulk", 2 * BULK_NUM_KEYS,
+			sizeof(bulk_keys[0]), efd_get_all_sockets_bitmask(),
+			test_socket_id);
+	TEST_ASSERT_NOT_NULL(handle, "Error creating the EFD table\n");
+
+	if (use_rcu) {
+		qsv = rte_zmalloc(NULL, rte_rcu_qsbr_get_memsize(RTE_MAX_LCORE),
+				RTE_CACHE_LINE_SIZE);
+		if (qsv == NULL || rte_rcu_qsbr_init(qsv, RTE_MAX_LCORE) != 0) {
+			printf("Error creating the RCU QSBR variable\n");
+			goto exit;
+		}
+		rcu_cfg.v = qsv;
+		if (rte_efd_rcu_qsbr_add(handle, &rcu_cfg) != 0) {
+			printf("Error adding the RCU QSBR variable\n");
+			goto exit;
+		}
+		if (rte_efd_rcu_qsbr_add(handle, &rcu_cfg) == 0) {
+			printf("Adding the RCU QSBR variable twice should fail\n");
+			goto exit;
+		}
+	}
+
+	for (i = 0; i < BULK_NUM_KEYS; i++) {
+		bulk_keys[i] = rte_rand();
+		bulk_key_ptrs[i] = &bulk_keys[i];
+		bulk_values[i] = mrand48() & VALUE_BITMASK;
+	}
+
+	if (rte_efd_update_bulk(handle, test_socket_id, BULK_NUM_KEYS,
+			bulk_key_ptrs, bulk_values) != 0) {
+		printf("Error inserting the keys in bulk\n");
+		goto exit;
+	}
+	for (i = 0; i < BULK_NUM_KEYS; i++) {
+		if (rte_efd_lookup(handle, test_socket_id, &bulk_keys[i]) !=
+				bulk_values[i]) {
+			printf("Failed to find key %u after bulk insert\n", i);
+			goto exit;
+		}
+	}
+
+	/* The last value of a key repeated in the same call is kept */
+	for (i = 0; i < BULK_NUM_KEYS / 2; i++) {
+		bulk_keys[i] = bulk_keys[i + BULK_NUM_KEYS / 2];
+		bulk_values[i] = mrand48() & VALUE_BITMASK;
+		bulk_values[i + BULK_NUM_KEYS / 2] =
+				(bulk_values[i] + 1) & VALUE_BITMASK;
+	}
+
+	if (rte_efd_update_bulk(handle, test_socket_id, BULK_NUM_KEYS,
+			bulk_key_ptrs, bulk_values) != 0) {
+		printf("Error updating the keys in bulk\n");
+		goto exit;
+	}
+	for (i = BULK_NUM_KEYS / 2; i < BULK_NUM_KEYS; i++) {
+		if (rte_efd_lookup(handle, test_socket_id, &bulk_keys[i]) !=
+				bulk_values[i]) {
+			printf("Failed to find key %u after bulk update\n", i);
+			goto exit;
+		}
+	}
+
+	/* Single updates still work with RCU */
+	bulk_values[0] = (bulk_values[0] + 2) & VALUE_BITMASK;
+	if (rte_efd_update(handle, test_socket_id, &bulk_keys[0],
+			bulk_values[0]) != 0 ||
+			rte_efd_lookup(handle, test_socket_id, &bulk_keys[0]) !=
+			bulk_values[0]) {
+		printf("Error updating a key after bulk update\n");
+		goto exit;
+	}
+
+	ret = 0;
+exit:
+	rte_efd_free(handle);
+	rte_free(qsv);
+
+	return ret;
+}
+
 /*
  * Test to see the average table utilization (entries added/max entries)
  * before hitting a random entry that cannot be added
@@ -465,6 +569,10 @@ test_efd(void)
 		return -1;
 	if (test_efd_creation_with_bad_parameters() < 0)
 		return -1;
+	if (test_update_bulk(0) < 0)
+		return -1;
+	if (test_update_bulk(1) < 0)
+		return -1;
 	if (test_average_table_utilization() < 0)
 		return -1;
 
@@ -7,6 +7,7 @@
 
 #include <rte_test.h>
 #include "test.h"
+#include "virtual_pmd.h"
 
 #define NUM_RXQ	2
 #define NUM_TXQ	2
@@ -14,6 +15,7 @@
 #define NUM_TXD 512
 #define NUM_MBUF 1024
 #define MBUF_CACHE_SIZE 256
+#define NUM_RECYCLE_TXQ 2
 
 static int32_t
 ethdev_api_queue_status(void)
@@ -162,12 +164,284 @@ ethdev_api_queue_status(void)
 	return TEST_SUCCESS;
 }
 
+static unsigned int queue_quiesce_calls;
+
+/* No datapath lcore polls the queues in this test. */
+static int
+queue_quiesce(uint16_t port_id __rte_unused, uint16_t queue_id __rte_unused,
+	      void *arg __rte_unused)
+{
+	queue_quiesce_calls++;
+	return 0;
+}
+
+static int
+queue_quiesce_abort(uint16_t port_id __rte_unused,
+		    uint16_t queue_id __rte_unused, void *arg __rte_unused)
+{
+	return -EAGAIN;
+}
+
+static int32_t
+ethdev_api_queue_resize(void)
+{
+	struct rte_eth_dev_info dev_info;
+	struct rte_eth_rxq_info rx_qinfo;
+	struct rte_eth_txq_info tx_qinfo;
+	struct rte_mempool *mbuf_pool;
+	struct rte_eth_conf eth_conf;
+	uint16_t port_id;
+	int ret;
+
+	if (rte_eth_dev_count_avail() == 0)
+		return TEST_SKIPPED;
+
+	ret = rte_eth_dev_rx_queues_scale(RTE_MAX_ETHPORTS, 1,
+		queue_quiesce, NULL);
+	TEST_ASSERT(ret == -ENODEV, "Scaled Rx queues of invalid port.\n");
+	ret = rte_eth_rx_queue_resize(RTE_MAX_ETHPORTS, 0, NUM_RXD, NULL, NULL,
+		queue_quiesce, NULL);
+	TEST_ASSERT(ret == -ENODEV, "Resized Rx queue of invalid port.\n");
+	ret = rte_eth_tx_queue_resize(RTE_MAX_ETHPORTS, 0, NUM_TXD, NULL,
+		queue_quiesce, NULL);
+	TEST_ASSERT(ret == -ENODEV, "Resized Tx queue of invalid port.\n");
+
+	mbuf_pool = rte_mempool_lookup("MBUF_POOL");
+	if (mbuf_pool == NULL)
+		mbuf_pool = rte_pktmbuf_pool_create("MBUF_POOL", NUM_MBUF,
+				MBUF_CACHE_SIZE, 0, RTE_MBUF_DEFAULT_BUF_SIZE,
+				rte_socket_id());
+	TEST_ASSERT(mbuf_pool != NULL, "Failed to create mbuf pool.\n");
+
+	RTE_ETH_FOREACH_DEV(port_id) {
+		ret = rte_eth_dev_info_get(port_id, &dev_info);
+		TEST_ASSERT(ret == 0,
+			"Port(%u) failed to get dev info.\n", port_id);
+
+		memset(&eth_conf, 0, sizeof(eth_conf));
+		if (dev_info.flow_type_rss_offloads != 0) {
+			eth_conf.rxmode.mq_mode = RTE_ETH_MQ_RX_RSS;
+			eth_conf.rx_adv_conf.rss_conf.rss_hf =
+				dev_info.flow_type_rss_offloads;
+		}
+		ret = rte_eth_dev_configure(port_id, NUM_RXQ, NUM_TXQ, &eth_conf);
+		TEST_ASSERT(ret == 0,
+			"Port(%u) failed to configure.\n", port_id);
+
+		for (uint16_t queue_id = 0; queue_id < NUM_RXQ; queue_id++) {
+			ret = rte_eth_rx_queue_setup(port_id, queue_id, NUM_RXD,
+				rte_socket_id(), NULL,  mbuf_pool);
+			TEST_ASSERT(ret == 0,
+				"Port(%u), queue(%u) failed to setup RxQ.\n",
+				port_id, queue_id);
+		}
+
+		for (uint16_t queue_id = 0; queue_id < NUM_TXQ; queue_id++) {
+			ret = rte_eth_tx_queue_setup(port_id, queue_id, NUM_TXD,
+				rte_socket_id(), NULL);
+			TEST_ASSERT(ret == 0,
+				"Port(%u), queue(%u) failed to setup TxQ.\n",
+				port_id, queue_id);
+		}
+
+		/* Resizing a queue of a stopped port is a plain setup. */
+		ret = rte_eth_rx_queue_resize(port_id, 0, NUM_RXD, NULL, mbuf_pool,
+			NULL, NULL);
+		TEST_ASSERT(ret == 0,
+			"Port(%u) failed to resize stopped RxQ.\n", port_id);
+		ret = rte_eth_tx_queue_resize(port_id, 0, NUM_TXD, NULL, NULL, NULL);
+		TEST_ASSERT(ret == 0,
+			"Port(%u) failed to resize stopped TxQ.\n", port_id);
+
+		ret = rte_eth_rx_queue_resize(port_id, NUM_RXQ, NUM_RXD,
+			NULL, mbuf_pool, queue_quiesce, NULL);
+		TEST_ASSERT(ret == -EINVAL,
+			"Port(%u) resized invalid RxQ.\n", port_id);
+		ret = rte_eth_tx_queue_resize(port_id, NUM_TXQ, NUM_TXD, NULL,
+			queue_quiesce, NULL);
+		TEST_ASSERT(ret == -EINVAL,
+			"Port(%u) resized invalid TxQ.\n", port_id);
+
+		ret = rte_eth_dev_rx_queues_scale(port_id, 1, queue_quiesce, NULL);
+		TEST_ASSERT(ret == -EINVAL,
+			"Port(%u) scaled Rx queues while stopped.\n", port_id);
+
+		ret = rte_eth_dev_start(port_id);
+		TEST_ASSERT(ret == 0,
+			"Port(%u) failed to start.\n", port_id);
+
+		ret = rte_eth_dev_rx_queues_scale(port_id, 0, queue_quiesce, NULL);
+		TEST_ASSERT(ret == -EINVAL,
+			"Port(%u) scaled to no Rx queue.\n", port_id);
+		ret = rte_eth_dev_rx_queues_scale(port_id, NUM_RXQ + 1,
+			queue_quiesce, NULL);
+		TEST_ASSERT(ret == -EINVAL,
+			"Port(%u) scaled to unconfigured Rx queues.\n", port_id);
+
+		ret = rte_eth_dev_rx_queues_scale(port_id, 1, NULL, NULL);
+		TEST_ASSERT(ret == -EINVAL,
+			"Port(%u) scaled Rx queues without quiesce.\n", port_id);
+
+		queue_quiesce_calls = 0;
+		ret = rte_eth_dev_rx_queues_scale(port_id, 1, queue_quiesce, NULL);
+		TEST_ASSERT(ret == 0 || ret == -ENOTSUP,
+			"Port(%u) failed to scale down Rx queues: %d.\n",
+			port_id, ret);
+		TEST_ASSERT(ret != 0 || queue_quiesce_calls == NUM_RXQ - 1,
+			"Port(%u) quiesced %u Rx queues.\n",
+			port_id, queue_quiesce_calls);
+		ret = rte_eth_dev_rx_queues_scale(port_id, NUM_RXQ,
+			queue_quiesce, NULL);
+		TEST_ASSERT(ret == 0 || ret == -ENOTSUP,
+			"Port(%u) failed to scale up Rx queues: %d.\n",
+			port_id, ret);
+
+		/* Runtime resize, checked through the queue info if supported. */
+		ret = rte_eth_rx_queue_resize(port_id, 0, NUM_RXD / 2,
+			NULL, mbuf_pool, queue_quiesce_abort, NULL);
+		TEST_ASSERT(ret == -EAGAIN || ret == -ENOTSUP || ret == -EBUSY,
+			"Port(%u) resized RxQ despite quiesce error: %d.\n",
+			port_id, ret);
+
+		ret = rte_eth_rx_queue_resize(port_id, 0, NUM_RXD / 2,
+			NULL, mbuf_pool, queue_quiesce, NULL);
+		TEST_ASSERT(ret == 0 || ret == -ENOTSUP,
+			"Port(%u) failed to resize RxQ: %d.\n", port_id, ret);
+		if (ret == 0 && rte_eth_rx_queue_info_get(port_id, 0, &rx_qinfo) == 0)
+			TEST_ASSERT(rx_qinfo.nb_desc == NUM_RXD / 2 &&
+				rx_qinfo.queue_state == RTE_ETH_QUEUE_STATE_STARTED,
+				"Port(%u) wrong resized RxQ.\n", port_id);
+
+		ret = rte_eth_tx_queue_resize(port_id, 0, NUM_TXD / 2, NULL,
+			queue_quiesce, NULL);
+		TEST_ASSERT(ret == 0 || ret == -ENOTSUP,
+			"Port(%u) failed to resize TxQ: %d.\n", port_id, ret);
+		if (ret == 0 && rte_eth_tx_queue_info_get(port_id, 0, &tx_qinfo) == 0)
+			TEST_ASSERT(tx_qinfo.nb_desc == NUM_TXD / 2 &&
+				tx_qinfo.queue_state == RTE_ETH_QUEUE_STATE_STARTED,
+				"Port(%u) wrong resized TxQ.\n", port_id);
+
+		ret = rte_eth_dev_stop(port_id);
+		TEST_ASSERT(ret == 0,
+			"Port(%u) failed to stop.\n", port_id);
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int32_t
+ethdev_api_recycle_mbufs_bulk(void)
+{
+	struct rte_ether_addr mac = {
+		.addr_bytes = { 0x00, 0xFF, 0x00, 0xFF, 0x00, 0x00 } };
+	struct rte_eth_recycle_txq txqs[NUM_RECYCLE_TXQ];
+	struct rte_eth_recycle_rxq_info rxq_info;
+	struct rte_mbuf *pkts[NUM_RECYCLE_TXQ * 4];
+	struct rte_mempool *mbuf_pool;
+	struct rte_eth_conf eth_conf;
+	char name[RTE_ETH_NAME_MAX_LEN];
+	uint16_t ports[NUM_RECYCLE_TXQ + 1];
+	uint16_t i, nb_pkts, ret16;
+	int ret;
+
+	mbuf_pool = rte_mempool_lookup("MBUF_POOL");
+	if (mbuf_pool == NULL)
+		mbuf_pool = rte_pktmbuf_pool_create("MBUF_POOL", NUM_MBUF,
+				MBUF_CACHE_SIZE, 0, RTE_MBUF_DEFAULT_BUF_SIZE,
+				rte_socket_id());
+	TEST_ASSERT(mbuf_pool != NULL, "Failed to create mbuf pool.\n");
+
+	/* One Rx port fed by the Tx queues of the other ports. */
+	memset(&eth_conf, 0, sizeof(eth_conf));
+	for (i = 0; i < RTE_DIM(ports); i++) {
+		snprintf(name, sizeof(name), "eth_recycle_%u", i);
+		mac.addr_bytes[5] = i;
+		ret = virtual_ethdev_create(name, &mac, rte_socket_id(), 0);
+		TEST_ASSERT(ret >= 0, "Failed to create virtual port %s.\n", name);
+		ports[i] = ret;
+
+		ret = rte_eth_dev_configure(ports[i], 1, 1, &eth_conf);
+		TEST_ASSERT(ret == 0, "Port(%u) failed to configure.\n", ports[i]);
+		ret = rte_eth_rx_queue_setup(ports[i], 0, NUM_RXD,
+			rte_socket_id(), NULL, mbuf_pool);
+		TEST_ASSERT(ret == 0, "Port(%u) failed to setup RxQ.\n", ports[i]);
+		ret = rte_eth_tx_queue_setup(ports[i], 0, NUM_TXD,
+			rte_socket_id(), NULL);
+		TEST_ASSERT(ret == 0, "Port(%u) failed to setup TxQ.\n", ports[i]);
+		ret = rte_eth_dev_start(ports[i]);
+		TEST_ASSERT(ret == 0, "Port(%u) failed to start.\n", ports[i]);
+		virtual_ethdev_set_link_status(ports[i], 1);
+
+		if (i > 0) {
+			txqs[i - 1].port_id = ports[i];
+			txqs[i - 1].queue_id = 0;
+		}
+	}
+
+	ret = rte_eth_recycle_rx_queue_info_get(ports[0], 0, &rxq_info);
+	TEST_ASSERT(ret == 0, "Port(%u) failed to get recycle Rx info.\n",
+		ports[0]);
+
+	ret = rte_pktmbuf_alloc_bulk(mbuf_pool, pkts, RTE_DIM(pkts));
+	TEST_ASSERT(ret == 0, "Failed to allocate mbufs.\n");
+
+	/* Three packets on the first Tx queue, one on the second. */
+	ret16 = rte_eth_tx_burst(txqs[0].port_id, 0, pkts, 3);
+	TEST_ASSERT(ret16 == 3, "Port(%u) sent %u packets.\n",
+		txqs[0].port_id, ret16);
+	ret16 = rte_eth_tx_burst(txqs[1].port_id, 0, &pkts[3], 1);
+	TEST_ASSERT(ret16 == 1, "Port(%u) sent %u packets.\n",
+		txqs[1].port_id, ret16);
+	nb_pkts = 4;
+
+	ret16 = rte_eth_recycle_mbufs_bulk(ports[0], 0, txqs, RTE_DIM(txqs),
+		&rxq_info);
+	TEST_ASSERT(ret16 == nb_pkts, "Recycled %u mbufs.\n", ret16);
+	TEST_ASSERT(*rxq_info.refill_head == nb_pkts,
+		"Rx refill head %u after recycling.\n", *rxq_info.refill_head);
+
+	/* Tx queues are visited in order, each refilling the Rx ring. */
+	for (i = 0; i < nb_pkts; i++)
+		TEST_ASSERT(rxq_info.mbuf_ring[i] == pkts[i],
+			"Wrong recycled mbuf %u.\n", i);
+
+	ret16 = rte_eth_recycle_mbufs_bulk(ports[0], 0, txqs, RTE_DIM(txqs),
+		&rxq_info);
+	TEST_ASSERT(ret16 == 0, "Recycled %u mbufs from empty Tx queues.\n",
+		ret16);
+
+	/* No more mbufs than free entries in the Rx ring. */
+	*rxq_info.receive_tail = *rxq_info.refill_head -
+		rxq_info.mbuf_ring_size + 2;
+	ret16 = rte_eth_tx_burst(txqs[1].port_id, 0, &pkts[nb_pkts],
+		RTE_DIM(pkts) - nb_pkts);
+	TEST_ASSERT(ret16 == RTE_DIM(pkts) - nb_pkts,
+		"Port(%u) sent %u packets.\n", txqs[1].port_id, ret16);
+	ret16 = rte_eth_recycle_mbufs_bulk(ports[0], 0, txqs, RTE_DIM(txqs),
+		&rxq_info);
+	TEST_ASSERT(ret16 == 2, "Recycled %u mbufs into a full Rx ring.\n",
+		ret16);
+
+	/* The mbufs left in the Tx queue are freed on stop. */
+	rte_pktmbuf_free_bulk(pkts, nb_pkts + 2);
+	for (i = 0; i < RTE_DIM(ports); i++) {
+		ret = rte_eth_dev_stop(ports[i]);
+		TEST_ASSERT(ret == 0, "Port(%u) failed to stop.\n", ports[i]);
+		ret = rte_eth_dev_close(ports[i]);
+		TEST_ASSERT(ret == 0, "Port(%u) failed to close.\n", ports[i]);
+	}
+
+	return TEST_SUCCESS;
+}
+
 static struct unit_test_suite ethdev_api_testsuite = {
 	.suite_name = "ethdev API tests",
 	.setup = NULL,
 	.teardown = NULL,
 	.unit_test_cases = {
 		TEST_CASE(ethdev_api_queue_status),
+		TEST_CASE(ethdev_api_queue_resize),
+		TEST_CASE(ethdev_api_recycle_mbufs_bulk),
 		/* TODO: Add deferred_start queue status test */
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
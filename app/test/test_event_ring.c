@@ -213,6 +213,88 @@ test_event_ring_with_exact_size(void)
 	return 0;
 }
 
+/*
+ * check that the ordered ring restores the enqueue order of the events
+ * released out of order by a stage
+ */
+static int
+test_event_ordered_ring(void)
+{
+	struct rte_event_ordered_ring *or;
+	struct rte_event enq[MAX_BULK * 2];
+	struct rte_event deq[MAX_BULK * 2];
+	uint32_t token0, token1;
+	unsigned int i;
+
+	or = rte_event_ordered_ring_create("ev_ordered", RING_SIZE, 2,
+			SOCKET_ID_ANY, 0);
+	if (or == NULL) {
+		printf("%s: error, can't create ordered ring\n", __func__);
+		return -1;
+	}
+
+	for (i = 0; i < RTE_DIM(enq); i++)
+		enq[i] = (struct rte_event) { .flow_id = i % 4, .u64 = i };
+	if (rte_event_ordered_ring_enqueue_burst(or, enq, RTE_DIM(enq),
+			NULL) != RTE_DIM(enq)) {
+		printf("%s: error, enqueue failed\n", __func__);
+		goto error;
+	}
+
+	/* stage 0: release the second burst before the first one */
+	if (rte_event_ordered_ring_acquire_burst(or, deq, 0, MAX_BULK,
+			&token0, NULL) != MAX_BULK ||
+	    rte_event_ordered_ring_acquire_burst(or, deq + MAX_BULK, 0,
+			MAX_BULK, &token1, NULL) != MAX_BULK) {
+		printf("%s: error, stage 0 acquire failed\n", __func__);
+		goto error;
+	}
+	for (i = 0; i < RTE_DIM(deq); i++)
+		deq[i].u64 *= 2;
+	rte_event_ordered_ring_release(or, deq + MAX_BULK, 0, MAX_BULK,
+			token1);
+	if (rte_event_ordered_ring_acquire_burst(or, deq, 1, MAX_BULK,
+			&token1, NULL) != 0) {
+		printf("%s: error, stage 1 acquired events out of order\n",
+				__func__);
+		goto error;
+	}
+	rte_event_ordered_ring_release(or, deq, 0, MAX_BULK, token0);
+
+	/* stage 1: release the events unchanged */
+	if (rte_event_ordered_ring_acquire_burst(or, deq, 1, RTE_DIM(deq),
+			&token1, NULL) != RTE_DIM(deq)) {
+		printf("%s: error, stage 1 acquire failed\n", __func__);
+		goto error;
+	}
+	rte_event_ordered_ring_release(or, NULL, 1, RTE_DIM(deq), token1);
+
+	memset(deq, 0, sizeof(deq));
+	if (rte_event_ordered_ring_dequeue_burst(or, deq, RTE_DIM(deq),
+			NULL) != RTE_DIM(deq)) {
+		printf("%s: error, dequeue failed\n", __func__);
+		goto error;
+	}
+	for (i = 0; i < RTE_DIM(deq); i++) {
+		if (deq[i].u64 != i * 2 || deq[i].flow_id != i % 4) {
+			printf("%s: error, event %u out of order\n", __func__,
+					i);
+			goto error;
+		}
+	}
+	if (rte_event_ordered_ring_count(or) != 0) {
+		printf("%s: error, ring not empty\n", __func__);
+		goto error;
+	}
+
+	rte_event_ordered_ring_free(or);
+	return 0;
+
+error:
+	rte_event_ordered_ring_free(or);
+	return -1;
+}
+
 static int
 test_event_ring(void)
 {
@@ -251,6 +333,9 @@ test_event_ring(void)
 	if (test_event_ring_with_exact_size() < 0)
 		return -1;
 
+	if (test_event_ordered_ring() < 0)
+		return -1;
+
 	return 0;
 }
 
@@ -433,6 +433,61 @@ timdev_setup_sec_multicore(void)
 	return _timdev_setup(1E11, 1E9, flags);
 }
 
+static int
+timdev_setup_usec_wheel(void)
+{
+	uint64_t flags = RTE_EVENT_TIMER_ADAPTER_F_ADJUST_RES |
+			 RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL;
+
+	return using_services ?
+		/* Max timeout is 10,000us and bucket interval is 100us */
+		_timdev_setup(1E7, 1E5, flags) :
+		/* Max timeout is 100us and bucket interval is 1us */
+		_timdev_setup(1E5, 1E3, flags);
+}
+
+static int
+timdev_setup_msec_periodic_wheel(void)
+{
+	uint32_t caps = 0;
+	uint64_t max_tmo_ns;
+
+	uint64_t flags = RTE_EVENT_TIMER_ADAPTER_F_ADJUST_RES |
+			 RTE_EVENT_TIMER_ADAPTER_F_PERIODIC |
+			 RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL;
+
+	TEST_ASSERT_SUCCESS(rte_event_timer_adapter_caps_get(evdev, &caps),
+				"failed to get adapter capabilities");
+
+	if (caps & RTE_EVENT_TIMER_ADAPTER_CAP_INTERNAL_PORT)
+		max_tmo_ns = 0;
+	else
+		max_tmo_ns = 180 * NSECPERSEC;
+
+	/* Periodic mode with 100 ms resolution */
+	return _timdev_setup(max_tmo_ns, NSECPERSEC / 10, flags);
+}
+
+static int
+timdev_setup_msec_wheel(void)
+{
+	uint64_t flags = RTE_EVENT_TIMER_ADAPTER_F_ADJUST_RES |
+			 RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL;
+
+	/* Max timeout is 3 mins, and bucket interval is 100 ms */
+	return _timdev_setup(180 * NSECPERSEC, NSECPERSEC / 10, flags);
+}
+
+static int
+timdev_setup_sec_wheel(void)
+{
+	uint64_t flags = RTE_EVENT_TIMER_ADAPTER_F_ADJUST_RES |
+			 RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL;
+
+	/* Max timeout is 100sec and bucket interval is 1sec */
+	return _timdev_setup(1E11, 1E9, flags);
+}
+
 static void
 timdev_teardown(void)
 {
@@ -2024,6 +2079,28 @@ static struct unit_test_suite event_timer_adptr_functional_testsuite  = {
 		TEST_CASE(adapter_create_max),
 		TEST_CASE_ST(timdev_setup_msec, timdev_teardown,
 				test_timer_ticks_remaining),
+		TEST_CASE_ST(timdev_setup_usec_wheel, timdev_teardown,
+				test_timer_arm),
+		TEST_CASE_ST(timdev_setup_msec_periodic_wheel, timdev_teardown,
+				test_timer_arm_periodic),
+		TEST_CASE_ST(timdev_setup_usec_wheel, timdev_teardown,
+				test_timer_arm_burst),
+		TEST_CASE_ST(timdev_setup_msec_periodic_wheel, timdev_teardown,
+				test_timer_arm_burst_periodic),
+		TEST_CASE_ST(timdev_setup_sec_wheel, timdev_teardown,
+				test_timer_cancel),
+		TEST_CASE_ST(timdev_setup_sec_wheel, timdev_teardown,
+				test_timer_cancel_random),
+		TEST_CASE_ST(timdev_setup_usec_wheel, timdev_teardown,
+				test_timer_arm_burst_multicore),
+		TEST_CASE_ST(timdev_setup_sec_wheel, timdev_teardown,
+				test_timer_cancel_burst_multicore),
+		TEST_CASE_ST(timdev_setup_msec_wheel, timdev_teardown,
+			     event_timer_arm_expiry),
+		TEST_CASE_ST(timdev_setup_msec_wheel, timdev_teardown,
+				event_timer_arm_invalid_timeout),
+		TEST_CASE_ST(timdev_setup_msec_wheel, timdev_teardown,
+				test_timer_ticks_remaining),
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
 };
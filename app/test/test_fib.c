@@ -7,6 +7,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#include <rte_errno.h>
 #include <rte_ip.h>
 #include <rte_log.h>
 #include <rte_fib.h>
@@ -22,6 +23,7 @@ static int32_t test_free_null(void);
 static int32_t test_add_del_invalid(void);
 static int32_t test_get_invalid(void);
 static int32_t test_lookup(void);
+static int32_t test_update_bulk(void);
 static int32_t test_invalid_rcu(void);
 static int32_t test_fib_rcu_sync_rw(void);
 
@@ -379,6 +381,107 @@ test_lookup(void)
 	return TEST_SUCCESS;
 }
 
+/*
+ * Add and delete the routes of check_fib() with rte_fib_update_bulk()
+ * and check that it stops on the first failed update
+ */
+static int
+check_update_bulk(struct rte_fib *fib)
+{
+	struct rte_fib_route_update upd[RTE_FIB_MAXDEPTH];
+	uint64_t def_nh = 100;
+	uint32_t ip_arr[RTE_FIB_MAXDEPTH];
+	uint32_t ip_add = RTE_IPV4(128, 0, 0, 0);
+	uint32_t i, ip_missing = RTE_IPV4(127, 255, 255, 255);
+	int ret;
+
+	for (i = 0; i < RTE_FIB_MAXDEPTH; i++)
+		ip_arr[i] = ip_add + (1ULL << i) - 1;
+
+	for (i = 0; i < RTE_FIB_MAXDEPTH; i++) {
+		upd[i].ip = ip_add;
+		upd[i].depth = i + 1;
+		upd[i].op = RTE_FIB_ADD;
+		upd[i].next_hop = i + 1;
+	}
+	ret = rte_fib_update_bulk(fib, upd, RTE_FIB_MAXDEPTH);
+	RTE_TEST_ASSERT(ret == RTE_FIB_MAXDEPTH, "Failed to add routes\n");
+	ret = lookup_and_check_asc(fib, ip_arr, ip_missing, def_nh,
+		RTE_FIB_MAXDEPTH);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS, "Lookup and check fails\n");
+
+	for (i = 0; i < RTE_FIB_MAXDEPTH - 1; i++) {
+		upd[i].depth = RTE_FIB_MAXDEPTH - i;
+		upd[i].op = RTE_FIB_DEL;
+	}
+	ret = rte_fib_update_bulk(fib, upd, RTE_FIB_MAXDEPTH - 1);
+	RTE_TEST_ASSERT(ret == RTE_FIB_MAXDEPTH - 1,
+		"Failed to delete routes\n");
+	ret = lookup_and_check_asc(fib, ip_arr, ip_missing, def_nh, 1);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS, "Lookup and check fails\n");
+
+	/* invalid operation */
+	upd[0].depth = 2;
+	upd[0].op = RTE_FIB_ADD;
+	upd[0].next_hop = 2;
+	upd[1].op = RTE_FIB_DEL + 1;
+	ret = rte_fib_update_bulk(fib, upd, 2);
+	RTE_TEST_ASSERT((ret == 1) && (rte_errno == EINVAL),
+		"Call succeeded with invalid parameters\n");
+	ret = lookup_and_check_asc(fib, ip_arr, ip_missing, def_nh, 2);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS, "Lookup and check fails\n");
+
+	/* the second deletion of a route fails */
+	upd[0].op = RTE_FIB_DEL;
+	upd[1] = upd[0];
+	upd[2] = upd[0];
+	upd[2].depth = 1;
+	ret = rte_fib_update_bulk(fib, upd, 3);
+	RTE_TEST_ASSERT((ret == 1) && (rte_errno == ENOENT),
+		"Call succeeded with a missing route\n");
+	ret = rte_fib_update_bulk(fib, &upd[2], 1);
+	RTE_TEST_ASSERT(ret == 1, "Failed to delete routes\n");
+	ret = lookup_and_check_desc(fib, ip_arr, ip_missing, def_nh, 0);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS, "Lookup and check fails\n");
+
+	ret = rte_fib_update_bulk(NULL, upd, 1);
+	RTE_TEST_ASSERT(ret == -EINVAL,
+		"Call succeeded with invalid parameters\n");
+
+	return TEST_SUCCESS;
+}
+
+int32_t
+test_update_bulk(void)
+{
+	struct rte_fib *fib = NULL;
+	struct rte_fib_conf config = { 0 };
+	int ret;
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = 100;
+	config.type = RTE_FIB_DUMMY;
+
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	ret = check_update_bulk(fib);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Check_update_bulk fails for DUMMY type\n");
+	rte_fib_free(fib);
+
+	config.type = RTE_FIB_DIR24_8;
+	config.dir24_8.nh_sz = RTE_FIB_DIR24_8_4B;
+	config.dir24_8.num_tbl8 = MAX_TBL8;
+	fib = rte_fib_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+	ret = check_update_bulk(fib);
+	RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+		"Check_update_bulk fails for DIR24_8_4B type\n");
+	rte_fib_free(fib);
+
+	return TEST_SUCCESS;
+}
+
 /*
  * rte_fib_rcu_qsbr_add positive and negative tests.
  *  - Add RCU QSBR variable to FIB
@@ -598,6 +701,7 @@ static struct unit_test_suite fib_fast_tests = {
 	TEST_CASE(test_add_del_invalid),
 	TEST_CASE(test_get_invalid),
 	TEST_CASE(test_lookup),
+	TEST_CASE(test_update_bulk),
 	TEST_CASE(test_invalid_rcu),
 	TEST_CASE(test_fib_rcu_sync_rw),
 	TEST_CASES_END()
@@ -23,12 +23,15 @@ static int32_t test_free_null(void);
 static int32_t test_add_del_invalid(void);
 static int32_t test_get_invalid(void);
 static int32_t test_lookup(void);
+static int32_t test_lookup_poptrie(void);
 static int32_t test_invalid_rcu(void);
 static int32_t test_fib_rcu_sync_rw(void);
 
 #define MAX_ROUTES	(1 << 16)
 /** Maximum number of tbl8 for 2-byte entries */
 #define MAX_TBL8	(1 << 15)
+/** Number of poptrie nodes */
+#define POPTRIE_NODES	(1 << 12)
 
 /*
  * Check that rte_fib6_create fails gracefully for incorrect user input
@@ -67,7 +70,7 @@ test_create_invalid(void)
 		"Call succeeded with invalid parameters\n");
 	config.max_routes = MAX_ROUTES;
 
-	config.type = RTE_FIB6_TRIE + 1;
+	config.type = RTE_FIB6_POPTRIE + 1;
 	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
 	RTE_TEST_ASSERT(fib == NULL,
 		"Call succeeded with invalid parameters\n");
@@ -390,6 +393,60 @@ test_lookup(void)
 	return TEST_SUCCESS;
 }
 
+/*
+ * Check the poptrie with all the next hop sizes and lookup functions
+ */
+int32_t
+test_lookup_poptrie(void)
+{
+	struct rte_fib6 *fib = NULL;
+	struct rte_fib6_conf config = { 0 };
+	static const enum rte_fib6_lookup_type lookup_types[] = {
+		RTE_FIB6_LOOKUP_POPTRIE_SCALAR,
+		RTE_FIB6_LOOKUP_POPTRIE_VECTOR_AVX2,
+	};
+	unsigned int i, j;
+	int ret;
+
+	config.max_routes = MAX_ROUTES;
+	config.default_nh = 100;
+	config.type = RTE_FIB6_POPTRIE;
+	config.poptrie.num_nodes = POPTRIE_NODES;
+
+	for (i = RTE_FIB6_TRIE_2B; i <= RTE_FIB6_TRIE_8B; i++) {
+		config.poptrie.nh_sz = i;
+		/* use the smallest root table with the 8B next hops */
+		config.poptrie.root_stride = (i == RTE_FIB6_TRIE_8B) ? 8 : 0;
+		fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+		RTE_TEST_ASSERT(fib != NULL, "Failed to create FIB\n");
+		for (j = 0; j < RTE_DIM(lookup_types); j++) {
+			/* the vector lookup may be unsupported */
+			if (rte_fib6_select_lookup(fib, lookup_types[j]) != 0)
+				continue;
+			ret = check_fib(fib);
+			RTE_TEST_ASSERT(ret == TEST_SUCCESS,
+				"Check_fib fails for POPTRIE type\n");
+		}
+		rte_fib6_free(fib);
+	}
+
+	/* rte_fib6_create: invalid root stride */
+	config.poptrie.nh_sz = RTE_FIB6_TRIE_4B;
+	config.poptrie.root_stride = 25;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	/* rte_fib6_create: num_nodes = 0 */
+	config.poptrie.root_stride = 0;
+	config.poptrie.num_nodes = 0;
+	fib = rte_fib6_create(__func__, SOCKET_ID_ANY, &config);
+	RTE_TEST_ASSERT(fib == NULL,
+		"Call succeeded with invalid parameters\n");
+
+	return TEST_SUCCESS;
+}
+
 /*
  * rte_fib6_rcu_qsbr_add positive and negative tests.
  *  - Add RCU QSBR variable to FIB
@@ -609,6 +666,7 @@ static struct unit_test_suite fib6_fast_tests = {
 	TEST_CASE(test_add_del_invalid),
 	TEST_CASE(test_get_invalid),
 	TEST_CASE(test_lookup),
+	TEST_CASE(test_lookup_poptrie),
 	TEST_CASE(test_invalid_rcu),
 	TEST_CASE(test_fib_rcu_sync_rw),
 	TEST_CASES_END()
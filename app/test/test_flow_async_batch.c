@@ -0,0 +1,422 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <errno.h>
+#include <inttypes.h>
+#include <ethdev_driver.h>
+#include <rte_errno.h>
+#include <rte_ethdev.h>
+#include <rte_flow.h>
+#include <rte_flow_driver.h>
+#include <rte_lcore.h>
+
+#include "sample_packet_forward.h"
+#include "test.h"
+
+/*
+ * The asynchronous flow operations of the test port are replaced by a mock
+ * flow queue, which completes the pushed operations when they are pulled.
+ */
+#define MOCK_QUEUE_SIZE 64
+
+static struct {
+	uint32_t size;           /* Flow queue size, MOCK_QUEUE_SIZE if 0. */
+	uint32_t queue_id;       /* Queue of the last operation. */
+	uint32_t n_postponed;    /* Enqueued, not pushed. */
+	uint32_t n_pushed;       /* Pushed, not pulled. */
+	void *user_data[MOCK_QUEUE_SIZE];
+	uint32_t n_push;         /* Push calls. */
+	uint32_t n_pull;         /* Pull calls. */
+	uint32_t n_not_postponed;
+	uint32_t n_overflow;
+	int fail_enqueue;
+	int stall;               /* Pull returns nothing. */
+	uintptr_t next_flow;
+} mock;
+
+static struct {
+	uint32_t n_res;
+	uint32_t n_cb;
+} completed;
+
+static uint16_t portid;
+static struct rte_ring *ring;
+static struct rte_flow_fp_ops mock_fp_ops;
+static const struct rte_flow_fp_ops *orig_fp_ops;
+
+static int
+mock_enqueue(uint32_t queue_id, const struct rte_flow_op_attr *op_attr,
+	     void *user_data, struct rte_flow_error *error)
+{
+	uint32_t n = mock.n_postponed + mock.n_pushed;
+	uint32_t size = mock.size ? mock.size : MOCK_QUEUE_SIZE;
+
+	mock.queue_id = queue_id;
+	if (mock.fail_enqueue)
+		return rte_flow_error_set(error, EINVAL,
+					  RTE_FLOW_ERROR_TYPE_UNSPECIFIED,
+					  NULL, "mock enqueue failure");
+	if (n == size) {
+		mock.n_overflow++;
+		return rte_flow_error_set(error, EAGAIN,
+					  RTE_FLOW_ERROR_TYPE_UNSPECIFIED,
+					  NULL, "mock queue full");
+	}
+	if (!op_attr->postpone)
+		mock.n_not_postponed++;
+
+	mock.user_data[n] = user_data;
+	mock.n_postponed++;
+	return 0;
+}
+
+static struct rte_flow *
+mock_async_create(struct rte_eth_dev *dev __rte_unused, uint32_t queue_id,
+		  const struct rte_flow_op_attr *op_attr,
+		  struct rte_flow_template_table *table __rte_unused,
+		  const struct rte_flow_item *items __rte_unused,
+		  uint8_t pattern_template_index __rte_unused,
+		  const struct rte_flow_action *actions __rte_unused,
+		  uint8_t action_template_index __rte_unused,
+		  void *user_data, struct rte_flow_error *error)
+{
+	if (mock_enqueue(queue_id, op_attr, user_data, error) < 0)
+		return NULL;
+
+	return (struct rte_flow *)++mock.next_flow;
+}
+
+static int
+mock_async_destroy(struct rte_eth_dev *dev __rte_unused, uint32_t queue_id,
+		   const struct rte_flow_op_attr *op_attr,
+		   struct rte_flow *flow __rte_unused,
+		   void *user_data, struct rte_flow_error *error)
+{
+	return mock_enqueue(queue_id, op_attr, user_data, error);
+}
+
+static int
+mock_push(struct rte_eth_dev *dev __rte_unused, uint32_t queue_id,
+	  struct rte_flow_error *error __rte_unused)
+{
+	mock.queue_id = queue_id;
+	mock.n_push++;
+	mock.n_pushed += mock.n_postponed;
+	mock.n_postponed = 0;
+	return 0;
+}
+
+static int
+mock_pull(struct rte_eth_dev *dev __rte_unused, uint32_t queue_id,
+	  struct rte_flow_op_result *res, uint16_t n_res,
+	  struct rte_flow_error *error __rte_unused)
+{
+	uint32_t i, n;
+
+	mock.queue_id = queue_id;
+	mock.n_pull++;
+	if (mock.stall)
+		return 0;
+
+	n = RTE_MIN((uint32_t)n_res, mock.n_pushed);
+	for (i = 0; i < n; i++) {
+		res[i].status = RTE_FLOW_OP_SUCCESS;
+		res[i].user_data = mock.user_data[i];
+	}
+
+	/* The postponed operations follow the pushed ones. */
+	memmove(mock.user_data, &mock.user_data[n],
+		(mock.n_pushed + mock.n_postponed - n) * sizeof(mock.user_data[0]));
+	mock.n_pushed -= n;
+
+	return n;
+}
+
+static void
+batch_cb(uint16_t port_id, uint32_t queue_id __rte_unused,
+	 const struct rte_flow_op_result res[], uint16_t n_res,
+	 void *cb_arg __rte_unused)
+{
+	uint16_t i;
+
+	if (port_id != portid)
+		return;
+
+	for (i = 0; i < n_res; i++)
+		if (res[i].status == RTE_FLOW_OP_SUCCESS)
+			completed.n_res++;
+	completed.n_cb++;
+}
+
+static struct rte_flow *
+batch_flow_create(struct rte_flow_async_batch *batch, uintptr_t id)
+{
+	static const struct rte_flow_item pattern[] = {
+		{ .type = RTE_FLOW_ITEM_TYPE_END },
+	};
+	static const struct rte_flow_action actions[] = {
+		{ .type = RTE_FLOW_ACTION_TYPE_END },
+	};
+	struct rte_flow_error error;
+
+	return rte_flow_async_batch_flow_create(batch, NULL, pattern, 0,
+						actions, 0, (void *)id, &error);
+}
+
+static int
+test_flow_async_batch_create(void)
+{
+	struct rte_flow_async_batch_conf conf = {
+		.queue_id = 0,
+		.queue_size = 8,
+		.push_threshold = 4,
+		.pull_burst = 4,
+	};
+	struct rte_flow_async_batch_conf bad;
+	struct rte_flow_async_batch *batch;
+
+	batch = rte_flow_async_batch_create(RTE_MAX_ETHPORTS, &conf, SOCKET_ID_ANY);
+	TEST_ASSERT(batch == NULL && rte_errno == EINVAL,
+		    "Batch created on invalid port");
+
+	batch = rte_flow_async_batch_create(portid, NULL, SOCKET_ID_ANY);
+	TEST_ASSERT(batch == NULL && rte_errno == EINVAL,
+		    "Batch created without configuration");
+
+	bad = conf;
+	bad.queue_size = 0;
+	batch = rte_flow_async_batch_create(portid, &bad, SOCKET_ID_ANY);
+	TEST_ASSERT(batch == NULL && rte_errno == EINVAL,
+		    "Batch created with empty queue");
+
+	bad = conf;
+	bad.push_threshold = 0;
+	batch = rte_flow_async_batch_create(portid, &bad, SOCKET_ID_ANY);
+	TEST_ASSERT(batch == NULL && rte_errno == EINVAL,
+		    "Batch created without push threshold");
+
+	bad = conf;
+	bad.push_threshold = conf.queue_size + 1;
+	batch = rte_flow_async_batch_create(portid, &bad, SOCKET_ID_ANY);
+	TEST_ASSERT(batch == NULL && rte_errno == EINVAL,
+		    "Batch created with push threshold above queue size");
+
+	bad = conf;
+	bad.pull_burst = 0;
+	batch = rte_flow_async_batch_create(portid, &bad, SOCKET_ID_ANY);
+	TEST_ASSERT(batch == NULL && rte_errno == EINVAL,
+		    "Batch created without pull burst");
+
+	/* The lcore queue is the one of the creating lcore index. */
+	bad = conf;
+	bad.queue_id = RTE_FLOW_ASYNC_BATCH_QUEUE_LCORE;
+	batch = rte_flow_async_batch_create(portid, &bad, SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(batch, "Failed to create lcore queue batch");
+	TEST_ASSERT_NOT_NULL(batch_flow_create(batch, 1), "Failed to create flow");
+	TEST_ASSERT_EQUAL(mock.queue_id, (uint32_t)rte_lcore_index(-1),
+			  "Wrong queue %u", mock.queue_id);
+	TEST_ASSERT_SUCCESS(rte_flow_async_batch_drain(batch, NULL),
+			    "Failed to drain batch");
+	rte_flow_async_batch_free(batch);
+
+	/* Nothing to push nor to pull on an empty batch. */
+	batch = rte_flow_async_batch_create(portid, &conf, SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(batch, "Failed to create batch");
+	mock.n_push = 0;
+	mock.n_pull = 0;
+	TEST_ASSERT_SUCCESS(rte_flow_async_batch_push(batch, NULL),
+			    "Failed to push empty batch");
+	TEST_ASSERT_EQUAL(rte_flow_async_batch_poll(batch, NULL), 0,
+			  "Polled results from empty batch");
+	TEST_ASSERT_SUCCESS(rte_flow_async_batch_drain(batch, NULL),
+			    "Failed to drain empty batch");
+	TEST_ASSERT(mock.n_push == 0 && mock.n_pull == 0,
+		    "Empty batch called the driver");
+	rte_flow_async_batch_free(batch);
+
+	rte_flow_async_batch_free(NULL);
+
+	return TEST_SUCCESS;
+}
+
+/* Operations are pushed by threshold and completed through the callback. */
+static int
+test_flow_async_batch_push(void)
+{
+	struct rte_flow_async_batch_conf conf = {
+		.queue_id = 1,
+		.queue_size = 16,
+		.push_threshold = 4,
+		.pull_burst = 2,
+		.cb = batch_cb,
+	};
+	struct rte_flow *flows[6];
+	struct rte_flow_async_batch *batch;
+	struct rte_flow_error error;
+	uintptr_t i;
+	int ret;
+
+	batch = rte_flow_async_batch_create(portid, &conf, SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(batch, "Failed to create batch");
+
+	for (i = 0; i < 3; i++) {
+		flows[i] = batch_flow_create(batch, i);
+		TEST_ASSERT_NOT_NULL(flows[i], "Failed to create flow %"PRIuPTR, i);
+	}
+	TEST_ASSERT_EQUAL(mock.n_push, 0, "Pushed below threshold");
+
+	flows[3] = batch_flow_create(batch, 3);
+	TEST_ASSERT_NOT_NULL(flows[3], "Failed to create flow 3");
+	TEST_ASSERT_EQUAL(mock.n_push, 1, "Not pushed at threshold");
+	TEST_ASSERT_EQUAL(mock.n_not_postponed, 0, "Operation not postponed");
+	TEST_ASSERT_EQUAL(mock.queue_id, conf.queue_id, "Wrong queue");
+
+	/* One burst per poll. */
+	ret = rte_flow_async_batch_poll(batch, &error);
+	TEST_ASSERT_EQUAL(ret, conf.pull_burst, "Polled %d results", ret);
+	TEST_ASSERT(completed.n_cb == 1 && completed.n_res == 2,
+		    "Callback not called with the results");
+
+	/* Partial batch is pushed by the poll. */
+	flows[4] = batch_flow_create(batch, 4);
+	flows[5] = batch_flow_create(batch, 5);
+	TEST_ASSERT(flows[4] != NULL && flows[5] != NULL, "Failed to create flows");
+	TEST_ASSERT_SUCCESS(rte_flow_async_batch_drain(batch, &error),
+			    "Failed to drain batch");
+	TEST_ASSERT_EQUAL(mock.n_postponed + mock.n_pushed, 0,
+			  "Operations left in the queue");
+	TEST_ASSERT_EQUAL(completed.n_res, 6, "Wrong completed count %u",
+			  completed.n_res);
+
+	for (i = 0; i < 6; i++)
+		TEST_ASSERT_SUCCESS(rte_flow_async_batch_flow_destroy(batch,
+				    flows[i], NULL, &error),
+				    "Failed to destroy flow %"PRIuPTR, i);
+	TEST_ASSERT_SUCCESS(rte_flow_async_batch_drain(batch, &error),
+			    "Failed to drain batch");
+	TEST_ASSERT_EQUAL(completed.n_res, 12, "Wrong completed count %u",
+			  completed.n_res);
+
+	rte_flow_async_batch_free(batch);
+
+	return TEST_SUCCESS;
+}
+
+/* The flow queue is never overfilled, EAGAIN when it cannot be emptied. */
+static int
+test_flow_async_batch_full(void)
+{
+	struct rte_flow_async_batch_conf conf = {
+		.queue_id = 0,
+		.queue_size = 4,
+		.push_threshold = 4,
+		.pull_burst = 4,
+	};
+	struct rte_flow_async_batch *batch;
+	uintptr_t i;
+
+	batch = rte_flow_async_batch_create(portid, &conf, SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(batch, "Failed to create batch");
+	mock.size = conf.queue_size;
+
+	/* Twice the queue size, room is made by pulling. */
+	for (i = 0; i < 2 * conf.queue_size; i++)
+		TEST_ASSERT_NOT_NULL(batch_flow_create(batch, i),
+				     "Failed to create flow %"PRIuPTR, i);
+	TEST_ASSERT(mock.n_pull > 0, "Full queue not pulled");
+	TEST_ASSERT_EQUAL(mock.n_overflow, 0, "Flow queue overfilled");
+
+	mock.stall = 1;
+	TEST_ASSERT_NULL(batch_flow_create(batch, i), "Flow created in full queue");
+	TEST_ASSERT_EQUAL(rte_errno, EAGAIN, "Wrong error for full queue");
+	TEST_ASSERT_EQUAL(rte_flow_async_batch_flow_destroy(batch, NULL, NULL, NULL),
+			  -EAGAIN, "Flow destroyed in full queue");
+	mock.stall = 0;
+
+	TEST_ASSERT_SUCCESS(rte_flow_async_batch_drain(batch, NULL),
+			    "Failed to drain batch");
+	TEST_ASSERT_EQUAL(mock.n_overflow, 0, "Flow queue overfilled");
+
+	/* A rejected operation is not counted in flight. */
+	mock.fail_enqueue = 1;
+	TEST_ASSERT_NULL(batch_flow_create(batch, 0), "Rejected flow created");
+	TEST_ASSERT_EQUAL(rte_errno, EINVAL, "Wrong error for rejected flow");
+	mock.fail_enqueue = 0;
+	mock.n_pull = 0;
+	TEST_ASSERT_SUCCESS(rte_flow_async_batch_drain(batch, NULL),
+			    "Failed to drain batch");
+	TEST_ASSERT_EQUAL(mock.n_pull, 0, "Rejected flow waited for");
+
+	rte_flow_async_batch_free(batch);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_flow_async_batch_case_setup(void)
+{
+	memset(&mock, 0, sizeof(mock));
+	memset(&completed, 0, sizeof(completed));
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_flow_async_batch_setup(void)
+{
+	struct rte_eth_dev *dev;
+
+	test_ring_setup(&ring, &portid);
+	if (!rte_eth_dev_is_valid_port(portid)) {
+		printf("Failed to create ring port\n");
+		return TEST_FAILED;
+	}
+
+	dev = &rte_eth_devices[portid];
+	orig_fp_ops = dev->flow_fp_ops;
+	mock_fp_ops = *orig_fp_ops;
+	mock_fp_ops.async_create = mock_async_create;
+	mock_fp_ops.async_destroy = mock_async_destroy;
+	mock_fp_ops.push = mock_push;
+	mock_fp_ops.pull = mock_pull;
+	dev->flow_fp_ops = &mock_fp_ops;
+
+	return TEST_SUCCESS;
+}
+
+static void
+test_flow_async_batch_teardown(void)
+{
+	rte_eth_devices[portid].flow_fp_ops = orig_fp_ops;
+	test_vdev_uninit("net_ring_net_ringa");
+	test_ring_free(ring);
+}
+
+static struct
+unit_test_suite flow_async_batch_testsuite  = {
+	.suite_name = "Flow async batch Unit Test Suite",
+	.setup = test_flow_async_batch_setup,
+	.teardown = test_flow_async_batch_teardown,
+	.unit_test_cases = {
+		TEST_CASE_ST(test_flow_async_batch_case_setup, NULL,
+			     test_flow_async_batch_create),
+		TEST_CASE_ST(test_flow_async_batch_case_setup, NULL,
+			     test_flow_async_batch_push),
+		TEST_CASE_ST(test_flow_async_batch_case_setup, NULL,
+			     test_flow_async_batch_full),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_flow_async_batch(void)
+{
+	return unit_test_suite_runner(&flow_async_batch_testsuite);
+}
+
+REGISTER_FAST_TEST(flow_async_batch_autotest, NOHUGE_OK, ASAN_OK, test_flow_async_batch);
@@ -0,0 +1,338 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <errno.h>
+#include <rte_errno.h>
+#include <rte_ethdev.h>
+#include <rte_ether.h>
+#include <rte_flow.h>
+#include <rte_flow_sw.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_udp.h>
+
+#include "sample_packet_forward.h"
+#include "test.h"
+
+#define QUEUE_ID 0
+#define UDP_PORT_MATCH 1000
+#define UDP_PORT_OTHER 2000
+#define MARK_ID 7
+
+static uint16_t portid;
+static struct rte_ring *ring;
+static struct rte_mempool *mp;
+
+static const struct rte_flow_attr attr_ingress = {
+	.ingress = 1,
+};
+
+/* Build an Ethernet/IPv4/UDP packet to the given UDP port. */
+static struct rte_mbuf *
+flow_sw_pkt_build(uint16_t dst_port)
+{
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ip;
+	struct rte_udp_hdr *udp;
+	struct rte_mbuf *m;
+
+	m = rte_pktmbuf_alloc(mp);
+	if (m == NULL)
+		return NULL;
+
+	eth = (struct rte_ether_hdr *)rte_pktmbuf_append(m,
+		sizeof(*eth) + sizeof(*ip) + sizeof(*udp));
+	if (eth == NULL) {
+		rte_pktmbuf_free(m);
+		return NULL;
+	}
+	memset(eth, 0, sizeof(*eth) + sizeof(*ip) + sizeof(*udp));
+
+	eth->ether_type = rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4);
+	ip = (struct rte_ipv4_hdr *)(eth + 1);
+	ip->version_ihl = RTE_IPV4_VHL_DEF;
+	ip->next_proto_id = IPPROTO_UDP;
+	ip->total_length = rte_cpu_to_be_16(sizeof(*ip) + sizeof(*udp));
+	udp = (struct rte_udp_hdr *)(ip + 1);
+	udp->dst_port = rte_cpu_to_be_16(dst_port);
+	udp->dgram_len = rte_cpu_to_be_16(sizeof(*udp));
+
+	return m;
+}
+
+/*
+ * Send one packet to the given UDP port through the port loopback and
+ * receive it, return NULL when the software rules dropped it.
+ */
+static struct rte_mbuf *
+flow_sw_pkt_loop(uint16_t dst_port)
+{
+	struct rte_mbuf *m;
+
+	m = flow_sw_pkt_build(dst_port);
+	if (m == NULL)
+		return NULL;
+
+	if (rte_eth_tx_burst(portid, QUEUE_ID, &m, 1) != 1) {
+		rte_pktmbuf_free(m);
+		return NULL;
+	}
+
+	if (rte_eth_rx_burst(portid, QUEUE_ID, &m, 1) != 1)
+		return NULL;
+
+	return m;
+}
+
+/* Create a rule matching the UDP port, with the given actions. */
+static struct rte_flow_sw_handle *
+flow_sw_rule_create(uint32_t priority, uint16_t dst_port,
+		    const struct rte_flow_action actions[])
+{
+	struct rte_flow_attr attr = attr_ingress;
+	struct rte_flow_item_udp udp_spec = {
+		.hdr.dst_port = rte_cpu_to_be_16(dst_port),
+	};
+	struct rte_flow_item_udp udp_mask = {
+		.hdr.dst_port = RTE_BE16(0xffff),
+	};
+	struct rte_flow_item pattern[] = {
+		{ .type = RTE_FLOW_ITEM_TYPE_ETH },
+		{ .type = RTE_FLOW_ITEM_TYPE_IPV4 },
+		{
+			.type = RTE_FLOW_ITEM_TYPE_UDP,
+			.spec = dst_port ? &udp_spec : NULL,
+			.mask = dst_port ? &udp_mask : NULL,
+		},
+		{ .type = RTE_FLOW_ITEM_TYPE_END },
+	};
+	struct rte_flow_error error;
+
+	attr.priority = priority;
+
+	return rte_flow_sw_create(portid, &attr, pattern, actions, &error);
+}
+
+/* The ring PMD has no flow support, rules must fall back to software. */
+static int
+test_flow_sw_fallback(void)
+{
+	static const struct rte_flow_action_mark mark = { .id = MARK_ID };
+	static const struct rte_flow_action actions[] = {
+		{ .type = RTE_FLOW_ACTION_TYPE_MARK, .conf = &mark },
+		{ .type = RTE_FLOW_ACTION_TYPE_COUNT },
+		{ .type = RTE_FLOW_ACTION_TYPE_END },
+	};
+	struct rte_flow_query_count count = { .reset = 0 };
+	struct rte_flow_sw_handle *handle;
+	struct rte_flow_error error;
+	struct rte_mbuf *m;
+	int ret;
+
+	handle = flow_sw_rule_create(0, UDP_PORT_MATCH, actions);
+	TEST_ASSERT_NOT_NULL(handle, "Failed to create rule: %s",
+			     rte_strerror(rte_errno));
+	TEST_ASSERT_EQUAL(rte_flow_sw_is_software(handle), 1,
+			  "Rule not created in software");
+
+	/* Matching packet is marked. */
+	m = flow_sw_pkt_loop(UDP_PORT_MATCH);
+	TEST_ASSERT_NOT_NULL(m, "Matching packet not received");
+	TEST_ASSERT(m->ol_flags & RTE_MBUF_F_RX_FDIR_ID,
+		    "Matching packet not marked");
+	TEST_ASSERT_EQUAL(m->hash.fdir.hi, MARK_ID, "Wrong mark %u",
+			  m->hash.fdir.hi);
+	rte_pktmbuf_free(m);
+
+	/* Other packet is left untouched. */
+	m = flow_sw_pkt_loop(UDP_PORT_OTHER);
+	TEST_ASSERT_NOT_NULL(m, "Other packet not received");
+	TEST_ASSERT(!(m->ol_flags & RTE_MBUF_F_RX_FDIR),
+		    "Other packet marked");
+	rte_pktmbuf_free(m);
+
+	ret = rte_flow_sw_query_count(portid, handle, &count, &error);
+	TEST_ASSERT_SUCCESS(ret, "Failed to query count");
+	TEST_ASSERT_EQUAL(count.hits, 1, "Wrong hits %"PRIu64, count.hits);
+
+	ret = rte_flow_sw_destroy(portid, handle, &error);
+	TEST_ASSERT_SUCCESS(ret, "Failed to destroy rule");
+
+	/* Destroyed rule no longer matches. */
+	m = flow_sw_pkt_loop(UDP_PORT_MATCH);
+	TEST_ASSERT_NOT_NULL(m, "Packet not received after destroy");
+	TEST_ASSERT(!(m->ol_flags & RTE_MBUF_F_RX_FDIR),
+		    "Packet marked after destroy");
+	rte_pktmbuf_free(m);
+
+	return TEST_SUCCESS;
+}
+
+/* Rules apply in priority order, the first matching rule only. */
+static int
+test_flow_sw_priority(void)
+{
+	static const struct rte_flow_action_mark mark = { .id = MARK_ID };
+	static const struct rte_flow_action actions_drop[] = {
+		{ .type = RTE_FLOW_ACTION_TYPE_DROP },
+		{ .type = RTE_FLOW_ACTION_TYPE_END },
+	};
+	static const struct rte_flow_action actions_mark[] = {
+		{ .type = RTE_FLOW_ACTION_TYPE_MARK, .conf = &mark },
+		{ .type = RTE_FLOW_ACTION_TYPE_END },
+	};
+	struct rte_flow_sw_handle *drop, *all;
+	struct rte_flow_error error;
+	struct rte_mbuf *m;
+
+	/* Created first, but of lower priority than the next rule. */
+	drop = flow_sw_rule_create(1, UDP_PORT_MATCH, actions_drop);
+	TEST_ASSERT_NOT_NULL(drop, "Failed to create drop rule");
+	all = flow_sw_rule_create(0, 0, actions_mark);
+	TEST_ASSERT_NOT_NULL(all, "Failed to create mark rule");
+
+	m = flow_sw_pkt_loop(UDP_PORT_MATCH);
+	TEST_ASSERT_NOT_NULL(m, "Packet dropped by lower priority rule");
+	TEST_ASSERT_EQUAL(m->hash.fdir.hi, MARK_ID, "Packet not marked");
+	rte_pktmbuf_free(m);
+
+	TEST_ASSERT_SUCCESS(rte_flow_sw_destroy(portid, all, &error),
+			    "Failed to destroy mark rule");
+
+	m = flow_sw_pkt_loop(UDP_PORT_MATCH);
+	TEST_ASSERT_NULL(m, "Packet not dropped");
+
+	m = flow_sw_pkt_loop(UDP_PORT_OTHER);
+	TEST_ASSERT_NOT_NULL(m, "Other packet dropped");
+	rte_pktmbuf_free(m);
+
+	TEST_ASSERT_SUCCESS(rte_flow_sw_destroy(portid, drop, &error),
+			    "Failed to destroy drop rule");
+
+	return TEST_SUCCESS;
+}
+
+/* Rules and arguments the software classifier rejects. */
+static int
+test_flow_sw_invalid(void)
+{
+	static const struct rte_flow_action actions_queue[] = {
+		{ .type = RTE_FLOW_ACTION_TYPE_QUEUE },
+		{ .type = RTE_FLOW_ACTION_TYPE_END },
+	};
+	static const struct rte_flow_action actions_drop[] = {
+		{ .type = RTE_FLOW_ACTION_TYPE_DROP },
+		{ .type = RTE_FLOW_ACTION_TYPE_END },
+	};
+	static const struct rte_flow_item pattern[] = {
+		{ .type = RTE_FLOW_ITEM_TYPE_ETH },
+		{ .type = RTE_FLOW_ITEM_TYPE_END },
+	};
+	const struct rte_flow_attr attr_egress = { .egress = 1 };
+	struct rte_flow_query_count count = { .reset = 0 };
+	struct rte_flow_sw_handle *handle;
+	struct rte_flow_error error;
+
+	handle = rte_flow_sw_create(portid, &attr_egress, pattern,
+				    actions_drop, &error);
+	TEST_ASSERT_NULL(handle, "Egress rule created");
+	TEST_ASSERT_EQUAL(rte_errno, ENOTSUP, "Wrong error for egress rule");
+
+	handle = rte_flow_sw_create(portid, &attr_ingress, pattern,
+				    actions_queue, &error);
+	TEST_ASSERT_NULL(handle, "Rule with unsupported action created");
+	TEST_ASSERT_EQUAL(rte_errno, ENOTSUP, "Wrong error for queue action");
+
+	handle = rte_flow_sw_create(RTE_MAX_ETHPORTS, &attr_ingress, pattern,
+				    actions_drop, &error);
+	TEST_ASSERT_NULL(handle, "Rule created on invalid port");
+	TEST_ASSERT_EQUAL(rte_errno, ENODEV, "Wrong error for invalid port");
+
+	TEST_ASSERT_EQUAL(rte_flow_sw_destroy(portid, NULL, &error), -EINVAL,
+			  "Destroyed NULL handle");
+
+	/* No count action in the rule. */
+	handle = rte_flow_sw_create(portid, &attr_ingress, pattern,
+				    actions_drop, &error);
+	TEST_ASSERT_NOT_NULL(handle, "Failed to create drop rule");
+	TEST_ASSERT_EQUAL(rte_flow_sw_query_count(portid, handle, &count, &error),
+			  -ENOTSUP, "Queried rule without count action");
+	TEST_ASSERT_SUCCESS(rte_flow_sw_destroy(portid, handle, &error),
+			    "Failed to destroy drop rule");
+
+	TEST_ASSERT_EQUAL(rte_flow_sw_rx_queue_enable(portid, QUEUE_ID), -EEXIST,
+			  "Rx queue enabled twice");
+	TEST_ASSERT_EQUAL(rte_flow_sw_rx_queue_disable(portid, QUEUE_ID + 1),
+			  -ENOENT, "Disabled Rx queue not enabled");
+	TEST_ASSERT_EQUAL(rte_flow_sw_rx_queue_enable(portid,
+			  RTE_MAX_QUEUES_PER_PORT), -EINVAL,
+			  "Enabled invalid Rx queue");
+	TEST_ASSERT_EQUAL(rte_flow_sw_rx_queue_enable(RTE_MAX_ETHPORTS, QUEUE_ID),
+			  -ENODEV, "Enabled Rx queue of invalid port");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_flow_sw_setup(void)
+{
+	char poolname[] = "flow_sw_pool";
+	int ret;
+
+	ret = test_get_mempool(&mp, poolname);
+	if (ret < 0) {
+		printf("Failed to create mbuf pool\n");
+		return TEST_FAILED;
+	}
+
+	test_ring_setup(&ring, &portid);
+	ret = test_dev_start(portid, mp);
+	if (ret < 0) {
+		printf("test_dev_start(%hu) failed, error code: %d\n", portid, ret);
+		return TEST_FAILED;
+	}
+
+	ret = rte_flow_sw_rx_queue_enable(portid, QUEUE_ID);
+	if (ret < 0) {
+		printf("Failed to enable software rules on Rx queue: %d\n", ret);
+		return TEST_FAILED;
+	}
+
+	return TEST_SUCCESS;
+}
+
+static void
+test_flow_sw_teardown(void)
+{
+	rte_flow_sw_rx_queue_disable(portid, QUEUE_ID);
+	rte_eth_dev_stop(portid);
+	test_vdev_uninit("net_ring_net_ringa");
+	test_ring_free(ring);
+	test_mp_free(mp);
+}
+
+static struct
+unit_test_suite flow_sw_testsuite  = {
+	.suite_name = "Flow software fallback Unit Test Suite",
+	.setup = test_flow_sw_setup,
+	.teardown = test_flow_sw_teardown,
+	.unit_test_cases = {
+		TEST_CASE(test_flow_sw_fallback),
+		TEST_CASE(test_flow_sw_priority),
+		TEST_CASE(test_flow_sw_invalid),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_flow_sw(void)
+{
+	return unit_test_suite_runner(&flow_sw_testsuite);
+}
+
+REGISTER_FAST_TEST(flow_sw_autotest, NOHUGE_OK, ASAN_OK, test_flow_sw);
@@ -0,0 +1,326 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright (c) 2026 NVIDIA Corporation & Affiliates
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <errno.h>
+#include <rte_errno.h>
+#include <rte_gpudev.h>
+#include <gpudev_driver.h>
+#include <rte_mbuf.h>
+
+#include "test.h"
+
+/*
+ * The ring is created on a fake device which only registers CPU memory,
+ * so the doorbell falls back to registered CPU memory.
+ * The device side is simulated by writing the status and consumer index.
+ */
+#define RING_SIZE 8
+#define PKT_LEN 64
+
+static struct rte_gpu *gpu;
+static int16_t gpu_id;
+static unsigned int n_registered;
+
+static struct rte_mbuf pkts[2 * RING_SIZE];
+static struct rte_mbuf *pkt_list[2 * RING_SIZE];
+static uint8_t pkt_data[2 * RING_SIZE][PKT_LEN];
+
+static int
+fake_mem_register(struct rte_gpu *dev __rte_unused, size_t size __rte_unused,
+		  void *ptr __rte_unused)
+{
+	n_registered++;
+	return 0;
+}
+
+static int
+fake_mem_unregister(struct rte_gpu *dev __rte_unused, void *ptr __rte_unused)
+{
+	n_registered--;
+	return 0;
+}
+
+/* Complete the entries [tail, tail + n) with the given status. */
+static void
+simulate_device(struct rte_gpu_comm_ring *ring, uint32_t n,
+		enum rte_gpu_comm_list_status status)
+{
+	uint32_t cons = *ring->cons;
+	uint32_t i;
+
+	for (i = 0; i < n; i++)
+		ring->status[(cons + i) & (ring->size - 1)] = status;
+	rte_wmb();
+	*ring->cons = cons + n;
+}
+
+static int
+test_gpudev_comm_ring_setup(void)
+{
+	gpu = rte_gpu_allocate("test_gpu_comm_ring");
+	if (gpu == NULL) {
+		printf("Cannot allocate fake GPU device: %s\n",
+		       rte_strerror(rte_errno));
+		return TEST_SKIPPED;
+	}
+	gpu->ops.mem_register = fake_mem_register;
+	gpu->ops.mem_unregister = fake_mem_unregister;
+	rte_gpu_complete_new(gpu);
+	gpu_id = gpu->mpshared->info.dev_id;
+
+	return TEST_SUCCESS;
+}
+
+static void
+test_gpudev_comm_ring_teardown(void)
+{
+	rte_gpu_release(gpu);
+	gpu = NULL;
+}
+
+static int
+test_gpudev_comm_ring_case_setup(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < RTE_DIM(pkts); i++) {
+		memset(&pkts[i], 0, sizeof(pkts[i]));
+		pkts[i].buf_addr = pkt_data[i];
+		pkts[i].nb_segs = 1;
+		pkts[i].pkt_len = PKT_LEN;
+		pkts[i].data_len = PKT_LEN;
+		pkt_list[i] = &pkts[i];
+	}
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_gpudev_comm_ring_create(void)
+{
+	struct rte_gpu_comm_ring *ring;
+
+	rte_errno = 0;
+	ring = rte_gpu_comm_create_ring(gpu_id, 0);
+	TEST_ASSERT(ring == NULL && rte_errno == EINVAL,
+		    "Ring of size 0 not rejected");
+
+	rte_errno = 0;
+	ring = rte_gpu_comm_create_ring(gpu_id, RING_SIZE + 1);
+	TEST_ASSERT(ring == NULL && rte_errno == EINVAL,
+		    "Ring of non power of 2 size not rejected");
+
+	rte_errno = 0;
+	ring = rte_gpu_comm_create_ring((uint16_t)RTE_GPU_ID_NONE, RING_SIZE);
+	TEST_ASSERT(ring == NULL && rte_errno == ENODEV,
+		    "Ring on invalid device not rejected");
+
+	ring = rte_gpu_comm_create_ring(gpu_id, RING_SIZE);
+	TEST_ASSERT_NOT_NULL(ring, "Cannot create ring: %s",
+			     rte_strerror(rte_errno));
+	TEST_ASSERT_EQUAL(ring->size, RING_SIZE, "Wrong ring size");
+	TEST_ASSERT(ring->prod_h == ring->prod_d,
+		    "Doorbell not in CPU memory without device allocation");
+	TEST_ASSERT_EQUAL(*ring->prod_h, 0, "Doorbell not cleared");
+	TEST_ASSERT_EQUAL(*ring->cons, 0, "Consumer index not cleared");
+	TEST_ASSERT(n_registered > 0, "Ring memory not registered");
+
+	TEST_ASSERT_SUCCESS(rte_gpu_comm_destroy_ring(ring),
+			    "Cannot destroy ring");
+	TEST_ASSERT_EQUAL(n_registered, 0, "Ring memory not unregistered");
+
+	TEST_ASSERT_EQUAL(rte_gpu_comm_destroy_ring(NULL), -EINVAL,
+			  "Destroy of NULL ring not rejected");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_gpudev_comm_ring_enqueue(void)
+{
+	struct rte_gpu_comm_ring *ring;
+	struct rte_mbuf *out[RING_SIZE];
+	uint32_t n, i, entry;
+
+	ring = rte_gpu_comm_create_ring(gpu_id, RING_SIZE);
+	TEST_ASSERT_NOT_NULL(ring, "Cannot create ring");
+
+	rte_errno = 0;
+	n = rte_gpu_comm_enqueue_burst(NULL, pkt_list, 1);
+	TEST_ASSERT(n == 0 && rte_errno == EINVAL, "NULL ring not rejected");
+	rte_errno = 0;
+	n = rte_gpu_comm_enqueue_burst(ring, NULL, 1);
+	TEST_ASSERT(n == 0 && rte_errno == EINVAL, "NULL mbufs not rejected");
+	rte_errno = 0;
+	n = rte_gpu_comm_dequeue_burst(NULL, out, NULL, 1);
+	TEST_ASSERT(n == 0 && rte_errno == EINVAL,
+		    "Dequeue from NULL ring not rejected");
+
+	/* Enqueue more than the ring size: limited to the free entries. */
+	n = rte_gpu_comm_enqueue_burst(ring, pkt_list, 2 * RING_SIZE);
+	TEST_ASSERT_EQUAL(n, RING_SIZE, "Enqueue not limited to ring size");
+	TEST_ASSERT_EQUAL(*ring->prod_h, RING_SIZE, "Doorbell not rung");
+	for (i = 0; i < RING_SIZE; i++) {
+		TEST_ASSERT_EQUAL(ring->pkt_list[i].addr,
+				  (uintptr_t)pkt_data[i],
+				  "Wrong address in entry %u", i);
+		TEST_ASSERT_EQUAL(ring->pkt_list[i].size, PKT_LEN,
+				  "Wrong size in entry %u", i);
+	}
+
+	n = rte_gpu_comm_enqueue_burst(ring, &pkt_list[RING_SIZE], 1);
+	TEST_ASSERT_EQUAL(n, 0, "Enqueue in full ring");
+
+	/* Free two entries and wrap around. */
+	simulate_device(ring, 2, RTE_GPU_COMM_LIST_DONE);
+	n = rte_gpu_comm_dequeue_burst(ring, out, NULL, RING_SIZE);
+	TEST_ASSERT_EQUAL(n, 2, "Wrong number of dequeued mbufs");
+
+	n = rte_gpu_comm_enqueue_burst(ring, &pkt_list[RING_SIZE], RING_SIZE);
+	TEST_ASSERT_EQUAL(n, 2, "Enqueue not limited to free entries");
+	TEST_ASSERT_EQUAL(*ring->prod_h, RING_SIZE + 2, "Doorbell not rung");
+	for (i = 0; i < 2; i++) {
+		entry = (RING_SIZE + i) & (RING_SIZE - 1);
+		TEST_ASSERT_EQUAL(ring->pkt_list[entry].addr,
+				  (uintptr_t)pkt_data[RING_SIZE + i],
+				  "Wrong address in wrapped entry %u", entry);
+	}
+
+	TEST_ASSERT_SUCCESS(rte_gpu_comm_destroy_ring(ring),
+			    "Cannot destroy ring");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_gpudev_comm_ring_chained(void)
+{
+	struct rte_gpu_comm_ring *ring;
+	struct rte_mbuf *burst[3];
+	uint32_t n;
+
+	ring = rte_gpu_comm_create_ring(gpu_id, RING_SIZE);
+	TEST_ASSERT_NOT_NULL(ring, "Cannot create ring");
+
+	/* The chained mbuf stops the burst, the previous ones are enqueued. */
+	pkts[1].nb_segs = 2;
+	pkts[1].next = &pkts[2];
+	pkts[1].pkt_len = 2 * PKT_LEN;
+	burst[0] = &pkts[0];
+	burst[1] = &pkts[1];
+	burst[2] = &pkts[3];
+
+	rte_errno = 0;
+	n = rte_gpu_comm_enqueue_burst(ring, burst, RTE_DIM(burst));
+	TEST_ASSERT_EQUAL(n, 1, "Chained mbuf not rejected");
+	TEST_ASSERT_EQUAL(rte_errno, ENOTSUP, "Wrong errno for chained mbuf");
+	TEST_ASSERT_EQUAL(*ring->prod_h, 1, "Doorbell not rung for the first mbuf");
+
+	rte_errno = 0;
+	n = rte_gpu_comm_enqueue_burst(ring, &burst[1], 2);
+	TEST_ASSERT(n == 0 && rte_errno == ENOTSUP,
+		    "Chained mbuf not rejected at burst start");
+	TEST_ASSERT_EQUAL(*ring->prod_h, 1, "Doorbell rung for no mbuf");
+
+	TEST_ASSERT_SUCCESS(rte_gpu_comm_destroy_ring(ring),
+			    "Cannot destroy ring");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_gpudev_comm_ring_dequeue(void)
+{
+	struct rte_gpu_comm_ring *ring;
+	struct rte_mbuf *out[RING_SIZE];
+	enum rte_gpu_comm_list_status status[RING_SIZE];
+	uint32_t n, i;
+
+	ring = rte_gpu_comm_create_ring(gpu_id, RING_SIZE);
+	TEST_ASSERT_NOT_NULL(ring, "Cannot create ring");
+
+	n = rte_gpu_comm_dequeue_burst(ring, out, status, RING_SIZE);
+	TEST_ASSERT_EQUAL(n, 0, "Dequeue from empty ring");
+
+	n = rte_gpu_comm_enqueue_burst(ring, pkt_list, 4);
+	TEST_ASSERT_EQUAL(n, 4, "Cannot enqueue");
+
+	/* Nothing is returned before the device advances the consumer. */
+	n = rte_gpu_comm_dequeue_burst(ring, out, status, RING_SIZE);
+	TEST_ASSERT_EQUAL(n, 0, "Dequeue before device completion");
+
+	simulate_device(ring, 1, RTE_GPU_COMM_LIST_DONE);
+	simulate_device(ring, 1, RTE_GPU_COMM_LIST_ERROR);
+	simulate_device(ring, 1, RTE_GPU_COMM_LIST_DONE);
+
+	/* Completed entries are returned in order, with their status. */
+	n = rte_gpu_comm_dequeue_burst(ring, out, status, 1);
+	TEST_ASSERT_EQUAL(n, 1, "Dequeue not limited to requested number");
+	TEST_ASSERT(out[0] == pkt_list[0] &&
+		    status[0] == RTE_GPU_COMM_LIST_DONE,
+		    "Wrong first completion");
+
+	n = rte_gpu_comm_dequeue_burst(ring, out, status, RING_SIZE);
+	TEST_ASSERT_EQUAL(n, 2, "Dequeue not limited to completed entries");
+	TEST_ASSERT(out[0] == pkt_list[1] &&
+		    status[0] == RTE_GPU_COMM_LIST_ERROR,
+		    "Wrong completion with error");
+	TEST_ASSERT(out[1] == pkt_list[2] &&
+		    status[1] == RTE_GPU_COMM_LIST_DONE,
+		    "Wrong third completion");
+
+	/* Status is optional. */
+	simulate_device(ring, 1, RTE_GPU_COMM_LIST_DONE);
+	n = rte_gpu_comm_dequeue_burst(ring, out, NULL, RING_SIZE);
+	TEST_ASSERT(n == 1 && out[0] == pkt_list[3],
+		    "Wrong completion without status");
+
+	n = rte_gpu_comm_dequeue_burst(ring, out, status, RING_SIZE);
+	TEST_ASSERT_EQUAL(n, 0, "Dequeue from drained ring");
+
+	/* Entries keep their order across the ring wrap. */
+	for (i = 0; i < RING_SIZE; i++) {
+		n = rte_gpu_comm_enqueue_burst(ring, &pkt_list[i], 1);
+		TEST_ASSERT_EQUAL(n, 1, "Cannot enqueue mbuf %u", i);
+	}
+	simulate_device(ring, RING_SIZE, RTE_GPU_COMM_LIST_DONE);
+	n = rte_gpu_comm_dequeue_burst(ring, out, status, RING_SIZE);
+	TEST_ASSERT_EQUAL(n, RING_SIZE, "Cannot dequeue full ring");
+	for (i = 0; i < RING_SIZE; i++)
+		TEST_ASSERT(out[i] == pkt_list[i], "Wrong order at %u", i);
+
+	TEST_ASSERT_SUCCESS(rte_gpu_comm_destroy_ring(ring),
+			    "Cannot destroy ring");
+
+	return TEST_SUCCESS;
+}
+
+static struct unit_test_suite gpudev_comm_ring_testsuite = {
+	.suite_name = "gpudev communication ring autotest",
+	.setup = test_gpudev_comm_ring_setup,
+	.teardown = test_gpudev_comm_ring_teardown,
+	.unit_test_cases = {
+		TEST_CASE_ST(test_gpudev_comm_ring_case_setup, NULL,
+			     test_gpudev_comm_ring_create),
+		TEST_CASE_ST(test_gpudev_comm_ring_case_setup, NULL,
+			     test_gpudev_comm_ring_enqueue),
+		TEST_CASE_ST(test_gpudev_comm_ring_case_setup, NULL,
+			     test_gpudev_comm_ring_chained),
+		TEST_CASE_ST(test_gpudev_comm_ring_case_setup, NULL,
+			     test_gpudev_comm_ring_dequeue),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_gpudev_comm_ring(void)
+{
+	return unit_test_suite_runner(&gpudev_comm_ring_testsuite);
+}
+
+REGISTER_FAST_TEST(gpudev_comm_ring_autotest, NOHUGE_OK, ASAN_OK, test_gpudev_comm_ring);
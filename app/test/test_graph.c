@@ -933,6 +933,111 @@ test_graph_worker_model_set_get(void)
 	return ret;
 }
 
+static int
+test_graph_model_work_steal(void)
+{
+	rte_graph_t busy_graph_id = RTE_GRAPH_ID_INVALID;
+	rte_graph_t idle_graph_id = RTE_GRAPH_ID_INVALID;
+	struct rte_graph_param graph_conf = {0};
+	uint64_t offered = 0, stolen = 0;
+	struct rte_graph *busy, *idle;
+	struct rte_node *node;
+	unsigned int i;
+	int ret;
+
+	ret = rte_graph_worker_model_set(RTE_GRAPH_MODEL_WORK_STEAL);
+	if (ret != 0) {
+		printf("Set graph work-stealing model failed\n");
+		return ret;
+	}
+
+	graph_conf.steal.min_objs = 1;
+	busy_graph_id = rte_graph_clone(graph_id, "cloned-test4", &graph_conf);
+	idle_graph_id = rte_graph_clone(graph_id, "cloned-test5", &graph_conf);
+	busy = rte_graph_lookup("worker0-cloned-test4");
+	idle = rte_graph_lookup("worker0-cloned-test5");
+	if (busy == NULL || idle == NULL) {
+		printf("Clone graphs for work-stealing model failed\n");
+		ret = -1;
+		goto fail;
+	}
+
+	/* The source node always feeds both graphs, so mark one idle by hand */
+	__rte_graph_work_steal_idle_update(idle, false);
+
+	rte_graph_walk(busy);
+	rte_graph_walk(idle);
+
+	for (i = 0; i < RTE_DIM(node_names); i++) {
+		node = rte_graph_node_get_by_name(busy->name, node_names[i]);
+		if (node != NULL)
+			offered += node->steal.total_offered_objs;
+		node = rte_graph_node_get_by_name(idle->name, node_names[i]);
+		if (node != NULL)
+			stolen += node->steal.total_stolen_objs;
+	}
+
+	if (offered == 0 || stolen != offered) {
+		printf("Work-stealing failed, offered %" PRIu64 " stolen %" PRIu64 "\n",
+		       offered, stolen);
+		ret = -1;
+	}
+
+fail:
+	rte_graph_destroy(busy_graph_id);
+	rte_graph_destroy(idle_graph_id);
+
+	return ret;
+}
+
+static int
+test_node_batch(void)
+{
+	rte_graph_t cloned_graph_id = RTE_GRAPH_ID_INVALID;
+	struct rte_graph_param graph_conf = {0};
+	struct rte_graph *graph;
+	struct rte_node *node;
+	rte_node_t id;
+	int ret = -1;
+	int i;
+
+	id = rte_node_from_name("test_node00");
+	if (rte_node_batch_set(RTE_NODE_ID_INVALID, 8, 0) == 0 ||
+	    rte_node_batch_set(id, RTE_GRAPH_BURST_SIZE + 1, 0) == 0) {
+		printf("Node batch set with invalid parameters succeeded\n");
+		return -1;
+	}
+
+	/* The source never sends a full burst to test_node00 */
+	if (rte_node_batch_set(id, RTE_GRAPH_BURST_SIZE, US_PER_S) != 0) {
+		printf("Node batch set failed\n");
+		return -1;
+	}
+
+	cloned_graph_id = rte_graph_clone(graph_id, "cloned-test6", &graph_conf);
+	graph = rte_graph_lookup("worker0-cloned-test6");
+	if (graph == NULL) {
+		printf("Clone graph with node batch failed\n");
+		goto fail;
+	}
+
+	for (i = 0; i < 3; i++)
+		rte_graph_walk(graph);
+
+	node = rte_graph_node_get_by_name(graph->name, "test_node00");
+	if (node == NULL || node->batch.total_deferred == 0) {
+		printf("Node stream was not deferred\n");
+		goto fail;
+	}
+	ret = 0;
+
+fail:
+	rte_graph_destroy(cloned_graph_id);
+	rte_node_batch_set(id, 0, 0);
+
+	return ret;
+}
+
 static int
 test_graph_walk(void)
 {
@@ -1062,6 +1167,115 @@ test_print_stats(void)
 	return 0;
 }
 
+static int
+graph_cluster_stats_hist_cb(bool is_first, bool is_last, void *cookie,
+			    const struct rte_graph_cluster_node_stats *st)
+{
+	uint64_t *calls = cookie;
+	unsigned int i;
+
+	RTE_SET_USED(is_first);
+	RTE_SET_USED(is_last);
+
+	if (st->id != rte_node_from_name("test_node00"))
+		return 0;
+
+	for (i = 0; i < RTE_GRAPH_HIST_CYCLES_BUCKETS; i++)
+		*calls += st->cycles_hist[i];
+	return 0;
+}
+
+static uint64_t
+node_hist_calls(const struct rte_node *node, unsigned int start, unsigned int nb_buckets)
+{
+	const uint64_t *hist = RTE_PTR_ADD(node, node->hist_off);
+	uint64_t calls = 0;
+	unsigned int i;
+
+	for (i = start; i < start + nb_buckets; i++)
+		calls += hist[i];
+	return calls;
+}
+
+static int
+test_graph_hist(void)
+{
+	struct rte_graph_cluster_stats_param s_param;
+	struct rte_graph_cluster_stats *stats;
+	const char *pattern = "worker0";
+	uint64_t calls, hist_calls = 0;
+	struct rte_graph *graph;
+	struct rte_node *node;
+	int i;
+
+	if (!rte_graph_has_stats_feature()) {
+		if (rte_graph_hist_enable(graph_id, true) != -ENOTSUP) {
+			printf("Histograms enabled without stats feature\n");
+			return -1;
+		}
+		return 0;
+	}
+
+	if (rte_graph_hist_enable(RTE_GRAPH_ID_INVALID, true) == 0) {
+		printf("Histograms enabled on invalid graph\n");
+		return -1;
+	}
+
+	graph = rte_graph_lookup("worker0");
+	node = rte_graph_node_get_by_name("worker0", "test_node00");
+	if (graph == NULL || node == NULL || node->hist_off == 0) {
+		printf("Graph has no node histograms\n");
+		return -1;
+	}
+
+	calls = node->total_calls - node_hist_calls(node, 0, RTE_GRAPH_HIST_CYCLES_BUCKETS);
+	if (rte_graph_hist_enable(graph_id, true) != 0) {
+		printf("Histograms enable failed\n");
+		return -1;
+	}
+	for (i = 0; i < 5; i++)
+		rte_graph_walk(graph);
+	rte_graph_hist_enable(graph_id, false);
+	calls = node->total_calls - calls;
+
+	if (calls == 0 ||
+	    node_hist_calls(node, 0, RTE_GRAPH_HIST_CYCLES_BUCKETS) != calls ||
+	    node_hist_calls(node, RTE_GRAPH_HIST_CYCLES_BUCKETS,
+			    RTE_GRAPH_HIST_OBJS_BUCKETS) != calls) {
+		printf("Histograms do not count all the node calls\n");
+		return -1;
+	}
+
+	rte_graph_walk(graph);
+	if (node_hist_calls(node, 0, RTE_GRAPH_HIST_CYCLES_BUCKETS) != calls) {
+		printf("Histograms updated while disabled\n");
+		return -1;
+	}
+
+	memset(&s_param, 0, sizeof(s_param));
+	s_param.socket_id = SOCKET_ID_ANY;
+	s_param.graph_patterns = &pattern;
+	s_param.nb_graph_patterns = 1;
+	s_param.fn = graph_cluster_stats_hist_cb;
+	s_param.cookie = &hist_calls;
+
+	stats = rte_graph_cluster_stats_create(&s_param);
+	if (stats == NULL) {
+		printf("Unable to get stats\n");
+		return -1;
+	}
+	rte_graph_cluster_stats_get(stats, 0);
+	rte_graph_cluster_stats_destroy(stats);
+
+	if (hist_calls != calls) {
+		printf("Cluster histograms mismatch, expected = %"PRIu64", got = %"PRIu64"\n",
+		       calls, hist_calls);
+		return -1;
+	}
+
+	return 0;
+}
+
 static int
 graph_setup(void)
 {
@@ -1137,8 +1351,11 @@ static struct unit_test_suite graph_testsuite = {
 		TEST_CASE(test_graph_model_mcore_dispatch_node_lcore_affinity_set),
 		TEST_CASE(test_graph_model_mcore_dispatch_core_bind_unbind),
 		TEST_CASE(test_graph_worker_model_set_get),
+		TEST_CASE(test_graph_model_work_steal),
+		TEST_CASE(test_node_batch),
 		TEST_CASE(test_graph_lookup_functions),
 		TEST_CASE(test_graph_walk),
+		TEST_CASE(test_graph_hist),
 		TEST_CASE(test_print_stats),
 		TEST_CASES_END(), /**< NULL terminate unit test array */
 	},
@@ -2342,6 +2342,232 @@ test_hash_rcu_qsbr_dq_reclaim(void)
 	return 0;
 }
 
+/*
+ * Resizable hash table test: add many more keys than the initial size,
+ * so that the table is doubled several times, and check that all the keys
+ * are found during and after the migrations.
+ */
+#define RESIZE_INIT_ENTRIES 64
+#define RESIZE_NUM_KEYS 1024
+static int
+test_hash_resizable(void)
+{
+	struct rte_hash *handle;
+	const void *key_ptrs[RTE_HASH_LOOKUP_BULK_MAX];
+	void *data[RTE_HASH_LOOKUP_BULK_MAX];
+	int32_t positions[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t keys[RESIZE_NUM_KEYS];
+	const void *next_key;
+	void *next_data, *key_at_pos;
+	uint64_t hit_mask;
+	uint32_t iter = 0;
+	unsigned int i, j, count;
+	int ret;
+	struct rte_hash_parameters params = {
+		.name = "test_hash_resizable",
+		.entries = RESIZE_INIT_ENTRIES,
+		.key_len = sizeof(uint32_t),
+		.hash_func = rte_jhash,
+		.hash_func_init_val = 0,
+		.socket_id = 0,
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_RESIZABLE,
+	};
+
+	printf("\n# Running resizable hash table test\n");
+
+	/* resizing is not supported with concurrent writers */
+	params.extra_flag |= RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD;
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle != NULL,
+		"resizable hash created with multi-writer add");
+	params.extra_flag = RTE_HASH_EXTRA_FLAGS_RESIZABLE;
+
+	handle = rte_hash_create(&params);
+	RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+
+	for (i = 0; i < RESIZE_NUM_KEYS; i++) {
+		keys[i] = i;
+		ret = rte_hash_add_key_data(handle, &keys[i],
+			(void *)((uintptr_t)i + 1));
+		RETURN_IF_ERROR(ret < 0, "failed to add key %u (%d)", i, ret);
+		/* an earlier key, possibly left in the old table */
+		j = i / 2;
+		ret = rte_hash_lookup_data(handle, &keys[j], &next_data);
+		RETURN_IF_ERROR(ret < 0 || (uintptr_t)next_data != j + 1,
+			"key %u not found after adding key %u", j, i);
+		/* its position must resolve in the table it was found in */
+		ret = rte_hash_get_key_with_position(handle, ret, &key_at_pos);
+		RETURN_IF_ERROR(ret < 0 || *(uint32_t *)key_at_pos != keys[j],
+			"wrong key at the position of key %u (%d)", j, ret);
+	}
+	RETURN_IF_ERROR(rte_hash_count(handle) != RESIZE_NUM_KEYS,
+		"wrong count %d", rte_hash_count(handle));
+
+	for (i = 0; i < RESIZE_NUM_KEYS; i += RTE_HASH_LOOKUP_BULK_MAX) {
+		for (j = 0; j < RTE_HASH_LOOKUP_BULK_MAX; j++)
+			key_ptrs[j] = &keys[i + j];
+		ret = rte_hash_lookup_bulk_data(handle, key_ptrs,
+			RTE_HASH_LOOKUP_BULK_MAX, &hit_mask, data);
+		RETURN_IF_ERROR(ret != RTE_HASH_LOOKUP_BULK_MAX,
+			"bulk lookup found %d keys", ret);
+		for (j = 0; j < RTE_HASH_LOOKUP_BULK_MAX; j++)
+			RETURN_IF_ERROR((uintptr_t)data[j] != i + j + 1,
+				"wrong data for key %u", i + j);
+		ret = rte_hash_lookup_bulk(handle, key_ptrs,
+			RTE_HASH_LOOKUP_BULK_MAX, positions);
+		RETURN_IF_ERROR(ret != 0, "bulk lookup failed (%d)", ret);
+		for (j = 0; j < RTE_HASH_LOOKUP_BULK_MAX; j++) {
+			ret = rte_hash_get_key_with_position(handle,
+				positions[j], &key_at_pos);
+			RETURN_IF_ERROR(ret < 0 ||
+				*(uint32_t *)key_at_pos != keys[i + j],
+				"wrong key at the bulk position of key %u",
+				i + j);
+		}
+	}
+
+	/* delete every other key */
+	for (i = 0; i < RESIZE_NUM_KEYS; i += 2) {
+		ret = rte_hash_del_key(handle, &keys[i]);
+		RETURN_IF_ERROR(ret < 0, "failed to delete key %u (%d)", i, ret);
+	}
+	RETURN_IF_ERROR(rte_hash_count(handle) != RESIZE_NUM_KEYS / 2,
+		"wrong count %d after delete", rte_hash_count(handle));
+
+	for (i = 0; i < RESIZE_NUM_KEYS; i++) {
+		ret = rte_hash_lookup(handle, &keys[i]);
+		RETURN_IF_ERROR((i % 2 == 0) != (ret < 0),
+			"wrong lookup result %d for key %u", ret, i);
+	}
+
+	count = 0;
+	while ((ret = rte_hash_iterate(handle, &next_key, &next_data, &iter)) >= 0) {
+		RETURN_IF_ERROR(*(const uint32_t *)next_key % 2 == 0,
+			"deleted key %u iterated",
+			*(const uint32_t *)next_key);
+		ret = rte_hash_get_key_with_position(handle, ret, &key_at_pos);
+		RETURN_IF_ERROR(ret < 0 || key_at_pos != next_key,
+			"wrong key at the iterated position (%d)", ret);
+		count++;
+	}
+	RETURN_IF_ERROR(count != RESIZE_NUM_KEYS / 2,
+		"iterated %u keys", count);
+
+	rte_hash_reset(handle);
+	RETURN_IF_ERROR(rte_hash_count(handle) != 0,
+		"hash not empty after reset");
+
+	rte_hash_free(handle);
+
+	return 0;
+}
+
+#define BULK_KEY_MAX_LEN 128
+#define BULK_NUM_KEYS 48
+
+static unsigned int bulk_custom_cmp_calls;
+
+static int
+bulk_custom_cmp(const void *key1, const void *key2, size_t key_len)
+{
+	bulk_custom_cmp_calls++;
+	return memcmp(key1, key2, key_len);
+}
+
+/*
+ * Check the bulk lookups specialized by key size against the keys added,
+ * with missing keys differing from added ones in their last byte only.
+ */
+static int
+test_hash_bulk_key_sizes(void)
+{
+	static const uint32_t key_lens[] = {
+		16, 20, 32, 48, 64, 80, 96, 112, 128
+	};
+	static const uint32_t flags[] = {
+		0, RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF
+	};
+	static uint8_t bulk_keys[RTE_HASH_LOOKUP_BULK_MAX][BULK_KEY_MAX_LEN];
+	const void *key_ptrs[RTE_HASH_LOOKUP_BULK_MAX];
+	int32_t add_pos[BULK_NUM_KEYS];
+	int32_t positions[RTE_HASH_LOOKUP_BULK_MAX];
+	void *data[RTE_HASH_LOOKUP_BULK_MAX];
+	struct rte_hash *handle = NULL;
+	uint32_t key_len, extra_flag, id;
+	unsigned int i, t, custom;
+	uint64_t hit_mask;
+	int ret;
+	struct rte_hash_parameters params = {
+		.name = "test_hash_bulk_key_sizes",
+		.entries = 1024,
+		.hash_func = rte_jhash,
+		.hash_func_init_val = 0,
+		.socket_id = 0,
+	};
+
+	printf("\n# Running bulk lookup by key size test\n");
+
+	for (i = 0; i < RTE_HASH_LOOKUP_BULK_MAX; i++)
+		key_ptrs[i] = bulk_keys[i];
+
+	for (t = 0; t < RTE_DIM(key_lens) * RTE_DIM(flags) * 2; t++) {
+		key_len = key_lens[t / (RTE_DIM(flags) * 2)];
+		extra_flag = flags[(t / 2) % RTE_DIM(flags)];
+		custom = t % 2;
+
+		for (i = 0; i < RTE_HASH_LOOKUP_BULK_MAX; i++) {
+			id = i < BULK_NUM_KEYS ? i : i - BULK_NUM_KEYS;
+			memset(bulk_keys[i], 0x5a, key_len);
+			memcpy(bulk_keys[i], &id, sizeof(id));
+			/* the missing keys only differ in their last byte */
+			bulk_keys[i][key_len - 1] = i < BULK_NUM_KEYS ? 0 : 1;
+		}
+
+		params.key_len = key_len;
+		params.extra_flag = extra_flag;
+		handle = rte_hash_create(&params);
+		RETURN_IF_ERROR(handle == NULL, "hash creation failed");
+		if (custom)
+			rte_hash_set_cmp_func(handle, bulk_custom_cmp);
+
+		for (i = 0; i < BULK_NUM_KEYS; i++) {
+			ret = rte_hash_add_key_data(handle, bulk_keys[i],
+				(void *)((uintptr_t)i + 1));
+			RETURN_IF_ERROR(ret != 0,
+				"failed to add key %u of %u bytes", i, key_len);
+			add_pos[i] = rte_hash_lookup(handle, bulk_keys[i]);
+			RETURN_IF_ERROR(add_pos[i] < 0,
+				"key %u of %u bytes not found", i, key_len);
+		}
+
+		bulk_custom_cmp_calls = 0;
+		ret = rte_hash_lookup_bulk(handle, key_ptrs,
+			RTE_HASH_LOOKUP_BULK_MAX, positions);
+		RETURN_IF_ERROR(ret != 0, "bulk lookup failed (%d)", ret);
+		for (i = 0; i < RTE_HASH_LOOKUP_BULK_MAX; i++)
+			RETURN_IF_ERROR(positions[i] != (i < BULK_NUM_KEYS ?
+					add_pos[i] : -ENOENT),
+				"wrong position %d of key %u of %u bytes, flags %#x",
+				positions[i], i, key_len, extra_flag);
+		RETURN_IF_ERROR(custom && bulk_custom_cmp_calls < BULK_NUM_KEYS,
+			"custom compare function not used");
+
+		ret = rte_hash_lookup_bulk_data(handle, key_ptrs,
+			RTE_HASH_LOOKUP_BULK_MAX, &hit_mask, data);
+		RETURN_IF_ERROR(ret != BULK_NUM_KEYS ||
+			hit_mask != RTE_LEN2MASK(BULK_NUM_KEYS, uint64_t),
+			"bulk lookup of %u bytes keys found %d keys", key_len, ret);
+		for (i = 0; i < BULK_NUM_KEYS; i++)
+			RETURN_IF_ERROR((uintptr_t)data[i] != i + 1,
+				"wrong data for key %u of %u bytes", i, key_len);
+
+		rte_hash_free(handle);
+		handle = NULL;
+	}
+
+	return 0;
+}
+
 /*
  * Do all unit and performance tests.
  */
@@ -2423,6 +2649,12 @@ test_hash(void)
 	if (test_hash_rcu_qsbr_dq_reclaim() < 0)
 		return -1;
 
+	if (test_hash_resizable() < 0)
+		return -1;
+
+	if (test_hash_bulk_key_sizes() < 0)
+		return -1;
+
 	return 0;
 }
 
@@ -260,6 +260,45 @@ verify_jhash_words(void)
 	return 0;
 }
 
+/*
+ * Verify that rte_hash_crc_bulk and rte_hash_crc return the same,
+ * for any number of keys
+ */
+static int
+verify_crc_bulk(void)
+{
+	unsigned int i, j, num;
+	uint8_t keys[RTE_HASH_CRC_STREAMS * 2 + 1][MAX_KEYSIZE + 1];
+	const void *key_ptrs[RTE_DIM(keys)];
+	uint32_t hash[RTE_DIM(keys)];
+
+	for (i = 0; i < RTE_DIM(keys); i++) {
+		for (j = 0; j < sizeof(keys[i]); j++)
+			keys[i][j] = rand() & 0xff;
+		/* Unaligned keys */
+		key_ptrs[i] = &keys[i][i & 0x1];
+	}
+
+	for (i = 0; i < RTE_DIM(hashtest_key_lens); i++) {
+		for (num = 0; num <= RTE_DIM(keys); num++) {
+			rte_hash_crc_bulk(key_ptrs, hashtest_key_lens[i],
+					hashtest_initvals[1], hash, num);
+			for (j = 0; j < num; j++) {
+				if (hash[j] != rte_hash_crc(key_ptrs[j],
+						hashtest_key_lens[i],
+						hashtest_initvals[1])) {
+					printf("rte_hash_crc_bulk returns different value (0x%x)"
+					       "than rte_hash_crc for key %u of %u, length %u\n",
+					       hash[j], j, num, hashtest_key_lens[i]);
+					return -1;
+				}
+			}
+		}
+	}
+
+	return 0;
+}
+
 /*
  * Run all functional tests for hash functions
  */
@@ -275,6 +314,9 @@ run_hash_func_tests(void)
 	if (verify_jhash_words() != 0)
 		return -1;
 
+	if (verify_crc_bulk() != 0)
+		return -1;
+
 	return 0;
 
 }
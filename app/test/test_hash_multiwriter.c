@@ -49,6 +49,7 @@ static RTE_ATOMIC(uint64_t) gcycles;
 static RTE_ATOMIC(uint64_t) ginsertions;
 
 static int use_htm;
+static int use_lf;
 
 static int
 test_hash_multiwriter_worker(void *arg)
@@ -121,7 +122,11 @@ test_hash_multiwriter(void)
 		.hash_func_init_val = 0,
 		.socket_id = rte_socket_id(),
 	};
-	if (use_htm)
+	if (use_lf)
+		hash_params.extra_flag =
+			RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD_LF
+				| RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF;
+	else if (use_htm)
 		hash_params.extra_flag =
 			RTE_HASH_EXTRA_FLAGS_TRANS_MEM_SUPPORT
 				| RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD;
@@ -290,6 +295,12 @@ test_hash_multiwriter_main(void)
 	if (test_hash_multiwriter() < 0)
 		return -1;
 
+	printf("Test lock free multi-writer add\n");
+	use_lf = 1;
+	if (test_hash_multiwriter() < 0)
+		return -1;
+	use_lf = 0;
+
 	return 0;
 }
 
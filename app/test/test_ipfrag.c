@@ -13,6 +13,7 @@
 #include <rte_ip_frag.h>
 #include <rte_mbuf.h>
 #include <rte_random.h>
+#include <rte_ring.h>
 
 #define NUM_MBUFS 128
 #define BURST 32
@@ -483,6 +484,77 @@ test_ip_frag(void)
 	return result;
 }
 
+static int
+test_ip_frag_steer_reassemble(void)
+{
+	struct rte_mbuf *pkts[BURST], *frags[BURST];
+	struct rte_ip_frag_death_row dr = { .cnt = 0 };
+	struct rte_ring *rings[2] = { NULL, NULL };
+	struct rte_ip_frag_tbl *tbl;
+	struct rte_mbuf *b;
+	int32_t nb_frags, i;
+	uint16_t nb_local, nb_pkts;
+	int result = TEST_FAILED;
+
+	tbl = rte_ip_frag_table_create(16, 4, 64, rte_get_tsc_hz(),
+			SOCKET_ID_ANY);
+	rings[1] = rte_ring_create("test_ipfrag_steer", BURST, SOCKET_ID_ANY,
+			RING_F_SC_DEQ);
+	b = rte_pktmbuf_alloc(pkt_pool);
+	if (tbl == NULL || rings[1] == NULL || b == NULL) {
+		printf("%s: failed to allocate resources\n", __func__);
+		rte_pktmbuf_free(b);
+		goto out;
+	}
+
+	v4_allocate_packet_of(b, 0x41414141, 1000, 0, 0, 0, 0, 0,
+			rte_rand_max(UINT16_MAX), false, false, false);
+	nb_frags = rte_ipv4_fragment_packet(b, frags, BURST, 400,
+			direct_pool, indirect_pool);
+	rte_pktmbuf_free(b);
+	if (nb_frags < 2) {
+		printf("%s: failed to fragment, %d\n", __func__, nb_frags);
+		test_free_fragments(frags, RTE_MAX(nb_frags, 0));
+		goto out;
+	}
+
+	/* All the fragments are steered to the same owner */
+	for (i = 0; i != nb_frags; i++)
+		pkts[i] = frags[nb_frags - 1 - i];
+	nb_local = rte_ip_frag_steer_bulk(rings, 2, 0, pkts, nb_frags);
+	if (nb_local != 0 && nb_local != nb_frags) {
+		printf("%s: fragments spread, %u local of %d\n", __func__,
+			nb_local, nb_frags);
+		test_free_fragments(pkts, nb_local);
+		rte_ring_dequeue_burst(rings[1], (void **)pkts, BURST, NULL);
+		test_free_fragments(pkts, nb_frags - nb_local);
+		goto out;
+	}
+	if (nb_local == 0)
+		nb_local = rte_ring_dequeue_burst(rings[1], (void **)pkts,
+				BURST, NULL);
+
+	/* The owner reassembles the datagram out of order */
+	nb_pkts = rte_ip_frag_reassemble_bulk(tbl, &dr, pkts, nb_local,
+			rte_rdtsc());
+	rte_ip_frag_free_death_row(&dr, 0);
+	if (nb_pkts != 1 || pkts[0]->pkt_len != 1000 +
+			sizeof(struct rte_ipv4_hdr)) {
+		printf("%s: reassembly failed, %u packets\n", __func__,
+			nb_pkts);
+		test_free_fragments(pkts, nb_pkts);
+		goto out;
+	}
+	rte_pktmbuf_free(pkts[0]);
+
+	result = TEST_SUCCESS;
+out:
+	rte_ring_free(rings[1]);
+	if (tbl != NULL)
+		rte_ip_frag_table_destroy(tbl);
+	return result;
+}
+
 static struct unit_test_suite ipfrag_testsuite  = {
 	.suite_name = "IP Frag Unit Test Suite",
 	.setup = testsuite_setup,
@@ -490,6 +562,8 @@ static struct unit_test_suite ipfrag_testsuite  = {
 	.unit_test_cases = {
 		TEST_CASE_ST(ut_setup, ut_teardown,
 			     test_ip_frag),
+		TEST_CASE_ST(ut_setup, ut_teardown,
+			     test_ip_frag_steer_reassemble),
 
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
@@ -43,6 +43,7 @@ test_ipsec(void)
 #define REPLAY_WIN_64	64
 #define REPLAY_WIN_128	128
 #define REPLAY_WIN_256	256
+#define REPLAY_WIN_4096	4096
 #define DATA_64_BYTES	64
 #define DATA_80_BYTES	80
 #define DATA_100_BYTES	100
@@ -117,6 +118,10 @@ static const struct ipsec_test_cfg test_cfg[] = {
 	{REPLAY_WIN_128, ESN_ENABLED, RTE_IPSEC_SAFLAG_SQN_ATOM,
 		DATA_80_BYTES, 1, 0},
 	{REPLAY_WIN_256, ESN_DISABLED, 0, DATA_100_BYTES, 1, 0},
+	{REPLAY_WIN_4096, ESN_ENABLED, RTE_IPSEC_SAFLAG_SQN_MW,
+		DATA_64_BYTES, 1, 0},
+	{REPLAY_WIN_4096, ESN_DISABLED, RTE_IPSEC_SAFLAG_SQN_MW,
+		DATA_80_BYTES, BURST_SIZE, REORDER_PKTS},
 };
 
 static const int num_cfg = RTE_DIM(test_cfg);
@@ -942,6 +947,57 @@ crypto_ipsec_2sa(void)
 	return TEST_SUCCESS;
 }
 
+static int
+crypto_ipsec_2sa_multi(void)
+{
+	struct ipsec_testsuite_params *ts_params = &testsuite_params;
+	struct ipsec_unitest_params *ut_params = &unittest_params;
+	struct rte_ipsec_session *ss[BURST_SIZE];
+	struct rte_ipsec_group grp[BURST_SIZE];
+	uint32_t k, ng, i;
+
+	for (i = 0; i < BURST_SIZE; i++)
+		ss[i] = &ut_params->ss[i % 2];
+
+	/* call crypto prepare for the whole burst */
+	k = rte_ipsec_pkt_crypto_prepare_multi(ss, ut_params->ibuf,
+			ut_params->cop, BURST_SIZE);
+	if (k != BURST_SIZE) {
+		RTE_LOG(ERR, USER1,
+			"rte_ipsec_pkt_crypto_prepare_multi fail\n");
+		return TEST_FAILED;
+	}
+	k = rte_cryptodev_enqueue_burst(ts_params->valid_dev, 0,
+			ut_params->cop, BURST_SIZE);
+	if (k != BURST_SIZE) {
+		RTE_LOG(ERR, USER1, "rte_cryptodev_enqueue_burst fail\n");
+		return TEST_FAILED;
+	}
+
+	if (crypto_dequeue_burst(BURST_SIZE) == TEST_FAILED)
+		return TEST_FAILED;
+
+	/* packets are prepared grouped by SA */
+	ng = rte_ipsec_pkt_crypto_group(
+		(const struct rte_crypto_op **)(uintptr_t)ut_params->cop,
+		ut_params->obuf, grp, BURST_SIZE);
+	if (ng != 2) {
+		RTE_LOG(ERR, USER1, "rte_ipsec_pkt_crypto_group fail ng=%d\n",
+			ng);
+		return TEST_FAILED;
+	}
+
+	/* call crypto process */
+	for (i = 0; i < ng; i++) {
+		k = rte_ipsec_pkt_process(grp[i].id.ptr, grp[i].m, grp[i].cnt);
+		if (k != grp[i].cnt) {
+			dump_grp_pkt(i, grp, k);
+			return TEST_FAILED;
+		}
+	}
+	return TEST_SUCCESS;
+}
+
 #define PKT_4	4
 #define PKT_12	12
 #define PKT_21	21
@@ -2398,7 +2454,7 @@ crypto_inb_burst_2sa_null_null_check(struct ipsec_unitest_params *ut_params,
 }
 
 static int
-test_ipsec_crypto_inb_burst_2sa_null_null(int i)
+test_ipsec_crypto_inb_burst_2sa_null_null(int i, bool multi)
 {
 	struct ipsec_testsuite_params *ts_params = &testsuite_params;
 	struct ipsec_unitest_params *ut_params = &unittest_params;
@@ -2443,7 +2499,7 @@ test_ipsec_crypto_inb_burst_2sa_null_null(int i)
 
 	if (rc == 0) {
 		/* call ipsec library api */
-		rc = crypto_ipsec_2sa();
+		rc = multi ? crypto_ipsec_2sa_multi() : crypto_ipsec_2sa();
 		if (rc == 0)
 			rc = crypto_inb_burst_2sa_null_null_check(
 					ut_params, i);
@@ -2477,7 +2533,28 @@ test_ipsec_crypto_inb_burst_2sa_null_null_wrapper(void)
 
 	for (i = 0; i < num_cfg && rc == 0; i++) {
 		ut_params->ipsec_xform.options.esn = test_cfg[i].esn;
-		rc = test_ipsec_crypto_inb_burst_2sa_null_null(i);
+		rc = test_ipsec_crypto_inb_burst_2sa_null_null(i, false);
+	}
+
+	return rc;
+}
+
+static int
+test_ipsec_crypto_inb_burst_2sa_multi_null_null_wrapper(void)
+{
+	int i;
+	int rc = 0;
+	struct ipsec_unitest_params *ut_params = &unittest_params;
+
+	ut_params->ipsec_xform.spi = INBOUND_SPI;
+	ut_params->ipsec_xform.direction = RTE_SECURITY_IPSEC_SA_DIR_INGRESS;
+	ut_params->ipsec_xform.proto = RTE_SECURITY_IPSEC_SA_PROTO_ESP;
+	ut_params->ipsec_xform.mode = RTE_SECURITY_IPSEC_SA_MODE_TUNNEL;
+	ut_params->ipsec_xform.tunnel.type = RTE_SECURITY_IPSEC_TUNNEL_IPV4;
+
+	for (i = 0; i < num_cfg && rc == 0; i++) {
+		ut_params->ipsec_xform.options.esn = test_cfg[i].esn;
+		rc = test_ipsec_crypto_inb_burst_2sa_null_null(i, true);
 	}
 
 	return rc;
@@ -2605,6 +2682,8 @@ static struct unit_test_suite ipsec_testsuite  = {
 			test_ipsec_crypto_inb_burst_2sa_null_null_wrapper),
 		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
 			test_ipsec_crypto_inb_burst_2sa_4grp_null_null_wrapper),
+		TEST_CASE_ST(ut_setup_ipsec, ut_teardown_ipsec,
+			test_ipsec_crypto_inb_burst_2sa_multi_null_null_wrapper),
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
 };
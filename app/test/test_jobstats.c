@@ -0,0 +1,172 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_bitops.h>
+#include <rte_jobstats.h>
+
+#include "test.h"
+
+#define NB_EXEC 16
+#define MIN_PERIOD 100
+#define MAX_PERIOD 10000
+#define INITIAL_PERIOD 1000
+
+static struct rte_jobstats_context ctx;
+static struct rte_jobstats job;
+
+static int
+test_setup(void)
+{
+	TEST_ASSERT_SUCCESS(rte_jobstats_context_init(&ctx),
+			"Cannot init jobstats context");
+	TEST_ASSERT_SUCCESS(rte_jobstats_init(&job, "test_job", MIN_PERIOD,
+			MAX_PERIOD, INITIAL_PERIOD, 0), "Cannot init job");
+
+	return TEST_SUCCESS;
+}
+
+static void
+test_teardown(void)
+{
+	rte_jobstats_release(&job);
+}
+
+/* run the job once, returning whether its period was updated */
+static int
+job_exec(int64_t job_value)
+{
+	int ret;
+
+	ret = rte_jobstats_start(&ctx, &job);
+	if (ret != 0)
+		return ret;
+
+	return rte_jobstats_finish(&job, job_value);
+}
+
+static int
+test_hist(void)
+{
+	uint64_t counts[RTE_JOBSTATS_HIST_BUCKETS];
+	uint64_t total = 0;
+	unsigned int i;
+
+	TEST_ASSERT_EQUAL(rte_jobstats_hist_enable(NULL), -EINVAL,
+			"Enabled histogram of NULL job");
+	TEST_ASSERT_EQUAL(rte_jobstats_hist_get(NULL, counts, RTE_DIM(counts)),
+			-EINVAL, "Got histogram of NULL job");
+	TEST_ASSERT_EQUAL(rte_jobstats_hist_get(&job, NULL, RTE_DIM(counts)),
+			-EINVAL, "Got histogram in NULL array");
+	TEST_ASSERT_EQUAL(rte_jobstats_hist_get(&job, counts, RTE_DIM(counts)),
+			-ENOENT, "Got histogram before enabling it");
+
+	TEST_ASSERT_SUCCESS(rte_jobstats_hist_enable(&job),
+			"Cannot enable histogram");
+	for (i = 0; i < NB_EXEC; i++)
+		TEST_ASSERT(job_exec(0) >= 0, "Cannot execute job");
+
+	/* each execution is counted once, the longest in its log2 bucket */
+	TEST_ASSERT_EQUAL(rte_jobstats_hist_get(&job, counts, RTE_DIM(counts)),
+			RTE_JOBSTATS_HIST_BUCKETS, "Cannot get histogram");
+	for (i = 0; i < RTE_DIM(counts); i++)
+		total += counts[i];
+	TEST_ASSERT_EQUAL(total, job.exec_cnt, "Histogram counts %"PRIu64
+			" executions out of %"PRIu64, total, job.exec_cnt);
+	i = job.max_exec_time == 0 ? 0 : rte_fls_u64(job.max_exec_time) - 1;
+	TEST_ASSERT(counts[i] != 0, "Longest execution not in bucket %u", i);
+
+	TEST_ASSERT_EQUAL(rte_jobstats_hist_get(&job, counts, 4), 4,
+			"Copied more buckets than requested");
+
+	/* cleared with the other statistics of the job */
+	rte_jobstats_reset(&job);
+	TEST_ASSERT_EQUAL(rte_jobstats_hist_get(&job, counts, RTE_DIM(counts)),
+			RTE_JOBSTATS_HIST_BUCKETS, "Cannot get histogram");
+	for (i = 0; i < RTE_DIM(counts); i++)
+		TEST_ASSERT_EQUAL(counts[i], 0, "Bucket %u not cleared", i);
+
+	rte_jobstats_release(&job);
+	TEST_ASSERT_NULL(job.ext, "Histogram not released");
+	TEST_ASSERT_EQUAL(rte_jobstats_hist_get(&job, counts, RTE_DIM(counts)),
+			-ENOENT, "Got histogram after release");
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_pid(void)
+{
+	struct rte_jobstats_pid_conf conf = {
+		.target = 10,
+		.kp = 1024,
+	};
+
+	TEST_ASSERT_EQUAL(rte_jobstats_pid_set(NULL, &conf), -EINVAL,
+			"Set controller of NULL job");
+	TEST_ASSERT_EQUAL(rte_jobstats_pid_set(&job, NULL), -EINVAL,
+			"Set NULL controller");
+
+	/* proportional: one cycle of period per unit of error */
+	TEST_ASSERT_SUCCESS(rte_jobstats_pid_set(&job, &conf),
+			"Cannot set controller");
+	TEST_ASSERT_EQUAL(job.target, conf.target, "Target not replaced");
+	TEST_ASSERT_EQUAL(job_exec(5), 1, "Period not updated");
+	TEST_ASSERT_EQUAL(job.period, INITIAL_PERIOD + 5,
+			"Wrong period %"PRIu64, job.period);
+	TEST_ASSERT_EQUAL(job_exec(conf.target), 0, "Period updated on target");
+	TEST_ASSERT_EQUAL(job.period, INITIAL_PERIOD + 5,
+			"Wrong period %"PRIu64, job.period);
+	TEST_ASSERT_EQUAL(job_exec(-MAX_PERIOD * 2), 1, "Period not updated");
+	TEST_ASSERT_EQUAL(job.period, MAX_PERIOD,
+			"Period %"PRIu64" not saturated", job.period);
+
+	/* integral: not accumulated while the period is saturated */
+	conf.kp = 0;
+	conf.ki = 1024;
+	TEST_ASSERT_SUCCESS(rte_jobstats_pid_set(&job, &conf),
+			"Cannot set controller");
+	rte_jobstats_set_period(&job, INITIAL_PERIOD, 0);
+	TEST_ASSERT_EQUAL(job_exec(5), 1, "Period not updated");
+	TEST_ASSERT_EQUAL(job.period, INITIAL_PERIOD + 5,
+			"Wrong period %"PRIu64, job.period);
+	TEST_ASSERT_EQUAL(job_exec(MAX_PERIOD * 2), 1, "Period not updated");
+	TEST_ASSERT_EQUAL(job.period, MIN_PERIOD,
+			"Period %"PRIu64" not saturated", job.period);
+	TEST_ASSERT_EQUAL(job_exec(5), 1, "Period not updated");
+	TEST_ASSERT_EQUAL(job.period, MIN_PERIOD + 10,
+			"Integral wound up, period %"PRIu64, job.period);
+
+	/* another update function removes the controller */
+	rte_jobstats_set_update_period_function(&job, NULL);
+	rte_jobstats_set_period(&job, INITIAL_PERIOD, 0);
+	TEST_ASSERT_EQUAL(job_exec(5), 1, "Period not updated");
+	TEST_ASSERT_EQUAL(job.period, INITIAL_PERIOD + 1,
+			"Default update not restored, period %"PRIu64, job.period);
+	rte_jobstats_release(&job);
+	TEST_ASSERT_NULL(job.ext, "Controller not released");
+
+	return TEST_SUCCESS;
+}
+
+static struct unit_test_suite jobstats_testsuite = {
+	.suite_name = "jobstats autotest",
+	.unit_test_cases = {
+		TEST_CASE_ST(test_setup, test_teardown, test_hist),
+		TEST_CASE_ST(test_setup, test_teardown, test_pid),
+		TEST_CASES_END()
+	},
+};
+
+static int
+test_jobstats(void)
+{
+	return unit_test_suite_runner(&jobstats_testsuite);
+}
+
+REGISTER_FAST_TEST(jobstats_autotest, NOHUGE_OK, ASAN_OK, test_jobstats);
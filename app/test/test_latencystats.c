@@ -6,6 +6,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <rte_eth_ring.h>
 #include <rte_ethdev.h>
 #include <rte_latencystats.h>
 #include "rte_lcore.h"
@@ -14,12 +15,16 @@
 #include "sample_packet_forward.h"
 #include "test.h"
 
-#define NUM_STATS 5
+#define NUM_STATS 8
 #define LATENCY_NUM_PACKETS 10
 #define QUEUE_ID 0
+#define MULTI_NUM_QUEUES 2
+#define MULTI_NUM_BURSTS 100
 
 static uint16_t portid;
 static struct rte_ring *ring;
+static uint16_t multi_portid;
+static struct rte_ring *multi_rings[MULTI_NUM_QUEUES];
 
 static struct rte_metric_name lat_stats_strings[NUM_STATS] = {
 	{"min_latency_ns"},
@@ -27,6 +32,9 @@ static struct rte_metric_name lat_stats_strings[NUM_STATS] = {
 	{"max_latency_ns"},
 	{"jitter_ns"},
 	{"samples"},
+	{"p50_latency_ns"},
+	{"p99_latency_ns"},
+	{"p999_latency_ns"},
 };
 
 /* Test case for latency init with metrics init */
@@ -131,6 +139,17 @@ static int test_latency_ring_setup(void)
 {
 	test_ring_setup(&ring, &portid);
 
+	/* Port with several Tx queues, created before the latency init */
+	multi_rings[0] = rte_ring_create("R1", RING_SIZE, rte_socket_id(),
+			RING_F_SP_ENQ | RING_F_SC_DEQ);
+	multi_rings[1] = rte_ring_create("R2", RING_SIZE, rte_socket_id(),
+			RING_F_SP_ENQ | RING_F_SC_DEQ);
+	TEST_ASSERT(multi_rings[0] != NULL && multi_rings[1] != NULL,
+			"Test Failed to create rings");
+	multi_portid = rte_eth_from_rings("net_ringb", multi_rings,
+			MULTI_NUM_QUEUES, multi_rings, MULTI_NUM_QUEUES,
+			rte_socket_id());
+
 	return TEST_SUCCESS;
 }
 
@@ -138,6 +157,9 @@ static void test_latency_ring_free(void)
 {
 	test_ring_free(ring);
 	test_vdev_uninit("net_ring_net_ringa");
+	test_vdev_uninit("net_ring_net_ringb");
+	test_ring_free(multi_rings[0]);
+	test_ring_free(multi_rings[1]);
 }
 
 static int test_latency_packet_forward(void)
@@ -150,6 +172,7 @@ static int test_latency_packet_forward(void)
 	uint64_t end_cycles;
 	struct rte_metric_value values[NUM_STATS] = { };
 	struct rte_metric_name names[NUM_STATS] = { };
+	struct rte_latencystats_queue qstats;
 
 	ret = test_get_mbuf_from_pool(&mp, pbuf, poolname);
 	if (ret < 0) {
@@ -199,12 +222,120 @@ static int test_latency_packet_forward(void)
 	TEST_ASSERT(values[0].value < values[2].value, "Min latency > Max latency");
 	TEST_ASSERT(values[1].value < values[2].value, "Avg latency > Max latency");
 
+	ret = rte_latencystats_queue_get(portid, QUEUE_ID, &qstats);
+	TEST_ASSERT(ret == 0, "Test failed to get queue results");
+	printf("queue samples = %"PRIu64", p50 = %"PRIu64" ns, p99 = %"PRIu64" ns, p999 = %"PRIu64" ns\n",
+	       qstats.samples, qstats.p50_ns, qstats.p99_ns, qstats.p999_ns);
+	TEST_ASSERT(qstats.samples > 0, "No queue samples taken");
+	TEST_ASSERT(qstats.min_ns <= qstats.p50_ns, "Min latency > p50 latency");
+	TEST_ASSERT(qstats.p50_ns <= qstats.p99_ns, "p50 latency > p99 latency");
+	TEST_ASSERT(qstats.p99_ns <= qstats.p999_ns, "p99 latency > p999 latency");
+	TEST_ASSERT(qstats.p999_ns <= qstats.max_ns, "p999 latency > Max latency");
+
 	rte_eth_dev_stop(portid);
 	test_put_mbuf_to_pool(mp, pbuf);
 
 	return (ret >= 0) ? TEST_SUCCESS : TEST_FAILED;
 }
 
+/* Test case to check the stats are accumulated per Tx queue and merged */
+static int test_latency_queues(void)
+{
+	struct rte_mbuf *pbuf[LATENCY_NUM_PACKETS] = { };
+	struct rte_metric_value values[NUM_STATS] = { };
+	struct rte_latencystats_queue qstats[MULTI_NUM_QUEUES];
+	struct rte_eth_conf conf;
+	struct rte_mempool *mp;
+	char poolname[] = "mbuf_pool_queues";
+	uint16_t qid;
+	unsigned int i;
+	int ret;
+
+	/* Failure Test: Invalid port, queue and stats */
+	ret = rte_latencystats_queue_get(multi_portid, 0, NULL);
+	TEST_ASSERT(ret == -EINVAL, "Test Failed: got stats in NULL");
+	ret = rte_latencystats_queue_get(RTE_MAX_ETHPORTS, 0, &qstats[0]);
+	TEST_ASSERT(ret == -EINVAL, "Test Failed: got stats of invalid port");
+	ret = rte_latencystats_queue_get(multi_portid, MULTI_NUM_QUEUES,
+			&qstats[0]);
+	TEST_ASSERT(ret == -EINVAL, "Test Failed: got stats of invalid queue");
+	ret = rte_latencystats_queue_reset(multi_portid, MULTI_NUM_QUEUES);
+	TEST_ASSERT(ret == -EINVAL, "Test Failed: reset invalid queue");
+
+	/* Only the queues of this test in the merged stats */
+	ret = rte_latencystats_queue_reset(portid, QUEUE_ID);
+	TEST_ASSERT(ret == 0, "Test Failed to reset queue stats");
+	for (qid = 0; qid < MULTI_NUM_QUEUES; qid++) {
+		ret = rte_latencystats_queue_reset(multi_portid, qid);
+		TEST_ASSERT(ret == 0, "Test Failed to reset queue stats");
+		ret = rte_latencystats_queue_get(multi_portid, qid, &qstats[qid]);
+		TEST_ASSERT(ret == 0 && qstats[qid].samples == 0,
+				"Queue %u samples not reset", qid);
+	}
+
+	ret = test_get_mbuf_from_pool(&mp, pbuf, poolname);
+	TEST_ASSERT(ret == 0, "Test Failed to allocate mbufs");
+	memset(&conf, 0, sizeof(conf));
+	ret = rte_eth_dev_configure(multi_portid, MULTI_NUM_QUEUES,
+			MULTI_NUM_QUEUES, &conf);
+	TEST_ASSERT(ret == 0, "Test Failed to configure port");
+	for (qid = 0; qid < MULTI_NUM_QUEUES; qid++) {
+		ret = rte_eth_rx_queue_setup(multi_portid, qid, RING_SIZE,
+				SOCKET_ID_ANY, NULL, mp);
+		TEST_ASSERT(ret == 0, "Test Failed to setup Rx queue");
+		ret = rte_eth_tx_queue_setup(multi_portid, qid, RING_SIZE,
+				SOCKET_ID_ANY, NULL);
+		TEST_ASSERT(ret == 0, "Test Failed to setup Tx queue");
+	}
+	ret = rte_eth_dev_start(multi_portid);
+	TEST_ASSERT(ret == 0, "Test Failed to start port");
+
+	/* Traffic on the last queue only */
+	for (i = 0; i < MULTI_NUM_BURSTS; i++) {
+		ret = test_packet_forward(pbuf, multi_portid,
+				MULTI_NUM_QUEUES - 1);
+		TEST_ASSERT(ret == 0, "Test Failed to forward packets");
+	}
+
+	for (qid = 0; qid < MULTI_NUM_QUEUES; qid++) {
+		ret = rte_latencystats_queue_get(multi_portid, qid, &qstats[qid]);
+		TEST_ASSERT(ret == 0, "Test Failed to get queue results");
+	}
+	TEST_ASSERT(qstats[0].samples == 0, "Samples on a queue without traffic");
+	qid = MULTI_NUM_QUEUES - 1;
+	TEST_ASSERT(qstats[qid].samples > 0, "No queue samples taken");
+	TEST_ASSERT(qstats[qid].min_ns <= qstats[qid].p50_ns,
+			"Min latency > p50 latency");
+	TEST_ASSERT(qstats[qid].p50_ns <= qstats[qid].p99_ns,
+			"p50 latency > p99 latency");
+	TEST_ASSERT(qstats[qid].p99_ns <= qstats[qid].p999_ns,
+			"p99 latency > p999 latency");
+	TEST_ASSERT(qstats[qid].p999_ns <= qstats[qid].max_ns,
+			"p999 latency > Max latency");
+
+	/* Merged from the histograms of all the queues */
+	ret = rte_latencystats_get(values, NUM_STATS);
+	TEST_ASSERT(ret == NUM_STATS, "Test failed to get results");
+	TEST_ASSERT(values[4].value == qstats[qid].samples,
+			"Merged samples %"PRIu64" != queue samples %"PRIu64,
+			values[4].value, qstats[qid].samples);
+	TEST_ASSERT(values[5].value == qstats[qid].p50_ns &&
+			values[6].value == qstats[qid].p99_ns &&
+			values[7].value == qstats[qid].p999_ns,
+			"Merged percentiles differ from the queue ones");
+
+	ret = rte_latencystats_queue_reset(multi_portid, qid);
+	TEST_ASSERT(ret == 0, "Test Failed to reset queue stats");
+	ret = rte_latencystats_get(values, NUM_STATS);
+	TEST_ASSERT(ret == NUM_STATS, "Test failed to get results");
+	TEST_ASSERT(values[4].value == 0, "Samples not zero after reset");
+
+	rte_eth_dev_stop(multi_portid);
+	test_put_mbuf_to_pool(mp, pbuf);
+
+	return TEST_SUCCESS;
+}
+
 static struct
 unit_test_suite latencystats_testsuite = {
 	.suite_name = "Latency Stats Unit Test Suite",
@@ -234,7 +365,12 @@ unit_test_suite latencystats_testsuite = {
 		TEST_CASE_ST(test_latency_packet_forward, NULL,
 				test_latency_update),
 
-		/* Test Case 5: To check uninit of latency test */
+		/* Test Case 5: To check the latency stats are
+		 * accumulated per Tx queue and merged on read
+		 */
+		TEST_CASE_ST(NULL, NULL, test_latency_queues),
+
+		/* Test Case 6: To check uninit of latency test */
 		TEST_CASE_ST(NULL, NULL, test_latency_uninit),
 
 		TEST_CASES_END()
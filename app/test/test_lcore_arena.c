@@ -0,0 +1,184 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Ericsson AB
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <rte_errno.h>
+#include <rte_launch.h>
+#include <rte_lcore_arena.h>
+
+#include "test.h"
+
+#define MIN_LCORES 2
+#define ARENA_SIZE 4096
+
+static struct rte_lcore_arena *arena;
+
+static int
+test_setup(void)
+{
+	arena = rte_lcore_arena_create(ARENA_SIZE);
+	TEST_ASSERT_NOT_NULL(arena, "Cannot create lcore arena: %d", rte_errno);
+
+	return TEST_SUCCESS;
+}
+
+static void
+test_teardown(void)
+{
+	rte_lcore_arena_free(arena);
+	arena = NULL;
+}
+
+static int
+test_invalid(void)
+{
+	TEST_ASSERT_NULL(rte_lcore_arena_create(0),
+			"Lcore arena of zero size created");
+	TEST_ASSERT_EQUAL(rte_errno, EINVAL, "Wrong rte_errno %d", rte_errno);
+
+	/* nothing to free */
+	rte_lcore_arena_free(NULL);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_alloc_reset(void)
+{
+	char *p1, *p2, *p3;
+
+	p1 = rte_lcore_arena_alloc(arena, 1, 1);
+	TEST_ASSERT_NOT_NULL(p1, "Cannot allocate from lcore arena");
+	TEST_ASSERT((uintptr_t)p1 % RTE_CACHE_LINE_SIZE == 0,
+			"First allocation not aligned on the region start");
+
+	p2 = rte_lcore_arena_alloc(arena, 8, 8);
+	TEST_ASSERT_EQUAL(p2, p1 + 8, "Allocation not bumped and aligned");
+
+	p3 = rte_lcore_arena_alloc(arena, 1, RTE_CACHE_LINE_SIZE);
+	TEST_ASSERT_EQUAL(p3, p1 + RTE_CACHE_LINE_SIZE,
+			"Allocation not aligned on a cache line");
+
+	/* the end of the region is reachable, but not beyond */
+	TEST_ASSERT_NULL(rte_lcore_arena_alloc(arena, ARENA_SIZE, 1),
+			"Allocation beyond the region succeeded");
+	TEST_ASSERT_NOT_NULL(rte_lcore_arena_alloc(arena,
+			ARENA_SIZE - 2 * RTE_CACHE_LINE_SIZE, RTE_CACHE_LINE_SIZE),
+			"Cannot allocate up to the region end");
+	TEST_ASSERT_NULL(rte_lcore_arena_alloc(arena, 1, 1),
+			"Allocation from an exhausted region succeeded");
+	TEST_ASSERT_EQUAL(rte_lcore_arena_high_water(arena, rte_lcore_id()),
+			(size_t)ARENA_SIZE, "Wrong high water");
+
+	rte_lcore_arena_reset(arena);
+	TEST_ASSERT_EQUAL(rte_lcore_arena_alloc(arena, ARENA_SIZE, 1), p1,
+			"Region not released by reset");
+	rte_lcore_arena_reset(arena);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_mark_release(void)
+{
+	char *p1, *p2;
+	size_t mark;
+
+	p1 = rte_lcore_arena_alloc(arena, 100, 4);
+	TEST_ASSERT_NOT_NULL(p1, "Cannot allocate from lcore arena");
+	memset(p1, 0x5a, 100);
+
+	mark = rte_lcore_arena_mark(arena);
+	p2 = rte_lcore_arena_alloc(arena, 200, 4);
+	TEST_ASSERT_NOT_NULL(p2, "Cannot allocate from lcore arena");
+	TEST_ASSERT(p2 >= p1 + 100, "Allocations overlap");
+
+	rte_lcore_arena_release(arena, mark);
+	TEST_ASSERT_EQUAL(rte_lcore_arena_alloc(arena, 200, 4), p2,
+			"Allocations after the mark not released");
+	TEST_ASSERT_EQUAL(p1[99], 0x5a, "Allocation before the mark modified");
+
+	rte_lcore_arena_reset(arena);
+
+	return TEST_SUCCESS;
+}
+
+struct lcore_state {
+	char *ptr;
+	bool success;
+};
+
+static int
+fill_lcore_region(void *arg)
+{
+	struct lcore_state *state = arg;
+	unsigned int i;
+
+	state->ptr = rte_lcore_arena_alloc(arena, ARENA_SIZE, 1);
+	if (state->ptr == NULL)
+		return 0;
+
+	memset(state->ptr, (int)rte_lcore_id(), ARENA_SIZE);
+	rte_lcore_arena_reset(arena);
+
+	state->success = true;
+	for (i = 0; i < ARENA_SIZE; i++)
+		state->success &= state->ptr[i] == (char)rte_lcore_id();
+
+	return 0;
+}
+
+static int
+test_per_lcore(void)
+{
+	struct lcore_state states[RTE_MAX_LCORE] = {};
+	unsigned int lcore_id, other_id;
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		rte_eal_remote_launch(fill_lcore_region, &states[lcore_id],
+				lcore_id);
+	}
+	rte_eal_mp_wait_lcore();
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		TEST_ASSERT(states[lcore_id].success,
+				"Lcore %u region corrupted", lcore_id);
+		RTE_LCORE_FOREACH_WORKER(other_id) {
+			if (other_id == lcore_id)
+				continue;
+			TEST_ASSERT(states[lcore_id].ptr != states[other_id].ptr,
+					"Lcores %u and %u share a region",
+					lcore_id, other_id);
+		}
+	}
+
+	return TEST_SUCCESS;
+}
+
+static struct unit_test_suite lcore_arena_testsuite = {
+	.suite_name = "lcore arena autotest",
+	.unit_test_cases = {
+		TEST_CASE(test_invalid),
+		TEST_CASE_ST(test_setup, test_teardown, test_alloc_reset),
+		TEST_CASE_ST(test_setup, test_teardown, test_mark_release),
+		TEST_CASE_ST(test_setup, test_teardown, test_per_lcore),
+		TEST_CASES_END()
+	},
+};
+
+static int test_lcore_arena(void)
+{
+	if (rte_lcore_count() < MIN_LCORES) {
+		printf("Not enough cores for lcore_arena_autotest; expecting at least %d.\n",
+				MIN_LCORES);
+		return TEST_SKIPPED;
+	}
+
+	return unit_test_suite_runner(&lcore_arena_testsuite);
+}
+
+REGISTER_FAST_TEST(lcore_arena_autotest, NOHUGE_OK, ASAN_OK, test_lcore_arena);
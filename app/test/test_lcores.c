@@ -389,6 +389,46 @@ test_ctrl_thread(void)
 	return 0;
 }
 
+static int
+test_lcore_domains(void)
+{
+	enum rte_lcore_domain domain;
+	unsigned int lcore_id;
+	rte_cpuset_t cpuset;
+	int cpu, id;
+
+	RTE_LCORE_FOREACH(lcore_id) {
+		cpuset = rte_lcore_cpuset(lcore_id);
+		for (cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+			if (CPU_ISSET(cpu, &cpuset))
+				break;
+		}
+		for (domain = RTE_LCORE_DOMAIN_SMT; domain <= RTE_LCORE_DOMAIN_CLUSTER; domain++) {
+			id = rte_lcore_domain_id(lcore_id, domain);
+			if (id == -ENOTSUP || id == -ENOENT)
+				continue;
+			if (id < 0) {
+				printf("Error: no domain %d for lcore %u: %d\n",
+					domain, lcore_id, id);
+				return -1;
+			}
+			/* a domain is named after the lowest cpu in it */
+			if (id > cpu) {
+				printf("Error: domain %d of lcore %u is %d, above cpu %d\n",
+					domain, lcore_id, id, cpu);
+				return -1;
+			}
+		}
+	}
+
+	if (rte_lcore_domain_id(RTE_MAX_LCORE, RTE_LCORE_DOMAIN_L3) != -EINVAL)
+		return -1;
+	if (rte_lcore_domain_id(rte_get_main_lcore(), RTE_LCORE_DOMAIN_CLUSTER + 1) != -EINVAL)
+		return -1;
+
+	return 0;
+}
+
 static int
 test_lcores(void)
 {
@@ -419,6 +459,9 @@ test_lcores(void)
 	if (test_ctrl_thread() < 0)
 		return TEST_FAILED;
 
+	if (test_lcore_domains() < 0)
+		return TEST_FAILED;
+
 	return TEST_SUCCESS;
 }
 
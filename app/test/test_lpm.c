@@ -44,6 +44,7 @@ static int32_t test18(void);
 static int32_t test19(void);
 static int32_t test20(void);
 static int32_t test21(void);
+static int32_t test22(void);
 
 rte_lpm_test tests[] = {
 /* Test Cases */
@@ -68,7 +69,8 @@ rte_lpm_test tests[] = {
 	test18,
 	test19,
 	test20,
-	test21
+	test21,
+	test22
 };
 
 #define MAX_DEPTH 32
@@ -1563,6 +1565,87 @@ test21(void)
 	return (status == 0) ? PASS : -1;
 }
 
+/*
+ * tbl8 groups growth test.
+ *  - Create LPM which supports 1 tbl8 group, with RTE_LPM_F_TBL8_GROW
+ *  - Add rules with depth=28 (> 24) in 2 different /24:
+ *    the second add fails without RCU QSBR variable
+ *  - Add RCU QSBR variable in DQ mode to LPM
+ *  - Add rules with depth=28 in many /24, growing the tbl8 groups
+ *  - Lookup all the rules
+ *  - Delete and re-add all the rules
+ */
+#define GROW_NUM_RULES 64
+int32_t
+test22(void)
+{
+	struct rte_lpm *lpm = NULL;
+	struct rte_lpm_config config;
+	size_t sz;
+	struct rte_rcu_qsbr *qsv;
+	int32_t status;
+	uint32_t i, ip, next_hop_return;
+	uint8_t depth = 28;
+	struct rte_lpm_rcu_config rcu_cfg = {0};
+
+	config.max_rules = MAX_RULES;
+	config.number_tbl8s = 1;
+	config.flags = RTE_LPM_F_TBL8_GROW;
+
+	lpm = rte_lpm_create(__func__, SOCKET_ID_ANY, &config);
+	TEST_LPM_ASSERT(lpm != NULL);
+
+	status = rte_lpm_add(lpm, RTE_IPV4(10, 0, 0, 16), depth, 1);
+	TEST_LPM_ASSERT(status == 0);
+	status = rte_lpm_add(lpm, RTE_IPV4(10, 0, 1, 16), depth, 2);
+	TEST_LPM_ASSERT(status == -ENOSPC);
+
+	/* Create RCU QSBR variable */
+	sz = rte_rcu_qsbr_get_memsize(1);
+	qsv = (struct rte_rcu_qsbr *)rte_zmalloc_socket(NULL, sz,
+				RTE_CACHE_LINE_SIZE, SOCKET_ID_ANY);
+	TEST_LPM_ASSERT(qsv != NULL);
+
+	status = rte_rcu_qsbr_init(qsv, 1);
+	TEST_LPM_ASSERT(status == 0);
+
+	rcu_cfg.v = qsv;
+	rcu_cfg.mode = RTE_LPM_QSBR_MODE_DQ;
+	status = rte_lpm_rcu_qsbr_add(lpm, &rcu_cfg);
+	TEST_LPM_ASSERT(status == 0);
+
+	for (i = 1; i < GROW_NUM_RULES; i++) {
+		status = rte_lpm_add(lpm, RTE_IPV4(10, 0, i, 16), depth, i + 1);
+		TEST_LPM_ASSERT(status == 0);
+	}
+
+	for (i = 0; i < GROW_NUM_RULES; i++) {
+		ip = RTE_IPV4(10, 0, i, 17);
+		status = rte_lpm_lookup(lpm, ip, &next_hop_return);
+		TEST_LPM_ASSERT(status == 0 && next_hop_return == i + 1);
+		status = rte_lpm_lookup(lpm, ip + 16, &next_hop_return);
+		TEST_LPM_ASSERT(status == -ENOENT);
+	}
+
+	/* the freed groups are reclaimed from the defer queue */
+	for (i = 0; i < GROW_NUM_RULES; i++) {
+		status = rte_lpm_delete(lpm, RTE_IPV4(10, 0, i, 16), depth);
+		TEST_LPM_ASSERT(status == 0);
+	}
+	for (i = 0; i < GROW_NUM_RULES; i++) {
+		status = rte_lpm_add(lpm, RTE_IPV4(10, 0, i, 16), depth, i + 1);
+		TEST_LPM_ASSERT(status == 0);
+	}
+	status = rte_lpm_lookup(lpm, RTE_IPV4(10, 0, GROW_NUM_RULES - 1, 17),
+			&next_hop_return);
+	TEST_LPM_ASSERT(status == 0 && next_hop_return == GROW_NUM_RULES);
+
+	rte_lpm_free(lpm);
+	rte_free(qsv);
+
+	return PASS;
+}
+
 /*
  * Do all unit tests.
  */
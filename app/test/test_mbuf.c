@@ -35,6 +35,7 @@
 #include <rte_ip.h>
 #include <rte_tcp.h>
 #include <rte_mbuf_dyn.h>
+#include <rte_ptr_compress.h>
 
 #define MEMPOOL_CACHE_SIZE      32
 #define MBUF_DATA_SIZE          2048
@@ -739,6 +740,180 @@ test_pktmbuf_pool(struct rte_mempool *pktmbuf_pool)
 	return ret;
 }
 
+/*
+ * test bulk allocation and bulk free of mbufs as compressed pointers,
+ * from a pool storing compressed pointers
+ */
+static int
+test_pktmbuf_pool_bulk_compressed(void)
+{
+	struct rte_mempool_mem_range_info range;
+	struct rte_mempool *pool = NULL;
+	uint32_t mbufs32[NB_MBUF];
+	uint16_t mbufs16[NB_MBUF];
+	struct rte_mbuf *m;
+	size_t alignment;
+	uint8_t shift;
+	unsigned int i;
+	int ret = -1;
+
+	pool = rte_pktmbuf_pool_create_by_ops("test_pktmbuf_bulk_c32",
+			NB_MBUF, 0, 0, MBUF_DATA_SIZE, SOCKET_ID_ANY, "ring_c32");
+	if (pool == NULL) {
+		printf("rte_pktmbuf_pool_create_by_ops() failed. rte_errno %d\n",
+		       rte_errno);
+		goto err;
+	}
+
+	if (rte_mempool_get_mem_range(pool, &range) < 0)
+		goto err;
+	alignment = rte_mempool_get_obj_alignment(pool);
+	shift = RTE_PTR_COMPRESS_BIT_SHIFT_FROM_ALIGNMENT(alignment);
+	if (!RTE_PTR_COMPRESS_CAN_COMPRESS_32_SHIFT(range.length, alignment)) {
+		printf("mempool range cannot be compressed\n");
+		goto err;
+	}
+
+	printf("Test compressed bulk alloc and free.\n");
+
+	ret = rte_pktmbuf_alloc_bulk_compressed_32(pool, mbufs32, NB_MBUF,
+			range.start, shift);
+	if (ret != 0) {
+		printf("rte_pktmbuf_alloc_bulk_compressed_32() failed: %d\n",
+		       ret);
+		goto err;
+	}
+	ret = -1;
+	if (!rte_mempool_empty(pool)) {
+		printf("mempool not empty\n");
+		goto err;
+	}
+	for (i = 0; i < NB_MBUF; i++) {
+		rte_ptr_decompress_32_shift(range.start, &mbufs32[i],
+				(void **)&m, 1, shift);
+		if (m->pool != pool || rte_mbuf_refcnt_read(m) != 1) {
+			printf("bad mbuf %u after decompression\n", i);
+			goto err;
+		}
+	}
+	/* all or nothing: nothing is retrieved from the empty pool */
+	if (rte_pktmbuf_alloc_bulk_compressed_32(pool, mbufs32, 1,
+			range.start, shift) != -ENOENT) {
+		printf("allocation from an empty mempool succeeded\n");
+		goto err;
+	}
+	rte_pktmbuf_free_bulk_compressed_32(mbufs32, NB_MBUF / 2,
+			range.start, shift);
+	rte_pktmbuf_free_bulk_compressed_32(&mbufs32[NB_MBUF / 2],
+			NB_MBUF / 2, range.start, shift);
+	if (rte_mempool_avail_count(pool) != NB_MBUF) {
+		printf("mempool avail count incorrect\n");
+		goto err;
+	}
+
+	if (RTE_PTR_COMPRESS_CAN_COMPRESS_16_SHIFT(range.length, alignment)) {
+		printf("Test 16-bit compressed bulk alloc and free.\n");
+		if (rte_pktmbuf_alloc_bulk_compressed_16(pool, mbufs16,
+				NB_MBUF, range.start, shift) != 0) {
+			printf("rte_pktmbuf_alloc_bulk_compressed_16() failed\n");
+			goto err;
+		}
+		rte_pktmbuf_free_bulk_compressed_16(mbufs16, NB_MBUF,
+				range.start, shift);
+		if (rte_mempool_avail_count(pool) != NB_MBUF) {
+			printf("mempool avail count incorrect\n");
+			goto err;
+		}
+	}
+
+	ret = 0;
+
+err:
+	rte_mempool_free(pool);
+	return ret;
+}
+
+/*
+ * test replication of a packet behind header segments, and that the
+ * packet is freed with the last chain
+ */
+static int
+test_pktmbuf_hdr_seg(struct rte_mempool *pktmbuf_pool)
+{
+	struct rte_mempool *hdr_pool = NULL;
+	struct rte_mbuf *hdrs[4];
+	struct rte_mbuf *m = NULL;
+	unsigned int avail, i;
+	char *hdr;
+	int ret = -1;
+
+	hdr_pool = rte_pktmbuf_hdr_pool_create("test_pktmbuf_hdr_seg",
+			NB_MBUF, 0, SOCKET_ID_ANY);
+	if (hdr_pool == NULL) {
+		printf("rte_pktmbuf_hdr_pool_create() failed. rte_errno %d\n",
+		       rte_errno);
+		goto err;
+	}
+
+	m = rte_pktmbuf_alloc(pktmbuf_pool);
+	if (m == NULL)
+		GOTO_FAIL("cannot allocate mbuf");
+	if (rte_pktmbuf_append(m, MBUF_TEST_DATA_LEN) == NULL)
+		GOTO_FAIL("cannot append data");
+	memset(rte_pktmbuf_mtod(m, char *), 0x66, MBUF_TEST_DATA_LEN);
+	m->ol_flags |= RTE_MBUF_F_RX_RSS_HASH;
+	m->hash.rss = 0x1234;
+	avail = rte_mempool_avail_count(pktmbuf_pool);
+
+	if (rte_pktmbuf_hdr_replicate(hdr_pool, m, hdrs,
+			RTE_DIM(hdrs)) != 0)
+		GOTO_FAIL("rte_pktmbuf_hdr_replicate() failed");
+	if (rte_mbuf_refcnt_read(m) != RTE_DIM(hdrs))
+		GOTO_FAIL("bad packet refcnt");
+
+	for (i = 0; i < RTE_DIM(hdrs); i++) {
+		if (!RTE_MBUF_IS_HDR_SEG(hdrs[i]))
+			GOTO_FAIL("not a header segment");
+		if (rte_pktmbuf_headroom(hdrs[i]) != RTE_PKTMBUF_HDR_SEG_SIZE)
+			GOTO_FAIL("bad header segment headroom");
+		hdr = rte_pktmbuf_prepend(hdrs[i], MBUF_TEST_HDR1_LEN);
+		if (hdr == NULL)
+			GOTO_FAIL("cannot prepend header");
+		memset(hdr, i, MBUF_TEST_HDR1_LEN);
+		if (hdrs[i]->next != m || hdrs[i]->nb_segs != 2 ||
+		    hdrs[i]->pkt_len != MBUF_TEST_HDR1_LEN + MBUF_TEST_DATA_LEN)
+			GOTO_FAIL("bad chain");
+		if (!(hdrs[i]->ol_flags & RTE_MBUF_F_RX_RSS_HASH) ||
+		    hdrs[i]->hash.rss != 0x1234)
+			GOTO_FAIL("metadata not copied");
+		rte_mbuf_sanity_check(hdrs[i], 1);
+	}
+
+	/* the packet is not written */
+	if (m->data_len != MBUF_TEST_DATA_LEN ||
+	    m->pkt_len != MBUF_TEST_DATA_LEN ||
+	    *rte_pktmbuf_mtod(m, char *) != 0x66)
+		GOTO_FAIL("packet modified");
+
+	for (i = 0; i < RTE_DIM(hdrs); i++) {
+		rte_pktmbuf_free(hdrs[i]);
+		if (rte_mempool_avail_count(pktmbuf_pool) !=
+		    (i == RTE_DIM(hdrs) - 1 ? avail + 1 : avail))
+			GOTO_FAIL("packet freed at the wrong time");
+	}
+	m = NULL;
+	if (rte_mempool_avail_count(hdr_pool) != NB_MBUF)
+		GOTO_FAIL("header segments not freed");
+
+	ret = 0;
+
+fail:
+	rte_pktmbuf_free(m);
+err:
+	rte_mempool_free(hdr_pool);
+	return ret;
+}
+
 /*
  * test bulk allocation and bulk free of mbufs
  */
@@ -2769,6 +2944,100 @@ test_nb_segs_and_next_reset(void)
 	return -1;
 }
 
+/* check the sampled trace of the mbuf history */
+#define TRACE_RING_SIZE 64
+
+static int
+test_mbuf_history_trace(struct rte_mempool *pktmbuf_pool)
+{
+#ifndef RTE_MBUF_HISTORY_TRACE
+	RTE_SET_USED(pktmbuf_pool);
+	if (rte_mbuf_history_trace_start(1, TRACE_RING_SIZE) != -ENOTSUP) {
+		printf("mbuf history trace started while not compiled\n");
+		return -1;
+	}
+	return 0;
+#else
+	struct rte_mbuf_history_trace_lcore *trace;
+	const struct rte_mbuf_history_record *rec;
+	struct rte_mbuf *m = NULL;
+	char line[128], prefix[32];
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int i, nb_lines = 0;
+	uint64_t head;
+	FILE *f = NULL;
+
+	if (rte_mbuf_history_trace_start(0, TRACE_RING_SIZE) != -EINVAL ||
+			rte_mbuf_history_trace_start(1, 0) != -EINVAL)
+		GOTO_FAIL("trace started with invalid parameters");
+
+	/* sample rate 1: every mbuf is traced */
+	if (rte_mbuf_history_trace_start(1, TRACE_RING_SIZE) != 0)
+		GOTO_FAIL("cannot start trace");
+	if (rte_mbuf_history_trace_start(1, TRACE_RING_SIZE + 1) != -EEXIST)
+		GOTO_FAIL("trace rings allocated again with another size");
+	trace = &rte_mbuf_history_trace_lcores[lcore_id];
+	if (trace->mask != TRACE_RING_SIZE - 1)
+		GOTO_FAIL("trace ring of lcore %u not allocated", lcore_id);
+
+	m = rte_pktmbuf_alloc(pktmbuf_pool);
+	if (m == NULL)
+		GOTO_FAIL("cannot allocate mbuf");
+
+	rte_mbuf_history_mark_ctx(m, RTE_MBUF_HISTORY_OP_USR1, 0x1234);
+	rte_mbuf_history_mark_bulk_ctx(&m, 1, RTE_MBUF_HISTORY_OP_USR2,
+			RTE_MBUF_HISTORY_CTX_QUEUE(3, 5));
+	head = rte_atomic_load_explicit(&trace->head, rte_memory_order_relaxed);
+	rec = &trace->records[(head - 2) & trace->mask];
+	if (rec->m != m || rec->op != RTE_MBUF_HISTORY_OP_USR1 ||
+			rec->ctx != 0x1234)
+		GOTO_FAIL("wrong record of the operation with context");
+	rec = &trace->records[(head - 1) & trace->mask];
+	if (rec->m != m || rec->op != RTE_MBUF_HISTORY_OP_USR2 ||
+			rec->ctx != 0x30005)
+		GOTO_FAIL("wrong record of the bulk operation with context");
+
+	/* the ring keeps the most recent records */
+	for (i = 0; i < TRACE_RING_SIZE + 10; i++)
+		rte_mbuf_history_mark(m, RTE_MBUF_HISTORY_OP_USR1);
+	head = rte_atomic_load_explicit(&trace->head, rte_memory_order_relaxed);
+
+	/* about 1 in 2^32 mbufs traced: this one is not */
+	if (rte_mbuf_history_trace_start(UINT32_MAX, TRACE_RING_SIZE) != 0)
+		GOTO_FAIL("cannot change trace sample rate");
+	rte_mbuf_history_mark(m, RTE_MBUF_HISTORY_OP_USR1);
+	rte_mbuf_history_trace_stop();
+	rte_mbuf_history_mark(m, RTE_MBUF_HISTORY_OP_USR1);
+	if (rte_atomic_load_explicit(&trace->head, rte_memory_order_relaxed) != head)
+		GOTO_FAIL("operation recorded while not sampled or stopped");
+
+	f = tmpfile();
+	if (f == NULL)
+		GOTO_FAIL("cannot create dump file");
+	rte_mbuf_history_trace_dump(f);
+	rewind(f);
+	snprintf(prefix, sizeof(prefix), "trace %u ", lcore_id);
+	while (fgets(line, sizeof(line), f) != NULL) {
+		if (strncmp(line, prefix, strlen(prefix)) == 0)
+			nb_lines++;
+	}
+	if (nb_lines != TRACE_RING_SIZE)
+		GOTO_FAIL("dumped %u records of lcore %u instead of %u",
+			nb_lines, lcore_id, TRACE_RING_SIZE);
+
+	fclose(f);
+	rte_pktmbuf_free(m);
+	return 0;
+
+fail:
+	rte_mbuf_history_trace_stop();
+	if (f != NULL)
+		fclose(f);
+	rte_pktmbuf_free(m);
+	return -1;
+#endif
+}
+
 static int
 test_mbuf(void)
 {
@@ -2824,6 +3093,18 @@ test_mbuf(void)
 		goto err;
 	}
 
+	/* test compressed bulk mbuf alloc and free */
+	if (test_pktmbuf_pool_bulk_compressed() < 0) {
+		printf("test_pktmbuf_pool_bulk_compressed() failed\n");
+		goto err;
+	}
+
+	/* test header segments attached to a shared packet */
+	if (test_pktmbuf_hdr_seg(pktmbuf_pool) < 0) {
+		printf("test_pktmbuf_hdr_seg() failed\n");
+		goto err;
+	}
+
 	/* test that the pointer to the data on a packet mbuf is set properly */
 	if (test_pktmbuf_pool_ptr(pktmbuf_pool) < 0) {
 		printf("test_pktmbuf_pool_ptr() failed\n");
@@ -2965,6 +3246,12 @@ test_mbuf(void)
 		goto err;
 	}
 
+	/* test the sampled trace of the mbuf history */
+	if (test_mbuf_history_trace(pktmbuf_pool) < 0) {
+		printf("test_mbuf_history_trace() failed\n");
+		goto err;
+	}
+
 	ret = 0;
 err:
 	rte_mempool_free(pktmbuf_pool);
@@ -692,6 +692,126 @@ test_member_loadfactor(void)
 	return 0;
 }
 
+static int
+cf_test(uint32_t extra_flag)
+{
+	struct rte_member_setsum *setsum_cf;
+	const void *key_array[RTE_MEMBER_LOOKUP_BULK_MAX];
+	member_set_t set_ids[RTE_MEMBER_LOOKUP_BULK_MAX];
+	const unsigned int num_added = MAX_ENTRIES / 2;
+	unsigned int i, j, n, false_pos = 0;
+	member_set_t set_id;
+	int ret;
+
+	params.name = "test_member_cf";
+	params.type = RTE_MEMBER_TYPE_CF;
+	params.extra_flag = extra_flag;
+	setsum_cf = rte_member_create(&params);
+	if (setsum_cf == NULL) {
+		printf("Creation of cuckoo filter fail\n");
+		return -1;
+	}
+
+	for (i = 0; i < num_added; i++) {
+		if (rte_member_add(setsum_cf, &generated_keys[i], 1) < 0) {
+			printf("Add key %u to cuckoo filter fail\n", i);
+			goto error;
+		}
+	}
+
+	/* No false-negative for single and bulk lookup */
+	for (i = 0; i < num_added; i++) {
+		if (rte_member_lookup(setsum_cf, &generated_keys[i],
+				&set_id) != 1 || set_id != 1) {
+			printf("Cuckoo filter lookup miss\n");
+			goto error;
+		}
+	}
+	for (i = 0; i < MAX_ENTRIES; i += n) {
+		n = RTE_MIN(MAX_ENTRIES - i,
+			(unsigned int)RTE_MEMBER_LOOKUP_BULK_MAX);
+		for (j = 0; j < n; j++)
+			key_array[j] = &generated_keys[i + j];
+		ret = rte_member_lookup_bulk(setsum_cf, key_array, n, set_ids);
+		for (j = 0; j < n; j++) {
+			if (i + j >= num_added) {
+				false_pos += set_ids[j] != RTE_MEMBER_NO_MATCH;
+			} else if (set_ids[j] != 1) {
+				printf("Cuckoo filter lookup bulk miss\n");
+				goto error;
+			}
+		}
+		if (i + n <= num_added && ret != (int)n) {
+			printf("Cuckoo filter lookup bulk count wrong\n");
+			goto error;
+		}
+	}
+	printf("Cuckoo filter %u-bit false positive rate = %.4f%%\n",
+		(extra_flag & RTE_MEMBER_CF_FP_8BIT) ? 8 : 16,
+		(double)false_pos / (MAX_ENTRIES - num_added) * 100);
+
+	/* Delete half of the keys, the others must still be found */
+	for (i = 0; i < num_added / 2; i++) {
+		if (rte_member_delete(setsum_cf, &generated_keys[i], 0) < 0) {
+			printf("Cuckoo filter delete fail\n");
+			goto error;
+		}
+	}
+	for (i = num_added / 2; i < num_added; i++) {
+		if (rte_member_lookup(setsum_cf, &generated_keys[i],
+				&set_id) != 1) {
+			printf("Cuckoo filter lookup miss after delete\n");
+			goto error;
+		}
+	}
+
+	/* A key added twice is still found after one delete */
+	i = num_added - 1;
+	if (rte_member_add(setsum_cf, &generated_keys[i], 1) < 0 ||
+			rte_member_delete(setsum_cf, &generated_keys[i], 0) < 0 ||
+			rte_member_lookup(setsum_cf, &generated_keys[i],
+				&set_id) != 1) {
+		printf("Cuckoo filter duplicate key fail\n");
+		goto error;
+	}
+
+	rte_member_reset(setsum_cf);
+	if (rte_member_lookup(setsum_cf, &generated_keys[i], &set_id) != 0) {
+		printf("Cuckoo filter reset fail\n");
+		goto error;
+	}
+
+	rte_member_free(setsum_cf);
+	params.extra_flag = 0;
+	return 0;
+
+error:
+	rte_member_free(setsum_cf);
+	params.extra_flag = 0;
+	return -1;
+}
+
+static int
+test_member_cf(void)
+{
+	uint32_t num_keys = params.num_keys;
+
+	if (cf_test(0) < 0 || cf_test(RTE_MEMBER_CF_FP_8BIT) < 0)
+		return -1;
+
+	params.name = "test_member_cf";
+	params.type = RTE_MEMBER_TYPE_CF;
+	params.num_keys = 0;
+	if (rte_member_create(&params) != NULL) {
+		printf("Creation of cuckoo filter with no key did not fail\n");
+		params.num_keys = num_keys;
+		return -1;
+	}
+	params.num_keys = num_keys;
+	printf("Cuckoo filter test passed\n");
+	return 0;
+}
+
 static void
 perform_free(void)
 {
@@ -869,6 +989,105 @@ sketch_test(uint32_t *keys, uint32_t total_pkt, int count_byte, int reset_test)
 	return 0;
 }
 
+#define SKETCH_WINDOW_SEGMENTS 4
+#define SKETCH_WINDOW_PKTS 1000
+
+static int
+sketch_window_test(uint32_t extra_flag)
+{
+	struct rte_member_setsum *setsum_window;
+	uint64_t count[TOP_K];
+	uint64_t result;
+	uint32_t i, seg, key;
+	int ret, hh_cnt;
+
+	params.key_len = sizeof(uint32_t);
+	params.name = "test_member_sketch_window";
+	params.type = RTE_MEMBER_TYPE_SKETCH;
+	params.error_rate = SKETCH_ERROR_RATE;
+	params.sample_rate = 1;
+	params.extra_flag = extra_flag;
+	params.top_k = TOP_K;
+
+	setsum_window = rte_member_create(&params);
+	if (setsum_window == NULL) {
+		printf("Creation of sketch for sliding window failed\n");
+		return -1;
+	}
+
+	if (rte_member_rotate_window(setsum_window) != -EINVAL) {
+		printf("Rotation of sketch without sliding window not rejected\n");
+		goto error;
+	}
+	if (rte_member_set_window(setsum_window, 0, 0) != -EINVAL) {
+		printf("Sliding window of 0 segment not rejected\n");
+		goto error;
+	}
+	if (rte_member_set_window(setsum_window, SKETCH_WINDOW_SEGMENTS, 0) < 0) {
+		printf("Setting of sliding window failed\n");
+		goto error;
+	}
+	if (rte_member_set_window(setsum_window, SKETCH_WINDOW_SEGMENTS, 0) != -EINVAL) {
+		printf("Second sliding window not rejected\n");
+		goto error;
+	}
+
+	/* a heavy key in each segment, and a key in all of them */
+	for (seg = 0; seg < SKETCH_WINDOW_SEGMENTS; seg++) {
+		for (i = 0; i < SKETCH_WINDOW_PKTS; i++) {
+			key = seg == 0 ? 1 : 0;
+			if (extra_flag & RTE_MEMBER_SKETCH_COUNT_BYTE)
+				ret = rte_member_add_byte_count(setsum_window, &key, 1);
+			else
+				ret = rte_member_add(setsum_window, &key, 1);
+			if (ret < 0)
+				goto error;
+		}
+		if (rte_member_rotate_window(setsum_window) < 0) {
+			printf("Sliding window rotation failed\n");
+			goto error;
+		}
+	}
+
+	/* the first segment was dropped by the last rotation */
+	key = 1;
+	rte_member_query_count(setsum_window, &key, &result);
+	if (result != 0) {
+		printf("Count %"PRIu64" of a key out of the window\n", result);
+		goto error;
+	}
+	key = 0;
+	rte_member_query_count(setsum_window, &key, &result);
+	if (result != (SKETCH_WINDOW_SEGMENTS - 1) * SKETCH_WINDOW_PKTS) {
+		printf("Count %"PRIu64" of a key in the window\n", result);
+		goto error;
+	}
+	hh_cnt = rte_member_report_heavyhitter(setsum_window, heavy_hitters, count);
+	if (hh_cnt != 1 || *(uint32_t *)heavy_hitters[0] != 0) {
+		printf("Wrong heavy hitters in the window\n");
+		goto error;
+	}
+
+	/* all the counts are dropped after a full window */
+	for (seg = 0; seg < SKETCH_WINDOW_SEGMENTS; seg++)
+		rte_member_rotate_window(setsum_window);
+	rte_member_query_count(setsum_window, &key, &result);
+	hh_cnt = rte_member_report_heavyhitter(setsum_window, heavy_hitters, count);
+	if (result != 0 || hh_cnt != 0) {
+		printf("Counts not dropped after a full window\n");
+		goto error;
+	}
+
+	rte_member_free(setsum_window);
+	params.extra_flag = 0;
+	return 0;
+
+error:
+	rte_member_free(setsum_window);
+	params.extra_flag = 0;
+	return -1;
+}
+
 static int
 test_member_sketch(void)
 {
@@ -947,6 +1166,13 @@ test_member_sketch(void)
 		return -1;
 	}
 
+	printf("\n[Sketch with Sliding Window]\n");
+	if (sketch_window_test(0) < 0 ||
+			sketch_window_test(RTE_MEMBER_SKETCH_COUNT_BYTE) < 0) {
+		rte_free(keys);
+		return -1;
+	}
+
 	rte_free(keys);
 	return 0;
 }
@@ -986,6 +1212,11 @@ test_member(void)
 		return -1;
 	}
 
+	if (test_member_cf() < 0) {
+		perform_free();
+		return -1;
+	}
+
 	if (test_member_sketch() < 0) {
 		perform_free();
 		return -1;
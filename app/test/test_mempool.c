@@ -838,6 +838,260 @@ test_mempool_flag_non_io_unset_when_populated_with_valid_iova(void)
 
 #pragma pop_macro("RTE_TEST_TRACE_FAILURE")
 
+static struct rte_mempool *mp_socket_return;
+
+/* free objects on a remote socket, they go to its return queue */
+static int
+test_mempool_launch_remote_free(__rte_unused void *arg)
+{
+	void *objs[MAX_KEEP];
+
+	if (rte_mempool_get_bulk(mp_socket_return, objs, MAX_KEEP) < 0)
+		return -1;
+	rte_mempool_put_bulk(mp_socket_return, objs, MAX_KEEP);
+	rte_mempool_cache_flush(NULL, mp_socket_return);
+
+	return 0;
+}
+
+static int
+test_mempool_socket_return(void)
+{
+	unsigned int lcore_id, remote_lcore = RTE_MAX_LCORE;
+	unsigned int i, size = 0;
+	void **objs = NULL;
+	int ret = -1;
+
+	/* the socket of the objects is required */
+	mp_socket_return = rte_mempool_create("test_socket_return_any",
+		MEMPOOL_SIZE, MEMPOOL_ELT_SIZE, 0, 0,
+		NULL, NULL, NULL, NULL,
+		SOCKET_ID_ANY, RTE_MEMPOOL_F_SOCKET_RETURN);
+	if (mp_socket_return != NULL || rte_errno != EINVAL)
+		GOTO_ERR(ret, err);
+
+	mp_socket_return = rte_mempool_create("test_socket_return",
+		MEMPOOL_SIZE, MEMPOOL_ELT_SIZE,
+		RTE_MEMPOOL_CACHE_MAX_SIZE, 0,
+		NULL, NULL, my_obj_init, NULL,
+		rte_socket_id(), RTE_MEMPOOL_F_SOCKET_RETURN);
+	if (mp_socket_return == NULL)
+		GOTO_ERR(ret, err);
+
+	/* the common pool is accessed through the socket return handler */
+	if (strcmp(rte_mempool_get_ops(mp_socket_return->ops_index)->name,
+			"socket_return") != 0)
+		GOTO_ERR(ret, err);
+
+	/* local frees behave as without return queues */
+	if (test_mempool_basic(mp_socket_return, 0) < 0)
+		GOTO_ERR(ret, err);
+
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		if (rte_lcore_to_socket_id(lcore_id) != rte_socket_id()) {
+			remote_lcore = lcore_id;
+			break;
+		}
+	}
+	if (remote_lcore == RTE_MAX_LCORE) {
+		printf("No lcore on a remote socket, skipping remote frees\n");
+		ret = 0;
+		goto err;
+	}
+
+	if (rte_eal_remote_launch(test_mempool_launch_remote_free, NULL,
+			remote_lcore) < 0)
+		GOTO_ERR(ret, err);
+	if (rte_eal_wait_lcore(remote_lcore) < 0)
+		GOTO_ERR(ret, err);
+
+	/* objects on return queues are still available */
+	rte_mempool_dump(stdout, mp_socket_return);
+	size = mp_socket_return->size;
+	if (rte_mempool_avail_count(mp_socket_return) != size)
+		GOTO_ERR(ret, err);
+
+	/* all objects can be allocated, draining the return queues */
+	rte_mempool_cache_flush(NULL, mp_socket_return);
+	objs = rte_calloc(NULL, size, sizeof(void *), 0);
+	if (objs == NULL)
+		GOTO_ERR(ret, err);
+	for (i = 0; i < size; i++) {
+		if (rte_mempool_generic_get(mp_socket_return, &objs[i], 1,
+				NULL) < 0)
+			GOTO_ERR(ret, err);
+	}
+	if (rte_mempool_avail_count(mp_socket_return) != 0)
+		GOTO_ERR(ret, err);
+
+	ret = 0;
+
+err:
+	if (objs != NULL) {
+		for (i = 0; i < size && objs[i] != NULL; i++)
+			rte_mempool_generic_put(mp_socket_return, &objs[i], 1,
+				NULL);
+		rte_free(objs);
+	}
+	rte_mempool_free(mp_socket_return);
+	mp_socket_return = NULL;
+	return ret;
+}
+
+static int
+test_mempool_adaptive_cache(void)
+{
+	const unsigned int windows = 10, burst = RTE_MEMPOOL_CACHE_MAX_SIZE / 2;
+	struct rte_mempool_cache *cache;
+	struct rte_mempool *mp;
+	void **objs = NULL;
+	unsigned int i;
+	int ret = -1;
+
+	/* adaptive caches need a cache */
+	mp = rte_mempool_create("test_adaptive_cache_none", MEMPOOL_SIZE,
+		MEMPOOL_ELT_SIZE, 0, 0, NULL, NULL, NULL, NULL,
+		SOCKET_ID_ANY, RTE_MEMPOOL_F_ADAPTIVE_CACHE);
+	if (mp != NULL || rte_errno != EINVAL) {
+		rte_mempool_free(mp);
+		RET_ERR();
+	}
+
+	mp = rte_mempool_create("test_adaptive_cache", MEMPOOL_SIZE,
+		MEMPOOL_ELT_SIZE, RTE_MEMPOOL_CACHE_MAX_SIZE, 0,
+		NULL, NULL, my_obj_init, NULL,
+		SOCKET_ID_ANY, RTE_MEMPOOL_F_ADAPTIVE_CACHE);
+	if (mp == NULL)
+		RET_ERR();
+
+	objs = malloc(burst * sizeof(void *));
+	if (objs == NULL)
+		GOTO_ERR(ret, err);
+
+	if (test_mempool_basic(mp, 0) < 0)
+		GOTO_ERR(ret, err);
+
+	/* small bursts leave most of the cache idle: it shrinks */
+	cache = rte_mempool_default_cache(mp, rte_lcore_id());
+	for (i = 0; i < windows * RTE_MEMPOOL_ADAPTIVE_CACHE_WINDOW / 2; i++) {
+		if (rte_mempool_generic_get(mp, objs, 8, cache) < 0)
+			GOTO_ERR(ret, err);
+		rte_mempool_generic_put(mp, objs, 8, cache);
+	}
+	rte_mempool_dump(stdout, mp);
+	if (cache->size != RTE_MEMPOOL_ADAPTIVE_CACHE_MIN ||
+	    cache->len > cache->flushthresh)
+		GOTO_ERR(ret, err);
+
+	/* large bursts go to the common pool each time: it grows */
+	for (i = 0; i < windows * RTE_MEMPOOL_ADAPTIVE_CACHE_WINDOW / 2; i++) {
+		if (rte_mempool_generic_get(mp, objs, burst, cache) < 0)
+			GOTO_ERR(ret, err);
+		rte_mempool_generic_put(mp, objs, burst, cache);
+	}
+	rte_mempool_dump(stdout, mp);
+	if (cache->size < burst || cache->size > mp->cache_size)
+		GOTO_ERR(ret, err);
+
+	ret = 0;
+
+err:
+	free(objs);
+	rte_mempool_free(mp);
+	return ret;
+}
+
+#ifdef RTE_MEMPOOL_BUCKET
+/* test the bucket handler: partial buckets, rollback and contiguous blocks */
+static int
+test_mempool_bucket(void)
+{
+	const unsigned int size = 1024;
+	struct rte_mempool_info info;
+	struct rte_mempool *mp;
+	struct rte_mbuf **mbufs = NULL;
+	void **objs = NULL;
+	unsigned int avail, bs, i, n;
+	size_t stride;
+	int ret = -1;
+
+	mp = rte_pktmbuf_pool_create_by_ops("test_bucket", size, 0, 0,
+		RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY, "bucket");
+	if (mp == NULL)
+		RET_ERR();
+
+	if (rte_mempool_ops_get_info(mp, &info) < 0)
+		GOTO_ERR(ret, err);
+	bs = info.contig_block_size;
+	stride = mp->header_size + mp->elt_size + mp->trailer_size;
+	avail = rte_mempool_avail_count(mp);
+	if (bs < 2 || avail < 3 * bs)
+		GOTO_ERR(ret, err);
+
+	objs = malloc((size + bs + 1) * sizeof(void *));
+	mbufs = malloc(2 * bs * sizeof(struct rte_mbuf *));
+	if (objs == NULL || mbufs == NULL)
+		GOTO_ERR(ret, err);
+
+	/* the objects of a partially dequeued bucket follow in address order */
+	if (rte_mempool_generic_get(mp, &objs[0], 1, NULL) < 0)
+		GOTO_ERR(ret, err);
+	if (rte_mempool_generic_get(mp, &objs[1], 1, NULL) < 0) {
+		rte_mempool_generic_put(mp, objs, 1, NULL);
+		GOTO_ERR(ret, err);
+	}
+	if (rte_mempool_generic_get(mp, &objs[2], bs - 2, NULL) < 0) {
+		rte_mempool_generic_put(mp, objs, 2, NULL);
+		GOTO_ERR(ret, err);
+	}
+	for (i = 1; i < bs; i++) {
+		if ((uintptr_t)objs[i] != (uintptr_t)objs[i - 1] + stride) {
+			rte_mempool_generic_put(mp, objs, bs, NULL);
+			GOTO_ERR(ret, err);
+		}
+	}
+
+	/* a failing dequeue with a partial bucket takes nothing */
+	n = (rte_mempool_avail_count(mp) / bs + 1) * bs + 1;
+	if (rte_mempool_generic_get(mp, &objs[bs], n, NULL) == 0) {
+		rte_mempool_generic_put(mp, objs, bs + n, NULL);
+		GOTO_ERR(ret, err);
+	}
+	if (rte_mempool_avail_count(mp) != avail - bs) {
+		rte_mempool_generic_put(mp, objs, bs, NULL);
+		GOTO_ERR(ret, err);
+	}
+	rte_mempool_generic_put(mp, objs, bs, NULL);
+	if (rte_mempool_avail_count(mp) != avail)
+		GOTO_ERR(ret, err);
+
+	/* contiguous blocks are expanded into adjacent mbufs */
+	if (rte_mbuf_raw_alloc_contig_blocks(mp, mbufs, 2, bs + 1) != -EINVAL)
+		GOTO_ERR(ret, err);
+	if (rte_mbuf_raw_alloc_contig_blocks(mp, mbufs, 2, bs) < 0)
+		GOTO_ERR(ret, err);
+	for (i = 0; i < 2 * bs; i++) {
+		if (mbufs[i]->pool != mp ||
+		    (i % bs != 0 && (uintptr_t)mbufs[i] !=
+				(uintptr_t)mbufs[i - 1] + stride)) {
+			rte_mempool_put_bulk(mp, (void **)mbufs, 2 * bs);
+			GOTO_ERR(ret, err);
+		}
+	}
+	rte_mempool_put_bulk(mp, (void **)mbufs, 2 * bs);
+	if (rte_mempool_avail_count(mp) != avail)
+		GOTO_ERR(ret, err);
+
+	ret = 0;
+
+err:
+	free(mbufs);
+	free(objs);
+	rte_mempool_free(mp);
+	return ret;
+}
+#endif
+
 static int
 test_mempool(void)
 {
@@ -851,6 +1105,7 @@ test_mempool(void)
 	struct rte_mempool *mp_mempool_iter = NULL;
 #ifdef RTE_MEMPOOL_STACK
 	struct rte_mempool *mp_stack = NULL;
+	struct rte_mempool *mp_numa_stack = NULL;
 #endif
 	struct rte_mempool *default_pool = NULL;
 	struct rte_mempool *mp_alignment = NULL;
@@ -950,6 +1205,30 @@ test_mempool(void)
 		GOTO_ERR(ret, err);
 	}
 	rte_mempool_obj_iter(mp_stack, my_obj_init, NULL);
+
+#if defined(RTE_ARCH_X86_64) || defined(RTE_ARCH_ARM64)
+	/* create a mempool with per-socket lock-free stacks */
+	mp_numa_stack = rte_mempool_create_empty("test_numa_stack",
+		MEMPOOL_SIZE,
+		MEMPOOL_ELT_SIZE,
+		RTE_MEMPOOL_CACHE_MAX_SIZE, 0,
+		SOCKET_ID_ANY, 0);
+
+	if (mp_numa_stack == NULL) {
+		printf("cannot allocate mp_numa_stack mempool\n");
+		GOTO_ERR(ret, err);
+	}
+	if (rte_mempool_set_ops_byname(mp_numa_stack, "lf_stack_numa",
+			NULL) < 0) {
+		printf("cannot set lf_stack_numa handler\n");
+		GOTO_ERR(ret, err);
+	}
+	if (rte_mempool_populate_default(mp_numa_stack) < 0) {
+		printf("cannot populate mp_numa_stack mempool\n");
+		GOTO_ERR(ret, err);
+	}
+	rte_mempool_obj_iter(mp_numa_stack, my_obj_init, NULL);
+#endif
 #endif /* RTE_MEMPOOL_STACK */
 
 	/* Create a mempool based on Default handler */
@@ -1081,15 +1360,32 @@ test_mempool(void)
 	if (test_mempool_same_name_twice_creation() < 0)
 		GOTO_ERR(ret, err);
 
+	if (test_mempool_socket_return() < 0)
+		GOTO_ERR(ret, err);
+
+	if (test_mempool_adaptive_cache() < 0)
+		GOTO_ERR(ret, err);
+
 #ifdef RTE_MEMPOOL_STACK
 	/* test the stack handler */
 	if (test_mempool_basic(mp_stack, 1) < 0)
 		GOTO_ERR(ret, err);
+#if defined(RTE_ARCH_X86_64) || defined(RTE_ARCH_ARM64)
+	/* test the per-socket lock-free stack handler */
+	if (test_mempool_basic(mp_numa_stack, 1) < 0)
+		GOTO_ERR(ret, err);
+#endif
 #endif
 
 	if (test_mempool_basic(default_pool, 1) < 0)
 		GOTO_ERR(ret, err);
 
+#ifdef RTE_MEMPOOL_BUCKET
+	/* test the bucket handler */
+	if (test_mempool_bucket() < 0)
+		GOTO_ERR(ret, err);
+#endif
+
 	/* test mempool event callbacks */
 	if (test_mempool_events(rte_mempool_populate_default) < 0)
 		GOTO_ERR(ret, err);
@@ -1115,6 +1411,7 @@ test_mempool(void)
 	rte_mempool_free(mp_mempool_iter);
 #ifdef RTE_MEMPOOL_STACK
 	rte_mempool_free(mp_stack);
+	rte_mempool_free(mp_numa_stack);
 #endif
 	rte_mempool_free(default_pool);
 	rte_mempool_free(mp_alignment);
@@ -676,6 +676,85 @@ tm_test_trtcm_rfc4115_color_aware_check(void)
 	return 0;
 }
 
+/**
+ * functional test for the bulk color aware checks, against the single ones
+ */
+static inline int
+tm_test_color_aware_check_bulk(void)
+{
+#define BULK_CHECK_MSG "color_aware_check_bulk"
+#define BULK_CHECK_PKTS 32
+	struct rte_meter_srtcm_profile sp;
+	struct rte_meter_trtcm_profile tp;
+	struct rte_meter_srtcm sm[2], sm_ref[2];
+	struct rte_meter_trtcm tm[2], tm_ref[2];
+	struct rte_meter_srtcm *smp[BULK_CHECK_PKTS];
+	struct rte_meter_srtcm_profile *spp[BULK_CHECK_PKTS];
+	struct rte_meter_trtcm *tmp[BULK_CHECK_PKTS];
+	struct rte_meter_trtcm_profile *tpp[BULK_CHECK_PKTS];
+	enum rte_color scolor[BULK_CHECK_PKTS], tcolor[BULK_CHECK_PKTS];
+	enum rte_color in_color[BULK_CHECK_PKTS], color;
+	uint32_t pkt_len[BULK_CHECK_PKTS];
+	uint64_t hz = rte_get_tsc_hz();
+	uint64_t time;
+	uint32_t i, j, k;
+
+	if (rte_meter_srtcm_profile_config(&sp, &sparams) != 0)
+		melog(BULK_CHECK_MSG);
+	if (rte_meter_trtcm_profile_config(&tp, &tparams) != 0)
+		melog(BULK_CHECK_MSG);
+	for (j = 0; j < 2; j++) {
+		if (rte_meter_srtcm_config(&sm[j], &sp) != 0)
+			melog(BULK_CHECK_MSG);
+		if (rte_meter_trtcm_config(&tm[j], &tp) != 0)
+			melog(BULK_CHECK_MSG);
+	}
+	memcpy(sm_ref, sm, sizeof(sm));
+	memcpy(tm_ref, tm, sizeof(tm));
+	time = rte_get_tsc_cycles();
+
+	/* runs of packets of the same meter, draining the buckets */
+	for (k = 1; k <= 3; k++) {
+		time += hz / 10000 * k;
+		for (i = 0; i < BULK_CHECK_PKTS; i++) {
+			j = (i / 5) & 1;
+			smp[i] = &sm[j];
+			spp[i] = &sp;
+			tmp[i] = &tm[j];
+			tpp[i] = &tp;
+			pkt_len[i] = 64 + 100 * (i % 7);
+			in_color[i] = (i % 11 == 3) ? RTE_COLOR_YELLOW :
+				(i % 13 == 5) ? RTE_COLOR_RED : RTE_COLOR_GREEN;
+			scolor[i] = in_color[i];
+			tcolor[i] = in_color[i];
+		}
+
+		rte_meter_srtcm_color_aware_check_bulk(smp, spp, time,
+			pkt_len, scolor, BULK_CHECK_PKTS);
+		rte_meter_trtcm_color_aware_check_bulk(tmp, tpp, time,
+			pkt_len, tcolor, BULK_CHECK_PKTS);
+
+		for (i = 0; i < BULK_CHECK_PKTS; i++) {
+			j = (i / 5) & 1;
+			color = rte_meter_srtcm_color_aware_check(&sm_ref[j],
+				&sp, time, pkt_len[i], in_color[i]);
+			if (color != scolor[i])
+				melog(BULK_CHECK_MSG" srtcm color");
+			color = rte_meter_trtcm_color_aware_check(&tm_ref[j],
+				&tp, time, pkt_len[i], in_color[i]);
+			if (color != tcolor[i])
+				melog(BULK_CHECK_MSG" trtcm color");
+		}
+
+		if (memcmp(sm, sm_ref, sizeof(sm)) != 0)
+			melog(BULK_CHECK_MSG" srtcm state");
+		if (memcmp(tm, tm_ref, sizeof(tm)) != 0)
+			melog(BULK_CHECK_MSG" trtcm state");
+	}
+
+	return 0;
+}
+
 /**
  * test main entrance for library meter
  */
@@ -709,6 +788,9 @@ test_meter(void)
 	if (tm_test_trtcm_rfc4115_color_aware_check() != 0)
 		return -1;
 
+	if (tm_test_color_aware_check_bulk() != 0)
+		return -1;
+
 	return 0;
 
 }
@@ -7,6 +7,8 @@
 #include <stdint.h>
 #include <errno.h>
 
+#include <rte_errno.h>
+#include <rte_launch.h>
 #include <rte_lcore.h>
 #include <rte_metrics.h>
 
@@ -271,6 +273,100 @@ test_metrics_get_values(void)
 	return TEST_SUCCESS;
 }
 
+/* Worker adding to its own slot of the metric */
+static int
+test_metrics_lcore_slot_worker(void *arg)
+{
+	rte_metrics_lcore_slot_t *slot;
+
+	slot = rte_metrics_lcore_slot_get(RTE_METRICS_GLOBAL, KEY);
+	if (slot == NULL)
+		return -rte_errno;
+	rte_metrics_lcore_slot_add(slot, *(uint64_t *)arg);
+
+	return 0;
+}
+
+/* Test to validate the per-lcore slots summed into the metric values */
+static int
+test_metrics_lcore_slot(void)
+{
+	struct rte_metric_value before[RTE_METRICS_MAX_METRICS];
+	struct rte_metric_value after[RTE_METRICS_MAX_METRICS];
+	rte_metrics_lcore_slot_t *slot;
+	uint64_t worker_delta = 7;
+	uint64_t global_value;
+	uint64_t expected;
+	unsigned int lcore_id;
+	int count;
+	int err;
+
+	/* Failure Test: invalid port_id and key */
+	slot = rte_metrics_lcore_slot_get(-2, KEY);
+	TEST_ASSERT(slot == NULL && rte_errno == EINVAL,
+			"%s, %d", __func__, __LINE__);
+
+	count = rte_metrics_get_names(NULL, 0);
+	TEST_ASSERT(count > KEY, "%s, %d", __func__, __LINE__);
+	slot = rte_metrics_lcore_slot_get(RTE_METRICS_GLOBAL, count);
+	TEST_ASSERT(slot == NULL && rte_errno == EINVAL,
+			"%s, %d", __func__, __LINE__);
+
+	err = rte_metrics_get_values(RTE_METRICS_GLOBAL, before,
+			RTE_DIM(before));
+	TEST_ASSERT(err == count, "%s, %d", __func__, __LINE__);
+
+	/* Successful Test: the slot of the lcore is looked up once */
+	slot = rte_metrics_lcore_slot_get(RTE_METRICS_GLOBAL, KEY);
+	TEST_ASSERT(slot != NULL, "%s, %d", __func__, __LINE__);
+	TEST_ASSERT(rte_metrics_lcore_slot_get(RTE_METRICS_GLOBAL, KEY) == slot,
+			"%s, %d", __func__, __LINE__);
+	rte_metrics_lcore_slot_add(slot, 5);
+	rte_metrics_lcore_slot_add(slot, 5);
+	global_value = before[KEY].value;
+	expected = global_value + 10;
+
+	/* Successful Test: the slots of the other lcores are summed too */
+	RTE_LCORE_FOREACH_WORKER(lcore_id) {
+		err = rte_eal_remote_launch(test_metrics_lcore_slot_worker,
+				&worker_delta, lcore_id);
+		TEST_ASSERT(err == 0, "%s, %d", __func__, __LINE__);
+		err = rte_eal_wait_lcore(lcore_id);
+		TEST_ASSERT(err == 0, "%s, %d", __func__, __LINE__);
+		expected += worker_delta;
+		break;
+	}
+
+	err = rte_metrics_get_values(RTE_METRICS_GLOBAL, after,
+			RTE_DIM(after));
+	TEST_ASSERT(err == count, "%s, %d", __func__, __LINE__);
+	TEST_ASSERT(after[KEY].value == expected, "%s, %d", __func__, __LINE__);
+	TEST_ASSERT(after[0].value == before[0].value,
+			"%s, %d", __func__, __LINE__);
+
+	/* Successful Test: the slots of a port are not summed in the others */
+	err = rte_metrics_get_values(0, before, RTE_DIM(before));
+	TEST_ASSERT(err == count, "%s, %d", __func__, __LINE__);
+	slot = rte_metrics_lcore_slot_get(1, KEY);
+	TEST_ASSERT(slot != NULL, "%s, %d", __func__, __LINE__);
+	rte_metrics_lcore_slot_add(slot, 3);
+	err = rte_metrics_get_values(0, after, RTE_DIM(after));
+	TEST_ASSERT(err == count, "%s, %d", __func__, __LINE__);
+	TEST_ASSERT(after[KEY].value == before[KEY].value,
+			"%s, %d", __func__, __LINE__);
+
+	/* Successful Test: the slots are added to the updated value */
+	err = rte_metrics_update_value(RTE_METRICS_GLOBAL, KEY, 100);
+	TEST_ASSERT(err >= 0, "%s, %d", __func__, __LINE__);
+	err = rte_metrics_get_values(RTE_METRICS_GLOBAL, after,
+			RTE_DIM(after));
+	TEST_ASSERT(err == count, "%s, %d", __func__, __LINE__);
+	TEST_ASSERT(after[KEY].value == expected - global_value + 100,
+			"%s, %d", __func__, __LINE__);
+
+	return TEST_SUCCESS;
+}
+
 static struct unit_test_suite metrics_testsuite  = {
 	.suite_name = "Metrics Unit Test Suite",
 	.setup = NULL,
@@ -313,7 +409,12 @@ static struct unit_test_suite metrics_testsuite  = {
 		 */
 		TEST_CASE(test_metrics_get_values),
 
-		/* TEST CASE 8: Test to unregister metrics*/
+		/* TEST CASE 8: Test to add to the per-lcore slots of a metric
+		 * and get them summed into the metric values
+		 */
+		TEST_CASE(test_metrics_lcore_slot),
+
+		/* TEST CASE 9: Test to unregister metrics*/
 		TEST_CASE(test_metrics_deinitialize),
 
 		TEST_CASES_END()
@@ -58,6 +58,82 @@ test_mp_secondary(void)
 
 #define launch_proc(ARGV) process_dup(ARGV, RTE_DIM(ARGV), __func__)
 
+/* Requests of the secondary process, echoed incremented by the primary. */
+#define MP_TEST_ECHO "mp_test_echo"
+#define MP_TEST_ECHO_FD "mp_test_echo_fd"
+#define MP_TEST_UNKNOWN "mp_test_unknown"
+#define MP_TEST_REQUESTS 100
+
+static int
+mp_test_echo(const struct rte_mp_msg *msg, const void *peer)
+{
+	struct rte_mp_msg reply;
+	uint32_t val;
+	int i, ret;
+
+	for (i = 0; i < msg->num_fds; i++)
+		close(msg->fds[i]);
+
+	if (msg->len_param != sizeof(val))
+		return -1;
+	memcpy(&val, msg->param, sizeof(val));
+	val++;
+
+	memset(&reply, 0, sizeof(reply));
+	strlcpy(reply.name, msg->name, sizeof(reply.name));
+	memcpy(reply.param, &val, sizeof(val));
+	reply.len_param = sizeof(val);
+
+	/* A reply with file descriptors goes over the socket. */
+	if (strcmp(msg->name, MP_TEST_ECHO_FD) == 0) {
+		reply.fds[0] = dup(STDOUT_FILENO);
+		if (reply.fds[0] < 0)
+			return -1;
+		reply.num_fds = 1;
+	}
+
+	ret = rte_mp_reply(&reply, peer);
+	if (reply.num_fds != 0)
+		close(reply.fds[0]);
+
+	return ret;
+}
+
+/* Send a synchronous request, return the echoed value or -1. */
+static int64_t
+mp_test_request(const char *name, uint32_t val, int with_fd, int *reply_fd)
+{
+	struct timespec ts = { .tv_sec = 5, .tv_nsec = 0 };
+	struct rte_mp_reply reply;
+	struct rte_mp_msg req;
+	int64_t ret = -1;
+	uint32_t echo;
+
+	memset(&req, 0, sizeof(req));
+	strlcpy(req.name, name, sizeof(req.name));
+	memcpy(req.param, &val, sizeof(val));
+	req.len_param = sizeof(val);
+	if (with_fd) {
+		req.fds[0] = STDOUT_FILENO;
+		req.num_fds = 1;
+	}
+
+	if (rte_mp_request_sync(&req, &reply, &ts) < 0)
+		return -1;
+
+	if (reply.nb_received == 1 &&
+	    reply.msgs[0].len_param == sizeof(echo)) {
+		memcpy(&echo, reply.msgs[0].param, sizeof(echo));
+		ret = echo;
+		if (reply_fd != NULL)
+			*reply_fd = reply.msgs[0].num_fds == 1 ?
+				reply.msgs[0].fds[0] : -1;
+	}
+	free(reply.msgs);
+
+	return ret;
+}
+
 /*
  * This function is called in the primary i.e. main test, to spawn off secondary
  * processes to run actual mp tests. Uses fork() and exec pair
@@ -98,6 +174,12 @@ run_secondary_instances(void)
 
 	snprintf(core_str, sizeof(core_str), "%u", rte_get_main_lcore());
 
+	if (rte_mp_action_register(MP_TEST_ECHO, mp_test_echo) < 0 ||
+	    rte_mp_action_register(MP_TEST_ECHO_FD, mp_test_echo) < 0) {
+		printf("Error: cannot register mp actions\n");
+		return -1;
+	}
+
 	ret |= launch_proc(argv1);
 	printf("### Testing rte_mp_disable() reject:\n");
 	if (rte_mp_disable()) {
@@ -113,9 +195,68 @@ run_secondary_instances(void)
 	ret |= !(launch_proc(argv4));
 #endif
 
+	rte_mp_action_unregister(MP_TEST_ECHO);
+	rte_mp_action_unregister(MP_TEST_ECHO_FD);
+
 	return ret;
 }
 
+/*
+ * This function is run in the secondary instance to test the synchronous
+ * requests to the primary, over shared memory or over the socket when
+ * file descriptors are passed
+ */
+static int
+run_mp_request_tests(void)
+{
+	struct timespec ts = { .tv_sec = 0, .tv_nsec = 100000000 };
+	struct rte_mp_reply reply;
+	struct rte_mp_msg req;
+	uint32_t i;
+	int fd;
+
+	printf("### Testing synchronous requests to primary\n");
+
+	for (i = 0; i < MP_TEST_REQUESTS; i++) {
+		if (mp_test_request(MP_TEST_ECHO, i, 0, NULL) != i + 1) {
+			printf("Error: wrong reply to request %u\n", i);
+			return -1;
+		}
+	}
+	printf("# Checked requests without file descriptor OK\n");
+
+	if (mp_test_request(MP_TEST_ECHO, i, 1, NULL) != i + 1) {
+		printf("Error: wrong reply to request with file descriptor\n");
+		return -1;
+	}
+	printf("# Checked request with file descriptor OK\n");
+
+	fd = -1;
+	if (mp_test_request(MP_TEST_ECHO_FD, i, 0, &fd) != i + 1 || fd < 0) {
+		printf("Error: wrong reply with file descriptor\n");
+		return -1;
+	}
+	close(fd);
+	printf("# Checked reply with file descriptor OK\n");
+
+	/* No action in the primary, no reply. */
+	memset(&req, 0, sizeof(req));
+	strlcpy(req.name, MP_TEST_UNKNOWN, sizeof(req.name));
+	rte_errno = 0;
+	if (rte_mp_request_sync(&req, &reply, &ts) == 0 || rte_errno != ETIMEDOUT) {
+		printf("Error: request without action not timed out\n");
+		free(reply.msgs);
+		return -1;
+	}
+	if (mp_test_request(MP_TEST_ECHO, 0, 0, NULL) != 1) {
+		printf("Error: wrong reply after timed out request\n");
+		return -1;
+	}
+	printf("# Checked request without action OK\n");
+
+	return 0;
+}
+
 /*
  * This function is run in the secondary instance to test that creation of
  * objects fails in a secondary
@@ -211,6 +352,9 @@ test_mp_secondary(void)
 
 	printf("IN SECONDARY PROCESS\n");
 
+	if (run_mp_request_tests() < 0)
+		return -1;
+
 	return run_object_creation_tests();
 }
 
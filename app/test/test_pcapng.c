@@ -382,8 +382,9 @@ test_add_interface(void)
 	return -1;
 }
 
+/* Write packets to a capture file, through a buffer if buf_size is not 0 */
 static int
-test_write_packets(void)
+write_packets(uint32_t buf_size)
 {
 	char file_name[] = "/tmp/pcapng_test_XXXXXX.pcapng";
 	static rte_pcapng_t *pcapng;
@@ -398,7 +399,11 @@ test_write_packets(void)
 	printf("pcapng: output file %s\n", file_name);
 
 	/* open a test capture file */
-	pcapng = rte_pcapng_fdopen(tmp_fd, NULL, NULL, "pcapng_test", NULL);
+	if (buf_size != 0)
+		pcapng = rte_pcapng_fdopen_buffered(tmp_fd, buf_size, 0,
+						    NULL, NULL, "pcapng_test", NULL);
+	else
+		pcapng = rte_pcapng_fdopen(tmp_fd, NULL, NULL, "pcapng_test", NULL);
 	if (pcapng == NULL) {
 		fprintf(stderr, "rte_pcapng_fdopen failed\n");
 		close(tmp_fd);
@@ -439,6 +444,19 @@ test_write_packets(void)
 	return -1;
 }
 
+static int
+test_write_packets(void)
+{
+	return write_packets(0);
+}
+
+static int
+test_write_packets_buffered(void)
+{
+	/* smaller than the packets written to test the buffer wrap */
+	return write_packets(16 * 1024);
+}
+
 static void
 test_cleanup(void)
 {
@@ -454,6 +472,7 @@ unit_test_suite test_pcapng_suite  = {
 	.unit_test_cases = {
 		TEST_CASE(test_add_interface),
 		TEST_CASE(test_write_packets),
+		TEST_CASE(test_write_packets_buffered),
 		TEST_CASES_END()
 	}
 };
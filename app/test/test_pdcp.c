@@ -12,6 +12,7 @@
 #include <rte_pdcp.h>
 #include <rte_pdcp_hdr.h>
 #include <rte_timer.h>
+#include <rte_timer_wheel.h>
 
 #include "test.h"
 #include "test_cryptodev.h"
@@ -1807,6 +1808,99 @@ test_expiry_with_rte_timer(const struct pdcp_test_conf *ul_conf)
 	return ret;
 }
 
+static void
+test_timer_wheel_expiry_handle(struct rte_timer_wheel_timer **timers, unsigned int nb_timers,
+			       void *arg)
+{
+	struct test_rte_timer_args *timer_data = arg;
+	struct rte_mbuf *out_mb[1] = {0};
+	unsigned int i;
+	uint16_t n;
+
+	for (i = 0; i < nb_timers; i++) {
+		/* The timer of the PDCP library has the entity as argument */
+		n = rte_pdcp_t_reordering_expiry_handle(timers[i]->arg, out_mb);
+		rte_pktmbuf_free_bulk(out_mb, n);
+
+		timer_data->status = timers[i]->arg == timer_data->pdcp_entity && n == 1 ? n : -1;
+	}
+}
+
+static int
+test_expiry_with_timer_wheel(const struct pdcp_test_conf *ul_conf)
+{
+	const enum rte_security_pdcp_sn_size sn_size = ul_conf->entity.pdcp_xfrm.sn_size;
+	struct rte_mbuf *m1 = NULL, *out_mb[1] = {0};
+	uint16_t n = 0, nb_err = 0, nb_try = 100;
+	struct test_rte_timer_args timer_args;
+	struct rte_timer_wheel_params params = {
+		.name = "pdcp_t_reordering",
+		.socket_id = SOCKET_ID_ANY,
+		.tick_ns = 10000, /* 10 us */
+		.expire_cb = test_timer_wheel_expiry_handle,
+		.expire_cb_arg = &timer_args,
+	};
+	struct rte_pdcp_entity *pdcp_entity;
+	struct rte_timer_wheel *tw;
+	struct pdcp_test_conf dl_conf;
+	int ret = TEST_FAILED, nb_out;
+
+	const int start_count = 0;
+
+	if (ul_conf->entity.pdcp_xfrm.pkt_dir == RTE_SECURITY_PDCP_DOWNLINK)
+		return TEST_SKIPPED;
+
+	tw = rte_timer_wheel_create(&params);
+	if (tw == NULL)
+		return TEST_FAILED;
+
+	/* Create configuration for actual testing */
+	uplink_to_downlink_convert(ul_conf, &dl_conf);
+	dl_conf.entity.pdcp_xfrm.hfn = pdcp_hfn_from_count_get(start_count, sn_size);
+	dl_conf.entity.sn = pdcp_sn_from_count_get(start_count, sn_size);
+	dl_conf.entity.t_reordering.wheel = tw;
+	dl_conf.entity.t_reordering.wheel_ticks = 1;
+
+	pdcp_entity = test_entity_create(&dl_conf, &ret);
+	if (pdcp_entity == NULL) {
+		rte_timer_wheel_free(tw);
+		return ret;
+	}
+
+	timer_args.status = 0;
+	timer_args.pdcp_entity = pdcp_entity;
+
+	/* Send packet with SN > RX_DELIV to create a gap */
+	m1 = generate_packet_for_dl_with_sn(*ul_conf, start_count + 1);
+	ASSERT_TRUE_OR_GOTO(m1 != NULL, exit, "Could not allocate buffer for packet\n");
+
+	/* Buffered packets after insert [NULL, m1] */
+	n = test_process_packets(pdcp_entity, dl_conf.entity.dev_id, &m1, 1, out_mb, &nb_err);
+	ASSERT_TRUE_OR_GOTO(nb_err == 0, exit, "Error occurred during packet buffering\n");
+	ASSERT_TRUE_OR_GOTO(n == 0, exit, "Packet was not buffered as expected\n");
+
+	m1 = NULL; /* Packet was moved to PDCP lib */
+
+	/* Verify that expire was handled correctly */
+	rte_timer_wheel_manage(tw);
+	while (timer_args.status != 1) {
+		rte_delay_us(10);
+		rte_timer_wheel_manage(tw);
+		ASSERT_TRUE_OR_GOTO(nb_try > 0, exit, "Bad expire handle status %i\n",
+			timer_args.status);
+		nb_try--;
+	}
+
+	ret = TEST_SUCCESS;
+exit:
+	rte_pktmbuf_free(m1);
+	rte_pktmbuf_free_bulk(out_mb, n);
+	nb_out = rte_pdcp_entity_release(pdcp_entity, out_mb);
+	rte_pktmbuf_free_bulk(out_mb, nb_out);
+	rte_timer_wheel_free(tw);
+	return ret;
+}
+
 static struct rte_pdcp_up_ctrl_pdu_hdr *
 pdcp_status_report_init(uint32_t fmc)
 {
@@ -2069,6 +2163,82 @@ test_combined(struct pdcp_test_conf *ul_conf)
 	return ret;
 }
 
+#define NB_MULTI_PKTS 4
+
+static int
+test_pre_process_multi(struct pdcp_test_conf *ul_conf)
+{
+	const struct rte_pdcp_entity *en[NB_MULTI_PKTS];
+	struct rte_mbuf *mb[NB_MULTI_PKTS], *pkts[NB_MULTI_PKTS] = {0};
+	struct rte_mbuf *in_mb[NB_MULTI_PKTS], *out_mb[NB_MULTI_PKTS];
+	struct rte_crypto_op *cop[NB_MULTI_PKTS];
+	struct rte_pdcp_entity *pdcp_entity[2] = {0};
+	const uint8_t cdev_id = ul_conf->entity.dev_id;
+	struct rte_pdcp_group grp[NB_MULTI_PKTS];
+	uint16_t i, nb_cop, nb_grp, nb_err = 0, nb_out;
+	int ret = TEST_FAILED;
+
+	if (ul_conf->entity.pdcp_xfrm.pkt_dir == RTE_SECURITY_PDCP_DOWNLINK)
+		return TEST_SKIPPED;
+
+	for (i = 0; i < RTE_DIM(pdcp_entity); i++) {
+		pdcp_entity[i] = test_entity_create(ul_conf, &ret);
+		if (pdcp_entity[i] == NULL)
+			goto exit;
+	}
+	ret = TEST_FAILED;
+
+	/* Interleave the packets of the two entities */
+	for (i = 0; i < NB_MULTI_PKTS; i++) {
+		pkts[i] = mbuf_from_data_create(ul_conf->input, ul_conf->input_len);
+		ASSERT_TRUE_OR_GOTO(pkts[i] != NULL, exit, "Could not allocate buffer for packet\n");
+		mb[i] = pkts[i];
+		en[i] = pdcp_entity[i % 2];
+	}
+
+	nb_cop = rte_pdcp_pkt_pre_process_multi(en, mb, cop, NB_MULTI_PKTS, &nb_err);
+	ASSERT_TRUE_OR_GOTO(nb_cop == NB_MULTI_PKTS && nb_err == 0, exit,
+			"Could not pre process PDCP packets\n");
+
+	/* The crypto ops are grouped by entity, in the order of the packets */
+	for (i = 0; i < NB_MULTI_PKTS; i++) {
+		ASSERT_TRUE_OR_GOTO(rte_pdcp_en_from_cop(cop[i]) == pdcp_entity[i / 2], exit,
+				"Crypto op %u not grouped by entity\n", i);
+		ASSERT_TRUE_OR_GOTO(cop[i]->sym->m_src == pkts[(i % 2) * 2 + i / 2], exit,
+				"Crypto op %u not in the order of the packets\n", i);
+	}
+
+	for (i = 0; i < NB_MULTI_PKTS; i++)
+		ASSERT_TRUE_OR_GOTO(process_crypto_request(cdev_id, cop[i]) != NULL, exit,
+				"Could not process crypto request\n");
+
+	nb_grp = rte_pdcp_pkt_crypto_group(cop, in_mb, grp, NB_MULTI_PKTS);
+	ASSERT_TRUE_OR_GOTO(nb_grp == 2, exit, "Unexpected number of groups: %u\n", nb_grp);
+
+	for (i = 0; i < nb_grp; i++) {
+		ASSERT_TRUE_OR_GOTO(grp[i].id.ptr == pdcp_entity[i] && grp[i].cnt == 2, exit,
+				"Unexpected group %u\n", i);
+		nb_out = rte_pdcp_pkt_post_process(grp[i].id.ptr, grp[i].m, out_mb, grp[i].cnt,
+				&nb_err);
+		ASSERT_TRUE_OR_GOTO(nb_out == 2 && nb_err == 0, exit,
+				"Could not post process PDCP packets\n");
+
+		/* The first packet of each entity has the SN of the known vector */
+		if (ul_conf->output_len && pdcp_known_vec_verify(out_mb[0], ul_conf->output,
+				ul_conf->output_len))
+			goto exit;
+	}
+
+	ret = TEST_SUCCESS;
+exit:
+	for (i = 0; i < NB_MULTI_PKTS; i++)
+		rte_pktmbuf_free(pkts[i]);
+	for (i = 0; i < RTE_DIM(pdcp_entity); i++)
+		if (pdcp_entity[i] != NULL)
+			rte_pdcp_entity_release(pdcp_entity[i], NULL);
+	return ret;
+}
+
 #define MIN_DATA_LEN 0
 #define MAX_DATA_LEN 9000
 
@@ -2239,6 +2409,9 @@ static struct unit_test_suite combined_mode_cases  = {
 		TEST_CASE_NAMED_WITH_DATA("combined mode data walkthrough",
 			ut_setup_pdcp, ut_teardown_pdcp,
 			run_test_with_all_known_vec, test_combined_data_walkthrough),
+		TEST_CASE_NAMED_WITH_DATA("multi entity pre process",
+			ut_setup_pdcp, ut_teardown_pdcp,
+			run_test_with_all_known_vec, test_pre_process_multi),
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
 };
@@ -2279,6 +2452,10 @@ static struct unit_test_suite reorder_test_cases  = {
 			ut_setup_pdcp, ut_teardown_pdcp,
 			run_test_with_all_known_vec_until_first_pass,
 			test_expiry_with_rte_timer),
+		TEST_CASE_NAMED_WITH_DATA("test_expire_with_timer_wheel",
+			ut_setup_pdcp, ut_teardown_pdcp,
+			run_test_with_all_known_vec_until_first_pass,
+			test_expiry_with_timer_wheel),
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
 };
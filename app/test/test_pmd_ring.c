@@ -6,6 +6,7 @@
 
 #include <stdio.h>
 
+#include <rte_cycles.h>
 #include <rte_eth_ring.h>
 #include <rte_ethdev.h>
 #include <rte_bus_vdev.h>
@@ -96,6 +97,185 @@ test_send_basic_packets(void)
 	return TEST_SUCCESS;
 }
 
+static int
+test_rx_peek_packets(void)
+{
+	struct rte_mbuf  bufs[RING_SIZE];
+	struct rte_mbuf *pbufs[RING_SIZE];
+	struct rte_ring_zc_data zcd;
+	struct rte_mbuf **peeked;
+	int i, n;
+
+	printf("Testing peek at RING_SIZE/2 packets (tx_porta -> rx_portb)\n");
+
+	for (i = 0; i < RING_SIZE/2; i++)
+		pbufs[i] = &bufs[i];
+
+	if (rte_eth_tx_burst(tx_porta, 0, pbufs, RING_SIZE/2) < RING_SIZE/2) {
+		printf("Failed to transmit packet burst port %d\n", tx_porta);
+		return TEST_FAILED;
+	}
+
+	n = rte_eth_ring_rx_peek(rx_portb, 0, &zcd, RING_SIZE);
+	TEST_ASSERT_EQUAL(n, RING_SIZE/2, "Failed to peek at packets on port %d",
+			rx_portb);
+	for (i = 0; i < n; i++) {
+		peeked = i < (int)zcd.n1 ? &((struct rte_mbuf **)zcd.ptr1)[i] :
+				&((struct rte_mbuf **)zcd.ptr2)[i - zcd.n1];
+		if (*peeked != &bufs[i]) {
+			rte_eth_ring_rx_peek_finish(rx_portb, 0, 0);
+			printf("Error: peeked data does not match that transmitted\n");
+			return TEST_FAILED;
+		}
+	}
+
+	/* dequeue only the first half, the second half is received */
+	rte_eth_ring_rx_peek_finish(rx_portb, 0, RING_SIZE/4);
+
+	if (rte_eth_rx_burst(rx_portb, 0, pbufs, RING_SIZE) != RING_SIZE/4) {
+		printf("Failed to receive packet burst on port %d\n", rx_portb);
+		return TEST_FAILED;
+	}
+
+	for (i = 0; i < RING_SIZE/4; i++)
+		if (pbufs[i] != &bufs[RING_SIZE/4 + i]) {
+			printf("Error: received data does not match that transmitted\n");
+			return TEST_FAILED;
+		}
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_rx_burst_adaptive(void)
+{
+	static const uint16_t exp_rx[] = { 8, 16, 32, 64, 8, 0 };
+	static const uint16_t exp_burst[] = { 16, 32, 64, 64, 32, 16 };
+	struct rte_mbuf  bufs[RING_SIZE];
+	struct rte_mbuf *pbufs[RING_SIZE];
+	struct rte_eth_rx_burst_adapt adapt;
+	unsigned int i;
+	uint16_t nb_rx;
+
+	printf("Testing adaptive Rx burst of RING_SIZE/2 packets (tx_porta -> rx_portb)\n");
+
+	/* The ring PMD has no pending hint, the burst size follows the bursts */
+	TEST_ASSERT_EQUAL(rte_eth_rx_queue_pending(rx_portb, 0), -ENOTSUP,
+			"Unexpected Rx pending hint on port %d", rx_portb);
+
+	for (i = 0; i < RING_SIZE/2; i++)
+		pbufs[i] = &bufs[i];
+
+	if (rte_eth_tx_burst(tx_porta, 0, pbufs, RING_SIZE/2) < RING_SIZE/2) {
+		printf("Failed to transmit packet burst port %d\n", tx_porta);
+		return TEST_FAILED;
+	}
+
+	/* Doubled after each full burst, halved after a less than half one */
+	rte_eth_rx_burst_adapt_init(&adapt, 8, 64);
+	for (i = 0; i < RTE_DIM(exp_rx); i++) {
+		nb_rx = rte_eth_rx_burst_adaptive(rx_portb, 0, pbufs, &adapt);
+		TEST_ASSERT_EQUAL(nb_rx, exp_rx[i],
+				"Burst %u received %u packets", i, nb_rx);
+		TEST_ASSERT_EQUAL(adapt.cur_burst, exp_burst[i],
+				"Burst %u set next burst size to %u",
+				i, adapt.cur_burst);
+	}
+
+	return TEST_SUCCESS;
+}
+
+static unsigned int tx_batch_unsent;
+
+static void
+tx_batch_count_unsent(struct rte_mbuf **unsent __rte_unused, uint16_t count,
+		void *userdata __rte_unused)
+{
+	tx_batch_unsent += count;
+}
+
+static int
+test_tx_batch(void)
+{
+	struct rte_mbuf  bufs[RING_SIZE];
+	struct rte_mbuf *pbufs[RING_SIZE];
+	struct rte_eth_tx_batch *batch;
+	unsigned int lcore_id = rte_lcore_id();
+	uint16_t sent;
+	int i;
+
+	printf("Testing Tx batch of RING_SIZE/8 packets (tx_porta -> rx_portb)\n");
+
+	for (i = 0; i < RING_SIZE; i++)
+		pbufs[i] = &bufs[i];
+
+	batch = rte_eth_tx_batch_create(tx_porta, 0, lcore_id, RING_SIZE/8, 0);
+	TEST_ASSERT_NOT_NULL(batch, "Failed to create Tx batch on port %d",
+			tx_porta);
+	TEST_ASSERT(!batch->deferred, "Ring PMD Tx doorbell deferred");
+	TEST_ASSERT_NULL(rte_eth_tx_batch_create(tx_porta, 0, lcore_id,
+			RING_SIZE/8, 0), "Created a second Tx batch");
+	TEST_ASSERT_EQUAL(rte_errno, EEXIST, "Wrong error for a second Tx batch");
+	TEST_ASSERT(rte_eth_tx_batch_lookup(tx_porta, 0) == batch,
+			"Failed to look up Tx batch");
+	TEST_ASSERT_NULL(rte_eth_tx_batch_lookup(rx_portb, 0),
+			"Looked up a Tx batch of another port");
+	TEST_ASSERT_SUCCESS(rte_eth_tx_batch_set_err_callback(batch,
+			tx_batch_count_unsent, NULL),
+			"Failed to set Tx batch error callback");
+
+	/* Pending until the batch is full, then flushed in order */
+	sent = rte_eth_tx_batch(batch, pbufs, RING_SIZE/16);
+	TEST_ASSERT_EQUAL(sent, 0, "Sent %u packets before the batch is full", sent);
+	TEST_ASSERT_EQUAL(rte_eth_rx_burst(rx_portb, 0, pbufs, RING_SIZE), 0,
+			"Received packets before the batch is full");
+	for (i = 0; i < RING_SIZE/16; i++)
+		pbufs[i] = &bufs[i];
+	sent = rte_eth_tx_batch(batch, &pbufs[RING_SIZE/16], RING_SIZE/8);
+	TEST_ASSERT_EQUAL(sent, RING_SIZE/8, "Sent %u packets on full batch", sent);
+	TEST_ASSERT_EQUAL(batch->length, RING_SIZE/16, "Wrong pending packets");
+	TEST_ASSERT_EQUAL(rte_eth_tx_batch_flush(batch), RING_SIZE/16,
+			"Failed to flush Tx batch");
+	TEST_ASSERT_EQUAL(rte_eth_rx_burst(rx_portb, 0, pbufs, RING_SIZE),
+			RING_SIZE/8 + RING_SIZE/16, "Failed to receive Tx batch");
+	for (i = 0; i < RING_SIZE/8 + RING_SIZE/16; i++)
+		TEST_ASSERT(pbufs[i] == &bufs[i],
+				"Received data does not match that transmitted");
+
+	/* The packets not fitting in the Tx ring go to the error callback */
+	for (i = 0; i < RING_SIZE; i++)
+		pbufs[i] = &bufs[i];
+	tx_batch_unsent = 0;
+	sent = rte_eth_tx_batch(batch, pbufs, RING_SIZE);
+	TEST_ASSERT_EQUAL(sent, RING_SIZE - 1, "Sent %u packets to a full ring", sent);
+	TEST_ASSERT_EQUAL(tx_batch_unsent, 1, "Got %u unsent packets",
+			tx_batch_unsent);
+	TEST_ASSERT_EQUAL(rte_eth_rx_burst(rx_portb, 0, pbufs, RING_SIZE),
+			RING_SIZE - 1, "Failed to drain the ring");
+	rte_eth_tx_batch_free(batch);
+	TEST_ASSERT_NULL(rte_eth_tx_batch_lookup(tx_porta, 0),
+			"Looked up a freed Tx batch");
+
+	/* Pending packets are flushed by the poll once the timeout expired */
+	batch = rte_eth_tx_batch_create(tx_porta, 0, lcore_id, RING_SIZE/8,
+			10 * 1000);
+	TEST_ASSERT_NOT_NULL(batch, "Failed to create Tx batch with timeout");
+	for (i = 0; i < RING_SIZE/16; i++)
+		pbufs[i] = &bufs[i];
+	sent = rte_eth_tx_batch(batch, pbufs, RING_SIZE/16);
+	TEST_ASSERT_EQUAL(sent, 0, "Sent %u packets before the batch is full", sent);
+	TEST_ASSERT_EQUAL(rte_eth_tx_batch_poll(), 0,
+			"Flushed Tx batch before its timeout");
+	rte_delay_us(20 * 1000);
+	TEST_ASSERT_EQUAL(rte_eth_tx_batch_poll(), RING_SIZE/16,
+			"Failed to flush Tx batch on timeout");
+	TEST_ASSERT_EQUAL(rte_eth_rx_burst(rx_portb, 0, pbufs, RING_SIZE),
+			RING_SIZE/16, "Failed to receive Tx batch");
+	rte_eth_tx_batch_free(batch);
+
+	return TEST_SUCCESS;
+}
+
 static int
 test_send_basic_packets_port(int port)
 {
@@ -579,6 +759,9 @@ unit_test_suite test_pmd_ring_suite  = {
 	.unit_test_cases = {
 		TEST_CASE(test_ethdev_configure_ports),
 		TEST_CASE(test_send_basic_packets),
+		TEST_CASE(test_rx_peek_packets),
+		TEST_CASE(test_rx_burst_adaptive),
+		TEST_CASE(test_tx_batch),
 		TEST_CASE(test_get_stats_for_port),
 		TEST_CASE(test_stats_reset_for_port),
 		TEST_CASE(test_pmd_ring_pair_create_attach),
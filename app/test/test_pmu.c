@@ -36,12 +36,65 @@ test_pmu_read(void)
 	return val ? TEST_SUCCESS : TEST_FAILED;
 }
 
+static int
+test_pmu_read_group(void)
+{
+#ifdef RTE_PMU_EVENT_CYCLES
+	const char *names[] = { RTE_PMU_EVENT_INSTRUCTIONS, RTE_PMU_EVENT_CYCLES };
+	uint64_t values[RTE_DIM(names)] = { 0 }, tsc = 0;
+	uint64_t pub[RTE_DIM(names)];
+	int event, tries = 10;
+	unsigned int i;
+
+	if (rte_pmu_init() < 0)
+		return TEST_FAILED;
+
+	for (i = 0; i < RTE_DIM(names); i++) {
+		event = rte_pmu_add_event(names[i]);
+		if (event != (int)i)
+			goto fail;
+	}
+
+	while (tries--) {
+		if (rte_pmu_read_group(values, RTE_DIM(values)) != RTE_DIM(values))
+			goto fail;
+	}
+	if (values[0] == 0 || values[1] == 0)
+		goto fail;
+
+	/* nothing published yet */
+	if (rte_pmu_lcore_read(rte_lcore_id(), &tsc, pub, RTE_DIM(pub)) != 0)
+		goto fail;
+
+	rte_pmu_publish();
+	if (rte_pmu_lcore_read(rte_lcore_id(), &tsc, pub, RTE_DIM(pub)) !=
+			RTE_DIM(pub) || tsc == 0)
+		goto fail;
+	/* counters only increase */
+	if (pub[0] < values[0] || pub[1] < values[1])
+		goto fail;
+
+	rte_pmu_fini();
+
+	return TEST_SUCCESS;
+fail:
+	rte_pmu_fini();
+
+	return TEST_FAILED;
+#else
+	printf("PMU not supported on this arch\n");
+
+	return TEST_SKIPPED;
+#endif
+}
+
 static struct unit_test_suite pmu_tests = {
 	.suite_name = "PMU autotest",
 	.setup = NULL,
 	.teardown = NULL,
 	.unit_test_cases = {
 		TEST_CASE(test_pmu_read),
+		TEST_CASE(test_pmu_read_group),
 		TEST_CASES_END()
 	}
 };
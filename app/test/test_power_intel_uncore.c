@@ -14,6 +14,9 @@ test_power_intel_uncore(void)
 }
 
 #else
+#include <errno.h>
+#include <string.h>
+
 #include <rte_power_uncore.h>
 #include <power_common.h>
 
@@ -216,6 +219,47 @@ check_power_uncore_get_num_dies(void)
 	return 0;
 }
 
+static int
+check_power_uncore_auto(void)
+{
+	struct rte_power_uncore_auto_conf conf = {
+		.miss_high = 1,
+		.miss_low = 2,
+	};
+	int ret;
+
+	/* Unsuccessful Test */
+	ret = rte_power_uncore_auto_start(&conf);
+	if (ret != -EINVAL) {
+		printf("Unexpectedly started uncore auto tuning with invalid thresholds\n");
+		return -1;
+	}
+
+	/* PMU events may not be available, e.g. in a VM */
+	memset(&conf, 0, sizeof(conf));
+	ret = rte_power_uncore_auto_start(&conf);
+	if (ret < 0) {
+		printf("Uncore auto tuning not available, skipping: %d\n", ret);
+		return 0;
+	}
+
+	rte_power_uncore_auto_update();
+	ret = rte_power_uncore_auto_start(&conf);
+	if (ret != -EBUSY) {
+		printf("Unexpectedly started uncore auto tuning twice\n");
+		rte_power_uncore_auto_stop();
+		return -1;
+	}
+
+	ret = rte_power_uncore_auto_stop();
+	if (ret < 0) {
+		printf("Failed to stop uncore auto tuning\n");
+		return -1;
+	}
+
+	return 0;
+}
+
 static int
 check_power_uncore_exit(void)
 {
@@ -291,6 +335,10 @@ test_power_intel_uncore(void)
 	if (ret < 0)
 		goto fail_all;
 
+	ret = check_power_uncore_auto();
+	if (ret < 0)
+		goto fail_all;
+
 	ret = check_power_uncore_exit();
 	if (ret < 0)
 		return -1;
@@ -11,6 +11,7 @@
 #include <rte_malloc.h>
 #include <rte_cycles.h>
 #include <rte_random.h>
+#include <rte_service.h>
 #include <unistd.h>
 
 #include "test.h"
@@ -927,6 +928,87 @@ test_rcu_qsbr_dq_functional(int32_t size, int32_t esize, uint32_t flags)
 	return -1;
 }
 
+/*
+ * Per lcore defer queues: bounded by waiting for the grace period when
+ * full, and reclaimed by a service.
+ */
+static int
+test_rcu_qsbr_dq_service(void)
+{
+	struct rte_rcu_qsbr_dq_parameters params;
+	struct rte_rcu_qsbr_dq *dq;
+	unsigned int freed, pending;
+	uint32_t service_id;
+	uint64_t e = 1;
+	unsigned int i;
+	int ret;
+
+	printf("\nTest rte_rcu_qsbr_dq_service_register()\n");
+
+	cb_failed = 0;
+	rte_rcu_qsbr_init(t[0], RTE_MAX_LCORE);
+
+	memset(&params, 0, sizeof(struct rte_rcu_qsbr_dq_parameters));
+	params.name = "TEST_RCU_SVC";
+	params.flags = RTE_RCU_QSBR_DQ_LCORE | RTE_RCU_QSBR_DQ_WAIT_ON_FULL;
+	params.free_fn = test_rcu_qsbr_free_resource2;
+	params.v = t[0];
+	params.size = 8;
+	params.esize = sizeof(e);
+	params.trigger_reclaim_limit = params.size + 1;
+	params.max_reclaim_size = 1;
+	dq = rte_rcu_qsbr_dq_create(&params);
+	TEST_RCU_QSBR_RETURN_IF_ERROR((dq == NULL), "dq create valid params");
+
+	ret = rte_rcu_qsbr_dq_service_register(NULL, &service_id);
+	TEST_RCU_QSBR_GOTO_IF_ERROR(end, (ret == 0), "NULL dq service");
+	ret = rte_rcu_qsbr_dq_service_register(dq, &service_id);
+	TEST_RCU_QSBR_GOTO_IF_ERROR(end, (ret != 0), "dq service register");
+	ret = rte_rcu_qsbr_dq_service_register(dq, &service_id);
+	TEST_RCU_QSBR_GOTO_IF_ERROR(end, (ret == 0), "dq service registered twice");
+	rte_service_runstate_set(service_id, 1);
+
+	/* A reader holds the resources until it reports its quiescent state */
+	rte_rcu_qsbr_thread_register(t[0], 1);
+	rte_rcu_qsbr_thread_online(t[0], 1);
+	for (i = 0; i < params.size; i++) {
+		ret = rte_rcu_qsbr_dq_enqueue(dq, &e);
+		TEST_RCU_QSBR_GOTO_IF_ERROR(end, (ret != 0),
+			"dq enqueue functional, i = %u", i);
+	}
+	rte_service_run_iter_on_app_lcore(service_id, 1);
+	rte_rcu_qsbr_dq_reclaim(dq, 1, &freed, &pending, NULL);
+	TEST_RCU_QSBR_GOTO_IF_ERROR(end, (freed != 0 || pending != 8),
+		"reclaimed before quiescent state, pending = %u", pending);
+
+	rte_rcu_qsbr_quiescent(t[0], 1);
+	rte_service_run_iter_on_app_lcore(service_id, 1);
+	rte_rcu_qsbr_dq_reclaim(dq, 1, &freed, &pending, NULL);
+	TEST_RCU_QSBR_GOTO_IF_ERROR(end, (pending != 0),
+		"service did not reclaim, pending = %u", pending);
+
+	/* The enqueue on a full queue waits for the offline reader */
+	rte_rcu_qsbr_thread_offline(t[0], 1);
+	for (i = 0; i < 4 * params.size; i++) {
+		ret = rte_rcu_qsbr_dq_enqueue(dq, &e);
+		TEST_RCU_QSBR_GOTO_IF_ERROR(end, (ret != 0),
+			"dq enqueue on full queue, i = %u", i);
+	}
+	rte_rcu_qsbr_thread_unregister(t[0], 1);
+
+	TEST_RCU_QSBR_GOTO_IF_ERROR(end, (cb_failed == 1), "CB failed");
+
+	ret = rte_rcu_qsbr_dq_delete(dq);
+	TEST_RCU_QSBR_RETURN_IF_ERROR((ret != 0), "dq delete valid params");
+
+	return 0;
+
+end:
+	rte_rcu_qsbr_thread_unregister(t[0], 1);
+	rte_rcu_qsbr_dq_delete(dq);
+	return -1;
+}
+
 /*
  * rte_rcu_qsbr_dump: Dump status of a single QS variable to a file
  */
@@ -1407,6 +1489,12 @@ test_rcu_qsbr_main(void)
 	if (test_rcu_qsbr_dq_functional(7, 128, RTE_RCU_QSBR_DQ_MT_UNSAFE) < 0)
 		goto test_fail;
 
+	if (test_rcu_qsbr_dq_functional(303, 16, RTE_RCU_QSBR_DQ_LCORE) < 0)
+		goto test_fail;
+
+	if (test_rcu_qsbr_dq_service() < 0)
+		goto test_fail;
+
 	free_rcu();
 
 	printf("\n");
@@ -489,6 +489,113 @@ test_reorder_set_seqn(void)
 	return ret;
 }
 
+static int
+test_reorder_insert_mp(void)
+{
+#define INSERT_MP_NUM_BUFS 7u
+
+	struct rte_mempool *p = test_params->p;
+	struct rte_reorder_buffer *b = NULL;
+	struct rte_mbuf *bufs[INSERT_MP_NUM_BUFS];
+	struct rte_mbuf *robufs[INSERT_MP_NUM_BUFS];
+	const unsigned int size = 4;
+	unsigned int i, cnt;
+	int ret = 0;
+
+	memset(bufs, 0, sizeof(bufs));
+	b = rte_reorder_create("test_insert_mp", rte_socket_id(), size);
+	TEST_ASSERT_NOT_NULL(b, "Failed to create reorder buffer");
+
+	for (i = 0; i < INSERT_MP_NUM_BUFS; i++) {
+		bufs[i] = rte_pktmbuf_alloc(p);
+		if (bufs[i] == NULL) {
+			printf("Packet allocation failed\n");
+			ret = -1;
+			goto exit;
+		}
+		*rte_reorder_seqn(bufs[i]) = i;
+	}
+
+	/* the minimum sequence number must be set first */
+	ret = rte_reorder_insert_mp(b, bufs[0]);
+	if (ret != -1 || rte_errno != EINVAL) {
+		printf("%s:%d: Insertion without min seq number\n", __func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+	rte_reorder_min_seqn_set(b, 0);
+
+	/* insert 1, 0, 3: drain returns 0, 1 and stops at missing 2 */
+	if (rte_reorder_insert_mp(b, bufs[1]) != 0 ||
+			rte_reorder_insert_mp(b, bufs[0]) != 0 ||
+			rte_reorder_insert_mp(b, bufs[3]) != 0) {
+		printf("%s:%d: Error inserting packets\n", __func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+	bufs[0] = bufs[1] = bufs[3] = NULL;
+	cnt = rte_reorder_drain_mp(b, robufs, INSERT_MP_NUM_BUFS);
+	if (cnt != 2 || *rte_reorder_seqn(robufs[0]) != 0 ||
+			*rte_reorder_seqn(robufs[1]) != 1) {
+		printf("%s:%d: Error draining packets\n", __func__, __LINE__);
+		rte_pktmbuf_free_bulk(robufs, cnt);
+		ret = -1;
+		goto exit;
+	}
+	rte_pktmbuf_free_bulk(robufs, cnt);
+
+	/* 6 is beyond the window: the drain skips 2 to make room */
+	ret = rte_reorder_insert_mp(b, bufs[6]);
+	if (ret != -1 || rte_errno != ENOSPC) {
+		printf("%s:%d: Early packet not rejected\n", __func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+	cnt = rte_reorder_drain_mp(b, robufs, INSERT_MP_NUM_BUFS);
+	if (cnt != 1 || *rte_reorder_seqn(robufs[0]) != 3) {
+		printf("%s:%d: Error draining packets\n", __func__, __LINE__);
+		rte_pktmbuf_free_bulk(robufs, cnt);
+		ret = -1;
+		goto exit;
+	}
+	rte_pktmbuf_free_bulk(robufs, cnt);
+
+	/* 2 was skipped, 6 takes its entry in the next lap */
+	ret = rte_reorder_insert_mp(b, bufs[2]);
+	if (ret != -1 || rte_errno != ERANGE) {
+		printf("%s:%d: Skipped packet not rejected\n", __func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+	if (rte_reorder_insert_mp(b, bufs[6]) != 0 ||
+			rte_reorder_insert_mp(b, bufs[5]) != 0 ||
+			rte_reorder_insert_mp(b, bufs[4]) != 0) {
+		printf("%s:%d: Error inserting packets\n", __func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+	bufs[4] = bufs[5] = bufs[6] = NULL;
+	cnt = rte_reorder_drain_mp(b, robufs, INSERT_MP_NUM_BUFS);
+	for (i = 0; i < cnt; i++) {
+		if (*rte_reorder_seqn(robufs[i]) != 4 + i)
+			break;
+	}
+	rte_pktmbuf_free_bulk(robufs, cnt);
+	if (cnt != 3 || i != cnt) {
+		printf("%s:%d: Error draining packets\n", __func__, __LINE__);
+		ret = -1;
+		goto exit;
+	}
+
+	ret = 0;
+exit:
+	rte_reorder_free(b);
+	for (i = 0; i < INSERT_MP_NUM_BUFS; i++)
+		rte_pktmbuf_free(bufs[i]);
+
+	return ret;
+}
+
 static int
 test_setup(void)
 {
@@ -541,6 +648,7 @@ static struct unit_test_suite reorder_test_suite  = {
 		TEST_CASE(test_reorder_drain),
 		TEST_CASE(test_reorder_drain_up_to_seqn),
 		TEST_CASE(test_reorder_set_seqn),
+		TEST_CASE(test_reorder_insert_mp),
 		TEST_CASES_END()
 	}
 };
@@ -1197,6 +1197,87 @@ test_ring_with_exact_size(void)
 	return -1;
 }
 
+/*
+ * Dequeue from a set of rings, with and without doorbell.
+ */
+#define MULTI_NB_RINGS 4
+static int
+test_ring_dequeue_multi(void)
+{
+	struct rte_ring *rings[MULTI_NB_RINGS] = {NULL};
+	struct rte_ring_doorbell db;
+	uintptr_t obj, objs[MULTI_NB_RINGS * 4];
+	unsigned int i, n, pos;
+
+	printf("Test multi-ring dequeue\n");
+
+	for (i = 0; i < MULTI_NB_RINGS; i++) {
+		char name[RTE_RING_NAMESIZE];
+
+		snprintf(name, sizeof(name), "multi%u", i);
+		rings[i] = rte_ring_create(name, 16, SOCKET_ID_ANY,
+				RING_F_SP_ENQ | RING_F_SC_DEQ);
+		if (rings[i] == NULL) {
+			printf("%s: error, can't create ring\n", __func__);
+			goto test_fail;
+		}
+	}
+
+	/* objects of ring i are 0xi0 to 0xi3, rings 1 and 3 stay empty */
+	for (obj = 0x00; obj < 0x04; obj++)
+		rte_ring_enqueue(rings[0], (void *)obj);
+	for (obj = 0x20; obj < 0x24; obj++)
+		rte_ring_enqueue(rings[2], (void *)obj);
+
+	/* round-robin without doorbell, resuming after the last ring */
+	pos = 0;
+	n = rte_ring_dequeue_burst_multi(rings, MULTI_NB_RINGS, NULL,
+			(void **)objs, 6, &pos);
+	TEST_RING_VERIFY(n == 6, rings[2], goto test_fail);
+	TEST_RING_VERIFY(objs[3] == 0x03 && objs[4] == 0x20 && objs[5] == 0x21,
+			rings[2], goto test_fail);
+	TEST_RING_VERIFY(pos == 3, rings[2], goto test_fail);
+	n = rte_ring_dequeue_burst_multi(rings, MULTI_NB_RINGS, NULL,
+			(void **)objs, RTE_DIM(objs), &pos);
+	TEST_RING_VERIFY(n == 2 && objs[0] == 0x22 && objs[1] == 0x23,
+			rings[2], goto test_fail);
+	TEST_RING_VERIFY(pos == 3, rings[2], goto test_fail);
+
+	/* with doorbell, a ring not rung is not polled */
+	rte_ring_doorbell_init(&db);
+	rte_ring_enqueue(rings[1], (void *)0x10);
+	rte_ring_enqueue(rings[3], (void *)0x30);
+	rte_ring_doorbell_ring(&db, 3);
+	n = rte_ring_dequeue_burst_multi(rings, MULTI_NB_RINGS, &db,
+			(void **)objs, RTE_DIM(objs), NULL);
+	TEST_RING_VERIFY(n == 1 && objs[0] == 0x30, rings[3], goto test_fail);
+	TEST_RING_VERIFY(db.bits == 0, rings[3], goto test_fail);
+	n = rte_ring_dequeue_burst_multi(rings, MULTI_NB_RINGS, &db,
+			(void **)objs, RTE_DIM(objs), NULL);
+	TEST_RING_VERIFY(n == 0, rings[1], goto test_fail);
+
+	/* the bit of a ring not drained is set again */
+	rte_ring_enqueue(rings[1], (void *)0x11);
+	rte_ring_doorbell_ring(&db, 1);
+	n = rte_ring_dequeue_burst_multi(rings, MULTI_NB_RINGS, &db,
+			(void **)objs, 1, NULL);
+	TEST_RING_VERIFY(n == 1 && objs[0] == 0x10, rings[1], goto test_fail);
+	TEST_RING_VERIFY(db.bits == RTE_BIT64(1), rings[1], goto test_fail);
+	n = rte_ring_dequeue_burst_multi(rings, MULTI_NB_RINGS, &db,
+			(void **)objs, RTE_DIM(objs), NULL);
+	TEST_RING_VERIFY(n == 1 && objs[0] == 0x11, rings[1], goto test_fail);
+	TEST_RING_VERIFY(db.bits == 0, rings[1], goto test_fail);
+
+	for (i = 0; i < MULTI_NB_RINGS; i++)
+		rte_ring_free(rings[i]);
+	return 0;
+
+test_fail:
+	for (i = 0; i < MULTI_NB_RINGS; i++)
+		rte_ring_free(rings[i]);
+	return -1;
+}
+
 static int
 test_ring(void)
 {
@@ -1214,6 +1295,9 @@ test_ring(void)
 	if (test_ring_with_exact_size() < 0)
 		goto test_fail;
 
+	if (test_ring_dequeue_multi() < 0)
+		goto test_fail;
+
 	/* Burst and bulk operations with sp/sc, mp/mc and default.
 	 * The test cases are split into smaller test cases to
 	 * help clang compile faster.
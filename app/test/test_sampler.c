@@ -2,13 +2,20 @@
  * Copyright(c) 2024 Intel Corporation
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdint.h>
 
+#include <rte_bitrate.h>
 #include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_lcore.h>
 #include <rte_malloc.h>
+#include <rte_metrics.h>
 #include <rte_sampler.h>
+#include <rte_sampler_sink_bitrate.h>
+#include <rte_string_fns.h>
 
 #include "test.h"
 
@@ -84,6 +91,71 @@ test_sink_output(const char *source_name,
 	return 0;
 }
 
+/* Counting source: each sample returns id * number of samples taken */
+struct test_counting_source {
+	int num_stats;
+	uint64_t samples;
+};
+
+static int
+test_counting_names_get(uint16_t source_id,
+		struct rte_sampler_xstats_name *xstats_names,
+		uint64_t *ids,
+		unsigned int size,
+		void *user_data)
+{
+	struct test_counting_source *src = user_data;
+
+	return test_xstats_names_get(source_id, xstats_names, ids, size,
+		&src->num_stats);
+}
+
+static int
+test_counting_get(uint16_t source_id,
+		const uint64_t *ids,
+		uint64_t *values,
+		unsigned int n,
+		void *user_data)
+{
+	struct test_counting_source *src = user_data;
+	unsigned int i;
+
+	RTE_SET_USED(source_id);
+
+	src->samples++;
+	for (i = 0; i < n; i++)
+		values[i] = ids[i] * src->samples;
+
+	return n;
+}
+
+/* Sink recording the last values it received */
+struct test_record_sink {
+	uint64_t values[TEST_NUM_STATS];
+	unsigned int n;
+};
+
+static int
+test_record_output(const char *source_name,
+		uint16_t source_id,
+		const struct rte_sampler_xstats_name *xstats_names,
+		const uint64_t *ids,
+		const uint64_t *values,
+		unsigned int n,
+		void *user_data)
+{
+	struct test_record_sink *rec = user_data;
+
+	RTE_SET_USED(source_name);
+	RTE_SET_USED(source_id);
+	RTE_SET_USED(xstats_names);
+	RTE_SET_USED(ids);
+
+	rec->n = RTE_MIN(n, (unsigned int)TEST_NUM_STATS);
+	memcpy(rec->values, values, rec->n * sizeof(uint64_t));
+	return 0;
+}
+
 /* Test basic session creation and deletion */
 static int
 test_sampler_session_create_free(void)
@@ -503,6 +575,413 @@ test_sampler_filter(void)
 	return TEST_SUCCESS;
 }
 
+/* Test scheduling of periodic sessions by rte_sampler_poll() */
+static int
+test_sampler_poll_schedule(void)
+{
+	struct rte_sampler_session *session;
+	struct rte_sampler_session_conf conf;
+	struct rte_sampler_source *source;
+	struct rte_sampler_sink *sink;
+	struct rte_sampler_source_ops src_ops;
+	struct rte_sampler_sink_ops sink_ops;
+	int num_stats = TEST_NUM_STATS;
+	unsigned int sink_count = 0;
+	int ret;
+
+	memset(&conf, 0, sizeof(conf));
+	conf.sample_interval_ms = 10;
+	conf.duration_ms = 0;
+	conf.name = "test_poll_session";
+
+	session = rte_sampler_session_create(&conf);
+	TEST_ASSERT_NOT_NULL(session, "Failed to create session");
+
+	memset(&src_ops, 0, sizeof(src_ops));
+	src_ops.xstats_names_get = test_xstats_names_get;
+	src_ops.xstats_get = test_xstats_get;
+	source = rte_sampler_session_register_source(session, "test_source", 0,
+		&src_ops, &num_stats);
+	TEST_ASSERT_NOT_NULL(source, "Failed to register source");
+
+	memset(&sink_ops, 0, sizeof(sink_ops));
+	sink_ops.output = test_sink_output;
+	sink = rte_sampler_session_register_sink(session, "test_sink", &sink_ops,
+		&sink_count);
+	TEST_ASSERT_NOT_NULL(sink, "Failed to register sink");
+
+	/* Not started: nothing is due */
+	ret = rte_sampler_poll();
+	TEST_ASSERT_EQUAL(ret, 0, "Poll of stopped session returned %d", ret);
+
+	TEST_ASSERT_SUCCESS(rte_sampler_session_start(session, 0),
+		"Failed to start session");
+
+	/* Interval not yet elapsed */
+	ret = rte_sampler_poll();
+	TEST_ASSERT_EQUAL(ret, 0, "Poll before interval returned %d", ret);
+
+	rte_delay_ms(conf.sample_interval_ms + 1);
+	ret = rte_sampler_poll();
+	TEST_ASSERT_EQUAL(ret, 1, "Poll after interval returned %d", ret);
+	TEST_ASSERT_EQUAL(sink_count, 1, "Expected 1 sample, got %u", sink_count);
+
+	/* Rescheduled one interval later */
+	ret = rte_sampler_poll();
+	TEST_ASSERT_EQUAL(ret, 0, "Immediate re-poll returned %d", ret);
+
+	/* Stopped sessions are no longer scheduled */
+	rte_sampler_session_stop(session);
+	rte_delay_ms(conf.sample_interval_ms + 1);
+	ret = rte_sampler_poll();
+	TEST_ASSERT_EQUAL(ret, 0, "Poll of stopped session returned %d", ret);
+
+	rte_sampler_session_unregister_sink(session, sink);
+	rte_sampler_session_unregister_source(session, source);
+	rte_sampler_session_free(session);
+	return TEST_SUCCESS;
+}
+
+/* Sink recording the sample TSC of the session */
+struct test_tsc_sink {
+	struct rte_sampler_session *session;
+	uint64_t tsc;
+	unsigned int count;
+};
+
+static int
+test_tsc_sink_output(const char *source_name,
+		uint16_t source_id,
+		const struct rte_sampler_xstats_name *xstats_names,
+		const uint64_t *ids,
+		const uint64_t *values,
+		unsigned int n,
+		void *user_data)
+{
+	struct test_tsc_sink *sink = user_data;
+
+	RTE_SET_USED(source_name);
+	RTE_SET_USED(source_id);
+	RTE_SET_USED(xstats_names);
+	RTE_SET_USED(ids);
+	RTE_SET_USED(values);
+	RTE_SET_USED(n);
+
+	sink->tsc = rte_sampler_session_get_sample_tsc(sink->session);
+	sink->count++;
+
+	return 0;
+}
+
+/* Test microsecond interval and sample TSC */
+static int
+test_sampler_poll_us(void)
+{
+	struct rte_sampler_session *session;
+	struct rte_sampler_session_conf conf;
+	struct rte_sampler_session_ext_conf ext_conf;
+	struct rte_sampler_source *source;
+	struct rte_sampler_sink *sink;
+	struct rte_sampler_source_ops src_ops;
+	struct rte_sampler_sink_ops sink_ops;
+	struct test_tsc_sink tsc_sink;
+	int num_stats = TEST_NUM_STATS;
+	uint64_t start;
+	int ret;
+
+	memset(&conf, 0, sizeof(conf));
+	conf.sample_interval_ms = 1000;
+	conf.name = "test_poll_us_session";
+	memset(&ext_conf, 0, sizeof(ext_conf));
+	ext_conf.sample_interval_us = 500;
+
+	session = rte_sampler_session_create_ext(&conf, &ext_conf);
+	TEST_ASSERT_NOT_NULL(session, "Failed to create session");
+
+	memset(&src_ops, 0, sizeof(src_ops));
+	src_ops.xstats_names_get = test_xstats_names_get;
+	src_ops.xstats_get = test_xstats_get;
+	source = rte_sampler_session_register_source(session, "test_source", 0,
+		&src_ops, &num_stats);
+	TEST_ASSERT_NOT_NULL(source, "Failed to register source");
+
+	memset(&tsc_sink, 0, sizeof(tsc_sink));
+	tsc_sink.session = session;
+	memset(&sink_ops, 0, sizeof(sink_ops));
+	sink_ops.output = test_tsc_sink_output;
+	sink = rte_sampler_session_register_sink(session, "test_tsc_sink", &sink_ops,
+		&tsc_sink);
+	TEST_ASSERT_NOT_NULL(sink, "Failed to register sink");
+
+	start = rte_get_tsc_cycles();
+	TEST_ASSERT_SUCCESS(rte_sampler_session_start(session, 0),
+		"Failed to start session");
+
+	/* The microsecond interval overrides the millisecond one */
+	rte_delay_us(ext_conf.sample_interval_us * 2);
+	ret = rte_sampler_poll();
+	TEST_ASSERT_EQUAL(ret, 1, "Poll after interval returned %d", ret);
+	TEST_ASSERT_EQUAL(tsc_sink.count, 1, "Expected 1 sample, got %u",
+		tsc_sink.count);
+	TEST_ASSERT(tsc_sink.tsc >= start && tsc_sink.tsc <= rte_get_tsc_cycles(),
+		"Sample TSC out of range");
+
+	rte_sampler_session_stop(session);
+	rte_sampler_session_unregister_sink(session, sink);
+	rte_sampler_session_unregister_source(session, source);
+	rte_sampler_session_free(session);
+
+	return TEST_SUCCESS;
+}
+
+/* Test delta transform between sources and sinks */
+static int
+test_sampler_transform_delta(void)
+{
+	struct rte_sampler_session *session;
+	struct rte_sampler_session_conf conf;
+	struct rte_sampler_source *source;
+	struct rte_sampler_sink *raw_sink, *delta_sink;
+	struct rte_sampler_source_ops src_ops;
+	struct rte_sampler_sink_ops sink_ops;
+	struct test_counting_source src = { .num_stats = TEST_NUM_STATS };
+	struct test_record_sink raw, delta;
+	unsigned int i;
+
+	memset(&raw, 0, sizeof(raw));
+	memset(&delta, 0, sizeof(delta));
+	memset(&conf, 0, sizeof(conf));
+	conf.name = "test_transform_session";
+
+	session = rte_sampler_session_create(&conf);
+	TEST_ASSERT_NOT_NULL(session, "Failed to create session");
+
+	memset(&src_ops, 0, sizeof(src_ops));
+	src_ops.xstats_names_get = test_counting_names_get;
+	src_ops.xstats_get = test_counting_get;
+	source = rte_sampler_session_register_source(session, "test_source", 0,
+		&src_ops, &src);
+	TEST_ASSERT_NOT_NULL(source, "Failed to register source");
+
+	memset(&sink_ops, 0, sizeof(sink_ops));
+	sink_ops.output = test_record_output;
+	raw_sink = rte_sampler_session_register_sink(session, "raw", &sink_ops, &raw);
+	TEST_ASSERT_NOT_NULL(raw_sink, "Failed to register raw sink");
+
+	sink_ops.flags = RTE_SAMPLER_SINK_F_DELTA;
+	delta_sink = rte_sampler_session_register_sink(session, "delta", &sink_ops,
+		&delta);
+	TEST_ASSERT_NOT_NULL(delta_sink, "Failed to register delta sink");
+
+	rte_sampler_session_start(session, 0);
+
+	/* First sample has no previous values */
+	TEST_ASSERT_SUCCESS(rte_sampler_session_process(session), "Sampling failed");
+	TEST_ASSERT_EQUAL(delta.n, TEST_NUM_STATS, "Delta sink got %u stats", delta.n);
+	for (i = 0; i < delta.n; i++)
+		TEST_ASSERT_EQUAL(delta.values[i], 0, "First delta %u not zero", i);
+
+	TEST_ASSERT_SUCCESS(rte_sampler_session_process(session), "Sampling failed");
+	TEST_ASSERT_SUCCESS(rte_sampler_session_process(session), "Sampling failed");
+	for (i = 0; i < delta.n; i++) {
+		TEST_ASSERT_EQUAL(raw.values[i], i * 3, "Raw value %u wrong", i);
+		TEST_ASSERT_EQUAL(delta.values[i], i, "Delta value %u wrong", i);
+	}
+
+	rte_sampler_session_stop(session);
+	rte_sampler_session_unregister_sink(session, delta_sink);
+	rte_sampler_session_unregister_sink(session, raw_sink);
+	rte_sampler_session_unregister_source(session, source);
+	rte_sampler_session_free(session);
+	return TEST_SUCCESS;
+}
+
+/* Test compiled filter matching on sampled sources */
+static int
+test_sampler_filter_match(void)
+{
+	struct rte_sampler_session *session;
+	struct rte_sampler_session_conf conf;
+	struct rte_sampler_source *source;
+	struct rte_sampler_source_ops ops;
+	int num_stats = TEST_NUM_STATS;
+	/* 11 + 10 + 1 + 1 matching stats out of test_stat_0..99 */
+	const char *patterns[] = {"test_stat_1*", "test_stat_2?", "test_stat_42", "*_99"};
+	int ret;
+
+	memset(&conf, 0, sizeof(conf));
+	conf.name = "test_filter_session";
+
+	session = rte_sampler_session_create(&conf);
+	TEST_ASSERT_NOT_NULL(session, "Failed to create session");
+
+	memset(&ops, 0, sizeof(ops));
+	ops.xstats_names_get = test_xstats_names_get;
+	ops.xstats_get = test_xstats_get;
+	source = rte_sampler_session_register_source(session, "test_source", 0,
+		&ops, &num_stats);
+	TEST_ASSERT_NOT_NULL(source, "Failed to register source");
+
+	TEST_ASSERT_SUCCESS(rte_sampler_source_set_filter(source, patterns,
+		RTE_DIM(patterns)), "Failed to set filter");
+	TEST_ASSERT_SUCCESS(rte_sampler_session_process(session), "Sampling failed");
+
+	ret = rte_sampler_source_get_xstats_count(source);
+	TEST_ASSERT_EQUAL(ret, 23, "Expected 23 filtered stats, got %d", ret);
+
+	TEST_ASSERT_SUCCESS(rte_sampler_source_clear_filter(source),
+		"Failed to clear filter");
+	ret = rte_sampler_source_get_xstats_count(source);
+	TEST_ASSERT_EQUAL(ret, TEST_NUM_STATS, "Expected all stats, got %d", ret);
+
+	rte_sampler_session_unregister_source(session, source);
+	rte_sampler_session_free(session);
+	return TEST_SUCCESS;
+}
+
+/* Byte counters source: each sample adds 1000 bytes in and 500 out */
+static const char * const test_bytes_names[] = {
+	"rx_good_packets", "rx_good_bytes", "tx_good_bytes",
+};
+
+static int
+test_bytes_names_get(uint16_t source_id,
+		struct rte_sampler_xstats_name *xstats_names,
+		uint64_t *ids,
+		unsigned int size,
+		void *user_data)
+{
+	unsigned int i;
+
+	RTE_SET_USED(source_id);
+	RTE_SET_USED(user_data);
+
+	if (xstats_names == NULL)
+		return RTE_DIM(test_bytes_names);
+
+	for (i = 0; i < RTE_DIM(test_bytes_names) && i < size; i++) {
+		strlcpy(xstats_names[i].name, test_bytes_names[i],
+			RTE_SAMPLER_XSTATS_NAME_SIZE);
+		ids[i] = i;
+	}
+
+	return RTE_DIM(test_bytes_names);
+}
+
+static int
+test_bytes_get(uint16_t source_id,
+		const uint64_t *ids,
+		uint64_t *values,
+		unsigned int n,
+		void *user_data)
+{
+	struct test_counting_source *src = user_data;
+	const uint64_t per_sample[] = {1, 1000, 500};
+	unsigned int i;
+
+	RTE_SET_USED(source_id);
+
+	src->samples++;
+	for (i = 0; i < n; i++)
+		values[i] = per_sample[ids[i]] * src->samples;
+
+	return n;
+}
+
+/* Get the in and out EWMA bit rates of a port */
+static int
+test_bitrate_ewma_get(uint16_t port, uint64_t *ewma_in, uint64_t *ewma_out)
+{
+	struct rte_metric_name names[RTE_METRICS_MAX_METRICS];
+	struct rte_metric_value values[RTE_METRICS_MAX_METRICS];
+	int count;
+	int i;
+
+	count = rte_metrics_get_names(names, RTE_DIM(names));
+	if (count < 0 || count > (int)RTE_DIM(names))
+		return -1;
+	if (rte_metrics_get_values(port, values, RTE_DIM(values)) != count)
+		return -1;
+
+	for (i = 0; i < count; i++) {
+		if (strcmp(names[i].name, "ewma_bits_in") == 0)
+			*ewma_in = values[i].value;
+		else if (strcmp(names[i].name, "ewma_bits_out") == 0)
+			*ewma_out = values[i].value;
+	}
+
+	return 0;
+}
+
+/* Test bit rates calculated by the bitrate sink from the sampled bytes */
+static int
+test_sampler_sink_bitrate(void)
+{
+	struct rte_sampler_session *session;
+	struct rte_sampler_session_conf conf;
+	struct rte_sampler_source *port_source, *other_source;
+	struct rte_sampler_source_ops src_ops;
+	struct rte_sampler_sink *sink;
+	struct rte_stats_bitrates *bitrate_data;
+	struct test_counting_source port_src = { 0 };
+	struct test_counting_source other_src = { 0 };
+	uint64_t ewma_in = 0, ewma_out = 0;
+
+	rte_metrics_init(rte_socket_id());
+	bitrate_data = rte_stats_bitrate_create();
+	TEST_ASSERT_NOT_NULL(bitrate_data, "Failed to create bit rates");
+	TEST_ASSERT_SUCCESS(rte_stats_bitrate_reg(bitrate_data),
+		"Failed to register bit rates");
+
+	memset(&conf, 0, sizeof(conf));
+	conf.name = "test_bitrate_session";
+
+	session = rte_sampler_session_create(&conf);
+	TEST_ASSERT_NOT_NULL(session, "Failed to create session");
+
+	TEST_ASSERT_NULL(rte_sampler_sink_bitrate_create(session, "bitrate", NULL),
+		"Created bitrate sink without bit rates");
+
+	/* Only the sources named after their ethdev port are used */
+	memset(&src_ops, 0, sizeof(src_ops));
+	src_ops.xstats_names_get = test_bytes_names_get;
+	src_ops.xstats_get = test_bytes_get;
+	port_source = rte_sampler_session_register_source(session, "ethdev_3", 3,
+		&src_ops, &port_src);
+	TEST_ASSERT_NOT_NULL(port_source, "Failed to register port source");
+	other_source = rte_sampler_session_register_source(session, "test_source", 4,
+		&src_ops, &other_src);
+	TEST_ASSERT_NOT_NULL(other_source, "Failed to register other source");
+
+	sink = rte_sampler_sink_bitrate_create(session, "bitrate", bitrate_data);
+	TEST_ASSERT_NOT_NULL(sink, "Failed to create bitrate sink");
+
+	rte_sampler_session_start(session, 0);
+	TEST_ASSERT_SUCCESS(rte_sampler_session_process(session), "Sampling failed");
+	TEST_ASSERT_SUCCESS(rte_sampler_session_process(session), "Sampling failed");
+
+	/* EWMA of 20% on 8000 then 8000 bits in, 4000 then 4000 out */
+	TEST_ASSERT_SUCCESS(test_bitrate_ewma_get(3, &ewma_in, &ewma_out),
+		"Failed to get bit rates");
+	TEST_ASSERT_EQUAL(ewma_in, 2880, "Wrong EWMA bits in %"PRIu64, ewma_in);
+	TEST_ASSERT_EQUAL(ewma_out, 1440, "Wrong EWMA bits out %"PRIu64, ewma_out);
+
+	TEST_ASSERT_SUCCESS(test_bitrate_ewma_get(4, &ewma_in, &ewma_out),
+		"Failed to get bit rates");
+	TEST_ASSERT(ewma_in == 0 && ewma_out == 0,
+		"Bit rates calculated for a source other than a port");
+
+	rte_sampler_session_stop(session);
+	TEST_ASSERT_SUCCESS(rte_sampler_sink_bitrate_destroy(sink),
+		"Failed to destroy bitrate sink");
+	rte_sampler_session_unregister_source(session, other_source);
+	rte_sampler_session_unregister_source(session, port_source);
+	rte_sampler_session_free(session);
+	rte_stats_bitrate_free(bitrate_data);
+	rte_metrics_deinit();
+	return TEST_SUCCESS;
+}
+
 static struct unit_test_suite sampler_tests = {
 	.suite_name = "sampler autotest",
 	.setup = NULL,
@@ -516,6 +995,11 @@ static struct unit_test_suite sampler_tests = {
 		TEST_CASE(test_sampler_dynamic_sources),
 		TEST_CASE(test_sampler_dynamic_sessions),
 		TEST_CASE(test_sampler_filter),
+		TEST_CASE(test_sampler_filter_match),
+		TEST_CASE(test_sampler_poll_schedule),
+		TEST_CASE(test_sampler_poll_us),
+		TEST_CASE(test_sampler_transform_delta),
+		TEST_CASE(test_sampler_sink_bitrate),
 		TEST_CASES_END()
 	}
 };
@@ -132,6 +132,65 @@ prepare_pkt(struct rte_sched_port *port, struct rte_mbuf *mbuf)
 }
 
 
+/* one shard per subport, each dequeuing its own packets */
+static int
+test_sched_shards(struct rte_mempool *mp)
+{
+	struct rte_sched_port_params params = port_param;
+	struct rte_sched_port *port;
+	struct rte_mbuf *in_mbufs[10];
+	struct rte_mbuf *out_mbufs[10];
+	uint32_t subport, pipe, traffic_class, queue;
+	int i, err;
+
+	params.n_subports_per_port = 2;
+	port = rte_sched_port_config(&params);
+	TEST_ASSERT_NOT_NULL(port, "Error config sched port\n");
+
+	for (subport = 0; subport < 2; subport++) {
+		err = rte_sched_subport_config(port, subport, subport_param, 0);
+		TEST_ASSERT_SUCCESS(err, "Error config sched, err=%d\n", err);
+		err = rte_sched_pipe_config(port, subport, PIPE, 0);
+		TEST_ASSERT_SUCCESS(err, "Error config sched pipe, err=%d\n", err);
+	}
+
+	err = rte_sched_port_shards_config(port, 3);
+	TEST_ASSERT_FAIL(err, "More shards than subports\n");
+	err = rte_sched_port_shards_config(port, 2);
+	TEST_ASSERT_SUCCESS(err, "Error config sched shards, err=%d\n", err);
+
+	for (i = 0; i < 10; i++) {
+		in_mbufs[i] = rte_pktmbuf_alloc(mp);
+		TEST_ASSERT_NOT_NULL(in_mbufs[i], "Packet allocation failed\n");
+		rte_sched_port_pkt_write(port, in_mbufs[i], 1, PIPE, TC, QUEUE,
+			RTE_COLOR_GREEN);
+		in_mbufs[i]->pkt_len = 60;
+		in_mbufs[i]->data_len = 60;
+		TEST_ASSERT_EQUAL(rte_sched_port_pkt_shard_get(port, in_mbufs[i]),
+			1, "Wrong shard\n");
+	}
+
+	err = rte_sched_port_enqueue(port, in_mbufs, 10);
+	TEST_ASSERT_EQUAL(err, 10, "Wrong enqueue, err=%d\n", err);
+
+	/* the packets of subport 1 are only seen by shard 1 */
+	err = rte_sched_port_shard_dequeue(port, 0, out_mbufs, 10);
+	TEST_ASSERT_EQUAL(err, 0, "Wrong shard 0 dequeue, err=%d\n", err);
+	err = rte_sched_port_shard_dequeue(port, 1, out_mbufs, 10);
+	TEST_ASSERT_EQUAL(err, 10, "Wrong shard 1 dequeue, err=%d\n", err);
+
+	for (i = 0; i < 10; i++) {
+		rte_sched_port_pkt_read_tree_path(port, out_mbufs[i],
+				&subport, &pipe, &traffic_class, &queue);
+		TEST_ASSERT_EQUAL(subport, 1, "Wrong subport\n");
+		rte_pktmbuf_free(out_mbufs[i]);
+	}
+
+	rte_sched_port_free(port);
+
+	return 0;
+}
+
 /**
  * test main entrance for library sched
  */
@@ -210,7 +269,7 @@ test_sched(void)
 
 	rte_sched_port_free(port);
 
-	return 0;
+	return test_sched_shards(mp);
 }
 
 #endif /* !RTE_EXEC_ENV_WINDOWS */
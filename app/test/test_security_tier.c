@@ -0,0 +1,218 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include "test.h"
+
+#include <errno.h>
+#include <stdint.h>
+
+#include <rte_common.h>
+#include <rte_memory.h>
+#include <rte_security_tier.h>
+
+#define NB_SA 64
+#define HOT_CAPACITY 8
+
+static enum rte_security_tier_type sa_tier[NB_SA];
+static uint32_t nic_entries;
+static uint32_t nic_capacity;
+
+/* Mimic the SA table of the NIC, possibly smaller than the hot tier */
+static int
+tier_test_migrate(uint32_t sa_id, enum rte_security_tier_type tier,
+		  void *arg __rte_unused)
+{
+	if (tier == RTE_SECURITY_TIER_HOT) {
+		if (nic_entries == nic_capacity)
+			return -ENOSPC;
+		nic_entries++;
+	} else {
+		nic_entries--;
+	}
+	sa_tier[sa_id] = tier;
+
+	return 0;
+}
+
+static struct rte_security_tier *
+tier_test_create(uint32_t max_promotions)
+{
+	struct rte_security_tier_params params = {
+		.name = "test_security_tier",
+		.socket_id = SOCKET_ID_ANY,
+		.nb_sa = NB_SA,
+		.hot_capacity = HOT_CAPACITY,
+		.max_promotions = max_promotions,
+		.migrate = tier_test_migrate,
+	};
+	unsigned int i;
+
+	for (i = 0; i < NB_SA; i++)
+		sa_tier[i] = RTE_SECURITY_TIER_COLD;
+	nic_entries = 0;
+	nic_capacity = HOT_CAPACITY;
+
+	return rte_security_tier_create(&params);
+}
+
+/* Count packets to the SAs [first, first + nb), the last ones being busier */
+static void
+tier_test_traffic(struct rte_security_tier *st, uint32_t first, uint32_t nb,
+		  uint32_t pkts)
+{
+	uint32_t sa_id[NB_SA], nb_pkts[NB_SA];
+	uint32_t i;
+
+	for (i = 0; i < nb; i++) {
+		sa_id[i] = first + i;
+		nb_pkts[i] = pkts * (i + 1);
+	}
+	rte_security_tier_count(st, sa_id, nb_pkts, nb);
+}
+
+static int
+tier_test_check(struct rte_security_tier *st)
+{
+	struct rte_security_tier_stats stats;
+	uint32_t i, nb_hot = 0;
+
+	for (i = 0; i < NB_SA; i++) {
+		TEST_ASSERT_EQUAL(rte_security_tier_get(st, i), sa_tier[i],
+				"SA %u in the wrong tier", i);
+		nb_hot += sa_tier[i] == RTE_SECURITY_TIER_HOT;
+	}
+	rte_security_tier_stats_get(st, &stats);
+	TEST_ASSERT_EQUAL(stats.nb_hot, nb_hot, "%u SAs hot, %u expected",
+			stats.nb_hot, nb_hot);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_security_tier_promote(void)
+{
+	struct rte_security_tier *st;
+	uint32_t i;
+
+	st = tier_test_create(0);
+	TEST_ASSERT_NOT_NULL(st, "failed to create SA tiers");
+
+	/* The 8 busiest of 16 active SAs are promoted */
+	tier_test_traffic(st, 0, 16, 100);
+	TEST_ASSERT_EQUAL(rte_security_tier_rebalance(st), HOT_CAPACITY,
+			"hot tier not filled");
+	for (i = 0; i < 16; i++)
+		TEST_ASSERT_EQUAL(sa_tier[i], (i >= 8 ? RTE_SECURITY_TIER_HOT :
+				RTE_SECURITY_TIER_COLD), "SA %u in the wrong tier", i);
+	TEST_ASSERT_SUCCESS(tier_test_check(st), "inconsistent tiers");
+
+	/* The traffic moves to other SAs, which replace the idle hot SAs */
+	for (i = 0; i < 8; i++) {
+		tier_test_traffic(st, 32, 8, 1000);
+		rte_security_tier_rebalance(st);
+	}
+	for (i = 0; i < NB_SA; i++)
+		TEST_ASSERT_EQUAL(sa_tier[i], (i >= 32 && i < 40 ?
+				RTE_SECURITY_TIER_HOT : RTE_SECURITY_TIER_COLD),
+				"SA %u in the wrong tier", i);
+	TEST_ASSERT_SUCCESS(tier_test_check(st), "inconsistent tiers");
+
+	rte_security_tier_free(st);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_security_tier_hysteresis(void)
+{
+	struct rte_security_tier *st;
+	uint32_t i, sa_id, nb_pkts;
+
+	st = tier_test_create(0);
+	TEST_ASSERT_NOT_NULL(st, "failed to create SA tiers");
+
+	tier_test_traffic(st, 0, HOT_CAPACITY, 100);
+	rte_security_tier_rebalance(st);
+
+	/* A cold SA slightly busier than the idlest hot SA stays cold */
+	for (i = 0; i < 8; i++) {
+		tier_test_traffic(st, 0, HOT_CAPACITY, 100);
+		sa_id = NB_SA - 1;
+		nb_pkts = 120;
+		rte_security_tier_count(st, &sa_id, &nb_pkts, 1);
+		TEST_ASSERT_EQUAL(rte_security_tier_rebalance(st), 0,
+				"SA promoted within the hysteresis");
+	}
+	TEST_ASSERT_EQUAL(sa_tier[NB_SA - 1], RTE_SECURITY_TIER_COLD,
+			"SA promoted within the hysteresis");
+	TEST_ASSERT_SUCCESS(tier_test_check(st), "inconsistent tiers");
+
+	rte_security_tier_free(st);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_security_tier_limits(void)
+{
+	struct rte_security_tier_stats stats;
+	struct rte_security_tier *st;
+	uint32_t i;
+
+	st = tier_test_create(3);
+	TEST_ASSERT_NOT_NULL(st, "failed to create SA tiers");
+
+	/* The promotions per rebalance are limited */
+	tier_test_traffic(st, 0, 16, 100);
+	TEST_ASSERT_EQUAL(rte_security_tier_rebalance(st), 3,
+			"promotions not limited");
+	rte_security_tier_free(st);
+
+	/* The NIC table gets full before the hot tier */
+	st = tier_test_create(0);
+	TEST_ASSERT_NOT_NULL(st, "failed to create SA tiers");
+	nic_capacity = 5;
+	tier_test_traffic(st, 0, 16, 100);
+	TEST_ASSERT_EQUAL(rte_security_tier_rebalance(st), 5,
+			"SAs promoted beyond the NIC capacity");
+	rte_security_tier_stats_get(st, &stats);
+	TEST_ASSERT_EQUAL(stats.migrate_errors, 1, "migration error not counted");
+	TEST_ASSERT_SUCCESS(tier_test_check(st), "inconsistent tiers");
+	rte_security_tier_free(st);
+
+	/* Explicit placement */
+	st = tier_test_create(0);
+	TEST_ASSERT_NOT_NULL(st, "failed to create SA tiers");
+	for (i = 0; i < HOT_CAPACITY; i++)
+		TEST_ASSERT_SUCCESS(rte_security_tier_set(st, i,
+				RTE_SECURITY_TIER_HOT), "failed to promote SA %u", i);
+	TEST_ASSERT_EQUAL(rte_security_tier_set(st, i, RTE_SECURITY_TIER_HOT),
+			-ENOSPC, "hot tier overflow");
+	TEST_ASSERT_SUCCESS(rte_security_tier_set(st, 0, RTE_SECURITY_TIER_COLD),
+			"failed to demote SA");
+	TEST_ASSERT_EQUAL(rte_security_tier_set(st, NB_SA, RTE_SECURITY_TIER_HOT),
+			-EINVAL, "invalid SA accepted");
+	TEST_ASSERT_SUCCESS(tier_test_check(st), "inconsistent tiers");
+	rte_security_tier_free(st);
+
+	return TEST_SUCCESS;
+}
+
+static struct unit_test_suite security_tier_testsuite = {
+	.suite_name = "security SA tiers autotest",
+	.unit_test_cases = {
+		TEST_CASE(test_security_tier_promote),
+		TEST_CASE(test_security_tier_hysteresis),
+		TEST_CASE(test_security_tier_limits),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_security_tier(void)
+{
+	return unit_test_suite_runner(&security_tier_testsuite);
+}
+
+REGISTER_FAST_TEST(security_tier_autotest, NOHUGE_SKIP, ASAN_OK, test_security_tier);
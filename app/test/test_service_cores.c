@@ -1054,6 +1054,109 @@ service_active_two_cores(void)
 	return unregister_all();
 }
 
+static int32_t
+sched_count_cb(void *args)
+{
+	uint64_t *count = args;
+
+	(*count)++;
+	return 0;
+}
+
+static int32_t
+sched_slow_cb(void *args)
+{
+	rte_delay_us_block(20);
+	return sched_count_cb(args);
+}
+
+/* check priorities and cycles budgets of the services of a lcore */
+static int
+service_priority_budget(void)
+{
+	static const char * const names[] = {
+		"sched_low", "sched_high", "sched_slow"
+	};
+	uint64_t counts[RTE_DIM(names)] = { 0 };
+	struct rte_service_spec service;
+	uint64_t max, avg, overruns;
+	uint32_t ids[RTE_DIM(names)];
+	uint32_t i;
+
+	unregister_all();
+
+	for (i = 0; i != RTE_DIM(names); i++) {
+		memset(&service, 0, sizeof(service));
+		snprintf(service.name, sizeof(service.name), "%s", names[i]);
+		service.callback = i == 2 ? sched_slow_cb : sched_count_cb;
+		service.callback_userdata = &counts[i];
+		service.capabilities = RTE_SERVICE_CAP_MT_SAFE;
+		TEST_ASSERT_EQUAL(0, rte_service_component_register(&service,
+				&ids[i]), "Register of %s failed", names[i]);
+		rte_service_component_runstate_set(ids[i], 1);
+		TEST_ASSERT_EQUAL(0, rte_service_runstate_set(ids[i], 1),
+				"Starting %s failed", names[i]);
+		TEST_ASSERT_EQUAL(0, rte_service_set_stats_enable(ids[i], 1),
+				"Enabling stats of %s failed", names[i]);
+	}
+
+	/* expected failure cases */
+	TEST_ASSERT_EQUAL(-EINVAL, rte_service_priority_set(UINT32_MAX, 0),
+			"Invalid service priority set did not fail");
+	TEST_ASSERT_EQUAL(-EINVAL, rte_service_priority_set(ids[0],
+			RTE_SERVICE_PRIORITY_MAX + 1),
+			"Invalid priority set did not fail");
+	TEST_ASSERT_EQUAL(-EINVAL, rte_service_cycles_budget_set(UINT32_MAX, 0),
+			"Invalid service budget set did not fail");
+
+	TEST_ASSERT_EQUAL(0, rte_service_priority_set(ids[1], 3),
+			"Setting priority failed");
+	TEST_ASSERT_EQUAL(0, rte_service_cycles_budget_set(ids[2],
+			rte_get_tsc_hz() / US_PER_S),
+			"Setting cycles budget failed");
+
+	TEST_ASSERT_EQUAL(0, rte_service_lcore_add(slcore_id),
+			"Service core add did not return zero");
+	for (i = 0; i != RTE_DIM(names); i++)
+		TEST_ASSERT_EQUAL(0, rte_service_map_lcore_set(ids[i],
+				slcore_id, 1), "Mapping %s failed", names[i]);
+	TEST_ASSERT_EQUAL(0, rte_service_lcore_start(slcore_id),
+			"Starting service core failed");
+
+	rte_delay_ms(100);
+
+	TEST_ASSERT_EQUAL(0, rte_service_lcore_stop(slcore_id),
+			"Failed to stop service lcore");
+	wait_slcore_inactive(slcore_id);
+
+	TEST_ASSERT(counts[1] > counts[0],
+			"High priority service ran %"PRIu64" times, low %"PRIu64,
+			counts[1], counts[0]);
+
+	TEST_ASSERT_EQUAL(0, rte_service_attr_get(ids[2],
+			RTE_SERVICE_ATTR_BUDGET_OVERRUN_COUNT, &overruns),
+			"Getting overrun count failed");
+	TEST_ASSERT(overruns > 0, "Budget overruns not counted");
+	TEST_ASSERT_EQUAL(0, rte_service_attr_get(ids[0],
+			RTE_SERVICE_ATTR_RUN_LATENCY_MAX, &max),
+			"Getting max latency failed");
+	TEST_ASSERT_EQUAL(0, rte_service_attr_get(ids[0],
+			RTE_SERVICE_ATTR_RUN_LATENCY_AVG, &avg),
+			"Getting average latency failed");
+	TEST_ASSERT(avg > 0 && avg <= max,
+			"Unexpected latencies, avg %"PRIu64" max %"PRIu64,
+			avg, max);
+
+	TEST_ASSERT_EQUAL(0, rte_service_attr_reset_all(ids[0]),
+			"Resetting attributes failed");
+	TEST_ASSERT_EQUAL(0, rte_service_attr_get(ids[0],
+			RTE_SERVICE_ATTR_RUN_LATENCY_MAX, &max),
+			"Getting max latency failed");
+	TEST_ASSERT_EQUAL(0, max, "Max latency not reset");
+
+	return unregister_all();
+}
+
 static struct unit_test_suite service_tests  = {
 	.suite_name = "service core test suite",
 	.setup = testsuite_setup,
@@ -1071,6 +1174,7 @@ static struct unit_test_suite service_tests  = {
 		TEST_CASE_ST(dummy_register, NULL, service_mt_safe_poll),
 		TEST_CASE_ST(dummy_register, NULL, service_may_be_active),
 		TEST_CASE_ST(dummy_register, NULL, service_active_two_cores),
+		TEST_CASE_ST(dummy_register, NULL, service_priority_budget),
 		TEST_CASES_END() /**< NULL terminate unit test array */
 	}
 };
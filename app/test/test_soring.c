@@ -408,6 +408,86 @@ test_soring_acquire_release(void)
 	return 0;
 }
 
+static int
+test_soring_adaptive_burst(void)
+{
+	struct rte_soring *sor = NULL;
+	struct rte_soring_param prm;
+	struct rte_soring_stage_stats stats;
+	uint32_t objs[16], acquired_objs[16];
+	uint32_t acquired, enqueued, dequeued, ftoken;
+	int rc, i;
+	size_t sz;
+
+	for (i = 0; i < 16; i++)
+		objs[i] = i;
+
+	memset(&prm, 0, sizeof(prm));
+	set_soring_init_param(&prm, "test_adaptive", sizeof(uint32_t),
+			64, 1, 0, RTE_RING_SYNC_MT, RTE_RING_SYNC_MT);
+	prm.flags = RTE_SORING_F_ADAPTIVE_BURST;
+	sz = rte_soring_get_memsize(&prm);
+	sor = rte_zmalloc(NULL, sz, RTE_CACHE_LINE_SIZE);
+	if (sor == NULL) {
+		printf("%s: alloc(%zu) for FIFO with %u elems failed",
+			__func__, sz, prm.elems);
+		return -ENOMEM;
+	}
+
+	rc = rte_soring_init(sor, &prm);
+	RTE_TEST_ASSERT_SUCCESS(rc, "failed to init soring");
+
+	/* first burst uses the requested size */
+	enqueued = rte_soring_enqueue_burst(sor, objs, 16, NULL);
+	SORING_TEST_ASSERT(enqueued, 16);
+	acquired = rte_soring_acquire_burst(sor, acquired_objs, 0, 16,
+			&ftoken, NULL);
+	SORING_TEST_ASSERT(acquired, 16);
+	rte_soring_release(sor, NULL, 0, acquired, ftoken);
+	dequeued = rte_soring_dequeue_burst(sor, acquired_objs, 16, NULL);
+	SORING_TEST_ASSERT(dequeued, 16);
+
+	/* an empty stage stalls and halves its burst */
+	acquired = rte_soring_acquire_burst(sor, acquired_objs, 0, 16,
+			&ftoken, NULL);
+	SORING_TEST_ASSERT(acquired, 0);
+	rc = rte_soring_stage_stats_get(sor, 0, &stats);
+	RTE_TEST_ASSERT_SUCCESS(rc, "failed to get stage stats");
+	SORING_TEST_ASSERT(stats.burst, 8);
+	RTE_TEST_ASSERT_EQUAL(stats.stalls, 1, "stalls: %" PRIu64, stats.stalls);
+
+	/* backlog after a full burst grows it back */
+	enqueued = rte_soring_enqueue_burst(sor, objs, 16, NULL);
+	SORING_TEST_ASSERT(enqueued, 16);
+	acquired = rte_soring_acquire_burst(sor, acquired_objs, 0, 16,
+			&ftoken, NULL);
+	SORING_TEST_ASSERT(acquired, 8);
+	rc = rte_soring_stage_stats_get(sor, 0, &stats);
+	RTE_TEST_ASSERT_SUCCESS(rc, "failed to get stage stats");
+	SORING_TEST_ASSERT(stats.burst, 16);
+	SORING_TEST_ASSERT(stats.depth, 8);
+	SORING_TEST_ASSERT(stats.inflight, 8);
+	rte_soring_release(sor, NULL, 0, acquired, ftoken);
+
+	rte_soring_stats_reset(sor);
+	rc = rte_soring_stage_stats_get(sor, 0, &stats);
+	RTE_TEST_ASSERT_SUCCESS(rc, "failed to get stage stats");
+	RTE_TEST_ASSERT_EQUAL(stats.stalls, 0, "stalls: %" PRIu64, stats.stalls);
+
+	rc = rte_soring_stage_stats_get(sor, 1, &stats);
+	RTE_TEST_ASSERT_EQUAL(rc, -EINVAL, "invalid stage accepted");
+
+	RTE_TEST_ASSERT_SUCCESS(rte_soring_telemetry_register(sor),
+			"failed to register soring with telemetry");
+	RTE_TEST_ASSERT_EQUAL(rte_soring_telemetry_register(sor), -EEXIST,
+			"soring registered twice");
+	RTE_TEST_ASSERT_SUCCESS(rte_soring_telemetry_unregister(sor),
+			"failed to unregister soring from telemetry");
+
+	rte_free(sor);
+	return 0;
+}
+
 static int
 test_soring(void)
 {
@@ -432,6 +512,10 @@ test_soring(void)
 	if (test_soring_stages() < 0)
 		goto test_fail;
 
+	/* Adaptive burst and stage statistics */
+	if (test_soring_adaptive_burst() < 0)
+		goto test_fail;
+
 	return 0;
 
 test_fail:
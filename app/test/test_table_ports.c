@@ -10,6 +10,7 @@
 port_test port_tests[] = {
 	test_port_ring_reader,
 	test_port_ring_writer,
+	test_port_ring_writer_group,
 };
 
 unsigned n_port_tests = RTE_DIM(port_tests);
@@ -192,4 +193,118 @@ test_port_ring_writer(void)
 	return 0;
 }
 
+int
+test_port_ring_writer_group(void)
+{
+	int status, i;
+	struct rte_port_ring_writer_group_params params;
+	struct rte_ring *rings[N_PORTS] = {RING_TX, RING_TX_2};
+	void *port;
+
+	/* Invalid params */
+	port = rte_port_ring_writer_group_ops.f_create(NULL, 0);
+	if (port != NULL)
+		return -1;
+
+	status = rte_port_ring_writer_group_ops.f_free(port);
+	if (status >= 0)
+		return -2;
+
+	params.rings = rings;
+	params.n_rings = 0;
+	params.tx_burst_sz = 4;
+	params.ring_id_offset = APP_METADATA_OFFSET(0);
+	params.flush_cycles = 0;
+
+	port = rte_port_ring_writer_group_ops.f_create(&params, 0);
+	if (port != NULL)
+		return -3;
+
+	params.n_rings = N_PORTS;
+	params.tx_burst_sz = RTE_PORT_IN_BURST_SIZE_MAX + 1;
+
+	port = rte_port_ring_writer_group_ops.f_create(&params, 0);
+	if (port != NULL)
+		return -4;
+
+	/* Create and free */
+	params.tx_burst_sz = 4;
+
+	port = rte_port_ring_writer_group_ops.f_create(&params, 0);
+	if (port == NULL)
+		return -5;
+
+	status = rte_port_ring_writer_group_ops.f_free(port);
+	if (status != 0)
+		return -6;
+
+	/* -- Traffic TX -- */
+	int received_pkts;
+	struct rte_mbuf *mbuf[RTE_PORT_IN_BURST_SIZE_MAX];
+	struct rte_mbuf *res_mbuf[RTE_PORT_IN_BURST_SIZE_MAX];
+
+	port = rte_port_ring_writer_group_ops.f_create(&params, 0);
+
+	/* Full burst to the first ring, partial burst to the second ring and
+	 * one packet with invalid ring index.
+	 */
+	for (i = 0; i < 6; i++) {
+		mbuf[i] = rte_pktmbuf_alloc(pool);
+		RTE_MBUF_METADATA_UINT32(mbuf[i], APP_METADATA_OFFSET(0)) =
+			(i < 4) ? 0 : ((i == 4) ? 1 : N_PORTS);
+	}
+	rte_port_ring_writer_group_ops.f_tx_bulk(port, mbuf, 0x3F);
+
+	received_pkts = rte_ring_sc_dequeue_burst(RING_TX,
+		(void **)res_mbuf, RTE_PORT_IN_BURST_SIZE_MAX, NULL);
+	if (received_pkts != 4)
+		return -7;
+
+	for (i = 0; i < received_pkts; i++)
+		rte_pktmbuf_free(res_mbuf[i]);
+
+	received_pkts = rte_ring_sc_dequeue_burst(RING_TX_2,
+		(void **)res_mbuf, RTE_PORT_IN_BURST_SIZE_MAX, NULL);
+	if (received_pkts != 0)
+		return -8;
+
+	rte_port_ring_writer_group_ops.f_flush(port);
+
+	received_pkts = rte_ring_sc_dequeue_burst(RING_TX_2,
+		(void **)res_mbuf, RTE_PORT_IN_BURST_SIZE_MAX, NULL);
+	if (received_pkts != 1)
+		return -9;
+
+	rte_pktmbuf_free(res_mbuf[0]);
+
+	status = rte_port_ring_writer_group_ops.f_free(port);
+	if (status != 0)
+		return -10;
+
+	/* Flush requests within the flush period are ignored, free flushes */
+	params.flush_cycles = UINT64_MAX;
+	port = rte_port_ring_writer_group_ops.f_create(&params, 0);
+
+	mbuf[0] = rte_pktmbuf_alloc(pool);
+	RTE_MBUF_METADATA_UINT32(mbuf[0], APP_METADATA_OFFSET(0)) = 0;
+	rte_port_ring_writer_group_ops.f_tx(port, mbuf[0]);
+	rte_port_ring_writer_group_ops.f_flush(port);
+
+	received_pkts = rte_ring_sc_dequeue_burst(RING_TX,
+		(void **)res_mbuf, RTE_PORT_IN_BURST_SIZE_MAX, NULL);
+	if (received_pkts != 0)
+		return -11;
+
+	rte_port_ring_writer_group_ops.f_free(port);
+
+	received_pkts = rte_ring_sc_dequeue_burst(RING_TX,
+		(void **)res_mbuf, RTE_PORT_IN_BURST_SIZE_MAX, NULL);
+	if (received_pkts != 1)
+		return -12;
+
+	rte_pktmbuf_free(res_mbuf[0]);
+
+	return 0;
+}
+
 #endif /* !RTE_EXEC_ENV_WINDOWS */
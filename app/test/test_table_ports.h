@@ -5,6 +5,7 @@
 /* Test prototypes */
 int test_port_ring_reader(void);
 int test_port_ring_writer(void);
+int test_port_ring_writer_group(void);
 
 /* Extern variables */
 typedef int (*port_test)(void);
@@ -81,6 +81,27 @@ telemetry_test_cb(const char *cmd __rte_unused, const char *params __rte_unused,
  * response. The expected response is passed in by the test case function,
  * and is compared to the actual response received from Telemetry.
  */
+static int
+check_request(const char *func_name, const char *request, const void *expected,
+		int len)
+{
+	int bytes;
+	char buf[BUF_SIZE * 16];
+	if (write(sock, request, strlen(request)) < 0) {
+		printf("%s: Error with socket write - %s\n", __func__,
+				strerror(errno));
+		return -1;
+	}
+	bytes = read(sock, buf, sizeof(buf));
+	if (bytes < 0) {
+		printf("%s: Error with socket read - %s\n", __func__,
+				strerror(errno));
+		return -1;
+	}
+	printf("%s: %s, %d bytes, expected %d\n", func_name, request, bytes, len);
+	return bytes != len || memcmp(expected, buf, len) != 0;
+}
+
 static int
 check_output(const char *func_name, const char *expected)
 {
@@ -528,6 +549,46 @@ test_dict_char_escaping(void)
 	return CHECK_OUTPUT("{\"name\":\"escaped\\n\\tvalue\"}");
 }
 
+static int
+test_batch(void)
+{
+	rte_tel_data_start_dict(&response_data);
+	rte_tel_data_add_dict_int(&response_data, "a", 1);
+	rte_tel_data_add_dict_string(&response_data, "b", "x");
+
+	const char expected[] = "[{\"" REQUEST_CMD "\":{\"a\":1,\"b\":\"x\"}},"
+		"{\"/nonexistent\":null},{\"/batch\":null},"
+		"{\"" REQUEST_CMD "\":{\"a\":1,\"b\":\"x\"}}]";
+	return check_request(__func__, "/batch," REQUEST_CMD ";/nonexistent;/batch;"
+			REQUEST_CMD, expected, strlen(expected));
+}
+
+static int
+test_cbor_encoding(void)
+{
+	rte_tel_data_start_dict(&response_data);
+	rte_tel_data_add_dict_int(&response_data, "a", 1);
+	rte_tel_data_add_dict_int(&response_data, "b", -2);
+	rte_tel_data_add_dict_uint(&response_data, "c", 300);
+	rte_tel_data_add_dict_string(&response_data, "d", "x");
+
+	/* {"/encoding": "cbor"} */
+	const uint8_t encoding[] = {0xa1, 0x69, '/', 'e', 'n', 'c', 'o', 'd', 'i', 'n', 'g',
+		0x64, 'c', 'b', 'o', 'r'};
+	/* {"/test": {"a": 1, "b": -2, "c": 300, "d": "x"}}, with an indefinite map */
+	const uint8_t expected[] = {0xa1, 0x65, '/', 't', 'e', 's', 't',
+		0xbf, 0x61, 'a', 0x01, 0x61, 'b', 0x21, 0x61, 'c', 0x19, 0x01, 0x2c,
+		0x61, 'd', 0x61, 'x', 0xff};
+	const char json[] = "{\"/encoding\":\"json\"}";
+
+	if (check_request(__func__, "/encoding,cbor", encoding, sizeof(encoding)) != 0 ||
+			check_request(__func__, REQUEST_CMD, expected, sizeof(expected)) != 0) {
+		check_request(__func__, "/encoding,json", json, strlen(json));
+		return -1;
+	}
+	return check_request(__func__, "/encoding,json", json, strlen(json));
+}
+
 static int
 connect_to_socket(void)
 {
@@ -600,6 +661,8 @@ telemetry_data_autotest(void)
 			test_string_char_escaping,
 			test_array_char_escaping,
 			test_dict_char_escaping,
+			test_batch,
+			test_cbor_encoding,
 	};
 
 	rte_telemetry_register_cmd(REQUEST_CMD, telemetry_test_cb, "Test");
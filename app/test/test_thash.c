@@ -8,10 +8,15 @@
 #include <rte_random.h>
 #include <rte_malloc.h>
 #include <rte_byteorder.h>
+#include <rte_ether.h>
+#include <rte_mbuf.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
 
 #include "test.h"
 
 #include <rte_thash.h>
+#include <rte_thash_rss.h>
 
 #define HASH_MSK(reta_sz)	((1 << reta_sz) - 1)
 #define TUPLE_SZ	(RTE_THASH_V4_L4_LEN * 4)
@@ -1028,6 +1033,156 @@ test_keygen(void)
 	return TEST_SUCCESS;
 }
 
+#define RSS_TEST_NB_PKTS	(RTE_DIM(v4_tbl) + RTE_DIM(v6_tbl) + 1)
+#define RSS_TEST_NB_QUEUES	4
+#define RSS_TEST_RETA_SZ	128
+
+/* Build a TCP over IPv4, UDP over IPv6, or ARP packet of the test tables */
+static void
+rss_test_pkt_build(struct rte_mbuf *m, uint32_t i)
+{
+	struct rte_ether_hdr *eth;
+	struct rte_ipv4_hdr *ipv4;
+	struct rte_ipv6_hdr *ipv6;
+	struct rte_tcp_hdr *tcp;
+	struct rte_udp_hdr *udp;
+
+	eth = (struct rte_ether_hdr *)rte_pktmbuf_append(m, 128);
+	memset(eth, 0, 128);
+
+	if (i < RTE_DIM(v4_tbl)) {
+		eth->ether_type = RTE_BE16(RTE_ETHER_TYPE_IPV4);
+		ipv4 = (struct rte_ipv4_hdr *)(eth + 1);
+		ipv4->version_ihl = RTE_IPV4_VHL_DEF;
+		ipv4->next_proto_id = IPPROTO_TCP;
+		ipv4->src_addr = rte_cpu_to_be_32(v4_tbl[i].src_ip);
+		ipv4->dst_addr = rte_cpu_to_be_32(v4_tbl[i].dst_ip);
+		tcp = (struct rte_tcp_hdr *)(ipv4 + 1);
+		tcp->src_port = rte_cpu_to_be_16(v4_tbl[i].src_port);
+		tcp->dst_port = rte_cpu_to_be_16(v4_tbl[i].dst_port);
+	} else if (i < RTE_DIM(v4_tbl) + RTE_DIM(v6_tbl)) {
+		i -= RTE_DIM(v4_tbl);
+		eth->ether_type = RTE_BE16(RTE_ETHER_TYPE_IPV6);
+		ipv6 = (struct rte_ipv6_hdr *)(eth + 1);
+		ipv6->proto = IPPROTO_UDP;
+		ipv6->src_addr = v6_tbl[i].src_ip;
+		ipv6->dst_addr = v6_tbl[i].dst_ip;
+		udp = (struct rte_udp_hdr *)(ipv6 + 1);
+		udp->src_port = rte_cpu_to_be_16(v6_tbl[i].src_port);
+		udp->dst_port = rte_cpu_to_be_16(v6_tbl[i].dst_port);
+	} else {
+		eth->ether_type = RTE_BE16(RTE_ETHER_TYPE_ARP);
+	}
+}
+
+static uint32_t
+rss_test_expected_hash(uint32_t i, bool l4)
+{
+	if (i < RTE_DIM(v4_tbl))
+		return l4 ? v4_tbl[i].hash_l3l4 : v4_tbl[i].hash_l3;
+	i -= RTE_DIM(v4_tbl);
+	if (i < RTE_DIM(v6_tbl))
+		return l4 ? v6_tbl[i].hash_l3l4 : v6_tbl[i].hash_l3;
+	return 0;
+}
+
+static int
+test_thash_rss(void)
+{
+	struct rte_mbuf *queue_bufs[RSS_TEST_NB_QUEUES][RSS_TEST_NB_PKTS];
+	struct rte_mbuf **queue_pkts[RSS_TEST_NB_QUEUES];
+	uint16_t nb_queue_pkts[RSS_TEST_NB_QUEUES];
+	struct rte_mbuf *pkts[RSS_TEST_NB_PKTS] = { NULL };
+	uint16_t reta[RSS_TEST_RETA_SZ];
+	struct rte_thash_rss_conf conf = {
+		.key = default_rss_key,
+		.key_len = RTE_DIM(default_rss_key),
+		.reta = reta,
+		.reta_size = RSS_TEST_RETA_SZ,
+		.nb_queues = RSS_TEST_NB_QUEUES,
+		.socket_id = SOCKET_ID_ANY,
+	};
+	struct rte_thash_rss *rss = NULL;
+	struct rte_mempool *mp;
+	uint32_t i, l4, hash;
+	uint16_t q, n, total;
+	int ret = TEST_FAILED;
+
+	for (i = 0; i < RSS_TEST_RETA_SZ; i++)
+		reta[i] = i % RSS_TEST_NB_QUEUES;
+	for (q = 0; q < RSS_TEST_NB_QUEUES; q++)
+		queue_pkts[q] = queue_bufs[q];
+
+	mp = rte_pktmbuf_pool_create("thash_rss_test", 2 * RSS_TEST_NB_PKTS,
+		0, 0, RTE_MBUF_DEFAULT_BUF_SIZE, SOCKET_ID_ANY);
+	TEST_ASSERT_NOT_NULL(mp, "Cannot create mbuf pool");
+	if (rte_pktmbuf_alloc_bulk(mp, pkts, RSS_TEST_NB_PKTS) != 0) {
+		printf("Cannot allocate mbufs\n");
+		goto out;
+	}
+	for (i = 0; i < RSS_TEST_NB_PKTS; i++)
+		rss_test_pkt_build(pkts[i], i);
+
+	reta[0] = RSS_TEST_NB_QUEUES;
+	if (rte_thash_rss_create(&conf) != NULL) {
+		printf("Context created with an invalid RETA\n");
+		goto out;
+	}
+	reta[0] = 0;
+
+	for (l4 = 0; l4 <= 1; l4++) {
+		conf.flags = l4 ? RTE_THASH_RSS_F_L4 : 0;
+		rss = rte_thash_rss_create(&conf);
+		if (rss == NULL) {
+			printf("Cannot create software RSS context\n");
+			goto out;
+		}
+
+		rte_thash_rss_split(rss, pkts, RSS_TEST_NB_PKTS, queue_pkts,
+			nb_queue_pkts);
+
+		total = 0;
+		for (q = 0; q < RSS_TEST_NB_QUEUES; q++)
+			total += nb_queue_pkts[q];
+		if (total != RSS_TEST_NB_PKTS) {
+			printf("%u packets split out of %u\n", total,
+				(unsigned int)RSS_TEST_NB_PKTS);
+			goto out;
+		}
+
+		memset(nb_queue_pkts, 0, sizeof(nb_queue_pkts));
+		for (i = 0; i < RSS_TEST_NB_PKTS; i++) {
+			hash = rss_test_expected_hash(i, l4);
+			if (hash != 0 && (pkts[i]->hash.rss != hash ||
+					!(pkts[i]->ol_flags &
+					RTE_MBUF_F_RX_RSS_HASH))) {
+				printf("Packet %u: hash 0x%x instead of 0x%x\n",
+					i, pkts[i]->hash.rss, hash);
+				goto out;
+			}
+			/* packets of a queue are in order */
+			q = reta[hash % RSS_TEST_RETA_SZ];
+			n = nb_queue_pkts[q]++;
+			if (queue_pkts[q][n] != pkts[i]) {
+				printf("Packet %u not in queue %u\n", i, q);
+				goto out;
+			}
+		}
+
+		rte_thash_rss_free(rss);
+		rss = NULL;
+	}
+
+	ret = TEST_SUCCESS;
+out:
+	rte_thash_rss_free(rss);
+	for (i = 0; i < RSS_TEST_NB_PKTS; i++)
+		if (pkts[i] != NULL)
+			rte_pktmbuf_free(pkts[i]);
+	rte_mempool_free(mp);
+	return ret;
+}
+
 static struct unit_test_suite thash_tests = {
 	.suite_name = "thash autotest",
 	.setup = NULL,
@@ -1050,6 +1205,7 @@ static struct unit_test_suite thash_tests = {
 	TEST_CASE(test_adjust_tuple),
 	TEST_CASE(test_adjust_tuple_mult_reta),
 	TEST_CASE(test_keygen),
+	TEST_CASE(test_thash_rss),
 	TEST_CASES_END()
 	}
 };
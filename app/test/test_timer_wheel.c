@@ -0,0 +1,222 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include "test.h"
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_launch.h>
+#include <rte_lcore.h>
+#include <rte_memory.h>
+#include <rte_pause.h>
+#include <rte_random.h>
+#include <rte_timer_wheel.h>
+
+#define NB_TIMERS 1000
+#define TICK_NS 1000000 /* 1 ms */
+#define MAX_TICKS 100
+
+struct wheel_test_timer {
+	struct rte_timer_wheel_timer tim;
+	uint64_t armed_cycles;
+	uint64_t ticks;
+	unsigned int nb_expired;
+	unsigned int lcore_id;
+	int early;
+};
+
+static struct wheel_test_timer timers[NB_TIMERS];
+static RTE_ATOMIC(int) worker_stop;
+
+static void
+wheel_test_expire_cb(struct rte_timer_wheel_timer **tims, unsigned int nb_timers,
+		     void *arg __rte_unused)
+{
+	uint64_t now = rte_get_timer_cycles();
+	uint64_t tick_cycles = rte_get_timer_hz() / (NS_PER_S / TICK_NS);
+	unsigned int i;
+
+	for (i = 0; i < nb_timers; i++) {
+		struct wheel_test_timer *t = tims[i]->arg;
+
+		t->nb_expired++;
+		t->lcore_id = rte_lcore_id();
+		if (now - t->armed_cycles < t->ticks * tick_cycles)
+			t->early = 1;
+	}
+}
+
+static struct rte_timer_wheel *
+wheel_test_create(void)
+{
+	struct rte_timer_wheel_params params = {
+		.name = "test_timer_wheel",
+		.socket_id = SOCKET_ID_ANY,
+		.tick_ns = TICK_NS,
+		.expire_cb = wheel_test_expire_cb,
+	};
+	unsigned int i;
+
+	for (i = 0; i < NB_TIMERS; i++) {
+		timers[i].nb_expired = 0;
+		timers[i].early = 0;
+		timers[i].lcore_id = LCORE_ID_ANY;
+		rte_timer_wheel_timer_init(&timers[i].tim, &timers[i]);
+	}
+
+	return rte_timer_wheel_create(&params);
+}
+
+/* Manage the wheel of the calling lcore for some ticks */
+static void
+wheel_test_manage(struct rte_timer_wheel *tw, uint64_t ticks)
+{
+	uint64_t end = rte_get_timer_cycles() +
+		ticks * rte_get_timer_hz() / (NS_PER_S / TICK_NS);
+
+	while (rte_get_timer_cycles() < end) {
+		rte_timer_wheel_manage(tw);
+		rte_delay_us(10);
+	}
+}
+
+static int
+test_timer_wheel_single(void)
+{
+	struct rte_timer_wheel *tw;
+	unsigned int i;
+
+	tw = wheel_test_create();
+	TEST_ASSERT_NOT_NULL(tw, "failed to create timer wheel");
+
+	for (i = 0; i < NB_TIMERS; i++) {
+		timers[i].ticks = rte_rand_max(MAX_TICKS) + 1;
+		timers[i].armed_cycles = rte_get_timer_cycles();
+		TEST_ASSERT_SUCCESS(rte_timer_wheel_arm(tw, &timers[i].tim,
+				timers[i].ticks, SINGLE, LCORE_ID_ANY),
+				"failed to arm timer %u", i);
+	}
+	/* Stop a timer out of two */
+	for (i = 0; i < NB_TIMERS; i += 2)
+		TEST_ASSERT_SUCCESS(rte_timer_wheel_stop(tw, &timers[i].tim),
+				"failed to stop timer %u", i);
+
+	wheel_test_manage(tw, MAX_TICKS + 2);
+
+	for (i = 0; i < NB_TIMERS; i++) {
+		TEST_ASSERT_EQUAL(timers[i].nb_expired, i % 2,
+				"timer %u expired %u times", i, timers[i].nb_expired);
+		TEST_ASSERT(!timers[i].early, "timer %u expired early", i);
+		TEST_ASSERT(!rte_timer_wheel_pending(&timers[i].tim),
+				"timer %u still pending", i);
+	}
+
+	rte_timer_wheel_free(tw);
+
+	return TEST_SUCCESS;
+}
+
+static int
+test_timer_wheel_periodic(void)
+{
+	struct rte_timer_wheel *tw;
+
+	tw = wheel_test_create();
+	TEST_ASSERT_NOT_NULL(tw, "failed to create timer wheel");
+
+	timers[0].ticks = 2;
+	timers[0].armed_cycles = rte_get_timer_cycles();
+	TEST_ASSERT_SUCCESS(rte_timer_wheel_arm(tw, &timers[0].tim, 2,
+			PERIODICAL, LCORE_ID_ANY), "failed to arm timer");
+
+	wheel_test_manage(tw, 21);
+	TEST_ASSERT_SUCCESS(rte_timer_wheel_stop(tw, &timers[0].tim),
+			"failed to stop timer");
+	TEST_ASSERT(timers[0].nb_expired >= 9 && timers[0].nb_expired <= 10,
+			"periodic timer expired %u times", timers[0].nb_expired);
+
+	rte_timer_wheel_free(tw);
+
+	return TEST_SUCCESS;
+}
+
+static int
+wheel_test_worker(void *arg)
+{
+	struct rte_timer_wheel *tw = arg;
+
+	while (!rte_atomic_load_explicit(&worker_stop, rte_memory_order_acquire))
+		rte_timer_wheel_manage(tw);
+	rte_timer_wheel_manage(tw);
+
+	return 0;
+}
+
+static int
+test_timer_wheel_remote(void)
+{
+	struct rte_timer_wheel *tw;
+	unsigned int worker, i;
+
+	worker = rte_get_next_lcore(-1, 1, 0);
+	if (worker >= RTE_MAX_LCORE) {
+		printf("Not enough lcores, skipping test\n");
+		return TEST_SKIPPED;
+	}
+
+	tw = wheel_test_create();
+	TEST_ASSERT_NOT_NULL(tw, "failed to create timer wheel");
+
+	rte_atomic_store_explicit(&worker_stop, 0, rte_memory_order_relaxed);
+	rte_eal_remote_launch(wheel_test_worker, tw, worker);
+
+	for (i = 0; i < NB_TIMERS; i++) {
+		timers[i].ticks = rte_rand_max(MAX_TICKS) + 1;
+		timers[i].armed_cycles = rte_get_timer_cycles();
+		TEST_ASSERT_SUCCESS(rte_timer_wheel_arm(tw, &timers[i].tim,
+				timers[i].ticks, SINGLE, worker),
+				"failed to arm timer %u", i);
+	}
+	/* Only the worker can stop its timers */
+	TEST_ASSERT_EQUAL(rte_timer_wheel_stop(tw, &timers[0].tim), -EBUSY,
+			"stopped a timer of another lcore");
+
+	rte_delay_ms((MAX_TICKS + 2) * TICK_NS / 1000000);
+	rte_atomic_store_explicit(&worker_stop, 1, rte_memory_order_release);
+	rte_eal_wait_lcore(worker);
+
+	for (i = 0; i < NB_TIMERS; i++) {
+		TEST_ASSERT_EQUAL(timers[i].nb_expired, 1,
+				"timer %u expired %u times", i, timers[i].nb_expired);
+		TEST_ASSERT_EQUAL(timers[i].lcore_id, worker,
+				"timer %u expired on lcore %u", i, timers[i].lcore_id);
+		TEST_ASSERT(!timers[i].early, "timer %u expired early", i);
+	}
+
+	rte_timer_wheel_free(tw);
+
+	return TEST_SUCCESS;
+}
+
+static struct unit_test_suite timer_wheel_testsuite = {
+	.suite_name = "timer wheel autotest",
+	.unit_test_cases = {
+		TEST_CASE(test_timer_wheel_single),
+		TEST_CASE(test_timer_wheel_periodic),
+		TEST_CASE(test_timer_wheel_remote),
+		TEST_CASES_END()
+	}
+};
+
+static int
+test_timer_wheel(void)
+{
+	return unit_test_suite_runner(&timer_wheel_testsuite);
+}
+
+REGISTER_FAST_TEST(timer_wheel_autotest, NOHUGE_SKIP, ASAN_OK, test_timer_wheel);
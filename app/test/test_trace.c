@@ -133,6 +133,18 @@ test_trace_mode(void)
 
 	current = rte_trace_mode_get();
 
+	/* The stream mode can only be set at init */
+	if (current == RTE_TRACE_MODE_STREAM) {
+		rte_trace_mode_set(RTE_TRACE_MODE_DISCARD);
+		if (rte_trace_mode_get() != RTE_TRACE_MODE_STREAM)
+			goto failed;
+		return TEST_SUCCESS;
+	}
+
+	rte_trace_mode_set(RTE_TRACE_MODE_STREAM);
+	if (rte_trace_mode_get() != current)
+		goto failed;
+
 	rte_trace_mode_set(RTE_TRACE_MODE_DISCARD);
 	if (rte_trace_mode_get() != RTE_TRACE_MODE_DISCARD)
 		goto failed;
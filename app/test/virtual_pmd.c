@@ -15,6 +15,7 @@
 #include "virtual_pmd.h"
 
 #define MAX_PKT_BURST 512
+#define RECYCLE_RING_SIZE 64
 
 static const char *virtual_ethdev_driver_name = "Virtual PMD";
 
@@ -26,6 +27,11 @@ struct virtual_ethdev_private {
 	struct rte_ring *tx_queue;
 
 	int tx_burst_fail_count;
+
+	/* Rx mbuf ring refilled by mbufs recycling */
+	struct rte_mbuf *recycle_ring[RECYCLE_RING_SIZE];
+	uint16_t recycle_refill_head;
+	uint16_t recycle_receive_tail;
 };
 
 struct virtual_ethdev_queue {
@@ -226,6 +232,21 @@ virtual_ethdev_mac_address_set(__rte_unused struct rte_eth_dev *dev,
 	return 0;
 }
 
+static void
+virtual_ethdev_recycle_rxq_info_get(struct rte_eth_dev *dev,
+		uint16_t rx_queue_id __rte_unused,
+		struct rte_eth_recycle_rxq_info *recycle_rxq_info)
+{
+	struct virtual_ethdev_private *dev_private = dev->data->dev_private;
+
+	recycle_rxq_info->mbuf_ring = dev_private->recycle_ring;
+	recycle_rxq_info->mp = NULL;
+	recycle_rxq_info->refill_head = &dev_private->recycle_refill_head;
+	recycle_rxq_info->receive_tail = &dev_private->recycle_receive_tail;
+	recycle_rxq_info->mbuf_ring_size = RECYCLE_RING_SIZE;
+	recycle_rxq_info->refill_requirement = 0;
+}
+
 static const struct eth_dev_ops virtual_ethdev_default_dev_ops = {
 	.dev_configure = virtual_ethdev_configure_success,
 	.dev_start = virtual_ethdev_start_success,
@@ -239,7 +260,8 @@ static const struct eth_dev_ops virtual_ethdev_default_dev_ops = {
 	.stats_get = virtual_ethdev_stats_get,
 	.stats_reset = virtual_ethdev_stats_reset,
 	.promiscuous_enable = virtual_ethdev_promiscuous_mode_enable,
-	.promiscuous_disable = virtual_ethdev_promiscuous_mode_disable
+	.promiscuous_disable = virtual_ethdev_promiscuous_mode_disable,
+	.recycle_rxq_info_get = virtual_ethdev_recycle_rxq_info_get
 };
 
 void
@@ -409,6 +431,40 @@ virtual_ethdev_tx_burst_fail(void *queue, struct rte_mbuf **bufs,
 	return 0;
 }
 
+/* Move the transmitted mbufs to the free entries of the Rx mbuf ring */
+static uint16_t
+virtual_ethdev_recycle_tx_mbufs_reuse(void *queue,
+		struct rte_eth_recycle_rxq_info *recycle_rxq_info)
+{
+	struct virtual_ethdev_queue *tx_q = queue;
+	struct virtual_ethdev_private *dev_private;
+	uint16_t mask = recycle_rxq_info->mbuf_ring_size - 1;
+	uint16_t head = *recycle_rxq_info->refill_head;
+	uint16_t nb_free, i;
+	void *pkt;
+
+	dev_private = rte_eth_devices[tx_q->port_id].data->dev_private;
+	nb_free = recycle_rxq_info->mbuf_ring_size -
+		(uint16_t)(head - *recycle_rxq_info->receive_tail);
+
+	for (i = 0; i < nb_free; i++) {
+		if (rte_ring_dequeue(dev_private->tx_queue, &pkt) != 0)
+			break;
+		recycle_rxq_info->mbuf_ring[(head + i) & mask] = pkt;
+	}
+
+	return i;
+}
+
+static void
+virtual_ethdev_recycle_rx_descriptors_refill(void *queue, uint16_t nb)
+{
+	struct virtual_ethdev_queue *rx_q = queue;
+	struct virtual_ethdev_private *dev_private;
+
+	dev_private = rte_eth_devices[rx_q->port_id].data->dev_private;
+	dev_private->recycle_refill_head += nb;
+}
 
 void
 virtual_ethdev_rx_burst_fn_set_success(uint16_t port_id, uint8_t success)
@@ -594,6 +650,9 @@ virtual_ethdev_create(const char *name, struct rte_ether_addr *mac_addr,
 
 	eth_dev->rx_pkt_burst = virtual_ethdev_rx_burst_success;
 	eth_dev->tx_pkt_burst = virtual_ethdev_tx_burst_success;
+	eth_dev->recycle_tx_mbufs_reuse = virtual_ethdev_recycle_tx_mbufs_reuse;
+	eth_dev->recycle_rx_descriptors_refill =
+		virtual_ethdev_recycle_rx_descriptors_refill;
 
 	rte_eth_dev_probing_finish(eth_dev);
 
@@ -12,6 +12,9 @@
 #include <rte_kvargs.h>
 #include <rte_cycles.h>
 #include <rte_errno.h>
+#include <rte_pause.h>
+#include <rte_service.h>
+#include <rte_service_component.h>
 
 #include <rte_bbdev.h>
 #include <rte_bbdev_pmd.h>
@@ -50,25 +53,78 @@ RTE_LOG_REGISTER_DEFAULT(bbdev_turbo_sw_logtype, NOTICE);
 #define DEINT_INPUT_BUF_SIZE (((RTE_BBDEV_TURBO_MAX_CB_SIZE >> 3) + 1) * 48)
 #define DEINT_OUTPUT_BUF_SIZE (DEINT_INPUT_BUF_SIZE * 6)
 #define ADAPTER_OUTPUT_BUF_SIZE ((RTE_BBDEV_TURBO_MAX_CB_SIZE + 4) * 48)
+/* Per code block buffers of the batched LDPC decoder */
+#define LDPC_DEC_LLR_BUF_SIZE (RTE_BBDEV_TURBO_MAX_CB_SIZE * 10)
+#define LDPC_DEC_OUT_BUF_SIZE RTE_ALIGN_CEIL((RTE_BBDEV_LDPC_MAX_CB_SIZE >> 3) + \
+		RTE_CACHE_LINE_SIZE, RTE_CACHE_LINE_SIZE)
+
+#define TURBO_SW_MAX_LDPC_DEC_BATCH 64
+#define TURBO_SW_MAX_WORKERS 32
+/* Maximum number of operations processed by a worker per queue and run */
+#define TURBO_SW_WORKER_BURST 32U
+
+/* Asynchronous processing context, run as an EAL service */
+struct turbo_sw_worker {
+	struct rte_bbdev_data *data;
+	uint32_t service_id;
+	/* Index of the worker, processing the queues with id modulo nb_workers */
+	uint16_t id;
+	uint16_t nb_workers;
+	bool registered;
+};
 
 /* private data structure */
 struct bbdev_private {
 	unsigned int max_nb_queues;
+	/* Max number of LDPC decode code blocks processed together */
+	uint16_t ldpc_dec_batch;
+	/* Number of workers, synchronous processing on enqueue when zero */
+	uint16_t nb_workers;
+	struct turbo_sw_worker workers[TURBO_SW_MAX_WORKERS];
 };
 
 /*  Initialisation params structure that can be used by Turbo SW driver */
 struct turbo_sw_params {
 	int socket_id;
 	uint16_t queues_num;
+	uint16_t ldpc_dec_batch;
+	uint16_t nb_workers;
 };
 
 /* Acceptable params for Turbo SW devices */
 #define TURBO_SW_MAX_NB_QUEUES_ARG  "max_nb_queues"
 #define TURBO_SW_SOCKET_ID_ARG      "socket_id"
+#define TURBO_SW_LDPC_DEC_BATCH_ARG "ldpc_dec_batch"
+#define TURBO_SW_WORKERS_ARG        "workers"
 
 static const char * const turbo_sw_valid_params[] = {
 	TURBO_SW_MAX_NB_QUEUES_ARG,
-	TURBO_SW_SOCKET_ID_ARG
+	TURBO_SW_SOCKET_ID_ARG,
+	TURBO_SW_LDPC_DEC_BATCH_ARG,
+	TURBO_SW_WORKERS_ARG,
+	NULL
+};
+
+/* Code block of the batched LDPC decoder */
+struct turbo_sw_ldpc_dec_cb {
+	struct rte_bbdev_dec_op *op;
+	/* Input LLRs */
+	uint8_t *in;
+	/* Output data, already appended to the hard output mbuf */
+	uint8_t *out;
+	/* Rate dematched and HARQ combined LLRs */
+	int8_t *llr;
+	/* Decoder output */
+	uint8_t *dec_out;
+	struct rte_mbuf *m_harq_out_head;
+	struct rte_mbuf *m_harq_out;
+	uint32_t e;
+	uint16_t harq_out_offset;
+	uint16_t harq_in_length;
+	uint16_t out_length;
+	uint16_t crc24_overlap;
+	int16_t derm_out_size;
+	int16_t num_rows;
 };
 
 /* queue */
@@ -95,6 +151,14 @@ struct __rte_cache_aligned turbo_sw_queue {
 	uint8_t *adapter_output;
 	/* Operation type of this queue */
 	enum rte_bbdev_op_type type;
+	/* Ring of operations awaiting processing by a worker, if any */
+	struct rte_ring *pending;
+	/* Code blocks gathered by the batched LDPC decoder, if enabled */
+	struct turbo_sw_ldpc_dec_cb *ldpc_dec_cbs;
+	uint16_t ldpc_dec_batch;
+	uint16_t nb_ldpc_dec_cbs;
+	int8_t *ldpc_dec_llr;
+	uint8_t *ldpc_dec_out;
 };
 
 
@@ -280,6 +344,10 @@ q_release(struct rte_bbdev *dev, uint16_t q_id)
 
 	if (q != NULL) {
 		rte_ring_free(q->processed_pkts);
+		rte_ring_free(q->pending);
+		rte_free(q->ldpc_dec_cbs);
+		rte_free(q->ldpc_dec_llr);
+		rte_free(q->ldpc_dec_out);
 		rte_free(q->enc_out);
 		rte_free(q->enc_in);
 		rte_free(q->ag);
@@ -302,6 +370,7 @@ q_setup(struct rte_bbdev *dev, uint16_t q_id,
 		const struct rte_bbdev_queue_conf *queue_conf)
 {
 	int ret;
+	struct bbdev_private *internals = dev->data->dev_private;
 	struct turbo_sw_queue *q;
 	char name[RTE_RING_NAMESIZE];
 
@@ -476,6 +545,60 @@ q_setup(struct rte_bbdev *dev, uint16_t q_id,
 		goto free_q;
 	}
 
+	if (internals->nb_workers > 0) {
+		/* Create ring for operations awaiting to be processed. */
+		ret = snprintf(name, RTE_RING_NAMESIZE,
+				RTE_STR(DRIVER_NAME)"_p%u:%u",
+				dev->data->dev_id, q_id);
+		if ((ret < 0) || (ret >= (int)RTE_RING_NAMESIZE)) {
+			rte_bbdev_log(ERR,
+					"Creating queue name for device %u queue %u failed",
+					dev->data->dev_id, q_id);
+			ret = -ENAMETOOLONG;
+			goto free_q;
+		}
+		q->pending = rte_ring_create(name, queue_conf->queue_size,
+				queue_conf->socket, RING_F_SP_ENQ | RING_F_SC_DEQ);
+		if (q->pending == NULL) {
+			rte_bbdev_log(ERR, "Failed to create ring for %s", name);
+			ret = -rte_errno;
+			goto free_q;
+		}
+	}
+
+#ifdef RTE_BBDEV_SDK_AVX512
+	if (queue_conf->op_type == RTE_BBDEV_OP_LDPC_DEC &&
+			internals->ldpc_dec_batch > 1) {
+		uint16_t i;
+
+		/* Allocate memory for the batched LDPC decoder. */
+		q->ldpc_dec_batch = internals->ldpc_dec_batch;
+		q->ldpc_dec_cbs = rte_zmalloc_socket(NULL,
+				q->ldpc_dec_batch * sizeof(*q->ldpc_dec_cbs),
+				RTE_CACHE_LINE_SIZE, queue_conf->socket);
+		q->ldpc_dec_llr = rte_zmalloc_socket(NULL,
+				q->ldpc_dec_batch * LDPC_DEC_LLR_BUF_SIZE,
+				RTE_CACHE_LINE_SIZE, queue_conf->socket);
+		q->ldpc_dec_out = rte_zmalloc_socket(NULL,
+				q->ldpc_dec_batch * LDPC_DEC_OUT_BUF_SIZE,
+				RTE_CACHE_LINE_SIZE, queue_conf->socket);
+		if (q->ldpc_dec_cbs == NULL || q->ldpc_dec_llr == NULL ||
+				q->ldpc_dec_out == NULL) {
+			rte_bbdev_log(ERR,
+				"Failed to allocate LDPC decoder batch memory for device %u queue %u",
+				dev->data->dev_id, q_id);
+			ret = -ENOMEM;
+			goto free_q;
+		}
+		for (i = 0; i < q->ldpc_dec_batch; i++) {
+			q->ldpc_dec_cbs[i].llr = q->ldpc_dec_llr +
+					i * LDPC_DEC_LLR_BUF_SIZE;
+			q->ldpc_dec_cbs[i].dec_out = q->ldpc_dec_out +
+					i * LDPC_DEC_OUT_BUF_SIZE;
+		}
+	}
+#endif
+
 	q->type = queue_conf->op_type;
 
 	dev->data->queues[q_id].queue_private = q;
@@ -484,6 +607,10 @@ q_setup(struct rte_bbdev *dev, uint16_t q_id,
 
 free_q:
 	rte_ring_free(q->processed_pkts);
+	rte_ring_free(q->pending);
+	rte_free(q->ldpc_dec_cbs);
+	rte_free(q->ldpc_dec_llr);
+	rte_free(q->ldpc_dec_out);
 	rte_free(q->enc_out);
 	rte_free(q->enc_in);
 	rte_free(q->ag);
@@ -495,7 +622,48 @@ q_setup(struct rte_bbdev *dev, uint16_t q_id,
 	return ret;
 }
 
+/* Start device, enabling the workers */
+static int
+dev_start(struct rte_bbdev *dev)
+{
+	struct bbdev_private *internals = dev->data->dev_private;
+	uint16_t i;
+
+	for (i = 0; i < internals->nb_workers; i++) {
+		struct turbo_sw_worker *w = &internals->workers[i];
+
+		rte_service_component_runstate_set(w->service_id, 1);
+
+		/* check a service core is mapped to this service */
+		if (!rte_service_runstate_get(w->service_id))
+			rte_bbdev_log(WARNING,
+					"No service core enabled on worker %u of device %u",
+					i, dev->data->dev_id);
+	}
+
+	return 0;
+}
+
+/* Stop device, waiting for the workers to be idle */
+static void
+dev_stop(struct rte_bbdev *dev)
+{
+	struct bbdev_private *internals = dev->data->dev_private;
+	uint16_t i;
+
+	for (i = 0; i < internals->nb_workers; i++)
+		rte_service_component_runstate_set(
+				internals->workers[i].service_id, 0);
+
+	for (i = 0; i < internals->nb_workers; i++)
+		while (rte_service_may_be_active(
+				internals->workers[i].service_id) == 1)
+			rte_pause();
+}
+
 static const struct rte_bbdev_ops pmd_ops = {
+	.start = dev_start,
+	.stop = dev_stop,
 	.info_get = info_get,
 	.queue_setup = q_setup,
 	.queue_release = q_release
@@ -1335,6 +1503,240 @@ process_dec_cb(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 #endif
 }
 
+#ifdef RTE_BBDEV_SDK_AVX512
+/* Process the code blocks gathered by the batched LDPC decoder.
+ * Each stage of the decoding runs over all the code blocks before the next
+ * one, so that the code and tables of each SDK kernel stay hot in cache
+ * across the code blocks of different operations.
+ */
+static inline void
+ldpc_dec_batch_flush(struct turbo_sw_queue *q, struct rte_bbdev_stats *q_stats)
+{
+	struct bblib_rate_dematching_5gnr_request derm_req;
+	struct bblib_rate_dematching_5gnr_response derm_resp;
+	struct bblib_ldpc_decoder_5gnr_request dec_req;
+	struct bblib_ldpc_decoder_5gnr_response dec_resp;
+	struct bblib_crc_request crc_req;
+	struct bblib_crc_response crc_resp;
+	struct turbo_sw_ldpc_dec_cb *cb;
+	struct rte_bbdev_op_ldpc_dec *dec;
+	uint16_t i, K, parity_offset, sys_cols, outLenWithCrc;
+	uint8_t *harq_out;
+
+	if (q->nb_ldpc_dec_cbs == 0)
+		return;
+
+	uint64_t start_time = rte_rdtsc_precise();
+
+	/* Rate dematching and HARQ combining */
+	for (i = 0; i < q->nb_ldpc_dec_cbs; i++) {
+		cb = &q->ldpc_dec_cbs[i];
+		dec = &cb->op->ldpc_dec;
+		sys_cols = (dec->basegraph == 1) ? 22 : 10;
+		K = sys_cols * dec->z_c;
+		parity_offset = K - 2 * dec->z_c;
+
+		derm_req.p_in = (int8_t *) cb->in;
+		derm_req.p_harq = cb->llr; /* This doesn't include the filler bits */
+		derm_req.base_graph = dec->basegraph;
+		derm_req.zc = dec->z_c;
+		derm_req.ncb = dec->n_cb;
+		derm_req.e = cb->e;
+		derm_req.k0 = 0; /* Actual output from SDK */
+		derm_req.isretx = check_bit(dec->op_flags,
+				RTE_BBDEV_LDPC_HQ_COMBINE_IN_ENABLE);
+		derm_req.rvid = dec->rv_index;
+		derm_req.modulation_order = dec->q_m;
+		derm_req.start_null_index = parity_offset - dec->n_filler;
+		derm_req.num_of_null = dec->n_filler;
+
+		bblib_rate_dematching_5gnr(&derm_req, &derm_resp);
+
+		/* Compute RM out size and number of rows */
+		cb->derm_out_size = RTE_MIN(
+				derm_req.k0 + derm_req.e -
+				((derm_req.k0 < derm_req.start_null_index) ?
+						0 : dec->n_filler),
+				dec->n_cb - dec->n_filler);
+		if (cb->harq_in_length > 0)
+			cb->derm_out_size = RTE_MAX(cb->derm_out_size,
+					RTE_MIN(dec->n_cb - dec->n_filler,
+							cb->harq_in_length));
+		cb->num_rows = ((cb->derm_out_size + dec->n_filler +
+				dec->z_c - 1) / dec->z_c) - sys_cols + 2;
+		cb->num_rows = RTE_MAX(4, cb->num_rows);
+	}
+
+	/* LDPC decoding */
+	for (i = 0; i < q->nb_ldpc_dec_cbs; i++) {
+		cb = &q->ldpc_dec_cbs[i];
+		dec = &cb->op->ldpc_dec;
+
+		dec_req.Zc = dec->z_c;
+		dec_req.baseGraph = dec->basegraph;
+		dec_req.nRows = cb->num_rows;
+		dec_req.numChannelLlrs = cb->derm_out_size;
+		dec_req.varNodes = cb->llr;
+		dec_req.numFillerBits = dec->n_filler;
+		dec_req.maxIterations = dec->iter_max;
+		dec_req.enableEarlyTermination = check_bit(dec->op_flags,
+				RTE_BBDEV_LDPC_ITERATION_STOP_ENABLE);
+		dec_resp.varNodes = (int16_t *) q->adapter_output;
+		dec_resp.compactedMessageBytes = cb->dec_out;
+
+		bblib_ldpc_decoder_5gnr(&dec_req, &dec_resp);
+
+		dec->iter_count = RTE_MAX(dec_resp.iterationAtTermination,
+				dec->iter_count);
+		if (!dec_resp.parityPassedAtTermination)
+			cb->op->status |= 1 << RTE_BBDEV_SYNDROME_ERROR;
+
+		outLenWithCrc = cb->out_length + (cb->crc24_overlap >> 3);
+		bblib_bit_reverse((int8_t *) cb->dec_out, outLenWithCrc << 3);
+	}
+
+	/* CRC check */
+	for (i = 0; i < q->nb_ldpc_dec_cbs; i++) {
+		cb = &q->ldpc_dec_cbs[i];
+		dec = &cb->op->ldpc_dec;
+		K = ((dec->basegraph == 1) ? 22 : 10) * dec->z_c;
+
+		if (check_bit(dec->op_flags, RTE_BBDEV_LDPC_CRC_TYPE_24A_CHECK) ||
+				check_bit(dec->op_flags,
+						RTE_BBDEV_LDPC_CRC_TYPE_24B_CHECK)) {
+			crc_req.data = cb->dec_out;
+			crc_req.len  = K - dec->n_filler - 24;
+			crc_resp.check_passed = false;
+			crc_resp.data = cb->dec_out;
+			if (check_bit(dec->op_flags,
+					RTE_BBDEV_LDPC_CRC_TYPE_24B_CHECK))
+				bblib_lte_crc24b_check(&crc_req, &crc_resp);
+			else
+				bblib_lte_crc24a_check(&crc_req, &crc_resp);
+			if (!crc_resp.check_passed)
+				cb->op->status |= 1 << RTE_BBDEV_CRC_ERROR;
+		} else if (check_bit(dec->op_flags,
+				RTE_BBDEV_LDPC_CRC_TYPE_16_CHECK)) {
+			crc_req.data = cb->dec_out;
+			crc_req.len  = K - dec->n_filler - 16;
+			crc_resp.check_passed = false;
+			crc_resp.data = cb->dec_out;
+			bblib_lte_crc16_check(&crc_req, &crc_resp);
+			if (!crc_resp.check_passed)
+				cb->op->status |= 1 << RTE_BBDEV_CRC_ERROR;
+		}
+	}
+
+	q_stats->acc_offload_cycles += rte_rdtsc_precise() - start_time;
+
+	/* Copy of the outputs */
+	for (i = 0; i < q->nb_ldpc_dec_cbs; i++) {
+		cb = &q->ldpc_dec_cbs[i];
+		dec = &cb->op->ldpc_dec;
+
+		if (check_bit(dec->op_flags,
+				RTE_BBDEV_LDPC_HQ_COMBINE_OUT_ENABLE)) {
+			harq_out = NULL;
+			if (cb->m_harq_out != NULL) {
+				/* Initialize HARQ data length since we overwrite */
+				cb->m_harq_out->data_len = 0;
+				/* Check there is enough space
+				 * in the HARQ outbound buffer
+				 */
+				harq_out = (uint8_t *)mbuf_append(
+						cb->m_harq_out_head,
+						cb->m_harq_out,
+						cb->derm_out_size);
+			}
+			if (harq_out == NULL) {
+				cb->op->status |= 1 << RTE_BBDEV_DATA_ERROR;
+				rte_bbdev_log(ERR, "No space in HARQ output mbuf");
+				continue;
+			}
+			/* get output data starting address and overwrite the data */
+			harq_out = rte_pktmbuf_mtod_offset(cb->m_harq_out,
+					uint8_t *, cb->harq_out_offset);
+			rte_memcpy(harq_out, cb->llr, cb->derm_out_size);
+			dec->harq_combined_output.length += cb->derm_out_size;
+		}
+
+		rte_memcpy(cb->out, cb->dec_out, cb->out_length);
+		dec->hard_output.length += cb->out_length;
+	}
+
+	q->nb_ldpc_dec_cbs = 0;
+}
+
+/* Add a code block to the batched LDPC decoder, processing the batch once
+ * full. The outputs of the code block are only written by
+ * ldpc_dec_batch_flush().
+ */
+static inline void
+ldpc_dec_batch_add_cb(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
+		uint16_t out_length, uint32_t e,
+		struct rte_mbuf *m_in,
+		struct rte_mbuf *m_out_head, struct rte_mbuf *m_out,
+		struct rte_mbuf *m_harq_in,
+		struct rte_mbuf *m_harq_out_head, struct rte_mbuf *m_harq_out,
+		uint16_t in_offset, uint16_t out_offset,
+		uint16_t harq_in_offset, uint16_t harq_out_offset,
+		uint16_t crc24_overlap,
+		struct rte_bbdev_stats *q_stats)
+{
+	struct turbo_sw_ldpc_dec_cb *cb = &q->ldpc_dec_cbs[q->nb_ldpc_dec_cbs];
+	struct rte_bbdev_op_ldpc_dec *dec = &op->ldpc_dec;
+	uint8_t *harq_in, *out;
+
+	if (check_bit(dec->op_flags, RTE_BBDEV_LDPC_HQ_COMBINE_IN_ENABLE)) {
+		/**
+		 *  Single contiguous block from the first LLR of the
+		 *  circular buffer.
+		 */
+		harq_in = NULL;
+		if (m_harq_in != NULL)
+			harq_in = rte_pktmbuf_mtod_offset(m_harq_in,
+				uint8_t *, harq_in_offset);
+		if (harq_in == NULL) {
+			op->status |= 1 << RTE_BBDEV_DATA_ERROR;
+			rte_bbdev_log(ERR, "No space in harq input mbuf");
+			return;
+		}
+		uint16_t harq_in_length = RTE_MIN(
+				dec->harq_combined_input.length,
+				(uint32_t) dec->n_cb);
+		memset(cb->llr + harq_in_length, 0,
+				dec->n_cb - harq_in_length);
+		rte_memcpy(cb->llr, harq_in, harq_in_length);
+	}
+
+	/* get output data starting address */
+	out = (uint8_t *)mbuf_append(m_out_head, m_out, out_length);
+	if (out == NULL) {
+		op->status |= 1 << RTE_BBDEV_DATA_ERROR;
+		rte_bbdev_log(ERR,
+				"Too little space in LDPC decoder output mbuf");
+		return;
+	}
+
+	cb->op = op;
+	cb->in = rte_pktmbuf_mtod_offset(m_in, uint8_t *, in_offset);
+	/* rte_bbdev_op_data.offset can be different than the offset
+	 * of the appended bytes
+	 */
+	cb->out = rte_pktmbuf_mtod_offset(m_out, uint8_t *, out_offset);
+	cb->m_harq_out_head = m_harq_out_head;
+	cb->m_harq_out = m_harq_out;
+	cb->harq_out_offset = harq_out_offset;
+	cb->harq_in_length = (m_harq_in != NULL) ? m_harq_in->data_len : 0;
+	cb->e = e;
+	cb->out_length = out_length;
+	cb->crc24_overlap = crc24_overlap;
+
+	if (++q->nb_ldpc_dec_cbs == q->ldpc_dec_batch)
+		ldpc_dec_batch_flush(q, q_stats);
+}
+#endif
+
 static inline void
 process_ldpc_dec_cb(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 		uint8_t c, uint16_t out_length, uint32_t e,
@@ -1351,6 +1753,15 @@ process_ldpc_dec_cb(struct turbo_sw_queue *q, struct rte_bbdev_dec_op *op,
 #ifdef RTE_BBDEV_SDK_AVX512
 	RTE_SET_USED(in_length);
 	RTE_SET_USED(c);
+	if (q->ldpc_dec_cbs != NULL) {
+		ldpc_dec_batch_add_cb(q, op, out_length, e, m_in,
+				m_out_head, m_out, m_harq_in,
+				m_harq_out_head, m_harq_out,
+				in_offset, out_offset, harq_in_offset,
+				harq_out_offset, crc24_overlap, q_stats);
+		return;
+	}
+
 	uint8_t *in, *out, *harq_in, *harq_out, *adapter_input;
 	struct bblib_rate_dematching_5gnr_request derm_req;
 	struct bblib_rate_dematching_5gnr_response derm_resp;
@@ -1734,6 +2145,9 @@ enqueue_ldpc_dec_all_ops(struct turbo_sw_queue *q,
 
 	for (i = 0; i < nb_ops; ++i)
 		enqueue_ldpc_dec_one_op(q, ops[i], queue_stats);
+#ifdef RTE_BBDEV_SDK_AVX512
+	ldpc_dec_batch_flush(q, queue_stats);
+#endif
 
 	return rte_ring_enqueue_burst(q->processed_pkts, (void **)ops, nb_ops,
 			NULL);
@@ -1748,7 +2162,12 @@ enqueue_enc_ops(struct rte_bbdev_queue_data *q_data,
 	struct turbo_sw_queue *q = queue;
 	uint16_t nb_enqueued = 0;
 
-	nb_enqueued = enqueue_enc_all_ops(q, ops, nb_ops, &q_data->queue_stats);
+	if (q->pending != NULL)
+		nb_enqueued = rte_ring_enqueue_burst(q->pending, (void **)ops,
+				nb_ops, NULL);
+	else
+		nb_enqueued = enqueue_enc_all_ops(q, ops, nb_ops,
+				&q_data->queue_stats);
 
 	q_data->queue_stats.enqueue_err_count += nb_ops - nb_enqueued;
 	q_data->queue_stats.enqueued_count += nb_enqueued;
@@ -1765,8 +2184,12 @@ enqueue_ldpc_enc_ops(struct rte_bbdev_queue_data *q_data,
 	struct turbo_sw_queue *q = queue;
 	uint16_t nb_enqueued = 0;
 
-	nb_enqueued = enqueue_ldpc_enc_all_ops(
-			q, ops, nb_ops, &q_data->queue_stats);
+	if (q->pending != NULL)
+		nb_enqueued = rte_ring_enqueue_burst(q->pending, (void **)ops,
+				nb_ops, NULL);
+	else
+		nb_enqueued = enqueue_ldpc_enc_all_ops(
+				q, ops, nb_ops, &q_data->queue_stats);
 
 	q_data->queue_stats.enqueue_err_count += nb_ops - nb_enqueued;
 	q_data->queue_stats.enqueued_count += nb_enqueued;
@@ -1783,7 +2206,12 @@ enqueue_dec_ops(struct rte_bbdev_queue_data *q_data,
 	struct turbo_sw_queue *q = queue;
 	uint16_t nb_enqueued = 0;
 
-	nb_enqueued = enqueue_dec_all_ops(q, ops, nb_ops, &q_data->queue_stats);
+	if (q->pending != NULL)
+		nb_enqueued = rte_ring_enqueue_burst(q->pending, (void **)ops,
+				nb_ops, NULL);
+	else
+		nb_enqueued = enqueue_dec_all_ops(q, ops, nb_ops,
+				&q_data->queue_stats);
 
 	q_data->queue_stats.enqueue_err_count += nb_ops - nb_enqueued;
 	q_data->queue_stats.enqueued_count += nb_enqueued;
@@ -1800,8 +2228,12 @@ enqueue_ldpc_dec_ops(struct rte_bbdev_queue_data *q_data,
 	struct turbo_sw_queue *q = queue;
 	uint16_t nb_enqueued = 0;
 
-	nb_enqueued = enqueue_ldpc_dec_all_ops(q, ops, nb_ops,
-			&q_data->queue_stats);
+	if (q->pending != NULL)
+		nb_enqueued = rte_ring_enqueue_burst(q->pending, (void **)ops,
+				nb_ops, NULL);
+	else
+		nb_enqueued = enqueue_ldpc_dec_all_ops(q, ops, nb_ops,
+				&q_data->queue_stats);
 
 	q_data->queue_stats.enqueue_err_count += nb_ops - nb_enqueued;
 	q_data->queue_stats.enqueued_count += nb_enqueued;
@@ -1835,6 +2267,109 @@ dequeue_enc_ops(struct rte_bbdev_queue_data *q_data,
 	return nb_dequeued;
 }
 
+/* Process the pending operations of the queues of a worker */
+static int32_t
+turbo_sw_worker_run(void *arg)
+{
+	struct turbo_sw_worker *w = arg;
+	struct rte_bbdev_data *data = w->data;
+	struct rte_bbdev_stats stats;
+	void *ops[TURBO_SW_WORKER_BURST];
+	struct turbo_sw_queue *q;
+	unsigned int nb_ops;
+	uint32_t nb_processed = 0;
+	uint16_t q_id;
+
+	for (q_id = w->id; q_id < data->num_queues; q_id += w->nb_workers) {
+		q = data->queues[q_id].queue_private;
+		if (q == NULL)
+			continue;
+
+		/* Only take what can be made available to dequeue */
+		nb_ops = RTE_MIN(rte_ring_free_count(q->processed_pkts),
+				TURBO_SW_WORKER_BURST);
+		nb_ops = rte_ring_dequeue_burst(q->pending, ops, nb_ops, NULL);
+		if (nb_ops == 0)
+			continue;
+
+		switch (q->type) {
+		case RTE_BBDEV_OP_TURBO_ENC:
+			enqueue_enc_all_ops(q, (struct rte_bbdev_enc_op **)ops,
+					nb_ops, &stats);
+			break;
+		case RTE_BBDEV_OP_LDPC_ENC:
+			enqueue_ldpc_enc_all_ops(q,
+					(struct rte_bbdev_enc_op **)ops,
+					nb_ops, &stats);
+			break;
+		case RTE_BBDEV_OP_TURBO_DEC:
+			enqueue_dec_all_ops(q, (struct rte_bbdev_dec_op **)ops,
+					nb_ops, &stats);
+			break;
+		case RTE_BBDEV_OP_LDPC_DEC:
+			enqueue_ldpc_dec_all_ops(q,
+					(struct rte_bbdev_dec_op **)ops,
+					nb_ops, &stats);
+			break;
+		default:
+			break;
+		}
+		nb_processed += nb_ops;
+	}
+
+	return nb_processed > 0 ? 0 : -EAGAIN;
+}
+
+/* Unregister the services of the workers */
+static void
+turbo_sw_workers_free(struct bbdev_private *internals)
+{
+	uint16_t i;
+
+	for (i = 0; i < internals->nb_workers; i++) {
+		struct turbo_sw_worker *w = &internals->workers[i];
+
+		if (w->registered)
+			rte_service_component_unregister(w->service_id);
+		w->registered = false;
+	}
+}
+
+/* Register one service per worker with EAL */
+static int
+turbo_sw_workers_init(struct rte_bbdev *dev, int socket_id)
+{
+	struct bbdev_private *internals = dev->data->dev_private;
+	struct rte_service_spec service;
+	uint16_t i;
+
+	for (i = 0; i < internals->nb_workers; i++) {
+		struct turbo_sw_worker *w = &internals->workers[i];
+
+		w->data = dev->data;
+		w->id = i;
+		w->nb_workers = internals->nb_workers;
+
+		memset(&service, 0, sizeof(struct rte_service_spec));
+		snprintf(service.name, sizeof(service.name),
+				"turbo_sw%u_worker_%u", dev->data->dev_id, i);
+		service.socket_id = socket_id;
+		service.callback = turbo_sw_worker_run;
+		service.callback_userdata = w;
+
+		if (rte_service_component_register(&service,
+				&w->service_id)) {
+			rte_bbdev_log(ERR, "Failed to register service %s",
+					service.name);
+			turbo_sw_workers_free(internals);
+			return -ENOEXEC;
+		}
+		w->registered = true;
+	}
+
+	return 0;
+}
+
 /* Parse 16bit integer from string argument */
 static inline int
 parse_u16_arg(const char *key, const char *value, void *extra_args)
@@ -1878,6 +2413,30 @@ parse_turbo_sw_params(struct turbo_sw_params *params, const char *input_args)
 		if (ret < 0)
 			goto exit;
 
+		ret = rte_kvargs_process(kvlist, turbo_sw_valid_params[2],
+					&parse_u16_arg, &params->ldpc_dec_batch);
+		if (ret < 0)
+			goto exit;
+
+		ret = rte_kvargs_process(kvlist, turbo_sw_valid_params[3],
+					&parse_u16_arg, &params->nb_workers);
+		if (ret < 0)
+			goto exit;
+
+		if (params->ldpc_dec_batch > TURBO_SW_MAX_LDPC_DEC_BATCH) {
+			rte_bbdev_log(ERR, "Invalid LDPC decode batch, must be <= %u",
+					TURBO_SW_MAX_LDPC_DEC_BATCH);
+			ret = -EINVAL;
+			goto exit;
+		}
+
+		if (params->nb_workers > TURBO_SW_MAX_WORKERS) {
+			rte_bbdev_log(ERR, "Invalid number of workers, must be <= %u",
+					TURBO_SW_MAX_WORKERS);
+			ret = -EINVAL;
+			goto exit;
+		}
+
 		if (params->socket_id >= RTE_MAX_NUMA_NODES) {
 			rte_bbdev_log(ERR, "Invalid socket, must be < %u",
 					RTE_MAX_NUMA_NODES);
@@ -1896,7 +2455,9 @@ turbo_sw_bbdev_create(struct rte_vdev_device *vdev,
 		struct turbo_sw_params *init_params)
 {
 	struct rte_bbdev *bbdev;
+	struct bbdev_private *internals;
 	const char *name = rte_vdev_device_name(vdev);
+	int ret;
 
 	bbdev = rte_bbdev_allocate(name);
 	if (bbdev == NULL)
@@ -1924,8 +2485,18 @@ turbo_sw_bbdev_create(struct rte_vdev_device *vdev,
 	bbdev->dequeue_ldpc_dec_ops = dequeue_dec_ops;
 	bbdev->enqueue_ldpc_enc_ops = enqueue_ldpc_enc_ops;
 	bbdev->enqueue_ldpc_dec_ops = enqueue_ldpc_dec_ops;
-	((struct bbdev_private *) bbdev->data->dev_private)->max_nb_queues =
-			init_params->queues_num;
+	internals = bbdev->data->dev_private;
+	internals->max_nb_queues = init_params->queues_num;
+	internals->ldpc_dec_batch = init_params->ldpc_dec_batch;
+	internals->nb_workers = init_params->nb_workers;
+
+	/* Registered at probe for EAL to map them to its service cores */
+	ret = turbo_sw_workers_init(bbdev, init_params->socket_id);
+	if (ret < 0) {
+		rte_free(bbdev->data->dev_private);
+		rte_bbdev_release(bbdev);
+		return ret;
+	}
 
 	return 0;
 }
@@ -1936,7 +2507,9 @@ turbo_sw_bbdev_probe(struct rte_vdev_device *vdev)
 {
 	struct turbo_sw_params init_params = {
 		rte_socket_id(),
-		RTE_BBDEV_DEFAULT_MAX_NB_QUEUES
+		RTE_BBDEV_DEFAULT_MAX_NB_QUEUES,
+		1,
+		0
 	};
 	const char *name;
 	const char *input_args;
@@ -1951,8 +2524,9 @@ turbo_sw_bbdev_probe(struct rte_vdev_device *vdev)
 	parse_turbo_sw_params(&init_params, input_args);
 
 	rte_bbdev_log_debug(
-			"Initialising %s on NUMA node %d with max queues: %d",
-			name, init_params.socket_id, init_params.queues_num);
+			"Initialising %s on NUMA node %d with max queues: %d, LDPC decode batch: %u, workers: %u",
+			name, init_params.socket_id, init_params.queues_num,
+			init_params.ldpc_dec_batch, init_params.nb_workers);
 
 	return turbo_sw_bbdev_create(vdev, &init_params);
 }
@@ -1975,6 +2549,7 @@ turbo_sw_bbdev_remove(struct rte_vdev_device *vdev)
 	if (bbdev == NULL)
 		return -EINVAL;
 
+	turbo_sw_workers_free(bbdev->data->dev_private);
 	rte_free(bbdev->data->dev_private);
 
 	return rte_bbdev_release(bbdev);
@@ -1988,5 +2563,7 @@ static struct rte_vdev_driver bbdev_turbo_sw_pmd_drv = {
 RTE_PMD_REGISTER_VDEV(DRIVER_NAME, bbdev_turbo_sw_pmd_drv);
 RTE_PMD_REGISTER_PARAM_STRING(DRIVER_NAME,
 	TURBO_SW_MAX_NB_QUEUES_ARG"=<int> "
-	TURBO_SW_SOCKET_ID_ARG"=<int>");
+	TURBO_SW_SOCKET_ID_ARG"=<int> "
+	TURBO_SW_LDPC_DEC_BATCH_ARG"=<int> "
+	TURBO_SW_WORKERS_ARG"=<int>");
 RTE_PMD_REGISTER_ALIAS(DRIVER_NAME, turbo_sw);
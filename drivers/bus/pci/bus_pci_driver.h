@@ -153,6 +153,11 @@ struct rte_pci_driver {
 #define RTE_PCI_DRV_KEEP_MAPPED_RES 0x0020
 /** Device driver needs IOVA as VA and cannot work with IOVA as PA */
 #define RTE_PCI_DRV_NEED_IOVA_AS_VA 0x0040
+/**
+ * Device driver probe can run in parallel with the probe of other devices,
+ * the functions of a same device being probed in order.
+ */
+#define RTE_PCI_DRV_PROBE_PARALLEL 0x0080
 
 /**
  * Register a PCI driver.
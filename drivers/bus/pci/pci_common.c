@@ -27,12 +27,17 @@
 #include <rte_devargs.h>
 #include <rte_vfio.h>
 #include <rte_tailq.h>
+#include <rte_stdatomic.h>
+#include <rte_thread.h>
 
 #include "private.h"
 
 
 #define SYSFS_PCI_DEVICES "/sys/bus/pci/devices"
 
+/* Maximum number of threads probing the devices in parallel */
+#define PCI_PROBE_THREADS_MAX 16
+
 RTE_EXPORT_INTERNAL_SYMBOL(rte_pci_get_sysfs_path)
 const char *rte_pci_get_sysfs_path(void)
 {
@@ -392,6 +397,145 @@ pci_probe_all_drivers(struct rte_pci_device *dev)
 	return 1;
 }
 
+/*
+ * Check if all the drivers matching a device can probe it in parallel
+ * with other devices.
+ */
+static bool
+pci_probe_parallel_allowed(struct rte_pci_device *dev)
+{
+	struct rte_pci_driver *dr;
+	bool matched = false;
+
+	FOREACH_DRIVER_ON_PCIBUS(dr) {
+		if (!rte_pci_match(dr, dev))
+			continue;
+		if (!(dr->drv_flags & RTE_PCI_DRV_PROBE_PARALLEL))
+			return false;
+		matched = true;
+	}
+	return matched;
+}
+
+/* Devices of a same slot, probed in order by one thread. */
+struct pci_probe_job {
+	struct rte_pci_device **devs;
+	int *ret;
+	uint32_t n_devs;
+};
+
+struct pci_probe_ctx {
+	struct pci_probe_job *jobs;
+	uint32_t n_jobs;
+	RTE_ATOMIC(uint32_t) next;
+};
+
+static uint32_t
+pci_probe_thread(void *arg)
+{
+	struct pci_probe_ctx *ctx = arg;
+
+	for ( ; ; ) {
+		struct pci_probe_job *job;
+		uint32_t i;
+
+		i = rte_atomic_fetch_add_explicit(&ctx->next, 1,
+			rte_memory_order_relaxed);
+		if (i >= ctx->n_jobs)
+			break;
+
+		job = &ctx->jobs[i];
+		for (i = 0; i < job->n_devs; i++)
+			job->ret[i] = pci_probe_all_drivers(job->devs[i]);
+	}
+	return 0;
+}
+
+/*
+ * Probe the devices of the drivers allowing it in parallel, one job per slot.
+ * Return the number of devices probed, or 0 if parallel probe is not used.
+ */
+static size_t
+pci_probe_parallel(size_t *failed)
+{
+	struct pci_probe_ctx ctx = { 0 };
+	rte_thread_t threads[PCI_PROBE_THREADS_MAX];
+	struct rte_pci_device **devs = NULL;
+	struct rte_pci_device *dev;
+	uint32_t n_devs = 0, n_threads, i;
+	int *ret = NULL;
+
+	FOREACH_DEVICE_ON_PCIBUS(dev)
+		n_devs++;
+	if (n_devs < 2)
+		return 0;
+
+	devs = calloc(n_devs, sizeof(*devs));
+	ret = calloc(n_devs, sizeof(*ret));
+	ctx.jobs = calloc(n_devs, sizeof(*ctx.jobs));
+	if (devs == NULL || ret == NULL || ctx.jobs == NULL)
+		goto out;
+
+	/* The bus list is sorted, the functions of a slot are contiguous. */
+	n_devs = 0;
+	FOREACH_DEVICE_ON_PCIBUS(dev) {
+		struct pci_probe_job *job;
+
+		if (!pci_probe_parallel_allowed(dev))
+			continue;
+
+		job = ctx.n_jobs ? &ctx.jobs[ctx.n_jobs - 1] : NULL;
+		if (job == NULL ||
+		    job->devs[0]->addr.domain != dev->addr.domain ||
+		    job->devs[0]->addr.bus != dev->addr.bus ||
+		    job->devs[0]->addr.devid != dev->addr.devid) {
+			job = &ctx.jobs[ctx.n_jobs++];
+			job->devs = &devs[n_devs];
+			job->ret = &ret[n_devs];
+		}
+		devs[n_devs++] = dev;
+		job->n_devs++;
+	}
+	if (ctx.n_jobs < 2) {
+		n_devs = 0;
+		goto out;
+	}
+
+	n_threads = RTE_MIN(ctx.n_jobs, (uint32_t)PCI_PROBE_THREADS_MAX);
+	for (i = 0; i < n_threads; i++) {
+		char name[RTE_THREAD_INTERNAL_NAME_SIZE];
+
+		snprintf(name, sizeof(name), "pci-prb-%u", i);
+		if (rte_thread_create_internal_control(&threads[i], name,
+				pci_probe_thread, &ctx) != 0)
+			break;
+	}
+	n_threads = i;
+	PCI_LOG(DEBUG, "Probing %u devices of %u slots with %u threads",
+		n_devs, ctx.n_jobs, n_threads);
+
+	/* Probe in this thread as well, in case no thread could be created. */
+	pci_probe_thread(&ctx);
+	for (i = 0; i < n_threads; i++)
+		rte_thread_join(threads[i], NULL);
+
+	for (i = 0; i < n_devs; i++) {
+		if (ret[i] < 0 && ret[i] != -EEXIST) {
+			PCI_LOG(ERR, "Requested device " PCI_PRI_FMT " cannot be used",
+				devs[i]->addr.domain, devs[i]->addr.bus,
+				devs[i]->addr.devid, devs[i]->addr.function);
+			rte_errno = -ret[i];
+			(*failed)++;
+		}
+	}
+
+out:
+	free(ctx.jobs);
+	free(ret);
+	free(devs);
+	return n_devs;
+}
+
 /*
  * Scan the content of the PCI bus, and call the probe() function for
  * all registered drivers that have a matching entry in its id_table
@@ -402,9 +546,16 @@ pci_probe(void)
 {
 	struct rte_pci_device *dev = NULL;
 	size_t probed = 0, failed = 0;
+	bool parallel;
 	int ret = 0;
 
+	probed = pci_probe_parallel(&failed);
+	parallel = probed != 0;
+
 	FOREACH_DEVICE_ON_PCIBUS(dev) {
+		if (parallel && pci_probe_parallel_allowed(dev))
+			continue;
+
 		probed++;
 
 		ret = pci_probe_all_drivers(dev);
@@ -8,6 +8,7 @@
 #include <rte_cpuflags.h>
 #include <rte_malloc.h>
 #include <rte_mbuf.h>
+#include <rte_prefetch.h>
 #include <rte_compressdev_pmd.h>
 
 #include "isal_compress_pmd_private.h"
@@ -26,6 +27,80 @@
 #define ISAL_VERSION_STRING \
 	ISAL_TOSTRING(ISAL_MAJOR_VERSION, ISAL_MINOR_VERSION, ISAL_PATCH_VERSION)
 
+/* Dictionaries can be processed once and reused since ISA-L 2.29 */
+#if ISAL_MAJOR_VERSION > 2 || \
+	(ISAL_MAJOR_VERSION == 2 && ISAL_MINOR_VERSION >= 29)
+#define ISAL_PROCESSED_DICT
+#endif
+
+/* Free the dictionary of a private xform */
+void
+isal_comp_free_priv_xform_dictionary(struct isal_priv_xform *priv_xform)
+{
+	rte_free(priv_xform->dict);
+	priv_xform->dict = NULL;
+	rte_free(priv_xform->dict_buf);
+	priv_xform->dict_buf = NULL;
+	priv_xform->dict_len = 0;
+}
+
+/*
+ * Copy the preset dictionary of the xform, to be shared by all the operations
+ * of the private xform. For compression, the dictionary is also processed
+ * once, its hash table being only copied to the stream of each operation.
+ */
+static int
+isal_comp_set_priv_xform_dictionary(struct isal_priv_xform *priv_xform,
+		const uint8_t *dictionary, uint16_t dictionary_len)
+{
+#ifdef ISAL_PROCESSED_DICT
+	struct isal_zstream *stream;
+#endif
+
+	priv_xform->dict_buf = NULL;
+	priv_xform->dict_len = 0;
+	priv_xform->dict = NULL;
+
+	if (dictionary == NULL || dictionary_len == 0)
+		return 0;
+
+	priv_xform->dict_buf = rte_malloc(NULL, dictionary_len, 0);
+	if (priv_xform->dict_buf == NULL) {
+		ISAL_PMD_LOG(ERR, "Dictionary could not be allocated");
+		return -ENOMEM;
+	}
+	memcpy(priv_xform->dict_buf, dictionary, dictionary_len);
+	priv_xform->dict_len = dictionary_len;
+
+#ifdef ISAL_PROCESSED_DICT
+	if (priv_xform->type != RTE_COMP_COMPRESS)
+		return 0;
+
+	priv_xform->dict = rte_malloc(NULL, sizeof(struct isal_dict), 0);
+	stream = rte_zmalloc(NULL, sizeof(struct isal_zstream), 0);
+	if (priv_xform->dict == NULL || stream == NULL) {
+		ISAL_PMD_LOG(ERR, "Dictionary could not be allocated");
+		rte_free(stream);
+		isal_comp_free_priv_xform_dictionary(priv_xform);
+		return -ENOMEM;
+	}
+
+	/* The hash table of the dictionary depends on the level */
+	isal_deflate_init(stream);
+	stream->level = priv_xform->compress.level;
+	if (isal_deflate_process_dict(stream, priv_xform->dict,
+			priv_xform->dict_buf, priv_xform->dict_len) != COMP_OK) {
+		ISAL_PMD_LOG(ERR, "Dictionary could not be processed");
+		rte_free(stream);
+		isal_comp_free_priv_xform_dictionary(priv_xform);
+		return -EINVAL;
+	}
+	rte_free(stream);
+#endif
+
+	return 0;
+}
+
 /* Verify and set private xform parameters */
 int
 isal_comp_set_priv_xform_parameters(struct isal_priv_xform *priv_xform,
@@ -177,6 +252,10 @@ isal_comp_set_priv_xform_parameters(struct isal_priv_xform *priv_xform,
 				}
 			}
 		}
+
+		return isal_comp_set_priv_xform_dictionary(priv_xform,
+				xform->compress.deflate.dictionary,
+				xform->compress.deflate.dictionary_len);
 	}
 
 	/* Set decompression private xform variables */
@@ -226,6 +305,10 @@ isal_comp_set_priv_xform_parameters(struct isal_priv_xform *priv_xform,
 			ISAL_PMD_LOG(ERR, "Window size not supported");
 			return -ENOTSUP;
 		}
+
+		return isal_comp_set_priv_xform_dictionary(priv_xform,
+				xform->decompress.inflate.dictionary,
+				xform->decompress.inflate.dictionary_len);
 	}
 	return 0;
 }
@@ -450,6 +533,21 @@ process_isal_deflate(struct rte_comp_op *op, struct isal_comp_qp *qp,
 		isal_deflate_set_hufftables(qp->stream, NULL,
 				IGZIP_HUFFTABLE_DEFAULT);
 
+	/* Set the preset dictionary of the private xform */
+	if (priv_xform->dict_buf != NULL) {
+#ifdef ISAL_PROCESSED_DICT
+		ret = isal_deflate_reset_dict(qp->stream, priv_xform->dict);
+#else
+		ret = isal_deflate_set_dict(qp->stream, priv_xform->dict_buf,
+				priv_xform->dict_len);
+#endif
+		if (ret != COMP_OK) {
+			ISAL_PMD_LOG(ERR, "Dictionary could not be set");
+			op->status = RTE_COMP_OP_STATUS_ERROR;
+			return ret;
+		}
+	}
+
 	if (op->m_src->pkt_len < (op->src.length + op->src.offset)) {
 		ISAL_PMD_LOG(ERR, "Input mbuf(s) not big enough.");
 		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
@@ -542,6 +640,17 @@ process_isal_inflate(struct rte_comp_op *op, struct isal_comp_qp *qp,
 	/* Set Checksum flag */
 	qp->state->crc_flag = priv_xform->decompress.chksum;
 
+	/* Set the preset dictionary of the private xform */
+	if (priv_xform->dict_buf != NULL) {
+		ret = isal_inflate_set_dict(qp->state, priv_xform->dict_buf,
+				priv_xform->dict_len);
+		if (ret != ISAL_DECOMP_OK) {
+			ISAL_PMD_LOG(ERR, "Dictionary could not be set");
+			op->status = RTE_COMP_OP_STATUS_ERROR;
+			return ret;
+		}
+	}
+
 	if (op->m_src->pkt_len < (op->src.length + op->src.offset)) {
 		ISAL_PMD_LOG(ERR, "Input mbuf(s) not big enough.");
 		op->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
@@ -639,6 +748,12 @@ isal_comp_pmd_enqueue_burst(void *queue_pair, struct rte_comp_op **ops,
 	int16_t num_enq = RTE_MIN(qp->num_free_elements, nb_ops);
 
 	for (i = 0; i < num_enq; i++) {
+		/* Prefetch the next operation while processing this one */
+		if (i + 1 < num_enq) {
+			rte_prefetch0(ops[i + 1]->private_xform);
+			rte_prefetch0(rte_pktmbuf_mtod_offset(ops[i + 1]->m_src,
+					void *, ops[i + 1]->src.offset));
+		}
 		if (unlikely(ops[i]->op_type != RTE_COMP_OP_STATELESS)) {
 			ops[i]->status = RTE_COMP_OP_STATUS_INVALID_ARGS;
 			ISAL_PMD_LOG(ERR, "Stateful operation not Supported");
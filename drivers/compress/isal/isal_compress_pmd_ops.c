@@ -334,7 +334,7 @@ isal_comp_pmd_priv_xform_create(struct rte_compressdev *dev,
 		ISAL_PMD_LOG(ERR, "Failed to configure private xform parameters");
 
 		/* Return private xform to mempool */
-		rte_mempool_put(internals->priv_xform_mp, priv_xform);
+		rte_mempool_put(internals->priv_xform_mp, *priv_xform);
 		return ret;
 	}
 	return 0;
@@ -348,6 +348,7 @@ isal_comp_pmd_priv_xform_free(struct rte_compressdev *dev, void *priv_xform)
 
 	/* Zero out the whole structure */
 	if (priv_xform) {
+		isal_comp_free_priv_xform_dictionary(priv_xform);
 		memset(priv_xform, 0, sizeof(struct isal_priv_xform));
 		rte_mempool_put(internals->priv_xform_mp, priv_xform);
 	}
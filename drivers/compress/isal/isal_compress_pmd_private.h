@@ -44,6 +44,11 @@ struct __rte_cache_aligned isal_priv_xform {
 		struct rte_comp_decompress_xform decompress;
 	};
 	uint32_t level_buffer_size;
+	/* Preset dictionary, copied at the private xform creation */
+	uint8_t *dict_buf;
+	uint32_t dict_len;
+	/* Dictionary processed once for all the compression operations */
+	struct isal_dict *dict;
 };
 
 /** Set and validate NULL comp private xform parameters */
@@ -51,6 +56,10 @@ extern int
 isal_comp_set_priv_xform_parameters(struct isal_priv_xform *priv_xform,
 			const struct rte_comp_xform *xform);
 
+/** Free the dictionary of a private xform */
+extern void
+isal_comp_free_priv_xform_dictionary(struct isal_priv_xform *priv_xform);
+
 /** device specific operations function pointer structure */
 extern struct rte_compressdev_ops *isal_compress_pmd_ops;
 
@@ -2162,23 +2162,69 @@ set_job_null_op(IMB_JOB *job, struct rte_crypto_op *op)
 	return job;
 }
 
+/*
+ * Group the operations of a burst by session, keeping the order of the
+ * operations of each session, so that the jobs of each algorithm and key size
+ * are submitted back to back and fill the lanes of the multi-buffer manager,
+ * instead of waiting behind the jobs of other sessions in the job queue.
+ * Returns 0 if the burst uses a single session, otherwise the operations
+ * are reordered and pos[] gives their position in the original burst.
+ */
+static inline int
+aesni_mb_group_ops(struct rte_crypto_op **ops, uint16_t nb_ops, uint16_t pos[])
+{
+	struct rte_crypto_op *grouped[IMB_MAX_BURST_SIZE];
+	uint64_t done[RTE_ALIGN_CEIL(IMB_MAX_BURST_SIZE, 64) / 64] = {0};
+	void *sess;
+	uint16_t i, j, k;
+
+	for (i = 1; i < nb_ops; i++)
+		if (ops[i]->sym->session != ops[0]->sym->session)
+			break;
+	if (i >= nb_ops)
+		return 0;
+
+	k = 0;
+	for (i = 0; i < nb_ops; i++) {
+		if (done[i / 64] & RTE_BIT64(i % 64))
+			continue;
+		sess = ops[i]->sym->session;
+		for (j = i; j < nb_ops; j++) {
+			if (ops[j]->sym->session != sess)
+				continue;
+			done[j / 64] |= RTE_BIT64(j % 64);
+			pos[k] = j;
+			grouped[k++] = ops[j];
+		}
+	}
+	memcpy(ops, grouped, nb_ops * sizeof(ops[0]));
+
+	return 1;
+}
+
 uint16_t
 aesni_mb_dequeue_burst(void *queue_pair, struct rte_crypto_op **ops,
 		uint16_t nb_ops)
 {
 	struct ipsec_mb_qp *qp = queue_pair;
 	IMB_MGR *mb_mgr = qp->mb_mgr;
+	struct aesni_mb_qp_data *qp_data;
 	struct rte_crypto_op *op;
 	struct rte_crypto_op *deqd_ops[IMB_MAX_BURST_SIZE];
+	struct rte_crypto_op **burst_ops;
+	uint16_t pos[IMB_MAX_BURST_SIZE];
 	IMB_JOB *job;
 	int retval, processed_jobs = 0;
-	uint16_t i, nb_jobs;
+	uint16_t i, nb_jobs, nb_done;
 	IMB_JOB *jobs[IMB_MAX_BURST_SIZE] = {NULL};
+	int grouped;
 	pid_t pid;
 
 	if (unlikely(nb_ops == 0 || mb_mgr == NULL))
 		return 0;
 
+	qp_data = ipsec_mb_get_qp_private_data(qp);
+
 	uint8_t digest_idx = qp->digest_idx;
 	uint16_t burst_sz = (nb_ops > IMB_MAX_BURST_SIZE) ?
 		IMB_MAX_BURST_SIZE : nb_ops;
@@ -2199,6 +2245,7 @@ aesni_mb_dequeue_burst(void *queue_pair, struct rte_crypto_op **ops,
 			 * Flush n jobs until enough jobs available
 			 */
 			nb_jobs = IMB_FLUSH_BURST(mb_mgr, n, jobs);
+			qp_data->nb_inflight -= nb_jobs;
 			for (i = 0; i < nb_jobs; i++) {
 				job = jobs[i];
 
@@ -2229,6 +2276,15 @@ aesni_mb_dequeue_burst(void *queue_pair, struct rte_crypto_op **ops,
 		 */
 		nb_submit_ops = rte_ring_dequeue_burst(qp->ingress_queue,
 						(void **)deqd_ops, n, NULL);
+
+		/*
+		 * A burst mixing sessions is grouped by session only when
+		 * the manager is empty, to complete it in this call and
+		 * return it in the enqueue order.
+		 */
+		grouped = qp_data->nb_inflight == 0 &&
+			aesni_mb_group_ops(deqd_ops, nb_submit_ops, pos);
+
 		for (i = 0; i < nb_submit_ops; i++) {
 			job = jobs[i];
 			op = deqd_ops[i];
@@ -2258,6 +2314,7 @@ aesni_mb_dequeue_burst(void *queue_pair, struct rte_crypto_op **ops,
 		nb_jobs = IMB_SUBMIT_BURST_NOCHECK(mb_mgr,
 						   nb_submit_ops, jobs);
 #endif
+		qp_data->nb_inflight += nb_submit_ops - nb_jobs;
 		for (i = 0; i < nb_jobs; i++) {
 			job = jobs[i];
 
@@ -2273,8 +2330,50 @@ aesni_mb_dequeue_burst(void *queue_pair, struct rte_crypto_op **ops,
 
 		qp->digest_idx = digest_idx;
 
+		if (grouped) {
+			/* Complete the grouped burst */
+			nb_done = nb_jobs;
+			while (nb_done < nb_submit_ops) {
+				nb_jobs = IMB_FLUSH_BURST(mb_mgr,
+						nb_submit_ops - nb_done, jobs);
+				if (nb_jobs == 0)
+					break;
+				qp_data->nb_inflight -= nb_jobs;
+				nb_done += nb_jobs;
+
+				for (i = 0; i < nb_jobs; i++) {
+					job = jobs[i];
+
+					op = post_process_mb_job(qp, job);
+					if (op) {
+						ops[processed_jobs++] = op;
+						qp->stats.dequeued_count++;
+					} else {
+						qp->stats.dequeue_err_count++;
+						break;
+					}
+				}
+			}
+
+			/*
+			 * Return the operations in the enqueue order,
+			 * unless a job failed and the burst is incomplete.
+			 */
+			i = 0;
+			if (processed_jobs >= nb_submit_ops) {
+				burst_ops = &ops[processed_jobs - nb_submit_ops];
+				for (; i < nb_submit_ops; i++)
+					if (burst_ops[i] != deqd_ops[i])
+						break;
+			}
+			if (i == nb_submit_ops)
+				for (i = 0; i < nb_submit_ops; i++)
+					burst_ops[pos[i]] = deqd_ops[i];
+		}
+
 		if (processed_jobs < 1) {
 			nb_jobs = IMB_FLUSH_BURST(mb_mgr, n, jobs);
+			qp_data->nb_inflight -= nb_jobs;
 
 			for (i = 0; i < nb_jobs; i++) {
 				job = jobs[i];
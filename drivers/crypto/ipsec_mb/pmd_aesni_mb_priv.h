@@ -871,6 +871,10 @@ struct aesni_mb_qp_data {
 		struct gcm_context_data gcm_sgl_ctx;
 		struct chacha20_poly1305_context_data chacha_sgl_ctx;
 	};
+	uint32_t nb_inflight;
+	/* *< Number of jobs submitted to the multi-buffer manager
+	 * and not returned yet
+	 */
 };
 
 /* Maximum length for digest */
@@ -146,6 +146,10 @@ struct __rte_cache_aligned openssl_session {
 				/**< pointer to EVP algorithm function */
 				EVP_MD_CTX *ctx;
 				/**< pointer to EVP context structure */
+# if OPENSSL_VERSION_NUMBER >= 0x30000000L
+				EVP_MD *fetched_md;
+				/**< digest fetched from the provider at setup */
+# endif
 			} auth;
 
 			struct {
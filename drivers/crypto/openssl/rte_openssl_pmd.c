@@ -688,6 +688,17 @@ openssl_set_session_auth_parameters(struct openssl_session *sess,
 		if (get_auth_algo(xform->auth.algo,
 				&sess->auth.auth.evp_algo) != 0)
 			return -EINVAL;
+# if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+		/*
+		 * Fetch the digest once, initializing a context with the
+		 * legacy EVP_MD would fetch it from the provider store,
+		 * under its lock, for every operation.
+		 */
+		sess->auth.auth.fetched_md = EVP_MD_fetch(NULL,
+				EVP_MD_get0_name(sess->auth.auth.evp_algo), NULL);
+		if (sess->auth.auth.fetched_md == NULL)
+			return -EINVAL;
+# endif
 		sess->auth.auth.ctx = EVP_MD_CTX_create();
 		break;
 
@@ -932,6 +943,9 @@ openssl_reset_session(struct openssl_session *sess)
 	switch (sess->auth.mode) {
 	case OPENSSL_AUTH_AS_AUTH:
 		EVP_MD_CTX_destroy(sess->auth.auth.ctx);
+# if OPENSSL_VERSION_NUMBER >= 0x30000000L
+		EVP_MD_free(sess->auth.auth.fetched_md);
+# endif
 		break;
 	case OPENSSL_AUTH_AS_HMAC:
 		free_hmac_ctx(sess->auth.hmac.ctx);
@@ -1462,23 +1476,21 @@ process_openssl_auth(struct rte_mbuf *mbuf_src, uint8_t *dst, int offset,
 	}
 
 process_auth_final:
-	/* SHAKE algorithms are XOFs and require EVP_DigestFinalXOF */
-	if (algo == EVP_shake128() || algo == EVP_shake256()) {
 #if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+	/* SHAKE algorithms are XOFs and require EVP_DigestFinalXOF */
+	if (EVP_MD_get_flags(algo) & EVP_MD_FLAG_XOF) {
 		/* Set XOF output length before calling EVP_DigestFinalXOF */
 		if (EVP_MD_CTX_ctrl(ctx, EVP_MD_CTRL_XOF_LEN, digest_length, NULL) <= 0)
 			goto process_auth_err;
 		if (EVP_DigestFinalXOF(ctx, dst, digest_length) <= 0)
 			goto process_auth_err;
+		return 0;
+	}
 #else
-		RTE_SET_USED(digest_length);
-		OPENSSL_LOG(ERR, "SHAKE algorithms require OpenSSL 3.0+");
-		goto process_auth_err;
+	RTE_SET_USED(digest_length);
 #endif
-	} else {
-		if (EVP_DigestFinal_ex(ctx, dst, (unsigned int *)&dstlen) <= 0)
-			goto process_auth_err;
-	}
+	if (EVP_DigestFinal_ex(ctx, dst, (unsigned int *)&dstlen) <= 0)
+		goto process_auth_err;
 
 	return 0;
 
@@ -2036,7 +2048,12 @@ process_openssl_auth_op(struct openssl_qp *qp, struct rte_crypto_op *op,
 		ctx_a = get_local_auth_ctx(sess, qp);
 		status = process_openssl_auth(mbuf_src, dst,
 				op->sym->auth.data.offset, NULL, NULL, srclen,
-				ctx_a, sess->auth.auth.evp_algo, sess->auth.digest_length);
+# if OPENSSL_VERSION_NUMBER >= 0x30000000L
+				ctx_a, sess->auth.auth.fetched_md,
+# else
+				ctx_a, sess->auth.auth.evp_algo,
+# endif
+				sess->auth.digest_length);
 		break;
 	case OPENSSL_AUTH_AS_HMAC:
 		ctx_h = get_local_hmac_ctx(sess, qp);
@@ -4283,8 +4300,7 @@ process_openssl_mldsa_op(struct rte_crypto_op *cop,
 #endif
 
 static int
-process_asym_op(struct openssl_qp *qp, struct rte_crypto_op *op,
-		struct openssl_asym_session *sess)
+process_asym_op(struct rte_crypto_op *op, struct openssl_asym_session *sess)
 {
 	int retval = 0;
 
@@ -4369,13 +4385,6 @@ process_asym_op(struct openssl_qp *qp, struct rte_crypto_op *op,
 		op->status = RTE_CRYPTO_OP_STATUS_INVALID_ARGS;
 		break;
 	}
-	if (!retval) {
-		/* op processed so push to completion queue as processed */
-		retval = rte_ring_enqueue(qp->processed_ops, (void *)op);
-		if (retval)
-			/* return error if failed to put in completion queue */
-			retval = -1;
-	}
 
 	return retval;
 }
@@ -4406,7 +4415,6 @@ process_op(struct openssl_qp *qp, struct rte_crypto_op *op,
 		struct openssl_session *sess)
 {
 	struct rte_mbuf *msrc, *mdst;
-	int retval;
 
 	msrc = op->sym->m_src;
 	mdst = op->sym->m_dst ? op->sym->m_dst : op->sym->m_src;
@@ -4453,12 +4461,7 @@ process_op(struct openssl_qp *qp, struct rte_crypto_op *op,
 	if (op->status == RTE_CRYPTO_OP_STATUS_NOT_PROCESSED)
 		op->status = RTE_CRYPTO_OP_STATUS_SUCCESS;
 
-	if (op->status != RTE_CRYPTO_OP_STATUS_ERROR)
-		retval = rte_ring_enqueue(qp->processed_ops, (void *)op);
-	else
-		retval = -1;
-
-	return retval;
+	return op->status != RTE_CRYPTO_OP_STATUS_ERROR ? 0 : -1;
 }
 
 /*
@@ -4476,6 +4479,12 @@ openssl_pmd_enqueue_burst(void *queue_pair, struct rte_crypto_op **ops,
 	struct openssl_qp *qp = queue_pair;
 	int i, retval;
 
+	/*
+	 * The processed operations are pushed to the completion ring in one
+	 * burst, accept only as many as it can hold.
+	 */
+	nb_ops = RTE_MIN(nb_ops, rte_ring_free_count(qp->processed_ops));
+
 	for (i = 0; i < nb_ops; i++) {
 		sess = get_session(qp, ops[i]);
 		if (unlikely(sess == NULL))
@@ -4485,16 +4494,19 @@ openssl_pmd_enqueue_burst(void *queue_pair, struct rte_crypto_op **ops,
 			retval = process_op(qp, ops[i],
 					(struct openssl_session *) sess);
 		else
-			retval = process_asym_op(qp, ops[i],
+			retval = process_asym_op(ops[i],
 					(struct openssl_asym_session *) sess);
 		if (unlikely(retval < 0))
 			goto enqueue_err;
 	}
 
+	rte_ring_enqueue_burst(qp->processed_ops, (void **)ops, i, NULL);
 	qp->stats.enqueued_count += i;
 	return i;
 
 enqueue_err:
+	rte_ring_enqueue_burst(qp->processed_ops, (void **)ops, i, NULL);
+	qp->stats.enqueued_count += i;
 	qp->stats.enqueue_err_count++;
 	return i;
 }
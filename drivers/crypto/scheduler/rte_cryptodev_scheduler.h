@@ -13,8 +13,9 @@
  * The RTE Cryptodev Scheduler Device allows the aggregation of multiple worker
  * Cryptodevs into a single logical crypto device, and the scheduling the
  * crypto operations to the workers based on the mode of the specified mode of
- * operation specified and supported. This implementation supports 3 modes of
- * operation: round robin, packet-size based, and fail-over.
+ * operation specified and supported. This implementation supports 5 modes of
+ * operation: round robin, packet-size based, fail-over, multi-core and
+ * load balance.
  */
 
 #include <stdint.h>
@@ -40,6 +41,8 @@ extern "C" {
 #define SCHEDULER_MODE_NAME_FAIL_OVER		fail-over
 /** multi-core scheduling mode string */
 #define SCHEDULER_MODE_NAME_MULTI_CORE		multi-core
+/** Load balance scheduling mode string */
+#define SCHEDULER_MODE_NAME_LOAD_BALANCE	load-balance
 
 /**
  * Crypto scheduler PMD operation modes
@@ -56,6 +59,8 @@ enum rte_cryptodev_scheduler_mode {
 	CDEV_SCHED_MODE_FAILOVER,
 	/** multi-core mode */
 	CDEV_SCHED_MODE_MULTICORE,
+	/** Load balance mode */
+	CDEV_SCHED_MODE_LOAD_BALANCE,
 
 	CDEV_SCHED_MODE_COUNT /**< number of modes */
 };
@@ -276,6 +281,8 @@ extern struct rte_cryptodev_scheduler *crypto_scheduler_pkt_size_based_distr;
 extern struct rte_cryptodev_scheduler *crypto_scheduler_failover;
 /** multi-core mode scheduler */
 extern struct rte_cryptodev_scheduler *crypto_scheduler_multicore;
+/** Load balance mode scheduler */
+extern struct rte_cryptodev_scheduler *crypto_scheduler_load_balance;
 
 #ifdef __cplusplus
 }
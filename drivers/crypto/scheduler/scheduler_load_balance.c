@@ -0,0 +1,334 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <cryptodev_pmd.h>
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+
+#include "rte_cryptodev_scheduler_operations.h"
+#include "scheduler_pmd_private.h"
+
+/* Number of enqueued bursts tracked per worker for the latency measure */
+#define LB_NB_BURSTS		64
+#define LB_BURSTS_MASK		(LB_NB_BURSTS - 1)
+/* Weight of a new sample in the average cycles per operation: 1/8 */
+#define LB_EWMA_SHIFT		3
+/* Fixed point precision of the average cycles per operation */
+#define LB_CYCLES_SHIFT		4
+
+struct lb_burst {
+	uint64_t tsc;		/* enqueue time */
+	uint32_t nb_ops;	/* operations of the burst not dequeued yet */
+	uint32_t depth;		/* inflight operations after the enqueue */
+};
+
+struct lb_scheduler_worker {
+	struct scheduler_worker worker;
+	/* Average completion cycles per inflight operation */
+	uint64_t op_cycles;
+	struct lb_burst bursts[LB_NB_BURSTS];
+	uint32_t burst_head;
+	uint32_t nb_bursts;
+};
+
+struct lb_scheduler_qp_ctx {
+	struct lb_scheduler_worker workers[RTE_CRYPTODEV_SCHEDULER_MAX_NB_WORKERS];
+	uint32_t nb_workers;
+
+	uint32_t last_deq_worker_idx;
+};
+
+static __rte_always_inline void
+lb_burst_enqueued(struct lb_scheduler_worker *lb_worker, uint16_t nb_ops,
+		uint64_t tsc)
+{
+	struct lb_burst *burst;
+
+	/* With too many bursts in flight, merge with the last one */
+	if (lb_worker->nb_bursts == LB_NB_BURSTS) {
+		burst = &lb_worker->bursts[(lb_worker->burst_head +
+				LB_NB_BURSTS - 1) & LB_BURSTS_MASK];
+		burst->nb_ops += nb_ops;
+		return;
+	}
+
+	burst = &lb_worker->bursts[(lb_worker->burst_head +
+			lb_worker->nb_bursts) & LB_BURSTS_MASK];
+	burst->tsc = tsc;
+	burst->nb_ops = nb_ops;
+	burst->depth = lb_worker->worker.nb_inflight_cops;
+	lb_worker->nb_bursts++;
+}
+
+/*
+ * Account the dequeued operations to the oldest bursts. Each completed burst
+ * gives a sample of the cycles per operation: its latency divided by the
+ * number of operations it was queued behind, including its own.
+ */
+static __rte_always_inline void
+lb_burst_dequeued(struct lb_scheduler_worker *lb_worker, uint16_t nb_ops,
+		uint64_t tsc)
+{
+	struct lb_burst *burst;
+	int64_t sample;
+
+	while (nb_ops != 0 && lb_worker->nb_bursts != 0) {
+		burst = &lb_worker->bursts[lb_worker->burst_head];
+		if (nb_ops < burst->nb_ops) {
+			burst->nb_ops -= nb_ops;
+			return;
+		}
+		nb_ops -= burst->nb_ops;
+
+		sample = ((tsc - burst->tsc) << LB_CYCLES_SHIFT) / burst->depth;
+		lb_worker->op_cycles += (sample -
+				(int64_t)lb_worker->op_cycles) >> LB_EWMA_SHIFT;
+
+		lb_worker->burst_head = (lb_worker->burst_head + 1) &
+				LB_BURSTS_MASK;
+		lb_worker->nb_bursts--;
+	}
+}
+
+/*
+ * Select the worker expected to complete the operations first, i.e. with
+ * the lowest inflight operations weighted by its cycles per operation.
+ * Workers which have not completed any burst yet are preferred, to measure
+ * them. Returns -1 if all workers are excluded.
+ */
+static __rte_always_inline int
+lb_select_worker(struct lb_scheduler_qp_ctx *lb_qp_ctx, uint16_t nb_ops,
+		uint32_t excluded)
+{
+	struct lb_scheduler_worker *lb_worker;
+	uint64_t cost, min_cost = UINT64_MAX;
+	int worker_idx = -1;
+	uint32_t i;
+
+	for (i = 0; i < lb_qp_ctx->nb_workers; i++) {
+		if (excluded & RTE_BIT32(i))
+			continue;
+		lb_worker = &lb_qp_ctx->workers[i];
+		cost = (uint64_t)(lb_worker->worker.nb_inflight_cops + nb_ops) *
+				(lb_worker->op_cycles + 1);
+		if (cost < min_cost) {
+			min_cost = cost;
+			worker_idx = i;
+		}
+	}
+
+	return worker_idx;
+}
+
+static uint16_t
+schedule_enqueue(void *qp, struct rte_crypto_op **ops, uint16_t nb_ops)
+{
+	struct lb_scheduler_qp_ctx *lb_qp_ctx =
+			((struct scheduler_qp_ctx *)qp)->private_qp_ctx;
+	struct lb_scheduler_worker *lb_worker;
+	struct scheduler_worker *worker;
+	uint16_t enqueued_ops = 0, processed_ops;
+	uint32_t excluded = 0;
+	uint64_t tsc;
+	int worker_idx;
+
+	if (unlikely(nb_ops == 0))
+		return 0;
+
+	tsc = rte_rdtsc();
+
+	/* Spill the operations a full worker does not accept to the next one */
+	while (enqueued_ops < nb_ops) {
+		worker_idx = lb_select_worker(lb_qp_ctx,
+				nb_ops - enqueued_ops, excluded);
+		if (worker_idx < 0)
+			break;
+		excluded |= RTE_BIT32(worker_idx);
+		lb_worker = &lb_qp_ctx->workers[worker_idx];
+		worker = &lb_worker->worker;
+
+		scheduler_set_worker_sessions(&ops[enqueued_ops],
+				nb_ops - enqueued_ops, worker_idx);
+		processed_ops = rte_cryptodev_enqueue_burst(worker->dev_id,
+				worker->qp_id, &ops[enqueued_ops],
+				nb_ops - enqueued_ops);
+		enqueued_ops += processed_ops;
+		if (enqueued_ops < nb_ops)
+			scheduler_retrieve_sessions(&ops[enqueued_ops],
+				nb_ops - enqueued_ops);
+
+		if (processed_ops == 0)
+			continue;
+		worker->nb_inflight_cops += processed_ops;
+		lb_burst_enqueued(lb_worker, processed_ops, tsc);
+	}
+
+	return enqueued_ops;
+}
+
+static uint16_t
+schedule_enqueue_ordering(void *qp, struct rte_crypto_op **ops,
+		uint16_t nb_ops)
+{
+	struct rte_ring *order_ring =
+			((struct scheduler_qp_ctx *)qp)->order_ring;
+	uint16_t nb_ops_to_enq = get_max_enqueue_order_count(order_ring,
+			nb_ops);
+	uint16_t nb_ops_enqd = schedule_enqueue(qp, ops,
+			nb_ops_to_enq);
+
+	scheduler_order_insert(order_ring, ops, nb_ops_enqd);
+
+	return nb_ops_enqd;
+}
+
+static uint16_t
+schedule_dequeue(void *qp, struct rte_crypto_op **ops, uint16_t nb_ops)
+{
+	struct lb_scheduler_qp_ctx *lb_qp_ctx =
+			((struct scheduler_qp_ctx *)qp)->private_qp_ctx;
+	struct lb_scheduler_worker *lb_worker;
+	struct scheduler_worker *worker;
+	uint32_t worker_idx = lb_qp_ctx->last_deq_worker_idx;
+	uint16_t nb_deq_ops = 0, processed_ops;
+	uint64_t tsc = rte_rdtsc();
+	uint32_t i;
+
+	for (i = 0; i < lb_qp_ctx->nb_workers && nb_deq_ops < nb_ops; i++) {
+		lb_worker = &lb_qp_ctx->workers[worker_idx];
+		worker = &lb_worker->worker;
+
+		if (++worker_idx == lb_qp_ctx->nb_workers)
+			worker_idx = 0;
+		if (worker->nb_inflight_cops == 0)
+			continue;
+
+		processed_ops = rte_cryptodev_dequeue_burst(worker->dev_id,
+				worker->qp_id, &ops[nb_deq_ops],
+				nb_ops - nb_deq_ops);
+		worker->nb_inflight_cops -= processed_ops;
+		lb_burst_dequeued(lb_worker, processed_ops, tsc);
+		nb_deq_ops += processed_ops;
+	}
+
+	lb_qp_ctx->last_deq_worker_idx = worker_idx;
+
+	scheduler_retrieve_sessions(ops, nb_deq_ops);
+
+	return nb_deq_ops;
+}
+
+static uint16_t
+schedule_dequeue_ordering(void *qp, struct rte_crypto_op **ops,
+		uint16_t nb_ops)
+{
+	struct rte_ring *order_ring =
+			((struct scheduler_qp_ctx *)qp)->order_ring;
+
+	schedule_dequeue(qp, ops, nb_ops);
+
+	return scheduler_order_drain(order_ring, ops, nb_ops);
+}
+
+static int
+worker_attach(__rte_unused struct rte_cryptodev *dev,
+		__rte_unused uint8_t worker_id)
+{
+	return 0;
+}
+
+static int
+worker_detach(__rte_unused struct rte_cryptodev *dev,
+		__rte_unused uint8_t worker_id)
+{
+	return 0;
+}
+
+static int
+scheduler_start(struct rte_cryptodev *dev)
+{
+	struct scheduler_ctx *sched_ctx = dev->data->dev_private;
+	uint16_t i;
+
+	if (sched_ctx->reordering_enabled) {
+		dev->enqueue_burst = &schedule_enqueue_ordering;
+		dev->dequeue_burst = &schedule_dequeue_ordering;
+	} else {
+		dev->enqueue_burst = &schedule_enqueue;
+		dev->dequeue_burst = &schedule_dequeue;
+	}
+
+	for (i = 0; i < dev->data->nb_queue_pairs; i++) {
+		struct scheduler_qp_ctx *qp_ctx = dev->data->queue_pairs[i];
+		struct lb_scheduler_qp_ctx *lb_qp_ctx =
+				qp_ctx->private_qp_ctx;
+		uint32_t j;
+
+		memset(lb_qp_ctx->workers, 0, sizeof(lb_qp_ctx->workers));
+		for (j = 0; j < sched_ctx->nb_workers; j++) {
+			lb_qp_ctx->workers[j].worker.dev_id =
+					sched_ctx->workers[j].dev_id;
+			lb_qp_ctx->workers[j].worker.qp_id = i;
+		}
+
+		lb_qp_ctx->nb_workers = sched_ctx->nb_workers;
+
+		lb_qp_ctx->last_deq_worker_idx = 0;
+	}
+
+	return 0;
+}
+
+static int
+scheduler_stop(__rte_unused struct rte_cryptodev *dev)
+{
+	return 0;
+}
+
+static int
+scheduler_config_qp(struct rte_cryptodev *dev, uint16_t qp_id)
+{
+	struct scheduler_qp_ctx *qp_ctx = dev->data->queue_pairs[qp_id];
+	struct lb_scheduler_qp_ctx *lb_qp_ctx;
+
+	lb_qp_ctx = rte_zmalloc_socket(NULL, sizeof(*lb_qp_ctx), 0,
+			rte_socket_id());
+	if (!lb_qp_ctx) {
+		CR_SCHED_LOG(ERR, "failed allocate memory for private queue pair");
+		return -ENOMEM;
+	}
+
+	qp_ctx->private_qp_ctx = (void *)lb_qp_ctx;
+
+	return 0;
+}
+
+static int
+scheduler_create_private_ctx(__rte_unused struct rte_cryptodev *dev)
+{
+	return 0;
+}
+
+static struct rte_cryptodev_scheduler_ops scheduler_lb_ops = {
+	worker_attach,
+	worker_detach,
+	scheduler_start,
+	scheduler_stop,
+	scheduler_config_qp,
+	scheduler_create_private_ctx,
+	NULL,	/* option_set */
+	NULL	/* option_get */
+};
+
+static struct rte_cryptodev_scheduler lb_scheduler = {
+		.name = "load-balance-scheduler",
+		.description = "scheduler which enqueues each burst to the "
+				"worker with the lowest expected latency, from "
+				"its inflight operations and measured completion "
+				"time, spilling to the next worker when full",
+		.mode = CDEV_SCHED_MODE_LOAD_BALANCE,
+		.ops = &scheduler_lb_ops
+};
+
+struct rte_cryptodev_scheduler *crypto_scheduler_load_balance = &lb_scheduler;
@@ -68,7 +68,9 @@ const struct scheduler_parse_map scheduler_mode_map[] = {
 	{RTE_STR(SCHEDULER_MODE_NAME_FAIL_OVER),
 			CDEV_SCHED_MODE_FAILOVER},
 	{RTE_STR(SCHEDULER_MODE_NAME_MULTI_CORE),
-			CDEV_SCHED_MODE_MULTICORE}
+			CDEV_SCHED_MODE_MULTICORE},
+	{RTE_STR(SCHEDULER_MODE_NAME_LOAD_BALANCE),
+			CDEV_SCHED_MODE_LOAD_BALANCE}
 };
 
 const struct scheduler_parse_map scheduler_ordering_map[] = {
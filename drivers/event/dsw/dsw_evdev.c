@@ -2,9 +2,12 @@
  * Copyright(c) 2018 Ericsson AB
  */
 
+#include <limits.h>
 #include <stdbool.h>
+#include <stdio.h>
 
 #include <rte_cycles.h>
+#include <rte_lcore.h>
 #include <eventdev_pmd.h>
 #include <eventdev_pmd_vdev.h>
 #include <rte_random.h>
@@ -36,7 +39,8 @@ dsw_port_setup(struct rte_eventdev *dev, uint8_t port_id,
 		.dequeue_depth = conf->dequeue_depth,
 		.enqueue_depth = conf->enqueue_depth,
 		.new_event_threshold = conf->new_event_threshold,
-		.implicit_release = implicit_release
+		.implicit_release = implicit_release,
+		.lcore_id = LCORE_ID_ANY
 	};
 
 	snprintf(ring_name, sizeof(ring_name), "dsw%d_p%u", dev->data->dev_id,
@@ -232,6 +236,78 @@ dsw_info_get(struct rte_eventdev *dev __rte_unused,
 	};
 }
 
+#ifdef RTE_EXEC_ENV_LINUX
+static int
+dsw_read_cpu_cache_attr(unsigned int cpu, unsigned int index,
+			const char *attr)
+{
+	char path[PATH_MAX];
+	FILE *f;
+	int value;
+
+	snprintf(path, sizeof(path),
+		 "/sys/devices/system/cpu/cpu%u/cache/index%u/%s",
+		 cpu, index, attr);
+
+	f = fopen(path, "r");
+	if (f == NULL)
+		return -1;
+
+	if (fscanf(f, "%d", &value) != 1)
+		value = -1;
+
+	fclose(f);
+
+	return value;
+}
+
+static int32_t
+dsw_cpu_l3(unsigned int cpu)
+{
+	unsigned int index;
+
+	for (index = 0;; index++) {
+		int level = dsw_read_cpu_cache_attr(cpu, index, "level");
+
+		if (level < 0)
+			return -1;
+
+		if (level == 3)
+			return dsw_read_cpu_cache_attr(cpu, index, "id");
+	}
+}
+#endif
+
+/* The L3 cache domain of an lcore is the one of the first CPU of its
+ * affinity set.
+ */
+static int32_t
+dsw_lcore_l3(unsigned int lcore_id)
+{
+#ifdef RTE_EXEC_ENV_LINUX
+	rte_cpuset_t cpuset = rte_lcore_cpuset(lcore_id);
+	unsigned int cpu;
+
+	for (cpu = 0; cpu < CPU_SETSIZE; cpu++)
+		if (CPU_ISSET(cpu, &cpuset))
+			return dsw_cpu_l3(cpu);
+#else
+	RTE_SET_USED(lcore_id);
+#endif
+
+	return -1;
+}
+
+static void
+dsw_init_lcore_l3(struct dsw_evdev *dsw)
+{
+	unsigned int lcore_id;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+		dsw->lcore_l3[lcore_id] = rte_lcore_is_enabled(lcore_id) ?
+			dsw_lcore_l3(lcore_id) : -1;
+}
+
 static int
 dsw_configure(const struct rte_eventdev *dev)
 {
@@ -249,6 +325,8 @@ dsw_configure(const struct rte_eventdev *dev)
 
 	dsw->max_inflight = RTE_MAX(conf->nb_events_limit, min_max_in_flight);
 
+	dsw_init_lcore_l3(dsw);
+
 	return 0;
 }
 
@@ -102,6 +102,19 @@
 
 #define DSW_MAX_FLOWS_PER_MIGRATION (8)
 
+/* Migrating a flow to a port polled by an lcore on another L3 cache
+ * domain (e.g., another CCX on AMD CPUs), or worse on another NUMA
+ * node, means its state has to be brought in from a remote cache or
+ * remote memory, causing a processing spike on the target port just
+ * as it is being assigned more load. Such migrations are only done
+ * if the load imbalance exceeds the rebalance threshold by this
+ * cost, and are only preferred if the resulting target load is
+ * lower by more than this cost. Setting a cost to 0 makes the
+ * migrations ignore that aspect of the topology.
+ */
+#define DSW_CROSS_L3_MIGRATION_COST (DSW_LOAD_FROM_PERCENT(5))
+#define DSW_CROSS_NUMA_MIGRATION_COST (DSW_LOAD_FROM_PERCENT(15))
+
 /* Only one outstanding migration per port is allowed */
 #define DSW_MAX_PAUSED_FLOWS (DSW_MAX_PORTS*DSW_MAX_FLOWS_PER_MIGRATION)
 
@@ -232,6 +245,10 @@ struct __rte_cache_aligned dsw_port {
 
 	/* Estimate of current port load. */
 	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int16_t) load;
+	/* The lcore which most recently updated the load estimate,
+	 * or LCORE_ID_ANY.
+	 */
+	RTE_ATOMIC(uint32_t) lcore_id;
 	/* Estimate of flows currently migrating to this port. */
 	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int32_t) immigration_load;
 };
@@ -256,6 +273,9 @@ struct dsw_evdev {
 	uint8_t num_queues;
 	int32_t max_inflight;
 
+	/* L3 cache domain of each lcore, or -1 if unknown. */
+	int32_t lcore_l3[RTE_MAX_LCORE];
+
 	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(int32_t) credits_on_loan;
 };
 
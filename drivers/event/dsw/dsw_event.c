@@ -172,6 +172,9 @@ dsw_port_load_update(struct dsw_port *port, uint64_t now)
 	rte_atomic_store_explicit(&port->load, new_load,
 				  rte_memory_order_relaxed);
 
+	rte_atomic_store_explicit(&port->lcore_id, rte_lcore_id(),
+				  rte_memory_order_relaxed);
+
 	/* The load of the recently immigrated flows should hopefully
 	 * be reflected the load estimate by now.
 	 */
@@ -422,9 +425,41 @@ dsw_flow_load(uint16_t num_events, int16_t port_load)
 		DSW_MAX_EVENTS_RECORDED;
 }
 
+static int16_t
+dsw_migration_cost(struct dsw_evdev *dsw, unsigned int source_lcore_id,
+		   uint8_t target_port_id)
+{
+	struct dsw_port *target_port = &dsw->ports[target_port_id];
+	unsigned int target_lcore_id;
+	int32_t source_l3;
+	int32_t target_l3;
+
+	target_lcore_id =
+		rte_atomic_load_explicit(&target_port->lcore_id,
+					 rte_memory_order_relaxed);
+
+	/* Non-EAL threads, or a port not yet polled */
+	if (source_lcore_id >= RTE_MAX_LCORE ||
+	    target_lcore_id >= RTE_MAX_LCORE ||
+	    source_lcore_id == target_lcore_id)
+		return 0;
+
+	if (rte_lcore_to_socket_id(source_lcore_id) !=
+	    rte_lcore_to_socket_id(target_lcore_id))
+		return DSW_CROSS_NUMA_MIGRATION_COST;
+
+	source_l3 = dsw->lcore_l3[source_lcore_id];
+	target_l3 = dsw->lcore_l3[target_lcore_id];
+
+	if (source_l3 >= 0 && target_l3 >= 0 && source_l3 != target_l3)
+		return DSW_CROSS_L3_MIGRATION_COST;
+
+	return 0;
+}
+
 static int16_t
 dsw_evaluate_migration(int16_t source_load, int16_t target_load,
-		       int16_t flow_load)
+		       int16_t flow_load, int16_t migration_cost)
 {
 	int32_t res_target_load;
 	int32_t imbalance;
@@ -434,7 +469,8 @@ dsw_evaluate_migration(int16_t source_load, int16_t target_load,
 
 	imbalance = source_load - target_load;
 
-	if (imbalance < DSW_REBALANCE_THRESHOLD)
+	/* A remote target must be worth the cache misses. */
+	if (imbalance < DSW_REBALANCE_THRESHOLD + migration_cost)
 		return -1;
 
 	res_target_load = target_load + flow_load;
@@ -448,9 +484,10 @@ dsw_evaluate_migration(int16_t source_load, int16_t target_load,
 
 	/* The more idle the target will be, the better. This will
 	 * make migration prefer moving smaller flows, and flows to
-	 * lightly loaded ports.
+	 * lightly loaded ports. Nearby ports are preferred to remote
+	 * ports with a similar load.
 	 */
-	return DSW_MAX_LOAD - res_target_load;
+	return DSW_MAX_LOAD - res_target_load - migration_cost;
 }
 
 static bool
@@ -466,7 +503,9 @@ dsw_select_emigration_target(struct dsw_evdev *dsw,
 			     struct dsw_port *source_port,
 			     struct dsw_queue_flow_burst *bursts,
 			     uint16_t num_bursts,
-			     int16_t *port_loads, uint16_t num_ports,
+			     int16_t *port_loads,
+			     const int16_t *migration_costs,
+			     uint16_t num_ports,
 			     uint8_t *target_port_ids,
 			     struct dsw_queue_flow *target_qfs,
 			     uint8_t *targets_len)
@@ -504,7 +543,8 @@ dsw_select_emigration_target(struct dsw_evdev *dsw,
 
 			weight = dsw_evaluate_migration(source_port_load,
 							port_loads[port_id],
-							flow_load);
+							flow_load,
+							migration_costs[port_id]);
 
 			if (weight > candidate_weight) {
 				candidate_qf = qf;
@@ -549,14 +589,21 @@ dsw_select_emigration_targets(struct dsw_evdev *dsw,
 	struct dsw_queue_flow *target_qfs = source_port->emigration_target_qfs;
 	uint8_t *target_port_ids = source_port->emigration_target_port_ids;
 	uint8_t *targets_len = &source_port->emigration_targets_len;
+	int16_t migration_costs[DSW_MAX_PORTS];
+	unsigned int lcore_id = rte_lcore_id();
 	uint16_t i;
 
+	for (i = 0; i < dsw->num_ports; i++)
+		migration_costs[i] = dsw_migration_cost(dsw, lcore_id, i);
+
 	for (i = 0; i < DSW_MAX_FLOWS_PER_MIGRATION; i++) {
 		bool found;
 
 		found = dsw_select_emigration_target(dsw, source_port,
 						     bursts, num_bursts,
-						     port_loads, dsw->num_ports,
+						     port_loads,
+						     migration_costs,
+						     dsw->num_ports,
 						     target_port_ids,
 						     target_qfs,
 						     targets_len);
@@ -24,6 +24,7 @@
 #define MIN_BURST_SIZE_ARG "min_burst"
 #define DEQ_BURST_SIZE_ARG "deq_burst"
 #define REFIL_ONCE_ARG "refill_once"
+#define SCHED_SHARDS_ARG "sched_shards"
 
 static void
 sw_info_get(struct rte_eventdev *dev, struct rte_event_dev_info *info);
@@ -61,6 +62,12 @@ sw_port_link(struct rte_eventdev *dev, void *port, const uint8_t queues[],
 		if (j < q->cq_num_mapped_cqs)
 			continue;
 
+		/* check port and qid are scheduled by the same shard */
+		if (sw->started && sw->nb_shards > 1 && q->shard != p->shard) {
+			rte_errno = EINVAL;
+			break;
+		}
+
 		if (q->type == SW_SCHED_TYPE_DIRECT) {
 			/* check directed qids only map to one port */
 			if (p->num_qids_mapped > 0) {
@@ -359,7 +366,7 @@ sw_init_qid_iqs(struct sw_evdev *sw)
 			continue;
 
 		for (j = 0; j < SW_IQS_MAX; j++)
-			iq_init(sw, &qid->iq[j]);
+			iq_init(&sw->shards[qid->shard], &qid->iq[j]);
 	}
 }
 
@@ -389,6 +396,12 @@ sw_ports_empty(struct sw_evdev *sw)
 			return 0;
 	}
 
+	for (i = 0; i < sw->nb_shards; i++) {
+		if (sw->shards[i].xfer_ring != NULL &&
+		    rte_event_ring_count(sw->shards[i].xfer_ring))
+			return 0;
+	}
+
 	return 1;
 }
 
@@ -419,9 +432,9 @@ sw_drain_ports(struct rte_eventdev *dev)
 }
 
 static void
-sw_drain_queue(struct rte_eventdev *dev, struct sw_iq *iq)
+sw_drain_queue(struct rte_eventdev *dev, struct sw_shard *sh,
+		struct sw_iq *iq)
 {
-	struct sw_evdev *sw = sw_pmd_priv(dev);
 	eventdev_stop_flush_t flush;
 	uint8_t dev_id;
 	void *arg;
@@ -433,7 +446,7 @@ sw_drain_queue(struct rte_eventdev *dev, struct sw_iq *iq)
 	while (iq_count(iq) > 0) {
 		struct rte_event ev;
 
-		iq_dequeue_burst(sw, iq, &ev, 1);
+		iq_dequeue_burst(sh, iq, &ev, 1);
 
 		if (flush)
 			flush(dev_id, ev, arg);
@@ -447,8 +460,11 @@ sw_drain_queues(struct rte_eventdev *dev)
 	unsigned int i, j;
 
 	for (i = 0; i < sw->qid_count; i++) {
+		struct sw_qid *qid = &sw->qids[i];
+
 		for (j = 0; j < SW_IQS_MAX; j++)
-			sw_drain_queue(dev, &sw->qids[i].iq[j]);
+			sw_drain_queue(dev, &sw->shards[qid->shard],
+					&qid->iq[j]);
 	}
 }
 
@@ -465,7 +481,8 @@ sw_clean_qid_iqs(struct rte_eventdev *dev)
 		for (j = 0; j < SW_IQS_MAX; j++) {
 			if (!qid->iq[j].head)
 				continue;
-			iq_free_chunk_list(sw, qid->iq[j].head);
+			iq_free_chunk_list(&sw->shards[qid->shard],
+					qid->iq[j].head);
 			qid->iq[j].head = NULL;
 		}
 	}
@@ -507,7 +524,7 @@ sw_dev_configure(const struct rte_eventdev *dev)
 	struct sw_evdev *sw = sw_pmd_priv(dev);
 	const struct rte_eventdev_data *data = dev->data;
 	const struct rte_event_dev_config *conf = &data->dev_conf;
-	int num_chunks, i;
+	int num_chunks, i, s;
 
 	sw->qid_count = conf->nb_event_queues;
 	sw->port_count = conf->nb_event_ports;
@@ -524,17 +541,22 @@ sw_dev_configure(const struct rte_eventdev *dev)
 	 */
 	rte_free(sw->chunks);
 
+	/* Each shard may hold all the inflight events in its IQs */
 	sw->chunks = rte_malloc_socket(NULL,
 				       sizeof(struct sw_queue_chunk) *
-				       num_chunks,
+				       num_chunks * sw->nb_shards,
 				       0,
 				       sw->data->socket_id);
 	if (!sw->chunks)
 		return -ENOMEM;
 
-	sw->chunk_list_head = NULL;
-	for (i = 0; i < num_chunks; i++)
-		iq_free_chunk(sw, &sw->chunks[i]);
+	for (s = 0; s < sw->nb_shards; s++) {
+		struct sw_shard *sh = &sw->shards[s];
+
+		sh->chunk_list_head = NULL;
+		for (i = 0; i < num_chunks; i++)
+			iq_free_chunk(sh, &sw->chunks[s * num_chunks + i]);
+	}
 
 	if (conf->event_dev_cfg & RTE_EVENT_DEV_CFG_PER_DEQUEUE_TIMEOUT)
 		return -ENOTSUP;
@@ -623,16 +645,31 @@ sw_dump(struct rte_eventdev *dev, FILE *f)
 	static const char * const q_type_strings[] = {
 			"Ordered", "Atomic", "Parallel", "Directed"
 	};
+	struct sw_point_stats stats = {0};
+	uint64_t sched_called = 0, sched_cq_qid_called = 0;
+	uint64_t sched_no_iq_enqueues = 0, sched_no_cq_enqueues = 0;
 	uint32_t i;
-	fprintf(f, "EventDev %s: ports %d, qids %d\n",
-		dev->data->name, sw->port_count, sw->qid_count);
+	fprintf(f, "EventDev %s: ports %d, qids %d, shards %d\n",
+		dev->data->name, sw->port_count, sw->qid_count, sw->nb_shards);
+
+	for (i = 0; i < sw->nb_shards; i++) {
+		const struct sw_shard *sh = &sw->shards[i];
+
+		stats.rx_pkts += sh->stats.rx_pkts;
+		stats.rx_dropped += sh->stats.rx_dropped;
+		stats.tx_pkts += sh->stats.tx_pkts;
+		sched_called += sh->sched_called;
+		sched_cq_qid_called += sh->sched_cq_qid_called;
+		sched_no_iq_enqueues += sh->sched_no_iq_enqueues;
+		sched_no_cq_enqueues += sh->sched_no_cq_enqueues;
+	}
 
 	fprintf(f, "\trx   %"PRIu64"\n\tdrop %"PRIu64"\n\ttx   %"PRIu64"\n",
-		sw->stats.rx_pkts, sw->stats.rx_dropped, sw->stats.tx_pkts);
-	fprintf(f, "\tsched calls: %"PRIu64"\n", sw->sched_called);
-	fprintf(f, "\tsched cq/qid call: %"PRIu64"\n", sw->sched_cq_qid_called);
-	fprintf(f, "\tsched no IQ enq: %"PRIu64"\n", sw->sched_no_iq_enqueues);
-	fprintf(f, "\tsched no CQ enq: %"PRIu64"\n", sw->sched_no_cq_enqueues);
+		stats.rx_pkts, stats.rx_dropped, stats.tx_pkts);
+	fprintf(f, "\tsched calls: %"PRIu64"\n", sched_called);
+	fprintf(f, "\tsched cq/qid call: %"PRIu64"\n", sched_cq_qid_called);
+	fprintf(f, "\tsched no IQ enq: %"PRIu64"\n", sched_no_iq_enqueues);
+	fprintf(f, "\tsched no CQ enq: %"PRIu64"\n", sched_no_cq_enqueues);
 	uint32_t inflights = rte_atomic32_read(&sw->inflights);
 	uint32_t credits = sw->nb_events_limit - inflights;
 	fprintf(f, "\tinflight %d, credits: %d\n", inflights, credits);
@@ -648,8 +685,8 @@ sw_dump(struct rte_eventdev *dev, FILE *f)
 				COL_RED, i, COL_RESET);
 			continue;
 		}
-		fprintf(f, "  Port %d %s\n", i,
-			p->is_directed ? " (SingleCons)" : "");
+		fprintf(f, "  Port %d %s(shard %d)\n", i,
+			p->is_directed ? " (SingleCons) " : "", p->shard);
 		fprintf(f, "\trx   %"PRIu64"\tdrop %"PRIu64"\ttx   %"PRIu64
 			"\t%sinflight %d%s\n", sw->ports[i].stats.rx_pkts,
 			sw->ports[i].stats.rx_dropped,
@@ -712,7 +749,8 @@ sw_dump(struct rte_eventdev *dev, FILE *f)
 		}
 		int affinities_per_port[SW_PORTS_MAX] = {0};
 
-		fprintf(f, "  Queue %d (%s)\n", i, q_type_strings[qid->type]);
+		fprintf(f, "  Queue %d (%s) (shard %d)\n", i,
+			q_type_strings[qid->type], qid->shard);
 		fprintf(f, "\trx   %"PRIu64"\tdrop %"PRIu64"\ttx   %"PRIu64"\n",
 			qid->stats.rx_pkts, qid->stats.rx_dropped,
 			qid->stats.tx_pkts);
@@ -762,19 +800,107 @@ sw_dump(struct rte_eventdev *dev, FILE *f)
 	}
 }
 
+static uint16_t
+sw_shard_group_find(uint16_t *parent, uint16_t i)
+{
+	while (parent[i] != i) {
+		parent[i] = parent[parent[i]];
+		i = parent[i];
+	}
+	return i;
+}
+
+/* Partition the qids and ports across the scheduler shards. A port and the
+ * qids it is linked to must be scheduled by the same shard, as the history
+ * list and CQ of the port are only updated by one scheduler. The groups of
+ * linked qids and ports are spread over the shards, largest group first.
+ */
+static void
+sw_assign_shards(struct sw_evdev *sw)
+{
+	/* qids are [0, qid_count), ports are [qid_count, n) */
+	uint16_t parent[RTE_EVENT_MAX_QUEUES_PER_DEV + SW_PORTS_MAX];
+	uint16_t weight[RTE_EVENT_MAX_QUEUES_PER_DEV + SW_PORTS_MAX];
+	uint8_t group_shard[RTE_EVENT_MAX_QUEUES_PER_DEV + SW_PORTS_MAX];
+	uint32_t load[SW_SHARDS_MAX] = {0};
+	uint16_t n = sw->qid_count + sw->port_count;
+	unsigned int i, j;
+
+	for (i = 0; i < n; i++) {
+		parent[i] = i;
+		weight[i] = 0;
+	}
+
+	for (i = 0; i < sw->qid_count; i++) {
+		const struct sw_qid *qid = &sw->qids[i];
+
+		for (j = 0; j < qid->cq_num_mapped_cqs; j++) {
+			uint16_t a = sw_shard_group_find(parent, i);
+			uint16_t b = sw_shard_group_find(parent,
+					sw->qid_count + qid->cq_map[j]);
+			parent[a] = b;
+		}
+	}
+
+	for (i = 0; i < n; i++)
+		weight[sw_shard_group_find(parent, i)]++;
+
+	for (;;) {
+		uint16_t group = 0, max = 0;
+		uint8_t shard = 0;
+
+		for (i = 0; i < n; i++) {
+			if (weight[i] > max) {
+				max = weight[i];
+				group = i;
+			}
+		}
+		if (max == 0)
+			break;
+
+		for (i = 1; i < sw->nb_shards; i++)
+			if (load[i] < load[shard])
+				shard = i;
+
+		group_shard[group] = shard;
+		load[shard] += max;
+		weight[group] = 0;
+	}
+
+	for (i = 0; i < sw->qid_count; i++)
+		sw->qids[i].shard = group_shard[sw_shard_group_find(parent, i)];
+	for (i = 0; i < sw->port_count; i++)
+		sw->ports[i].shard = group_shard[sw_shard_group_find(parent,
+				sw->qid_count + i)];
+
+	for (i = 0; i < sw->nb_shards; i++) {
+		sw->shards[i].port_count = 0;
+		sw->shards[i].qid_count = 0;
+	}
+	for (i = 0; i < sw->port_count; i++) {
+		struct sw_shard *sh = &sw->shards[sw->ports[i].shard];
+
+		sh->port_ids[sh->port_count++] = i;
+	}
+}
+
 static int
 sw_start(struct rte_eventdev *dev)
 {
 	unsigned int i, j;
 	struct sw_evdev *sw = sw_pmd_priv(dev);
 
-	rte_service_component_runstate_set(sw->service_id, 1);
+	for (i = 0; i < sw->nb_shards; i++) {
+		struct sw_shard *sh = &sw->shards[i];
 
-	/* check a service core is mapped to this service */
-	if (!rte_service_runstate_get(sw->service_id)) {
-		SW_LOG_ERR("Warning: No Service core enabled on service %s",
-				sw->service_name);
-		return -ENOENT;
+		rte_service_component_runstate_set(sh->service_id, 1);
+
+		/* check a service core is mapped to this service */
+		if (!rte_service_runstate_get(sh->service_id)) {
+			SW_LOG_ERR("Warning: No Service core enabled on service %s",
+					sh->service_name);
+			return -ENOENT;
+		}
 	}
 
 	/* check all ports are set up */
@@ -798,12 +924,15 @@ sw_start(struct rte_eventdev *dev)
 	 * "If two members compare as equal, their order in the sorted
 	 * array is undefined."
 	 */
-	uint32_t qidx = 0;
+	sw_assign_shards(sw);
 	for (j = 0; j <= RTE_EVENT_DEV_PRIORITY_LOWEST; j++) {
 		for (i = 0; i < sw->qid_count; i++) {
 			if (sw->qids[i].priority == j) {
-				sw->qids_prioritized[qidx] = &sw->qids[i];
-				qidx++;
+				struct sw_shard *sh =
+					&sw->shards[sw->qids[i].shard];
+
+				sh->qids_prioritized[sh->qid_count++] =
+					&sw->qids[i];
 			}
 		}
 	}
@@ -823,15 +952,19 @@ static void
 sw_stop(struct rte_eventdev *dev)
 {
 	struct sw_evdev *sw = sw_pmd_priv(dev);
-	int32_t runstate;
+	int32_t runstate[SW_SHARDS_MAX];
+	unsigned int i;
 
-	/* Stop the scheduler if it's running */
-	runstate = rte_service_runstate_get(sw->service_id);
-	if (runstate == 1)
-		rte_service_runstate_set(sw->service_id, 0);
+	/* Stop the schedulers if they are running */
+	for (i = 0; i < sw->nb_shards; i++) {
+		runstate[i] = rte_service_runstate_get(sw->shards[i].service_id);
+		if (runstate[i] == 1)
+			rte_service_runstate_set(sw->shards[i].service_id, 0);
+	}
 
-	while (rte_service_may_be_active(sw->service_id))
-		rte_pause();
+	for (i = 0; i < sw->nb_shards; i++)
+		while (rte_service_may_be_active(sw->shards[i].service_id))
+			rte_pause();
 
 	/* Flush all events out of the device */
 	while (!(sw_qids_empty(sw) && sw_ports_empty(sw))) {
@@ -845,8 +978,9 @@ sw_stop(struct rte_eventdev *dev)
 	sw->started = 0;
 	rte_smp_wmb();
 
-	if (runstate == 1)
-		rte_service_runstate_set(sw->service_id, 1);
+	for (i = 0; i < sw->nb_shards; i++)
+		if (runstate[i] == 1)
+			rte_service_runstate_set(sw->shards[i].service_id, 1);
 }
 
 static int
@@ -863,11 +997,15 @@ sw_close(struct rte_eventdev *dev)
 		sw_port_release(&sw->ports[i]);
 	sw->port_count = 0;
 
-	memset(&sw->stats, 0, sizeof(sw->stats));
-	sw->sched_called = 0;
-	sw->sched_no_iq_enqueues = 0;
-	sw->sched_no_cq_enqueues = 0;
-	sw->sched_cq_qid_called = 0;
+	for (i = 0; i < sw->nb_shards; i++) {
+		struct sw_shard *sh = &sw->shards[i];
+
+		memset(&sh->stats, 0, sizeof(sh->stats));
+		sh->sched_called = 0;
+		sh->sched_no_iq_enqueues = 0;
+		sh->sched_no_cq_enqueues = 0;
+		sh->sched_cq_qid_called = 0;
+	}
 
 	return 0;
 }
@@ -932,10 +1070,91 @@ set_refill_once(const char *key __rte_unused, const char *value, void *opaque)
 	return 0;
 }
 
+static int
+set_sched_shards(const char *key __rte_unused, const char *value, void *opaque)
+{
+	int *shards = opaque;
+	*shards = atoi(value);
+	if (*shards < 1 || *shards > SW_SHARDS_MAX)
+		return -1;
+	return 0;
+}
+
 static int32_t sw_sched_service_func(void *args)
 {
-	struct rte_eventdev *dev = args;
-	return sw_event_schedule(dev);
+	struct sw_shard *sh = args;
+	return sw_shard_schedule(sh);
+}
+
+static void
+sw_shards_free(struct sw_evdev *sw)
+{
+	unsigned int i;
+
+	for (i = 0; i < sw->nb_shards; i++) {
+		struct sw_shard *sh = &sw->shards[i];
+
+		if (sh->service_name[0] != '\0')
+			rte_service_component_unregister(sh->service_id);
+		sh->service_name[0] = '\0';
+		rte_event_ring_free(sh->xfer_ring);
+		sh->xfer_ring = NULL;
+	}
+}
+
+/* register one service per shard with EAL */
+static int
+sw_shards_init(struct rte_eventdev *dev, const char *name, int socket_id)
+{
+	struct sw_evdev *sw = sw_pmd_priv(dev);
+	struct rte_service_spec service;
+	char ring_name[RTE_RING_NAMESIZE];
+	unsigned int i;
+
+	for (i = 0; i < sw->nb_shards; i++) {
+		struct sw_shard *sh = &sw->shards[i];
+
+		sh->sw = sw;
+		sh->id = i;
+
+		/* the events for the qids of the shard from the others */
+		if (sw->nb_shards > 1) {
+			snprintf(ring_name, sizeof(ring_name), "%s_xfer%u",
+					name, i);
+			sh->xfer_ring = rte_event_ring_create(ring_name,
+					SW_INFLIGHT_EVENTS_TOTAL, socket_id,
+					RING_F_SC_DEQ | RING_F_EXACT_SZ);
+			if (sh->xfer_ring == NULL) {
+				SW_LOG_ERR("xfer ring create failed");
+				goto fail;
+			}
+		}
+
+		memset(&service, 0, sizeof(struct rte_service_spec));
+		if (i == 0)
+			snprintf(service.name, sizeof(service.name),
+					"%s_service", name);
+		else
+			snprintf(service.name, sizeof(service.name),
+					"%s_service_%u", name, i);
+		service.socket_id = socket_id;
+		service.callback = sw_sched_service_func;
+		service.callback_userdata = (void *)sh;
+
+		if (rte_service_component_register(&service,
+				&sh->service_id)) {
+			SW_LOG_ERR("service register() failed");
+			goto fail;
+		}
+		snprintf(sh->service_name, sizeof(sh->service_name), "%s",
+				service.name);
+	}
+
+	return 0;
+
+fail:
+	sw_shards_free(sw);
+	return -ENOEXEC;
 }
 
 static int
@@ -980,6 +1199,7 @@ sw_probe(struct rte_vdev_device *vdev)
 		MIN_BURST_SIZE_ARG,
 		DEQ_BURST_SIZE_ARG,
 		REFIL_ONCE_ARG,
+		SCHED_SHARDS_ARG,
 		NULL
 	};
 	const char *name;
@@ -992,6 +1212,7 @@ sw_probe(struct rte_vdev_device *vdev)
 	int min_burst_size = 1;
 	int deq_burst_size = SCHED_DEQUEUE_DEFAULT_BURST_SIZE;
 	int refill_once = 0;
+	int sched_shards = 1;
 
 	name = rte_vdev_device_name(vdev);
 	params = rte_vdev_device_args(vdev);
@@ -1063,6 +1284,16 @@ sw_probe(struct rte_vdev_device *vdev)
 				return ret;
 			}
 
+			ret = rte_kvargs_process(kvlist, SCHED_SHARDS_ARG,
+					set_sched_shards, &sched_shards);
+			if (ret != 0) {
+				SW_LOG_ERR(
+					"%s: Error parsing sched shards parameter",
+					name);
+				rte_kvargs_free(kvlist);
+				return ret;
+			}
+
 			rte_kvargs_free(kvlist);
 		}
 	}
@@ -1070,9 +1301,11 @@ sw_probe(struct rte_vdev_device *vdev)
 	SW_LOG_INFO(
 			"Creating eventdev sw device %s, numa_node=%d, "
 			"sched_quanta=%d, credit_quanta=%d "
-			"min_burst=%d, deq_burst=%d, refill_once=%d",
+			"min_burst=%d, deq_burst=%d, refill_once=%d, "
+			"sched_shards=%d",
 			name, socket_id, sched_quanta, credit_quanta,
-			min_burst_size, deq_burst_size, refill_once);
+			min_burst_size, deq_burst_size, refill_once,
+			sched_shards);
 
 	dev = rte_event_pmd_vdev_init(name,
 			sizeof(struct sw_evdev), socket_id, vdev);
@@ -1098,25 +1331,15 @@ sw_probe(struct rte_vdev_device *vdev)
 	sw->sched_min_burst_size = min_burst_size;
 	sw->sched_deq_burst_size = deq_burst_size;
 	sw->refill_once_per_iter = refill_once;
+	sw->nb_shards = sched_shards;
 
-	/* register service with EAL */
-	struct rte_service_spec service;
-	memset(&service, 0, sizeof(struct rte_service_spec));
-	snprintf(service.name, sizeof(service.name), "%s_service", name);
-	snprintf(sw->service_name, sizeof(sw->service_name), "%s_service",
-			name);
-	service.socket_id = socket_id;
-	service.callback = sw_sched_service_func;
-	service.callback_userdata = (void *)dev;
-
-	int32_t ret = rte_service_component_register(&service, &sw->service_id);
-	if (ret) {
-		SW_LOG_ERR("service register() failed");
-		return -ENOEXEC;
-	}
+	int32_t ret = sw_shards_init(dev, name, socket_id);
+	if (ret)
+		return ret;
 
+	/* the service of the first shard is the one of the device */
 	dev->data->service_inited = 1;
-	dev->data->service_id = sw->service_id;
+	dev->data->service_id = sw->shards[0].service_id;
 
 	event_dev_probing_finish(dev);
 
@@ -1126,6 +1349,7 @@ sw_probe(struct rte_vdev_device *vdev)
 static int
 sw_remove(struct rte_vdev_device *vdev)
 {
+	struct rte_eventdev *dev;
 	const char *name;
 
 	name = rte_vdev_device_name(vdev);
@@ -1134,6 +1358,10 @@ sw_remove(struct rte_vdev_device *vdev)
 
 	SW_LOG_INFO("Closing eventdev sw device %s", name);
 
+	dev = rte_event_pmd_get_named_dev(name);
+	if (dev != NULL && rte_eal_process_type() == RTE_PROC_PRIMARY)
+		sw_shards_free(sw_pmd_priv(dev));
+
 	return rte_event_pmd_vdev_uninit(name);
 }
 
@@ -1146,5 +1374,5 @@ RTE_PMD_REGISTER_VDEV(EVENTDEV_NAME_SW_PMD, evdev_sw_pmd_drv);
 RTE_PMD_REGISTER_PARAM_STRING(event_sw, NUMA_NODE_ARG "=<int> "
 		SCHED_QUANTA_ARG "=<int>" CREDIT_QUANTA_ARG "=<int>"
 		MIN_BURST_SIZE_ARG "=<int>" DEQ_BURST_SIZE_ARG "=<int>"
-		REFIL_ONCE_ARG "=<int>");
+		REFIL_ONCE_ARG "=<int>" SCHED_SHARDS_ARG "=<int>");
 RTE_LOG_REGISTER_DEFAULT(eventdev_sw_log_level, NOTICE);
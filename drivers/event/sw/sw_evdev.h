@@ -36,6 +36,11 @@
 /* Flush the pipeline after this many no enq to cq */
 #define SCHED_NO_ENQ_CYCLE_FLUSH 256
 
+/* max number of scheduler shards, each run by its own service */
+#define SW_SHARDS_MAX 8
+/* events buffered for another shard before enqueueing them */
+#define SW_SHARD_XFER_BURST 32
+
 
 #define SW_PORT_HIST_LIST (MAX_SW_PROD_Q_DEPTH) /* size of our history list */
 #define NUM_SAMPLES 64 /* how many data points use for average stats */
@@ -133,6 +138,9 @@ struct sw_qid {
 	uint32_t window_size;          /* Used to wrap reorder_buffer_index */
 
 	uint8_t priority;
+
+	/* The scheduler shard owning this QID */
+	uint8_t shard;
 };
 
 struct sw_hist_list_entry {
@@ -207,6 +215,49 @@ struct sw_port {
 	struct rte_event cq_buf[MAX_SW_CONS_Q_DEPTH];
 
 	uint8_t num_qids_mapped;
+
+	/* The scheduler shard pulling from this port and scheduling to it */
+	uint8_t shard;
+};
+
+/* A scheduler instance, run by its own service. The QIDs and the ports
+ * linked together are scheduled by the same shard, so atomic flows stay
+ * pinned within a shard. Events enqueued to a QID of another shard are
+ * transferred to it through its xfer_ring.
+ */
+struct __rte_cache_aligned sw_shard {
+	struct sw_evdev *sw;
+	uint8_t id;
+
+	/* Ports pulled and QIDs scheduled by this shard */
+	uint32_t port_count;
+	uint8_t port_ids[SW_PORTS_MAX];
+	uint32_t qid_count;
+	struct sw_qid *qids_prioritized[RTE_EVENT_MAX_QUEUES_PER_DEV];
+
+	/* IQ memory of the QIDs of this shard */
+	struct sw_queue_chunk *chunk_list_head;
+
+	/* Events for the QIDs of this shard, enqueued by other shards */
+	struct rte_event_ring *xfer_ring;
+	uint16_t xfer_buf_count[SW_SHARDS_MAX];
+	struct rte_event xfer_buf[SW_SHARDS_MAX][SW_SHARD_XFER_BURST];
+
+	/* Current values */
+	uint32_t sched_flush_count;
+	uint32_t sched_min_burst;
+
+	/* Stats */
+	struct sw_point_stats stats;
+	uint64_t sched_called;
+	uint64_t sched_no_iq_enqueues;
+	uint64_t sched_no_cq_enqueues;
+	uint64_t sched_cq_qid_called;
+	uint64_t sched_last_iter_bitmask;
+	uint8_t sched_progress_last_iter;
+
+	uint32_t service_id;
+	char service_name[SW_PMD_NAME_MAX];
 };
 
 struct sw_evdev {
@@ -226,9 +277,6 @@ struct sw_evdev {
 	uint32_t sched_deq_burst_size;
 	/* Refill pp buffers only once per scheduler call*/
 	uint32_t refill_once_per_iter;
-	/* Current values */
-	uint32_t sched_flush_count;
-	uint32_t sched_min_burst;
 
 	/* Contains all ports - load balanced and directed */
 	alignas(RTE_CACHE_LINE_SIZE) struct sw_port ports[SW_PORTS_MAX];
@@ -243,24 +291,16 @@ struct sw_evdev {
 
 	/* Internal queues - one per logical queue */
 	alignas(RTE_CACHE_LINE_SIZE) struct sw_qid qids[RTE_EVENT_MAX_QUEUES_PER_DEV];
-	struct sw_queue_chunk *chunk_list_head;
 	struct sw_queue_chunk *chunks;
 
 	/* Cache how many packets are in each cq */
 	alignas(RTE_CACHE_LINE_SIZE) uint16_t cq_ring_space[SW_PORTS_MAX];
 
-	/* Array of pointers to load-balanced QIDs sorted by priority level */
-	struct sw_qid *qids_prioritized[RTE_EVENT_MAX_QUEUES_PER_DEV];
+	/* Scheduler instances */
+	uint8_t nb_shards;
+	struct sw_shard shards[SW_SHARDS_MAX];
 
-	/* Stats */
-	alignas(RTE_CACHE_LINE_SIZE) struct sw_point_stats stats;
-	uint64_t sched_called;
 	int32_t sched_quanta;
-	uint64_t sched_no_iq_enqueues;
-	uint64_t sched_no_cq_enqueues;
-	uint64_t sched_cq_qid_called;
-	uint64_t sched_last_iter_bitmask;
-	uint8_t sched_progress_last_iter;
 
 	uint8_t started;
 	uint32_t credit_update_quanta;
@@ -271,9 +311,6 @@ struct sw_evdev {
 	/* store num stats and offset of the stats for each queue */
 	uint16_t xstats_count_per_qid[RTE_EVENT_MAX_QUEUES_PER_DEV];
 	uint16_t xstats_offset_for_qid[RTE_EVENT_MAX_QUEUES_PER_DEV];
-
-	uint32_t service_id;
-	char service_name[SW_PMD_NAME_MAX];
 };
 
 static inline struct sw_evdev *
@@ -293,6 +330,7 @@ uint16_t sw_event_enqueue_burst(void *port, const struct rte_event ev[],
 
 uint16_t sw_event_dequeue_burst(void *port, struct rte_event *ev, uint16_t num,
 			uint64_t wait);
+int32_t sw_shard_schedule(struct sw_shard *sh);
 int32_t sw_event_schedule(struct rte_eventdev *dev);
 int sw_xstats_init(struct sw_evdev *dev);
 int sw_xstats_uninit(struct sw_evdev *dev);
@@ -29,9 +29,10 @@
 
 
 static inline uint32_t
-sw_schedule_atomic_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
+sw_schedule_atomic_to_cq(struct sw_shard *sh, struct sw_qid * const qid,
 		uint32_t iq_num, unsigned int count)
 {
+	struct sw_evdev *sw = sh->sw;
 	struct rte_event qes[MAX_PER_IQ_DEQUEUE]; /* count <= MAX */
 	struct rte_event blocked_qes[MAX_PER_IQ_DEQUEUE];
 	uint32_t nb_blocked = 0;
@@ -45,7 +46,7 @@ sw_schedule_atomic_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 	 */
 	uint32_t qid_id = qid->id;
 
-	iq_dequeue_burst(sw, &qid->iq[iq_num], qes, count);
+	iq_dequeue_burst(sh, &qid->iq[iq_num], qes, count);
 	for (i = 0; i < count; i++) {
 		const struct rte_event *qe = &qes[i];
 		const uint16_t flow_id = SW_HASH_FLOWID(qes[i].flow_id);
@@ -108,15 +109,16 @@ sw_schedule_atomic_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 			p->cq_buf_count = 0;
 		}
 	}
-	iq_put_back(sw, &qid->iq[iq_num], blocked_qes, nb_blocked);
+	iq_put_back(sh, &qid->iq[iq_num], blocked_qes, nb_blocked);
 
 	return count - nb_blocked;
 }
 
 static inline uint32_t
-sw_schedule_parallel_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
+sw_schedule_parallel_to_cq(struct sw_shard *sh, struct sw_qid * const qid,
 		uint32_t iq_num, unsigned int count, int keep_order)
 {
+	struct sw_evdev *sw = sh->sw;
 	uint32_t i;
 	uint32_t cq_idx = qid->cq_next_tx;
 
@@ -174,7 +176,7 @@ sw_schedule_parallel_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 					(void *)&p->hist_list[head].rob_entry);
 
 		sw->ports[cq].cq_buf[sw->ports[cq].cq_buf_count++] = *qe;
-		iq_pop(sw, &qid->iq[iq_num]);
+		iq_pop(sh, &qid->iq[iq_num]);
 
 		rte_compiler_barrier();
 		p->inflights++;
@@ -187,9 +189,10 @@ sw_schedule_parallel_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 }
 
 static uint32_t
-sw_schedule_dir_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
+sw_schedule_dir_to_cq(struct sw_shard *sh, struct sw_qid * const qid,
 		uint32_t iq_num, unsigned int count __rte_unused)
 {
+	struct sw_evdev *sw = sh->sw;
 	uint32_t cq_id = qid->cq_map[0];
 	struct sw_port *port = &sw->ports[cq_id];
 
@@ -200,7 +203,7 @@ sw_schedule_dir_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 
 	/* burst dequeue from the QID IQ ring */
 	struct sw_iq *iq = &qid->iq[iq_num];
-	uint32_t ret = iq_dequeue_burst(sw, iq,
+	uint32_t ret = iq_dequeue_burst(sh, iq,
 			&port->cq_buf[port->cq_buf_count], count_free);
 	port->cq_buf_count += ret;
 
@@ -215,15 +218,15 @@ sw_schedule_dir_to_cq(struct sw_evdev *sw, struct sw_qid * const qid,
 }
 
 static uint32_t
-sw_schedule_qid_to_cq(struct sw_evdev *sw)
+sw_schedule_qid_to_cq(struct sw_shard *sh)
 {
 	uint32_t pkts = 0;
 	uint32_t qid_idx;
 
-	sw->sched_cq_qid_called++;
+	sh->sched_cq_qid_called++;
 
-	for (qid_idx = 0; qid_idx < sw->qid_count; qid_idx++) {
-		struct sw_qid *qid = sw->qids_prioritized[qid_idx];
+	for (qid_idx = 0; qid_idx < sh->qid_count; qid_idx++) {
+		struct sw_qid *qid = sh->qids_prioritized[qid_idx];
 
 		int type = qid->type;
 		int iq_num = PKT_MASK_TO_IQ(qid->iq_pkt_mask);
@@ -235,15 +238,15 @@ sw_schedule_qid_to_cq(struct sw_evdev *sw)
 		uint32_t pkts_done = 0;
 		uint32_t count = iq_count(&qid->iq[iq_num]);
 
-		if (count >= sw->sched_min_burst) {
+		if (count >= sh->sched_min_burst) {
 			if (type == SW_SCHED_TYPE_DIRECT)
-				pkts_done += sw_schedule_dir_to_cq(sw, qid,
+				pkts_done += sw_schedule_dir_to_cq(sh, qid,
 						iq_num, count);
 			else if (type == RTE_SCHED_TYPE_ATOMIC)
-				pkts_done += sw_schedule_atomic_to_cq(sw, qid,
+				pkts_done += sw_schedule_atomic_to_cq(sh, qid,
 						iq_num, count);
 			else
-				pkts_done += sw_schedule_parallel_to_cq(sw, qid,
+				pkts_done += sw_schedule_parallel_to_cq(sh, qid,
 						iq_num, count,
 						type == RTE_SCHED_TYPE_ORDERED);
 		}
@@ -260,19 +263,80 @@ sw_schedule_qid_to_cq(struct sw_evdev *sw)
 	return pkts;
 }
 
+static void
+sw_shard_xfer_flush(struct sw_shard *sh, uint8_t dst)
+{
+	struct sw_shard *to = &sh->sw->shards[dst];
+	uint16_t count = sh->xfer_buf_count[dst];
+	uint32_t n;
+
+	/* The ring is sized for all the inflight events, it can't be full */
+	n = rte_event_ring_enqueue_burst(to->xfer_ring, sh->xfer_buf[dst],
+			count, NULL);
+	sh->stats.rx_dropped += count - n;
+	sh->xfer_buf_count[dst] = 0;
+}
+
+/* Buffer an event for a QID scheduled by another shard */
+static __rte_always_inline void
+sw_shard_xfer(struct sw_shard *sh, uint8_t dst, const struct rte_event *qe)
+{
+	sh->xfer_buf[dst][sh->xfer_buf_count[dst]++] = *qe;
+	if (sh->xfer_buf_count[dst] == SW_SHARD_XFER_BURST)
+		sw_shard_xfer_flush(sh, dst);
+}
+
+static __rte_always_inline void
+sw_shard_iq_enqueue(struct sw_shard *sh, struct sw_qid *qid,
+		uint32_t iq_num, const struct rte_event *qe)
+{
+	qid->iq_pkt_mask |= (1 << (iq_num));
+	iq_enqueue(sh, &qid->iq[iq_num], qe);
+	qid->iq_pkt_count[iq_num]++;
+	qid->stats.rx_pkts++;
+}
+
+/* Pull the events enqueued by the other shards to the QIDs of this shard */
+static uint32_t
+sw_schedule_pull_xfer(struct sw_shard *sh)
+{
+	struct rte_event evs[SW_SHARD_XFER_BURST];
+	uint32_t pkts_iter = 0;
+	uint16_t n, i;
+
+	if (sh->xfer_ring == NULL)
+		return 0;
+
+	do {
+		n = rte_event_ring_dequeue_burst(sh->xfer_ring, evs,
+				RTE_DIM(evs), NULL);
+		for (i = 0; i < n; i++) {
+			struct sw_qid *qid = &sh->sw->qids[evs[i].queue_id];
+
+			sw_shard_iq_enqueue(sh, qid,
+					PRIO_TO_IQ(evs[i].priority), &evs[i]);
+		}
+		pkts_iter += n;
+	} while (n == RTE_DIM(evs));
+
+	return pkts_iter;
+}
+
 /* This function will perform re-ordering of packets, and injecting into
- * the appropriate QID IQ. As LB and DIR QIDs are in the same array, but *NOT*
- * contiguous in that array, this function accepts a "range" of QIDs to scan.
+ * the appropriate QID IQ. Only the ordered QIDs scheduled by the shard are
+ * scanned.
  */
 static uint16_t
-sw_schedule_reorder(struct sw_evdev *sw, int qid_start, int qid_end)
+sw_schedule_reorder(struct sw_shard *sh)
 {
+	struct sw_evdev *sw = sh->sw;
 	/* Perform egress reordering */
 	struct rte_event *qe;
 	uint32_t pkts_iter = 0;
+	uint32_t qid_idx;
 
-	for (; qid_start < qid_end; qid_start++) {
-		struct sw_qid *qid = &sw->qids[qid_start];
+	for (qid_idx = 0; qid_idx < sh->qid_count; qid_idx++) {
+		struct sw_qid *qid = sh->qids_prioritized[qid_idx];
 		unsigned int i, num_entries_in_use;
 
 		if (qid->type != RTE_SCHED_TYPE_ORDERED)
@@ -281,7 +345,7 @@ sw_schedule_reorder(struct sw_evdev *sw, int qid_start, int qid_end)
 		num_entries_in_use = rob_ring_free_count(
 					qid->reorder_buffer_freelist);
 
-		if (num_entries_in_use < sw->sched_min_burst)
+		if (num_entries_in_use < sh->sched_min_burst)
 			num_entries_in_use = 0;
 
 		for (i = 0; i < num_entries_in_use; i++) {
@@ -304,22 +368,23 @@ sw_schedule_reorder(struct sw_evdev *sw, int qid_start, int qid_end)
 				dest_iq  = PRIO_TO_IQ(qe->priority);
 
 				if (dest_qid >= sw->qid_count) {
-					sw->stats.rx_dropped++;
+					sh->stats.rx_dropped++;
 					continue;
 				}
 
-				pkts_iter++;
-
 				struct sw_qid *q = &sw->qids[dest_qid];
-				struct sw_iq *iq = &q->iq[dest_iq];
+
+				if (q->shard != sh->id) {
+					sw_shard_xfer(sh, q->shard, qe);
+					continue;
+				}
+
+				pkts_iter++;
 
 				/* we checked for space above, so enqueue must
 				 * succeed
 				 */
-				iq_enqueue(sw, iq, qe);
-				q->iq_pkt_mask |= (1 << (dest_iq));
-				q->iq_pkt_count[dest_iq]++;
-				q->stats.rx_pkts++;
+				sw_shard_iq_enqueue(sh, q, dest_iq, qe);
 			}
 
 			entry->ready = (j != entry->num_fragments);
@@ -352,9 +417,10 @@ sw_refill_pp_buf(struct sw_evdev *sw, struct sw_port *port)
 }
 
 static __rte_always_inline uint32_t
-__pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
+__pull_port_lb(struct sw_shard *sh, uint32_t port_id, int allow_reorder)
 {
 	static struct reorder_buffer_entry dummy_rob;
+	struct sw_evdev *sw = sh->sw;
 	uint32_t pkts_iter = 0;
 	struct sw_port *port = &sw->ports[port_id];
 
@@ -424,7 +490,7 @@ __pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
 				 */
 				int num_frag = rob_entry->num_fragments;
 				if (num_frag == SW_FRAGMENTS_MAX)
-					sw->stats.rx_dropped++;
+					sh->stats.rx_dropped++;
 				else {
 					int idx = rob_entry->num_fragments++;
 					rob_entry->fragments[idx] = *qe;
@@ -432,14 +498,15 @@ __pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
 				goto end_qe;
 			}
 
+			if (qid->shard != sh->id) {
+				sw_shard_xfer(sh, qid->shard, qe);
+				goto end_qe;
+			}
+
 			/* Use the iq_num from above to push the QE
 			 * into the qid at the right priority
 			 */
-
-			qid->iq_pkt_mask |= (1 << (iq_num));
-			iq_enqueue(sw, &qid->iq[iq_num], qe);
-			qid->iq_pkt_count[iq_num]++;
-			qid->stats.rx_pkts++;
+			sw_shard_iq_enqueue(sh, qid, iq_num, qe);
 			pkts_iter++;
 		}
 
@@ -452,20 +519,21 @@ __pull_port_lb(struct sw_evdev *sw, uint32_t port_id, int allow_reorder)
 }
 
 static uint32_t
-sw_schedule_pull_port_lb(struct sw_evdev *sw, uint32_t port_id)
+sw_schedule_pull_port_lb(struct sw_shard *sh, uint32_t port_id)
 {
-	return __pull_port_lb(sw, port_id, 1);
+	return __pull_port_lb(sh, port_id, 1);
 }
 
 static uint32_t
-sw_schedule_pull_port_no_reorder(struct sw_evdev *sw, uint32_t port_id)
+sw_schedule_pull_port_no_reorder(struct sw_shard *sh, uint32_t port_id)
 {
-	return __pull_port_lb(sw, port_id, 0);
+	return __pull_port_lb(sh, port_id, 0);
 }
 
 static uint32_t
-sw_schedule_pull_port_dir(struct sw_evdev *sw, uint32_t port_id)
+sw_schedule_pull_port_dir(struct sw_shard *sh, uint32_t port_id)
 {
+	struct sw_evdev *sw = sh->sw;
 	uint32_t pkts_iter = 0;
 	struct sw_port *port = &sw->ports[port_id];
 
@@ -482,17 +550,18 @@ sw_schedule_pull_port_dir(struct sw_evdev *sw, uint32_t port_id)
 
 		uint32_t iq_num = PRIO_TO_IQ(qe->priority);
 		struct sw_qid *qid = &sw->qids[qe->queue_id];
-		struct sw_iq *iq = &qid->iq[iq_num];
 
 		port->stats.rx_pkts++;
 
+		if (qid->shard != sh->id) {
+			sw_shard_xfer(sh, qid->shard, qe);
+			goto end_qe;
+		}
+
 		/* Use the iq_num from above to push the QE
 		 * into the qid at the right priority
 		 */
-		qid->iq_pkt_mask |= (1 << (iq_num));
-		iq_enqueue(sw, iq, qe);
-		qid->iq_pkt_count[iq_num]++;
-		qid->stats.rx_pkts++;
+		sw_shard_iq_enqueue(sh, qid, iq_num, qe);
 		pkts_iter++;
 
 end_qe:
@@ -504,15 +573,15 @@ sw_schedule_pull_port_dir(struct sw_evdev *sw, uint32_t port_id)
 }
 
 int32_t
-sw_event_schedule(struct rte_eventdev *dev)
+sw_shard_schedule(struct sw_shard *sh)
 {
-	struct sw_evdev *sw = sw_pmd_priv(dev);
+	struct sw_evdev *sw = sh->sw;
 	uint32_t in_pkts, out_pkts;
 	uint32_t out_pkts_total = 0, in_pkts_total = 0;
 	int32_t sched_quanta = sw->sched_quanta;
-	uint32_t i;
+	uint32_t i, j;
 
-	sw->sched_called++;
+	sh->sched_called++;
 	if (unlikely(!sw->started))
 		return -EAGAIN;
 
@@ -522,27 +591,29 @@ sw_event_schedule(struct rte_eventdev *dev)
 		/* Pull from rx_ring for ports */
 		do {
 			in_pkts = 0;
-			for (i = 0; i < sw->port_count; i++) {
+			for (j = 0; j < sh->port_count; j++) {
+				i = sh->port_ids[j];
 				/* ack the unlinks in progress as done */
 				if (sw->ports[i].unlinks_in_progress)
 					sw->ports[i].unlinks_in_progress = 0;
 
 				if (sw->ports[i].is_directed)
-					in_pkts += sw_schedule_pull_port_dir(sw, i);
+					in_pkts += sw_schedule_pull_port_dir(sh, i);
 				else if (sw->ports[i].num_ordered_qids > 0)
-					in_pkts += sw_schedule_pull_port_lb(sw, i);
+					in_pkts += sw_schedule_pull_port_lb(sh, i);
 				else
-					in_pkts += sw_schedule_pull_port_no_reorder(sw, i);
+					in_pkts += sw_schedule_pull_port_no_reorder(sh, i);
 			}
 
 			/* QID scan for re-ordered */
-			in_pkts += sw_schedule_reorder(sw, 0,
-					sw->qid_count);
+			in_pkts += sw_schedule_reorder(sh);
+			/* events from the other shards */
+			in_pkts += sw_schedule_pull_xfer(sh);
 			in_pkts_this_iteration += in_pkts;
 		} while (in_pkts > 4 &&
 				(int)in_pkts_this_iteration < sched_quanta);
 
-		out_pkts = sw_schedule_qid_to_cq(sw);
+		out_pkts = sw_schedule_qid_to_cq(sh);
 		out_pkts_total += out_pkts;
 		in_pkts_total += in_pkts_this_iteration;
 
@@ -550,14 +621,19 @@ sw_event_schedule(struct rte_eventdev *dev)
 			break;
 	} while ((int)out_pkts_total < sched_quanta);
 
-	sw->stats.tx_pkts += out_pkts_total;
-	sw->stats.rx_pkts += in_pkts_total;
+	/* hand over the events buffered for the other shards */
+	for (i = 0; i < sw->nb_shards; i++)
+		if (sh->xfer_buf_count[i])
+			sw_shard_xfer_flush(sh, i);
 
-	sw->sched_no_iq_enqueues += (in_pkts_total == 0);
-	sw->sched_no_cq_enqueues += (out_pkts_total == 0);
+	sh->stats.tx_pkts += out_pkts_total;
+	sh->stats.rx_pkts += in_pkts_total;
+
+	sh->sched_no_iq_enqueues += (in_pkts_total == 0);
+	sh->sched_no_cq_enqueues += (out_pkts_total == 0);
 
 	uint64_t work_done = (in_pkts_total + out_pkts_total) != 0;
-	sw->sched_progress_last_iter = work_done;
+	sh->sched_progress_last_iter = work_done;
 
 	uint64_t cqs_scheds_last_iter = 0;
 
@@ -565,7 +641,8 @@ sw_event_schedule(struct rte_eventdev *dev)
 	 * worker cores: aka, do the ring transfers batched.
 	 */
 	int no_enq = 1;
-	for (i = 0; i < sw->port_count; i++) {
+	for (j = 0; j < sh->port_count; j++) {
+		i = sh->port_ids[j];
 		struct sw_port *port = &sw->ports[i];
 		struct rte_event_ring *worker = port->cq_worker_ring;
 
@@ -573,7 +650,7 @@ sw_event_schedule(struct rte_eventdev *dev)
 		if (sw->refill_once_per_iter && port->pp_buf_count == 0)
 			sw_refill_pp_buf(sw, port);
 
-		if (port->cq_buf_count >= sw->sched_min_burst) {
+		if (port->cq_buf_count >= sh->sched_min_burst) {
 			rte_event_ring_enqueue_burst(worker,
 					port->cq_buf,
 					port->cq_buf_count,
@@ -589,24 +666,38 @@ sw_event_schedule(struct rte_eventdev *dev)
 	}
 
 	if (no_enq) {
-		if (unlikely(sw->sched_flush_count > SCHED_NO_ENQ_CYCLE_FLUSH))
-			sw->sched_min_burst = 1;
+		if (unlikely(sh->sched_flush_count > SCHED_NO_ENQ_CYCLE_FLUSH))
+			sh->sched_min_burst = 1;
 		else
-			sw->sched_flush_count++;
+			sh->sched_flush_count++;
 	} else {
-		if (sw->sched_flush_count)
-			sw->sched_flush_count--;
+		if (sh->sched_flush_count)
+			sh->sched_flush_count--;
 		else
-			sw->sched_min_burst = sw->sched_min_burst_size;
+			sh->sched_min_burst = sw->sched_min_burst_size;
 	}
 
 	/* Provide stats on what eventdev ports were scheduled to this
 	 * iteration. If more than 64 ports are active, always report that
 	 * all Eventdev ports have been scheduled events.
 	 */
-	sw->sched_last_iter_bitmask = cqs_scheds_last_iter;
+	sh->sched_last_iter_bitmask = cqs_scheds_last_iter;
 	if (unlikely(sw->port_count >= 64))
-		sw->sched_last_iter_bitmask = UINT64_MAX;
+		sh->sched_last_iter_bitmask = UINT64_MAX;
 
 	return work_done ? 0 : -EAGAIN;
 }
+
+int32_t
+sw_event_schedule(struct rte_eventdev *dev)
+{
+	struct sw_evdev *sw = sw_pmd_priv(dev);
+	int32_t ret = -EAGAIN;
+	uint32_t i;
+
+	for (i = 0; i < sw->nb_shards; i++)
+		if (sw_shard_schedule(&sw->shards[i]) == 0)
+			ret = 0;
+
+	return ret;
+}
@@ -3303,6 +3303,107 @@ worker_loopback(struct test *t, uint8_t disable_implicit_release)
 	return 0;
 }
 
+static int
+sharded_schedulers(struct test *t)
+{
+	const char *eventdev_name = "event_sw_shards";
+	int main_evdev = evdev;
+	uint32_t service_id[2];
+	struct rte_event ev;
+	int ret = -1;
+	int i;
+
+	if (rte_vdev_init(eventdev_name, "sched_shards=2") < 0) {
+		printf("%d: Error creating eventdev\n", __LINE__);
+		return -1;
+	}
+	evdev = rte_event_dev_get_dev_id(eventdev_name);
+	if (evdev < 0 ||
+			rte_event_dev_service_id_get(evdev, &service_id[0]) < 0 ||
+			rte_service_get_by_name("event_sw_shards_service_1",
+				&service_id[1]) < 0) {
+		printf("%d: Error finding eventdev services\n", __LINE__);
+		goto err;
+	}
+	for (i = 0; i < 2; i++) {
+		rte_service_runstate_set(service_id[i], 1);
+		rte_service_set_runstate_mapped_check(service_id[i], 0);
+	}
+
+	/* 1 producer port, 2 atomic QIDs each linked to its own port */
+	if (init(t, 2, 3) < 0 ||
+			create_ports(t, 3) < 0 ||
+			create_atomic_qids(t, 2) < 0)
+		goto err;
+
+	for (i = 0; i < 2; i++) {
+		if (rte_event_port_link(evdev, t->port[i + 1], &t->qid[i],
+				NULL, 1) != 1) {
+			printf("%d: error mapping qid to port\n", __LINE__);
+			goto err_close;
+		}
+	}
+	if (rte_event_dev_start(evdev) < 0) {
+		printf("%d: Error with start call\n", __LINE__);
+		goto err_close;
+	}
+
+	/* the QIDs are scheduled by different shards */
+	if (rte_event_port_link(evdev, t->port[1], &t->qid[1], NULL, 1) != 0) {
+		printf("%d: port linked to a QID of another shard\n",
+				__LINE__);
+		goto err_close;
+	}
+
+	ev = (struct rte_event){
+		.op = RTE_EVENT_OP_NEW,
+		.queue_id = t->qid[0],
+		.sched_type = RTE_SCHED_TYPE_ATOMIC,
+		.priority = RTE_EVENT_DEV_PRIORITY_NORMAL,
+		.flow_id = 7,
+		.u64 = 0xcafe,
+	};
+	if (rte_event_enqueue_burst(evdev, t->port[0], &ev, 1) != 1) {
+		printf("%d: Failed to enqueue\n", __LINE__);
+		goto err_close;
+	}
+	rte_service_run_iter_on_app_lcore(service_id[0], 1);
+
+	if (rte_event_dequeue_burst(evdev, t->port[1], &ev, 1, 0) != 1) {
+		printf("%d: failed to dequeue from first shard\n", __LINE__);
+		goto err_close;
+	}
+
+	/* forward to the QID of the other shard */
+	ev.op = RTE_EVENT_OP_FORWARD;
+	ev.queue_id = t->qid[1];
+	if (rte_event_enqueue_burst(evdev, t->port[1], &ev, 1) != 1) {
+		printf("%d: Failed to enqueue\n", __LINE__);
+		goto err_close;
+	}
+	rte_service_run_iter_on_app_lcore(service_id[0], 1);
+	rte_service_run_iter_on_app_lcore(service_id[1], 1);
+
+	if (rte_event_dequeue_burst(evdev, t->port[2], &ev, 1, 0) != 1) {
+		printf("%d: failed to dequeue from second shard\n", __LINE__);
+		goto err_close;
+	}
+	if (ev.queue_id != t->qid[1] || ev.u64 != 0xcafe) {
+		printf("%d: unexpected event\n", __LINE__);
+		goto err_close;
+	}
+	rte_event_enqueue_burst(evdev, t->port[2], &release_ev, 1);
+	rte_service_run_iter_on_app_lcore(service_id[1], 1);
+
+	ret = 0;
+err_close:
+	cleanup(t);
+err:
+	rte_vdev_uninit(eventdev_name);
+	evdev = main_evdev;
+	return ret;
+}
+
 static struct rte_mempool *eventdev_func_mempool;
 
 int
@@ -3521,6 +3622,12 @@ test_sw_eventdev(void)
 		printf("ERROR - Ordered & Atomic hist-list test FAILED.\n");
 		goto test_fail;
 	}
+	printf("*** Running Sharded Schedulers test...\n");
+	ret = sharded_schedulers(t);
+	if (ret != 0) {
+		printf("ERROR - Sharded Schedulers test FAILED.\n");
+		goto test_fail;
+	}
 	if (rte_lcore_count() >= 3) {
 		printf("*** Running Worker loopback test...\n");
 		ret = worker_loopback(t, 0);
@@ -49,23 +49,45 @@ struct sw_xstats_entry {
 };
 
 static uint64_t
-get_dev_stat(const struct sw_evdev *sw, uint16_t obj_idx __rte_unused,
-		enum xstats_type type, int extra_arg __rte_unused)
+get_shard_stat(const struct sw_shard *sh, enum xstats_type type)
 {
 	switch (type) {
-	case rx: return sw->stats.rx_pkts;
-	case tx: return sw->stats.tx_pkts;
-	case dropped: return sw->stats.rx_dropped;
-	case calls: return sw->sched_called;
-	case no_iq_enq: return sw->sched_no_iq_enqueues;
-	case no_cq_enq: return sw->sched_no_cq_enqueues;
-	case sched_last_iter_bitmask: return sw->sched_last_iter_bitmask;
-	case sched_progress_last_iter: return sw->sched_progress_last_iter;
+	case rx: return sh->stats.rx_pkts;
+	case tx: return sh->stats.tx_pkts;
+	case dropped: return sh->stats.rx_dropped;
+	case calls: return sh->sched_called;
+	case no_iq_enq: return sh->sched_no_iq_enqueues;
+	case no_cq_enq: return sh->sched_no_cq_enqueues;
+	case sched_last_iter_bitmask: return sh->sched_last_iter_bitmask;
+	case sched_progress_last_iter: return sh->sched_progress_last_iter;
 
 	default: return -1;
 	}
 }
 
+static uint64_t
+get_dev_stat(const struct sw_evdev *sw, uint16_t obj_idx __rte_unused,
+		enum xstats_type type, int extra_arg __rte_unused)
+{
+	uint64_t val = 0;
+	unsigned int i;
+
+	/* counters are summed over the shards, the last iteration ORed */
+	for (i = 0; i < sw->nb_shards; i++) {
+		uint64_t v = get_shard_stat(&sw->shards[i], type);
+
+		if (v == (uint64_t)-1)
+			return v;
+		if (type == sched_last_iter_bitmask ||
+				type == sched_progress_last_iter)
+			val |= v;
+		else
+			val += v;
+	}
+
+	return val;
+}
+
 static uint64_t
 get_port_stat(const struct sw_evdev *sw, uint16_t obj_idx,
 		enum xstats_type type, int extra_arg __rte_unused)
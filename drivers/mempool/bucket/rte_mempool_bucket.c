@@ -24,6 +24,9 @@
  * Until the bucket is full, no objects from it are eligible for allocation.
  * If a request is made to dequeue a multiply of bucket size, it is
  * satisfied by returning the whole buckets, instead of separate objects.
+ * A bucket dequeued by an lcore is owned by it until full again: other
+ * objects of a partially used bucket are served only to the same lcore,
+ * in address order, from its current bucket.
  */
 
 
@@ -35,6 +38,9 @@ struct bucket_header {
 struct bucket_stack {
 	unsigned int top;
 	unsigned int limit;
+	/* Next objects of the bucket partially dequeued by the lcore */
+	uint8_t *cur_obj;
+	unsigned int cur_left;
 	void *objects[];
 };
 
@@ -52,7 +58,6 @@ struct bucket_data {
 	 * dequeued
 	 */
 	struct rte_ring *adoption_buffer_rings[RTE_MAX_LCORE];
-	struct rte_ring *shared_orphan_ring;
 	struct rte_mempool *pool;
 	unsigned int bucket_mem_size;
 	void *lcore_callback_handle;
@@ -175,47 +180,50 @@ bucket_fill_obj_table(const struct bucket_data *bd, void **pstart,
 	return obj_table;
 }
 
+static void **
+bucket_take_cur_objs(const struct bucket_data *bd,
+		     struct bucket_stack *stack, void **obj_table,
+		     unsigned int n)
+{
+	uint8_t *objptr = stack->cur_obj;
+
+	RTE_ASSERT(n <= stack->cur_left);
+	stack->cur_left -= n;
+	for (; n > 0; n--, objptr += bd->total_elt_size)
+		*obj_table++ = objptr;
+	stack->cur_obj = objptr;
+	return obj_table;
+}
+
 static int
 bucket_dequeue_orphans(struct bucket_data *bd, void **obj_table,
 		       unsigned int n_orphans)
 {
-	unsigned int i;
-	int rc;
-	uint8_t *objptr;
+	struct bucket_stack *cur_stack = bd->buckets[rte_lcore_id()];
+	unsigned int n_cur = RTE_MIN(n_orphans, cur_stack->cur_left);
+	struct bucket_header *hdr;
 
-	rc = rte_ring_dequeue_bulk(bd->shared_orphan_ring, obj_table,
-				   n_orphans, NULL);
-	if (unlikely(rc != (int)n_orphans)) {
-		struct bucket_header *hdr;
+	if (likely(n_cur == n_orphans)) {
+		bucket_take_cur_objs(bd, cur_stack, obj_table, n_orphans);
+		return 0;
+	}
 
-		objptr = bucket_stack_pop(bd->buckets[rte_lcore_id()]);
-		hdr = (struct bucket_header *)objptr;
-
-		if (objptr == NULL) {
-			rc = rte_ring_dequeue(bd->shared_bucket_ring,
-					      (void **)&objptr);
-			if (rc != 0) {
-				rte_errno = ENOBUFS;
-				return -rte_errno;
-			}
-			hdr = (struct bucket_header *)objptr;
-			hdr->lcore_id = rte_lcore_id();
-		}
-		hdr->fill_cnt = 0;
-		bucket_fill_obj_table(bd, (void **)&objptr, obj_table,
-				      n_orphans);
-		for (i = n_orphans; i < bd->obj_per_bucket; i++,
-			     objptr += bd->total_elt_size) {
-			rc = rte_ring_enqueue(bd->shared_orphan_ring,
-					      objptr);
-			if (rc != 0) {
-				RTE_ASSERT(0);
-				rte_errno = -rc;
-				return rc;
-			}
+	/* Get the next bucket first, not to fail with objects taken */
+	hdr = bucket_stack_pop(cur_stack);
+	if (hdr == NULL) {
+		if (rte_ring_dequeue(bd->shared_bucket_ring,
+				     (void **)&hdr) != 0) {
+			rte_errno = ENOBUFS;
+			return -rte_errno;
 		}
+		hdr->lcore_id = rte_lcore_id();
 	}
 
+	obj_table = bucket_take_cur_objs(bd, cur_stack, obj_table, n_cur);
+	cur_stack->cur_obj = (uint8_t *)hdr + bd->header_size;
+	cur_stack->cur_left = bd->obj_per_bucket;
+	bucket_take_cur_objs(bd, cur_stack, obj_table, n_orphans - n_cur);
+
 	return 0;
 }
 
@@ -296,10 +304,10 @@ bucket_dequeue(struct rte_mempool *mp, void **obj_table, unsigned int n)
 	if (likely(n_buckets > 0)) {
 		rc = bucket_dequeue_buckets(bd, obj_table, n_buckets);
 		if (unlikely(rc != 0) && n_orphans > 0) {
-			rte_ring_enqueue_bulk(bd->shared_orphan_ring,
-					      obj_table + (n_buckets *
-							   bd->obj_per_bucket),
-					      n_orphans, NULL);
+			/* The orphans are accounted back in their bucket */
+			bucket_enqueue(mp, obj_table +
+				       (n_buckets * bd->obj_per_bucket),
+				       n_orphans);
 		}
 	}
 
@@ -313,34 +321,37 @@ bucket_dequeue_contig_blocks(struct rte_mempool *mp, void **first_obj_table,
 	struct bucket_data *bd = mp->pool_data;
 	const uint32_t header_size = bd->header_size;
 	struct bucket_stack *cur_stack = bd->buckets[rte_lcore_id()];
-	unsigned int n_buckets_from_stack = RTE_MIN(n, cur_stack->top);
+	unsigned int n_buckets_from_stack;
 	struct bucket_header *hdr;
 	void **first_objp = first_obj_table;
+	void **stack_objp;
 
 	bucket_adopt_orphans(bd);
 
-	n -= n_buckets_from_stack;
-	while (n_buckets_from_stack-- > 0) {
-		hdr = bucket_stack_pop_unsafe(cur_stack);
-		*first_objp++ = (uint8_t *)hdr + header_size;
-	}
-	if (n > 0) {
+	n_buckets_from_stack = RTE_MIN(n, cur_stack->top);
+	if (n > n_buckets_from_stack) {
+		/*
+		 * Check the shared ring before taking the local buckets,
+		 * so that failing leaves the local stack untouched.
+		 */
 		if (unlikely(rte_ring_dequeue_bulk(bd->shared_bucket_ring,
-						   first_objp, n, NULL) != n)) {
-			/* Return the already dequeued buckets */
-			while (first_objp-- != first_obj_table) {
-				bucket_stack_push(cur_stack,
-						  (uint8_t *)*first_objp -
-						  header_size);
-			}
+				first_objp + n_buckets_from_stack,
+				n - n_buckets_from_stack, NULL) == 0)) {
 			rte_errno = ENOBUFS;
 			return -rte_errno;
 		}
-		while (n-- > 0) {
-			hdr = (struct bucket_header *)*first_objp;
-			hdr->lcore_id = rte_lcore_id();
-			*first_objp++ = (uint8_t *)hdr + header_size;
-		}
+	}
+
+	/* Most recently returned buckets first, they are likely cached */
+	n -= n_buckets_from_stack;
+	cur_stack->top -= n_buckets_from_stack;
+	stack_objp = &cur_stack->objects[cur_stack->top + n_buckets_from_stack];
+	while (n_buckets_from_stack-- > 0)
+		*first_objp++ = (uint8_t *)*--stack_objp + header_size;
+	while (n-- > 0) {
+		hdr = (struct bucket_header *)*first_objp;
+		hdr->lcore_id = rte_lcore_id();
+		*first_objp++ = (uint8_t *)hdr + header_size;
 	}
 
 	return 0;
@@ -358,6 +369,7 @@ bucket_count_per_lcore(unsigned int lcore_id, void *arg)
 
 	bplc->count += bplc->bd->obj_per_bucket *
 		bplc->bd->buckets[lcore_id]->top;
+	bplc->count += bplc->bd->buckets[lcore_id]->cur_left;
 	bplc->count +=
 		rte_ring_count(bplc->bd->adoption_buffer_rings[lcore_id]);
 	return 0;
@@ -396,7 +408,6 @@ bucket_get_count(const struct rte_mempool *mp)
 	bplc.bd = mp->pool_data;
 	bplc.count = bplc.bd->obj_per_bucket *
 		rte_ring_count(bplc.bd->shared_bucket_ring);
-	bplc.count += rte_ring_count(bplc.bd->shared_orphan_ring);
 
 	rte_lcore_iterate(bucket_count_per_lcore, &bplc);
 	rte_mempool_mem_iter((struct rte_mempool *)(uintptr_t)mp,
@@ -498,20 +509,6 @@ bucket_alloc(struct rte_mempool *mp)
 		rg_flags |= RING_F_SP_ENQ;
 	if (mp->flags & RTE_MEMPOOL_F_SC_GET)
 		rg_flags |= RING_F_SC_DEQ;
-	rc = snprintf(rg_name, sizeof(rg_name),
-		      RTE_MEMPOOL_MZ_FORMAT ".0", mp->name);
-	if (rc < 0 || rc >= (int)sizeof(rg_name)) {
-		rc = -ENAMETOOLONG;
-		goto invalid_shared_orphan_ring;
-	}
-	bd->shared_orphan_ring =
-		rte_ring_create(rg_name, rte_align32pow2(mp->size + 1),
-				mp->socket_id, rg_flags);
-	if (bd->shared_orphan_ring == NULL) {
-		rc = -rte_errno;
-		goto cannot_create_shared_orphan_ring;
-	}
-
 	rc = snprintf(rg_name, sizeof(rg_name),
 		       RTE_MEMPOOL_MZ_FORMAT ".1", mp->name);
 	if (rc < 0 || rc >= (int)sizeof(rg_name)) {
@@ -534,9 +531,6 @@ bucket_alloc(struct rte_mempool *mp)
 
 cannot_create_shared_bucket_ring:
 invalid_shared_bucket_ring:
-	rte_ring_free(bd->shared_orphan_ring);
-cannot_create_shared_orphan_ring:
-invalid_shared_orphan_ring:
 	rte_lcore_callback_unregister(bd->lcore_callback_handle);
 no_mem_for_stacks:
 	rte_free(bd);
@@ -555,7 +549,6 @@ bucket_free(struct rte_mempool *mp)
 
 	rte_lcore_callback_unregister(bd->lcore_callback_handle);
 
-	rte_ring_free(bd->shared_orphan_ring);
 	rte_ring_free(bd->shared_bucket_ring);
 
 	rte_free(bd);
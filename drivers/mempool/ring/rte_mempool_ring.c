@@ -6,8 +6,24 @@
 #include <string.h>
 
 #include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_memory.h>
 #include <rte_ring.h>
+#include <rte_ring_peek_zc.h>
 #include <rte_mempool.h>
+#include <rte_ptr_compress.h>
+
+/*
+ * Ring storing objects as 32-bit offsets from a base address, shifted by
+ * the object alignment. The base is set by the first populate and all the
+ * objects must be within the compressed range from it.
+ */
+struct compressed_ring {
+	struct rte_ring *r;
+	void *base;          /* NULL until the first populate */
+	uint64_t range;      /* Bytes covered from base */
+	uint8_t shift;
+};
 
 static int
 common_ring_mp_enqueue(struct rte_mempool *mp, void * const *obj_table,
@@ -136,6 +152,152 @@ common_ring_free(struct rte_mempool *mp)
 	rte_ring_free(mp->pool_data);
 }
 
+/* compress straight into the ring slots, in one or two parts on wrap */
+static int
+compressed_ring_enqueue(struct rte_mempool *mp, void * const *obj_table,
+	unsigned int n)
+{
+	struct compressed_ring *cr = mp->pool_data;
+	struct rte_ring_zc_data zcd;
+
+	if (unlikely(n == 0))
+		return 0;
+
+	if (rte_ring_enqueue_zc_bulk_elem_start(cr->r, sizeof(uint32_t), n,
+			&zcd, NULL) == 0)
+		return -ENOBUFS;
+
+	rte_ptr_compress_32_shift(cr->base, obj_table, zcd.ptr1, zcd.n1,
+		cr->shift);
+	if (zcd.n1 != n)
+		rte_ptr_compress_32_shift(cr->base, obj_table + zcd.n1,
+			zcd.ptr2, n - zcd.n1, cr->shift);
+	rte_ring_enqueue_zc_elem_finish(cr->r, n);
+
+	return 0;
+}
+
+static int
+compressed_ring_dequeue(struct rte_mempool *mp, void **obj_table,
+	unsigned int n)
+{
+	struct compressed_ring *cr = mp->pool_data;
+	struct rte_ring_zc_data zcd;
+
+	if (unlikely(n == 0))
+		return 0;
+
+	if (rte_ring_dequeue_zc_bulk_elem_start(cr->r, sizeof(uint32_t), n,
+			&zcd, NULL) == 0)
+		return -ENOBUFS;
+
+	rte_ptr_decompress_32_shift(cr->base, zcd.ptr1, obj_table, zcd.n1,
+		cr->shift);
+	if (zcd.n1 != n)
+		rte_ptr_decompress_32_shift(cr->base, zcd.ptr2,
+			obj_table + zcd.n1, n - zcd.n1, cr->shift);
+	rte_ring_dequeue_zc_elem_finish(cr->r, n);
+
+	return 0;
+}
+
+static unsigned int
+compressed_ring_get_count(const struct rte_mempool *mp)
+{
+	const struct compressed_ring *cr = mp->pool_data;
+
+	return rte_ring_count(cr->r);
+}
+
+/* zero copy is supported by single thread and HTS rings */
+static int
+compressed_ring_alloc(struct rte_mempool *mp)
+{
+	uint32_t rg_flags = RING_F_MP_HTS_ENQ | RING_F_MC_HTS_DEQ;
+	char rg_name[RTE_RING_NAMESIZE];
+	struct compressed_ring *cr;
+	int ret;
+
+	ret = snprintf(rg_name, sizeof(rg_name),
+		RTE_MEMPOOL_MZ_FORMAT, mp->name);
+	if (ret < 0 || ret >= (int)sizeof(rg_name)) {
+		rte_errno = ENAMETOOLONG;
+		return -rte_errno;
+	}
+
+	cr = rte_zmalloc_socket("MEMPOOL_COMPRESSED_RING", sizeof(*cr), 0,
+		mp->socket_id);
+	if (cr == NULL)
+		return -ENOMEM;
+
+	if ((mp->flags & RTE_MEMPOOL_F_SP_PUT) &&
+	    (mp->flags & RTE_MEMPOOL_F_SC_GET))
+		rg_flags = RING_F_SP_ENQ | RING_F_SC_DEQ;
+
+	cr->r = rte_ring_create_elem(rg_name, sizeof(uint32_t),
+		rte_align32pow2(mp->size + 1), mp->socket_id, rg_flags);
+	if (cr->r == NULL) {
+		ret = -rte_errno;
+		rte_free(cr);
+		return ret;
+	}
+
+	cr->shift = RTE_PTR_COMPRESS_BIT_SHIFT_FROM_ALIGNMENT(
+		rte_mempool_get_obj_alignment(mp));
+	cr->range = UINT64_C(1) << (32 + cr->shift);
+	mp->pool_data = cr;
+
+	return 0;
+}
+
+/*
+ * The base is the memseg list of the first chunk if it fits in the
+ * compressed range, so that later chunks of the same hugepage region can
+ * be added, otherwise the first chunk itself.
+ */
+static int
+compressed_ring_populate(struct rte_mempool *mp, unsigned int max_objs,
+	void *vaddr, rte_iova_t iova, size_t len,
+	rte_mempool_populate_obj_cb_t *obj_cb, void *obj_cb_arg)
+{
+	struct compressed_ring *cr = mp->pool_data;
+	const struct rte_memseg_list *msl;
+
+	if (cr->base == NULL) {
+		msl = rte_mem_virt2memseg_list(vaddr);
+		if (msl != NULL && (uint64_t)msl->len <= cr->range)
+			cr->base = msl->base_va;
+		else
+			cr->base = RTE_PTR_ALIGN_FLOOR(vaddr,
+				(uintptr_t)1 << cr->shift);
+	}
+
+	if ((uintptr_t)vaddr < (uintptr_t)cr->base ||
+	    (uint64_t)RTE_PTR_DIFF(RTE_PTR_ADD(vaddr, len), cr->base) >
+			cr->range) {
+		RTE_MEMPOOL_LOG(ERR,
+			"Chunk %p-%p of %s out of the compressed range %p-%p",
+			vaddr, RTE_PTR_ADD(vaddr, len), mp->name, cr->base,
+			RTE_PTR_ADD(cr->base, cr->range));
+		return -ERANGE;
+	}
+
+	return rte_mempool_op_populate_helper(mp, 0, max_objs, vaddr, iova,
+		len, obj_cb, obj_cb_arg);
+}
+
+static void
+compressed_ring_free(struct rte_mempool *mp)
+{
+	struct compressed_ring *cr = mp->pool_data;
+
+	if (cr == NULL)
+		return;
+
+	rte_ring_free(cr->r);
+	rte_free(cr);
+}
+
 /*
  * The following 4 declarations of mempool ops structs address
  * the need for the backward compatible mempool handlers for
@@ -198,9 +360,26 @@ static const struct rte_mempool_ops ops_mt_hts = {
 	.get_count = common_ring_get_count,
 };
 
+/*
+ * ops for mempool with ring storing compressed object pointers, for pools
+ * within one memory region; the ring is in MT_HTS sync mode, or single
+ * thread for pools created with both RTE_MEMPOOL_F_SP_PUT and
+ * RTE_MEMPOOL_F_SC_GET
+ */
+static const struct rte_mempool_ops ops_c32 = {
+	.name = "ring_c32",
+	.alloc = compressed_ring_alloc,
+	.free = compressed_ring_free,
+	.enqueue = compressed_ring_enqueue,
+	.dequeue = compressed_ring_dequeue,
+	.get_count = compressed_ring_get_count,
+	.populate = compressed_ring_populate,
+};
+
 RTE_MEMPOOL_REGISTER_OPS(ops_mp_mc);
 RTE_MEMPOOL_REGISTER_OPS(ops_sp_sc);
 RTE_MEMPOOL_REGISTER_OPS(ops_mp_sc);
 RTE_MEMPOOL_REGISTER_OPS(ops_sp_mc);
 RTE_MEMPOOL_REGISTER_OPS(ops_mt_rts);
 RTE_MEMPOOL_REGISTER_OPS(ops_mt_hts);
+RTE_MEMPOOL_REGISTER_OPS(ops_c32);
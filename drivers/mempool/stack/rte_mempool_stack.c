@@ -3,9 +3,19 @@
  */
 
 #include <stdio.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
 #include <rte_mempool.h>
 #include <rte_stack.h>
 
+/* Lock-free stacks of a mempool, one per NUMA socket. */
+struct numa_stacks {
+	unsigned int nb_stacks;
+	/* index of the stack of each socket id */
+	unsigned int socket_idx[RTE_MAX_NUMA_NODES];
+	struct rte_stack *stacks[RTE_MAX_NUMA_NODES];
+};
+
 static int
 __stack_alloc(struct rte_mempool *mp, uint32_t flags)
 {
@@ -75,6 +85,138 @@ stack_free(struct rte_mempool *mp)
 	rte_stack_free(s);
 }
 
+static void
+numa_stack_free(struct rte_mempool *mp)
+{
+	struct numa_stacks *ns = mp->pool_data;
+	unsigned int i;
+
+	for (i = 0; i < ns->nb_stacks; i++)
+		rte_stack_free(ns->stacks[i]);
+	rte_free(ns);
+}
+
+static int
+numa_stack_alloc(struct rte_mempool *mp)
+{
+	char name[RTE_STACK_NAMESIZE];
+	struct numa_stacks *ns;
+	unsigned int i;
+	int socket_id;
+	int ret;
+
+	ns = rte_zmalloc_socket("numa_stacks", sizeof(*ns), 0, mp->socket_id);
+	if (ns == NULL) {
+		rte_errno = ENOMEM;
+		return -rte_errno;
+	}
+	mp->pool_data = ns;
+
+	/*
+	 * Objects are pushed on the stack of the freeing lcore socket,
+	 * so each stack must be able to hold all the objects.
+	 */
+	for (i = 0; i < rte_socket_count(); i++) {
+		socket_id = rte_socket_id_by_idx(i);
+
+		ret = snprintf(name, sizeof(name),
+			       RTE_MEMPOOL_MZ_FORMAT "_%u", mp->name, i);
+		if (ret < 0 || ret >= (int)sizeof(name)) {
+			rte_errno = ENAMETOOLONG;
+			goto fail;
+		}
+
+		ns->stacks[i] = rte_stack_create(name, mp->size, socket_id,
+						 RTE_STACK_F_LF);
+		if (ns->stacks[i] == NULL)
+			goto fail;
+		ns->socket_idx[socket_id] = i;
+		ns->nb_stacks++;
+	}
+
+	return 0;
+
+fail:
+	ret = -rte_errno;
+	numa_stack_free(mp);
+	mp->pool_data = NULL;
+	return ret;
+}
+
+/* Index of the stack of the calling lcore socket. */
+static inline unsigned int
+numa_stack_local(const struct numa_stacks *ns)
+{
+	unsigned int socket_id = rte_socket_id();
+
+	/* non-EAL threads have no socket, use the first stack */
+	if (socket_id >= RTE_MAX_NUMA_NODES)
+		return 0;
+
+	return ns->socket_idx[socket_id];
+}
+
+static int
+numa_stack_enqueue(struct rte_mempool *mp, void * const *obj_table,
+		   unsigned int n)
+{
+	struct numa_stacks *ns = mp->pool_data;
+	struct rte_stack *s = ns->stacks[numa_stack_local(ns)];
+
+	return rte_stack_push(s, obj_table, n) == 0 ? -ENOBUFS : 0;
+}
+
+static int
+numa_stack_dequeue(struct rte_mempool *mp, void **obj_table,
+		   unsigned int n)
+{
+	struct numa_stacks *ns = mp->pool_data;
+	unsigned int local, idx, i, avail, got;
+	struct rte_stack *s;
+
+	/* fast path: all the objects from the local stack, in one pop */
+	local = numa_stack_local(ns);
+	if (likely(rte_stack_pop(ns->stacks[local], obj_table, n) != 0))
+		return 0;
+
+	/*
+	 * Take what the local stack has left, then steal from the stacks
+	 * of the other sockets, in order.
+	 */
+	got = 0;
+	for (i = 0; i < ns->nb_stacks && got < n; i++) {
+		idx = local + i;
+		if (idx >= ns->nb_stacks)
+			idx -= ns->nb_stacks;
+		s = ns->stacks[idx];
+
+		avail = RTE_MIN(rte_stack_count(s), n - got);
+		if (avail != 0)
+			got += rte_stack_pop(s, &obj_table[got], avail);
+	}
+
+	if (unlikely(got < n)) {
+		/* all or nothing: give back the objects to the local stack */
+		if (got != 0)
+			rte_stack_push(ns->stacks[local], obj_table, got);
+		return -ENOBUFS;
+	}
+
+	return 0;
+}
+
+static unsigned
+numa_stack_get_count(const struct rte_mempool *mp)
+{
+	const struct numa_stacks *ns = mp->pool_data;
+	unsigned int i, count = 0;
+
+	for (i = 0; i < ns->nb_stacks; i++)
+		count += rte_stack_count(ns->stacks[i]);
+
+	return count;
+}
+
 static struct rte_mempool_ops ops_stack = {
 	.name = "stack",
 	.alloc = stack_alloc,
@@ -93,5 +235,15 @@ static struct rte_mempool_ops ops_lf_stack = {
 	.get_count = stack_get_count
 };
 
+static struct rte_mempool_ops ops_lf_stack_numa = {
+	.name = "lf_stack_numa",
+	.alloc = numa_stack_alloc,
+	.free = numa_stack_free,
+	.enqueue = numa_stack_enqueue,
+	.dequeue = numa_stack_dequeue,
+	.get_count = numa_stack_get_count
+};
+
 RTE_MEMPOOL_REGISTER_OPS(ops_stack);
 RTE_MEMPOOL_REGISTER_OPS(ops_lf_stack);
+RTE_MEMPOOL_REGISTER_OPS(ops_lf_stack_numa);
@@ -7,6 +7,7 @@
  */
 
 #include <rte_common.h>
+#include <rte_stdatomic.h>
 #include <rte_string_fns.h>
 #include <rte_mbuf.h>
 #include <ethdev_driver.h>
@@ -37,25 +38,44 @@
 #define ETH_AF_PACKET_FRAMECOUNT_ARG	"framecnt"
 #define ETH_AF_PACKET_QDISC_BYPASS_ARG	"qdisc_bypass"
 #define ETH_AF_PACKET_FANOUT_MODE_ARG	"fanout_mode"
+#define ETH_AF_PACKET_TPACKET_V3_ARG	"tpacket_v3"
+#define ETH_AF_PACKET_RX_ZERO_COPY_ARG	"rx_zero_copy"
 
 #define DFLT_FRAME_SIZE		(1 << 11)
 #define DFLT_FRAME_COUNT	(1 << 9)
+/* TPACKET_V3 Rx block retire timeout, in milliseconds */
+#define DFLT_BLOCK_TIMEOUT	1
 
 static uint64_t timestamp_dynflag;
 static int timestamp_dynfield_offset = -1;
 
+/* TPACKET_V3 Rx block, attached to the mbufs in zero-copy mode */
+struct pkt_rx_block {
+	struct rte_mbuf_ext_shared_info shinfo;
+	struct tpacket_block_desc *pbd;
+	/* set while mbufs are attached to the block */
+	RTE_ATOMIC(uint32_t) held;
+};
+
 struct __rte_cache_aligned pkt_rx_queue {
 	int sockfd;
 
+	/* frames with TPACKET_V2, blocks with TPACKET_V3 */
 	struct iovec *rd;
 	uint8_t *map;
 	unsigned int framecount;
 	unsigned int framenum;
 
+	/* TPACKET_V3: next packet of the current block, NULL if none */
+	struct tpacket3_hdr *ppd;
+	unsigned int blk_pkts;
+	struct pkt_rx_block *blocks;
+
 	struct rte_mempool *mb_pool;
 	uint16_t in_port;
 	uint8_t vlan_strip;
 	uint8_t timestamp_offloading;
+	uint8_t zero_copy;
 
 	volatile unsigned long rx_pkts;
 	volatile unsigned long rx_bytes;
@@ -84,12 +104,14 @@ struct pmd_internals {
 	char *if_name;
 	struct rte_ether_addr eth_addr;
 
-	struct tpacket_req req;
+	struct tpacket_req3 req;
 
 	struct pkt_rx_queue *rx_queue;
 	struct pkt_tx_queue *tx_queue;
 	uint8_t vlan_strip;
 	uint8_t timestamp_offloading;
+	uint8_t tpacket_v3;
+	uint8_t rx_zero_copy;
 };
 
 static const char *valid_arguments[] = {
@@ -100,6 +122,8 @@ static const char *valid_arguments[] = {
 	ETH_AF_PACKET_FRAMECOUNT_ARG,
 	ETH_AF_PACKET_QDISC_BYPASS_ARG,
 	ETH_AF_PACKET_FANOUT_MODE_ARG,
+	ETH_AF_PACKET_TPACKET_V3_ARG,
+	ETH_AF_PACKET_RX_ZERO_COPY_ARG,
 	NULL
 };
 
@@ -120,6 +144,13 @@ RTE_LOG_REGISTER_DEFAULT(af_packet_logtype, NOTICE);
 	RTE_LOG_LINE(level, AFPACKET, "%s(): " fmt ":%s", __func__, \
 		## __VA_ARGS__, strerror(errno))
 
+/* Size of the frame header, before the packet data */
+static inline unsigned int
+tpacket_hdrlen(const struct pmd_internals *internals)
+{
+	return internals->tpacket_v3 ? TPACKET3_HDRLEN : TPACKET2_HDRLEN;
+}
+
 static uint16_t
 eth_af_packet_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 {
@@ -195,6 +226,141 @@ eth_af_packet_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	return num_rx;
 }
 
+/*
+ * Give a TPACKET_V3 block back to the kernel.
+ * Called on the last free of the mbufs attached to the block.
+ */
+static void
+pkt_rx_block_release(void *addr __rte_unused, void *opaque)
+{
+	struct pkt_rx_block *blk = opaque;
+
+	rte_atomic_thread_fence(rte_memory_order_release);
+	blk->pbd->hdr.bh1.block_status = TP_STATUS_KERNEL;
+	rte_atomic_store_explicit(&blk->held, 0, rte_memory_order_release);
+}
+
+/*
+ * Receive from the TPACKET_V3 ring, a block of packets at a time.
+ * In zero-copy mode the packets are attached to the mbufs as external
+ * buffers, and the block is released when all of them are freed.
+ */
+static uint16_t
+eth_af_packet_rx_v3(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	struct pkt_rx_queue *pkt_q = queue;
+	struct tpacket_block_desc *pbd;
+	struct tpacket3_hdr *ppd;
+	struct pkt_rx_block *blk;
+	struct rte_mbuf *mbuf;
+	uint8_t *pbuf;
+	uint16_t num_rx = 0;
+	unsigned long num_rx_bytes = 0;
+	unsigned int blocknum = pkt_q->framenum;
+
+	if (unlikely(nb_pkts == 0))
+		return 0;
+
+	while (num_rx < nb_pkts) {
+		blk = &pkt_q->blocks[blocknum];
+		pbd = blk->pbd;
+
+		if (pkt_q->ppd == NULL) {
+			/* block still attached to mbufs of the previous turn */
+			if (rte_atomic_load_explicit(&blk->held,
+					rte_memory_order_acquire) != 0)
+				break;
+			if ((pbd->hdr.bh1.block_status & TP_STATUS_USER) == 0)
+				break;
+			rte_atomic_thread_fence(rte_memory_order_acquire);
+
+			pkt_q->ppd = (struct tpacket3_hdr *)((uint8_t *)pbd +
+					pbd->hdr.bh1.offset_to_first_pkt);
+			pkt_q->blk_pkts = pbd->hdr.bh1.num_pkts;
+			if (pkt_q->zero_copy) {
+				/* the queue holds a reference until the end of the block */
+				rte_mbuf_ext_refcnt_set(&blk->shinfo, 1);
+				rte_atomic_store_explicit(&blk->held, 1,
+						rte_memory_order_relaxed);
+			}
+		}
+
+		ppd = pkt_q->ppd;
+		while (pkt_q->blk_pkts > 0 && num_rx < nb_pkts) {
+			/* allocate the next mbuf */
+			mbuf = rte_pktmbuf_alloc(pkt_q->mb_pool);
+			if (unlikely(mbuf == NULL)) {
+				pkt_q->rx_nombuf++;
+				pkt_q->ppd = ppd;
+				goto out;
+			}
+
+			pbuf = (uint8_t *)ppd + ppd->tp_mac;
+			if (pkt_q->zero_copy) {
+				rte_pktmbuf_attach_extbuf(mbuf, pbuf, RTE_BAD_IOVA,
+						ppd->tp_snaplen, &blk->shinfo);
+				rte_mbuf_ext_refcnt_update(&blk->shinfo, 1);
+			} else if (unlikely(ppd->tp_snaplen >
+					rte_pktmbuf_tailroom(mbuf))) {
+				/* packet does not fit in the mbuf */
+				rte_pktmbuf_free(mbuf);
+				pkt_q->rx_dropped_pkts++;
+				goto next;
+			} else {
+				memcpy(rte_pktmbuf_mtod(mbuf, void *), pbuf,
+						ppd->tp_snaplen);
+			}
+			rte_pktmbuf_pkt_len(mbuf) = rte_pktmbuf_data_len(mbuf) =
+				ppd->tp_snaplen;
+
+			/* check for vlan info */
+			if (ppd->tp_status & TP_STATUS_VLAN_VALID) {
+				mbuf->vlan_tci = ppd->hv1.tp_vlan_tci;
+				mbuf->ol_flags |= (RTE_MBUF_F_RX_VLAN | RTE_MBUF_F_RX_VLAN_STRIPPED);
+
+				if (!pkt_q->vlan_strip && rte_vlan_insert(&mbuf))
+					PMD_LOG(ERR, "Failed to reinsert VLAN tag");
+			}
+
+			/* add kernel provided timestamp when offloading is enabled */
+			if (pkt_q->timestamp_offloading) {
+				/* TPACKET_V3 timestamps are in nanoseconds resolution */
+				*RTE_MBUF_DYNFIELD(mbuf, timestamp_dynfield_offset,
+					rte_mbuf_timestamp_t *) =
+						(uint64_t)ppd->tp_sec * 1000000000 + ppd->tp_nsec;
+
+				mbuf->ol_flags |= timestamp_dynflag;
+			}
+			mbuf->port = pkt_q->in_port;
+
+			/* account for the receive frame */
+			bufs[num_rx++] = mbuf;
+			num_rx_bytes += mbuf->pkt_len;
+next:
+			ppd = (struct tpacket3_hdr *)((uint8_t *)ppd +
+					ppd->tp_next_offset);
+			pkt_q->blk_pkts--;
+		}
+		pkt_q->ppd = ppd;
+		if (pkt_q->blk_pkts > 0)
+			break;
+
+		/* release the block, or let the last mbuf free do it */
+		if (!pkt_q->zero_copy)
+			pkt_rx_block_release(NULL, blk);
+		else if (rte_mbuf_ext_refcnt_update(&blk->shinfo, -1) == 0)
+			pkt_rx_block_release(NULL, blk);
+		pkt_q->ppd = NULL;
+		if (++blocknum >= pkt_q->framecount)
+			blocknum = 0;
+	}
+out:
+	pkt_q->framenum = blocknum;
+	pkt_q->rx_pkts += num_rx;
+	pkt_q->rx_bytes += num_rx_bytes;
+	return num_rx;
+}
+
 /*
  * Check if there is an available frame in the ring
  */
@@ -215,13 +381,45 @@ tx_ring_status_available(uint32_t tp_status)
 	return tp_status == TP_STATUS_AVAILABLE;
 }
 
+/* Status of a Tx frame, for TPACKET_V2 or TPACKET_V3 */
+static __rte_always_inline uint32_t
+tx_frame_status(void *ppd, const bool v3)
+{
+	if (v3)
+		return ((struct tpacket3_hdr *)ppd)->tp_status;
+	return ((struct tpacket2_hdr *)ppd)->tp_status;
+}
+
+/* Request the send of a Tx frame of len bytes */
+static __rte_always_inline void
+tx_frame_send(void *ppd, uint32_t len, const bool v3)
+{
+	if (v3) {
+		struct tpacket3_hdr *ppd3 = ppd;
+
+		ppd3->tp_next_offset = 0;
+		ppd3->tp_len = len;
+		ppd3->tp_snaplen = len;
+		ppd3->tp_status = TP_STATUS_SEND_REQUEST;
+	} else {
+		struct tpacket2_hdr *ppd2 = ppd;
+
+		ppd2->tp_len = len;
+		ppd2->tp_snaplen = len;
+		ppd2->tp_status = TP_STATUS_SEND_REQUEST;
+	}
+}
+
 /*
  * Callback to handle sending packets through a real NIC.
  */
-static uint16_t
-eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+static __rte_always_inline uint16_t
+af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts,
+		const bool v3)
 {
-	struct tpacket2_hdr *ppd;
+	const unsigned int data_off = (v3 ? TPACKET3_HDRLEN : TPACKET2_HDRLEN) -
+		sizeof(struct sockaddr_ll);
+	void *ppd;
 	struct rte_mbuf *mbuf;
 	uint8_t *pbuf;
 	unsigned int framecount, framenum;
@@ -241,7 +439,7 @@ eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 
 	framecount = pkt_q->framecount;
 	framenum = pkt_q->framenum;
-	ppd = (struct tpacket2_hdr *) pkt_q->rd[framenum].iov_base;
+	ppd = pkt_q->rd[framenum].iov_base;
 	for (i = 0; i < nb_pkts; i++) {
 		mbuf = *bufs++;
 
@@ -260,7 +458,7 @@ eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		}
 
 		/* point at the next incoming frame */
-		if (!tx_ring_status_available(ppd->tp_status)) {
+		if (!tx_ring_status_available(tx_frame_status(ppd, v3))) {
 			if (poll(&pfd, 1, -1) < 0)
 				break;
 
@@ -283,12 +481,11 @@ eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		 *
 		 * This results in poll() returning POLLOUT.
 		 */
-		if (!tx_ring_status_available(ppd->tp_status))
+		if (!tx_ring_status_available(tx_frame_status(ppd, v3)))
 			break;
 
 		/* copy the tx frame data */
-		pbuf = (uint8_t *) ppd + TPACKET2_HDRLEN -
-			sizeof(struct sockaddr_ll);
+		pbuf = (uint8_t *) ppd + data_off;
 
 		struct rte_mbuf *tmp_mbuf = mbuf;
 		while (tmp_mbuf) {
@@ -298,14 +495,11 @@ eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 			tmp_mbuf = tmp_mbuf->next;
 		}
 
-		ppd->tp_len = mbuf->pkt_len;
-		ppd->tp_snaplen = mbuf->pkt_len;
-
 		/* release incoming frame and advance ring buffer */
-		ppd->tp_status = TP_STATUS_SEND_REQUEST;
+		tx_frame_send(ppd, mbuf->pkt_len, v3);
 		if (++framenum >= framecount)
 			framenum = 0;
-		ppd = (struct tpacket2_hdr *) pkt_q->rd[framenum].iov_base;
+		ppd = pkt_q->rd[framenum].iov_base;
 
 		num_tx++;
 		num_tx_bytes += mbuf->pkt_len;
@@ -332,6 +526,18 @@ eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	return i;
 }
 
+static uint16_t
+eth_af_packet_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	return af_packet_tx(queue, bufs, nb_pkts, false);
+}
+
+static uint16_t
+eth_af_packet_tx_v3(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	return af_packet_tx(queue, bufs, nb_pkts, true);
+}
+
 static int
 eth_dev_start(struct rte_eth_dev *dev)
 {
@@ -494,7 +700,7 @@ static int
 eth_dev_close(struct rte_eth_dev *dev)
 {
 	struct pmd_internals *internals;
-	struct tpacket_req *req;
+	struct tpacket_req3 *req;
 	unsigned int q;
 	int sockfd;
 
@@ -524,6 +730,7 @@ eth_dev_close(struct rte_eth_dev *dev)
 		munmap(internals->rx_queue[q].map,
 			2 * req->tp_block_size * req->tp_block_nr);
 		rte_free(internals->rx_queue[q].rd);
+		rte_free(internals->rx_queue[q].blocks);
 		rte_free(internals->tx_queue[q].rd);
 	}
 	rte_free(internals->if_name);
@@ -573,9 +780,10 @@ eth_rx_queue_setup(struct rte_eth_dev *dev,
 	buf_size = rte_pktmbuf_data_room_size(pkt_q->mb_pool) -
 		RTE_PKTMBUF_HEADROOM;
 	data_size = internals->req.tp_frame_size;
-	data_size -= TPACKET2_HDRLEN - sizeof(struct sockaddr_ll);
+	data_size -= tpacket_hdrlen(internals) - sizeof(struct sockaddr_ll);
 
-	if (data_size > buf_size) {
+	/* in zero-copy mode the data is not copied in the mbuf */
+	if (!internals->rx_zero_copy && data_size > buf_size) {
 		PMD_LOG(ERR,
 			"%s: %d bytes will not fit in mbuf (%d bytes)",
 			dev->device->name, data_size, buf_size);
@@ -586,6 +794,7 @@ eth_rx_queue_setup(struct rte_eth_dev *dev,
 	pkt_q->in_port = dev->data->port_id;
 	pkt_q->vlan_strip = internals->vlan_strip;
 	pkt_q->timestamp_offloading = internals->timestamp_offloading;
+	pkt_q->zero_copy = internals->rx_zero_copy;
 
 	return 0;
 }
@@ -612,7 +821,7 @@ eth_dev_mtu_set(struct rte_eth_dev *dev, uint16_t mtu)
 	int ret;
 	int s;
 	unsigned int data_size = internals->req.tp_frame_size -
-				 TPACKET2_HDRLEN;
+				 tpacket_hdrlen(internals);
 
 	if (mtu > data_size)
 		return -EINVAL;
@@ -794,6 +1003,8 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
                        unsigned int framecnt,
 		       unsigned int qdisc_bypass,
 		       const char *fanout_mode,
+		       unsigned int tpacket_v3,
+		       unsigned int rx_zero_copy,
                        struct pmd_internals **internals,
                        struct rte_eth_dev **eth_dev,
                        struct rte_kvargs *kvlist)
@@ -806,9 +1017,11 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 	size_t ifnamelen;
 	unsigned k_idx;
 	struct sockaddr_ll sockaddr;
-	struct tpacket_req *req;
+	struct tpacket_req3 *req;
 	struct pkt_rx_queue *rx_queue;
 	struct pkt_tx_queue *tx_queue;
+	struct tpacket_req3 tx_req;
+	socklen_t req_len;
 	int rc, tpver, discard;
 	int qsockfd = -1;
 	unsigned int i, q, rdsize;
@@ -862,6 +1075,17 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 	req->tp_frame_size = framesize;
 	req->tp_frame_nr = framecnt;
 
+	/* The Tx ring has no block timeout, even with TPACKET_V3 */
+	tx_req = *req;
+	if (tpacket_v3) {
+		req->tp_retire_blk_tov = DFLT_BLOCK_TIMEOUT;
+		req_len = sizeof(struct tpacket_req3);
+	} else {
+		req_len = sizeof(struct tpacket_req);
+	}
+	(*internals)->tpacket_v3 = tpacket_v3;
+	(*internals)->rx_zero_copy = rx_zero_copy;
+
 	ifnamelen = strlen(pair->value);
 	if (ifnamelen < sizeof(ifr.ifr_name)) {
 		memcpy(ifr.ifr_name, pair->value, ifnamelen);
@@ -909,7 +1133,7 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 			goto error;
 		}
 
-		tpver = TPACKET_V2;
+		tpver = tpacket_v3 ? TPACKET_V3 : TPACKET_V2;
 		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_VERSION,
 				&tpver, sizeof(tpver));
 		if (rc == -1) {
@@ -942,7 +1166,7 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 #endif
 		}
 
-		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_RX_RING, req, sizeof(*req));
+		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_RX_RING, req, req_len);
 		if (rc == -1) {
 			PMD_LOG_ERRNO(ERR,
 				"%s: could not set PACKET_RX_RING on AF_PACKET socket for %s",
@@ -950,7 +1174,7 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 			goto error;
 		}
 
-		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_TX_RING, req, sizeof(*req));
+		rc = setsockopt(qsockfd, SOL_PACKET, PACKET_TX_RING, &tx_req, req_len);
 		if (rc == -1) {
 			PMD_LOG_ERRNO(ERR,
 				"%s: could not set PACKET_TX_RING on AF_PACKET "
@@ -977,16 +1201,33 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 		rx_queue->rd = rte_zmalloc_socket(name, rdsize, 0, numa_node);
 		if (rx_queue->rd == NULL)
 			goto error;
-		for (i = 0; i < req->tp_frame_nr; ++i) {
-			rx_queue->rd[i].iov_base = rx_queue->map + (i * framesize);
-			rx_queue->rd[i].iov_len = req->tp_frame_size;
+		if (tpacket_v3) {
+			/* The TPACKET_V3 Rx ring is read a block at a time */
+			rx_queue->framecount = req->tp_block_nr;
+			rx_queue->blocks = rte_zmalloc_socket(name,
+					req->tp_block_nr * sizeof(*rx_queue->blocks),
+					0, numa_node);
+			if (rx_queue->blocks == NULL)
+				goto error;
+			for (i = 0; i < req->tp_block_nr; ++i) {
+				rx_queue->rd[i].iov_base = rx_queue->map + (i * blocksize);
+				rx_queue->rd[i].iov_len = req->tp_block_size;
+				rx_queue->blocks[i].pbd = rx_queue->rd[i].iov_base;
+				rx_queue->blocks[i].shinfo.free_cb = pkt_rx_block_release;
+				rx_queue->blocks[i].shinfo.fcb_opaque = &rx_queue->blocks[i];
+			}
+		} else {
+			for (i = 0; i < req->tp_frame_nr; ++i) {
+				rx_queue->rd[i].iov_base = rx_queue->map + (i * framesize);
+				rx_queue->rd[i].iov_len = req->tp_frame_size;
+			}
 		}
 		rx_queue->sockfd = qsockfd;
 
 		tx_queue = &((*internals)->tx_queue[q]);
 		tx_queue->framecount = req->tp_frame_nr;
 		tx_queue->frame_data_size = req->tp_frame_size;
-		tx_queue->frame_data_size -= TPACKET2_HDRLEN -
+		tx_queue->frame_data_size -= tpacket_hdrlen(*internals) -
 			sizeof(struct sockaddr_ll);
 
 		tx_queue->map = rx_queue->map + req->tp_block_size * req->tp_block_nr;
@@ -1057,6 +1298,7 @@ rte_pmd_init_internals(struct rte_vdev_device *dev,
 			       2 * req->tp_block_size * req->tp_block_nr);
 
 		rte_free((*internals)->rx_queue[q].rd);
+		rte_free((*internals)->rx_queue[q].blocks);
 		rte_free((*internals)->tx_queue[q].rd);
 		if (((*internals)->rx_queue[q].sockfd >= 0) &&
 			((*internals)->rx_queue[q].sockfd != qsockfd))
@@ -1087,6 +1329,8 @@ rte_eth_from_packet(struct rte_vdev_device *dev,
 	unsigned int qpairs = 1;
 	unsigned int qdisc_bypass = 1;
 	const char *fanout_mode = NULL;
+	unsigned int tpacket_v3 = 0;
+	unsigned int rx_zero_copy = 0;
 
 	/* do some parameter checking */
 	if (*sockfd < 0)
@@ -1153,8 +1397,32 @@ rte_eth_from_packet(struct rte_vdev_device *dev,
 			fanout_mode = pair->value;
 			continue;
 		}
+		if (strstr(pair->key, ETH_AF_PACKET_TPACKET_V3_ARG) != NULL) {
+			tpacket_v3 = atoi(pair->value);
+			if (tpacket_v3 > 1) {
+				PMD_LOG(ERR,
+					"%s: invalid tpacket_v3 value",
+					name);
+				return -1;
+			}
+			continue;
+		}
+		if (strstr(pair->key, ETH_AF_PACKET_RX_ZERO_COPY_ARG) != NULL) {
+			rx_zero_copy = atoi(pair->value);
+			if (rx_zero_copy > 1) {
+				PMD_LOG(ERR,
+					"%s: invalid rx_zero_copy value",
+					name);
+				return -1;
+			}
+			continue;
+		}
 	}
 
+	/* Zero-copy needs the TPACKET_V3 blocks */
+	if (rx_zero_copy)
+		tpacket_v3 = 1;
+
 	if (framesize > blocksize) {
 		PMD_LOG(ERR,
 			"%s: AF_PACKET MMAP frame size exceeds block size!",
@@ -1175,6 +1443,8 @@ rte_eth_from_packet(struct rte_vdev_device *dev,
 	PMD_LOG(DEBUG, "%s:\tframe size %d", name, framesize);
 	PMD_LOG(DEBUG, "%s:\tframe count %d", name, framecount);
 	PMD_LOG(DEBUG, "%s:\tqdisc bypass %d", name, qdisc_bypass);
+	PMD_LOG(DEBUG, "%s:\ttpacket v3 %d", name, tpacket_v3);
+	PMD_LOG(DEBUG, "%s:\trx zero-copy %d", name, rx_zero_copy);
 	if (fanout_mode)
 		PMD_LOG(DEBUG, "%s:\tfanout mode %s", name, fanout_mode);
 	else
@@ -1185,12 +1455,19 @@ rte_eth_from_packet(struct rte_vdev_device *dev,
 				   framesize, framecount,
 				   qdisc_bypass,
 				   fanout_mode,
+				   tpacket_v3,
+				   rx_zero_copy,
 				   &internals, &eth_dev,
 				   kvlist) < 0)
 		return -1;
 
-	eth_dev->rx_pkt_burst = eth_af_packet_rx;
-	eth_dev->tx_pkt_burst = eth_af_packet_tx;
+	if (tpacket_v3) {
+		eth_dev->rx_pkt_burst = eth_af_packet_rx_v3;
+		eth_dev->tx_pkt_burst = eth_af_packet_tx_v3;
+	} else {
+		eth_dev->rx_pkt_burst = eth_af_packet_rx;
+		eth_dev->tx_pkt_burst = eth_af_packet_tx;
+	}
 
 	rte_eth_dev_probing_finish(eth_dev);
 	return 0;
@@ -1282,4 +1559,6 @@ RTE_PMD_REGISTER_PARAM_STRING(net_af_packet,
 	"framesz=<int> "
 	"framecnt=<int> "
 	"qdisc_bypass=<0|1> "
-	"fanout_mode=<hash|lb|cpu|rollover|rnd|qm>");
+	"fanout_mode=<hash|lb|cpu|rollover|rnd|qm> "
+	"tpacket_v3=<0|1> "
+	"rx_zero_copy=<0|1>");
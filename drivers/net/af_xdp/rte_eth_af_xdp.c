@@ -75,12 +75,18 @@ RTE_LOG_REGISTER_DEFAULT(af_xdp_logtype, NOTICE);
 #define ETH_AF_XDP_DFLT_QUEUE_COUNT	1
 #define ETH_AF_XDP_DFLT_BUSY_BUDGET	64
 #define ETH_AF_XDP_DFLT_BUSY_TIMEOUT	20
+/* Pending Tx descriptors above which a lazy kick is never skipped */
+#define ETH_AF_XDP_TX_LAZY_KICK_THRESH	256
 
 #define ETH_AF_XDP_RX_BATCH_SIZE	XSK_RING_CONS__DEFAULT_NUM_DESCS
 #define ETH_AF_XDP_TX_BATCH_SIZE	XSK_RING_CONS__DEFAULT_NUM_DESCS
 
 #define ETH_AF_XDP_ETH_OVERHEAD		(RTE_ETHER_HDR_LEN + RTE_ETHER_CRC_LEN)
 
+/* Frags of a multi-buffer packet accepted by the kernel (MAX_SKB_FRAGS + 1) */
+#define ETH_AF_XDP_TX_MAX_SEGS		18
+#define ETH_AF_XDP_MAX_RX_PKTLEN	RTE_ETHER_MAX_JUMBO_FRAME_LEN
+
 #define ETH_AF_XDP_MP_KEY "afxdp_mp_send_fds"
 
 #define DP_BASE_PATH			"/tmp/afxdp_dp"
@@ -125,6 +131,7 @@ struct xsk_umem_info {
 struct rx_stats {
 	uint64_t rx_pkts;
 	uint64_t rx_bytes;
+	uint64_t rx_wakeups;
 	uint64_t imissed_offset;
 };
 
@@ -144,12 +151,20 @@ struct pkt_rx_queue {
 	struct pollfd fds[1];
 	int xsk_queue_idx;
 	int busy_budget;
+	int busy_timeout;
+
+	/* multi-buffer packets, XDP_USE_SG */
+	bool sg;
+	struct rte_mbuf *pkt_first_seg;
+	struct rte_mbuf *pkt_last_seg;
 };
 
 struct tx_stats {
 	uint64_t tx_pkts;
 	uint64_t tx_bytes;
 	uint64_t tx_dropped;
+	uint64_t tx_kicks;
+	uint64_t tx_kicks_skipped;
 };
 
 struct pkt_tx_queue {
@@ -160,6 +175,11 @@ struct pkt_tx_queue {
 
 	struct pkt_rx_queue *pair;
 	int xsk_queue_idx;
+	bool sg;
+
+	/* skip the kicks while the kernel consumes the Tx ring */
+	bool lazy_kick;
+	uint32_t kick_cons;
 };
 
 struct pmd_internals {
@@ -195,6 +215,8 @@ struct pmd_process_private {
 #define ETH_AF_XDP_SHARED_UMEM_ARG		"shared_umem"
 #define ETH_AF_XDP_PROG_ARG			"xdp_prog"
 #define ETH_AF_XDP_BUDGET_ARG			"busy_budget"
+#define ETH_AF_XDP_BUSY_TIMEOUT_ARG		"busy_timeout"
+#define ETH_AF_XDP_LAZY_KICK_ARG		"lazy_kick"
 #define ETH_AF_XDP_FORCE_COPY_ARG		"force_copy"
 #define ETH_AF_XDP_USE_CNI_ARG			"use_cni"
 #define ETH_AF_XDP_USE_PINNED_MAP_ARG	"use_pinned_map"
@@ -227,6 +249,8 @@ static const char * const valid_arguments[] = {
 	ETH_AF_XDP_SHARED_UMEM_ARG,
 	ETH_AF_XDP_PROG_ARG,
 	ETH_AF_XDP_BUDGET_ARG,
+	ETH_AF_XDP_BUSY_TIMEOUT_ARG,
+	ETH_AF_XDP_LAZY_KICK_ARG,
 	ETH_AF_XDP_FORCE_COPY_ARG,
 	ETH_AF_XDP_USE_CNI_ARG,
 	ETH_AF_XDP_USE_PINNED_MAP_ARG,
@@ -338,15 +362,18 @@ af_xdp_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	struct xsk_ring_cons *rx = &rxq->rx;
 	struct xsk_ring_prod *fq = &rxq->fq;
 	struct xsk_umem_info *umem = rxq->umem;
+	struct rte_mbuf *first_seg = rxq->pkt_first_seg;
+	struct rte_mbuf *last_seg = rxq->pkt_last_seg;
 	uint32_t idx_rx = 0;
 	unsigned long rx_bytes = 0;
+	uint16_t nb_desc, nb_rx = 0;
 	int i;
 	struct rte_mbuf *fq_bufs[ETH_AF_XDP_RX_BATCH_SIZE];
 	struct rte_eth_dev *dev = &rte_eth_devices[rxq->port];
 
-	nb_pkts = xsk_ring_cons__peek(rx, nb_pkts, &idx_rx);
+	nb_desc = xsk_ring_cons__peek(rx, nb_pkts, &idx_rx);
 
-	if (nb_pkts == 0) {
+	if (nb_desc == 0) {
 		/* we can assume a kernel >= 5.11 is in use if busy polling is
 		 * enabled and thus we can safely use the recvfrom() syscall
 		 * which is only supported for AF_XDP sockets in kernels >=
@@ -355,28 +382,31 @@ af_xdp_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		if (rxq->busy_budget) {
 			(void)recvfrom(xsk_socket__fd(rxq->xsk), NULL, 0,
 				       MSG_DONTWAIT, NULL, NULL);
+			rxq->stats.rx_wakeups++;
 		} else if (xsk_ring_prod__needs_wakeup(fq)) {
 			(void)poll(&rxq->fds[0], 1, 1000);
+			rxq->stats.rx_wakeups++;
 		}
 
 		return 0;
 	}
 
 	/* allocate bufs for fill queue replenishment after rx */
-	if (rte_pktmbuf_alloc_bulk(umem->mb_pool, fq_bufs, nb_pkts)) {
+	if (rte_pktmbuf_alloc_bulk(umem->mb_pool, fq_bufs, nb_desc)) {
 		AF_XDP_LOG_LINE(DEBUG,
 			"Failed to get enough buffers for fq.");
 		/* rollback cached_cons which is added by
 		 * xsk_ring_cons__peek
 		 */
-		rx->cached_cons -= nb_pkts;
-		dev->data->rx_mbuf_alloc_failed += nb_pkts;
+		rx->cached_cons -= nb_desc;
+		dev->data->rx_mbuf_alloc_failed += nb_desc;
 
 		return 0;
 	}
 
-	for (i = 0; i < nb_pkts; i++) {
+	for (i = 0; i < nb_desc; i++) {
 		const struct xdp_desc *desc;
+		struct rte_mbuf *mbuf;
 		uint64_t addr;
 		uint32_t len;
 		uint64_t offset;
@@ -388,27 +418,54 @@ af_xdp_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		offset = xsk_umem__extract_offset(addr);
 		addr = xsk_umem__extract_addr(addr);
 
-		bufs[i] = (struct rte_mbuf *)
+		mbuf = (struct rte_mbuf *)
 				xsk_umem__get_data(umem->buffer, addr +
 					umem->mb_pool->header_size);
-		bufs[i]->data_off = offset - sizeof(struct rte_mbuf) -
+		mbuf->data_off = offset - sizeof(struct rte_mbuf) -
 			rte_pktmbuf_priv_size(umem->mb_pool) -
 			umem->mb_pool->header_size;
-		bufs[i]->port = rxq->port;
+		mbuf->port = rxq->port;
 
-		rte_pktmbuf_pkt_len(bufs[i]) = len;
-		rte_pktmbuf_data_len(bufs[i]) = len;
+		rte_pktmbuf_pkt_len(mbuf) = len;
+		rte_pktmbuf_data_len(mbuf) = len;
 		rx_bytes += len;
+
+		if (!rxq->sg) {
+			bufs[nb_rx++] = mbuf;
+			continue;
+		}
+
+#if defined(ETH_AF_XDP_MULTI_BUF)
+		/* chain the frags until the last one of the packet */
+		if (first_seg == NULL) {
+			first_seg = mbuf;
+		} else {
+			first_seg->pkt_len += len;
+			first_seg->nb_segs++;
+			last_seg->next = mbuf;
+		}
+		last_seg = mbuf;
+
+		if (desc->options & XDP_PKT_CONTD)
+			continue;
+
+		bufs[nb_rx++] = first_seg;
+		first_seg = NULL;
+#endif
 	}
 
-	xsk_ring_cons__release(rx, nb_pkts);
-	(void)reserve_fill_queue(umem, nb_pkts, fq_bufs, fq);
+	xsk_ring_cons__release(rx, nb_desc);
+	(void)reserve_fill_queue(umem, nb_desc, fq_bufs, fq);
+
+	/* keep the partial packet for the next burst */
+	rxq->pkt_first_seg = first_seg;
+	rxq->pkt_last_seg = last_seg;
 
 	/* statistics */
-	rxq->stats.rx_pkts += nb_pkts;
+	rxq->stats.rx_pkts += nb_rx;
 	rxq->stats.rx_bytes += rx_bytes;
 
-	return nb_pkts;
+	return nb_rx;
 }
 #else
 static uint16_t
@@ -431,8 +488,10 @@ af_xdp_rx_cp(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	nb_pkts = xsk_ring_cons__peek(rx, nb_pkts, &idx_rx);
 	if (nb_pkts == 0) {
 #if defined(XDP_USE_NEED_WAKEUP)
-		if (xsk_ring_prod__needs_wakeup(fq))
+		if (xsk_ring_prod__needs_wakeup(fq)) {
 			(void)poll(rxq->fds, 1, 1000);
+			rxq->stats.rx_wakeups++;
+		}
 #endif
 		return 0;
 	}
@@ -525,7 +584,8 @@ pull_umem_cq(struct xsk_umem_info *umem, int size, struct xsk_ring_cons *cq)
 		addr = *xsk_ring_cons__comp_addr(cq, idx_cq++);
 #if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG)
 		addr = xsk_umem__extract_addr(addr);
-		rte_pktmbuf_free((struct rte_mbuf *)
+		/* one completion per segment of multi-buffer packets */
+		rte_pktmbuf_free_seg((struct rte_mbuf *)
 					xsk_umem__get_data(umem->buffer,
 					addr + umem->mb_pool->header_size));
 #else
@@ -536,41 +596,67 @@ pull_umem_cq(struct xsk_umem_info *umem, int size, struct xsk_ring_cons *cq)
 	xsk_ring_cons__release(cq, n);
 }
 
+/*
+ * Check whether the kernel is still consuming the Tx ring since the
+ * previous check, so that the descriptors just submitted are picked up
+ * without a syscall.
+ */
+static inline bool
+tx_kick_skippable(struct pkt_tx_queue *txq)
+{
+	struct xsk_ring_prod *tx = &txq->tx;
+	uint32_t pending, cons;
+	bool progress;
+
+	pending = tx->size - xsk_prod_nb_free(tx, tx->size);
+	if (pending == 0)
+		return true;
+
+	cons = tx->cached_cons - tx->size;
+	progress = cons != txq->kick_cons;
+	txq->kick_cons = cons;
+
+	return progress && pending < ETH_AF_XDP_TX_LAZY_KICK_THRESH;
+}
+
 static void
-kick_tx(struct pkt_tx_queue *txq, struct xsk_ring_cons *cq)
+kick_tx(struct pkt_tx_queue *txq, struct xsk_ring_cons *cq, bool lazy)
 {
 	struct xsk_umem_info *umem = txq->umem;
 
 	pull_umem_cq(umem, XSK_RING_CONS__DEFAULT_NUM_DESCS, cq);
 
-	if (tx_syscall_needed(&txq->tx))
-		while (send(xsk_socket__fd(txq->pair->xsk), NULL,
-			    0, MSG_DONTWAIT) < 0) {
-			/* some thing unexpected */
-			if (errno != EBUSY && errno != EAGAIN && errno != EINTR)
-				break;
-
-			/* pull from completion queue to leave more space */
-			if (errno == EAGAIN)
-				pull_umem_cq(umem,
-					     XSK_RING_CONS__DEFAULT_NUM_DESCS,
-					     cq);
-		}
+	if (!tx_syscall_needed(&txq->tx))
+		return;
+
+	if (lazy && txq->lazy_kick && tx_kick_skippable(txq)) {
+		txq->stats.tx_kicks_skipped++;
+		return;
+	}
+
+	txq->stats.tx_kicks++;
+	while (send(xsk_socket__fd(txq->pair->xsk), NULL,
+		    0, MSG_DONTWAIT) < 0) {
+		/* some thing unexpected */
+		if (errno != EBUSY && errno != EAGAIN && errno != EINTR)
+			break;
+
+		/* pull from completion queue to leave more space */
+		if (errno == EAGAIN)
+			pull_umem_cq(umem,
+				     XSK_RING_CONS__DEFAULT_NUM_DESCS,
+				     cq);
+	}
 }
 
-static inline struct xdp_desc *
-reserve_and_fill(struct pkt_tx_queue *txq, struct rte_mbuf *mbuf,
-		 struct xsk_umem_info *umem, void **pkt_ptr)
+static inline void
+fill_desc(struct xdp_desc *desc, struct rte_mbuf *mbuf,
+	  struct xsk_umem_info *umem, void **pkt_ptr)
 {
-	struct xdp_desc *desc = NULL;
 	uint64_t addr, offset;
-	uint32_t idx_tx;
-
-	if (!xsk_ring_prod__reserve(&txq->tx, 1, &idx_tx))
-		goto out;
 
-	desc = xsk_ring_prod__tx_desc(&txq->tx, idx_tx);
-	desc->len = mbuf->pkt_len;
+	desc->len = mbuf->data_len;
+	desc->options = 0;
 
 	addr = (uint64_t)mbuf - (uint64_t)umem->buffer
 		- umem->mb_pool->header_size;
@@ -582,11 +668,67 @@ reserve_and_fill(struct pkt_tx_queue *txq, struct rte_mbuf *mbuf,
 
 	offset = offset << XSK_UNALIGNED_BUF_OFFSET_SHIFT;
 	desc->addr = addr | offset;
+}
+
+static inline struct xdp_desc *
+reserve_and_fill(struct pkt_tx_queue *txq, struct rte_mbuf *mbuf,
+		 struct xsk_umem_info *umem, void **pkt_ptr)
+{
+	struct xdp_desc *desc = NULL;
+	uint32_t idx_tx;
+
+	if (!xsk_ring_prod__reserve(&txq->tx, 1, &idx_tx))
+		goto out;
+
+	desc = xsk_ring_prod__tx_desc(&txq->tx, idx_tx);
+	fill_desc(desc, mbuf, umem, pkt_ptr);
 
 out:
 	return desc;
 }
 
+#if defined(ETH_AF_XDP_MULTI_BUF)
+/* Check whether all the segments of a packet can be sent without copy. */
+static inline bool
+tx_zc_segs_ok(struct rte_mbuf *mbuf, struct xsk_umem_info *umem)
+{
+	if (mbuf->nb_segs > ETH_AF_XDP_TX_MAX_SEGS)
+		return false;
+
+	for (; mbuf != NULL; mbuf = mbuf->next)
+		if (!RTE_MBUF_DIRECT(mbuf) || mbuf->pool != umem->mb_pool)
+			return false;
+
+	return true;
+}
+
+/*
+ * Reserve one descriptor per segment of a multi-buffer packet.
+ * Return the number of descriptors filled, 0 if the Tx ring is full.
+ */
+static inline uint16_t
+reserve_and_fill_segs(struct pkt_tx_queue *txq, struct rte_mbuf *mbuf,
+		      struct xsk_umem_info *umem)
+{
+	uint16_t nb_segs = mbuf->nb_segs;
+	struct xdp_desc *desc;
+	uint32_t idx_tx;
+	uint16_t i;
+
+	if (xsk_ring_prod__reserve(&txq->tx, nb_segs, &idx_tx) != nb_segs)
+		return 0;
+
+	for (i = 0; i < nb_segs; i++, mbuf = mbuf->next) {
+		desc = xsk_ring_prod__tx_desc(&txq->tx, idx_tx + i);
+		fill_desc(desc, mbuf, umem, NULL);
+		if (i != nb_segs - 1)
+			desc->options = XDP_PKT_CONTD;
+	}
+
+	return nb_segs;
+}
+#endif
+
 #if defined(XDP_UMEM_UNALIGNED_CHUNK_FLAG)
 static uint16_t
 af_xdp_tx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
@@ -597,6 +739,8 @@ af_xdp_tx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	unsigned long tx_bytes = 0;
 	int i;
 	uint16_t count = 0;
+	uint16_t nb_desc = 0;
+	uint16_t oversized = 0;
 	struct xdp_desc *desc;
 	struct xsk_ring_cons *cq = &txq->pair->cq;
 	uint32_t free_thresh = cq->size >> 1;
@@ -608,22 +752,53 @@ af_xdp_tx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	for (i = 0; i < nb_pkts; i++) {
 		mbuf = bufs[i];
 
-		if (RTE_MBUF_DIRECT(mbuf) && mbuf->pool == umem->mb_pool) {
+#if defined(ETH_AF_XDP_MULTI_BUF)
+		if (mbuf->nb_segs > 1 && txq->sg && tx_zc_segs_ok(mbuf, umem)) {
+			uint16_t n = reserve_and_fill_segs(txq, mbuf, umem);
+
+			if (n == 0) {
+				kick_tx(txq, cq, false);
+				n = reserve_and_fill_segs(txq, mbuf, umem);
+				if (n == 0)
+					goto out;
+			}
+
+			tx_bytes += mbuf->pkt_len;
+			nb_desc += n;
+			count++;
+			continue;
+		}
+#endif
+
+		if (mbuf->nb_segs == 1 && RTE_MBUF_DIRECT(mbuf) &&
+		    mbuf->pool == umem->mb_pool) {
 			desc = reserve_and_fill(txq, mbuf, umem, NULL);
 			if (!desc) {
-				kick_tx(txq, cq);
+				kick_tx(txq, cq, false);
 				desc = reserve_and_fill(txq, mbuf, umem, NULL);
 				if (!desc)
 					goto out;
 			}
 
 			tx_bytes += desc->len;
+			nb_desc++;
 			count++;
 		} else {
+			const void *data;
+
 			local_mbuf = rte_pktmbuf_alloc(umem->mb_pool);
 			if (!local_mbuf)
 				goto out;
 
+			/* multi-segment packets are linearized in one frame */
+			if (mbuf->pkt_len > rte_pktmbuf_tailroom(local_mbuf)) {
+				rte_pktmbuf_free(local_mbuf);
+				rte_pktmbuf_free(mbuf);
+				oversized++;
+				count++;
+				continue;
+			}
+
 			desc = reserve_and_fill(txq, local_mbuf, umem, &pkt);
 			if (!desc) {
 				rte_pktmbuf_free(local_mbuf);
@@ -631,21 +806,23 @@ af_xdp_tx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 			}
 
 			desc->len = mbuf->pkt_len;
-			rte_memcpy(pkt, rte_pktmbuf_mtod(mbuf, void *),
-				   desc->len);
+			data = rte_pktmbuf_read(mbuf, 0, desc->len, pkt);
+			if (data != pkt)
+				rte_memcpy(pkt, data, desc->len);
 			rte_pktmbuf_free(mbuf);
 			tx_bytes += desc->len;
+			nb_desc++;
 			count++;
 		}
 	}
 
 out:
-	xsk_ring_prod__submit(&txq->tx, count);
-	kick_tx(txq, cq);
+	xsk_ring_prod__submit(&txq->tx, nb_desc);
+	kick_tx(txq, cq, true);
 
-	txq->stats.tx_pkts += count;
+	txq->stats.tx_pkts += count - oversized;
 	txq->stats.tx_bytes += tx_bytes;
-	txq->stats.tx_dropped += nb_pkts - count;
+	txq->stats.tx_dropped += nb_pkts - count + oversized;
 
 	return count;
 }
@@ -670,7 +847,7 @@ af_xdp_tx_cp(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		return 0;
 
 	if (xsk_ring_prod__reserve(&txq->tx, nb_pkts, &idx_tx) != nb_pkts) {
-		kick_tx(txq, cq);
+		kick_tx(txq, cq, false);
 		rte_ring_enqueue_bulk(umem->buf_ring, addrs, nb_pkts, NULL);
 		return 0;
 	}
@@ -693,7 +870,7 @@ af_xdp_tx_cp(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 
 	xsk_ring_prod__submit(&txq->tx, nb_pkts);
 
-	kick_tx(txq, cq);
+	kick_tx(txq, cq, true);
 
 	txq->stats.tx_pkts += nb_pkts;
 	txq->stats.tx_bytes += tx_bytes;
@@ -878,6 +1055,12 @@ eth_dev_info(struct rte_eth_dev *dev, struct rte_eth_dev_info *dev_info)
 				  RTE_PKTMBUF_HEADROOM - XDP_PACKET_HEADROOM;
 #else
 	dev_info->max_rx_pktlen = ETH_AF_XDP_FRAME_SIZE - XDP_PACKET_HEADROOM;
+#endif
+#if defined(ETH_AF_XDP_MULTI_BUF)
+	/* larger packets are received and sent as multiple buffers */
+	dev_info->max_rx_pktlen = ETH_AF_XDP_MAX_RX_PKTLEN;
+	dev_info->rx_offload_capa = RTE_ETH_RX_OFFLOAD_SCATTER;
+	dev_info->tx_offload_capa = RTE_ETH_TX_OFFLOAD_MULTI_SEGS;
 #endif
 	dev_info->max_mtu = dev_info->max_rx_pktlen - ETH_AF_XDP_ETH_OVERHEAD;
 
@@ -972,6 +1155,80 @@ eth_stats_reset(struct rte_eth_dev *dev)
 	return 0;
 }
 
+struct af_xdp_xstats_name_off {
+	char name[RTE_ETH_XSTATS_NAME_SIZE];
+	size_t offset;
+};
+
+static const struct af_xdp_xstats_name_off af_xdp_rxq_xstats[] = {
+	{"wakeups", offsetof(struct rx_stats, rx_wakeups)},
+};
+
+static const struct af_xdp_xstats_name_off af_xdp_txq_xstats[] = {
+	{"kicks", offsetof(struct tx_stats, tx_kicks)},
+	{"kicks_skipped", offsetof(struct tx_stats, tx_kicks_skipped)},
+};
+
+#define AF_XDP_NB_RXQ_XSTATS RTE_DIM(af_xdp_rxq_xstats)
+#define AF_XDP_NB_TXQ_XSTATS RTE_DIM(af_xdp_txq_xstats)
+
+static int
+eth_xstats_get_names(struct rte_eth_dev *dev,
+		     struct rte_eth_xstat_name *xstats_names,
+		     unsigned int size __rte_unused)
+{
+	unsigned int nb_queues = dev->data->nb_rx_queues;
+	unsigned int i, q, count = 0;
+
+	if (xstats_names == NULL)
+		return nb_queues * (AF_XDP_NB_RXQ_XSTATS + AF_XDP_NB_TXQ_XSTATS);
+
+	for (q = 0; q < nb_queues; q++) {
+		for (i = 0; i < AF_XDP_NB_RXQ_XSTATS; i++)
+			snprintf(xstats_names[count++].name,
+				 sizeof(xstats_names[0].name), "rx_q%u_%s",
+				 q, af_xdp_rxq_xstats[i].name);
+		for (i = 0; i < AF_XDP_NB_TXQ_XSTATS; i++)
+			snprintf(xstats_names[count++].name,
+				 sizeof(xstats_names[0].name), "tx_q%u_%s",
+				 q, af_xdp_txq_xstats[i].name);
+	}
+
+	return count;
+}
+
+static int
+eth_xstats_get(struct rte_eth_dev *dev, struct rte_eth_xstat *xstats,
+	       unsigned int n)
+{
+	struct pmd_internals *internals = dev->data->dev_private;
+	unsigned int nb_queues = dev->data->nb_rx_queues;
+	unsigned int nb_xstats;
+	unsigned int i, q, count = 0;
+
+	nb_xstats = nb_queues * (AF_XDP_NB_RXQ_XSTATS + AF_XDP_NB_TXQ_XSTATS);
+	if (n < nb_xstats)
+		return nb_xstats;
+
+	for (q = 0; q < nb_queues; q++) {
+		const char *rx = (const char *)&internals->rx_queues[q].stats;
+		const char *tx = (const char *)&internals->tx_queues[q].stats;
+
+		for (i = 0; i < AF_XDP_NB_RXQ_XSTATS; i++) {
+			xstats[count].id = count;
+			xstats[count++].value = *(const uint64_t *)
+				(rx + af_xdp_rxq_xstats[i].offset);
+		}
+		for (i = 0; i < AF_XDP_NB_TXQ_XSTATS; i++) {
+			xstats[count].id = count;
+			xstats[count++].value = *(const uint64_t *)
+				(tx + af_xdp_txq_xstats[i].offset);
+		}
+	}
+
+	return count;
+}
+
 #ifdef RTE_NET_AF_XDP_LIBBPF_XDP_ATTACH
 
 static int link_xdp_prog_with_dev(int ifindex, int fd, __u32 flags)
@@ -1064,6 +1321,7 @@ eth_dev_close(struct rte_eth_dev *dev)
 		rxq = &internals->rx_queues[i];
 		if (rxq->umem == NULL)
 			break;
+		rte_pktmbuf_free(rxq->pkt_first_seg);
 		xsk_socket__delete(rxq->xsk);
 
 		if (rte_atomic_fetch_sub_explicit(&rxq->umem->refcnt, 1,
@@ -1391,7 +1649,7 @@ configure_preferred_busy_poll(struct pkt_rx_queue *rxq)
 		goto err_prefer;
 	}
 
-	sock_opt = ETH_AF_XDP_DFLT_BUSY_TIMEOUT;
+	sock_opt = rxq->busy_timeout;
 	ret = setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, (void *)&sock_opt,
 			sizeof(sock_opt));
 	if (ret < 0) {
@@ -1405,8 +1663,8 @@ configure_preferred_busy_poll(struct pkt_rx_queue *rxq)
 	if (ret < 0) {
 		AF_XDP_LOG_LINE(DEBUG, "Failed to set SO_BUSY_POLL_BUDGET");
 	} else {
-		AF_XDP_LOG_LINE(INFO, "Busy polling budget set to: %u",
-					rxq->busy_budget);
+		AF_XDP_LOG_LINE(INFO, "Busy polling budget set to: %u, timeout: %u us",
+					rxq->busy_budget, rxq->busy_timeout);
 		return 0;
 	}
 
@@ -1725,6 +1983,11 @@ xsk_configure(struct pmd_internals *internals, struct pkt_rx_queue *rxq,
 	cfg.bind_flags |= XDP_USE_NEED_WAKEUP;
 #endif
 
+#if defined(ETH_AF_XDP_MULTI_BUF)
+	if (rxq->sg)
+		cfg.bind_flags |= XDP_USE_SG;
+#endif
+
 	/* Disable libbpf from loading XDP program */
 	if (internals->use_cni || internals->use_pinned_map)
 		cfg.libbpf_flags |= XSK_LIBBPF_FLAGS__INHIBIT_PROG_LOAD;
@@ -1860,6 +2123,15 @@ eth_rx_queue_setup(struct rte_eth_dev *dev,
 
 	rxq->mb_pool = mb_pool;
 
+#if defined(ETH_AF_XDP_MULTI_BUF)
+	/* both directions share the socket, bound once with XDP_USE_SG */
+	rxq->sg = (dev->data->dev_conf.rxmode.offloads &
+			RTE_ETH_RX_OFFLOAD_SCATTER) ||
+		  (dev->data->dev_conf.txmode.offloads &
+			RTE_ETH_TX_OFFLOAD_MULTI_SEGS);
+	rxq->pair->sg = rxq->sg;
+#endif
+
 	if (xsk_configure(internals, rxq, nb_rx_desc)) {
 		AF_XDP_LOG_LINE(ERR, "Failed to configure xdp socket");
 		ret = -EINVAL;
@@ -1975,6 +2247,8 @@ static const struct eth_dev_ops ops = {
 	.link_update = eth_link_update,
 	.stats_get = eth_stats_get,
 	.stats_reset = eth_stats_reset,
+	.xstats_get = eth_xstats_get,
+	.xstats_get_names = eth_xstats_get_names,
 	.get_monitor_addr = eth_get_monitor_addr,
 };
 
@@ -1996,6 +2270,8 @@ static const struct eth_dev_ops ops_afxdp_dp = {
 	.link_update = eth_link_update,
 	.stats_get = eth_stats_get,
 	.stats_reset = eth_stats_reset,
+	.xstats_get = eth_xstats_get,
+	.xstats_get_names = eth_xstats_get_names,
 	.get_monitor_addr = eth_get_monitor_addr,
 };
 
@@ -2147,7 +2423,8 @@ xdp_get_channels_info(const char *if_name, int *max_queues,
 static int
 parse_parameters(struct rte_kvargs *kvlist, char *if_name, int *start_queue,
 		 int *queue_cnt, int *shared_umem, char *prog_path,
-		 int *busy_budget, int *force_copy, int *use_cni,
+		 int *busy_budget, int *busy_timeout, int *lazy_kick,
+		 int *force_copy, int *use_cni,
 		 int *use_pinned_map, char *dp_path, uint32_t *xdp_mode)
 {
 	int ret;
@@ -2184,6 +2461,16 @@ parse_parameters(struct rte_kvargs *kvlist, char *if_name, int *start_queue,
 	if (ret < 0)
 		goto free_kvlist;
 
+	ret = rte_kvargs_process(kvlist, ETH_AF_XDP_BUSY_TIMEOUT_ARG,
+				&parse_integer_arg, busy_timeout);
+	if (ret < 0)
+		goto free_kvlist;
+
+	ret = rte_kvargs_process(kvlist, ETH_AF_XDP_LAZY_KICK_ARG,
+				&parse_integer_arg, lazy_kick);
+	if (ret < 0)
+		goto free_kvlist;
+
 	ret = rte_kvargs_process(kvlist, ETH_AF_XDP_FORCE_COPY_ARG,
 				&parse_integer_arg, force_copy);
 	if (ret < 0)
@@ -2249,8 +2536,9 @@ get_iface_info(const char *if_name,
 static struct rte_eth_dev *
 init_internals(struct rte_vdev_device *dev, const char *if_name,
 	       int start_queue_idx, int queue_cnt, int shared_umem,
-	       const char *prog_path, int busy_budget, int force_copy,
-	       int use_cni, int use_pinned_map, const char *dp_path, uint32_t xdp_mode)
+	       const char *prog_path, int busy_budget, int busy_timeout,
+	       int lazy_kick, int force_copy, int use_cni, int use_pinned_map,
+	       const char *dp_path, uint32_t xdp_mode)
 {
 	const char *name = rte_vdev_device_name(dev);
 	const unsigned int numa_node = dev->device.numa_node;
@@ -2318,6 +2606,8 @@ init_internals(struct rte_vdev_device *dev, const char *if_name,
 		internals->rx_queues[i].xsk_queue_idx = start_queue_idx + i;
 		internals->tx_queues[i].xsk_queue_idx = start_queue_idx + i;
 		internals->rx_queues[i].busy_budget = busy_budget;
+		internals->rx_queues[i].busy_timeout = busy_timeout;
+		internals->tx_queues[i].lazy_kick = lazy_kick;
 	}
 
 	ret = get_iface_info(if_name, &internals->eth_addr,
@@ -2471,6 +2761,8 @@ rte_pmd_af_xdp_probe(struct rte_vdev_device *dev)
 	int shared_umem = 0;
 	char prog_path[PATH_MAX] = {'\0'};
 	int busy_budget = -1, ret;
+	int busy_timeout = ETH_AF_XDP_DFLT_BUSY_TIMEOUT;
+	int lazy_kick = 0;
 	int force_copy = 0;
 	int use_cni = 0;
 	int use_pinned_map = 0;
@@ -2518,7 +2810,8 @@ rte_pmd_af_xdp_probe(struct rte_vdev_device *dev)
 
 	if (parse_parameters(kvlist, if_name, &xsk_start_queue_idx,
 			     &xsk_queue_cnt, &shared_umem, prog_path,
-			     &busy_budget, &force_copy, &use_cni, &use_pinned_map,
+			     &busy_budget, &busy_timeout, &lazy_kick,
+			     &force_copy, &use_cni, &use_pinned_map,
 			     dp_path, &xdp_mode) < 0) {
 		AF_XDP_LOG_LINE(ERR, "Invalid kvargs value");
 		return -EINVAL;
@@ -2586,8 +2879,8 @@ rte_pmd_af_xdp_probe(struct rte_vdev_device *dev)
 
 	eth_dev = init_internals(dev, if_name, xsk_start_queue_idx,
 				 xsk_queue_cnt, shared_umem, prog_path,
-				 busy_budget, force_copy, use_cni, use_pinned_map,
-				 dp_path, xdp_mode);
+				 busy_budget, busy_timeout, lazy_kick, force_copy,
+				 use_cni, use_pinned_map, dp_path, xdp_mode);
 	if (eth_dev == NULL) {
 		AF_XDP_LOG_LINE(ERR, "Failed to init internals");
 		return -1;
@@ -2647,6 +2940,8 @@ RTE_PMD_REGISTER_PARAM_STRING(net_af_xdp,
 			      "shared_umem=<int> "
 			      "xdp_prog=<string> "
 			      "busy_budget=<int> "
+			      "busy_timeout=<int> "
+			      "lazy_kick=<int> "
 			      "force_copy=<int> "
 			      "use_cni=<int> "
 			      "use_pinned_map=<int> "
@@ -10,6 +10,8 @@
 #include <rte_ether.h>
 #include <rte_byteorder.h>
 #include <rte_atomic.h>
+#include <rte_spinlock.h>
+#include <rte_stdatomic.h>
 #include <rte_flow.h>
 
 #include "rte_eth_bond_8023ad.h"
@@ -149,6 +151,20 @@ struct port {
 	struct rte_mempool *slow_pool;
 };
 
+/** Number of hash slots of the Tx distribution table, a power of 2. */
+#define BOND_8023AD_DIST_SLOTS		256
+#define BOND_8023AD_DIST_SLOTS_MASK	(BOND_8023AD_DIST_SLOTS - 1)
+
+/**
+ * Tx distribution table: the members in DISTRIBUTING state, and the member
+ * index of each hash slot. Read-only once published.
+ */
+struct mode8023ad_dist {
+	uint16_t member_count;
+	uint16_t members[RTE_MAX_ETHPORTS];
+	uint16_t slots[BOND_8023AD_DIST_SLOTS];
+};
+
 struct mode8023ad_private {
 	uint64_t fast_periodic_timeout;
 	uint64_t slow_periodic_timeout;
@@ -178,6 +194,13 @@ struct mode8023ad_private {
 		uint16_t tx_qid;
 	} dedicated_queues;
 	enum rte_bond_8023ad_agg_selection agg_selection;
+
+	/** Tx distribution table used by the data path. */
+	RTE_ATOMIC(struct mode8023ad_dist *) dist;
+	/** Tables alternately published, the unused one is updated. */
+	struct mode8023ad_dist dist_tables[2];
+	/** Serialize the distribution table updates. */
+	rte_spinlock_t dist_lock;
 };
 
 /**
@@ -291,6 +314,17 @@ bond_mode_8023ad_activate_member(struct rte_eth_dev *dev, uint16_t port_id);
 int
 bond_mode_8023ad_deactivate_member(struct rte_eth_dev *dev, uint16_t member_pos);
 
+/**
+ * @internal
+ *
+ * Publish the Tx distribution table of the members in DISTRIBUTING state,
+ * if it changed, and wait for the Tx bursts using the previous one.
+ *
+ * @param dev       Bonding interface.
+ */
+void
+bond_mode_8023ad_dist_update(struct rte_eth_dev *dev);
+
 /**
  * Updates state when MAC was changed on bonding device or one of its members.
  * @param bond_dev Bonding device
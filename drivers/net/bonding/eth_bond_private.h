@@ -72,6 +72,8 @@ struct bond_tx_queue {
 	/**< Number of TX descriptors available for the queue */
 	struct rte_eth_txconf tx_conf;
 	/**< Copy of TX configuration structure for queue */
+	RTE_ATOMIC(uint32_t) dist_seq;
+	/**< Odd while a mode 4 burst reads the distribution table */
 };
 
 /** Bonding member devices structure */
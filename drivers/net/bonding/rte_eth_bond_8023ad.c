@@ -958,10 +958,72 @@ bond_mode_8023ad_periodic_cb(void *arg)
 		show_warnings(member_id);
 	}
 
+	bond_mode_8023ad_dist_update(bond_dev);
+
 	rte_eal_alarm_set(internals->mode4.update_timeout_us,
 			bond_mode_8023ad_periodic_cb, arg);
 }
 
+void
+bond_mode_8023ad_dist_update(struct rte_eth_dev *bond_dev)
+{
+	struct bond_dev_private *internals = bond_dev->data->dev_private;
+	struct mode8023ad_private *mode4 = &internals->mode4;
+	struct mode8023ad_dist *cur, *next;
+	uint16_t members[RTE_MAX_ETHPORTS];
+	uint16_t member_count = 0;
+	uint16_t i;
+
+	rte_spinlock_lock(&mode4->dist_lock);
+
+	for (i = 0; i < internals->active_member_count; i++) {
+		uint16_t member_id = internals->active_members[i];
+
+		if (ACTOR_STATE(&bond_mode_8023ad_ports[member_id], DISTRIBUTING))
+			members[member_count++] = member_id;
+	}
+
+	cur = rte_atomic_load_explicit(&mode4->dist, rte_memory_order_relaxed);
+	if (cur != NULL && cur->member_count == member_count &&
+			memcmp(cur->members, members,
+			       member_count * sizeof(members[0])) == 0) {
+		rte_spinlock_unlock(&mode4->dist_lock);
+		return;
+	}
+
+	/* The table not in use was released by the previous update. */
+	next = cur == &mode4->dist_tables[0] ?
+			&mode4->dist_tables[1] : &mode4->dist_tables[0];
+
+	next->member_count = member_count;
+	memcpy(next->members, members, member_count * sizeof(members[0]));
+	for (i = 0; i < BOND_8023AD_DIST_SLOTS; i++)
+		next->slots[i] = member_count ? i % member_count : 0;
+
+	rte_atomic_store_explicit(&mode4->dist, next, rte_memory_order_release);
+	rte_atomic_thread_fence(rte_memory_order_seq_cst);
+
+	/* Wait for the bursts which may still read the previous table. */
+	for (i = 0; i < bond_dev->data->nb_tx_queues; i++) {
+		struct bond_tx_queue *bd_tx_q = bond_dev->data->tx_queues[i];
+		uint32_t seq;
+
+		if (bd_tx_q == NULL)
+			continue;
+
+		seq = rte_atomic_load_explicit(&bd_tx_q->dist_seq,
+				rte_memory_order_acquire);
+		if (!(seq & 1))
+			continue;
+
+		while (rte_atomic_load_explicit(&bd_tx_q->dist_seq,
+				rte_memory_order_acquire) == seq)
+			rte_pause();
+	}
+
+	rte_spinlock_unlock(&mode4->dist_lock);
+}
+
 static int
 bond_mode_8023ad_register_lacp_mac(uint16_t member_id)
 {
@@ -1628,6 +1690,8 @@ rte_eth_bond_8023ad_ext_distrib(uint16_t port_id, uint16_t member_id,
 	else
 		ACTOR_STATE_CLR(port, DISTRIBUTING);
 
+	bond_mode_8023ad_dist_update(&rte_eth_devices[port_id]);
+
 	return 0;
 }
 
@@ -1719,6 +1783,8 @@ bond_mode_8023ad_ext_periodic_cb(void *arg)
 		}
 	}
 
+	bond_mode_8023ad_dist_update(bond_dev);
+
 	rte_eal_alarm_set(internals->mode4.update_timeout_us,
 			bond_mode_8023ad_ext_periodic_cb, arg);
 }
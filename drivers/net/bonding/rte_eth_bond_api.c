@@ -138,6 +138,10 @@ deactivate_member(struct rte_eth_dev *eth_dev, uint16_t port_id)
 	RTE_ASSERT(active_count < RTE_DIM(internals->active_members));
 	internals->active_member_count = active_count;
 
+	/* Stop sending on the member before it leaves the bonding port. */
+	if (internals->mode == BONDING_MODE_8023AD)
+		bond_mode_8023ad_dist_update(eth_dev);
+
 	if (eth_dev->data->dev_started) {
 		if (internals->mode == BONDING_MODE_8023AD) {
 			bond_mode_8023ad_start(eth_dev);
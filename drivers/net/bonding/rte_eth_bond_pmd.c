@@ -700,132 +700,179 @@ ipv6_hash(struct rte_ipv6_hdr *ipv6_hdr)
 }
 
 
-void
-burst_xmit_l2_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
-		uint16_t member_count, uint16_t *members)
+static inline uint32_t
+xmit_l2_hash(struct rte_mbuf *buf)
 {
 	struct rte_ether_hdr *eth_hdr;
 	uint32_t hash;
-	int i;
 
-	for (i = 0; i < nb_pkts; i++) {
-		eth_hdr = rte_pktmbuf_mtod(buf[i], struct rte_ether_hdr *);
+	eth_hdr = rte_pktmbuf_mtod(buf, struct rte_ether_hdr *);
 
-		hash = ether_hash(eth_hdr);
+	hash = ether_hash(eth_hdr);
 
-		members[i] = (hash ^= hash >> 8) % member_count;
-	}
+	return hash ^ (hash >> 8);
 }
 
-void
-burst_xmit_l23_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
-		uint16_t member_count, uint16_t *members)
+static inline uint32_t
+xmit_l23_hash(struct rte_mbuf *buf)
 {
-	uint16_t i;
 	struct rte_ether_hdr *eth_hdr;
 	uint16_t proto;
 	size_t vlan_offset;
 	uint32_t hash, l3hash;
 
-	for (i = 0; i < nb_pkts; i++) {
-		eth_hdr = rte_pktmbuf_mtod(buf[i], struct rte_ether_hdr *);
-		l3hash = 0;
+	eth_hdr = rte_pktmbuf_mtod(buf, struct rte_ether_hdr *);
+	l3hash = 0;
 
-		proto = eth_hdr->ether_type;
-		hash = ether_hash(eth_hdr);
+	proto = eth_hdr->ether_type;
+	hash = ether_hash(eth_hdr);
 
-		vlan_offset = get_vlan_offset(eth_hdr, &proto);
+	vlan_offset = get_vlan_offset(eth_hdr, &proto);
 
-		if (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4) == proto) {
-			struct rte_ipv4_hdr *ipv4_hdr = (struct rte_ipv4_hdr *)
-					((char *)(eth_hdr + 1) + vlan_offset);
-			l3hash = ipv4_hash(ipv4_hdr);
+	if (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4) == proto) {
+		struct rte_ipv4_hdr *ipv4_hdr = (struct rte_ipv4_hdr *)
+				((char *)(eth_hdr + 1) + vlan_offset);
+		l3hash = ipv4_hash(ipv4_hdr);
 
-		} else if (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6) == proto) {
-			struct rte_ipv6_hdr *ipv6_hdr = (struct rte_ipv6_hdr *)
-					((char *)(eth_hdr + 1) + vlan_offset);
-			l3hash = ipv6_hash(ipv6_hdr);
-		}
+	} else if (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6) == proto) {
+		struct rte_ipv6_hdr *ipv6_hdr = (struct rte_ipv6_hdr *)
+				((char *)(eth_hdr + 1) + vlan_offset);
+		l3hash = ipv6_hash(ipv6_hdr);
+	}
 
-		hash = hash ^ l3hash;
-		hash ^= hash >> 16;
-		hash ^= hash >> 8;
+	hash = hash ^ l3hash;
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
 
-		members[i] = hash % member_count;
-	}
+	return hash;
 }
 
-void
-burst_xmit_l34_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
-		uint16_t member_count, uint16_t *members)
+static inline uint32_t
+xmit_l34_hash(struct rte_mbuf *buf)
 {
 	struct rte_ether_hdr *eth_hdr;
 	uint16_t proto;
 	size_t vlan_offset;
-	int i;
 
 	struct rte_udp_hdr *udp_hdr;
 	struct rte_tcp_hdr *tcp_hdr;
 	uint32_t hash, l3hash, l4hash;
 
-	for (i = 0; i < nb_pkts; i++) {
-		eth_hdr = rte_pktmbuf_mtod(buf[i], struct rte_ether_hdr *);
-		size_t pkt_end = (size_t)eth_hdr + rte_pktmbuf_data_len(buf[i]);
-		proto = eth_hdr->ether_type;
-		vlan_offset = get_vlan_offset(eth_hdr, &proto);
-		l3hash = 0;
-		l4hash = 0;
-
-		if (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4) == proto) {
-			struct rte_ipv4_hdr *ipv4_hdr = (struct rte_ipv4_hdr *)
-					((char *)(eth_hdr + 1) + vlan_offset);
-			size_t ip_hdr_offset;
-
-			l3hash = ipv4_hash(ipv4_hdr);
-
-			/* there is no L4 header in fragmented packet */
-			if (likely(rte_ipv4_frag_pkt_is_fragmented(ipv4_hdr)
-								== 0)) {
-				ip_hdr_offset = (ipv4_hdr->version_ihl
-					& RTE_IPV4_HDR_IHL_MASK) *
-					RTE_IPV4_IHL_MULTIPLIER;
-
-				if (ipv4_hdr->next_proto_id == IPPROTO_TCP) {
-					tcp_hdr = (struct rte_tcp_hdr *)
-						((char *)ipv4_hdr +
-							ip_hdr_offset);
-					if ((size_t)tcp_hdr + sizeof(*tcp_hdr)
-							<= pkt_end)
-						l4hash = HASH_L4_PORTS(tcp_hdr);
-				} else if (ipv4_hdr->next_proto_id ==
-								IPPROTO_UDP) {
-					udp_hdr = (struct rte_udp_hdr *)
-						((char *)ipv4_hdr +
-							ip_hdr_offset);
-					if ((size_t)udp_hdr + sizeof(*udp_hdr)
-							< pkt_end)
-						l4hash = HASH_L4_PORTS(udp_hdr);
-				}
-			}
-		} else if  (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6) == proto) {
-			struct rte_ipv6_hdr *ipv6_hdr = (struct rte_ipv6_hdr *)
-					((char *)(eth_hdr + 1) + vlan_offset);
-			l3hash = ipv6_hash(ipv6_hdr);
-
-			if (ipv6_hdr->proto == IPPROTO_TCP) {
-				tcp_hdr = (struct rte_tcp_hdr *)(ipv6_hdr + 1);
-				l4hash = HASH_L4_PORTS(tcp_hdr);
-			} else if (ipv6_hdr->proto == IPPROTO_UDP) {
-				udp_hdr = (struct rte_udp_hdr *)(ipv6_hdr + 1);
-				l4hash = HASH_L4_PORTS(udp_hdr);
+	eth_hdr = rte_pktmbuf_mtod(buf, struct rte_ether_hdr *);
+	size_t pkt_end = (size_t)eth_hdr + rte_pktmbuf_data_len(buf);
+	proto = eth_hdr->ether_type;
+	vlan_offset = get_vlan_offset(eth_hdr, &proto);
+	l3hash = 0;
+	l4hash = 0;
+
+	if (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV4) == proto) {
+		struct rte_ipv4_hdr *ipv4_hdr = (struct rte_ipv4_hdr *)
+				((char *)(eth_hdr + 1) + vlan_offset);
+		size_t ip_hdr_offset;
+
+		l3hash = ipv4_hash(ipv4_hdr);
+
+		/* there is no L4 header in fragmented packet */
+		if (likely(rte_ipv4_frag_pkt_is_fragmented(ipv4_hdr)
+							== 0)) {
+			ip_hdr_offset = (ipv4_hdr->version_ihl
+				& RTE_IPV4_HDR_IHL_MASK) *
+				RTE_IPV4_IHL_MULTIPLIER;
+
+			if (ipv4_hdr->next_proto_id == IPPROTO_TCP) {
+				tcp_hdr = (struct rte_tcp_hdr *)
+					((char *)ipv4_hdr +
+						ip_hdr_offset);
+				if ((size_t)tcp_hdr + sizeof(*tcp_hdr)
+						<= pkt_end)
+					l4hash = HASH_L4_PORTS(tcp_hdr);
+			} else if (ipv4_hdr->next_proto_id ==
+							IPPROTO_UDP) {
+				udp_hdr = (struct rte_udp_hdr *)
+					((char *)ipv4_hdr +
+						ip_hdr_offset);
+				if ((size_t)udp_hdr + sizeof(*udp_hdr)
+						< pkt_end)
+					l4hash = HASH_L4_PORTS(udp_hdr);
 			}
 		}
+	} else if  (rte_cpu_to_be_16(RTE_ETHER_TYPE_IPV6) == proto) {
+		struct rte_ipv6_hdr *ipv6_hdr = (struct rte_ipv6_hdr *)
+				((char *)(eth_hdr + 1) + vlan_offset);
+		l3hash = ipv6_hash(ipv6_hdr);
+
+		if (ipv6_hdr->proto == IPPROTO_TCP) {
+			tcp_hdr = (struct rte_tcp_hdr *)(ipv6_hdr + 1);
+			l4hash = HASH_L4_PORTS(tcp_hdr);
+		} else if (ipv6_hdr->proto == IPPROTO_UDP) {
+			udp_hdr = (struct rte_udp_hdr *)(ipv6_hdr + 1);
+			l4hash = HASH_L4_PORTS(udp_hdr);
+		}
+	}
+
+	hash = l3hash ^ l4hash;
+	hash ^= hash >> 16;
+	hash ^= hash >> 8;
+
+	return hash;
+}
 
-		hash = l3hash ^ l4hash;
-		hash ^= hash >> 16;
-		hash ^= hash >> 8;
+void
+burst_xmit_l2_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
+		uint16_t member_count, uint16_t *members)
+{
+	int i;
+
+	for (i = 0; i < nb_pkts; i++)
+		members[i] = xmit_l2_hash(buf[i]) % member_count;
+}
 
-		members[i] = hash % member_count;
+void
+burst_xmit_l23_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
+		uint16_t member_count, uint16_t *members)
+{
+	uint16_t i;
+
+	for (i = 0; i < nb_pkts; i++)
+		members[i] = xmit_l23_hash(buf[i]) % member_count;
+}
+
+void
+burst_xmit_l34_hash(struct rte_mbuf **buf, uint16_t nb_pkts,
+		uint16_t member_count, uint16_t *members)
+{
+	int i;
+
+	for (i = 0; i < nb_pkts; i++)
+		members[i] = xmit_l34_hash(buf[i]) % member_count;
+}
+
+/*
+ * Map each packet to the index of its member in the 802.3AD distribution
+ * table. The hash is masked instead of divided, and inlined for the policy.
+ */
+static inline void
+burst_xmit_8023ad_dist(uint8_t policy, struct rte_mbuf **buf, uint16_t nb_pkts,
+		const struct mode8023ad_dist *dist, uint16_t *members)
+{
+	uint16_t i;
+
+	switch (policy) {
+	case BALANCE_XMIT_POLICY_LAYER23:
+		for (i = 0; i < nb_pkts; i++)
+			members[i] = dist->slots[xmit_l23_hash(buf[i]) &
+					BOND_8023AD_DIST_SLOTS_MASK];
+		break;
+	case BALANCE_XMIT_POLICY_LAYER34:
+		for (i = 0; i < nb_pkts; i++)
+			members[i] = dist->slots[xmit_l34_hash(buf[i]) &
+					BOND_8023AD_DIST_SLOTS_MASK];
+		break;
+	default:
+		for (i = 0; i < nb_pkts; i++)
+			members[i] = dist->slots[xmit_l2_hash(buf[i]) &
+					BOND_8023AD_DIST_SLOTS_MASK];
+		break;
 	}
 }
 
@@ -1240,23 +1287,92 @@ bond_ethdev_tx_burst_balance(void *queue, struct rte_mbuf **bufs,
 				member_count);
 }
 
+/*
+ * Send a burst on the distributing members of a 802.3AD bonding port,
+ * grouping the packets of each member with a counting sort.
+ */
+static inline uint16_t
+tx_burst_8023ad_dist(struct bond_tx_queue *bd_tx_q, struct rte_mbuf **bufs,
+		uint16_t nb_bufs, const struct mode8023ad_dist *dist)
+{
+	struct bond_dev_private *internals = bd_tx_q->dev_private;
+	uint16_t member_count = dist->member_count;
+
+	/* Member index of each packet */
+	uint16_t bufs_member_idxs[nb_bufs];
+	/* Packets sorted by member */
+	struct rte_mbuf *member_bufs[nb_bufs];
+	uint16_t member_nb_bufs[RTE_MAX_ETHPORTS];
+	uint16_t member_start[RTE_MAX_ETHPORTS];
+	uint16_t member_pos[RTE_MAX_ETHPORTS];
+
+	uint16_t member_tx_count;
+	uint16_t total_tx_count = 0, total_tx_fail_count = 0;
+	uint16_t i, pos;
+
+	burst_xmit_8023ad_dist(internals->balance_xmit_policy, bufs, nb_bufs,
+			dist, bufs_member_idxs);
+
+	memset(member_nb_bufs, 0, member_count * sizeof(member_nb_bufs[0]));
+	for (i = 0; i < nb_bufs; i++)
+		member_nb_bufs[bufs_member_idxs[i]]++;
+
+	for (i = 0, pos = 0; i < member_count; i++) {
+		member_start[i] = pos;
+		member_pos[i] = pos;
+		pos += member_nb_bufs[i];
+	}
+
+	for (i = 0; i < nb_bufs; i++)
+		member_bufs[member_pos[bufs_member_idxs[i]]++] = bufs[i];
+
+	/* Send packet burst on each member device */
+	for (i = 0; i < member_count; i++) {
+		struct rte_mbuf **pkts = &member_bufs[member_start[i]];
+
+		if (member_nb_bufs[i] == 0)
+			continue;
+
+		member_tx_count = rte_eth_tx_prepare(dist->members[i],
+				bd_tx_q->queue_id, pkts, member_nb_bufs[i]);
+		member_tx_count = rte_eth_tx_burst(dist->members[i],
+				bd_tx_q->queue_id, pkts, member_tx_count);
+
+		total_tx_count += member_tx_count;
+
+		/* If tx burst fails move packets to end of bufs */
+		if (unlikely(member_tx_count < member_nb_bufs[i])) {
+			int member_tx_fail_count = member_nb_bufs[i] -
+					member_tx_count;
+			total_tx_fail_count += member_tx_fail_count;
+			memcpy(&bufs[nb_bufs - total_tx_fail_count],
+			       &pkts[member_tx_count],
+			       member_tx_fail_count * sizeof(bufs[0]));
+		}
+	}
+
+	return total_tx_count;
+}
+
 static inline uint16_t
 tx_burst_8023ad(void *queue, struct rte_mbuf **bufs, uint16_t nb_bufs,
 		bool dedicated_txq)
 {
 	struct bond_tx_queue *bd_tx_q = (struct bond_tx_queue *)queue;
 	struct bond_dev_private *internals = bd_tx_q->dev_private;
+	const struct mode8023ad_dist *dist;
 
 	uint16_t member_port_ids[RTE_MAX_ETHPORTS];
 	uint16_t member_count;
 
-	uint16_t dist_member_port_ids[RTE_MAX_ETHPORTS];
-	uint16_t dist_member_count;
-
 	uint16_t member_tx_count;
+	uint32_t seq;
 
 	uint16_t i;
 
+	if (dedicated_txq)
+		goto skip_tx_ring;
+
 	/* Copy member list to protect against member up/down changes during tx
 	 * bursting */
 	member_count = internals->active_member_count;
@@ -1266,9 +1382,6 @@ tx_burst_8023ad(void *queue, struct rte_mbuf **bufs, uint16_t nb_bufs,
 	memcpy(member_port_ids, internals->active_members,
 			sizeof(member_port_ids[0]) * member_count);
 
-	if (dedicated_txq)
-		goto skip_tx_ring;
-
 	/* Check for LACP control packets and send if available */
 	for (i = 0; i < member_count; i++) {
 		struct port *port = &bond_mode_8023ad_ports[member_port_ids[i]];
@@ -1296,20 +1409,24 @@ tx_burst_8023ad(void *queue, struct rte_mbuf **bufs, uint16_t nb_bufs,
 	if (unlikely(nb_bufs == 0))
 		return 0;
 
-	dist_member_count = 0;
-	for (i = 0; i < member_count; i++) {
-		struct port *port = &bond_mode_8023ad_ports[member_port_ids[i]];
+	/*
+	 * The distribution table is published by the control path, which waits
+	 * for the queues with an odd sequence number to finish their burst
+	 * before reusing the previous table.
+	 */
+	seq = rte_atomic_load_explicit(&bd_tx_q->dist_seq, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&bd_tx_q->dist_seq, seq + 1, rte_memory_order_relaxed);
+	rte_atomic_thread_fence(rte_memory_order_seq_cst);
 
-		if (ACTOR_STATE(port, DISTRIBUTING))
-			dist_member_port_ids[dist_member_count++] =
-					member_port_ids[i];
-	}
+	dist = rte_atomic_load_explicit(&internals->mode4.dist, rte_memory_order_acquire);
+	if (likely(dist != NULL && dist->member_count != 0))
+		member_tx_count = tx_burst_8023ad_dist(bd_tx_q, bufs, nb_bufs, dist);
+	else
+		member_tx_count = 0;
 
-	if (unlikely(dist_member_count < 1))
-		return 0;
+	rte_atomic_store_explicit(&bd_tx_q->dist_seq, seq + 2, rte_memory_order_release);
 
-	return tx_burst_balance(queue, bufs, nb_bufs, dist_member_port_ids,
-				dist_member_count);
+	return member_tx_count;
 }
 
 static uint16_t
@@ -3679,6 +3796,7 @@ bond_alloc(struct rte_vdev_device *dev, uint8_t mode)
 
 	rte_spinlock_init(&internals->lock);
 	rte_spinlock_init(&internals->lsc_lock);
+	rte_spinlock_init(&internals->mode4.dist_lock);
 
 	internals->port_id = eth_dev->data->port_id;
 	internals->mode = BONDING_MODE_INVALID;
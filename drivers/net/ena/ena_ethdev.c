@@ -10,12 +10,14 @@
 #include <rte_net.h>
 #include <rte_kvargs.h>
 #include <rte_eal_paging.h>
+#include <rte_vect.h>
 
 #include "ena_ethdev.h"
 #include "ena_logs.h"
 #include "ena_platform.h"
 #include "ena_com.h"
 #include "ena_eth_com.h"
+#include "ena_rxtx_vec_common.h"
 
 #include <ena_common_defs.h>
 #include <ena_regs_defs.h>
@@ -263,8 +265,8 @@ static struct rte_mbuf *ena_rx_mbuf(struct ena_ring *rx_ring,
 				    uint32_t descs,
 				    uint16_t *next_to_clean,
 				    uint8_t offset);
-static uint16_t eth_ena_recv_pkts(void *rx_queue,
-				  struct rte_mbuf **rx_pkts, uint16_t nb_pkts);
+static uint64_t ena_rx_mbuf_initializer(uint16_t port_id);
+static void ena_set_rx_burst(struct rte_eth_dev *dev);
 static int ena_add_single_rx_desc(struct ena_com_io_sq *io_sq,
 				  struct rte_mbuf *mbuf, uint16_t id);
 static int ena_populate_rx_queue(struct ena_ring *rxq, unsigned int count);
@@ -388,6 +390,8 @@ enum ena_mp_req {
 };
 
 /** Proxy message body. Shared between requests and responses. */
+struct ena_rx_vec_flags ena_rx_vec_flags_table[ENA_RX_VEC_FLAGS_NUM];
+
 struct ena_mp_body {
 	/* Message type */
 	enum ena_mp_req type;
@@ -1428,6 +1432,7 @@ static int ena_start(struct rte_eth_dev *dev)
 	}
 
 	ena_stats_restart(dev);
+	ena_set_rx_burst(dev);
 
 	adapter->timestamp_wd = rte_get_timer_cycles();
 	adapter->keep_alive_timeout = ENA_DEVICE_KALIVE_TIMEOUT;
@@ -1829,6 +1834,7 @@ static int ena_rx_queue_setup(struct rte_eth_dev *dev,
 		rxq->empty_rx_reqs[i] = i;
 
 	rxq->offloads = rx_conf->offloads | dev->data->dev_conf.rxmode.offloads;
+	rxq->mbuf_initializer = ena_rx_mbuf_initializer(rxq->port_id);
 
 	if (rx_conf->rx_free_thresh != 0) {
 		rxq->rx_free_thresh = rx_conf->rx_free_thresh;
@@ -2351,6 +2357,77 @@ ena_set_offloads(struct ena_offloads *offloads,
 		offloads->rx_offloads |= ENA_RX_RSS_HASH;
 }
 
+/* Rearm data of the received mbufs, stored at once by the vector Rx */
+static uint64_t ena_rx_mbuf_initializer(uint16_t port_id)
+{
+	struct rte_mbuf mb_def = { .buf_addr = 0 }; /* zeroed mbuf */
+
+	mb_def.nb_segs = 1;
+	mb_def.data_off = RTE_PKTMBUF_HEADROOM;
+	mb_def.port = port_id;
+	rte_mbuf_refcnt_set(&mb_def, 1);
+
+	return *(uint64_t *)&mb_def.rearm_data;
+}
+
+/*
+ * Precompute the flags set by ena_rx_mbuf_prepare() for each status of the
+ * Rx completion descriptor which matters to it, for the vector Rx.
+ */
+static void ena_rx_vec_flags_init(void)
+{
+	struct ena_ring ring = { 0 };
+	struct ena_com_rx_ctx ctx;
+	struct rte_mbuf mbuf;
+	unsigned int key;
+
+	ring.offloads = RTE_ETH_RX_OFFLOAD_RSS_HASH;
+	ring.ts_mbuf.offset = ENA_TS_OFFSET_UNSET;
+
+	for (key = 0; key < ENA_RX_VEC_FLAGS_NUM; key++) {
+		uint32_t status = (key & ENA_RX_VEC_STATUS_MASK) <<
+			ENA_RX_VEC_STATUS_SHIFT;
+
+		memset(&ctx, 0, sizeof(ctx));
+		if (key & ENA_RX_VEC_IPV4)
+			ctx.l3_proto = ENA_ETH_IO_L3_PROTO_IPV4;
+		else if (key & ENA_RX_VEC_IPV6)
+			ctx.l3_proto = ENA_ETH_IO_L3_PROTO_IPV6;
+		if (key & ENA_RX_VEC_TCP)
+			ctx.l4_proto = ENA_ETH_IO_L4_PROTO_TCP;
+		else if (key & ENA_RX_VEC_UDP)
+			ctx.l4_proto = ENA_ETH_IO_L4_PROTO_UDP;
+		ctx.l3_csum_err = !!(status & ENA_ETH_IO_RX_CDESC_BASE_L3_CSUM_ERR_MASK);
+		ctx.l4_csum_err = !!(status & ENA_ETH_IO_RX_CDESC_BASE_L4_CSUM_ERR_MASK);
+		ctx.frag = !!(status & ENA_ETH_IO_RX_CDESC_BASE_IPV4_FRAG_MASK);
+		ctx.l4_csum_checked = !!(status &
+			ENA_ETH_IO_RX_CDESC_BASE_L4_CSUM_CHECKED_MASK);
+
+		ena_rx_mbuf_prepare(&ring, &mbuf, &ctx);
+		ena_rx_vec_flags_table[key].ol_flags = mbuf.ol_flags;
+		ena_rx_vec_flags_table[key].packet_type = mbuf.packet_type;
+	}
+}
+
+/* Select the Rx burst function, in the primary and secondary processes */
+static void ena_set_rx_burst(struct rte_eth_dev *dev)
+{
+	uint64_t offloads = dev->data->dev_conf.rxmode.offloads;
+
+	dev->rx_pkt_burst = &eth_ena_recv_pkts;
+#if defined(RTE_ARCH_X86) || defined(RTE_ARCH_ARM64)
+	/* Timestamps are only in the extended completion descriptors */
+	if (!(offloads & RTE_ETH_RX_OFFLOAD_TIMESTAMP) &&
+	    rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_128) {
+		PMD_DRV_LOG_LINE(INFO, "Using vector Rx, port %u",
+				 dev->data->port_id);
+		dev->rx_pkt_burst = &ena_recv_pkts_vec;
+	}
+#else
+	RTE_SET_USED(offloads);
+#endif
+}
+
 static int ena_init_once(void)
 {
 	static bool init_done;
@@ -2358,6 +2435,8 @@ static int ena_init_once(void)
 	if (init_done)
 		return 0;
 
+	ena_rx_vec_flags_init();
+
 	if (rte_eal_process_type() == RTE_PROC_PRIMARY) {
 		/* Init timer subsystem for the ENA timer service. */
 		rte_timer_subsystem_init();
@@ -2412,8 +2491,10 @@ static int eth_ena_dev_init(struct rte_eth_dev *eth_dev)
 	if (rc != 0)
 		return rc;
 
-	if (rte_eal_process_type() != RTE_PROC_PRIMARY)
+	if (rte_eal_process_type() != RTE_PROC_PRIMARY) {
+		ena_set_rx_burst(eth_dev);
 		return 0;
+	}
 
 	eth_dev->data->dev_flags |= RTE_ETH_DEV_AUTOFILL_QUEUE_XSTATS;
 
@@ -2933,8 +3014,8 @@ static struct rte_mbuf *ena_rx_mbuf(struct ena_ring *rx_ring,
 	return mbuf_head;
 }
 
-static uint16_t eth_ena_recv_pkts(void *rx_queue, struct rte_mbuf **rx_pkts,
-				  uint16_t nb_pkts)
+uint16_t eth_ena_recv_pkts(void *rx_queue, struct rte_mbuf **rx_pkts,
+			   uint16_t nb_pkts)
 {
 	struct ena_ring *rx_ring = (struct ena_ring *)(rx_queue);
 	unsigned int free_queue_entries;
@@ -3262,6 +3343,173 @@ static void ena_tx_map_mbuf(struct ena_ring *tx_ring,
 	}
 }
 
+/*
+ * Copy a LLQ entry to the device memory in 64-byte stores, each filling
+ * a whole write-combining buffer, instead of 8-byte ones.
+ */
+static __rte_always_inline void ena_llq_entry_write(void *dst, const void *src,
+						    uint16_t size)
+{
+	uint16_t off;
+
+	for (off = 0; off < size; off += ENA_LLQ_STORE_SIZE) {
+		void *to = RTE_PTR_ADD(dst, off);
+		const void *from = RTE_PTR_ADD(src, off);
+#if defined(RTE_ARCH_X86) && defined(__AVX512F__)
+		_mm512_store_si512(to, _mm512_load_si512(from));
+#elif defined(RTE_ARCH_X86) && defined(__AVX__)
+		_mm256_store_si256(to, _mm256_load_si256(from));
+		_mm256_store_si256(RTE_PTR_ADD(to, 32),
+				   _mm256_load_si256(RTE_PTR_ADD(from, 32)));
+#elif defined(RTE_ARCH_X86)
+		_mm_store_si128(to, _mm_load_si128(from));
+		_mm_store_si128(RTE_PTR_ADD(to, 16),
+				_mm_load_si128(RTE_PTR_ADD(from, 16)));
+		_mm_store_si128(RTE_PTR_ADD(to, 32),
+				_mm_load_si128(RTE_PTR_ADD(from, 32)));
+		_mm_store_si128(RTE_PTR_ADD(to, 48),
+				_mm_load_si128(RTE_PTR_ADD(from, 48)));
+#elif defined(RTE_ARCH_ARM64)
+		vst1q_u64(to, vld1q_u64(from));
+		vst1q_u64(RTE_PTR_ADD(to, 16), vld1q_u64(RTE_PTR_ADD(from, 16)));
+		vst1q_u64(RTE_PTR_ADD(to, 32), vld1q_u64(RTE_PTR_ADD(from, 32)));
+		vst1q_u64(RTE_PTR_ADD(to, 48), vld1q_u64(RTE_PTR_ADD(from, 48)));
+#else
+		ENA_MEMCPY_TO_DEVICE_64(to, from, ENA_LLQ_STORE_SIZE);
+#endif
+	}
+}
+
+/*
+ * Send a single segment packet, which doesn't need a meta descriptor, in
+ * a single LLQ entry. The entry is built on the stack and written at once,
+ * skipping the bounce buffer and the barrier of ena_com_prepare_tx(): the
+ * entries of the burst are ordered by the doorbell.
+ * Returns 1 if the packet has to be sent by ena_com_prepare_tx().
+ */
+static int ena_xmit_mbuf_llq(struct ena_ring *tx_ring, struct rte_mbuf *mbuf)
+{
+	alignas(ENA_LLQ_STORE_SIZE) uint8_t entry[ENA_LLQ_ENTRY_MAX_SIZE];
+	struct ena_eth_io_tx_desc *desc = (struct ena_eth_io_tx_desc *)entry;
+	struct ena_com_io_sq *io_sq = tx_ring->ena_com_io_sq;
+	struct ena_com_llq_info *llq_info = &io_sq->llq_info;
+	struct ena_com_tx_ctx ena_tx_ctx = { { 0 } };
+	struct ena_tx_buffer *tx_info;
+	uint16_t header_offset, header_len, entry_size;
+	uint16_t next_to_use, req_id, tail_masked;
+	uint32_t buf_len;
+	uint64_t paddr;
+
+	header_len = RTE_MIN(mbuf->pkt_len, tx_ring->tx_max_header_size);
+	header_offset = llq_info->descs_num_before_header * io_sq->desc_entry_size;
+	entry_size = llq_info->desc_list_entry_size;
+	if (unlikely(header_offset == 0 || entry_size > sizeof(entry) ||
+		     header_offset + header_len > entry_size))
+		return 1;
+
+	ena_tx_mbuf_prepare(mbuf, &ena_tx_ctx, tx_ring->offloads,
+		tx_ring->disable_meta_caching);
+	if (io_sq->disable_meta_caching ||
+	    unlikely(ena_com_meta_desc_changed(io_sq, &ena_tx_ctx)))
+		return 1;
+
+	if (!ena_com_sq_have_enough_space(io_sq, mbuf->nb_segs + 2)) {
+		PMD_TX_LOG_LINE(DEBUG, "Not enough space in the tx queue");
+		return ENA_COM_NO_MEM;
+	}
+
+	/* The rest of the segment follows the pushed header */
+	buf_len = mbuf->data_len - header_len;
+	ena_tx_ctx.num_bufs = buf_len != 0;
+
+	if (unlikely(ena_com_is_doorbell_needed(io_sq, &ena_tx_ctx))) {
+		PMD_TX_LOG_LINE(DEBUG,
+			"LLQ Tx max burst size of queue %d achieved, writing doorbell to send burst",
+			tx_ring->id);
+		ena_com_write_tx_sq_doorbell(io_sq);
+		tx_ring->tx_stats.doorbells++;
+		tx_ring->pkts_without_db = false;
+	}
+
+	next_to_use = tx_ring->next_to_use;
+	req_id = tx_ring->empty_tx_reqs[next_to_use];
+	tx_info = &tx_ring->tx_buffer_info[req_id];
+	RTE_ASSERT(tx_info->mbuf == NULL);
+
+	memset(entry, 0, entry_size);
+
+	desc->len_ctrl = ENA_FIELD_PREP((uint32_t)io_sq->phase,
+					ENA_ETH_IO_TX_DESC_PHASE_MASK,
+					ENA_ETH_IO_TX_DESC_PHASE_SHIFT) |
+		ENA_ETH_IO_TX_DESC_FIRST_MASK |
+		ENA_ETH_IO_TX_DESC_COMP_REQ_MASK |
+		ENA_ETH_IO_TX_DESC_LAST_MASK |
+		ENA_FIELD_PREP((uint32_t)(req_id >> 10),
+			       ENA_ETH_IO_TX_DESC_REQ_ID_HI_MASK,
+			       ENA_ETH_IO_TX_DESC_REQ_ID_HI_SHIFT) |
+		(buf_len & ENA_ETH_IO_TX_DESC_LENGTH_MASK);
+	desc->meta_ctrl = ENA_FIELD_PREP((uint32_t)req_id,
+					 ENA_ETH_IO_TX_DESC_REQ_ID_LO_MASK,
+					 ENA_ETH_IO_TX_DESC_REQ_ID_LO_SHIFT) |
+		ENA_FIELD_PREP((uint32_t)ena_tx_ctx.df,
+			       ENA_ETH_IO_TX_DESC_DF_MASK,
+			       ENA_ETH_IO_TX_DESC_DF_SHIFT);
+	if (ena_tx_ctx.meta_valid) {
+		desc->meta_ctrl |= ENA_FIELD_PREP((uint32_t)ena_tx_ctx.tso_enable,
+						  ENA_ETH_IO_TX_DESC_TSO_EN_MASK,
+						  ENA_ETH_IO_TX_DESC_TSO_EN_SHIFT) |
+			(ena_tx_ctx.l3_proto & ENA_ETH_IO_TX_DESC_L3_PROTO_IDX_MASK) |
+			ENA_FIELD_PREP((uint32_t)ena_tx_ctx.l4_proto,
+				       ENA_ETH_IO_TX_DESC_L4_PROTO_IDX_MASK,
+				       ENA_ETH_IO_TX_DESC_L4_PROTO_IDX_SHIFT) |
+			ENA_FIELD_PREP((uint32_t)ena_tx_ctx.l3_csum_enable,
+				       ENA_ETH_IO_TX_DESC_L3_CSUM_EN_MASK,
+				       ENA_ETH_IO_TX_DESC_L3_CSUM_EN_SHIFT) |
+			ENA_FIELD_PREP((uint32_t)ena_tx_ctx.l4_csum_enable,
+				       ENA_ETH_IO_TX_DESC_L4_CSUM_EN_MASK,
+				       ENA_ETH_IO_TX_DESC_L4_CSUM_EN_SHIFT) |
+			ENA_FIELD_PREP((uint32_t)ena_tx_ctx.l4_csum_partial,
+				       ENA_ETH_IO_TX_DESC_L4_CSUM_PARTIAL_MASK,
+				       ENA_ETH_IO_TX_DESC_L4_CSUM_PARTIAL_SHIFT);
+	}
+	desc->buff_addr_hi_hdr_sz = ENA_FIELD_PREP((uint32_t)header_len,
+		ENA_ETH_IO_TX_DESC_HEADER_LENGTH_MASK,
+		ENA_ETH_IO_TX_DESC_HEADER_LENGTH_SHIFT);
+	if (buf_len != 0) {
+		paddr = rte_pktmbuf_iova_offset(mbuf, header_len);
+		desc->buff_addr_lo = (uint32_t)paddr;
+		desc->buff_addr_hi_hdr_sz |= ((paddr &
+			GENMASK_ULL(io_sq->dma_addr_bits - 1, 32)) >> 32) &
+			ENA_ETH_IO_TX_DESC_ADDR_HI_MASK;
+	}
+	rte_memcpy(entry + header_offset, rte_pktmbuf_mtod(mbuf, void *),
+		   header_len);
+
+	if (is_llq_max_tx_burst_exists(io_sq))
+		io_sq->entries_in_tx_burst_left--;
+	tail_masked = io_sq->tail & (io_sq->q_depth - 1);
+	ena_llq_entry_write(RTE_PTR_ADD(io_sq->desc_addr.pbuf_dev_addr,
+					tail_masked * entry_size),
+			    entry, entry_size);
+	io_sq->tail++;
+	/* Switch phase bit in case of wrap around */
+	if (unlikely((io_sq->tail & (io_sq->q_depth - 1)) == 0))
+		io_sq->phase ^= 1;
+
+	tx_info->mbuf = mbuf;
+	tx_info->num_of_bufs = ena_tx_ctx.num_bufs;
+	tx_info->tx_descs = 1;
+	tx_info->timestamp = rte_get_timer_cycles();
+
+	tx_ring->tx_stats.cnt++;
+	tx_ring->tx_stats.bytes += mbuf->pkt_len;
+
+	tx_ring->next_to_use = ENA_IDX_NEXT_MASKED(next_to_use,
+		tx_ring->size_mask);
+
+	return 0;
+}
+
 static int ena_xmit_mbuf(struct ena_ring *tx_ring, struct rte_mbuf *mbuf)
 {
 	struct ena_tx_buffer *tx_info;
@@ -3273,6 +3521,13 @@ static int ena_xmit_mbuf(struct ena_ring *tx_ring, struct rte_mbuf *mbuf)
 	int nb_hw_desc;
 	int rc;
 
+	if (tx_ring->tx_mem_queue_type == ENA_ADMIN_PLACEMENT_POLICY_DEV &&
+	    mbuf->nb_segs == 1) {
+		rc = ena_xmit_mbuf_llq(tx_ring, mbuf);
+		if (rc <= 0)
+			return rc;
+	}
+
 	/* Checking for space for 2 additional metadata descriptors due to
 	 * possible header split and metadata descriptor
 	 */
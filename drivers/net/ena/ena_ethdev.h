@@ -31,6 +31,10 @@
 
 #define ENA_MIN_MTU		128
 
+/* Largest LLQ entry, written to the device in 64-byte stores */
+#define ENA_LLQ_ENTRY_MAX_SIZE	256
+#define ENA_LLQ_STORE_SIZE	64
+
 #define ENA_MMIO_DISABLE_REG_READ	BIT(0)
 
 #define ENA_WD_TIMEOUT_SEC	3
@@ -213,6 +217,9 @@ struct __rte_cache_aligned ena_ring {
 
 	/* Dynamic mbuf params for HW timestamping */
 	struct ena_timestamp_mbuf ts_mbuf;
+
+	/* Rearm data of the received mbufs, set by the vector Rx */
+	uint64_t mbuf_initializer;
 };
 
 enum ena_adapter_state {
@@ -392,4 +399,9 @@ int ena_rss_hash_conf_get(struct rte_eth_dev *dev,
 			  struct rte_eth_rss_conf *rss_conf);
 int ena_rss_configure(struct ena_adapter *adapter);
 
+uint16_t eth_ena_recv_pkts(void *rx_queue, struct rte_mbuf **rx_pkts,
+			   uint16_t nb_pkts);
+uint16_t ena_recv_pkts_vec(void *rx_queue, struct rte_mbuf **rx_pkts,
+			   uint16_t nb_pkts);
+
 #endif /* _ENA_ETHDEV_H_ */
@@ -0,0 +1,152 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _ENA_RXTX_VEC_COMMON_H_
+#define _ENA_RXTX_VEC_COMMON_H_
+
+#include "ena_ethdev.h"
+#include "ena_eth_com.h"
+
+#include <ena_eth_io_defs.h>
+
+/* Number of Rx completion descriptors parsed together, one cache line */
+#define ENA_RX_VEC_DESCS	4
+
+/*
+ * Index bits of ena_rx_vec_flags_table, built from the status of the
+ * Rx completion descriptor.
+ */
+#define ENA_RX_VEC_IPV4			RTE_BIT32(0)
+#define ENA_RX_VEC_IPV6			RTE_BIT32(1)
+#define ENA_RX_VEC_TCP			RTE_BIT32(2)
+#define ENA_RX_VEC_UDP			RTE_BIT32(3)
+/* L3 csum err, L4 csum err, IPv4 frag and L4 csum checked status bits */
+#define ENA_RX_VEC_STATUS_SHIFT		(ENA_ETH_IO_RX_CDESC_BASE_L3_CSUM_ERR_SHIFT - 4)
+#define ENA_RX_VEC_STATUS_MASK		0xf0
+#define ENA_RX_VEC_FLAGS_NUM		256
+
+/* Status bits which prevent the vector Rx from handling a descriptor */
+#define ENA_RX_VEC_STATUS_CHECK	(ENA_ETH_IO_RX_CDESC_BASE_PHASE_MASK | \
+				 ENA_ETH_IO_RX_CDESC_BASE_FIRST_MASK | \
+				 ENA_ETH_IO_RX_CDESC_BASE_LAST_MASK | \
+				 ENA_ETH_IO_RX_CDESC_BASE_MBZ7_MASK | \
+				 ENA_ETH_IO_RX_CDESC_BASE_MBZ17_MASK)
+/* Expected value of these bits, apart from the phase */
+#define ENA_RX_VEC_STATUS_SINGLE (ENA_ETH_IO_RX_CDESC_BASE_FIRST_MASK | \
+				  ENA_ETH_IO_RX_CDESC_BASE_LAST_MASK)
+
+/* Offset of the packet in its buffer, in the completion descriptor */
+#define ENA_RX_VEC_OFFSET_BYTE	14
+
+/* Flags of a received packet, as set by ena_rx_mbuf_prepare() */
+struct ena_rx_vec_flags {
+	uint64_t ol_flags;
+	uint32_t packet_type;
+};
+
+extern struct ena_rx_vec_flags ena_rx_vec_flags_table[ENA_RX_VEC_FLAGS_NUM];
+
+/* Statistics of a vector Rx burst */
+struct ena_rx_vec_stats {
+	uint64_t bytes;
+	uint32_t l3_csum_bad;
+	uint32_t l4_csum_bad;
+	uint32_t l4_csum_good;
+	uint32_t errors;
+};
+
+static __rte_always_inline void
+ena_rx_vec_stats_add(struct ena_rx_vec_stats *stats, uint64_t ol_flags,
+		     uint16_t len)
+{
+	uint64_t l4 = ol_flags & RTE_MBUF_F_RX_L4_CKSUM_MASK;
+	uint32_t l3_bad = !!(ol_flags & RTE_MBUF_F_RX_IP_CKSUM_BAD);
+	uint32_t l4_bad = l4 == RTE_MBUF_F_RX_L4_CKSUM_BAD;
+
+	stats->bytes += len;
+	stats->l3_csum_bad += l3_bad;
+	stats->l4_csum_bad += l4_bad;
+	stats->l4_csum_good += l4 == RTE_MBUF_F_RX_L4_CKSUM_GOOD;
+	stats->errors += l3_bad | l4_bad;
+}
+
+/* Get the mbuf of a completed request, releasing its request id */
+static __rte_always_inline struct rte_mbuf *
+ena_rx_vec_mbuf(struct ena_ring *rx_ring, uint16_t req_id, uint16_t *ntc)
+{
+	struct ena_rx_buffer *rx_info = &rx_ring->rx_buffer_info[req_id];
+	struct rte_mbuf *mbuf = rx_info->mbuf;
+
+	RTE_ASSERT(mbuf != NULL);
+	rx_info->mbuf = NULL;
+	rx_ring->empty_rx_reqs[*ntc] = req_id;
+	*ntc = ENA_IDX_NEXT_MASKED(*ntc, rx_ring->size_mask);
+
+	return mbuf;
+}
+
+/*
+ * Get the completion descriptors to parse together,
+ * or NULL if they would wrap around the queue
+ * or if the scalar Rx is in the middle of a packet.
+ */
+static __rte_always_inline const struct ena_eth_io_rx_cdesc_base *
+ena_rx_vec_cdescs(struct ena_com_io_cq *io_cq)
+{
+	uint16_t head_masked = io_cq->head & (io_cq->q_depth - 1);
+
+	if (unlikely(head_masked + ENA_RX_VEC_DESCS > io_cq->q_depth ||
+		     io_cq->cur_rx_pkt_cdesc_count != 0))
+		return NULL;
+
+	return (const struct ena_eth_io_rx_cdesc_base *)
+		((uintptr_t)io_cq->cdesc_addr.virt_addr +
+		 head_masked * sizeof(struct ena_eth_io_rx_cdesc_base));
+}
+
+/* Consume completion descriptors of single buffer packets */
+static __rte_always_inline void
+ena_rx_vec_consume(struct ena_ring *rx_ring, uint16_t n)
+{
+	struct ena_com_io_cq *io_cq = rx_ring->ena_com_io_cq;
+	uint16_t head_masked;
+
+	io_cq->head += n;
+	head_masked = io_cq->head & (io_cq->q_depth - 1);
+	/* Descriptors never wrap around, except the last one */
+	if (unlikely(head_masked == 0))
+		io_cq->phase ^= 1;
+	io_cq->cur_rx_pkt_cdesc_start_idx = head_masked;
+	rx_ring->ena_com_io_sq->next_to_comp += n;
+}
+
+/*
+ * Update the statistics of the vector Rx burst,
+ * then receive the remaining packets with the scalar Rx,
+ * which also refills the queue.
+ */
+static inline uint16_t
+ena_rx_vec_finish(struct ena_ring *rx_ring, struct rte_mbuf **rx_pkts,
+		  uint16_t nb_pkts, uint16_t nb_rx, uint16_t next_to_clean,
+		  const struct ena_rx_vec_stats *stats)
+{
+	struct ena_stats_rx *rx_stats = &rx_ring->rx_stats;
+
+	if (nb_rx != 0) {
+		rx_ring->next_to_clean = next_to_clean;
+		rx_stats->cnt += nb_rx;
+		rx_stats->bytes += stats->bytes;
+		rx_stats->l3_csum_bad += stats->l3_csum_bad;
+		rx_stats->l4_csum_bad += stats->l4_csum_bad;
+		rx_stats->l4_csum_good += stats->l4_csum_good;
+		if (unlikely(stats->errors != 0))
+			rte_atomic64_add(&rx_ring->adapter->drv_stats->ierrors,
+					 stats->errors);
+	}
+
+	return nb_rx + eth_ena_recv_pkts(rx_ring, rx_pkts + nb_rx,
+					 nb_pkts - nb_rx);
+}
+
+#endif /* _ENA_RXTX_VEC_COMMON_H_ */
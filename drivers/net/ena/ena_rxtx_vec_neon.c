@@ -0,0 +1,132 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_vect.h>
+
+#include "ena_rxtx_vec_common.h"
+
+/*
+ * Receive single buffer packets,
+ * parsing 4 completion descriptors of a cache line together.
+ */
+uint16_t
+ena_recv_pkts_vec(void *rx_queue, struct rte_mbuf **rx_pkts, uint16_t nb_pkts)
+{
+	struct ena_ring *rx_ring = rx_queue;
+	struct ena_com_io_cq *io_cq = rx_ring->ena_com_io_cq;
+	const struct ena_eth_io_rx_cdesc_base *cdesc;
+	struct ena_rx_vec_stats stats = { 0 };
+	uint16_t next_to_clean = rx_ring->next_to_clean;
+	uint64_t ol_mask = (rx_ring->offloads & RTE_ETH_RX_OFFLOAD_RSS_HASH) ?
+		UINT64_MAX : ~RTE_MBUF_F_RX_RSS_HASH;
+	uint32_t keys[ENA_RX_VEC_DESCS];
+	uint16_t nb_rx = 0;
+	unsigned int i, n;
+
+	/* length, length and hash, packet type inserted from the table */
+	const uint8x16_t fields_shuf = {
+		0xff, 0xff, 0xff, 0xff, 4, 5, 0xff, 0xff,
+		4, 5, 0xff, 0xff, 8, 9, 10, 11
+	};
+	const uint32x4_t check_mask = vdupq_n_u32(ENA_RX_VEC_STATUS_CHECK);
+	const uint32x4_t l3_mask = vdupq_n_u32(ENA_ETH_IO_RX_CDESC_BASE_L3_PROTO_IDX_MASK);
+	const uint32x4_t l4_mask = vdupq_n_u32(ENA_ETH_IO_RX_CDESC_BASE_L4_PROTO_IDX_MASK);
+	const uint32x4_t status_mask = vdupq_n_u32(ENA_RX_VEC_STATUS_MASK);
+	const uint32x4_t q_depth = vdupq_n_u32(io_cq->q_depth);
+
+	/* mbuf fields stored together from the completion descriptor */
+	RTE_BUILD_BUG_ON(offsetof(struct rte_mbuf, pkt_len) !=
+			 offsetof(struct rte_mbuf, rx_descriptor_fields1) + 4);
+	RTE_BUILD_BUG_ON(offsetof(struct rte_mbuf, data_len) !=
+			 offsetof(struct rte_mbuf, rx_descriptor_fields1) + 8);
+	RTE_BUILD_BUG_ON(offsetof(struct rte_mbuf, hash) !=
+			 offsetof(struct rte_mbuf, rx_descriptor_fields1) + 12);
+	RTE_BUILD_BUG_ON(sizeof(struct ena_eth_io_rx_cdesc_base) != 16);
+
+	while (nb_rx < nb_pkts) {
+		uint32x4_t d[ENA_RX_VEC_DESCS];
+		uint32x4_t status, lr, key, ok, expected;
+		uint64_t ok_bits;
+
+		cdesc = ena_rx_vec_cdescs(io_cq);
+		if (unlikely(cdesc == NULL))
+			break;
+
+		expected = vdupq_n_u32(ENA_RX_VEC_STATUS_SINGLE |
+			((uint32_t)io_cq->phase << ENA_ETH_IO_RX_CDESC_BASE_PHASE_SHIFT));
+
+		/* Statuses are read before the rest of the descriptors */
+		for (i = 0; i < ENA_RX_VEC_DESCS; i++)
+			d[i] = vld1q_u32((const uint32_t *)&cdesc[i]);
+		status = vuzp1q_u32(vuzp1q_u32(d[0], d[1]),
+			vuzp1q_u32(d[2], d[3]));
+
+		rte_io_rmb();
+
+		for (i = 0; i < ENA_RX_VEC_DESCS; i++)
+			d[i] = vld1q_u32((const uint32_t *)&cdesc[i]);
+		/* length and request id */
+		lr = vuzp1q_u32(vuzp2q_u32(d[0], d[1]), vuzp2q_u32(d[2], d[3]));
+
+		/* completed single buffer packets with a valid request id */
+		ok = vceqq_u32(vandq_u32(status, check_mask), expected);
+		ok = vandq_u32(ok, vcltq_u32(vshrq_n_u32(lr, 16), q_depth));
+		ok_bits = vget_lane_u64(vreinterpret_u64_u16(vmovn_u32(ok)), 0);
+		n = ~ok_bits == 0 ? ENA_RX_VEC_DESCS :
+			rte_ctz64(~ok_bits) / 16;
+		n = RTE_MIN(n, (unsigned int)(nb_pkts - nb_rx));
+		if (n == 0)
+			break;
+
+		/* index of the flags of each packet */
+		key = vandq_u32(vshrq_n_u32(status, ENA_RX_VEC_STATUS_SHIFT),
+			status_mask);
+		key = vorrq_u32(key, vandq_u32(vdupq_n_u32(ENA_RX_VEC_IPV4),
+			vceqq_u32(vandq_u32(status, l3_mask),
+				vdupq_n_u32(ENA_ETH_IO_L3_PROTO_IPV4))));
+		key = vorrq_u32(key, vandq_u32(vdupq_n_u32(ENA_RX_VEC_IPV6),
+			vceqq_u32(vandq_u32(status, l3_mask),
+				vdupq_n_u32(ENA_ETH_IO_L3_PROTO_IPV6))));
+		key = vorrq_u32(key, vandq_u32(vdupq_n_u32(ENA_RX_VEC_TCP),
+			vceqq_u32(vandq_u32(status, l4_mask),
+				vdupq_n_u32(ENA_ETH_IO_L4_PROTO_TCP <<
+					ENA_ETH_IO_RX_CDESC_BASE_L4_PROTO_IDX_SHIFT))));
+		key = vorrq_u32(key, vandq_u32(vdupq_n_u32(ENA_RX_VEC_UDP),
+			vceqq_u32(vandq_u32(status, l4_mask),
+				vdupq_n_u32(ENA_ETH_IO_L4_PROTO_UDP <<
+					ENA_ETH_IO_RX_CDESC_BASE_L4_PROTO_IDX_SHIFT))));
+		vst1q_u32(keys, key);
+
+		for (i = 0; i < n; i++) {
+			const struct ena_rx_vec_flags *flags =
+				&ena_rx_vec_flags_table[keys[i]];
+			uint8x16_t desc = vreinterpretq_u8_u32(d[i]);
+			struct rte_mbuf *mbuf;
+			uint32x4_t fields;
+
+			mbuf = ena_rx_vec_mbuf(rx_ring,
+				vgetq_lane_u16(vreinterpretq_u16_u8(desc), 3),
+				&next_to_clean);
+
+			mbuf->rearm_data[0] = rx_ring->mbuf_initializer +
+				vgetq_lane_u8(desc, ENA_RX_VEC_OFFSET_BYTE);
+			fields = vreinterpretq_u32_u8(vqtbl1q_u8(desc, fields_shuf));
+			fields = vsetq_lane_u32(flags->packet_type, fields, 0);
+			vst1q_u32((uint32_t *)mbuf->rx_descriptor_fields1, fields);
+			mbuf->ol_flags = flags->ol_flags & ol_mask;
+
+			ena_rx_vec_stats_add(&stats, flags->ol_flags,
+				vgetq_lane_u16(vreinterpretq_u16_u8(desc), 2));
+			rx_pkts[nb_rx + i] = mbuf;
+		}
+
+		ena_rx_vec_consume(rx_ring, n);
+		nb_rx += n;
+		if (n < ENA_RX_VEC_DESCS)
+			break;
+	}
+
+	return ena_rx_vec_finish(rx_ring, rx_pkts, nb_pkts, nb_rx,
+		next_to_clean, &stats);
+}
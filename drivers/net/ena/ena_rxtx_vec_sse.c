@@ -0,0 +1,135 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_vect.h>
+
+#include "ena_rxtx_vec_common.h"
+
+/*
+ * Receive single buffer packets,
+ * parsing 4 completion descriptors of a cache line together.
+ */
+uint16_t
+ena_recv_pkts_vec(void *rx_queue, struct rte_mbuf **rx_pkts, uint16_t nb_pkts)
+{
+	struct ena_ring *rx_ring = rx_queue;
+	struct ena_com_io_cq *io_cq = rx_ring->ena_com_io_cq;
+	const struct ena_eth_io_rx_cdesc_base *cdesc;
+	struct ena_rx_vec_stats stats = { 0 };
+	uint16_t next_to_clean = rx_ring->next_to_clean;
+	uint64_t ol_mask = (rx_ring->offloads & RTE_ETH_RX_OFFLOAD_RSS_HASH) ?
+		UINT64_MAX : ~RTE_MBUF_F_RX_RSS_HASH;
+	uint32_t keys[ENA_RX_VEC_DESCS];
+	uint16_t nb_rx = 0;
+	unsigned int i, n;
+
+	/* length, length and hash, packet type inserted from the table */
+	const __m128i fields_shuf = _mm_set_epi8(11, 10, 9, 8,
+		-1, -1, 5, 4, -1, -1, 5, 4, -1, -1, -1, -1);
+	const __m128i check_mask = _mm_set1_epi32(ENA_RX_VEC_STATUS_CHECK);
+	const __m128i l3_mask = _mm_set1_epi32(ENA_ETH_IO_RX_CDESC_BASE_L3_PROTO_IDX_MASK);
+	const __m128i l4_mask = _mm_set1_epi32(ENA_ETH_IO_RX_CDESC_BASE_L4_PROTO_IDX_MASK);
+	const __m128i status_mask = _mm_set1_epi32(ENA_RX_VEC_STATUS_MASK);
+	const __m128i q_depth = _mm_set1_epi32(io_cq->q_depth);
+
+	/* mbuf fields stored together from the completion descriptor */
+	RTE_BUILD_BUG_ON(offsetof(struct rte_mbuf, pkt_len) !=
+			 offsetof(struct rte_mbuf, rx_descriptor_fields1) + 4);
+	RTE_BUILD_BUG_ON(offsetof(struct rte_mbuf, data_len) !=
+			 offsetof(struct rte_mbuf, rx_descriptor_fields1) + 8);
+	RTE_BUILD_BUG_ON(offsetof(struct rte_mbuf, hash) !=
+			 offsetof(struct rte_mbuf, rx_descriptor_fields1) + 12);
+	RTE_BUILD_BUG_ON(sizeof(struct ena_eth_io_rx_cdesc_base) != 16);
+
+	while (nb_rx < nb_pkts) {
+		__m128i d0, d1, d2, d3, s01, s23, status, lr, key, ok;
+		__m128i expected;
+
+		cdesc = ena_rx_vec_cdescs(io_cq);
+		if (unlikely(cdesc == NULL))
+			break;
+
+		expected = _mm_set1_epi32(ENA_RX_VEC_STATUS_SINGLE |
+			((uint32_t)io_cq->phase << ENA_ETH_IO_RX_CDESC_BASE_PHASE_SHIFT));
+
+		/* Statuses are read before the rest of the descriptors */
+		d0 = _mm_loadu_si128((const __m128i *)&cdesc[0]);
+		d1 = _mm_loadu_si128((const __m128i *)&cdesc[1]);
+		d2 = _mm_loadu_si128((const __m128i *)&cdesc[2]);
+		d3 = _mm_loadu_si128((const __m128i *)&cdesc[3]);
+		s01 = _mm_unpacklo_epi32(d0, d1);
+		s23 = _mm_unpacklo_epi32(d2, d3);
+		status = _mm_unpacklo_epi64(s01, s23);
+
+		rte_io_rmb();
+
+		d0 = _mm_loadu_si128((const __m128i *)&cdesc[0]);
+		d1 = _mm_loadu_si128((const __m128i *)&cdesc[1]);
+		d2 = _mm_loadu_si128((const __m128i *)&cdesc[2]);
+		d3 = _mm_loadu_si128((const __m128i *)&cdesc[3]);
+		s01 = _mm_unpacklo_epi32(d0, d1);
+		s23 = _mm_unpacklo_epi32(d2, d3);
+		/* length and request id */
+		lr = _mm_unpackhi_epi64(s01, s23);
+
+		/* completed single buffer packets with a valid request id */
+		ok = _mm_cmpeq_epi32(_mm_and_si128(status, check_mask), expected);
+		ok = _mm_and_si128(ok, _mm_cmpgt_epi32(q_depth,
+			_mm_srli_epi32(lr, 16)));
+		n = rte_ctz32(~_mm_movemask_ps(_mm_castsi128_ps(ok)));
+		n = RTE_MIN(n, (unsigned int)(nb_pkts - nb_rx));
+		if (n == 0)
+			break;
+
+		/* index of the flags of each packet */
+		key = _mm_and_si128(_mm_srli_epi32(status, ENA_RX_VEC_STATUS_SHIFT),
+			status_mask);
+		key = _mm_or_si128(key, _mm_and_si128(_mm_set1_epi32(ENA_RX_VEC_IPV4),
+			_mm_cmpeq_epi32(_mm_and_si128(status, l3_mask),
+				_mm_set1_epi32(ENA_ETH_IO_L3_PROTO_IPV4))));
+		key = _mm_or_si128(key, _mm_and_si128(_mm_set1_epi32(ENA_RX_VEC_IPV6),
+			_mm_cmpeq_epi32(_mm_and_si128(status, l3_mask),
+				_mm_set1_epi32(ENA_ETH_IO_L3_PROTO_IPV6))));
+		key = _mm_or_si128(key, _mm_and_si128(_mm_set1_epi32(ENA_RX_VEC_TCP),
+			_mm_cmpeq_epi32(_mm_and_si128(status, l4_mask),
+				_mm_set1_epi32(ENA_ETH_IO_L4_PROTO_TCP <<
+					ENA_ETH_IO_RX_CDESC_BASE_L4_PROTO_IDX_SHIFT))));
+		key = _mm_or_si128(key, _mm_and_si128(_mm_set1_epi32(ENA_RX_VEC_UDP),
+			_mm_cmpeq_epi32(_mm_and_si128(status, l4_mask),
+				_mm_set1_epi32(ENA_ETH_IO_L4_PROTO_UDP <<
+					ENA_ETH_IO_RX_CDESC_BASE_L4_PROTO_IDX_SHIFT))));
+		_mm_storeu_si128((__m128i *)keys, key);
+
+		for (i = 0; i < n; i++) {
+			const struct ena_rx_vec_flags *flags =
+				&ena_rx_vec_flags_table[keys[i]];
+			struct rte_mbuf *mbuf;
+			__m128i d, fields;
+
+			d = i == 0 ? d0 : i == 1 ? d1 : i == 2 ? d2 : d3;
+			mbuf = ena_rx_vec_mbuf(rx_ring, _mm_extract_epi16(d, 3),
+				&next_to_clean);
+
+			mbuf->rearm_data[0] = rx_ring->mbuf_initializer +
+				_mm_extract_epi8(d, ENA_RX_VEC_OFFSET_BYTE);
+			fields = _mm_shuffle_epi8(d, fields_shuf);
+			fields = _mm_insert_epi32(fields, flags->packet_type, 0);
+			_mm_storeu_si128((__m128i *)mbuf->rx_descriptor_fields1,
+				fields);
+			mbuf->ol_flags = flags->ol_flags & ol_mask;
+
+			ena_rx_vec_stats_add(&stats, flags->ol_flags,
+				_mm_extract_epi16(d, 2));
+			rx_pkts[nb_rx + i] = mbuf;
+		}
+
+		ena_rx_vec_consume(rx_ring, n);
+		nb_rx += n;
+		if (n < ENA_RX_VEC_DESCS)
+			break;
+	}
+
+	return ena_rx_vec_finish(rx_ring, rx_pkts, nb_pkts, nb_rx,
+		next_to_clean, &stats);
+}
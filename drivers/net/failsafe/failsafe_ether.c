@@ -343,8 +343,15 @@ fs_dev_stats_save(struct sub_device *sdev)
 static inline int
 fs_rxtx_clean(struct sub_device *sdev)
 {
+	struct fs_priv *priv = PRIV(fs_dev(sdev));
 	uint16_t i;
 
+	/* Lockless bursts must be over before checking reference counters. */
+	if (priv->rcu_pending) {
+		if (rte_rcu_qsbr_check(priv->qsv, priv->rcu_token, false) != 1)
+			return 0;
+		priv->rcu_pending = 0;
+	}
 	for (i = 0; i < ETH(sdev)->data->nb_rx_queues; i++)
 		if (FS_ATOMIC_RX(sdev, i))
 			return 0;
@@ -16,6 +16,7 @@
 #include <rte_devargs.h>
 #include <rte_flow.h>
 #include <rte_interrupts.h>
+#include <rte_rcu_qsbr.h>
 
 #define FAILSAFE_DRIVER_NAME "Fail-safe PMD"
 #define FAILSAFE_OWNER_NAME "Fail-safe"
@@ -192,6 +193,16 @@ struct fs_priv {
 	unsigned int pending_alarm:1; /* An alarm is pending */
 	/* flow isolation state */
 	int flow_isolated:1;
+	/*
+	 * RCU QSBR variable of the application, the fast bursts do not use
+	 * the queue reference counters when set.
+	 */
+	struct rte_rcu_qsbr *qsv;
+	/* Emitting device loaded by the lockless Tx burst */
+	struct sub_device *tx_sdev;
+	/* Token of the grace period started when leaving lockless bursts */
+	uint64_t rcu_token;
+	unsigned int rcu_pending:1;
 };
 
 /* FAILSAFE_INTR */
@@ -220,6 +231,11 @@ uint16_t failsafe_rx_burst_fast(void *rxq,
 uint16_t failsafe_tx_burst_fast(void *txq,
 		struct rte_mbuf **tx_pkts, uint16_t nb_pkts);
 
+uint16_t failsafe_rx_burst_rcu(void *rxq,
+		struct rte_mbuf **rx_pkts, uint16_t nb_pkts);
+uint16_t failsafe_tx_burst_rcu(void *txq,
+		struct rte_mbuf **tx_pkts, uint16_t nb_pkts);
+
 /* ARGS */
 
 int failsafe_args_parse(struct rte_eth_dev *dev, const char *params);
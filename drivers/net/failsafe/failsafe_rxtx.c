@@ -3,12 +3,14 @@
  * Copyright 2017 Mellanox Technologies, Ltd
  */
 
+#include <eal_export.h>
 #include <rte_atomic.h>
 #include <rte_debug.h>
 #include <rte_mbuf.h>
 #include <ethdev_driver.h>
 
 #include "failsafe_private.h"
+#include "rte_pmd_failsafe.h"
 
 static inline int
 fs_rx_unsafe(struct sub_device *sdev)
@@ -31,11 +33,15 @@ fs_tx_unsafe(struct sub_device *sdev)
 void
 failsafe_set_burst_fn(struct rte_eth_dev *dev, int force_safe)
 {
+	struct fs_priv *priv = PRIV(dev);
 	struct sub_device *sdev;
 	uint8_t i;
 	int need_safe;
 	int safe_set;
+	int lockless;
 
+	lockless = (dev->rx_pkt_burst == &failsafe_rx_burst_rcu ||
+		    dev->tx_pkt_burst == &failsafe_tx_burst_rcu);
 	need_safe = force_safe;
 	FOREACH_SUBDEV(sdev, i, dev)
 		need_safe |= fs_rx_unsafe(sdev);
@@ -45,8 +51,10 @@ failsafe_set_burst_fn(struct rte_eth_dev *dev, int force_safe)
 		      (force_safe ? " (forced)" : ""));
 		dev->rx_pkt_burst = &failsafe_rx_burst;
 	} else if (!need_safe && safe_set) {
-		DEBUG("Using fast RX bursts");
-		dev->rx_pkt_burst = &failsafe_rx_burst_fast;
+		DEBUG("Using fast RX bursts%s",
+		      (priv->qsv != NULL ? " (lockless)" : ""));
+		dev->rx_pkt_burst = priv->qsv != NULL ?
+			&failsafe_rx_burst_rcu : &failsafe_rx_burst_fast;
 	}
 	need_safe = force_safe || fs_tx_unsafe(TX_SUBDEV(dev));
 	safe_set = (dev->tx_pkt_burst == &failsafe_tx_burst);
@@ -55,10 +63,51 @@ failsafe_set_burst_fn(struct rte_eth_dev *dev, int force_safe)
 		      (force_safe ? " (forced)" : ""));
 		dev->tx_pkt_burst = &failsafe_tx_burst;
 	} else if (!need_safe && safe_set) {
-		DEBUG("Using fast TX bursts");
-		dev->tx_pkt_burst = &failsafe_tx_burst_fast;
+		DEBUG("Using fast TX bursts%s",
+		      (priv->qsv != NULL ? " (lockless)" : ""));
+		dev->tx_pkt_burst = priv->qsv != NULL ?
+			&failsafe_tx_burst_rcu : &failsafe_tx_burst_fast;
+	}
+	priv->tx_sdev = TX_SUBDEV(dev);
+	/* Bursts may be switched while the port is running. */
+	if (dev->data->dev_started) {
+		rte_eth_fp_ops[dev->data->port_id].rx_pkt_burst =
+			dev->rx_pkt_burst;
+		rte_eth_fp_ops[dev->data->port_id].tx_pkt_burst =
+			dev->tx_pkt_burst;
 	}
 	rte_wmb();
+	/*
+	 * The lockless bursts do not take the reference counters,
+	 * a sub-device cannot be removed before they are all over.
+	 */
+	if (lockless && (dev->rx_pkt_burst != &failsafe_rx_burst_rcu ||
+			 dev->tx_pkt_burst != &failsafe_tx_burst_rcu)) {
+		priv->rcu_token = rte_rcu_qsbr_start(priv->qsv);
+		priv->rcu_pending = 1;
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pmd_failsafe_rcu_qsbr_add, 26.03)
+int
+rte_pmd_failsafe_rcu_qsbr_add(uint16_t port_id, struct rte_rcu_qsbr *v)
+{
+	struct rte_eth_dev *dev;
+	struct fs_priv *priv;
+
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, -ENODEV);
+	dev = &rte_eth_devices[port_id];
+	if (dev->dev_ops != &failsafe_ops)
+		return -ENODEV;
+	if (v == NULL)
+		return -EINVAL;
+	priv = PRIV(dev);
+	if (priv->qsv != NULL)
+		return -EEXIST;
+	if (dev->data->dev_started)
+		return -EBUSY;
+	priv->qsv = v;
+	return 0;
 }
 
 /*
@@ -136,6 +185,37 @@ failsafe_rx_burst_fast(void *queue,
 	return nb_rx;
 }
 
+/*
+ * Same as failsafe_rx_burst_fast(), without reference counting.
+ * Sub-devices are released only after a grace period of the
+ * RCU QSBR variable, once the safe bursts are in use.
+ */
+uint16_t
+failsafe_rx_burst_rcu(void *queue,
+		      struct rte_mbuf **rx_pkts,
+		      uint16_t nb_pkts)
+{
+	struct sub_device *sdev;
+	struct rxq *rxq;
+	void *sub_rxq;
+	uint16_t nb_rx;
+
+	rxq = queue;
+	sdev = rxq->sdev;
+	do {
+		RTE_ASSERT(!fs_rx_unsafe(sdev));
+		sub_rxq = ETH(sdev)->data->rx_queues[rxq->qid];
+		nb_rx = ETH(sdev)->
+			rx_pkt_burst(sub_rxq, rx_pkts, nb_pkts);
+		sdev = sdev->next;
+	} while (nb_rx == 0 && sdev != rxq->sdev);
+	rxq->sdev = sdev;
+	if (nb_rx)
+		failsafe_rx_set_port(rx_pkts, nb_rx,
+				     rxq->priv->data->port_id);
+	return nb_rx;
+}
+
 uint16_t
 failsafe_tx_burst(void *queue,
 		  struct rte_mbuf **tx_pkts,
@@ -176,3 +256,23 @@ failsafe_tx_burst_fast(void *queue,
 	FS_ATOMIC_V(txq->refcnt[sdev->sid]);
 	return nb_tx;
 }
+
+/*
+ * Same as failsafe_tx_burst_fast(), without reference counting,
+ * the emitting device is loaded from its published pointer.
+ */
+uint16_t
+failsafe_tx_burst_rcu(void *queue,
+		      struct rte_mbuf **tx_pkts,
+		      uint16_t nb_pkts)
+{
+	struct sub_device *sdev;
+	struct txq *txq;
+	void *sub_txq;
+
+	txq = queue;
+	sdev = txq->priv->tx_sdev;
+	RTE_ASSERT(!fs_tx_unsafe(sdev));
+	sub_txq = ETH(sdev)->data->tx_queues[txq->qid];
+	return ETH(sdev)->tx_pkt_burst(sub_txq, tx_pkts, nb_pkts);
+}
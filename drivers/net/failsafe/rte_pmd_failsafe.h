@@ -0,0 +1,53 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_PMD_FAILSAFE_H_
+#define _RTE_PMD_FAILSAFE_H_
+
+/**
+ * @file
+ * Fail-safe PMD specific functions.
+ */
+
+#include <stdint.h>
+
+#include <rte_compat.h>
+#include <rte_rcu_qsbr.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Associate an RCU QSBR variable with a fail-safe port.
+ *
+ * Once associated, the Rx and Tx bursts of the port no longer mark
+ * their use of a sub-device in each call, they only load its pointer.
+ * On sub-device removal, the fail-safe PMD waits for a grace period of
+ * the QSBR variable before releasing the sub-device.
+ * All the threads calling the Rx and Tx bursts of the port must be
+ * registered to the QSBR variable and report their quiescent states.
+ *
+ * @param port_id
+ *   Port identifier of the fail-safe device, which must be stopped.
+ * @param v
+ *   RCU QSBR variable, which must stay valid until the port is closed.
+ * @return
+ *   - 0 on success.
+ *   - -ENODEV if the port is not a fail-safe device.
+ *   - -EINVAL if the QSBR variable is NULL.
+ *   - -EEXIST if a QSBR variable is already associated.
+ *   - -EBUSY if the port is started.
+ */
+__rte_experimental
+int rte_pmd_failsafe_rcu_qsbr_add(uint16_t port_id, struct rte_rcu_qsbr *v);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_PMD_FAILSAFE_H_ */
@@ -419,6 +419,9 @@ gve_dev_start(struct rte_eth_dev *dev)
 	gve_link_update(dev, 0);
 
 	priv = dev->data->dev_private;
+	/* The Rx burst depends on the configured offloads */
+	if (!gve_is_gqi(priv))
+		gve_set_rx_function_dqo(dev);
 	/* No stats available yet for Dqo. */
 	if (gve_is_gqi(priv)) {
 		ret = gve_alloc_stats_report(priv,
@@ -635,6 +638,13 @@ gve_dev_info_get(struct rte_eth_dev *dev, struct rte_eth_dev_info *dev_info)
 				RTE_ETH_RX_OFFLOAD_UDP_CKSUM	|
 				RTE_ETH_RX_OFFLOAD_TCP_CKSUM	|
 				RTE_ETH_RX_OFFLOAD_TCP_LRO;
+		if (priv->header_buf_size != 0) {
+			dev_info->rx_offload_capa |=
+				RTE_ETH_RX_OFFLOAD_BUFFER_SPLIT;
+			/* headers split by the device, payload in another pool */
+			dev_info->rx_seg_capa.max_nseg = 2;
+			dev_info->rx_seg_capa.multi_pools = 1;
+		}
 	}
 
 	dev_info->default_rxconf = (struct rte_eth_rxconf) {
@@ -1113,6 +1123,7 @@ static const struct eth_dev_ops gve_eth_dev_ops_dqo = {
 	.rss_hash_conf_get    = gve_rss_hash_conf_get,
 	.reta_update          = gve_rss_reta_update,
 	.reta_query           = gve_rss_reta_query,
+	.recycle_rxq_info_get = gve_recycle_rxq_info_get_dqo,
 };
 
 static int
@@ -1182,6 +1193,7 @@ gve_setup_device_resources(struct gve_priv *priv)
 			PMD_DRV_LOG(ERR, "Failed to get ptype map: err=%d", err);
 			goto free_ptype_lut;
 		}
+		gve_set_mbuf_ptype_lut_dqo(priv);
 	}
 
 	gve_set_device_resources_ok(priv);
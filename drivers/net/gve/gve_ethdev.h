@@ -249,6 +249,22 @@ struct gve_rx_queue {
 	/* Only valid for DQO_RDA queue format */
 	struct gve_rx_queue *bufq;
 
+	/* Header split buffers, indexed by buffer ID */
+	struct rte_mempool *hdr_mpool;
+	struct rte_mbuf **hdr_sw_ring;
+
+	/*
+	 * Mbufs given back by a Tx queue through rte_eth_recycle_mbufs(),
+	 * posted to the buffer queue right away.
+	 * The head is always 0, the tail is the number of buffers to post.
+	 */
+	struct rte_mbuf **recycle_ring;
+	uint16_t recycle_head;
+	uint16_t recycle_tail;
+
+	/* Rearm data of the received mbufs */
+	uint64_t mbuf_initializer;
+
 	uint8_t is_gqi_qpl;
 };
 
@@ -332,6 +348,11 @@ struct gve_priv {
 
 	struct gve_rss_config rss_config;
 	struct gve_ptype_lut *ptype_lut_dqo;
+	/* mbuf packet types of the DQO packet types */
+	uint32_t mbuf_ptype_lut_dqo[GVE_NUM_PTYPES];
+
+	/* Size of the DQO header split buffers, 0 if not supported */
+	uint16_t header_buf_size;
 };
 
 static inline bool
@@ -404,6 +425,24 @@ gve_clear_device_rings_ok(struct gve_priv *priv)
 				&priv->state_flags);
 }
 
+/* Assumes buf_id < nb_rx_desc */
+static inline void
+gve_completed_buf_list_push(struct gve_rx_queue *rxq, uint16_t buf_id)
+{
+	rxq->completed_buf_list[buf_id] = rxq->completed_buf_list_head;
+	rxq->completed_buf_list_head = buf_id;
+}
+
+static inline int16_t
+gve_completed_buf_list_pop(struct gve_rx_queue *rxq)
+{
+	int16_t head = rxq->completed_buf_list_head;
+	if (head != -1)
+		rxq->completed_buf_list_head = rxq->completed_buf_list[head];
+
+	return head;
+}
+
 int
 gve_rx_queue_setup(struct rte_eth_dev *dev, uint16_t queue_id, uint16_t nb_desc,
 		   unsigned int socket_id, const struct rte_eth_rxconf *conf,
@@ -494,6 +533,26 @@ gve_stop_rx_queues_dqo(struct rte_eth_dev *dev);
 uint16_t
 gve_rx_burst_dqo(void *rxq, struct rte_mbuf **rx_pkts, uint16_t nb_pkts);
 
+uint16_t
+gve_rx_burst_dqo_vec(void *rxq, struct rte_mbuf **rx_pkts, uint16_t nb_pkts);
+
+void
+gve_rx_refill_dqo(struct gve_rx_queue *rxq);
+
+void
+gve_set_mbuf_ptype_lut_dqo(struct gve_priv *priv);
+
+void
+gve_recycle_rxq_info_get_dqo(struct rte_eth_dev *dev, uint16_t queue_id,
+			     struct rte_eth_recycle_rxq_info *recycle_rxq_info);
+
+void
+gve_recycle_rx_descriptors_refill_dqo(void *rxq, uint16_t nb_mbufs);
+
+uint16_t
+gve_recycle_tx_mbufs_reuse_dqo(void *txq,
+			       struct rte_eth_recycle_rxq_info *recycle_rxq_info);
+
 uint16_t
 gve_tx_burst_dqo(void *txq, struct rte_mbuf **tx_pkts, uint16_t nb_pkts);
 
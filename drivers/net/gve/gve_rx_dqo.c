@@ -8,6 +8,20 @@
 #include "base/gve_adminq.h"
 #include "rte_mbuf_ptype.h"
 #include "rte_atomic.h"
+#include <rte_vect.h>
+
+static inline uint64_t
+gve_rx_mbuf_initializer_dqo(uint16_t port_id)
+{
+	struct rte_mbuf mb_def = { .buf_addr = 0 };
+
+	mb_def.nb_segs = 1;
+	mb_def.data_off = RTE_PKTMBUF_HEADROOM;
+	mb_def.port = port_id;
+	rte_mbuf_refcnt_set(&mb_def, 1);
+
+	return mb_def.rearm_data[0];
+}
 
 static inline void
 gve_completed_buf_list_init(struct gve_rx_queue *rxq)
@@ -18,39 +32,63 @@ gve_completed_buf_list_init(struct gve_rx_queue *rxq)
 	rxq->completed_buf_list_head = -1;
 }
 
-/* Assumes buf_id < nb_rx_desc */
-static inline void
-gve_completed_buf_list_push(struct gve_rx_queue *rxq, uint16_t buf_id)
+/*
+ * Post a buffer at the given index of the buffer queue,
+ * with a header buffer if the header split is enabled.
+ * Returns -1 if no header buffer can be allocated.
+ */
+static inline int
+gve_rx_post_buf_dqo(struct gve_rx_queue *rxq, uint16_t idx, uint16_t buf_id,
+		    struct rte_mbuf *nmb)
 {
-	rxq->completed_buf_list[buf_id] = rxq->completed_buf_list_head;
-	rxq->completed_buf_list_head = buf_id;
+	volatile struct gve_rx_desc_dqo *rx_buf_desc = &rxq->rx_ring[idx];
+	struct rte_mbuf *hdr = NULL;
+
+	if (rxq->hdr_mpool != NULL) {
+		/* The header buffer is kept while no header is written in it */
+		hdr = rxq->hdr_sw_ring[buf_id];
+		if (hdr == NULL) {
+			hdr = rte_pktmbuf_alloc(rxq->hdr_mpool);
+			if (unlikely(hdr == NULL))
+				return -1;
+			rxq->hdr_sw_ring[buf_id] = hdr;
+		}
+	}
+
+	rxq->sw_ring[buf_id] = nmb;
+	rx_buf_desc->buf_id = rte_cpu_to_le_16(buf_id);
+	rx_buf_desc->header_buf_addr = hdr == NULL ? 0 :
+		rte_cpu_to_le_64(rte_mbuf_data_iova_default(hdr));
+	rx_buf_desc->buf_addr =
+		rte_cpu_to_le_64(rte_mbuf_data_iova_default(nmb));
+
+	return 0;
 }
 
-static inline int16_t
-gve_completed_buf_list_pop(struct gve_rx_queue *rxq)
+static void
+gve_rx_hdr_alloc_failed_dqo(struct gve_rx_queue *rxq, uint16_t buf_id)
 {
-	int16_t head = rxq->completed_buf_list_head;
-	if (head != -1)
-		rxq->completed_buf_list_head = rxq->completed_buf_list[head];
-
-	return head;
+	gve_completed_buf_list_push(rxq, buf_id);
+	rxq->stats.no_mbufs++;
+	rte_eth_devices[rxq->port_id].data->rx_mbuf_alloc_failed++;
+	PMD_DRV_DP_LOG(DEBUG, "RX header mbuf alloc failed port_id=%u queue_id=%u",
+		       rxq->port_id, rxq->queue_id);
 }
 
-static inline void
+void
 gve_rx_refill_dqo(struct gve_rx_queue *rxq)
 {
-	volatile struct gve_rx_desc_dqo *rx_buf_desc;
 	struct rte_mbuf *new_bufs[rxq->nb_rx_desc];
 	uint16_t rx_mask = rxq->nb_rx_desc - 1;
 	uint16_t next_avail = rxq->bufq_tail;
 	struct rte_eth_dev *dev;
 	uint16_t nb_refill;
-	uint64_t dma_addr;
 	int16_t buf_id;
 	int diag;
 	int i;
 
 	nb_refill = rxq->nb_rx_hold;
+	rxq->recycle_tail = nb_refill;
 	if (nb_refill < rxq->free_thresh)
 		return;
 
@@ -68,7 +106,6 @@ gve_rx_refill_dqo(struct gve_rx_queue *rxq)
 
 	/* Mbuf allocation succeeded, so refill buffers. */
 	for (i = 0; i < nb_refill; i++) {
-		rx_buf_desc = &rxq->rx_ring[next_avail];
 		buf_id = gve_completed_buf_list_pop(rxq);
 
 		/* Out of buffers. Free remaining mbufs and return. */
@@ -80,16 +117,19 @@ gve_rx_refill_dqo(struct gve_rx_queue *rxq)
 			nb_refill = i;
 			break;
 		}
-		rxq->sw_ring[buf_id] = new_bufs[i];
-		dma_addr = rte_cpu_to_le_64(rte_mbuf_data_iova_default(new_bufs[i]));
-		rx_buf_desc->buf_id = buf_id;
-		rx_buf_desc->header_buf_addr = 0;
-		rx_buf_desc->buf_addr = dma_addr;
+		if (unlikely(gve_rx_post_buf_dqo(rxq, next_avail, buf_id,
+						 new_bufs[i]) < 0)) {
+			gve_rx_hdr_alloc_failed_dqo(rxq, buf_id);
+			rte_pktmbuf_free_bulk(new_bufs + i, nb_refill - i);
+			nb_refill = i;
+			break;
+		}
 
 		next_avail = (next_avail + 1) & rx_mask;
 	}
 
 	rxq->nb_rx_hold -= nb_refill;
+	rxq->recycle_tail = rxq->nb_rx_hold;
 	rte_write32(next_avail, rxq->qrx_tail);
 	rxq->bufq_tail = next_avail;
 }
@@ -116,41 +156,73 @@ gve_parse_csum_ol_flags(struct rte_mbuf *rx_mbuf,
 		rx_mbuf->ol_flags |= RTE_MBUF_F_RX_L4_CKSUM_GOOD;
 }
 
-static inline void
-gve_rx_set_mbuf_ptype(struct gve_priv *priv, struct rte_mbuf *rx_mbuf,
-		      volatile struct gve_rx_compl_desc_dqo *rx_desc)
+/* Translate the packet type map of the device to mbuf packet types */
+void
+gve_set_mbuf_ptype_lut_dqo(struct gve_priv *priv)
 {
-	struct gve_ptype ptype =
-		priv->ptype_lut_dqo->ptypes[rx_desc->packet_type];
-	rx_mbuf->packet_type = 0;
-
-	switch (ptype.l3_type) {
-	case GVE_L3_TYPE_IPV4:
-		rx_mbuf->packet_type |= RTE_PTYPE_L3_IPV4;
-		break;
-	case GVE_L3_TYPE_IPV6:
-		rx_mbuf->packet_type |= RTE_PTYPE_L3_IPV6;
-		break;
-	default:
-		break;
+	struct gve_ptype ptype;
+	uint32_t packet_type;
+	int i;
+
+	for (i = 0; i < GVE_NUM_PTYPES; i++) {
+		ptype = priv->ptype_lut_dqo->ptypes[i];
+		packet_type = 0;
+
+		switch (ptype.l3_type) {
+		case GVE_L3_TYPE_IPV4:
+			packet_type |= RTE_PTYPE_L3_IPV4;
+			break;
+		case GVE_L3_TYPE_IPV6:
+			packet_type |= RTE_PTYPE_L3_IPV6;
+			break;
+		default:
+			break;
+		}
+
+		switch (ptype.l4_type) {
+		case GVE_L4_TYPE_TCP:
+			packet_type |= RTE_PTYPE_L4_TCP;
+			break;
+		case GVE_L4_TYPE_UDP:
+			packet_type |= RTE_PTYPE_L4_UDP;
+			break;
+		case GVE_L4_TYPE_ICMP:
+			packet_type |= RTE_PTYPE_L4_ICMP;
+			break;
+		case GVE_L4_TYPE_SCTP:
+			packet_type |= RTE_PTYPE_L4_SCTP;
+			break;
+		default:
+			break;
+		}
+
+		priv->mbuf_ptype_lut_dqo[i] = packet_type;
 	}
+}
 
-	switch (ptype.l4_type) {
-	case GVE_L4_TYPE_TCP:
-		rx_mbuf->packet_type |= RTE_PTYPE_L4_TCP;
-		break;
-	case GVE_L4_TYPE_UDP:
-		rx_mbuf->packet_type |= RTE_PTYPE_L4_UDP;
-		break;
-	case GVE_L4_TYPE_ICMP:
-		rx_mbuf->packet_type |= RTE_PTYPE_L4_ICMP;
-		break;
-	case GVE_L4_TYPE_SCTP:
-		rx_mbuf->packet_type |= RTE_PTYPE_L4_SCTP;
-		break;
-	default:
-		break;
+/*
+ * Chain the header buffer of a split packet before its payload buffer.
+ * Returns the first segment of the packet.
+ */
+static inline struct rte_mbuf *
+gve_rx_split_header_dqo(struct gve_rx_queue *rxq, uint16_t buf_id,
+			struct rte_mbuf *rxm, uint16_t hdr_len)
+{
+	struct rte_mbuf *hdr = rxq->hdr_sw_ring[buf_id];
+
+	rxq->hdr_sw_ring[buf_id] = NULL;
+	hdr->data_len = hdr_len;
+	hdr->pkt_len = hdr_len + rxm->data_len;
+	hdr->port = rxq->port_id;
+
+	if (rxm->data_len == 0) {
+		rte_pktmbuf_free_seg(rxm);
+		return hdr;
 	}
+
+	hdr->next = rxm;
+	hdr->nb_segs = 2;
+	return hdr;
 }
 
 uint16_t
@@ -197,11 +269,20 @@ gve_rx_burst_dqo(void *rx_queue, struct rte_mbuf **rx_pkts, uint16_t nb_pkts)
 			continue;
 		}
 
+		/* Recycled mbufs may have another data offset */
+		rxm->rearm_data[0] = rxq->mbuf_initializer;
 		pkt_len = rte_le_to_cpu_16(rx_desc->packet_len);
 		rxm->pkt_len = pkt_len;
 		rxm->data_len = pkt_len;
 		rxm->port = rxq->port_id;
-		gve_rx_set_mbuf_ptype(rxq->hw, rxm, rx_desc);
+		if (rxq->hdr_mpool != NULL && rx_desc->split_header &&
+		    rx_desc->header_len != 0) {
+			pkt_len += rx_desc->header_len;
+			rxm = gve_rx_split_header_dqo(rxq, rx_buf_id, rxm,
+						      rx_desc->header_len);
+		}
+		rxm->packet_type =
+			rxq->hw->mbuf_ptype_lut_dqo[rx_desc->packet_type];
 		rxm->ol_flags = RTE_MBUF_F_RX_RSS_HASH;
 		gve_parse_csum_ol_flags(rxm, rx_desc);
 		rxm->hash.rss = rte_le_to_cpu_32(rx_desc->hash);
@@ -231,6 +312,10 @@ gve_release_rxq_mbufs_dqo(struct gve_rx_queue *rxq)
 			rte_pktmbuf_free_seg(rxq->sw_ring[i]);
 			rxq->sw_ring[i] = NULL;
 		}
+		if (rxq->hdr_sw_ring != NULL && rxq->hdr_sw_ring[i]) {
+			rte_pktmbuf_free_seg(rxq->hdr_sw_ring[i]);
+			rxq->hdr_sw_ring[i] = NULL;
+		}
 	}
 
 	rxq->nb_avail = rxq->nb_rx_desc;
@@ -246,6 +331,8 @@ gve_rx_queue_release_dqo(struct rte_eth_dev *dev, uint16_t qid)
 
 	gve_release_rxq_mbufs_dqo(q);
 	rte_free(q->sw_ring);
+	rte_free(q->hdr_sw_ring);
+	rte_free(q->recycle_ring);
 	rte_free(q->completed_buf_list);
 	rte_memzone_free(q->compl_ring_mz);
 	rte_memzone_free(q->mz);
@@ -282,10 +369,47 @@ gve_reset_rx_ring_state_dqo(struct gve_rx_queue *rxq)
 	rxq->bufq_tail = 0;
 	rxq->nb_rx_hold = rxq->nb_rx_desc - 1;
 
+	rxq->recycle_head = 0;
+	rxq->recycle_tail = 0;
+
 	rxq->rx_tail = 0;
 	rxq->cur_gen_bit = 1;
 }
 
+/*
+ * Check the buffer split configuration:
+ * headers in the first mempool, payloads in the second one.
+ */
+static int
+gve_rx_buffer_split_check_dqo(struct gve_priv *hw,
+			      const struct rte_eth_rxconf *conf)
+{
+	const struct rte_eth_rxseg_split *seg;
+
+	if (hw->header_buf_size == 0) {
+		PMD_DRV_LOG(ERR, "Header split is not supported by the device");
+		return -ENOTSUP;
+	}
+	if (conf->rx_nseg != 2) {
+		PMD_DRV_LOG(ERR, "Buffer split requires 2 segments, %u given",
+			    conf->rx_nseg);
+		return -EINVAL;
+	}
+	seg = &conf->rx_seg[0].split;
+	if (seg->mp == NULL || conf->rx_seg[1].split.mp == NULL) {
+		PMD_DRV_LOG(ERR, "Buffer split requires a mempool per segment");
+		return -EINVAL;
+	}
+	if (rte_pktmbuf_data_room_size(seg->mp) - RTE_PKTMBUF_HEADROOM <
+	    hw->header_buf_size) {
+		PMD_DRV_LOG(ERR, "Header mbufs must hold %u bytes",
+			    hw->header_buf_size);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
 int
 gve_rx_queue_setup_dqo(struct rte_eth_dev *dev, uint16_t queue_id,
 		       uint16_t nb_desc, unsigned int socket_id,
@@ -295,10 +419,21 @@ gve_rx_queue_setup_dqo(struct rte_eth_dev *dev, uint16_t queue_id,
 	struct gve_priv *hw = dev->data->dev_private;
 	const struct rte_memzone *mz;
 	struct gve_rx_queue *rxq;
+	struct rte_mempool *hdr_pool = NULL;
 	uint16_t free_thresh;
 	uint32_t mbuf_len;
+	uint64_t offloads;
 	int err = 0;
 
+	offloads = conf->offloads | dev->data->dev_conf.rxmode.offloads;
+	if (offloads & RTE_ETH_RX_OFFLOAD_BUFFER_SPLIT) {
+		err = gve_rx_buffer_split_check_dqo(hw, conf);
+		if (err != 0)
+			return err;
+		hdr_pool = conf->rx_seg[0].split.mp;
+		pool = conf->rx_seg[1].split.mp;
+	}
+
 	/* Free memory if needed */
 	if (dev->data->rx_queues[queue_id]) {
 		gve_rx_queue_release_dqo(dev, queue_id);
@@ -332,6 +467,8 @@ gve_rx_queue_setup_dqo(struct rte_eth_dev *dev, uint16_t queue_id,
 	rxq->ntfy_id = hw->num_ntfy_blks / 2 + queue_id;
 
 	rxq->mpool = pool;
+	rxq->hdr_mpool = hdr_pool;
+	rxq->mbuf_initializer = gve_rx_mbuf_initializer_dqo(rxq->port_id);
 	rxq->hw = hw;
 	rxq->ntfy_addr = &hw->db_bar2[rte_be_to_cpu_32(hw->irq_dbs[rxq->ntfy_id].id)];
 
@@ -361,6 +498,27 @@ gve_rx_queue_setup_dqo(struct rte_eth_dev *dev, uint16_t queue_id,
 		goto free_rxq_sw_ring;
 	}
 
+	/* Allocate the ring of the mbufs recycled from Tx */
+	rxq->recycle_ring = rte_zmalloc_socket("gve rx recycle ring",
+					       nb_desc * sizeof(struct rte_mbuf *),
+					       RTE_CACHE_LINE_SIZE, socket_id);
+	if (rxq->recycle_ring == NULL) {
+		PMD_DRV_LOG(ERR, "Failed to allocate memory for Rx recycle ring");
+		err = -ENOMEM;
+		goto free_rxq_completed_buf_list;
+	}
+
+	if (hdr_pool != NULL) {
+		rxq->hdr_sw_ring = rte_zmalloc_socket("gve rx hdr sw ring",
+						      nb_desc * sizeof(struct rte_mbuf *),
+						      RTE_CACHE_LINE_SIZE, socket_id);
+		if (rxq->hdr_sw_ring == NULL) {
+			PMD_DRV_LOG(ERR, "Failed to allocate memory for Rx header ring");
+			err = -ENOMEM;
+			goto free_rxq_recycle_ring;
+		}
+	}
+
 	/* Allocate RX buffer queue */
 	mz = rte_eth_dma_zone_reserve(dev, "rx_ring", queue_id,
 				      nb_desc * sizeof(struct gve_rx_desc_dqo),
@@ -368,7 +526,7 @@ gve_rx_queue_setup_dqo(struct rte_eth_dev *dev, uint16_t queue_id,
 	if (mz == NULL) {
 		PMD_DRV_LOG(ERR, "Failed to reserve DMA memory for RX buffer queue");
 		err = -ENOMEM;
-		goto free_rxq_completed_buf_list;
+		goto free_rxq_hdr_sw_ring;
 	}
 	rxq->rx_ring = (struct gve_rx_desc_dqo *)mz->addr;
 	rxq->rx_ring_phys_addr = mz->iova;
@@ -410,6 +568,10 @@ gve_rx_queue_setup_dqo(struct rte_eth_dev *dev, uint16_t queue_id,
 	rte_memzone_free(rxq->compl_ring_mz);
 free_rxq_mz:
 	rte_memzone_free(rxq->mz);
+free_rxq_hdr_sw_ring:
+	rte_free(rxq->hdr_sw_ring);
+free_rxq_recycle_ring:
+	rte_free(rxq->recycle_ring);
 free_rxq_completed_buf_list:
 	rte_free(rxq->completed_buf_list);
 free_rxq_sw_ring:
@@ -445,12 +607,16 @@ gve_rxq_mbufs_alloc_dqo(struct gve_rx_queue *rxq)
 
 	for (i = 0; i < rx_mask; i++) {
 		nmb = rxq->sw_ring[i];
-		rxq->rx_ring[i].buf_addr = rte_cpu_to_le_64(rte_mbuf_data_iova_default(nmb));
-		rxq->rx_ring[i].buf_id = rte_cpu_to_le_16(i);
+		if (gve_rx_post_buf_dqo(rxq, i, i, nmb) < 0) {
+			rxq->stats.no_mbufs++;
+			gve_release_rxq_mbufs_dqo(rxq);
+			return -ENOMEM;
+		}
 	}
 	rxq->rx_ring[rx_mask].buf_id = rte_cpu_to_le_16(rx_mask);
 
 	rxq->nb_rx_hold = 0;
+	rxq->recycle_tail = 0;
 	rxq->bufq_tail = rx_mask;
 
 	rte_write32(rxq->bufq_tail, rxq->qrx_tail);
@@ -520,8 +686,77 @@ gve_stop_rx_queues_dqo(struct rte_eth_dev *dev)
 			PMD_DRV_LOG(WARNING, "Fail to stop Rx queue %d", i);
 }
 
+void
+gve_recycle_rxq_info_get_dqo(struct rte_eth_dev *dev, uint16_t queue_id,
+			     struct rte_eth_recycle_rxq_info *recycle_rxq_info)
+{
+	struct gve_rx_queue *rxq = dev->data->rx_queues[queue_id];
+
+	recycle_rxq_info->mbuf_ring = rxq->recycle_ring;
+	recycle_rxq_info->mp = rxq->mpool;
+	recycle_rxq_info->mbuf_ring_size = rxq->nb_rx_desc;
+	recycle_rxq_info->receive_tail = &rxq->recycle_tail;
+	recycle_rxq_info->refill_requirement = 0;
+	recycle_rxq_info->refill_head = &rxq->recycle_head;
+}
+
+/*
+ * Post the mbufs recycled from a Tx queue, in place of new mbufs.
+ * They are at the start of the recycle ring, whose tail (the number of
+ * mbufs it can take) is the number of free buffer IDs.
+ */
+void
+gve_recycle_rx_descriptors_refill_dqo(void *rx_queue, uint16_t nb_mbufs)
+{
+	struct gve_rx_queue *rxq = rx_queue;
+	struct rte_mbuf **recycle_ring = rxq->recycle_ring;
+	uint16_t rx_mask = rxq->nb_rx_desc - 1;
+	uint16_t next_avail = rxq->bufq_tail;
+	int16_t buf_id;
+	uint16_t i;
+
+	for (i = 0; i < nb_mbufs; i++) {
+		buf_id = gve_completed_buf_list_pop(rxq);
+		if (unlikely(buf_id == -1)) {
+			rte_pktmbuf_free_bulk(recycle_ring + i, nb_mbufs - i);
+			break;
+		}
+		if (unlikely(gve_rx_post_buf_dqo(rxq, next_avail, buf_id,
+						 recycle_ring[i]) < 0)) {
+			gve_rx_hdr_alloc_failed_dqo(rxq, buf_id);
+			rte_pktmbuf_free_bulk(recycle_ring + i, nb_mbufs - i);
+			break;
+		}
+
+		next_avail = (next_avail + 1) & rx_mask;
+	}
+
+	rxq->nb_rx_hold -= i;
+	rxq->recycle_tail = rxq->nb_rx_hold;
+	rte_write32(next_avail, rxq->qrx_tail);
+	rxq->bufq_tail = next_avail;
+}
+
 void
 gve_set_rx_function_dqo(struct rte_eth_dev *dev)
 {
+	uint64_t offloads = dev->data->dev_conf.rxmode.offloads;
+
+	dev->recycle_rx_descriptors_refill = gve_recycle_rx_descriptors_refill_dqo;
+
+#ifdef RTE_ARCH_X86
+	/* Single buffer packets without header split */
+	if (!(offloads & (RTE_ETH_RX_OFFLOAD_BUFFER_SPLIT |
+			  RTE_ETH_RX_OFFLOAD_TCP_LRO)) &&
+	    rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_128) {
+		PMD_DRV_LOG(DEBUG, "Using vector Rx on port %u",
+			    dev->data->port_id);
+		dev->rx_pkt_burst = gve_rx_burst_dqo_vec;
+		return;
+	}
+#else
+	RTE_SET_USED(offloads);
+#endif
+
 	dev->rx_pkt_burst = gve_rx_burst_dqo;
 }
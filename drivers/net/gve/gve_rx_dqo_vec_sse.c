@@ -0,0 +1,182 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_vect.h>
+
+#include "gve_ethdev.h"
+
+/* Number of completion descriptors parsed together */
+#define GVE_RX_VEC_DESCS		4
+
+/* Bits of the 4 dwords of a completion descriptor */
+#define GVE_RX_VEC_ERR			RTE_BIT32(10)	/* dword 0 */
+#define GVE_RX_VEC_PTYPE_SHIFT		16		/* dword 0 */
+#define GVE_RX_VEC_PTYPE_MASK		0x3ff
+#define GVE_RX_VEC_LEN_MASK		0x3fff		/* dword 1 */
+#define GVE_RX_VEC_GEN_SHIFT		14		/* dword 1 */
+#define GVE_RX_VEC_EOP			RTE_BIT32(1)	/* dword 2 */
+#define GVE_RX_VEC_CSUM_SHIFT		3		/* dword 2 */
+#define GVE_RX_VEC_BUF_ID_MASK		0xffff		/* dword 3 */
+
+/*
+ * Index bits of gve_rx_vec_ol_flags:
+ * l3_l4_processed, csum_ip_err and csum_l4_err of the descriptor,
+ * then IPv4 and L4 packet types.
+ */
+#define GVE_RX_VEC_CSUM_MASK		0x7
+#define GVE_RX_VEC_IPV4			RTE_BIT32(3)
+#define GVE_RX_VEC_L4			RTE_BIT32(4)
+
+/* Same flags as gve_parse_csum_ol_flags() */
+#define GVE_RX_VEC_OL_FLAGS(k) (RTE_MBUF_F_RX_RSS_HASH | \
+	(!((k) & 1) ? 0 : \
+	 (!((k) & GVE_RX_VEC_IPV4) ? 0 : ((k) & 2) ? \
+		RTE_MBUF_F_RX_IP_CKSUM_BAD : RTE_MBUF_F_RX_IP_CKSUM_GOOD) | \
+	 (((k) & 4) ? RTE_MBUF_F_RX_L4_CKSUM_BAD : \
+	  ((k) & GVE_RX_VEC_L4) ? RTE_MBUF_F_RX_L4_CKSUM_GOOD : 0)))
+#define GVE_RX_VEC_OL_FLAGS4(k) \
+	GVE_RX_VEC_OL_FLAGS(k), GVE_RX_VEC_OL_FLAGS((k) + 1), \
+	GVE_RX_VEC_OL_FLAGS((k) + 2), GVE_RX_VEC_OL_FLAGS((k) + 3)
+
+static const uint64_t gve_rx_vec_ol_flags[] = {
+	GVE_RX_VEC_OL_FLAGS4(0), GVE_RX_VEC_OL_FLAGS4(4),
+	GVE_RX_VEC_OL_FLAGS4(8), GVE_RX_VEC_OL_FLAGS4(12),
+	GVE_RX_VEC_OL_FLAGS4(16), GVE_RX_VEC_OL_FLAGS4(20),
+	GVE_RX_VEC_OL_FLAGS4(24), GVE_RX_VEC_OL_FLAGS4(28),
+};
+
+/*
+ * Receive single buffer packets,
+ * parsing 4 completion descriptors together.
+ * Errors, multi-buffer packets and the descriptors at the end of
+ * the ring are left to the scalar Rx, which also refills the queue.
+ */
+uint16_t
+gve_rx_burst_dqo_vec(void *rx_queue, struct rte_mbuf **rx_pkts, uint16_t nb_pkts)
+{
+	struct gve_rx_queue *rxq = rx_queue;
+	volatile struct gve_rx_compl_desc_dqo *rx_desc;
+	const uint32_t *ptype_lut = rxq->hw->mbuf_ptype_lut_dqo;
+	uint32_t ptypes[GVE_RX_VEC_DESCS];
+	uint32_t status[GVE_RX_VEC_DESCS];
+	uint32_t bufs[GVE_RX_VEC_DESCS];
+	uint32_t lens[GVE_RX_VEC_DESCS];
+	uint16_t rx_id = rxq->rx_tail;
+	uint16_t nb_rx = 0;
+	uint64_t bytes = 0;
+	unsigned int i, n;
+
+	const __m128i gen_mask = _mm_set1_epi32(1 << GVE_RX_VEC_GEN_SHIFT);
+	const __m128i check_mask = _mm_set1_epi32(GVE_RX_VEC_ERR);
+	const __m128i eop_mask = _mm_set1_epi32(GVE_RX_VEC_EOP);
+	const __m128i ptype_mask = _mm_set1_epi32(GVE_RX_VEC_PTYPE_MASK);
+	const __m128i len_mask = _mm_set1_epi32(GVE_RX_VEC_LEN_MASK);
+	const __m128i buf_id_mask = _mm_set1_epi32(GVE_RX_VEC_BUF_ID_MASK);
+
+	/* mbuf fields stored together from the completion descriptor */
+	RTE_BUILD_BUG_ON(offsetof(struct rte_mbuf, pkt_len) !=
+			 offsetof(struct rte_mbuf, rx_descriptor_fields1) + 4);
+	RTE_BUILD_BUG_ON(offsetof(struct rte_mbuf, data_len) !=
+			 offsetof(struct rte_mbuf, rx_descriptor_fields1) + 8);
+	RTE_BUILD_BUG_ON(offsetof(struct rte_mbuf, hash) !=
+			 offsetof(struct rte_mbuf, rx_descriptor_fields1) + 12);
+	RTE_BUILD_BUG_ON(RTE_DIM(gve_rx_vec_ol_flags) !=
+			 GVE_RX_VEC_L4 << 1);
+
+	while (nb_rx < nb_pkts &&
+	       rx_id + GVE_RX_VEC_DESCS <= rxq->nb_rx_desc) {
+		__m128i d0, d1, d2, d3, t0, t1, t2, t3, w0, w1, w2, w3;
+		__m128i gen, ok;
+
+		rx_desc = &rxq->compl_ring[rx_id];
+		gen = _mm_set1_epi32((uint32_t)rxq->cur_gen_bit <<
+				     GVE_RX_VEC_GEN_SHIFT);
+
+		/* Generations are read before the rest of the descriptors */
+		d0 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rx_desc[0]);
+		d1 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rx_desc[1]);
+		d2 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rx_desc[2]);
+		d3 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rx_desc[3]);
+		t0 = _mm_unpacklo_epi32(d0, d1);
+		t1 = _mm_unpacklo_epi32(d2, d3);
+		w1 = _mm_unpackhi_epi64(t0, t1);
+		ok = _mm_cmpeq_epi32(_mm_and_si128(w1, gen_mask), gen);
+		n = rte_ctz32(~_mm_movemask_ps(_mm_castsi128_ps(ok)));
+		if (n == 0)
+			break;
+
+		rte_io_rmb();
+
+		d0 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rx_desc[0]);
+		d1 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rx_desc[1]);
+		d2 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rx_desc[2]);
+		d3 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rx_desc[3]);
+		t0 = _mm_unpacklo_epi32(d0, d1);
+		t1 = _mm_unpacklo_epi32(d2, d3);
+		t2 = _mm_unpackhi_epi32(d0, d1);
+		t3 = _mm_unpackhi_epi32(d2, d3);
+		w0 = _mm_unpacklo_epi64(t0, t1);
+		w1 = _mm_unpackhi_epi64(t0, t1);
+		w2 = _mm_unpacklo_epi64(t2, t3);
+		w3 = _mm_unpackhi_epi64(t2, t3);
+
+		/* complete packets without error */
+		ok = _mm_cmpeq_epi32(_mm_or_si128(_mm_and_si128(w0, check_mask),
+			_mm_and_si128(w2, eop_mask)), eop_mask);
+		n = RTE_MIN(n, rte_ctz32(~_mm_movemask_ps(_mm_castsi128_ps(ok))));
+		n = RTE_MIN(n, (unsigned int)(nb_pkts - nb_rx));
+		if (n == 0)
+			break;
+
+		_mm_storeu_si128((__m128i *)ptypes, _mm_and_si128(
+			_mm_srli_epi32(w0, GVE_RX_VEC_PTYPE_SHIFT), ptype_mask));
+		_mm_storeu_si128((__m128i *)lens, _mm_and_si128(w1, len_mask));
+		_mm_storeu_si128((__m128i *)status,
+			_mm_srli_epi32(w2, GVE_RX_VEC_CSUM_SHIFT));
+		_mm_storeu_si128((__m128i *)bufs, _mm_and_si128(w3, buf_id_mask));
+
+		for (i = 0; i < n; i++) {
+			uint32_t packet_type = ptype_lut[ptypes[i]];
+			struct rte_mbuf *rxm = rxq->sw_ring[bufs[i]];
+			uint32_t key;
+
+			gve_completed_buf_list_push(rxq, bufs[i]);
+
+			key = (status[i] & GVE_RX_VEC_CSUM_MASK) |
+				((packet_type & RTE_PTYPE_L3_IPV4) ?
+				 GVE_RX_VEC_IPV4 : 0) |
+				((packet_type & RTE_PTYPE_L4_MASK) ?
+				 GVE_RX_VEC_L4 : 0);
+
+			/* Recycled mbufs may have another data offset */
+			rxm->rearm_data[0] = rxq->mbuf_initializer;
+			_mm_storeu_si128((__m128i *)rxm->rx_descriptor_fields1,
+				_mm_set_epi32(rte_le_to_cpu_32(rx_desc[i].hash),
+					      lens[i], lens[i], packet_type));
+			rxm->ol_flags = gve_rx_vec_ol_flags[key];
+
+			bytes += lens[i];
+			rx_pkts[nb_rx + i] = rxm;
+		}
+
+		nb_rx += n;
+		rxq->nb_rx_hold += n;
+		rx_id += n;
+		if (rx_id == rxq->nb_rx_desc) {
+			rx_id = 0;
+			rxq->cur_gen_bit ^= 1;
+		}
+		if (n < GVE_RX_VEC_DESCS)
+			break;
+	}
+
+	if (nb_rx > 0) {
+		rxq->rx_tail = rx_id;
+
+		rxq->stats.packets += nb_rx;
+		rxq->stats.bytes += bytes;
+	}
+
+	return nb_rx + gve_rx_burst_dqo(rxq, rx_pkts + nb_rx, nb_pkts - nb_rx);
+}
@@ -50,8 +50,14 @@ gve_free_compl_tags_push(struct gve_tx_queue *txq, uint16_t compl_tag)
 	txq->num_free_compl_tags++;
 }
 
-static inline void
-gve_tx_clean_dqo(struct gve_tx_queue *txq)
+/*
+ * Process one completion descriptor.
+ * The mbuf of a completed packet is returned in *done if not NULL,
+ * and freed otherwise.
+ * Returns false if there is no completion to process.
+ */
+static inline bool
+gve_tx_clean_compl_dqo(struct gve_tx_queue *txq, struct rte_mbuf **done)
 {
 	struct gve_tx_compl_desc *compl_ring;
 	struct gve_tx_compl_desc *compl_desc;
@@ -66,7 +72,7 @@ gve_tx_clean_dqo(struct gve_tx_queue *txq)
 	compl_desc = &compl_ring[next];
 
 	if (compl_desc->generation != txq->cur_gen_bit)
-		return;
+		return false;
 
 	rte_io_rmb();
 
@@ -99,7 +105,10 @@ gve_tx_clean_dqo(struct gve_tx_queue *txq)
 				       compl_tag);
 			break;
 		}
-		rte_pktmbuf_free(pkt->mbuf);
+		if (done != NULL)
+			*done = pkt->mbuf;
+		else
+			rte_pktmbuf_free(pkt->mbuf);
 		pkt->mbuf = NULL;
 		gve_free_compl_tags_push(txq, compl_tag);
 		break;
@@ -109,7 +118,7 @@ gve_tx_clean_dqo(struct gve_tx_queue *txq)
 		break;
 	default:
 		PMD_DRV_DP_LOG(ERR, "unknown completion type.");
-		return;
+		return false;
 	}
 
 	next++;
@@ -118,6 +127,14 @@ gve_tx_clean_dqo(struct gve_tx_queue *txq)
 		txq->cur_gen_bit ^= 1;
 	}
 	txq->complq_tail = next;
+
+	return true;
+}
+
+static inline void
+gve_tx_clean_dqo(struct gve_tx_queue *txq)
+{
+	gve_tx_clean_compl_dqo(txq, NULL);
 }
 
 static inline void
@@ -619,8 +636,61 @@ gve_stop_tx_queues_dqo(struct rte_eth_dev *dev)
 			PMD_DRV_LOG(WARNING, "Fail to stop Tx queue %d", i);
 }
 
+/*
+ * Give the mbufs of the completed packets to an Rx queue,
+ * instead of freeing them to their mempool.
+ */
+uint16_t
+gve_recycle_tx_mbufs_reuse_dqo(void *tx_queue,
+			       struct rte_eth_recycle_rxq_info *recycle_rxq_info)
+{
+	struct gve_tx_queue *txq = tx_queue;
+	struct rte_mbuf **rxep = recycle_rxq_info->mbuf_ring;
+	struct rte_mempool *mp = recycle_rxq_info->mp;
+	uint16_t mbuf_ring_size = recycle_rxq_info->mbuf_ring_size;
+	uint16_t refill_head = *recycle_rxq_info->refill_head;
+	uint16_t receive_tail = *recycle_rxq_info->receive_tail;
+	uint16_t nb_recycle = 0;
+	struct rte_mbuf *m;
+	uint16_t avail;
+
+	/* Rx queues refilled by blocks of mbufs are not supported */
+	if (recycle_rxq_info->refill_requirement != 0)
+		return 0;
+
+	/* Space in the Rx ring, without wrapping around */
+	avail = (mbuf_ring_size - (refill_head - receive_tail)) &
+		(mbuf_ring_size - 1);
+	avail = RTE_MIN(avail, (uint16_t)(mbuf_ring_size - refill_head));
+	rxep += refill_head;
+
+	while (nb_recycle < avail) {
+		m = NULL;
+		if (!gve_tx_clean_compl_dqo(txq, &m))
+			break;
+		if (m == NULL)
+			continue;
+
+		/* Only single segment mbufs are recycled */
+		if (m->nb_segs != 1) {
+			rte_pktmbuf_free(m);
+			continue;
+		}
+		m = rte_pktmbuf_prefree_seg(m);
+		if (m == NULL)
+			continue;
+		if (likely(m->pool == mp))
+			rxep[nb_recycle++] = m;
+		else
+			rte_mempool_put(m->pool, m);
+	}
+
+	return nb_recycle;
+}
+
 void
 gve_set_tx_function_dqo(struct rte_eth_dev *dev)
 {
 	dev->tx_pkt_burst = gve_tx_burst_dqo;
+	dev->recycle_tx_mbufs_reuse = gve_recycle_tx_mbufs_reuse_dqo;
 }
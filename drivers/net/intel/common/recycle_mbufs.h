@@ -78,9 +78,9 @@ static __rte_always_inline uint16_t
 ci_tx_recycle_mbufs(struct ci_tx_queue *txq, ci_desc_done_fn desc_done,
 	struct rte_eth_recycle_rxq_info *recycle_rxq_info)
 {
-	struct ci_tx_entry *txep;
 	struct rte_mbuf **rxep;
 	int i, n;
+	uint16_t first;
 	uint16_t nb_recycle_mbufs;
 	uint16_t avail = 0;
 	uint16_t mbuf_ring_size = recycle_rxq_info->mbuf_ring_size;
@@ -124,34 +124,42 @@ ci_tx_recycle_mbufs(struct ci_tx_queue *txq, ci_desc_done_fn desc_done,
 	/* First buffer to free from S/W ring is at index
 	 * tx_next_dd - (tx_rs_thresh-1).
 	 */
-	txep = &txq->sw_ring[txq->tx_next_dd - (n - 1)];
+	first = txq->tx_next_dd - (n - 1);
 	rxep = recycle_rxq_info->mbuf_ring;
 	rxep += refill_head;
 
+	/* Move the mbuf pointers from the Tx S/W ring to the Rx mbuf ring. The
+	 * simple and vector Tx paths use the reduced S/W ring entries.
+	 */
+	if (txq->use_vec_entry)
+		for (i = 0; i < n; i++)
+			rxep[i] = txq->sw_ring_vec[first + i].mbuf;
+	else
+		for (i = 0; i < n; i++)
+			rxep[i] = txq->sw_ring[first + i].mbuf;
+
 	/* is fast-free enabled in offloads? */
 	struct rte_mempool *fast_free_mp =
 			likely(txq->fast_free_mp != (void *)UINTPTR_MAX) ?
 			txq->fast_free_mp :
-			(txq->fast_free_mp = txep[0].mbuf->pool);
+			(txq->fast_free_mp = rxep[0]->pool);
 
 	if (fast_free_mp != NULL) {
 		/* Avoid txq containing buffers from unexpected mempool. */
 		if (unlikely(recycle_rxq_info->mp != fast_free_mp))
 			return 0;
-
-		/* Directly put mbufs from Tx to Rx. */
-		for (i = 0; i < n; i++)
-			rxep[i] = txep[i].mbuf;
 	} else {
 		for (i = 0; i < n; i++) {
-			rxep[i] = rte_pktmbuf_prefree_seg(txep[i].mbuf);
+			struct rte_mbuf *m = rxep[i];
+
+			rxep[i] = rte_pktmbuf_prefree_seg(m);
 
 			/* If Tx buffers are not the last reference or from
 			 * unexpected mempool, previous copied buffers are
 			 * considered as invalid.
 			 */
 			if (unlikely(rxep[i] == NULL ||
-				recycle_rxq_info->mp != txep[i].mbuf->pool))
+				recycle_rxq_info->mp != m->pool))
 				nb_recycle_mbufs = 0;
 		}
 		/* If Tx buffers are not the last reference or
@@ -8,6 +8,7 @@
 #include <stdint.h>
 #include <rte_mbuf.h>
 #include <rte_ethdev.h>
+#include <rte_io.h>
 #include <rte_vect.h>
 
 /* Common TX Descriptor QW1 Field Definitions */
@@ -174,6 +175,7 @@ struct ci_tx_queue {
 	bool tx_deferred_start; /* don't start this queue in dev start */
 	bool q_set;             /* indicate if tx queue has been configured */
 	bool use_vec_entry;     /* use sw_ring_vec (true for vector and simple paths) */
+	bool doorbell_defer;    /* tail register only written by ci_tx_doorbell() */
 	union {                  /* the VSI this queue belongs to */
 		struct i40e_vsi *i40e_vsi;
 		struct iavf_vsi *iavf_vsi;
@@ -254,6 +256,24 @@ ci_tx_backlog_entry_vec(struct ci_tx_entry_vec *txep, struct rte_mbuf **tx_pkts,
 		txep[i].mbuf = tx_pkts[i];
 }
 
+/* Update the tail register, unless the doorbell is deferred. */
+static __rte_always_inline void
+ci_tx_tail_write(struct ci_tx_queue *txq, uint16_t tail)
+{
+	if (unlikely(txq->doorbell_defer))
+		return;
+	rte_write32_wc((uint32_t)tail, txq->qtx_tail);
+}
+
+/* Update the tail register deferred by ci_tx_tail_write(). */
+static inline void
+ci_tx_doorbell(void *tx_queue)
+{
+	struct ci_tx_queue *txq = tx_queue;
+
+	rte_write32_wc((uint32_t)txq->tx_tail, txq->qtx_tail);
+}
+
 #define IETH_VPMD_TX_MAX_FREE_BUF 64
 
 typedef int (*ci_desc_done_fn)(struct ci_tx_queue *txq, uint16_t idx);
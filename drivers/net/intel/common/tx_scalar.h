@@ -149,7 +149,7 @@ ci_xmit_burst_simple(struct ci_tx_queue *txq,
 	txq->tx_tail = tx_id;
 
 	/* Update the tx tail register */
-	rte_write32_wc((uint32_t)tx_id, txq->qtx_tail);
+	ci_tx_tail_write(txq, tx_id);
 
 	return nb_pkts;
 }
@@ -580,7 +580,7 @@ ci_xmit_pkts(struct ci_tx_queue *txq,
 	if (ts_fns != NULL)
 		ts_fns->write_ts_tail(txq, ts_id);
 	else
-		rte_write32_wc(tx_id, txq->qtx_tail);
+		ci_tx_tail_write(txq, tx_id);
 	txq->tx_tail = tx_id;
 
 	return nb_tx;
@@ -1855,6 +1855,37 @@ i40e_dev_rx_queue_count(void *rx_queue)
 	return desc;
 }
 
+int
+i40e_dev_rx_queue_pending(void *rx_queue)
+{
+#define I40E_RXQ_PENDING_PROBE_MIN 8
+#define I40E_RXQ_PENDING_PROBE_MAX 256
+	volatile union ci_rx_desc *rxdp;
+	struct ci_rx_queue *rxq = rx_queue;
+	uint16_t max = RTE_MIN(rxq->nb_rx_desc, I40E_RXQ_PENDING_PROBE_MAX);
+	uint16_t desc = 0, probe, idx;
+
+	/**
+	 * The descriptors are written back in order, so only check the DD bit
+	 * of the last descriptor of each power of 2 sized group.
+	 */
+	for (probe = I40E_RXQ_PENDING_PROBE_MIN; probe <= max; probe <<= 1) {
+		idx = rxq->rx_tail + probe - 1;
+		if (idx >= rxq->nb_rx_desc)
+			idx -= rxq->nb_rx_desc;
+
+		rxdp = &(rxq->rx_ring[idx]);
+		if (!(((rte_le_to_cpu_64(rxdp->wb.qword1.status_error_len) &
+			I40E_RXD_QW1_STATUS_MASK) >> I40E_RXD_QW1_STATUS_SHIFT) &
+				(1 << I40E_RX_DESC_STATUS_DD_SHIFT)))
+			break;
+
+		desc = probe;
+	}
+
+	return desc;
+}
+
 int
 i40e_dev_rx_descriptor_status(void *rx_queue, uint16_t offset)
 {
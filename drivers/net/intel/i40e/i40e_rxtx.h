@@ -155,6 +155,7 @@ int i40e_alloc_rx_queue_mbufs(struct ci_rx_queue *rxq);
 void i40e_rx_queue_release_mbufs(struct ci_rx_queue *rxq);
 
 int i40e_dev_rx_queue_count(void *rx_queue);
+int i40e_dev_rx_queue_pending(void *rx_queue);
 int i40e_dev_rx_descriptor_status(void *rx_queue, uint16_t offset);
 int i40e_dev_tx_descriptor_status(void *tx_queue, uint16_t offset);
 
@@ -133,6 +133,7 @@ static int ice_rss_reta_update(struct rte_eth_dev *dev,
 static int ice_rss_reta_query(struct rte_eth_dev *dev,
 			      struct rte_eth_rss_reta_entry64 *reta_conf,
 			      uint16_t reta_size);
+static void ice_rss_buckets_restore(struct ice_pf *pf);
 static int ice_rss_hash_update(struct rte_eth_dev *dev,
 			       struct rte_eth_rss_conf *rss_conf);
 static int ice_rss_hash_conf_get(struct rte_eth_dev *dev,
@@ -314,6 +315,8 @@ static const struct eth_dev_ops ice_eth_dev_ops = {
 	.vlan_tpid_set                = ice_vlan_tpid_set,
 	.rxq_info_get                 = ice_rxq_info_get,
 	.txq_info_get                 = ice_txq_info_get,
+	.tx_queue_doorbell_defer      = ice_tx_queue_doorbell_defer,
+	.recycle_rxq_info_get         = ice_recycle_rxq_info_get,
 	.rx_burst_mode_get            = ice_rx_burst_mode_get,
 	.tx_burst_mode_get            = ice_tx_burst_mode_get,
 	.get_eeprom_length            = ice_get_eeprom_length,
@@ -2630,8 +2633,10 @@ ice_dev_init(struct rte_eth_dev *dev)
 
 	dev->dev_ops = &ice_eth_dev_ops;
 	dev->rx_queue_count = ice_rx_queue_count;
+	dev->rx_queue_pending = ice_rx_queue_pending;
 	dev->rx_descriptor_status = ice_rx_descriptor_status;
 	dev->tx_descriptor_status = ice_tx_descriptor_status;
+	dev->tx_doorbell = ci_tx_doorbell;
 	dev->rx_pkt_burst = ice_recv_pkts;
 	dev->tx_pkt_burst = ice_xmit_pkts;
 	dev->tx_pkt_prepare = ice_prep_pkts;
@@ -3909,6 +3914,8 @@ ice_dev_configure(struct rte_eth_dev *dev)
 			PMD_DRV_LOG(ERR, "Failed to enable rss for PF");
 			return ret;
 		}
+		if (pf->rss_buckets != NULL)
+			ice_rss_buckets_restore(pf);
 	}
 
 	if (dev->data->dev_conf.rxmode.mq_mode & RTE_ETH_MQ_RX_DCB_FLAG) {
@@ -4596,6 +4603,10 @@ ice_dev_info_get(struct rte_eth_dev *dev, struct rte_eth_dev_info *dev_info)
 	dev_info->rx_queue_offload_capa = RTE_ETH_RX_OFFLOAD_BUFFER_SPLIT;
 	dev_info->tx_queue_offload_capa = RTE_ETH_TX_OFFLOAD_MBUF_FAST_FREE;
 
+	dev_info->dev_capa |=
+		RTE_ETH_DEV_CAPA_RUNTIME_RX_QUEUE_SETUP |
+		RTE_ETH_DEV_CAPA_RUNTIME_TX_QUEUE_SETUP;
+
 	dev_info->reta_size = pf->hash_lut_size;
 	dev_info->hash_key_size = (VSIQF_HKEY_MAX_INDEX + 1) * sizeof(uint32_t);
 
@@ -5577,6 +5588,12 @@ ice_rss_reta_update(struct rte_eth_dev *dev,
 			    reta_size);
 		return -EINVAL;
 	}
+	if (pf->rss_buckets != NULL && reta_size != lut_size) {
+		PMD_DRV_LOG(ERR,
+			    "The size of hash lookup table cannot change "
+			    "while an indirect RSS action exists");
+		return -EBUSY;
+	}
 
 	/* It MUST use the current LUT size to get the RSS lookup table,
 	 * otherwise if will fail with -100 error code.
@@ -5597,6 +5614,17 @@ ice_rss_reta_update(struct rte_eth_dev *dev,
 			lut[i] = reta_conf[idx].reta[shift];
 	}
 	ret = ice_set_rss_lut(pf->main_vsi, lut, reta_size);
+	if (ret == 0 && pf->rss_buckets != NULL) {
+		/* Written entries are kept by the indirect RSS action */
+		for (i = 0; i < reta_size; i++) {
+			idx = i / RTE_ETH_RETA_GROUP_SIZE;
+			shift = i % RTE_ETH_RETA_GROUP_SIZE;
+			if (!(reta_conf[idx].mask & (1ULL << shift)))
+				continue;
+			pf->rss_buckets->lut[i] = lut[i];
+			pf->rss_buckets->pinned[i / 64] |= RTE_BIT64(i % 64);
+		}
+	}
 	if (ret == 0 && lut_size != reta_size) {
 		PMD_DRV_LOG(INFO,
 			    "The size of hash lookup table is changed from (%d) to (%d)",
@@ -5653,6 +5681,247 @@ ice_rss_reta_query(struct rte_eth_dev *dev,
 	return ret;
 }
 
+static inline bool
+ice_rss_bucket_pinned(const struct ice_rss_buckets *b, uint16_t i)
+{
+	return (b->pinned[i / 64] >> (i % 64)) & 1;
+}
+
+/*
+ * Spread the buckets which are not pinned over the queues,
+ * keeping as many buckets as possible on their current queue:
+ * adding or removing a queue only moves the buckets needed
+ * to balance the queues.
+ */
+static void
+ice_rss_buckets_balance(struct ice_rss_buckets *b, uint16_t nb_rxq)
+{
+	uint16_t target[ICE_RSS_BUCKETS_MAX_QUEUES] = { 0 };
+	uint16_t kept[ICE_RSS_BUCKETS_MAX_QUEUES] = { 0 };
+	bool member[ICE_RSS_BUCKETS_MAX_QUEUES] = { false };
+	uint16_t moved[ICE_AQC_GSET_RSS_LUT_TABLE_SIZE_2K];
+	uint16_t i, j, q, nb_free = 0, nb_moved = 0;
+	uint16_t base, extra;
+
+	for (j = 0; j < b->nb_queues; j++)
+		member[b->queues[j]] = true;
+
+	for (i = 0; i < b->lut_size; i++) {
+		/* Pins to removed queues are dropped */
+		if (ice_rss_bucket_pinned(b, i) && b->lut[i] >= nb_rxq)
+			b->pinned[i / 64] &= ~RTE_BIT64(i % 64);
+		if (ice_rss_bucket_pinned(b, i))
+			continue;
+		nb_free++;
+		if (member[b->lut[i]])
+			kept[b->lut[i]]++;
+	}
+
+	/* The queues with the most buckets get the remainder */
+	base = nb_free / b->nb_queues;
+	extra = nb_free % b->nb_queues;
+	for (j = 0; j < b->nb_queues; j++) {
+		q = b->queues[j];
+		target[q] = base;
+		if (extra != 0 && kept[q] > base) {
+			target[q]++;
+			extra--;
+		}
+	}
+	for (j = 0; j < b->nb_queues && extra != 0; j++) {
+		q = b->queues[j];
+		if (target[q] == base) {
+			target[q]++;
+			extra--;
+		}
+	}
+
+	/* Keep the first buckets of each queue, up to its target */
+	memset(kept, 0, sizeof(kept));
+	for (i = 0; i < b->lut_size; i++) {
+		if (ice_rss_bucket_pinned(b, i))
+			continue;
+		q = b->lut[i];
+		if (member[q] && kept[q] < target[q])
+			kept[q]++;
+		else
+			moved[nb_moved++] = i;
+	}
+
+	/* Move the others to the queues below their target */
+	j = 0;
+	for (i = 0; i < nb_moved; i++) {
+		while (kept[b->queues[j]] >= target[b->queues[j]])
+			j++;
+		q = b->queues[j];
+		b->lut[moved[i]] = q;
+		kept[q]++;
+	}
+}
+
+static int
+ice_rss_buckets_check(struct ice_pf *pf, const struct rte_flow_action_rss *rss,
+		      struct rte_flow_error *error)
+{
+	bool used[ICE_RSS_BUCKETS_MAX_QUEUES] = { false };
+	uint16_t nb_rxq = pf->dev_data->nb_rx_queues;
+	uint32_t i;
+
+	if (pf->main_vsi->rss_lut == NULL)
+		return rte_flow_error_set(error, ENOTSUP,
+				RTE_FLOW_ERROR_TYPE_ACTION, NULL,
+				"RSS is not enabled");
+	if (rss->func != RTE_ETH_HASH_FUNCTION_DEFAULT &&
+	    rss->func != RTE_ETH_HASH_FUNCTION_TOEPLITZ)
+		return rte_flow_error_set(error, ENOTSUP,
+				RTE_FLOW_ERROR_TYPE_ACTION_CONF, rss,
+				"Only the hash function of the port is supported");
+	/* The hash types are those of the port, they are ignored */
+	if (rss->level != 0 || rss->key_len != 0)
+		return rte_flow_error_set(error, ENOTSUP,
+				RTE_FLOW_ERROR_TYPE_ACTION_CONF, rss,
+				"Hash level and key are those of the port");
+	if (rss->queue_num > ICE_RSS_BUCKETS_MAX_QUEUES)
+		return rte_flow_error_set(error, EINVAL,
+				RTE_FLOW_ERROR_TYPE_ACTION_CONF, rss,
+				"Too many queues");
+
+	for (i = 0; i < rss->queue_num; i++) {
+		if (rss->queue[i] >= RTE_MIN(nb_rxq, ICE_RSS_BUCKETS_MAX_QUEUES) ||
+		    used[rss->queue[i]])
+			return rte_flow_error_set(error, EINVAL,
+					RTE_FLOW_ERROR_TYPE_ACTION_CONF, rss,
+					"Invalid or duplicated queue");
+		used[rss->queue[i]] = true;
+	}
+
+	return 0;
+}
+
+/* Balance the buckets over the queues and write the lookup table */
+static int
+ice_rss_buckets_set(struct ice_pf *pf, struct ice_rss_buckets *b,
+		    const uint16_t *queues, uint16_t nb_queues, bool unpin)
+{
+	struct ice_rss_buckets *nb;
+	int ret;
+
+	nb = rte_malloc(NULL, sizeof(*nb), 0);
+	if (nb == NULL)
+		return -ENOMEM;
+
+	*nb = *b;
+	memcpy(nb->queues, queues, nb_queues * sizeof(*queues));
+	nb->nb_queues = nb_queues;
+	if (unpin)
+		memset(nb->pinned, 0, sizeof(nb->pinned));
+	ice_rss_buckets_balance(nb, pf->dev_data->nb_rx_queues);
+
+	ret = ice_set_rss_lut(pf->main_vsi, nb->lut, nb->lut_size);
+	if (ret == 0)
+		*b = *nb;
+
+	rte_free(nb);
+	return ret;
+}
+
+int
+ice_rss_buckets_create(struct ice_pf *pf, const struct rte_flow_action_rss *rss,
+		       struct rte_flow_error *error)
+{
+	struct ice_rss_buckets *b;
+	int ret;
+
+	if (pf->rss_buckets != NULL)
+		return rte_flow_error_set(error, EEXIST,
+				RTE_FLOW_ERROR_TYPE_ACTION, NULL,
+				"RSS buckets are already steered by an indirect action");
+	ret = ice_rss_buckets_check(pf, rss, error);
+	if (ret)
+		return ret;
+	if (rss->queue_num == 0)
+		return rte_flow_error_set(error, EINVAL,
+				RTE_FLOW_ERROR_TYPE_ACTION_CONF, rss,
+				"No queue");
+
+	b = rte_zmalloc(NULL, sizeof(*b), 0);
+	if (b == NULL)
+		return rte_flow_error_set(error, ENOMEM,
+				RTE_FLOW_ERROR_TYPE_UNSPECIFIED, NULL,
+				"No memory can be allocated");
+
+	/* Start from the current table to move as few buckets as possible */
+	b->lut_size = pf->hash_lut_size;
+	ret = ice_get_rss_lut(pf->main_vsi, b->lut, b->lut_size);
+	if (ret == 0)
+		ret = ice_rss_buckets_set(pf, b, rss->queue, rss->queue_num,
+					  true);
+	if (ret) {
+		rte_free(b);
+		return rte_flow_error_set(error, -ret,
+				RTE_FLOW_ERROR_TYPE_UNSPECIFIED, NULL,
+				"Failed to set RSS lookup table");
+	}
+
+	pf->rss_buckets = b;
+	return 0;
+}
+
+/*
+ * Spread the buckets over a new set of queues,
+ * or over the same queues dropping the pinned buckets if none is given.
+ */
+int
+ice_rss_buckets_update(struct ice_pf *pf, const struct rte_flow_action_rss *rss,
+		       struct rte_flow_error *error)
+{
+	struct ice_rss_buckets *b = pf->rss_buckets;
+	int ret;
+
+	ret = ice_rss_buckets_check(pf, rss, error);
+	if (ret)
+		return ret;
+
+	if (rss->queue_num == 0)
+		ret = ice_rss_buckets_set(pf, b, b->queues, b->nb_queues, true);
+	else
+		ret = ice_rss_buckets_set(pf, b, rss->queue, rss->queue_num,
+					  false);
+	if (ret)
+		return rte_flow_error_set(error, -ret,
+				RTE_FLOW_ERROR_TYPE_UNSPECIFIED, NULL,
+				"Failed to set RSS lookup table");
+
+	return 0;
+}
+
+/* The lookup table is left as is */
+void
+ice_rss_buckets_destroy(struct ice_pf *pf)
+{
+	rte_free(pf->rss_buckets);
+	pf->rss_buckets = NULL;
+}
+
+/* Write the buckets again after the lookup table was reset */
+static void
+ice_rss_buckets_restore(struct ice_pf *pf)
+{
+	struct ice_rss_buckets *b = pf->rss_buckets;
+	uint16_t nb_rxq = pf->dev_data->nb_rx_queues;
+	uint16_t queues[ICE_RSS_BUCKETS_MAX_QUEUES];
+	uint16_t i, nb_queues = 0;
+
+	for (i = 0; i < b->nb_queues; i++)
+		if (b->queues[i] < nb_rxq)
+			queues[nb_queues++] = b->queues[i];
+
+	if (nb_queues == 0 || b->lut_size != pf->hash_lut_size ||
+	    ice_rss_buckets_set(pf, b, queues, nb_queues, false) != 0)
+		PMD_DRV_LOG(WARNING,
+			    "RSS buckets of the indirect action are not restored");
+}
+
 static int
 ice_set_rss_key(struct ice_vsi *vsi, uint8_t *key, uint8_t key_len)
 {
@@ -483,6 +483,23 @@ struct ice_hash_ctx {
 	struct ice_hash_gtpu_ctx gtpu6;
 };
 
+/* Max number of queues in the RSS lookup table, whose entries are bytes */
+#define ICE_RSS_BUCKETS_MAX_QUEUES	256
+
+/**
+ * RSS hash buckets (entries of the RSS lookup table)
+ * steered by the indirect RSS action of the port.
+ * Buckets are spread over the queues of the action,
+ * except the pinned ones written through the RETA update API.
+ */
+struct ice_rss_buckets {
+	uint16_t lut_size;
+	uint16_t nb_queues;
+	uint16_t queues[ICE_RSS_BUCKETS_MAX_QUEUES];
+	uint64_t pinned[ICE_AQC_GSET_RSS_LUT_TABLE_SIZE_2K / 64];
+	uint8_t lut[ICE_AQC_GSET_RSS_LUT_TABLE_SIZE_2K];
+};
+
 struct ice_acl_conf {
 	struct ice_fdir_fltr input;
 	uint64_t input_set;
@@ -582,6 +599,7 @@ struct ice_pf {
 	struct ice_fdir_info fdir; /* flow director info */
 	struct ice_acl_info acl; /* ACL info */
 	struct ice_hash_ctx hash_ctx;
+	struct ice_rss_buckets *rss_buckets; /* indirect RSS action */
 	uint16_t hw_prof_cnt[ICE_FLTR_PTYPE_MAX][ICE_FD_HW_SEG_MAX];
 	uint16_t fdir_fltr_cnt[ICE_FLTR_PTYPE_MAX][ICE_FD_HW_SEG_MAX];
 	struct ice_hw_port_stats stats_offset;
@@ -742,6 +760,13 @@ int ice_add_rss_cfg_wrap(struct ice_pf *pf, uint16_t vsi_id,
 			 struct ice_rss_hash_cfg *cfg);
 int ice_rem_rss_cfg_wrap(struct ice_pf *pf, uint16_t vsi_id,
 			 struct ice_rss_hash_cfg *cfg);
+int ice_rss_buckets_create(struct ice_pf *pf,
+			   const struct rte_flow_action_rss *rss,
+			   struct rte_flow_error *error);
+int ice_rss_buckets_update(struct ice_pf *pf,
+			   const struct rte_flow_action_rss *rss,
+			   struct rte_flow_error *error);
+void ice_rss_buckets_destroy(struct ice_pf *pf);
 void ice_tm_conf_init(struct rte_eth_dev *dev);
 void ice_tm_conf_uninit(struct rte_eth_dev *dev);
 extern const struct rte_tm_ops ice_tm_ops;
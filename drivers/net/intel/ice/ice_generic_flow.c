@@ -45,6 +45,18 @@ static int ice_flow_query(struct rte_eth_dev *dev,
 		const struct rte_flow_action *actions,
 		void *data,
 		struct rte_flow_error *error);
+static struct rte_flow_action_handle *ice_flow_action_handle_create(
+		struct rte_eth_dev *dev,
+		const struct rte_flow_indir_action_conf *conf,
+		const struct rte_flow_action *action,
+		struct rte_flow_error *error);
+static int ice_flow_action_handle_destroy(struct rte_eth_dev *dev,
+		struct rte_flow_action_handle *handle,
+		struct rte_flow_error *error);
+static int ice_flow_action_handle_update(struct rte_eth_dev *dev,
+		struct rte_flow_action_handle *handle,
+		const void *update,
+		struct rte_flow_error *error);
 
 const struct rte_flow_ops ice_flow_ops = {
 	.validate = ice_flow_validate,
@@ -52,6 +64,9 @@ const struct rte_flow_ops ice_flow_ops = {
 	.destroy = ice_flow_destroy,
 	.flush = ice_flow_flush,
 	.query = ice_flow_query,
+	.action_handle_create = ice_flow_action_handle_create,
+	.action_handle_destroy = ice_flow_action_handle_destroy,
+	.action_handle_update = ice_flow_action_handle_update,
 };
 
 /* empty */
@@ -1878,6 +1893,8 @@ ice_flow_uninit(struct ice_adapter *ad)
 		rte_free(p_flow);
 	}
 
+	ice_rss_buckets_destroy(pf);
+
 	if (ad->psr != NULL) {
 		ice_parser_destroy(ad->psr);
 		ad->psr = NULL;
@@ -2498,3 +2515,87 @@ ice_flow_redirect(struct ice_adapter *ad,
 
 	return ret;
 }
+
+/*
+ * The only indirect action is an RSS action steering the hash buckets
+ * (entries of the RSS lookup table) of the port over a set of queues.
+ * Updating its queues moves only the buckets needed to balance them,
+ * buckets written with the RETA update API are kept on their queue.
+ */
+static struct rte_flow_action_handle *
+ice_flow_action_handle_create(struct rte_eth_dev *dev,
+		const struct rte_flow_indir_action_conf *conf,
+		const struct rte_flow_action *action,
+		struct rte_flow_error *error)
+{
+	struct ice_pf *pf = ICE_DEV_PRIVATE_TO_PF(dev->data->dev_private);
+	int ret;
+
+	if (!conf->ingress || conf->egress || conf->transfer) {
+		rte_flow_error_set(error, ENOTSUP,
+				RTE_FLOW_ERROR_TYPE_ATTR,
+				NULL, "Only ingress is supported");
+		return NULL;
+	}
+	if (action->type != RTE_FLOW_ACTION_TYPE_RSS) {
+		rte_flow_error_set(error, ENOTSUP,
+				RTE_FLOW_ERROR_TYPE_ACTION,
+				action, "action not supported");
+		return NULL;
+	}
+
+	rte_spinlock_lock(&pf->flow_ops_lock);
+	ret = ice_rss_buckets_create(pf, action->conf, error);
+	rte_spinlock_unlock(&pf->flow_ops_lock);
+
+	return ret ? NULL : (struct rte_flow_action_handle *)pf->rss_buckets;
+}
+
+static int
+ice_flow_action_handle_destroy(struct rte_eth_dev *dev,
+		struct rte_flow_action_handle *handle,
+		struct rte_flow_error *error)
+{
+	struct ice_pf *pf = ICE_DEV_PRIVATE_TO_PF(dev->data->dev_private);
+	int ret = 0;
+
+	rte_spinlock_lock(&pf->flow_ops_lock);
+	if (handle == NULL ||
+	    handle != (struct rte_flow_action_handle *)pf->rss_buckets)
+		ret = rte_flow_error_set(error, EINVAL,
+				RTE_FLOW_ERROR_TYPE_HANDLE,
+				NULL, "Invalid action handle");
+	else
+		ice_rss_buckets_destroy(pf);
+	rte_spinlock_unlock(&pf->flow_ops_lock);
+
+	return ret;
+}
+
+static int
+ice_flow_action_handle_update(struct rte_eth_dev *dev,
+		struct rte_flow_action_handle *handle,
+		const void *update,
+		struct rte_flow_error *error)
+{
+	struct ice_pf *pf = ICE_DEV_PRIVATE_TO_PF(dev->data->dev_private);
+	const struct rte_flow_action *action = update;
+	int ret;
+
+	if (action == NULL || action->type != RTE_FLOW_ACTION_TYPE_RSS)
+		return rte_flow_error_set(error, ENOTSUP,
+				RTE_FLOW_ERROR_TYPE_ACTION,
+				action, "action not supported");
+
+	rte_spinlock_lock(&pf->flow_ops_lock);
+	if (handle == NULL ||
+	    handle != (struct rte_flow_action_handle *)pf->rss_buckets)
+		ret = rte_flow_error_set(error, EINVAL,
+				RTE_FLOW_ERROR_TYPE_HANDLE,
+				NULL, "Invalid action handle");
+	else
+		ret = ice_rss_buckets_update(pf, action->conf, error);
+	rte_spinlock_unlock(&pf->flow_ops_lock);
+
+	return ret;
+}
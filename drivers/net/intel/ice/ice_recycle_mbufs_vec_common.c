@@ -0,0 +1,28 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdint.h>
+#include <ethdev_driver.h>
+
+#include "ice_ethdev.h"
+#include "ice_rxtx.h"
+
+#include "ice_rxtx_vec_common.h"
+
+#include "../common/recycle_mbufs.h"
+
+void
+ice_recycle_rx_descriptors_refill_vec(void *rx_queue, uint16_t nb_mbufs)
+{
+	ci_rx_recycle_mbufs(rx_queue, nb_mbufs);
+}
+
+uint16_t
+ice_recycle_tx_mbufs_reuse_vec(void *tx_queue,
+	struct rte_eth_recycle_rxq_info *recycle_rxq_info)
+{
+	struct ci_tx_queue *txq = tx_queue;
+
+	return ci_tx_recycle_mbufs(txq, ice_tx_desc_done, recycle_rxq_info);
+}
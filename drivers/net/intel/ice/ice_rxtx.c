@@ -1262,6 +1262,12 @@ ice_fdir_tx_queue_stop(struct rte_eth_dev *dev, uint16_t tx_queue_id)
 	return 0;
 }
 
+static int ice_rx_queue_runtime_check(struct rte_eth_dev *dev,
+				      struct ci_rx_queue *rxq,
+				      int use_def_burst_func);
+static int ice_tx_queue_runtime_check(struct rte_eth_dev *dev,
+				      struct ci_tx_queue *txq);
+
 int
 ice_rx_queue_setup(struct rte_eth_dev *dev,
 		   uint16_t queue_idx,
@@ -1420,6 +1426,14 @@ ice_rx_queue_setup(struct rte_eth_dev *dev,
 
 	use_def_burst_func = ice_check_rx_burst_bulk_alloc_preconditions(rxq);
 
+	/* The Rx path cannot change while the port is started. */
+	if (dev->data->dev_started &&
+	    ice_rx_queue_runtime_check(dev, rxq, use_def_burst_func) != 0) {
+		ice_rx_queue_release(rxq);
+		dev->data->rx_queues[queue_idx] = NULL;
+		return -EINVAL;
+	}
+
 	if (!use_def_burst_func) {
 		PMD_INIT_LOG(DEBUG, "Rx Burst Bulk Alloc Preconditions are "
 			     "satisfied. Rx Burst Bulk Alloc function will be "
@@ -1717,6 +1731,17 @@ ice_tx_queue_setup(struct rte_eth_dev *dev,
 	ice_reset_tx_queue(txq);
 	txq->q_set = true;
 	dev->data->tx_queues[queue_idx] = txq;
+
+	/* The Tx path cannot change while the port is started. */
+	if (dev->data->dev_started) {
+		if (ice_tx_queue_runtime_check(dev, txq) != 0) {
+			ice_tx_queue_release(txq);
+			dev->data->tx_queues[queue_idx] = NULL;
+			return -EINVAL;
+		}
+		return 0;
+	}
+
 	ice_set_tx_function_flag(dev, txq);
 
 	return 0;
@@ -1792,6 +1817,26 @@ ice_txq_info_get(struct rte_eth_dev *dev, uint16_t queue_id,
 	qinfo->conf.tx_deferred_start = txq->tx_deferred_start;
 }
 
+int
+ice_tx_queue_doorbell_defer(struct rte_eth_dev *dev, uint16_t queue_id, int on)
+{
+	struct ci_tx_queue *txq = dev->data->tx_queues[queue_id];
+
+	if (txq == NULL)
+		return -EINVAL;
+
+	/* The Tx time queue has its own tail register. */
+	if (txq->tsq != NULL && txq->tsq->ts_flag > 0)
+		return -ENOTSUP;
+
+	if (!on && txq->doorbell_defer)
+		ci_tx_doorbell(txq);
+
+	txq->doorbell_defer = on;
+
+	return 0;
+}
+
 int
 ice_rx_queue_count(void *rx_queue)
 {
@@ -1819,6 +1864,36 @@ ice_rx_queue_count(void *rx_queue)
 	return desc;
 }
 
+int
+ice_rx_queue_pending(void *rx_queue)
+{
+#define ICE_RXQ_PENDING_PROBE_MIN 8
+#define ICE_RXQ_PENDING_PROBE_MAX 256
+	volatile union ci_rx_flex_desc *rxdp;
+	struct ci_rx_queue *rxq = rx_queue;
+	uint16_t max = RTE_MIN(rxq->nb_rx_desc, ICE_RXQ_PENDING_PROBE_MAX);
+	uint16_t desc = 0, probe, idx;
+
+	/**
+	 * The descriptors are written back in order, so only check the DD bit
+	 * of the last descriptor of each power of 2 sized group.
+	 */
+	for (probe = ICE_RXQ_PENDING_PROBE_MIN; probe <= max; probe <<= 1) {
+		idx = rxq->rx_tail + probe - 1;
+		if (idx >= rxq->nb_rx_desc)
+			idx -= rxq->nb_rx_desc;
+
+		rxdp = &rxq->rx_flex_ring[idx];
+		if (!(rte_le_to_cpu_16(rxdp->wb.status_error0) &
+		      (1 << ICE_RX_FLEX_DESC_STATUS0_DD_S)))
+			break;
+
+		desc = probe;
+	}
+
+	return desc;
+}
+
 #define ICE_RX_FLEX_ERR0_BITS	\
 	((1 << ICE_RX_FLEX_DESC_STATUS0_HBO_S) |	\
 	 (1 << ICE_RX_FLEX_DESC_STATUS0_XSUM_IPE_S) |	\
@@ -3404,6 +3479,9 @@ ice_set_rx_function(struct rte_eth_dev *dev)
 		for (i = 0; i < dev->data->nb_rx_queues; i++)
 			if (dev->data->rx_queues[i])
 				ice_rxq_vec_setup(dev->data->rx_queues[i]);
+
+	if (ice_rx_path_infos[ad->rx_func_type].features.simd_width == RTE_VECT_SIMD_256)
+		dev->recycle_rx_descriptors_refill = ice_recycle_rx_descriptors_refill_vec;
 #endif
 
 out:
@@ -3412,6 +3490,52 @@ ice_set_rx_function(struct rte_eth_dev *dev)
 			ice_rx_path_infos[ad->rx_func_type].info, dev->data->port_id);
 }
 
+/* Check that a Rx queue set up on a started port fits the selected Rx path. */
+static int __rte_cold
+ice_rx_queue_runtime_check(struct rte_eth_dev *dev, struct ci_rx_queue *rxq,
+			   int use_def_burst_func)
+{
+	struct ice_adapter *ad =
+		ICE_DEV_PRIVATE_TO_ADAPTER(dev->data->dev_private);
+	const struct ci_rx_path_features *features =
+		&ice_rx_path_infos[ad->rx_func_type].features;
+	uint32_t frame_size = dev->data->mtu + ICE_ETH_OVERHEAD;
+	uint16_t buf_size;
+
+	if (rxq->offloads & ~(uint64_t)features->rx_offloads) {
+		PMD_DRV_LOG(ERR, "Rx queue %u offloads not supported by the %s Rx path",
+			    rxq->queue_id, ice_rx_path_infos[ad->rx_func_type].info);
+		return -EINVAL;
+	}
+
+	if (features->bulk_alloc && use_def_burst_func) {
+		PMD_DRV_LOG(ERR, "Rx queue %u does not meet the bulk alloc preconditions",
+			    rxq->queue_id);
+		return -EINVAL;
+	}
+
+	buf_size = (uint16_t)(rte_pktmbuf_data_room_size(rxq->mp) -
+			      RTE_PKTMBUF_HEADROOM);
+	if (!features->scattered && frame_size > buf_size) {
+		PMD_DRV_LOG(ERR, "Rx queue %u needs scattered Rx, not enabled on port %u",
+			    rxq->queue_id, dev->data->port_id);
+		return -EINVAL;
+	}
+
+#ifdef RTE_ARCH_X86
+	if (features->simd_width >= RTE_VECT_SIMD_256) {
+		if (ice_rx_vec_queue_default(rxq) != 0) {
+			PMD_DRV_LOG(ERR, "Rx queue %u cannot use the %s Rx path",
+				    rxq->queue_id, ice_rx_path_infos[ad->rx_func_type].info);
+			return -EINVAL;
+		}
+		ice_rxq_vec_setup(rxq);
+	}
+#endif
+
+	return 0;
+}
+
 int
 ice_rx_burst_mode_get(struct rte_eth_dev *dev, __rte_unused uint16_t queue_id,
 		      struct rte_eth_burst_mode *mode)
@@ -3432,6 +3556,30 @@ ice_rx_burst_mode_get(struct rte_eth_dev *dev, __rte_unused uint16_t queue_id,
 	return ret;
 }
 
+void
+ice_recycle_rxq_info_get(struct rte_eth_dev *dev, uint16_t queue_id,
+			 struct rte_eth_recycle_rxq_info *recycle_rxq_info)
+{
+	struct ci_rx_queue *rxq;
+	struct ice_adapter *ad =
+		ICE_DEV_PRIVATE_TO_ADAPTER(dev->data->dev_private);
+
+	rxq = dev->data->rx_queues[queue_id];
+
+	recycle_rxq_info->mbuf_ring = (void *)rxq->sw_ring;
+	recycle_rxq_info->mp = rxq->mp;
+	recycle_rxq_info->mbuf_ring_size = rxq->nb_rx_desc;
+	recycle_rxq_info->receive_tail = &rxq->rx_tail;
+
+	if (ice_rx_path_infos[ad->rx_func_type].features.simd_width >= RTE_VECT_SIMD_256) {
+		recycle_rxq_info->refill_requirement = ICE_VPMD_RXQ_REARM_THRESH;
+		recycle_rxq_info->refill_head = &rxq->rxrearm_start;
+	} else {
+		recycle_rxq_info->refill_requirement = rxq->rx_free_thresh;
+		recycle_rxq_info->refill_head = &rxq->rx_free_trigger;
+	}
+}
+
 void __rte_cold
 ice_set_tx_function_flag(struct rte_eth_dev *dev, struct ci_tx_queue *txq)
 {
@@ -3737,6 +3885,46 @@ ice_set_tx_function(struct rte_eth_dev *dev)
 	dev->tx_pkt_prepare = ice_tx_path_infos[ad->tx_func_type].pkt_prep;
 	PMD_DRV_LOG(NOTICE, "Using %s (port %d).",
 		ice_tx_path_infos[ad->tx_func_type].info, dev->data->port_id);
+
+	if (ad->tx_func_type == ICE_TX_SIMPLE ||
+			ad->tx_func_type == ICE_TX_AVX2 ||
+			ad->tx_func_type == ICE_TX_AVX2_OFFLOAD)
+		dev->recycle_tx_mbufs_reuse = ice_recycle_tx_mbufs_reuse_vec;
+}
+
+/* Check that a Tx queue set up on a started port fits the selected Tx path. */
+static int __rte_cold
+ice_tx_queue_runtime_check(struct rte_eth_dev *dev, struct ci_tx_queue *txq)
+{
+	struct ice_adapter *ad =
+		ICE_DEV_PRIVATE_TO_ADAPTER(dev->data->dev_private);
+	const struct ci_tx_path_features *features =
+		&ice_tx_path_infos[ad->tx_func_type].features;
+
+	if (txq->offloads & ~(uint64_t)features->tx_offloads) {
+		PMD_DRV_LOG(ERR, "Tx queue %u offloads not supported by the %s Tx path",
+			    txq->queue_id, ice_tx_path_infos[ad->tx_func_type].info);
+		return -EINVAL;
+	}
+
+	if ((features->simple_tx || ad->tx_simple_allowed) &&
+	    (txq->offloads != (txq->offloads & RTE_ETH_TX_OFFLOAD_MBUF_FAST_FREE) ||
+	     txq->tx_rs_thresh < ICE_TX_MAX_BURST)) {
+		PMD_DRV_LOG(ERR, "Tx queue %u cannot use the simple Tx path",
+			    txq->queue_id);
+		return -EINVAL;
+	}
+
+#ifdef RTE_ARCH_X86
+	if (features->simd_width >= RTE_VECT_SIMD_256 &&
+	    ice_tx_vec_queue_default(txq) != 0) {
+		PMD_DRV_LOG(ERR, "Tx queue %u cannot use the %s Tx path",
+			    txq->queue_id, ice_tx_path_infos[ad->tx_func_type].info);
+		return -EINVAL;
+	}
+#endif
+
+	return 0;
 }
 
 int
@@ -245,10 +245,18 @@ void ice_set_tx_function_flag(struct rte_eth_dev *dev,
 			      struct ci_tx_queue *txq);
 void ice_set_tx_function(struct rte_eth_dev *dev);
 int ice_rx_queue_count(void *rx_queue);
+int ice_rx_queue_pending(void *rx_queue);
 void ice_rxq_info_get(struct rte_eth_dev *dev, uint16_t queue_id,
 		      struct rte_eth_rxq_info *qinfo);
 void ice_txq_info_get(struct rte_eth_dev *dev, uint16_t queue_id,
 		      struct rte_eth_txq_info *qinfo);
+int ice_tx_queue_doorbell_defer(struct rte_eth_dev *dev, uint16_t queue_id,
+				int on);
+void ice_recycle_rxq_info_get(struct rte_eth_dev *dev, uint16_t queue_id,
+			      struct rte_eth_recycle_rxq_info *recycle_rxq_info);
+uint16_t ice_recycle_tx_mbufs_reuse_vec(void *tx_queue,
+		struct rte_eth_recycle_rxq_info *recycle_rxq_info);
+void ice_recycle_rx_descriptors_refill_vec(void *rx_queue, uint16_t nb_mbufs);
 int ice_rx_burst_mode_get(struct rte_eth_dev *dev, uint16_t queue_id,
 			  struct rte_eth_burst_mode *mode);
 int ice_tx_burst_mode_get(struct rte_eth_dev *dev, uint16_t queue_id,
@@ -652,6 +652,199 @@ eth_memif_rx_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	return n_rx_pkts;
 }
 
+/* Maximum number of descriptors of a packet received by a zero-copy server */
+#define MEMIF_ZC_MAX_SEGS 32
+
+static void
+memif_zc_buf_free(void *addr __rte_unused, void *opaque)
+{
+	struct memif_zc_slot *slot = opaque;
+	struct memif_zc_ring *zr = slot->zr;
+
+	/* The buffer is given back to the client by the next rx burst. */
+	rte_atomic_store_explicit(&slot->done, 1, rte_memory_order_release);
+	if (rte_atomic_fetch_sub_explicit(&zr->refcnt, 1,
+			rte_memory_order_acq_rel) == 1)
+		rte_free(zr);
+}
+
+static int
+memif_zc_ring_alloc(struct memif_queue *mq)
+{
+	uint16_t ring_size = 1 << mq->log2_ring_size;
+	struct memif_zc_ring *zr;
+	uint16_t i;
+
+	zr = rte_zmalloc("memif_zc", sizeof(*zr) +
+			 sizeof(struct memif_zc_slot) * ring_size,
+			 RTE_CACHE_LINE_SIZE);
+	if (zr == NULL)
+		return -ENOMEM;
+
+	rte_atomic_store_explicit(&zr->refcnt, 1, rte_memory_order_relaxed);
+	for (i = 0; i < ring_size; i++) {
+		zr->slots[i].shinfo.free_cb = memif_zc_buf_free;
+		zr->slots[i].shinfo.fcb_opaque = &zr->slots[i];
+		zr->slots[i].zr = zr;
+	}
+	mq->zc_ring = zr;
+
+	return 0;
+}
+
+/*
+ * Release the zero-copy rings of the server rx queues.
+ * Return the number of rings with buffers still held by the application.
+ */
+static unsigned int
+memif_zc_rings_release(struct rte_eth_dev *dev)
+{
+	struct memif_zc_ring *zr;
+	struct memif_queue *mq;
+	unsigned int busy = 0;
+	uint16_t i;
+
+	for (i = 0; i < dev->data->nb_rx_queues; i++) {
+		mq = dev->data->rx_queues[i];
+		if (mq == NULL || mq->zc_ring == NULL)
+			continue;
+		zr = mq->zc_ring;
+		mq->zc_ring = NULL;
+		/* the last buffer freed releases the ring */
+		if (rte_atomic_fetch_sub_explicit(&zr->refcnt, 1,
+				rte_memory_order_acq_rel) == 1)
+			rte_free(zr);
+		else
+			busy++;
+	}
+
+	return busy;
+}
+
+/*
+ * Server rx without copy: the client buffers are attached to the mbufs
+ * as external buffers, and given back to the client in ring order once
+ * freed by the application.
+ */
+static uint16_t
+eth_memif_rx_server_zc(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	struct memif_queue *mq = queue;
+	struct pmd_internals *pmd = rte_eth_devices[mq->in_port].data->dev_private;
+	struct pmd_process_private *proc_private =
+		rte_eth_devices[mq->in_port].process_private;
+	memif_ring_t *ring = memif_get_ring_from_queue(proc_private, mq);
+	struct memif_zc_ring *zr = mq->zc_ring;
+	struct rte_mbuf *segs[MEMIF_ZC_MAX_SEGS];
+	uint16_t cur_slot, last_slot, n_slots, mask, s0, tail, n_segs, i;
+	uint16_t n_rx_pkts = 0;
+	struct memif_zc_slot *slot;
+	memif_desc_t *d0;
+	struct rte_mbuf *mbuf;
+	int ret;
+	struct rte_eth_link link;
+
+	if (unlikely((pmd->flags & ETH_MEMIF_FLAG_CONNECTED) == 0))
+		return 0;
+	if (unlikely(ring == NULL || zr == NULL)) {
+		/* Secondary process will attempt to request regions. */
+		ret = rte_eth_link_get(mq->in_port, &link);
+		if (ret < 0)
+			MIF_LOG(ERR, "Failed to get port %u link info: %s",
+				mq->in_port, rte_strerror(-ret));
+		return 0;
+	}
+
+	/* consume interrupt */
+	if ((rte_intr_fd_get(mq->intr_handle) >= 0) &&
+	    ((ring->flags & MEMIF_RING_FLAG_MASK_INT) == 0)) {
+		uint64_t b;
+		ssize_t size __rte_unused;
+		size = read(rte_intr_fd_get(mq->intr_handle), &b,
+			    sizeof(b));
+	}
+
+	mask = (1 << mq->log2_ring_size) - 1;
+
+	/* Give back to the client the buffers freed, in ring order. */
+	tail = mq->last_tail;
+	while (tail != mq->last_head &&
+	       rte_atomic_load_explicit(&zr->slots[tail & mask].done,
+					rte_memory_order_acquire)) {
+		rte_atomic_store_explicit(&zr->slots[tail & mask].done, 0,
+					  rte_memory_order_relaxed);
+		tail++;
+	}
+	if (tail != mq->last_tail) {
+		mq->last_tail = tail;
+		/* The ring->tail acts as a guard variable between Tx and Rx
+		 * threads, so using store-release pairs with load-acquire
+		 * in function eth_memif_tx.
+		 */
+		rte_atomic_store_explicit(&ring->tail, tail,
+					  rte_memory_order_release);
+	}
+
+	cur_slot = mq->last_head;
+	last_slot = rte_atomic_load_explicit(&ring->head, rte_memory_order_acquire);
+	n_slots = last_slot - cur_slot;
+
+	while (n_slots && n_rx_pkts < nb_pkts) {
+		/* count the descriptors of the packet */
+		n_segs = 0;
+		do {
+			d0 = &ring->desc[(cur_slot + n_segs) & mask];
+			n_segs++;
+		} while ((d0->flags & MEMIF_DESC_FLAG_NEXT) && n_segs < n_slots);
+		if (unlikely(d0->flags & MEMIF_DESC_FLAG_NEXT)) {
+			MIF_LOG(ERR, "Incomplete multi-segment packet");
+			break;
+		}
+
+		if (unlikely(n_segs > MEMIF_ZC_MAX_SEGS)) {
+			MIF_LOG(ERR, "number-of-segments-overflow");
+			for (i = 0; i < n_segs; i++)
+				rte_atomic_store_explicit(
+					&zr->slots[cur_slot++ & mask].done, 1,
+					rte_memory_order_relaxed);
+			n_slots -= n_segs;
+			continue;
+		}
+
+		if (unlikely(rte_pktmbuf_alloc_bulk(mq->mempool, segs, n_segs) < 0))
+			break;
+
+		for (i = 0; i < n_segs; i++) {
+			s0 = cur_slot++ & mask;
+			d0 = &ring->desc[s0];
+			slot = &zr->slots[s0];
+			mbuf = segs[i];
+
+			rte_mbuf_ext_refcnt_set(&slot->shinfo, 1);
+			rte_atomic_fetch_add_explicit(&zr->refcnt, 1,
+						      rte_memory_order_relaxed);
+			rte_pktmbuf_attach_extbuf(mbuf,
+				memif_get_buffer(proc_private, d0),
+				RTE_BAD_IOVA, d0->length, &slot->shinfo);
+			mbuf->port = mq->in_port;
+			rte_pktmbuf_data_len(mbuf) = d0->length;
+			rte_pktmbuf_pkt_len(mbuf) = d0->length;
+			if (i > 0)
+				memif_pktmbuf_chain(segs[0], segs[i - 1], mbuf);
+		}
+		n_slots -= n_segs;
+
+		mq->n_bytes += rte_pktmbuf_pkt_len(segs[0]);
+		*bufs++ = segs[0];
+		n_rx_pkts++;
+	}
+
+	mq->last_head = cur_slot;
+	mq->n_pkts += n_rx_pkts;
+
+	return n_rx_pkts;
+}
+
 static uint16_t
 eth_memif_tx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 {
@@ -1001,17 +1194,25 @@ memif_free_regions(struct rte_eth_dev *dev)
 {
 	struct pmd_process_private *proc_private = dev->process_private;
 	struct pmd_internals *pmd = dev->data->dev_private;
+	bool keep_mapped = false;
 	int i;
 	struct memif_region *r;
 
+	if ((pmd->flags & ETH_MEMIF_FLAG_RX_EXTBUF) &&
+	    memif_zc_rings_release(dev) > 0) {
+		MIF_LOG(WARNING, "Client buffers still in use, keeping regions mapped.");
+		keep_mapped = true;
+	}
+
 	/* regions are allocated contiguously, so it's
 	 * enough to loop until 'proc_private->regions_num'
 	 */
 	for (i = 0; i < proc_private->regions_num; i++) {
 		r = proc_private->regions[i];
 		if (r != NULL) {
-			/* This is memzone */
-			if (i > 0 && (pmd->flags & ETH_MEMIF_FLAG_ZERO_COPY)) {
+			/* This is memzone, or still used by the application */
+			if ((i > 0 && (pmd->flags & ETH_MEMIF_FLAG_ZERO_COPY)) ||
+			    keep_mapped) {
 				r->addr = NULL;
 				if (r->fd > 0)
 					close(r->fd);
@@ -1357,6 +1558,11 @@ memif_connect(struct rte_eth_dev *dev)
 			/* enable polling mode */
 			if (pmd->role == MEMIF_ROLE_SERVER)
 				ring->flags = MEMIF_RING_FLAG_MASK_INT;
+			if ((pmd->flags & ETH_MEMIF_FLAG_RX_EXTBUF) &&
+			    mq->zc_ring == NULL && memif_zc_ring_alloc(mq) < 0) {
+				MIF_LOG(ERR, "Failed to alloc zero-copy ring");
+				return -ENOMEM;
+			}
 		}
 		for (i = 0; i < pmd->run.num_s2c_rings; i++) {
 			mq = (pmd->role == MEMIF_ROLE_CLIENT) ?
@@ -1720,9 +1926,12 @@ memif_create(struct rte_vdev_device *vdev, enum memif_role_t role,
 	pmd->flags = flags;
 	pmd->flags |= ETH_MEMIF_FLAG_DISABLED;
 	pmd->role = role;
-	/* Zero-copy flag irelevant to server. */
-	if (pmd->role == MEMIF_ROLE_SERVER)
+	/* Zero-copy server receives the client buffers without copy. */
+	if (pmd->role == MEMIF_ROLE_SERVER &&
+	    (pmd->flags & ETH_MEMIF_FLAG_ZERO_COPY)) {
 		pmd->flags &= ~ETH_MEMIF_FLAG_ZERO_COPY;
+		pmd->flags |= ETH_MEMIF_FLAG_RX_EXTBUF;
+	}
 	pmd->owner_uid = owner_uid;
 	pmd->owner_gid = owner_gid;
 
@@ -1755,6 +1964,9 @@ memif_create(struct rte_vdev_device *vdev, enum memif_role_t role,
 	if (pmd->flags & ETH_MEMIF_FLAG_ZERO_COPY) {
 		eth_dev->rx_pkt_burst = eth_memif_rx_zc;
 		eth_dev->tx_pkt_burst = eth_memif_tx_zc;
+	} else if (pmd->flags & ETH_MEMIF_FLAG_RX_EXTBUF) {
+		eth_dev->rx_pkt_burst = eth_memif_rx_server_zc;
+		eth_dev->tx_pkt_burst = eth_memif_tx;
 	} else {
 		eth_dev->rx_pkt_burst = eth_memif_rx;
 		eth_dev->tx_pkt_burst = eth_memif_tx;
@@ -46,6 +46,22 @@ struct memif_region {
 	/**< offset from 'addr' to first packet buffer */
 };
 
+struct memif_zc_ring;
+
+/* Client buffer received by a zero-copy server */
+struct memif_zc_slot {
+	struct rte_mbuf_ext_shared_info shinfo;	/**< external buffer info */
+	struct memif_zc_ring *zr;		/**< owner ring */
+	RTE_ATOMIC(uint16_t) done;		/**< buffer freed by application */
+};
+
+/* Client buffers received by a zero-copy server, one per ring slot */
+struct memif_zc_ring {
+	RTE_ATOMIC(uint32_t) refcnt;
+	/**< queue reference and one per buffer held by application */
+	struct memif_zc_slot slots[];
+};
+
 struct memif_queue {
 	struct rte_mempool *mempool;		/**< mempool for RX packets */
 	struct pmd_internals *pmd;		/**< device internals */
@@ -65,6 +81,8 @@ struct memif_queue {
 	/**< Stored mbufs. Used in zero-copy tx. Client stores transmitted
 	 * mbufs to free them once server has received them.
 	 */
+	struct memif_zc_ring *zc_ring;
+	/**< Client buffers attached to mbufs. Used in zero-copy server rx. */
 
 	/* rx/tx info */
 	uint64_t n_pkts;			/**< number of rx/tx packets */
@@ -89,6 +107,8 @@ struct pmd_internals {
 /**< device has not been configured and can not accept connection requests */
 #define ETH_MEMIF_FLAG_SOCKET_ABSTRACT	(1 << 4)
 /**< use abstract socket address */
+#define ETH_MEMIF_FLAG_RX_EXTBUF		(1 << 5)
+/**< server receives the client buffers as external mbuf buffers */
 
 	char *socket_filename;			/**< pointer to socket filename */
 	uid_t owner_uid;			/**< socket owner uid */
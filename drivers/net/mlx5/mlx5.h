@@ -1419,6 +1419,9 @@ LIST_HEAD(aso_ct_list, mlx5_aso_ct_action);
 
 #define MLX5_ASO_CT_SQ_NUM 16
 
+/* Maximum number of CT contexts queried with a single doorbell. */
+#define MLX5_ASO_CT_QUERY_BULK 64
+
 /* Pools management structure for ASO connection tracking pools. */
 struct mlx5_aso_ct_pools_mng {
 	struct mlx5_aso_ct_pool **pools;
@@ -2672,6 +2675,11 @@ int mlx5_aso_ct_query_by_wqe(struct mlx5_dev_ctx_shared *sh, uint32_t queue,
 			     struct mlx5_aso_ct_action *ct,
 			     struct rte_flow_action_conntrack *profile,
 			     void *user_data, bool push);
+int mlx5_aso_ct_query_bulk(struct mlx5_dev_ctx_shared *sh,
+			   struct mlx5_aso_ct_pool *pool,
+			   struct mlx5_aso_ct_action **cts,
+			   struct rte_flow_action_conntrack *profiles,
+			   uint32_t n);
 int mlx5_aso_ct_available(struct mlx5_dev_ctx_shared *sh, uint32_t queue,
 			  struct mlx5_aso_ct_action *ct);
 uint32_t
@@ -1768,6 +1768,83 @@ mlx5_aso_ct_query_by_wqe(struct mlx5_dev_ctx_shared *sh,
 	return ret;
 }
 
+/*
+ * Query the contexts of HW steering connection tracking objects in bulk.
+ *
+ * The WQEs of a batch are posted on the shared SQ of the pool with
+ * a single doorbell and their completions are polled together,
+ * instead of a doorbell and a completion round trip per object.
+ *
+ * @param[in] sh
+ *   Pointer to shared device context.
+ * @param[in] pool
+ *   Pointer to the CT pool of the objects.
+ * @param[in] cts
+ *   Array of connection tracking offload objects.
+ * @param[out] profiles
+ *   Array of connection tracking TCP information, in the same order.
+ * @param[in] n
+ *   Number of objects to query.
+ *
+ * @return
+ *   0 on success, -1 on failure.
+ */
+int
+mlx5_aso_ct_query_bulk(struct mlx5_dev_ctx_shared *sh,
+		       struct mlx5_aso_ct_pool *pool,
+		       struct mlx5_aso_ct_action **cts,
+		       struct rte_flow_action_conntrack *profiles,
+		       uint32_t n)
+{
+	uint32_t poll_wqe_times = MLX5_CT_POLL_WQE_CQE_TIMES;
+	struct mlx5_aso_sq *sq = pool->shared_sq;
+	char out_data[MLX5_ASO_CT_QUERY_BULK][64];
+	uint32_t done = 0;
+	uint32_t posted;
+	uint32_t i;
+	int ret = 0;
+
+	while (done < n) {
+		rte_spinlock_lock(&sq->sqsl);
+		mlx5_aso_ct_completion_handle(sh, sq, false);
+		for (posted = 0; posted < MLX5_ASO_CT_QUERY_BULK &&
+		     done + posted < n; posted++) {
+			ret = mlx5_aso_ct_sq_query_single(sh, sq,
+					cts[done + posted], out_data[posted],
+					false, NULL, false);
+			if (ret <= 0)
+				break;
+		}
+		mlx5_aso_push_wqe(sh, sq);
+		rte_spinlock_unlock(&sq->sqsl);
+		/* The posted WQEs are completed before their data is released. */
+		for (i = 0; i < posted; i++)
+			if (mlx5_aso_ct_wait_ready(sh, MLX5_HW_INV_QUEUE,
+						   cts[done + i]))
+				ret = -1;
+		if (ret < 0)
+			return -1;
+		/* The completions may be copied by another thread. */
+		rte_spinlock_lock(&sq->sqsl);
+		rte_spinlock_unlock(&sq->sqsl);
+		for (i = 0; i < posted; i++)
+			mlx5_aso_ct_obj_analyze(&profiles[done + i], out_data[i]);
+		done += posted;
+		if (posted) {
+			poll_wqe_times = MLX5_CT_POLL_WQE_CQE_TIMES;
+			continue;
+		}
+		/* Waiting for wqe resource or state. */
+		if (!--poll_wqe_times) {
+			DRV_LOG(ERR, "Fail to send WQE for ASO CT %d in pool %d",
+				cts[done]->offset, pool->index);
+			return -1;
+		}
+		rte_delay_us_sleep(10u);
+	}
+	return 0;
+}
+
 /*
  * Make sure the conntrack context is synchronized with hardware before
  * creating a flow rule that uses it.
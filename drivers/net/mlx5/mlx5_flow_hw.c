@@ -5,6 +5,7 @@
 #include <eal_export.h>
 #include <rte_flow.h>
 #include <rte_flow_driver.h>
+#include <rte_hash.h>
 #include <rte_stdatomic.h>
 
 #include <mlx5_malloc.h>
@@ -12629,6 +12630,130 @@ flow_hw_conntrack_query(struct rte_eth_dev *dev, uint32_t queue, uint32_t idx,
 	return 0;
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pmd_mlx5_conntrack_query_bulk, 26.03)
+int
+rte_pmd_mlx5_conntrack_query_bulk(uint16_t port_id,
+				  struct rte_flow_action_handle *const handles[],
+				  struct rte_flow_action_conntrack profiles[],
+				  uint32_t n)
+{
+	struct mlx5_aso_ct_action *cts[MLX5_ASO_CT_QUERY_BULK];
+	struct rte_eth_dev *dev;
+	struct mlx5_priv *priv;
+	struct mlx5_aso_ct_pool *pool;
+	uint32_t done, cnt, i;
+
+	if (rte_eth_dev_is_valid_port(port_id) < 0) {
+		DRV_LOG(ERR, "port %u: no Ethernet device", port_id);
+		rte_errno = ENODEV;
+		return -rte_errno;
+	}
+	dev = &rte_eth_devices[port_id];
+	priv = dev->data->dev_private;
+	pool = priv->hws_ctpool;
+	if (!mlx5_hws_active(dev) || !pool) {
+		DRV_LOG(ERR, "port %u: HWS CT not active", port_id);
+		rte_errno = EINVAL;
+		return -rte_errno;
+	}
+	if (priv->shared_host) {
+		DRV_LOG(ERR, "port %u: CT query is not allowed to guest port",
+			port_id);
+		rte_errno = ENOTSUP;
+		return -rte_errno;
+	}
+	for (done = 0; done < n; done += cnt) {
+		cnt = RTE_MIN(n - done, (uint32_t)MLX5_ASO_CT_QUERY_BULK);
+		for (i = 0; i < cnt; i++) {
+			uint32_t act_idx = (uint32_t)(uintptr_t)handles[done + i];
+
+			if (act_idx >> MLX5_INDIRECT_ACTION_TYPE_OFFSET !=
+			    MLX5_INDIRECT_ACTION_TYPE_CT)
+				cts[i] = NULL;
+			else
+				cts[i] = mlx5_ipool_get(pool->cts,
+					MLX5_INDIRECT_ACTION_IDX_GET(handles[done + i]));
+			if (!cts[i]) {
+				DRV_LOG(ERR, "port %u: invalid CT handle %p",
+					port_id, (void *)handles[done + i]);
+				rte_errno = EINVAL;
+				return -rte_errno;
+			}
+			profiles[done + i].peer_port = cts[i]->peer;
+			profiles[done + i].is_original_dir = cts[i]->is_original;
+		}
+		if (mlx5_aso_ct_query_bulk(priv->sh, pool, cts,
+					   &profiles[done], cnt)) {
+			DRV_LOG(ERR, "port %u: failed to query CT contexts",
+				port_id);
+			rte_errno = EIO;
+			return -rte_errno;
+		}
+	}
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pmd_mlx5_conntrack_get_aged, 26.03)
+int
+rte_pmd_mlx5_conntrack_get_aged(uint16_t port_id, uint32_t queue_id,
+				struct rte_flow_action_handle *handles[],
+				struct rte_flow_action_conntrack profiles[],
+				uint32_t n)
+{
+	struct rte_flow_error error;
+	int nb;
+	int ret;
+
+	nb = rte_flow_get_q_aged_flows(port_id, queue_id, (void **)handles,
+				       n, &error);
+	if (nb <= 0)
+		return nb;
+	ret = rte_pmd_mlx5_conntrack_query_bulk(port_id, handles, profiles, nb);
+	return ret < 0 ? ret : nb;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pmd_mlx5_conntrack_sync_hash, 26.03)
+int
+rte_pmd_mlx5_conntrack_sync_hash(uint16_t port_id, struct rte_hash *h,
+				 struct rte_flow_action_handle *const handles[],
+				 uint32_t n)
+{
+	struct rte_flow_action_handle *hits[RTE_HASH_LOOKUP_BULK_MAX];
+	struct rte_flow_action_conntrack profiles[RTE_HASH_LOOKUP_BULK_MAX];
+	const void *keys[RTE_HASH_LOOKUP_BULK_MAX];
+	void *data[RTE_HASH_LOOKUP_BULK_MAX];
+	uint32_t done, cnt, nb_hits, i;
+	uint64_t hit_mask;
+	int synced = 0;
+	int ret;
+
+	for (done = 0; done < n; done += cnt) {
+		cnt = RTE_MIN(n - done, (uint32_t)RTE_HASH_LOOKUP_BULK_MAX);
+		for (i = 0; i < cnt; i++)
+			keys[i] = &handles[done + i];
+		ret = rte_hash_lookup_bulk_data(h, keys, cnt, &hit_mask, data);
+		if (ret < 0) {
+			rte_errno = -ret;
+			return ret;
+		}
+		nb_hits = 0;
+		for (i = 0; i < cnt; i++)
+			if (hit_mask & RTE_BIT64(i))
+				hits[nb_hits++] = handles[done + i];
+		ret = rte_pmd_mlx5_conntrack_query_bulk(port_id, hits, profiles,
+							nb_hits);
+		if (ret < 0)
+			return ret;
+		nb_hits = 0;
+		for (i = 0; i < cnt; i++)
+			if (hit_mask & RTE_BIT64(i))
+				memcpy(data[i], &profiles[nb_hits++],
+				       sizeof(profiles[0]));
+		synced += nb_hits;
+	}
+	return synced;
+}
+
 
 static int
 flow_hw_conntrack_update(struct rte_eth_dev *dev, uint32_t queue,
@@ -679,6 +679,103 @@ __rte_experimental
 int
 rte_pmd_mlx5_rss_tir_unregister(uint16_t port_id, void *handle);
 
+/**
+ * Query the state of connection tracking indirect actions in bulk.
+ *
+ * Only supported with HW steering (dv_flow_en=2).
+ * The queries of up to 64 objects are posted together to the device
+ * and their completions are polled at once, which is much cheaper than
+ * querying the objects one by one with #rte_flow_action_handle_query.
+ * The call is synchronous and may be done from any thread.
+ *
+ * @param[in] port_id
+ *   The port identifier of the Ethernet device.
+ * @param[in] handles
+ *   Indirect CONNTRACK action handles.
+ * @param[out] profiles
+ *   States of the connection tracking objects, in the order of *handles*.
+ * @param[in] n
+ *   Number of objects to query.
+ *
+ * @return
+ *   - (0) if successful.
+ *   - (-ENODEV) if *port_id* invalid.
+ *   - (-EINVAL) if a handle was invalid or port HWS CT was not activated.
+ *   - (-ENOTSUP) if the port shares the CT objects of another port.
+ *   - (-EIO) if the device did not answer.
+ */
+__rte_experimental
+int
+rte_pmd_mlx5_conntrack_query_bulk(uint16_t port_id,
+				  struct rte_flow_action_handle *const handles[],
+				  struct rte_flow_action_conntrack profiles[],
+				  uint32_t n);
+
+/**
+ * Get the aged connection tracking objects with their last state.
+ *
+ * The flows of the connections must use an AGE action whose context
+ * is the handle of their indirect CONNTRACK action.
+ * The aged contexts are retrieved with #rte_flow_get_q_aged_flows
+ * and their state is queried with #rte_pmd_mlx5_conntrack_query_bulk,
+ * so that the connection table of the application can be updated
+ * before the objects are destroyed or reused.
+ *
+ * @param[in] port_id
+ *   The port identifier of the Ethernet device.
+ * @param[in] queue_id
+ *   Flow queue to poll the aged flows from, as in #rte_flow_get_q_aged_flows.
+ * @param[out] handles
+ *   Indirect CONNTRACK action handles of the aged flows.
+ * @param[out] profiles
+ *   States of the connection tracking objects, in the order of *handles*.
+ * @param[in] n
+ *   Size of *handles* and *profiles*.
+ *
+ * @return
+ *   - The number of aged objects returned if successful.
+ *   - A negative errno value otherwise.
+ */
+__rte_experimental
+int
+rte_pmd_mlx5_conntrack_get_aged(uint16_t port_id, uint32_t queue_id,
+				struct rte_flow_action_handle *handles[],
+				struct rte_flow_action_conntrack profiles[],
+				uint32_t n);
+
+struct rte_hash;
+
+/**
+ * Synchronize the connection table of the application with the device.
+ *
+ * The keys of the hash table are the indirect CONNTRACK action handles
+ * (key length of a pointer) and the data of each entry points to
+ * a struct rte_flow_action_conntrack owned by the application.
+ * The state of the given handles found in the table is queried
+ * in bulk and written to their entry data.
+ *
+ * The hash table is only read, the application must serialize
+ * the call with its own updates of the table.
+ *
+ * @param[in] port_id
+ *   The port identifier of the Ethernet device.
+ * @param[in] h
+ *   Hash table of the connections.
+ * @param[in] handles
+ *   Indirect CONNTRACK action handles to synchronize.
+ * @param[in] n
+ *   Number of handles.
+ *
+ * @return
+ *   - The number of entries updated if successful.
+ *   - A negative errno value otherwise.
+ */
+__rte_experimental
+int
+rte_pmd_mlx5_conntrack_sync_hash(uint16_t port_id, struct rte_hash *h,
+				 struct rte_flow_action_handle *const handles[],
+				 uint32_t n);
+
 
 #ifdef __cplusplus
 }
@@ -63,6 +63,7 @@
 #define NETVSC_ARG_RXBREAK "rx_copybreak"
 #define NETVSC_ARG_TXBREAK "tx_copybreak"
 #define NETVSC_ARG_RX_EXTMBUF_ENABLE "rx_extmbuf_enable"
+#define NETVSC_ARG_NUMA_AWARE "numa_aware"
 
 /* The max number of retry when hot adding a VF device */
 #define NETVSC_MAX_HOTADD_RETRY 10
@@ -196,6 +197,10 @@ static int hn_set_parameter(const char *key, const char *value, void *opaque)
 		hv->rx_extmbuf_enable = v;
 		PMD_DRV_LOG(DEBUG, "rx extmbuf enable set to %u",
 			    hv->rx_extmbuf_enable);
+	} else if (!strcmp(key, NETVSC_ARG_NUMA_AWARE)) {
+		hv->numa_aware = v;
+		PMD_DRV_LOG(DEBUG, "numa aware set to %u",
+			    hv->numa_aware);
 	}
 
 	return 0;
@@ -1346,6 +1351,7 @@ eth_hn_dev_init(struct rte_eth_dev *eth_dev)
 	hv->rx_copybreak = HN_RXCOPY_THRESHOLD;
 	hv->tx_copybreak = HN_TXCOPY_THRESHOLD;
 	hv->rx_extmbuf_enable = HN_RX_EXTMBUF_ENABLE;
+	hv->numa_aware = HN_NUMA_AWARE;
 	hv->max_queues = 1;
 
 	rte_rwlock_init(&hv->vf_lock);
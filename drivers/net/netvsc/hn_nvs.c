@@ -114,7 +114,7 @@ __hn_nvs_execute(struct hn_data *hv,
 	/* Silently drop received packets while waiting for response */
 	switch (hdr->type) {
 	case NVS_TYPE_RNDIS:
-		hn_nvs_ack_rxbuf(hv, chan, xactid);
+		hn_nvs_ack_rxbuf(hv, chan, xactid, NULL);
 		/* fallthrough */
 
 	case NVS_TYPE_TXTBL_NOTE:
@@ -516,9 +516,12 @@ hn_nvs_detach(struct hn_data *hv __rte_unused)
 /*
  * Ack the consumed RXBUF associated w/ this channel packet,
  * so that this RXBUF can be recycled by the hypervisor.
+ * If need_sig is set, the host is signaled later by the caller,
+ * once for all the acks of a batch.
  */
 void
-hn_nvs_ack_rxbuf(struct hn_data *hv, struct vmbus_channel *chan, uint64_t tid)
+hn_nvs_ack_rxbuf(struct hn_data *hv, struct vmbus_channel *chan,
+		 uint64_t tid, bool *need_sig)
 {
 	unsigned int retries = 0;
 	struct hn_nvs_rndis_ack ack = {
@@ -532,12 +535,19 @@ hn_nvs_ack_rxbuf(struct hn_data *hv, struct vmbus_channel *chan, uint64_t tid)
  again:
 	error = rte_vmbus_chan_send(hn_nvs_get_vmbus_device(hv), chan,
 				    VMBUS_CHANPKT_TYPE_COMP, &ack, sizeof(ack),
-				    tid, VMBUS_CHANPKT_FLAG_NONE, NULL);
+				    tid, VMBUS_CHANPKT_FLAG_NONE, need_sig);
 
 	if (error == 0)
 		return;
 
 	if (error == -EAGAIN) {
+		/* Let the host drain the acks not signaled yet */
+		if (need_sig && *need_sig) {
+			rte_vmbus_chan_signal_tx(hn_nvs_get_vmbus_device(hv),
+						 chan);
+			*need_sig = false;
+		}
+
 		/*
 		 * NOTE:
 		 * This should _not_ happen in real world, since the
@@ -273,6 +273,7 @@ hn_dev_tx_queue_setup(struct rte_eth_dev *dev,
 	txq->port_id = dev->data->port_id;
 	txq->queue_id = queue_idx;
 	txq->free_thresh = tx_free_thresh;
+	txq->socket_id = socket_id;
 
 	snprintf(name, sizeof(name),
 		 "hn_txd_%u_%u", dev->data->port_id, queue_idx);
@@ -281,7 +282,7 @@ hn_dev_tx_queue_setup(struct rte_eth_dev *dev,
 		     name, nb_desc, sizeof(struct hn_txdesc));
 
 	txq->tx_rndis_mz = rte_memzone_reserve_aligned(name,
-			nb_desc * HN_RNDIS_PKT_ALIGNED, rte_socket_id(),
+			nb_desc * HN_RNDIS_PKT_ALIGNED, socket_id,
 			RTE_MEMZONE_IOVA_CONTIG, HN_RNDIS_PKT_ALIGNED);
 	if (!txq->tx_rndis_mz) {
 		err = -rte_errno;
@@ -294,7 +295,7 @@ hn_dev_tx_queue_setup(struct rte_eth_dev *dev,
 					      sizeof(struct hn_txdesc),
 					      0, 0, NULL, NULL,
 					      hn_txd_init, txq,
-					      dev->device->numa_node, 0);
+					      socket_id, 0);
 	if (txq->txdesc_pool == NULL) {
 		PMD_DRV_LOG(ERR,
 			    "mempool %s create failed: %d", name, rte_errno);
@@ -559,7 +560,7 @@ static void hn_rx_buf_free_cb(void *buf __rte_unused, void *opaque)
 	struct hn_data *hv = rxq->hv;
 
 	rte_atomic32_dec(&rxq->rxbuf_outstanding);
-	hn_nvs_ack_rxbuf(hv, rxb->chan, rxb->xactid);
+	hn_nvs_ack_rxbuf(hv, rxb->chan, rxb->xactid, NULL);
 }
 
 static struct hn_rx_bufinfo *hn_rx_buf_init(struct hn_rx_queue *rxq,
@@ -794,7 +795,7 @@ hn_nvs_handle_rxbuf(struct rte_eth_dev *dev,
 		    struct hn_data *hv,
 		    struct hn_rx_queue *rxq,
 		    const struct vmbus_chanpkt_hdr *hdr,
-		    const void *buf)
+		    const void *buf, bool *need_sig)
 {
 	const struct vmbus_chanpkt_rxbuf *pkt;
 	const struct hn_nvs_hdr *nvs_hdr = buf;
@@ -870,7 +871,7 @@ hn_nvs_handle_rxbuf(struct rte_eth_dev *dev,
 
 	/* Send ACK now if external mbuf not used */
 	if (rte_mbuf_ext_refcnt_update(&rxb->shinfo, -1) == 0)
-		hn_nvs_ack_rxbuf(hv, rxb->chan, rxb->xactid);
+		hn_nvs_ack_rxbuf(hv, rxb->chan, rxb->xactid, need_sig);
 }
 
 /*
@@ -918,6 +919,7 @@ struct hn_rx_queue *hn_rx_queue_alloc(struct hn_data *hv,
 	rte_spinlock_init(&rxq->ring_lock);
 	rxq->port_id = hv->port_id;
 	rxq->queue_id = queue_id;
+	rxq->socket_id = socket_id;
 	rxq->event_sz = HN_RXQ_EVENT_DEFAULT;
 	rxq->event_buf = rte_malloc_socket("HN_EVENTS", HN_RXQ_EVENT_DEFAULT,
 					   RTE_CACHE_LINE_SIZE, socket_id);
@@ -928,10 +930,10 @@ struct hn_rx_queue *hn_rx_queue_alloc(struct hn_data *hv,
 
 	/* setup rxbuf_info for non-primary queue */
 	if (queue_id) {
-		rxq->rxbuf_info = rte_calloc("HN_RXBUF_INFO",
+		rxq->rxbuf_info = rte_calloc_socket("HN_RXBUF_INFO",
 					hv->rxbuf_section_cnt,
 					sizeof(*rxq->rxbuf_info),
-					RTE_CACHE_LINE_SIZE);
+					RTE_CACHE_LINE_SIZE, socket_id);
 
 		if (!rxq->rxbuf_info) {
 			PMD_DRV_LOG(ERR,
@@ -989,6 +991,7 @@ hn_dev_rx_queue_setup(struct rte_eth_dev *dev,
 	}
 
 	rxq->mb_pool = mp;
+	rxq->socket_id = socket_id;
 	count = rte_mempool_avail_count(mp) / dev->data->nb_rx_queues;
 	if (nb_desc == 0 || nb_desc > count)
 		nb_desc = count;
@@ -1106,6 +1109,7 @@ uint32_t hn_process_events(struct hn_data *hv, uint16_t queue_id,
 	struct hn_rx_queue *rxq;
 	uint32_t bytes_read = 0;
 	uint32_t tx_done = 0;
+	bool need_sig = false;
 	int ret = 0;
 
 	rxq = queue_id == 0 ? hv->primary : dev->data->rx_queues[queue_id];
@@ -1159,7 +1163,8 @@ uint32_t hn_process_events(struct hn_data *hv, uint16_t queue_id,
 			break;
 
 		case VMBUS_CHANPKT_TYPE_RXBUF:
-			hn_nvs_handle_rxbuf(dev, hv, rxq, pkt, data);
+			hn_nvs_handle_rxbuf(dev, hv, rxq, pkt, data,
+					    &need_sig);
 			break;
 
 		case VMBUS_CHANPKT_TYPE_INBAND:
@@ -1178,6 +1183,10 @@ uint32_t hn_process_events(struct hn_data *hv, uint16_t queue_id,
 	if (bytes_read > 0)
 		rte_vmbus_chan_signal_read(hn_nvs_get_vmbus_device(hv), rxq->chan, bytes_read);
 
+	/* Signal the RXBUF acks of all the events at once */
+	if (need_sig)
+		rte_vmbus_chan_signal_tx(hn_nvs_get_vmbus_device(hv), rxq->chan);
+
 	rte_spinlock_unlock(&rxq->ring_lock);
 
 	return tx_done;
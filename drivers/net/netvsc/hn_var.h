@@ -30,6 +30,7 @@
 #define HN_RXCOPY_THRESHOLD	256
 
 #define HN_RX_EXTMBUF_ENABLE	0
+#define HN_NUMA_AWARE		0
 
 struct hn_data;
 struct hn_txdesc;
@@ -52,6 +53,7 @@ struct hn_tx_queue {
 	uint16_t	port_id;
 	uint16_t	queue_id;
 	uint32_t	free_thresh;
+	unsigned int	socket_id;
 	struct rte_mempool *txdesc_pool;
 	const struct rte_memzone *tx_rndis_mz;
 	void		*tx_rndis;
@@ -81,6 +83,7 @@ struct hn_rx_queue {
 	uint32_t event_sz;
 	uint16_t port_id;
 	uint16_t queue_id;
+	unsigned int socket_id;
 	struct hn_stats stats;
 
 	void *event_buf;
@@ -147,6 +150,7 @@ struct hn_data {
 	uint32_t	rxbuf_section_cnt;	/* # of Rx sections */
 	uint32_t	rx_copybreak;
 	uint32_t	rx_extmbuf_enable;
+	uint32_t	numa_aware;
 	uint16_t	max_queues;		/* Max available queues */
 	uint16_t	num_queues;
 	uint64_t	rss_offloads;
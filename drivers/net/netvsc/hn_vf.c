@@ -91,6 +91,13 @@ static int hn_vf_attach(struct rte_eth_dev *dev, struct hn_data *hv)
 	PMD_DRV_LOG(DEBUG, "Attach VF device %u", port);
 	hv->vf_ctx.vf_attached = true;
 	hv->vf_ctx.vf_port = port;
+
+	/* Report the NUMA node of the VF, which carries most of the traffic */
+	if (hv->numa_aware) {
+		dev->data->numa_node = rte_eth_devices[port].data->numa_node;
+		PMD_DRV_LOG(DEBUG, "Use NUMA node %d of VF port %u",
+			    dev->data->numa_node, port);
+	}
 	return 0;
 }
 
@@ -163,8 +170,13 @@ int hn_eth_rmv_event_callback(uint16_t port_id,
 	return 0;
 }
 
+/*
+ * Setup the VF queues on the NUMA node of the synthetic queues,
+ * where they are polled.
+ */
 static int hn_setup_vf_queues(int port, struct rte_eth_dev *dev)
 {
+	struct hn_tx_queue *tx_queue;
 	struct hn_rx_queue *rx_queue;
 	struct rte_eth_txq_info txinfo;
 	struct rte_eth_rxq_info rxinfo;
@@ -179,8 +191,10 @@ static int hn_setup_vf_queues(int port, struct rte_eth_dev *dev)
 			return ret;
 		}
 
-		ret = rte_eth_tx_queue_setup(port, i, txinfo.nb_desc, 0,
-					     &txinfo.conf);
+		tx_queue = dev->data->tx_queues[i];
+
+		ret = rte_eth_tx_queue_setup(port, i, txinfo.nb_desc,
+					     tx_queue->socket_id, &txinfo.conf);
 		if (ret) {
 			PMD_DRV_LOG(ERR,
 				    "rte_eth_tx_queue_setup failed ret=%d",
@@ -200,8 +214,9 @@ static int hn_setup_vf_queues(int port, struct rte_eth_dev *dev)
 
 		rx_queue = dev->data->rx_queues[i];
 
-		ret = rte_eth_rx_queue_setup(port, i, rxinfo.nb_desc, 0,
-					     &rxinfo.conf, rx_queue->mb_pool);
+		ret = rte_eth_rx_queue_setup(port, i, rxinfo.nb_desc,
+					     rx_queue->socket_id, &rxinfo.conf,
+					     rx_queue->mb_pool);
 		if (ret) {
 			PMD_DRV_LOG(ERR,
 				    "rte_eth_rx_queue_setup failed ret=%d",
@@ -215,7 +230,11 @@ static int hn_setup_vf_queues(int port, struct rte_eth_dev *dev)
 
 int hn_vf_add(struct rte_eth_dev *dev, struct hn_data *hv);
 
-static void hn_vf_add_retry(void *args)
+/*
+ * Bring up the VF from the interrupt thread,
+ * the synthetic path keeps forwarding until the data path is switched.
+ */
+static void hn_vf_add_delayed(void *args)
 {
 	struct rte_eth_dev *dev = args;
 	struct hn_data *hv = dev->data->dev_private;
@@ -240,7 +259,7 @@ int hn_vf_add(struct rte_eth_dev *dev, struct hn_data *hv)
 	if (ret) {
 		PMD_DRV_LOG(NOTICE,
 			    "RNDIS reports VF but device not found, retrying");
-		rte_eal_alarm_set(1000000, hn_vf_add_retry, dev);
+		rte_eal_alarm_set(1000000, hn_vf_add_delayed, dev);
 		goto exit;
 	}
 
@@ -341,8 +360,12 @@ hn_nvs_handle_vfassoc(struct rte_eth_dev *dev,
 	hv->vf_ctx.vf_vsp_reported = vf_assoc->allocated;
 
 	if (dev->state == RTE_ETH_DEV_ATTACHED) {
+		/*
+		 * Configuring and starting the VF takes long,
+		 * do not stall the queue polling the events.
+		 */
 		if (vf_assoc->allocated)
-			hn_vf_add(dev, hv);
+			rte_eal_alarm_set(1, hn_vf_add_delayed, dev);
 		else
 			hn_vf_remove(hv);
 	}
@@ -555,7 +578,7 @@ int hn_vf_close(struct rte_eth_dev *dev)
 	int ret = 0;
 	struct hn_data *hv = dev->data->dev_private;
 
-	rte_eal_alarm_cancel(hn_vf_add_retry, dev);
+	rte_eal_alarm_cancel(hn_vf_add_delayed, dev);
 
 	rte_rwlock_read_lock(&hv->vf_lock);
 	if (hv->vf_ctx.vf_attached) {
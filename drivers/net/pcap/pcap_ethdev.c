@@ -20,6 +20,7 @@
 #include <rte_os_shim.h>
 
 #include "pcap_osdep.h"
+#include "pcap_replay.h"
 
 #define RTE_ETH_PCAP_SNAPSHOT_LEN 65535
 #define RTE_ETH_PCAP_SNAPLEN RTE_ETHER_MAX_JUMBO_FRAME_LEN
@@ -34,6 +35,8 @@
 #define ETH_PCAP_IFACE_ARG    "iface"
 #define ETH_PCAP_PHY_MAC_ARG  "phy_mac"
 #define ETH_PCAP_INFINITE_RX_ARG  "infinite_rx"
+#define ETH_PCAP_REPLAY_ARG  "replay"
+#define ETH_PCAP_REPLAY_PACE_ARG  "replay_pace"
 
 #define ETH_PCAP_ARG_MAXLEN	64
 
@@ -75,6 +78,8 @@ struct pcap_rx_queue {
 
 	/* Contains pre-generated packets to be looped through */
 	struct rte_ring *pkts;
+	/* Packets of the file attached to the mbufs in replay mode */
+	struct pcap_replay *replay;
 };
 
 struct pcap_tx_queue {
@@ -94,6 +99,8 @@ struct pmd_internals {
 	int single_iface;
 	int phy_mac;
 	unsigned int infinite_rx;
+	unsigned int replay;
+	unsigned int replay_pace;
 };
 
 struct pmd_process_private {
@@ -122,6 +129,8 @@ struct pmd_devargs_all {
 	unsigned int is_rx_pcap;
 	unsigned int is_rx_iface;
 	unsigned int infinite_rx;
+	unsigned int replay;
+	unsigned int replay_pace;
 };
 
 static const char *valid_arguments[] = {
@@ -133,6 +142,8 @@ static const char *valid_arguments[] = {
 	ETH_PCAP_IFACE_ARG,
 	ETH_PCAP_PHY_MAC_ARG,
 	ETH_PCAP_INFINITE_RX_ARG,
+	ETH_PCAP_REPLAY_ARG,
+	ETH_PCAP_REPLAY_PACE_ARG,
 	NULL
 };
 
@@ -270,6 +281,32 @@ eth_pcap_rx_infinite(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	return i;
 }
 
+static uint16_t
+eth_pcap_rx_replay(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	struct pcap_rx_queue *pcap_q = queue;
+	uint64_t rx_bytes = 0;
+	int i, nb_rx;
+
+	if (unlikely(nb_pkts == 0))
+		return 0;
+
+	nb_rx = pcap_replay_rx(pcap_q->replay, pcap_q->mb_pool, bufs, nb_pkts,
+			&rx_bytes);
+	if (unlikely(nb_rx < 0)) {
+		pcap_q->rx_stat.rx_nombuf++;
+		return 0;
+	}
+
+	for (i = 0; i < nb_rx; i++)
+		bufs[i]->port = pcap_q->port_id;
+
+	pcap_q->rx_stat.pkts += nb_rx;
+	pcap_q->rx_stat.bytes += rx_bytes;
+
+	return nb_rx;
+}
+
 static uint16_t
 eth_pcap_rx(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 {
@@ -863,6 +900,15 @@ eth_dev_close(struct rte_eth_dev *dev)
 		}
 	}
 
+	if (internals->replay) {
+		for (i = 0; i < dev->data->nb_rx_queues; i++) {
+			struct pcap_rx_queue *pcap_q = &internals->rx_queue[i];
+
+			pcap_replay_free(pcap_q->replay);
+			pcap_q->replay = NULL;
+		}
+	}
+
 	if (internals->phy_mac == 0)
 		/* not dynamically allocated, must not be freed */
 		dev->data->mac_addrs = NULL;
@@ -881,7 +927,7 @@ static int
 eth_rx_queue_setup(struct rte_eth_dev *dev,
 		uint16_t rx_queue_id,
 		uint16_t nb_rx_desc __rte_unused,
-		unsigned int socket_id __rte_unused,
+		unsigned int socket_id,
 		const struct rte_eth_rxconf *rx_conf __rte_unused,
 		struct rte_mempool *mb_pool)
 {
@@ -893,7 +939,14 @@ eth_rx_queue_setup(struct rte_eth_dev *dev,
 	pcap_q->queue_id = rx_queue_id;
 	dev->data->rx_queues[rx_queue_id] = pcap_q;
 
-	if (internals->infinite_rx) {
+	if (internals->replay) {
+		/* Loaded once, the packets do not depend on the mempool */
+		if (pcap_q->replay == NULL)
+			pcap_q->replay = pcap_replay_create(pcap_q->name,
+					socket_id, internals->replay_pace);
+		if (pcap_q->replay == NULL)
+			return -EINVAL;
+	} else if (internals->infinite_rx) {
 		struct pmd_process_private *pp;
 		char ring_name[RTE_RING_NAMESIZE];
 		static uint32_t ring_number;
@@ -1358,8 +1411,12 @@ eth_from_pcaps(struct rte_vdev_device *vdev,
 	}
 
 	internals->infinite_rx = infinite_rx;
+	internals->replay = devargs_all->replay;
+	internals->replay_pace = devargs_all->replay_pace;
 	/* Assign rx ops. */
-	if (infinite_rx)
+	if (devargs_all->replay)
+		eth_dev->rx_pkt_burst = eth_pcap_rx_replay;
+	else if (infinite_rx)
 		eth_dev->rx_pkt_burst = eth_pcap_rx_infinite;
 	else if (devargs_all->is_rx_pcap || devargs_all->is_rx_iface ||
 			single_iface)
@@ -1525,6 +1582,30 @@ pmd_pcap_probe(struct rte_vdev_device *dev)
 					"for %s", name);
 		}
 
+		/*
+		 * We check whether we want to replay the pcap file
+		 * from memory, optionally at the pace of its timestamps.
+		 */
+		ret = rte_kvargs_process(kvlist, ETH_PCAP_REPLAY_ARG,
+				&get_infinite_rx_arg, &devargs_all.replay);
+		if (ret < 0)
+			goto free_kvlist;
+		ret = rte_kvargs_process(kvlist, ETH_PCAP_REPLAY_PACE_ARG,
+				&get_infinite_rx_arg, &devargs_all.replay_pace);
+		if (ret < 0)
+			goto free_kvlist;
+		if (devargs_all.replay_pace)
+			devargs_all.replay = 1;
+		if (devargs_all.replay) {
+			PMD_LOG(INFO, "replay%s has been enabled for %s",
+					devargs_all.replay_pace ? " with pacing" : "",
+					name);
+			if (devargs_all.infinite_rx)
+				PMD_LOG(WARNING, "infinite_rx is ignored in replay mode for %s",
+						name);
+			devargs_all.infinite_rx = 0;
+		}
+
 		ret = rte_kvargs_process(kvlist, ETH_PCAP_RX_PCAP_ARG,
 				&open_rx_pcap, &pcaps);
 	} else if (devargs_all.is_rx_iface) {
@@ -1665,4 +1746,6 @@ RTE_PMD_REGISTER_PARAM_STRING(net_pcap,
 	ETH_PCAP_TX_IFACE_ARG "=<ifc> "
 	ETH_PCAP_IFACE_ARG "=<ifc> "
 	ETH_PCAP_PHY_MAC_ARG "=<int>"
-	ETH_PCAP_INFINITE_RX_ARG "=<0|1>");
+	ETH_PCAP_INFINITE_RX_ARG "=<0|1> "
+	ETH_PCAP_REPLAY_ARG "=<0|1> "
+	ETH_PCAP_REPLAY_PACE_ARG "=<0|1>");
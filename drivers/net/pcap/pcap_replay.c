@@ -0,0 +1,539 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <rte_byteorder.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_eal.h>
+#include <rte_eal_paging.h>
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_os_shim.h>
+
+#include "pcap_osdep.h"
+#include "pcap_replay.h"
+
+#define PCAP_MAGIC_US		0xa1b2c3d4
+#define PCAP_MAGIC_NS		0xa1b23c4d
+#define PCAPNG_SHB_TYPE		0x0a0d0d0a
+#define PCAPNG_BYTE_ORDER_MAGIC	0x1a2b3c4d
+#define PCAPNG_IDB_TYPE		0x00000001
+#define PCAPNG_SPB_TYPE		0x00000003
+#define PCAPNG_EPB_TYPE		0x00000006
+#define PCAPNG_OPT_END		0
+#define PCAPNG_OPT_TSRESOL	9
+
+/* Interfaces of a pcapng section with their own timestamp resolution */
+#define PCAPNG_MAX_IFACES	32U
+
+/* Classic pcap headers */
+struct pcap_file_hdr {
+	uint32_t magic;
+	uint16_t version_major;
+	uint16_t version_minor;
+	int32_t thiszone;
+	uint32_t sigfigs;
+	uint32_t snaplen;
+	uint32_t linktype;
+};
+
+struct pcap_rec_hdr {
+	uint32_t ts_sec;
+	uint32_t ts_frac;
+	uint32_t caplen;
+	uint32_t len;
+};
+
+/* pcapng block header and the bodies of the blocks read */
+struct pcapng_block_hdr {
+	uint32_t type;
+	uint32_t len;
+};
+
+struct pcapng_shb {
+	uint32_t magic;
+	uint16_t version_major;
+	uint16_t version_minor;
+	uint64_t section_len;
+};
+
+struct pcapng_idb {
+	uint16_t linktype;
+	uint16_t reserved;
+	uint32_t snaplen;
+};
+
+struct pcapng_epb {
+	uint32_t iface;
+	uint32_t ts_high;
+	uint32_t ts_low;
+	uint32_t caplen;
+	uint32_t len;
+};
+
+struct pcapng_opt {
+	uint16_t code;
+	uint16_t len;
+};
+
+/* Packet of the replay */
+struct pcap_replay_pkt {
+	struct rte_mbuf_ext_shared_info shinfo;
+	void *data;
+	rte_iova_t iova;
+	/* time to receive it, in timer cycles from the first packet */
+	uint64_t tsc;
+	uint16_t len;
+};
+
+struct pcap_replay {
+	uint32_t nb_pkts;
+	uint32_t next;
+	bool pace;
+	/* start time of the current loop, 0 before the first Rx */
+	uint64_t start;
+	/* duration of a loop, in timer cycles */
+	uint64_t duration;
+	uint8_t *data;
+	struct pcap_replay_pkt *pkts;
+};
+
+/* Called for each packet of the file, with its timestamp in ns */
+typedef void (pcap_replay_pkt_cb)(void *arg, const uint8_t *data,
+		uint32_t len, uint64_t ts);
+
+/* Packet data layout, computed once to size the buffer and once to fill it */
+struct pcap_replay_load {
+	struct pcap_replay *r;
+	size_t size;
+	size_t page_sz;
+	uint32_t nb_pkts;
+	uint32_t nb_skipped;
+	uint64_t first_ts;
+	uint64_t last_ts;
+};
+
+static inline uint32_t
+pcap_u32(uint32_t v, bool swap)
+{
+	return swap ? rte_bswap32(v) : v;
+}
+
+static inline uint16_t
+pcap_u16(uint16_t v, bool swap)
+{
+	return swap ? rte_bswap16(v) : v;
+}
+
+static int
+pcap_file_parse(const uint8_t *buf, size_t size, pcap_replay_pkt_cb *cb,
+		void *arg)
+{
+	const struct pcap_file_hdr *fh = (const void *)buf;
+	uint64_t ts_mult;
+	size_t off;
+	bool swap;
+
+	if (size < sizeof(*fh))
+		return -EINVAL;
+
+	switch (fh->magic) {
+	case PCAP_MAGIC_US:
+	case PCAP_MAGIC_NS:
+		swap = false;
+		break;
+	case RTE_STATIC_BSWAP32(PCAP_MAGIC_US):
+	case RTE_STATIC_BSWAP32(PCAP_MAGIC_NS):
+		swap = true;
+		break;
+	default:
+		return -EINVAL;
+	}
+	ts_mult = pcap_u32(fh->magic, swap) == PCAP_MAGIC_NS ? 1 : 1000;
+
+	for (off = sizeof(*fh); off + sizeof(struct pcap_rec_hdr) <= size; ) {
+		const struct pcap_rec_hdr *rh = (const void *)(buf + off);
+		uint32_t caplen = pcap_u32(rh->caplen, swap);
+
+		off += sizeof(*rh);
+		if (caplen > size - off)
+			break;
+
+		cb(arg, buf + off, caplen,
+			(uint64_t)pcap_u32(rh->ts_sec, swap) * NS_PER_S +
+			(uint64_t)pcap_u32(rh->ts_frac, swap) * ts_mult);
+		off += caplen;
+	}
+
+	return 0;
+}
+
+/* Timestamp in ns of a resolution given by the pcapng if_tsresol option */
+static uint64_t
+pcapng_ts_ns(uint64_t ts, uint8_t tsresol)
+{
+	uint8_t exp = tsresol & 0x7f;
+	uint64_t div = 1;
+
+	if (tsresol & 0x80) {
+		if (exp >= 64)
+			return 0;
+		return (ts >> exp) * NS_PER_S +
+			(((ts & ((UINT64_C(1) << exp) - 1)) * NS_PER_S) >> exp);
+	}
+
+	if (exp <= 9) {
+		while (exp++ < 9)
+			ts *= 10;
+		return ts;
+	}
+	while (exp-- > 9)
+		div *= 10;
+	return ts / div;
+}
+
+static int
+pcapng_file_parse(const uint8_t *buf, size_t size, pcap_replay_pkt_cb *cb,
+		void *arg)
+{
+	uint8_t tsresol[PCAPNG_MAX_IFACES];
+	uint32_t snaplen = UINT32_MAX;
+	unsigned int nb_ifaces = 0;
+	bool swap = false;
+	size_t off = 0;
+
+	while (off + sizeof(struct pcapng_block_hdr) <= size) {
+		const struct pcapng_block_hdr *bh = (const void *)(buf + off);
+		const uint8_t *body = buf + off + sizeof(*bh);
+		uint32_t type = pcap_u32(bh->type, swap);
+		uint32_t len, body_len;
+
+		if (type == PCAPNG_SHB_TYPE) {
+			const struct pcapng_shb *shb = (const void *)body;
+
+			if (size - off < sizeof(*bh) + sizeof(*shb))
+				break;
+			if (shb->magic == PCAPNG_BYTE_ORDER_MAGIC)
+				swap = false;
+			else if (shb->magic ==
+					RTE_STATIC_BSWAP32(PCAPNG_BYTE_ORDER_MAGIC))
+				swap = true;
+			else
+				return -EINVAL;
+			/* the interfaces are per section */
+			nb_ifaces = 0;
+			snaplen = UINT32_MAX;
+		} else if (off == 0) {
+			return -EINVAL;
+		}
+
+		len = pcap_u32(bh->len, swap);
+		if (len < sizeof(*bh) + sizeof(uint32_t) || len > size - off ||
+				(len & 3) != 0)
+			break;
+		body_len = len - sizeof(*bh) - sizeof(uint32_t);
+
+		if (type == PCAPNG_IDB_TYPE &&
+				body_len >= sizeof(struct pcapng_idb)) {
+			const struct pcapng_idb *idb = (const void *)body;
+			uint32_t opt_off = sizeof(*idb);
+			uint8_t res = 6; /* default microseconds */
+
+			/* Simple packets are truncated to the first interface snaplen */
+			if (nb_ifaces == 0)
+				snaplen = pcap_u32(idb->snaplen, swap);
+			while (opt_off + sizeof(struct pcapng_opt) <= body_len) {
+				const struct pcapng_opt *opt =
+					(const void *)(body + opt_off);
+				uint16_t code = pcap_u16(opt->code, swap);
+				uint16_t opt_len = pcap_u16(opt->len, swap);
+
+				if (code == PCAPNG_OPT_END)
+					break;
+				opt_off += sizeof(*opt);
+				if (opt_len > body_len - opt_off)
+					break;
+				if (code == PCAPNG_OPT_TSRESOL && opt_len >= 1)
+					res = body[opt_off];
+				opt_off += RTE_ALIGN(opt_len, sizeof(uint32_t));
+			}
+			if (nb_ifaces < PCAPNG_MAX_IFACES)
+				tsresol[nb_ifaces] = res;
+			nb_ifaces++;
+		} else if (type == PCAPNG_EPB_TYPE &&
+				body_len >= sizeof(struct pcapng_epb)) {
+			const struct pcapng_epb *epb = (const void *)body;
+			uint32_t iface = pcap_u32(epb->iface, swap);
+			uint32_t caplen = pcap_u32(epb->caplen, swap);
+			uint64_t ts = (uint64_t)pcap_u32(epb->ts_high, swap) << 32 |
+				pcap_u32(epb->ts_low, swap);
+
+			if (caplen <= body_len - sizeof(*epb))
+				cb(arg, body + sizeof(*epb), caplen,
+					pcapng_ts_ns(ts, iface < RTE_MIN(nb_ifaces,
+						PCAPNG_MAX_IFACES) ? tsresol[iface] : 6));
+		} else if (type == PCAPNG_SPB_TYPE &&
+				body_len >= sizeof(uint32_t)) {
+			uint32_t caplen = pcap_u32(*(const uint32_t *)body, swap);
+
+			caplen = RTE_MIN(caplen, snaplen);
+			caplen = RTE_MIN(caplen, body_len - sizeof(uint32_t));
+			/* no timestamp: received at the same time as the previous one */
+			cb(arg, body + sizeof(uint32_t), caplen, UINT64_MAX);
+		}
+
+		off += len;
+	}
+
+	return 0;
+}
+
+/* Place a packet in the buffer, without crossing a page in IOVA as PA mode */
+static size_t
+pcap_replay_place(struct pcap_replay_load *load, uint32_t len)
+{
+	size_t off = load->size;
+
+	if (load->page_sz != 0 && len <= load->page_sz &&
+			off / load->page_sz != (off + len - 1) / load->page_sz)
+		off = RTE_ALIGN_CEIL(off, load->page_sz);
+	load->size = off + len;
+
+	return off;
+}
+
+static void
+pcap_replay_pkt_add(void *arg, const uint8_t *data, uint32_t len, uint64_t ts)
+{
+	struct pcap_replay_load *load = arg;
+	struct pcap_replay *r = load->r;
+	struct pcap_replay_pkt *pkt;
+	size_t off;
+
+	if (len == 0 || len > UINT16_MAX) {
+		load->nb_skipped++;
+		return;
+	}
+
+	if (ts == UINT64_MAX)
+		ts = load->last_ts;
+	if (load->nb_pkts == 0)
+		load->first_ts = ts;
+	/* keep the timestamps monotonic */
+	if (ts < load->last_ts)
+		ts = load->last_ts;
+	load->last_ts = ts;
+
+	off = pcap_replay_place(load, len);
+	if (r->pkts != NULL) {
+		pkt = &r->pkts[load->nb_pkts];
+		pkt->data = r->data + off;
+		pkt->iova = rte_malloc_virt2iova(pkt->data);
+		pkt->len = len;
+		pkt->tsc = ts - load->first_ts;
+		memcpy(pkt->data, data, len);
+	}
+	load->nb_pkts++;
+}
+
+/* The packets data stays attached to the replay until freed */
+static void
+pcap_replay_extbuf_free(void *addr __rte_unused, void *opaque __rte_unused)
+{
+}
+
+static uint64_t
+pcap_replay_ns_to_tsc(uint64_t ns, uint64_t hz)
+{
+	return (ns / NS_PER_S) * hz + (ns % NS_PER_S) * hz / NS_PER_S;
+}
+
+static int
+pcap_replay_load(struct pcap_replay_load *load, const uint8_t *buf,
+		size_t size)
+{
+	int ret;
+
+	load->size = 0;
+	load->nb_pkts = 0;
+	load->nb_skipped = 0;
+	load->first_ts = 0;
+	load->last_ts = 0;
+
+	ret = pcap_file_parse(buf, size, pcap_replay_pkt_add, load);
+	if (ret == -EINVAL)
+		ret = pcapng_file_parse(buf, size, pcap_replay_pkt_add, load);
+
+	return ret;
+}
+
+struct pcap_replay *
+pcap_replay_create(const char *path, int socket_id, bool pace)
+{
+	struct pcap_replay_load load = { 0 };
+	struct pcap_replay *r;
+	uint64_t hz = rte_get_timer_hz();
+	struct stat st;
+	uint8_t *buf;
+	uint32_t i;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		PMD_LOG(ERR, "Couldn't open %s: %s", path, strerror(errno));
+		return NULL;
+	}
+	if (fstat(fd, &st) < 0 || st.st_size == 0) {
+		PMD_LOG(ERR, "Couldn't get the size of %s", path);
+		close(fd);
+		return NULL;
+	}
+	buf = rte_mem_map(NULL, st.st_size, RTE_PROT_READ, RTE_MAP_PRIVATE,
+			fd, 0);
+	close(fd);
+	if (buf == NULL) {
+		PMD_LOG(ERR, "Couldn't map %s: %s", path,
+			rte_strerror(rte_errno));
+		return NULL;
+	}
+
+	r = rte_zmalloc_socket("pcap_replay", sizeof(*r), 0, socket_id);
+	if (r == NULL)
+		goto error;
+	r->pace = pace;
+	load.r = r;
+
+	/*
+	 * First pass to get the number of packets and size of the data.
+	 * With IOVA as PA, the packets are not placed across system pages,
+	 * which are never larger than the hugepages.
+	 */
+	if (rte_eal_iova_mode() == RTE_IOVA_PA)
+		load.page_sz = rte_mem_page_size();
+	if (pcap_replay_load(&load, buf, st.st_size) < 0) {
+		PMD_LOG(ERR, "%s is not a pcap or pcapng file", path);
+		goto error;
+	}
+	if (load.nb_pkts == 0) {
+		PMD_LOG(ERR, "No packet in %s", path);
+		goto error;
+	}
+
+	r->pkts = rte_zmalloc_socket("pcap_replay_pkts",
+			load.nb_pkts * sizeof(*r->pkts), 0, socket_id);
+	r->data = rte_malloc_socket("pcap_replay_data", load.size,
+			RTE_MAX(load.page_sz, (size_t)RTE_CACHE_LINE_SIZE),
+			socket_id);
+	if (r->pkts == NULL || r->data == NULL) {
+		PMD_LOG(ERR, "Couldn't allocate %zu bytes for %s",
+			load.size, path);
+		goto error;
+	}
+	/* Second pass to copy the packets */
+	pcap_replay_load(&load, buf, st.st_size);
+	rte_mem_unmap(buf, st.st_size);
+	buf = NULL;
+
+	r->nb_pkts = load.nb_pkts;
+	for (i = 0; i < r->nb_pkts; i++) {
+		struct pcap_replay_pkt *pkt = &r->pkts[i];
+
+		pkt->tsc = pcap_replay_ns_to_tsc(pkt->tsc, hz);
+		pkt->shinfo.free_cb = pcap_replay_extbuf_free;
+		/* the replay holds a reference, never released on Rx */
+		rte_mbuf_ext_refcnt_set(&pkt->shinfo, 1);
+	}
+	/* Loop after the average gap between the packets */
+	r->duration = r->pkts[r->nb_pkts - 1].tsc;
+	if (r->nb_pkts > 1)
+		r->duration += r->duration / (r->nb_pkts - 1);
+
+	if (load.nb_skipped != 0)
+		PMD_LOG(WARNING, "%u packets of %s not loaded",
+			load.nb_skipped, path);
+	PMD_LOG(INFO, "Loaded %u packets, %zu bytes from %s",
+		r->nb_pkts, load.size, path);
+
+	return r;
+
+error:
+	if (buf != NULL)
+		rte_mem_unmap(buf, st.st_size);
+	pcap_replay_free(r);
+	return NULL;
+}
+
+void
+pcap_replay_free(struct pcap_replay *r)
+{
+	if (r == NULL)
+		return;
+
+	rte_free(r->data);
+	rte_free(r->pkts);
+	rte_free(r);
+}
+
+int
+pcap_replay_rx(struct pcap_replay *r, struct rte_mempool *mp,
+		struct rte_mbuf **bufs, uint16_t nb_pkts, uint64_t *bytes)
+{
+	struct pcap_replay_pkt *pkt;
+	uint32_t next = r->next;
+	uint64_t rx_bytes = 0;
+	uint16_t i;
+
+	/* Stop at the first packet not yet due */
+	if (r->pace) {
+		uint64_t now = rte_get_timer_cycles();
+		uint64_t start;
+
+		if (r->start == 0)
+			r->start = now;
+		start = r->start;
+		for (i = 0; i < nb_pkts; i++) {
+			if (start + r->pkts[next].tsc > now)
+				break;
+			if (++next == r->nb_pkts) {
+				next = 0;
+				start += r->duration;
+			}
+		}
+		nb_pkts = i;
+		next = r->next;
+	}
+	if (nb_pkts == 0)
+		return 0;
+
+	if (rte_pktmbuf_alloc_bulk(mp, bufs, nb_pkts) != 0)
+		return -1;
+
+	for (i = 0; i < nb_pkts; i++) {
+		struct rte_mbuf *m = bufs[i];
+
+		pkt = &r->pkts[next];
+		rte_mbuf_ext_refcnt_update(&pkt->shinfo, 1);
+		rte_pktmbuf_attach_extbuf(m, pkt->data, pkt->iova, pkt->len,
+				&pkt->shinfo);
+		m->data_len = pkt->len;
+		m->pkt_len = pkt->len;
+		rx_bytes += pkt->len;
+
+		if (++next == r->nb_pkts) {
+			next = 0;
+			r->start += r->duration;
+		}
+	}
+	r->next = next;
+	*bytes += rx_bytes;
+
+	return nb_pkts;
+}
@@ -0,0 +1,41 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _PCAP_REPLAY_H_
+#define _PCAP_REPLAY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <rte_mbuf.h>
+#include <rte_mempool.h>
+
+/*
+ * Replay of a pcap or pcapng file, loaded once in DPDK memory.
+ * The received mbufs are attached to the loaded packets as external
+ * buffers, so the packets are neither parsed nor copied on Rx.
+ */
+struct pcap_replay;
+
+/*
+ * Load the packets of a pcap or pcapng file.
+ * With pace, the packets are received no faster than their timestamps.
+ * Returns NULL on error.
+ */
+struct pcap_replay *pcap_replay_create(const char *path, int socket_id,
+		bool pace);
+
+/* Free a replay, the mbufs attached to it must have been freed. */
+void pcap_replay_free(struct pcap_replay *r);
+
+/*
+ * Receive up to nb_pkts packets of the replay, starting again
+ * from the first packet after the last one.
+ * The total length of the packets is added to *bytes.
+ * Returns the number of packets, or -1 if the mbufs allocation failed.
+ */
+int pcap_replay_rx(struct pcap_replay *r, struct rte_mempool *mp,
+		struct rte_mbuf **bufs, uint16_t nb_pkts, uint64_t *bytes);
+
+#endif /* _PCAP_REPLAY_H_ */
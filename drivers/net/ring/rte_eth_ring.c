@@ -46,8 +46,14 @@ enum dev_action {
 struct ring_queue {
 	struct rte_ring *rng;
 	uint16_t in_port;
+	/* consumer sync type allows rte_eth_ring_rx_peek() */
+	bool peek;
 	RTE_ATOMIC(uint64_t) rx_pkts;
 	RTE_ATOMIC(uint64_t) tx_pkts;
+	/* bursts with packets */
+	RTE_ATOMIC(uint64_t) bursts;
+	/* Rx: bursts without packets, Tx: packets not enqueued */
+	RTE_ATOMIC(uint64_t) misses;
 };
 
 struct pmd_internals {
@@ -74,6 +80,28 @@ RTE_LOG_REGISTER_DEFAULT(eth_ring_logtype, NOTICE);
 #define PMD_LOG(level, ...) \
 	RTE_LOG_LINE_PREFIX(level, ETH_RING, "%s(): ", __func__, __VA_ARGS__)
 
+static inline void
+ring_stat_add(RTE_ATOMIC(uint64_t) *stat, uint64_t n, bool single)
+{
+	if (single)
+		*stat += n;
+	else
+		rte_atomic_fetch_add_explicit(stat, n, rte_memory_order_relaxed);
+}
+
+static inline void
+ring_rx_stats_update(struct ring_queue *r, uint16_t nb_rx)
+{
+	const bool single = r->rng->flags & RING_F_SC_DEQ;
+
+	if (nb_rx == 0) {
+		ring_stat_add(&r->misses, 1, single);
+		return;
+	}
+	ring_stat_add(&r->rx_pkts, nb_rx, single);
+	ring_stat_add(&r->bursts, 1, single);
+}
+
 static uint16_t
 eth_ring_rx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
 {
@@ -84,10 +112,7 @@ eth_ring_rx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
 			ptrs, nb_bufs, NULL);
 	for (i = 0; i < nb_rx; i++)
 		bufs[i]->port = r->in_port;
-	if (r->rng->flags & RING_F_SC_DEQ)
-		r->rx_pkts += nb_rx;
-	else
-		rte_atomic_fetch_add_explicit(&r->rx_pkts, nb_rx, rte_memory_order_relaxed);
+	ring_rx_stats_update(r, nb_rx);
 	return nb_rx;
 }
 
@@ -96,12 +121,15 @@ eth_ring_tx(void *q, struct rte_mbuf **bufs, uint16_t nb_bufs)
 {
 	void **ptrs = (void *)&bufs[0];
 	struct ring_queue *r = q;
+	const bool single = r->rng->flags & RING_F_SP_ENQ;
 	const uint16_t nb_tx = (uint16_t)rte_ring_enqueue_burst(r->rng,
 			ptrs, nb_bufs, NULL);
-	if (r->rng->flags & RING_F_SP_ENQ)
-		r->tx_pkts += nb_tx;
-	else
-		rte_atomic_fetch_add_explicit(&r->tx_pkts, nb_tx, rte_memory_order_relaxed);
+	if (nb_tx != 0) {
+		ring_stat_add(&r->tx_pkts, nb_tx, single);
+		ring_stat_add(&r->bursts, 1, single);
+	}
+	if (unlikely(nb_tx != nb_bufs))
+		ring_stat_add(&r->misses, nb_bufs - nb_tx, single);
 	return nb_tx;
 }
 
@@ -229,14 +257,86 @@ eth_stats_reset(struct rte_eth_dev *dev)
 	unsigned int i;
 	struct pmd_internals *internal = dev->data->dev_private;
 
-	for (i = 0; i < dev->data->nb_rx_queues; i++)
+	for (i = 0; i < dev->data->nb_rx_queues; i++) {
 		internal->rx_ring_queues[i].rx_pkts = 0;
-	for (i = 0; i < dev->data->nb_tx_queues; i++)
+		internal->rx_ring_queues[i].bursts = 0;
+		internal->rx_ring_queues[i].misses = 0;
+	}
+	for (i = 0; i < dev->data->nb_tx_queues; i++) {
 		internal->tx_ring_queues[i].tx_pkts = 0;
+		internal->tx_ring_queues[i].bursts = 0;
+		internal->tx_ring_queues[i].misses = 0;
+	}
 
 	return 0;
 }
 
+/* Per queue: bursts with packets, and empty Rx bursts or unsent Tx packets */
+#define ETH_RING_NB_QUEUE_XSTATS 2
+
+static unsigned int
+eth_xstats_count(const struct rte_eth_dev *dev)
+{
+	return (dev->data->nb_rx_queues + dev->data->nb_tx_queues) *
+		ETH_RING_NB_QUEUE_XSTATS;
+}
+
+static int
+eth_xstats_get_names(struct rte_eth_dev *dev,
+		struct rte_eth_xstat_name *xstats_names, unsigned int size)
+{
+	unsigned int count = eth_xstats_count(dev);
+	unsigned int i, n = 0;
+
+	if (xstats_names == NULL || size < count)
+		return count;
+
+	for (i = 0; i < dev->data->nb_rx_queues; i++) {
+		snprintf(xstats_names[n++].name, RTE_ETH_XSTATS_NAME_SIZE,
+			 "rx_q%u_bursts", i);
+		snprintf(xstats_names[n++].name, RTE_ETH_XSTATS_NAME_SIZE,
+			 "rx_q%u_empty_polls", i);
+	}
+	for (i = 0; i < dev->data->nb_tx_queues; i++) {
+		snprintf(xstats_names[n++].name, RTE_ETH_XSTATS_NAME_SIZE,
+			 "tx_q%u_bursts", i);
+		snprintf(xstats_names[n++].name, RTE_ETH_XSTATS_NAME_SIZE,
+			 "tx_q%u_ring_full", i);
+	}
+
+	return count;
+}
+
+static int
+eth_xstats_get(struct rte_eth_dev *dev, struct rte_eth_xstat *xstats,
+	       unsigned int n)
+{
+	const struct pmd_internals *internal = dev->data->dev_private;
+	unsigned int count = eth_xstats_count(dev);
+	const struct ring_queue *r;
+	unsigned int i, k = 0;
+
+	if (xstats == NULL || n < count)
+		return count;
+
+	for (i = 0; i < dev->data->nb_rx_queues; i++) {
+		r = &internal->rx_ring_queues[i];
+		xstats[k].id = k;
+		xstats[k++].value = r->bursts;
+		xstats[k].id = k;
+		xstats[k++].value = r->misses;
+	}
+	for (i = 0; i < dev->data->nb_tx_queues; i++) {
+		r = &internal->tx_ring_queues[i];
+		xstats[k].id = k;
+		xstats[k++].value = r->bursts;
+		xstats[k].id = k;
+		xstats[k++].value = r->misses;
+	}
+
+	return count;
+}
+
 static void
 eth_mac_addr_remove(struct rte_eth_dev *dev __rte_unused,
 	uint32_t index __rte_unused)
@@ -347,6 +447,9 @@ static const struct eth_dev_ops ops = {
 	.link_update = eth_link_update,
 	.stats_get = eth_stats_get,
 	.stats_reset = eth_stats_reset,
+	.xstats_get = eth_xstats_get,
+	.xstats_get_names = eth_xstats_get_names,
+	.xstats_reset = eth_stats_reset,
 	.mac_addr_remove = eth_mac_addr_remove,
 	.mac_addr_add = eth_mac_addr_add,
 	.promiscuous_enable = eth_promiscuous_enable,
@@ -356,6 +459,58 @@ static const struct eth_dev_ops ops = {
 	.get_monitor_addr = eth_get_monitor_addr,
 };
 
+static struct ring_queue *
+eth_ring_peek_queue(uint16_t port_id, uint16_t queue_id)
+{
+	struct rte_eth_dev *dev;
+
+	if (!rte_eth_dev_is_valid_port(port_id))
+		return NULL;
+
+	/* dev_ops is set by each process to its own ops */
+	dev = &rte_eth_devices[port_id];
+	if (dev->dev_ops != &ops || queue_id >= dev->data->nb_rx_queues)
+		return NULL;
+
+	return dev->data->rx_queues[queue_id];
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_ring_rx_peek, 26.03)
+int
+rte_eth_ring_rx_peek(uint16_t port_id, uint16_t queue_id,
+		struct rte_ring_zc_data *zcd, uint16_t nb_pkts)
+{
+	struct ring_queue *r = eth_ring_peek_queue(port_id, queue_id);
+	uint16_t nb_rx;
+
+	if (r == NULL || zcd == NULL)
+		return -EINVAL;
+	if (!r->peek)
+		return -ENOTSUP;
+
+	nb_rx = (uint16_t)rte_ring_dequeue_zc_burst_start(r->rng, nb_pkts,
+			zcd, NULL);
+	if (nb_rx == 0)
+		ring_rx_stats_update(r, 0);
+
+	return nb_rx;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_ring_rx_peek_finish, 26.03)
+void
+rte_eth_ring_rx_peek_finish(uint16_t port_id, uint16_t queue_id,
+		uint16_t nb_pkts)
+{
+	struct ring_queue *r = eth_ring_peek_queue(port_id, queue_id);
+
+	if (r == NULL || !r->peek)
+		return;
+
+	rte_ring_dequeue_zc_finish(r->rng, nb_pkts);
+	if (nb_pkts != 0)
+		ring_rx_stats_update(r, nb_pkts);
+}
+
 static int
 do_eth_dev_ring_create(const char *name,
 		struct rte_vdev_device *vdev,
@@ -421,8 +576,12 @@ do_eth_dev_ring_create(const char *name,
 	internals->max_rx_queues = nb_rx_queues;
 	internals->max_tx_queues = nb_tx_queues;
 	for (i = 0; i < nb_rx_queues; i++) {
+		enum rte_ring_sync_type st = rte_ring_get_cons_sync_type(rx_queues[i]);
+
 		internals->rx_ring_queues[i].rng = rx_queues[i];
 		internals->rx_ring_queues[i].in_port = -1;
+		internals->rx_ring_queues[i].peek = st == RTE_RING_SYNC_ST ||
+				st == RTE_RING_SYNC_MT_HTS;
 		data->rx_queues[i] = &internals->rx_ring_queues[i];
 	}
 	for (i = 0; i < nb_tx_queues; i++) {
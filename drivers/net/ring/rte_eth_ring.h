@@ -50,6 +50,58 @@ int rte_eth_from_rings(const char *name,
  */
 int rte_eth_from_ring(struct rte_ring *r);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Peek at the packets of a Rx queue, in place in its ring.
+ *
+ * The packets are not dequeued until rte_eth_ring_rx_peek_finish(),
+ * so that an application can forward them without copying the mbuf
+ * pointers, and leave in the ring the packets it could not forward.
+ * Unlike rte_eth_rx_burst(), the port field of the mbufs is not set.
+ *
+ * The ring of the queue must be single consumer, or HTS multi consumer.
+ * The ring stays reserved to the caller until
+ * rte_eth_ring_rx_peek_finish() is called.
+ *
+ * @param port_id
+ *    the port of a ring-based ethdev
+ * @param queue_id
+ *    the Rx queue
+ * @param zcd
+ *    filled with the location of the mbuf pointers in the ring,
+ *    which may be split in two parts when the ring wraps
+ * @param nb_pkts
+ *    the maximum number of packets to peek at
+ * @return
+ *    the number of packets, -EINVAL if the port or queue is not valid,
+ *    or -ENOTSUP if the ring consumer sync type does not allow peeking.
+ */
+__rte_experimental
+int rte_eth_ring_rx_peek(uint16_t port_id, uint16_t queue_id,
+		struct rte_ring_zc_data *zcd, uint16_t nb_pkts);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Dequeue the first packets returned by rte_eth_ring_rx_peek().
+ *
+ * Must be called after each rte_eth_ring_rx_peek() returning packets.
+ *
+ * @param port_id
+ *    the port of a ring-based ethdev
+ * @param queue_id
+ *    the Rx queue
+ * @param nb_pkts
+ *    the number of packets to dequeue, at most the number peeked at;
+ *    0 leaves all the packets in the ring
+ */
+__rte_experimental
+void rte_eth_ring_rx_peek_finish(uint16_t port_id, uint16_t queue_id,
+		uint16_t nb_pkts);
+
 #ifdef __cplusplus
 }
 #endif
@@ -386,6 +386,7 @@ cmd_softnic_pipeline_libbuild(struct pmd_internals *softnic __rte_unused,
 
 /**
  * pipeline <pipeline_name> build lib <lib_file> io <iospec_file> numa <numa_node>
+ *	[instance of <parent_pipeline_name>]
  */
 static void
 cmd_softnic_pipeline_build(struct pmd_internals *softnic,
@@ -394,12 +395,12 @@ cmd_softnic_pipeline_build(struct pmd_internals *softnic,
 	char *out,
 	size_t out_size)
 {
-	struct pipeline *p = NULL;
+	struct pipeline *p = NULL, *parent = NULL;
 	char *pipeline_name, *lib_file_name, *iospec_file_name;
 	uint32_t numa_node = 0;
 
 	/* Parsing. */
-	if (n_tokens != 9) {
+	if (n_tokens != 9 && n_tokens != 12) {
 		snprintf(out, out_size, MSG_ARG_MISMATCH, tokens[0]);
 		return;
 	}
@@ -435,12 +436,26 @@ cmd_softnic_pipeline_build(struct pmd_internals *softnic,
 		return;
 	}
 
+	if (n_tokens == 12) {
+		if (strcmp(tokens[9], "instance") || strcmp(tokens[10], "of")) {
+			snprintf(out, out_size, MSG_ARG_NOT_FOUND, "instance of");
+			return;
+		}
+
+		parent = softnic_pipeline_find(softnic, tokens[11]);
+		if (!parent || parent->parent) {
+			snprintf(out, out_size, MSG_ARG_INVALID, "parent_pipeline_name");
+			return;
+		}
+	}
+
 	/* Pipeline create. */
 	p = softnic_pipeline_create(softnic,
 				    pipeline_name,
 				    lib_file_name,
 				    iospec_file_name,
-				    (int)numa_node);
+				    (int)numa_node,
+				    parent);
 	if (!p)
 		snprintf(out, out_size, "Pipeline creation failed.\n");
 }
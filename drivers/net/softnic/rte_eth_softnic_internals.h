@@ -80,6 +80,9 @@ struct pipeline {
 	struct rte_swx_pipeline *p;
 	struct rte_swx_ctl_pipeline *ctl;
 
+	/* Pipeline owning the tables shared with this instance, NULL if none. */
+	struct pipeline *parent;
+
 	int enabled;
 	uint32_t thread_id;
 };
@@ -227,7 +230,8 @@ softnic_pipeline_create(struct pmd_internals *p,
 	const char *name,
 	const char *lib_file_name,
 	const char *iospec_file_name,
-	int numa_node);
+	int numa_node,
+	struct pipeline *parent);
 
 /**
  * Thread
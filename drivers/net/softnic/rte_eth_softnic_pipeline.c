@@ -29,7 +29,8 @@ softnic_pipeline_free(struct pmd_internals *p)
 			break;
 
 		TAILQ_REMOVE(&p->pipeline_list, pipeline, node);
-		rte_swx_ctl_pipeline_free(pipeline->ctl);
+		if (!pipeline->parent)
+			rte_swx_ctl_pipeline_free(pipeline->ctl);
 		rte_swx_pipeline_free(pipeline->p);
 		free(pipeline);
 	}
@@ -179,7 +180,8 @@ softnic_pipeline_create(struct pmd_internals *softnic,
 	const char *name,
 	const char *lib_file_name,
 	const char *iospec_file_name,
-	int numa_node)
+	int numa_node,
+	struct pipeline *parent)
 {
 	char global_name[NAME_MAX];
 	FILE *iospec_file = NULL;
@@ -192,6 +194,9 @@ softnic_pipeline_create(struct pmd_internals *softnic,
 	if (!name || !name[0] || softnic_pipeline_find(softnic, name))
 		goto error;
 
+	if (parent && parent->parent)
+		goto error;
+
 	/* Resource create */
 	snprintf(global_name, sizeof(global_name), "/tmp/%s_%s.io", softnic->params.name, name);
 
@@ -216,19 +221,27 @@ softnic_pipeline_create(struct pmd_internals *softnic,
 	fclose(iospec_file);
 	iospec_file = NULL;
 
-	ctl = rte_swx_ctl_pipeline_create(p);
-	if (!ctl)
-		goto error;
-
 	/* Node allocation */
 	pipeline = calloc(1, sizeof(struct pipeline));
 	if (!pipeline)
 		goto error;
 
+	/* The instances of a pipeline share its tables and its control handle. */
+	if (parent) {
+		status = rte_swx_ctl_pipeline_instance_add(parent->ctl, p);
+		if (status)
+			goto error;
+	} else {
+		ctl = rte_swx_ctl_pipeline_create(p);
+		if (!ctl)
+			goto error;
+	}
+
 	/* Node fill in */
 	strlcpy(pipeline->name, name, sizeof(pipeline->name));
 	pipeline->p = p;
-	pipeline->ctl = ctl;
+	pipeline->ctl = parent ? parent->ctl : ctl;
+	pipeline->parent = parent;
 
 	/* Node add to list */
 	TAILQ_INSERT_TAIL(&softnic->pipeline_list, pipeline, node);
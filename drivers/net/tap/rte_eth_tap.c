@@ -41,6 +41,9 @@
 #include <tap_flow.h>
 #include <tap_netlink.h>
 #include <tap_tcmsgs.h>
+#ifdef HAVE_IO_URING
+#include <tap_uring.h>
+#endif
 
 /* Linux based path to the TUN device */
 #define TUN_TAP_DEV_PATH        "/dev/net/tun"
@@ -412,6 +415,34 @@ tap_rxq_pool_free(struct rte_mbuf *pool)
 	rte_pktmbuf_free(pool);
 }
 
+#ifdef HAVE_IO_URING
+/* Rx burst of a queue using io_uring, single segment packets only */
+static uint16_t
+tap_rx_burst_uring(struct rx_queue *rxq, struct tap_uring *u,
+		   struct rte_mbuf **bufs, uint16_t nb_pkts)
+{
+	unsigned long num_rx_bytes = 0;
+	uint16_t num_rx, i;
+
+	num_rx = tap_uring_rx_burst(u, bufs, nb_pkts, &rxq->stats.ierrors,
+				    &rxq->stats.rx_nombuf);
+	for (i = 0; i < num_rx; i++) {
+		struct rte_mbuf *mbuf = bufs[i];
+
+		mbuf->port = rxq->in_port;
+		mbuf->packet_type = rte_net_get_ptype(mbuf, NULL,
+						      RTE_PTYPE_ALL_MASK);
+		if (rxq->rxmode->offloads & RTE_ETH_RX_OFFLOAD_CHECKSUM)
+			tap_verify_csum(mbuf);
+		num_rx_bytes += mbuf->pkt_len;
+	}
+	rxq->stats.ipackets += num_rx;
+	rxq->stats.ibytes += num_rx_bytes;
+
+	return num_rx;
+}
+#endif
+
 /* Callback to handle the rx burst of packets to the correct interface and
  * file descriptor(s) in a multi-queue setup.
  */
@@ -428,6 +459,14 @@ pmd_rx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 		return 0;
 
 	process_private = rte_eth_devices[rxq->in_port].process_private;
+#ifdef HAVE_IO_URING
+	if (process_private->rxu[rxq->queue_id] != NULL) {
+		num_rx = tap_rx_burst_uring(rxq,
+				process_private->rxu[rxq->queue_id],
+				bufs, nb_pkts);
+		goto trigger;
+	}
+#endif
 	for (num_rx = 0; num_rx < nb_pkts; ) {
 		struct rte_mbuf *mbuf = rxq->pool;
 		struct rte_mbuf *seg = NULL;
@@ -504,6 +543,9 @@ pmd_rx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 	rxq->stats.ipackets += num_rx;
 	rxq->stats.ibytes += num_rx_bytes;
 
+#ifdef HAVE_IO_URING
+trigger:
+#endif
 	if (trigger && num_rx < nb_pkts)
 		rxq->trigger_seen = trigger;
 
@@ -631,10 +673,21 @@ tap_write_mbufs(struct tx_queue *txq, uint16_t num_mbufs,
 			seg = seg->next;
 		}
 
+#ifdef HAVE_IO_URING
+		/* queue the write, its errors are counted at flush */
+		if (process_private->txu[txq->queue_id] != NULL &&
+		    tap_uring_tx_queue(process_private->txu[txq->queue_id],
+				       &pi, &iovecs[1], k - 1,
+				       rte_pktmbuf_pkt_len(mbuf)) == 0)
+			goto queued;
+#endif
 		/* copy the tx frame data */
 		n = writev(process_private->fds[txq->queue_id], iovecs, k);
 		if (n <= 0)
 			return -1;
+#ifdef HAVE_IO_URING
+queued:
+#endif
 
 		(*num_packets)++;
 		(*num_tx_bytes) += rte_pktmbuf_pkt_len(mbuf);
@@ -642,6 +695,51 @@ tap_write_mbufs(struct tx_queue *txq, uint16_t num_mbufs,
 	return 0;
 }
 
+/* Free transmitted mbufs, once written when using io_uring */
+static inline void
+tap_tx_free(struct tx_queue *txq, struct rte_mbuf **mbufs, unsigned int n)
+{
+#ifdef HAVE_IO_URING
+	struct pmd_process_private *process_private;
+
+	process_private = rte_eth_devices[txq->out_port].process_private;
+	if (process_private->txu[txq->queue_id] != NULL) {
+		tap_uring_tx_free(process_private->txu[txq->queue_id],
+				  mbufs, n);
+		return;
+	}
+#else
+	RTE_SET_USED(txq);
+#endif
+	rte_pktmbuf_free_bulk(mbufs, n);
+}
+
+/* Wait for the io_uring writes, and remove the failed ones from the stats */
+static inline void
+tap_tx_flush(struct tx_queue *txq, uint16_t *num_packets,
+	     unsigned long *num_tx_bytes)
+{
+#ifdef HAVE_IO_URING
+	struct pmd_process_private *process_private;
+	uint64_t err_bytes = 0;
+	uint16_t nb_err;
+
+	process_private = rte_eth_devices[txq->out_port].process_private;
+	if (process_private->txu[txq->queue_id] == NULL)
+		return;
+
+	nb_err = tap_uring_tx_flush(process_private->txu[txq->queue_id],
+				    &err_bytes);
+	*num_packets -= nb_err;
+	*num_tx_bytes -= err_bytes;
+	txq->stats.errs += nb_err;
+#else
+	RTE_SET_USED(txq);
+	RTE_SET_USED(num_packets);
+	RTE_SET_USED(num_tx_bytes);
+#endif
+}
+
 /* Callback to handle sending packets from the tap interface
  */
 static uint16_t
@@ -723,21 +821,23 @@ pmd_tx_burst(void *queue, struct rte_mbuf **bufs, uint16_t nb_pkts)
 			txq->stats.errs++;
 			/* free tso mbufs */
 			if (num_tso_mbufs > 0)
-				rte_pktmbuf_free_bulk(mbuf, num_tso_mbufs);
+				tap_tx_free(txq, mbuf, num_tso_mbufs);
 			break;
 		}
 		num_tx++;
 		if (num_tso_mbufs == 0) {
 			/* tap_write_mbufs may prepend a segment to mbuf_in */
-			rte_pktmbuf_free(mbuf[0]);
+			tap_tx_free(txq, mbuf, 1);
 		} else {
 			/* free original mbuf */
-			rte_pktmbuf_free(mbuf_in);
+			tap_tx_free(txq, &mbuf_in, 1);
 			/* free tso mbufs */
-			rte_pktmbuf_free_bulk(mbuf, num_tso_mbufs);
+			tap_tx_free(txq, mbuf, num_tso_mbufs);
 		}
 	}
 
+	tap_tx_flush(txq, &num_packets, &num_tx_bytes);
+
 	txq->stats.opackets += num_packets;
 	txq->stats.errs += nb_pkts - num_tx;
 	txq->stats.obytes += num_tx_bytes;
@@ -1020,6 +1120,15 @@ tap_stats_reset(struct rte_eth_dev *dev)
 	return 0;
 }
 
+#ifdef HAVE_IO_URING
+static void
+tap_queue_uring_free(struct tap_uring **u)
+{
+	tap_uring_free(*u);
+	*u = NULL;
+}
+#endif
+
 static void
 tap_queue_close(struct pmd_process_private *process_private, uint16_t qid)
 {
@@ -1059,6 +1168,10 @@ tap_dev_close(struct rte_eth_dev *dev)
 	for (i = 0; i < RTE_PMD_TAP_MAX_QUEUES; i++) {
 		struct rx_queue *rxq = &internals->rxq[i];
 
+#ifdef HAVE_IO_URING
+		tap_queue_uring_free(&process_private->rxu[i]);
+		tap_queue_uring_free(&process_private->txu[i]);
+#endif
 		tap_queue_close(process_private, i);
 
 		tap_rxq_pool_free(rxq->pool);
@@ -1121,6 +1234,9 @@ tap_rx_queue_release(struct rte_eth_dev *dev, uint16_t qid)
 
 	process_private = rte_eth_devices[rxq->in_port].process_private;
 
+#ifdef HAVE_IO_URING
+	tap_queue_uring_free(&process_private->rxu[qid]);
+#endif
 	tap_rxq_pool_free(rxq->pool);
 	rte_free(rxq->iovecs);
 	rxq->pool = NULL;
@@ -1140,6 +1256,9 @@ tap_tx_queue_release(struct rte_eth_dev *dev, uint16_t qid)
 		return;
 
 	process_private = rte_eth_devices[txq->out_port].process_private;
+#ifdef HAVE_IO_URING
+	tap_queue_uring_free(&process_private->txu[qid]);
+#endif
 	if (dev->data->rx_queues[qid] == NULL)
 		tap_queue_close(process_private, qid);
 }
@@ -1572,6 +1691,14 @@ tap_rx_queue_setup(struct rte_eth_dev *dev,
 		tmp = &(*tmp)->next;
 	}
 
+#ifdef HAVE_IO_URING
+	/* Scattered packets are received with readv() */
+	tap_queue_uring_free(&process_private->rxu[rx_queue_id]);
+	if (!(rxq->rxmode->offloads & RTE_ETH_RX_OFFLOAD_SCATTER))
+		process_private->rxu[rx_queue_id] = tap_uring_rx_create(
+				process_private->fds[rx_queue_id], mp, socket_id);
+#endif
+
 	/* set carrier after creating at least one rxq */
 	ret = tap_carrier_set(internals, 1);
 	if (ret < 0)
@@ -1595,7 +1722,7 @@ static int
 tap_tx_queue_setup(struct rte_eth_dev *dev,
 		   uint16_t tx_queue_id,
 		   uint16_t nb_tx_desc __rte_unused,
-		   unsigned int socket_id __rte_unused,
+		   unsigned int socket_id,
 		   const struct rte_eth_txconf *tx_conf)
 {
 	struct pmd_internals *internals = dev->data->dev_private;
@@ -1620,6 +1747,13 @@ tap_tx_queue_setup(struct rte_eth_dev *dev,
 	ret = tap_setup_queue(dev, internals, tx_queue_id, 0);
 	if (ret == -1)
 		return -1;
+#ifdef HAVE_IO_URING
+	tap_queue_uring_free(&process_private->txu[tx_queue_id]);
+	process_private->txu[tx_queue_id] = tap_uring_tx_create(
+			process_private->fds[tx_queue_id], socket_id);
+#else
+	RTE_SET_USED(socket_id);
+#endif
 	TAP_LOG(DEBUG,
 		"  TX TUNTAP device name %s, qid %d on fd %d csum %s",
 		internals->name, tx_queue_id,
@@ -97,6 +97,11 @@ struct pmd_internals {
 
 struct pmd_process_private {
 	int fds[RTE_PMD_TAP_MAX_QUEUES];
+#ifdef HAVE_IO_URING
+	/* io_uring of the queues, NULL when using readv/writev */
+	struct tap_uring *rxu[RTE_PMD_TAP_MAX_QUEUES];
+	struct tap_uring *txu[RTE_PMD_TAP_MAX_QUEUES];
+#endif
 };
 
 /* tap_intr.c */
@@ -0,0 +1,355 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2026 Intel Corporation
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <liburing.h>
+
+#include <rte_common.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+
+#include "tap_log.h"
+#include "tap_uring.h"
+
+/* Data iovecs per queued write; longer chains are written with writev(). */
+#define TAP_URING_TX_MAX_IOV 8
+/* Maximum number of mempool chunks registered as fixed buffers. */
+#define TAP_URING_MAX_FIXED 64
+/* Maximum number of mbufs waiting for their write to be done. */
+#define TAP_URING_TX_MAX_FREE (TAP_URING_DEPTH * 2)
+
+struct tap_uring_fixed {
+	uintptr_t start;
+	uintptr_t end;
+};
+
+struct tap_uring_tx_slot {
+	struct tun_pi pi;
+	uint32_t len;
+	struct iovec iov[TAP_URING_TX_MAX_IOV + 1];
+};
+
+struct tap_uring {
+	struct io_uring ring;
+	int fd;
+	struct rte_mempool *mp;
+	/* Rx: mbufs allocated for the next reads */
+	uint16_t nb_cached;
+	struct rte_mbuf *cache[TAP_URING_DEPTH];
+	/* Rx: registered mempool chunks */
+	uint16_t nb_fixed;
+	struct tap_uring_fixed fixed[TAP_URING_MAX_FIXED];
+	/* Tx: queued writes and mbufs to free once written */
+	uint16_t nb_queued;
+	uint16_t nb_free;
+	uint16_t nb_err;
+	uint64_t err_bytes;
+	struct tap_uring_tx_slot slots[TAP_URING_DEPTH];
+	struct rte_mbuf *to_free[TAP_URING_TX_MAX_FREE];
+};
+
+static struct tap_uring *
+tap_uring_create(int fd, int socket_id)
+{
+	struct tap_uring *u;
+	int ret;
+
+	u = rte_zmalloc_socket("tap_uring", sizeof(*u), RTE_CACHE_LINE_SIZE,
+			socket_id);
+	if (u == NULL)
+		return NULL;
+
+	ret = io_uring_queue_init(TAP_URING_DEPTH, &u->ring, 0);
+	if (ret < 0) {
+		TAP_LOG(INFO, "io_uring not available: %s", strerror(-ret));
+		rte_free(u);
+		return NULL;
+	}
+	u->fd = fd;
+
+	return u;
+}
+
+static void
+tap_uring_fixed_add(struct rte_mempool *mp __rte_unused, void *opaque,
+		struct rte_mempool_memhdr *memhdr, unsigned int mem_idx __rte_unused)
+{
+	struct tap_uring *u = opaque;
+
+	/* Too many chunks: disable the fixed buffers */
+	if (u->nb_fixed >= TAP_URING_MAX_FIXED) {
+		u->nb_fixed = UINT16_MAX;
+		return;
+	}
+	if (u->nb_fixed == UINT16_MAX)
+		return;
+
+	u->fixed[u->nb_fixed].start = (uintptr_t)memhdr->addr;
+	u->fixed[u->nb_fixed].end = (uintptr_t)memhdr->addr + memhdr->len;
+	u->nb_fixed++;
+}
+
+static void
+tap_uring_fixed_register(struct tap_uring *u)
+{
+	struct iovec iov[TAP_URING_MAX_FIXED];
+	unsigned int i;
+	int ret;
+
+	rte_mempool_mem_iter(u->mp, tap_uring_fixed_add, u);
+	if (u->nb_fixed == UINT16_MAX || u->nb_fixed == 0)
+		goto disable;
+
+	for (i = 0; i < u->nb_fixed; i++) {
+		iov[i].iov_base = (void *)u->fixed[i].start;
+		iov[i].iov_len = u->fixed[i].end - u->fixed[i].start;
+	}
+	ret = io_uring_register_buffers(&u->ring, iov, u->nb_fixed);
+	if (ret < 0) {
+		TAP_LOG(INFO, "io_uring fixed buffers not available: %s",
+			strerror(-ret));
+		goto disable;
+	}
+	return;
+
+disable:
+	u->nb_fixed = 0;
+}
+
+struct tap_uring *
+tap_uring_rx_create(int fd, struct rte_mempool *mp, int socket_id)
+{
+	struct tap_uring *u;
+
+	/* The packet info is read in the headroom. */
+	if (RTE_PKTMBUF_HEADROOM < sizeof(struct tun_pi))
+		return NULL;
+
+	u = tap_uring_create(fd, socket_id);
+	if (u == NULL)
+		return NULL;
+
+	u->mp = mp;
+	tap_uring_fixed_register(u);
+
+	return u;
+}
+
+struct tap_uring *
+tap_uring_tx_create(int fd, int socket_id)
+{
+	return tap_uring_create(fd, socket_id);
+}
+
+void
+tap_uring_free(struct tap_uring *u)
+{
+	if (u == NULL)
+		return;
+
+	tap_uring_tx_flush(u, NULL);
+	if (u->nb_cached != 0)
+		rte_pktmbuf_free_bulk(u->cache, u->nb_cached);
+	io_uring_queue_exit(&u->ring);
+	rte_free(u);
+}
+
+/* Index of the registered chunk holding the buffer, -1 if none. */
+static inline int
+tap_uring_fixed_index(const struct tap_uring *u, const void *buf)
+{
+	uintptr_t addr = (uintptr_t)buf;
+	unsigned int i;
+
+	for (i = 0; i < u->nb_fixed; i++) {
+		if (addr >= u->fixed[i].start && addr < u->fixed[i].end)
+			return i;
+	}
+
+	return -1;
+}
+
+uint16_t
+tap_uring_rx_burst(struct tap_uring *u, struct rte_mbuf **bufs,
+		uint16_t nb_pkts, uint64_t *nb_err, uint64_t *nb_nombuf)
+{
+	int32_t res[TAP_URING_DEPTH];
+	struct io_uring_cqe *cqe;
+	struct io_uring_sqe *sqe;
+	uint16_t nb_rx = 0, nb_left = 0;
+	unsigned int head, count = 0;
+	uint16_t n, i, nb_cached;
+	int ret;
+
+	n = RTE_MIN(nb_pkts, TAP_URING_DEPTH);
+	if (u->nb_cached < n) {
+		if (rte_pktmbuf_alloc_bulk(u->mp, &u->cache[u->nb_cached],
+				n - u->nb_cached) == 0)
+			u->nb_cached = n;
+		else
+			(*nb_nombuf)++;
+	}
+	nb_cached = u->nb_cached;
+	n = RTE_MIN(n, nb_cached);
+	if (n == 0)
+		return 0;
+
+	/* The packet info is read in the headroom, before the data. */
+	for (i = 0; i < n; i++) {
+		struct rte_mbuf *m = u->cache[i];
+		char *buf = rte_pktmbuf_mtod_offset(m, char *,
+				-(int)sizeof(struct tun_pi));
+		unsigned int len = rte_pktmbuf_tailroom(m) +
+				sizeof(struct tun_pi);
+		int idx = tap_uring_fixed_index(u, buf);
+
+		sqe = io_uring_get_sqe(&u->ring);
+		if (idx >= 0)
+			io_uring_prep_read_fixed(sqe, u->fd, buf, len, 0, idx);
+		else
+			io_uring_prep_read(sqe, u->fd, buf, len, 0);
+		sqe->user_data = i;
+		res[i] = -EAGAIN;
+	}
+
+	/*
+	 * The fd is non-blocking: all the reads are done, or failed
+	 * with EAGAIN, when io_uring_submit_and_wait() returns.
+	 */
+	do {
+		ret = io_uring_submit_and_wait(&u->ring, n);
+	} while (ret == -EINTR);
+	if (ret < 0)
+		return 0;
+
+	io_uring_for_each_cqe(&u->ring, head, cqe) {
+		if (cqe->user_data < n)
+			res[cqe->user_data] = cqe->res;
+		count++;
+	}
+	io_uring_cq_advance(&u->ring, count);
+
+	for (i = 0; i < n; i++) {
+		struct rte_mbuf *m = u->cache[i];
+		struct tun_pi *pi = rte_pktmbuf_mtod_offset(m, struct tun_pi *,
+				-(int)sizeof(struct tun_pi));
+
+		if (res[i] < (int32_t)sizeof(struct tun_pi)) {
+			u->cache[nb_left++] = m;
+			continue;
+		}
+
+		/* Packet couldn't fit in the mbuf */
+		if (unlikely(pi->flags & TUN_PKT_STRIP)) {
+			(*nb_err)++;
+			u->cache[nb_left++] = m;
+			continue;
+		}
+
+		m->data_len = res[i] - sizeof(struct tun_pi);
+		m->pkt_len = m->data_len;
+		bufs[nb_rx++] = m;
+	}
+	/* keep the mbufs not read, for the next bursts */
+	for (i = n; i < nb_cached; i++)
+		u->cache[nb_left++] = u->cache[i];
+	u->nb_cached = nb_left;
+
+	return nb_rx;
+}
+
+static void tap_uring_tx_submit(struct tap_uring *u);
+
+int
+tap_uring_tx_queue(struct tap_uring *u, const struct tun_pi *pi,
+		const struct iovec *iov, int iovcnt, uint32_t len)
+{
+	struct tap_uring_tx_slot *slot;
+	struct io_uring_sqe *sqe;
+
+	if (iovcnt > TAP_URING_TX_MAX_IOV)
+		return -1;
+
+	if (u->nb_queued == TAP_URING_DEPTH)
+		tap_uring_tx_submit(u);
+
+	slot = &u->slots[u->nb_queued];
+	slot->pi = *pi;
+	slot->len = len;
+	slot->iov[0].iov_base = &slot->pi;
+	slot->iov[0].iov_len = sizeof(slot->pi);
+	memcpy(&slot->iov[1], iov, iovcnt * sizeof(*iov));
+
+	sqe = io_uring_get_sqe(&u->ring);
+	io_uring_prep_writev(sqe, u->fd, slot->iov, iovcnt + 1, 0);
+	sqe->user_data = u->nb_queued;
+	u->nb_queued++;
+
+	return 0;
+}
+
+void
+tap_uring_tx_free(struct tap_uring *u, struct rte_mbuf **m, unsigned int n)
+{
+	if (u->nb_free + n > TAP_URING_TX_MAX_FREE)
+		tap_uring_tx_submit(u);
+
+	/* Nothing queued anymore, free now. */
+	if (u->nb_queued == 0 || n > TAP_URING_TX_MAX_FREE) {
+		rte_pktmbuf_free_bulk(m, n);
+		return;
+	}
+
+	memcpy(&u->to_free[u->nb_free], m, n * sizeof(*m));
+	u->nb_free += n;
+}
+
+/* Submit the queued writes and wait for them, then free the mbufs. */
+static void
+tap_uring_tx_submit(struct tap_uring *u)
+{
+	struct io_uring_cqe *cqe;
+	unsigned int head, count = 0;
+	int ret;
+
+	if (u->nb_queued != 0) {
+		do {
+			ret = io_uring_submit_and_wait(&u->ring, u->nb_queued);
+		} while (ret == -EINTR);
+		if (ret >= 0) {
+			io_uring_for_each_cqe(&u->ring, head, cqe) {
+				if (cqe->res <= 0 && cqe->user_data < u->nb_queued) {
+					u->nb_err++;
+					u->err_bytes += u->slots[cqe->user_data].len;
+				}
+				count++;
+			}
+			io_uring_cq_advance(&u->ring, count);
+		}
+		u->nb_queued = 0;
+	}
+
+	if (u->nb_free != 0) {
+		rte_pktmbuf_free_bulk(u->to_free, u->nb_free);
+		u->nb_free = 0;
+	}
+}
+
+uint16_t
+tap_uring_tx_flush(struct tap_uring *u, uint64_t *err_bytes)
+{
+	uint16_t nb_err;
+
+	tap_uring_tx_submit(u);
+
+	nb_err = u->nb_err;
+	if (err_bytes != NULL)
+		*err_bytes += u->err_bytes;
+	u->nb_err = 0;
+	u->err_bytes = 0;
+
+	return nb_err;
+}
@@ -0,0 +1,68 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright 2026 Intel Corporation
+ */
+
+#ifndef _TAP_URING_H_
+#define _TAP_URING_H_
+
+#include <stdint.h>
+#include <sys/uio.h>
+
+#include <linux/if_tun.h>
+
+#include <rte_mbuf.h>
+#include <rte_mempool.h>
+
+/*
+ * io_uring based Rx/Tx of a queue: the reads or writes of a burst
+ * are all done by a single io_uring_enter() system call.
+ */
+struct tap_uring;
+
+/* Number of reads or writes submitted at once. */
+#define TAP_URING_DEPTH 64
+
+/*
+ * Create the io_uring of a Rx queue, reading from fd into mbufs of mp,
+ * with the memory of mp registered as fixed buffers when possible.
+ * Returns NULL if io_uring is not supported by the kernel.
+ */
+struct tap_uring *tap_uring_rx_create(int fd, struct rte_mempool *mp,
+		int socket_id);
+
+/* Create the io_uring of a Tx queue writing to fd. */
+struct tap_uring *tap_uring_tx_create(int fd, int socket_id);
+
+/* Free the io_uring of a queue, and the mbufs it holds. */
+void tap_uring_free(struct tap_uring *u);
+
+/*
+ * Read up to nb_pkts packets, with their packet info header in the
+ * mbuf headroom. The packets dropped for being too long are counted
+ * in *nb_err, and the allocation failures in *nb_nombuf.
+ */
+uint16_t tap_uring_rx_burst(struct tap_uring *u, struct rte_mbuf **bufs,
+		uint16_t nb_pkts, uint64_t *nb_err, uint64_t *nb_nombuf);
+
+/*
+ * Queue the write of a packet, made of the packet info and iovcnt data
+ * iovecs of len bytes in total. The data must stay valid until the next
+ * tap_uring_tx_flush(). Returns -1 if iovcnt is too large.
+ */
+int tap_uring_tx_queue(struct tap_uring *u, const struct tun_pi *pi,
+		const struct iovec *iov, int iovcnt, uint32_t len);
+
+/*
+ * Free mbufs when the queued writes are done, flushing them first if
+ * there are too many mbufs to free.
+ */
+void tap_uring_tx_free(struct tap_uring *u, struct rte_mbuf **m,
+		unsigned int n);
+
+/*
+ * Submit the queued writes, wait for them and free the deferred mbufs.
+ * Returns the number of failed writes, and their length in *err_bytes.
+ */
+uint16_t tap_uring_tx_flush(struct tap_uring *u, uint64_t *err_bytes);
+
+#endif /* _TAP_URING_H_ */
@@ -194,6 +194,7 @@ struct virtio_hw {
 	uint8_t has_rx_offload;
 	uint8_t use_vec_rx;
 	uint8_t use_vec_tx;
+	uint8_t use_vec_avx2;
 	uint8_t use_inorder_rx;
 	uint8_t use_inorder_tx;
 	uint8_t opened;
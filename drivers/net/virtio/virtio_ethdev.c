@@ -1284,6 +1284,9 @@ static const struct {
 	{	virtio_xmit_pkts_packed, "Scalar packed ring"},
 	{	virtio_xmit_pkts_inorder, "Scalar in order"},
 	{	virtio_xmit_pkts_packed_vec, "Vector packed ring"},
+#ifdef RTE_ARCH_X86
+	{	virtio_xmit_pkts_packed_vec_avx2, "Vector AVX2 packed ring"},
+#endif
 };
 
 static int
@@ -1314,9 +1317,10 @@ static const struct {
 	{	virtio_recv_pkts_inorder, "Scalar"},
 	{	virtio_recv_mergeable_pkts, "Scalar mergeable"},
 	{	virtio_recv_mergeable_pkts_packed, "Scalar mergeable packed ring"},
-#ifdef RTE_ARCH_x86
+#ifdef RTE_ARCH_X86
 	{	virtio_recv_pkts_vec, "Vector SSE"},
 	{	virtio_recv_pkts_packed_vec, "Vector AVX512 packed ring"},
+	{	virtio_recv_pkts_packed_vec_avx2, "Vector AVX2 packed ring"},
 #elif defined(RTE_ARCH_ARM)
 	{	virtio_recv_pkts_vec, "Vector NEON"},
 	{	virtio_recv_pkts_packed_vec, "Vector NEON packed ring"},
@@ -1357,10 +1361,16 @@ set_rxtx_funcs(struct rte_eth_dev *eth_dev)
 			"virtio: using packed ring %s Tx path on port %u",
 			hw->use_vec_tx ? "vectorized" : "standard",
 			eth_dev->data->port_id);
-		if (hw->use_vec_tx)
+		if (hw->use_vec_tx) {
 			eth_dev->tx_pkt_burst = virtio_xmit_pkts_packed_vec;
-		else
+#ifdef RTE_ARCH_X86
+			if (hw->use_vec_avx2)
+				eth_dev->tx_pkt_burst =
+					virtio_xmit_pkts_packed_vec_avx2;
+#endif
+		} else {
 			eth_dev->tx_pkt_burst = virtio_xmit_pkts_packed;
+		}
 	} else {
 		if (hw->use_inorder_tx) {
 			PMD_INIT_LOG(INFO, "virtio: using inorder Tx path on port %u",
@@ -1380,6 +1390,11 @@ set_rxtx_funcs(struct rte_eth_dev *eth_dev)
 				eth_dev->data->port_id);
 			eth_dev->rx_pkt_burst =
 				&virtio_recv_pkts_packed_vec;
+#ifdef RTE_ARCH_X86
+			if (hw->use_vec_avx2)
+				eth_dev->rx_pkt_burst =
+					&virtio_recv_pkts_packed_vec_avx2;
+#endif
 		} else if (virtio_with_feature(hw, VIRTIO_NET_F_MRG_RXBUF)) {
 			PMD_INIT_LOG(INFO,
 				"virtio: using packed ring mergeable buffer Rx path on port %u",
@@ -2090,7 +2105,7 @@ eth_virtio_dev_init(struct rte_eth_dev *eth_dev)
 		if (!virtio_with_packed_queue(hw)) {
 			hw->use_vec_tx = 0;
 		} else {
-#if !defined(CC_AVX512_SUPPORT) && !defined(RTE_ARCH_ARM)
+#if !defined(RTE_ARCH_X86) && !defined(RTE_ARCH_ARM)
 			hw->use_vec_rx = 0;
 			hw->use_vec_tx = 0;
 			PMD_DRV_LOG(INFO,
@@ -2360,12 +2375,20 @@ virtio_dev_configure(struct rte_eth_dev *dev)
 	hw->has_rx_offload = rx_offload_enabled(hw);
 
 	if (virtio_with_packed_queue(hw)) {
-#if defined(RTE_ARCH_X86_64) && defined(CC_AVX512_SUPPORT)
+#if defined(RTE_ARCH_X86_64)
+		/* AVX512 path when available, AVX2 path otherwise */
+		hw->use_vec_avx2 = 1;
+#ifdef CC_AVX512_SUPPORT
+		if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) &&
+		    rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_512)
+			hw->use_vec_avx2 = 0;
+#endif
 		if ((hw->use_vec_rx || hw->use_vec_tx) &&
-		    (!rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) ||
+		    ((hw->use_vec_avx2 &&
+		      (!rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2) ||
+		       rte_vect_get_max_simd_bitwidth() < RTE_VECT_SIMD_256)) ||
 		     !virtio_with_feature(hw, VIRTIO_F_IN_ORDER) ||
-		     !virtio_with_feature(hw, VIRTIO_F_VERSION_1) ||
-		     rte_vect_get_max_simd_bitwidth() < RTE_VECT_SIMD_512)) {
+		     !virtio_with_feature(hw, VIRTIO_F_VERSION_1))) {
 			PMD_DRV_LOG(INFO,
 				"disabled packed ring vectorized path for requirements not met");
 			hw->use_vec_rx = 0;
@@ -20,7 +20,7 @@
 
 #define BYTE_SIZE 8
 
-#ifdef CC_AVX512_SUPPORT
+#ifdef RTE_ARCH_X86
 /* flag bits offset in packed ring desc higher 64bits */
 #define FLAGS_BITS_OFFSET ((offsetof(struct vring_packed_desc, flags) - \
 	offsetof(struct vring_packed_desc, len)) * BYTE_SIZE)
@@ -39,7 +39,7 @@
 #define REFCNT_BITS_OFFSET ((offsetof(struct rte_mbuf, refcnt) - \
 	offsetof(struct rte_mbuf, rearm_data)) * BYTE_SIZE)
 
-#ifdef CC_AVX512_SUPPORT
+#ifdef RTE_ARCH_X86
 /* segment number offset in mbuf rearm data */
 #define SEG_NUM_BITS_OFFSET ((offsetof(struct rte_mbuf, nb_segs) - \
 	offsetof(struct rte_mbuf, rearm_data)) * BYTE_SIZE)
@@ -0,0 +1,237 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include <rte_net.h>
+#include <rte_vect.h>
+
+#include "virtio_logs.h"
+#include "virtio_ethdev.h"
+#include "virtio.h"
+#include "virtio_rxtx_packed.h"
+#include "virtqueue.h"
+
+/*
+ * Same batch operations as the AVX512 version, with the four descriptors
+ * of a cache line handled as two 256-bit halves.
+ */
+
+static inline int
+virtqueue_enqueue_batch_packed_vec(struct virtnet_tx *txvq,
+				   struct rte_mbuf **tx_pkts)
+{
+	struct virtqueue *vq = virtnet_txq_to_vq(txvq);
+	uint16_t head_size = vq->hw->vtnet_hdr_size;
+	uint16_t idx = vq->vq_avail_idx;
+	struct virtio_net_hdr *hdr;
+	struct vq_desc_extra *dxp;
+	uint16_t i;
+	int cmp;
+
+	if (vq->vq_avail_idx & PACKED_BATCH_MASK)
+		return -1;
+
+	if (unlikely((idx + PACKED_BATCH_SIZE) > vq->vq_nentries))
+		return -1;
+
+	/* Load four mbufs rearm data */
+	RTE_BUILD_BUG_ON(REFCNT_BITS_OFFSET >= 64);
+	RTE_BUILD_BUG_ON(SEG_NUM_BITS_OFFSET >= 64);
+	__m256i mbufs = _mm256_set_epi64x(*tx_pkts[3]->rearm_data,
+					  *tx_pkts[2]->rearm_data,
+					  *tx_pkts[1]->rearm_data,
+					  *tx_pkts[0]->rearm_data);
+
+	/* Check refcnt=1 and nb_segs=1 */
+	__m256i ref_mask = _mm256_set1_epi64x(0xFFFFULL << REFCNT_BITS_OFFSET |
+					      0xFFFFULL << SEG_NUM_BITS_OFFSET);
+	__m256i mbuf_ref = _mm256_set1_epi64x(DEFAULT_REARM_DATA);
+	cmp = _mm256_movemask_epi8(_mm256_cmpeq_epi64(
+			_mm256_and_si256(mbufs, ref_mask), mbuf_ref));
+	if (unlikely(cmp != -1))
+		return -1;
+
+	/* Check headroom is enough, as unsigned data_off >= head_size */
+	RTE_BUILD_BUG_ON(offsetof(struct rte_mbuf, data_off) !=
+		offsetof(struct rte_mbuf, rearm_data));
+	__m256i head_rooms = _mm256_set1_epi16(head_size);
+	cmp = _mm256_movemask_epi8(_mm256_cmpeq_epi16(
+			_mm256_max_epu16(mbufs, head_rooms), mbufs));
+	if (unlikely((cmp & 0x03030303) != 0x03030303))
+		return -1;
+
+	virtio_for_each_try_unroll(i, 0, PACKED_BATCH_SIZE) {
+		dxp = &vq->vq_descx[idx + i];
+		dxp->ndescs = 1;
+		dxp->cookie = tx_pkts[i];
+	}
+
+	virtio_for_each_try_unroll(i, 0, PACKED_BATCH_SIZE) {
+		tx_pkts[i]->data_off -= head_size;
+		tx_pkts[i]->data_len += head_size;
+	}
+
+	uint64_t flags_temp = (uint64_t)idx << ID_BITS_OFFSET |
+		(uint64_t)vq->vq_packed.cached_flags << FLAGS_BITS_OFFSET;
+
+	/* id and flags offset, for the two descs of each half */
+	__m256i v_offset = _mm256_set_epi64x(flags_temp +
+			((uint64_t)1 << ID_BITS_OFFSET), 0, flags_temp, 0);
+
+	__m256i v_desc_lo = _mm256_add_epi64(v_offset,
+			_mm256_set_epi64x(tx_pkts[1]->data_len,
+				VIRTIO_MBUF_ADDR(tx_pkts[1], vq) +
+				tx_pkts[1]->data_off,
+				tx_pkts[0]->data_len,
+				VIRTIO_MBUF_ADDR(tx_pkts[0], vq) +
+				tx_pkts[0]->data_off));
+	__m256i v_desc_hi = _mm256_add_epi64(v_offset,
+			_mm256_set_epi64x(tx_pkts[3]->data_len +
+				((uint64_t)2 << ID_BITS_OFFSET),
+				VIRTIO_MBUF_ADDR(tx_pkts[3], vq) +
+				tx_pkts[3]->data_off,
+				tx_pkts[2]->data_len +
+				((uint64_t)2 << ID_BITS_OFFSET),
+				VIRTIO_MBUF_ADDR(tx_pkts[2], vq) +
+				tx_pkts[2]->data_off));
+
+	if (!vq->hw->has_tx_offload) {
+		/* first NET_HDR_MASK 16-bit words of the header */
+		__m128i hdr_mask = _mm_set_epi16(0, 0, -1, -1, -1, -1, -1, -1);
+		RTE_BUILD_BUG_ON(NET_HDR_MASK != 0x3F);
+		virtio_for_each_try_unroll(i, 0, PACKED_BATCH_SIZE) {
+			hdr = rte_pktmbuf_mtod_offset(tx_pkts[i],
+					struct virtio_net_hdr *, -head_size);
+			__m128i v_hdr = _mm_loadu_si128((void *)hdr);
+			if (unlikely(!_mm_testz_si128(v_hdr, hdr_mask)))
+				_mm_storeu_si128((void *)hdr,
+					_mm_andnot_si128(hdr_mask, v_hdr));
+		}
+	} else {
+		virtio_for_each_try_unroll(i, 0, PACKED_BATCH_SIZE) {
+			hdr = rte_pktmbuf_mtod_offset(tx_pkts[i],
+					struct virtio_net_hdr *, -head_size);
+			virtqueue_xmit_offload(hdr, tx_pkts[i]);
+		}
+	}
+
+	/* Enqueue Packet buffers */
+	_mm256_storeu_si256((void *)&vq->vq_packed.ring.desc[idx], v_desc_lo);
+	_mm256_storeu_si256((void *)&vq->vq_packed.ring.desc[idx + 2],
+			v_desc_hi);
+
+	virtio_update_batch_stats(&txvq->stats, tx_pkts[0]->pkt_len,
+			tx_pkts[1]->pkt_len, tx_pkts[2]->pkt_len,
+			tx_pkts[3]->pkt_len);
+
+	vq->vq_avail_idx += PACKED_BATCH_SIZE;
+	vq->vq_free_cnt -= PACKED_BATCH_SIZE;
+
+	if (vq->vq_avail_idx >= vq->vq_nentries) {
+		vq->vq_avail_idx -= vq->vq_nentries;
+		vq->vq_packed.cached_flags ^=
+			VRING_PACKED_DESC_F_AVAIL_USED;
+	}
+
+	return 0;
+}
+
+static inline uint16_t
+virtqueue_dequeue_batch_packed_vec(struct virtnet_rx *rxvq,
+				   struct rte_mbuf **rx_pkts)
+{
+	struct virtqueue *vq = virtnet_rxq_to_vq(rxvq);
+	struct virtio_hw *hw = vq->hw;
+	uint16_t hdr_size = hw->vtnet_hdr_size;
+	uint16_t id = vq->vq_used_cons_idx;
+	void *desc_addr;
+	uint16_t i;
+
+	if (id & PACKED_BATCH_MASK)
+		return -1;
+
+	if (unlikely((id + PACKED_BATCH_SIZE) > vq->vq_nentries))
+		return -1;
+
+	/* only care avail/used bits */
+	__m256i v_mask = _mm256_set_epi64x(PACKED_FLAGS_MASK, 0x0,
+					   PACKED_FLAGS_MASK, 0x0);
+	desc_addr = &vq->vq_packed.ring.desc[id];
+
+	__m256i v_desc_lo = _mm256_loadu_si256(desc_addr);
+	__m256i v_desc_hi = _mm256_loadu_si256((__m256i *)desc_addr + 1);
+	__m256i v_flag_lo = _mm256_and_si256(v_desc_lo, v_mask);
+	__m256i v_flag_hi = _mm256_and_si256(v_desc_hi, v_mask);
+
+	__m256i v_used_flag = _mm256_setzero_si256();
+	if (vq->vq_packed.used_wrap_counter)
+		v_used_flag = v_mask;
+
+	/* Check all descs are used */
+	if (_mm256_movemask_epi8(_mm256_and_si256(
+			_mm256_cmpeq_epi64(v_flag_lo, v_used_flag),
+			_mm256_cmpeq_epi64(v_flag_hi, v_used_flag))) != -1)
+		return -1;
+
+	virtio_for_each_try_unroll(i, 0, PACKED_BATCH_SIZE) {
+		rx_pkts[i] = (struct rte_mbuf *)vq->vq_descx[id + i].cookie;
+		rte_packet_prefetch(rte_pktmbuf_mtod(rx_pkts[i], void *));
+	}
+
+	/*
+	 * load len from desc, store into mbuf pkt_len and data_len
+	 * len limited by l6bit buf_len, pkt_len[16:31] can be ignored
+	 */
+	const int blend = 0x6 | 0x6 << 4;
+	__m256i mbuf_len_offset = _mm256_blend_epi32(_mm256_setzero_si256(),
+			_mm256_set1_epi32((uint32_t)-hdr_size), blend);
+	__m256i v_value_lo = _mm256_add_epi32(mbuf_len_offset,
+			_mm256_blend_epi32(_mm256_setzero_si256(),
+				_mm256_shuffle_epi32(v_desc_lo, 0xAA), blend));
+	__m256i v_value_hi = _mm256_add_epi32(mbuf_len_offset,
+			_mm256_blend_epi32(_mm256_setzero_si256(),
+				_mm256_shuffle_epi32(v_desc_hi, 0xAA), blend));
+
+	/* assert offset of data_len */
+	RTE_BUILD_BUG_ON(offsetof(struct rte_mbuf, data_len) !=
+		offsetof(struct rte_mbuf, rx_descriptor_fields1) + 8);
+
+	/* store into mbufs, one 128-bit lane per mbuf */
+	_mm_storeu_si128((void *)rx_pkts[0]->rx_descriptor_fields1,
+			_mm256_castsi256_si128(v_value_lo));
+	_mm_storeu_si128((void *)rx_pkts[1]->rx_descriptor_fields1,
+			_mm256_extracti128_si256(v_value_lo, 1));
+	_mm_storeu_si128((void *)rx_pkts[2]->rx_descriptor_fields1,
+			_mm256_castsi256_si128(v_value_hi));
+	_mm_storeu_si128((void *)rx_pkts[3]->rx_descriptor_fields1,
+			_mm256_extracti128_si256(v_value_hi, 1));
+
+	if (hw->has_rx_offload) {
+		virtio_for_each_try_unroll(i, 0, PACKED_BATCH_SIZE) {
+			char *addr = (char *)rx_pkts[i]->buf_addr +
+				RTE_PKTMBUF_HEADROOM - hdr_size;
+			virtio_vec_rx_offload(rx_pkts[i],
+					(struct virtio_net_hdr *)addr);
+		}
+	}
+
+	virtio_update_batch_stats(&rxvq->stats, rx_pkts[0]->pkt_len,
+			rx_pkts[1]->pkt_len, rx_pkts[2]->pkt_len,
+			rx_pkts[3]->pkt_len);
+
+	vq->vq_free_cnt += PACKED_BATCH_SIZE;
+
+	vq->vq_used_cons_idx += PACKED_BATCH_SIZE;
+	if (vq->vq_used_cons_idx >= vq->vq_nentries) {
+		vq->vq_used_cons_idx -= vq->vq_nentries;
+		vq->vq_packed.used_wrap_counter ^= 1;
+	}
+
+	return 0;
+}
@@ -1139,6 +1139,8 @@ vmxnet3_dev_start(struct rte_eth_dev *dev)
 		return ret;
 	}
 
+	vmxnet3_set_rx_function(dev);
+
 	vmxnet3_init_bufsize(hw);
 
 	hw->adapter_stopped = FALSE;
@@ -1655,6 +1657,12 @@ vmxnet3_dev_supported_ptypes_get(struct rte_eth_dev *dev,
 		*no_of_elements = RTE_DIM(ptypes);
 		return ptypes;
 	}
+#ifdef RTE_ARCH_X86
+	if (dev->rx_pkt_burst == vmxnet3_recv_pkts_vec) {
+		*no_of_elements = RTE_DIM(ptypes);
+		return ptypes;
+	}
+#endif
 	return NULL;
 }
 
@@ -224,11 +224,31 @@ int vmxnet3_rss_configure(struct rte_eth_dev *dev);
 
 uint16_t vmxnet3_recv_pkts(void *rx_queue, struct rte_mbuf **rx_pkts,
 			   uint16_t nb_pkts);
+uint16_t vmxnet3_recv_pkts_vec(void *rx_queue, struct rte_mbuf **rx_pkts,
+			       uint16_t nb_pkts);
+void vmxnet3_set_rx_function(struct rte_eth_dev *dev);
+void vmxnet3_rx_rearm_bulk(struct vmxnet3_rx_queue *rxq);
 uint16_t vmxnet3_xmit_pkts(void *tx_queue, struct rte_mbuf **tx_pkts,
 			   uint16_t nb_pkts);
 uint16_t vmxnet3_prep_pkts(void *tx_queue, struct rte_mbuf **tx_pkts,
 			uint16_t nb_pkts);
 
+/* Number of mbufs allocated together to refill the Rx ring */
+#define VMXNET3_RX_REARM_BULK	32
+
+/*
+ * Offload flags and packet type of a packet, indexed by
+ * tuc, udp, tcp, ipc, v6 and v4 bits of the completion, then cnc.
+ */
+#define VMXNET3_RX_FLAGS_NUM	128
+
+struct vmxnet3_rx_flags {
+	uint64_t ol_flags;
+	uint32_t packet_type;
+};
+
+extern struct vmxnet3_rx_flags vmxnet3_rx_flags_table[VMXNET3_RX_FLAGS_NUM];
+
 #define VMXNET3_SEGS_DYNFIELD_NAME "rte_net_vmxnet3_dynfield_segs"
 typedef uint8_t vmxnet3_segs_dynfield_t;
 extern int vmxnet3_segs_dynfield_offset;
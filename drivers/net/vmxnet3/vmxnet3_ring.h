@@ -151,6 +151,7 @@ typedef struct vmxnet3_rx_queue {
 	bool                        stopped;
 	uint16_t                    queue_id;      /**< Device RX queue index. */
 	uint16_t                    port_id;       /**< Device port identifier. */
+	uint64_t                    mbuf_initializer; /**< Value to init mbufs. */
 } vmxnet3_rx_queue_t;
 
 #endif /* _VMXNET3_RING_H_ */
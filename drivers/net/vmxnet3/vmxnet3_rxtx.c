@@ -41,6 +41,7 @@
 #include <rte_string_fns.h>
 #include <rte_errno.h>
 #include <rte_net.h>
+#include <rte_vect.h>
 
 #include "base/vmxnet3_defs.h"
 #include "vmxnet3_ring.h"
@@ -679,6 +680,35 @@ vmxnet3_post_rx_bufs(vmxnet3_rx_queue_t *rxq, uint8_t ring_id)
 		return i;
 }
 
+/*
+ * Refill the 1st ring with a bulk of mbufs once enough descriptors are free,
+ * and update the device with a single write.
+ */
+void
+vmxnet3_rx_rearm_bulk(vmxnet3_rx_queue_t *rxq)
+{
+	struct vmxnet3_cmd_ring *ring = &rxq->cmd_ring[0];
+	struct rte_mbuf *mbufs[VMXNET3_RX_REARM_BULK];
+	unsigned int i;
+
+	if (vmxnet3_cmd_ring_desc_avail(ring) < VMXNET3_RX_REARM_BULK)
+		return;
+
+	if (unlikely(rte_mbuf_raw_alloc_bulk(rxq->mp, mbufs,
+					     VMXNET3_RX_REARM_BULK) != 0)) {
+		rxq->stats.rx_buf_alloc_failure++;
+		return;
+	}
+
+	for (i = 0; i < VMXNET3_RX_REARM_BULK; i++)
+		vmxnet3_renew_desc(rxq, 0, mbufs[i]);
+
+	if (unlikely(rxq->shared->ctrl.updateRxProd))
+		VMXNET3_WRITE_BAR0_REG(rxq->hw, rxq->hw->rx_prod_offset[0] +
+				       (rxq->queue_id * VMXNET3_REG_ALIGN),
+				       ring->next2fill);
+}
+
 /* MSS not provided by vmxnet3, guess one with available information */
 static uint16_t
 vmxnet3_guess_mss(struct vmxnet3_hw *hw, const Vmxnet3_RxCompDesc *rcd,
@@ -1055,6 +1085,51 @@ vmxnet3_recv_pkts(void *rx_queue, struct rte_mbuf **rx_pkts, uint16_t nb_pkts)
 	return nb_rx;
 }
 
+struct vmxnet3_rx_flags vmxnet3_rx_flags_table[VMXNET3_RX_FLAGS_NUM];
+
+/* Fill the flags of the vector Rx from the scalar Rx offload parsing */
+static void
+vmxnet3_rx_flags_init(struct vmxnet3_hw *hw)
+{
+	Vmxnet3_RxCompDesc rcd;
+	struct rte_mbuf m;
+	uint32_t key;
+
+	for (key = 0; key < VMXNET3_RX_FLAGS_NUM; key++) {
+		memset(&rcd, 0, sizeof(rcd));
+		rcd.type = VMXNET3_CDTYPE_RXCOMP;
+		rcd.tuc = !!(key & RTE_BIT32(0));
+		rcd.udp = !!(key & RTE_BIT32(1));
+		rcd.tcp = !!(key & RTE_BIT32(2));
+		rcd.ipc = !!(key & RTE_BIT32(3));
+		rcd.v6 = !!(key & RTE_BIT32(4));
+		rcd.v4 = !!(key & RTE_BIT32(5));
+		rcd.cnc = !!(key & RTE_BIT32(6));
+
+		memset(&m, 0, sizeof(m));
+		vmxnet3_rx_offload(hw, &rcd, &m, 1);
+		vmxnet3_rx_offload(hw, &rcd, &m, 0);
+		vmxnet3_rx_flags_table[key].ol_flags = m.ol_flags;
+		vmxnet3_rx_flags_table[key].packet_type = m.packet_type;
+	}
+}
+
+void
+vmxnet3_set_rx_function(struct rte_eth_dev *dev)
+{
+#ifdef RTE_ARCH_X86
+	if (rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_128) {
+		PMD_INIT_LOG(DEBUG, "Using vector Rx on port %u",
+			     dev->data->port_id);
+		vmxnet3_rx_flags_init(dev->data->dev_private);
+		dev->rx_pkt_burst = vmxnet3_recv_pkts_vec;
+		return;
+	}
+#endif
+
+	dev->rx_pkt_burst = vmxnet3_recv_pkts;
+}
+
 int
 vmxnet3_dev_rx_queue_count(void *rx_queue)
 {
@@ -1186,14 +1261,29 @@ vmxnet3_dev_tx_queue_setup(struct rte_eth_dev *dev,
 	return 0;
 }
 
+static uint64_t
+vmxnet3_rx_mbuf_initializer(uint16_t port_id)
+{
+	struct rte_mbuf mb_def = { .buf_addr = 0 };
+
+	mb_def.nb_segs = 1;
+	mb_def.data_off = RTE_PKTMBUF_HEADROOM;
+	mb_def.port = port_id;
+	rte_mbuf_refcnt_set(&mb_def, 1);
+
+	return mb_def.rearm_data[0];
+}
+
 int
 vmxnet3_dev_rx_queue_setup(struct rte_eth_dev *dev,
 			   uint16_t queue_idx,
 			   uint16_t nb_desc,
 			   unsigned int socket_id,
-			   __rte_unused const struct rte_eth_rxconf *rx_conf,
+			   const struct rte_eth_rxconf *rx_conf,
 			   struct rte_mempool *mp)
 {
+	uint64_t offloads = dev->data->dev_conf.rxmode.offloads |
+		rx_conf->offloads;
 	const struct rte_memzone *mz;
 	struct vmxnet3_rx_queue *rxq;
 	struct vmxnet3_hw *hw = dev->data->dev_private;
@@ -1226,18 +1316,21 @@ vmxnet3_dev_rx_queue_setup(struct rte_eth_dev *dev,
 	rxq->data_ring_qid = queue_idx + 2 * hw->num_rx_queues;
 	rxq->data_desc_size = hw->rxdata_desc_size;
 	rxq->stopped = TRUE;
+	rxq->mbuf_initializer = vmxnet3_rx_mbuf_initializer(rxq->port_id);
 
 	ring0 = &rxq->cmd_ring[0];
 	ring1 = &rxq->cmd_ring[1];
 	comp_ring = &rxq->comp_ring;
 	data_ring = &rxq->data_ring;
 
-	/* Rx vmxnet rings length should be between 256-4096 */
+	/* Rx vmxnet rings length should be between 128-4096 */
 	if (nb_desc < VMXNET3_DEF_RX_RING_SIZE) {
-		PMD_INIT_LOG(ERR, "VMXNET3 Rx Ring Size Min: 256");
+		PMD_INIT_LOG(ERR, "VMXNET3 Rx Ring Size Min: %u",
+			     VMXNET3_DEF_RX_RING_SIZE);
 		return -EINVAL;
 	} else if (nb_desc > VMXNET3_RX_RING_MAX_SIZE) {
-		PMD_INIT_LOG(ERR, "VMXNET3 Rx Ring Size Max: 4096");
+		PMD_INIT_LOG(ERR, "VMXNET3 Rx Ring Size Max: %u",
+			     VMXNET3_RX_RING_MAX_SIZE);
 		return -EINVAL;
 	} else {
 		ring0->size = nb_desc;
@@ -1245,6 +1338,15 @@ vmxnet3_dev_rx_queue_setup(struct rte_eth_dev *dev,
 			ring0->size = rte_align32prevpow2(nb_desc);
 		ring0->size &= ~VMXNET3_RING_SIZE_MASK;
 		ring1->size = ring0->size;
+		/*
+		 * The 2nd ring only gets the body of packets larger than
+		 * a buffer, keep it small for large rings without scatter,
+		 * instead of doubling the mbufs and completions.
+		 */
+		if (!(offloads & (RTE_ETH_RX_OFFLOAD_SCATTER |
+				  RTE_ETH_RX_OFFLOAD_TCP_LRO)))
+			ring1->size = RTE_MIN(ring0->size,
+					      (uint32_t)VMXNET3_DEF_RX_RING_SIZE);
 	}
 
 	comp_ring->size = ring0->size + ring1->size;
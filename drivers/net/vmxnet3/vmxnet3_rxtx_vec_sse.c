@@ -0,0 +1,216 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_vect.h>
+#include <rte_memcpy.h>
+#include <ethdev_driver.h>
+
+#include "base/vmxnet3_defs.h"
+#include "vmxnet3_ring.h"
+
+#include "vmxnet3_logs.h"
+#include "vmxnet3_ethdev.h"
+
+/* Number of completion descriptors parsed together */
+#define VMXNET3_RX_VEC_DESCS		4
+
+/* Bits of the 4 dwords of a completion descriptor */
+#define VMXNET3_RX_VEC_IDX_MASK		0xfff		/* dword 0 */
+#define VMXNET3_RX_VEC_EOP		RTE_BIT32(14)	/* dword 0 */
+#define VMXNET3_RX_VEC_SOP		RTE_BIT32(15)	/* dword 0 */
+#define VMXNET3_RX_VEC_RQID_SHIFT	16		/* dword 0 */
+#define VMXNET3_RX_VEC_RQID_MASK	0x3ff
+#define VMXNET3_RX_VEC_RSS_MASK		(0xfU << 26)	/* dword 0 */
+#define VMXNET3_RX_VEC_CNC		RTE_BIT32(30)	/* dword 0 */
+#define VMXNET3_RX_VEC_LEN_MASK		0x3fff		/* dword 2 */
+#define VMXNET3_RX_VEC_ERR		RTE_BIT32(14)	/* dword 2 */
+#define VMXNET3_RX_VEC_TS		RTE_BIT32(15)	/* dword 2 */
+#define VMXNET3_RX_VEC_FLAGS_SHIFT	16		/* dword 3 */
+#define VMXNET3_RX_VEC_FLAGS_MASK	0x3f
+#define VMXNET3_RX_VEC_TYPE_SHIFT	24		/* dword 3 */
+#define VMXNET3_RX_VEC_TYPE_MASK	(0x7fU << VMXNET3_RX_VEC_TYPE_SHIFT)
+#define VMXNET3_RX_VEC_GEN_SHIFT	31		/* dword 3 */
+
+/*
+ * Receive single buffer packets of the 1st ring,
+ * parsing 4 completion descriptors together.
+ * Errors, multi-buffer and LRO packets and the descriptors at the end of
+ * the completion ring are left to the scalar Rx.
+ */
+uint16_t
+vmxnet3_recv_pkts_vec(void *rx_queue, struct rte_mbuf **rx_pkts, uint16_t nb_pkts)
+{
+	vmxnet3_rx_queue_t *rxq = rx_queue;
+	struct vmxnet3_comp_ring *comp_ring = &rxq->comp_ring;
+	struct vmxnet3_cmd_ring *ring0 = &rxq->cmd_ring[0];
+	const volatile Vmxnet3_GenericDesc *rcd;
+	uint32_t next2proc = comp_ring->next2proc;
+	uint32_t dw0[VMXNET3_RX_VEC_DESCS];
+	uint32_t dw2[VMXNET3_RX_VEC_DESCS];
+	uint32_t keys[VMXNET3_RX_VEC_DESCS];
+	uint32_t hashes[VMXNET3_RX_VEC_DESCS];
+	uint16_t nb_rx = 0;
+	unsigned int i, n;
+
+	const __m128i check3_mask = _mm_set1_epi32(VMXNET3_RX_VEC_TYPE_MASK |
+		RTE_BIT32(VMXNET3_RX_VEC_GEN_SHIFT));
+	const __m128i sop_eop = _mm_set1_epi32(VMXNET3_RX_VEC_SOP |
+		VMXNET3_RX_VEC_EOP);
+	const __m128i err_mask = _mm_set1_epi32(VMXNET3_RX_VEC_ERR);
+	const __m128i len_mask = _mm_set1_epi32(VMXNET3_RX_VEC_LEN_MASK);
+	const __m128i idx_mask = _mm_set1_epi32(VMXNET3_RX_VEC_IDX_MASK);
+	const __m128i rqid_mask = _mm_set1_epi32(VMXNET3_RX_VEC_RQID_MASK);
+	const __m128i flags_mask = _mm_set1_epi32(VMXNET3_RX_VEC_FLAGS_MASK);
+	const __m128i cnc_mask = _mm_set1_epi32(VMXNET3_RX_VEC_CNC);
+	const __m128i qid1 = _mm_set1_epi32(rxq->qid1);
+	const __m128i data_qid = _mm_set1_epi32(rxq->data_ring_qid);
+	const __m128i lanes = _mm_set_epi32(3, 2, 1, 0);
+	const __m128i zero = _mm_setzero_si128();
+
+	/* mbuf fields stored together from the completion descriptor */
+	RTE_BUILD_BUG_ON(offsetof(struct rte_mbuf, pkt_len) !=
+			 offsetof(struct rte_mbuf, rx_descriptor_fields1) + 4);
+	RTE_BUILD_BUG_ON(offsetof(struct rte_mbuf, data_len) !=
+			 offsetof(struct rte_mbuf, rx_descriptor_fields1) + 8);
+	RTE_BUILD_BUG_ON(offsetof(struct rte_mbuf, vlan_tci) !=
+			 offsetof(struct rte_mbuf, rx_descriptor_fields1) + 10);
+	RTE_BUILD_BUG_ON(offsetof(struct rte_mbuf, hash) !=
+			 offsetof(struct rte_mbuf, rx_descriptor_fields1) + 12);
+	RTE_BUILD_BUG_ON(sizeof(Vmxnet3_RxCompDesc) != 16);
+	RTE_BUILD_BUG_ON(VMXNET3_RX_FLAGS_NUM !=
+			 (VMXNET3_RX_VEC_FLAGS_MASK + 1) << 1);
+
+	if (unlikely(rxq->stopped)) {
+		PMD_RX_LOG(DEBUG, "Rx queue is stopped.");
+		return 0;
+	}
+
+	while (nb_rx < nb_pkts &&
+	       next2proc + VMXNET3_RX_VEC_DESCS <= comp_ring->size) {
+		__m128i d0, d1, d2, d3, t0, t1, t2, t3, w0, w1, w2, w3;
+		__m128i expected, ok, rqid, key;
+
+		rcd = &comp_ring->base[next2proc];
+		expected = _mm_set1_epi32((VMXNET3_CDTYPE_RXCOMP <<
+			VMXNET3_RX_VEC_TYPE_SHIFT) |
+			((uint32_t)comp_ring->gen << VMXNET3_RX_VEC_GEN_SHIFT));
+
+		/* Generations are read before the rest of the descriptors */
+		d0 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rcd[0]);
+		d1 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rcd[1]);
+		d2 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rcd[2]);
+		d3 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rcd[3]);
+		t2 = _mm_unpackhi_epi32(d0, d1);
+		t3 = _mm_unpackhi_epi32(d2, d3);
+		w3 = _mm_unpackhi_epi64(t2, t3);
+		ok = _mm_cmpeq_epi32(_mm_and_si128(w3, check3_mask), expected);
+		n = rte_ctz32(~_mm_movemask_ps(_mm_castsi128_ps(ok)));
+		if (n == 0)
+			break;
+
+		rte_io_rmb();
+
+		d0 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rcd[0]);
+		d1 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rcd[1]);
+		d2 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rcd[2]);
+		d3 = _mm_loadu_si128((const __m128i *)(uintptr_t)&rcd[3]);
+		t0 = _mm_unpacklo_epi32(d0, d1);
+		t1 = _mm_unpacklo_epi32(d2, d3);
+		t2 = _mm_unpackhi_epi32(d0, d1);
+		t3 = _mm_unpackhi_epi32(d2, d3);
+		w0 = _mm_unpacklo_epi64(t0, t1);
+		w1 = _mm_unpackhi_epi64(t0, t1);
+		w2 = _mm_unpacklo_epi64(t2, t3);
+		w3 = _mm_unpackhi_epi64(t2, t3);
+
+		/* non-empty complete packets without error */
+		ok = _mm_cmpeq_epi32(_mm_and_si128(w0, sop_eop), sop_eop);
+		ok = _mm_and_si128(ok, _mm_cmpeq_epi32(
+			_mm_and_si128(w2, err_mask), zero));
+		ok = _mm_andnot_si128(_mm_cmpeq_epi32(
+			_mm_and_si128(w2, len_mask), zero), ok);
+		/* in the 1st ring or its data ring */
+		rqid = _mm_and_si128(_mm_srli_epi32(w0,
+			VMXNET3_RX_VEC_RQID_SHIFT), rqid_mask);
+		ok = _mm_and_si128(ok, _mm_or_si128(_mm_cmpeq_epi32(rqid, qid1),
+			_mm_cmpeq_epi32(rqid, data_qid)));
+		/* in order of the 1st ring, without wrapping */
+		ok = _mm_and_si128(ok, _mm_cmpeq_epi32(_mm_and_si128(w0, idx_mask),
+			_mm_add_epi32(_mm_set1_epi32(ring0->next2comp), lanes)));
+		n = RTE_MIN(n, rte_ctz32(~_mm_movemask_ps(_mm_castsi128_ps(ok))));
+		n = RTE_MIN(n, (unsigned int)(nb_pkts - nb_rx));
+		if (n == 0)
+			break;
+
+		/* index of the flags of each packet */
+		key = _mm_and_si128(_mm_srli_epi32(w3,
+			VMXNET3_RX_VEC_FLAGS_SHIFT), flags_mask);
+		key = _mm_or_si128(key, _mm_srli_epi32(
+			_mm_and_si128(w0, cnc_mask), 24));
+		_mm_storeu_si128((__m128i *)keys, key);
+		_mm_storeu_si128((__m128i *)dw0, w0);
+		_mm_storeu_si128((__m128i *)hashes, w1);
+		_mm_storeu_si128((__m128i *)dw2, w2);
+
+		for (i = 0; i < n; i++) {
+			const struct vmxnet3_rx_flags *flags =
+				&vmxnet3_rx_flags_table[keys[i]];
+			vmxnet3_buf_info_t *rbi =
+				&ring0->buf_info[ring0->next2comp];
+			uint32_t len = dw2[i] & VMXNET3_RX_VEC_LEN_MASK;
+			uint32_t rq_id = (dw0[i] >> VMXNET3_RX_VEC_RQID_SHIFT) &
+				VMXNET3_RX_VEC_RQID_MASK;
+			uint64_t ol_flags = flags->ol_flags;
+			uint32_t tci = 0;
+			struct rte_mbuf *rxm = rbi->m;
+
+			rbi->m = NULL;
+			rbi->bufPA = 0;
+
+			if (unlikely(rq_id != rxq->qid1)) {
+				uint8_t *rdd = rxq->data_ring.base +
+					ring0->next2comp * rxq->data_desc_size;
+
+				rte_memcpy(rte_pktmbuf_mtod(rxm, char *),
+					   rdd, len);
+			}
+
+			if (dw0[i] & VMXNET3_RX_VEC_RSS_MASK)
+				ol_flags |= RTE_MBUF_F_RX_RSS_HASH;
+			if (dw2[i] & VMXNET3_RX_VEC_TS) {
+				ol_flags |= RTE_MBUF_F_RX_VLAN |
+					RTE_MBUF_F_RX_VLAN_STRIPPED;
+				tci = dw2[i] >> 16;
+			}
+
+			rxm->rearm_data[0] = rxq->mbuf_initializer;
+			_mm_storeu_si128((__m128i *)rxm->rx_descriptor_fields1,
+				_mm_set_epi32(hashes[i], tci << 16 | len, len,
+					      flags->packet_type));
+			rxm->ol_flags = ol_flags;
+
+			VMXNET3_INC_RING_IDX_ONLY(ring0->next2comp,
+						  ring0->size);
+			rx_pkts[nb_rx + i] = rxm;
+		}
+
+		nb_rx += n;
+		next2proc += n;
+		if (next2proc == comp_ring->size) {
+			next2proc = 0;
+			comp_ring->gen ^= 1;
+		}
+		if (n < VMXNET3_RX_VEC_DESCS)
+			break;
+	}
+
+	comp_ring->next2proc = next2proc;
+	vmxnet3_rx_rearm_bulk(rxq);
+
+	if (nb_rx < nb_pkts)
+		nb_rx += vmxnet3_recv_pkts(rxq, rx_pkts + nb_rx,
+					   nb_pkts - nb_rx);
+
+	return nb_rx;
+}
@@ -0,0 +1,788 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <bus_vdev_driver.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_regexdev.h>
+#include <rte_regexdev_core.h>
+#include <rte_regexdev_driver.h>
+
+#include "hs_regexdev.h"
+
+#define HS_REGEX_RULE_FLAGS (RTE_REGEX_PCRE_RULE_ALLOW_EMPTY_F | \
+		RTE_REGEX_PCRE_RULE_CASELESS_F | RTE_REGEX_PCRE_RULE_DOTALL_F | \
+		RTE_REGEX_PCRE_RULE_MULTILINE_F | RTE_REGEX_PCRE_RULE_UCP_F | \
+		RTE_REGEX_PCRE_RULE_UTF_F)
+
+#define HS_REGEX_DB_MAGIC	"DPDK_HS"
+#define HS_REGEX_DB_VERSION	1
+
+/* Layout of an exported rule database, followed by the match identifiers
+ * and the serialized Hyperscan database.
+ */
+struct hs_regex_db_hdr {
+	char magic[8];
+	uint32_t version;
+	uint32_t nb_ids;
+	uint64_t hs_len;
+};
+
+/* Context of the scan of one operation */
+struct hs_regex_scan {
+	const struct hs_regex_priv *priv;
+	struct rte_regex_ops *op;
+	uint16_t groups[4];
+	uint16_t nb_groups;
+};
+
+static unsigned int
+hs_regex_flags(uint64_t rule_flags)
+{
+	unsigned int flags = HS_FLAG_SOM_LEFTMOST;
+
+	if (rule_flags & RTE_REGEX_PCRE_RULE_ALLOW_EMPTY_F)
+		flags |= HS_FLAG_ALLOWEMPTY;
+	if (rule_flags & RTE_REGEX_PCRE_RULE_CASELESS_F)
+		flags |= HS_FLAG_CASELESS;
+	if (rule_flags & RTE_REGEX_PCRE_RULE_DOTALL_F)
+		flags |= HS_FLAG_DOTALL;
+	if (rule_flags & RTE_REGEX_PCRE_RULE_MULTILINE_F)
+		flags |= HS_FLAG_MULTILINE;
+	if (rule_flags & RTE_REGEX_PCRE_RULE_UCP_F)
+		flags |= HS_FLAG_UCP;
+	if (rule_flags & RTE_REGEX_PCRE_RULE_UTF_F)
+		flags |= HS_FLAG_UTF8;
+
+	return flags;
+}
+
+static int
+hs_regex_match(unsigned int id, unsigned long long from, unsigned long long to,
+	       unsigned int flags __rte_unused, void *ctx)
+{
+	struct hs_regex_scan *scan = ctx;
+	const struct hs_regex_match_id *mid = &scan->priv->ids[id];
+	struct rte_regex_ops *op = scan->op;
+	struct rte_regexdev_match match;
+	uint16_t i;
+
+	if (scan->nb_groups != 0) {
+		for (i = 0; i < scan->nb_groups; i++)
+			if (scan->groups[i] == mid->group_id)
+				break;
+		if (i == scan->nb_groups)
+			return 0;
+	}
+
+	match.u64 = 0;
+	match.rule_id = mid->rule_id;
+	match.group_id = mid->group_id;
+	match.start_offset = from;
+	match.len = to - from;
+
+	op->nb_actual_matches++;
+
+	if (op->req_flags & RTE_REGEX_OPS_REQ_MATCH_HIGH_PRIORITY_F) {
+		/* keep the lowest rule, start and length */
+		if (op->nb_matches == 0 ||
+		    match.rule_id < op->matches[0].rule_id ||
+		    (match.rule_id == op->matches[0].rule_id &&
+		     (match.start_offset < op->matches[0].start_offset ||
+		      (match.start_offset == op->matches[0].start_offset &&
+		       match.len < op->matches[0].len))))
+			op->matches[0] = match;
+		op->nb_matches = 1;
+		return 0;
+	}
+
+	if (op->nb_matches == scan->priv->nb_max_matches) {
+		op->rsp_flags |= RTE_REGEX_OPS_RSP_MAX_MATCH_F;
+		return 0;
+	}
+	op->matches[op->nb_matches++] = match;
+
+	/* a non zero value terminates the scan */
+	return !!(op->req_flags & RTE_REGEX_OPS_REQ_STOP_ON_MATCH_F);
+}
+
+static void
+hs_regex_scan(const struct hs_regex_priv *priv, struct hs_regex_qp *qp,
+	      struct rte_regex_ops *op)
+{
+	const char *data[HS_REGEX_MAX_SEGS];
+	unsigned int len[HS_REGEX_MAX_SEGS];
+	struct hs_regex_scan scan;
+	struct rte_mbuf *m;
+	unsigned int nb_segs = 0;
+	hs_error_t ret;
+
+	op->rsp_flags = 0;
+	op->nb_actual_matches = 0;
+	op->nb_matches = 0;
+
+	if (unlikely(op->mbuf->pkt_len > UINT16_MAX)) {
+		op->rsp_flags |= RTE_REGEX_OPS_RSP_RESOURCE_LIMIT_REACHED_F;
+		return;
+	}
+
+	for (m = op->mbuf; m != NULL; m = m->next) {
+		if (unlikely(nb_segs == HS_REGEX_MAX_SEGS)) {
+			op->rsp_flags |= RTE_REGEX_OPS_RSP_RESOURCE_LIMIT_REACHED_F;
+			return;
+		}
+		data[nb_segs] = rte_pktmbuf_mtod(m, const char *);
+		len[nb_segs] = m->data_len;
+		nb_segs++;
+	}
+
+	scan.priv = priv;
+	scan.op = op;
+	scan.nb_groups = 0;
+	if (op->req_flags & RTE_REGEX_OPS_REQ_GROUP_ID0_VALID_F)
+		scan.groups[scan.nb_groups++] = op->group_id0;
+	if (op->req_flags & RTE_REGEX_OPS_REQ_GROUP_ID1_VALID_F)
+		scan.groups[scan.nb_groups++] = op->group_id1;
+	if (op->req_flags & RTE_REGEX_OPS_REQ_GROUP_ID2_VALID_F)
+		scan.groups[scan.nb_groups++] = op->group_id2;
+	if (op->req_flags & RTE_REGEX_OPS_REQ_GROUP_ID3_VALID_F)
+		scan.groups[scan.nb_groups++] = op->group_id3;
+
+	ret = hs_scan_vector(priv->db, data, len, nb_segs, 0, qp->scratch,
+			     hs_regex_match, &scan);
+	if (unlikely(ret != HS_SUCCESS && ret != HS_SCAN_TERMINATED))
+		op->rsp_flags |= RTE_REGEX_OPS_RSP_RESOURCE_LIMIT_REACHED_F;
+}
+
+/* The operations are scanned at enqueue, on the lcore polling the queue pair. */
+static uint16_t
+hs_regex_enqueue_burst(struct rte_regexdev *dev, uint16_t qp_id,
+		       struct rte_regex_ops **ops, uint16_t nb_ops)
+{
+	struct hs_regex_priv *priv = dev->data->dev_private;
+	struct hs_regex_qp *qp = &priv->qps[qp_id];
+	uint16_t i;
+
+	nb_ops = RTE_MIN(nb_ops, qp->mask + 1 - (qp->tail - qp->head));
+
+	for (i = 0; i < nb_ops; i++) {
+		if (i + 1 < nb_ops)
+			rte_prefetch0(rte_pktmbuf_mtod(ops[i + 1]->mbuf, void *));
+		hs_regex_scan(priv, qp, ops[i]);
+		qp->ops[qp->tail++ & qp->mask] = ops[i];
+	}
+
+	return nb_ops;
+}
+
+static uint16_t
+hs_regex_dequeue_burst(struct rte_regexdev *dev, uint16_t qp_id,
+		       struct rte_regex_ops **ops, uint16_t nb_ops)
+{
+	struct hs_regex_priv *priv = dev->data->dev_private;
+	struct hs_regex_qp *qp = &priv->qps[qp_id];
+	uint16_t i;
+
+	nb_ops = RTE_MIN(nb_ops, qp->tail - qp->head);
+
+	for (i = 0; i < nb_ops; i++)
+		ops[i] = qp->ops[qp->head++ & qp->mask];
+
+	return nb_ops;
+}
+
+/* Replace the active database, the scratch of each queue pair being grown to fit it. */
+static int
+hs_regex_db_activate(struct hs_regex_priv *priv, hs_database_t *db,
+		     struct hs_regex_match_id *ids, uint32_t nb_ids)
+{
+	uint16_t i;
+
+	for (i = 0; i < priv->nb_qps; i++) {
+		if (priv->qps[i].ops == NULL)
+			continue;
+		if (hs_alloc_scratch(db, &priv->qps[i].scratch) != HS_SUCCESS) {
+			HS_REGEX_LOG(ERR, "Could not allocate scratch of queue pair %u", i);
+			hs_free_database(db);
+			rte_free(ids);
+			return -ENOMEM;
+		}
+	}
+
+	hs_free_database(priv->db);
+	rte_free(priv->ids);
+	priv->db = db;
+	priv->ids = ids;
+	priv->nb_ids = nb_ids;
+
+	return 0;
+}
+
+static void
+hs_regex_rules_free(struct hs_regex_priv *priv)
+{
+	uint32_t i;
+
+	for (i = 0; i < priv->nb_rules; i++)
+		rte_free(priv->rules[i].pcre);
+	rte_free(priv->rules);
+	priv->rules = NULL;
+	priv->nb_rules = 0;
+	priv->rules_size = 0;
+}
+
+static void
+hs_regex_qps_free(struct hs_regex_priv *priv)
+{
+	uint16_t i;
+
+	if (priv->qps == NULL)
+		return;
+
+	for (i = 0; i < priv->nb_qps; i++) {
+		hs_free_scratch(priv->qps[i].scratch);
+		rte_free(priv->qps[i].ops);
+	}
+	rte_free(priv->qps);
+	priv->qps = NULL;
+	priv->nb_qps = 0;
+}
+
+static int
+hs_regex_rule_find(const struct hs_regex_priv *priv, uint16_t group_id, uint32_t rule_id)
+{
+	uint32_t i;
+
+	for (i = 0; i < priv->nb_rules; i++)
+		if (priv->rules[i].group_id == group_id && priv->rules[i].rule_id == rule_id)
+			return i;
+
+	return -1;
+}
+
+static int
+hs_regex_rule_db_update(struct rte_regexdev *dev,
+			const struct rte_regexdev_rule *rules, uint16_t nb_rules)
+{
+	struct hs_regex_priv *priv = dev->data->dev_private;
+	struct hs_regex_rule *rule;
+	uint32_t size;
+	uint16_t i;
+	char *pcre;
+	int idx;
+
+	for (i = 0; i < nb_rules; i++) {
+		if (rules[i].group_id >= HS_REGEX_MAX_GROUPS ||
+		    rules[i].rule_id >= HS_REGEX_MAX_RULES ||
+		    (rules[i].rule_flags & ~HS_REGEX_RULE_FLAGS) != 0)
+			break;
+
+		idx = hs_regex_rule_find(priv, rules[i].group_id, rules[i].rule_id);
+
+		if (rules[i].op == RTE_REGEX_RULE_OP_REMOVE) {
+			if (idx < 0)
+				break;
+			rte_free(priv->rules[idx].pcre);
+			priv->rules[idx] = priv->rules[--priv->nb_rules];
+			continue;
+		}
+
+		if (rules[i].pcre_rule == NULL || rules[i].pcre_rule_len == 0)
+			break;
+
+		pcre = rte_malloc("regex_hs_rule", rules[i].pcre_rule_len + 1, 0);
+		if (pcre == NULL)
+			break;
+		memcpy(pcre, rules[i].pcre_rule, rules[i].pcre_rule_len);
+		pcre[rules[i].pcre_rule_len] = '\0';
+
+		if (idx >= 0) {
+			rule = &priv->rules[idx];
+			rte_free(rule->pcre);
+		} else {
+			if (priv->nb_rules == priv->rules_size) {
+				size = RTE_MAX(2 * priv->rules_size, 64U);
+				rule = rte_realloc(priv->rules, size * sizeof(*rule), 0);
+				if (rule == NULL) {
+					rte_free(pcre);
+					break;
+				}
+				priv->rules = rule;
+				priv->rules_size = size;
+			}
+			rule = &priv->rules[priv->nb_rules++];
+		}
+
+		rule->rule_id = rules[i].rule_id;
+		rule->group_id = rules[i].group_id;
+		rule->rule_flags = rules[i].rule_flags;
+		rule->pcre = pcre;
+	}
+
+	return i;
+}
+
+static int
+hs_regex_rule_db_compile_activate(struct rte_regexdev *dev)
+{
+	struct hs_regex_priv *priv = dev->data->dev_private;
+	struct hs_regex_match_id *ids = NULL;
+	hs_compile_error_t *error = NULL;
+	unsigned int *flags = NULL;
+	unsigned int *hs_ids = NULL;
+	const char **exprs = NULL;
+	hs_database_t *db = NULL;
+	uint32_t nb = priv->nb_rules;
+	uint32_t i;
+	int ret = -ENOMEM;
+
+	if (dev->data->dev_started)
+		return -EBUSY;
+
+	if (nb == 0) {
+		HS_REGEX_LOG(ERR, "No rule to compile");
+		return -EINVAL;
+	}
+
+	exprs = rte_malloc(NULL, nb * sizeof(*exprs), 0);
+	flags = rte_malloc(NULL, nb * sizeof(*flags), 0);
+	hs_ids = rte_malloc(NULL, nb * sizeof(*hs_ids), 0);
+	ids = rte_zmalloc(NULL, nb * sizeof(*ids), 0);
+	if (exprs == NULL || flags == NULL || hs_ids == NULL || ids == NULL)
+		goto exit;
+
+	for (i = 0; i < nb; i++) {
+		exprs[i] = priv->rules[i].pcre;
+		flags[i] = hs_regex_flags(priv->rules[i].rule_flags);
+		hs_ids[i] = i;
+		ids[i].rule_id = priv->rules[i].rule_id;
+		ids[i].group_id = priv->rules[i].group_id;
+	}
+
+	if (hs_compile_multi(exprs, flags, hs_ids, nb, HS_MODE_VECTORED, NULL,
+			     &db, &error) != HS_SUCCESS) {
+		if (error->expression >= 0)
+			HS_REGEX_LOG(ERR, "Could not compile rule %u of group %u: %s",
+				     ids[error->expression].rule_id,
+				     ids[error->expression].group_id, error->message);
+		else
+			HS_REGEX_LOG(ERR, "Could not compile rules: %s", error->message);
+		hs_free_compile_error(error);
+		ret = -EINVAL;
+		goto exit;
+	}
+
+	ret = hs_regex_db_activate(priv, db, ids, nb);
+	ids = NULL;
+
+exit:
+	rte_free(ids);
+	rte_free(hs_ids);
+	rte_free(flags);
+	rte_free(exprs);
+
+	return ret;
+}
+
+static int
+hs_regex_rule_db_import_binary(struct hs_regex_priv *priv, const char *rule_db,
+			       uint32_t rule_db_len)
+{
+	struct hs_regex_match_id *ids;
+	struct hs_regex_db_hdr hdr;
+	hs_database_t *db = NULL;
+	uint64_t offset;
+
+	memcpy(&hdr, rule_db, sizeof(hdr));
+	offset = sizeof(hdr) + (uint64_t)hdr.nb_ids * sizeof(*ids);
+	if (hdr.version != HS_REGEX_DB_VERSION || hdr.nb_ids == 0 ||
+	    offset + hdr.hs_len > rule_db_len) {
+		HS_REGEX_LOG(ERR, "Invalid rule database");
+		return -EINVAL;
+	}
+
+	ids = rte_malloc(NULL, hdr.nb_ids * sizeof(*ids), 0);
+	if (ids == NULL)
+		return -ENOMEM;
+	memcpy(ids, rule_db + sizeof(hdr), hdr.nb_ids * sizeof(*ids));
+
+	if (hs_deserialize_database(rule_db + offset, hdr.hs_len, &db) != HS_SUCCESS) {
+		HS_REGEX_LOG(ERR, "Could not deserialize rule database");
+		rte_free(ids);
+		return -EINVAL;
+	}
+
+	/* the expressions of an imported database are not known */
+	hs_regex_rules_free(priv);
+
+	return hs_regex_db_activate(priv, db, ids, hdr.nb_ids);
+}
+
+/* Parse rules in the "<rule_id>:/<expression>/<flags>" format, one per line. */
+static int
+hs_regex_rule_db_import_text(struct rte_regexdev *dev, const char *rule_db,
+			     uint32_t rule_db_len)
+{
+	struct hs_regex_priv *priv = dev->data->dev_private;
+	struct rte_regexdev_rule *rules;
+	const char *line, *end, *eol, *pcre;
+	uint32_t pos, nb_rules = 1;
+	uint32_t nb_lines = 0;
+	uint32_t rule_id;
+	uint64_t flags;
+	int ret;
+
+	for (pos = 0; pos < rule_db_len; pos++)
+		if (rule_db[pos] == '\n')
+			nb_rules++;
+
+	rules = rte_zmalloc(NULL, nb_rules * sizeof(*rules), 0);
+	if (rules == NULL)
+		return -ENOMEM;
+
+	nb_rules = 0;
+	pos = 0;
+	while (pos < rule_db_len) {
+		line = rule_db + pos;
+		end = memchr(line, '\n', rule_db_len - pos);
+		if (end == NULL)
+			end = rule_db + rule_db_len;
+		pos = end - rule_db + 1;
+		nb_lines++;
+
+		while (line < end && (*line == ' ' || *line == '\t'))
+			line++;
+		while (end > line && (end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t'))
+			end--;
+		if (line == end || *line == '#')
+			continue;
+		eol = end;
+
+		for (rule_id = 0; line < end && *line >= '0' && *line <= '9'; line++)
+			rule_id = rule_id * 10 + *line - '0';
+		if (end - line < 3 || line[0] != ':' || line[1] != '/')
+			goto error;
+		pcre = line + 2;
+
+		/* the flags follow the last slash */
+		while (end > pcre && end[-1] != '/')
+			end--;
+		if (end == pcre)
+			goto error;
+
+		for (flags = 0, line = end; line < eol; line++) {
+			switch (*line) {
+			case 'i':
+				flags |= RTE_REGEX_PCRE_RULE_CASELESS_F;
+				break;
+			case 's':
+				flags |= RTE_REGEX_PCRE_RULE_DOTALL_F;
+				break;
+			case 'm':
+				flags |= RTE_REGEX_PCRE_RULE_MULTILINE_F;
+				break;
+			case 'V':
+				flags |= RTE_REGEX_PCRE_RULE_ALLOW_EMPTY_F;
+				break;
+			case '8':
+				flags |= RTE_REGEX_PCRE_RULE_UTF_F;
+				break;
+			case 'W':
+				flags |= RTE_REGEX_PCRE_RULE_UCP_F;
+				break;
+			default:
+				goto error;
+			}
+		}
+
+		rules[nb_rules].op = RTE_REGEX_RULE_OP_ADD;
+		rules[nb_rules].group_id = 0;
+		rules[nb_rules].rule_id = rule_id;
+		rules[nb_rules].pcre_rule = pcre;
+		rules[nb_rules].pcre_rule_len = end - 1 - pcre;
+		rules[nb_rules].rule_flags = flags;
+		nb_rules++;
+	}
+
+	hs_regex_rules_free(priv);
+	ret = -EINVAL;
+	if (nb_rules > UINT16_MAX ||
+	    hs_regex_rule_db_update(dev, rules, nb_rules) != (int)nb_rules)
+		goto exit;
+
+	ret = hs_regex_rule_db_compile_activate(dev);
+
+exit:
+	rte_free(rules);
+	return ret;
+
+error:
+	HS_REGEX_LOG(ERR, "Invalid rule at line %u", nb_lines);
+	rte_free(rules);
+	return -EINVAL;
+}
+
+static int
+hs_regex_rule_db_import(struct rte_regexdev *dev, const char *rule_db,
+			uint32_t rule_db_len)
+{
+	struct hs_regex_priv *priv = dev->data->dev_private;
+
+	if (dev->data->dev_started)
+		return -EBUSY;
+
+	if (rule_db_len >= sizeof(struct hs_regex_db_hdr) &&
+	    memcmp(rule_db, HS_REGEX_DB_MAGIC, sizeof(HS_REGEX_DB_MAGIC)) == 0)
+		return hs_regex_rule_db_import_binary(priv, rule_db, rule_db_len);
+
+	return hs_regex_rule_db_import_text(dev, rule_db, rule_db_len);
+}
+
+static int
+hs_regex_rule_db_export(struct rte_regexdev *dev, char *rule_db)
+{
+	struct hs_regex_priv *priv = dev->data->dev_private;
+	struct hs_regex_db_hdr hdr;
+	char *bytes = NULL;
+	size_t len, size;
+
+	if (priv->db == NULL)
+		return -ENOENT;
+
+	if (hs_serialize_database(priv->db, &bytes, &len) != HS_SUCCESS)
+		return -ENOMEM;
+
+	size = sizeof(hdr) + priv->nb_ids * sizeof(*priv->ids) + len;
+	if (rule_db == NULL) {
+		free(bytes);
+		return size;
+	}
+
+	memset(&hdr, 0, sizeof(hdr));
+	memcpy(hdr.magic, HS_REGEX_DB_MAGIC, sizeof(HS_REGEX_DB_MAGIC));
+	hdr.version = HS_REGEX_DB_VERSION;
+	hdr.nb_ids = priv->nb_ids;
+	hdr.hs_len = len;
+
+	memcpy(rule_db, &hdr, sizeof(hdr));
+	rule_db += sizeof(hdr);
+	memcpy(rule_db, priv->ids, priv->nb_ids * sizeof(*priv->ids));
+	rule_db += priv->nb_ids * sizeof(*priv->ids);
+	memcpy(rule_db, bytes, len);
+	free(bytes);
+
+	return 0;
+}
+
+static int
+hs_regex_dev_info_get(struct rte_regexdev *dev, struct rte_regexdev_info *info)
+{
+	info->driver_name = dev->device->driver->name;
+	info->dev = dev->device;
+	info->max_matches = HS_REGEX_MAX_MATCHES;
+	info->max_queue_pairs = HS_REGEX_MAX_QPS;
+	info->max_payload_size = UINT16_MAX;
+	info->max_segs = HS_REGEX_MAX_SEGS;
+	info->max_rules_per_group = HS_REGEX_MAX_RULES;
+	info->max_groups = HS_REGEX_MAX_GROUPS;
+	info->regexdev_capa = RTE_REGEXDEV_CAPA_RUNTIME_COMPILATION_F |
+			      RTE_REGEXDEV_CAPA_SUPP_PCRE_START_ANCHOR_F |
+			      RTE_REGEXDEV_SUPP_PCRE_UTF_8_F |
+			      RTE_REGEXDEV_SUPP_PCRE_WORD_BOUNDARY_F |
+			      RTE_REGEXDEV_SUPP_MATCH_ALL_F;
+	info->rule_flags = HS_REGEX_RULE_FLAGS;
+
+	return 0;
+}
+
+static int
+hs_regex_dev_configure(struct rte_regexdev *dev, const struct rte_regexdev_config *cfg)
+{
+	struct hs_regex_priv *priv = dev->data->dev_private;
+
+	if (cfg->nb_queue_pairs == 0 || cfg->nb_queue_pairs > HS_REGEX_MAX_QPS) {
+		HS_REGEX_LOG(ERR, "Invalid number of queue pairs %u", cfg->nb_queue_pairs);
+		return -EINVAL;
+	}
+
+	if (cfg->nb_max_matches > HS_REGEX_MAX_MATCHES) {
+		HS_REGEX_LOG(ERR, "Invalid number of max matches %u", cfg->nb_max_matches);
+		return -EINVAL;
+	}
+
+	if (cfg->dev_cfg_flags != 0) {
+		HS_REGEX_LOG(ERR, "Invalid device configuration flags 0x%x",
+			     cfg->dev_cfg_flags);
+		return -EINVAL;
+	}
+
+	hs_regex_qps_free(priv);
+	priv->qps = rte_zmalloc("regex_hs_qps", cfg->nb_queue_pairs * sizeof(*priv->qps),
+				RTE_CACHE_LINE_SIZE);
+	if (priv->qps == NULL)
+		return -ENOMEM;
+	priv->nb_qps = cfg->nb_queue_pairs;
+	priv->nb_max_matches = cfg->nb_max_matches != 0 ?
+			       cfg->nb_max_matches : HS_REGEX_MAX_MATCHES;
+
+	dev->enqueue = hs_regex_enqueue_burst;
+	dev->dequeue = hs_regex_dequeue_burst;
+
+	if (cfg->rule_db != NULL && cfg->rule_db_len != 0)
+		return hs_regex_rule_db_import(dev, cfg->rule_db, cfg->rule_db_len);
+
+	return 0;
+}
+
+static int
+hs_regex_queue_pair_setup(struct rte_regexdev *dev, uint16_t qp_id,
+			  const struct rte_regexdev_qp_conf *qp_conf)
+{
+	struct hs_regex_priv *priv = dev->data->dev_private;
+	struct hs_regex_qp *qp;
+	uint32_t size;
+
+	if (qp_id >= priv->nb_qps || qp_conf->nb_desc == 0)
+		return -EINVAL;
+
+	if (qp_conf->qp_conf_flags & ~RTE_REGEX_QUEUE_PAIR_CFG_OOS_F) {
+		HS_REGEX_LOG(ERR, "Invalid queue pair configuration flags 0x%x",
+			     qp_conf->qp_conf_flags);
+		return -EINVAL;
+	}
+
+	qp = &priv->qps[qp_id];
+	rte_free(qp->ops);
+
+	size = rte_align32pow2(qp_conf->nb_desc);
+	qp->ops = rte_zmalloc("regex_hs_qp_ops", size * sizeof(*qp->ops), RTE_CACHE_LINE_SIZE);
+	if (qp->ops == NULL)
+		return -ENOMEM;
+	qp->mask = size - 1;
+	qp->head = 0;
+	qp->tail = 0;
+
+	if (priv->db != NULL && hs_alloc_scratch(priv->db, &qp->scratch) != HS_SUCCESS)
+		return -ENOMEM;
+
+	return 0;
+}
+
+static int
+hs_regex_dev_start(struct rte_regexdev *dev)
+{
+	struct hs_regex_priv *priv = dev->data->dev_private;
+
+	if (priv->db == NULL) {
+		HS_REGEX_LOG(ERR, "Rule db not programmed");
+		return -EFAULT;
+	}
+
+	return 0;
+}
+
+static int
+hs_regex_dev_stop(struct rte_regexdev *dev __rte_unused)
+{
+	return 0;
+}
+
+static int
+hs_regex_dev_close(struct rte_regexdev *dev)
+{
+	struct hs_regex_priv *priv = dev->data->dev_private;
+
+	hs_regex_qps_free(priv);
+	hs_regex_rules_free(priv);
+	hs_free_database(priv->db);
+	priv->db = NULL;
+	rte_free(priv->ids);
+	priv->ids = NULL;
+	priv->nb_ids = 0;
+
+	return 0;
+}
+
+static const struct rte_regexdev_ops hs_regex_ops = {
+	.dev_info_get = hs_regex_dev_info_get,
+	.dev_configure = hs_regex_dev_configure,
+	.dev_qp_setup = hs_regex_queue_pair_setup,
+	.dev_start = hs_regex_dev_start,
+	.dev_stop = hs_regex_dev_stop,
+	.dev_close = hs_regex_dev_close,
+	.dev_rule_db_update = hs_regex_rule_db_update,
+	.dev_rule_db_compile_activate = hs_regex_rule_db_compile_activate,
+	.dev_db_import = hs_regex_rule_db_import,
+	.dev_db_export = hs_regex_rule_db_export,
+};
+
+static int
+hs_regex_probe(struct rte_vdev_device *vdev)
+{
+	struct rte_regexdev *dev;
+	const char *name;
+
+	name = rte_vdev_device_name(vdev);
+	if (name == NULL)
+		return -EINVAL;
+
+	if (hs_valid_platform() != HS_SUCCESS) {
+		HS_REGEX_LOG(ERR, "CPU not supported by Hyperscan");
+		return -ENOTSUP;
+	}
+
+	dev = rte_regexdev_register(name);
+	if (dev == NULL) {
+		HS_REGEX_LOG(ERR, "Failed to allocate regex device for %s", name);
+		return -ENODEV;
+	}
+
+	dev->data->dev_private = rte_zmalloc_socket("regex_hs_priv",
+			sizeof(struct hs_regex_priv), RTE_CACHE_LINE_SIZE, rte_socket_id());
+	if (dev->data->dev_private == NULL) {
+		rte_regexdev_unregister(dev);
+		return -ENOMEM;
+	}
+
+	dev->dev_ops = &hs_regex_ops;
+	dev->device = &vdev->device;
+	dev->state = RTE_REGEXDEV_READY;
+
+	HS_REGEX_LOG(INFO, "Hyperscan version %s", hs_version());
+
+	return 0;
+}
+
+static int
+hs_regex_remove(struct rte_vdev_device *vdev)
+{
+	struct rte_regexdev *dev;
+	const char *name;
+
+	name = rte_vdev_device_name(vdev);
+	if (name == NULL)
+		return -EINVAL;
+
+	dev = rte_regexdev_get_device_by_name(name);
+	if (dev == NULL)
+		return -ENODEV;
+
+	hs_regex_dev_close(dev);
+	rte_free(dev->data->dev_private);
+	dev->data->dev_private = NULL;
+	rte_regexdev_unregister(dev);
+
+	return 0;
+}
+
+static struct rte_vdev_driver hs_regex_pmd_drv = {
+	.probe = hs_regex_probe,
+	.remove = hs_regex_remove,
+};
+
+RTE_PMD_REGISTER_VDEV(REGEXDEV_NAME_HS_PMD, hs_regex_pmd_drv);
+RTE_LOG_REGISTER_DEFAULT(hs_regex_logtype, INFO);
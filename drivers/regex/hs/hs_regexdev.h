@@ -0,0 +1,72 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _HS_REGEXDEV_H_
+#define _HS_REGEXDEV_H_
+
+#include <hs.h>
+
+#include <rte_common.h>
+#include <rte_log.h>
+#include <rte_regexdev.h>
+
+/* Software regex PMD device name */
+#define REGEXDEV_NAME_HS_PMD	regex_hs
+
+extern int hs_regex_logtype;
+#define RTE_LOGTYPE_HS_REGEX hs_regex_logtype
+#define HS_REGEX_LOG(level, ...) \
+	RTE_LOG_LINE_PREFIX(level, HS_REGEX, "%s(): ", __func__, __VA_ARGS__)
+
+#define HS_REGEX_MAX_QPS	RTE_MAX_LCORE
+#define HS_REGEX_MAX_MATCHES	255
+#define HS_REGEX_MAX_SEGS	64
+/* limited by the width of struct rte_regexdev_match fields */
+#define HS_REGEX_MAX_RULES	(1 << 20)
+#define HS_REGEX_MAX_GROUPS	(1 << 12)
+
+/** Rule of the database, as added by rte_regexdev_rule_db_update() */
+struct hs_regex_rule {
+	uint32_t rule_id;
+	uint16_t group_id;
+	uint64_t rule_flags;
+	char *pcre;
+	/**< NUL terminated expression */
+};
+
+/** Rule reported for each expression identifier of the compiled database */
+struct hs_regex_match_id {
+	uint32_t rule_id;
+	uint16_t group_id;
+	uint16_t reserved;
+};
+
+/** Queue pair, holding the processed operations up to their dequeue */
+struct __rte_cache_aligned hs_regex_qp {
+	hs_scratch_t *scratch;
+	/**< Scan scratch space, private to the lcore polling the queue pair */
+	struct rte_regex_ops **ops;
+	/**< Processed operations */
+	uint32_t mask;
+	uint32_t head;
+	uint32_t tail;
+};
+
+/** Device private data */
+struct __rte_cache_aligned hs_regex_priv {
+	hs_database_t *db;
+	/**< Active database */
+	struct hs_regex_match_id *ids;
+	/**< Rule of each expression of the active database */
+	uint32_t nb_ids;
+	struct hs_regex_rule *rules;
+	/**< Rules to be compiled */
+	uint32_t nb_rules;
+	uint32_t rules_size;
+	struct hs_regex_qp *qps;
+	uint16_t nb_qps;
+	uint16_t nb_max_matches;
+};
+
+#endif /* _HS_REGEXDEV_H_ */
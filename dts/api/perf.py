@@ -0,0 +1,221 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright(c) 2026 Intel Corporation
+
+"""Performance results store and regression detection.
+
+The performance test suites report their measurements with :func:`record_performance`.
+The measurements are written in the suite's output directory and, if :option:`--perf-results-store`
+is set, appended to a JSON results store kept across test runs, keyed by test suite,
+measurement name and tested DPDK commit.
+
+Each measurement is compared to a baseline, the median of the same measurement
+in the last commits found in the results store. A regression is reported when the throughput
+drops, or the latency rises, by more than the given threshold relative to the baseline.
+
+Example:
+    .. code:: python
+
+        from api.perf import PerfMeasurement, record_performance
+        from api.test import verify
+
+        measurements = [PerfMeasurement("io/64B", mpps=14.2)]
+        regressions = record_performance("forward_perf", measurements, threshold=0.05)
+        verify(not regressions, "\\n".join(str(r) for r in regressions))
+"""
+
+import json
+from dataclasses import asdict, dataclass
+from datetime import datetime
+from pathlib import Path
+from statistics import median
+
+from api.test import get_logger, write_performance_json
+from framework.context import get_ctx
+from framework.settings import SETTINGS
+
+
+@dataclass(slots=True)
+class PerfMeasurement:
+    """A performance measurement of a test case with a given set of parameters.
+
+    Attributes:
+        name: The name of the measurement, unique in the test suite,
+            e.g. the forwarding mode and frame size ``io/64B``.
+        mpps: The measured throughput in millions of packets or operations per second.
+        latency_us: The measured average latency in microseconds.
+    """
+
+    name: str
+    mpps: float | None = None
+    latency_us: float | None = None
+
+
+@dataclass(slots=True)
+class PerfRegression:
+    """A measurement worse than its baseline by more than the threshold.
+
+    Attributes:
+        name: The name of the measurement.
+        metric: The regressed metric, ``mpps`` or ``latency_us``.
+        measured: The measured value.
+        baseline: The baseline value.
+    """
+
+    name: str
+    metric: str
+    measured: float
+    baseline: float
+
+    def __str__(self) -> str:
+        """A human-readable description of the regression."""
+        delta = (self.measured - self.baseline) / self.baseline * 100
+        return (
+            f"{self.name}: {self.metric} = {self.measured:.3f}, "
+            f"baseline = {self.baseline:.3f} ({delta:+.1f}%)"
+        )
+
+
+#: Metrics whose higher values are better.
+_HIGHER_IS_BETTER = {"mpps": True, "latency_us": False}
+
+
+class PerfResultsStore:
+    """The JSON store of the performance results of the tested commits.
+
+    The store maps each test suite to its measurements, each being a list of results
+    in the order they were recorded::
+
+        {"suite": {"name": [{"commit": "...", "timestamp": "...", "mpps": 1.0}, ...]}}
+
+    Attributes:
+        path: The path of the JSON file.
+        history: The number of last commits used to compute a baseline.
+    """
+
+    path: Path
+    history: int
+    _results: dict[str, dict[str, list[dict]]]
+
+    def __init__(self, path: Path, history: int) -> None:
+        """Load the results store, or start an empty one if the file does not exist.
+
+        Args:
+            path: The path of the JSON file.
+            history: The number of last commits used to compute a baseline.
+        """
+        self.path = path
+        self.history = history
+        self._results = {}
+        if path.exists():
+            with path.open("r") as f:
+                self._results = json.load(f)
+
+    def baseline(self, suite: str, name: str, metric: str, commit: str) -> float | None:
+        """Compute the baseline of a metric from the results of the other commits.
+
+        Args:
+            suite: The name of the test suite.
+            name: The name of the measurement.
+            metric: The name of the metric.
+            commit: The tested commit, excluded from the baseline.
+
+        Returns:
+            The median of the last results, or :data:`None` if there is no result.
+        """
+        results = self._results.get(suite, {}).get(name, [])
+        values = [r[metric] for r in results if r["commit"] != commit and r.get(metric)]
+        if not values:
+            return None
+        return median(values[-self.history :])
+
+    def add(self, suite: str, commit: str, measurement: PerfMeasurement) -> None:
+        """Add a measurement, replacing the previous result of the same commit.
+
+        Args:
+            suite: The name of the test suite.
+            commit: The tested commit.
+            measurement: The measurement to add.
+        """
+        results = self._results.setdefault(suite, {}).setdefault(measurement.name, [])
+        results[:] = [r for r in results if r["commit"] != commit]
+        result = {"commit": commit, "timestamp": datetime.now().isoformat()}
+        result.update({k: v for k, v in asdict(measurement).items() if k != "name"})
+        results.append(result)
+
+    def save(self) -> None:
+        """Write the results store."""
+        self.path.parent.mkdir(parents=True, exist_ok=True)
+        with self.path.open("w") as f:
+            json.dump(self._results, f, indent=2)
+
+
+def _tested_commit() -> str:
+    """The identifier of the tested DPDK commit, from the settings or the DPDK version."""
+    if SETTINGS.perf_commit:
+        return SETTINGS.perf_commit
+    return get_ctx().dpdk_build.dpdk_version or "unknown"
+
+
+def record_performance(
+    suite: str,
+    measurements: list[PerfMeasurement],
+    threshold: float,
+    history: int = 5,
+) -> list[PerfRegression]:
+    """Record the measurements of a test suite and find the regressions.
+
+    The measurements are written to the ``<suite>_performance.json`` file in the suite's output
+    directory. If a results store is configured, they are compared to their baseline,
+    then stored for the tested commit.
+
+    Args:
+        suite: The name of the test suite.
+        measurements: The measurements of the test suite.
+        threshold: The relative degradation from the baseline reported as a regression,
+            e.g. 0.05 for 5%.
+        history: The number of last commits used to compute a baseline.
+
+    Returns:
+        The regressions, empty if no results store is configured.
+    """
+    commit = _tested_commit()
+    regressions = []
+    baselines: dict[str, dict[str, float | None]] = {}
+
+    if SETTINGS.perf_results_store is not None:
+        store = PerfResultsStore(SETTINGS.perf_results_store, history)
+        for measurement in measurements:
+            baselines[measurement.name] = {}
+            for metric, higher_is_better in _HIGHER_IS_BETTER.items():
+                value = getattr(measurement, metric)
+                baseline = store.baseline(suite, measurement.name, metric, commit)
+                baselines[measurement.name][metric] = baseline
+                if value is None or baseline is None:
+                    continue
+                if higher_is_better:
+                    regressed = value < baseline * (1 - threshold)
+                else:
+                    regressed = value > baseline * (1 + threshold)
+                if regressed:
+                    regressions.append(PerfRegression(measurement.name, metric, value, baseline))
+            store.add(suite, commit, measurement)
+        store.save()
+    else:
+        get_logger().info("No performance results store, the results are not compared.")
+
+    write_performance_json(
+        {
+            "commit": commit,
+            "threshold": threshold,
+            "results": [
+                {**asdict(m), "baseline": baselines.get(m.name)} for m in measurements
+            ],
+            "regressions": [str(r) for r in regressions],
+        },
+        f"{suite}_performance.json",
+    )
+
+    for regression in regressions:
+        get_logger().warning(f"Performance regression: {regression}")
+
+    return regressions
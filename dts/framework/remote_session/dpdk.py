@@ -267,10 +267,13 @@ def _build_dpdk(self) -> None:
             and ctx.topology.sut_port_ingress.config.os_driver == "ice"
         ):
             meson_args = MesonArgs(
-                default_library="static", libdir="lib", c_args="-DRTE_NET_INTEL_USE_16BYTE_DESC"
+                default_library="static",
+                libdir="lib",
+                examples="l3fwd",
+                c_args="-DRTE_NET_INTEL_USE_16BYTE_DESC",
             )
         else:
-            meson_args = MesonArgs(default_library="static", libdir="lib")
+            meson_args = MesonArgs(default_library="static", libdir="lib", examples="l3fwd")
 
         self._session.build_dpdk(
             self._env_vars,
@@ -283,6 +286,12 @@ def get_app(self, app_name: str) -> PurePath:
         """Retrieve path for a DPDK app."""
         return self._session.join_remote_path(self.remote_dpdk_build_dir, "app", f"dpdk-{app_name}")
 
+    def get_example(self, example_name: str) -> PurePath:
+        """Retrieve path for a DPDK example app."""
+        return self._session.join_remote_path(
+            self.remote_dpdk_build_dir, "examples", f"dpdk-{example_name}"
+        )
+
     @cached_property
     def remote_dpdk_tree_path(self) -> PurePath:
         """The remote DPDK tree path."""
@@ -90,6 +90,18 @@
     The seed to use with the pseudo-random generator. If not specified, the configuration value is
     used instead. If that's also not specified, a random seed is generated.
 
+.. option:: --perf-results-store
+.. envvar:: DTS_PERF_RESULTS_STORE
+
+    The path to the JSON file storing the performance results of the tested commits,
+    used to detect performance regressions. If not specified, the results are not compared.
+
+.. option:: --perf-commit
+.. envvar:: DTS_PERF_COMMIT
+
+    The identifier of the tested commit in the performance results store.
+    If not specified, the DPDK version is used instead.
+
 The module provides one key module-level variable:
 
 Attributes:
@@ -159,6 +171,10 @@ class Settings:
     re_run: int = 0
     #:
     random_seed: int | None = None
+    #:
+    perf_results_store: Path | None = None
+    #:
+    perf_commit: str | None = None
 
 
 SETTINGS: Settings = Settings()
@@ -489,6 +505,23 @@ def _get_parser() -> _DTSArgumentParser:
     )
     _add_env_var_to_action(action)
 
+    action = parser.add_argument(
+        "--perf-results-store",
+        type=Path,
+        help="The JSON file storing the performance results of the tested commits, "
+        "used to detect performance regressions. If not specified, the results are not compared.",
+        metavar="FILE_PATH",
+    )
+    _add_env_var_to_action(action)
+
+    action = parser.add_argument(
+        "--perf-commit",
+        help="The identifier of the tested commit in the performance results store. "
+        "If not specified, the DPDK version is used instead.",
+        metavar="COMMIT",
+    )
+    _add_env_var_to_action(action)
+
     return parser
 
 
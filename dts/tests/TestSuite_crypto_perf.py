@@ -0,0 +1,135 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright(c) 2026 Intel Corporation
+
+"""Cryptodev performance regression test suite.
+
+This suite runs the dpdk-test-crypto-perf application on a virtual crypto device,
+measuring the throughput and the latency of the configured cipher at the standard buffer sizes.
+Each measurement is recorded in the performance results store and compared to the baseline
+of the previous commits, the test failing on a regression beyond the configured threshold.
+"""
+
+import re
+
+from api.perf import PerfMeasurement, record_performance
+from api.test import log, verify
+from framework.params.eal import EalParams
+from framework.remote_session.dpdk_shell import compute_eal_params
+from framework.test_suite import BaseConfig, TestSuite, perf_test
+from framework.testbed_model.virtual_device import VirtualDevice
+
+
+class Config(BaseConfig):
+    """Performance test parameters."""
+
+    #: The virtual crypto device driver.
+    crypto_device: str = "crypto_aesni_mb"
+    #: The cipher parameters of dpdk-test-crypto-perf.
+    cipher_params: str = (
+        "--optype cipher-only --cipher-algo aes-cbc --cipher-op encrypt "
+        "--cipher-key-sz 16 --cipher-iv-sz 16"
+    )
+    #: The buffer sizes to measure, in bytes.
+    buffer_sizes: list[int] = [64, 128, 256, 512, 1024, 1518]
+    #: The burst size of the operations.
+    burst_size: int = 32
+    #: The number of operations of each throughput measurement.
+    throughput_ops: int = 10_000_000
+    #: The number of operations of each latency measurement.
+    latency_ops: int = 100_000
+    #: The relative throughput drop or latency rise from the baseline reported as a regression.
+    regression_threshold: float = 0.05
+    #: The number of last commits used to compute the baseline.
+    baseline_history: int = 5
+
+
+class TestCryptoPerf(TestSuite):
+    """Cryptodev performance regression test suite."""
+
+    config: Config
+
+    #: A throughput result line with ``--csv-friendly``:
+    #: lcore,buffer size,burst size,enqueued,dequeued,failed enq,failed deq,MOps,Gbps,cycles/buf
+    THROUGHPUT_PATTERN = re.compile(r"^\d+,(\d+),\d+,\d+,\d+,\d+,\d+,([\d.]+),[\d.]+,[\d.]+$", re.M)
+    #: The latency result line: total, average, maximum and minimum time in microseconds.
+    LATENCY_PATTERN = re.compile(r"#\s*time \[us\]\s+[\d.]+\s+([\d.]+)")
+
+    def _run(self, ptest: str, buffer_sizes: str, total_ops: int, extra: str = "") -> str:
+        """Run a dpdk-test-crypto-perf test.
+
+        Args:
+            ptest: The type of test.
+            buffer_sizes: The comma-separated buffer sizes.
+            total_ops: The number of operations per buffer size.
+            extra: Extra parameters of the test.
+
+        Returns:
+            The standard output of the application.
+        """
+        eal_params = compute_eal_params(
+            EalParams(
+                no_pci=True,
+                allowed_ports=[],
+                vdevs=[VirtualDevice(self.config.crypto_device)],
+            )
+        )
+        eal_params.append_str(
+            f" --ptest {ptest} --devtype {self.config.crypto_device} "
+            f"{self.config.cipher_params} --buffer-sz {buffer_sizes} "
+            f"--burst-sz {self.config.burst_size} --total-ops {total_ops} {extra}"
+        )
+        result = self._ctx.dpdk.run_dpdk_app(
+            self._ctx.dpdk_build.get_app("test-crypto-perf"), eal_params, timeout=600
+        )
+        return result.stdout
+
+    @perf_test
+    def crypto_perf(self) -> None:
+        """Verify the cryptodev throughput and latency against the baseline.
+
+        Steps:
+            * Run the throughput test of dpdk-test-crypto-perf at all the buffer sizes.
+            * Run the latency test of dpdk-test-crypto-perf at each buffer size.
+            * Record the MOps and average latency in the performance results store.
+
+        Verify:
+            * The MOps did not drop, and the latency did not rise,
+              by more than the threshold from the baseline.
+        """
+        buffer_sizes = ",".join(str(size) for size in self.config.buffer_sizes)
+        output = self._run(
+            "throughput", buffer_sizes, self.config.throughput_ops, "--csv-friendly --silent"
+        )
+        mops: dict[int, float] = {}
+        for size, value in self.THROUGHPUT_PATTERN.findall(output):
+            # Sum the results of all the worker lcores.
+            mops[int(size)] = mops.get(int(size), 0.0) + float(value)
+        verify(
+            all(size in mops for size in self.config.buffer_sizes),
+            f"Missing throughput results in dpdk-test-crypto-perf output:\n{output}",
+        )
+
+        measurements = []
+        for size in self.config.buffer_sizes:
+            output = self._run("latency", str(size), self.config.latency_ops)
+            latencies = [float(value) for value in self.LATENCY_PATTERN.findall(output)]
+            verify(
+                len(latencies) > 0,
+                f"Missing latency results in dpdk-test-crypto-perf output:\n{output}",
+            )
+            latency_us = sum(latencies) / len(latencies)
+            log(f"{size}B buffers: {mops[size]:.3f} MOps, {latency_us:.3f} us")
+            measurements.append(
+                PerfMeasurement(f"{size}B", mpps=mops[size], latency_us=latency_us)
+            )
+
+        regressions = record_performance(
+            "crypto_perf",
+            measurements,
+            self.config.regression_threshold,
+            self.config.baseline_history,
+        )
+        verify(
+            not regressions,
+            "Cryptodev performance regressions:\n" + "\n".join(str(r) for r in regressions),
+        )
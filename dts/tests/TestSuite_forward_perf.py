@@ -0,0 +1,104 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright(c) 2026 Intel Corporation
+
+"""Forwarding performance regression test suite.
+
+This suite measures the packets forwarded by TestPMD in the io and mac forwarding modes,
+at the standard frame sizes, with a performance traffic generator sending at line rate
+to two paired TestPMD interfaces. Each measurement is recorded in the performance results store
+and compared to the baseline of the previous commits, the test failing on a regression
+beyond the configured threshold.
+"""
+
+from scapy.layers.inet import IP, UDP
+from scapy.layers.l2 import Ether
+from scapy.packet import Raw
+
+from api.capabilities import (
+    LinkTopology,
+    requires_link_topology,
+)
+from api.packet import assess_performance_by_packet
+from api.perf import PerfMeasurement, record_performance
+from api.test import log, verify
+from api.testpmd import TestPmd
+from api.testpmd.config import SimpleForwardingModes
+from framework.test_suite import BaseConfig, TestSuite, perf_test
+
+
+class Config(BaseConfig):
+    """Performance test parameters."""
+
+    #: The frame sizes to measure, in bytes.
+    frame_sizes: list[int] = [64, 128, 256, 512, 1024, 1518]
+    #: The TestPMD forwarding modes to measure.
+    forward_modes: list[str] = ["io", "mac"]
+    #: The number of TestPMD forwarding cores.
+    nb_cores: int = 1
+    #: The traffic duration of each measurement, in seconds.
+    duration: float = 30
+    #: The relative throughput drop from the baseline reported as a regression.
+    regression_threshold: float = 0.05
+    #: The number of last commits used to compute the baseline.
+    baseline_history: int = 5
+
+
+@requires_link_topology(LinkTopology.TWO_LINKS)
+class TestForwardPerf(TestSuite):
+    """Forwarding performance regression test suite."""
+
+    config: Config
+
+    def _measure(self, frame_size: int) -> float:
+        """Send traffic of a given frame size and measure the forwarded throughput.
+
+        Args:
+            frame_size: The size of the frame to transmit.
+
+        Returns:
+            The MPPS (millions of packets per second) forwarded by the SUT.
+        """
+        # Account for the 14B, 20B and 8B Ether, IP and UDP headers
+        packet = (
+            Ether(src="52:00:00:00:00:00")
+            / IP(src="198.18.0.1", dst="198.18.1.1")
+            / UDP(sport=9, dport=9)
+            / Raw(load="x" * (frame_size - 14 - 20 - 8))
+        )
+        stats = assess_performance_by_packet(packet=packet, duration=self.config.duration)
+        return stats.rx_pps / 1_000_000
+
+    @perf_test
+    def forward_perf(self) -> None:
+        """Verify the TestPMD forwarding throughput against the baseline.
+
+        Steps:
+            * Start TestPMD in each configured forwarding mode.
+            * Transmit from the traffic generator at line rate each configured frame size.
+            * Record the forwarded MPPS in the performance results store.
+
+        Verify:
+            * The forwarded MPPS did not drop by more than the threshold from the baseline.
+        """
+        measurements = []
+
+        for mode in self.config.forward_modes:
+            with TestPmd(
+                forward_mode=SimpleForwardingModes(mode), nb_cores=self.config.nb_cores
+            ) as testpmd:
+                testpmd.start()
+                for frame_size in self.config.frame_sizes:
+                    mpps = self._measure(frame_size)
+                    log(f"{mode} forwarding of {frame_size}B frames: {mpps:.3f} Mpps")
+                    measurements.append(PerfMeasurement(f"{mode}/{frame_size}B", mpps=mpps))
+
+        regressions = record_performance(
+            "forward_perf",
+            measurements,
+            self.config.regression_threshold,
+            self.config.baseline_history,
+        )
+        verify(
+            not regressions,
+            "Forwarding performance regressions:\n" + "\n".join(str(r) for r in regressions),
+        )
@@ -0,0 +1,139 @@
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright(c) 2026 Intel Corporation
+
+"""L3 forwarding performance regression test suite.
+
+This suite measures the packets forwarded by the l3fwd example application
+with its LPM, FIB and exact match lookup methods, at the standard frame sizes,
+with a performance traffic generator sending at line rate to two SUT ports.
+The packets match the default routes and flows of l3fwd, forwarding them to the second port.
+Each measurement is recorded in the performance results store and compared to the baseline
+of the previous commits, the test failing on a regression beyond the configured threshold.
+"""
+
+from scapy.layers.inet import IP, UDP
+from scapy.layers.l2 import Ether
+from scapy.packet import Raw
+
+from api.capabilities import (
+    LinkTopology,
+    requires_link_topology,
+)
+from api.packet import assess_performance_by_packet
+from api.perf import PerfMeasurement, record_performance
+from api.test import log, verify, verify_else_skip
+from framework.remote_session.blocking_app import BlockingApp
+from framework.remote_session.dpdk_shell import compute_eal_params
+from framework.test_suite import BaseConfig, TestSuite, perf_test
+
+
+class Config(BaseConfig):
+    """Performance test parameters."""
+
+    #: The frame sizes to measure, in bytes.
+    frame_sizes: list[int] = [64, 128, 256, 512, 1024, 1518]
+    #: The l3fwd lookup methods to measure.
+    lookups: list[str] = ["lpm", "fib", "em"]
+    #: The traffic duration of each measurement, in seconds.
+    duration: float = 30
+    #: The relative throughput drop from the baseline reported as a regression.
+    regression_threshold: float = 0.05
+    #: The number of last commits used to compute the baseline.
+    baseline_history: int = 5
+
+
+@requires_link_topology(LinkTopology.TWO_LINKS)
+class TestL3fwdPerf(TestSuite):
+    """L3 forwarding performance regression test suite."""
+
+    config: Config
+
+    def set_up_suite(self) -> None:
+        """Set up the test suite.
+
+        Setup:
+            Find the l3fwd example application, built with DPDK.
+        """
+        self.l3fwd_path = self._ctx.dpdk_build.get_example("l3fwd")
+        verify_else_skip(
+            self._ctx.sut_node.main_session.remote_path_exists(self.l3fwd_path),
+            "The l3fwd example application is not built.",
+        )
+
+    def _start_l3fwd(self, lookup: str) -> BlockingApp:
+        """Start l3fwd with a given lookup method, polling both ports with one lcore.
+
+        Args:
+            lookup: The lookup method.
+
+        Returns:
+            The running l3fwd application.
+        """
+        eal_params = compute_eal_params()
+        assert eal_params.lcore_list is not None
+        lcore = eal_params.lcore_list.lcore_list[0]
+        eal_params.append_str(
+            f' -p 0x3 -P --config="(0,0,{lcore}),(1,0,{lcore})" --lookup={lookup}'
+        )
+        return BlockingApp(
+            self._ctx.sut_node,
+            self.l3fwd_path,
+            name=f"l3fwd-{lookup}",
+            privileged=True,
+            app_params=eal_params,
+        ).wait_until_ready(f"entering main loop on lcore {lcore}")
+
+    def _measure(self, frame_size: int) -> float:
+        """Send traffic of a given frame size and measure the forwarded throughput.
+
+        Args:
+            frame_size: The size of the frame to transmit.
+
+        Returns:
+            The MPPS (millions of packets per second) forwarded by the SUT.
+        """
+        # The default LPM and FIB route and exact match flow to port 1,
+        # accounting for the 14B, 20B and 8B Ether, IP and UDP headers.
+        packet = (
+            Ether(src="52:00:00:00:00:00")
+            / IP(src="198.18.1.1", dst="198.18.1.0")
+            / UDP(sport=9, dport=9)
+            / Raw(load="x" * (frame_size - 14 - 20 - 8))
+        )
+        stats = assess_performance_by_packet(packet=packet, duration=self.config.duration)
+        return stats.rx_pps / 1_000_000
+
+    @perf_test
+    def l3fwd_perf(self) -> None:
+        """Verify the l3fwd forwarding throughput against the baseline.
+
+        Steps:
+            * Start l3fwd with each configured lookup method.
+            * Transmit from the traffic generator at line rate each configured frame size.
+            * Record the forwarded MPPS in the performance results store.
+
+        Verify:
+            * The forwarded MPPS did not drop by more than the threshold from the baseline.
+        """
+        measurements = []
+
+        for lookup in self.config.lookups:
+            l3fwd = self._start_l3fwd(lookup)
+            try:
+                for frame_size in self.config.frame_sizes:
+                    mpps = self._measure(frame_size)
+                    log(f"l3fwd {lookup} of {frame_size}B frames: {mpps:.3f} Mpps")
+                    measurements.append(PerfMeasurement(f"{lookup}/{frame_size}B", mpps=mpps))
+            finally:
+                l3fwd.close()
+
+        regressions = record_performance(
+            "l3fwd_perf",
+            measurements,
+            self.config.regression_threshold,
+            self.config.baseline_history,
+        )
+        verify(
+            not regressions,
+            "L3 forwarding performance regressions:\n" + "\n".join(str(r) for r in regressions),
+        )
@@ -692,6 +692,26 @@ init_power_library(void)
 	return ret;
 }
 
+/*
+ * Rx and Tx exchange the packets with the distributor through rings,
+ * check an lcore shares the last level cache of the distributor one.
+ */
+static int
+lcore_near(unsigned int lcore_id, int ref_core_id)
+{
+	int llc;
+
+	if (ref_core_id < 0)
+		return 1;
+
+	/* no preference when the cache topology is unknown */
+	llc = rte_lcore_domain_id(ref_core_id, RTE_LCORE_DOMAIN_L3);
+	if (llc < 0)
+		return 1;
+
+	return llc == rte_lcore_domain_id(lcore_id, RTE_LCORE_DOMAIN_L3);
+}
+
 /* display usage */
 static void
 print_usage(const char *prgname)
@@ -774,8 +794,9 @@ main(int argc, char *argv[])
 	struct rte_ring *dist_tx_ring;
 	struct rte_ring *rx_dist_ring;
 	struct rte_power_core_capabilities lcore_cap;
-	unsigned int lcore_id, worker_id = 0;
+	unsigned int lcore_id, worker_id = 0, pass;
 	int distr_core_id = -1, rx_core_id = -1, tx_core_id = -1;
+	int ref_core_id;
 	unsigned nb_ports;
 	unsigned int min_cores;
 	uint16_t portid;
@@ -914,27 +935,34 @@ main(int argc, char *argv[])
 	/*
 	 * If there's any of the key workloads left without an lcore_id
 	 * after the high performing core assignment above, pre-assign
-	 * them here.
+	 * them here, first on the lcores sharing the last level cache
+	 * of the distributor, then on any lcore.
 	 */
-	RTE_LCORE_FOREACH_WORKER(lcore_id) {
-		if (lcore_id == (unsigned int)distr_core_id ||
-				lcore_id == (unsigned int)rx_core_id ||
-				lcore_id == (unsigned int)tx_core_id)
-			continue;
-		if (distr_core_id < 0 && !enable_lcore_rx_distributor) {
-			distr_core_id = lcore_id;
-			printf("Distributor on core %d\n", lcore_id);
-			continue;
-		}
-		if (rx_core_id < 0) {
-			rx_core_id = lcore_id;
-			printf("Rx on core %d\n", lcore_id);
-			continue;
-		}
-		if (tx_core_id < 0) {
-			tx_core_id = lcore_id;
-			printf("Tx on core %d\n", lcore_id);
-			continue;
+	for (pass = 0; pass < 2; pass++) {
+		RTE_LCORE_FOREACH_WORKER(lcore_id) {
+			if (lcore_id == (unsigned int)distr_core_id ||
+					lcore_id == (unsigned int)rx_core_id ||
+					lcore_id == (unsigned int)tx_core_id)
+				continue;
+			ref_core_id = enable_lcore_rx_distributor ?
+				rx_core_id : distr_core_id;
+			if (pass == 0 && !lcore_near(lcore_id, ref_core_id))
+				continue;
+			if (distr_core_id < 0 && !enable_lcore_rx_distributor) {
+				distr_core_id = lcore_id;
+				printf("Distributor on core %d\n", lcore_id);
+				continue;
+			}
+			if (rx_core_id < 0) {
+				rx_core_id = lcore_id;
+				printf("Rx on core %d\n", lcore_id);
+				continue;
+			}
+			if (tx_core_id < 0) {
+				tx_core_id = lcore_id;
+				printf("Tx on core %d\n", lcore_id);
+				continue;
+			}
 		}
 	}
 
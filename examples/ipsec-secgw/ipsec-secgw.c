@@ -131,6 +131,7 @@ struct flow_info flow_info_tbl[RTE_MAX_ETHPORTS];
 #define CMD_LINE_OPT_VECTOR_POOL_SZ	"vector-pool-sz"
 #define CMD_LINE_OPT_PER_PORT_POOL	"per-port-pool"
 #define CMD_LINE_OPT_QP_DESC_NB		"desc-nb"
+#define CMD_LINE_OPT_CRYPTO_RAW_DP	"crypto-raw-dp"
 
 #define CMD_LINE_ARG_EVENT	"event"
 #define CMD_LINE_ARG_POLL	"poll"
@@ -161,6 +162,7 @@ enum {
 	CMD_LINE_OPT_VECTOR_POOL_SZ_NUM,
 	CMD_LINE_OPT_PER_PORT_POOL_NUM,
 	CMD_LINE_OPT_QP_DESC_NB_NUM,
+	CMD_LINE_OPT_CRYPTO_RAW_DP_NUM,
 };
 
 static const struct option lgopts[] = {
@@ -180,6 +182,7 @@ static const struct option lgopts[] = {
 	{CMD_LINE_OPT_VECTOR_POOL_SZ, 1, 0, CMD_LINE_OPT_VECTOR_POOL_SZ_NUM},
 	{CMD_LINE_OPT_PER_PORT_POOL, 0, 0, CMD_LINE_OPT_PER_PORT_POOL_NUM},
 	{CMD_LINE_OPT_QP_DESC_NB, 1, 0, CMD_LINE_OPT_QP_DESC_NB_NUM},
+	{CMD_LINE_OPT_CRYPTO_RAW_DP, 0, 0, CMD_LINE_OPT_CRYPTO_RAW_DP_NUM},
 	{NULL, 0, 0, 0}
 };
 
@@ -254,6 +257,7 @@ static struct rte_eth_conf port_conf = {
 struct socket_ctx socket_ctx[NB_SOCKETS];
 
 bool per_port_pool;
+bool crypto_raw_dp;
 
 uint16_t wrkr_flags;
 /*
@@ -918,6 +922,7 @@ print_usage(const char *prgname)
 		" [--vector-size SIZE]"
 		" [--vector-tmo TIMEOUT in ns]"
 		" [--" CMD_LINE_OPT_QP_DESC_NB " NUMBER_OF_DESC]"
+		" [--" CMD_LINE_OPT_CRYPTO_RAW_DP "]"
 		"\n\n"
 		"  -p PORTMASK: Hexadecimal bitmask of ports to configure\n"
 		"  -P : Enable promiscuous mode\n"
@@ -982,6 +987,9 @@ print_usage(const char *prgname)
 		"                    (default value is based on mbuf count)\n"
 		"  --" CMD_LINE_OPT_QP_DESC_NB " DESC_NB"
 		": Number of descriptors per queue pair (default value: 2048)\n"
+		"  --" CMD_LINE_OPT_CRYPTO_RAW_DP
+		": enqueue to the crypto devices through the raw data-path API\n"
+		"    instead of crypto ops, only in poll mode\n"
 		"\n",
 		prgname);
 }
@@ -1383,6 +1391,9 @@ parse_args(int32_t argc, char **argv, struct eh_conf *eh_conf)
 		case CMD_LINE_OPT_QP_DESC_NB_NUM:
 			qp_desc_nb = parse_decimal(optarg);
 			break;
+		case CMD_LINE_OPT_CRYPTO_RAW_DP_NUM:
+			crypto_raw_dp = 1;
+			break;
 		default:
 			print_usage(prgname);
 			return -1;
@@ -1394,6 +1405,12 @@ parse_args(int32_t argc, char **argv, struct eh_conf *eh_conf)
 		return -1;
 	}
 
+	if (crypto_raw_dp && eh_conf->mode != EH_PKT_TRANSFER_MODE_POLL) {
+		printf("Option \"--%s\" is only supported in poll mode\n",
+			CMD_LINE_OPT_CRYPTO_RAW_DP);
+		return -1;
+	}
+
 	/* check do we need to enable multi-seg support */
 	if (multi_seg_required()) {
 		/* legacy mode doesn't support multi-seg */
@@ -1532,6 +1549,13 @@ add_mapping(const char *str, uint16_t cdev_id,
 		}
 		ipsec_ctx->tbl[i].id = cdev_id;
 		ipsec_ctx->tbl[i].qp = qp;
+		if (crypto_raw_dp) {
+			ret = cqp_raw_init(&ipsec_ctx->tbl[i]);
+			if (ret < 0)
+				rte_exit(EXIT_FAILURE, "Crypto device %u does "
+					"not support the raw data-path API, "
+					"error %d\n", cdev_id, ret);
+		}
 		ipsec_ctx->nb_qps++;
 		printf("%s cdev mapping: lcore %u using cdev %u qp %u "
 				"(cdev_id_qp %lu)\n", str, key.lcore_id,
@@ -144,6 +144,7 @@ extern volatile bool force_quit;
 extern uint32_t nb_bufs_in_pool;
 
 extern bool per_port_pool;
+extern bool crypto_raw_dp;
 extern int ip_reassembly_dynfield_offset;
 extern uint64_t ip_reassembly_dynflag;
 extern uint32_t mtu_size;
@@ -15,6 +15,7 @@
 #include <rte_ethdev.h>
 #include <rte_mbuf.h>
 #include <rte_hash.h>
+#include <rte_malloc.h>
 
 #include "ipsec.h"
 #include "esp.h"
@@ -771,7 +772,7 @@ enqueue_cop_burst(struct cdev_qp *cqp)
 	uint32_t i, len, ret;
 
 	len = cqp->len;
-	ret = rte_cryptodev_enqueue_burst(cqp->id, cqp->qp, cqp->buf, len);
+	ret = cqp_enqueue_burst(cqp, cqp->buf, len);
 	if (ret < len) {
 		RTE_LOG_DP(DEBUG, IPSEC, "Cryptodev %u queue %u:"
 			" enqueued %u crypto ops out of %u\n",
@@ -784,6 +785,230 @@ enqueue_cop_burst(struct cdev_qp *cqp)
 	cqp->len = 0;
 }
 
+/* Vectors of the packet segments processed in a raw data-path burst */
+#define RAW_DP_NB_VECS		(MAX_PKT_BURST * 4)
+
+int
+cqp_raw_init(struct cdev_qp *cqp)
+{
+	int32_t size;
+
+	size = rte_cryptodev_get_raw_dp_ctx_size(cqp->id);
+	if (size < 0)
+		return size;
+
+	cqp->raw_ctx = rte_zmalloc(NULL, size, RTE_CACHE_LINE_SIZE);
+	if (cqp->raw_ctx == NULL)
+		return -ENOMEM;
+	cqp->raw_sess = NULL;
+
+	return 0;
+}
+
+/*
+ * The raw data-path context is bound to a session, update it when
+ * the session changes between the ops.
+ */
+static inline int
+raw_dp_set_session(struct cdev_qp *cqp, void *sess)
+{
+	union rte_cryptodev_session_ctx sess_ctx = { .crypto_sess = sess };
+	int ret;
+
+	ret = rte_cryptodev_configure_raw_dp_ctx(cqp->id, cqp->qp,
+			cqp->raw_ctx, RTE_CRYPTO_OP_WITH_SESSION, sess_ctx,
+			cqp->raw_sess != NULL);
+	if (ret == 0)
+		cqp->raw_sess = sess;
+
+	return ret;
+}
+
+static inline int
+raw_dp_is_aead(const struct rte_crypto_op *cop)
+{
+	const struct ipsec_sa *sa = get_priv(cop->sym->m_src)->sa;
+
+	return sa->aead_algo == RTE_CRYPTO_AEAD_AES_GCM ||
+		sa->aead_algo == RTE_CRYPTO_AEAD_AES_CCM ||
+		sa->aead_algo == RTE_CRYPTO_AEAD_CHACHA20_POLY1305;
+}
+
+/*
+ * Get the data region of an op, covering its cipher and auth regions,
+ * and the offsets of these regions from the region start and end.
+ */
+static inline void
+raw_dp_op_region(const struct rte_crypto_sym_op *sop, int aead,
+		uint32_t *start, uint32_t *len, union rte_crypto_sym_ofs *ofs)
+{
+	uint32_t cend, aend, end;
+
+	ofs->raw = 0;
+	if (aead) {
+		*start = sop->aead.data.offset;
+		*len = sop->aead.data.length;
+		return;
+	}
+
+	cend = sop->cipher.data.offset + sop->cipher.data.length;
+	aend = sop->auth.data.offset + sop->auth.data.length;
+	if (sop->auth.data.length == 0) {
+		*start = sop->cipher.data.offset;
+		end = cend;
+	} else if (sop->cipher.data.length == 0) {
+		*start = sop->auth.data.offset;
+		end = aend;
+	} else {
+		*start = RTE_MIN(sop->cipher.data.offset,
+				sop->auth.data.offset);
+		end = RTE_MAX(cend, aend);
+	}
+	*len = end - *start;
+
+	if (sop->cipher.data.length != 0) {
+		ofs->ofs.cipher.head = sop->cipher.data.offset - *start;
+		ofs->ofs.cipher.tail = end - cend;
+	}
+	if (sop->auth.data.length != 0) {
+		ofs->ofs.auth.head = sop->auth.data.offset - *start;
+		ofs->ofs.auth.tail = end - aend;
+	}
+}
+
+/*
+ * Enqueue crypto ops through the raw data-path API, in bursts of
+ * consecutive ops of the same session and region offsets.
+ * The ops are given as user data, to be returned on dequeue.
+ */
+uint16_t
+cqp_raw_enqueue_burst(struct cdev_qp *cqp, struct rte_crypto_op *cop[],
+		uint16_t num)
+{
+	struct rte_crypto_va_iova_ptr iv[MAX_PKT_BURST];
+	struct rte_crypto_va_iova_ptr digest[MAX_PKT_BURST];
+	struct rte_crypto_va_iova_ptr aad[MAX_PKT_BURST];
+	struct rte_crypto_sgl sgl[MAX_PKT_BURST];
+	struct rte_crypto_vec vec[RAW_DP_NB_VECS];
+	int32_t status[MAX_PKT_BURST];
+	struct rte_crypto_sym_vec symvec = {
+		.src_sgl = sgl,
+		.iv = iv,
+		.digest = digest,
+		.aad = aad,
+		.status = status,
+	};
+	union rte_crypto_sym_ofs ofs, op_ofs;
+	struct rte_crypto_sym_op *sop;
+	uint32_t i, j, k, n, start, len, vofs, nb_enq;
+	int aead, enq_status, nb_vecs;
+	void *sess;
+
+	num = RTE_MIN(num, MAX_PKT_BURST);
+	nb_enq = 0;
+	ofs.raw = 0;
+
+	for (i = 0; i != num; i = j) {
+		/* lookaside protocol ops have no crypto session */
+		if (cop[i]->sess_type != RTE_CRYPTO_OP_WITH_SESSION)
+			break;
+		sess = cop[i]->sym->session;
+		if (sess != cqp->raw_sess &&
+				raw_dp_set_session(cqp, sess) != 0)
+			break;
+		aead = raw_dp_is_aead(cop[i]);
+
+		vofs = 0;
+		for (j = i; j != num; j++) {
+			sop = cop[j]->sym;
+			if (cop[j]->sess_type != RTE_CRYPTO_OP_WITH_SESSION ||
+					sop->session != sess)
+				break;
+
+			raw_dp_op_region(sop, aead, &start, &len, &op_ofs);
+			if (j != i && op_ofs.raw != ofs.raw)
+				break;
+
+			nb_vecs = rte_crypto_mbuf_to_vec(sop->m_src, start, len,
+					&vec[vofs], RTE_DIM(vec) - vofs);
+			if (nb_vecs < 0)
+				break;
+
+			k = j - i;
+			ofs = op_ofs;
+			sgl[k].vec = &vec[vofs];
+			sgl[k].num = nb_vecs;
+			vofs += nb_vecs;
+
+			iv[k].va = rte_crypto_op_ctod_offset(cop[j], void *,
+					IV_OFFSET);
+			iv[k].iova = rte_crypto_op_ctophys_offset(cop[j],
+					IV_OFFSET);
+			if (aead) {
+				digest[k].va = sop->aead.digest.data;
+				digest[k].iova = sop->aead.digest.phys_addr;
+				aad[k].va = sop->aead.aad.data;
+				aad[k].iova = sop->aead.aad.phys_addr;
+			} else {
+				digest[k].va = sop->auth.digest.data;
+				digest[k].iova = sop->auth.digest.phys_addr;
+				/* auth IV, if any, follows the cipher IV */
+				aad[k] = iv[k];
+			}
+		}
+
+		/* first op of the group cannot be described */
+		if (j == i)
+			break;
+
+		symvec.num = j - i;
+		n = rte_cryptodev_raw_enqueue_burst(cqp->raw_ctx, &symvec, ofs,
+				(void **)&cop[i], &enq_status);
+		if (enq_status < 0 || (enq_status == 0 && n != 0 &&
+				rte_cryptodev_raw_enqueue_done(cqp->raw_ctx,
+					n) != 0))
+			n = 0;
+
+		nb_enq += n;
+		if (n != j - i)
+			break;
+	}
+
+	return nb_enq;
+}
+
+static void
+raw_dp_post_dequeue(void *user_data, uint32_t index __rte_unused,
+		uint8_t is_op_success)
+{
+	struct rte_crypto_op *cop = user_data;
+
+	cop->status = is_op_success ? RTE_CRYPTO_OP_STATUS_SUCCESS :
+			RTE_CRYPTO_OP_STATUS_ERROR;
+}
+
+uint16_t
+cqp_raw_dequeue_burst(struct cdev_qp *cqp, struct rte_crypto_op *cop[],
+		uint16_t num)
+{
+	uint32_t n, n_success;
+	int deq_status;
+
+	/* the context is not set before the first enqueue */
+	if (cqp->raw_sess == NULL)
+		return 0;
+
+	n = rte_cryptodev_raw_dequeue_burst(cqp->raw_ctx, NULL, num,
+			raw_dp_post_dequeue, (void **)cop, 1, &n_success,
+			&deq_status);
+	if (deq_status < 0)
+		return 0;
+	if (deq_status == 0 && n != 0)
+		rte_cryptodev_raw_dequeue_done(cqp->raw_ctx, n);
+
+	return n;
+}
+
 static inline void
 enqueue_cop(struct cdev_qp *cqp, struct rte_crypto_op *cop)
 {
@@ -957,8 +1182,7 @@ ipsec_dequeue(ipsec_xform_fn xform_func, struct ipsec_ctx *ipsec_ctx,
 		if (cqp->in_flight == 0)
 			continue;
 
-		nb_cops = rte_cryptodev_dequeue_burst(cqp->id, cqp->qp,
-				cops, max_pkts - nb_pkts);
+		nb_cops = cqp_dequeue_burst(cqp, cops, max_pkts - nb_pkts);
 
 		cqp->in_flight -= nb_cops;
 
@@ -9,6 +9,7 @@
 
 #include <rte_byteorder.h>
 #include <rte_crypto.h>
+#include <rte_cryptodev.h>
 #include <rte_ip_frag.h>
 #include <rte_security.h>
 #include <rte_flow.h>
@@ -222,6 +223,9 @@ struct cdev_qp {
 	uint16_t in_flight;
 	uint16_t len;
 	struct rte_crypto_op *buf[MAX_PKT_BURST];
+	/* raw data-path context, NULL when enqueuing crypto ops */
+	struct rte_crypto_raw_dp_ctx *raw_ctx;
+	void *raw_sess;
 };
 
 struct ipsec_ctx {
@@ -455,6 +459,42 @@ add_dst_ethaddr(uint16_t port, const struct rte_ether_addr *addr);
 void
 enqueue_cop_burst(struct cdev_qp *cqp);
 
+int
+cqp_raw_init(struct cdev_qp *cqp);
+
+uint16_t
+cqp_raw_enqueue_burst(struct cdev_qp *cqp, struct rte_crypto_op *cop[],
+		uint16_t num);
+
+uint16_t
+cqp_raw_dequeue_burst(struct cdev_qp *cqp, struct rte_crypto_op *cop[],
+		uint16_t num);
+
+/*
+ * Enqueue crypto ops to a crypto queue, through the raw data-path API
+ * if enabled, in which case only the data described by the ops is given
+ * to the PMD.
+ */
+static inline uint16_t
+cqp_enqueue_burst(struct cdev_qp *cqp, struct rte_crypto_op *cop[],
+		uint16_t num)
+{
+	if (cqp->raw_ctx != NULL)
+		return cqp_raw_enqueue_burst(cqp, cop, num);
+
+	return rte_cryptodev_enqueue_burst(cqp->id, cqp->qp, cop, num);
+}
+
+static inline uint16_t
+cqp_dequeue_burst(struct cdev_qp *cqp, struct rte_crypto_op *cop[],
+		uint16_t num)
+{
+	if (cqp->raw_ctx != NULL)
+		return cqp_raw_dequeue_burst(cqp, cop, num);
+
+	return rte_cryptodev_dequeue_burst(cqp->id, cqp->qp, cop, num);
+}
+
 int
 create_lookaside_session(struct ipsec_ctx *ipsec_ctx[],
 	struct socket_ctx *skt_ctx, const struct eventmode_conf *em_conf,
@@ -38,7 +38,7 @@ enqueue_cop_bulk(struct cdev_qp *cqp, struct rte_crypto_op *cop[], uint32_t num)
 	 * then queue them to the PMD straightway.
 	 */
 	if (num >= RTE_DIM(cqp->buf) * 3 / 4 && len == 0) {
-		n = rte_cryptodev_enqueue_burst(cqp->id, cqp->qp, cop, num);
+		n = cqp_enqueue_burst(cqp, cop, num);
 		cqp->in_flight += n;
 		free_cops(cop + n, num - n);
 		return;
@@ -59,8 +59,7 @@ enqueue_cop_bulk(struct cdev_qp *cqp, struct rte_crypto_op *cop[], uint32_t num)
 
 		/* if cqp is full then, enqueue crypto-ops to PMD */
 		if (len == RTE_DIM(cqp->buf)) {
-			n = rte_cryptodev_enqueue_burst(cqp->id, cqp->qp,
-					cqp->buf, len);
+			n = cqp_enqueue_burst(cqp, cqp->buf, len);
 			cqp->in_flight += n;
 			free_cops(cqp->buf + n, len - n);
 			len = 0;
@@ -301,7 +300,7 @@ cqp_dequeue(struct cdev_qp *cqp, struct rte_crypto_op *cop[], uint32_t num)
 	if (cqp->in_flight == 0)
 		return 0;
 
-	n = rte_cryptodev_dequeue_burst(cqp->id, cqp->qp, cop, num);
+	n = cqp_dequeue_burst(cqp, cop, num);
 	RTE_ASSERT(cqp->in_flight >= n);
 	cqp->in_flight -= n;
 
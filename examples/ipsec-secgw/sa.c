@@ -756,10 +756,15 @@ parse_sa_tokens(char **tokens, uint32_t n_tokens,
 				ips->type =
 				RTE_SECURITY_ACTION_TYPE_INLINE_PROTOCOL;
 			else if (strcmp(tokens[ti],
-					"lookaside-protocol-offload") == 0)
+					"lookaside-protocol-offload") == 0) {
+				APP_CHECK(!crypto_raw_dp, status,
+					"lookaside-protocol-offload not "
+					"supported with raw data-path API");
+				if (status->status < 0)
+					return;
 				ips->type =
 				RTE_SECURITY_ACTION_TYPE_LOOKASIDE_PROTOCOL;
-			else if (strcmp(tokens[ti], "no-offload") == 0)
+			} else if (strcmp(tokens[ti], "no-offload") == 0)
 				ips->type = RTE_SECURITY_ACTION_TYPE_NONE;
 			else if (strcmp(tokens[ti], "cpu-crypto") == 0)
 				ips->type = RTE_SECURITY_ACTION_TYPE_CPU_CRYPTO;
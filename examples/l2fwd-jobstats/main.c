@@ -62,6 +62,14 @@ static uint32_t l2fwd_dst_ports[RTE_MAX_ETHPORTS];
 #define UPDATE_STEP_UP 1
 #define UPDATE_STEP_DOWN 32
 
+/* PID gains of the forward jobs, in 1/1024 TSC cycles per packet */
+#define FWD_PID_KP (16 * 1024)
+#define FWD_PID_KI 1024
+#define FWD_PID_KD 0
+
+/* use the jobstats PID controller instead of l2fwd_job_update_cb */
+static int l2fwd_pid;
+
 static unsigned int l2fwd_rx_queue_per_lcore = 1;
 
 #define MAX_RX_QUEUE_PER_LCORE 16
@@ -558,11 +566,12 @@ l2fwd_launch_one_lcore(__rte_unused void *dummy)
 static void
 l2fwd_usage(const char *prgname)
 {
-	printf("%s [EAL options] -- -p PORTMASK [-q NQ]\n"
+	printf("%s [EAL options] -- -p PORTMASK [-q NQ] [-P]\n"
 	       "  -p PORTMASK: hexadecimal bitmask of ports to configure\n"
 	       "  -q NQ: number of queue (=ports) per lcore (default is 1)\n"
 		   "  -T PERIOD: statistics will be refreshed each PERIOD seconds (0 to disable, 10 default, 86400 maximum)\n"
-		   "  -l set system default locale instead of default (\"C\" locale) for thousands separator in stats.",
+		   "  -l set system default locale instead of default (\"C\" locale) for thousands separator in stats.\n"
+		   "  -P adjust the forward jobs period with a PID controller.",
 	       prgname);
 }
 
@@ -628,7 +637,7 @@ l2fwd_parse_args(int argc, char **argv)
 
 	argvopt = argv;
 
-	while ((opt = getopt_long(argc, argvopt, "p:q:T:l",
+	while ((opt = getopt_long(argc, argvopt, "p:q:T:lP",
 				  lgopts, &option_index)) != EOF) {
 
 		switch (opt) {
@@ -667,6 +676,11 @@ l2fwd_parse_args(int argc, char **argv)
 			setlocale(LC_ALL, "");
 			break;
 
+		/* PID period controller */
+		case 'P':
+			l2fwd_pid = 1;
+			break;
+
 		/* long options */
 		case 0:
 			l2fwd_usage(prgname);
@@ -990,6 +1004,7 @@ main(int argc, char **argv)
 		 */
 		rte_jobstats_init(&qconf->flush_job, "flush", drain_tsc, drain_tsc,
 				drain_tsc, 0);
+		rte_jobstats_hist_enable(&qconf->flush_job);
 
 		rte_timer_init(&qconf->flush_timer);
 		ret = rte_timer_reset(&qconf->flush_timer, drain_tsc, PERIODICAL,
@@ -1015,6 +1030,20 @@ main(int argc, char **argv)
 			 */
 			rte_jobstats_init(job, name, 0, drain_tsc, 0, MAX_PKT_BURST);
 			rte_jobstats_set_update_period_function(job, l2fwd_job_update_cb);
+			if (l2fwd_pid) {
+				struct rte_jobstats_pid_conf pid = {
+					.target = MAX_PKT_BURST,
+					.kp = FWD_PID_KP,
+					.ki = FWD_PID_KI,
+					.kd = FWD_PID_KD,
+				};
+
+				if (rte_jobstats_pid_set(job, &pid) < 0)
+					rte_exit(1, "Failed to set lcore %u port %u PID controller",
+							lcore_id, portid);
+			}
+			/* Execute times histogram, reported by telemetry. */
+			rte_jobstats_hist_enable(job);
 
 			rte_timer_init(&qconf->rx_timers[i]);
 			ret = rte_timer_reset(&qconf->rx_timers[i], 0, PERIODICAL, lcore_id,
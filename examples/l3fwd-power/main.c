@@ -1515,7 +1515,7 @@ print_usage(const char *prgname)
 		" empty polls, full polls, and core busyness to telemetry\n"
 		" --interrupt-only: enable interrupt-only mode\n"
 		" --pmd-mgmt MODE: enable PMD power management mode. "
-		"Currently supported modes: baseline, monitor, pause, scale\n"
+		"Currently supported modes: baseline, monitor, pause, scale, predict\n"
 		"  --max-empty-polls MAX_EMPTY_POLLS: number of empty polls to"
 		" wait before entering sleep state\n"
 		"  --pause-duration DURATION: set the duration, in microseconds,"
@@ -1708,6 +1708,7 @@ parse_pmd_mgmt_config(const char *name)
 #define PMD_MGMT_MONITOR "monitor"
 #define PMD_MGMT_PAUSE   "pause"
 #define PMD_MGMT_SCALE   "scale"
+#define PMD_MGMT_PREDICT "predict"
 #define PMD_MGMT_BASELINE  "baseline"
 
 	if (strncmp(PMD_MGMT_MONITOR, name, sizeof(PMD_MGMT_MONITOR)) == 0) {
@@ -1724,6 +1725,11 @@ parse_pmd_mgmt_config(const char *name)
 		pmgmt_type = RTE_POWER_MGMT_TYPE_SCALE;
 		return 0;
 	}
+
+	if (strncmp(PMD_MGMT_PREDICT, name, sizeof(PMD_MGMT_PREDICT)) == 0) {
+		pmgmt_type = RTE_POWER_MGMT_TYPE_PREDICT;
+		return 0;
+	}
 	if (strncmp(PMD_MGMT_BASELINE, name, sizeof(PMD_MGMT_BASELINE)) == 0) {
 		baseline_enabled = true;
 		return 0;
@@ -208,9 +208,6 @@ ipv6_hash_crc(const void *data, __rte_unused uint32_t data_len,
 	return init_val;
 }
 
-static alignas(RTE_CACHE_LINE_SIZE) uint8_t ipv4_l3fwd_out_if[L3FWD_HASH_ENTRIES];
-static alignas(RTE_CACHE_LINE_SIZE) uint8_t ipv6_l3fwd_out_if[L3FWD_HASH_ENTRIES];
-
 static rte_xmm_t mask0;
 static rte_xmm_t mask1;
 static rte_xmm_t mask2;
@@ -264,6 +261,7 @@ static inline uint16_t
 em_get_ipv4_dst_port(void *ipv4_hdr, uint16_t portid, void *lookup_struct)
 {
 	int ret = 0;
+	void *data;
 	union ipv4_5tuple_host key;
 	struct rte_hash *ipv4_l3fwd_lookup_struct =
 		(struct rte_hash *)lookup_struct;
@@ -277,9 +275,10 @@ em_get_ipv4_dst_port(void *ipv4_hdr, uint16_t portid, void *lookup_struct)
 	 */
 	key.xmm = em_mask_key(ipv4_hdr, mask0.x);
 
-	/* Find destination port */
-	ret = rte_hash_lookup(ipv4_l3fwd_lookup_struct, (const void *)&key);
-	return (ret < 0) ? portid : ipv4_l3fwd_out_if[ret];
+	/* Find destination port, stored as the key data */
+	ret = rte_hash_lookup_data(ipv4_l3fwd_lookup_struct, (const void *)&key,
+				   &data);
+	return (ret < 0) ? portid : (uintptr_t)data;
 }
 /* >8 End of performing hash-based lookups. */
 
@@ -287,6 +286,7 @@ static inline uint16_t
 em_get_ipv6_dst_port(void *ipv6_hdr, uint16_t portid, void *lookup_struct)
 {
 	int ret = 0;
+	void *data;
 	union ipv6_5tuple_host key;
 	struct rte_hash *ipv6_l3fwd_lookup_struct =
 		(struct rte_hash *)lookup_struct;
@@ -316,9 +316,10 @@ em_get_ipv6_dst_port(void *ipv6_hdr, uint16_t portid, void *lookup_struct)
 	 */
 	key.xmm[2] = em_mask_key(data2, mask2.x);
 
-	/* Find destination port */
-	ret = rte_hash_lookup(ipv6_l3fwd_lookup_struct, (const void *)&key);
-	return (ret < 0) ? portid : ipv6_l3fwd_out_if[ret];
+	/* Find destination port, stored as the key data */
+	ret = rte_hash_lookup_data(ipv6_l3fwd_lookup_struct, (const void *)&key,
+				   &data);
+	return (ret < 0) ? portid : (uintptr_t)data;
 }
 
 #if defined RTE_ARCH_X86 || defined __ARM_NEON
@@ -390,12 +391,12 @@ populate_ipv4_flow_into_table(const struct rte_hash *h)
 
 		entry = &em_route_base_v4[i];
 		convert_ipv4_5tuple(&(entry->v4_key), &newkey);
-		ret = rte_hash_add_key(h, (void *) &newkey);
+		ret = rte_hash_add_key_data(h, (void *) &newkey,
+				(void *)(uintptr_t)entry->if_out);
 		if (ret < 0) {
 			rte_exit(EXIT_FAILURE, "Unable to add entry %" PRIu32
 				" to the l3fwd hash.\n", i);
 		}
-		ipv4_l3fwd_out_if[ret] = entry->if_out;
 		ret = rte_eth_dev_info_get(em_route_base_v4[i].if_out,
 				     &dev_info);
 		if (ret != 0)
@@ -442,12 +443,12 @@ populate_ipv6_flow_into_table(const struct rte_hash *h)
 
 		entry = &em_route_base_v6[i];
 		convert_ipv6_5tuple(&(entry->v6_key), &newkey);
-		ret = rte_hash_add_key(h, (void *) &newkey);
+		ret = rte_hash_add_key_data(h, (void *) &newkey,
+				(void *)(uintptr_t)entry->if_out);
 		if (ret < 0) {
 			rte_exit(EXIT_FAILURE, "Unable to add entry %" PRIu32
 				" to the l3fwd hash.\n", i);
 		}
-		ipv6_l3fwd_out_if[ret] = entry->if_out;
 		ret = rte_eth_dev_info_get(em_route_base_v6[i].if_out,
 				     &dev_info);
 		if (ret != 0)
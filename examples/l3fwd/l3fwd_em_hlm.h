@@ -14,7 +14,11 @@
 #include "l3fwd_em_hlm_neon.h"
 #endif
 
-#ifdef RTE_ARCH_ARM64
+/*
+ * Larger groups amortize the hash bulk lookup pipeline over more keys,
+ * when the signature compare of the hash is wide enough for it.
+ */
+#if defined RTE_ARCH_ARM64 || defined __AVX512F__
 #define EM_HASH_LOOKUP_COUNT 16
 #else
 #define EM_HASH_LOOKUP_COUNT 8
@@ -26,7 +30,8 @@ em_get_dst_port_ipv4xN(struct lcore_conf *qconf, struct rte_mbuf *m[],
 		uint16_t portid, uint16_t dst_port[])
 {
 	int i;
-	int32_t ret[EM_HASH_LOOKUP_COUNT];
+	uint64_t hits;
+	void *data[EM_HASH_LOOKUP_COUNT];
 	union ipv4_5tuple_host key[EM_HASH_LOOKUP_COUNT];
 	const void *key_array[EM_HASH_LOOKUP_COUNT];
 
@@ -35,12 +40,13 @@ em_get_dst_port_ipv4xN(struct lcore_conf *qconf, struct rte_mbuf *m[],
 		key_array[i] = &key[i];
 	}
 
-	rte_hash_lookup_bulk(qconf->ipv4_lookup_struct, &key_array[0],
-			     EM_HASH_LOOKUP_COUNT, ret);
+	/* The ports are the key data, read with the keys compared */
+	rte_hash_lookup_bulk_data(qconf->ipv4_lookup_struct, &key_array[0],
+				  EM_HASH_LOOKUP_COUNT, &hits, data);
 
 	for (i = 0; i < EM_HASH_LOOKUP_COUNT; i++) {
-		dst_port[i] = ((ret[i] < 0) ?
-				portid : ipv4_l3fwd_out_if[ret[i]]);
+		dst_port[i] = ((hits & RTE_BIT64(i)) == 0 ?
+				portid : (uintptr_t)data[i]);
 
 		if (dst_port[i] >= RTE_MAX_ETHPORTS ||
 				(enabled_port_mask & 1 << dst_port[i]) == 0)
@@ -53,7 +59,8 @@ em_get_dst_port_ipv6xN(struct lcore_conf *qconf, struct rte_mbuf *m[],
 		uint16_t portid, uint16_t dst_port[])
 {
 	int i;
-	int32_t ret[EM_HASH_LOOKUP_COUNT];
+	uint64_t hits;
+	void *data[EM_HASH_LOOKUP_COUNT];
 	union ipv6_5tuple_host key[EM_HASH_LOOKUP_COUNT];
 	const void *key_array[EM_HASH_LOOKUP_COUNT];
 
@@ -62,12 +69,13 @@ em_get_dst_port_ipv6xN(struct lcore_conf *qconf, struct rte_mbuf *m[],
 		key_array[i] = &key[i];
 	}
 
-	rte_hash_lookup_bulk(qconf->ipv6_lookup_struct, &key_array[0],
-			     EM_HASH_LOOKUP_COUNT, ret);
+	/* The ports are the key data, read with the keys compared */
+	rte_hash_lookup_bulk_data(qconf->ipv6_lookup_struct, &key_array[0],
+				  EM_HASH_LOOKUP_COUNT, &hits, data);
 
 	for (i = 0; i < EM_HASH_LOOKUP_COUNT; i++) {
-		dst_port[i] = ((ret[i] < 0) ?
-				portid : ipv6_l3fwd_out_if[ret[i]]);
+		dst_port[i] = ((hits & RTE_BIT64(i)) == 0 ?
+				portid : (uintptr_t)data[i]);
 
 		if (dst_port[i] >= RTE_MAX_ETHPORTS ||
 				(enabled_port_mask & 1 << dst_port[i]) == 0)
@@ -80,7 +88,8 @@ em_get_dst_port_ipv4xN_events(struct lcore_conf *qconf, struct rte_mbuf *m[],
 			      uint16_t dst_port[])
 {
 	int i;
-	int32_t ret[EM_HASH_LOOKUP_COUNT];
+	uint64_t hits;
+	void *data[EM_HASH_LOOKUP_COUNT];
 	union ipv4_5tuple_host key[EM_HASH_LOOKUP_COUNT];
 	const void *key_array[EM_HASH_LOOKUP_COUNT];
 
@@ -89,12 +98,13 @@ em_get_dst_port_ipv4xN_events(struct lcore_conf *qconf, struct rte_mbuf *m[],
 		key_array[i] = &key[i];
 	}
 
-	rte_hash_lookup_bulk(qconf->ipv4_lookup_struct, &key_array[0],
-			     EM_HASH_LOOKUP_COUNT, ret);
+	/* The ports are the key data, read with the keys compared */
+	rte_hash_lookup_bulk_data(qconf->ipv4_lookup_struct, &key_array[0],
+				  EM_HASH_LOOKUP_COUNT, &hits, data);
 
 	for (i = 0; i < EM_HASH_LOOKUP_COUNT; i++) {
-		dst_port[i] = ((ret[i] < 0) ?
-				m[i]->port : ipv4_l3fwd_out_if[ret[i]]);
+		dst_port[i] = ((hits & RTE_BIT64(i)) == 0 ?
+				m[i]->port : (uintptr_t)data[i]);
 
 		if (dst_port[i] >= RTE_MAX_ETHPORTS ||
 				(enabled_port_mask & 1 << dst_port[i]) == 0)
@@ -107,7 +117,8 @@ em_get_dst_port_ipv6xN_events(struct lcore_conf *qconf, struct rte_mbuf *m[],
 			      uint16_t dst_port[])
 {
 	int i;
-	int32_t ret[EM_HASH_LOOKUP_COUNT];
+	uint64_t hits;
+	void *data[EM_HASH_LOOKUP_COUNT];
 	union ipv6_5tuple_host key[EM_HASH_LOOKUP_COUNT];
 	const void *key_array[EM_HASH_LOOKUP_COUNT];
 
@@ -116,12 +127,13 @@ em_get_dst_port_ipv6xN_events(struct lcore_conf *qconf, struct rte_mbuf *m[],
 		key_array[i] = &key[i];
 	}
 
-	rte_hash_lookup_bulk(qconf->ipv6_lookup_struct, &key_array[0],
-			     EM_HASH_LOOKUP_COUNT, ret);
+	/* The ports are the key data, read with the keys compared */
+	rte_hash_lookup_bulk_data(qconf->ipv6_lookup_struct, &key_array[0],
+				  EM_HASH_LOOKUP_COUNT, &hits, data);
 
 	for (i = 0; i < EM_HASH_LOOKUP_COUNT; i++) {
-		dst_port[i] = ((ret[i] < 0) ?
-				m[i]->port : ipv6_l3fwd_out_if[ret[i]]);
+		dst_port[i] = ((hits & RTE_BIT64(i)) == 0 ?
+				m[i]->port : (uintptr_t)data[i]);
 
 		if (dst_port[i] >= RTE_MAX_ETHPORTS ||
 				(enabled_port_mask & 1 << dst_port[i]) == 0)
@@ -31,12 +31,14 @@ get_ipv6_5tuple(struct rte_mbuf *m0, int32x4_t mask0,
 	int32x4_t tmpdata1 = vld1q_s32(
 		rte_pktmbuf_mtod_offset(m0, int *,
 			sizeof(struct rte_ether_hdr) +
-			offsetof(struct rte_ipv6_hdr, payload_len) + 8));
+			offsetof(struct rte_ipv6_hdr, payload_len) +
+			sizeof(int32x4_t)));
 
 	int32x4_t tmpdata2 = vld1q_s32(
 		rte_pktmbuf_mtod_offset(m0, int *,
 			sizeof(struct rte_ether_hdr) +
-			offsetof(struct rte_ipv6_hdr, payload_len) + 16));
+			offsetof(struct rte_ipv6_hdr, payload_len) +
+			sizeof(int32x4_t) + sizeof(int32x4_t)));
 
 	key->xmm[0] = vandq_s32(tmpdata0, mask0);
 	key->xmm[1] = tmpdata1;
@@ -19,6 +19,25 @@ get_ipv4_5tuple(struct rte_mbuf *m0, __m128i mask0,
 	key->xmm = _mm_and_si128(tmpdata0, mask0);
 }
 
+#ifdef __AVX2__
+static inline void
+get_ipv6_5tuple(struct rte_mbuf *m0, __m128i mask0,
+		__m128i mask1, union ipv6_5tuple_host *key)
+{
+	const uint8_t *data = rte_pktmbuf_mtod_offset(m0, uint8_t *,
+				sizeof(struct rte_ether_hdr) +
+				offsetof(struct rte_ipv6_hdr, payload_len));
+	/* Protocol and src IP address, then dst IP address lower 96 bits */
+	__m256i mask01 = _mm256_set_m128i(_mm_set1_epi32(-1), mask0);
+	__m256i tmpdata01 = _mm256_loadu_si256((const __m256i *)data);
+	__m128i tmpdata2 = _mm_loadu_si128(
+			(const __m128i *)(data + sizeof(__m256i)));
+
+	_mm256_storeu_si256((__m256i *)key->xmm,
+			    _mm256_and_si256(tmpdata01, mask01));
+	key->xmm[2] = _mm_and_si128(tmpdata2, mask1);
+}
+#else
 static inline void
 get_ipv6_5tuple(struct rte_mbuf *m0, __m128i mask0,
 		__m128i mask1, union ipv6_5tuple_host *key)
@@ -44,4 +63,5 @@ get_ipv6_5tuple(struct rte_mbuf *m0, __m128i mask0,
 	key->xmm[1] = tmpdata1;
 	key->xmm[2] = _mm_and_si128(tmpdata2, mask1);
 }
+#endif /* __AVX2__ */
 #endif /* __L3FWD_EM_SSE_HLM_H__ */
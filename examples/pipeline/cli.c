@@ -840,6 +840,115 @@ cmd_pipeline_build(char **tokens,
 		fclose(iospec_file);
 }
 
+static const char cmd_pipeline_reload_help[] =
+"pipeline <pipeline_name> reload lib <lib_file> io <iospec_file> numa <numa_node>\n";
+
+static void
+cmd_pipeline_reload(char **tokens,
+	uint32_t n_tokens,
+	char *out,
+	size_t out_size,
+	void *obj __rte_unused)
+{
+	struct rte_swx_pipeline *p;
+	struct rte_swx_ctl_pipeline *ctl;
+	char *pipeline_name, *lib_file_name, *iospec_file_name;
+	FILE *iospec_file = NULL;
+	uint32_t numa_node = 0, thread_id;
+	int status = 0;
+
+	/* Parsing. */
+	if (n_tokens != 9) {
+		snprintf(out, out_size, MSG_ARG_MISMATCH, tokens[0]);
+		return;
+	}
+
+	pipeline_name = tokens[1];
+	p = rte_swx_pipeline_find(pipeline_name);
+	ctl = rte_swx_ctl_pipeline_find(pipeline_name);
+	if (!p || !ctl) {
+		snprintf(out, out_size, MSG_ARG_INVALID, "pipeline_name");
+		return;
+	}
+
+	if (strcmp(tokens[2], "reload")) {
+		snprintf(out, out_size, MSG_ARG_NOT_FOUND, "reload");
+		return;
+	}
+
+	if (strcmp(tokens[3], "lib")) {
+		snprintf(out, out_size, MSG_ARG_NOT_FOUND, "lib");
+		return;
+	}
+
+	lib_file_name = tokens[4];
+
+	if (strcmp(tokens[5], "io")) {
+		snprintf(out, out_size, MSG_ARG_NOT_FOUND, "io");
+		return;
+	}
+
+	iospec_file_name = tokens[6];
+
+	if (strcmp(tokens[7], "numa")) {
+		snprintf(out, out_size, MSG_ARG_NOT_FOUND, "numa");
+		return;
+	}
+
+	if (parser_read_uint32(&numa_node, tokens[8])) {
+		snprintf(out, out_size, MSG_ARG_INVALID, "numa_node");
+		return;
+	}
+
+	/* I/O spec file open. */
+	iospec_file = fopen(iospec_file_name, "r");
+	if (!iospec_file) {
+		snprintf(out, out_size, "Cannot open file \"%s\".\n", iospec_file_name);
+		return;
+	}
+
+	/* Stop running the current pipeline and free it, which releases its name and its ports. */
+	thread_id = pipeline_thread_get(p);
+	pipeline_disable(p);
+
+	rte_swx_ctl_pipeline_free(ctl);
+	rte_swx_pipeline_free(p);
+	p = NULL;
+
+	/* Build the new pipeline and run it on the same thread. */
+	status = rte_swx_pipeline_build_from_lib(&p,
+						 pipeline_name,
+						 lib_file_name,
+						 iospec_file,
+						 (int)numa_node);
+	if (status) {
+		snprintf(out, out_size, "Pipeline build failed (%d).", status);
+		goto free;
+	}
+
+	ctl = rte_swx_ctl_pipeline_create(p);
+	if (!ctl) {
+		snprintf(out, out_size, "Pipeline control create failed.");
+		status = -ENOMEM;
+		goto free;
+	}
+
+	if (thread_id < RTE_MAX_LCORE) {
+		status = pipeline_enable(p, thread_id);
+		if (status) {
+			snprintf(out, out_size, MSG_CMD_FAIL, "pipeline enable");
+			rte_swx_ctl_pipeline_free(ctl);
+			goto free;
+		}
+	}
+
+free:
+	if (status)
+		rte_swx_pipeline_free(p);
+
+	fclose(iospec_file);
+}
+
 static int
 pipeline_table_entries_add(struct rte_swx_ctl_pipeline *p,
 			   const char *table_name,
@@ -2854,14 +2963,16 @@ cmd_pipeline_stats(char **tokens,
 			"\t\tLearn OK (packets): %" PRIu64 "\n"
 			"\t\tLearn error (packets): %" PRIu64 "\n"
 			"\t\tRearm (packets): %" PRIu64 "\n"
-			"\t\tForget (packets): %" PRIu64 "\n",
+			"\t\tForget (packets): %" PRIu64 "\n"
+			"\t\tExpired (keys): %" PRIu64 "\n",
 			learner_info.name,
 			stats.n_pkts_hit,
 			stats.n_pkts_miss,
 			stats.n_pkts_learn_ok,
 			stats.n_pkts_learn_err,
 			stats.n_pkts_rearm,
-			stats.n_pkts_forget);
+			stats.n_pkts_forget,
+			stats.n_keys_expired);
 		out_size -= strlen(out);
 		out += strlen(out);
 
@@ -3438,6 +3549,82 @@ cmd_block_disable(char **tokens,
 	block_disable(block);
 }
 
+static const char cmd_thread_balance_help[] =
+"thread balance [period <period_ms>]\n";
+
+static void
+cmd_thread_balance(char **tokens,
+		   uint32_t n_tokens,
+		   char *out,
+		   size_t out_size,
+		   void *obj __rte_unused)
+{
+	struct rte_swx_pipeline *pipelines[THREAD_PIPELINES_MAX];
+	uint64_t loads[THREAD_PIPELINES_MAX];
+	uint32_t thread_id, period_ms, n_moved;
+	size_t len;
+	int status;
+
+	if (n_tokens != 2 && n_tokens != 4) {
+		snprintf(out, out_size, MSG_ARG_MISMATCH, tokens[0]);
+		return;
+	}
+
+	if (strcmp(tokens[1], "balance") != 0) {
+		snprintf(out, out_size, MSG_ARG_NOT_FOUND, "balance");
+		return;
+	}
+
+	/* Periodic balancing. */
+	if (n_tokens == 4) {
+		if (strcmp(tokens[2], "period") != 0) {
+			snprintf(out, out_size, MSG_ARG_NOT_FOUND, "period");
+			return;
+		}
+
+		if (parser_read_uint32(&period_ms, tokens[3]) != 0) {
+			snprintf(out, out_size, MSG_ARG_INVALID, "period_ms");
+			return;
+		}
+
+		thread_balance_period_set(period_ms);
+		return;
+	}
+
+	/* Balance now and show the measured loads. */
+	status = thread_balance(&n_moved);
+	if (status) {
+		snprintf(out, out_size, MSG_CMD_FAIL, "thread balance");
+		return;
+	}
+
+	snprintf(out, out_size, "Pipelines moved: %u\n", n_moved);
+
+	RTE_LCORE_FOREACH_WORKER(thread_id) {
+		uint64_t load = 0;
+		uint32_t n, i;
+
+		n = thread_pipelines_get(thread_id, pipelines, loads, RTE_DIM(pipelines));
+		for (i = 0; i < n; i++)
+			load += loads[i];
+
+		len = strlen(out);
+		snprintf(out + len, out_size - len, "Thread %u: %" PRIu64 " cycles per loop\n",
+			 thread_id, load);
+
+		for (i = 0; i < n; i++) {
+			struct rte_swx_ctl_pipeline_info info;
+
+			if (rte_swx_ctl_pipeline_info_get(pipelines[i], &info))
+				continue;
+
+			len = strlen(out);
+			snprintf(out + len, out_size - len, "\tPipeline %s: %" PRIu64 " cycles\n",
+				 info.name, loads[i]);
+		}
+	}
+}
+
 static void
 cmd_help(char **tokens,
 	 uint32_t n_tokens,
@@ -3460,6 +3647,7 @@ cmd_help(char **tokens,
 			"\tpipeline codegen\n"
 			"\tpipeline libbuild\n"
 			"\tpipeline build\n"
+			"\tpipeline reload\n"
 			"\tpipeline table add\n"
 			"\tpipeline table delete\n"
 			"\tpipeline table default\n"
@@ -3489,6 +3677,7 @@ cmd_help(char **tokens,
 			"\tipsec sa delete\n"
 			"\tblock enable\n"
 			"\tblock disable\n"
+			"\tthread balance\n"
 			);
 		return;
 	}
@@ -3538,6 +3727,12 @@ cmd_help(char **tokens,
 		return;
 	}
 
+	if (!strcmp(tokens[0], "pipeline") &&
+		(n_tokens == 2) && !strcmp(tokens[1], "reload")) {
+		snprintf(out, out_size, "\n%s\n", cmd_pipeline_reload_help);
+		return;
+	}
+
 	if ((strcmp(tokens[0], "pipeline") == 0) &&
 		(n_tokens == 3) &&
 		(strcmp(tokens[1], "table") == 0) &&
@@ -3762,6 +3957,12 @@ cmd_help(char **tokens,
 		return;
 	}
 
+	if (!strcmp(tokens[0], "thread") &&
+		(n_tokens == 2) && !strcmp(tokens[1], "balance")) {
+		snprintf(out, out_size, "\n%s\n", cmd_thread_balance_help);
+		return;
+	}
+
 	snprintf(out, out_size, "Invalid command\n");
 }
 
@@ -3836,6 +4037,11 @@ cli_process(char *in, char *out, size_t out_size, void *obj)
 			return;
 		}
 
+		if (n_tokens >= 3 && !strcmp(tokens[2], "reload")) {
+			cmd_pipeline_reload(tokens, n_tokens, out, out_size, obj);
+			return;
+		}
+
 		if ((n_tokens >= 5) &&
 			(strcmp(tokens[2], "table") == 0) &&
 			(strcmp(tokens[4], "add") == 0)) {
@@ -4038,6 +4244,13 @@ cli_process(char *in, char *out, size_t out_size, void *obj)
 		}
 	}
 
+	if (!strcmp(tokens[0], "thread")) {
+		if (n_tokens >= 2 && !strcmp(tokens[1], "balance")) {
+			cmd_thread_balance(tokens, n_tokens, out, out_size, obj);
+			return;
+		}
+	}
+
 	snprintf(out, out_size, MSG_CMD_UNKNOWN, tokens[0]);
 }
 
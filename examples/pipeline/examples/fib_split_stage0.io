@@ -0,0 +1,17 @@
+; SPDX-License-Identifier: BSD-3-Clause
+; Copyright(C) 2026 Marvell.
+
+;
+; Pipeline input ports.
+;
+; Note: Customize the parameters below to match your setup.
+;
+port in 0 ethdev 0000:18:00.0 rxq 0 bsz 32
+port in 1 ethdev 0000:18:00.1 rxq 0 bsz 32
+port in 2 ethdev 0000:3b:00.0 rxq 0 bsz 32
+port in 3 ethdev 0000:3b:00.1 rxq 0 bsz 32
+
+;
+; Pipeline output ports.
+;
+port out 0 ring RING0 bsz 32
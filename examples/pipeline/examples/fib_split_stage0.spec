@@ -0,0 +1,125 @@
+; SPDX-License-Identifier: BSD-3-Clause
+; Copyright(C) 2026 Marvell.
+
+; This example splits the FIB example (see fib.spec) into two pipeline stages running on different
+; CPU threads: this first stage does the routing table lookup and the next hop selection, the second
+; stage (see fib_split_stage1.spec) does the next hop table lookup and sends the packet out. The
+; stages are connected by a ring, which keeps the packet order.
+;
+; The meta-data is not kept across the pipelines, so the ID of the selected next hop is sent to the
+; second stage through the bridge header prepended to the packet, which the second stage removes.
+
+//
+// Headers
+//
+struct ethernet_h {
+	bit<48> dst_addr
+	bit<48> src_addr
+	bit<16> ethertype
+}
+
+struct ipv4_h {
+	bit<8> ver_ihl
+	bit<8> diffserv
+	bit<16> total_len
+	bit<16> identification
+	bit<16> flags_offset
+	bit<8> ttl
+	bit<8> protocol
+	bit<16> hdr_checksum
+	bit<32> src_addr
+	bit<32> dst_addr
+}
+
+struct bridge_h {
+	bit<32> nexthop_id
+}
+
+header ethernet instanceof ethernet_h
+header ipv4 instanceof ipv4_h
+header bridge instanceof bridge_h
+
+//
+// Meta-data
+//
+struct metadata_t {
+	bit<32> port_in
+	bit<32> port_out
+	bit<32> vrf_id
+	bit<32> dst_addr
+	bit<32> nexthop_group_id
+	bit<32> nexthop_id
+}
+
+metadata instanceof metadata_t
+
+//
+// Actions
+//
+struct nexthop_group_action_args_t {
+	bit<32> nexthop_group_id
+}
+
+action nexthop_group_action args instanceof nexthop_group_action_args_t {
+	mov m.nexthop_group_id t.nexthop_group_id
+	return
+}
+
+action drop args none {
+	drop
+}
+
+//
+// Tables
+//
+table routing_table {
+	key {
+		m.vrf_id exact
+		m.dst_addr lpm
+	}
+
+	actions {
+		nexthop_group_action
+		drop
+	}
+
+	default_action drop args none
+
+	size 1048576
+}
+
+selector nexthop_group_table {
+	group_id m.nexthop_group_id
+
+	selector {
+		h.ipv4.protocol
+		h.ipv4.src_addr
+		h.ipv4.dst_addr
+	}
+
+	member_id m.nexthop_id
+
+	n_groups_max 65536
+
+	n_members_per_group_max 64
+}
+
+//
+// Pipeline
+//
+apply {
+	rx m.port_in
+	extract h.ethernet
+	extract h.ipv4
+	mov m.vrf_id h.ipv4.src_addr
+	mov m.dst_addr h.ipv4.dst_addr
+	table routing_table
+	table nexthop_group_table
+	validate h.bridge
+	mov h.bridge.nexthop_id m.nexthop_id
+	emit h.bridge
+	emit h.ethernet
+	emit h.ipv4
+	mov m.port_out 0x0
+	tx m.port_out
+}
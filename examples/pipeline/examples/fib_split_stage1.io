@@ -0,0 +1,17 @@
+; SPDX-License-Identifier: BSD-3-Clause
+; Copyright(C) 2026 Marvell.
+
+;
+; Pipeline input ports.
+;
+port in 0 ring RING0 bsz 32
+
+;
+; Pipeline output ports.
+;
+; Note: Customize the parameters below to match your setup.
+;
+port out 0 ethdev 0000:18:00.0 txq 0 bsz 32
+port out 1 ethdev 0000:18:00.1 txq 0 bsz 32
+port out 2 ethdev 0000:3b:00.0 txq 0 bsz 32
+port out 3 ethdev 0000:3b:00.1 txq 0 bsz 32
@@ -0,0 +1,110 @@
+; SPDX-License-Identifier: BSD-3-Clause
+; Copyright(C) 2026 Marvell.
+
+; Second stage of the FIB example split into two pipeline stages, see fib_split_stage0.spec.
+
+//
+// Headers
+//
+struct ethernet_h {
+	bit<48> dst_addr
+	bit<48> src_addr
+	bit<16> ethertype
+}
+
+struct ipv4_h {
+	bit<8> ver_ihl
+	bit<8> diffserv
+	bit<16> total_len
+	bit<16> identification
+	bit<16> flags_offset
+	bit<8> ttl
+	bit<8> protocol
+	bit<16> hdr_checksum
+	bit<32> src_addr
+	bit<32> dst_addr
+}
+
+struct bridge_h {
+	bit<32> nexthop_id
+}
+
+header bridge instanceof bridge_h
+header ethernet instanceof ethernet_h
+header ipv4 instanceof ipv4_h
+
+//
+// Meta-data
+//
+struct metadata_t {
+	bit<32> port_in
+	bit<32> port_out
+	bit<32> nexthop_id
+}
+
+metadata instanceof metadata_t
+
+//
+// Actions
+//
+struct nexthop_action_args_t {
+	bit<48> ethernet_dst_addr
+	bit<48> ethernet_src_addr
+	bit<16> ethernet_ethertype
+	bit<32> port_out
+}
+
+action nexthop_action args instanceof nexthop_action_args_t {
+	//Set Ethernet header.
+	validate h.ethernet
+	mov h.ethernet.dst_addr t.ethernet_dst_addr
+	mov h.ethernet.src_addr t.ethernet_src_addr
+	mov h.ethernet.ethertype t.ethernet_ethertype
+
+	//Decrement the TTL and update the checksum within the IPv4 header.
+	cksub h.ipv4.hdr_checksum h.ipv4.ttl
+	sub h.ipv4.ttl 0x1
+	ckadd h.ipv4.hdr_checksum h.ipv4.ttl
+
+	//Set the output port.
+	mov m.port_out t.port_out
+
+	return
+}
+
+action drop args none {
+	drop
+}
+
+//
+// Tables
+//
+table nexthop_table {
+	key {
+		m.nexthop_id exact
+	}
+
+	actions {
+		nexthop_action
+		drop
+	}
+
+	default_action drop args none
+
+	size 1048576
+}
+
+//
+// Pipeline
+//
+apply {
+	rx m.port_in
+	extract h.bridge
+	extract h.ethernet
+	extract h.ipv4
+	mov m.nexthop_id h.bridge.nexthop_id
+	table nexthop_table
+	emit h.ethernet
+	emit h.ipv4
+	tx m.port_out
+}
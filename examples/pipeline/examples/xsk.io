@@ -0,0 +1,31 @@
+; SPDX-License-Identifier: BSD-3-Clause
+; Copyright(c) 2026 Intel Corporation
+
+;
+; Pipeline packet mirroring.
+;
+mirroring slots 4 sessions 64
+
+;
+; Pipeline input ports.
+;
+; The AF_XDP socket (XSK) ports read and write the kernel network interfaces directly, without an
+; ethdev in between. The output port of an interface must use a different queue than its input
+; port.
+;
+; Note: Customize the parameters below to match your setup.
+;
+port in 0 xsk veth0 rxq 0 frames 4096 mempool MEMPOOL0 bsz 32
+port in 1 xsk veth1 rxq 0 frames 4096 mempool MEMPOOL0 bsz 32
+port in 2 xsk veth2 rxq 0 frames 4096 mempool MEMPOOL0 bsz 32
+port in 3 xsk veth3 rxq 0 frames 4096 mempool MEMPOOL0 bsz 32
+
+;
+; Pipeline output ports.
+;
+; Note: Customize the parameters below to match your setup.
+;
+port out 0 xsk veth0 txq 1 frames 4096 bsz 32
+port out 1 xsk veth1 txq 1 frames 4096 bsz 32
+port out 2 xsk veth2 txq 1 frames 4096 bsz 32
+port out 3 xsk veth3 txq 1 frames 4096 bsz 32
@@ -182,6 +182,8 @@ main(int argc, char **argv)
 		conn_poll_for_conn(conn);
 
 		conn_poll_for_msg(conn);
+
+		thread_balance_poll();
 	}
 
 	/* clean up the EAL */
@@ -7,15 +7,13 @@
 
 #include <rte_atomic.h>
 #include <rte_common.h>
+#include <rte_cycles.h>
 #include <rte_lcore.h>
+#include <rte_pause.h>
 
 #include "obj.h"
 #include "thread.h"
 
-#ifndef THREAD_PIPELINES_MAX
-#define THREAD_PIPELINES_MAX                               256
-#endif
-
 #ifndef THREAD_BLOCKS_MAX
 #define THREAD_BLOCKS_MAX                                  256
 #endif
@@ -29,6 +27,21 @@
 #define PIPELINE_INSTR_QUANTA                              1000
 #endif
 
+/* Learner table expiry scan quanta: number of buckets of each learner table scanned after each
+ * pipeline instruction quanta, so the full table scan is spread over many dispatch loops.
+ */
+#ifndef PIPELINE_LEARNER_SCAN_QUANTA
+#define PIPELINE_LEARNER_SCAN_QUANTA                       8
+#endif
+
+/* Pipeline balancing threshold: a pipeline is moved to another thread only when the dispatch loop
+ * of the most loaded thread is longer than the one of the least loaded thread by more than this
+ * percentage, so the pipelines are not moved back and forth on small load variations.
+ */
+#ifndef THREAD_BALANCE_THRESHOLD
+#define THREAD_BALANCE_THRESHOLD                           10
+#endif
+
 /**
  * In this design, there is a single control plane (CP) thread and one or multiple data plane (DP)
  * threads. Each DP thread can run up to THREAD_PIPELINES_MAX pipelines and up to THREAD_BLOCKS_MAX
@@ -53,10 +66,24 @@ struct __rte_cache_aligned thread {
 	volatile uint64_t n_pipelines;
 	volatile uint64_t n_blocks;
 	int enabled;
+
+	/* Written by the DP thread: cycles spent in each pipeline, dispatch loop iterations. */
+	uint64_t pipeline_cycles[THREAD_PIPELINES_MAX];
+	volatile uint64_t n_loops;
+
+	/* CP thread only: counters at the last load measurement, cycles per loop of each pipeline. */
+	uint64_t pipeline_cycles_prev[THREAD_PIPELINES_MAX];
+	uint64_t pipeline_load[THREAD_PIPELINES_MAX];
+	uint64_t n_loops_prev;
+	uint64_t load;
 };
 
 static struct thread threads[RTE_MAX_LCORE];
 
+/* Periodic pipeline balancing, in TSC cycles, disabled when zero. */
+static uint64_t balance_period;
+static uint64_t balance_time_next;
+
 /**
  * Control plane (CP) thread.
  */
@@ -117,7 +144,7 @@ pipeline_find(struct rte_swx_pipeline *p)
 
 		for (i = 0; i < t->n_pipelines; i++)
 			if (t->pipelines[i] == p)
-				break;
+				return thread_id;
 	}
 
 	return thread_id;
@@ -137,12 +164,30 @@ block_find(void *b)
 
 		for (i = 0; i < t->n_blocks; i++)
 			if (t->blocks[i]->block == b)
-				break;
+				return thread_id;
 	}
 
 	return thread_id;
 }
 
+/* Wait for the DP thread to complete its current dispatch loop iteration, after which it no longer
+ * uses the pipelines removed before the call.
+ */
+static void
+thread_quiesce(struct thread *t)
+{
+	uint64_t n_loops = t->n_loops;
+
+	while (t->n_loops == n_loops)
+		rte_pause();
+}
+
+uint32_t
+pipeline_thread_get(struct rte_swx_pipeline *p)
+{
+	return pipeline_find(p);
+}
+
 /**
  * Enable a given pipeline to run on a specific DP thread.
  *
@@ -184,6 +229,8 @@ pipeline_enable(struct rte_swx_pipeline *p, uint32_t thread_id)
 
 	/* Install the new pipeline. */
 	t->pipelines[n_pipelines] = p;
+	t->pipeline_cycles_prev[n_pipelines] = t->pipeline_cycles[n_pipelines];
+	t->pipeline_load[n_pipelines] = 0;
 	rte_wmb();
 	t->n_pipelines = n_pipelines + 1;
 
@@ -220,6 +267,9 @@ pipeline_enable(struct rte_swx_pipeline *p, uint32_t thread_id)
  *
  * DP thread:
  *  - Reads t->n_pipelines before starting every new iteration through t->pipelines[].
+ *
+ * Once the DP thread completed its current dispatch loop iteration, it no longer runs the given
+ * pipeline, which can then be freed or enabled on another thread.
  */
 void
 pipeline_disable(struct rte_swx_pipeline *p)
@@ -255,12 +305,171 @@ pipeline_disable(struct rte_swx_pipeline *p)
 		rte_wmb();
 		t->n_pipelines = n_pipelines - 1;
 
+		thread_quiesce(t);
+
+		/* The load of the pipeline_last is measured again from its new position. */
+		if (i < n_pipelines - 1) {
+			t->pipeline_cycles_prev[i] = t->pipeline_cycles[i];
+			t->pipeline_load[i] = t->pipeline_load[n_pipelines - 1];
+		}
+
 		return;
 	}
 
 	return;
 }
 
+/**
+ * Pipeline balancing.
+ *
+ * The DP thread counts the cycles spent in each of its pipelines and its dispatch loop iterations.
+ * The load of a pipeline is the average number of cycles it takes in each dispatch loop iteration
+ * of its thread, and the load of a thread is the average duration of its dispatch loop iteration,
+ * i.e. the time it takes to get back to any of its pipelines.
+ *
+ * Each balancing pass measures the loads since the previous pass, then repeatedly moves a pipeline
+ * from the most loaded thread to the least loaded thread, picking the most loaded pipeline that
+ * reduces the difference between the two threads, until the difference is below the threshold.
+ */
+static void
+thread_load_update(struct thread *t)
+{
+	uint64_t n_loops = t->n_loops, n_pipelines = t->n_pipelines;
+	uint64_t n_loops_delta = n_loops - t->n_loops_prev;
+	uint32_t i;
+
+	t->n_loops_prev = n_loops;
+	t->load = 0;
+
+	for (i = 0; i < n_pipelines; i++) {
+		uint64_t cycles = t->pipeline_cycles[i];
+
+		t->pipeline_load[i] = n_loops_delta ?
+			(cycles - t->pipeline_cycles_prev[i]) / n_loops_delta : 0;
+		t->pipeline_cycles_prev[i] = cycles;
+		t->load += t->pipeline_load[i];
+	}
+}
+
+int
+thread_balance(uint32_t *n_moved)
+{
+	uint32_t thread_id, n_pipelines = 0, n = 0;
+
+	RTE_LCORE_FOREACH_WORKER(thread_id) {
+		struct thread *t = &threads[thread_id];
+
+		if (!t->enabled)
+			continue;
+
+		thread_load_update(t);
+		n_pipelines += t->n_pipelines;
+	}
+
+	/* Each pipeline is moved at most once per pass. */
+	for ( ; n < n_pipelines; n++) {
+		struct thread *t_max = NULL, *t_min = NULL;
+		struct rte_swx_pipeline *p;
+		uint32_t thread_id_min = 0, i, pos = 0;
+		uint64_t load_max = 0;
+		int status;
+
+		RTE_LCORE_FOREACH_WORKER(thread_id) {
+			struct thread *t = &threads[thread_id];
+
+			if (!t->enabled)
+				continue;
+
+			if (!t_max || t->load > t_max->load)
+				t_max = t;
+
+			if (!t_min || t->load < t_min->load) {
+				t_min = t;
+				thread_id_min = thread_id;
+			}
+		}
+
+		if (!t_max || t_max == t_min ||
+		    (t_max->load - t_min->load) * 100 <= t_max->load * THREAD_BALANCE_THRESHOLD)
+			break;
+
+		for (i = 0; i < t_max->n_pipelines; i++) {
+			uint64_t load = t_max->pipeline_load[i];
+
+			if (load > load_max && load < t_max->load - t_min->load) {
+				load_max = load;
+				pos = i;
+			}
+		}
+
+		if (!load_max)
+			break;
+
+		p = t_max->pipelines[pos];
+		pipeline_disable(p);
+		status = pipeline_enable(p, thread_id_min);
+		if (status)
+			return status;
+
+		t_min->pipeline_load[t_min->n_pipelines - 1] = load_max;
+		t_max->load -= load_max;
+		t_min->load += load_max;
+	}
+
+	if (n_moved)
+		*n_moved = n;
+
+	return 0;
+}
+
+int
+thread_balance_period_set(uint32_t period_ms)
+{
+	balance_period = rte_get_tsc_hz() * period_ms / 1000;
+	balance_time_next = rte_get_tsc_cycles() + balance_period;
+
+	return 0;
+}
+
+void
+thread_balance_poll(void)
+{
+	uint64_t time;
+
+	if (!balance_period)
+		return;
+
+	time = rte_get_tsc_cycles();
+	if (time < balance_time_next)
+		return;
+
+	balance_time_next = time + balance_period;
+	thread_balance(NULL);
+}
+
+uint32_t
+thread_pipelines_get(uint32_t thread_id,
+		     struct rte_swx_pipeline **pipelines,
+		     uint64_t *loads,
+		     uint32_t n_max)
+{
+	struct thread *t;
+	uint32_t n, i;
+
+	if (thread_id >= RTE_MAX_LCORE || !threads[thread_id].enabled)
+		return 0;
+
+	t = &threads[thread_id];
+	n = RTE_MIN(t->n_pipelines, n_max);
+
+	for (i = 0; i < n; i++) {
+		pipelines[i] = t->pipelines[i];
+		loads[i] = t->pipeline_load[i];
+	}
+
+	return n;
+}
+
 int
 block_enable(block_run_f block_func, void *block, uint32_t thread_id)
 {
@@ -363,8 +572,14 @@ thread_main(void *arg __rte_unused)
 		uint32_t i;
 
 		/* Pipelines. */
-		for (i = 0; i < t->n_pipelines; i++)
+		for (i = 0; i < t->n_pipelines; i++) {
+			uint64_t time = rte_rdtsc();
+
 			rte_swx_pipeline_run(t->pipelines[i], PIPELINE_INSTR_QUANTA);
+			rte_swx_pipeline_learner_scan(t->pipelines[i], PIPELINE_LEARNER_SCAN_QUANTA);
+
+			t->pipeline_cycles[i] += rte_rdtsc() - time;
+		}
 
 		/* Blocks. */
 		for (i = 0; i < t->n_blocks; i++) {
@@ -372,6 +587,8 @@ thread_main(void *arg __rte_unused)
 
 			b->block_func(b->block);
 		}
+
+		t->n_loops++;
 	}
 
 	return 0;
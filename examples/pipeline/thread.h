@@ -9,6 +9,10 @@
 
 #include <rte_swx_pipeline.h>
 
+#ifndef THREAD_PIPELINES_MAX
+#define THREAD_PIPELINES_MAX                               256
+#endif
+
 /**
  * Control plane (CP) thread.
  */
@@ -21,6 +25,24 @@ pipeline_enable(struct rte_swx_pipeline *p, uint32_t thread_id);
 void
 pipeline_disable(struct rte_swx_pipeline *p);
 
+uint32_t
+pipeline_thread_get(struct rte_swx_pipeline *p);
+
+int
+thread_balance(uint32_t *n_moved);
+
+int
+thread_balance_period_set(uint32_t period_ms);
+
+void
+thread_balance_poll(void);
+
+uint32_t
+thread_pipelines_get(uint32_t thread_id,
+		     struct rte_swx_pipeline **pipelines,
+		     uint64_t *loads,
+		     uint32_t n_max);
+
 typedef void
 (*block_run_f)(void *block);
 
@@ -13,6 +13,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <signal.h>
 #include <rte_eal.h>
 #include <rte_eventdev.h>
@@ -47,6 +48,7 @@ int count, i, j;
 printf("\n=== Ring Buffer Sink Demo ===\n");
 
 /* Create ring buffer sink */
+memset(&rb_conf, 0, sizeof(rb_conf));
 rb_conf.max_entries = 100;
 rb_sink = rte_sampler_sink_ringbuffer_create(session, "ringbuffer", &rb_conf);
 if (rb_sink == NULL) {
@@ -159,15 +161,21 @@ static void
 		demo_ctf_sink(struct rte_sampler_session *session)
 {
 struct rte_sampler_sink_ctf_conf ctf_conf;
+struct rte_sampler_sink_ctf_buffer_conf buffer_conf;
 struct rte_sampler_sink *ctf_sink;
 
 printf("\n=== CTF Sink Demo ===\n");
 
-/* Create CTF sink */
+/* Create CTF sink, buffering up to 64 KB or 100 ms of samples */
+memset(&ctf_conf, 0, sizeof(ctf_conf));
 ctf_conf.trace_dir = "/tmp/sampler_trace";
 ctf_conf.trace_name = "sampler";
+memset(&buffer_conf, 0, sizeof(buffer_conf));
+buffer_conf.packet_size = 64 * 1024;
+buffer_conf.flush_interval_us = 100 * 1000;
 
-ctf_sink = rte_sampler_sink_ctf_create(session, "ctf_sink", &ctf_conf);
+ctf_sink = rte_sampler_sink_ctf_create_buffered(session, "ctf_sink", &ctf_conf,
+		&buffer_conf);
 if (ctf_sink == NULL) {
 printf("Failed to create CTF sink\n");
 return;
@@ -181,7 +189,7 @@ rte_delay_ms(3000);
 
 rte_sampler_sink_ctf_destroy(ctf_sink);
 printf("\nCTF trace written to %s/\n", ctf_conf.trace_dir);
-printf("View with: babeltrace %s\n", ctf_conf.trace_dir);
+printf("View with: babeltrace2 %s\n", ctf_conf.trace_dir);
 }
 
 int
@@ -18,6 +18,8 @@
 
 #include <rte_cycles.h>
 #include <rte_ethdev.h>
+#include <rte_hash.h>
+#include <rte_hash_crc.h>
 #include <rte_log.h>
 #include <rte_string_fns.h>
 #include <rte_malloc.h>
@@ -76,6 +78,13 @@ struct dma_for_vhost dma_bind[RTE_MAX_VHOST_DEVICE];
 int16_t dmas_id[RTE_DMADEV_DEFAULT_MAX];
 static int dma_count;
 
+/* DMA devices shared out to the data cores, for the devices without a given DMA device. */
+static int16_t dma_pool[VIRTIO_QNUM][RTE_DMADEV_DEFAULT_MAX];
+static int dma_pool_count[VIRTIO_QNUM];
+
+/* MAC address of the learned devices to device lookup table. */
+static struct rte_hash *mac_table;
+
 /* mask of enabled ports */
 static uint32_t enabled_port_mask = 0;
 
@@ -237,6 +246,17 @@ is_dma_configured(int16_t dev_id)
 	return false;
 }
 
+static inline bool
+is_dma_pooled(int vring_id, int dev_id)
+{
+	int i;
+
+	for (i = 0; i < dma_pool_count[vring_id]; i++)
+		if (dma_pool[vring_id][i] == dev_id)
+			return true;
+	return false;
+}
+
 static inline int
 open_dma(const char *value)
 {
@@ -313,7 +333,10 @@ open_dma(const char *value)
 
 		start += 3;
 		socketid = strtol(start, &end, 0);
-		if (end == start) {
+		/* No device index, the DMA device is added to the pool. */
+		if (end == start)
+			socketid = -1;
+		else if (socketid < 0 || socketid >= RTE_MAX_VHOST_DEVICE) {
 			ret = -1;
 			goto out;
 		}
@@ -373,8 +396,13 @@ open_dma(const char *value)
 		dmas_id[dma_count++] = dev_id;
 
 done:
-		(dma_info + socketid)->dmas[vring_id].dev_id = dev_id;
-		(dma_info + socketid)->async_flag |= async_flag;
+		if (socketid < 0) {
+			if (!is_dma_pooled(vring_id, dev_id))
+				dma_pool[vring_id][dma_pool_count[vring_id]++] = dev_id;
+		} else {
+			(dma_info + socketid)->dmas[vring_id].dev_id = dev_id;
+			(dma_info + socketid)->async_flag |= async_flag;
+		}
 		i++;
 	}
 out:
@@ -923,15 +951,56 @@ static unsigned check_ports_num(unsigned nb_ports)
 static __rte_always_inline struct vhost_dev *
 find_vhost_dev(struct rte_ether_addr *mac)
 {
-	struct vhost_dev *vdev;
+	void *vdev;
 
-	TAILQ_FOREACH(vdev, &vhost_dev_list, global_vdev_entry) {
-		if (vdev->ready == DEVICE_RX &&
-		    rte_is_same_ether_addr(mac, &vdev->mac_address))
-			return vdev;
-	}
+	if (rte_hash_lookup_data(mac_table, mac, &vdev) < 0)
+		return NULL;
 
-	return NULL;
+	return vdev;
+}
+
+/*
+ * Look up the destination devices of a burst of packets in the MAC table,
+ * setting the device of the packets not sent to a local device to NULL.
+ */
+static __rte_always_inline void
+find_vhost_devs(struct rte_mbuf **pkts, uint16_t count,
+	struct vhost_dev **dst_vdevs)
+{
+	const void *keys[MAX_PKT_BURST];
+	uint64_t hit_mask = 0;
+	uint16_t i;
+
+	for (i = 0; i < count; i++)
+		keys[i] = &rte_pktmbuf_mtod(pkts[i], struct rte_ether_hdr *)->dst_addr;
+
+	rte_hash_lookup_bulk_data(mac_table, keys, count, &hit_mask,
+				  (void **)dst_vdevs);
+
+	for (i = 0; i < count; i++)
+		if (!(hit_mask & (1ULL << i)))
+			dst_vdevs[i] = NULL;
+}
+
+static int
+create_mac_table(void)
+{
+	struct rte_hash_parameters params = {
+		.name = "vhost_mac_table",
+		.entries = RTE_MAX_VHOST_DEVICE,
+		.key_len = RTE_ETHER_ADDR_LEN,
+		.hash_func = rte_hash_crc,
+		.socket_id = rte_socket_id(),
+		/* Devices are learned by all data cores, while they look up. */
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD |
+			RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF,
+	};
+
+	mac_table = rte_hash_create(&params);
+	if (mac_table == NULL)
+		return -1;
+
+	return 0;
 }
 
 /*
@@ -980,6 +1049,12 @@ link_vmdq(struct vhost_dev *vdev, struct rte_mbuf *m)
 	/* Set device as ready for RX. */
 	vdev->ready = DEVICE_RX;
 
+	/* Make the device a local destination. */
+	if (rte_hash_add_key_data(mac_table, &vdev->mac_address, vdev) < 0)
+		RTE_LOG(ERR, VHOST_DATA,
+			"(%d) failed to add device MAC address to MAC table\n",
+			vdev->vid);
+
 	return 0;
 }
 
@@ -995,6 +1070,12 @@ unlink_vmdq(struct vhost_dev *vdev)
 	struct rte_mbuf *pkts_burst[MAX_PKT_BURST];
 
 	if (vdev->ready == DEVICE_RX) {
+		/*
+		 * The key slot is freed once no data core can be
+		 * looking up the device, in destroy_device().
+		 */
+		vdev->mac_key_pos = rte_hash_del_key(mac_table, &vdev->mac_address);
+
 		/*clear MAC and VLAN settings*/
 		rte_eth_dev_mac_addr_remove(ports[0], &vdev->mac_address);
 		for (i = 0; i < 6; i++)
@@ -1119,15 +1200,12 @@ drain_vhost_table(void)
  * the packet on that devices RX queue. If not then return.
  */
 static __rte_always_inline int
-virtio_tx_local(struct vhost_dev *vdev, struct rte_mbuf *m)
+virtio_tx_local(struct vhost_dev *vdev, struct vhost_dev *dst_vdev,
+	struct rte_mbuf *m)
 {
-	struct rte_ether_hdr *pkt_hdr;
-	struct vhost_dev *dst_vdev;
 	struct vhost_bufftable *vhost_txq;
 	uint16_t lcore_id = rte_lcore_id();
-	pkt_hdr = rte_pktmbuf_mtod(m, struct rte_ether_hdr *);
 
-	dst_vdev = find_vhost_dev(&pkt_hdr->dst_addr);
 	if (!dst_vdev)
 		return -1;
 
@@ -1168,14 +1246,9 @@ virtio_tx_local(struct vhost_dev *vdev, struct rte_mbuf *m)
  * and get its vlan tag, and offset if it is.
  */
 static __rte_always_inline int
-find_local_dest(struct vhost_dev *vdev, struct rte_mbuf *m,
+find_local_dest(struct vhost_dev *vdev, struct vhost_dev *dst_vdev,
 	uint32_t *offset, uint16_t *vlan_tag)
 {
-	struct vhost_dev *dst_vdev;
-	struct rte_ether_hdr *pkt_hdr =
-		rte_pktmbuf_mtod(m, struct rte_ether_hdr *);
-
-	dst_vdev = find_vhost_dev(&pkt_hdr->dst_addr);
 	if (!dst_vdev)
 		return 0;
 
@@ -1246,10 +1319,12 @@ do_drain_mbuf_table(struct mbuf_table *tx_q)
 
 /*
  * This function routes the TX packet to the correct interface. This
- * may be a local device or the physical port.
+ * may be a local device, looked up in the MAC table as dst_vdev, or the
+ * physical port.
  */
 static __rte_always_inline void
-virtio_tx_route(struct vhost_dev *vdev, struct rte_mbuf *m, uint16_t vlan_tag)
+virtio_tx_route(struct vhost_dev *vdev, struct vhost_dev *dst_vdev,
+	struct rte_mbuf *m, uint16_t vlan_tag)
 {
 	struct mbuf_table *tx_q;
 	unsigned offset = 0;
@@ -1269,11 +1344,12 @@ virtio_tx_route(struct vhost_dev *vdev, struct rte_mbuf *m, uint16_t vlan_tag)
 	}
 
 	/*check if destination is local VM*/
-	if ((vm2vm_mode == VM2VM_SOFTWARE) && (virtio_tx_local(vdev, m) == 0))
+	if ((vm2vm_mode == VM2VM_SOFTWARE) &&
+	    (virtio_tx_local(vdev, dst_vdev, m) == 0))
 		return;
 
 	if (unlikely(vm2vm_mode == VM2VM_HARDWARE)) {
-		if (unlikely(find_local_dest(vdev, m, &offset,
+		if (unlikely(find_local_dest(vdev, dst_vdev, &offset,
 					     &vlan_tag) != 0)) {
 			rte_pktmbuf_free(m);
 			return;
@@ -1444,20 +1520,31 @@ static __rte_always_inline void
 drain_virtio_tx(struct vhost_dev *vdev)
 {
 	struct rte_mbuf *pkts[MAX_PKT_BURST];
+	struct vhost_dev *dst_vdevs[MAX_PKT_BURST];
 	uint16_t count;
 	uint16_t i;
 
 	count = vdev_queue_ops[vdev->vid].dequeue_pkt_burst(vdev,
 				VIRTIO_TXQ, mbuf_pool, pkts, MAX_PKT_BURST);
+	if (count == 0)
+		return;
 
 	/* setup VMDq for the first packet */
-	if (unlikely(vdev->ready == DEVICE_MAC_LEARNING) && count) {
-		if (vdev->remove || link_vmdq(vdev, pkts[0]) == -1)
+	if (unlikely(vdev->ready == DEVICE_MAC_LEARNING)) {
+		if (vdev->remove || link_vmdq(vdev, pkts[0]) == -1) {
 			free_pkts(pkts, count);
+			return;
+		}
 	}
 
+	/* Look up the local destinations of the whole burst at once. */
+	if (vm2vm_mode != VM2VM_DISABLED)
+		find_vhost_devs(pkts, count, dst_vdevs);
+	else
+		memset(dst_vdevs, 0, count * sizeof(dst_vdevs[0]));
+
 	for (i = 0; i < count; ++i)
-		virtio_tx_route(vdev, pkts[i], vlan_tags[vdev->vid]);
+		virtio_tx_route(vdev, dst_vdevs[i], pkts[i], vlan_tags[vdev->vid]);
 }
 
 /*
@@ -1618,20 +1705,25 @@ destroy_device(int vid)
 
 	lcore_info[vdev->coreid].device_num--;
 
+	if (vdev->mac_key_pos >= 0)
+		rte_hash_free_key_with_position(mac_table, vdev->mac_key_pos);
+
 	RTE_LOG(INFO, VHOST_DATA,
 		"(%d) device has been removed from data core\n",
 		vdev->vid);
 
-	if (dma_bind[vid].dmas[VIRTIO_RXQ].async_enabled) {
-		vhost_clear_queue(vdev, VIRTIO_RXQ);
-		rte_vhost_async_channel_unregister(vid, VIRTIO_RXQ);
-		dma_bind[vid].dmas[VIRTIO_RXQ].async_enabled = false;
-	}
+	for (i = 0; i < VIRTIO_QNUM; i++) {
+		struct dma_info *dma = &dma_bind[vid2socketid[vid]].dmas[i];
+
+		if (dma->async_enabled) {
+			vhost_clear_queue(vdev, i);
+			rte_vhost_async_channel_unregister(vid, i);
+			dma->async_enabled = false;
+		}
 
-	if (dma_bind[vid].dmas[VIRTIO_TXQ].async_enabled) {
-		vhost_clear_queue(vdev, VIRTIO_TXQ);
-		rte_vhost_async_channel_unregister(vid, VIRTIO_TXQ);
-		dma_bind[vid].dmas[VIRTIO_TXQ].async_enabled = false;
+		/* The device may be added to another data core next time. */
+		if (dma->pooled)
+			dma->dev_id = INVALID_DMA_ID;
 	}
 
 	rte_free(vdev);
@@ -1737,6 +1829,23 @@ new_device(int vid)
 
 	init_vid2socketid_array(vid, socketid);
 
+	/* Find a suitable lcore to add the device. */
+	RTE_LCORE_FOREACH_WORKER(lcore) {
+		if (lcore_info[lcore].device_num < device_num_min) {
+			device_num_min = lcore_info[lcore].device_num;
+			core_add = lcore;
+		}
+	}
+	vdev->coreid = core_add;
+
+	/* Use the pooled DMA devices of the data core. */
+	for (i = 0; i < VIRTIO_QNUM; i++) {
+		struct dma_info *dma = &dma_bind[socketid].dmas[i];
+
+		if (dma->pooled)
+			dma->dev_id = lcore_info[vdev->coreid].dma_id[i];
+	}
+
 	ret =  vhost_async_channel_register(vid);
 
 	if (init_vhost_queue_ops(vid) != 0)
@@ -1751,15 +1860,7 @@ new_device(int vid)
 	/*reset ready flag*/
 	vdev->ready = DEVICE_MAC_LEARNING;
 	vdev->remove = 0;
-
-	/* Find a suitable lcore to add the device. */
-	RTE_LCORE_FOREACH_WORKER(lcore) {
-		if (lcore_info[lcore].device_num < device_num_min) {
-			device_num_min = lcore_info[lcore].device_num;
-			core_add = lcore;
-		}
-	}
-	vdev->coreid = core_add;
+	vdev->mac_key_pos = -1;
 
 	TAILQ_INSERT_TAIL(&lcore_info[vdev->coreid].vdev_list, vdev,
 			  lcore_vdev_entry);
@@ -1883,6 +1984,49 @@ sigint_handler(__rte_unused int signum)
 	exit(0);
 }
 
+/*
+ * Give each data core its own DMA devices from the pool. The devices without
+ * a given DMA device use the DMA devices of the data core they are added to,
+ * instead of all sharing the same DMA channels. The devices of the data cores
+ * left without a DMA device use the sync data path.
+ */
+static void
+share_dma_pool(void)
+{
+	unsigned int lcore;
+	int i, q, used[VIRTIO_QNUM] = { 0 };
+
+	RTE_LCORE_FOREACH_WORKER(lcore) {
+		for (q = 0; q < VIRTIO_QNUM; q++) {
+			if (used[q] < dma_pool_count[q])
+				lcore_info[lcore].dma_id[q] = dma_pool[q][used[q]++];
+			else
+				lcore_info[lcore].dma_id[q] = INVALID_DMA_ID;
+		}
+	}
+
+	for (q = 0; q < VIRTIO_QNUM; q++) {
+		if (dma_pool_count[q] == 0)
+			continue;
+
+		if (used[q] < (int)rte_lcore_count() - 1)
+			RTE_LOG(WARNING, VHOST_CONFIG,
+				"Only %d of the data cores use a DMA device for %s\n",
+				used[q], q == VIRTIO_RXQ ? "enqueue" : "dequeue");
+
+		for (i = 0; i < nb_sockets; i++) {
+			struct dma_for_vhost *dma = &dma_bind[i];
+
+			if (dma->dmas[q].dev_id != INVALID_DMA_ID)
+				continue;
+
+			dma->dmas[q].pooled = true;
+			dma->async_flag |= q == VIRTIO_RXQ ?
+				ASYNC_ENQUEUE_VHOST : ASYNC_DEQUEUE_VHOST;
+		}
+	}
+}
+
 static void
 reset_dma(void)
 {
@@ -1894,6 +2038,7 @@ reset_dma(void)
 		for (j = 0; j < RTE_MAX_QUEUES_PER_PORT * 2; j++) {
 			dma_bind[i].dmas[j].dev_id = INVALID_DMA_ID;
 			dma_bind[i].dmas[j].async_enabled = false;
+			dma_bind[i].dmas[j].pooled = false;
 		}
 	}
 
@@ -1968,6 +2113,11 @@ main(int argc, char *argv[])
 	if (mbuf_pool == NULL)
 		rte_exit(EXIT_FAILURE, "Cannot create mbuf pool\n");
 
+	if (create_mac_table() != 0)
+		rte_exit(EXIT_FAILURE, "Cannot create MAC table\n");
+
+	share_dma_pool();
+
 	if (vm2vm_mode == VM2VM_HARDWARE) {
 		/* Enable VT loop back to let L2 switch to do it. */
 		vmdq_conf_default.rx_adv_conf.vmdq_rx_conf.enable_loop_back = 1;
@@ -47,6 +47,8 @@ struct __rte_cache_aligned vhost_dev {
 	volatile uint8_t ready;
 	/**< Device is marked for removal from the data core. */
 	volatile uint8_t remove;
+	/**< Position of the MAC address in the MAC table, freed on removal. */
+	int32_t mac_key_pos;
 
 	int vid;
 	uint64_t features;
@@ -89,6 +91,9 @@ struct lcore_info {
 	/* Flag to synchronize device removal. */
 	volatile uint8_t	dev_removal_flag;
 
+	/* DMA devices of the pool used by the devices of this core. */
+	int16_t			dma_id[VIRTIO_QNUM];
+
 	struct vhost_dev_tailq_list vdev_list;
 };
 
@@ -96,6 +101,8 @@ struct dma_info {
 	struct rte_pci_addr addr;
 	int16_t dev_id;
 	bool async_enabled;
+	/* DMA device taken from the pool of the data core of the device. */
+	bool pooled;
 };
 
 struct dma_for_vhost {
@@ -2,9 +2,13 @@
  * Copyright(c) 2010-2014 Intel Corporation
  */
 
+#include <stdio.h>
+
 #include <eal_export.h>
 #include <rte_acl.h>
 #include <rte_log.h>
+#include <rte_stdatomic.h>
+#include <rte_thread.h>
 
 #include "tb_mem.h"
 #include "acl.h"
@@ -69,6 +73,8 @@ struct rte_acl_build_rule {
 	uint32_t                    *wildness;
 };
 
+struct acl_build_job;
+
 /* Context for build phase */
 struct acl_build_context {
 	const struct rte_acl_ctx *acx;
@@ -84,6 +90,7 @@ struct acl_build_context {
 	uint32_t                  src_mask;
 	uint32_t                  num_build_rules;
 	uint32_t                  num_tries;
+	uint32_t                  num_workers;
 	struct tb_mem_pool        pool;
 	struct rte_acl_trie       tries[RTE_ACL_MAX_TRIES];
 	struct rte_acl_bld_trie   bld_tries[RTE_ACL_MAX_TRIES];
@@ -92,6 +99,19 @@ struct acl_build_context {
 	/* memory free lists for nodes and blocks used for node ptrs */
 	struct acl_mem_block      blocks[MEM_BLOCK_NUM];
 	struct rte_acl_node       *node_free_list;
+
+	/* rebuilds of the split tries, run by worker threads */
+	struct acl_build_job      *jobs[RTE_ACL_MAX_TRIES];
+};
+
+/* Rebuild of a trie for its reduced rule-set, with its own build context. */
+struct acl_build_job {
+	struct acl_build_context  bcx;
+	struct rte_acl_build_rule *rule_sets[RTE_ACL_MAX_TRIES];
+	uint32_t                  n;
+	int32_t                   rc;
+	RTE_ATOMIC(uint32_t)      done;
+	rte_thread_t              tid;
 };
 
 static int acl_merge_trie(struct acl_build_context *context,
@@ -1345,6 +1365,113 @@ build_one_trie(struct acl_build_context *context,
 	return last;
 }
 
+static uint32_t
+acl_build_job_run(void *arg)
+{
+	struct acl_build_job *job;
+	struct rte_acl_build_rule *last;
+	int32_t rc;
+
+	job = arg;
+
+	rc = sigsetjmp(job->bcx.pool.fail, 0);
+	if (rc == 0) {
+		last = build_one_trie(&job->bcx, job->rule_sets, job->n,
+			INT32_MAX);
+		if (job->bcx.bld_tries[job->n].trie == NULL || last != NULL)
+			rc = -ENOMEM;
+	}
+
+	job->rc = rc;
+	rte_atomic_store_explicit(&job->done, 1, rte_memory_order_release);
+	return 0;
+}
+
+/*
+ * Start the rebuild of the n-th trie on a worker thread.
+ * Returns non-zero if no worker is available,
+ * the caller then rebuilds the trie itself.
+ */
+static int
+acl_build_job_start(struct acl_build_context *context,
+	struct rte_acl_build_rule *head, uint32_t n)
+{
+	char name[RTE_THREAD_INTERNAL_NAME_SIZE];
+	struct acl_build_job *job;
+	uint32_t i, k;
+
+	k = 0;
+	for (i = 0; i != RTE_DIM(context->jobs); i++) {
+		job = context->jobs[i];
+		if (job != NULL && rte_atomic_load_explicit(&job->done,
+				rte_memory_order_relaxed) == 0)
+			k++;
+	}
+	if (k >= context->num_workers)
+		return -ENOSPC;
+
+	job = tb_alloc(&context->pool, sizeof(*job));
+	memset(job, 0, sizeof(*job));
+	job->bcx.acx = context->acx;
+	/* the field definitions may be changed by another job */
+	job->bcx.cfg.num_categories = context->cfg.num_categories;
+	job->bcx.category_mask = context->category_mask;
+	job->bcx.node_max = context->node_max;
+	job->bcx.pool.alignment = ACL_POOL_ALIGN;
+	job->bcx.pool.min_alloc = ACL_POOL_ALLOC_MIN;
+	job->rule_sets[n] = head;
+	job->n = n;
+
+	snprintf(name, sizeof(name), "acl-bld%u", n);
+	if (rte_thread_create_internal_control(&job->tid, name,
+			acl_build_job_run, job) != 0)
+		return -ENOSPC;
+
+	context->jobs[n] = job;
+	return 0;
+}
+
+/*
+ * Wait for the worker threads and collect the tries they built.
+ */
+static int
+acl_build_job_join(struct acl_build_context *context)
+{
+	struct acl_build_job *job;
+	uint32_t n;
+	int32_t rc;
+
+	rc = 0;
+	for (n = 0; n != RTE_DIM(context->jobs); n++) {
+		job = context->jobs[n];
+		if (job == NULL)
+			continue;
+
+		rte_thread_join(job->tid, NULL);
+		if (job->rc != 0) {
+			ACL_LOG(ERR, "Build of %u-th trie failed", n);
+			rc = job->rc;
+		}
+
+		context->tries[n] = job->bcx.tries[n];
+		context->bld_tries[n] = job->bcx.bld_tries[n];
+		context->num_nodes += job->bcx.num_nodes;
+	}
+
+	return rc;
+}
+
+static void
+acl_build_job_free(struct acl_build_context *context)
+{
+	uint32_t n;
+
+	for (n = 0; n != RTE_DIM(context->jobs); n++) {
+		if (context->jobs[n] != NULL)
+			tb_free_pool(&context->jobs[n]->bcx.pool);
+	}
+}
+
 static int
 acl_build_tries(struct acl_build_context *context,
 	struct rte_acl_build_rule *head)
@@ -1407,7 +1534,12 @@ acl_build_tries(struct acl_build_context *context,
 		/*
 		 * Rebuild the trie for the reduced rule-set.
 		 * Don't try to split it any further.
+		 * If possible, do it on a worker thread,
+		 * while splitting the remaining rules.
 		 */
+		if (acl_build_job_start(context, rule_sets[n], n) == 0)
+			continue;
+
 		last = build_one_trie(context, rule_sets, n, INT32_MAX);
 		if (context->bld_tries[n].trie == NULL || last != NULL) {
 			ACL_LOG(ERR, "Build of %u-th trie failed", n);
@@ -1424,6 +1556,13 @@ static void
 acl_build_log(const struct acl_build_context *ctx)
 {
 	uint32_t n;
+	size_t alloc;
+
+	alloc = ctx->pool.alloc;
+	for (n = 0; n != RTE_DIM(ctx->jobs); n++) {
+		if (ctx->jobs[n] != NULL)
+			alloc += ctx->jobs[n]->bcx.pool.alloc;
+	}
 
 	RTE_LOG(DEBUG, ACL, "Build phase for ACL \"%s\":\n"
 		"node limit for tree split: %u\n"
@@ -1432,7 +1571,7 @@ acl_build_log(const struct acl_build_context *ctx)
 		ctx->acx->name,
 		ctx->node_max,
 		ctx->num_nodes,
-		ctx->pool.alloc);
+		alloc);
 
 	for (n = 0; n < RTE_DIM(ctx->tries); n++) {
 		if (ctx->tries[n].count != 0)
@@ -1509,7 +1648,8 @@ acl_set_data_indexes(struct rte_acl_ctx *ctx)
  */
 static int
 acl_bld(struct acl_build_context *bcx, struct rte_acl_ctx *ctx,
-	const struct rte_acl_config *cfg, uint32_t node_max)
+	const struct rte_acl_config *cfg, uint32_t node_max,
+	uint32_t num_workers)
 {
 	int32_t rc;
 
@@ -1522,6 +1662,7 @@ acl_bld(struct acl_build_context *bcx, struct rte_acl_ctx *ctx,
 	bcx->category_mask = RTE_LEN2MASK(bcx->cfg.num_categories,
 		typeof(bcx->category_mask));
 	bcx->node_max = node_max;
+	bcx->num_workers = num_workers;
 
 	rc = sigsetjmp(bcx->pool.fail, 0);
 
@@ -1622,11 +1763,11 @@ get_first_load_size(const struct rte_acl_config *cfg)
 	return (ofs < max_ofs) ? sizeof(uint32_t) : sizeof(uint8_t);
 }
 
-RTE_EXPORT_SYMBOL(rte_acl_build)
-int
-rte_acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg)
+static int
+acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg,
+	uint32_t num_workers)
 {
-	int32_t rc;
+	int32_t rc, rcj;
 	uint32_t n;
 	size_t max_size;
 	struct acl_build_context bcx;
@@ -1648,7 +1789,12 @@ rte_acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg)
 	for (rc = -ERANGE; n >= NODE_MIN && rc == -ERANGE; n /= 2) {
 
 		/* perform build phase. */
-		rc = acl_bld(&bcx, ctx, cfg, n);
+		rc = acl_bld(&bcx, ctx, cfg, n, num_workers);
+
+		/* wait for the tries built by the worker threads. */
+		rcj = acl_build_job_join(&bcx);
+		if (rc == 0)
+			rc = rcj;
 
 		if (rc == 0) {
 			/* allocate and fill run-time  structures. */
@@ -1671,8 +1817,24 @@ rte_acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg)
 		acl_build_log(&bcx);
 
 		/* cleanup after build. */
+		acl_build_job_free(&bcx);
 		tb_free_pool(&bcx.pool);
 	}
 
 	return rc;
 }
+
+RTE_EXPORT_SYMBOL(rte_acl_build)
+int
+rte_acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg)
+{
+	return acl_build(ctx, cfg, 0);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_build_mt, 26.03)
+int
+rte_acl_build_mt(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg,
+	uint32_t num_workers)
+{
+	return acl_build(ctx, cfg, num_workers);
+}
@@ -0,0 +1,726 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <eal_export.h>
+#include <rte_acl.h>
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_rcu_qsbr.h>
+#include <rte_spinlock.h>
+#include <rte_stdatomic.h>
+#include <rte_string_fns.h>
+
+#include "acl.h"
+#include "acl_log.h"
+
+/*
+ * Incremental ACL context.
+ *
+ * The rules are classified against two tries: the main trie, built by
+ * rte_acl_incr_merge(), and a small delta trie rebuilt on each update.
+ * The delta trie holds the rules added since the last merge. A deleted
+ * rule of the main trie is flagged, and the main rules overlapping it are
+ * copied into the delta trie, so that the best of them still matches
+ * the packets the deleted rule used to match.
+ * The tries use the slot index of a rule + 1 as userdata, the classify
+ * results are the best priority of both tries, mapped to the user data.
+ */
+
+/* Number of packets classified against the delta trie at once. */
+#define ACL_INCR_BURST	64
+
+/* Writer states of a slot. */
+enum {
+	ACL_INCR_USED = RTE_BIT32(0),	/* slot holds a rule */
+	ACL_INCR_MAIN = RTE_BIT32(1),	/* rule is in the main trie */
+	ACL_INCR_DEAD = RTE_BIT32(2),	/* rule is deleted */
+	ACL_INCR_SHADOW = RTE_BIT32(3),	/* main rule copied to the delta trie */
+	ACL_INCR_MERGE = RTE_BIT32(4),	/* rule is in the trie being merged */
+};
+
+/* Rule data read by the classify threads. */
+struct acl_incr_slot {
+	uint32_t userdata;
+	int32_t priority;
+	RTE_ATOMIC(uint32_t) deleted;
+};
+
+struct acl_incr_view {
+	struct rte_acl_ctx *main;
+	struct rte_acl_ctx *delta;
+};
+
+struct rte_acl_incr {
+	char name[RTE_ACL_NAMESIZE];
+	RTE_ATOMIC(struct acl_incr_view *) view;
+	struct acl_incr_slot *slots;
+	uint32_t *state;	/* writer states of the slots */
+	uint8_t *rules;		/* rules, with the slot index + 1 as userdata */
+	uint32_t *free_slots;
+	uint32_t nb_free;
+	uint32_t *scratch;	/* slot indexes of the delta trie */
+	uint32_t *hash;		/* user data to slot index + 1 */
+	uint32_t hash_mask;
+	uint32_t max_rules;
+	uint32_t rule_sz;
+	uint32_t nb_delta;
+	RTE_ATOMIC(uint32_t) gen;
+	int socket_id;
+	bool merging;
+	rte_spinlock_t lock;
+	struct rte_rcu_qsbr *v;
+	struct rte_acl_config cfg;
+};
+
+static inline struct rte_acl_rule *
+acl_incr_rule(const struct rte_acl_incr *incr, uint32_t idx)
+{
+	return (struct rte_acl_rule *)(incr->rules + (size_t)idx * incr->rule_sz);
+}
+
+static inline uint32_t
+acl_incr_hash(const struct rte_acl_incr *incr, uint32_t userdata)
+{
+	return (userdata * 0x9e3779b1) & incr->hash_mask;
+}
+
+static uint32_t *
+acl_incr_hash_find(const struct rte_acl_incr *incr, uint32_t userdata)
+{
+	uint32_t i;
+
+	for (i = acl_incr_hash(incr, userdata); incr->hash[i] != 0;
+			i = (i + 1) & incr->hash_mask) {
+		if (incr->slots[incr->hash[i] - 1].userdata == userdata)
+			return &incr->hash[i];
+	}
+	return NULL;
+}
+
+static void
+acl_incr_hash_add(struct rte_acl_incr *incr, uint32_t userdata, uint32_t idx)
+{
+	uint32_t i;
+
+	for (i = acl_incr_hash(incr, userdata); incr->hash[i] != 0;
+			i = (i + 1) & incr->hash_mask)
+		;
+	incr->hash[i] = idx + 1;
+}
+
+/* Remove an entry, shifting back the next ones of its probe sequence. */
+static void
+acl_incr_hash_del(struct rte_acl_incr *incr, uint32_t *ent)
+{
+	uint32_t i, j, k;
+
+	i = ent - incr->hash;
+	for (j = (i + 1) & incr->hash_mask; incr->hash[j] != 0;
+			j = (j + 1) & incr->hash_mask) {
+		k = acl_incr_hash(incr,
+			incr->slots[incr->hash[j] - 1].userdata);
+		/* keep the entry if its home is cyclically in (i, j] */
+		if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j))
+			continue;
+		incr->hash[i] = incr->hash[j];
+		i = j;
+	}
+	incr->hash[i] = 0;
+}
+
+static inline uint64_t
+acl_incr_field(const union rte_acl_field_types *f, uint8_t size)
+{
+	switch (size) {
+	case sizeof(uint8_t):
+		return f->u8;
+	case sizeof(uint16_t):
+		return f->u16;
+	case sizeof(uint32_t):
+		return f->u32;
+	default:
+		return f->u64;
+	}
+}
+
+static inline uint64_t
+acl_incr_len2mask(uint64_t len, uint8_t size)
+{
+	uint32_t bits = size * CHAR_BIT;
+
+	if (len == 0)
+		return 0;
+	if (len >= bits)
+		return UINT64_MAX >> (64 - bits);
+	return (UINT64_MAX << (bits - len)) & (UINT64_MAX >> (64 - bits));
+}
+
+/* Check if a packet can match both rules in a common category. */
+static bool
+acl_incr_rules_overlap(const struct rte_acl_config *cfg,
+	const struct rte_acl_rule *a, const struct rte_acl_rule *b)
+{
+	const struct rte_acl_field_def *def;
+	uint64_t va, vb, ma, mb;
+	uint32_t i;
+
+	if ((a->data.category_mask & b->data.category_mask) == 0)
+		return false;
+
+	for (i = 0; i != cfg->num_fields; i++) {
+		def = &cfg->defs[i];
+		va = acl_incr_field(&a->field[def->field_index].value,
+			def->size);
+		vb = acl_incr_field(&b->field[def->field_index].value,
+			def->size);
+		ma = acl_incr_field(&a->field[def->field_index].mask_range,
+			def->size);
+		mb = acl_incr_field(&b->field[def->field_index].mask_range,
+			def->size);
+		switch (def->type) {
+		case RTE_ACL_FIELD_TYPE_RANGE:
+			if (va > mb || vb > ma)
+				return false;
+			break;
+		case RTE_ACL_FIELD_TYPE_MASK:
+			ma = acl_incr_len2mask(ma, def->size);
+			mb = acl_incr_len2mask(mb, def->size);
+			/* fallthrough */
+		default:
+			if (((va ^ vb) & ma & mb) != 0)
+				return false;
+			break;
+		}
+	}
+	return true;
+}
+
+/* Flag the live main rules overlapping a deleted one as shadows. */
+static void
+acl_incr_shadow(struct rte_acl_incr *incr, uint32_t dead)
+{
+	const struct rte_acl_rule *rd = acl_incr_rule(incr, dead);
+	uint32_t i, st;
+
+	for (i = 0; i != incr->max_rules; i++) {
+		st = incr->state[i];
+		if ((st & (ACL_INCR_MAIN | ACL_INCR_DEAD | ACL_INCR_SHADOW)) ==
+				ACL_INCR_MAIN &&
+				acl_incr_rules_overlap(&incr->cfg, rd,
+					acl_incr_rule(incr, i)))
+			incr->state[i] |= ACL_INCR_SHADOW;
+	}
+}
+
+/* Build a trie of the given slots, NULL if there are none. */
+static int
+acl_incr_build(struct rte_acl_incr *incr, const uint32_t *idx, uint32_t num,
+	struct rte_acl_ctx **ctx)
+{
+	char name[RTE_ACL_NAMESIZE];
+	struct rte_acl_param prm;
+	struct rte_acl_ctx *acx;
+	uint32_t i;
+	int rc;
+
+	*ctx = NULL;
+	if (num == 0)
+		return 0;
+
+	/* the names of the ACL contexts must be unique */
+	snprintf(name, sizeof(name), "INCR%p_%u", incr,
+		rte_atomic_fetch_add_explicit(&incr->gen, 1,
+			rte_memory_order_relaxed));
+	prm.name = name;
+	prm.socket_id = incr->socket_id;
+	prm.rule_size = incr->rule_sz;
+	prm.max_rule_num = num;
+
+	acx = rte_acl_create(&prm);
+	if (acx == NULL)
+		return -ENOMEM;
+
+	rc = 0;
+	for (i = 0; i != num && rc == 0; i++)
+		rc = rte_acl_add_rules(acx, acl_incr_rule(incr, idx[i]), 1);
+	if (rc == 0)
+		rc = rte_acl_build(acx, &incr->cfg);
+	if (rc != 0) {
+		rte_acl_free(acx);
+		return rc;
+	}
+
+	*ctx = acx;
+	return 0;
+}
+
+/*
+ * Rebuild the delta trie and publish it with the main trie.
+ * Returns the previous view, to free once no classify thread uses it.
+ */
+static int
+acl_incr_update(struct rte_acl_incr *incr, struct rte_acl_ctx *main_ctx,
+	struct acl_incr_view **old)
+{
+	struct acl_incr_view *view;
+	struct rte_acl_ctx *delta;
+	uint32_t i, n, st;
+	int rc;
+
+	n = 0;
+	for (i = 0; i != incr->max_rules; i++) {
+		st = incr->state[i];
+		if ((st & (ACL_INCR_USED | ACL_INCR_DEAD)) == ACL_INCR_USED &&
+				((st & ACL_INCR_MAIN) == 0 ||
+				(st & ACL_INCR_SHADOW) != 0))
+			incr->scratch[n++] = i;
+	}
+
+	view = rte_zmalloc_socket(NULL, sizeof(*view), 0, incr->socket_id);
+	if (view == NULL)
+		return -ENOMEM;
+
+	rc = acl_incr_build(incr, incr->scratch, n, &delta);
+	if (rc != 0) {
+		rte_free(view);
+		return rc;
+	}
+
+	view->main = main_ctx;
+	view->delta = delta;
+	*old = rte_atomic_load_explicit(&incr->view, rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&incr->view, view, rte_memory_order_release);
+	incr->nb_delta = n;
+	return 0;
+}
+
+/* Wait for the classify threads to stop using the previous view. */
+static void
+acl_incr_sync(struct rte_acl_incr *incr)
+{
+	if (incr->v != NULL)
+		rte_rcu_qsbr_synchronize(incr->v, RTE_QSBR_THRID_INVALID);
+}
+
+static void
+acl_incr_slot_free(struct rte_acl_incr *incr, uint32_t idx)
+{
+	rte_atomic_store_explicit(&incr->slots[idx].deleted, 0,
+		rte_memory_order_relaxed);
+	incr->state[idx] = 0;
+	incr->free_slots[incr->nb_free++] = idx;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_incr_create, 26.03)
+struct rte_acl_incr *
+rte_acl_incr_create(const struct rte_acl_incr_param *param)
+{
+	struct rte_acl_incr *incr;
+	struct acl_incr_view *view;
+	uint32_t i, hash_sz;
+
+	if (param == NULL || param->name == NULL || param->cfg == NULL ||
+			param->max_rule_num == 0 ||
+			param->max_rule_num > RTE_ACL_MAX_INDEX / 2 ||
+			param->rule_size < RTE_ACL_RULE_SZ(param->cfg->num_fields) ||
+			param->cfg->num_fields > RTE_ACL_MAX_FIELDS ||
+			param->cfg->num_categories == 0 ||
+			param->cfg->num_categories > RTE_ACL_MAX_CATEGORIES) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	incr = rte_zmalloc_socket(NULL, sizeof(*incr), RTE_CACHE_LINE_SIZE,
+		param->socket_id);
+	view = rte_zmalloc_socket(NULL, sizeof(*view), 0, param->socket_id);
+	if (incr == NULL || view == NULL)
+		goto nomem;
+
+	hash_sz = rte_align32pow2(param->max_rule_num * 2);
+	incr->slots = rte_zmalloc_socket(NULL,
+		sizeof(incr->slots[0]) * param->max_rule_num,
+		RTE_CACHE_LINE_SIZE, param->socket_id);
+	incr->state = rte_zmalloc(NULL,
+		sizeof(incr->state[0]) * param->max_rule_num, 0);
+	incr->rules = rte_malloc(NULL,
+		(size_t)param->max_rule_num * param->rule_size, 0);
+	incr->free_slots = rte_malloc(NULL,
+		sizeof(incr->free_slots[0]) * param->max_rule_num, 0);
+	incr->scratch = rte_malloc(NULL,
+		sizeof(incr->scratch[0]) * param->max_rule_num, 0);
+	incr->hash = rte_zmalloc(NULL, sizeof(incr->hash[0]) * hash_sz, 0);
+	if (incr->slots == NULL || incr->state == NULL ||
+			incr->rules == NULL || incr->free_slots == NULL ||
+			incr->scratch == NULL || incr->hash == NULL)
+		goto nomem;
+
+	strlcpy(incr->name, param->name, sizeof(incr->name));
+	incr->hash_mask = hash_sz - 1;
+	incr->max_rules = param->max_rule_num;
+	incr->rule_sz = param->rule_size;
+	incr->socket_id = param->socket_id;
+	incr->v = param->v;
+	incr->cfg = *param->cfg;
+	rte_spinlock_init(&incr->lock);
+
+	/* hand out the lowest slots first */
+	for (i = 0; i != incr->max_rules; i++)
+		incr->free_slots[i] = incr->max_rules - 1 - i;
+	incr->nb_free = incr->max_rules;
+
+	rte_atomic_store_explicit(&incr->view, view, rte_memory_order_relaxed);
+	return incr;
+
+nomem:
+	ACL_LOG(ERR, "%s(%s): cannot allocate memory", __func__, param->name);
+	if (incr != NULL) {
+		rte_free(incr->hash);
+		rte_free(incr->scratch);
+		rte_free(incr->free_slots);
+		rte_free(incr->rules);
+		rte_free(incr->state);
+		rte_free(incr->slots);
+	}
+	rte_free(view);
+	rte_free(incr);
+	rte_errno = ENOMEM;
+	return NULL;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_incr_free, 26.03)
+void
+rte_acl_incr_free(struct rte_acl_incr *incr)
+{
+	struct acl_incr_view *view;
+
+	if (incr == NULL)
+		return;
+
+	view = rte_atomic_load_explicit(&incr->view, rte_memory_order_relaxed);
+	rte_acl_free(view->main);
+	rte_acl_free(view->delta);
+	rte_free(view);
+	rte_free(incr->hash);
+	rte_free(incr->scratch);
+	rte_free(incr->free_slots);
+	rte_free(incr->rules);
+	rte_free(incr->state);
+	rte_free(incr->slots);
+	rte_free(incr);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_incr_add_rules, 26.03)
+int
+rte_acl_incr_add_rules(struct rte_acl_incr *incr,
+	const struct rte_acl_rule *rules, uint32_t num)
+{
+	const struct rte_acl_rule *rv;
+	struct rte_acl_rule *rule;
+	struct acl_incr_view *old, *cur;
+	uint32_t *ent;
+	uint32_t i, idx;
+	int rc;
+
+	if (incr == NULL || rules == NULL)
+		return -EINVAL;
+
+	rte_spinlock_lock(&incr->lock);
+
+	if (num > incr->nb_free) {
+		rte_spinlock_unlock(&incr->lock);
+		return -ENOMEM;
+	}
+
+	rc = 0;
+	for (i = 0; i != num; i++) {
+		rv = (const struct rte_acl_rule *)
+			((uintptr_t)rules + i * incr->rule_sz);
+		if (rv->data.userdata == 0 || acl_check_rule(&rv->data) != 0) {
+			ACL_LOG(ERR, "%s(%s): rule #%u is invalid",
+				__func__, incr->name, i + 1);
+			rc = -EINVAL;
+			break;
+		}
+		if (acl_incr_hash_find(incr, rv->data.userdata) != NULL) {
+			rc = -EEXIST;
+			break;
+		}
+
+		idx = incr->free_slots[--incr->nb_free];
+		rule = acl_incr_rule(incr, idx);
+		memcpy(rule, rv, incr->rule_sz);
+		rule->data.userdata = idx + 1;
+		incr->slots[idx].userdata = rv->data.userdata;
+		incr->slots[idx].priority = rv->data.priority;
+		incr->state[idx] = ACL_INCR_USED;
+		acl_incr_hash_add(incr, rv->data.userdata, idx);
+	}
+
+	if (rc == 0) {
+		cur = rte_atomic_load_explicit(&incr->view,
+			rte_memory_order_relaxed);
+		rc = acl_incr_update(incr, cur->main, &old);
+	}
+
+	if (rc != 0) {
+		/* the new slots were never published, free them now */
+		while (i-- != 0) {
+			rv = (const struct rte_acl_rule *)
+				((uintptr_t)rules + i * incr->rule_sz);
+			ent = acl_incr_hash_find(incr, rv->data.userdata);
+			idx = *ent - 1;
+			acl_incr_hash_del(incr, ent);
+			acl_incr_slot_free(incr, idx);
+		}
+		rte_spinlock_unlock(&incr->lock);
+		return rc;
+	}
+
+	acl_incr_sync(incr);
+	rte_acl_free(old->delta);
+	rte_free(old);
+
+	rte_spinlock_unlock(&incr->lock);
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_incr_del_rules, 26.03)
+int
+rte_acl_incr_del_rules(struct rte_acl_incr *incr, const uint32_t *userdata,
+	uint32_t num)
+{
+	struct acl_incr_view *old, *cur;
+	uint32_t *ent;
+	uint32_t i, idx;
+	int rc;
+
+	if (incr == NULL || userdata == NULL)
+		return -EINVAL;
+
+	rte_spinlock_lock(&incr->lock);
+
+	rc = 0;
+	for (i = 0; i != num; i++) {
+		ent = acl_incr_hash_find(incr, userdata[i]);
+		if (ent == NULL ||
+				(incr->state[*ent - 1] & ACL_INCR_DEAD) != 0) {
+			rc = -ENOENT;
+			break;
+		}
+		incr->state[*ent - 1] |= ACL_INCR_DEAD;
+	}
+
+	if (rc == 0) {
+		for (i = 0; i != num; i++) {
+			idx = *acl_incr_hash_find(incr, userdata[i]) - 1;
+			if ((incr->state[idx] & ACL_INCR_MAIN) != 0)
+				acl_incr_shadow(incr, idx);
+		}
+		cur = rte_atomic_load_explicit(&incr->view,
+			rte_memory_order_relaxed);
+		rc = acl_incr_update(incr, cur->main, &old);
+	}
+
+	if (rc != 0) {
+		while (i-- != 0) {
+			idx = *acl_incr_hash_find(incr, userdata[i]) - 1;
+			incr->state[idx] &= ~ACL_INCR_DEAD;
+		}
+		rte_spinlock_unlock(&incr->lock);
+		return rc;
+	}
+
+	/*
+	 * Until all the classify threads use the new delta trie,
+	 * a deleted main rule keeps matching.
+	 */
+	acl_incr_sync(incr);
+	for (i = 0; i != num; i++) {
+		ent = acl_incr_hash_find(incr, userdata[i]);
+		idx = *ent - 1;
+		acl_incr_hash_del(incr, ent);
+		if ((incr->state[idx] & ACL_INCR_MAIN) != 0)
+			rte_atomic_store_explicit(&incr->slots[idx].deleted, 1,
+				rte_memory_order_relaxed);
+		else if ((incr->state[idx] & ACL_INCR_MERGE) == 0)
+			acl_incr_slot_free(incr, idx);
+	}
+	rte_acl_free(old->delta);
+	rte_free(old);
+
+	rte_spinlock_unlock(&incr->lock);
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_incr_merge, 26.03)
+int
+rte_acl_incr_merge(struct rte_acl_incr *incr)
+{
+	struct acl_incr_view *old;
+	struct rte_acl_ctx *main_ctx;
+	uint32_t *idx, *state;
+	uint32_t i, n, st;
+	int rc;
+
+	if (incr == NULL)
+		return -EINVAL;
+
+	idx = rte_malloc(NULL, sizeof(idx[0]) * incr->max_rules, 0);
+	state = rte_malloc(NULL, sizeof(state[0]) * incr->max_rules, 0);
+	if (idx == NULL || state == NULL) {
+		rte_free(idx);
+		rte_free(state);
+		return -ENOMEM;
+	}
+
+	rte_spinlock_lock(&incr->lock);
+	if (incr->merging) {
+		rte_spinlock_unlock(&incr->lock);
+		rte_free(idx);
+		rte_free(state);
+		return -EBUSY;
+	}
+	n = 0;
+	for (i = 0; i != incr->max_rules; i++) {
+		if ((incr->state[i] & (ACL_INCR_USED | ACL_INCR_DEAD)) ==
+				ACL_INCR_USED) {
+			incr->state[i] |= ACL_INCR_MERGE;
+			idx[n++] = i;
+		}
+	}
+	incr->merging = true;
+	rte_spinlock_unlock(&incr->lock);
+
+	/* the updates go on during the build of the main trie */
+	rc = acl_incr_build(incr, idx, n, &main_ctx);
+
+	rte_spinlock_lock(&incr->lock);
+	incr->merging = false;
+
+	if (rc == 0) {
+		memcpy(state, incr->state, sizeof(state[0]) * incr->max_rules);
+		for (i = 0; i != incr->max_rules; i++) {
+			st = incr->state[i] & ~ACL_INCR_SHADOW;
+			if ((st & ACL_INCR_MERGE) != 0)
+				st = (st & ~ACL_INCR_MERGE) | ACL_INCR_MAIN;
+			else
+				st &= ~ACL_INCR_MAIN;
+			incr->state[i] = st;
+		}
+		/* rules deleted during the build */
+		for (i = 0; i != incr->max_rules; i++) {
+			if ((incr->state[i] & (ACL_INCR_MAIN | ACL_INCR_DEAD)) ==
+					(ACL_INCR_MAIN | ACL_INCR_DEAD))
+				acl_incr_shadow(incr, i);
+		}
+		rc = acl_incr_update(incr, main_ctx, &old);
+		if (rc != 0) {
+			memcpy(incr->state, state,
+				sizeof(state[0]) * incr->max_rules);
+			rte_acl_free(main_ctx);
+		}
+	}
+
+	if (rc != 0) {
+		/* free the rules deleted during the build */
+		for (i = 0; i != incr->max_rules; i++) {
+			st = incr->state[i] & ~ACL_INCR_MERGE;
+			incr->state[i] = st;
+			if ((st & (ACL_INCR_USED | ACL_INCR_MAIN |
+					ACL_INCR_DEAD)) ==
+					(ACL_INCR_USED | ACL_INCR_DEAD))
+				acl_incr_slot_free(incr, i);
+		}
+		rte_spinlock_unlock(&incr->lock);
+		rte_free(idx);
+		rte_free(state);
+		return rc;
+	}
+
+	acl_incr_sync(incr);
+	for (i = 0; i != incr->max_rules; i++) {
+		st = incr->state[i];
+		if ((st & (ACL_INCR_USED | ACL_INCR_DEAD)) !=
+				(ACL_INCR_USED | ACL_INCR_DEAD))
+			continue;
+		if ((st & ACL_INCR_MAIN) != 0)
+			rte_atomic_store_explicit(&incr->slots[i].deleted, 1,
+				rte_memory_order_relaxed);
+		else
+			acl_incr_slot_free(incr, i);
+	}
+	rte_acl_free(old->main);
+	rte_acl_free(old->delta);
+	rte_free(old);
+
+	rte_spinlock_unlock(&incr->lock);
+	rte_free(idx);
+	rte_free(state);
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_incr_delta_count, 26.03)
+uint32_t
+rte_acl_incr_delta_count(const struct rte_acl_incr *incr)
+{
+	return (incr == NULL) ? 0 : incr->nb_delta;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_acl_incr_classify, 26.03)
+int
+rte_acl_incr_classify(const struct rte_acl_incr *incr, const uint8_t **data,
+	uint32_t *results, uint32_t num, uint32_t categories)
+{
+	uint32_t res[ACL_INCR_BURST * RTE_ACL_MAX_CATEGORIES];
+	const struct acl_incr_slot *slots;
+	const struct acl_incr_view *view;
+	uint32_t i, j, k, m, n, d;
+	int rc;
+
+	if (incr == NULL || categories == 0 ||
+			categories > RTE_ACL_MAX_CATEGORIES)
+		return -EINVAL;
+
+	slots = incr->slots;
+	view = rte_atomic_load_explicit(&incr->view, rte_memory_order_acquire);
+
+	if (view->main != NULL) {
+		rc = rte_acl_classify(view->main, data, results, num,
+			categories);
+		if (rc != 0)
+			return rc;
+	} else
+		memset(results, 0, sizeof(results[0]) * num * categories);
+
+	for (i = 0; i < num; i += n) {
+		n = RTE_MIN(num - i, (uint32_t)ACL_INCR_BURST);
+		if (view->delta != NULL) {
+			rc = rte_acl_classify(view->delta, data + i, res, n,
+				categories);
+			if (rc != 0)
+				return rc;
+		} else
+			memset(res, 0, sizeof(res[0]) * n * categories);
+
+		for (j = 0; j != n * categories; j++) {
+			k = i * categories + j;
+			m = results[k];
+			d = res[j];
+			if (m != 0 && rte_atomic_load_explicit(
+					&slots[m - 1].deleted,
+					rte_memory_order_relaxed) != 0)
+				m = 0;
+			if (d != 0 && (m == 0 ||
+					slots[d - 1].priority >
+					slots[m - 1].priority))
+				m = d;
+			results[k] = (m == 0) ? 0 : slots[m - 1].userdata;
+		}
+	}
+	return 0;
+}
@@ -453,7 +453,7 @@ acl_add_rules(struct rte_acl_ctx *ctx, const void *rules, uint32_t num)
 	return 0;
 }
 
-static int
+int
 acl_check_rule(const struct rte_acl_rule_data *rd)
 {
 	if ((RTE_LEN2MASK(RTE_ACL_MAX_CATEGORIES, typeof(rd->category_mask)) &
@@ -13,6 +13,7 @@
 
 #include <rte_common.h>
 #include <rte_acl_osdep.h>
+#include <rte_rcu_qsbr.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -225,6 +226,38 @@ rte_acl_reset_rules(struct rte_acl_ctx *ctx);
 int
 rte_acl_build(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Analyze set of rules and build required internal run-time structures,
+ * as rte_acl_build(), using worker threads.
+ * When the rule-set is split into several tries, each trie is rebuilt
+ * for its part of the rules on a worker thread, while the remaining
+ * rules are split further. The run-time structures are generated
+ * once all the tries are built.
+ * The speed-up depends on the number of tries of the rule-set,
+ * as there are at most 8 tries, at most 7 workers are used.
+ * This function is not multi-thread safe.
+ *
+ * @param ctx
+ *   ACL context to build.
+ * @param cfg
+ *   Pointer to struct rte_acl_config - defines build parameters.
+ * @param num_workers
+ *   Maximum number of worker threads running at once.
+ *   Zero builds all the tries on the calling thread.
+ * @return
+ *   - -ENOMEM if couldn't allocate enough memory.
+ *   - -EINVAL if the parameters are invalid.
+ *   - Negative error code if operation failed.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_build_mt(struct rte_acl_ctx *ctx, const struct rte_acl_config *cfg,
+	uint32_t num_workers);
+
 /**
  * Delete all rules from the ACL context and
  * destroy all internal run-time structures.
@@ -359,6 +392,180 @@ rte_acl_dump(const struct rte_acl_ctx *ctx);
 void
 rte_acl_list_dump(void);
 
+/**
+ * Parameters used when creating an incremental ACL context.
+ */
+struct rte_acl_incr_param {
+	const char *name;         /**< Name of the context. */
+	int         socket_id;    /**< Socket ID to allocate memory for. */
+	uint32_t    rule_size;    /**< Size of each rule. */
+	/**
+	 * Maximum number of rules,
+	 * including the deleted ones until the next merge.
+	 */
+	uint32_t    max_rule_num;
+	/** Build configuration of the tries. */
+	const struct rte_acl_config *cfg;
+	/**
+	 * RCU QSBR variable of the classify threads.
+	 * NULL if the updates never run concurrently with the classification.
+	 */
+	struct rte_rcu_qsbr *v;
+};
+
+/** @internal opaque incremental ACL handle */
+struct rte_acl_incr;
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create an incremental ACL context.
+ *
+ * An incremental context classifies against a main trie and a small
+ * delta trie. Adding or deleting rules only rebuilds the delta trie,
+ * rte_acl_incr_merge() rebuilds the main trie with all the rules.
+ * The rules are identified by their user data, which must be unique
+ * and non-zero.
+ *
+ * @param param
+ *   Parameters used to create and initialise the context.
+ * @return
+ *   Pointer to the context on success, NULL otherwise with rte_errno set.
+ */
+__rte_experimental
+struct rte_acl_incr *
+rte_acl_incr_create(const struct rte_acl_incr_param *param);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * De-allocate all memory used by an incremental ACL context.
+ * No classification must run on the context.
+ *
+ * @param incr
+ *   Incremental ACL context to free.
+ *   If incr is NULL, no operation is performed.
+ */
+__rte_experimental
+void
+rte_acl_incr_free(struct rte_acl_incr *incr);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Add rules to an incremental ACL context and rebuild its delta trie.
+ * The rules are used by the classification when the function returns.
+ *
+ * @param incr
+ *   Incremental ACL context to add rules to.
+ * @param rules
+ *   Array of rules to add.
+ * @param num
+ *   Number of elements in the input array of rules.
+ * @return
+ *   - -ENOMEM if there is no space for these rules or the delta trie.
+ *   - -EINVAL if the parameters are invalid.
+ *   - -EEXIST if a rule with the same user data exists.
+ *   - Zero if operation completed successfully, no rules are added otherwise.
+ */
+__rte_experimental
+int
+rte_acl_incr_add_rules(struct rte_acl_incr *incr,
+	const struct rte_acl_rule *rules, uint32_t num);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Delete rules from an incremental ACL context and rebuild its delta trie.
+ * The rules of the main trie overlapping a deleted rule are copied
+ * to the delta trie until the next merge.
+ * The rules are not used by the classification when the function returns.
+ *
+ * @param incr
+ *   Incremental ACL context to delete rules from.
+ * @param userdata
+ *   Array of the user data of the rules to delete.
+ * @param num
+ *   Number of elements in the userdata array.
+ * @return
+ *   - -ENOMEM if there is no space for the delta trie.
+ *   - -EINVAL if the parameters are invalid.
+ *   - -ENOENT if a rule does not exist.
+ *   - Zero if operation completed successfully, no rules are deleted otherwise.
+ */
+__rte_experimental
+int
+rte_acl_incr_del_rules(struct rte_acl_incr *incr, const uint32_t *userdata,
+	uint32_t num);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Rebuild the main trie of an incremental ACL context with all its rules,
+ * emptying the delta trie.
+ * Rules can be added and deleted from other threads during the merge.
+ *
+ * @param incr
+ *   Incremental ACL context to merge.
+ * @return
+ *   - -ENOMEM if couldn't allocate enough memory.
+ *   - -EBUSY if a merge is already running.
+ *   - Negative error code if the build failed.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_acl_incr_merge(struct rte_acl_incr *incr);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the number of rules in the delta trie of an incremental ACL context,
+ * to decide when to merge it.
+ *
+ * @param incr
+ *   Incremental ACL context.
+ * @return
+ *   Number of rules in the delta trie.
+ */
+__rte_experimental
+uint32_t
+rte_acl_incr_delta_count(const struct rte_acl_incr *incr);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Search for a matching ACL rule in an incremental ACL context,
+ * as with rte_acl_classify().
+ * The classify threads must report their quiescent state
+ * to the RCU QSBR variable of the context, outside of this function.
+ *
+ * @param incr
+ *   Incremental ACL context to search with.
+ * @param data
+ *   Array of pointers to input data buffers to perform search.
+ * @param results
+ *   Array of search results, *categories* results per each input data buffer.
+ * @param num
+ *   Number of elements in the input data buffers array.
+ * @param categories
+ *   Number of maximum possible matches for each input buffer.
+ * @return
+ *   zero on successful completion.
+ *   -EINVAL for incorrect arguments.
+ */
+__rte_experimental
+int
+rte_acl_incr_classify(const struct rte_acl_incr *incr, const uint8_t **data,
+	uint32_t *results, uint32_t num, uint32_t categories);
+
 #ifdef __cplusplus
 }
 #endif
@@ -66,27 +66,17 @@ rte_stats_bitrate_reg(struct rte_stats_bitrates *bitrate_data)
 	return return_value;
 }
 
-RTE_EXPORT_SYMBOL(rte_stats_bitrate_calc)
-int
-rte_stats_bitrate_calc(struct rte_stats_bitrates *bitrate_data,
-			uint16_t port_id)
+static int
+bitrate_calc(struct rte_stats_bitrates *bitrate_data, uint16_t port_id,
+	     uint64_t ibytes, uint64_t obytes)
 {
 	struct rte_stats_bitrate *port_data;
-	struct rte_eth_stats eth_stats;
-	int ret_code;
 	uint64_t cnt_bits;
 	int64_t delta;
 	const int64_t alpha_percent = 20;
 	uint64_t values[6];
 	int ret;
 
-	if (bitrate_data == NULL)
-		return -EINVAL;
-
-	ret_code = rte_eth_stats_get(port_id, &eth_stats);
-	if (ret_code != 0)
-		return ret_code < 0 ? ret_code : -ret_code;
-
 	port_data = &bitrate_data->port_stats[port_id];
 
 	/* Incoming bitrate. This is an iteratively calculated EWMA
@@ -95,8 +85,8 @@ rte_stats_bitrate_calc(struct rte_stats_bitrates *bitrate_data,
 	 * for just the current time delta is also calculated for the
 	 * benefit of people who don't understand signal processing.
 	 */
-	cnt_bits = (eth_stats.ibytes - port_data->last_ibytes) << 3;
-	port_data->last_ibytes = eth_stats.ibytes;
+	cnt_bits = (ibytes - port_data->last_ibytes) << 3;
+	port_data->last_ibytes = ibytes;
 	if (cnt_bits > port_data->peak_ibits)
 		port_data->peak_ibits = cnt_bits;
 	delta = cnt_bits;
@@ -115,8 +105,8 @@ rte_stats_bitrate_calc(struct rte_stats_bitrates *bitrate_data,
 	port_data->mean_ibits = cnt_bits;
 
 	/* Outgoing bitrate (also EWMA) */
-	cnt_bits = (eth_stats.obytes - port_data->last_obytes) << 3;
-	port_data->last_obytes = eth_stats.obytes;
+	cnt_bits = (obytes - port_data->last_obytes) << 3;
+	port_data->last_obytes = obytes;
 	if (cnt_bits > port_data->peak_obits)
 		port_data->peak_obits = cnt_bits;
 	delta = cnt_bits;
@@ -143,3 +133,33 @@ rte_stats_bitrate_calc(struct rte_stats_bitrates *bitrate_data,
 
 	return 0;
 }
+
+RTE_EXPORT_SYMBOL(rte_stats_bitrate_calc)
+int
+rte_stats_bitrate_calc(struct rte_stats_bitrates *bitrate_data,
+			uint16_t port_id)
+{
+	struct rte_eth_stats eth_stats;
+	int ret_code;
+
+	if (bitrate_data == NULL)
+		return -EINVAL;
+
+	ret_code = rte_eth_stats_get(port_id, &eth_stats);
+	if (ret_code != 0)
+		return ret_code < 0 ? ret_code : -ret_code;
+
+	return bitrate_calc(bitrate_data, port_id, eth_stats.ibytes,
+		eth_stats.obytes);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_stats_bitrate_calc_bytes, 26.03)
+int
+rte_stats_bitrate_calc_bytes(struct rte_stats_bitrates *bitrate_data,
+			uint16_t port_id, uint64_t ibytes, uint64_t obytes)
+{
+	if (bitrate_data == NULL || port_id >= RTE_MAX_ETHPORTS)
+		return -EINVAL;
+
+	return bitrate_calc(bitrate_data, port_id, ibytes, obytes);
+}
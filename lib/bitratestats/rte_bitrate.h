@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include <rte_common.h>
+#include <rte_compat.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -68,6 +69,31 @@ int rte_stats_bitrate_reg(struct rte_stats_bitrates *bitrate_data);
 int rte_stats_bitrate_calc(struct rte_stats_bitrates *bitrate_data,
 			   uint16_t port_id);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Calculate statistics for current time window from byte counters
+ * read by the caller, e.g. the xstats sampled by the sampler library,
+ * instead of reading the ethdev basic statistics of the port.
+ *
+ * @param bitrate_data
+ *   Bitrate statistics data pointer
+ * @param port_id
+ *   Port id to calculate statistics for
+ * @param ibytes
+ *   Cumulative count of received bytes
+ * @param obytes
+ *   Cumulative count of transmitted bytes
+ *
+ * @return
+ *  - Zero on success
+ *  - Negative value on error
+ */
+__rte_experimental
+int rte_stats_bitrate_calc_bytes(struct rte_stats_bitrates *bitrate_data,
+				 uint16_t port_id, uint64_t ibytes, uint64_t obytes);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,8 @@ rte_bpf_destroy(struct rte_bpf *bpf)
 	if (bpf != NULL) {
 		if (bpf->jit.func != NULL)
 			munmap(bpf->jit.func, bpf->jit.sz);
+		if (bpf->jit_burst.func != NULL)
+			munmap(bpf->jit_burst.func, bpf->jit_burst.sz);
 		munmap(bpf, bpf->sz);
 	}
 }
@@ -33,6 +35,17 @@ rte_bpf_get_jit(const struct rte_bpf *bpf, struct rte_bpf_jit *jit)
 	return 0;
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_bpf_get_jit_burst, 26.03)
+int
+rte_bpf_get_jit_burst(const struct rte_bpf *bpf, struct rte_bpf_jit_burst *jit)
+{
+	if (bpf == NULL || jit == NULL)
+		return -EINVAL;
+
+	jit[0] = bpf->jit_burst;
+	return 0;
+}
+
 int
 __rte_bpf_jit(struct rte_bpf *bpf)
 {
@@ -13,6 +13,7 @@
 struct rte_bpf {
 	struct rte_bpf_prm prm;
 	struct rte_bpf_jit jit;
+	struct rte_bpf_jit_burst jit_burst;
 	size_t sz;
 	uint32_t stack_sz;
 };
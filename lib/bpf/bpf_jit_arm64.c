@@ -8,6 +8,7 @@
 
 #include <rte_common.h>
 #include <rte_byteorder.h>
+#include <rte_mbuf.h>
 
 #include "bpf_impl.h"
 
@@ -1123,6 +1124,142 @@ emit_branch(struct a64_jit_ctx *ctx, uint8_t op, uint32_t i, int16_t off)
 	emit_b_cond(ctx, ebpf_to_a64_cond(op), jump_offset_get(ctx, i, off));
 }
 
+/*
+ * Helper function, used by emit_ld_mbuf().
+ * Generates code for 'fast_path':
+ * calculate load offset and check is it inside first packet segment.
+ */
+static void
+emit_ldmb_fast_path(struct a64_jit_ctx *ctx, uint8_t op, uint8_t src,
+	int32_t imm, uint32_t slow_off, uint32_t fin_off)
+{
+	uint8_t r0, r2, r3, r6, tmp1;
+
+	r0 = ebpf_to_a64_reg(ctx, EBPF_REG_0);
+	r2 = ebpf_to_a64_reg(ctx, EBPF_REG_2);
+	r3 = ebpf_to_a64_reg(ctx, EBPF_REG_3);
+	r6 = ebpf_to_a64_reg(ctx, EBPF_REG_6);
+	tmp1 = ebpf_to_a64_reg(ctx, TMP_REG_1);
+
+	/* R2 = off, as a 32-bit value */
+	emit_mov_imm(ctx, 0, tmp1, imm);
+	if (BPF_MODE(op) == BPF_IND)
+		emit_add(ctx, 0, tmp1, src);
+	emit_mov_64(ctx, r2, tmp1);
+
+	/* R3 = mbuf->data_len - R2 */
+	emit_mov_imm(ctx, 1, tmp1, offsetof(struct rte_mbuf, data_len));
+	emit_ldr(ctx, BPF_H, r3, r6, tmp1);
+	emit_sub(ctx, 1, r3, r2);
+
+	/* if (R3 < sz) goto slow_path */
+	emit_mov_imm(ctx, 1, tmp1, bpf_size(BPF_SIZE(op)));
+	emit_cmp(ctx, 1, r3, tmp1);
+	emit_b_cond(ctx, A64_LT, slow_off - ctx->idx);
+
+	/* R0 = mbuf->buf_addr + mbuf->data_off + R2 */
+	emit_mov_imm(ctx, 1, tmp1, offsetof(struct rte_mbuf, data_off));
+	emit_ldr(ctx, BPF_H, r3, r6, tmp1);
+	emit_mov_imm(ctx, 1, tmp1, offsetof(struct rte_mbuf, buf_addr));
+	emit_ldr(ctx, EBPF_DW, r0, r6, tmp1);
+	emit_add(ctx, 1, r0, r3);
+	emit_add(ctx, 1, r0, r2);
+
+	/* goto fin_part */
+	emit_b(ctx, fin_off - ctx->idx);
+}
+
+/*
+ * Helper function, used by emit_ld_mbuf().
+ * Generates code for 'slow_path':
+ * call __rte_pktmbuf_read() and check return value.
+ */
+static void
+emit_ldmb_slow_path(struct a64_jit_ctx *ctx, struct rte_bpf *bpf, uint8_t op)
+{
+	uint8_t r0, r1, r3, r4, r6, fp, tmp1;
+
+	r0 = ebpf_to_a64_reg(ctx, EBPF_REG_0);
+	r1 = ebpf_to_a64_reg(ctx, EBPF_REG_1);
+	r3 = ebpf_to_a64_reg(ctx, EBPF_REG_3);
+	r4 = ebpf_to_a64_reg(ctx, EBPF_REG_4);
+	r6 = ebpf_to_a64_reg(ctx, EBPF_REG_6);
+	fp = ebpf_to_a64_reg(ctx, EBPF_FP);
+	tmp1 = ebpf_to_a64_reg(ctx, TMP_REG_1);
+
+	/* R1 = mbuf, R2 = off, R3 = len, R4 = EBPF_FP - bpf->stack_sz */
+	emit_mov_64(ctx, r1, r6);
+	emit_mov_imm(ctx, 1, r3, bpf_size(BPF_SIZE(op)));
+	emit_mov_64(ctx, r4, fp);
+	emit_mov_imm(ctx, 1, tmp1, bpf->stack_sz);
+	emit_sub(ctx, 1, r4, tmp1);
+
+	emit_call(ctx, tmp1, __rte_pktmbuf_read);
+	emit_return_zero_if_src_zero(ctx, 1, r0);
+}
+
+/*
+ * Helper function, used by emit_ld_mbuf().
+ * Generates final part of code for BPF_ABS/BPF_IND load:
+ * perform data load and endianness conversion.
+ */
+static void
+emit_ldmb_fin(struct a64_jit_ctx *ctx, uint8_t op)
+{
+	uint8_t r0, tmp1;
+	size_t sz;
+
+	r0 = ebpf_to_a64_reg(ctx, EBPF_REG_0);
+	tmp1 = ebpf_to_a64_reg(ctx, TMP_REG_1);
+	sz = bpf_size(BPF_SIZE(op));
+
+	emit_mov_imm(ctx, 1, tmp1, 0);
+	emit_ldr(ctx, BPF_SIZE(op), r0, r0, tmp1);
+	if (sz != sizeof(uint8_t))
+		emit_be(ctx, r0, sz * CHAR_BIT);
+}
+
+/*
+ * Emit code for BPF_ABS/BPF_IND load, as the x86 JIT does.
+ * Generates the following construction:
+ * fast_path:
+ *   off = ins->sreg + ins->imm
+ *   if (mbuf->data_len - off < ins->opsz)
+ *      goto slow_path;
+ *   ptr = mbuf->buf_addr + mbuf->data_off + off;
+ *   goto fin_part;
+ * slow_path:
+ *   typeof(ins->opsz) buf; //reserved on the stack by the validator
+ *   ptr = __rte_pktmbuf_read(mbuf, off, ins->opsz, &buf);
+ *   if (ptr == NULL)
+ *      return 0;
+ * fin_part:
+ *   res = *(typeof(ins->opsz))ptr;
+ *   res = bswap(res);
+ *
+ * The program is handled as one with calls, so that R6 is kept
+ * in a callee saved register across __rte_pktmbuf_read().
+ */
+static void
+emit_ld_mbuf(struct a64_jit_ctx *ctx, struct rte_bpf *bpf, uint8_t op,
+	uint8_t src, int32_t imm)
+{
+	uint32_t start, slow_off, fin_off;
+
+	/* dry run first to calculate jump offsets */
+	start = ctx->idx;
+	emit_ldmb_fast_path(ctx, op, src, imm, start, start);
+	slow_off = ctx->idx;
+	emit_ldmb_slow_path(ctx, bpf, op);
+	fin_off = ctx->idx;
+
+	/* reset dry-run code and do a proper run */
+	ctx->idx = start;
+	emit_ldmb_fast_path(ctx, op, src, imm, slow_off, fin_off);
+	emit_ldmb_slow_path(ctx, bpf, op);
+	emit_ldmb_fin(ctx, op);
+}
+
 static void
 check_program_has_call(struct a64_jit_ctx *ctx, struct rte_bpf *bpf)
 {
@@ -1137,6 +1274,13 @@ check_program_has_call(struct a64_jit_ctx *ctx, struct rte_bpf *bpf)
 		switch (op) {
 		/* Call imm */
 		case (BPF_JMP | EBPF_CALL):
+		/* Packet load, may call __rte_pktmbuf_read() */
+		case (BPF_LD | BPF_ABS | BPF_B):
+		case (BPF_LD | BPF_ABS | BPF_H):
+		case (BPF_LD | BPF_ABS | BPF_W):
+		case (BPF_LD | BPF_IND | BPF_B):
+		case (BPF_LD | BPF_IND | BPF_H):
+		case (BPF_LD | BPF_IND | BPF_W):
 			ctx->foundcall = 1;
 			return;
 		}
@@ -1338,6 +1482,15 @@ emit(struct a64_jit_ctx *ctx, struct rte_bpf *bpf)
 			emit_mov_imm(ctx, 1, dst, u64);
 			i++;
 			break;
+		/* R0 = ntoh(*(size *)(mbuf data + src + imm)) */
+		case (BPF_LD | BPF_ABS | BPF_B):
+		case (BPF_LD | BPF_ABS | BPF_H):
+		case (BPF_LD | BPF_ABS | BPF_W):
+		case (BPF_LD | BPF_IND | BPF_B):
+		case (BPF_LD | BPF_IND | BPF_H):
+		case (BPF_LD | BPF_IND | BPF_W):
+			emit_ld_mbuf(ctx, bpf, op, src, imm);
+			break;
 		/* *(size *)(dst + off) = src */
 		case (BPF_STX | BPF_MEM | BPF_B):
 		case (BPF_STX | BPF_MEM | BPF_H):
@@ -82,6 +82,21 @@ enum {
 	REG_TMP1 = R10,
 };
 
+/*
+ * r12 is not used by eBPF code and holds the input index of a burst.
+ */
+enum {
+	REG_BURST_IDX = R12,
+};
+
+/* burst entry arguments, saved on the stack above callee saved registers */
+enum {
+	BURST_CTX,
+	BURST_RC,
+	BURST_NUM,
+	BURST_ARG_NUM
+};
+
 /* LD_ABS/LD_IMM offsets */
 enum {
 	LDMB_FSP_OFS, /* fast-path */
@@ -108,6 +123,12 @@ struct bpf_jit_state {
 	struct {
 		uint32_t stack_ofs;
 	} ldmb;
+	struct {
+		uint32_t enabled;
+		int32_t arg_ofs;
+		int32_t loop_off;
+		int32_t done_off;
+	} burst;
 	uint32_t reguse;
 	int32_t *off;
 	uint8_t *ins;
@@ -1213,16 +1234,34 @@ emit_ld_mbuf(struct bpf_jit_state *st, uint32_t op, uint32_t sreg, uint32_t imm)
 	emit_ldmb_fin(st, rg[EBPF_REG_0], opsz, sz);
 }
 
-static void
-emit_prolog(struct bpf_jit_state *st, int32_t stack_size)
+/*
+ * number of stack slots used to save callee saved registers,
+ * and burst entry arguments.
+ */
+static int32_t
+spill_slots(const struct bpf_jit_state *st)
 {
 	uint32_t i;
-	int32_t spil, ofs;
+	int32_t spil;
 
 	spil = 0;
 	for (i = 0; i != RTE_DIM(save_regs); i++)
 		spil += INUSE(st->reguse, save_regs[i]);
 
+	if (st->burst.enabled != 0)
+		spil += BURST_ARG_NUM;
+
+	return spil;
+}
+
+static void
+emit_prolog(struct bpf_jit_state *st, int32_t stack_size)
+{
+	uint32_t i;
+	int32_t spil, ofs;
+
+	spil = spill_slots(st);
+
 	/* we can avoid touching the stack at all */
 	if (spil == 0)
 		return;
@@ -1240,6 +1279,17 @@ emit_prolog(struct bpf_jit_state *st, int32_t stack_size)
 		}
 	}
 
+	/* save burst entry arguments: ctx[], rc[], num */
+	if (st->burst.enabled != 0) {
+		st->burst.arg_ofs = ofs;
+		emit_st_reg(st, BPF_STX | BPF_MEM | EBPF_DW, RDI, RSP,
+			ofs + BURST_CTX * sizeof(uint64_t));
+		emit_st_reg(st, BPF_STX | BPF_MEM | EBPF_DW, RSI, RSP,
+			ofs + BURST_RC * sizeof(uint64_t));
+		emit_st_reg(st, BPF_STX | BPF_MEM | EBPF_DW, RDX, RSP,
+			ofs + BURST_NUM * sizeof(uint64_t));
+	}
+
 	if (INUSE(st->reguse, RBP) != 0) {
 		emit_mov_reg(st, EBPF_ALU64 | EBPF_MOV | BPF_X, RSP, RBP);
 		emit_alu_imm(st, EBPF_ALU64 | BPF_SUB | BPF_K, RSP, stack_size);
@@ -1267,24 +1317,16 @@ emit_ret(struct bpf_jit_state *st)
 	emit_bytes(st, &ops, sizeof(ops));
 }
 
+/*
+ * restore callee saved registers and return.
+ */
 static void
-emit_epilog(struct bpf_jit_state *st)
+emit_restore(struct bpf_jit_state *st)
 {
 	uint32_t i;
 	int32_t spil, ofs;
 
-	/* if we already have an epilog generate a jump to it */
-	if (st->exit.num++ != 0) {
-		emit_abs_jmp(st, st->exit.off);
-		return;
-	}
-
-	/* store offset of epilog block */
-	st->exit.off = st->sz;
-
-	spil = 0;
-	for (i = 0; i != RTE_DIM(save_regs); i++)
-		spil += INUSE(st->reguse, save_regs[i]);
+	spil = spill_slots(st);
 
 	if (spil != 0) {
 
@@ -1308,6 +1350,85 @@ emit_epilog(struct bpf_jit_state *st)
 	emit_ret(st);
 }
 
+static void
+emit_epilog(struct bpf_jit_state *st)
+{
+	/*
+	 * if we already have an epilog, or the exit point of a burst,
+	 * generate a jump to it
+	 */
+	if (st->burst.enabled != 0 || st->exit.num++ != 0) {
+		emit_abs_jmp(st, st->exit.off);
+		return;
+	}
+
+	/* store offset of epilog block */
+	st->exit.off = st->sz;
+
+	emit_restore(st);
+}
+
+/*
+ * emit the head of the burst loop:
+ *   i = 0;
+ * loop:
+ *   if (i >= num)
+ *      goto done;
+ *   R1 = ctx[i];
+ */
+static void
+emit_burst_head(struct bpf_jit_state *st)
+{
+	const uint32_t r1 = ebpf2x86[EBPF_REG_1];
+	const int32_t ofs = st->burst.arg_ofs;
+
+	emit_mov_imm(st, EBPF_ALU64 | EBPF_MOV | BPF_K, REG_BURST_IDX, 0);
+
+	st->burst.loop_off = st->sz;
+	emit_ld_reg(st, BPF_LDX | BPF_MEM | BPF_W, RBP, REG_TMP0,
+		ofs + BURST_NUM * sizeof(uint64_t));
+	emit_cmp_reg(st, EBPF_ALU64, REG_TMP0, REG_BURST_IDX);
+	emit_abs_jcc(st, BPF_JMP | BPF_JGE | BPF_X, st->burst.done_off);
+
+	emit_ld_reg(st, BPF_LDX | BPF_MEM | EBPF_DW, RBP, REG_TMP0,
+		ofs + BURST_CTX * sizeof(uint64_t));
+	emit_mov_reg(st, EBPF_ALU64 | EBPF_MOV | BPF_X, REG_BURST_IDX, r1);
+	emit_shift_imm(st, EBPF_ALU64 | BPF_LSH | BPF_K, r1, 3);
+	emit_alu_reg(st, EBPF_ALU64 | BPF_ADD | BPF_X, REG_TMP0, r1);
+	emit_ld_reg(st, BPF_LDX | BPF_MEM | EBPF_DW, r1, r1, 0);
+}
+
+/*
+ * emit the tail of the burst loop, exit point of the eBPF code:
+ *   rc[i] = R0;
+ *   i++;
+ *   goto loop;
+ * done:
+ *   return num;
+ */
+static void
+emit_burst_tail(struct bpf_jit_state *st)
+{
+	const uint32_t r0 = ebpf2x86[EBPF_REG_0];
+	const int32_t ofs = st->burst.arg_ofs;
+
+	st->exit.off = st->sz;
+	emit_ld_reg(st, BPF_LDX | BPF_MEM | EBPF_DW, RBP, REG_TMP0,
+		ofs + BURST_RC * sizeof(uint64_t));
+	emit_mov_reg(st, EBPF_ALU64 | EBPF_MOV | BPF_X, REG_BURST_IDX,
+		REG_TMP1);
+	emit_shift_imm(st, EBPF_ALU64 | BPF_LSH | BPF_K, REG_TMP1, 3);
+	emit_alu_reg(st, EBPF_ALU64 | BPF_ADD | BPF_X, REG_TMP0, REG_TMP1);
+	emit_st_reg(st, BPF_STX | BPF_MEM | EBPF_DW, r0, REG_TMP1, 0);
+	emit_alu_imm(st, EBPF_ALU64 | BPF_ADD | BPF_K, REG_BURST_IDX, 1);
+	emit_abs_jmp(st, st->burst.loop_off);
+
+	st->burst.done_off = st->sz;
+	emit_ld_reg(st, BPF_LDX | BPF_MEM | BPF_W, RBP, r0,
+		ofs + BURST_NUM * sizeof(uint64_t));
+	emit_restore(st);
+}
+
 /*
  * walk through bpf code and translate them x86_64 one.
  */
@@ -1322,8 +1443,17 @@ emit(struct bpf_jit_state *st, const struct rte_bpf *bpf)
 	st->exit.num = 0;
 	st->ldmb.stack_ofs = bpf->stack_sz;
 
+	/* the burst loop needs a frame pointer and an index register */
+	if (st->burst.enabled != 0) {
+		USED(st->reguse, RBP);
+		USED(st->reguse, REG_BURST_IDX);
+	}
+
 	emit_prolog(st, bpf->stack_sz);
 
+	if (st->burst.enabled != 0)
+		emit_burst_head(st);
+
 	for (i = 0; i != bpf->prm.nb_ins; i++) {
 
 		st->idx = i;
@@ -1516,14 +1646,18 @@ emit(struct bpf_jit_state *st, const struct rte_bpf *bpf)
 		}
 	}
 
+	if (st->burst.enabled != 0)
+		emit_burst_tail(st);
+
 	return 0;
 }
 
 /*
- * produce a native ISA version of the given BPF code.
+ * produce a native ISA version of the given BPF code,
+ * either running it once or over a burst of inputs.
  */
-int
-__rte_bpf_jit_x86(struct rte_bpf *bpf)
+static int
+jit_x86(struct rte_bpf *bpf, uint32_t burst, void **func, size_t *func_sz)
 {
 	int32_t rc;
 	uint32_t i;
@@ -1538,6 +1672,8 @@ __rte_bpf_jit_x86(struct rte_bpf *bpf)
 
 	/* fill with fake offsets */
 	st.exit.off = INT32_MAX;
+	st.burst.enabled = burst;
+	st.burst.done_off = INT32_MAX;
 	for (i = 0; i != bpf->prm.nb_ins; i++)
 		st.off[i] = INT32_MAX;
 
@@ -1568,10 +1704,33 @@ __rte_bpf_jit_x86(struct rte_bpf *bpf)
 	if (rc != 0)
 		munmap(st.ins, st.sz);
 	else {
-		bpf->jit.func = (void *)st.ins;
-		bpf->jit.sz = st.sz;
+		*func = st.ins;
+		*func_sz = st.sz;
 	}
 
 	free(st.off);
 	return rc;
 }
+
+int
+__rte_bpf_jit_x86(struct rte_bpf *bpf)
+{
+	int32_t rc;
+	size_t sz;
+	void *func;
+
+	rc = jit_x86(bpf, 0, &func, &sz);
+	if (rc != 0)
+		return rc;
+
+	bpf->jit.func = func;
+	bpf->jit.sz = sz;
+
+	/* burst entry is optional, the single one can be used instead */
+	if (jit_x86(bpf, 1, &func, &sz) == 0) {
+		bpf->jit_burst.func = func;
+		bpf->jit_burst.sz = sz;
+	}
+
+	return 0;
+}
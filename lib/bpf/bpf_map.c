@@ -0,0 +1,350 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <eal_export.h>
+#include <rte_common.h>
+#include <rte_errno.h>
+#include <rte_hash.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+
+#include "bpf_impl.h"
+#include "rte_bpf_map.h"
+
+#define BPF_MAP_XSYM_NAMESIZE	(RTE_BPF_MAP_NAMESIZE + sizeof("_lookup"))
+
+static const char * const bpf_map_xsym_suffix[RTE_BPF_MAP_XSYM_NUM] = {
+	[RTE_BPF_MAP_XSYM_MAP] = "",
+	[RTE_BPF_MAP_XSYM_LOOKUP] = "_lookup",
+	[RTE_BPF_MAP_XSYM_UPDATE] = "_update",
+	[RTE_BPF_MAP_XSYM_DELETE] = "_delete",
+	[RTE_BPF_MAP_XSYM_VALUES] = "_values",
+};
+
+struct rte_bpf_map {
+	enum rte_bpf_map_type type;
+	uint32_t key_size;
+	uint32_t value_size;
+	uint32_t max_entries;
+	/* value size, rounded up to 8 bytes */
+	uint32_t stride;
+	/* size of the values of one lcore, for per lcore arrays */
+	size_t lcore_sz;
+	struct rte_hash *hash;
+	uint8_t *values;
+	char xname[RTE_BPF_MAP_XSYM_NUM][BPF_MAP_XSYM_NAMESIZE];
+};
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_bpf_map_create, 26.03)
+struct rte_bpf_map *
+rte_bpf_map_create(const struct rte_bpf_map_params *prm)
+{
+	struct rte_bpf_map *map;
+	struct rte_hash_parameters hprm;
+	char hname[RTE_HASH_NAMESIZE];
+	size_t sz;
+	uint32_t i;
+
+	if (prm == NULL || prm->name == NULL ||
+			strnlen(prm->name, RTE_BPF_MAP_NAMESIZE) ==
+			RTE_BPF_MAP_NAMESIZE ||
+			prm->value_size == 0 || prm->max_entries == 0 ||
+			prm->key_size == 0) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	switch (prm->type) {
+	case RTE_BPF_MAP_TYPE_ARRAY:
+	case RTE_BPF_MAP_TYPE_PERCPU_ARRAY:
+		if (prm->key_size != sizeof(uint32_t)) {
+			rte_errno = EINVAL;
+			return NULL;
+		}
+		break;
+	case RTE_BPF_MAP_TYPE_HASH:
+		break;
+	default:
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	map = rte_zmalloc_socket(prm->name, sizeof(*map), RTE_CACHE_LINE_SIZE,
+		prm->socket_id);
+	if (map == NULL) {
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	map->type = prm->type;
+	map->key_size = prm->key_size;
+	map->value_size = prm->value_size;
+	map->max_entries = prm->max_entries;
+	map->stride = RTE_ALIGN_CEIL(prm->value_size, sizeof(uint64_t));
+
+	sz = (size_t)map->stride * map->max_entries;
+	if (map->type == RTE_BPF_MAP_TYPE_PERCPU_ARRAY) {
+		/* keep the copies of different lcores on different lines */
+		map->lcore_sz = RTE_ALIGN_CEIL(sz, RTE_CACHE_LINE_SIZE);
+		sz = map->lcore_sz * RTE_MAX_LCORE;
+	}
+
+	map->values = rte_zmalloc_socket(prm->name, sz, RTE_CACHE_LINE_SIZE,
+		prm->socket_id);
+	if (map->values == NULL) {
+		rte_bpf_map_free(map);
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	if (map->type == RTE_BPF_MAP_TYPE_HASH) {
+		snprintf(hname, sizeof(hname), "bpfm_%s", prm->name);
+		memset(&hprm, 0, sizeof(hprm));
+		hprm.name = hname;
+		hprm.entries = prm->max_entries;
+		hprm.key_len = prm->key_size;
+		hprm.socket_id = prm->socket_id;
+		/* updated by the programs from several lcores */
+		hprm.extra_flag = RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY |
+			RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD;
+
+		map->hash = rte_hash_create(&hprm);
+		if (map->hash == NULL) {
+			rte_bpf_map_free(map);
+			return NULL;
+		}
+	}
+
+	for (i = 0; i != RTE_DIM(map->xname); i++)
+		snprintf(map->xname[i], sizeof(map->xname[i]), "%s%s",
+			prm->name, bpf_map_xsym_suffix[i]);
+
+	return map;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_bpf_map_free, 26.03)
+void
+rte_bpf_map_free(struct rte_bpf_map *map)
+{
+	if (map == NULL)
+		return;
+
+	rte_hash_free(map->hash);
+	rte_free(map->values);
+	rte_free(map);
+}
+
+/*
+ * position of the element in the values, or negative errno.
+ */
+static int32_t
+bpf_map_elem_pos(const struct rte_bpf_map *map, const void *key)
+{
+	uint32_t idx;
+
+	if (map->type == RTE_BPF_MAP_TYPE_HASH)
+		return rte_hash_lookup(map->hash, key);
+
+	memcpy(&idx, key, sizeof(idx));
+	if (idx >= map->max_entries)
+		return -ENOENT;
+
+	return idx;
+}
+
+static inline void *
+bpf_map_value(const struct rte_bpf_map *map, uint32_t pos, uint32_t lcore_id)
+{
+	return map->values + lcore_id * map->lcore_sz +
+		(size_t)pos * map->stride;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_bpf_map_lookup_elem, 26.03)
+void *
+rte_bpf_map_lookup_elem(struct rte_bpf_map *map, const void *key)
+{
+	uint32_t lcore_id;
+	int32_t pos;
+
+	lcore_id = 0;
+	if (map->type == RTE_BPF_MAP_TYPE_PERCPU_ARRAY) {
+		lcore_id = rte_lcore_id();
+		if (lcore_id >= RTE_MAX_LCORE)
+			return NULL;
+	}
+
+	pos = bpf_map_elem_pos(map, key);
+	if (pos < 0)
+		return NULL;
+
+	return bpf_map_value(map, pos, lcore_id);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_bpf_map_lookup_lcore_elem, 26.03)
+void *
+rte_bpf_map_lookup_lcore_elem(struct rte_bpf_map *map, const void *key,
+	uint32_t lcore_id)
+{
+	int32_t pos;
+
+	if (map->type != RTE_BPF_MAP_TYPE_PERCPU_ARRAY ||
+			lcore_id >= RTE_MAX_LCORE)
+		return NULL;
+
+	pos = bpf_map_elem_pos(map, key);
+	if (pos < 0)
+		return NULL;
+
+	return bpf_map_value(map, pos, lcore_id);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_bpf_map_update_elem, 26.03)
+int
+rte_bpf_map_update_elem(struct rte_bpf_map *map, const void *key,
+	const void *value)
+{
+	uint32_t i, lcore_id;
+	int32_t pos;
+
+	if (map->type == RTE_BPF_MAP_TYPE_HASH) {
+		pos = rte_hash_add_key(map->hash, key);
+		if (pos < 0)
+			return pos;
+		memcpy(bpf_map_value(map, pos, 0), value, map->value_size);
+		return 0;
+	}
+
+	pos = bpf_map_elem_pos(map, key);
+	if (pos < 0)
+		return pos;
+
+	lcore_id = 0;
+	if (map->type == RTE_BPF_MAP_TYPE_PERCPU_ARRAY) {
+		lcore_id = rte_lcore_id();
+		if (lcore_id >= RTE_MAX_LCORE) {
+			for (i = 0; i != RTE_MAX_LCORE; i++)
+				memcpy(bpf_map_value(map, pos, i), value,
+					map->value_size);
+			return 0;
+		}
+	}
+
+	memcpy(bpf_map_value(map, pos, lcore_id), value, map->value_size);
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_bpf_map_delete_elem, 26.03)
+int
+rte_bpf_map_delete_elem(struct rte_bpf_map *map, const void *key)
+{
+	int32_t pos;
+
+	if (map->type != RTE_BPF_MAP_TYPE_HASH)
+		return -ENOTSUP;
+
+	pos = rte_hash_del_key(map->hash, key);
+	return (pos < 0) ? pos : 0;
+}
+
+/*
+ * wrappers called by the BPF programs.
+ */
+
+static uint64_t
+bpf_map_lookup_xsym(uint64_t map, uint64_t key, uint64_t a3 __rte_unused,
+	uint64_t a4 __rte_unused, uint64_t a5 __rte_unused)
+{
+	return (uintptr_t)rte_bpf_map_lookup_elem(
+		(struct rte_bpf_map *)(uintptr_t)map, (const void *)(uintptr_t)key);
+}
+
+static uint64_t
+bpf_map_update_xsym(uint64_t map, uint64_t key, uint64_t value,
+	uint64_t a4 __rte_unused, uint64_t a5 __rte_unused)
+{
+	return (int64_t)rte_bpf_map_update_elem(
+		(struct rte_bpf_map *)(uintptr_t)map, (const void *)(uintptr_t)key,
+		(const void *)(uintptr_t)value);
+}
+
+static uint64_t
+bpf_map_delete_xsym(uint64_t map, uint64_t key, uint64_t a3 __rte_unused,
+	uint64_t a4 __rte_unused, uint64_t a5 __rte_unused)
+{
+	return (int64_t)rte_bpf_map_delete_elem(
+		(struct rte_bpf_map *)(uintptr_t)map, (const void *)(uintptr_t)key);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_bpf_map_xsym_get, 26.03)
+uint32_t
+rte_bpf_map_xsym_get(const struct rte_bpf_map *map,
+	struct rte_bpf_xsym xsym[RTE_BPF_MAP_XSYM_NUM])
+{
+	const struct rte_bpf_arg handle = {
+		.type = RTE_BPF_ARG_RAW,
+		.size = sizeof(uint64_t),
+	};
+	const struct rte_bpf_arg key = {
+		.type = RTE_BPF_ARG_PTR,
+		.size = map->key_size,
+	};
+	const struct rte_bpf_arg value = {
+		.type = RTE_BPF_ARG_PTR,
+		.size = map->value_size,
+	};
+	struct rte_bpf_xsym *xs;
+	uint32_t i, n;
+
+	n = (map->type == RTE_BPF_MAP_TYPE_ARRAY) ?
+		RTE_BPF_MAP_XSYM_NUM : RTE_BPF_MAP_XSYM_VALUES;
+
+	memset(xsym, 0, n * sizeof(xsym[0]));
+	for (i = 0; i != n; i++)
+		xsym[i].name = map->xname[i];
+
+	/* the handle is the map address, as loaded by the program */
+	xs = xsym + RTE_BPF_MAP_XSYM_MAP;
+	xs->type = RTE_BPF_XTYPE_VAR;
+	xs->var.val = (void *)(uintptr_t)map;
+	xs->var.desc = handle;
+
+	xs = xsym + RTE_BPF_MAP_XSYM_LOOKUP;
+	xs->type = RTE_BPF_XTYPE_FUNC;
+	xs->func.val = bpf_map_lookup_xsym;
+	xs->func.nb_args = 2;
+	xs->func.args[0] = handle;
+	xs->func.args[1] = key;
+	xs->func.ret = value;
+
+	xs = xsym + RTE_BPF_MAP_XSYM_UPDATE;
+	xs->type = RTE_BPF_XTYPE_FUNC;
+	xs->func.val = bpf_map_update_xsym;
+	xs->func.nb_args = 3;
+	xs->func.args[0] = handle;
+	xs->func.args[1] = key;
+	xs->func.args[2] = value;
+	xs->func.ret = handle;
+
+	xs = xsym + RTE_BPF_MAP_XSYM_DELETE;
+	xs->type = RTE_BPF_XTYPE_FUNC;
+	xs->func.val = bpf_map_delete_xsym;
+	xs->func.nb_args = 2;
+	xs->func.args[0] = handle;
+	xs->func.args[1] = key;
+	xs->func.ret = handle;
+
+	if (n == RTE_BPF_MAP_XSYM_NUM) {
+		xs = xsym + RTE_BPF_MAP_XSYM_VALUES;
+		xs->type = RTE_BPF_XTYPE_VAR;
+		xs->var.val = map->values;
+		xs->var.desc.type = RTE_BPF_ARG_PTR;
+		xs->var.desc.size = (size_t)map->stride * map->max_entries;
+	}
+
+	return n;
+}
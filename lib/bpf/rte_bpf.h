@@ -17,6 +17,7 @@
  */
 
 #include <rte_common.h>
+#include <rte_compat.h>
 #include <rte_mbuf.h>
 #include <rte_malloc.h>
 #include <bpf_def.h>
@@ -105,6 +106,17 @@ struct rte_bpf_jit {
 	size_t sz;                /**< size of JIT-ed code */
 };
 
+/**
+ * Information about compiled into native ISA eBPF code,
+ * executing it over a set of input contexts.
+ * The function has the same semantics as rte_bpf_exec_burst().
+ */
+struct rte_bpf_jit_burst {
+	/** JIT-ed native code */
+	uint32_t (*func)(void *ctx[], uint64_t rc[], uint32_t num);
+	size_t sz; /**< size of JIT-ed code */
+};
+
 struct rte_bpf;
 
 /**
@@ -202,6 +214,26 @@ rte_bpf_exec_burst(const struct rte_bpf *bpf, void *ctx[], uint64_t rc[],
 int
 rte_bpf_get_jit(const struct rte_bpf *bpf, struct rte_bpf_jit *jit);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Provide information about natively compiled code for given BPF handle,
+ * executing it over a set of input contexts in a single call.
+ * The function pointer is NULL if no such code is available.
+ *
+ * @param bpf
+ *   handle for the BPF code.
+ * @param jit
+ *   pointer to the rte_bpf_jit_burst structure to be filled with related data.
+ * @return
+ *   - -EINVAL if the parameters are invalid.
+ *   - Zero if operation completed successfully.
+ */
+__rte_experimental
+int
+rte_bpf_get_jit_burst(const struct rte_bpf *bpf, struct rte_bpf_jit_burst *jit);
+
 /**
  * Dump epf instructions to a file.
  *
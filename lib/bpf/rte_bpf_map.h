@@ -0,0 +1,218 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_BPF_MAP_H_
+#define _RTE_BPF_MAP_H_
+
+/**
+ * @file rte_bpf_map.h
+ *
+ * Maps keeping the state of BPF programs across their runs,
+ * e.g. per flow counters or token buckets of a rate limiting filter.
+ *
+ * A map is made available to a BPF program through a set of external
+ * symbols, appended to rte_bpf_prm.xsym:
+ * - "<name>": the map handle, a raw value to pass to the functions below,
+ * - "<name>_lookup": void *lookup(map, const void *key),
+ *   returns a pointer to the value or NULL, that must be checked,
+ * - "<name>_update": int update(map, const void *key, const void *value),
+ * - "<name>_delete": int delete(map, const void *key),
+ * - "<name>_values": for an array map only, the values themselves,
+ *   so that the program looks up an element inline, without a call.
+ *
+ * The values are stored at 8 bytes aligned offsets,
+ * the value of index i of an array map being at offset
+ * i * RTE_ALIGN_CEIL(value_size, 8) of "<name>_values".
+ * Concurrent updates of a value by several lcores must use atomic
+ * instructions, e.g. (BPF_STX | EBPF_ATOMIC | EBPF_DW).
+ */
+
+#include <stdint.h>
+
+#include <rte_bpf.h>
+#include <rte_compat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum length of a map name. */
+#define RTE_BPF_MAP_NAMESIZE	24
+
+/**
+ * Map types.
+ */
+enum rte_bpf_map_type {
+	/** array of values, indexed by a uint32_t key */
+	RTE_BPF_MAP_TYPE_ARRAY,
+	/** array of values with one copy per lcore, indexed by a uint32_t key */
+	RTE_BPF_MAP_TYPE_PERCPU_ARRAY,
+	/** hash table of values, based on rte_hash */
+	RTE_BPF_MAP_TYPE_HASH,
+};
+
+/**
+ * External symbols of a map.
+ */
+enum rte_bpf_map_xsym {
+	RTE_BPF_MAP_XSYM_MAP,    /**< map handle */
+	RTE_BPF_MAP_XSYM_LOOKUP, /**< lookup function */
+	RTE_BPF_MAP_XSYM_UPDATE, /**< update function */
+	RTE_BPF_MAP_XSYM_DELETE, /**< delete function */
+	RTE_BPF_MAP_XSYM_VALUES, /**< values of an array map */
+	RTE_BPF_MAP_XSYM_NUM
+};
+
+/**
+ * Map parameters.
+ */
+struct rte_bpf_map_params {
+	const char *name;          /**< name, used for its external symbols */
+	enum rte_bpf_map_type type; /**< map type */
+	uint32_t key_size;         /**< key size, sizeof(uint32_t) for arrays */
+	uint32_t value_size;       /**< value size */
+	uint32_t max_entries;      /**< maximum number of elements */
+	int socket_id;             /**< socket to allocate the map on */
+};
+
+struct rte_bpf_map;
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a map.
+ * The values of the arrays are zeroed.
+ *
+ * @param prm
+ *   Map parameters.
+ * @return
+ *   Map handle, or NULL on error with rte_errno set:
+ *   - EINVAL - invalid parameter passed to function
+ *   - ENOMEM - can't reserve enough memory
+ */
+__rte_experimental
+struct rte_bpf_map *
+rte_bpf_map_create(const struct rte_bpf_map_params *prm);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free a map. The BPF programs using it must be destroyed first.
+ *
+ * @param map
+ *   Map handle, can be NULL.
+ */
+__rte_experimental
+void
+rte_bpf_map_free(struct rte_bpf_map *map);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Look up an element of a map.
+ * For a per lcore array, the copy of the calling lcore is returned.
+ *
+ * @param map
+ *   Map handle.
+ * @param key
+ *   Key of the element.
+ * @return
+ *   Pointer to the value, or NULL if not found.
+ */
+__rte_experimental
+void *
+rte_bpf_map_lookup_elem(struct rte_bpf_map *map, const void *key);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Look up the copy of an element of a per lcore array for a given lcore,
+ * e.g. to gather the values of all lcores from the control path.
+ *
+ * @param map
+ *   Map handle.
+ * @param key
+ *   Key of the element.
+ * @param lcore_id
+ *   Lcore of the copy.
+ * @return
+ *   Pointer to the value, or NULL if not found or not a per lcore array.
+ */
+__rte_experimental
+void *
+rte_bpf_map_lookup_lcore_elem(struct rte_bpf_map *map, const void *key,
+	uint32_t lcore_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Add or update an element of a map.
+ * For a per lcore array, the copy of the calling lcore is updated,
+ * or all the copies when called from a non EAL thread.
+ *
+ * @param map
+ *   Map handle.
+ * @param key
+ *   Key of the element.
+ * @param value
+ *   New value of the element.
+ * @return
+ *   - 0 on success.
+ *   - -ENOENT if the key is out of the array.
+ *   - -ENOSPC if the hash table is full.
+ */
+__rte_experimental
+int
+rte_bpf_map_update_elem(struct rte_bpf_map *map, const void *key,
+	const void *value);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Delete an element of a hash map.
+ *
+ * @param map
+ *   Map handle.
+ * @param key
+ *   Key of the element.
+ * @return
+ *   - 0 on success.
+ *   - -ENOENT if the key is not found.
+ *   - -ENOTSUP if the map is an array.
+ */
+__rte_experimental
+int
+rte_bpf_map_delete_elem(struct rte_bpf_map *map, const void *key);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the external symbols of a map, to append to rte_bpf_prm.xsym.
+ * The symbols remain valid until the map is freed.
+ *
+ * @param map
+ *   Map handle.
+ * @param xsym
+ *   Array filled with the external symbols.
+ * @return
+ *   Number of symbols filled, RTE_BPF_MAP_XSYM_VALUES is filled
+ *   for the arrays only.
+ */
+__rte_experimental
+uint32_t
+rte_bpf_map_xsym_get(const struct rte_bpf_map *map,
+	struct rte_bpf_xsym xsym[RTE_BPF_MAP_XSYM_NUM]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_BPF_MAP_H_ */
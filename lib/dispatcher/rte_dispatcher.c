@@ -6,6 +6,7 @@
 #include <stdint.h>
 
 #include <eal_export.h>
+#include <rte_bitops.h>
 #include <rte_branch_prediction.h>
 #include <rte_common.h>
 #include <rte_lcore.h>
@@ -36,6 +37,14 @@ struct rte_dispatcher_handler {
 	void *process_data;
 };
 
+struct rte_dispatcher_match_handler {
+	int id;
+	enum rte_dispatcher_match_field field;
+	uint8_t value;
+	rte_dispatcher_process_t process_fun;
+	void *process_data;
+};
+
 struct rte_dispatcher_finalizer {
 	int id;
 	rte_dispatcher_finalize_t finalize_fun;
@@ -57,6 +66,11 @@ struct rte_dispatcher {
 	int socket_id;
 	uint32_t service_id;
 	struct rte_dispatcher_lcore lcores[RTE_MAX_LCORE];
+	uint16_t num_match_handlers;
+	uint8_t match_fields; /* bitmask of the fields with a table entry */
+	struct rte_dispatcher_match_handler match_handlers[EVD_MAX_HANDLERS];
+	/* Match handler index + 1 per field value, 0 if none. */
+	uint8_t match_tables[RTE_DISPATCHER_MATCH_FIELD_MAX][UINT8_MAX + 1];
 	uint16_t num_finalizers;
 	struct rte_dispatcher_finalizer finalizers[EVD_MAX_FINALIZERS];
 };
@@ -78,6 +92,42 @@ evd_lookup_handler_idx(struct rte_dispatcher_lcore *lcore,
 	return -1;
 }
 
+static inline uint8_t
+evd_event_field(const struct rte_event *event,
+	enum rte_dispatcher_match_field field)
+{
+	switch (field) {
+	case RTE_DISPATCHER_MATCH_QUEUE_ID:
+		return event->queue_id;
+	case RTE_DISPATCHER_MATCH_EVENT_TYPE:
+		return event->event_type;
+	default:
+		return event->sub_event_type;
+	}
+}
+
+/* Returns the match handler index + 1, or 0 if no table matches. */
+static inline uint8_t
+evd_lookup_match_handler(const struct rte_dispatcher *dispatcher,
+	const struct rte_event *event)
+{
+	int field;
+
+	for (field = 0; field < RTE_DISPATCHER_MATCH_FIELD_MAX; field++) {
+		uint8_t entry;
+
+		if (!(dispatcher->match_fields & RTE_BIT32(field)))
+			continue;
+
+		entry = dispatcher->match_tables[field]
+			[evd_event_field(event, field)];
+		if (entry != 0)
+			return entry;
+	}
+
+	return 0;
+}
+
 static void
 evd_prioritize_handler(struct rte_dispatcher_lcore *lcore,
 	int handler_idx)
@@ -113,6 +163,49 @@ evd_consider_prioritize_handler(struct rte_dispatcher_lcore *lcore,
 	}
 }
 
+/*
+ * Sort the table matched events into one contiguous run per handler,
+ * keeping their order, and deliver each run in a single call.
+ */
+static inline void
+evd_dispatch_matched(struct rte_dispatcher *dispatcher,
+	struct rte_dispatcher_lcore_port *port,
+	const struct rte_event *events, uint16_t num_events,
+	const uint8_t *match_entries, const uint16_t *match_lens,
+	uint16_t *match_pos, struct rte_event *match_events)
+{
+	uint16_t start = 0;
+	uint16_t i;
+
+	for (i = 0; i < dispatcher->num_match_handlers; i++) {
+		match_pos[i] = start;
+		start += match_lens[i];
+	}
+
+	for (i = 0; i < num_events; i++) {
+		uint8_t entry = match_entries[i];
+
+		if (entry != 0)
+			match_events[match_pos[entry - 1]++] = events[i];
+	}
+
+	start = 0;
+	for (i = 0; i < dispatcher->num_match_handlers; i++) {
+		struct rte_dispatcher_match_handler *handler =
+			&dispatcher->match_handlers[i];
+		uint16_t len = match_lens[i];
+
+		if (len == 0)
+			continue;
+
+		handler->process_fun(dispatcher->event_dev_id, port->port_id,
+				     &match_events[start], len,
+				     handler->process_data);
+
+		start += len;
+	}
+}
+
 static inline void
 evd_dispatch_events(struct rte_dispatcher *dispatcher,
 	struct rte_dispatcher_lcore *lcore,
@@ -122,6 +215,11 @@ evd_dispatch_events(struct rte_dispatcher *dispatcher,
 	int i;
 	struct rte_event bursts[EVD_MAX_HANDLERS][num_events];
 	uint16_t burst_lens[EVD_MAX_HANDLERS] = { 0 };
+	struct rte_event match_events[num_events];
+	uint8_t match_entries[num_events];
+	uint16_t match_lens[EVD_MAX_HANDLERS] = { 0 };
+	uint16_t match_pos[EVD_MAX_HANDLERS];
+	uint16_t num_matched = 0;
 	uint16_t drop_count = 0;
 	uint16_t dispatch_count;
 	uint16_t dispatched = 0;
@@ -130,6 +228,18 @@ evd_dispatch_events(struct rte_dispatcher *dispatcher,
 		struct rte_event *event = &events[i];
 		int handler_idx;
 
+		if (dispatcher->match_fields != 0) {
+			uint8_t entry;
+
+			entry = evd_lookup_match_handler(dispatcher, event);
+			match_entries[i] = entry;
+			if (entry != 0) {
+				match_lens[entry - 1]++;
+				num_matched++;
+				continue;
+			}
+		}
+
 		handler_idx = evd_lookup_handler_idx(lcore, event);
 
 		if (unlikely(handler_idx < 0)) {
@@ -143,6 +253,13 @@ evd_dispatch_events(struct rte_dispatcher *dispatcher,
 
 	dispatch_count = num_events - drop_count;
 
+	if (num_matched > 0)
+		evd_dispatch_matched(dispatcher, port, events, num_events,
+				     match_entries, match_lens, match_pos,
+				     match_events);
+
+	dispatched = num_matched;
+
 	for (i = 0; i < lcore->num_handlers &&
 		 dispatched < dispatch_count; i++) {
 		struct rte_dispatcher_handler *handler =
@@ -418,6 +535,22 @@ evd_lcore_get_handler_by_id(struct rte_dispatcher_lcore *lcore, int handler_id)
 	return NULL;
 }
 
+static struct rte_dispatcher_match_handler *
+evd_get_match_handler_by_id(struct rte_dispatcher *dispatcher, int handler_id)
+{
+	uint16_t i;
+
+	for (i = 0; i < dispatcher->num_match_handlers; i++) {
+		struct rte_dispatcher_match_handler *handler =
+			&dispatcher->match_handlers[i];
+
+		if (handler->id == handler_id)
+			return handler;
+	}
+
+	return NULL;
+}
+
 static int
 evd_alloc_handler_id(struct rte_dispatcher *dispatcher)
 {
@@ -425,10 +558,9 @@ evd_alloc_handler_id(struct rte_dispatcher *dispatcher)
 	struct rte_dispatcher_lcore *reference_lcore =
 		&dispatcher->lcores[0];
 
-	if (reference_lcore->num_handlers == EVD_MAX_HANDLERS)
-		return -1;
-
-	while (evd_lcore_get_handler_by_id(reference_lcore, handler_id) != NULL)
+	/* Both kinds of handlers share the same identifier space */
+	while (evd_lcore_get_handler_by_id(reference_lcore, handler_id) != NULL ||
+	       evd_get_match_handler_by_id(dispatcher, handler_id) != NULL)
 		handler_id++;
 
 	return handler_id;
@@ -470,16 +602,93 @@ rte_dispatcher_register(struct rte_dispatcher *dispatcher,
 		.process_data = process_data
 	};
 
-	handler.id = evd_alloc_handler_id(dispatcher);
-
-	if (handler.id < 0)
+	if (dispatcher->lcores[0].num_handlers == EVD_MAX_HANDLERS)
 		return -ENOMEM;
 
+	handler.id = evd_alloc_handler_id(dispatcher);
+
 	evd_install_handler(dispatcher, &handler);
 
 	return handler.id;
 }
 
+static void
+evd_build_match_tables(struct rte_dispatcher *dispatcher)
+{
+	uint16_t i;
+
+	memset(dispatcher->match_tables, 0, sizeof(dispatcher->match_tables));
+	dispatcher->match_fields = 0;
+
+	for (i = 0; i < dispatcher->num_match_handlers; i++) {
+		const struct rte_dispatcher_match_handler *handler =
+			&dispatcher->match_handlers[i];
+
+		dispatcher->match_tables[handler->field][handler->value] = i + 1;
+		dispatcher->match_fields |= RTE_BIT32(handler->field);
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_dispatcher_register_match, 26.03)
+int
+rte_dispatcher_register_match(struct rte_dispatcher *dispatcher,
+	enum rte_dispatcher_match_field field, uint8_t value,
+	rte_dispatcher_process_t process_fun, void *process_data)
+{
+	struct rte_dispatcher_match_handler *handler;
+
+	if (field >= RTE_DISPATCHER_MATCH_FIELD_MAX || process_fun == NULL ||
+	    (field == RTE_DISPATCHER_MATCH_EVENT_TYPE &&
+	     value >= RTE_EVENT_TYPE_MAX))
+		return -EINVAL;
+
+	if (dispatcher->match_tables[field][value] != 0)
+		return -EEXIST;
+
+	if (dispatcher->num_match_handlers == EVD_MAX_HANDLERS)
+		return -ENOMEM;
+
+	handler = &dispatcher->match_handlers[dispatcher->num_match_handlers];
+
+	*handler = (struct rte_dispatcher_match_handler) {
+		.id = evd_alloc_handler_id(dispatcher),
+		.field = field,
+		.value = value,
+		.process_fun = process_fun,
+		.process_data = process_data
+	};
+
+	dispatcher->num_match_handlers++;
+
+	evd_build_match_tables(dispatcher);
+
+	return handler->id;
+}
+
+static int
+evd_uninstall_match_handler(struct rte_dispatcher *dispatcher,
+	struct rte_dispatcher_match_handler *unreg_handler)
+{
+	int handler_idx;
+	uint16_t last_idx;
+
+	handler_idx = unreg_handler - &dispatcher->match_handlers[0];
+
+	last_idx = dispatcher->num_match_handlers - 1;
+
+	if (handler_idx != last_idx) {
+		int n = last_idx - handler_idx;
+		memmove(unreg_handler, unreg_handler + 1,
+			sizeof(struct rte_dispatcher_match_handler) * n);
+	}
+
+	dispatcher->num_match_handlers--;
+
+	evd_build_match_tables(dispatcher);
+
+	return 0;
+}
+
 static int
 evd_lcore_uninstall_handler(struct rte_dispatcher_lcore *lcore,
 	int handler_id)
@@ -533,6 +742,12 @@ RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_dispatcher_unregister, 23.11)
 int
 rte_dispatcher_unregister(struct rte_dispatcher *dispatcher, int handler_id)
 {
+	struct rte_dispatcher_match_handler *match_handler;
+
+	match_handler = evd_get_match_handler_by_id(dispatcher, handler_id);
+	if (match_handler != NULL)
+		return evd_uninstall_match_handler(dispatcher, match_handler);
+
 	return evd_uninstall_handler(dispatcher, handler_id);
 }
 
@@ -102,6 +102,22 @@ typedef void (*rte_dispatcher_process_t)(uint8_t event_dev_id,
 typedef void (*rte_dispatcher_finalize_t)(uint8_t event_dev_id,
 	uint8_t event_port_id, void *cb_data);
 
+/**
+ * Event fields usable by table based handler matching.
+ *
+ * @see rte_dispatcher_register_match()
+ */
+enum rte_dispatcher_match_field {
+	/** Match on the rte_event queue_id field. */
+	RTE_DISPATCHER_MATCH_QUEUE_ID,
+	/** Match on the rte_event event_type field. */
+	RTE_DISPATCHER_MATCH_EVENT_TYPE,
+	/** Match on the rte_event sub_event_type field. */
+	RTE_DISPATCHER_MATCH_SUB_EVENT_TYPE,
+	/** Number of match fields. */
+	RTE_DISPATCHER_MATCH_FIELD_MAX
+};
+
 /**
  * Dispatcher statistics
  */
@@ -295,6 +311,62 @@ rte_dispatcher_register(struct rte_dispatcher *dispatcher,
 	rte_dispatcher_match_t match_fun, void *match_cb_data,
 	rte_dispatcher_process_t process_fun, void *process_cb_data);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Register an event handler matching on the value of an event field.
+ *
+ * Instead of a match callback, the handler is selected by a lookup
+ * table indexed by the value of the event field, at a constant cost
+ * per event regardless of the number of handlers. The events matched
+ * this way in a dequeued batch are grouped into one contiguous run per
+ * handler, keeping their relative order, and each run is delivered in
+ * a single process callback call.
+ *
+ * The lookup tables take precedence over the match callbacks of
+ * handlers registered with rte_dispatcher_register(): the tables are
+ * looked up in the order of enum rte_dispatcher_match_field, and only
+ * the events not found in any table are passed to the match
+ * callbacks.
+ *
+ * The handler is unregistered with rte_dispatcher_unregister(). Its
+ * identifier is taken from the same space as those of
+ * rte_dispatcher_register().
+ *
+ * This function may be called by any thread (including unregistered
+ * non-EAL threads), but not while the event dispatcher is running on
+ * any service lcore.
+ *
+ * @param dispatcher
+ *  The dispatcher instance.
+ *
+ * @param field
+ *  The event field to match on.
+ *
+ * @param value
+ *  The value of the event field selecting this handler.
+ *
+ * @param process_fun
+ *  The process callback function.
+ *
+ * @param process_cb_data
+ *  A pointer to some application-specific opaque data (or NULL),
+ *  which is supplied back to the application when process_fun is
+ *  called.
+ *
+ * @return
+ *  - >= 0: The identifier for this registration.
+ *  - -ENOMEM: Unable to allocate sufficient resources.
+ *  - -EEXIST: A handler is already registered for this field value.
+ *  - -EINVAL: Invalid arguments.
+ */
+__rte_experimental
+int
+rte_dispatcher_register_match(struct rte_dispatcher *dispatcher,
+	enum rte_dispatcher_match_field field, uint8_t value,
+	rte_dispatcher_process_t process_fun, void *process_cb_data);
+
 /**
  * Unregister an event handler.
  *
@@ -307,7 +379,8 @@ rte_dispatcher_register(struct rte_dispatcher *dispatcher,
  *
  * @param handler_id
  *  The handler registration id returned by the original
- *  rte_dispatcher_register() call.
+ *  rte_dispatcher_register() or rte_dispatcher_register_match()
+ *  call.
  *
  * @return
  *  - 0: Success
@@ -6,6 +6,7 @@
 #define _DIST_PRIV_H_
 
 #include <stdalign.h>
+#include <stdbool.h>
 
 /**
  * @file
@@ -156,6 +157,18 @@ struct rte_distributor {
 
 	uint8_t active[RTE_DISTRIB_MAX_WORKERS];
 	uint8_t activesum;
+
+	int socket_id;          /**< Socket preferred for new flows */
+	bool adaptive;          /**< Adaptive in-flight limit enabled */
+
+	/* Adaptive in-flight limit, per worker */
+	uint8_t limit[RTE_DISTRIB_MAX_WORKERS];
+	uint32_t cycles_per_pkt[RTE_DISTRIB_MAX_WORKERS];
+	uint32_t release_count[RTE_DISTRIB_MAX_WORKERS];
+	uint64_t release_tsc[RTE_DISTRIB_MAX_WORKERS];
+
+	/* Socket of each worker, written by the workers */
+	alignas(RTE_CACHE_LINE_SIZE) int worker_socket[RTE_DISTRIB_MAX_WORKERS];
 };
 
 void
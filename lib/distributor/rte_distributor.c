@@ -2,6 +2,7 @@
  * Copyright(c) 2017 Intel Corporation
  */
 
+#include <limits.h>
 #include <stdalign.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -10,12 +11,14 @@
 #include <eal_export.h>
 #include <rte_mbuf.h>
 #include <rte_cycles.h>
+#include <rte_lcore.h>
 #include <rte_memzone.h>
 #include <rte_errno.h>
 #include <rte_string_fns.h>
 #include <rte_eal_memconfig.h>
 #include <rte_pause.h>
 #include <rte_tailq.h>
+#include <rte_telemetry.h>
 
 #include "rte_distributor.h"
 #include "rte_distributor_single.h"
@@ -39,6 +42,7 @@ rte_distributor_request_pkt(struct rte_distributor *d,
 		unsigned int count)
 {
 	struct rte_distributor_buffer *buf = &(d->bufs[worker_id]);
+	int socket_id = (int)rte_socket_id();
 	unsigned int i;
 
 	volatile RTE_ATOMIC(int64_t) *retptr64;
@@ -49,6 +53,10 @@ rte_distributor_request_pkt(struct rte_distributor *d,
 		return;
 	}
 
+	/* Let the distributor know the socket of the worker */
+	if (unlikely(d->worker_socket[worker_id] != socket_id))
+		d->worker_socket[worker_id] = socket_id;
+
 	retptr64 = &(buf->retptr64[0]);
 	/* Spin while handshake bits are set (scheduler clears it).
 	 * Sync with worker on GET_BUF flag.
@@ -338,6 +346,74 @@ handle_worker_shutdown(struct rte_distributor *d, unsigned int wkr)
 }
 
 
+/*
+ * Update the average number of cycles a worker takes to process a packet,
+ * from the time since the release of its last burst.
+ */
+static inline void
+update_cycles(struct rte_distributor *d, unsigned int wkr)
+{
+	uint32_t cycles;
+
+	cycles = (rte_rdtsc() - d->release_tsc[wkr]) / d->release_count[wkr];
+	if (d->cycles_per_pkt[wkr] == 0)
+		d->cycles_per_pkt[wkr] = cycles;
+	else
+		d->cycles_per_pkt[wkr] = (d->cycles_per_pkt[wkr] * 3 + cycles) / 4;
+	d->release_count[wkr] = 0;
+}
+
+/*
+ * Limit the backlog of new flows of each worker to the share of a burst
+ * matching its speed relative to the fastest worker.
+ */
+static void
+update_limits(struct rte_distributor *d)
+{
+	uint32_t min_cycles = UINT32_MAX;
+	unsigned int wkr;
+
+	for (wkr = 0; wkr < d->num_workers; wkr++)
+		if (d->active[wkr] && d->cycles_per_pkt[wkr] != 0)
+			min_cycles = RTE_MIN(min_cycles, d->cycles_per_pkt[wkr]);
+
+	for (wkr = 0; wkr < d->num_workers; wkr++) {
+		if (min_cycles == UINT32_MAX || d->cycles_per_pkt[wkr] == 0)
+			d->limit[wkr] = RTE_DIST_BURST_SIZE;
+		else
+			d->limit[wkr] = RTE_MAX(1U, (uint32_t)
+				((uint64_t)RTE_DIST_BURST_SIZE * min_cycles /
+				d->cycles_per_pkt[wkr]));
+	}
+}
+
+/*
+ * Select the worker of a new flow, starting from the round robin position:
+ * an active worker of the preferred socket below its in-flight limit, else
+ * another active worker below its limit, else any active worker.
+ */
+static inline unsigned int
+select_worker(struct rte_distributor *d, unsigned int wkr)
+{
+	unsigned int i, remote = UINT_MAX, any = UINT_MAX;
+
+	for (i = 0; i < d->num_workers; i++, wkr = (wkr + 1) % d->num_workers) {
+		if (!d->active[wkr])
+			continue;
+		if (any == UINT_MAX)
+			any = wkr;
+		if (d->backlog[wkr].count >= d->limit[wkr])
+			continue;
+		if (d->socket_id == SOCKET_ID_ANY ||
+				d->worker_socket[wkr] == d->socket_id)
+			return wkr;
+		if (remote == UINT_MAX)
+			remote = wkr;
+	}
+
+	return remote != UINT_MAX ? remote : any;
+}
+
 /*
  * When the handshake bits indicate that there are packets coming
  * back from the worker, this function is called to copy and store
@@ -369,6 +445,11 @@ handle_returns(struct rte_distributor *d, unsigned int wkr)
 		d->returns.start = ret_start;
 		d->returns.count = ret_count;
 
+		/* Time taken by the worker to process the last burst */
+		if (d->adaptive && d->release_count[wkr] != 0 &&
+				(buf->retptr64[0] & RTE_DISTRIB_GET_BUF))
+			update_cycles(d, wkr);
+
 		/* If worker requested packets with GET_BUF, set it to active
 		 * otherwise (RETURN_BUF), set it to not active.
 		 */
@@ -433,6 +514,11 @@ release(struct rte_distributor *d, unsigned int wkr)
 
 	d->backlog[wkr].count = 0;
 
+	if (d->adaptive && buf->count != 0) {
+		d->release_tsc[wkr] = rte_rdtsc();
+		d->release_count[wkr] = buf->count;
+	}
+
 	/* Clear the GET bit.
 	 * Sync with worker on GET_BUF flag. Release bufptrs.
 	 */
@@ -483,6 +569,9 @@ rte_distributor_process(struct rte_distributor *d,
 	if (unlikely(!d->activesum))
 		return 0;
 
+	if (d->adaptive)
+		update_limits(d);
+
 	while (next_idx < num_mbufs) {
 		alignas(128) uint16_t matches[RTE_DIST_BURST_SIZE];
 		unsigned int pkts;
@@ -568,8 +657,11 @@ rte_distributor_process(struct rte_distributor *d,
 			} else {
 				struct rte_distributor_backlog *bl;
 
-				while (unlikely(!d->active[wkr]))
-					wkr = (wkr + 1) % d->num_workers;
+				if (d->socket_id != SOCKET_ID_ANY || d->adaptive)
+					wkr = select_worker(d, wkr);
+				else
+					while (unlikely(!d->active[wkr]))
+						wkr = (wkr + 1) % d->num_workers;
 				bl = &d->backlog[wkr];
 
 				if (unlikely(bl->count ==
@@ -787,6 +879,15 @@ rte_distributor_create(const char *name,
 	memset(d->active, 0, sizeof(d->active));
 	d->activesum = 0;
 
+	d->socket_id = SOCKET_ID_ANY;
+	d->adaptive = false;
+	memset(d->cycles_per_pkt, 0, sizeof(d->cycles_per_pkt));
+	memset(d->release_count, 0, sizeof(d->release_count));
+	for (i = 0; i < RTE_DISTRIB_MAX_WORKERS; i++) {
+		d->limit[i] = RTE_DIST_BURST_SIZE;
+		d->worker_socket[i] = SOCKET_ID_ANY;
+	}
+
 	dist_burst_list = RTE_TAILQ_CAST(rte_dist_burst_tailq.head,
 					  rte_dist_burst_list);
 
@@ -797,3 +898,136 @@ rte_distributor_create(const char *name,
 
 	return d;
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_distributor_socket_set, 26.03)
+int
+rte_distributor_socket_set(struct rte_distributor *d, int socket_id)
+{
+	if (d == NULL || (socket_id != SOCKET_ID_ANY &&
+			(socket_id < 0 || socket_id >= RTE_MAX_NUMA_NODES)))
+		return -EINVAL;
+	if (d->alg_type == RTE_DIST_ALG_SINGLE)
+		return -ENOTSUP;
+
+	d->socket_id = socket_id;
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_distributor_adaptive_set, 26.03)
+int
+rte_distributor_adaptive_set(struct rte_distributor *d, bool enable)
+{
+	unsigned int wkr;
+
+	if (d == NULL)
+		return -EINVAL;
+	if (d->alg_type == RTE_DIST_ALG_SINGLE)
+		return -ENOTSUP;
+
+	d->adaptive = enable;
+	for (wkr = 0; wkr < RTE_DISTRIB_MAX_WORKERS; wkr++) {
+		d->limit[wkr] = RTE_DIST_BURST_SIZE;
+		d->cycles_per_pkt[wkr] = 0;
+		d->release_count[wkr] = 0;
+	}
+	return 0;
+}
+
+static void
+dist_walk(void (*func)(struct rte_distributor *, void *), void *arg)
+{
+	struct rte_dist_burst_list *dist_burst_list;
+	struct rte_distributor *d;
+
+	dist_burst_list = RTE_TAILQ_CAST(rte_dist_burst_tailq.head,
+					  rte_dist_burst_list);
+	rte_mcfg_tailq_read_lock();
+
+	TAILQ_FOREACH(d, dist_burst_list, next)
+		(*func)(d, arg);
+
+	rte_mcfg_tailq_read_unlock();
+}
+
+static void
+dist_list_cb(struct rte_distributor *d, void *arg)
+{
+	rte_tel_data_add_array_string(arg, d->name);
+}
+
+static int
+dist_handle_list(const char *cmd __rte_unused,
+		const char *params __rte_unused, struct rte_tel_data *d)
+{
+	rte_tel_data_start_array(d, RTE_TEL_STRING_VAL);
+	dist_walk(dist_list_cb, d);
+	return 0;
+}
+
+struct dist_info_cb_arg {
+	const char *name;
+	struct rte_tel_data *d;
+};
+
+static void
+dist_info_cb(struct rte_distributor *d, void *arg)
+{
+	struct dist_info_cb_arg *info_arg = arg;
+	struct rte_tel_data *workers, *w;
+	unsigned int wkr;
+
+	if (strncmp(d->name, info_arg->name, RTE_DISTRIBUTOR_NAMESIZE) != 0)
+		return;
+
+	rte_tel_data_add_dict_string(info_arg->d, "name", d->name);
+	rte_tel_data_add_dict_uint(info_arg->d, "num_workers", d->num_workers);
+	rte_tel_data_add_dict_int(info_arg->d, "socket", d->socket_id);
+	rte_tel_data_add_dict_uint(info_arg->d, "adaptive", d->adaptive);
+
+	workers = rte_tel_data_alloc();
+	if (workers == NULL)
+		return;
+	rte_tel_data_start_array(workers, RTE_TEL_CONTAINER);
+	for (wkr = 0; wkr < d->num_workers; wkr++) {
+		w = rte_tel_data_alloc();
+		if (w == NULL)
+			break;
+		rte_tel_data_start_dict(w);
+		rte_tel_data_add_dict_uint(w, "active", d->active[wkr]);
+		rte_tel_data_add_dict_int(w, "socket", d->worker_socket[wkr]);
+		rte_tel_data_add_dict_uint(w, "backlog", d->backlog[wkr].count);
+		rte_tel_data_add_dict_uint(w, "in_flight", d->bufs[wkr].count);
+		rte_tel_data_add_dict_uint(w, "limit", d->limit[wkr]);
+		rte_tel_data_add_dict_uint(w, "cycles_per_pkt",
+			d->cycles_per_pkt[wkr]);
+		rte_tel_data_add_array_container(workers, w, 0);
+	}
+	rte_tel_data_add_dict_container(info_arg->d, "workers", workers, 0);
+}
+
+static int
+dist_handle_info(const char *cmd __rte_unused, const char *params,
+		struct rte_tel_data *d)
+{
+	struct dist_info_cb_arg info_arg;
+
+	if (params == NULL || strlen(params) == 0 ||
+			strlen(params) >= RTE_DISTRIBUTOR_NAMESIZE)
+		return -EINVAL;
+
+	info_arg.name = params;
+	info_arg.d = d;
+
+	rte_tel_data_start_dict(d);
+	dist_walk(dist_info_cb, &info_arg);
+
+	return 0;
+}
+
+RTE_INIT(distributor_init_telemetry)
+{
+	rte_telemetry_register_cmd("/distributor/list", dist_handle_list,
+		"Returns list of burst distributors. Takes no parameters");
+	rte_telemetry_register_cmd("/distributor/info", dist_handle_info,
+		"Returns distributor info with per worker backlog. Parameters: distributor_name");
+}
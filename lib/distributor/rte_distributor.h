@@ -13,6 +13,10 @@
  * one-at-a-time to workers, with dynamic load balancing.
  */
 
+#include <stdbool.h>
+
+#include <rte_compat.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -88,6 +92,53 @@ int
 rte_distributor_process(struct rte_distributor *d,
 		struct rte_mbuf **mbufs, unsigned int num_mbufs);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Set the socket preferred for the new flows, typically the socket of the
+ * port the packets are received from. A flow not in-flight is given to an
+ * active worker of this socket, if any can take it, rather than to a remote
+ * worker. The socket of a worker is the one of the lcore requesting packets.
+ *
+ * This should only be called on the same lcore as rte_distributor_process()
+ *
+ * @param d
+ *   The distributor instance to be used, with the burst API
+ * @param socket_id
+ *   The preferred socket, or SOCKET_ID_ANY for no preference (the default)
+ * @return
+ *   0 on success, -EINVAL on invalid parameters, -ENOTSUP with the legacy
+ *   single API.
+ */
+__rte_experimental
+int
+rte_distributor_socket_set(struct rte_distributor *d, int socket_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enable or disable the adaptive in-flight limit. The distributor measures
+ * the time each worker takes to process a packet, and limits the packets of
+ * new flows queued to a worker to its share of a burst, relative to the
+ * fastest worker. The packets of the flows in-flight on a worker still go to
+ * it.
+ *
+ * This should only be called on the same lcore as rte_distributor_process()
+ *
+ * @param d
+ *   The distributor instance to be used, with the burst API
+ * @param enable
+ *   Enable the adaptive limit if true, disabled by default
+ * @return
+ *   0 on success, -EINVAL on invalid parameters, -ENOTSUP with the legacy
+ *   single API.
+ */
+__rte_experimental
+int
+rte_distributor_adaptive_set(struct rte_distributor *d, bool enable);
+
 /**
  * Get a set of mbufs that have been returned to the distributor by workers
  *
@@ -0,0 +1,308 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+
+#include <eal_export.h>
+#include <rte_bitops.h>
+#include <rte_common.h>
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_memcpy.h>
+#include <rte_memory.h>
+#include <rte_pause.h>
+
+#include "rte_dmadev.h"
+#include "rte_dma_memcpy.h"
+
+#define DM_DEFAULT_FUTURES	1024
+#define DM_DEFAULT_CPU_THRESHOLD	2048
+#define DM_DEFAULT_STRIPE_SIZE	(64 * 1024)
+#define DM_COMPLETED_BURST	32
+
+struct dm_future {
+	uint32_t id;
+	uint32_t pending; /* DMA operations not completed */
+	int status;
+};
+
+struct dm_chan {
+	int16_t dev_id;
+	uint16_t vchan;
+	uint32_t mask;
+	uint32_t head;
+	uint32_t tail;
+	/* Future index of each enqueued operation, in the channel order */
+	uint32_t *fifo;
+};
+
+struct rte_dma_memcpy {
+	uint16_t nb_chans;
+	uint16_t next_chan;
+	uint32_t cpu_threshold;
+	uint32_t stripe_size;
+	uint32_t mask;
+	uint32_t next_id;
+	bool iova_pa;
+	struct rte_dma_memcpy_stats stats;
+	struct dm_future *futures;
+	struct dm_chan chans[RTE_DMA_MEMCPY_MAX_CHANS];
+};
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_dma_memcpy_create, 26.03)
+struct rte_dma_memcpy *
+rte_dma_memcpy_create(const struct rte_dma_memcpy_params *params)
+{
+	struct rte_dma_info info;
+	struct rte_dma_memcpy *dm;
+	struct dm_chan *chan;
+	uint32_t nb_futures, i;
+
+	if (params == NULL || params->chans == NULL || params->nb_chans == 0 ||
+			params->nb_chans > RTE_DMA_MEMCPY_MAX_CHANS) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+	for (i = 0; i != params->nb_chans; i++) {
+		if (rte_dma_info_get(params->chans[i].dev_id, &info) != 0 ||
+				params->chans[i].vchan >= info.nb_vchans) {
+			rte_errno = EINVAL;
+			return NULL;
+		}
+	}
+
+	nb_futures = params->nb_futures != 0 ?
+			rte_align32pow2(params->nb_futures) : DM_DEFAULT_FUTURES;
+
+	dm = rte_zmalloc_socket(params->name, sizeof(*dm), 0, params->socket_id);
+	if (dm == NULL)
+		goto nomem;
+	dm->futures = rte_zmalloc_socket(params->name,
+			sizeof(*dm->futures) * nb_futures, RTE_CACHE_LINE_SIZE,
+			params->socket_id);
+	if (dm->futures == NULL)
+		goto nomem;
+	/* The ids of the futures not returned yet must not match their slot */
+	for (i = 0; i != nb_futures; i++)
+		dm->futures[i].id = i - nb_futures;
+
+	for (i = 0; i != params->nb_chans; i++) {
+		chan = &dm->chans[i];
+		rte_dma_info_get(params->chans[i].dev_id, &info);
+		/* A channel has no more operations pending than descriptors */
+		chan->mask = rte_align32pow2(info.max_desc) - 1;
+		chan->fifo = rte_malloc_socket(params->name,
+				sizeof(*chan->fifo) * (chan->mask + 1), 0,
+				params->socket_id);
+		if (chan->fifo == NULL)
+			goto nomem;
+		chan->dev_id = params->chans[i].dev_id;
+		chan->vchan = params->chans[i].vchan;
+	}
+
+	dm->nb_chans = params->nb_chans;
+	dm->mask = nb_futures - 1;
+	dm->cpu_threshold = params->cpu_threshold != 0 ?
+			params->cpu_threshold : DM_DEFAULT_CPU_THRESHOLD;
+	dm->stripe_size = params->stripe_size != 0 ?
+			params->stripe_size : DM_DEFAULT_STRIPE_SIZE;
+	dm->iova_pa = rte_eal_iova_mode() == RTE_IOVA_PA;
+
+	return dm;
+
+nomem:
+	rte_dma_memcpy_free(dm);
+	rte_errno = ENOMEM;
+	return NULL;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_dma_memcpy_free, 26.03)
+void
+rte_dma_memcpy_free(struct rte_dma_memcpy *dm)
+{
+	uint16_t i;
+
+	if (dm == NULL)
+		return;
+
+	for (i = 0; i != RTE_DMA_MEMCPY_MAX_CHANS; i++)
+		rte_free(dm->chans[i].fifo);
+	rte_free(dm->futures);
+	rte_free(dm);
+}
+
+/* IOVA of a buffer, or RTE_BAD_IOVA if not IOVA contiguous */
+static rte_iova_t
+dm_iova(const struct rte_dma_memcpy *dm, const void *addr, uint32_t length)
+{
+	const struct rte_memseg *ms;
+	size_t offset;
+
+	if (!dm->iova_pa)
+		return (uintptr_t)addr;
+
+	ms = rte_mem_virt2memseg(addr, NULL);
+	if (ms == NULL || ms->iova == RTE_BAD_IOVA)
+		return RTE_BAD_IOVA;
+	offset = RTE_PTR_DIFF(addr, ms->addr);
+	if (offset + length > ms->len)
+		return RTE_BAD_IOVA;
+
+	return ms->iova + offset;
+}
+
+static void
+dm_cpu_copy(struct rte_dma_memcpy *dm, void *dst, const void *src,
+		uint32_t length)
+{
+	rte_memcpy(dst, src, length);
+	dm->stats.cpu_copies++;
+	dm->stats.cpu_bytes += length;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_dma_memcpy_bulk_async, 26.03)
+int
+rte_dma_memcpy_bulk_async(struct rte_dma_memcpy *dm,
+		const struct rte_dma_memcpy_seg *segs, uint16_t nb_segs,
+		uint32_t *future)
+{
+	struct dm_future *fut = &dm->futures[dm->next_id & dm->mask];
+	uint32_t nb_stripes, stripe, offset, length;
+	rte_iova_t src_iova, dst_iova;
+	uint64_t submit = 0;
+	struct dm_chan *chan;
+	uint16_t i, c;
+
+	if (fut->pending != 0)
+		return -ENOSPC;
+
+	fut->id = dm->next_id;
+	fut->status = 0;
+
+	for (i = 0; i != nb_segs; i++) {
+		if (segs[i].length < dm->cpu_threshold)
+			goto cpu_copy;
+		src_iova = dm_iova(dm, segs[i].src, segs[i].length);
+		dst_iova = dm_iova(dm, segs[i].dst, segs[i].length);
+		if (src_iova == RTE_BAD_IOVA || dst_iova == RTE_BAD_IOVA)
+			goto cpu_copy;
+
+		/* Split the copy in stripes of the same size, cache aligned */
+		nb_stripes = RTE_MIN(segs[i].length / dm->stripe_size,
+				(uint32_t)dm->nb_chans);
+		stripe = segs[i].length;
+		if (nb_stripes > 1)
+			stripe = RTE_ALIGN_CEIL(stripe / nb_stripes,
+					RTE_CACHE_LINE_SIZE);
+
+		for (offset = 0; offset < segs[i].length; offset += length) {
+			length = RTE_MIN(stripe, segs[i].length - offset);
+			c = dm->next_chan;
+			if (++dm->next_chan == dm->nb_chans)
+				dm->next_chan = 0;
+			chan = &dm->chans[c];
+
+			if (chan->head - chan->tail > chan->mask ||
+					rte_dma_copy(chan->dev_id, chan->vchan,
+					src_iova + offset, dst_iova + offset,
+					length, 0) < 0) {
+				dm_cpu_copy(dm, RTE_PTR_ADD(segs[i].dst, offset),
+						RTE_PTR_ADD(segs[i].src, offset),
+						length);
+				dm->stats.fallbacks++;
+				continue;
+			}
+			chan->fifo[chan->head++ & chan->mask] =
+					dm->next_id & dm->mask;
+			fut->pending++;
+			submit |= RTE_BIT64(c);
+			dm->stats.dma_copies++;
+			dm->stats.dma_bytes += length;
+		}
+		continue;
+
+cpu_copy:
+		dm_cpu_copy(dm, segs[i].dst, segs[i].src, segs[i].length);
+	}
+
+	while (submit != 0) {
+		c = rte_ctz64(submit);
+		submit &= submit - 1;
+		rte_dma_submit(dm->chans[c].dev_id, dm->chans[c].vchan);
+	}
+
+	*future = dm->next_id++;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_dma_memcpy_poll, 26.03)
+uint32_t
+rte_dma_memcpy_poll(struct rte_dma_memcpy *dm)
+{
+	enum rte_dma_status_code status[DM_COMPLETED_BURST];
+	struct dm_future *fut;
+	struct dm_chan *chan;
+	uint32_t total = 0;
+	uint16_t c, n, i;
+
+	for (c = 0; c != dm->nb_chans; c++) {
+		chan = &dm->chans[c];
+		while (chan->head != chan->tail) {
+			n = rte_dma_completed_status(chan->dev_id, chan->vchan,
+					DM_COMPLETED_BURST, NULL, status);
+			for (i = 0; i != n; i++) {
+				fut = &dm->futures[chan->fifo[chan->tail++ &
+						chan->mask]];
+				if (status[i] != RTE_DMA_STATUS_SUCCESSFUL) {
+					fut->status = -EIO;
+					dm->stats.dma_errors++;
+				}
+				fut->pending--;
+			}
+			total += n;
+			if (n < DM_COMPLETED_BURST)
+				break;
+		}
+	}
+
+	return total;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_dma_memcpy_status, 26.03)
+int
+rte_dma_memcpy_status(const struct rte_dma_memcpy *dm, uint32_t future)
+{
+	const struct dm_future *fut = &dm->futures[future & dm->mask];
+
+	if (fut->id != future)
+		return -ESTALE;
+	if (fut->pending != 0)
+		return -EAGAIN;
+
+	return fut->status;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_dma_memcpy_wait, 26.03)
+int
+rte_dma_memcpy_wait(struct rte_dma_memcpy *dm, uint32_t future)
+{
+	int ret;
+
+	while ((ret = rte_dma_memcpy_status(dm, future)) == -EAGAIN) {
+		if (rte_dma_memcpy_poll(dm) == 0)
+			rte_pause();
+	}
+
+	return ret;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_dma_memcpy_stats_get, 26.03)
+void
+rte_dma_memcpy_stats_get(const struct rte_dma_memcpy *dm,
+		struct rte_dma_memcpy_stats *stats)
+{
+	*stats = dm->stats;
+}
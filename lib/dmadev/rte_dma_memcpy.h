@@ -0,0 +1,240 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef RTE_DMA_MEMCPY_H
+#define RTE_DMA_MEMCPY_H
+
+/**
+ * @file
+ * DMA memory copy offload
+ *
+ * Helper copying memory with a set of DMA virtual channels, or with the CPU
+ * when a copy is too small to amortize the DMA overhead:
+ * - the copies below a size threshold are done by the CPU at once,
+ * - the larger copies are split in stripes, enqueued to several channels,
+ * - a copy falls back to the CPU if the channels are full.
+ *
+ * Each call returns a future, to poll for the completion of its copies.
+ *
+ * A memory copy handle is not thread safe, and its virtual channels must be
+ * used by no one else. The virtual channels are configured by the application
+ * for memory to memory copies, and started before the handle is used.
+ *
+ * The buffers must be DMA capable, e.g. allocated with rte_malloc(). In IOVA
+ * as PA mode, the buffers not IOVA contiguous, i.e. crossing a page boundary,
+ * are copied by the CPU.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <rte_compat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of virtual channels of a memory copy handle. */
+#define RTE_DMA_MEMCPY_MAX_CHANS 64
+
+/** Handle of a memory copy offload. */
+struct rte_dma_memcpy;
+
+/** A DMA virtual channel. */
+struct rte_dma_memcpy_chan {
+	int16_t dev_id;  /**< DMA device identifier. */
+	uint16_t vchan;  /**< Virtual channel of the device. */
+};
+
+/** Memory copy offload parameters. */
+struct rte_dma_memcpy_params {
+	const char *name;  /**< Name of the handle. */
+	int socket_id;     /**< Socket of the handle memory. */
+	/** Virtual channels to copy with, at most RTE_DMA_MEMCPY_MAX_CHANS. */
+	const struct rte_dma_memcpy_chan *chans;
+	uint16_t nb_chans; /**< Number of virtual channels. */
+	/**
+	 * Maximum number of pending futures, rounded up to a power of 2.
+	 * 0 for the default of 1024.
+	 */
+	uint32_t nb_futures;
+	/**
+	 * Size from which a copy is offloaded to DMA, smaller copies being
+	 * done by the CPU. 0 for the default of 2048 bytes.
+	 */
+	uint32_t cpu_threshold;
+	/**
+	 * Minimum size of a stripe, a copy being split in stripes across the
+	 * virtual channels. 0 for the default of 64 KB.
+	 */
+	uint32_t stripe_size;
+};
+
+/** A segment of a batch of copies. */
+struct rte_dma_memcpy_seg {
+	void *dst;         /**< Destination address. */
+	const void *src;   /**< Source address. */
+	uint32_t length;   /**< Length in bytes. */
+};
+
+/** Memory copy offload statistics. */
+struct rte_dma_memcpy_stats {
+	uint64_t cpu_copies;   /**< Copies done by the CPU. */
+	uint64_t cpu_bytes;    /**< Bytes copied by the CPU. */
+	uint64_t dma_copies;   /**< DMA operations enqueued. */
+	uint64_t dma_bytes;    /**< Bytes enqueued to DMA. */
+	uint64_t dma_errors;   /**< DMA operations failed. */
+	uint64_t fallbacks;    /**< Copies done by the CPU on full channels. */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a memory copy offload handle.
+ *
+ * @param params
+ *   The memory copy offload parameters.
+ * @return
+ *   The handle, or NULL on error with rte_errno set.
+ */
+__rte_experimental
+struct rte_dma_memcpy *
+rte_dma_memcpy_create(const struct rte_dma_memcpy_params *params);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free a memory copy offload handle. The pending copies are not waited for.
+ *
+ * @param dm
+ *   The handle, can be NULL.
+ */
+__rte_experimental
+void
+rte_dma_memcpy_free(struct rte_dma_memcpy *dm);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Copy a batch of segments. The copies are submitted to the virtual channels
+ * before returning.
+ *
+ * @param dm
+ *   The handle.
+ * @param segs
+ *   The segments to copy.
+ * @param nb_segs
+ *   The number of segments.
+ * @param[out] future
+ *   The future of the copies, to pass to rte_dma_memcpy_status().
+ * @return
+ *   - 0 on success.
+ *   - -ENOSPC if too many futures are pending, rte_dma_memcpy_poll() must
+ *     be called to complete them.
+ */
+__rte_experimental
+int
+rte_dma_memcpy_bulk_async(struct rte_dma_memcpy *dm,
+		const struct rte_dma_memcpy_seg *segs, uint16_t nb_segs,
+		uint32_t *future);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Copy a buffer.
+ *
+ * @see rte_dma_memcpy_bulk_async()
+ */
+__rte_experimental
+static inline int
+rte_dma_memcpy_async(struct rte_dma_memcpy *dm, void *dst, const void *src,
+		uint32_t length, uint32_t *future)
+{
+	struct rte_dma_memcpy_seg seg = {
+		.dst = dst,
+		.src = src,
+		.length = length,
+	};
+
+	return rte_dma_memcpy_bulk_async(dm, &seg, 1, future);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Gather the completed DMA operations of the virtual channels, and update
+ * the futures they belong to.
+ *
+ * @param dm
+ *   The handle.
+ * @return
+ *   The number of completed DMA operations.
+ */
+__rte_experimental
+uint32_t
+rte_dma_memcpy_poll(struct rte_dma_memcpy *dm);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the status of a future, as of the last rte_dma_memcpy_poll().
+ *
+ * @param dm
+ *   The handle.
+ * @param future
+ *   The future.
+ * @return
+ *   - 0 if the copies are done.
+ *   - -EAGAIN if copies are pending.
+ *   - -EIO if a DMA operation failed.
+ *   - -ESTALE if the future is too old, its status being lost.
+ */
+__rte_experimental
+int
+rte_dma_memcpy_status(const struct rte_dma_memcpy *dm, uint32_t future);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Poll until the copies of a future are done.
+ *
+ * @param dm
+ *   The handle.
+ * @param future
+ *   The future.
+ * @return
+ *   The status of the future, not -EAGAIN.
+ */
+__rte_experimental
+int
+rte_dma_memcpy_wait(struct rte_dma_memcpy *dm, uint32_t future);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the statistics of a memory copy offload handle.
+ *
+ * @param dm
+ *   The handle.
+ * @param stats
+ *   The statistics to fill.
+ */
+__rte_experimental
+void
+rte_dma_memcpy_stats_get(const struct rte_dma_memcpy *dm,
+		struct rte_dma_memcpy_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RTE_DMA_MEMCPY_H */
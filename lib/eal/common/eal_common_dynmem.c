@@ -4,16 +4,19 @@
  */
 
 #include <inttypes.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include <rte_log.h>
 #include <rte_string_fns.h>
+#include <rte_thread.h>
 
 #include "eal_internal_cfg.h"
 #include "eal_memalloc.h"
 #include "eal_memcfg.h"
 #include "eal_private.h"
+#include "eal_thread.h"
 
 /** @file Functions common to EALs that support dynamic memory allocation. */
 
@@ -222,6 +225,166 @@ limits_callback(int socket_id, size_t cur_limit, size_t new_len)
 	return -1;
 }
 
+static int
+dynmem_alloc_pages(struct hugepage_info *hpi, int socket_id, bool clear)
+{
+	struct rte_memseg **pages;
+	unsigned int num_pages = hpi->num_pages[socket_id];
+	unsigned int num_pages_alloc;
+
+	if (num_pages == 0)
+		return 0;
+
+	EAL_LOG(DEBUG,
+		"Allocating %u pages of size %" PRIu64 "M "
+		"on socket %i",
+		num_pages, hpi->hugepage_sz >> 20, socket_id);
+
+	/* we may not be able to allocate all pages in one go,
+	 * because we break up our memory map into multiple
+	 * memseg lists. therefore, try allocating multiple
+	 * times and see if we can get the desired number of
+	 * pages from multiple allocations.
+	 */
+
+	num_pages_alloc = 0;
+	do {
+		int i, cur_pages, needed;
+
+		needed = num_pages - num_pages_alloc;
+
+		pages = malloc(sizeof(*pages) * needed);
+		if (pages == NULL) {
+			EAL_LOG(ERR, "Failed to malloc pages");
+			return -1;
+		}
+
+		/* do not request exact number of pages */
+		cur_pages = eal_memalloc_alloc_seg_bulk(pages,
+				needed, hpi->hugepage_sz,
+				socket_id, false);
+		if (cur_pages <= 0) {
+			free(pages);
+			return -1;
+		}
+
+		/* mark preallocated pages as unfreeable */
+		for (i = 0; i < cur_pages; i++) {
+			struct rte_memseg *ms = pages[i];
+			ms->flags |= RTE_MEMSEG_FLAG_DO_NOT_FREE;
+
+			/* pages cleared by the kernel are not cleared again */
+			if (clear && (ms->flags & RTE_MEMSEG_FLAG_DIRTY)) {
+				memset(ms->addr, 0, ms->len);
+				ms->flags &= ~RTE_MEMSEG_FLAG_DIRTY;
+			}
+		}
+		free(pages);
+
+		num_pages_alloc += cur_pages;
+	} while (num_pages_alloc != num_pages);
+
+	return 0;
+}
+
+/* Initial memory allocation of a NUMA node, in its own thread. */
+struct dynmem_node_init {
+	struct hugepage_info *used_hp;
+	unsigned int num_hugepage_sizes;
+	int socket_id;
+	bool clear;
+	int ret;
+	rte_thread_t thread;
+};
+
+static uint32_t
+dynmem_node_init_thread(void *arg)
+{
+	struct dynmem_node_init *ni = arg;
+	unsigned int hp_sz_idx;
+
+	ni->ret = 0;
+	for (hp_sz_idx = 0; hp_sz_idx < ni->num_hugepage_sizes; hp_sz_idx++) {
+		if (dynmem_alloc_pages(&ni->used_hp[hp_sz_idx],
+				ni->socket_id, ni->clear) < 0) {
+			ni->ret = -1;
+			break;
+		}
+	}
+
+	return 0;
+}
+
+/*
+ * Allocate the initial memory of each NUMA node in a separate thread,
+ * running on the CPUs of the node, so that the kernel faults and clears
+ * the hugepages of all nodes at the same time. The memory hotplug lock is
+ * held by the caller, and each thread only touches the memseg lists of its
+ * own node.
+ */
+static int
+dynmem_parallel_init(struct hugepage_info *used_hp,
+		unsigned int num_hugepage_sizes, bool clear)
+{
+	struct dynmem_node_init nodes[RTE_MAX_NUMA_NODES];
+	rte_thread_attr_t attr;
+	rte_cpuset_t cpuset;
+	char name[RTE_THREAD_INTERNAL_NAME_SIZE];
+	unsigned int hp_sz_idx, cpu, n, i;
+	bool has_cpu, has_pages;
+	int socket_id, ret = 0;
+
+	n = 0;
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
+		struct dynmem_node_init *ni = &nodes[n];
+
+		has_pages = false;
+		for (hp_sz_idx = 0; hp_sz_idx < num_hugepage_sizes; hp_sz_idx++)
+			has_pages |= used_hp[hp_sz_idx].num_pages[socket_id] != 0;
+		if (!has_pages)
+			continue;
+
+		ni->used_hp = used_hp;
+		ni->num_hugepage_sizes = num_hugepage_sizes;
+		ni->socket_id = socket_id;
+		ni->clear = clear;
+		ni->ret = -1;
+
+		/* the kernel clears the hugepages on the faulting CPU */
+		CPU_ZERO(&cpuset);
+		has_cpu = false;
+		for (cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+			if (eal_cpu_detected(cpu) &&
+					eal_cpu_socket_id(cpu) == (unsigned int)socket_id) {
+				CPU_SET(cpu, &cpuset);
+				has_cpu = true;
+			}
+		}
+
+		rte_thread_attr_init(&attr);
+		if (has_cpu)
+			rte_thread_attr_set_affinity(&attr, &cpuset);
+		if (rte_thread_create(&ni->thread, &attr,
+				dynmem_node_init_thread, ni) != 0) {
+			EAL_LOG(ERR, "Cannot create memory init thread for socket %i",
+				socket_id);
+			ret = -1;
+			break;
+		}
+		snprintf(name, sizeof(name), "mem-%i", socket_id);
+		rte_thread_set_prefixed_name(ni->thread, name);
+		n++;
+	}
+
+	for (i = 0; i < n; i++) {
+		rte_thread_join(nodes[i].thread, NULL);
+		if (nodes[i].ret < 0)
+			ret = -1;
+	}
+
+	return ret;
+}
+
 int
 eal_dynmem_hugepage_init(void)
 {
@@ -274,62 +437,21 @@ eal_dynmem_hugepage_init(void)
 			internal_conf->num_hugepage_sizes) < 0)
 		return -1;
 
-	for (hp_sz_idx = 0;
-			hp_sz_idx < (int)internal_conf->num_hugepage_sizes;
-			hp_sz_idx++) {
-		for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES;
-				socket_id++) {
-			struct rte_memseg **pages;
-			struct hugepage_info *hpi = &used_hp[hp_sz_idx];
-			unsigned int num_pages = hpi->num_pages[socket_id];
-			unsigned int num_pages_alloc;
-
-			if (num_pages == 0)
-				continue;
-
-			EAL_LOG(DEBUG,
-				"Allocating %u pages of size %" PRIu64 "M "
-				"on socket %i",
-				num_pages, hpi->hugepage_sz >> 20, socket_id);
-
-			/* we may not be able to allocate all pages in one go,
-			 * because we break up our memory map into multiple
-			 * memseg lists. therefore, try allocating multiple
-			 * times and see if we can get the desired number of
-			 * pages from multiple allocations.
-			 */
-
-			num_pages_alloc = 0;
-			do {
-				int i, cur_pages, needed;
-
-				needed = num_pages - num_pages_alloc;
-
-				pages = malloc(sizeof(*pages) * needed);
-				if (pages == NULL) {
-					EAL_LOG(ERR, "Failed to malloc pages");
-					return -1;
-				}
-
-				/* do not request exact number of pages */
-				cur_pages = eal_memalloc_alloc_seg_bulk(pages,
-						needed, hpi->hugepage_sz,
-						socket_id, false);
-				if (cur_pages <= 0) {
-					free(pages);
+	if (internal_conf->parallel_mem_init) {
+		if (dynmem_parallel_init(used_hp,
+				internal_conf->num_hugepage_sizes,
+				internal_conf->parallel_mem_clear) < 0)
+			return -1;
+	} else {
+		for (hp_sz_idx = 0;
+				hp_sz_idx < (int)internal_conf->num_hugepage_sizes;
+				hp_sz_idx++) {
+			for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES;
+					socket_id++) {
+				if (dynmem_alloc_pages(&used_hp[hp_sz_idx],
+						socket_id, false) < 0)
 					return -1;
-				}
-
-				/* mark preallocated pages as unfreeable */
-				for (i = 0; i < cur_pages; i++) {
-					struct rte_memseg *ms = pages[i];
-					ms->flags |=
-						RTE_MEMSEG_FLAG_DO_NOT_FREE;
-				}
-				free(pages);
-
-				num_pages_alloc += cur_pages;
-			} while (num_pages_alloc != num_pages);
+			}
 		}
 	}
 
@@ -19,6 +19,11 @@
 #include "eal_private.h"
 #include "eal_thread.h"
 
+#define LCORE_DOMAIN_COUNT (RTE_LCORE_DOMAIN_CLUSTER + 1)
+
+/* topology domain IDs of each cpu, -1 when unknown */
+static int cpu_domain_id[CPU_SETSIZE][LCORE_DOMAIN_COUNT];
+
 RTE_EXPORT_SYMBOL(rte_get_main_lcore)
 unsigned int rte_get_main_lcore(void)
 {
@@ -69,6 +74,33 @@ rte_cpuset_t rte_lcore_cpuset(unsigned int lcore_id)
 	return lcore_config[lcore_id].cpuset;
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_lcore_domain_id, 26.03)
+int
+rte_lcore_domain_id(unsigned int lcore_id, enum rte_lcore_domain domain)
+{
+	unsigned int cpu;
+	int id = -1;
+
+	if (lcore_id >= RTE_MAX_LCORE || (unsigned int)domain >= LCORE_DOMAIN_COUNT)
+		return -EINVAL;
+
+	for (cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+		if (!CPU_ISSET(cpu, &lcore_config[lcore_id].cpuset))
+			continue;
+		if (cpu_domain_id[cpu][domain] < 0)
+			return -ENOTSUP;
+		if (id >= 0 && id != cpu_domain_id[cpu][domain])
+			return -ENOENT;
+		id = cpu_domain_id[cpu][domain];
+	}
+
+	/* no cpu, the lcore is not in use */
+	if (id < 0)
+		return -EINVAL;
+
+	return id;
+}
+
 RTE_EXPORT_SYMBOL(rte_eal_lcore_role)
 enum rte_lcore_role_t
 rte_eal_lcore_role(unsigned int lcore_id)
@@ -142,6 +174,16 @@ socket_id_cmp(const void *a, const void *b)
 	return 0;
 }
 
+static void
+cpu_domains_init(unsigned int cpu, bool detected)
+{
+	unsigned int domain;
+
+	for (domain = 0; domain < LCORE_DOMAIN_COUNT; domain++)
+		cpu_domain_id[cpu][domain] = detected ?
+			eal_cpu_domain_id(cpu, domain) : -1;
+}
+
 /*
  * Parse /sys/devices/system/cpu to get the number of physical and logical
  * processors on the machine. The function will fill the cpu_info
@@ -178,8 +220,10 @@ rte_eal_cpu_init(void)
 		if (eal_cpu_detected(lcore_id) == 0) {
 			config->lcore_role[lcore_id] = ROLE_OFF;
 			lcore_config[lcore_id].core_index = -1;
+			cpu_domains_init(lcore_id, false);
 			continue;
 		}
+		cpu_domains_init(lcore_id, true);
 
 		/* By default, lcore 1:1 map to cpu id */
 		CPU_SET(lcore_id, &lcore_config[lcore_id].cpuset);
@@ -196,8 +240,11 @@ rte_eal_cpu_init(void)
 		count++;
 	}
 	for (; lcore_id < CPU_SETSIZE; lcore_id++) {
-		if (eal_cpu_detected(lcore_id) == 0)
+		if (eal_cpu_detected(lcore_id) == 0) {
+			cpu_domains_init(lcore_id, false);
 			continue;
+		}
+		cpu_domains_init(lcore_id, true);
 		socket_id = eal_cpu_socket_id(lcore_id);
 		lcore_to_socket_id[lcore_id] = socket_id;
 		EAL_LOG(DEBUG, "Skipped lcore %u as core %u on NUMA node %u",
@@ -550,6 +597,13 @@ format_usage_ratio(char *buf, uint16_t size, const struct rte_lcore_usage *usage
 	snprintf(buf, size, "%.02f%%", ratio);
 }
 
+static const char * const domain_names[LCORE_DOMAIN_COUNT] = {
+	[RTE_LCORE_DOMAIN_SMT] = "smt_domain",
+	[RTE_LCORE_DOMAIN_L2] = "l2_domain",
+	[RTE_LCORE_DOMAIN_L3] = "l3_domain",
+	[RTE_LCORE_DOMAIN_CLUSTER] = "cluster_domain",
+};
+
 static int
 lcore_telemetry_info_cb(unsigned int lcore_id, void *arg)
 {
@@ -559,7 +613,7 @@ lcore_telemetry_info_cb(unsigned int lcore_id, void *arg)
 	struct rte_lcore_usage usage;
 	struct rte_tel_data *cpuset;
 	rte_lcore_usage_cb usage_cb;
-	unsigned int cpu;
+	unsigned int cpu, domain;
 
 	if (lcore_id != info->lcore_id)
 		return 0;
@@ -577,6 +631,12 @@ lcore_telemetry_info_cb(unsigned int lcore_id, void *arg)
 			rte_tel_data_add_array_int(cpuset, cpu);
 	}
 	rte_tel_data_add_dict_container(info->d, "cpuset", cpuset, 0);
+	for (domain = 0; domain < LCORE_DOMAIN_COUNT; domain++) {
+		int id = rte_lcore_domain_id(lcore_id, domain);
+
+		if (id >= 0)
+			rte_tel_data_add_dict_int(info->d, domain_names[domain], id);
+	}
 	/* The callback may not set all the fields in the structure, so clear it here. */
 	memset(&usage, 0, sizeof(usage));
 	/* Guard against concurrent modification of lcore_usage_cb. */
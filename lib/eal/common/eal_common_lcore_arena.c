@@ -0,0 +1,89 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Ericsson AB
+ */
+
+#include <inttypes.h>
+
+#include <rte_common.h>
+#include <rte_errno.h>
+#include <rte_lcore.h>
+#include <rte_log.h>
+#include <rte_malloc.h>
+
+#include <rte_lcore_arena.h>
+
+#include <eal_export.h>
+#include "eal_private.h"
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_lcore_arena_create, 26.03)
+struct rte_lcore_arena *
+rte_lcore_arena_create(size_t size)
+{
+	struct rte_lcore_arena_lcore *lcore;
+	struct rte_lcore_arena *arena;
+	unsigned int lcore_id;
+	int socket_id;
+
+	if (size == 0) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	arena = rte_zmalloc("lcore_arena", sizeof(*arena), RTE_CACHE_LINE_SIZE);
+	if (arena == NULL) {
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+	arena->size = size;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		if (rte_eal_lcore_role(lcore_id) == ROLE_OFF)
+			continue;
+
+		lcore = &arena->lcores[lcore_id];
+		socket_id = rte_lcore_to_socket_id(lcore_id);
+		lcore->base = rte_malloc_socket("lcore_arena", size,
+				RTE_CACHE_LINE_SIZE, socket_id);
+		if (lcore->base == NULL)
+			lcore->base = rte_malloc_socket("lcore_arena", size,
+					RTE_CACHE_LINE_SIZE, SOCKET_ID_ANY);
+		if (lcore->base == NULL) {
+			EAL_LOG(ERR, "Cannot allocate %zu bytes of arena for lcore %u",
+				size, lcore_id);
+			rte_lcore_arena_free(arena);
+			rte_errno = ENOMEM;
+			return NULL;
+		}
+		lcore->size = size;
+	}
+
+	EAL_LOG(DEBUG, "Allocated lcore arena of %zu bytes per lcore", size);
+
+	return arena;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_lcore_arena_free, 26.03)
+void
+rte_lcore_arena_free(struct rte_lcore_arena *arena)
+{
+	unsigned int lcore_id;
+
+	if (arena == NULL)
+		return;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++)
+		rte_free(arena->lcores[lcore_id].base);
+
+	rte_free(arena);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_lcore_arena_high_water, 26.03)
+size_t
+rte_lcore_arena_high_water(const struct rte_lcore_arena *arena,
+		unsigned int lcore_id)
+{
+	if (arena == NULL || lcore_id >= RTE_MAX_LCORE)
+		return 0;
+
+	return arena->lcores[lcore_id].high;
+}
@@ -248,7 +248,9 @@ eal_collate_args(int argc, char **argv)
 			CONFLICTING_OPTIONS(args, no_huge, huge_unlink) ||
 			CONFLICTING_OPTIONS(args, single_file_segments, huge_unlink) ||
 			CONFLICTING_OPTIONS(args, no_huge, single_file_segments) ||
-			CONFLICTING_OPTIONS(args, in_memory, huge_unlink))
+			CONFLICTING_OPTIONS(args, in_memory, huge_unlink) ||
+			CONFLICTING_OPTIONS(args, legacy_mem, huge_parallel_init) ||
+			CONFLICTING_OPTIONS(args, no_huge, huge_parallel_init))
 		return -1;
 
 	argv[retval - 1] = argv[0];
@@ -512,6 +514,9 @@ eal_reset_internal_config(struct internal_config *internal_cfg)
 		internal_cfg->hugepage_info[i].lock_descriptor = -1;
 	}
 	internal_cfg->base_virtaddr = 0;
+	internal_cfg->parallel_mem_init = 0;
+	internal_cfg->malloc_cache = 0;
+	internal_cfg->parallel_mem_clear = 0;
 
 	/* if set to NONE, interrupt mode is determined automatically */
 	internal_cfg->vfio_intr_mode = RTE_INTR_MODE_NONE;
@@ -1778,6 +1783,21 @@ eal_parse_huge_unlink(const char *arg, struct hugepage_file_discipline *out)
 	return -1;
 }
 
+static int
+eal_parse_huge_parallel_init(const char *arg, struct internal_config *cfg)
+{
+	if (arg == NULL) {
+		cfg->parallel_mem_init = 1;
+		return 0;
+	}
+	if (strcmp(arg, "clear") == 0) {
+		cfg->parallel_mem_init = 1;
+		cfg->parallel_mem_clear = 1;
+		return 0;
+	}
+	return -1;
+}
+
 /* Parse all arguments looking for log related ones */
 int
 eal_parse_log_options(void)
@@ -2157,6 +2177,14 @@ eal_parse_args(void)
 			return -1;
 		}
 	}
+	if (args.huge_parallel_init != NULL) {
+		if (args.huge_parallel_init == (void *)1)
+			args.huge_parallel_init = NULL;
+		if (eal_parse_huge_parallel_init(args.huge_parallel_init, int_cfg) < 0) {
+			EAL_LOG(ERR, "invalid huge-parallel-init parameter");
+			return -1;
+		}
+	}
 	if (args.numa_mem != NULL) {
 		if (eal_parse_socket_arg(args.numa_mem, int_cfg->numa_mem) < 0) {
 			EAL_LOG(ERR, "invalid numa-mem parameter: '%s'", args.numa_mem);
@@ -2222,6 +2250,8 @@ eal_parse_args(void)
 		int_cfg->no_telemetry = 1;
 	if (args.match_allocations)
 		int_cfg->match_allocations = 1;
+	if (args.malloc_cache)
+		int_cfg->malloc_cache = 1;
 	if (args.create_uio_dev)
 		int_cfg->create_uio_dev = 1;
 
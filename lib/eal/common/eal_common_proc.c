@@ -12,8 +12,11 @@
 #include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <signal.h>
 #include <string.h>
 #include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -39,6 +42,8 @@ static rte_thread_t mp_handle_tid;
 static char mp_filter[UNIX_PATH_MAX];   /* Filter for secondary process sockets */
 static char mp_dir_path[UNIX_PATH_MAX]; /* The directory path for all mp sockets */
 static pthread_mutex_t mp_mutex_action = PTHREAD_MUTEX_INITIALIZER;
+/* serializes the actions run by the mp and mp-shm threads */
+static pthread_mutex_t mp_mutex_dispatch = PTHREAD_MUTEX_INITIALIZER;
 static char peer_name[UNIX_PATH_MAX];
 
 struct action_entry {
@@ -103,6 +108,56 @@ static struct {
 	/**< used in async requests only */
 };
 
+/*
+ * Synchronous requests of secondary processes to the primary process,
+ * without file descriptors, go over shared memory rather than the socket.
+ * Each secondary process owns a slot, in which it posts one request at a
+ * time, and which the primary process serves from a dedicated thread.
+ * A reply given synchronously by the action is written back in the slot,
+ * any other reply is sent over the socket.
+ * The actions are run one at a time, whether the request comes from the
+ * socket or from a slot, as they were when the mp thread ran them all.
+ * The requests of the threads of a secondary process share its slot,
+ * so they are posted one at a time, without holding pending_requests.lock.
+ */
+#define MP_SHM_MAGIC 0x6d707368 /* "mpsh" */
+#define MP_SHM_SLOTS 64
+
+enum mp_shm_state {
+	MP_SHM_IDLE,  /* no request */
+	MP_SHM_REQ,   /* request posted by the secondary process */
+	MP_SHM_BUSY,  /* request being processed by the primary process */
+	MP_SHM_REP,   /* reply written in the slot */
+	MP_SHM_IGN,   /* reply telling requester to ignore this response */
+	MP_SHM_SOCK,  /* reply sent over the socket, if any */
+};
+
+struct mp_shm_slot {
+	pthread_mutex_t lock;       /* protects the state and the message */
+	pthread_cond_t cond;        /* signals the state changes */
+	RTE_ATOMIC(int) pid;        /* owner process, 0 if free */
+	int state;
+	char peer[UNIX_PATH_MAX];   /* socket path of the owner process */
+	struct rte_mp_msg msg;
+};
+
+struct mp_shm {
+	RTE_ATOMIC(uint32_t) magic; /* set once initialized */
+	pthread_mutex_t lock;       /* protects pending */
+	pthread_cond_t cond;        /* signals pending requests */
+	uint32_t pending;           /* requests posted since the last scan */
+	struct mp_shm_slot slots[MP_SHM_SLOTS];
+};
+
+static struct mp_shm *mp_shm;
+static struct mp_shm_slot *mp_shm_own; /* slot of a secondary process */
+static pthread_mutex_t mp_shm_own_lock = PTHREAD_MUTEX_INITIALIZER;
+static rte_thread_t mp_shm_tid;
+static bool mp_shm_running;
+
+/* slot of the request processed by the calling thread, if any */
+static RTE_DEFINE_PER_LCORE(struct mp_shm_slot *, mp_shm_cur);
+
 /* forward declarations */
 static int
 mp_send(struct rte_mp_msg *msg, const char *peer, int type);
@@ -400,8 +455,11 @@ process_msg(struct mp_msg_internal *m, struct sockaddr_un *s)
 				msg->name);
 		}
 		cleanup_msg_fds(msg);
-	} else if (action(msg, s->sun_path) < 0) {
-		EAL_LOG(ERR, "Fail to handle message: %s", msg->name);
+	} else {
+		pthread_mutex_lock(&mp_mutex_dispatch);
+		if (action(msg, s->sun_path) < 0)
+			EAL_LOG(ERR, "Fail to handle message: %s", msg->name);
+		pthread_mutex_unlock(&mp_mutex_dispatch);
 	}
 }
 
@@ -425,6 +483,326 @@ mp_handle(void *arg __rte_unused)
 	return 0;
 }
 
+/* Lock a shared mutex, which may have been left locked by a dead process */
+static void
+mp_shm_lock(pthread_mutex_t *lock)
+{
+	if (pthread_mutex_lock(lock) == EOWNERDEAD)
+		pthread_mutex_consistent(lock);
+}
+
+/* Wait on a shared condition, until a deadline if not NULL */
+static int
+mp_shm_wait(pthread_cond_t *cond, pthread_mutex_t *lock,
+		const struct timespec *ts)
+{
+	int ret;
+
+	if (ts == NULL)
+		ret = pthread_cond_wait(cond, lock);
+	else
+		ret = pthread_cond_timedwait(cond, lock, ts);
+	if (ret == EOWNERDEAD) {
+		pthread_mutex_consistent(lock);
+		ret = 0;
+	}
+
+	return ret;
+}
+
+static void
+mp_shm_process(struct mp_shm_slot *slot)
+{
+	const struct internal_config *internal_conf =
+		eal_get_internal_configuration();
+	struct action_entry *entry;
+	rte_mp_t action = NULL;
+	struct rte_mp_msg msg;
+	char peer[UNIX_PATH_MAX];
+	int state;
+
+	mp_shm_lock(&slot->lock);
+	if (slot->state != MP_SHM_REQ) {
+		pthread_mutex_unlock(&slot->lock);
+		return;
+	}
+	slot->state = MP_SHM_BUSY;
+	memcpy(&msg, &slot->msg, sizeof(msg));
+	strlcpy(peer, slot->peer, sizeof(peer));
+	pthread_mutex_unlock(&slot->lock);
+
+	EAL_LOG(DEBUG, "shm msg: %s", msg.name);
+
+	pthread_mutex_lock(&mp_mutex_action);
+	entry = find_action_entry_by_name(msg.name);
+	if (entry != NULL)
+		action = entry->action;
+	pthread_mutex_unlock(&mp_mutex_action);
+
+	state = MP_SHM_SOCK;
+	if (action == NULL) {
+		/* same as a request received over the socket */
+		if (!internal_conf->init_complete)
+			state = MP_SHM_IGN;
+		else
+			EAL_LOG(ERR, "Cannot find action: %s", msg.name);
+	} else {
+		pthread_mutex_lock(&mp_mutex_dispatch);
+		RTE_PER_LCORE(mp_shm_cur) = slot;
+		if (action(&msg, peer) < 0)
+			EAL_LOG(ERR, "Fail to handle message: %s", msg.name);
+		RTE_PER_LCORE(mp_shm_cur) = NULL;
+		pthread_mutex_unlock(&mp_mutex_dispatch);
+	}
+
+	/* the reply is in the slot if the action replied synchronously */
+	mp_shm_lock(&slot->lock);
+	if (slot->state == MP_SHM_BUSY)
+		slot->state = state;
+	pthread_cond_signal(&slot->cond);
+	pthread_mutex_unlock(&slot->lock);
+}
+
+static uint32_t
+mp_shm_handle(void *arg __rte_unused)
+{
+	unsigned int i;
+
+	for (;;) {
+		mp_shm_lock(&mp_shm->lock);
+		while (mp_shm->pending == 0 && mp_shm_running)
+			mp_shm_wait(&mp_shm->cond, &mp_shm->lock, NULL);
+		if (!mp_shm_running) {
+			pthread_mutex_unlock(&mp_shm->lock);
+			break;
+		}
+		/* requests posted from now on are seen by the next scan */
+		mp_shm->pending = 0;
+		pthread_mutex_unlock(&mp_shm->lock);
+
+		for (i = 0; i < MP_SHM_SLOTS; i++)
+			mp_shm_process(&mp_shm->slots[i]);
+	}
+
+	return 0;
+}
+
+/* Write a reply in the slot of the request being processed, if possible */
+static int
+mp_shm_reply(const struct rte_mp_msg *msg, const char *peer)
+{
+	struct mp_shm_slot *slot = RTE_PER_LCORE(mp_shm_cur);
+
+	/* file descriptors can only be passed over the socket */
+	if (slot == NULL || msg->num_fds != 0 || strcmp(peer, slot->peer) != 0)
+		return -1;
+
+	mp_shm_lock(&slot->lock);
+	memcpy(&slot->msg, msg, sizeof(*msg));
+	slot->state = MP_SHM_REP;
+	pthread_mutex_unlock(&slot->lock);
+	/* only the first reply goes in the slot */
+	RTE_PER_LCORE(mp_shm_cur) = NULL;
+
+	return 0;
+}
+
+/*
+ * Post a request in the slot of the secondary process and wait for the
+ * primary process to process it. Returns the final state of the slot,
+ * or -1 on timeout.
+ * Must be called without pending_requests.lock, not to block the replies
+ * received over the socket while waiting.
+ */
+static int
+mp_shm_request(struct rte_mp_msg *req, struct rte_mp_msg *reply,
+		const struct timespec *ts)
+{
+	struct mp_shm_slot *slot = mp_shm_own;
+	int ret = 0, state;
+
+	pthread_mutex_lock(&mp_shm_own_lock);
+	mp_shm_lock(&slot->lock);
+	/* a timed out request may still be processed */
+	while (slot->state == MP_SHM_BUSY && ret != ETIMEDOUT)
+		ret = mp_shm_wait(&slot->cond, &slot->lock, ts);
+	if (slot->state == MP_SHM_BUSY) {
+		pthread_mutex_unlock(&slot->lock);
+		pthread_mutex_unlock(&mp_shm_own_lock);
+		return -1;
+	}
+
+	memcpy(&slot->msg, req, sizeof(*req));
+	slot->state = MP_SHM_REQ;
+
+	mp_shm_lock(&mp_shm->lock);
+	mp_shm->pending++;
+	pthread_cond_signal(&mp_shm->cond);
+	pthread_mutex_unlock(&mp_shm->lock);
+
+	while ((slot->state == MP_SHM_REQ || slot->state == MP_SHM_BUSY) &&
+			ret != ETIMEDOUT)
+		ret = mp_shm_wait(&slot->cond, &slot->lock, ts);
+
+	state = slot->state;
+	if (state == MP_SHM_REQ) {
+		/* not picked up by the primary process, cancel it */
+		slot->state = MP_SHM_IDLE;
+		state = -1;
+	} else if (state == MP_SHM_BUSY) {
+		state = -1;
+	} else if (state == MP_SHM_REP) {
+		memcpy(reply, &slot->msg, sizeof(*reply));
+	}
+	pthread_mutex_unlock(&slot->lock);
+	pthread_mutex_unlock(&mp_shm_own_lock);
+
+	return state;
+}
+
+static int
+mp_shm_init_primary(void)
+{
+	pthread_mutexattr_t mattr;
+	pthread_condattr_t cattr;
+	const char *path = eal_mp_shm_path();
+	unsigned int i;
+	void *addr;
+	int fd;
+
+	unlink(path); /* May still exist since last run */
+	fd = open(path, O_RDWR | O_CREAT | O_EXCL, 0600);
+	if (fd < 0 || ftruncate(fd, sizeof(*mp_shm)) < 0) {
+		EAL_LOG(ERR, "failed to create %s: %s", path, strerror(errno));
+		if (fd >= 0)
+			close(fd);
+		return -1;
+	}
+	addr = mmap(NULL, sizeof(*mp_shm), PROT_READ | PROT_WRITE,
+		MAP_SHARED, fd, 0);
+	close(fd);
+	if (addr == MAP_FAILED) {
+		EAL_LOG(ERR, "failed to map %s: %s", path, strerror(errno));
+		unlink(path);
+		return -1;
+	}
+	mp_shm = addr;
+
+	pthread_mutexattr_init(&mattr);
+	pthread_mutexattr_setpshared(&mattr, PTHREAD_PROCESS_SHARED);
+	pthread_mutexattr_setrobust(&mattr, PTHREAD_MUTEX_ROBUST);
+	pthread_condattr_init(&cattr);
+	pthread_condattr_setpshared(&cattr, PTHREAD_PROCESS_SHARED);
+	pthread_condattr_setclock(&cattr, CLOCK_MONOTONIC);
+
+	pthread_mutex_init(&mp_shm->lock, &mattr);
+	pthread_cond_init(&mp_shm->cond, &cattr);
+	for (i = 0; i < MP_SHM_SLOTS; i++) {
+		pthread_mutex_init(&mp_shm->slots[i].lock, &mattr);
+		pthread_cond_init(&mp_shm->slots[i].cond, &cattr);
+	}
+	pthread_mutexattr_destroy(&mattr);
+	pthread_condattr_destroy(&cattr);
+
+	mp_shm_running = true;
+	if (rte_thread_create_internal_control(&mp_shm_tid, "mp-shm",
+			mp_shm_handle, NULL) < 0) {
+		EAL_LOG(ERR, "failed to create mp shm thread: %s",
+			strerror(errno));
+		mp_shm_running = false;
+		munmap(mp_shm, sizeof(*mp_shm));
+		mp_shm = NULL;
+		unlink(path);
+		return -1;
+	}
+
+	rte_atomic_store_explicit(&mp_shm->magic, MP_SHM_MAGIC,
+		rte_memory_order_release);
+
+	return 0;
+}
+
+static int
+mp_shm_init_secondary(void)
+{
+	const char *path = eal_mp_shm_path();
+	struct mp_shm_slot *slot;
+	struct stat st;
+	unsigned int i;
+	void *addr;
+	int fd, pid;
+
+	fd = open(path, O_RDWR);
+	if (fd < 0)
+		return -1;
+	if (fstat(fd, &st) < 0 || st.st_size != sizeof(*mp_shm)) {
+		close(fd);
+		return -1;
+	}
+	addr = mmap(NULL, sizeof(*mp_shm), PROT_READ | PROT_WRITE,
+		MAP_SHARED, fd, 0);
+	close(fd);
+	if (addr == MAP_FAILED)
+		return -1;
+	mp_shm = addr;
+
+	if (rte_atomic_load_explicit(&mp_shm->magic,
+			rte_memory_order_acquire) != MP_SHM_MAGIC)
+		goto fail;
+
+	/* take a free slot, or the one of a dead process */
+	for (i = 0; i < MP_SHM_SLOTS; i++) {
+		slot = &mp_shm->slots[i];
+		pid = rte_atomic_load_explicit(&slot->pid,
+			rte_memory_order_relaxed);
+		if (pid != 0 && (kill(pid, 0) == 0 || errno != ESRCH))
+			continue;
+		if (rte_atomic_compare_exchange_strong_explicit(&slot->pid,
+				&pid, getpid(), rte_memory_order_acquire,
+				rte_memory_order_relaxed))
+			break;
+	}
+	if (i == MP_SHM_SLOTS) {
+		EAL_LOG(DEBUG, "No free mp shm slot, requests go over the socket");
+		goto fail;
+	}
+
+	mp_shm_lock(&slot->lock);
+	slot->state = MP_SHM_IDLE;
+	create_socket_path(peer_name, slot->peer, sizeof(slot->peer));
+	pthread_mutex_unlock(&slot->lock);
+	mp_shm_own = slot;
+
+	return 0;
+fail:
+	munmap(mp_shm, sizeof(*mp_shm));
+	mp_shm = NULL;
+	return -1;
+}
+
+static void
+mp_shm_cleanup(void)
+{
+	if (mp_shm == NULL)
+		return;
+
+	if (rte_eal_process_type() == RTE_PROC_PRIMARY) {
+		mp_shm_lock(&mp_shm->lock);
+		mp_shm_running = false;
+		pthread_cond_signal(&mp_shm->cond);
+		pthread_mutex_unlock(&mp_shm->lock);
+		rte_thread_join(mp_shm_tid, NULL);
+		unlink(eal_mp_shm_path());
+	} else if (mp_shm_own != NULL) {
+		rte_atomic_store_explicit(&mp_shm_own->pid, 0,
+			rte_memory_order_release);
+		mp_shm_own = NULL;
+	}
+
+	munmap(mp_shm, sizeof(*mp_shm));
+	mp_shm = NULL;
+}
+
 static int
 timespec_cmp(const struct timespec *a, const struct timespec *b)
 {
@@ -670,6 +1048,12 @@ rte_mp_channel_init(void)
 		return -1;
 	}
 
+	/* the socket alone is used if shared memory is not available */
+	if (rte_eal_process_type() == RTE_PROC_PRIMARY)
+		mp_shm_init_primary();
+	else
+		mp_shm_init_secondary();
+
 	/* unlock the directory */
 	flock(dir_fd, LOCK_UN);
 	close(dir_fd);
@@ -686,6 +1070,8 @@ rte_mp_channel_cleanup(void)
 	if (fd < 0)
 		return;
 
+	mp_shm_cleanup();
+
 	pthread_cancel((pthread_t)mp_handle_tid.opaque_id);
 	rte_thread_join(mp_handle_tid, NULL);
 	close_socket_fd(fd);
@@ -939,8 +1325,9 @@ mp_request_sync(const char *dst, struct rte_mp_msg *req,
 	       struct rte_mp_reply *reply, const struct timespec *ts)
 {
 	int ret;
+	bool use_shm;
 	pthread_condattr_t attr;
-	struct rte_mp_msg msg, *tmp;
+	struct rte_mp_msg msg, shm_msg, *tmp;
 	struct pending_request pending_req, *exist;
 
 	pending_req.type = REQUEST_TYPE_SYNC;
@@ -959,22 +1346,42 @@ mp_request_sync(const char *dst, struct rte_mp_msg *req,
 		return -1;
 	}
 
-	ret = send_msg(dst, req, MP_REQ);
-	if (ret < 0) {
-		EAL_LOG(ERR, "Fail to send request %s:%s",
-			dst, req->name);
-		return -1;
-	} else if (ret == 0)
-		return 0;
+	/* only a secondary process owns a slot, to request the primary */
+	use_shm = mp_shm_own != NULL && req->num_fds == 0;
+	if (!use_shm) {
+		ret = send_msg(dst, req, MP_REQ);
+		if (ret < 0) {
+			EAL_LOG(ERR, "Fail to send request %s:%s",
+				dst, req->name);
+			return -1;
+		} else if (ret == 0)
+			return 0;
+	}
 
+	/* queued first, for a reply over the socket to be matched */
 	TAILQ_INSERT_TAIL(&pending_requests.requests, &pending_req, next);
 
 	reply->nb_sent++;
 
-	do {
+	if (use_shm) {
+		/* a reply over the socket is matched while waiting */
+		pthread_mutex_unlock(&pending_requests.lock);
+		ret = mp_shm_request(req, &shm_msg, ts);
+		pthread_mutex_lock(&pending_requests.lock);
+		if (pending_req.reply_received == 0 && ret == MP_SHM_REP) {
+			memcpy(&msg, &shm_msg, sizeof(msg));
+			pending_req.reply_received = 1;
+		} else if (pending_req.reply_received == 0 && ret == MP_SHM_IGN) {
+			pending_req.reply_received = -1;
+		}
+	}
+
+	while (pending_req.reply_received == 0) {
 		ret = pthread_cond_timedwait(&pending_req.sync.cond,
 				&pending_requests.lock, ts);
-	} while (ret != 0 && ret != ETIMEDOUT);
+		if (ret == ETIMEDOUT)
+			break;
+	}
 
 	TAILQ_REMOVE(&pending_requests.requests, &pending_req, next);
 
@@ -1285,6 +1692,9 @@ rte_mp_reply(struct rte_mp_msg *msg, const char *peer)
 		return 0;
 	}
 
+	if (mp_shm_reply(msg, peer) == 0)
+		return 0;
+
 	return mp_send(msg, peer, MP_REP);
 }
 
@@ -80,6 +80,10 @@ eal_trace_init(void)
 
 	rte_trace_mode_set(trace.mode);
 
+	/* Start streaming the trace memory to the trace directory */
+	if (trace.mode == RTE_TRACE_MODE_STREAM && trace_stream_init() < 0)
+		goto free_meta;
+
 	return 0;
 
 free_meta:
@@ -92,6 +96,8 @@ eal_trace_init(void)
 void
 eal_trace_fini(void)
 {
+	if (trace.mode == RTE_TRACE_MODE_STREAM)
+		trace_stream_fini();
 	trace_mem_free();
 	trace_metadata_destroy();
 	eal_trace_args_free();
@@ -110,6 +116,9 @@ trace_mode_set(rte_trace_point_t *t, enum rte_trace_mode mode)
 	if (mode == RTE_TRACE_MODE_OVERWRITE)
 		rte_atomic_fetch_and_explicit(t, ~__RTE_TRACE_FIELD_ENABLE_DISCARD,
 			rte_memory_order_release);
+	else if (mode == RTE_TRACE_MODE_STREAM)
+		rte_atomic_fetch_or_explicit(t, __RTE_TRACE_FIELD_ENABLE_STREAM,
+			rte_memory_order_release);
 	else
 		rte_atomic_fetch_or_explicit(t, __RTE_TRACE_FIELD_ENABLE_DISCARD,
 			rte_memory_order_release);
@@ -121,6 +130,13 @@ rte_trace_mode_set(enum rte_trace_mode mode)
 {
 	struct trace_point *tp;
 
+	/* The trace memory layout depends on the stream mode */
+	if ((mode == RTE_TRACE_MODE_STREAM) !=
+			(trace.mode == RTE_TRACE_MODE_STREAM)) {
+		trace_err("stream mode can only be set with --trace-mode");
+		return;
+	}
+
 	STAILQ_FOREACH(tp, &tp_list, next)
 		trace_mode_set(tp->handle, mode);
 
@@ -281,11 +297,11 @@ trace_lcore_mem_dump(FILE *f)
 	fprintf(f, "\nTrace mem info\n--------------\n");
 	for (count = 0; count < t->nb_trace_mem_list; count++) {
 		header = t->lcore_meta[count].mem;
-		fprintf(f, "\tid %d, mem=%p, area=%s, lcore_id=%d, name=%s\n",
+		fprintf(f, "\tid %d, mem=%p, area=%s, lcore_id=%d, name=%s, lost=%u\n",
 		count, header,
 		trace_area_to_string(t->lcore_meta[count].area),
 		header->stream_header.lcore_id,
-		header->stream_header.thread_name);
+		header->stream_header.thread_name, header->lost);
 	}
 out:
 	rte_spinlock_unlock(&t->lock);
@@ -332,6 +348,7 @@ __rte_trace_mem_per_thread_alloc(void)
 {
 	struct trace *t = trace_obj_get();
 	struct __rte_trace_header *header;
+	size_t mem_size;
 	uint32_t count;
 
 	if (!rte_trace_is_enabled())
@@ -355,15 +372,20 @@ __rte_trace_mem_per_thread_alloc(void)
 		goto fail;
 	}
 
+	/* Two buffers are used in turn in stream mode */
+	if (t->mode == RTE_TRACE_MODE_STREAM)
+		mem_size = trace_mem_sz(2 * t->buff_len);
+	else
+		mem_size = trace_mem_sz(t->buff_len);
+
 	/* First attempt from huge page */
-	header = eal_malloc_no_trace(NULL, trace_mem_sz(t->buff_len), 8);
+	header = eal_malloc_no_trace(NULL, mem_size, 8);
 	if (header) {
 		t->lcore_meta[count].area = TRACE_AREA_HUGEPAGE;
 		goto found;
 	}
 
 	/* Second attempt from heap with proper alignment */
-	size_t mem_size = trace_mem_sz(t->buff_len);
 	void *aligned_ptr = NULL;
 	int ret = posix_memalign(&aligned_ptr, 8, mem_size);
 	header = (ret == 0) ? aligned_ptr : NULL;
@@ -381,6 +403,10 @@ __rte_trace_mem_per_thread_alloc(void)
 found:
 	header->offset = 0;
 	header->len = t->buff_len;
+	header->base = 0;
+	header->full[0] = 0;
+	header->full[1] = 0;
+	header->lost = 0;
 	header->stream_header.magic = TRACE_CTF_MAGIC;
 	rte_uuid_copy(header->stream_header.uuid, t->uuid);
 	header->stream_header.lcore_id = rte_lcore_id();
@@ -392,6 +418,8 @@ __rte_trace_mem_per_thread_alloc(void)
 		__RTE_TRACE_EMIT_STRING_LEN_MAX);
 
 	t->lcore_meta[count].mem = header;
+	t->lcore_meta[count].stream.fd = -1;
+	t->lcore_meta[count].stream.map = NULL;
 	t->nb_trace_mem_list++;
 fail:
 	RTE_PER_LCORE(trace_mem) = header;
@@ -426,6 +454,8 @@ trace_mem_per_thread_free(void)
 	if (count != t->nb_trace_mem_list) {
 		struct thread_mem_meta *meta = &t->lcore_meta[count];
 
+		if (t->mode == RTE_TRACE_MODE_STREAM)
+			trace_stream_close(meta);
 		trace_mem_per_thread_free_unlocked(meta);
 		if (count != t->nb_trace_mem_list - 1) {
 			memmove(meta, meta + 1,
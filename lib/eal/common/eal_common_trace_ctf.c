@@ -210,20 +210,25 @@ meta_clock_pass4_emit(char **meta, int *offset)
 static int
 meta_stream_emit(char **meta, int *offset)
 {
+	struct trace *trace = trace_obj_get();
 	char *str = NULL;
 	int rc;
 
+	/* A streamed file holds several packets, each with its size */
 	rc = metadata_printf(&str,
 		"stream {\n"
 		"    packet.context := struct {\n"
 		"         uint32_t cpu_id;\n"
 		"         string_bounded_t name[32];\n"
+		"%s"
 		"    };\n"
 		"    event.header := struct {\n"
 		"          uint48_clock_dpdk_t timestamp;\n"
 		"          uint16_t id;\n"
 		"    } align(64);\n"
-		"};\n\n");
+		"};\n\n", trace->mode == RTE_TRACE_MODE_STREAM ?
+		"         uint64_t content_size;\n"
+		"         uint64_t packet_size;\n" : "");
 	return meta_copy(meta, offset, str, rc);
 }
 
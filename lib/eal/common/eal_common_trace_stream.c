@@ -0,0 +1,292 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_errno.h>
+#include <rte_thread.h>
+
+#include <eal_export.h>
+#include "eal_trace.h"
+
+/* Size of the windows the stream files are mapped by */
+#define TRACE_STREAM_MAP_SZ	(16 * 1024 * 1024)
+/* Period of the streaming thread */
+#define TRACE_STREAM_PERIOD_US	1000
+
+/* CTF packet header and context of a streamed buffer */
+struct trace_stream_packet {
+	struct __rte_trace_stream_header hdr;
+	uint64_t content_size;
+	uint64_t packet_size;
+};
+
+static rte_thread_t stream_thread;
+static RTE_ATOMIC(bool) stream_running;
+static uint32_t stream_count;
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(__rte_trace_mem_switch, 26.03)
+int
+__rte_trace_mem_switch(void *mem)
+{
+	struct __rte_trace_header *trace = mem;
+	uint32_t cur = trace->base == 0 ? 0 : 1;
+
+	/* The events are lost until the streaming thread catches up */
+	if (rte_atomic_load_explicit(&trace->full[!cur],
+			rte_memory_order_acquire) != 0) {
+		trace->lost++;
+		return -ENOSPC;
+	}
+
+	rte_atomic_store_explicit(&trace->full[cur], trace->offset,
+		rte_memory_order_release);
+	trace->base = cur == 0 ? trace->len : 0;
+	trace->offset = 0;
+
+	return 0;
+}
+
+static int
+stream_open(struct trace_stream_file *s)
+{
+	struct trace *trace = trace_obj_get();
+	char file_name[PATH_MAX];
+	int rc;
+
+	rc = snprintf(file_name, PATH_MAX, "%s/channel0_%u", trace->dir,
+		stream_count);
+	if (rc < 0 || rc >= PATH_MAX)
+		return -ENAMETOOLONG;
+
+	s->fd = open(file_name, O_RDWR | O_CREAT | O_TRUNC, 0600);
+	if (s->fd < 0) {
+		trace_err("open %s failed [%s]", file_name, strerror(errno));
+		return -errno;
+	}
+
+	s->map = NULL;
+	s->map_off = 0;
+	s->pos = 0;
+	stream_count++;
+
+	return 0;
+}
+
+/* Extend the file and map its next window */
+static int
+stream_map_next(struct trace_stream_file *s)
+{
+	void *map;
+
+	if (s->map != NULL) {
+		munmap(s->map, TRACE_STREAM_MAP_SZ);
+		s->map = NULL;
+		s->map_off += TRACE_STREAM_MAP_SZ;
+	}
+
+	if (ftruncate(s->fd, s->map_off + TRACE_STREAM_MAP_SZ) < 0)
+		return -errno;
+
+	map = mmap(NULL, TRACE_STREAM_MAP_SZ, PROT_READ | PROT_WRITE,
+		MAP_SHARED, s->fd, s->map_off);
+	if (map == MAP_FAILED)
+		return -errno;
+
+	s->map = map;
+	s->pos = 0;
+
+	return 0;
+}
+
+static int
+stream_write(struct trace_stream_file *s, const void *buf, size_t len)
+{
+	size_t n;
+	int rc;
+
+	while (len != 0) {
+		if (s->map == NULL || s->pos == TRACE_STREAM_MAP_SZ) {
+			rc = stream_map_next(s);
+			if (rc < 0)
+				return rc;
+		}
+
+		n = RTE_MIN(len, TRACE_STREAM_MAP_SZ - s->pos);
+		memcpy(s->map + s->pos, buf, n);
+		s->pos += n;
+		buf = RTE_PTR_ADD(buf, n);
+		len -= n;
+	}
+
+	return 0;
+}
+
+static void
+stream_file_close(struct trace_stream_file *s)
+{
+	if (s->map != NULL)
+		munmap(s->map, TRACE_STREAM_MAP_SZ);
+	if (ftruncate(s->fd, s->map_off + s->pos) < 0)
+		trace_err("truncate failed [%s]", strerror(errno));
+	close(s->fd);
+	s->map = NULL;
+}
+
+/* Write the events of a buffer as a CTF packet */
+static void
+stream_packet_write(struct thread_mem_meta *meta, const void *events,
+	uint32_t size)
+{
+	static const uint8_t pad[sizeof(uint64_t)];
+	struct __rte_trace_header *hdr = meta->mem;
+	struct trace_stream_packet pkt;
+	struct trace_stream_file *s = &meta->stream;
+	uint32_t len;
+	int rc;
+
+	RTE_BUILD_BUG_ON(sizeof(pkt) % sizeof(uint64_t) != 0);
+
+	if (s->fd == -1 && stream_open(s) < 0)
+		s->fd = -2;
+	/* Streaming failed for this thread */
+	if (s->fd < 0)
+		return;
+
+	/* Packets are padded to keep the events 64 bits aligned */
+	len = sizeof(pkt) + size;
+	pkt.hdr = hdr->stream_header;
+	pkt.content_size = (uint64_t)len * CHAR_BIT;
+	pkt.packet_size = (uint64_t)RTE_ALIGN_CEIL(len, sizeof(uint64_t)) *
+		CHAR_BIT;
+
+	rc = stream_write(s, &pkt, sizeof(pkt));
+	if (rc == 0)
+		rc = stream_write(s, events, size);
+	if (rc == 0)
+		rc = stream_write(s, pad,
+			RTE_ALIGN_CEIL(len, sizeof(uint64_t)) - len);
+	if (rc < 0) {
+		trace_err("streaming of thread %s failed [%s]",
+			hdr->stream_header.thread_name, strerror(-rc));
+		stream_file_close(s);
+		s->fd = -2;
+	}
+}
+
+static void
+stream_mem_drain(struct thread_mem_meta *meta, bool final)
+{
+	struct __rte_trace_header *hdr = meta->mem;
+	uint32_t half, size;
+
+	/* At most one buffer is full, older than the one in use */
+	for (half = 0; half != RTE_DIM(hdr->full); half++) {
+		size = rte_atomic_load_explicit(&hdr->full[half],
+			rte_memory_order_acquire);
+		if (size == 0)
+			continue;
+
+		stream_packet_write(meta, &hdr->mem[half * hdr->len], size);
+		rte_atomic_store_explicit(&hdr->full[half], 0,
+			rte_memory_order_release);
+	}
+
+	/* The thread does not record events anymore */
+	if (final && hdr->offset != 0) {
+		stream_packet_write(meta, &hdr->mem[hdr->base], hdr->offset);
+		hdr->offset = 0;
+	}
+}
+
+void
+trace_stream_drain(bool final)
+{
+	struct trace *trace = trace_obj_get();
+	uint32_t count;
+
+	for (count = 0; count < trace->nb_trace_mem_list; count++)
+		stream_mem_drain(&trace->lcore_meta[count], final);
+}
+
+void
+trace_stream_close(struct thread_mem_meta *meta)
+{
+	struct trace_stream_file *s = &meta->stream;
+
+	stream_mem_drain(meta, true);
+
+	/* The streaming may have failed while draining */
+	if (s->fd >= 0) {
+		stream_file_close(s);
+		s->fd = -1;
+	}
+}
+
+static uint32_t
+trace_stream_thread(void *arg)
+{
+	struct trace *trace = arg;
+
+	while (rte_atomic_load_explicit(&stream_running,
+			rte_memory_order_acquire)) {
+		rte_spinlock_lock(&trace->lock);
+		trace_stream_drain(false);
+		rte_spinlock_unlock(&trace->lock);
+
+		rte_delay_us_sleep(TRACE_STREAM_PERIOD_US);
+	}
+
+	return 0;
+}
+
+int
+trace_stream_init(void)
+{
+	int rc;
+
+	rc = trace_mkdir();
+	if (rc < 0)
+		return rc;
+
+	rte_atomic_store_explicit(&stream_running, true,
+		rte_memory_order_release);
+	rc = rte_thread_create_internal_control(&stream_thread, "trace",
+		trace_stream_thread, trace_obj_get());
+	if (rc != 0) {
+		trace_err("streaming thread creation failed");
+		rte_atomic_store_explicit(&stream_running, false,
+			rte_memory_order_release);
+		rte_errno = rc < 0 ? -rc : rc;
+		return -rte_errno;
+	}
+
+	return 0;
+}
+
+void
+trace_stream_fini(void)
+{
+	struct trace *trace = trace_obj_get();
+	uint32_t count;
+
+	if (!rte_atomic_load_explicit(&stream_running,
+			rte_memory_order_acquire))
+		return;
+
+	rte_atomic_store_explicit(&stream_running, false,
+		rte_memory_order_release);
+	rte_thread_join(stream_thread, NULL);
+
+	rte_spinlock_lock(&trace->lock);
+	for (count = 0; count < trace->nb_trace_mem_list; count++)
+		trace_stream_close(&trace->lcore_meta[count]);
+	rte_spinlock_unlock(&trace->lock);
+}
@@ -22,6 +22,7 @@ trace_mode_to_string(enum rte_trace_mode mode)
 	switch (mode) {
 	case RTE_TRACE_MODE_OVERWRITE: return "overwrite";
 	case RTE_TRACE_MODE_DISCARD: return "discard";
+	case RTE_TRACE_MODE_STREAM: return "stream";
 	default: return "unknown";
 	}
 }
@@ -229,6 +230,8 @@ eal_trace_mode_args_save(const char *val)
 		tmp = RTE_TRACE_MODE_OVERWRITE;
 	else if (fnmatch(pattern, "discard", 0) == 0)
 		tmp = RTE_TRACE_MODE_DISCARD;
+	else if (fnmatch(pattern, "stream", 0) == 0)
+		tmp = RTE_TRACE_MODE_STREAM;
 	else {
 		free(pattern);
 		return -EINVAL;
@@ -301,7 +304,7 @@ trace_dir_default_path_get(char **dir_path)
 	return 0;
 }
 
-static int
+int
 trace_mkdir(void)
 {
 	struct trace *trace = trace_obj_get();
@@ -355,7 +358,7 @@ trace_mkdir(void)
 	return 0;
 }
 
-static int
+int
 trace_meta_save(struct trace *trace)
 {
 	char file_name[PATH_MAX];
@@ -431,6 +434,11 @@ rte_trace_save(void)
 		return rc;
 
 	rte_spinlock_lock(&trace->lock);
+	if (trace->mode == RTE_TRACE_MODE_STREAM) {
+		trace_stream_drain(false);
+		rte_spinlock_unlock(&trace->lock);
+		return 0;
+	}
 	for (count = 0; count < trace->nb_trace_mem_list; count++) {
 		header = trace->lcore_meta[count].mem;
 		rc =  trace_mem_save(trace, header, count);
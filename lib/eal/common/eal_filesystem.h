@@ -70,6 +70,18 @@ eal_mp_socket_path(void)
 	return buffer;
 }
 
+/** Path of the shared memory channel of the secondary process requests. */
+#define MP_SHM_FNAME "mp_shm"
+static inline const char *
+eal_mp_shm_path(void)
+{
+	static char buffer[PATH_MAX]; /* static so auto-zeroed */
+
+	snprintf(buffer, sizeof(buffer), "%s/%s", rte_eal_get_runtime_dir(),
+			MP_SHM_FNAME);
+	return buffer;
+}
+
 #define FBARRAY_NAME_FMT "%s/fbarray_%s"
 static inline const char *
 eal_get_fbarray_path(char *buffer, size_t buflen, const char *name) {
@@ -82,10 +82,18 @@ struct internal_config {
 	 */
 	volatile unsigned match_allocations;
 	/**< true to free hugepages exactly as allocated */
+	volatile unsigned malloc_cache;
+	/**< true to cache small freed heap elements per lcore */
 	volatile unsigned single_file_segments;
 	/**< true if storing all pages within single files (per-page-size,
 	 * per-node) non-legacy mode only.
 	 */
+	volatile unsigned parallel_mem_init;
+	/**< true to allocate the initial memory of each NUMA node in a
+	 * separate thread, non-legacy mode only.
+	 */
+	volatile unsigned parallel_mem_clear;
+	/**< true to clear reused hugepages in the initial memory threads. */
 	/** default interrupt mode for VFIO */
 	volatile enum rte_intr_mode vfio_intr_mode;
 	/** the shared VF token for VFIO-PCI bound PF and VFs devices */
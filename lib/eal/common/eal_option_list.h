@@ -47,6 +47,7 @@ OPT_STR_ARG("--log-color", NULL, "Enable/disable color in log output", log_color
 LIST_ARG("--log-level", NULL, "Log level for loggers; use log-level=help for list of log types and levels", log_level)
 OPT_STR_ARG("--log-timestamp", NULL, "Enable/disable timestamp in log output", log_timestamp)
 STR_ARG("--main-lcore", NULL, "Select which core to use for the main thread", main_lcore)
+BOOL_ARG("--malloc-cache", NULL, "Cache small freed heap elements per lcore", malloc_cache)
 STR_ARG("--mbuf-pool-ops-name", NULL, "User defined mbuf default pool ops name", mbuf_pool_ops_name)
 STR_ARG("--memory-channels", "-n", "Number of memory channels per socket", memory_channels)
 STR_ARG("--memory-ranks", "-r", "Force number of memory ranks (don't detect)", memory_ranks)
@@ -80,6 +81,7 @@ STR_ARG("--trace-mode", NULL, "Trace mode", trace_mode)
 BOOL_ARG("--create-uio-dev", NULL, "Create /dev/uioX devices", create_uio_dev)
 STR_ARG("--file-prefix", NULL, "Base filename of hugetlbfs files", file_prefix)
 STR_ARG("--huge-dir", NULL, "Directory for hugepage files", huge_dir)
+OPT_STR_ARG("--huge-parallel-init", NULL, "Allocate initial hugepage memory of each NUMA node in a separate thread, optionally clearing reused hugepages (clear)", huge_parallel_init)
 OPT_STR_ARG("--huge-worker-stack", NULL, "Allocate worker thread stacks from hugepage memory, with optional size (kB)", huge_worker_stack)
 BOOL_ARG("--match-allocations", NULL, "Free hugepages exactly as allocated", match_allocations)
 STR_ARG("--numa-mem", NULL, "Memory to allocate on NUMA nodes (comma separated values)", numa_mem)
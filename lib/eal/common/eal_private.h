@@ -381,6 +381,16 @@ eal_dynmem_calc_num_pages_per_socket(
  */
 unsigned eal_cpu_core_id(unsigned lcore_id);
 
+/**
+ * Get the ID of a topology domain of a cpu, the lowest cpu ID in the domain.
+ *
+ * This function is private to the EAL.
+ *
+ * @return
+ *   The domain ID, or -1 if unknown.
+ */
+int eal_cpu_domain_id(unsigned int cpu_id, enum rte_lcore_domain domain);
+
 /**
  * Check if cpu is present.
  *
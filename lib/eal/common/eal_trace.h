@@ -37,9 +37,18 @@ enum trace_area_e {
 	TRACE_AREA_HUGEPAGE,
 };
 
+/* File a thread trace memory is streamed to, mapped by windows */
+struct trace_stream_file {
+	int fd;
+	uint8_t *map;
+	uint64_t map_off;
+	uint64_t pos;
+};
+
 struct thread_mem_meta {
 	void *mem;
 	enum trace_area_e area;
+	struct trace_stream_file stream;
 };
 
 struct trace_arg {
@@ -103,6 +112,14 @@ char *trace_metadata_fixup_field(const char *field);
 int trace_epoch_time_save(void);
 void trace_mem_free(void);
 void trace_mem_per_thread_free(void);
+int trace_mkdir(void);
+int trace_meta_save(struct trace *trace);
+
+/* Stream mode functions, called with the trace lock held but init/fini */
+int trace_stream_init(void);
+void trace_stream_fini(void);
+void trace_stream_drain(bool final);
+void trace_stream_close(struct thread_mem_meta *meta);
 
 /* EAL interface */
 int eal_trace_init(void);
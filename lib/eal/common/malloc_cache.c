@@ -0,0 +1,267 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <rte_bitops.h>
+#include <rte_common.h>
+#include <rte_eal.h>
+#include <rte_lcore.h>
+#include <rte_lcore_var.h>
+#include <rte_log.h>
+#ifndef RTE_EXEC_ENV_WINDOWS
+#include <rte_telemetry.h>
+#endif
+
+#include "eal_internal_cfg.h"
+#include "eal_memcfg.h"
+#include "eal_private.h"
+#include "malloc_cache.h"
+#include "malloc_elem.h"
+#include "malloc_heap.h"
+
+struct malloc_cache_class {
+	unsigned int len;
+	struct malloc_elem *elems[MALLOC_CACHE_SIZE];
+};
+
+struct malloc_lcore_cache {
+	/* heap of the lcore socket, NULL until the first use */
+	struct malloc_heap *heap;
+	/* no heap on the lcore socket, the cache is not used */
+	bool no_heap;
+	struct malloc_cache_class classes[MALLOC_CACHE_NUM_CLASSES];
+	struct malloc_cache_stats stats;
+};
+
+static RTE_LCORE_VAR_HANDLE(struct malloc_lcore_cache, lcore_caches);
+
+static bool malloc_cache_enabled;
+
+int
+malloc_cache_init(void)
+{
+	const struct internal_config *internal_conf =
+		eal_get_internal_configuration();
+
+	if (!internal_conf->malloc_cache)
+		return 0;
+
+#if defined(RTE_MALLOC_DEBUG) || defined(RTE_MALLOC_ASAN)
+	EAL_LOG(WARNING, "Malloc lcore caches are not supported with malloc debug or ASan");
+	return 0;
+#else
+	if (lcore_caches == NULL)
+		RTE_LCORE_VAR_ALLOC(lcore_caches);
+	malloc_cache_enabled = true;
+	EAL_LOG(DEBUG, "Malloc lcore caches enabled for elements up to %u bytes",
+		MALLOC_CACHE_MAX_SIZE);
+
+	return 0;
+#endif
+}
+
+/* Get the cache of the calling thread, NULL if it cannot use one. */
+static inline struct malloc_lcore_cache *
+malloc_cache_get(void)
+{
+	struct rte_mem_config *mcfg;
+	struct malloc_lcore_cache *cache;
+	int socket_id, heap_id;
+
+	if (!malloc_cache_enabled || rte_lcore_id() == LCORE_ID_ANY)
+		return NULL;
+
+	cache = RTE_LCORE_VAR(lcore_caches);
+	if (likely(cache->heap != NULL))
+		return cache;
+	if (cache->no_heap)
+		return NULL;
+
+	/* without hugepages, all the memory is in the first heap */
+	socket_id = rte_eal_has_hugepages() ? (int)rte_socket_id() :
+		rte_socket_id_by_idx(0);
+	heap_id = malloc_socket_to_heap_id(socket_id);
+	if (heap_id < 0) {
+		cache->no_heap = true;
+		return NULL;
+	}
+	mcfg = rte_eal_get_configuration()->mem_config;
+	cache->heap = &mcfg->malloc_heaps[heap_id];
+
+	return cache;
+}
+
+/* Return the n older elements of a size class to the heap. */
+static void
+malloc_cache_return(struct malloc_lcore_cache *cache,
+		struct malloc_cache_class *cls, unsigned int n)
+{
+	unsigned int i;
+
+	for (i = 0; i < n; i++) {
+		if (malloc_heap_free(cls->elems[i]) < 0)
+			EAL_LOG(ERR, "Error: Invalid memory");
+	}
+	cls->len -= n;
+	memmove(&cls->elems[0], &cls->elems[n],
+		cls->len * sizeof(cls->elems[0]));
+	cache->stats.free_returned += n;
+}
+
+void *
+malloc_cache_alloc(size_t size, unsigned int align, int socket)
+{
+	struct malloc_lcore_cache *cache;
+	struct malloc_cache_class *cls;
+	struct malloc_elem *elem;
+	unsigned int idx;
+	void *ptr;
+
+	/* data of elements without padding is aligned on a cache line */
+	if (size > MALLOC_CACHE_MAX_SIZE || align > RTE_CACHE_LINE_SIZE)
+		return NULL;
+
+	cache = malloc_cache_get();
+	if (cache == NULL)
+		return NULL;
+	if (socket != SOCKET_ID_ANY &&
+			(unsigned int)socket != cache->heap->socket_id)
+		return NULL;
+
+	idx = RTE_MAX(rte_log2_u64(size), (uint32_t)MALLOC_CACHE_MIN_SHIFT) -
+		MALLOC_CACHE_MIN_SHIFT;
+	cls = &cache->classes[idx];
+	if (cls->len > 0) {
+		elem = cls->elems[--cls->len];
+		cache->stats.alloc_hits++;
+		return RTE_PTR_ADD(elem, MALLOC_ELEM_HEADER_LEN);
+	}
+
+	/* allocate the whole class size, to be cached in the same class */
+	ptr = malloc_heap_alloc(1U << (idx + MALLOC_CACHE_MIN_SHIFT),
+			cache->heap->socket_id, 0, 1, 0, false);
+	if (ptr != NULL)
+		cache->stats.alloc_misses++;
+
+	return ptr;
+}
+
+bool
+malloc_cache_free(struct malloc_elem *elem)
+{
+	struct malloc_lcore_cache *cache;
+	struct malloc_cache_class *cls;
+	size_t data_len;
+	unsigned int idx;
+
+	cache = malloc_cache_get();
+	if (cache == NULL || elem->heap != cache->heap || elem->pad != 0 ||
+			elem->state != ELEM_BUSY)
+		return false;
+
+	data_len = elem->size - MALLOC_ELEM_OVERHEAD;
+	idx = rte_fls_u64(data_len) - 1;
+	if (idx < MALLOC_CACHE_MIN_SHIFT ||
+			idx >= MALLOC_CACHE_MIN_SHIFT + MALLOC_CACHE_NUM_CLASSES)
+		return false;
+	cls = &cache->classes[idx - MALLOC_CACHE_MIN_SHIFT];
+
+	if (cls->len == MALLOC_CACHE_SIZE)
+		malloc_cache_return(cache, cls, MALLOC_CACHE_SIZE / 2);
+
+	/* the data is not cleared until the element is returned to the heap */
+	elem->dirty = true;
+	cls->elems[cls->len++] = elem;
+	cache->stats.free_cached++;
+
+	return true;
+}
+
+void
+malloc_cache_flush(void)
+{
+	struct malloc_lcore_cache *cache;
+	unsigned int i;
+
+	cache = malloc_cache_get();
+	if (cache == NULL)
+		return;
+
+	for (i = 0; i < MALLOC_CACHE_NUM_CLASSES; i++)
+		malloc_cache_return(cache, &cache->classes[i],
+			cache->classes[i].len);
+}
+
+int
+malloc_cache_get_stats(unsigned int lcore_id, struct malloc_cache_stats *stats)
+{
+	if (!malloc_cache_enabled)
+		return -ENOTSUP;
+	if (lcore_id >= RTE_MAX_LCORE)
+		return -EINVAL;
+
+	*stats = RTE_LCORE_VAR_LCORE(lcore_id, lcore_caches)->stats;
+
+	return 0;
+}
+
+#ifndef RTE_EXEC_ENV_WINDOWS
+
+#define EAL_MALLOC_CACHE_REQ "/eal/malloc_cache"
+
+static int
+handle_malloc_cache_request(const char *cmd __rte_unused, const char *params,
+		struct rte_tel_data *d)
+{
+	struct malloc_cache_stats stats, total;
+	unsigned int lcore_id, first, last;
+	uint64_t allocs;
+	char *end;
+
+	memset(&total, 0, sizeof(total));
+	first = 0;
+	last = RTE_MAX_LCORE - 1;
+	if (params != NULL && strlen(params) != 0) {
+		errno = 0;
+		first = strtoul(params, &end, 10);
+		if (errno != 0 || *end != '\0' || first >= RTE_MAX_LCORE)
+			return -EINVAL;
+		last = first;
+	}
+
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_int(d, "enabled", malloc_cache_enabled);
+	if (!malloc_cache_enabled)
+		return 0;
+
+	for (lcore_id = first; lcore_id <= last; lcore_id++) {
+		malloc_cache_get_stats(lcore_id, &stats);
+		total.alloc_hits += stats.alloc_hits;
+		total.alloc_misses += stats.alloc_misses;
+		total.free_cached += stats.free_cached;
+		total.free_returned += stats.free_returned;
+	}
+
+	allocs = total.alloc_hits + total.alloc_misses;
+	rte_tel_data_add_dict_uint(d, "alloc_hits", total.alloc_hits);
+	rte_tel_data_add_dict_uint(d, "alloc_misses", total.alloc_misses);
+	rte_tel_data_add_dict_uint(d, "free_cached", total.free_cached);
+	rte_tel_data_add_dict_uint(d, "free_returned", total.free_returned);
+	rte_tel_data_add_dict_uint(d, "hit_rate_percent",
+		allocs != 0 ? total.alloc_hits * 100 / allocs : 0);
+
+	return 0;
+}
+
+RTE_INIT(malloc_cache_telemetry)
+{
+	rte_telemetry_register_cmd(EAL_MALLOC_CACHE_REQ,
+			handle_malloc_cache_request,
+			"Returns malloc lcore cache stats, of all lcores or of one. Parameters: int lcore_id (optional)");
+}
+
+#endif /* telemetry !RTE_EXEC_ENV_WINDOWS */
@@ -0,0 +1,57 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef MALLOC_CACHE_H
+#define MALLOC_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* forward declarations */
+struct malloc_elem;
+
+/*
+ * Per-lcore cache of small elements in front of the socket heaps.
+ *
+ * Freed elements up to MALLOC_CACHE_MAX_SIZE bytes are kept busy in a cache
+ * of the freeing lcore, one list per power of 2 size class, and used again
+ * by the next allocations of that lcore without taking the heap lock.
+ * When a list is full, its older half is returned to the heap.
+ */
+
+/* Smallest size class, as data is at least a cache line. */
+#define MALLOC_CACHE_MIN_SHIFT 6
+/* Number of size classes, from 64 to 4096 bytes. */
+#define MALLOC_CACHE_NUM_CLASSES 7
+#define MALLOC_CACHE_MAX_SIZE \
+	(1U << (MALLOC_CACHE_MIN_SHIFT + MALLOC_CACHE_NUM_CLASSES - 1))
+/* Number of elements cached per size class. */
+#define MALLOC_CACHE_SIZE 64
+
+/* Statistics of a lcore cache. */
+struct malloc_cache_stats {
+	uint64_t alloc_hits;    /* allocations served by the cache */
+	uint64_t alloc_misses;  /* allocations served by the heap */
+	uint64_t free_cached;   /* frees kept in the cache */
+	uint64_t free_returned; /* elements returned to the heap */
+};
+
+int
+malloc_cache_init(void);
+
+void *
+malloc_cache_alloc(size_t size, unsigned int align, int socket);
+
+bool
+malloc_cache_free(struct malloc_elem *elem);
+
+void
+malloc_cache_flush(void);
+
+int
+malloc_cache_get_stats(unsigned int lcore_id,
+		struct malloc_cache_stats *stats);
+
+#endif /* MALLOC_CACHE_H */
@@ -23,6 +23,7 @@
 #include "eal_memalloc.h"
 #include "eal_memcfg.h"
 #include "eal_private.h"
+#include "malloc_cache.h"
 #include "malloc_elem.h"
 #include "malloc_heap.h"
 #include "malloc_mp.h"
@@ -1429,7 +1430,7 @@ rte_eal_malloc_heap_init(void)
 		return -1;
 	}
 
-	return 0;
+	return malloc_cache_init();
 }
 
 int rte_eal_malloc_heap_populate(void)
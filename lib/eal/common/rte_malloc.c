@@ -20,6 +20,7 @@
 #include <eal_trace_internal.h>
 
 #include <rte_malloc.h>
+#include "malloc_cache.h"
 #include "malloc_elem.h"
 #include "malloc_heap.h"
 #include "eal_memalloc.h"
@@ -45,6 +46,9 @@ mem_free(void *addr, const bool trace_ena, bool zero)
 		rte_memzero_explicit(addr, data_len);
 	}
 
+	if (malloc_cache_free(elem))
+		return;
+
 	if (malloc_heap_free(elem) < 0)
 		EAL_LOG(ERR, "Error: Invalid memory");
 }
@@ -63,6 +67,13 @@ rte_free_sensitive(void *addr)
 	mem_free(addr, true, true);
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_malloc_cache_flush, 26.03)
+void
+rte_malloc_cache_flush(void)
+{
+	malloc_cache_flush();
+}
+
 void
 eal_free_no_trace(void *addr)
 {
@@ -88,8 +99,10 @@ malloc_socket(const char *type, size_t size, unsigned int align,
 				!rte_eal_has_hugepages())
 		socket_arg = SOCKET_ID_ANY;
 
-	ptr = malloc_heap_alloc(size, socket_arg, 0,
-			align == 0 ? 1 : align, 0, false);
+	ptr = malloc_cache_alloc(size, align, socket_arg);
+	if (ptr == NULL)
+		ptr = malloc_heap_alloc(size, socket_arg, 0,
+				align == 0 ? 1 : align, 0, false);
 
 	if (trace_ena)
 		rte_eal_trace_mem_malloc(type, size, align, socket_arg, ptr);
@@ -50,6 +50,12 @@ struct __rte_cache_aligned rte_service_spec_impl {
 	RTE_ATOMIC(int8_t) comp_runstate;
 	uint8_t internal_flags;
 
+	/* scheduling parameters, see rte_service_priority_set() and
+	 * rte_service_cycles_budget_set().
+	 */
+	uint32_t priority;
+	uint64_t max_cycles;
+
 	/* per service statistics */
 	/* Indicates how many cores the service is mapped to run on.
 	 * It does not indicate the number of cores the service is running
@@ -63,6 +69,20 @@ struct service_stats {
 	RTE_ATOMIC(uint64_t) idle_calls;
 	RTE_ATOMIC(uint64_t) error_calls;
 	RTE_ATOMIC(uint64_t) cycles;
+	RTE_ATOMIC(uint64_t) budget_overruns;
+	/* latency between the starts of two runs on the lcore */
+	RTE_ATOMIC(uint64_t) latency_max;
+	RTE_ATOMIC(uint64_t) latency_total;
+	RTE_ATOMIC(uint64_t) latency_count;
+	uint64_t last_start;
+};
+
+/* per lcore scheduling state of a service */
+struct service_sched {
+	/* start of the last time the service was selected to run */
+	uint64_t last_tsc;
+	/* the service is deferred until then, after overrunning its budget */
+	uint64_t next_tsc;
 };
 
 /* the internal values of a service core */
@@ -76,9 +96,14 @@ struct __rte_cache_aligned core_state {
 	RTE_ATOMIC(uint64_t) loops;
 	RTE_ATOMIC(uint64_t) cycles;
 	struct service_stats service_stats[RTE_SERVICE_NUM_MAX];
+	struct service_sched service_sched[RTE_SERVICE_NUM_MAX];
 };
 
 static uint32_t rte_service_count;
+/* set once a service has a priority or a budget, the service lcores
+ * then select the services to run instead of running them in turn.
+ */
+static RTE_ATOMIC(uint32_t) service_sched_enabled;
 static struct rte_service_spec_impl *rte_services;
 static RTE_LCORE_VAR_HANDLE(struct core_state, lcore_states);
 static uint32_t rte_service_library_initialized;
@@ -206,6 +231,37 @@ rte_service_set_runstate_mapped_check(uint32_t id, int32_t enabled)
 	return 0;
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_service_priority_set, 26.03)
+int32_t
+rte_service_priority_set(uint32_t id, uint32_t priority)
+{
+	struct rte_service_spec_impl *s;
+	SERVICE_VALID_GET_OR_ERR_RET(id, s, -EINVAL);
+
+	if (priority > RTE_SERVICE_PRIORITY_MAX)
+		return -EINVAL;
+
+	s->priority = priority;
+	rte_atomic_store_explicit(&service_sched_enabled, 1,
+		rte_memory_order_relaxed);
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_service_cycles_budget_set, 26.03)
+int32_t
+rte_service_cycles_budget_set(uint32_t id, uint64_t max_cycles)
+{
+	struct rte_service_spec_impl *s;
+	SERVICE_VALID_GET_OR_ERR_RET(id, s, -EINVAL);
+
+	s->max_cycles = max_cycles;
+	rte_atomic_store_explicit(&service_sched_enabled, 1,
+		rte_memory_order_relaxed);
+
+	return 0;
+}
+
 RTE_EXPORT_SYMBOL(rte_service_get_count)
 uint32_t
 rte_service_get_count(void)
@@ -407,6 +463,19 @@ service_runner_do_callback(struct rte_service_spec_impl *s,
 
 		service_counter_add(&service_stats->calls, 1);
 
+		if (service_stats->last_start != 0) {
+			uint64_t latency = start - service_stats->last_start;
+
+			service_counter_add(&service_stats->latency_total,
+				latency);
+			service_counter_add(&service_stats->latency_count, 1);
+			if (latency > service_stats->latency_max)
+				rte_atomic_store_explicit(
+					&service_stats->latency_max, latency,
+					rte_memory_order_relaxed);
+		}
+		service_stats->last_start = start;
+
 		if (rc == -EAGAIN)
 			service_counter_add(&service_stats->idle_calls, 1);
 		else if (rc != 0)
@@ -506,6 +575,74 @@ rte_service_run_iter_on_app_lcore(uint32_t id, uint32_t serialize_mt_unsafe)
 	return ret;
 }
 
+/* Select the next service to run on the lcore: among the services not
+ * deferred, the one having waited the longest, weighted by its priority.
+ * Returns -1 if all services are deferred.
+ */
+static ssize_t
+service_sched_select(struct core_state *cs, uint64_t now)
+{
+	struct service_sched *ss;
+	uint64_t wait, best_wait;
+	ssize_t id, best;
+
+	best = -1;
+	best_wait = 0;
+	RTE_BITSET_FOREACH_SET(id, cs->mapped_services, RTE_SERVICE_NUM_MAX) {
+		ss = &cs->service_sched[id];
+		if (now < ss->next_tsc)
+			continue;
+
+		wait = (now - ss->last_tsc) * (service_get(id)->priority + 1);
+		if (best < 0 || wait > best_wait) {
+			best = id;
+			best_wait = wait;
+		}
+	}
+
+	return best;
+}
+
+/* Run as many services as mapped to the lcore, by order of selection,
+ * so that a high priority service may run several times meanwhile a low
+ * priority one runs once.
+ */
+static void
+service_sched_run(struct core_state *cs)
+{
+	struct rte_service_spec_impl *s;
+	struct service_sched *ss;
+	uint64_t now, cycles;
+	uint32_t i, n;
+	ssize_t id;
+
+	n = rte_bitset_count_set(cs->mapped_services, RTE_SERVICE_NUM_MAX);
+	for (i = 0; i != n; i++) {
+		now = rte_rdtsc();
+		id = service_sched_select(cs, now);
+		if (id < 0)
+			break;
+
+		s = service_get(id);
+		ss = &cs->service_sched[id];
+		ss->last_tsc = now;
+
+		if (service_run(id, cs, cs->mapped_services, s, 1) != 0 ||
+				s->max_cycles == 0)
+			continue;
+
+		/* defer a service overrunning its budget by the overrun */
+		cycles = rte_rdtsc() - now;
+		if (cycles > s->max_cycles) {
+			ss->next_tsc = now + cycles + (cycles - s->max_cycles);
+			if (service_stats_enabled(s))
+				service_counter_add(
+					&cs->service_stats[id].budget_overruns,
+					1);
+		}
+	}
+}
+
 static int32_t
 service_runner_func(void *arg)
 {
@@ -522,9 +659,16 @@ service_runner_func(void *arg)
 			RUNSTATE_RUNNING) {
 		ssize_t id;
 
-		RTE_BITSET_FOREACH_SET(id, cs->mapped_services, RTE_SERVICE_NUM_MAX) {
-			/* return value ignored as no change to code flow */
-			service_run(id, cs, cs->mapped_services, service_get(id), 1);
+		if (rte_atomic_load_explicit(&service_sched_enabled,
+				rte_memory_order_relaxed) != 0)
+			service_sched_run(cs);
+		else {
+			RTE_BITSET_FOREACH_SET(id, cs->mapped_services,
+					RTE_SERVICE_NUM_MAX) {
+				/* return value ignored as no change to code flow */
+				service_run(id, cs, cs->mapped_services,
+					service_get(id), 1);
+			}
 		}
 
 		rte_atomic_store_explicit(&cs->loops, cs->loops + 1, rte_memory_order_relaxed);
@@ -930,6 +1074,36 @@ lcore_attr_get_service_cycles(uint32_t service_id, unsigned int lcore)
 		rte_memory_order_relaxed);
 }
 
+static uint64_t
+lcore_attr_get_service_budget_overruns(uint32_t service_id, unsigned int lcore)
+{
+	struct core_state *cs =	RTE_LCORE_VAR_LCORE(lcore, lcore_states);
+
+	return rte_atomic_load_explicit(
+		&cs->service_stats[service_id].budget_overruns,
+		rte_memory_order_relaxed);
+}
+
+static uint64_t
+lcore_attr_get_service_latency_total(uint32_t service_id, unsigned int lcore)
+{
+	struct core_state *cs =	RTE_LCORE_VAR_LCORE(lcore, lcore_states);
+
+	return rte_atomic_load_explicit(
+		&cs->service_stats[service_id].latency_total,
+		rte_memory_order_relaxed);
+}
+
+static uint64_t
+lcore_attr_get_service_latency_count(uint32_t service_id, unsigned int lcore)
+{
+	struct core_state *cs =	RTE_LCORE_VAR_LCORE(lcore, lcore_states);
+
+	return rte_atomic_load_explicit(
+		&cs->service_stats[service_id].latency_count,
+		rte_memory_order_relaxed);
+}
+
 typedef uint64_t (*lcore_attr_get_fun)(uint32_t service_id,
 				       unsigned int lcore);
 
@@ -974,6 +1148,46 @@ attr_get_service_cycles(uint32_t service_id)
 	return attr_get(service_id, lcore_attr_get_service_cycles);
 }
 
+static uint64_t
+attr_get_service_budget_overruns(uint32_t service_id)
+{
+	return attr_get(service_id, lcore_attr_get_service_budget_overruns);
+}
+
+static uint64_t
+attr_get_service_latency_max(uint32_t service_id)
+{
+	unsigned int lcore;
+	uint64_t latency, max = 0;
+
+	for (lcore = 0; lcore < RTE_MAX_LCORE; lcore++) {
+		struct core_state *cs =
+			RTE_LCORE_VAR_LCORE(lcore, lcore_states);
+
+		if (!cs->is_service_core)
+			continue;
+		latency = rte_atomic_load_explicit(
+			&cs->service_stats[service_id].latency_max,
+			rte_memory_order_relaxed);
+		max = RTE_MAX(max, latency);
+	}
+
+	return max;
+}
+
+static uint64_t
+attr_get_service_latency_avg(uint32_t service_id)
+{
+	uint64_t count;
+
+	count = attr_get(service_id, lcore_attr_get_service_latency_count);
+	if (count == 0)
+		return 0;
+
+	return attr_get(service_id, lcore_attr_get_service_latency_total) /
+		count;
+}
+
 RTE_EXPORT_SYMBOL(rte_service_attr_get)
 int32_t
 rte_service_attr_get(uint32_t id, uint32_t attr_id, uint64_t *attr_value)
@@ -997,6 +1211,15 @@ rte_service_attr_get(uint32_t id, uint32_t attr_id, uint64_t *attr_value)
 	case RTE_SERVICE_ATTR_CYCLES:
 		*attr_value = attr_get_service_cycles(id);
 		return 0;
+	case RTE_SERVICE_ATTR_BUDGET_OVERRUN_COUNT:
+		*attr_value = attr_get_service_budget_overruns(id);
+		return 0;
+	case RTE_SERVICE_ATTR_RUN_LATENCY_MAX:
+		*attr_value = attr_get_service_latency_max(id);
+		return 0;
+	case RTE_SERVICE_ATTR_RUN_LATENCY_AVG:
+		*attr_value = attr_get_service_latency_avg(id);
+		return 0;
 	default:
 		return -EINVAL;
 	}
@@ -1083,6 +1306,13 @@ service_dump_one(FILE *f, uint32_t id)
 		PRIu64"\tavg: %"PRIu64"\n",
 		s->spec.name, service_stats_enabled(s), service_calls,
 		service_cycles, service_cycles / service_calls);
+	if (s->priority != 0 || s->max_cycles != 0)
+		fprintf(f, "    priority %u\tbudget %"PRIu64"\toverruns %"
+			PRIu64"\tlatency max %"PRIu64"\tavg %"PRIu64"\n",
+			s->priority, s->max_cycles,
+			attr_get_service_budget_overruns(id),
+			attr_get_service_latency_max(id),
+			attr_get_service_latency_avg(id));
 }
 
 static void
@@ -21,6 +21,13 @@ eal_cpu_core_id(__rte_unused unsigned lcore_id)
 	return 0;
 }
 
+int
+eal_cpu_domain_id(__rte_unused unsigned int cpu_id,
+	__rte_unused enum rte_lcore_domain domain)
+{
+	return -1;
+}
+
 static int
 eal_get_ncpus(void)
 {
@@ -184,6 +184,40 @@ rte_cpuset_t rte_lcore_cpuset(unsigned int lcore_id);
 
 #endif /* RTE_HAS_CPUSET */
 
+/**
+ * The topology domains an lcore belongs to.
+ */
+enum rte_lcore_domain {
+	RTE_LCORE_DOMAIN_SMT,     /**< Hardware threads of a physical core. */
+	RTE_LCORE_DOMAIN_L2,      /**< CPUs sharing a level 2 cache. */
+	RTE_LCORE_DOMAIN_L3,      /**< CPUs sharing a level 3 cache, e.g. an AMD CCX. */
+	RTE_LCORE_DOMAIN_CLUSTER, /**< CPUs of a cluster, as reported by the kernel. */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the ID of a topology domain of the specified lcore.
+ *
+ * The ID of a domain is the lowest ID of the CPUs in it, so that two lcores
+ * share a cache or a physical core if they have the same domain ID.
+ * The domains are detected from the CPUs the lcore is affine to.
+ *
+ * @param lcore_id
+ *   The targeted lcore, which MUST be between 0 and RTE_MAX_LCORE-1.
+ * @param domain
+ *   The type of topology domain.
+ * @return
+ *   - The ID of the domain on success.
+ *   - -EINVAL if the lcore or the domain is invalid.
+ *   - -ENOTSUP if the topology of the CPUs is unknown.
+ *   - -ENOENT if the CPUs of the lcore belong to different domains.
+ */
+__rte_experimental
+int
+rte_lcore_domain_id(unsigned int lcore_id, enum rte_lcore_domain domain);
+
 /**
  * Test if an lcore is enabled.
  *
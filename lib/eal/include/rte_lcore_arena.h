@@ -0,0 +1,237 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Ericsson AB
+ */
+
+#ifndef RTE_LCORE_ARENA_H
+#define RTE_LCORE_ARENA_H
+
+/**
+ * @file
+ *
+ * Lcore arenas
+ *
+ * An lcore arena is a per-lcore id memory region from which scratch memory
+ * is allocated by bumping an offset, without locks nor atomic operations.
+ * The memory is not freed object by object: the whole arena, or the part
+ * allocated since a mark, is released at once, typically at the end of the
+ * processing of a burst.
+ *
+ * The per-lcore state is a cache-aligned array owned by the arena, indexed
+ * by lcore id, and the memory of each lcore is allocated on its NUMA node
+ * when the arena is created.
+ *
+ * An lcore arena may only be used by EAL threads and registered non-EAL
+ * threads, each one only using its own lcore id region.
+ *
+ * EXPERIMENTAL: this API may change, or be removed, without prior notice.
+ */
+
+#include <stddef.h>
+
+#include <rte_bitops.h>
+#include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_debug.h>
+#include <rte_lcore.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Per-lcore id state of an lcore arena.
+ */
+struct __rte_cache_aligned rte_lcore_arena_lcore {
+	char *base;    /**< Memory of the lcore, NULL if none. */
+	size_t size;   /**< Size of the memory of the lcore. */
+	size_t offset; /**< Offset of the first free byte. */
+	size_t high;   /**< Highest offset reached since creation. */
+};
+
+/**
+ * Lcore arena.
+ */
+struct rte_lcore_arena {
+	size_t size; /**< Size of the memory of each lcore. */
+	/** Per-lcore id state. */
+	struct rte_lcore_arena_lcore lcores[RTE_MAX_LCORE];
+};
+
+/**
+ * @internal
+ * State of the calling lcore in an lcore arena.
+ */
+static inline struct rte_lcore_arena_lcore *
+__rte_lcore_arena_lcore(struct rte_lcore_arena *arena)
+{
+	unsigned int lcore_id = rte_lcore_id();
+
+	RTE_ASSERT(lcore_id < RTE_MAX_LCORE);
+	return &arena->lcores[lcore_id];
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create an lcore arena.
+ *
+ * Memory is allocated for each lcore id with a role at the time of the call,
+ * i.e. EAL lcores, service lcores and registered non-EAL threads, on the NUMA
+ * node of the lcore. An lcore id registered later gets no memory, and its
+ * allocations fail.
+ *
+ * @param size
+ *   The size in bytes of the memory of each lcore. Must be > 0.
+ * @return
+ *   The lcore arena, or NULL on error with rte_errno set:
+ *   - EINVAL: invalid size
+ *   - ENOMEM: not enough memory
+ */
+__rte_experimental
+struct rte_lcore_arena *
+rte_lcore_arena_create(size_t size);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free an lcore arena and the memory of all lcores.
+ *
+ * No lcore may use the arena, nor memory allocated from it, any more.
+ *
+ * @param arena
+ *   The lcore arena. If NULL, no operation is performed.
+ */
+__rte_experimental
+void
+rte_lcore_arena_free(struct rte_lcore_arena *arena);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Allocate memory from the lcore arena region of the calling thread.
+ *
+ * The memory is not initialized. It is valid until the arena is reset,
+ * or released to a mark taken before the allocation.
+ *
+ * @param arena
+ *   The lcore arena.
+ * @param size
+ *   The size in bytes of the allocation.
+ * @param align
+ *   The alignment of the allocation, a power of 2 equal or less than
+ *   @c RTE_CACHE_LINE_SIZE.
+ * @return
+ *   A pointer to the allocated memory,
+ *   or NULL if the region of the calling lcore is exhausted.
+ */
+__rte_experimental
+static inline void *
+rte_lcore_arena_alloc(struct rte_lcore_arena *arena, size_t size, size_t align)
+{
+	struct rte_lcore_arena_lcore *lcore = __rte_lcore_arena_lcore(arena);
+	size_t offset;
+
+	RTE_ASSERT(rte_is_power_of_2(align) && align <= RTE_CACHE_LINE_SIZE);
+
+	offset = RTE_ALIGN_CEIL(lcore->offset, align);
+	/* an lcore without memory has a zero size */
+	if (unlikely(offset > lcore->size || size > lcore->size - offset))
+		return NULL;
+
+	lcore->offset = offset + size;
+	if (lcore->offset > lcore->high)
+		lcore->high = lcore->offset;
+
+	return lcore->base + offset;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get a mark of the lcore arena region of the calling thread.
+ *
+ * The allocations done after taking the mark can be released all at once
+ * with rte_lcore_arena_release(), keeping the ones done before.
+ *
+ * @param arena
+ *   The lcore arena.
+ * @return
+ *   The mark.
+ */
+__rte_experimental
+static inline size_t
+rte_lcore_arena_mark(struct rte_lcore_arena *arena)
+{
+	return __rte_lcore_arena_lcore(arena)->offset;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Release the allocations done since a mark was taken, by the calling thread.
+ *
+ * @param arena
+ *   The lcore arena.
+ * @param mark
+ *   A mark returned by rte_lcore_arena_mark(), on the calling thread,
+ *   since the last reset of the arena and before any release to an
+ *   earlier mark.
+ */
+__rte_experimental
+static inline void
+rte_lcore_arena_release(struct rte_lcore_arena *arena, size_t mark)
+{
+	struct rte_lcore_arena_lcore *lcore = __rte_lcore_arena_lcore(arena);
+
+	RTE_ASSERT(mark <= lcore->offset);
+	lcore->offset = mark;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Release all the allocations done by the calling thread.
+ *
+ * @param arena
+ *   The lcore arena.
+ */
+__rte_experimental
+static inline void
+rte_lcore_arena_reset(struct rte_lcore_arena *arena)
+{
+	__rte_lcore_arena_lcore(arena)->offset = 0;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the highest amount of memory used in the region of an lcore,
+ * to size the arena.
+ *
+ * The value is only accurate when the lcore is not using the arena.
+ *
+ * @param arena
+ *   The lcore arena.
+ * @param lcore_id
+ *   The lcore id.
+ * @return
+ *   The highest number of bytes used at once since the arena creation,
+ *   alignment padding included.
+ */
+__rte_experimental
+size_t
+rte_lcore_arena_high_water(const struct rte_lcore_arena *arena,
+		unsigned int lcore_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RTE_LCORE_ARENA_H */
@@ -74,6 +74,26 @@ __rte_experimental
 void
 rte_free_sensitive(void *ptr);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Return the small elements cached by the calling lcore to the heap.
+ *
+ * With the ``--malloc-cache`` EAL option, small elements freed by an lcore
+ * are kept in a cache of this lcore, to serve its next allocations without
+ * taking the heap lock. Cached elements are still accounted as allocated
+ * in the heap statistics, and their memory cannot be released to the system.
+ * A thread which stops allocating, e.g. before exiting, can give them back
+ * with this function.
+ *
+ * If the caches are not enabled, or the calling thread has no lcore id,
+ * the function does nothing.
+ */
+__rte_experimental
+void
+rte_malloc_cache_flush(void);
+
 /**
  * This function allocates memory from the huge-page area of memory. The memory
  * is not cleared. In NUMA systems, the memory allocated resides on the same
@@ -26,6 +26,7 @@
 #include<stdio.h>
 #include <stdint.h>
 
+#include <rte_compat.h>
 #include <rte_config.h>
 #include <rte_lcore.h>
 
@@ -336,6 +337,50 @@ int32_t rte_service_lcore_reset_all(void);
  */
 int32_t rte_service_set_stats_enable(uint32_t id, int32_t enable);
 
+/** Maximum priority of a service. */
+#define RTE_SERVICE_PRIORITY_MAX 15
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Set the priority of *service*.
+ *
+ * By default, a service lcore runs its mapped services in turn.
+ * Once a service has a priority or a cycles budget, the service lcores
+ * select at each step the service that has waited the longest since its
+ * last run, its waiting time being weighted by its priority plus one.
+ * A service of priority 1 thus runs about twice as often as a service
+ * of priority 0 mapped to the same lcore.
+ *
+ * @param id The service to set the priority of.
+ * @param priority Priority, from 0 (default) to RTE_SERVICE_PRIORITY_MAX.
+ * @retval 0 Success
+ * @retval -EINVAL Invalid service id or priority
+ */
+__rte_experimental
+int32_t rte_service_priority_set(uint32_t id, uint32_t priority);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Set the cycles budget of an invocation of *service*.
+ *
+ * The service callback is not preempted, but an invocation exceeding the
+ * budget defers the next invocation of the service on the lcore by the
+ * overrun, so that a misbehaving service does not starve the others.
+ * The overruns are counted in RTE_SERVICE_ATTR_BUDGET_OVERRUN_COUNT
+ * when the statistics are enabled.
+ *
+ * @param id The service to set the budget of.
+ * @param max_cycles Budget in TSC cycles, 0 (default) for no budget.
+ * @retval 0 Success
+ * @retval -EINVAL Invalid service id
+ */
+__rte_experimental
+int32_t rte_service_cycles_budget_set(uint32_t id, uint64_t max_cycles);
+
 /**
  * Retrieve the list of currently enabled service cores.
  *
@@ -400,6 +445,24 @@ int32_t rte_service_dump(FILE *f, uint32_t id);
  */
 #define RTE_SERVICE_ATTR_ERROR_CALL_COUNT 3
 
+/**
+ * Returns the number of invocations of this service function that exceeded
+ * its cycles budget, see rte_service_cycles_budget_set().
+ */
+#define RTE_SERVICE_ATTR_BUDGET_OVERRUN_COUNT 4
+
+/**
+ * Returns the maximum number of cycles between the starts of two
+ * consecutive invocations of this service function on a service lcore.
+ */
+#define RTE_SERVICE_ATTR_RUN_LATENCY_MAX 5
+
+/**
+ * Returns the average number of cycles between the starts of two
+ * consecutive invocations of this service function on a service lcore.
+ */
+#define RTE_SERVICE_ATTR_RUN_LATENCY_AVG 6
+
 /**
  * Get an attribute from a service.
  *
@@ -69,10 +69,19 @@ enum rte_trace_mode {
 	 * subsequent events shall not be recorded.
 	 */
 	RTE_TRACE_MODE_DISCARD,
+	/**
+	 * In this mode, the trace buffer of each thread is split in two
+	 * buffers, and a full buffer is streamed to the trace directory by
+	 * a control thread while the events are recorded in the other one.
+	 * The subsequent events are not recorded when both buffers are full.
+	 * This mode can only be set with the --trace-mode EAL option.
+	 */
+	RTE_TRACE_MODE_STREAM,
 };
 
 /**
  * Set the trace mode.
+ * The mode cannot be changed from or to RTE_TRACE_MODE_STREAM.
  *
  * @param mode
  *   Trace mode.
@@ -126,6 +135,9 @@ int rte_trace_regexp(const char *regex, bool enable);
  * By default, trace directory will be created at $HOME directory and this can
  * be overridden by --trace-dir EAL parameter.
  *
+ * In stream mode, the metadata is saved and the full buffers are streamed,
+ * the buffers in use are streamed at exit.
+ *
  * @return
  *   - 0: Success.
  *   - <0 : Failure.
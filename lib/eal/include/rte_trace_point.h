@@ -247,6 +247,21 @@ __rte_trace_point_fp_is_enabled(void)
 __rte_experimental
 void __rte_trace_mem_per_thread_alloc(void);
 
+/**
+ * @internal
+ *
+ * Hand the full trace buffer of the thread over to the streaming thread
+ * and switch to the other buffer, in stream mode.
+ *
+ * @param mem
+ *   Trace memory of the thread.
+ * @return
+ *   - 0: Success.
+ *   - <0: The other buffer is not drained yet, the event is lost.
+ */
+__rte_experimental
+int __rte_trace_mem_switch(void *mem);
+
 /**
  * @internal
  *
@@ -299,6 +314,7 @@ int __rte_trace_point_register(rte_trace_point_t *trace, const char *name,
 #define __RTE_TRACE_FIELD_ID_MASK (0xffffULL << __RTE_TRACE_FIELD_ID_SHIFT)
 #define __RTE_TRACE_FIELD_ENABLE_MASK (1ULL << 63)
 #define __RTE_TRACE_FIELD_ENABLE_DISCARD (1ULL << 62)
+#define __RTE_TRACE_FIELD_ENABLE_STREAM (1ULL << 61)
 
 struct __rte_trace_stream_header {
 	uint32_t magic;
@@ -310,6 +326,12 @@ struct __rte_trace_stream_header {
 struct __rte_trace_header {
 	uint32_t offset;
 	uint32_t len;
+	/* offset of the buffer in use in mem, 0 but in stream mode */
+	uint32_t base;
+	/* size of the events in each buffer waiting to be streamed */
+	RTE_ATOMIC(uint32_t) full[2];
+	/* number of events lost while waiting for a buffer to be streamed */
+	uint32_t lost;
 	struct __rte_trace_stream_header stream_header;
 	uint8_t mem[];
 };
@@ -333,13 +355,17 @@ __rte_trace_mem_get(uint64_t in)
 	/* Check the wrap around case */
 	uint32_t offset = RTE_ALIGN_CEIL(trace->offset, __RTE_TRACE_EVENT_HEADER_SZ);
 	if (unlikely((offset + sz) >= trace->len)) {
+		/* Switch to the other buffer in STREAM mode */
+		if (unlikely(in & __RTE_TRACE_FIELD_ENABLE_STREAM) &&
+				__rte_trace_mem_switch(trace) != 0)
+			return NULL;
 		/* Disable the trace event if it in DISCARD mode */
 		if (unlikely(in & __RTE_TRACE_FIELD_ENABLE_DISCARD))
 			return NULL;
 
 		offset = 0;
 	}
-	void *mem = RTE_PTR_ADD(&trace->mem[0], offset);
+	void *mem = RTE_PTR_ADD(&trace->mem[0], trace->base + offset);
 	offset += sz;
 	trace->offset = offset;
 
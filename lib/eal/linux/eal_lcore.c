@@ -4,6 +4,8 @@
 
 #include <unistd.h>
 #include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 #include <rte_log.h>
 
@@ -13,6 +15,9 @@
 
 #define SYS_CPU_DIR "/sys/devices/system/cpu/cpu%u"
 #define CORE_ID_FILE "topology/core_id"
+#define SIBLINGS_FILE "topology/thread_siblings_list"
+#define CLUSTER_FILE "topology/cluster_cpus_list"
+#define CACHE_DIR "cache/index%u"
 #define NUMA_NODE_PATH "/sys/devices/system/node"
 
 /* Check if a cpu is present by the presence of the cpu information for it */
@@ -72,3 +77,82 @@ eal_cpu_core_id(unsigned lcore_id)
 			"for lcore %u - assuming core 0", SYS_CPU_DIR, lcore_id);
 	return 0;
 }
+
+/*
+ * Read the first number of a sysfs file, the level of a cache or the
+ * lowest cpu of a cpu list. Missing files are expected, hence not logged.
+ */
+static int
+cpu_sysfs_first(const char *path, unsigned long *val)
+{
+	char buf[BUFSIZ];
+	char *end;
+	FILE *f;
+
+	f = fopen(path, "r");
+	if (f == NULL)
+		return -1;
+	if (fgets(buf, sizeof(buf), f) == NULL) {
+		fclose(f);
+		return -1;
+	}
+	fclose(f);
+
+	*val = strtoul(buf, &end, 10);
+	if (end == buf)
+		return -1;
+	return 0;
+}
+
+/* Get the lowest cpu sharing the cache of the given level with a cpu */
+static int
+cpu_cache_domain_id(unsigned int cpu_id, unsigned int level)
+{
+	char path[PATH_MAX];
+	unsigned long val;
+	unsigned int idx;
+
+	for (idx = 0; ; idx++) {
+		snprintf(path, sizeof(path), SYS_CPU_DIR "/" CACHE_DIR "/level",
+			cpu_id, idx);
+		if (cpu_sysfs_first(path, &val) != 0)
+			return -1;
+		if (val != level)
+			continue;
+
+		snprintf(path, sizeof(path), SYS_CPU_DIR "/" CACHE_DIR
+			"/shared_cpu_list", cpu_id, idx);
+		if (cpu_sysfs_first(path, &val) != 0)
+			return -1;
+		return val;
+	}
+}
+
+/* Get the lowest cpu of a topology domain from the /sys/.../cpuX values */
+int
+eal_cpu_domain_id(unsigned int cpu_id, enum rte_lcore_domain domain)
+{
+	char path[PATH_MAX];
+	unsigned long val;
+	const char *file;
+
+	switch (domain) {
+	case RTE_LCORE_DOMAIN_SMT:
+		file = SIBLINGS_FILE;
+		break;
+	case RTE_LCORE_DOMAIN_CLUSTER:
+		file = CLUSTER_FILE;
+		break;
+	case RTE_LCORE_DOMAIN_L2:
+		return cpu_cache_domain_id(cpu_id, 2);
+	case RTE_LCORE_DOMAIN_L3:
+		return cpu_cache_domain_id(cpu_id, 3);
+	default:
+		return -1;
+	}
+
+	snprintf(path, sizeof(path), SYS_CPU_DIR "/%s", cpu_id, file);
+	if (cpu_sysfs_first(path, &val) != 0)
+		return -1;
+	return val;
+}
@@ -14,6 +14,7 @@
 #include <unistd.h>
 #include <limits.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <signal.h>
 #include <setjmp.h>
 #include <linux/memfd.h>
@@ -28,6 +29,7 @@
 #include <rte_log.h>
 #include <rte_eal.h>
 #include <rte_memory.h>
+#include <rte_per_lcore.h>
 
 #include "eal_filesystem.h"
 #include "eal_internal_cfg.h"
@@ -76,11 +78,12 @@ static struct {
 /** local copy of a memory map, used to synchronize memory hotplug in MP */
 static struct rte_memseg_list local_memsegs[RTE_MAX_MEMSEG_LISTS];
 
-static sigjmp_buf huge_jmpenv;
+/* per thread, as the initial memory of NUMA nodes may be mapped in parallel */
+static RTE_DEFINE_PER_LCORE(sigjmp_buf, huge_jmpenv);
 
 static void huge_sigbus_handler(int signo __rte_unused)
 {
-	siglongjmp(huge_jmpenv, 1);
+	siglongjmp(RTE_PER_LCORE(huge_jmpenv), 1);
 }
 
 /* Put setjmp into a wrap method to avoid compiling error. Any non-volatile,
@@ -89,11 +92,14 @@ static void huge_sigbus_handler(int signo __rte_unused)
  */
 static int huge_wrap_sigsetjmp(void)
 {
-	return sigsetjmp(huge_jmpenv, 1);
+	return sigsetjmp(RTE_PER_LCORE(huge_jmpenv), 1);
 }
 
 static struct sigaction huge_action_old;
 static int huge_need_recover;
+/* number of threads mapping pages, the first one installs the handler */
+static unsigned int huge_sigbus_users;
+static pthread_mutex_t huge_sigbus_lock = PTHREAD_MUTEX_INITIALIZER;
 
 static void
 huge_register_sigbus(void)
@@ -107,16 +113,21 @@ huge_register_sigbus(void)
 	action.sa_mask = mask;
 	action.sa_handler = huge_sigbus_handler;
 
-	huge_need_recover = !sigaction(SIGBUS, &action, &huge_action_old);
+	pthread_mutex_lock(&huge_sigbus_lock);
+	if (huge_sigbus_users++ == 0)
+		huge_need_recover = !sigaction(SIGBUS, &action, &huge_action_old);
+	pthread_mutex_unlock(&huge_sigbus_lock);
 }
 
 static void
 huge_recover_sigbus(void)
 {
-	if (huge_need_recover) {
+	pthread_mutex_lock(&huge_sigbus_lock);
+	if (--huge_sigbus_users == 0 && huge_need_recover) {
 		sigaction(SIGBUS, &huge_action_old, NULL);
 		huge_need_recover = 0;
 	}
+	pthread_mutex_unlock(&huge_sigbus_lock);
 }
 
 #ifdef RTE_EAL_NUMA_AWARE_HUGEPAGES
@@ -577,6 +588,7 @@ alloc_seg(struct rte_memseg *ms, void *addr, int socket_id,
 	if (va != addr) {
 		EAL_LOG(DEBUG, "%s(): wrong mmap() address", __func__);
 		munmap(va, alloc_sz);
+		huge_recover_sigbus();
 		goto resized;
 	}
 
@@ -109,6 +109,14 @@ __rte_trace_mem_per_thread_alloc(void)
 {
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(__rte_trace_mem_switch, 26.03)
+int
+__rte_trace_mem_switch(void *mem)
+{
+	RTE_SET_USED(mem);
+	return -ENOTSUP;
+}
+
 void
 trace_mem_per_thread_free(void)
 {
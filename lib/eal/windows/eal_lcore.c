@@ -239,6 +239,14 @@ eal_cpu_core_id(unsigned int lcore_id)
 	return cpu_map.lcores[lcore_id].core_id;
 }
 
+int
+eal_cpu_domain_id(__rte_unused unsigned int cpu_id,
+	__rte_unused enum rte_lcore_domain domain)
+{
+	/* Topology of the caches is not detected on Windows */
+	return -1;
+}
+
 unsigned int
 eal_socket_numa_node(unsigned int socket_id)
 {
@@ -10,6 +10,7 @@
 #include <sys/queue.h>
 
 #include <eal_export.h>
+#include <rte_bitops.h>
 #include <rte_cpuflags.h>
 #include <rte_string_fns.h>
 #include <rte_log.h>
@@ -20,6 +21,7 @@
 #include <rte_branch_prediction.h>
 #include <rte_memcpy.h>
 #include <rte_ring.h>
+#include <rte_rcu_qsbr.h>
 #include <rte_jhash.h>
 #include <rte_hash_crc.h>
 #include <rte_tailq.h>
@@ -80,6 +82,11 @@ allocated memory
  */
 #define EFD_NUM_CHUNK_PADDING_BYTES (256)
 
+/** Size of the online table of a socket */
+#define EFD_ONLINE_TABLE_SIZE(num_chunks) \
+	((uint64_t)(num_chunks) * sizeof(struct efd_online_chunk) + \
+	EFD_NUM_CHUNK_PADDING_BYTES)
+
 /* All different internal lookup functions */
 enum efd_lookup_internal_function {
 	EFD_LOOKUP_SCALAR = 0,
@@ -255,9 +262,17 @@ struct rte_efd_table {
 	enum efd_lookup_internal_function lookup_fn;
 	/**< Indicates which lookup function to use. */
 
-	struct efd_online_chunk *chunks[RTE_MAX_NUMA_NODES];
+	RTE_ATOMIC(struct efd_online_chunk *) chunks[RTE_MAX_NUMA_NODES];
 	/**< Dynamic array of size num_chunks of chunk records. */
 
+	struct efd_online_chunk *shadow_chunks[RTE_MAX_NUMA_NODES];
+	/**< Copies of the chunk records written by the updates,
+	 * then swapped with the ones used by the lookups, when RCU is enabled.
+	 */
+
+	struct rte_rcu_qsbr *v;
+	/**< RCU QSBR variable of the lookups, NULL if RCU is not enabled. */
+
 	struct efd_offline_chunk_rules *offline_chunks;
 	/**< Dynamic array of size num_chunks of key-value pairs. */
 
@@ -303,12 +318,33 @@ efd_get_bin_id(const struct rte_efd_table * const table,
 }
 
 /**
- * Looks up the current permutation choice for a particular bin in the online table
+ * Returns the online table of a socket that the updates write to
  *
  * @param table
- *  EFD table to reference
+ *   EFD table to reference
  * @param socket_id
- *   Socket ID to use to look up existing values (ideally caller's socket id)
+ *   Socket ID of the online table
+ *
+ * @return
+ *   The copy of the online table not used by the lookups if RCU is enabled,
+ *   else the online table used by the lookups
+ */
+static inline struct efd_online_chunk *
+efd_update_chunks(const struct rte_efd_table * const table,
+		const unsigned int socket_id)
+{
+	if (table->v != NULL)
+		return table->shadow_chunks[socket_id];
+
+	return rte_atomic_load_explicit(&table->chunks[socket_id],
+			rte_memory_order_relaxed);
+}
+
+/**
+ * Looks up the current permutation choice for a particular bin in the online table
+ *
+ * @param chunks
+ *   Online table to reference
  * @param chunk_id
  *   Chunk ID of bin to look up
  * @param bin_id
@@ -318,11 +354,10 @@ efd_get_bin_id(const struct rte_efd_table * const table,
  *   Currently active permutation choice in the online table
  */
 static inline uint8_t
-efd_get_choice(const struct rte_efd_table * const table,
-		const unsigned int socket_id, const uint32_t chunk_id,
-		const uint32_t bin_id)
+efd_get_choice(const struct efd_online_chunk * const chunks,
+		const uint32_t chunk_id, const uint32_t bin_id)
 {
-	struct efd_online_chunk *chunk = &table->chunks[socket_id][chunk_id];
+	const struct efd_online_chunk *chunk = &chunks[chunk_id];
 
 	/*
 	 * Grab the chunk (byte) that contains the choices
@@ -614,16 +649,20 @@ rte_efd_create(const char *name, uint32_t max_num_rules, uint32_t key_len,
 			num_chunks, table->max_num_rules);
 
 	/* Make sure all the allocatable table pointers are NULL initially */
-	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++)
-		table->chunks[socket_id] = NULL;
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
+		rte_atomic_store_explicit(&table->chunks[socket_id], NULL,
+				rte_memory_order_relaxed);
+		table->shadow_chunks[socket_id] = NULL;
+	}
 	table->offline_chunks = NULL;
+	table->v = NULL;
 
 	/*
 	 * Allocate one online table per socket specified
 	 * in the user-supplied bitmask
 	 */
-	uint64_t online_table_size = num_chunks * sizeof(struct efd_online_chunk) +
-			EFD_NUM_CHUNK_PADDING_BYTES;
+	uint64_t online_table_size = EFD_ONLINE_TABLE_SIZE(num_chunks);
+	struct efd_online_chunk *chunks;
 
 	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
 		if ((online_cpu_socket_bitmask >> socket_id) & 0x01) {
@@ -631,13 +670,14 @@ rte_efd_create(const char *name, uint32_t max_num_rules, uint32_t key_len,
 			 * Allocate all of the EFD table chunks (the online portion)
 			 * as a continuous block
 			 */
-			table->chunks[socket_id] =
-				rte_zmalloc_socket(
+			chunks = rte_zmalloc_socket(
 				NULL,
 				online_table_size,
 				RTE_CACHE_LINE_SIZE,
 				socket_id);
-			if (table->chunks[socket_id] == NULL) {
+			rte_atomic_store_explicit(&table->chunks[socket_id],
+					chunks, rte_memory_order_relaxed);
+			if (chunks == NULL) {
 				EFD_LOG(ERR,
 						"Allocating EFD online table on "
 						"socket %u failed",
@@ -771,8 +811,11 @@ rte_efd_free(struct rte_efd_table *table)
 	if (table == NULL)
 		return;
 
-	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++)
-		rte_free(table->chunks[socket_id]);
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
+		rte_free(rte_atomic_load_explicit(&table->chunks[socket_id],
+				rte_memory_order_relaxed));
+		rte_free(table->shadow_chunks[socket_id]);
+	}
 
 	efd_list = RTE_TAILQ_CAST(rte_efd_tailq.head, rte_efd_list);
 	rte_mcfg_tailq_write_lock();
@@ -792,6 +835,56 @@ rte_efd_free(struct rte_efd_table *table)
 	rte_free(table);
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_efd_rcu_qsbr_add, 26.03)
+int
+rte_efd_rcu_qsbr_add(struct rte_efd_table *table,
+		const struct rte_efd_rcu_config *cfg)
+{
+	struct efd_online_chunk *chunks;
+	uint64_t online_table_size;
+	int socket_id;
+
+	if (table == NULL || cfg == NULL || cfg->v == NULL) {
+		rte_errno = EINVAL;
+		return 1;
+	}
+
+	if (table->v != NULL) {
+		rte_errno = EEXIST;
+		return 1;
+	}
+
+	/* Allocate the copies of the online tables written by the updates */
+	online_table_size = EFD_ONLINE_TABLE_SIZE(table->num_chunks);
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
+		chunks = rte_atomic_load_explicit(&table->chunks[socket_id],
+				rte_memory_order_relaxed);
+		if (chunks == NULL)
+			continue;
+
+		table->shadow_chunks[socket_id] = rte_zmalloc_socket(NULL,
+				online_table_size, RTE_CACHE_LINE_SIZE,
+				socket_id);
+		if (table->shadow_chunks[socket_id] == NULL) {
+			EFD_LOG(ERR, "Allocating EFD online table copy on "
+					"socket %u failed", socket_id);
+			for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES;
+					socket_id++) {
+				rte_free(table->shadow_chunks[socket_id]);
+				table->shadow_chunks[socket_id] = NULL;
+			}
+			rte_errno = ENOMEM;
+			return 1;
+		}
+		memcpy(table->shadow_chunks[socket_id], chunks,
+				online_table_size);
+	}
+
+	table->v = cfg->v;
+
+	return 0;
+}
+
 /**
  * Applies a previously computed table entry to the specified table for all
  * socket-local copies of the online table.
@@ -820,7 +913,9 @@ efd_apply_update(struct rte_efd_table * const table, const unsigned int socket_i
 		const struct efd_online_group_entry * const new_group_entry)
 {
 	int i;
-	struct efd_online_chunk *chunk = &table->chunks[socket_id][chunk_id];
+	struct efd_online_chunk *chunks;
+	struct efd_online_chunk *chunk =
+			&efd_update_chunks(table, socket_id)[chunk_id];
 	uint8_t bin_index = bin_id / EFD_CHUNK_NUM_BIN_TO_GROUP_SETS;
 
 	/*
@@ -840,16 +935,51 @@ efd_apply_update(struct rte_efd_table * const table, const unsigned int socket_i
 
 	/* Update the online table with the new data across all sockets */
 	for (i = 0; i < RTE_MAX_NUMA_NODES; i++) {
-		if (table->chunks[i] != NULL) {
-			memcpy(&(table->chunks[i][chunk_id].groups[group_id]),
+		chunks = efd_update_chunks(table, i);
+		if (chunks != NULL) {
+			memcpy(&(chunks[chunk_id].groups[group_id]),
 					new_group_entry,
 					sizeof(struct efd_online_group_entry));
-			table->chunks[i][chunk_id].bin_choice_list[bin_index] =
+			chunks[chunk_id].bin_choice_list[bin_index] =
 					choice_chunk;
 		}
 	}
 }
 
+/**
+ * Makes the updates written to the online tables visible to the lookups.
+ *
+ * With RCU enabled, the online tables written by the updates are swapped
+ * with the ones used by the lookups, then it waits for the lookups
+ * to stop using the previous ones, which the caller must bring up to date
+ * before writing the next updates.
+ * Without RCU, the updates are written in place and there is nothing to do.
+ *
+ * @param table
+ *   EFD table to reference
+ */
+static void
+efd_publish(struct rte_efd_table * const table)
+{
+	struct efd_online_chunk *chunks;
+	int i;
+
+	if (table->v == NULL)
+		return;
+
+	for (i = 0; i < RTE_MAX_NUMA_NODES; i++) {
+		if (table->shadow_chunks[i] == NULL)
+			continue;
+		chunks = rte_atomic_load_explicit(&table->chunks[i],
+				rte_memory_order_relaxed);
+		rte_atomic_store_explicit(&table->chunks[i],
+				table->shadow_chunks[i], rte_memory_order_release);
+		table->shadow_chunks[i] = chunks;
+	}
+
+	rte_rcu_qsbr_synchronize(table->v, RTE_QSBR_THRID_INVALID);
+}
+
 /*
  * Move the bin from prev group to the new group
  */
@@ -995,8 +1125,8 @@ efd_compute_update(struct rte_efd_table * const table,
 			&table->offline_chunks[*chunk_id];
 	struct efd_offline_group_rules *new_group;
 
-	uint8_t current_choice = efd_get_choice(table, socket_id,
-			*chunk_id, *bin_id);
+	uint8_t current_choice = efd_get_choice(
+			efd_update_chunks(table, socket_id), *chunk_id, *bin_id);
 	uint32_t current_group_id = efd_bin_to_group[current_choice][*bin_id];
 	struct efd_offline_group_rules * const current_group =
 			&chunk->group_rules[current_group_id];
@@ -1198,6 +1328,367 @@ rte_efd_update(struct rte_efd_table * const table, const unsigned int socket_id,
 
 	efd_apply_update(table, socket_id, chunk_id, group_id, bin_id,
 			new_bin_choice, &entry);
+	if (table->v != NULL) {
+		efd_publish(table);
+		/* Apply the update to the copies swapped out by the lookups */
+		efd_apply_update(table, socket_id, chunk_id, group_id, bin_id,
+				new_bin_choice, &entry);
+	}
+	return status;
+}
+
+/** Chunk being updated by rte_efd_update_bulk() */
+struct efd_bulk_chunk {
+	struct efd_online_chunk online;
+	/**< Bin choices and online groups of the chunk, computed offline. */
+
+	uint64_t dirty_groups;
+	/**< Bitmask of the groups needing a new perfect hash. */
+
+	uint64_t saved_groups;
+	/**< Bitmask of the groups saved before being modified. */
+
+	struct efd_offline_group_rules saved[EFD_CHUNK_NUM_GROUPS];
+	/**< Offline groups before the update, to revert it. */
+
+	uint32_t num_slots;
+	/**< Number of keys inserted in the chunk. */
+
+	uint32_t slots[EFD_TARGET_CHUNK_MAX_NUM_RULES];
+	/**< Key slots of the keys inserted in the chunk. */
+};
+
+/*
+ * Save an offline group before its first modification
+ */
+static inline void
+efd_bulk_save_group(struct efd_bulk_chunk * const bulk,
+		const struct efd_offline_chunk_rules * const chunk,
+		const uint32_t group_id)
+{
+	if (bulk->saved_groups & RTE_BIT64(group_id))
+		return;
+
+	bulk->saved[group_id] = chunk->group_rules[group_id];
+	bulk->saved_groups |= RTE_BIT64(group_id);
+}
+
+/*
+ * Revert the offline groups and key slots modified by a bulk update of a chunk
+ */
+static void
+efd_bulk_revert(struct rte_efd_table * const table,
+		struct efd_bulk_chunk * const bulk,
+		struct efd_offline_chunk_rules * const chunk)
+{
+	uint64_t groups = bulk->saved_groups;
+	uint32_t group_id, i;
+
+	while (groups != 0) {
+		group_id = rte_ctz64(groups);
+		groups &= groups - 1;
+		chunk->group_rules[group_id] = bulk->saved[group_id];
+	}
+
+	for (i = 0; i < bulk->num_slots; i++)
+		rte_ring_sp_enqueue(table->free_slots,
+				(void *)((uintptr_t)bulk->slots[i]));
+	table->num_rules -= bulk->num_slots;
+}
+
+/**
+ * Inserts or updates a key in the offline groups of a chunk,
+ * without computing the perfect hash of the modified groups,
+ * marked in the dirty_groups bitmask instead.
+ *
+ * @return
+ *   Same as efd_compute_update()
+ */
+static inline int
+efd_bulk_add(struct rte_efd_table * const table,
+		struct efd_bulk_chunk * const bulk,
+		struct efd_offline_chunk_rules * const chunk,
+		const uint32_t bin_id, const void *key, const efd_value_t value)
+{
+	uint8_t choice = efd_get_choice(&bulk->online, 0, bin_id);
+	uint32_t group_id = efd_bin_to_group[choice][bin_id];
+	struct efd_offline_group_rules * const group =
+			&chunk->group_rules[group_id];
+	uint32_t new_group_id = group_id;
+	uint32_t smallest_size, new_idx;
+	uint8_t bin_size = 0;
+	uint8_t new_choice = choice;
+	void *slot_id = NULL;
+	int status = EXIT_SUCCESS;
+	unsigned int i;
+
+	/* Scan the bin of the key and see if the key is already present */
+	for (i = 0; i < group->num_rules; i++) {
+		if (group->bin_id[i] != bin_id)
+			continue;
+		bin_size++;
+
+		if (memcmp(EFD_KEY(group->key_idx[i], table), key,
+				table->key_len) != 0)
+			continue;
+
+		if (group->value[i] == value)
+			return RTE_EFD_UPDATE_NO_CHANGE;
+
+		efd_bulk_save_group(bulk, chunk, group_id);
+		group->value[i] = value;
+		bulk->dirty_groups |= RTE_BIT64(group_id);
+		return EXIT_SUCCESS;
+	}
+
+	/* Key does not exist. Insert the rule into the bin/group */
+	if (unlikely(group->num_rules >= EFD_MAX_GROUP_NUM_RULES))
+		return RTE_EFD_UPDATE_FAILED;
+
+	if (unlikely(group->num_rules == (EFD_MAX_GROUP_NUM_RULES - 1)))
+		status = RTE_EFD_UPDATE_WARN_GROUP_FULL;
+
+	if (rte_ring_sc_dequeue(table->free_slots, &slot_id) != 0)
+		return RTE_EFD_UPDATE_FAILED;
+
+	new_idx = (uint32_t) ((uintptr_t) slot_id);
+	bulk->slots[bulk->num_slots++] = new_idx;
+	rte_memcpy(EFD_KEY(new_idx, table), key, table->key_len);
+
+	efd_bulk_save_group(bulk, chunk, group_id);
+	group->key_idx[group->num_rules] = new_idx;
+	group->value[group->num_rules] = value;
+	group->bin_id[group->num_rules] = bin_id;
+	group->num_rules++;
+	table->num_rules++;
+	bin_size++;
+	bulk->dirty_groups |= RTE_BIT64(group_id);
+
+	/* Group need to be rebalanced when it starts to get loaded */
+	if (group->num_rules <= EFD_MIN_BALANCED_NUM_RULES)
+		return status;
+
+	/*
+	 * Move the bin to the smallest of the groups it can map to,
+	 * which always has room for it
+	 */
+	smallest_size = group->num_rules - bin_size;
+	for (i = 0; i < EFD_CHUNK_NUM_BIN_TO_GROUP_SETS; i++) {
+		uint32_t test_group_id = efd_bin_to_group[i][bin_id];
+
+		if (chunk->group_rules[test_group_id].num_rules < smallest_size) {
+			smallest_size = chunk->group_rules[test_group_id].num_rules;
+			new_group_id = test_group_id;
+			new_choice = i;
+		}
+	}
+
+	if (new_group_id == group_id)
+		return status;
+
+	efd_bulk_save_group(bulk, chunk, new_group_id);
+	move_groups(bin_id, bin_size, &chunk->group_rules[new_group_id], group);
+	bulk->dirty_groups |= RTE_BIT64(new_group_id);
+
+	uint8_t * const choice_chunk = &bulk->online.bin_choice_list[
+			bin_id / EFD_CHUNK_NUM_BIN_TO_GROUP_SETS];
+	int offset = (bin_id & 0x3) * 2;
+
+	*choice_chunk = (*choice_chunk & (~(0x03 << offset)))
+			| ((new_choice & 0x03) << offset);
+
+	return status;
+}
+
+/**
+ * Inserts or updates the keys of a chunk, computing the perfect hash
+ * of each modified group once.
+ * Falls back to rte_efd_update() of each key if a perfect hash is not found.
+ *
+ * @return
+ *   0, RTE_EFD_UPDATE_WARN_GROUP_FULL or RTE_EFD_UPDATE_FAILED
+ */
+static int
+efd_bulk_update_chunk(struct rte_efd_table * const table,
+		const unsigned int socket_id, struct efd_bulk_chunk * const bulk,
+		const uint32_t chunk_id, const uint32_t * const key_idx,
+		const uint32_t num_keys, const void **key_list,
+		const efd_value_t * const value_list)
+{
+	struct efd_offline_chunk_rules * const chunk =
+			&table->offline_chunks[chunk_id];
+	struct efd_online_chunk *chunks;
+	uint32_t i, group_id, bin_id, unused;
+	uint64_t groups;
+	int ret, status = EXIT_SUCCESS;
+
+	memcpy(&bulk->online, &efd_update_chunks(table, socket_id)[chunk_id],
+			sizeof(bulk->online));
+	bulk->dirty_groups = 0;
+	bulk->saved_groups = 0;
+	bulk->num_slots = 0;
+
+	for (i = 0; i < num_keys; i++) {
+		const void *key = key_list[key_idx[i]];
+
+		efd_compute_ids(table, key, &unused, &bin_id);
+		ret = efd_bulk_add(table, bulk, chunk, bin_id, key,
+				value_list[key_idx[i]]);
+		if (ret == RTE_EFD_UPDATE_FAILED)
+			goto fallback;
+		if (ret == RTE_EFD_UPDATE_WARN_GROUP_FULL)
+			status = ret;
+	}
+
+	/* Recompute the hash function of each modified group */
+	groups = bulk->dirty_groups;
+	while (groups != 0) {
+		group_id = rte_ctz64(groups);
+		groups &= groups - 1;
+		if (efd_search_hash(table, &chunk->group_rules[group_id],
+				&bulk->online.groups[group_id]) != 0) {
+			EFD_LOG(DEBUG,
+					"Failed to find perfect hash for chunk %u "
+					"group %u, updating keys one by one",
+					chunk_id, group_id);
+			goto fallback;
+		}
+	}
+
+	/*
+	 * Update the online table across all sockets,
+	 * the groups before the bin choices that can point to them
+	 */
+	for (i = 0; i < RTE_MAX_NUMA_NODES; i++) {
+		chunks = efd_update_chunks(table, i);
+		if (chunks == NULL)
+			continue;
+
+		groups = bulk->dirty_groups;
+		while (groups != 0) {
+			group_id = rte_ctz64(groups);
+			groups &= groups - 1;
+			memcpy(&chunks[chunk_id].groups[group_id],
+					&bulk->online.groups[group_id],
+					sizeof(struct efd_online_group_entry));
+		}
+		memcpy(chunks[chunk_id].bin_choice_list,
+				bulk->online.bin_choice_list,
+				sizeof(bulk->online.bin_choice_list));
+	}
+
+	return status;
+
+fallback:
+	efd_bulk_revert(table, bulk, chunk);
+
+	status = EXIT_SUCCESS;
+	for (i = 0; i < num_keys; i++) {
+		uint32_t new_chunk_id = 0, new_group_id = 0, new_bin_id = 0;
+		uint8_t new_bin_choice = 0;
+		struct efd_online_group_entry entry = {{0}};
+
+		ret = efd_compute_update(table, socket_id, key_list[key_idx[i]],
+				value_list[key_idx[i]], &new_chunk_id,
+				&new_group_id, &new_bin_id, &new_bin_choice,
+				&entry);
+		if (ret == RTE_EFD_UPDATE_NO_CHANGE)
+			continue;
+		if (ret == RTE_EFD_UPDATE_FAILED) {
+			status = ret;
+			continue;
+		}
+		if (ret == RTE_EFD_UPDATE_WARN_GROUP_FULL && status == EXIT_SUCCESS)
+			status = ret;
+
+		efd_apply_update(table, socket_id, new_chunk_id, new_group_id,
+				new_bin_id, new_bin_choice, &entry);
+	}
+
+	return status;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_efd_update_bulk, 26.03)
+int
+rte_efd_update_bulk(struct rte_efd_table * const table,
+		const unsigned int socket_id, const uint32_t num_keys,
+		const void **key_list, const efd_value_t *value_list)
+{
+	struct efd_bulk_chunk *bulk = NULL;
+	struct efd_online_chunk *chunks;
+	uint32_t *chunk_end = NULL;
+	uint32_t *key_idx = NULL;
+	uint32_t i, chunk_id, bin_id, start;
+	int ret, status = EXIT_SUCCESS;
+
+	if (table == NULL || key_list == NULL || value_list == NULL)
+		return -EINVAL;
+
+	if (num_keys == 0)
+		return EXIT_SUCCESS;
+
+	bulk = rte_malloc(NULL, sizeof(*bulk), RTE_CACHE_LINE_SIZE);
+	chunk_end = rte_zmalloc(NULL,
+			(table->num_chunks + 1) * sizeof(*chunk_end), 0);
+	key_idx = rte_malloc(NULL, num_keys * sizeof(*key_idx), 0);
+	if (bulk == NULL || chunk_end == NULL || key_idx == NULL) {
+		EFD_LOG(ERR, "Allocating bulk update of %u keys failed",
+				num_keys);
+		status = -ENOMEM;
+		goto exit;
+	}
+
+	/*
+	 * Sort the keys by chunk, keeping their order within each chunk,
+	 * so that all the keys of a chunk are inserted together.
+	 * chunk_end[chunk_id] ends up as the index following
+	 * the last key of the chunk in key_idx.
+	 */
+	for (i = 0; i < num_keys; i++) {
+		efd_compute_ids(table, key_list[i], &chunk_id, &bin_id);
+		chunk_end[chunk_id + 1]++;
+	}
+	for (chunk_id = 0; chunk_id < table->num_chunks; chunk_id++)
+		chunk_end[chunk_id + 1] += chunk_end[chunk_id];
+	for (i = 0; i < num_keys; i++) {
+		efd_compute_ids(table, key_list[i], &chunk_id, &bin_id);
+		key_idx[chunk_end[chunk_id]++] = i;
+	}
+
+	for (chunk_id = 0, start = 0; chunk_id < table->num_chunks;
+			start = chunk_end[chunk_id++]) {
+		if (chunk_end[chunk_id] == start)
+			continue;
+
+		ret = efd_bulk_update_chunk(table, socket_id, bulk, chunk_id,
+				&key_idx[start], chunk_end[chunk_id] - start,
+				key_list, value_list);
+		status = RTE_MAX(status, ret);
+	}
+
+	if (table->v != NULL) {
+		efd_publish(table);
+		/* Copy the updated chunks to the copies swapped out by the lookups */
+		for (i = 0; i < RTE_MAX_NUMA_NODES; i++) {
+			if (table->shadow_chunks[i] == NULL)
+				continue;
+			chunks = rte_atomic_load_explicit(&table->chunks[i],
+					rte_memory_order_relaxed);
+			for (chunk_id = 0, start = 0; chunk_id < table->num_chunks;
+					start = chunk_end[chunk_id++]) {
+				if (chunk_end[chunk_id] != start)
+					memcpy(&table->shadow_chunks[i][chunk_id],
+							&chunks[chunk_id],
+							sizeof(struct efd_online_chunk));
+			}
+		}
+	}
+
+exit:
+	rte_free(key_idx);
+	rte_free(chunk_end);
+	rte_free(bulk);
+
 	return status;
 }
 
@@ -1215,8 +1706,8 @@ rte_efd_delete(struct rte_efd_table * const table, const unsigned int socket_id,
 	struct efd_offline_chunk_rules * const chunk =
 			&table->offline_chunks[chunk_id];
 
-	uint8_t current_choice = efd_get_choice(table, socket_id,
-			chunk_id, bin_id);
+	uint8_t current_choice = efd_get_choice(
+			efd_update_chunks(table, socket_id), chunk_id, bin_id);
 	uint32_t current_group_id = efd_bin_to_group[current_choice][bin_id];
 	struct efd_offline_group_rules * const current_group =
 			&chunk->group_rules[current_group_id];
@@ -1326,11 +1817,13 @@ rte_efd_lookup(const struct rte_efd_table * const table,
 	uint32_t chunk_id, group_id, bin_id;
 	uint8_t bin_choice;
 	const struct efd_online_group_entry *group;
-	const struct efd_online_chunk * const chunks = table->chunks[socket_id];
+	const struct efd_online_chunk * const chunks =
+			rte_atomic_load_explicit(&table->chunks[socket_id],
+				rte_memory_order_acquire);
 
 	/* Determine the chunk and group location for the given key */
 	efd_compute_ids(table, key, &chunk_id, &bin_id);
-	bin_choice = efd_get_choice(table, socket_id, chunk_id, bin_id);
+	bin_choice = efd_get_choice(chunks, chunk_id, bin_id);
 	group_id = efd_bin_to_group[bin_choice][bin_id];
 	group = &chunks[chunk_id].groups[group_id];
 
@@ -1350,9 +1843,11 @@ void rte_efd_lookup_bulk(const struct rte_efd_table * const table,
 	uint32_t bin_id_list[RTE_EFD_BURST_MAX];
 	uint8_t bin_choice_list[RTE_EFD_BURST_MAX];
 	uint32_t group_id_list[RTE_EFD_BURST_MAX];
-	struct efd_online_group_entry *group;
+	const struct efd_online_group_entry *group;
 
-	struct efd_online_chunk *chunks = table->chunks[socket_id];
+	const struct efd_online_chunk *chunks =
+			rte_atomic_load_explicit(&table->chunks[socket_id],
+				rte_memory_order_acquire);
 
 	for (i = 0; i < num_keys; i++) {
 		efd_compute_ids(table, key_list[i], &chunk_id_list[i],
@@ -1361,7 +1856,7 @@ void rte_efd_lookup_bulk(const struct rte_efd_table * const table,
 	}
 
 	for (i = 0; i < num_keys; i++) {
-		bin_choice_list[i] = efd_get_choice(table, socket_id,
+		bin_choice_list[i] = efd_get_choice(chunks,
 				chunk_id_list[i], bin_id_list[i]);
 		group_id_list[i] =
 				efd_bin_to_group[bin_choice_list[i]][bin_id_list[i]];
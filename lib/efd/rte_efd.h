@@ -13,6 +13,9 @@
 
 #include <stdint.h>
 
+#include <rte_compat.h>
+#include <rte_rcu_qsbr.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -201,6 +204,92 @@ int
 rte_efd_update(struct rte_efd_table *table, unsigned int socket_id,
 	const void *key, efd_value_t value);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Inserts or updates several key/value pairs at once.
+ * Equivalent to calling rte_efd_update() for each pair in order,
+ * but the keys are sorted by chunk and the perfect hash of each group
+ * modified by the keys of a chunk is computed only once,
+ * instead of once per key.
+ * This is much faster than rte_efd_update() to load many keys,
+ * and requires a temporary array of num_keys indexes.
+ * If no perfect hash is found for a modified group,
+ * the keys of its chunk are updated one by one as rte_efd_update() does.
+ * If RCU is enabled with rte_efd_rcu_qsbr_add(),
+ * all the updates become visible to the lookups at once.
+ * This operation is not multi-thread safe
+ * and should only be called from one thread.
+ *
+ * @param table
+ *   EFD table to reference
+ * @param socket_id
+ *   Socket ID to use to lookup existing value (ideally caller's socket id)
+ * @param num_keys
+ *   Number of keys in the key_list array
+ * @param key_list
+ *   Array of num_keys pointers to the EFD table keys to modify
+ * @param value_list
+ *   Array of num_keys values to associate with the keys
+ *
+ * @return
+ *  RTE_EFD_UPDATE_WARN_GROUP_FULL
+ *     All keys were inserted or updated, but the last available space
+ *     of some groups was used
+ *  RTE_EFD_UPDATE_FAILED
+ *     Some keys could not be inserted or updated, the other ones were
+ *  -EINVAL
+ *     Invalid parameters
+ *  -ENOMEM
+ *     Not enough memory to sort the keys, none was inserted or updated
+ *  0 - success
+ */
+__rte_experimental
+int
+rte_efd_update_bulk(struct rte_efd_table *table, unsigned int socket_id,
+	uint32_t num_keys, const void **key_list, const efd_value_t *value_list);
+
+/** EFD RCU QSBR configuration structure. */
+struct rte_efd_rcu_config {
+	struct rte_rcu_qsbr *v;	/* RCU QSBR variable of the lookup threads. */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Associate RCU QSBR variable with an EFD table,
+ * so that the lookups are not disturbed by concurrent updates.
+ *
+ * A second copy of each online table is allocated,
+ * the updates write to it, then swap it with the one used by the lookups
+ * and wait for the lookup threads to report a quiescent state
+ * before updating the other copy.
+ * Each rte_efd_update() call waits for a grace period,
+ * each rte_efd_update_bulk() call waits for a single one.
+ * The lookup threads must be registered to the RCU QSBR variable
+ * and report their quiescent states, between lookups.
+ *
+ * This operation is not multi-thread safe with the updates.
+ *
+ * @param table
+ *   EFD table to reference
+ * @param cfg
+ *   RCU QSBR configuration
+ * @return
+ *   On success - 0
+ *   On error - 1 with error code set in rte_errno.
+ *   Possible rte_errno codes are:
+ *   - EINVAL - invalid pointer
+ *   - EEXIST - already added QSBR
+ *   - ENOMEM - memory allocation failure
+ */
+__rte_experimental
+int
+rte_efd_rcu_qsbr_add(struct rte_efd_table *table,
+	const struct rte_efd_rcu_config *cfg);
+
 /**
  * Removes any value currently associated with the specified key from the table
  * This operation is not multi-thread safe
@@ -226,6 +315,8 @@ rte_efd_delete(struct rte_efd_table *table, unsigned int socket_id,
 /**
  * Looks up the value associated with a key
  * This operation is multi-thread safe.
+ * It is safe with concurrent updates if RCU is enabled
+ * with rte_efd_rcu_qsbr_add().
  *
  * NOTE: Lookups will *always* succeed - this is a property of
  * using a perfect hash table.
@@ -250,6 +341,8 @@ rte_efd_lookup(const struct rte_efd_table *table, unsigned int socket_id,
 /**
  * Looks up the value associated with several keys.
  * This operation is multi-thread safe.
+ * It is safe with concurrent updates if RCU is enabled
+ * with rte_efd_rcu_qsbr_add().
  *
  * NOTE: Lookups will *always* succeed - this is a property of
  * using a perfect hash table.
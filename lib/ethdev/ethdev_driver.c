@@ -82,6 +82,7 @@ eth_dev_set_dummy_fops(struct rte_eth_dev *eth_dev)
 	eth_dev->tx_pkt_burst = rte_eth_pkt_burst_dummy;
 	eth_dev->tx_pkt_prepare = rte_eth_tx_pkt_prepare_dummy;
 	eth_dev->rx_queue_count = rte_eth_queue_count_dummy;
+	eth_dev->rx_queue_pending = rte_eth_queue_count_dummy;
 	eth_dev->tx_queue_count = rte_eth_queue_count_dummy;
 	eth_dev->rx_descriptor_status = rte_eth_descriptor_status_dummy;
 	eth_dev->tx_descriptor_status = rte_eth_descriptor_status_dummy;
@@ -283,6 +284,8 @@ rte_eth_dev_release_port(struct rte_eth_dev *eth_dev)
 	eth_dev->tx_pkt_burst = NULL;
 	eth_dev->tx_pkt_prepare = NULL;
 	eth_dev->rx_queue_count = NULL;
+	eth_dev->rx_queue_pending = NULL;
+	eth_dev->tx_doorbell = NULL;
 	eth_dev->rx_descriptor_status = NULL;
 	eth_dev->tx_descriptor_status = NULL;
 	eth_dev->dev_ops = NULL;
@@ -77,6 +77,8 @@ struct __rte_cache_aligned rte_eth_dev {
 	eth_tx_prep_t tx_pkt_prepare;
 	/** Get the number of used Rx descriptors */
 	eth_rx_queue_count_t rx_queue_count;
+	/** Get a hint of the number of received packets pending */
+	eth_rx_queue_count_t rx_queue_pending;
 	/** Check the status of a Rx descriptor */
 	eth_rx_descriptor_status_t rx_descriptor_status;
 	/** Get the number of used Tx descriptors */
@@ -87,6 +89,8 @@ struct __rte_cache_aligned rte_eth_dev {
 	eth_recycle_tx_mbufs_reuse_t recycle_tx_mbufs_reuse;
 	/** Pointer to PMD receive descriptors refill function */
 	eth_recycle_rx_descriptors_refill_t recycle_rx_descriptors_refill;
+	/** Ring the deferred Tx doorbell, NULL if not supported */
+	eth_tx_doorbell_t tx_doorbell;
 
 	/**
 	 * Device data that is shared between primary and secondary processes
@@ -1271,6 +1275,16 @@ typedef int (*eth_rx_queue_avail_thresh_query_t)(struct rte_eth_dev *dev,
 					uint16_t *rx_queue_id,
 					uint8_t *avail_thresh);
 
+/**
+ * @internal Enable or disable the deferral of the Tx queue doorbell.
+ * @see rte_eth_tx_queue_doorbell_defer()
+ *
+ * When disabling, the driver must ring the doorbell of the descriptors
+ * already written.
+ */
+typedef int (*eth_tx_queue_doorbell_defer_t)(struct rte_eth_dev *dev,
+					uint16_t tx_queue_id, int on);
+
 /** @internal Get congestion management information. */
 typedef int (*eth_cman_info_get_t)(struct rte_eth_dev *dev,
 				struct rte_eth_cman_info *info);
@@ -1640,6 +1654,9 @@ struct eth_dev_ops {
 	/** Query Rx queue available descriptors threshold event */
 	eth_rx_queue_avail_thresh_query_t rx_queue_avail_thresh_query;
 
+	/** Enable or disable Tx queue doorbell deferral */
+	eth_tx_queue_doorbell_defer_t tx_queue_doorbell_defer;
+
 	/** Dump Rx descriptor info */
 	eth_rx_descriptor_dump_t eth_rx_descriptor_dump;
 	/** Dump Tx descriptor info */
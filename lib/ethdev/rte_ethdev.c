@@ -1029,6 +1029,264 @@ rte_eth_dev_tx_queue_stop(uint16_t port_id, uint16_t tx_queue_id)
 	return ret;
 }
 
+/*
+ * Ask the application to stop polling a queue which does not receive
+ * or transmit anymore. The queue functions are never called here:
+ * the application drains the queue from its own datapath lcore.
+ */
+static int
+eth_queue_quiesce(uint16_t port_id, uint16_t queue_id, bool rx,
+		  rte_eth_queue_quiesce_fn quiesce, void *arg)
+{
+	int ret;
+
+	ret = quiesce(port_id, queue_id, arg);
+	if (ret != 0)
+		RTE_ETHDEV_LOG_LINE(ERR,
+			"%s queue %u of port_id=%u not quiesced: %d",
+			rx ? "Rx" : "Tx", queue_id, port_id, ret);
+
+	return ret;
+}
+
+static int
+eth_dev_reta_get(uint16_t port_id, struct rte_eth_rss_reta_entry64 *reta_conf,
+		 uint16_t reta_size)
+{
+	uint16_t i;
+
+	for (i = 0; i < reta_size / RTE_ETH_RETA_GROUP_SIZE; i++)
+		reta_conf[i].mask = UINT64_MAX;
+
+	return rte_eth_dev_rss_reta_query(port_id, reta_conf, reta_size);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_dev_rx_queues_scale, 26.03)
+int
+rte_eth_dev_rx_queues_scale(uint16_t port_id, uint16_t nb_queues,
+			    rte_eth_queue_quiesce_fn quiesce, void *arg)
+{
+	struct rte_eth_rss_reta_entry64 reta_conf[RTE_ETH_RSS_RETA_SIZE_512 /
+						  RTE_ETH_RETA_GROUP_SIZE];
+	struct rte_eth_dev_info dev_info;
+	struct rte_eth_dev *dev;
+	uint16_t i, q;
+	int ret;
+
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, -ENODEV);
+	dev = &rte_eth_devices[port_id];
+
+	if (!dev->data->dev_started || nb_queues == 0 ||
+	    nb_queues > dev->data->nb_rx_queues || quiesce == NULL) {
+		RTE_ETHDEV_LOG_LINE(ERR,
+			"Cannot scale Rx queues of port_id=%u to %u queues",
+			port_id, nb_queues);
+		return -EINVAL;
+	}
+
+	ret = rte_eth_dev_info_get(port_id, &dev_info);
+	if (ret != 0)
+		return ret;
+
+	if (dev_info.reta_size == 0 ||
+	    dev_info.reta_size > RTE_ETH_RSS_RETA_SIZE_512 ||
+	    dev_info.reta_size % RTE_ETH_RETA_GROUP_SIZE != 0)
+		return -ENOTSUP;
+
+	/* Queues added first, so that they receive as soon as they are in the table. */
+	for (q = 0; q < nb_queues; q++) {
+		if (rte_eth_dev_is_rx_hairpin_queue(dev, q))
+			return -EINVAL;
+		ret = rte_eth_dev_rx_queue_start(port_id, q);
+		if (ret != 0)
+			return ret;
+	}
+
+	for (i = 0; i < dev_info.reta_size; i++) {
+		reta_conf[i / RTE_ETH_RETA_GROUP_SIZE].mask = UINT64_MAX;
+		reta_conf[i / RTE_ETH_RETA_GROUP_SIZE].reta[i % RTE_ETH_RETA_GROUP_SIZE] =
+			i % nb_queues;
+	}
+
+	ret = rte_eth_dev_rss_reta_update(port_id, reta_conf, dev_info.reta_size);
+	if (ret != 0)
+		return ret;
+
+	/* Queues removed last, once they do not receive anymore. */
+	for (q = nb_queues; q < dev->data->nb_rx_queues; q++) {
+		if (rte_eth_dev_is_rx_hairpin_queue(dev, q) ||
+		    dev->data->rx_queue_state[q] == RTE_ETH_QUEUE_STATE_STOPPED)
+			continue;
+
+		ret = eth_queue_quiesce(port_id, q, true, quiesce, arg);
+		if (ret != 0)
+			return ret;
+
+		ret = rte_eth_dev_rx_queue_stop(port_id, q);
+		if (ret != 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_rx_queue_resize, 26.03)
+int
+rte_eth_rx_queue_resize(uint16_t port_id, uint16_t rx_queue_id,
+			uint16_t nb_rx_desc,
+			const struct rte_eth_rxconf *rx_conf,
+			struct rte_mempool *mb_pool,
+			rte_eth_queue_quiesce_fn quiesce, void *arg)
+{
+	struct rte_eth_rss_reta_entry64 reta_conf[RTE_ETH_RSS_RETA_SIZE_512 /
+						  RTE_ETH_RETA_GROUP_SIZE];
+	struct rte_eth_rss_reta_entry64 new_conf[RTE_DIM(reta_conf)];
+	uint16_t others[RTE_ETH_RSS_RETA_SIZE_512];
+	struct rte_eth_dev_info dev_info;
+	uint16_t i, nb_others = 0, nb_moved = 0;
+	struct rte_eth_dev *dev;
+	int ret;
+
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, -ENODEV);
+	dev = &rte_eth_devices[port_id];
+
+	ret = eth_dev_validate_rx_queue(dev, rx_queue_id);
+	if (ret != 0)
+		return ret;
+
+	ret = rte_eth_dev_info_get(port_id, &dev_info);
+	if (ret != 0)
+		return ret;
+
+	if (!dev->data->dev_started)
+		return rte_eth_rx_queue_setup(port_id, rx_queue_id, nb_rx_desc,
+				rte_eth_dev_socket_id(port_id), rx_conf, mb_pool);
+
+	if (quiesce == NULL)
+		return -EINVAL;
+
+	if (!(dev_info.dev_capa & RTE_ETH_DEV_CAPA_RUNTIME_RX_QUEUE_SETUP))
+		return -ENOTSUP;
+
+	if (dev_info.reta_size == 0 ||
+	    dev_info.reta_size > RTE_ETH_RSS_RETA_SIZE_512 ||
+	    dev_info.reta_size % RTE_ETH_RETA_GROUP_SIZE != 0)
+		return -ENOTSUP;
+
+	ret = eth_dev_reta_get(port_id, reta_conf, dev_info.reta_size);
+	if (ret != 0)
+		return ret;
+
+	/* Move the entries of the queue to the other queues, round robin. */
+	memcpy(new_conf, reta_conf, sizeof(new_conf));
+	for (i = 0; i < dev_info.reta_size; i++) {
+		uint16_t q = reta_conf[i / RTE_ETH_RETA_GROUP_SIZE].reta[i % RTE_ETH_RETA_GROUP_SIZE];
+
+		if (q != rx_queue_id)
+			others[nb_others++] = q;
+	}
+
+	if (nb_others == 0)
+		return -EBUSY;
+
+	for (i = 0; i < dev_info.reta_size; i++) {
+		uint16_t *q = &new_conf[i / RTE_ETH_RETA_GROUP_SIZE].reta[i % RTE_ETH_RETA_GROUP_SIZE];
+
+		if (*q == rx_queue_id)
+			*q = others[nb_moved++ % nb_others];
+	}
+
+	if (nb_moved != 0) {
+		ret = rte_eth_dev_rss_reta_update(port_id, new_conf, dev_info.reta_size);
+		if (ret != 0)
+			return ret;
+	}
+
+	ret = eth_queue_quiesce(port_id, rx_queue_id, true, quiesce, arg);
+	if (ret != 0)
+		goto restore;
+
+	ret = rte_eth_dev_rx_queue_stop(port_id, rx_queue_id);
+	if (ret != 0)
+		goto restore;
+
+	ret = rte_eth_rx_queue_setup(port_id, rx_queue_id, nb_rx_desc,
+			rte_eth_dev_socket_id(port_id), rx_conf, mb_pool);
+	if (ret != 0) {
+		RTE_ETHDEV_LOG_LINE(ERR,
+			"Cannot set up Rx queue %u of port_id=%u with %u descriptors",
+			rx_queue_id, port_id, nb_rx_desc);
+		return ret;
+	}
+
+	ret = rte_eth_dev_rx_queue_start(port_id, rx_queue_id);
+	if (ret != 0)
+		return ret;
+
+restore:
+	if (nb_moved != 0) {
+		int err = rte_eth_dev_rss_reta_update(port_id, reta_conf,
+				dev_info.reta_size);
+
+		if (ret == 0)
+			ret = err;
+	}
+
+	return ret;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_tx_queue_resize, 26.03)
+int
+rte_eth_tx_queue_resize(uint16_t port_id, uint16_t tx_queue_id,
+			uint16_t nb_tx_desc,
+			const struct rte_eth_txconf *tx_conf,
+			rte_eth_queue_quiesce_fn quiesce, void *arg)
+{
+	struct rte_eth_dev_info dev_info;
+	struct rte_eth_dev *dev;
+	int ret;
+
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, -ENODEV);
+	dev = &rte_eth_devices[port_id];
+
+	ret = eth_dev_validate_tx_queue(dev, tx_queue_id);
+	if (ret != 0)
+		return ret;
+
+	ret = rte_eth_dev_info_get(port_id, &dev_info);
+	if (ret != 0)
+		return ret;
+
+	if (!dev->data->dev_started)
+		return rte_eth_tx_queue_setup(port_id, tx_queue_id, nb_tx_desc,
+				rte_eth_dev_socket_id(port_id), tx_conf);
+
+	if (quiesce == NULL)
+		return -EINVAL;
+
+	if (!(dev_info.dev_capa & RTE_ETH_DEV_CAPA_RUNTIME_TX_QUEUE_SETUP))
+		return -ENOTSUP;
+
+	ret = eth_queue_quiesce(port_id, tx_queue_id, false, quiesce, arg);
+	if (ret != 0)
+		return ret;
+
+	ret = rte_eth_dev_tx_queue_stop(port_id, tx_queue_id);
+	if (ret != 0)
+		return ret;
+
+	ret = rte_eth_tx_queue_setup(port_id, tx_queue_id, nb_tx_desc,
+			rte_eth_dev_socket_id(port_id), tx_conf);
+	if (ret != 0) {
+		RTE_ETHDEV_LOG_LINE(ERR,
+			"Cannot set up Tx queue %u of port_id=%u with %u descriptors",
+			tx_queue_id, port_id, nb_tx_desc);
+		return ret;
+	}
+
+	return rte_eth_dev_tx_queue_start(port_id, tx_queue_id);
+}
+
 RTE_EXPORT_SYMBOL(rte_eth_speed_bitflag)
 uint32_t
 rte_eth_speed_bitflag(uint32_t speed, int duplex)
@@ -3003,6 +3261,186 @@ rte_eth_tx_done_cleanup(uint16_t port_id, uint16_t queue_id, uint32_t free_cnt)
 	return ret;
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_tx_queue_doorbell_defer, 26.03)
+int
+rte_eth_tx_queue_doorbell_defer(uint16_t port_id, uint16_t queue_id, int on)
+{
+	struct rte_eth_dev *dev;
+
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, -ENODEV);
+	dev = &rte_eth_devices[port_id];
+
+	if (queue_id >= dev->data->nb_tx_queues) {
+		RTE_ETHDEV_LOG_LINE(ERR, "Invalid Tx queue_id=%u", queue_id);
+		return -EINVAL;
+	}
+
+	if (dev->dev_ops->tx_queue_doorbell_defer == NULL ||
+	    dev->tx_doorbell == NULL)
+		return -ENOTSUP;
+
+	return eth_err(port_id,
+		dev->dev_ops->tx_queue_doorbell_defer(dev, queue_id, !!on));
+}
+
+/*
+ * Tx batches of each lcore, polled by rte_eth_tx_batch_poll().
+ * The lock serializes the updates only: the lcore walks its list without it,
+ * so the list must not be updated while the lcore may walk it.
+ */
+static struct rte_eth_tx_batch *eth_tx_batches[RTE_MAX_LCORE];
+static rte_spinlock_t eth_tx_batches_lock = RTE_SPINLOCK_INITIALIZER;
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_tx_batch_create, 26.03)
+struct rte_eth_tx_batch *
+rte_eth_tx_batch_create(uint16_t port_id, uint16_t queue_id,
+		unsigned int lcore_id, uint16_t size, uint32_t timeout_us)
+{
+	struct rte_eth_tx_batch *batch, *b;
+	struct rte_eth_txq_info qinfo;
+	struct rte_eth_dev *dev;
+
+	if (!rte_eth_dev_is_valid_port(port_id)) {
+		RTE_ETHDEV_LOG_LINE(ERR, "Invalid port_id=%u", port_id);
+		rte_errno = ENODEV;
+		return NULL;
+	}
+	dev = &rte_eth_devices[port_id];
+
+	if (queue_id >= dev->data->nb_tx_queues || lcore_id >= RTE_MAX_LCORE ||
+	    size == 0) {
+		RTE_ETHDEV_LOG_LINE(ERR,
+			"Invalid Tx batch queue_id=%u, lcore_id=%u or size=%u",
+			queue_id, lcore_id, size);
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	batch = rte_zmalloc_socket("ethdev_tx_batch",
+			sizeof(*batch) + size * sizeof(batch->pkts[0]),
+			RTE_CACHE_LINE_SIZE, rte_eth_dev_socket_id(port_id));
+	if (batch == NULL) {
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	batch->port_id = port_id;
+	batch->queue_id = queue_id;
+	batch->size = size;
+	batch->timeout = (uint64_t)timeout_us * rte_get_tsc_hz() / US_PER_S;
+	batch->error_callback = rte_eth_tx_buffer_drop_callback;
+	batch->lcore_id = lcore_id;
+
+	rte_spinlock_lock(&eth_tx_batches_lock);
+
+	for (b = eth_tx_batches[lcore_id]; b != NULL; b = b->next) {
+		if (b->port_id == port_id && b->queue_id == queue_id) {
+			rte_spinlock_unlock(&eth_tx_batches_lock);
+			rte_free(batch);
+			rte_errno = EEXIST;
+			return NULL;
+		}
+	}
+
+	/*
+	 * The pending packets are in the Tx ring with the doorbell deferred,
+	 * in the descriptors left by the free and RS thresholds of the driver.
+	 */
+	if (rte_eth_tx_queue_info_get(port_id, queue_id, &qinfo) == 0 &&
+	    (uint32_t)size + qinfo.conf.tx_free_thresh +
+	    qinfo.conf.tx_rs_thresh < qinfo.nb_desc &&
+	    rte_eth_tx_queue_doorbell_defer(port_id, queue_id, 1) == 0)
+		batch->deferred = true;
+
+	batch->next = eth_tx_batches[lcore_id];
+	eth_tx_batches[lcore_id] = batch;
+
+	rte_spinlock_unlock(&eth_tx_batches_lock);
+
+	return batch;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_tx_batch_free, 26.03)
+void
+rte_eth_tx_batch_free(struct rte_eth_tx_batch *batch)
+{
+	struct rte_eth_tx_batch **b;
+
+	if (batch == NULL)
+		return;
+
+	rte_spinlock_lock(&eth_tx_batches_lock);
+	for (b = &eth_tx_batches[batch->lcore_id]; *b != NULL; b = &(*b)->next) {
+		if (*b == batch) {
+			*b = batch->next;
+			break;
+		}
+	}
+	rte_spinlock_unlock(&eth_tx_batches_lock);
+
+	rte_eth_tx_batch_flush(batch);
+	if (batch->deferred)
+		rte_eth_tx_queue_doorbell_defer(batch->port_id, batch->queue_id, 0);
+
+	rte_free(batch);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_tx_batch_set_err_callback, 26.03)
+int
+rte_eth_tx_batch_set_err_callback(struct rte_eth_tx_batch *batch,
+		buffer_tx_error_fn callback, void *userdata)
+{
+	if (batch == NULL || callback == NULL) {
+		RTE_ETHDEV_LOG_LINE(ERR,
+			"Cannot set Tx batch error callback to NULL");
+		return -EINVAL;
+	}
+
+	batch->error_callback = callback;
+	batch->error_userdata = userdata;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_tx_batch_lookup, 26.03)
+struct rte_eth_tx_batch *
+rte_eth_tx_batch_lookup(uint16_t port_id, uint16_t queue_id)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	struct rte_eth_tx_batch *batch;
+
+	if (lcore_id >= RTE_MAX_LCORE)
+		return NULL;
+
+	for (batch = eth_tx_batches[lcore_id]; batch != NULL; batch = batch->next)
+		if (batch->port_id == port_id && batch->queue_id == queue_id)
+			return batch;
+
+	return NULL;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_eth_tx_batch_poll, 26.03)
+uint32_t
+rte_eth_tx_batch_poll(void)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	struct rte_eth_tx_batch *batch;
+	uint32_t sent = 0;
+	uint64_t now;
+
+	if (lcore_id >= RTE_MAX_LCORE || eth_tx_batches[lcore_id] == NULL)
+		return 0;
+
+	now = rte_rdtsc();
+	for (batch = eth_tx_batches[lcore_id]; batch != NULL; batch = batch->next) {
+		if (batch->length != 0 && batch->timeout != 0 &&
+		    (int64_t)(now - batch->deadline) >= 0)
+			sent += rte_eth_tx_batch_flush(batch);
+	}
+
+	return sent;
+}
+
 RTE_EXPORT_SYMBOL(rte_eth_promiscuous_enable)
 int
 rte_eth_promiscuous_enable(uint16_t port_id)
@@ -157,6 +157,7 @@
 #endif
 
 #include <rte_cman.h>
+#include <rte_cycles.h>
 #include <rte_compat.h>
 #include <rte_log.h>
 #include <rte_interrupts.h>
@@ -1941,6 +1942,19 @@ struct __rte_cache_min_aligned rte_eth_recycle_rxq_info {
 	uint16_t refill_requirement;
 };
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this structure may change without prior notice.
+ *
+ * Ethernet device Tx queue identifier, used to feed the mbuf ring of one Rx
+ * queue from several Tx queues.
+ * @see rte_eth_recycle_mbufs_bulk()
+ */
+struct rte_eth_recycle_txq {
+	uint16_t port_id;  /**< Port identifying the transmit side. */
+	uint16_t queue_id; /**< Index of the transmit queue. */
+};
+
 /* Generic Burst mode flag definition, values can be ORed. */
 
 /**
@@ -2899,6 +2913,148 @@ int rte_eth_dev_tx_queue_start(uint16_t port_id, uint16_t tx_queue_id);
  */
 int rte_eth_dev_tx_queue_stop(uint16_t port_id, uint16_t tx_queue_id);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Function type called by the queue scaling and resizing functions
+ * before stopping a queue, once no traffic is steered to it anymore.
+ *
+ * The function must return only when no lcore polls the queue anymore.
+ * The lcore polling an Rx queue is expected to empty it first
+ * with its own calls to rte_eth_rx_burst(), from the datapath.
+ *
+ * @param port_id
+ *   The port identifier of the Ethernet device.
+ * @param queue_id
+ *   The index of the queue to stop polling.
+ * @param arg
+ *   The argument given to the scaling or resizing function.
+ * @return
+ *   0 if the queue is not polled anymore, a negative value to abort.
+ */
+typedef int (*rte_eth_queue_quiesce_fn)(uint16_t port_id, uint16_t queue_id,
+		void *arg);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Change the number of Rx queues receiving the RSS traffic of a started port,
+ * without stopping the port.
+ *
+ * The port must be configured in RSS mode with the maximum number of Rx
+ * queues, all of them set up, the unused ones with rx_deferred_start.
+ * The function starts the queues [0, nb_queues - 1], spreads the RSS
+ * redirection table over them with a single update, then for each other
+ * started queue calls *quiesce* and stops the queue.
+ *
+ * The application may poll the added queues as soon as the function
+ * is called. It must keep polling a removed queue until *quiesce*
+ * is called for it, so that no packet is dropped.
+ *
+ * @param port_id
+ *   The port identifier of the Ethernet device.
+ * @param nb_queues
+ *   The number of Rx queues receiving traffic, in [1, nb_rx_queues].
+ * @param quiesce
+ *   The function returning once a removed queue is not polled anymore.
+ * @param arg
+ *   The argument passed to *quiesce*.
+ * @return
+ *   - 0: Success.
+ *   - -ENODEV: if *port_id* is invalid.
+ *   - -EINVAL: invalid *nb_queues* or *quiesce*, or the port is not started.
+ *   - -ENOTSUP: RSS redirection table update or queue start/stop not supported.
+ *   - Other negative values: error returned by *quiesce*,
+ *     the queue is left started.
+ */
+__rte_experimental
+int rte_eth_dev_rx_queues_scale(uint16_t port_id, uint16_t nb_queues,
+				rte_eth_queue_quiesce_fn quiesce, void *arg);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Change the number of descriptors of an Rx queue of a started port,
+ * without dropping its traffic.
+ *
+ * The device must support RTE_ETH_DEV_CAPA_RUNTIME_RX_QUEUE_SETUP.
+ * The RSS redirection table entries of the queue are first moved to
+ * the other queues, then *quiesce* is called, and the queue is stopped,
+ * set up again and started. The redirection table is restored last.
+ *
+ * The application must keep polling the queue until *quiesce* is called,
+ * and may poll it again once the function returns.
+ *
+ * @param port_id
+ *   The port identifier of the Ethernet device.
+ * @param rx_queue_id
+ *   The index of the Rx queue.
+ * @param nb_rx_desc
+ *   The new number of receive descriptors.
+ * @param rx_conf
+ *   The queue configuration, as for rte_eth_rx_queue_setup().
+ * @param mb_pool
+ *   The mempool of the queue, as for rte_eth_rx_queue_setup().
+ * @param quiesce
+ *   The function returning once the queue is not polled anymore.
+ *   Not called if the port is stopped.
+ * @param arg
+ *   The argument passed to *quiesce*.
+ * @return
+ *   - 0: Success.
+ *   - -EINVAL: the port is started and *quiesce* is NULL.
+ *   - -EBUSY: the queue is the only destination of the RSS traffic.
+ *   - Other negative values: error returned by *quiesce*, the queue
+ *     is left unchanged, or errors of rte_eth_rx_queue_setup().
+ */
+__rte_experimental
+int rte_eth_rx_queue_resize(uint16_t port_id, uint16_t rx_queue_id,
+			    uint16_t nb_rx_desc,
+			    const struct rte_eth_rxconf *rx_conf,
+			    struct rte_mempool *mb_pool,
+			    rte_eth_queue_quiesce_fn quiesce, void *arg);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Change the number of descriptors of a Tx queue of a started port.
+ *
+ * The device must support RTE_ETH_DEV_CAPA_RUNTIME_TX_QUEUE_SETUP.
+ * The function calls *quiesce*, then stops, sets up and restarts the queue.
+ * The packets not sent yet when the queue is stopped are freed.
+ *
+ * The application may transmit on the queue until *quiesce* is called,
+ * and again once the function returns.
+ *
+ * @param port_id
+ *   The port identifier of the Ethernet device.
+ * @param tx_queue_id
+ *   The index of the Tx queue.
+ * @param nb_tx_desc
+ *   The new number of transmit descriptors.
+ * @param tx_conf
+ *   The queue configuration, as for rte_eth_tx_queue_setup().
+ * @param quiesce
+ *   The function returning once no lcore transmits on the queue anymore.
+ *   Not called if the port is stopped.
+ * @param arg
+ *   The argument passed to *quiesce*.
+ * @return
+ *   - 0: Success.
+ *   - -EINVAL: the port is started and *quiesce* is NULL.
+ *   - Other negative values: error returned by *quiesce*, the queue
+ *     is left unchanged, or errors of rte_eth_tx_queue_setup().
+ */
+__rte_experimental
+int rte_eth_tx_queue_resize(uint16_t port_id, uint16_t tx_queue_id,
+			    uint16_t nb_tx_desc,
+			    const struct rte_eth_txconf *tx_conf,
+			    rte_eth_queue_quiesce_fn quiesce, void *arg);
+
 /**
  * Start an Ethernet device.
  *
@@ -4025,6 +4181,167 @@ void
 rte_eth_tx_buffer_count_callback(struct rte_mbuf **pkts, uint16_t unsent,
 		void *userdata);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Enable or disable the deferral of the Tx doorbell of a queue.
+ *
+ * With the doorbell deferred, rte_eth_tx_burst() writes the Tx descriptors
+ * but does not notify the hardware, saving the MMIO write of each burst.
+ * The packets are only transmitted after a call to rte_eth_tx_doorbell().
+ * When disabling the deferral, the driver rings the doorbell of the
+ * descriptors already written.
+ *
+ * This function must not be called while packets are transmitted on the queue.
+ *
+ * @param port_id
+ *   The port identifier of the Ethernet device.
+ * @param queue_id
+ *   The index of the transmit queue.
+ * @param on
+ *   1 to defer the doorbell, 0 to ring it in each rte_eth_tx_burst().
+ * @return
+ *   - (0) if successful.
+ *   - (-ENOTSUP) if the driver does not support doorbell deferral.
+ *   - (-ENODEV) if *port_id* is invalid.
+ *   - (-EINVAL) if *queue_id* is invalid.
+ */
+__rte_experimental
+int
+rte_eth_tx_queue_doorbell_defer(uint16_t port_id, uint16_t queue_id, int on);
+
+/**
+ * Structure used to coalesce the packets transmitted on a Tx queue
+ * by several callers running on the same lcore.
+ * Used by the rte_eth_tx_batch_*() APIs.
+ *
+ * Unlike rte_eth_dev_tx_buffer, the packets are also flushed when the oldest
+ * one has been pending for longer than a timeout, from rte_eth_tx_batch_poll().
+ * When the driver supports doorbell deferral, the packets are written to the
+ * Tx ring immediately and only the doorbell is batched.
+ */
+struct rte_eth_tx_batch {
+	uint16_t port_id;   /**< Port of the Tx queue. */
+	uint16_t queue_id;  /**< Tx queue. */
+	uint16_t size;      /**< Packets pending before a flush. */
+	uint16_t length;    /**< Packets pending. */
+	bool deferred;      /**< Packets in the Tx ring, doorbell deferred. */
+	uint64_t timeout;   /**< Flush timeout in TSC cycles, 0 for none. */
+	uint64_t deadline;  /**< TSC flush deadline of the pending packets. */
+	buffer_tx_error_fn error_callback; /**< Called for the unsent packets. */
+	void *error_userdata;
+	unsigned int lcore_id;           /**< Lcore using the batch. */
+	struct rte_eth_tx_batch *next;   /**< Next batch of the lcore. */
+	/** Pending packets, when the doorbell is not deferred. */
+	struct rte_mbuf *pkts[];
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Create the Tx batch of a queue for a lcore.
+ *
+ * The doorbell deferral of the queue is enabled if supported by the driver,
+ * and if *size* packets fit in the Tx ring besides the descriptors kept by
+ * the tx_free_thresh and tx_rs_thresh of the queue.
+ * All the packets sent on the queue must then go through the batch.
+ *
+ * The Tx batches of a lcore are not protected against concurrent access:
+ * this function must not be called while the lcore *lcore_id* may call
+ * rte_eth_tx_batch_lookup() or rte_eth_tx_batch_poll().
+ * The unsent packets are freed, unless another error callback is set with
+ * rte_eth_tx_batch_set_err_callback().
+ *
+ * @param port_id
+ *   The port identifier of the Ethernet device.
+ * @param queue_id
+ *   The index of the transmit queue.
+ * @param lcore_id
+ *   The lcore transmitting on the queue.
+ * @param size
+ *   Number of pending packets triggering a flush.
+ * @param timeout_us
+ *   Maximum time a packet may stay pending before rte_eth_tx_batch_poll()
+ *   flushes it, in microseconds. 0 to flush on size or explicitly only.
+ * @return
+ *   The batch on success, NULL otherwise and rte_errno is set.
+ */
+__rte_experimental
+struct rte_eth_tx_batch *
+rte_eth_tx_batch_create(uint16_t port_id, uint16_t queue_id,
+		unsigned int lcore_id, uint16_t size, uint32_t timeout_us);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Flush and free a Tx batch, and restore the doorbell of its queue.
+ *
+ * The batch must not be in use by its lcore, which must not call
+ * rte_eth_tx_batch_lookup() or rte_eth_tx_batch_poll() during the call.
+ *
+ * @param batch
+ *   Tx batch, may be NULL.
+ */
+__rte_experimental
+void
+rte_eth_tx_batch_free(struct rte_eth_tx_batch *batch);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Set the callback called for the packets a Tx batch failed to send.
+ *
+ * @param batch
+ *   Tx batch.
+ * @param callback
+ *   The function called with the unsent packets, which it must free.
+ * @param userdata
+ *   Arbitrary parameter passed to the callback.
+ * @return
+ *   0 on success, -EINVAL otherwise.
+ */
+__rte_experimental
+int
+rte_eth_tx_batch_set_err_callback(struct rte_eth_tx_batch *batch,
+		buffer_tx_error_fn callback, void *userdata);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Find the Tx batch of the calling lcore for a queue,
+ * so that independent callers share the same batch.
+ *
+ * @param port_id
+ *   The port identifier of the Ethernet device.
+ * @param queue_id
+ *   The index of the transmit queue.
+ * @return
+ *   The batch, or NULL if the lcore has no batch for this queue.
+ */
+__rte_experimental
+struct rte_eth_tx_batch *
+rte_eth_tx_batch_lookup(uint16_t port_id, uint16_t queue_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Flush the Tx batches of the calling lcore whose timeout has expired.
+ *
+ * To be called regularly by the lcore, e.g. at the end of each polling loop.
+ *
+ * @return
+ *   The number of packets transmitted.
+ */
+__rte_experimental
+uint32_t
+rte_eth_tx_batch_poll(void);
+
 /**
  * Request the driver to free mbufs currently cached by the driver. The
  * driver will only free the mbuf if it is no longer in use. It is the
@@ -6378,7 +6695,8 @@ rte_eth_rx_burst(uint16_t port_id, uint16_t queue_id,
 
 	nb_rx = p->rx_pkt_burst(qd, rx_pkts, nb_pkts);
 
-	rte_mbuf_history_mark_bulk(rx_pkts, nb_rx, RTE_MBUF_HISTORY_OP_RX);
+	rte_mbuf_history_mark_bulk_ctx(rx_pkts, nb_rx, RTE_MBUF_HISTORY_OP_RX,
+			RTE_MBUF_HISTORY_CTX_QUEUE(port_id, queue_id));
 
 #ifdef RTE_ETHDEV_RXTX_CALLBACKS
 	{
@@ -6451,6 +6769,160 @@ rte_eth_rx_queue_count(uint16_t port_id, uint16_t queue_id)
 	return p->rx_queue_count(qd);
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Get a hint of the number of received packets pending in a Rx queue.
+ *
+ * Unlike rte_eth_rx_queue_count(), this function does not scan the Rx ring:
+ * the PMD only checks a few descriptors at increasing distances from the
+ * current receive position, so the returned value is a lower bound of the
+ * number of pending packets with a granularity chosen by the PMD.
+ * It is cheap enough to be called before each rte_eth_rx_burst(),
+ * e.g. to size the next burst, see rte_eth_rx_burst_adaptive().
+ *
+ * Since it's a dataplane function, no check is performed on port_id and
+ * queue_id. The caller must therefore ensure that the port is enabled
+ * and the queue is configured and running.
+ *
+ * @param port_id
+ *  The port identifier of the Ethernet device.
+ * @param queue_id
+ *  The queue ID on the specific port.
+ * @return
+ *  A lower bound of the number of received packets pending, or:
+ *   - (-ENODEV) if *port_id* is invalid.
+ *   - (-EINVAL) if *queue_id* is invalid
+ *   - (-ENOTSUP) if the device does not support this function
+ */
+__rte_experimental
+static inline int
+rte_eth_rx_queue_pending(uint16_t port_id, uint16_t queue_id)
+{
+	struct rte_eth_fp_ops *p;
+	void *qd;
+
+#ifdef RTE_ETHDEV_DEBUG_RX
+	if (port_id >= RTE_MAX_ETHPORTS ||
+			queue_id >= RTE_MAX_QUEUES_PER_PORT) {
+		RTE_ETHDEV_LOG_LINE(ERR,
+			"Invalid port_id=%u or queue_id=%u",
+			port_id, queue_id);
+		return -EINVAL;
+	}
+#endif
+
+	/* fetch pointer to queue data */
+	p = &rte_eth_fp_ops[port_id];
+	qd = p->rxq.data[queue_id];
+
+#ifdef RTE_ETHDEV_DEBUG_RX
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, -ENODEV);
+	if (qd == NULL)
+		return -EINVAL;
+#endif
+
+	if (p->rx_queue_pending == NULL)
+		return -ENOTSUP;
+
+	return p->rx_queue_pending(qd);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this structure may change without prior notice.
+ *
+ * Per Rx queue state of the adaptive burst size selection.
+ * @see rte_eth_rx_burst_adaptive()
+ */
+struct rte_eth_rx_burst_adapt {
+	uint16_t min_burst; /**< Smallest burst size. */
+	uint16_t max_burst; /**< Largest burst size. */
+	uint16_t cur_burst; /**< Burst size used when no hint is available. */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Initialize the adaptive burst size selection state of a Rx queue.
+ *
+ * @param adapt
+ *   Adaptive burst state.
+ * @param min_burst
+ *   Smallest burst size, used at low load to minimize latency. Must be a
+ *   power of 2, no smaller than the minimal burst size of the PMD Rx path.
+ * @param max_burst
+ *   Largest burst size, used at high load to maximize throughput. Must be a
+ *   power of 2, no smaller than *min_burst*.
+ */
+__rte_experimental
+static inline void
+rte_eth_rx_burst_adapt_init(struct rte_eth_rx_burst_adapt *adapt,
+		uint16_t min_burst, uint16_t max_burst)
+{
+	adapt->min_burst = min_burst;
+	adapt->max_burst = max_burst;
+	adapt->cur_burst = min_burst;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Receive a burst of packets, with a burst size picked from the Rx queue
+ * occupancy.
+ *
+ * When the PMD supports rte_eth_rx_queue_pending(), the burst size is the
+ * pending packets hint rounded up to a power of 2. Otherwise, the burst size
+ * is doubled after each full burst and halved after each burst less than
+ * half full. In both cases, it is kept within the bounds of *adapt*.
+ *
+ * Same constraints as rte_eth_rx_burst(), the *rx_pkts* array must be able
+ * to hold *adapt->max_burst* pointers.
+ *
+ * @param port_id
+ *   The port identifier of the Ethernet device.
+ * @param queue_id
+ *   The index of the receive queue on the specific port.
+ * @param rx_pkts
+ *   The address of an array of at least *adapt->max_burst* pointers to
+ *   *rte_mbuf* structures.
+ * @param adapt
+ *   Adaptive burst state of the Rx queue,
+ *   initialized with rte_eth_rx_burst_adapt_init().
+ * @return
+ *   The number of packets actually retrieved.
+ */
+__rte_experimental
+static inline uint16_t
+rte_eth_rx_burst_adaptive(uint16_t port_id, uint16_t queue_id,
+		struct rte_mbuf **rx_pkts, struct rte_eth_rx_burst_adapt *adapt)
+{
+	uint16_t burst, nb_rx;
+	int pending;
+
+	pending = rte_eth_rx_queue_pending(port_id, queue_id);
+	if (pending >= 0) {
+		burst = (uint16_t)RTE_MIN((uint32_t)adapt->max_burst,
+				RTE_MAX((uint32_t)adapt->min_burst,
+					rte_align32pow2((uint32_t)pending)));
+
+		return rte_eth_rx_burst(port_id, queue_id, rx_pkts, burst);
+	}
+
+	burst = adapt->cur_burst;
+	nb_rx = rte_eth_rx_burst(port_id, queue_id, rx_pkts, burst);
+
+	if (nb_rx == burst && burst < adapt->max_burst)
+		adapt->cur_burst = burst << 1;
+	else if (nb_rx < (burst >> 1) && burst > adapt->min_burst)
+		adapt->cur_burst = burst >> 1;
+
+	return nb_rx;
+}
+
 /**@{@name Rx hardware descriptor states
  * @see rte_eth_rx_descriptor_status
  */
@@ -6733,13 +7205,15 @@ rte_eth_tx_burst(uint16_t port_id, uint16_t queue_id,
 #endif
 
 	uint16_t requested_pkts = nb_pkts;
-	rte_mbuf_history_mark_bulk(tx_pkts, nb_pkts, RTE_MBUF_HISTORY_OP_TX);
+	rte_mbuf_history_mark_bulk_ctx(tx_pkts, nb_pkts, RTE_MBUF_HISTORY_OP_TX,
+			RTE_MBUF_HISTORY_CTX_QUEUE(port_id, queue_id));
 
 	nb_pkts = p->tx_pkt_burst(qd, tx_pkts, nb_pkts);
 
 	if (requested_pkts > nb_pkts)
-		rte_mbuf_history_mark_bulk(tx_pkts + nb_pkts,
-				requested_pkts - nb_pkts, RTE_MBUF_HISTORY_OP_TX_BUSY);
+		rte_mbuf_history_mark_bulk_ctx(tx_pkts + nb_pkts,
+				requested_pkts - nb_pkts, RTE_MBUF_HISTORY_OP_TX_BUSY,
+				RTE_MBUF_HISTORY_CTX_QUEUE(port_id, queue_id));
 
 	rte_ethdev_trace_tx_burst(port_id, queue_id, (void **)tx_pkts, nb_pkts);
 	return nb_pkts;
@@ -6836,7 +7310,8 @@ rte_eth_tx_prepare(uint16_t port_id, uint16_t queue_id,
 	}
 #endif
 
-	rte_mbuf_history_mark_bulk(tx_pkts, nb_pkts, RTE_MBUF_HISTORY_OP_TX_PREP);
+	rte_mbuf_history_mark_bulk_ctx(tx_pkts, nb_pkts, RTE_MBUF_HISTORY_OP_TX_PREP,
+			RTE_MBUF_HISTORY_CTX_QUEUE(port_id, queue_id));
 
 	return p->tx_pkt_prepare(qd, tx_pkts, nb_pkts);
 }
@@ -6948,6 +7423,172 @@ rte_eth_tx_buffer(uint16_t port_id, uint16_t queue_id,
 	return rte_eth_tx_buffer_flush(port_id, queue_id, buffer);
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Notify the hardware of the descriptors written by rte_eth_tx_burst()
+ * on a queue with the doorbell deferred by rte_eth_tx_queue_doorbell_defer().
+ *
+ * @param port_id
+ *   The port identifier of the Ethernet device.
+ * @param queue_id
+ *   The index of the transmit queue.
+ *   The value must be in the range [0, nb_tx_queue - 1] previously supplied
+ *   to rte_eth_dev_configure().
+ * @return
+ *   - (0) if successful.
+ *   - (-ENOTSUP) if the device does not support doorbell deferral.
+ *   - (-ENODEV) if *port_id* is invalid. Enabled only when RTE_ETHDEV_DEBUG_TX is enabled.
+ *   - (-EINVAL) if *queue_id* is invalid. Enabled only when RTE_ETHDEV_DEBUG_TX is enabled.
+ */
+__rte_experimental
+static inline int
+rte_eth_tx_doorbell(uint16_t port_id, uint16_t queue_id)
+{
+	struct rte_eth_fp_ops *p;
+	void *qd;
+
+#ifdef RTE_ETHDEV_DEBUG_TX
+	if (port_id >= RTE_MAX_ETHPORTS ||
+			queue_id >= RTE_MAX_QUEUES_PER_PORT) {
+		RTE_ETHDEV_LOG_LINE(ERR,
+			"Invalid port_id=%u or queue_id=%u",
+			port_id, queue_id);
+		return -EINVAL;
+	}
+#endif
+
+	p = &rte_eth_fp_ops[port_id];
+	qd = p->txq.data[queue_id];
+
+#ifdef RTE_ETHDEV_DEBUG_TX
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, -ENODEV);
+
+	if (qd == NULL) {
+		RTE_ETHDEV_LOG_LINE(ERR, "Invalid Tx queue_id=%u for port_id=%u",
+			queue_id, port_id);
+		return -EINVAL;
+	}
+#endif
+
+	if (p->tx_doorbell == NULL)
+		return -ENOTSUP;
+
+	p->tx_doorbell(qd);
+
+	return 0;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Transmit the pending packets of a Tx batch.
+ *
+ * @param batch
+ *   Tx batch, used by the calling lcore only.
+ * @return
+ *   The number of packets transmitted. The error callback is called
+ *   for the packets which could not be sent.
+ */
+__rte_experimental
+static inline uint16_t
+rte_eth_tx_batch_flush(struct rte_eth_tx_batch *batch)
+{
+	uint16_t to_send = batch->length;
+	uint16_t sent;
+
+	if (to_send == 0)
+		return 0;
+
+	batch->length = 0;
+
+	/* Packets already in the Tx ring, only notify the hardware. */
+	if (batch->deferred) {
+		rte_eth_tx_doorbell(batch->port_id, batch->queue_id);
+		return to_send;
+	}
+
+	sent = rte_eth_tx_burst(batch->port_id, batch->queue_id,
+			batch->pkts, to_send);
+	if (unlikely(sent != to_send))
+		batch->error_callback(&batch->pkts[sent],
+				(uint16_t)(to_send - sent), batch->error_userdata);
+
+	return sent;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Add packets to a Tx batch.
+ *
+ * The batch is flushed each time the number of pending packets reaches
+ * its size. The remaining packets are flushed by rte_eth_tx_batch_flush(),
+ * or by rte_eth_tx_batch_poll() once their timeout has expired.
+ *
+ * @param batch
+ *   Tx batch, used by the calling lcore only.
+ * @param tx_pkts
+ *   The packets to send. All of them are consumed: the packets which
+ *   can not be sent are passed to the error callback.
+ * @param nb_pkts
+ *   The number of packets to send.
+ * @return
+ *   The number of packets transmitted by the flushes triggered by this call.
+ */
+__rte_experimental
+static inline uint16_t
+rte_eth_tx_batch(struct rte_eth_tx_batch *batch,
+		struct rte_mbuf **tx_pkts, uint16_t nb_pkts)
+{
+	uint16_t sent = 0;
+	uint16_t n, i, k;
+
+	while (nb_pkts != 0) {
+		if (batch->length == 0 && batch->timeout != 0)
+			batch->deadline = rte_rdtsc() + batch->timeout;
+
+		n = RTE_MIN(nb_pkts, (uint16_t)(batch->size - batch->length));
+
+		if (batch->deferred) {
+			i = rte_eth_tx_burst(batch->port_id, batch->queue_id,
+					tx_pkts, n);
+			batch->length += i;
+			if (unlikely(i != n)) {
+				/* Tx ring full: ring the doorbell for the hardware
+				 * to complete descriptors, and retry once.
+				 */
+				sent += rte_eth_tx_batch_flush(batch);
+				if (batch->timeout != 0)
+					batch->deadline = rte_rdtsc() + batch->timeout;
+				k = rte_eth_tx_burst(batch->port_id, batch->queue_id,
+						&tx_pkts[i], (uint16_t)(n - i));
+				batch->length += k;
+				i += k;
+				if (unlikely(i != n))
+					batch->error_callback(&tx_pkts[i],
+							(uint16_t)(n - i),
+							batch->error_userdata);
+			}
+		} else {
+			for (i = 0; i < n; i++)
+				batch->pkts[batch->length + i] = tx_pkts[i];
+			batch->length += n;
+		}
+
+		tx_pkts += n;
+		nb_pkts -= n;
+
+		if (batch->length == batch->size)
+			sent += rte_eth_tx_batch_flush(batch);
+	}
+
+	return sent;
+}
+
 /**
  * @warning
  * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
@@ -6979,8 +7620,9 @@ rte_eth_tx_buffer(uint16_t port_id, uint16_t queue_id,
  * function to retrieve selected Rx queue information.
  * @see rte_eth_recycle_rxq_info_get, struct rte_eth_recycle_rxq_info
  *
- * Currently, the rte_eth_recycle_mbufs() function can support to feed 1 Rx queue from
- * 2 Tx queues in the same thread. Do not pair the Rx queue and Tx queue in different
+ * The same Rx queue can be fed from several Tx queues, possibly of different
+ * ports, as long as all of them are handled in the same thread, see
+ * rte_eth_recycle_mbufs_bulk(). Do not pair the Rx queue and Tx queue in different
  * threads, in order to avoid memory error rewriting.
  *
  * @param rx_port_id
@@ -7075,6 +7717,117 @@ rte_eth_recycle_mbufs(uint16_t rx_port_id, uint16_t rx_queue_id,
 	return nb_mbufs;
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice
+ *
+ * Recycle used mbufs from several transmit queues into the mbuf ring of a
+ * single receive queue.
+ *
+ * This is the many-to-one version of rte_eth_recycle_mbufs(): typically used
+ * by a forwarding thread that polls one Rx queue and transmits to several
+ * ports, so that the mbufs released by all the Tx queues go straight back to
+ * the Rx queue instead of making a round trip through the mempool. The Tx
+ * queues are visited in order and each one refills the Rx descriptors before
+ * the next one is visited, so the Rx queue may be refilled several times per
+ * call. Each Tx queue is visited at most once per call.
+ *
+ * All the Tx queues and the Rx queue must be handled by the calling thread.
+ * The Rx queue information must be retrieved beforehand with
+ * rte_eth_recycle_rx_queue_info_get().
+ *
+ * @param rx_port_id
+ *   Port identifying the receive side.
+ * @param rx_queue_id
+ *   The index of the receive queue identifying the receive side.
+ *   The value must be in the range [0, nb_rx_queue - 1] previously supplied
+ *   to rte_eth_dev_configure().
+ * @param txqs
+ *   Array of *nb_txqs* transmit queues identifying the transmit side.
+ * @param nb_txqs
+ *   Number of elements in the *txqs* array.
+ * @param recycle_rxq_info
+ *   A pointer to a structure of type *rte_eth_recycle_rxq_info* which contains
+ *   the information of the Rx queue mbuf ring.
+ * @return
+ *   The total number of recycled mbufs.
+ */
+__rte_experimental
+static inline uint16_t
+rte_eth_recycle_mbufs_bulk(uint16_t rx_port_id, uint16_t rx_queue_id,
+		const struct rte_eth_recycle_txq *txqs, uint16_t nb_txqs,
+		struct rte_eth_recycle_rxq_info *recycle_rxq_info)
+{
+	struct rte_eth_fp_ops *p1, *p2;
+	void *qd1, *qd2;
+	uint16_t nb_mbufs, nb_total = 0, i;
+
+#ifdef RTE_ETHDEV_DEBUG_RX
+	if (rx_port_id >= RTE_MAX_ETHPORTS ||
+			rx_queue_id >= RTE_MAX_QUEUES_PER_PORT) {
+		RTE_ETHDEV_LOG_LINE(ERR, "Invalid rx_port_id=%u or rx_queue_id=%u",
+				rx_port_id, rx_queue_id);
+		return 0;
+	}
+#endif
+
+	/* fetch pointer to Rx queue data */
+	p2 = &rte_eth_fp_ops[rx_port_id];
+	qd2 = p2->rxq.data[rx_queue_id];
+
+#ifdef RTE_ETHDEV_DEBUG_RX
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(rx_port_id, 0);
+
+	if (qd2 == NULL) {
+		RTE_ETHDEV_LOG_LINE(ERR, "Invalid Rx queue_id=%u for port_id=%u",
+				rx_queue_id, rx_port_id);
+		return 0;
+	}
+#endif
+
+	for (i = 0; i < nb_txqs; i++) {
+		uint16_t tx_port_id = txqs[i].port_id;
+		uint16_t tx_queue_id = txqs[i].queue_id;
+
+#ifdef RTE_ETHDEV_DEBUG_TX
+		if (tx_port_id >= RTE_MAX_ETHPORTS ||
+				tx_queue_id >= RTE_MAX_QUEUES_PER_PORT) {
+			RTE_ETHDEV_LOG_LINE(ERR,
+					"Invalid tx_port_id=%u or tx_queue_id=%u",
+					tx_port_id, tx_queue_id);
+			continue;
+		}
+#endif
+
+		/* fetch pointer to Tx queue data */
+		p1 = &rte_eth_fp_ops[tx_port_id];
+		qd1 = p1->txq.data[tx_queue_id];
+
+#ifdef RTE_ETHDEV_DEBUG_TX
+		if (!rte_eth_dev_is_valid_port(tx_port_id) || qd1 == NULL) {
+			RTE_ETHDEV_LOG_LINE(ERR, "Invalid Tx queue_id=%u for port_id=%u",
+					tx_queue_id, tx_port_id);
+			continue;
+		}
+#endif
+
+		/* Copy used *rte_mbuf* buffer pointers from Tx mbuf ring
+		 * into Rx mbuf ring.
+		 */
+		nb_mbufs = p1->recycle_tx_mbufs_reuse(qd1, recycle_rxq_info);
+		if (nb_mbufs == 0)
+			continue;
+
+		/* Replenish the Rx descriptors before the next Tx queue reads
+		 * the Rx refill head.
+		 */
+		p2->recycle_rx_descriptors_refill(qd2, nb_mbufs);
+		nb_total += nb_mbufs;
+	}
+
+	return nb_total;
+}
+
 /**
  * @warning
  * @b EXPERIMENTAL: this API may change without prior notice
@@ -63,6 +63,9 @@ typedef uint16_t (*eth_recycle_tx_mbufs_reuse_t)(void *txq,
 /** @internal Refill Rx descriptors with the recycling mbufs */
 typedef void (*eth_recycle_rx_descriptors_refill_t)(void *rxq, uint16_t nb);
 
+/** @internal Notify the hardware of the Tx descriptors written with doorbell deferred */
+typedef void (*eth_tx_doorbell_t)(void *txq);
+
 /**
  * @internal
  * Structure used to hold opaque pointers to internal ethdev Rx/Tx
@@ -101,7 +104,9 @@ struct __rte_cache_aligned rte_eth_fp_ops {
 	eth_rx_descriptor_status_t rx_descriptor_status;
 	/** Refill Rx descriptors with the recycling mbufs. */
 	eth_recycle_rx_descriptors_refill_t recycle_rx_descriptors_refill;
-	uintptr_t reserved1[2];
+	/** Get a hint of the number of received packets pending. */
+	eth_rx_queue_count_t rx_queue_pending;
+	uintptr_t reserved1[1];
 	/**@}*/
 
 	/**@{*/
@@ -121,7 +126,8 @@ struct __rte_cache_aligned rte_eth_fp_ops {
 	eth_recycle_tx_mbufs_reuse_t recycle_tx_mbufs_reuse;
 	/** Get the number of used Tx descriptors. */
 	eth_tx_queue_count_t tx_queue_count;
-	uintptr_t reserved2[1];
+	/** Ring the Tx doorbell deferred by rte_eth_tx_queue_doorbell_defer(). */
+	eth_tx_doorbell_t tx_doorbell;
 	/**@}*/
 
 };
@@ -13,6 +13,8 @@
 #include <rte_common.h>
 #include <rte_errno.h>
 #include <rte_branch_prediction.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
 #include <rte_string_fns.h>
 #include <rte_mbuf_dyn.h>
 #include "rte_flow_driver.h"
@@ -2324,6 +2326,235 @@ rte_flow_pull(uint16_t port_id,
 	return ret;
 }
 
+struct rte_flow_async_batch {
+	uint16_t port_id;
+	uint32_t queue_id;
+	uint32_t queue_size;
+	uint32_t push_threshold;
+	uint16_t pull_burst;
+	rte_flow_async_batch_cb_t cb;
+	void *cb_arg;
+
+	/* Operations enqueued, but not pushed yet. */
+	uint32_t n_postponed;
+
+	/* Operations enqueued, but not completed yet. */
+	uint32_t n_inflight;
+
+	struct rte_flow_op_result res[];
+};
+
+static const struct rte_flow_op_attr flow_async_batch_op_attr = {
+	.postpone = 1,
+};
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_flow_async_batch_create, 26.03)
+struct rte_flow_async_batch *
+rte_flow_async_batch_create(uint16_t port_id,
+			    const struct rte_flow_async_batch_conf *conf,
+			    int socket_id)
+{
+	struct rte_flow_async_batch *batch;
+	uint32_t queue_id;
+
+	if (!rte_eth_dev_is_valid_port(port_id) ||
+	    conf == NULL ||
+	    !conf->queue_size ||
+	    !conf->push_threshold ||
+	    conf->push_threshold > conf->queue_size ||
+	    !conf->pull_burst) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	queue_id = conf->queue_id;
+	if (queue_id == RTE_FLOW_ASYNC_BATCH_QUEUE_LCORE) {
+		int lcore_index = rte_lcore_index(-1);
+
+		if (lcore_index < 0) {
+			rte_errno = EINVAL;
+			return NULL;
+		}
+
+		queue_id = (uint32_t)lcore_index;
+	}
+
+	batch = rte_zmalloc_socket("rte_flow_async_batch",
+				   sizeof(*batch) + conf->pull_burst * sizeof(batch->res[0]),
+				   RTE_CACHE_LINE_SIZE,
+				   socket_id);
+	if (batch == NULL) {
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	batch->port_id = port_id;
+	batch->queue_id = queue_id;
+	batch->queue_size = conf->queue_size;
+	batch->push_threshold = conf->push_threshold;
+	batch->pull_burst = conf->pull_burst;
+	batch->cb = conf->cb;
+	batch->cb_arg = conf->cb_arg;
+
+	return batch;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_flow_async_batch_free, 26.03)
+void
+rte_flow_async_batch_free(struct rte_flow_async_batch *batch)
+{
+	rte_free(batch);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_flow_async_batch_push, 26.03)
+int
+rte_flow_async_batch_push(struct rte_flow_async_batch *batch,
+			  struct rte_flow_error *error)
+{
+	int ret;
+
+	if (!batch->n_postponed)
+		return 0;
+
+	ret = rte_flow_push(batch->port_id, batch->queue_id, error);
+	if (ret)
+		return flow_err(batch->port_id, ret, error);
+
+	batch->n_postponed = 0;
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_flow_async_batch_poll, 26.03)
+int
+rte_flow_async_batch_poll(struct rte_flow_async_batch *batch,
+			  struct rte_flow_error *error)
+{
+	int ret;
+
+	ret = rte_flow_async_batch_push(batch, error);
+	if (ret)
+		return ret;
+
+	if (!batch->n_inflight)
+		return 0;
+
+	ret = rte_flow_pull(batch->port_id, batch->queue_id,
+			    batch->res, batch->pull_burst, error);
+	if (ret <= 0)
+		return ret < 0 ? flow_err(batch->port_id, ret, error) : 0;
+
+	batch->n_inflight -= RTE_MIN((uint32_t)ret, batch->n_inflight);
+
+	if (batch->cb != NULL)
+		batch->cb(batch->port_id, batch->queue_id,
+			  batch->res, (uint16_t)ret, batch->cb_arg);
+
+	return ret;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_flow_async_batch_drain, 26.03)
+int
+rte_flow_async_batch_drain(struct rte_flow_async_batch *batch,
+			   struct rte_flow_error *error)
+{
+	while (batch->n_inflight) {
+		int ret = rte_flow_async_batch_poll(batch, error);
+
+		if (ret < 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+/* Make room in the flow queue for one more operation. */
+static int
+flow_async_batch_reserve(struct rte_flow_async_batch *batch,
+			 struct rte_flow_error *error)
+{
+	int ret;
+
+	if (likely(batch->n_inflight < batch->queue_size))
+		return 0;
+
+	ret = rte_flow_async_batch_poll(batch, error);
+	if (ret < 0)
+		return ret;
+
+	if (batch->n_inflight >= batch->queue_size)
+		return rte_flow_error_set(error, EAGAIN,
+					  RTE_FLOW_ERROR_TYPE_UNSPECIFIED,
+					  NULL, rte_strerror(EAGAIN));
+
+	return 0;
+}
+
+/* Account for one more enqueued operation, push when the threshold is hit. */
+static int
+flow_async_batch_enqueued(struct rte_flow_async_batch *batch,
+			  struct rte_flow_error *error)
+{
+	batch->n_inflight++;
+	batch->n_postponed++;
+
+	if (batch->n_postponed < batch->push_threshold)
+		return 0;
+
+	return rte_flow_async_batch_push(batch, error);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_flow_async_batch_flow_create, 26.03)
+struct rte_flow *
+rte_flow_async_batch_flow_create(struct rte_flow_async_batch *batch,
+				 struct rte_flow_template_table *template_table,
+				 const struct rte_flow_item pattern[],
+				 uint8_t pattern_template_index,
+				 const struct rte_flow_action actions[],
+				 uint8_t actions_template_index,
+				 void *user_data,
+				 struct rte_flow_error *error)
+{
+	struct rte_flow *flow;
+
+	if (flow_async_batch_reserve(batch, error))
+		return NULL;
+
+	flow = rte_flow_async_create(batch->port_id, batch->queue_id,
+				     &flow_async_batch_op_attr, template_table,
+				     pattern, pattern_template_index,
+				     actions, actions_template_index,
+				     user_data, error);
+	if (flow == NULL)
+		return NULL;
+
+	/* The rule is enqueued, a failed push is reported by the next push. */
+	flow_async_batch_enqueued(batch, NULL);
+
+	return flow;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_flow_async_batch_flow_destroy, 26.03)
+int
+rte_flow_async_batch_flow_destroy(struct rte_flow_async_batch *batch,
+				  struct rte_flow *flow,
+				  void *user_data,
+				  struct rte_flow_error *error)
+{
+	int ret;
+
+	ret = flow_async_batch_reserve(batch, error);
+	if (ret)
+		return ret;
+
+	ret = rte_flow_async_destroy(batch->port_id, batch->queue_id,
+				     &flow_async_batch_op_attr, flow,
+				     user_data, error);
+	if (ret)
+		return flow_err(batch->port_id, ret, error);
+
+	return flow_async_batch_enqueued(batch, error);
+}
+
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_flow_async_action_handle_create, 22.03)
 struct rte_flow_action_handle *
 rte_flow_async_action_handle_create(uint16_t port_id,
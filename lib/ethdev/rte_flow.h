@@ -6426,6 +6426,259 @@ rte_flow_pull(uint16_t port_id,
 	      uint16_t n_res,
 	      struct rte_flow_error *error);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Asynchronous flow operation batch.
+ *
+ * Helper layer on top of the asynchronous flow API, managing one flow queue:
+ * the flow rule operations are enqueued postponed and pushed to the hardware
+ * once a configurable number of them is pending, the flow queue is never
+ * overfilled, and the operation results are pulled in bursts and handed
+ * over to a single callback.
+ *
+ * A batch object is not thread safe, the typical usage is one batch object
+ * per lcore, each one using a different flow queue.
+ */
+struct rte_flow_async_batch;
+
+/**
+ * Flow queue selection: use the queue of index equal to the index of the
+ * lcore creating the batch object, as returned by rte_lcore_index().
+ */
+#define RTE_FLOW_ASYNC_BATCH_QUEUE_LCORE UINT32_MAX
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Asynchronous flow operation batch completion callback.
+ *
+ * @param[in] port_id
+ *   Port identifier of Ethernet device.
+ * @param[in] queue_id
+ *   Flow queue of the completed operations.
+ * @param[in] res
+ *   Array of *n_res* operation results, in completion order.
+ * @param[in] n_res
+ *   Number of operation results.
+ * @param[in] cb_arg
+ *   Opaque argument given at batch object creation.
+ */
+typedef void (*rte_flow_async_batch_cb_t)(uint16_t port_id,
+					  uint32_t queue_id,
+					  const struct rte_flow_op_result res[],
+					  uint16_t n_res,
+					  void *cb_arg);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this structure may change without prior notice.
+ *
+ * Asynchronous flow operation batch configuration.
+ */
+struct rte_flow_async_batch_conf {
+	/**
+	 * Flow queue, or RTE_FLOW_ASYNC_BATCH_QUEUE_LCORE.
+	 */
+	uint32_t queue_id;
+	/**
+	 * Size of the flow queue, as set with rte_flow_configure().
+	 * The number of operations in flight is kept below this value.
+	 */
+	uint32_t queue_size;
+	/**
+	 * Number of postponed operations triggering a push.
+	 * Must be in the range [1, queue_size].
+	 */
+	uint32_t push_threshold;
+	/**
+	 * Maximum number of operation results pulled at once. Must not be 0.
+	 */
+	uint16_t pull_burst;
+	/**
+	 * Completion callback, may be NULL.
+	 */
+	rte_flow_async_batch_cb_t cb;
+	/**
+	 * Opaque argument of the completion callback.
+	 */
+	void *cb_arg;
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create an asynchronous flow operation batch object.
+ *
+ * The port flow queues must have been configured with rte_flow_configure().
+ *
+ * @param[in] port_id
+ *   Port identifier of Ethernet device.
+ * @param[in] conf
+ *   Batch configuration.
+ * @param[in] socket_id
+ *   NUMA socket for the batch object memory.
+ *
+ * @return
+ *   Batch object on success, NULL otherwise and rte_errno is set.
+ */
+__rte_experimental
+struct rte_flow_async_batch *
+rte_flow_async_batch_create(uint16_t port_id,
+			    const struct rte_flow_async_batch_conf *conf,
+			    int socket_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free an asynchronous flow operation batch object.
+ *
+ * The operations still in flight are not waited for,
+ * see rte_flow_async_batch_drain().
+ *
+ * @param[in] batch
+ *   Batch object, may be NULL.
+ */
+__rte_experimental
+void
+rte_flow_async_batch_free(struct rte_flow_async_batch *batch);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enqueue a template based flow rule creation operation in a batch.
+ * @see rte_flow_async_create
+ *
+ * When the flow queue is full, the pending operations are pushed and
+ * the available results are pulled before enqueuing.
+ *
+ * @param[in] batch
+ *   Batch object.
+ * @param[in] template_table
+ *   Template table to take pattern and actions templates from.
+ * @param[in] pattern
+ *   List of pattern items to be used.
+ * @param[in] pattern_template_index
+ *   Pattern template index in the table.
+ * @param[in] actions
+ *   List of actions to be used.
+ * @param[in] actions_template_index
+ *   Actions template index in the table.
+ * @param[in] user_data
+ *   The user data that will be returned on the operation completion.
+ * @param[out] error
+ *   Perform verbose error reporting if not NULL.
+ *
+ * @return
+ *   Handle on success, NULL otherwise and rte_errno is set.
+ *   rte_errno is set to EAGAIN when the flow queue is still full.
+ */
+__rte_experimental
+struct rte_flow *
+rte_flow_async_batch_flow_create(struct rte_flow_async_batch *batch,
+				 struct rte_flow_template_table *template_table,
+				 const struct rte_flow_item pattern[],
+				 uint8_t pattern_template_index,
+				 const struct rte_flow_action actions[],
+				 uint8_t actions_template_index,
+				 void *user_data,
+				 struct rte_flow_error *error);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enqueue a flow rule destruction operation in a batch.
+ * @see rte_flow_async_destroy
+ *
+ * @param[in] batch
+ *   Batch object.
+ * @param[in] flow
+ *   Flow handle to be destroyed.
+ * @param[in] user_data
+ *   The user data that will be returned on the operation completion.
+ * @param[out] error
+ *   Perform verbose error reporting if not NULL.
+ *
+ * @return
+ *   0 on success, a negative errno value otherwise and rte_errno is set.
+ *   -EAGAIN when the flow queue is still full.
+ */
+__rte_experimental
+int
+rte_flow_async_batch_flow_destroy(struct rte_flow_async_batch *batch,
+				  struct rte_flow *flow,
+				  void *user_data,
+				  struct rte_flow_error *error);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Push the postponed operations of a batch to the hardware,
+ * without waiting for the push threshold.
+ *
+ * @param[in] batch
+ *   Batch object.
+ * @param[out] error
+ *   Perform verbose error reporting if not NULL.
+ *
+ * @return
+ *   0 on success, a negative errno value otherwise and rte_errno is set.
+ */
+__rte_experimental
+int
+rte_flow_async_batch_push(struct rte_flow_async_batch *batch,
+			  struct rte_flow_error *error);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Push the postponed operations of a batch, then pull up to one burst
+ * of operation results and pass them to the completion callback.
+ *
+ * To be called periodically, so that partial batches do not stay postponed.
+ *
+ * @param[in] batch
+ *   Batch object.
+ * @param[out] error
+ *   Perform verbose error reporting if not NULL.
+ *
+ * @return
+ *   Number of operation results pulled,
+ *   a negative errno value otherwise and rte_errno is set.
+ */
+__rte_experimental
+int
+rte_flow_async_batch_poll(struct rte_flow_async_batch *batch,
+			  struct rte_flow_error *error);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Push the postponed operations of a batch and poll until all the
+ * operations in flight are completed.
+ *
+ * @param[in] batch
+ *   Batch object.
+ * @param[out] error
+ *   Perform verbose error reporting if not NULL.
+ *
+ * @return
+ *   0 on success, a negative errno value otherwise and rte_errno is set.
+ */
+__rte_experimental
+int
+rte_flow_async_batch_drain(struct rte_flow_async_batch *batch,
+			   struct rte_flow_error *error);
+
 /**
  * @warning
  * @b EXPERIMENTAL: this API may change without prior notice.
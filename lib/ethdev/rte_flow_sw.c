@@ -0,0 +1,753 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/queue.h>
+
+#include <eal_export.h>
+#include <rte_atomic.h>
+#include <rte_branch_prediction.h>
+#include <rte_common.h>
+#include <rte_errno.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+#include <rte_pause.h>
+#include <rte_stdatomic.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+
+#include "rte_ethdev.h"
+#include "rte_flow.h"
+#include "rte_flow_sw.h"
+
+/* Packet layers the software rules can match on. */
+enum flow_sw_layer {
+	FLOW_SW_LAYER_ETH,
+	FLOW_SW_LAYER_VLAN,
+	FLOW_SW_LAYER_IPV4,
+	FLOW_SW_LAYER_IPV6,
+	FLOW_SW_LAYER_UDP,
+	FLOW_SW_LAYER_TCP,
+	FLOW_SW_LAYER_MAX,
+};
+
+#define FLOW_SW_ITEMS_MAX 8
+#define FLOW_SW_ITEM_SIZE_MAX sizeof(struct rte_ipv6_hdr)
+
+#define FLOW_SW_ACTION_DROP  RTE_BIT32(0)
+#define FLOW_SW_ACTION_MARK  RTE_BIT32(1)
+#define FLOW_SW_ACTION_FLAG  RTE_BIT32(2)
+#define FLOW_SW_ACTION_COUNT RTE_BIT32(3)
+
+struct flow_sw_item {
+	uint32_t layer;
+	uint32_t size;
+	uint8_t spec[FLOW_SW_ITEM_SIZE_MAX]; /* Pre-masked. */
+	uint8_t mask[FLOW_SW_ITEM_SIZE_MAX];
+};
+
+struct flow_sw_rule {
+	TAILQ_ENTRY(flow_sw_rule) node;
+	uint32_t priority;
+	uint32_t n_items;
+	struct flow_sw_item items[FLOW_SW_ITEMS_MAX];
+	uint32_t actions;
+	uint32_t mark_id;
+	RTE_ATOMIC(uint64_t) hits;
+	RTE_ATOMIC(uint64_t) bytes;
+};
+
+TAILQ_HEAD(flow_sw_rule_list, flow_sw_rule);
+
+/* Read-only snapshot of the rule list, used by the data path. */
+struct flow_sw_table {
+	uint32_t n_rules;
+	struct flow_sw_rule *rules[];
+};
+
+struct flow_sw_port;
+
+struct flow_sw_queue {
+	/* Odd while the Rx callback runs, even otherwise. */
+	RTE_ATOMIC(uint32_t) seq;
+	struct flow_sw_port *port;
+	const struct rte_eth_rxtx_callback *cb;
+};
+
+struct flow_sw_port {
+	RTE_ATOMIC(struct flow_sw_table *) table;
+	struct flow_sw_rule_list rules;
+	uint32_t n_rules;
+	struct flow_sw_queue *queues[RTE_MAX_QUEUES_PER_PORT];
+};
+
+struct rte_flow_sw_handle {
+	struct rte_flow *hw;
+	struct flow_sw_rule *sw;
+};
+
+static struct flow_sw_port *flow_sw_ports[RTE_MAX_ETHPORTS];
+static pthread_mutex_t flow_sw_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Data path.
+ */
+static inline void
+flow_sw_parse(struct rte_mbuf *m, const uint8_t *layers[FLOW_SW_LAYER_MAX])
+{
+	const uint8_t *data = rte_pktmbuf_mtod(m, const uint8_t *);
+	uint32_t len = m->data_len, offset;
+	uint16_t type;
+	uint8_t proto;
+
+	memset(layers, 0, FLOW_SW_LAYER_MAX * sizeof(layers[0]));
+
+	if (len < sizeof(struct rte_ether_hdr))
+		return;
+
+	layers[FLOW_SW_LAYER_ETH] = data;
+	type = ((const struct rte_ether_hdr *)data)->ether_type;
+	offset = sizeof(struct rte_ether_hdr);
+
+	/* The VLAN item matches the outer VLAN header. */
+	while (type == RTE_BE16(RTE_ETHER_TYPE_VLAN) ||
+	       type == RTE_BE16(RTE_ETHER_TYPE_QINQ)) {
+		if (len < offset + sizeof(struct rte_vlan_hdr))
+			return;
+
+		if (layers[FLOW_SW_LAYER_VLAN] == NULL)
+			layers[FLOW_SW_LAYER_VLAN] = &data[offset];
+		type = ((const struct rte_vlan_hdr *)&data[offset])->eth_proto;
+		offset += sizeof(struct rte_vlan_hdr);
+	}
+
+	if (type == RTE_BE16(RTE_ETHER_TYPE_IPV4)) {
+		const struct rte_ipv4_hdr *ip;
+
+		if (len < offset + sizeof(struct rte_ipv4_hdr))
+			return;
+
+		ip = (const struct rte_ipv4_hdr *)&data[offset];
+		layers[FLOW_SW_LAYER_IPV4] = &data[offset];
+
+		/* No L4 header in the non-first fragments. */
+		if (ip->fragment_offset & RTE_BE16(RTE_IPV4_HDR_OFFSET_MASK))
+			return;
+
+		proto = ip->next_proto_id;
+		offset += rte_ipv4_hdr_len(ip);
+	} else if (type == RTE_BE16(RTE_ETHER_TYPE_IPV6)) {
+		if (len < offset + sizeof(struct rte_ipv6_hdr))
+			return;
+
+		layers[FLOW_SW_LAYER_IPV6] = &data[offset];
+		proto = ((const struct rte_ipv6_hdr *)&data[offset])->proto;
+		offset += sizeof(struct rte_ipv6_hdr);
+	} else {
+		return;
+	}
+
+	if (proto == IPPROTO_UDP && len >= offset + sizeof(struct rte_udp_hdr))
+		layers[FLOW_SW_LAYER_UDP] = &data[offset];
+	else if (proto == IPPROTO_TCP && len >= offset + sizeof(struct rte_tcp_hdr))
+		layers[FLOW_SW_LAYER_TCP] = &data[offset];
+}
+
+static inline int
+flow_sw_rule_match(const struct flow_sw_rule *rule,
+		   const uint8_t *layers[FLOW_SW_LAYER_MAX])
+{
+	uint32_t i, j;
+
+	for (i = 0; i < rule->n_items; i++) {
+		const struct flow_sw_item *item = &rule->items[i];
+		const uint8_t *hdr = layers[item->layer];
+
+		if (hdr == NULL)
+			return 0;
+
+		for (j = 0; j < item->size; j++)
+			if ((hdr[j] & item->mask[j]) != item->spec[j])
+				return 0;
+	}
+
+	return 1;
+}
+
+/* Apply the first matching rule, return 0 when the packet is dropped. */
+static inline int
+flow_sw_pkt_work(const struct flow_sw_table *table, struct rte_mbuf *m)
+{
+	const uint8_t *layers[FLOW_SW_LAYER_MAX];
+	struct flow_sw_rule *rule = NULL;
+	uint32_t i;
+
+	flow_sw_parse(m, layers);
+
+	for (i = 0; i < table->n_rules; i++)
+		if (flow_sw_rule_match(table->rules[i], layers)) {
+			rule = table->rules[i];
+			break;
+		}
+
+	if (rule == NULL)
+		return 1;
+
+	if (rule->actions & FLOW_SW_ACTION_COUNT) {
+		rte_atomic_fetch_add_explicit(&rule->hits, 1, rte_memory_order_relaxed);
+		rte_atomic_fetch_add_explicit(&rule->bytes, m->pkt_len,
+					      rte_memory_order_relaxed);
+	}
+
+	if (rule->actions & FLOW_SW_ACTION_DROP) {
+		rte_pktmbuf_free(m);
+		return 0;
+	}
+
+	if (rule->actions & FLOW_SW_ACTION_MARK) {
+		m->hash.fdir.hi = rule->mark_id;
+		m->ol_flags |= RTE_MBUF_F_RX_FDIR | RTE_MBUF_F_RX_FDIR_ID;
+	}
+
+	if (rule->actions & FLOW_SW_ACTION_FLAG)
+		m->ol_flags |= RTE_MBUF_F_RX_FDIR;
+
+	return 1;
+}
+
+static uint16_t
+flow_sw_rx_cb(uint16_t port_id __rte_unused,
+	      uint16_t queue_id __rte_unused,
+	      struct rte_mbuf **pkts,
+	      uint16_t nb_pkts,
+	      uint16_t max_pkts __rte_unused,
+	      void *user_param)
+{
+	struct flow_sw_queue *q = user_param;
+	struct flow_sw_table *table;
+	uint32_t seq = rte_atomic_load_explicit(&q->seq, rte_memory_order_relaxed);
+	uint16_t i, n = 0;
+
+	/* Announce the table read before reading the table pointer. */
+	rte_atomic_store_explicit(&q->seq, seq + 1, rte_memory_order_relaxed);
+	rte_atomic_thread_fence(rte_memory_order_seq_cst);
+
+	table = rte_atomic_load_explicit(&q->port->table, rte_memory_order_acquire);
+	if (table == NULL || !table->n_rules) {
+		n = nb_pkts;
+		goto exit;
+	}
+
+	for (i = 0; i < nb_pkts; i++)
+		if (flow_sw_pkt_work(table, pkts[i]))
+			pkts[n++] = pkts[i];
+
+exit:
+	rte_atomic_store_explicit(&q->seq, seq + 2, rte_memory_order_release);
+	return n;
+}
+
+/*
+ * Control path.
+ */
+
+/* Wait for all the Rx callbacks currently running on the port to complete. */
+static void
+flow_sw_port_wait(struct flow_sw_port *port)
+{
+	uint32_t i;
+
+	rte_atomic_thread_fence(rte_memory_order_seq_cst);
+
+	for (i = 0; i < RTE_MAX_QUEUES_PER_PORT; i++) {
+		struct flow_sw_queue *q = port->queues[i];
+		uint32_t seq;
+
+		if (q == NULL)
+			continue;
+
+		seq = rte_atomic_load_explicit(&q->seq, rte_memory_order_acquire);
+		if (!(seq & 1))
+			continue;
+
+		while (rte_atomic_load_explicit(&q->seq, rte_memory_order_acquire) == seq)
+			rte_pause();
+	}
+}
+
+/* Publish a new snapshot of the rule list. */
+static int
+flow_sw_port_publish(struct flow_sw_port *port)
+{
+	struct flow_sw_table *table, *old;
+	struct flow_sw_rule *rule;
+	uint32_t i = 0;
+
+	table = rte_zmalloc("flow_sw_table",
+			    sizeof(*table) + port->n_rules * sizeof(table->rules[0]),
+			    RTE_CACHE_LINE_SIZE);
+	if (table == NULL)
+		return -ENOMEM;
+
+	TAILQ_FOREACH(rule, &port->rules, node)
+		table->rules[i++] = rule;
+	table->n_rules = i;
+
+	old = rte_atomic_exchange_explicit(&port->table, table, rte_memory_order_acq_rel);
+	flow_sw_port_wait(port);
+	rte_free(old);
+
+	return 0;
+}
+
+static struct flow_sw_port *
+flow_sw_port_get(uint16_t port_id)
+{
+	struct flow_sw_port *port = flow_sw_ports[port_id];
+
+	if (port != NULL)
+		return port;
+
+	port = rte_zmalloc("flow_sw_port", sizeof(*port), RTE_CACHE_LINE_SIZE);
+	if (port == NULL)
+		return NULL;
+
+	TAILQ_INIT(&port->rules);
+	flow_sw_ports[port_id] = port;
+
+	return port;
+}
+
+static int
+flow_sw_item_build(struct flow_sw_item *item,
+		   const struct rte_flow_item *pattern,
+		   struct rte_flow_error *error)
+{
+	const uint8_t *spec = pattern->spec;
+	const uint8_t *mask = pattern->mask;
+	uint32_t i;
+
+	switch (pattern->type) {
+	case RTE_FLOW_ITEM_TYPE_ETH:
+		item->layer = FLOW_SW_LAYER_ETH;
+		item->size = sizeof(struct rte_ether_hdr);
+		if (mask == NULL)
+			mask = (const uint8_t *)&rte_flow_item_eth_mask;
+		break;
+	case RTE_FLOW_ITEM_TYPE_VLAN:
+		item->layer = FLOW_SW_LAYER_VLAN;
+		item->size = sizeof(struct rte_vlan_hdr);
+		if (mask == NULL)
+			mask = (const uint8_t *)&rte_flow_item_vlan_mask;
+		break;
+	case RTE_FLOW_ITEM_TYPE_IPV4:
+		item->layer = FLOW_SW_LAYER_IPV4;
+		item->size = sizeof(struct rte_ipv4_hdr);
+		if (mask == NULL)
+			mask = (const uint8_t *)&rte_flow_item_ipv4_mask;
+		break;
+	case RTE_FLOW_ITEM_TYPE_IPV6:
+		item->layer = FLOW_SW_LAYER_IPV6;
+		item->size = sizeof(struct rte_ipv6_hdr);
+		if (mask == NULL)
+			mask = (const uint8_t *)&rte_flow_item_ipv6_mask;
+		break;
+	case RTE_FLOW_ITEM_TYPE_UDP:
+		item->layer = FLOW_SW_LAYER_UDP;
+		item->size = sizeof(struct rte_udp_hdr);
+		if (mask == NULL)
+			mask = (const uint8_t *)&rte_flow_item_udp_mask;
+		break;
+	case RTE_FLOW_ITEM_TYPE_TCP:
+		item->layer = FLOW_SW_LAYER_TCP;
+		item->size = sizeof(struct rte_tcp_hdr);
+		if (mask == NULL)
+			mask = (const uint8_t *)&rte_flow_item_tcp_mask;
+		break;
+	default:
+		return rte_flow_error_set(error, ENOTSUP, RTE_FLOW_ERROR_TYPE_ITEM,
+					  pattern, "item not supported in software");
+	}
+
+	if (pattern->last != NULL)
+		return rte_flow_error_set(error, ENOTSUP, RTE_FLOW_ERROR_TYPE_ITEM_LAST,
+					  pattern, "item range not supported in software");
+
+	/* Without spec, the item only matches the presence of the header. */
+	if (spec == NULL)
+		return 0;
+
+	/* The header is at the start of all the supported item structures. */
+	for (i = 0; i < item->size; i++) {
+		item->mask[i] = mask[i];
+		item->spec[i] = spec[i] & mask[i];
+	}
+
+	return 0;
+}
+
+static struct flow_sw_rule *
+flow_sw_rule_build(const struct rte_flow_attr *attr,
+		   const struct rte_flow_item pattern[],
+		   const struct rte_flow_action actions[],
+		   struct rte_flow_error *error)
+{
+	struct flow_sw_rule *rule;
+	int status;
+
+	if (attr == NULL || pattern == NULL || actions == NULL) {
+		rte_flow_error_set(error, EINVAL, RTE_FLOW_ERROR_TYPE_UNSPECIFIED,
+				   NULL, "invalid argument");
+		return NULL;
+	}
+
+	if (!attr->ingress || attr->egress || attr->transfer || attr->group) {
+		rte_flow_error_set(error, ENOTSUP, RTE_FLOW_ERROR_TYPE_ATTR,
+				   attr, "attributes not supported in software");
+		return NULL;
+	}
+
+	rule = rte_zmalloc("flow_sw_rule", sizeof(*rule), RTE_CACHE_LINE_SIZE);
+	if (rule == NULL) {
+		rte_flow_error_set(error, ENOMEM, RTE_FLOW_ERROR_TYPE_UNSPECIFIED,
+				   NULL, "rule allocation failed");
+		return NULL;
+	}
+
+	rule->priority = attr->priority;
+
+	/* Pattern. */
+	for ( ; pattern->type != RTE_FLOW_ITEM_TYPE_END; pattern++) {
+		if (pattern->type == RTE_FLOW_ITEM_TYPE_VOID)
+			continue;
+
+		if (rule->n_items == FLOW_SW_ITEMS_MAX) {
+			rte_flow_error_set(error, ENOTSUP, RTE_FLOW_ERROR_TYPE_ITEM,
+					   pattern, "too many items for software");
+			goto error;
+		}
+
+		status = flow_sw_item_build(&rule->items[rule->n_items], pattern, error);
+		if (status)
+			goto error;
+
+		rule->n_items++;
+	}
+
+	/* Actions. */
+	for ( ; actions->type != RTE_FLOW_ACTION_TYPE_END; actions++) {
+		switch (actions->type) {
+		case RTE_FLOW_ACTION_TYPE_VOID:
+			break;
+		case RTE_FLOW_ACTION_TYPE_DROP:
+			rule->actions |= FLOW_SW_ACTION_DROP;
+			break;
+		case RTE_FLOW_ACTION_TYPE_MARK:
+			if (actions->conf == NULL) {
+				rte_flow_error_set(error, EINVAL,
+						   RTE_FLOW_ERROR_TYPE_ACTION_CONF,
+						   actions, "missing mark configuration");
+				goto error;
+			}
+			rule->actions |= FLOW_SW_ACTION_MARK;
+			rule->mark_id = ((const struct rte_flow_action_mark *)actions->conf)->id;
+			break;
+		case RTE_FLOW_ACTION_TYPE_FLAG:
+			rule->actions |= FLOW_SW_ACTION_FLAG;
+			break;
+		case RTE_FLOW_ACTION_TYPE_COUNT:
+			rule->actions |= FLOW_SW_ACTION_COUNT;
+			break;
+		default:
+			rte_flow_error_set(error, ENOTSUP, RTE_FLOW_ERROR_TYPE_ACTION,
+					   actions, "action not supported in software");
+			goto error;
+		}
+	}
+
+	return rule;
+
+error:
+	rte_free(rule);
+	return NULL;
+}
+
+/* Insert the rule after the rules of lower or equal priority value. */
+static void
+flow_sw_rule_insert(struct flow_sw_port *port, struct flow_sw_rule *rule)
+{
+	struct flow_sw_rule *r;
+
+	TAILQ_FOREACH(r, &port->rules, node)
+		if (r->priority > rule->priority) {
+			TAILQ_INSERT_BEFORE(r, rule, node);
+			port->n_rules++;
+			return;
+		}
+
+	TAILQ_INSERT_TAIL(&port->rules, rule, node);
+	port->n_rules++;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_flow_sw_rx_queue_enable, 26.03)
+int
+rte_flow_sw_rx_queue_enable(uint16_t port_id, uint16_t queue_id)
+{
+	struct flow_sw_port *port;
+	struct flow_sw_queue *q;
+	int status = 0;
+
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, -ENODEV);
+	if (queue_id >= RTE_MAX_QUEUES_PER_PORT)
+		return -EINVAL;
+
+	pthread_mutex_lock(&flow_sw_lock);
+
+	port = flow_sw_port_get(port_id);
+	if (port == NULL) {
+		status = -ENOMEM;
+		goto exit;
+	}
+
+	if (port->queues[queue_id] != NULL) {
+		status = -EEXIST;
+		goto exit;
+	}
+
+	q = rte_zmalloc("flow_sw_queue", sizeof(*q), RTE_CACHE_LINE_SIZE);
+	if (q == NULL) {
+		status = -ENOMEM;
+		goto exit;
+	}
+
+	q->port = port;
+	q->cb = rte_eth_add_rx_callback(port_id, queue_id, flow_sw_rx_cb, q);
+	if (q->cb == NULL) {
+		status = -rte_errno;
+		rte_free(q);
+		goto exit;
+	}
+
+	port->queues[queue_id] = q;
+
+exit:
+	pthread_mutex_unlock(&flow_sw_lock);
+	return status;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_flow_sw_rx_queue_disable, 26.03)
+int
+rte_flow_sw_rx_queue_disable(uint16_t port_id, uint16_t queue_id)
+{
+	struct flow_sw_port *port;
+	struct flow_sw_queue *q;
+	int status;
+
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, -ENODEV);
+	if (queue_id >= RTE_MAX_QUEUES_PER_PORT)
+		return -EINVAL;
+
+	pthread_mutex_lock(&flow_sw_lock);
+
+	port = flow_sw_ports[port_id];
+	q = port ? port->queues[queue_id] : NULL;
+	if (q == NULL) {
+		status = -ENOENT;
+		goto exit;
+	}
+
+	status = rte_eth_remove_rx_callback(port_id, queue_id, q->cb);
+	if (status)
+		goto exit;
+
+	/* The callback may still be running, wait before freeing it. */
+	flow_sw_port_wait(port);
+	port->queues[queue_id] = NULL;
+	rte_free((void *)(uintptr_t)q->cb);
+	rte_free(q);
+
+exit:
+	pthread_mutex_unlock(&flow_sw_lock);
+	return status;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_flow_sw_create, 26.03)
+struct rte_flow_sw_handle *
+rte_flow_sw_create(uint16_t port_id,
+		   const struct rte_flow_attr *attr,
+		   const struct rte_flow_item pattern[],
+		   const struct rte_flow_action actions[],
+		   struct rte_flow_error *error)
+{
+	struct rte_flow_sw_handle *handle;
+	struct flow_sw_port *port;
+	struct flow_sw_rule *rule;
+	int status;
+
+	if (!rte_eth_dev_is_valid_port(port_id)) {
+		rte_flow_error_set(error, ENODEV, RTE_FLOW_ERROR_TYPE_UNSPECIFIED,
+				   NULL, rte_strerror(ENODEV));
+		return NULL;
+	}
+
+	handle = rte_zmalloc("flow_sw_handle", sizeof(*handle), 0);
+	if (handle == NULL) {
+		rte_flow_error_set(error, ENOMEM, RTE_FLOW_ERROR_TYPE_UNSPECIFIED,
+				   NULL, rte_strerror(ENOMEM));
+		return NULL;
+	}
+
+	/* Hardware first. */
+	handle->hw = rte_flow_create(port_id, attr, pattern, actions, error);
+	if (handle->hw != NULL)
+		return handle;
+
+	if (rte_errno != ENOSYS && rte_errno != ENOTSUP && rte_errno != EINVAL)
+		goto error;
+
+	/* Software fallback. */
+	rule = flow_sw_rule_build(attr, pattern, actions, error);
+	if (rule == NULL)
+		goto error;
+
+	pthread_mutex_lock(&flow_sw_lock);
+
+	port = flow_sw_port_get(port_id);
+	if (port == NULL) {
+		pthread_mutex_unlock(&flow_sw_lock);
+		rte_free(rule);
+		rte_flow_error_set(error, ENOMEM, RTE_FLOW_ERROR_TYPE_UNSPECIFIED,
+				   NULL, rte_strerror(ENOMEM));
+		goto error;
+	}
+
+	flow_sw_rule_insert(port, rule);
+
+	status = flow_sw_port_publish(port);
+	if (status) {
+		TAILQ_REMOVE(&port->rules, rule, node);
+		port->n_rules--;
+		pthread_mutex_unlock(&flow_sw_lock);
+		rte_free(rule);
+		rte_flow_error_set(error, -status, RTE_FLOW_ERROR_TYPE_UNSPECIFIED,
+				   NULL, rte_strerror(-status));
+		goto error;
+	}
+
+	pthread_mutex_unlock(&flow_sw_lock);
+
+	handle->sw = rule;
+	return handle;
+
+error:
+	rte_free(handle);
+	return NULL;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_flow_sw_destroy, 26.03)
+int
+rte_flow_sw_destroy(uint16_t port_id,
+		    struct rte_flow_sw_handle *handle,
+		    struct rte_flow_error *error)
+{
+	struct flow_sw_port *port;
+	int status;
+
+	if (handle == NULL)
+		return rte_flow_error_set(error, EINVAL, RTE_FLOW_ERROR_TYPE_HANDLE,
+					  NULL, rte_strerror(EINVAL));
+
+	if (handle->hw != NULL) {
+		status = rte_flow_destroy(port_id, handle->hw, error);
+		if (status)
+			return status;
+
+		rte_free(handle);
+		return 0;
+	}
+
+	if (port_id >= RTE_MAX_ETHPORTS)
+		return rte_flow_error_set(error, ENODEV, RTE_FLOW_ERROR_TYPE_UNSPECIFIED,
+					  NULL, rte_strerror(ENODEV));
+
+	pthread_mutex_lock(&flow_sw_lock);
+
+	port = flow_sw_ports[port_id];
+	if (port == NULL) {
+		pthread_mutex_unlock(&flow_sw_lock);
+		return rte_flow_error_set(error, ENOENT, RTE_FLOW_ERROR_TYPE_HANDLE,
+					  handle, rte_strerror(ENOENT));
+	}
+
+	TAILQ_REMOVE(&port->rules, handle->sw, node);
+	port->n_rules--;
+
+	status = flow_sw_port_publish(port);
+	if (status) {
+		flow_sw_rule_insert(port, handle->sw);
+		pthread_mutex_unlock(&flow_sw_lock);
+		return rte_flow_error_set(error, -status, RTE_FLOW_ERROR_TYPE_UNSPECIFIED,
+					  NULL, rte_strerror(-status));
+	}
+
+	pthread_mutex_unlock(&flow_sw_lock);
+
+	/* No Rx callback can see the rule after the publish. */
+	rte_free(handle->sw);
+	rte_free(handle);
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_flow_sw_is_software, 26.03)
+int
+rte_flow_sw_is_software(const struct rte_flow_sw_handle *handle)
+{
+	return handle->sw != NULL;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_flow_sw_query_count, 26.03)
+int
+rte_flow_sw_query_count(uint16_t port_id,
+			struct rte_flow_sw_handle *handle,
+			struct rte_flow_query_count *count,
+			struct rte_flow_error *error)
+{
+	static const struct rte_flow_action action_count = {
+		.type = RTE_FLOW_ACTION_TYPE_COUNT,
+	};
+	struct flow_sw_rule *rule;
+
+	if (handle == NULL || count == NULL)
+		return rte_flow_error_set(error, EINVAL, RTE_FLOW_ERROR_TYPE_UNSPECIFIED,
+					  NULL, rte_strerror(EINVAL));
+
+	if (handle->hw != NULL)
+		return rte_flow_query(port_id, handle->hw, &action_count, count, error);
+
+	rule = handle->sw;
+	if (!(rule->actions & FLOW_SW_ACTION_COUNT))
+		return rte_flow_error_set(error, ENOTSUP, RTE_FLOW_ERROR_TYPE_ACTION,
+					  NULL, "rule has no count action");
+
+	if (count->reset) {
+		count->hits = rte_atomic_exchange_explicit(&rule->hits, 0,
+							   rte_memory_order_relaxed);
+		count->bytes = rte_atomic_exchange_explicit(&rule->bytes, 0,
+							    rte_memory_order_relaxed);
+	} else {
+		count->hits = rte_atomic_load_explicit(&rule->hits,
+						       rte_memory_order_relaxed);
+		count->bytes = rte_atomic_load_explicit(&rule->bytes,
+							rte_memory_order_relaxed);
+	}
+	count->hits_set = 1;
+	count->bytes_set = 1;
+
+	return 0;
+}
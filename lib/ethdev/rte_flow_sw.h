@@ -0,0 +1,172 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef RTE_FLOW_SW_H_
+#define RTE_FLOW_SW_H_
+
+/**
+ * @file
+ * RTE generic flow API software fallback
+ *
+ * This API creates flow rules in hardware when the PMD supports them and
+ * falls back to a software classifier for the rules rejected by the PMD.
+ * The software rules are applied by a Rx callback on the Rx queues enabled
+ * with rte_flow_sw_rx_queue_enable(), so only the traffic not handled by
+ * the hardware rules goes through the software classifier.
+ *
+ * The software classifier supports ingress rules of group 0 with:
+ * - pattern items ETH, VLAN, IPV4, IPV6, UDP, TCP, VOID and END,
+ *   with spec and mask, but without last;
+ * - actions DROP, MARK, FLAG, COUNT, VOID and END.
+ *
+ * The rules are matched in increasing priority order, then in creation
+ * order, and the actions of the first matching rule only are applied.
+ *
+ * The control functions of this API are thread safe. They may wait for the
+ * lcores polling the enabled Rx queues to finish their current Rx burst.
+ */
+
+#include <stdint.h>
+
+#include <rte_compat.h>
+
+#include "rte_flow.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Flow rule handle, for either a hardware or a software flow rule. */
+struct rte_flow_sw_handle;
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Apply the software flow rules of a port on one of its Rx queues.
+ *
+ * @param port_id
+ *   Port identifier of Ethernet device.
+ * @param queue_id
+ *   Rx queue identifier.
+ * @return
+ *   0 on success, a negative errno value otherwise.
+ */
+__rte_experimental
+int
+rte_flow_sw_rx_queue_enable(uint16_t port_id, uint16_t queue_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Stop applying the software flow rules of a port on one of its Rx queues.
+ *
+ * @param port_id
+ *   Port identifier of Ethernet device.
+ * @param queue_id
+ *   Rx queue identifier.
+ * @return
+ *   0 on success, a negative errno value otherwise.
+ */
+__rte_experimental
+int
+rte_flow_sw_rx_queue_disable(uint16_t port_id, uint16_t queue_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a flow rule, in hardware when possible, in software otherwise.
+ *
+ * The rule is first created with rte_flow_create(). When the PMD does not
+ * support it (ENOSYS, ENOTSUP or EINVAL), the rule is added to the software
+ * classifier of the port.
+ *
+ * @param port_id
+ *   Port identifier of Ethernet device.
+ * @param[in] attr
+ *   Flow rule attributes.
+ * @param[in] pattern
+ *   Pattern specification (list terminated by the END pattern item).
+ * @param[in] actions
+ *   Associated actions (list terminated by the END action).
+ * @param[out] error
+ *   Perform verbose error reporting if not NULL.
+ * @return
+ *   Handle on success, NULL otherwise and rte_errno is set.
+ */
+__rte_experimental
+struct rte_flow_sw_handle *
+rte_flow_sw_create(uint16_t port_id,
+		   const struct rte_flow_attr *attr,
+		   const struct rte_flow_item pattern[],
+		   const struct rte_flow_action actions[],
+		   struct rte_flow_error *error);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Destroy a flow rule created with rte_flow_sw_create().
+ *
+ * @param port_id
+ *   Port identifier of Ethernet device.
+ * @param handle
+ *   Flow rule handle.
+ * @param[out] error
+ *   Perform verbose error reporting if not NULL.
+ * @return
+ *   0 on success, a negative errno value otherwise and rte_errno is set.
+ */
+__rte_experimental
+int
+rte_flow_sw_destroy(uint16_t port_id,
+		    struct rte_flow_sw_handle *handle,
+		    struct rte_flow_error *error);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Check whether a flow rule is handled in software.
+ *
+ * @param handle
+ *   Flow rule handle.
+ * @return
+ *   1 for a software flow rule, 0 for a hardware flow rule.
+ */
+__rte_experimental
+int
+rte_flow_sw_is_software(const struct rte_flow_sw_handle *handle);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Query the COUNT action of a flow rule created with rte_flow_sw_create().
+ *
+ * @param port_id
+ *   Port identifier of Ethernet device.
+ * @param handle
+ *   Flow rule handle.
+ * @param[in, out] count
+ *   Counter query, as for RTE_FLOW_ACTION_TYPE_COUNT.
+ * @param[out] error
+ *   Perform verbose error reporting if not NULL.
+ * @return
+ *   0 on success, a negative errno value otherwise and rte_errno is set.
+ */
+__rte_experimental
+int
+rte_flow_sw_query_count(uint16_t port_id,
+			struct rte_flow_sw_handle *handle,
+			struct rte_flow_query_count *count,
+			struct rte_flow_error *error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RTE_FLOW_SW_H_ */
@@ -10,6 +10,7 @@
 #include <dev_driver.h>
 #include <rte_errno.h>
 #include <rte_cryptodev.h>
+#include <rte_cycles.h>
 #include <cryptodev_pmd.h>
 #include <rte_log.h>
 #include <rte_malloc.h>
@@ -99,6 +100,13 @@ struct __rte_cache_aligned event_crypto_adapter {
 	uint16_t nb_qps;
 	/* Adapter mode */
 	enum rte_event_crypto_adapter_mode mode;
+	/* Max crypto ops inflight per queue pair, 0 if unlimited */
+	uint32_t max_inflight;
+	/* Max time crypto ops wait in a queue pair buffer, 0 if unlimited */
+	uint32_t flush_timeout_us;
+	uint64_t flush_timeout_cycles;
+	/* Time the buffered crypto ops must be flushed, UINT64_MAX if none */
+	uint64_t flush_deadline;
 };
 
 /* Per crypto device information */
@@ -127,6 +135,8 @@ struct __rte_cache_aligned crypto_queue_pair_info {
 	bool qp_enabled;
 	/* Circular buffer for batching crypto ops to cdev */
 	struct crypto_ops_circular_buffer cbuf;
+	/* Crypto ops enqueued to cdev and not dequeued yet */
+	uint32_t inflight;
 };
 
 static struct event_crypto_adapter **event_crypto_adapter;
@@ -260,8 +270,9 @@ eca_circular_buffer_add(struct crypto_ops_circular_buffer *bufp,
 static inline int
 eca_circular_buffer_flush_to_cdev(struct crypto_ops_circular_buffer *bufp,
 				  uint8_t cdev_id, uint16_t qp_id,
-				  uint16_t *nb_ops_flushed)
+				  uint16_t max_ops, uint16_t *nb_ops_flushed)
 {
+	bool limited = false;
 	uint16_t n = 0;
 	uint16_t *headp = &bufp->head;
 	uint16_t *tailp = &bufp->tail;
@@ -293,6 +304,16 @@ eca_circular_buffer_flush_to_cdev(struct crypto_ops_circular_buffer *bufp,
 		}
 	}
 
+	if (n > max_ops) {
+		n = max_ops;
+		limited = true;
+	}
+
+	if (n == 0) {
+		*nb_ops_flushed = 0;
+		return -1;
+	}
+
 	*nb_ops_flushed = rte_cryptodev_enqueue_burst(cdev_id, qp_id,
 						      &ops[*headp], n);
 	bufp->count -= *nb_ops_flushed;
@@ -302,7 +323,36 @@ eca_circular_buffer_flush_to_cdev(struct crypto_ops_circular_buffer *bufp,
 	} else
 		*headp = (*headp + *nb_ops_flushed) % bufp->size;
 
-	return *nb_ops_flushed == n ? 0 : -1;
+	return *nb_ops_flushed == n && !limited ? 0 : -1;
+}
+
+/*
+ * Flush the buffered crypto ops of a queue pair, within the inflight
+ * credits of the queue pair. Without credits left, the queue pair is
+ * known to be full and the enqueue is not attempted.
+ */
+static inline int
+eca_qp_flush_to_cdev(struct event_crypto_adapter *adapter,
+		     struct crypto_queue_pair_info *qp_info,
+		     uint8_t cdev_id, uint16_t qp_id,
+		     uint16_t *nb_ops_flushed)
+{
+	uint16_t max_ops = UINT16_MAX;
+	uint32_t credits;
+	int ret;
+
+	if (adapter->max_inflight != 0) {
+		credits = RTE_MIN(qp_info->inflight, adapter->max_inflight);
+		credits = adapter->max_inflight - credits;
+		max_ops = RTE_MIN(credits, (uint32_t)UINT16_MAX);
+	}
+
+	ret = eca_circular_buffer_flush_to_cdev(&qp_info->cbuf, cdev_id,
+						qp_id, max_ops,
+						nb_ops_flushed);
+	qp_info->inflight += *nb_ops_flushed;
+
+	return ret;
 }
 
 static inline struct event_crypto_adapter *
@@ -417,6 +467,7 @@ rte_event_crypto_adapter_create_ext(uint8_t id, uint8_t dev_id,
 	adapter->conf_cb = conf_cb;
 	adapter->conf_arg = conf_arg;
 	adapter->mode = mode;
+	adapter->flush_deadline = UINT64_MAX;
 	strcpy(adapter->mem_name, mem_name);
 	adapter->cdevs = rte_zmalloc_socket(adapter->mem_name,
 					rte_cryptodev_count() *
@@ -553,16 +604,23 @@ eca_enq_to_cryptodev(struct event_crypto_adapter *adapter, struct rte_event *ev,
 		}
 		eca_circular_buffer_add(&qp_info->cbuf, crypto_op);
 
+		/* Bound the time the first buffered op waits for a batch */
+		if (unlikely(adapter->flush_timeout_cycles != 0 &&
+			     qp_info->cbuf.count == 1 &&
+			     adapter->flush_deadline == UINT64_MAX))
+			adapter->flush_deadline = rte_get_timer_cycles() +
+				adapter->flush_timeout_cycles;
+
 		if (eca_circular_buffer_batch_ready(&qp_info->cbuf)) {
-			ret = eca_circular_buffer_flush_to_cdev(&qp_info->cbuf,
-								cdev_id,
-								qp_id,
-								&nb_enqueued);
+			ret = eca_qp_flush_to_cdev(adapter, qp_info,
+						   cdev_id, qp_id,
+						   &nb_enqueued);
 			stats->crypto_enq_count += nb_enqueued;
 			n += nb_enqueued;
 
 			/**
-			 * If some crypto ops failed to flush to cdev and
+			 * If some crypto ops failed to flush to cdev, or
+			 * were held back by the inflight credits, and
 			 * space for another batch is not available, stop
 			 * dequeue from eventdev momentarily
 			 */
@@ -595,10 +653,8 @@ eca_crypto_cdev_flush(struct event_crypto_adapter *adapter,
 		if (unlikely(curr_queue == NULL || !curr_queue->qp_enabled))
 			continue;
 
-		eca_circular_buffer_flush_to_cdev(&curr_queue->cbuf,
-						  cdev_id,
-						  qp,
-						  &nb_enqueued);
+		eca_qp_flush_to_cdev(adapter, curr_queue, cdev_id, qp,
+				     &nb_enqueued);
 		*nb_ops_flushed += curr_queue->cbuf.count;
 		nb += nb_enqueued;
 	}
@@ -626,6 +682,11 @@ eca_crypto_enq_flush(struct event_crypto_adapter *adapter)
 	if (!nb_ops_flushed)
 		adapter->stop_enq_to_cryptodev = false;
 
+	if (adapter->flush_timeout_cycles != 0)
+		adapter->flush_deadline = nb_ops_flushed ?
+			rte_get_timer_cycles() +
+			adapter->flush_timeout_cycles : UINT64_MAX;
+
 	stats->crypto_enq_count += nb_enqueued;
 
 	return nb_enqueued;
@@ -668,6 +729,9 @@ eca_crypto_adapter_enq_run(struct event_crypto_adapter *adapter,
 	if ((++adapter->transmit_loop_count &
 		(CRYPTO_ENQ_FLUSH_THRESHOLD - 1)) == 0) {
 		nb_enqueued += eca_crypto_enq_flush(adapter);
+	} else if (unlikely(adapter->flush_deadline != UINT64_MAX) &&
+		   rte_get_timer_cycles() >= adapter->flush_deadline) {
+		nb_enqueued += eca_crypto_enq_flush(adapter);
 	}
 
 	return nb_enqueued;
@@ -829,6 +893,8 @@ eca_crypto_adapter_deq_run(struct event_crypto_adapter *adapter,
 				nb_enqueued = 0;
 
 				stats->crypto_deq_count += n;
+				curr_queue->inflight -=
+					RTE_MIN(curr_queue->inflight, n);
 
 				if (unlikely(!adapter->ebuf.count))
 					nb_enqueued = eca_ops_enqueue_burst(
@@ -993,6 +1059,8 @@ eca_update_qp_info(struct event_crypto_adapter *adapter,
 		if (add) {
 			adapter->nb_qps += !enabled;
 			dev_info->num_qpairs += !enabled;
+			if (!enabled)
+				qp_info->inflight = 0;
 		} else {
 			adapter->nb_qps -= enabled;
 			dev_info->num_qpairs -= enabled;
@@ -1497,6 +1565,12 @@ rte_event_crypto_adapter_runtime_params_set(uint8_t id,
 
 	rte_spinlock_lock(&adapter->lock);
 	adapter->max_nb = params->max_nb;
+	adapter->max_inflight = params->max_inflight;
+	adapter->flush_timeout_us = params->flush_timeout_us;
+	adapter->flush_timeout_cycles = (uint64_t)params->flush_timeout_us *
+		rte_get_timer_hz() / US_PER_S;
+	if (adapter->flush_timeout_cycles == 0)
+		adapter->flush_deadline = UINT64_MAX;
 	rte_spinlock_unlock(&adapter->lock);
 
 	return 0;
@@ -1530,6 +1604,8 @@ rte_event_crypto_adapter_runtime_params_get(uint8_t id,
 		return ret;
 
 	params->max_nb = adapter->max_nb;
+	params->max_inflight = adapter->max_inflight;
+	params->flush_timeout_us = adapter->flush_timeout_us;
 
 	return 0;
 }
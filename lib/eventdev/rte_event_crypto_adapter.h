@@ -277,7 +277,30 @@ struct rte_event_crypto_adapter_runtime_params {
 	 * RTE_EVENT_CRYPTO_ADAPTER_CAP_INTERNAL_PORT_OP_FWD or
 	 * RTE_EVENT_CRYPTO_ADAPTER_CAP_INTERNAL_PORT_OP_NEW capability.
 	 */
-	uint32_t rsvd[15];
+	uint32_t flush_timeout_us;
+	/**< Maximum time in microseconds a crypto op dequeued from the event
+	 * port waits in the adapter for a full batch of its queue pair,
+	 * before being enqueued to the cryptodev anyway.
+	 * 0 means the partial batches are flushed periodically only.
+	 *
+	 * This is valid in RTE_EVENT_CRYPTO_ADAPTER_OP_FORWARD mode, for the
+	 * devices without RTE_EVENT_CRYPTO_ADAPTER_CAP_INTERNAL_PORT_OP_FWD
+	 * capability.
+	 */
+	uint32_t max_inflight;
+	/**< Maximum number of crypto ops enqueued by the adapter to a queue
+	 * pair and not dequeued yet. When a queue pair runs out of these
+	 * credits, the adapter stops dequeuing events from the event port
+	 * instead of retrying the cryptodev enqueue, pushing back on the
+	 * event producers until crypto ops complete.
+	 * It should not exceed the number of descriptors of the queue pairs.
+	 * 0 means unlimited.
+	 *
+	 * This is valid in RTE_EVENT_CRYPTO_ADAPTER_OP_FORWARD mode, for the
+	 * devices without RTE_EVENT_CRYPTO_ADAPTER_CAP_INTERNAL_PORT_OP_FWD
+	 * capability.
+	 */
+	uint32_t rsvd[13];
 	/**< Reserved fields for future expansion */
 };
 
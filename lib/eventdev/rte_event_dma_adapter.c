@@ -240,6 +240,8 @@ edma_circular_buffer_flush_to_dma_dev(struct event_dma_adapter *adapter,
 	uint16_t *head = &bufp->head;
 	uint16_t *tail = &bufp->tail;
 	struct dma_vchan_info *tq;
+	uint64_t submit = 0;
+	uint64_t flags;
 	uint16_t n;
 	uint16_t i;
 	int ret;
@@ -255,25 +257,35 @@ edma_circular_buffer_flush_to_dma_dev(struct event_dma_adapter *adapter,
 
 	tq = &adapter->dma_devs[dma_dev_id].tqmap[vchan];
 
+	/*
+	 * Ring the doorbell once for the burst, instead of once per op
+	 * requesting it with RTE_DMA_OP_FLAG_SUBMIT.
+	 */
 	for (i = 0; i < n; i++)	{
 		op = bufp->op_buffer[*head];
+		flags = op->flags & ~RTE_DMA_OP_FLAG_SUBMIT;
 		if (op->nb_src == 1 && op->nb_dst == 1)
 			ret = rte_dma_copy(dma_dev_id, vchan, op->src_dst_seg[0].addr,
 					   op->src_dst_seg[1].addr, op->src_dst_seg[0].length,
-					   op->flags);
+					   flags);
 		else
 			ret = rte_dma_copy_sg(dma_dev_id, vchan, &op->src_dst_seg[0],
 					      &op->src_dst_seg[op->nb_src], op->nb_src, op->nb_dst,
-					      op->flags);
+					      flags);
 		if (ret < 0)
 			break;
 
+		submit |= op->flags & RTE_DMA_OP_FLAG_SUBMIT;
+
 		/* Enqueue in transaction queue. */
 		edma_circular_buffer_add(&tq->dma_buf, op);
 
 		*head = (*head + 1) % bufp->size;
 	}
 
+	if (submit)
+		rte_dma_submit(dma_dev_id, vchan);
+
 	*nb_ops_flushed = i;
 	bufp->count -= *nb_ops_flushed;
 	if (!bufp->count) {
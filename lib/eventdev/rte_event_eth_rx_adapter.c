@@ -35,6 +35,8 @@
 #define ETH_EVENT_BUFFER_SIZE	(6*BATCH_SIZE)
 #define MAX_VECTOR_SIZE		1024
 #define MIN_VECTOR_SIZE		4
+/* Adaptive vectorization shrinks the vector size down to 1/8 */
+#define RXA_VECTOR_ADAPTIVE_SHIFT 3
 #define MAX_VECTOR_NS		1E9
 #define MIN_VECTOR_NS		1E5
 
@@ -78,11 +80,19 @@ struct __rte_cache_aligned eth_rx_vector_data {
 	uint16_t port;
 	uint16_t queue;
 	uint16_t max_vector_count;
+	/* Vector size and timeout in use, lower than the configured ones
+	 * with adaptive vectorization.
+	 */
+	uint16_t vector_count;
+	uint16_t min_vector_count;
+	uint8_t adaptive;
 	uint64_t event;
 	uint64_t ts;
 	uint64_t vector_timeout_ticks;
+	uint64_t cur_timeout_ticks;
 	struct rte_mempool *vector_pool;
 	struct rte_event_vector *vector_ev;
+	struct rte_event_eth_rx_adapter_queue_vector_stats stats;
 };
 
 TAILQ_HEAD(eth_rx_vector_data_list, eth_rx_vector_data);
@@ -865,6 +875,36 @@ rxa_init_vector(struct event_eth_rx_adapter *rx_adapter,
 	TAILQ_INSERT_TAIL(&rx_adapter->vector_list, vec, next);
 }
 
+static inline void
+rxa_vector_resize(struct eth_rx_vector_data *vec, uint16_t count)
+{
+	vec->vector_count = count;
+	vec->cur_timeout_ticks = vec->vector_timeout_ticks * count /
+			vec->max_vector_count;
+}
+
+/* Account a vector ready to be enqueued. The adaptive vector size grows
+ * when the vectors fill up, for throughput, and shrinks when they time
+ * out, to cut the latency at low load.
+ */
+static inline void
+rxa_vector_done(struct eth_rx_vector_data *vec, bool timedout)
+{
+	vec->stats.vectors++;
+	vec->stats.vectors_timedout += timedout;
+	vec->stats.vector_elems += vec->vector_ev->nb_elem;
+
+	if (!vec->adaptive)
+		return;
+
+	if (timedout && vec->vector_count > vec->min_vector_count)
+		rxa_vector_resize(vec, RTE_MAX(vec->vector_count >> 1,
+				vec->min_vector_count));
+	else if (!timedout && vec->vector_count < vec->max_vector_count)
+		rxa_vector_resize(vec, RTE_MIN(vec->vector_count << 1,
+				vec->max_vector_count));
+}
+
 static inline uint16_t
 rxa_create_event_vector(struct event_eth_rx_adapter *rx_adapter,
 			struct eth_rx_queue_info *queue_info,
@@ -887,8 +927,9 @@ rxa_create_event_vector(struct event_eth_rx_adapter *rx_adapter,
 		rxa_init_vector(rx_adapter, vec);
 	}
 	while (num) {
-		if (vec->vector_ev->nb_elem == vec->max_vector_count) {
+		if (vec->vector_ev->nb_elem >= vec->vector_count) {
 			/* Event ready. */
+			rxa_vector_done(vec, false);
 			ev->event = vec->event;
 			ev->vec = vec->vector_ev;
 			ev++;
@@ -903,7 +944,7 @@ rxa_create_event_vector(struct event_eth_rx_adapter *rx_adapter,
 			rxa_init_vector(rx_adapter, vec);
 		}
 
-		space = vec->max_vector_count - vec->vector_ev->nb_elem;
+		space = vec->vector_count - vec->vector_ev->nb_elem;
 		sz = num > space ? space : num;
 		memcpy(vec->vector_ev->mbufs + vec->vector_ev->nb_elem, mbufs,
 		       sizeof(void *) * sz);
@@ -913,7 +954,8 @@ rxa_create_event_vector(struct event_eth_rx_adapter *rx_adapter,
 		vec->ts = rte_rdtsc();
 	}
 
-	if (vec->vector_ev->nb_elem == vec->max_vector_count) {
+	if (vec->vector_ev->nb_elem >= vec->vector_count) {
+		rxa_vector_done(vec, false);
 		ev->event = vec->event;
 		ev->vec = vec->vector_ev;
 		ev++;
@@ -1399,6 +1441,7 @@ rxa_vector_expire(struct eth_rx_vector_data *vec, void *arg)
 	ev = &buf->events[buf->count];
 
 	/* Event ready. */
+	rxa_vector_done(vec, true);
 	ev->event = vec->event;
 	ev->vec = vec->vector_ev;
 	buf->count++;
@@ -1429,7 +1472,7 @@ rxa_service_func(void *args)
 			TAILQ_FOREACH(vec, &rx_adapter->vector_list, next) {
 				uint64_t elapsed_time = rte_rdtsc() - vec->ts;
 
-				if (elapsed_time >= vec->vector_timeout_ticks) {
+				if (elapsed_time >= vec->cur_timeout_ticks) {
 					rxa_vector_expire(vec, rx_adapter);
 					TAILQ_REMOVE(&rx_adapter->vector_list,
 						     vec, next);
@@ -1984,7 +2027,7 @@ rxa_update_queue(struct event_eth_rx_adapter *rx_adapter,
 static void
 rxa_set_vector_data(struct eth_rx_queue_info *queue_info, uint16_t vector_count,
 		    uint64_t vector_ns, struct rte_mempool *mp, uint32_t qid,
-		    uint16_t port_id)
+		    uint16_t port_id, bool adaptive)
 {
 #define NSEC2TICK(__ns, __freq) (((__ns) * (__freq)) / 1E9)
 	struct eth_rx_vector_data *vector_data;
@@ -1997,6 +2040,12 @@ rxa_set_vector_data(struct eth_rx_queue_info *queue_info, uint16_t vector_count,
 	vector_data->vector_pool = mp;
 	vector_data->vector_timeout_ticks =
 		NSEC2TICK(vector_ns, rte_get_timer_hz());
+	vector_data->adaptive = adaptive;
+	vector_data->min_vector_count = adaptive ?
+		RTE_MAX(vector_count >> RXA_VECTOR_ADAPTIVE_SHIFT,
+			MIN_VECTOR_SIZE) : vector_count;
+	rxa_vector_resize(vector_data, vector_count);
+	memset(&vector_data->stats, 0, sizeof(vector_data->stats));
 	vector_data->ts = 0;
 	flow_id = queue_info->event & 0xFFFFF;
 	flow_id =
@@ -2070,6 +2119,7 @@ rxa_add_queue(struct event_eth_rx_adapter *rx_adapter,
 	struct eth_event_enqueue_buffer *new_rx_buf = NULL;
 	struct rte_event_eth_rx_adapter_stats *stats = NULL;
 	uint16_t eth_dev_id = dev_info->dev->data->port_id;
+	uint64_t vector_tmo_ticks;
 	int ret;
 
 	if (rx_queue_id == -1) {
@@ -2109,16 +2159,19 @@ rxa_add_queue(struct event_eth_rx_adapter *rx_adapter,
 		qi_ev->event_type = RTE_EVENT_TYPE_ETH_RX_ADAPTER_VECTOR;
 		rxa_set_vector_data(queue_info, conf->vector_sz,
 				    conf->vector_timeout_ns, conf->vector_mp,
-				    rx_queue_id, dev_info->dev->data->port_id);
+				    rx_queue_id, dev_info->dev->data->port_id,
+				    conf->rx_queue_flags &
+				    RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR_ADAPTIVE);
 		rx_adapter->ena_vector = 1;
+		/* scan for the shortest timeout the queue may use */
+		vector_tmo_ticks = queue_info->vector_data.vector_timeout_ticks *
+			queue_info->vector_data.min_vector_count /
+			queue_info->vector_data.max_vector_count;
 		rx_adapter->vector_tmo_ticks =
 			rx_adapter->vector_tmo_ticks ?
-				      RTE_MIN(queue_info->vector_data
-							.vector_timeout_ticks >>
-						1,
+				      RTE_MIN(vector_tmo_ticks >> 1,
 					rx_adapter->vector_tmo_ticks) :
-				queue_info->vector_data.vector_timeout_ticks >>
-					1;
+				vector_tmo_ticks >> 1;
 	}
 
 	rxa_update_queue(rx_adapter, dev_info, rx_queue_id, 1);
@@ -2727,6 +2780,18 @@ rte_event_eth_rx_adapter_queue_add(uint8_t id,
 		}
 	}
 
+	if ((queue_conf->rx_queue_flags &
+	     RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR_ADAPTIVE) &&
+	    (!(queue_conf->rx_queue_flags &
+	       RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR) ||
+	     (cap & RTE_EVENT_ETH_RX_ADAPTER_CAP_INTERNAL_PORT))) {
+		RTE_EDEV_LOG_ERR("Adaptive event vectorization is not supported,"
+				 " eth port: %" PRIu16
+				 " adapter id: %" PRIu8,
+				 eth_dev_id, id);
+		return -EINVAL;
+	}
+
 	if ((cap & RTE_EVENT_ETH_RX_ADAPTER_CAP_MULTI_EVENTQ) == 0 &&
 		(rx_queue_id != -1)) {
 		RTE_EDEV_LOG_ERR("Rx queues can only be connected to single "
@@ -2897,6 +2962,16 @@ rte_event_eth_rx_adapter_queues_add(uint8_t id, uint16_t eth_dev_id, int32_t rx_
 			}
 		}
 
+		if ((conf->rx_queue_flags & RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR_ADAPTIVE) &&
+		    (!(conf->rx_queue_flags & RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR) ||
+		     (cap & RTE_EVENT_ETH_RX_ADAPTER_CAP_INTERNAL_PORT))) {
+			RTE_EDEV_LOG_ERR(
+				"Adaptive event vectorization is unsupported in queue_conf[%" PRIu32
+				"], eth port: %" PRIu16 " adapter id: %" PRIu8,
+				i, eth_dev_id, id);
+			return -EINVAL;
+		}
+
 		if ((rx_adapter->use_queue_event_buf && conf->event_buf_size == 0) ||
 		    (!rx_adapter->use_queue_event_buf && conf->event_buf_size != 0)) {
 			RTE_EDEV_LOG_ERR("Invalid Event buffer size in queue_conf[%" PRIu32 "]", i);
@@ -3407,6 +3482,83 @@ rte_event_eth_rx_adapter_queue_stats_reset(uint8_t id,
 	return 0;
 }
 
+static struct eth_rx_queue_info *
+rxa_vector_queue_get(uint8_t id, uint16_t eth_dev_id, uint16_t rx_queue_id)
+{
+	struct event_eth_rx_adapter *rx_adapter;
+	struct eth_device_info *dev_info;
+
+	if (rxa_memzone_lookup())
+		return NULL;
+
+	rx_adapter = rxa_id_to_adapter(id);
+	if (rx_adapter == NULL)
+		return NULL;
+
+	if (rx_queue_id >= rte_eth_devices[eth_dev_id].data->nb_rx_queues) {
+		RTE_EDEV_LOG_ERR("Invalid rx queue_id %" PRIu16, rx_queue_id);
+		return NULL;
+	}
+
+	dev_info = &rx_adapter->eth_devices[eth_dev_id];
+	if (dev_info->rx_queue == NULL ||
+	    !dev_info->rx_queue[rx_queue_id].queue_enabled ||
+	    !dev_info->rx_queue[rx_queue_id].ena_vector ||
+	    dev_info->internal_event_port) {
+		RTE_EDEV_LOG_ERR("Rx queue %u not added with event vectorization",
+				 rx_queue_id);
+		return NULL;
+	}
+
+	return &dev_info->rx_queue[rx_queue_id];
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_event_eth_rx_adapter_queue_vector_stats_get, 26.03)
+int
+rte_event_eth_rx_adapter_queue_vector_stats_get(uint8_t id,
+		uint16_t eth_dev_id,
+		uint16_t rx_queue_id,
+		struct rte_event_eth_rx_adapter_queue_vector_stats *stats)
+{
+	struct eth_rx_queue_info *queue_info;
+
+	RTE_EVENT_ETH_RX_ADAPTER_ID_VALID_OR_ERR_RET(id, -EINVAL);
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(eth_dev_id, -EINVAL);
+
+	if (stats == NULL)
+		return -EINVAL;
+
+	queue_info = rxa_vector_queue_get(id, eth_dev_id, rx_queue_id);
+	if (queue_info == NULL)
+		return -EINVAL;
+
+	*stats = queue_info->vector_data.stats;
+	stats->vector_sz = queue_info->vector_data.vector_count;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_event_eth_rx_adapter_queue_vector_stats_reset, 26.03)
+int
+rte_event_eth_rx_adapter_queue_vector_stats_reset(uint8_t id,
+		uint16_t eth_dev_id,
+		uint16_t rx_queue_id)
+{
+	struct eth_rx_queue_info *queue_info;
+
+	RTE_EVENT_ETH_RX_ADAPTER_ID_VALID_OR_ERR_RET(id, -EINVAL);
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(eth_dev_id, -EINVAL);
+
+	queue_info = rxa_vector_queue_get(id, eth_dev_id, rx_queue_id);
+	if (queue_info == NULL)
+		return -EINVAL;
+
+	memset(&queue_info->vector_data.stats, 0,
+	       sizeof(queue_info->vector_data.stats));
+
+	return 0;
+}
+
 RTE_EXPORT_SYMBOL(rte_event_eth_rx_adapter_service_id_get)
 int
 rte_event_eth_rx_adapter_service_id_get(uint8_t id, uint32_t *service_id)
@@ -3553,6 +3705,12 @@ rte_event_eth_rx_adapter_queue_conf_get(uint8_t id,
 	if (queue_info->flow_id_mask != 0)
 		queue_conf->rx_queue_flags |=
 			RTE_EVENT_ETH_RX_ADAPTER_QUEUE_FLOW_ID_VALID;
+	if (queue_info->ena_vector)
+		queue_conf->rx_queue_flags |=
+			RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR;
+	if (queue_info->vector_data.adaptive)
+		queue_conf->rx_queue_flags |=
+			RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR_ADAPTIVE;
 	queue_conf->servicing_weight = queue_info->wt;
 
 	queue_conf->ev.event = queue_info->event;
@@ -38,6 +38,8 @@
  *  - rte_event_eth_rx_adapter_queue_conf_get()
  *  - rte_event_eth_rx_adapter_queue_stats_get()
  *  - rte_event_eth_rx_adapter_queue_stats_reset()
+ *  - rte_event_eth_rx_adapter_queue_vector_stats_get()
+ *  - rte_event_eth_rx_adapter_queue_vector_stats_reset()
  *  - rte_event_eth_rx_adapter_event_port_get()
  *  - rte_event_eth_rx_adapter_instance_get()
  *  - rte_event_eth_rx_adapter_runtime_params_get()
@@ -109,6 +111,16 @@ extern "C" {
 /**< This flag indicates that mbufs arriving on the queue need to be vectorized
  * @see rte_event_eth_rx_adapter_queue_conf::rx_queue_flags
  */
+#define RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR_ADAPTIVE	0x4
+/**< This flag indicates that the vector size and timeout of a vectorized
+ * queue adapt to the load: vector_sz and vector_timeout_ns are the maximum
+ * values, used under load, and they are reduced down to 1/8 when the vectors
+ * time out, to cut the latency at low load.
+ * Only supported when the adapter uses a service function for the queue,
+ * along with the RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR flag.
+ * @see rte_event_eth_rx_adapter_queue_conf::rx_queue_flags
+ * @see rte_event_eth_rx_adapter_queue_vector_stats_get()
+ */
 
 /**
  * Adapter configuration structure that the adapter configuration callback
@@ -232,6 +244,25 @@ struct rte_event_eth_rx_adapter_queue_stats {
 	/**< Received packet dropped count */
 };
 
+/**
+ * A structure used to retrieve the event vectorization statistics
+ * of an eth rx adapter queue.
+ * The average fill ratio of the vectors is
+ * vector_elems / (vectors * rte_event_eth_rx_adapter_queue_conf::vector_sz).
+ */
+struct rte_event_eth_rx_adapter_queue_vector_stats {
+	uint64_t vectors;
+	/**< Event vectors enqueued */
+	uint64_t vectors_timedout;
+	/**< Event vectors enqueued on timeout, before being full */
+	uint64_t vector_elems;
+	/**< Mbufs in the enqueued event vectors */
+	uint16_t vector_sz;
+	/**< Vector size in use, lower than the configured one with
+	 * RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR_ADAPTIVE
+	 */
+};
+
 /**
  * A structure used to retrieve statistics for an eth rx adapter instance.
  */
@@ -794,6 +825,62 @@ rte_event_eth_rx_adapter_queue_stats_reset(uint8_t id,
 		uint16_t eth_dev_id,
 		uint16_t rx_queue_id);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Retrieve the event vectorization statistics of an Rx queue added
+ * with the RTE_EVENT_ETH_RX_ADAPTER_QUEUE_EVENT_VECTOR flag, when the
+ * adapter uses a service function for the queue.
+ *
+ * @param id
+ *  Adapter identifier.
+ *
+ * @param eth_dev_id
+ *  Port identifier of Ethernet device.
+ *
+ * @param rx_queue_id
+ *  Ethernet device receive queue index.
+ *
+ * @param[out] stats
+ *  Pointer to struct rte_event_eth_rx_adapter_queue_vector_stats
+ *
+ * @return
+ *  - 0: Success, queue vector stats retrieved.
+ *  - <0: Error code on failure.
+ */
+__rte_experimental
+int
+rte_event_eth_rx_adapter_queue_vector_stats_get(uint8_t id,
+		uint16_t eth_dev_id,
+		uint16_t rx_queue_id,
+		struct rte_event_eth_rx_adapter_queue_vector_stats *stats);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Reset the event vectorization statistics of an Rx queue.
+ *
+ * @param id
+ *  Adapter identifier.
+ *
+ * @param eth_dev_id
+ *  Port identifier of Ethernet device.
+ *
+ * @param rx_queue_id
+ *  Ethernet device receive queue index.
+ *
+ * @return
+ *  - 0: Success, queue vector stats reset.
+ *  - <0: Error code on failure.
+ */
+__rte_experimental
+int
+rte_event_eth_rx_adapter_queue_vector_stats_reset(uint8_t id,
+		uint16_t eth_dev_id,
+		uint16_t rx_queue_id);
+
 /**
  * Retrieve the event port ID of an adapter. If the adapter doesn't use
  * a rte_service function, this function returns -ESRCH.
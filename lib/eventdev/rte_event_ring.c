@@ -5,6 +5,10 @@
 
 
 #include <eal_export.h>
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_soring.h>
+
 #include "rte_event_ring.h"
 #include "eventdev_trace.h"
 
@@ -55,3 +59,104 @@ rte_event_ring_free(struct rte_event_ring *r)
 
 	rte_ring_free((struct rte_ring *)r);
 }
+
+/* An ordered event ring is a soring of events. */
+static inline struct rte_soring *
+event_ordered_ring_soring(struct rte_event_ordered_ring *r)
+{
+	return (struct rte_soring *)r;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_event_ordered_ring_create, 26.03)
+struct rte_event_ordered_ring *
+rte_event_ordered_ring_create(const char *name, unsigned int count,
+		unsigned int nb_stages, int socket_id, unsigned int flags)
+{
+	struct rte_soring_param prm = {
+		.name = name,
+		.elems = count,
+		.elem_size = sizeof(struct rte_event),
+		.stages = nb_stages,
+		.prod_synt = (flags & RING_F_SP_ENQ) ?
+			RTE_RING_SYNC_ST : RTE_RING_SYNC_MT,
+		.cons_synt = (flags & RING_F_SC_DEQ) ?
+			RTE_RING_SYNC_ST : RTE_RING_SYNC_MT,
+	};
+	struct rte_soring *sor;
+	ssize_t size;
+	int ret;
+
+	size = rte_soring_get_memsize(&prm);
+	if (size < 0) {
+		rte_errno = -size;
+		return NULL;
+	}
+
+	sor = rte_zmalloc_socket(name, size, RTE_CACHE_LINE_SIZE, socket_id);
+	if (sor == NULL) {
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	ret = rte_soring_init(sor, &prm);
+	if (ret != 0) {
+		rte_free(sor);
+		rte_errno = -ret;
+		return NULL;
+	}
+
+	return (struct rte_event_ordered_ring *)sor;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_event_ordered_ring_free, 26.03)
+void
+rte_event_ordered_ring_free(struct rte_event_ordered_ring *r)
+{
+	rte_free(r);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_event_ordered_ring_enqueue_burst, 26.03)
+unsigned int
+rte_event_ordered_ring_enqueue_burst(struct rte_event_ordered_ring *r,
+		const struct rte_event *events, unsigned int n,
+		uint32_t *free_space)
+{
+	return rte_soring_enqueue_burst(event_ordered_ring_soring(r), events,
+					n, free_space);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_event_ordered_ring_acquire_burst, 26.03)
+unsigned int
+rte_event_ordered_ring_acquire_burst(struct rte_event_ordered_ring *r,
+		struct rte_event *events, unsigned int stage, unsigned int n,
+		uint32_t *token, uint32_t *available)
+{
+	return rte_soring_acquire_burst(event_ordered_ring_soring(r), events,
+					stage, n, token, available);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_event_ordered_ring_release, 26.03)
+void
+rte_event_ordered_ring_release(struct rte_event_ordered_ring *r,
+		const struct rte_event *events, unsigned int stage,
+		unsigned int n, uint32_t token)
+{
+	rte_soring_release(event_ordered_ring_soring(r), events, stage, n,
+			   token);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_event_ordered_ring_dequeue_burst, 26.03)
+unsigned int
+rte_event_ordered_ring_dequeue_burst(struct rte_event_ordered_ring *r,
+		struct rte_event *events, unsigned int n, uint32_t *available)
+{
+	return rte_soring_dequeue_burst(event_ordered_ring_soring(r), events,
+					n, available);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_event_ordered_ring_count, 26.03)
+unsigned int
+rte_event_ordered_ring_count(const struct rte_event_ordered_ring *r)
+{
+	return rte_soring_count((const struct rte_soring *)r);
+}
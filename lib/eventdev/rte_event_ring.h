@@ -344,6 +344,176 @@ rte_event_ring_get_capacity(const struct rte_event_ring *r)
 	return rte_ring_get_capacity(&r->r);
 }
 
+/**
+ * Ordered event ring, built on the staged ordered ring (rte_soring).
+ *
+ * The events enqueued go through a number of stages. In each stage,
+ * several lcores may acquire and release events concurrently, in any
+ * order, but the events are dequeued in their enqueue order, after
+ * their release by the last stage. It gives ordered scheduling of
+ * a simple pipeline, without an event device.
+ *
+ * As the order is restored for all the events, it is also restored
+ * per flow. However, the events of a flow may be processed in parallel
+ * in a stage: no atomic scheduling is provided.
+ */
+struct rte_event_ordered_ring;
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free an ordered event ring.
+ *
+ * @param r
+ *   Ordered event ring to be freed, can be NULL.
+ */
+__rte_experimental
+void
+rte_event_ordered_ring_free(struct rte_event_ordered_ring *r);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create an ordered event ring.
+ *
+ * @param name
+ *   The name of the ring.
+ * @param count
+ *   The number of events of the ring, not necessarily a power of 2.
+ * @param nb_stages
+ *   The number of processing stages, at least 1.
+ * @param socket_id
+ *   The socket of the ring memory, or SOCKET_ID_ANY.
+ * @param flags
+ *   RING_F_SP_ENQ for a single producer, RING_F_SC_DEQ for a single
+ *   consumer, multi-producer and multi-consumer otherwise.
+ * @return
+ *   The ring, or NULL on error with rte_errno set:
+ *    - EINVAL - invalid count or number of stages
+ *    - ENOMEM - no memory for the ring
+ */
+__rte_experimental
+struct rte_event_ordered_ring *
+rte_event_ordered_ring_create(const char *name, unsigned int count,
+		unsigned int nb_stages, int socket_id, unsigned int flags)
+	__rte_malloc __rte_dealloc(rte_event_ordered_ring_free, 1);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enqueue events in an ordered event ring, for the first stage.
+ *
+ * @param r
+ *   The ordered event ring.
+ * @param events
+ *   The events to enqueue.
+ * @param n
+ *   The number of events.
+ * @param free_space
+ *   If non-NULL, returns the free space in the ring after the enqueue.
+ * @return
+ *   The number of events enqueued, 0 <= n' <= n.
+ */
+__rte_experimental
+unsigned int
+rte_event_ordered_ring_enqueue_burst(struct rte_event_ordered_ring *r,
+		const struct rte_event *events, unsigned int n,
+		uint32_t *free_space);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Acquire events released by the previous stage, or enqueued for the
+ * first stage. The lcore owns the events until it releases them.
+ *
+ * @param r
+ *   The ordered event ring.
+ * @param events
+ *   The array to copy the acquired events to.
+ * @param stage
+ *   The stage, from 0 to nb_stages - 1.
+ * @param n
+ *   The maximum number of events to acquire.
+ * @param token
+ *   Returns the token to pass to rte_event_ordered_ring_release().
+ * @param available
+ *   If non-NULL, returns the number of events left for this stage.
+ * @return
+ *   The number of events acquired, 0 <= n' <= n.
+ */
+__rte_experimental
+unsigned int
+rte_event_ordered_ring_acquire_burst(struct rte_event_ordered_ring *r,
+		struct rte_event *events, unsigned int stage, unsigned int n,
+		uint32_t *token, uint32_t *available);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Release the events acquired by a stage, to the next stage or to the
+ * dequeue after the last stage. The events keep their acquire order,
+ * whatever the order of the releases.
+ *
+ * @param r
+ *   The ordered event ring.
+ * @param events
+ *   The updated events to store in the ring, in acquire order,
+ *   or NULL to leave them unchanged.
+ * @param stage
+ *   The stage the events were acquired by.
+ * @param n
+ *   The number of events, as returned by the acquire.
+ * @param token
+ *   The token returned by the acquire.
+ */
+__rte_experimental
+void
+rte_event_ordered_ring_release(struct rte_event_ordered_ring *r,
+		const struct rte_event *events, unsigned int stage,
+		unsigned int n, uint32_t token);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Dequeue the events released by the last stage, in enqueue order.
+ *
+ * @param r
+ *   The ordered event ring.
+ * @param events
+ *   The array to copy the dequeued events to.
+ * @param n
+ *   The maximum number of events to dequeue.
+ * @param available
+ *   If non-NULL, returns the number of events left to dequeue.
+ * @return
+ *   The number of events dequeued, 0 <= n' <= n.
+ */
+__rte_experimental
+unsigned int
+rte_event_ordered_ring_dequeue_burst(struct rte_event_ordered_ring *r,
+		struct rte_event *events, unsigned int n, uint32_t *available);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Return the number of events in an ordered event ring, in any stage.
+ *
+ * @param r
+ *   The ordered event ring.
+ * @return
+ *   The number of events in the ring.
+ */
+__rte_experimental
+unsigned int
+rte_event_ordered_ring_count(const struct rte_event_ordered_ring *r);
+
 #ifdef __cplusplus
 }
 #endif
@@ -10,6 +10,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include <math.h>
+#include <sys/queue.h>
 
 #include <eal_export.h>
 #include <rte_memzone.h>
@@ -17,6 +18,7 @@
 #include <rte_malloc.h>
 #include <rte_mempool.h>
 #include <rte_common.h>
+#include <rte_spinlock.h>
 #include <rte_timer.h>
 #include <rte_service_component.h>
 #include <rte_telemetry.h>
@@ -41,6 +43,7 @@ RTE_LOG_REGISTER_SUFFIX(evtim_svc_logtype, adapter.timer.svc, NOTICE);
 static struct rte_event_timer_adapter *adapters;
 
 static const struct event_timer_adapter_ops swtim_ops;
+static const struct event_timer_adapter_ops swtw_ops;
 
 #define EVTIM_LOG(level, logtype, ...) \
 	RTE_LOG_LINE_PREFIX(level, logtype, \
@@ -241,7 +244,9 @@ rte_event_timer_adapter_create_ext(
 	 * implementation.
 	 */
 	if (adapter->ops == NULL)
-		adapter->ops = &swtim_ops;
+		adapter->ops = (adapter->data->conf.flags &
+				RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL) ?
+				&swtw_ops : &swtim_ops;
 
 	/* Allow driver to do some setup */
 	FUNC_PTR_OR_NULL_RET_WITH_ERRNO(adapter->ops->init, ENOTSUP);
@@ -390,7 +395,9 @@ rte_event_timer_adapter_lookup(uint16_t adapter_id)
 	 * implementation.
 	 */
 	if (adapter->ops == NULL)
-		adapter->ops = &swtim_ops;
+		adapter->ops = (adapter->data->conf.flags &
+				RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL) ?
+				&swtw_ops : &swtim_ops;
 
 	/* Set fast-path function pointers */
 	adapter->arm_burst = adapter->ops->arm_burst;
@@ -1084,8 +1091,8 @@ get_mapped_count_for_service(uint32_t service_id)
 static int
 swtim_start(const struct rte_event_timer_adapter *adapter)
 {
+	uint32_t service_id = adapter->data->service_id;
 	int mapped_count;
-	struct swtim *sw = swtim_pmd_priv(adapter);
 
 	/* Mapping the service to more than one service core can introduce
 	 * delays while one thread is waiting to acquire a lock, so only allow
@@ -1094,26 +1101,26 @@ swtim_start(const struct rte_event_timer_adapter *adapter)
 	 * Note: the service could be modified such that it spreads cores to
 	 * poll over multiple service instances.
 	 */
-	mapped_count = get_mapped_count_for_service(sw->service_id);
+	mapped_count = get_mapped_count_for_service(service_id);
 
 	if (mapped_count != 1)
 		return mapped_count < 1 ? -ENOENT : -ENOTSUP;
 
-	return rte_service_component_runstate_set(sw->service_id, 1);
+	return rte_service_component_runstate_set(service_id, 1);
 }
 
 static int
 swtim_stop(const struct rte_event_timer_adapter *adapter)
 {
+	uint32_t service_id = adapter->data->service_id;
 	int ret;
-	struct swtim *sw = swtim_pmd_priv(adapter);
 
-	ret = rte_service_component_runstate_set(sw->service_id, 0);
+	ret = rte_service_component_runstate_set(service_id, 0);
 	if (ret < 0)
 		return ret;
 
 	/* Wait for the service to complete its final iteration */
-	while (rte_service_may_be_active(sw->service_id))
+	while (rte_service_may_be_active(service_id))
 		rte_pause();
 
 	return 0;
@@ -1396,6 +1403,648 @@ static const struct event_timer_adapter_ops swtim_ops = {
 	.remaining_ticks_get = swtim_remaining_ticks_get,
 };
 
+/*
+ * Software timing wheel event timer adapter implementation
+ *
+ * Each lcore arming timers has its own hierarchical timing wheel, whose
+ * resolution is the adapter tick. A timer expiring in d ticks is queued in
+ * the level l for which 2^(SWTW_LEVEL_BITS * l) <= d < 2^(SWTW_LEVEL_BITS *
+ * (l + 1)), and the slots of the upper levels are cascaded to the lower
+ * levels as the wheel turns, so that arming, cancelling and expiring a timer
+ * are O(1). The wheels are turned by the service, under a lock per wheel
+ * which is otherwise only taken by the lcore arming the timers.
+ */
+#define SWTW_LEVEL_BITS 6
+#define SWTW_LEVEL_SLOTS (1 << SWTW_LEVEL_BITS)
+#define SWTW_LEVEL_MASK (SWTW_LEVEL_SLOTS - 1)
+#define SWTW_LEVELS 6
+/* The timers further away are queued at this distance, and cascaded again */
+#define SWTW_MAX_DELTA ((UINT64_C(1) << (SWTW_LEVEL_BITS * SWTW_LEVELS)) - 1)
+
+struct swtw_tim {
+	LIST_ENTRY(swtw_tim) next;
+	/* Expiry tick */
+	uint64_t expire;
+	/* Period in ticks of a periodic timer, 0 otherwise */
+	uint64_t period;
+	struct rte_event_timer *evtim;
+};
+
+LIST_HEAD(swtw_list, swtw_tim);
+
+struct __rte_cache_aligned swtw_wheel {
+	rte_spinlock_t lock;
+	/* Last tick processed */
+	uint64_t cur;
+	/* Number of timers armed */
+	uint32_t nb_timers;
+	/* Expired timers not enqueued yet, the event buffer being full */
+	struct swtw_list expired;
+	struct swtw_list slots[SWTW_LEVELS][SWTW_LEVEL_SLOTS];
+};
+
+struct swtw {
+	/* Identifier of service executing timer management logic. */
+	uint32_t service_id;
+	/* The tick resolution used by adapter instance. */
+	uint64_t timer_tick_ns;
+	/* Maximum timeout in ticks allowed by adapter instance. */
+	uint64_t max_tmo_ticks;
+	/* Cycle count of the tick 0, and cycles per tick */
+	uint64_t start_cycles;
+	uint64_t tick_cycles;
+	struct rte_reciprocal_u64 tick_cycles_inverse;
+	/* Last tick processed by the service */
+	uint64_t cur_tick;
+	/* A wheel could not be turned up to cur_tick */
+	bool wheel_behind;
+	/* Buffered timer expiry events to be enqueued to an event device. */
+	struct event_buffer buffer;
+	/* Statistics */
+	struct rte_event_timer_adapter_stats stats;
+	/* Mempool of timer objects */
+	struct rte_mempool *tim_pool;
+	/* Track which cores have actually armed a timer */
+	alignas(RTE_CACHE_LINE_SIZE) struct {
+		RTE_ATOMIC(uint16_t) v;
+	} in_use[RTE_MAX_LCORE];
+	/* Track which cores' timing wheels should be turned */
+	RTE_ATOMIC(unsigned int) poll_lcores[RTE_MAX_LCORE];
+	/* The number of wheels that should be turned */
+	RTE_ATOMIC(int) n_poll_lcores;
+	/* Timers which have expired and can be returned to a mempool */
+	struct swtw_tim *expired_timers[EXP_TIM_BUF_SZ];
+	/* The number of timers that can be returned to a mempool */
+	size_t n_expired_timers;
+	/* Timing wheel of each lcore */
+	struct swtw_wheel wheels[RTE_MAX_LCORE];
+};
+
+static inline struct swtw *
+swtw_pmd_priv(const struct rte_event_timer_adapter *adapter)
+{
+	return adapter->data->adapter_priv;
+}
+
+static inline uint64_t
+swtw_now(const struct swtw *sw)
+{
+	return rte_reciprocal_divide_u64(rte_get_timer_cycles() -
+			sw->start_cycles, &sw->tick_cycles_inverse);
+}
+
+static inline void
+swtw_wheel_add(struct swtw_wheel *w, struct swtw_tim *tim)
+{
+	uint64_t delta = RTE_MIN(tim->expire - w->cur, SWTW_MAX_DELTA);
+	unsigned int level = 0;
+
+	if (delta >= SWTW_LEVEL_SLOTS)
+		level = (rte_fls_u64(delta) - 1) / SWTW_LEVEL_BITS;
+
+	LIST_INSERT_HEAD(&w->slots[level][((w->cur + delta) >>
+			(level * SWTW_LEVEL_BITS)) & SWTW_LEVEL_MASK], tim, next);
+}
+
+/* Queue again the timers of a slot, once the wheel is closer to them. */
+static inline void
+swtw_wheel_cascade(struct swtw_wheel *w, struct swtw_list *slot)
+{
+	struct swtw_tim *tim;
+
+	while ((tim = LIST_FIRST(slot)) != NULL) {
+		LIST_REMOVE(tim, next);
+		swtw_wheel_add(w, tim);
+	}
+}
+
+static inline void
+swtw_buffer_flush(struct swtw *sw, const struct rte_event_timer_adapter *adapter)
+{
+	uint16_t nb_evs_flushed = 0;
+	uint16_t nb_evs_invalid = 0;
+
+	event_buffer_flush(&sw->buffer,
+			   adapter->data->event_dev_id,
+			   adapter->data->event_port_id,
+			   &nb_evs_flushed,
+			   &nb_evs_invalid);
+
+	sw->stats.ev_enq_count += nb_evs_flushed;
+	sw->stats.ev_inv_count += nb_evs_invalid;
+}
+
+/* Buffer the events of the expired timers, false if the buffer is full. */
+static bool
+swtw_wheel_expire(struct swtw *sw, const struct rte_event_timer_adapter *adapter,
+		  struct swtw_wheel *w)
+{
+	struct swtw_tim *tim;
+
+	while ((tim = LIST_FIRST(&w->expired)) != NULL) {
+		if (event_buffer_add(&sw->buffer, &tim->evtim->ev) < 0) {
+			swtw_buffer_flush(sw, adapter);
+			if (event_buffer_add(&sw->buffer, &tim->evtim->ev) < 0) {
+				sw->stats.evtim_retry_count++;
+				return false;
+			}
+		}
+
+		LIST_REMOVE(tim, next);
+		sw->stats.evtim_exp_count++;
+
+		if (tim->period != 0) {
+			tim->expire = RTE_MAX(tim->expire + tim->period,
+					      w->cur + 1);
+			swtw_wheel_add(w, tim);
+		} else {
+			w->nb_timers--;
+			if (unlikely(sw->n_expired_timers == EXP_TIM_BUF_SZ)) {
+				rte_mempool_put_bulk(sw->tim_pool,
+						     (void **)sw->expired_timers,
+						     sw->n_expired_timers);
+				sw->n_expired_timers = 0;
+			}
+			sw->expired_timers[sw->n_expired_timers++] = tim;
+			rte_atomic_store_explicit(&tim->evtim->state,
+					RTE_EVENT_TIMER_NOT_ARMED,
+					rte_memory_order_release);
+		}
+
+		if (event_buffer_batch_ready(&sw->buffer))
+			swtw_buffer_flush(sw, adapter);
+	}
+
+	return true;
+}
+
+/* Turn a wheel up to the tick now, false if it could not get there. */
+static bool
+swtw_wheel_turn(struct swtw *sw, const struct rte_event_timer_adapter *adapter,
+		struct swtw_wheel *w, uint64_t now)
+{
+	struct swtw_list *slot;
+	struct swtw_tim *first;
+	int level;
+
+	if (!swtw_wheel_expire(sw, adapter, w))
+		return false;
+
+	if (w->nb_timers == 0) {
+		w->cur = RTE_MAX(w->cur, now);
+		return true;
+	}
+
+	while (w->cur < now) {
+		w->cur++;
+
+		for (level = SWTW_LEVELS - 1; level > 0; level--) {
+			if (w->cur & ((UINT64_C(1) << (level * SWTW_LEVEL_BITS)) - 1))
+				continue;
+			swtw_wheel_cascade(w, &w->slots[level][(w->cur >>
+					(level * SWTW_LEVEL_BITS)) & SWTW_LEVEL_MASK]);
+		}
+
+		/* Move the timers of the slot to the expired list */
+		slot = &w->slots[0][w->cur & SWTW_LEVEL_MASK];
+		first = LIST_FIRST(slot);
+		if (first == NULL)
+			continue;
+		LIST_FIRST(&w->expired) = first;
+		first->next.le_prev = &LIST_FIRST(&w->expired);
+		LIST_INIT(slot);
+
+		if (!swtw_wheel_expire(sw, adapter, w))
+			return false;
+	}
+
+	return true;
+}
+
+static int
+swtw_service_func(void *arg)
+{
+	struct rte_event_timer_adapter *adapter = arg;
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	const uint64_t prior_enq_count = sw->stats.ev_enq_count;
+	struct swtw_wheel *w;
+	uint64_t now;
+	int i, n;
+
+	now = swtw_now(sw);
+	if (now != sw->cur_tick || sw->wheel_behind) {
+		sw->wheel_behind = false;
+		n = rte_atomic_load_explicit(&sw->n_poll_lcores,
+					     rte_memory_order_relaxed);
+		for (i = 0; i < n; i++) {
+			w = &sw->wheels[rte_atomic_load_explicit(&sw->poll_lcores[i],
+					rte_memory_order_relaxed)];
+			rte_spinlock_lock(&w->lock);
+			if (!swtw_wheel_turn(sw, adapter, w, now))
+				sw->wheel_behind = true;
+			rte_spinlock_unlock(&w->lock);
+		}
+
+		/* Return expired timer objects back to mempool */
+		rte_mempool_put_bulk(sw->tim_pool, (void **)sw->expired_timers,
+				     sw->n_expired_timers);
+		sw->n_expired_timers = 0;
+
+		sw->stats.adapter_tick_count += now - sw->cur_tick;
+		sw->cur_tick = now;
+	}
+
+	swtw_buffer_flush(sw, adapter);
+
+	rte_event_maintain(adapter->data->event_dev_id,
+			   adapter->data->event_port_id, 0);
+
+	return prior_enq_count == sw->stats.ev_enq_count ? -EAGAIN : 0;
+}
+
+static int
+swtw_init(struct rte_event_timer_adapter *adapter)
+{
+	struct rte_service_spec service;
+	char name[SWTIM_NAMESIZE];
+	struct swtw *sw;
+	int i, ret;
+
+	snprintf(name, SWTIM_NAMESIZE, "swtw_%"PRIu8, adapter->data->id);
+	sw = rte_zmalloc_socket(name, sizeof(*sw), RTE_CACHE_LINE_SIZE,
+			adapter->data->socket_id);
+	if (sw == NULL) {
+		EVTIM_LOG_ERR("failed to allocate space for private data");
+		rte_errno = ENOMEM;
+		return -1;
+	}
+
+	adapter->data->adapter_priv = sw;
+
+	sw->timer_tick_ns = adapter->data->conf.timer_tick_ns;
+	sw->max_tmo_ticks = adapter->data->conf.max_tmo_ns / sw->timer_tick_ns;
+	sw->tick_cycles = RTE_MAX((uint64_t)((double)sw->timer_tick_ns *
+			rte_get_timer_hz() / NSECPERSEC), UINT64_C(1));
+	sw->tick_cycles_inverse = rte_reciprocal_value_u64(sw->tick_cycles);
+	sw->start_cycles = rte_get_timer_cycles();
+
+	/* Create a timer pool */
+	snprintf(name, SWTIM_NAMESIZE, "swtw_pool_%"PRIu8, adapter->data->id);
+	/* Optimal mempool size is a power of 2 minus one */
+	uint64_t nb_timers = rte_align64pow2(adapter->data->conf.nb_timers);
+	int pool_size = nb_timers - 1;
+	int cache_size = compute_msg_mempool_cache_size(
+				adapter->data->conf.nb_timers, nb_timers);
+	sw->tim_pool = rte_mempool_create(name, pool_size,
+			sizeof(struct swtw_tim), cache_size, 0, NULL, NULL,
+			NULL, NULL, adapter->data->socket_id, 0);
+	if (sw->tim_pool == NULL) {
+		EVTIM_LOG_ERR("failed to create timer object mempool");
+		rte_errno = ENOMEM;
+		goto free_alloc;
+	}
+
+	for (i = 0; i < RTE_MAX_LCORE; i++) {
+		struct swtw_wheel *w = &sw->wheels[i];
+		int l, s;
+
+		rte_spinlock_init(&w->lock);
+		LIST_INIT(&w->expired);
+		for (l = 0; l < SWTW_LEVELS; l++)
+			for (s = 0; s < SWTW_LEVEL_SLOTS; s++)
+				LIST_INIT(&w->slots[l][s]);
+	}
+
+	event_buffer_init(&sw->buffer);
+
+	/* Register a service component to run adapter logic */
+	memset(&service, 0, sizeof(service));
+	snprintf(service.name, RTE_SERVICE_NAME_MAX,
+		 "swtim_svc_%"PRIu8, adapter->data->id);
+	service.socket_id = adapter->data->socket_id;
+	service.callback = swtw_service_func;
+	service.callback_userdata = adapter;
+	service.capabilities &= ~(RTE_SERVICE_CAP_MT_SAFE);
+	ret = rte_service_component_register(&service, &sw->service_id);
+	if (ret < 0) {
+		EVTIM_LOG_ERR("failed to register service %s with id %"PRIu32
+			      ": err = %d", service.name, sw->service_id,
+			      ret);
+
+		rte_errno = ENOSPC;
+		goto free_mempool;
+	}
+
+	EVTIM_LOG_DBG("registered service %s with id %"PRIu32, service.name,
+		      sw->service_id);
+
+	adapter->data->service_id = sw->service_id;
+	adapter->data->service_inited = 1;
+
+	return 0;
+free_mempool:
+	rte_mempool_free(sw->tim_pool);
+free_alloc:
+	rte_free(sw);
+	return -1;
+}
+
+static int
+swtw_uninit(struct rte_event_timer_adapter *adapter)
+{
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	int ret;
+
+	ret = rte_service_component_unregister(sw->service_id);
+	if (ret < 0) {
+		EVTIM_LOG_ERR("failed to unregister service component");
+		return ret;
+	}
+
+	/* The outstanding timers are freed along with the mempool */
+	rte_mempool_free(sw->tim_pool);
+	rte_free(sw);
+	adapter->data->adapter_priv = NULL;
+
+	return 0;
+}
+
+static void
+swtw_get_info(const struct rte_event_timer_adapter *adapter,
+		struct rte_event_timer_adapter_info *adapter_info)
+{
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	adapter_info->min_resolution_ns = sw->timer_tick_ns;
+	adapter_info->max_tmo_ns = sw->max_tmo_ticks * sw->timer_tick_ns;
+}
+
+static int
+swtw_stats_get(const struct rte_event_timer_adapter *adapter,
+		struct rte_event_timer_adapter_stats *stats)
+{
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	*stats = sw->stats; /* structure copy */
+	return 0;
+}
+
+static int
+swtw_stats_reset(const struct rte_event_timer_adapter *adapter)
+{
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	memset(&sw->stats, 0, sizeof(sw->stats));
+	return 0;
+}
+
+static int
+swtw_remaining_ticks_get(const struct rte_event_timer_adapter *adapter,
+			 const struct rte_event_timer *evtim,
+			 uint64_t *ticks_remaining)
+{
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	enum rte_event_timer_state n_state;
+	struct swtw_tim *tim;
+	uint64_t now;
+
+	/* Check that timer is armed */
+	n_state = rte_atomic_load_explicit(&evtim->state, rte_memory_order_acquire);
+	if (n_state != RTE_EVENT_TIMER_ARMED)
+		return -EINVAL;
+
+	tim = (struct swtw_tim *)(uintptr_t)evtim->impl_opaque[0];
+	now = swtw_now(sw);
+	*ticks_remaining = tim->expire > now + 1 ? tim->expire - now - 1 : 0;
+
+	return 0;
+}
+
+static uint16_t
+__swtw_arm_burst(const struct rte_event_timer_adapter *adapter,
+		 struct rte_event_timer **evtims,
+		 uint16_t nb_evtims)
+{
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	uint32_t lcore_id = rte_lcore_id();
+	struct swtw_tim *tim, *tims[nb_evtims];
+	enum rte_event_timer_state n_state;
+	/* Timing wheel for this lcore is not in use. */
+	uint16_t exp_state = 0;
+	struct swtw_wheel *w;
+	bool periodic;
+	uint64_t now;
+	int i, ret;
+	int n_lcores;
+
+#ifdef RTE_LIBRTE_EVENTDEV_DEBUG
+	/* Check that the service is running. */
+	if (rte_service_runstate_get(adapter->data->service_id) != 1) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+#endif
+
+	/* Adjust lcore_id if non-EAL thread. Arbitrarily pick the timing wheel
+	 * of the highest lcore to insert such timers into
+	 */
+	if (lcore_id == LCORE_ID_ANY)
+		lcore_id = RTE_MAX_LCORE - 1;
+
+	/* If this is the first time we're arming an event timer on this lcore,
+	 * mark this lcore as "in use", so that the service turns its wheel.
+	 */
+	if (unlikely(rte_atomic_compare_exchange_strong_explicit(&sw->in_use[lcore_id].v,
+			&exp_state, 1,
+			rte_memory_order_relaxed, rte_memory_order_relaxed))) {
+		EVTIM_LOG_DBG("Adding lcore id = %u to list of lcores to poll",
+			      lcore_id);
+		n_lcores = rte_atomic_fetch_add_explicit(&sw->n_poll_lcores, 1,
+					     rte_memory_order_relaxed);
+		rte_atomic_store_explicit(&sw->poll_lcores[n_lcores], lcore_id,
+				rte_memory_order_relaxed);
+	}
+
+	ret = rte_mempool_get_bulk(sw->tim_pool, (void **)tims, nb_evtims);
+	if (ret < 0) {
+		rte_errno = ENOSPC;
+		return 0;
+	}
+
+	periodic = get_timer_type(adapter) == PERIODICAL;
+	w = &sw->wheels[lcore_id];
+	now = swtw_now(sw);
+
+	rte_spinlock_lock(&w->lock);
+	/* The wheel is not turned while unused, catch up */
+	if (w->nb_timers == 0)
+		w->cur = RTE_MAX(w->cur, now);
+	for (i = 0; i < nb_evtims; i++) {
+		n_state = rte_atomic_load_explicit(&evtims[i]->state, rte_memory_order_acquire);
+		if (n_state == RTE_EVENT_TIMER_ARMED) {
+			rte_errno = EALREADY;
+			break;
+		} else if (!(n_state == RTE_EVENT_TIMER_NOT_ARMED ||
+			     n_state == RTE_EVENT_TIMER_CANCELED)) {
+			rte_errno = EINVAL;
+			break;
+		}
+
+		if (unlikely(check_destination_event_queue(evtims[i],
+							   adapter) < 0)) {
+			rte_atomic_store_explicit(&evtims[i]->state,
+					RTE_EVENT_TIMER_ERROR,
+					rte_memory_order_relaxed);
+			rte_errno = EINVAL;
+			break;
+		}
+
+		if (unlikely(evtims[i]->timeout_ticks > sw->max_tmo_ticks)) {
+			rte_atomic_store_explicit(&evtims[i]->state,
+					RTE_EVENT_TIMER_ERROR_TOOLATE,
+					rte_memory_order_relaxed);
+			rte_errno = EINVAL;
+			break;
+		} else if (unlikely(evtims[i]->timeout_ticks == 0)) {
+			rte_atomic_store_explicit(&evtims[i]->state,
+					RTE_EVENT_TIMER_ERROR_TOOEARLY,
+					rte_memory_order_relaxed);
+			rte_errno = EINVAL;
+			break;
+		}
+
+		tim = tims[i];
+		tim->evtim = evtims[i];
+		/* Round up to the next tick, not to expire early */
+		tim->expire = RTE_MAX(now + evtims[i]->timeout_ticks + 1,
+				      w->cur + 1);
+		tim->period = periodic ? evtims[i]->timeout_ticks : 0;
+		swtw_wheel_add(w, tim);
+		w->nb_timers++;
+
+		evtims[i]->impl_opaque[0] = (uintptr_t)tim;
+		evtims[i]->impl_opaque[1] = lcore_id;
+
+		EVTIM_LOG_DBG("armed an event timer");
+		/* RELEASE ordering guarantees the adapter specific value
+		 * changes observed before the update of state.
+		 */
+		rte_atomic_store_explicit(&evtims[i]->state, RTE_EVENT_TIMER_ARMED,
+				rte_memory_order_release);
+	}
+	rte_spinlock_unlock(&w->lock);
+
+	if (i < nb_evtims)
+		rte_mempool_put_bulk(sw->tim_pool,
+				     (void **)&tims[i], nb_evtims - i);
+
+	return i;
+}
+
+static uint16_t
+swtw_arm_burst(const struct rte_event_timer_adapter *adapter,
+	       struct rte_event_timer **evtims,
+	       uint16_t nb_evtims)
+{
+	return __swtw_arm_burst(adapter, evtims, nb_evtims);
+}
+
+static uint16_t
+swtw_cancel_burst(const struct rte_event_timer_adapter *adapter,
+		  struct rte_event_timer **evtims,
+		  uint16_t nb_evtims)
+{
+	struct swtw *sw = swtw_pmd_priv(adapter);
+	struct swtw_tim *tim, *tims[nb_evtims];
+	enum rte_event_timer_state n_state;
+	struct swtw_wheel *w = NULL, *tw;
+	int i;
+
+#ifdef RTE_LIBRTE_EVENTDEV_DEBUG
+	/* Check that the service is running. */
+	if (rte_service_runstate_get(adapter->data->service_id) != 1) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+#endif
+
+	for (i = 0; i < nb_evtims; i++) {
+		/* Don't modify the event timer state in these cases */
+		/* ACQUIRE ordering guarantees the access of implementation
+		 * specific opaque data under the correct state.
+		 */
+		n_state = rte_atomic_load_explicit(&evtims[i]->state, rte_memory_order_acquire);
+		if (n_state == RTE_EVENT_TIMER_CANCELED) {
+			rte_errno = EALREADY;
+			break;
+		} else if (n_state != RTE_EVENT_TIMER_ARMED) {
+			rte_errno = EINVAL;
+			break;
+		}
+
+		/* Keep the wheel locked for the timers armed on the same lcore */
+		tw = &sw->wheels[evtims[i]->impl_opaque[1]];
+		if (tw != w) {
+			if (w != NULL)
+				rte_spinlock_unlock(&w->lock);
+			w = tw;
+			rte_spinlock_lock(&w->lock);
+		}
+
+		/* The timer may have expired in the meantime */
+		n_state = rte_atomic_load_explicit(&evtims[i]->state, rte_memory_order_relaxed);
+		if (n_state != RTE_EVENT_TIMER_ARMED) {
+			rte_errno = EINVAL;
+			break;
+		}
+
+		tim = (struct swtw_tim *)(uintptr_t)evtims[i]->impl_opaque[0];
+		RTE_ASSERT(tim != NULL);
+		LIST_REMOVE(tim, next);
+		w->nb_timers--;
+		tims[i] = tim;
+
+		/* The RELEASE ordering here pairs with atomic ordering
+		 * to make sure the state update data observed between
+		 * threads.
+		 */
+		rte_atomic_store_explicit(&evtims[i]->state, RTE_EVENT_TIMER_CANCELED,
+				rte_memory_order_release);
+	}
+	if (w != NULL)
+		rte_spinlock_unlock(&w->lock);
+
+	if (i > 0)
+		rte_mempool_put_bulk(sw->tim_pool, (void **)tims, i);
+
+	return i;
+}
+
+static uint16_t
+swtw_arm_tmo_tick_burst(const struct rte_event_timer_adapter *adapter,
+			struct rte_event_timer **evtims,
+			uint64_t timeout_ticks,
+			uint16_t nb_evtims)
+{
+	int i;
+
+	for (i = 0; i < nb_evtims; i++)
+		evtims[i]->timeout_ticks = timeout_ticks;
+
+	return __swtw_arm_burst(adapter, evtims, nb_evtims);
+}
+
+static const struct event_timer_adapter_ops swtw_ops = {
+	.init = swtw_init,
+	.uninit = swtw_uninit,
+	.start = swtim_start,
+	.stop = swtim_stop,
+	.get_info = swtw_get_info,
+	.stats_get = swtw_stats_get,
+	.stats_reset = swtw_stats_reset,
+	.arm_burst = swtw_arm_burst,
+	.arm_tmo_tick_burst = swtw_arm_tmo_tick_burst,
+	.cancel_burst = swtw_cancel_burst,
+	.remaining_ticks_get = swtw_remaining_ticks_get,
+};
+
 static int
 handle_ta_info(const char *cmd __rte_unused, const char *params,
 		struct rte_tel_data *d)
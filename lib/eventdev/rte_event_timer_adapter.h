@@ -157,6 +157,18 @@ enum rte_event_timer_adapter_clk_src {
  * @see struct rte_event_timer_adapter_conf::flags
  */
 
+#define RTE_EVENT_TIMER_ADAPTER_F_TIMER_WHEEL	(1ULL << 3)
+/**< Flag to use hierarchical timing wheels in the software event timer
+ * adapter, instead of the timer library. Each lcore arming timers has its
+ * own wheel, arming and cancelling a timer are O(1) and bursts of timers
+ * are armed or cancelled under a single lock, which scales to a large
+ * number of timers such as the connection tracking timeouts.
+ * This flag is ignored by the event devices having their own timer adapter
+ * implementation.
+ *
+ * @see struct rte_event_timer_adapter_conf::flags
+ */
+
 /**
  * Timer adapter configuration structure
  */
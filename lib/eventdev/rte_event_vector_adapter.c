@@ -30,6 +30,7 @@
 #define SERVICE_RING_SZ	    1024
 #define SERVICE_DEQ_SZ	    16
 #define SERVICE_PEND_LIST   32
+#define ADAPTIVE_SZ_SHIFT   3
 
 RTE_LOG_REGISTER_SUFFIX(ev_vector_logtype, adapter.vector, NOTICE);
 #define RTE_LOGTYPE_EVVEC ev_vector_logtype
@@ -237,6 +238,13 @@ rte_event_vector_adapter_create_ext(const struct rte_event_vector_adapter_conf *
 		info = sw_info;
 	}
 
+	if ((conf->flags & RTE_EVENT_VECTOR_ADAPTER_CFG_ADAPTIVE) && adapter->ops != &sw_ops) {
+		adapter->ops = NULL;
+		EVVEC_LOG_DBG("adaptive vector size is not supported");
+		rte_errno = ENOTSUP;
+		goto error;
+	}
+
 	rc = validate_conf(conf, &info);
 	if (rc < 0) {
 		adapter->ops = NULL;
@@ -496,9 +504,13 @@ struct sw_vector_adapter_data {
 	uint8_t dev_id;
 	uint8_t port_id;
 	uint16_t vector_sz;
+	/* Vector size and timeout in use, reduced when adaptive */
+	uint16_t cur_vector_sz;
+	uint16_t min_vector_sz;
 	uint64_t timestamp;
 	uint64_t event_meta;
 	uint64_t vector_tmo_ticks;
+	uint64_t cur_tmo_ticks;
 	uint64_t fallback_event_meta;
 	struct rte_mempool *vector_mp;
 	struct rte_event_vector *vector;
@@ -522,6 +534,13 @@ sw_vector_adapter_priv(const struct rte_event_vector_adapter *adapter)
 	return adapter->data->adapter_priv;
 }
 
+static inline void
+sw_vector_adapter_resize(struct sw_vector_adapter_data *sw, uint16_t sz)
+{
+	sw->cur_vector_sz = sz;
+	sw->cur_tmo_ticks = sw->vector_tmo_ticks * sz / sw->vector_sz;
+}
+
 static int
 sw_vector_adapter_flush(struct sw_vector_adapter_data *sw)
 {
@@ -535,16 +554,35 @@ sw_vector_adapter_flush(struct sw_vector_adapter_data *sw)
 	if (rte_event_enqueue_burst(sw->dev_id, sw->port_id, &ev, 1) != 1)
 		return -ENOSPC;
 
+	sw->stats.vector_elems += sw->vector->nb_elem;
 	sw->vector = NULL;
 	sw->timestamp = 0;
 	return 0;
 }
 
+/* Shrink the adaptive vector size when the vectors time out */
+static inline void
+sw_vector_adapter_timedout(struct sw_vector_adapter_data *sw)
+{
+	sw->stats.vectors_timedout++;
+	if (sw->cur_vector_sz > sw->min_vector_sz)
+		sw_vector_adapter_resize(sw, RTE_MAX(sw->cur_vector_sz >> 1, sw->min_vector_sz));
+}
+
+/* Grow the adaptive vector size when the vectors fill up */
+static inline void
+sw_vector_adapter_filled(struct sw_vector_adapter_data *sw)
+{
+	sw->stats.vectorized++;
+	if (sw->cur_vector_sz < sw->vector_sz)
+		sw_vector_adapter_resize(sw, RTE_MIN(sw->cur_vector_sz << 1, sw->vector_sz));
+}
+
 static void
 sw_vector_adapter_process_pend_list(struct sw_vector_adapter_service_data *service_data)
 {
 	struct sw_vector_adapter_data *sw;
-	int i;
+	int i, ret;
 
 	if (service_data->pend_list == 0)
 		return;
@@ -562,11 +600,14 @@ sw_vector_adapter_process_pend_list(struct sw_vector_adapter_service_data *servi
 		}
 
 		rte_spinlock_lock(&sw->lock);
-		if (rte_get_tsc_cycles() - sw->timestamp >= sw->vector_tmo_ticks) {
-			if (sw_vector_adapter_flush(sw) != -ENOSPC) {
+		if (rte_get_tsc_cycles() - sw->timestamp >= sw->cur_tmo_ticks) {
+			ret = sw_vector_adapter_flush(sw);
+			if (ret != -ENOSPC) {
 				service_data->pend[i] = NULL;
 				service_data->pend_list--;
 			}
+			if (ret == 0)
+				sw_vector_adapter_timedout(sw);
 		}
 		rte_spinlock_unlock(&sw->lock);
 	}
@@ -599,7 +640,7 @@ sw_vector_adapter_service_func(void *arg)
 {
 	struct sw_vector_adapter_service_data *service_data = arg;
 	struct sw_vector_adapter_data *sw[SERVICE_DEQ_SZ];
-	int n, i;
+	int n, i, ret;
 
 	sw_vector_adapter_process_pend_list(service_data);
 	/* Dequeue the adapter list and flush the vectors */
@@ -609,17 +650,18 @@ sw_vector_adapter_service_func(void *arg)
 		if (sw[i]->vector == NULL)
 			continue;
 
-		if (rte_get_tsc_cycles() - sw[i]->timestamp < sw[i]->vector_tmo_ticks) {
+		if (rte_get_tsc_cycles() - sw[i]->timestamp < sw[i]->cur_tmo_ticks) {
 			sw_vector_adapter_add_to_pend_list(service_data, sw[i]);
 		} else {
 			if (!rte_spinlock_trylock(&sw[i]->lock)) {
 				sw_vector_adapter_add_to_pend_list(service_data, sw[i]);
 				continue;
 			}
-			if (sw_vector_adapter_flush(sw[i]) == -ENOSPC)
+			ret = sw_vector_adapter_flush(sw[i]);
+			if (ret == -ENOSPC)
 				sw_vector_adapter_add_to_pend_list(service_data, sw[i]);
-			else
-				sw[i]->stats.vectors_timedout++;
+			else if (ret == 0)
+				sw_vector_adapter_timedout(sw[i]);
 			rte_spinlock_unlock(&sw[i]->lock);
 		}
 	}
@@ -712,6 +754,10 @@ sw_vector_adapter_create(struct rte_event_vector_adapter *adapter)
 	sw->vector_sz = adapter->data->conf.vector_sz;
 	sw->vector_mp = adapter->data->conf.vector_mp;
 	sw->vector_tmo_ticks = NSEC2TICK(adapter->data->conf.vector_timeout_ns, rte_get_timer_hz());
+	sw->min_vector_sz = sw->vector_sz;
+	if (adapter->data->conf.flags & RTE_EVENT_VECTOR_ADAPTER_CFG_ADAPTIVE)
+		sw->min_vector_sz = RTE_MAX(sw->vector_sz >> ADAPTIVE_SZ_SHIFT, MIN_VECTOR_SIZE);
+	sw_vector_adapter_resize(sw, sw->vector_sz);
 
 	ev = adapter->data->conf.ev;
 	ev.op = RTE_EVENT_OP_NEW;
@@ -798,17 +844,17 @@ sw_vector_adapter_enqueue(struct rte_event_vector_adapter *adapter, uint64_t obj
 			sw->vector->attr_valid = 0;
 			sw->vector->elem_offset = 0;
 		}
-		n = RTE_MIN(sw->vector_sz - sw->vector->nb_elem, num_elem);
+		n = RTE_MIN(sw->cur_vector_sz - sw->vector->nb_elem, num_elem);
 		memcpy(&sw->vector->u64s[sw->vector->nb_elem], objs, n * sizeof(uint64_t));
 		sw->vector->nb_elem += n;
 		num_elem -= n;
 		objs += n;
 
-		if (sw->vector_sz == sw->vector->nb_elem) {
+		if (sw->cur_vector_sz == sw->vector->nb_elem) {
 			ret = sw_vector_adapter_flush(sw);
 			if (ret)
 				goto done;
-			sw->stats.vectorized++;
+			sw_vector_adapter_filled(sw);
 		}
 	}
 
@@ -835,6 +881,7 @@ sw_vector_adapter_stats_get(const struct rte_event_vector_adapter *adapter,
 	struct sw_vector_adapter_data *sw = sw_vector_adapter_priv(adapter);
 
 	*stats = sw->stats;
+	stats->vector_sz = sw->cur_vector_sz;
 	return 0;
 }
 
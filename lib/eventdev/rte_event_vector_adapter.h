@@ -130,6 +130,16 @@ extern "C" {
 #define RTE_EVENT_VECTOR_ENQ_FLUSH RTE_BIT64(2)
 /**< Flush any in-progress vector aggregation. */
 
+#define RTE_EVENT_VECTOR_ADAPTER_CFG_ADAPTIVE RTE_BIT64(0)
+/**< The vector size and timeout adapt to the load: the configured
+ *  rte_event_vector_adapter_conf::vector_sz and
+ *  rte_event_vector_adapter_conf::vector_timeout_ns are the maximum values,
+ *  used under load, and they are reduced down to 1/8 when the vectors time
+ *  out, to cut the latency at low load.
+ *  Only supported by the software vector adapter.
+ *  @see rte_event_vector_adapter_conf::flags
+ */
+
 /**
  * Vector adapter configuration structure
  */
@@ -181,6 +191,11 @@ struct rte_event_vector_adapter_conf {
 	 * rte_event_vector container.
 	 * @see rte_event_vector_pool_create
 	 */
+	uint64_t flags;
+	/**<
+	 * Vector adapter configuration flags.
+	 * @see RTE_EVENT_VECTOR_ADAPTER_CFG_ADAPTIVE
+	 */
 };
 
 /**
@@ -213,6 +228,15 @@ struct rte_event_vector_adapter_stats {
 	/**< Number of vectors flushed */
 	uint64_t alloc_failures;
 	/**< Number of vector allocation failures */
+	uint64_t vector_elems;
+	/**< Number of objects in the enqueued vectors. The average fill ratio
+	 *  of the vectors is vector_elems divided by the number of vectors
+	 *  (vectorized + vectors_timedout + vectors_flushed) and vector_sz.
+	 */
+	uint16_t vector_sz;
+	/**< Vector size in use, lower than the configured one with
+	 *  #RTE_EVENT_VECTOR_ADAPTER_CFG_ADAPTIVE
+	 */
 };
 
 struct rte_event_vector_adapter;
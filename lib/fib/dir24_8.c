@@ -27,6 +27,10 @@
 
 #endif /* CC_AVX512_SUPPORT */
 
+#ifdef RTE_ARCH_X86_64
+#include "dir24_8_avx2.h"
+#endif
+
 #define DIR24_8_NAMESIZE	64
 
 #define ROUNDUP(x, y)	 RTE_ALIGN_CEIL(x, (1 << (32 - y)))
@@ -116,6 +120,37 @@ get_vector_fn(enum rte_fib_dir24_8_nh_sz nh_sz, bool be_addr)
 	return NULL;
 }
 
+static inline rte_fib_lookup_fn_t
+get_avx2_fn(enum rte_fib_dir24_8_nh_sz nh_sz, bool be_addr)
+{
+#ifdef RTE_ARCH_X86_64
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2) <= 0 ||
+			rte_vect_get_max_simd_bitwidth() < RTE_VECT_SIMD_256)
+		return NULL;
+
+	switch (nh_sz) {
+	case RTE_FIB_DIR24_8_1B:
+		return be_addr ? rte_dir24_8_avx2_lookup_bulk_1b_be :
+			rte_dir24_8_avx2_lookup_bulk_1b;
+	case RTE_FIB_DIR24_8_2B:
+		return be_addr ? rte_dir24_8_avx2_lookup_bulk_2b_be :
+			rte_dir24_8_avx2_lookup_bulk_2b;
+	case RTE_FIB_DIR24_8_4B:
+		return be_addr ? rte_dir24_8_avx2_lookup_bulk_4b_be :
+			rte_dir24_8_avx2_lookup_bulk_4b;
+	case RTE_FIB_DIR24_8_8B:
+		return be_addr ? rte_dir24_8_avx2_lookup_bulk_8b_be :
+			rte_dir24_8_avx2_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+#else
+	RTE_SET_USED(nh_sz);
+	RTE_SET_USED(be_addr);
+#endif
+	return NULL;
+}
+
 rte_fib_lookup_fn_t
 dir24_8_get_lookup_fn(void *p, enum rte_fib_lookup_type type, bool be_addr)
 {
@@ -137,8 +172,12 @@ dir24_8_get_lookup_fn(void *p, enum rte_fib_lookup_type type, bool be_addr)
 		return be_addr ? dir24_8_lookup_bulk_uni_be : dir24_8_lookup_bulk_uni;
 	case RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512:
 		return get_vector_fn(nh_sz, be_addr);
+	case RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX2:
+		return get_avx2_fn(nh_sz, be_addr);
 	case RTE_FIB_LOOKUP_DEFAULT:
 		ret_fn = get_vector_fn(nh_sz, be_addr);
+		if (ret_fn == NULL)
+			ret_fn = get_avx2_fn(nh_sz, be_addr);
 		return ret_fn != NULL ? ret_fn : get_scalar_fn(nh_sz, be_addr);
 	default:
 		return NULL;
@@ -200,32 +239,6 @@ tbl8_free_idx(struct dir24_8_tbl *dp, int idx)
 		~(1ULL << (idx & BITMAP_SLAB_BITMASK));
 }
 
-static int
-tbl8_alloc(struct dir24_8_tbl *dp, uint64_t nh)
-{
-	int64_t	tbl8_idx;
-	uint8_t	*tbl8_ptr;
-
-	tbl8_idx = tbl8_get_idx(dp);
-
-	/* If there are no tbl8 groups try to reclaim one. */
-	if (unlikely(tbl8_idx == -ENOSPC && dp->dq &&
-			!rte_rcu_qsbr_dq_reclaim(dp->dq, 1, NULL, NULL, NULL)))
-		tbl8_idx = tbl8_get_idx(dp);
-
-	if (tbl8_idx < 0)
-		return tbl8_idx;
-	tbl8_ptr = (uint8_t *)dp->tbl8 +
-		((tbl8_idx * DIR24_8_TBL8_GRP_NUM_ENT) <<
-		dp->nh_sz);
-	/*Init tbl8 entries with nexthop from tbl24*/
-	write_to_fib((void *)tbl8_ptr, nh|
-		DIR24_8_EXT_ENT, dp->nh_sz,
-		DIR24_8_TBL8_GRP_NUM_ENT);
-	dp->cur_tbl8s++;
-	return tbl8_idx;
-}
-
 static void
 tbl8_cleanup_and_free(struct dir24_8_tbl *dp, uint64_t tbl8_idx)
 {
@@ -245,8 +258,9 @@ __rcu_qsbr_free_resource(void *p, void *data, unsigned int n __rte_unused)
 	tbl8_cleanup_and_free(dp, tbl8_idx);
 }
 
-static void
-tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
+/* Replace a tbl8 by its tbl24 entry if all the tbl8 entries are the same. */
+static bool
+tbl8_collapse(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
 {
 	uint32_t i;
 	uint64_t nh;
@@ -262,7 +276,7 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
 		nh = *ptr8;
 		for (i = 1; i < DIR24_8_TBL8_GRP_NUM_ENT; i++) {
 			if (nh != ptr8[i])
-				return;
+				return false;
 		}
 		((uint8_t *)dp->tbl24)[ip >> 8] =
 			nh & ~DIR24_8_EXT_ENT;
@@ -273,7 +287,7 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
 		nh = *ptr16;
 		for (i = 1; i < DIR24_8_TBL8_GRP_NUM_ENT; i++) {
 			if (nh != ptr16[i])
-				return;
+				return false;
 		}
 		((uint16_t *)dp->tbl24)[ip >> 8] =
 			nh & ~DIR24_8_EXT_ENT;
@@ -284,7 +298,7 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
 		nh = *ptr32;
 		for (i = 1; i < DIR24_8_TBL8_GRP_NUM_ENT; i++) {
 			if (nh != ptr32[i])
-				return;
+				return false;
 		}
 		((uint32_t *)dp->tbl24)[ip >> 8] =
 			nh & ~DIR24_8_EXT_ENT;
@@ -295,12 +309,28 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
 		nh = *ptr64;
 		for (i = 1; i < DIR24_8_TBL8_GRP_NUM_ENT; i++) {
 			if (nh != ptr64[i])
-				return;
+				return false;
 		}
 		((uint64_t *)dp->tbl24)[ip >> 8] =
 			nh & ~DIR24_8_EXT_ENT;
 		break;
 	}
+	return true;
+}
+
+static void
+tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
+{
+	/* The bulk update recycles each tbl8 once, at the end. */
+	if (dp->tbl8_dirty != NULL) {
+		dp->tbl8_dirty[tbl8_idx >> BITMAP_SLAB_BIT_SIZE_LOG2] |=
+			1ULL << (tbl8_idx & BITMAP_SLAB_BITMASK);
+		dp->tbl8_owner[tbl8_idx] = ip >> 8;
+		return;
+	}
+
+	if (!tbl8_collapse(dp, ip, tbl8_idx))
+		return;
 
 	if (dp->v == NULL) {
 		tbl8_cleanup_and_free(dp, tbl8_idx);
@@ -313,6 +343,88 @@ tbl8_recycle(struct dir24_8_tbl *dp, uint32_t ip, uint64_t tbl8_idx)
 	}
 }
 
+/*
+ * Recycle the tbl8s modified by a bulk update,
+ * waiting for a single grace period in blocking mode.
+ */
+static void
+tbl8_recycle_dirty(struct dir24_8_tbl *dp)
+{
+	uint64_t *dirty = dp->tbl8_dirty;
+	uint64_t slab, tbl8_idx;
+	uint32_t i, ip, nb_free = 0;
+	int bit_idx;
+
+	for (i = 0; i < (dp->number_tbl8s >> BITMAP_SLAB_BIT_SIZE_LOG2); i++) {
+		for (slab = dirty[i]; slab != 0; slab &= slab - 1) {
+			bit_idx = rte_ctz64(slab);
+			tbl8_idx = (i << BITMAP_SLAB_BIT_SIZE_LOG2) + bit_idx;
+			ip = dp->tbl8_owner[tbl8_idx] << 8;
+			/*
+			 * A later update of the whole tbl24 entry may have
+			 * unlinked the tbl8 already.
+			 */
+			if ((get_tbl24(dp, ip, dp->nh_sz) !=
+					((tbl8_idx << 1) | DIR24_8_EXT_ENT)) ||
+					tbl8_collapse(dp, ip, tbl8_idx))
+				nb_free++;
+			else
+				dirty[i] &= ~(1ULL << bit_idx);
+		}
+	}
+	if (nb_free == 0)
+		return;
+
+	if (dp->v != NULL && dp->rcu_mode == RTE_FIB_QSBR_MODE_SYNC)
+		rte_rcu_qsbr_synchronize(dp->v, RTE_QSBR_THRID_INVALID);
+
+	for (i = 0; i < (dp->number_tbl8s >> BITMAP_SLAB_BIT_SIZE_LOG2); i++) {
+		for (slab = dirty[i]; slab != 0; slab &= slab - 1) {
+			tbl8_idx = (i << BITMAP_SLAB_BIT_SIZE_LOG2) +
+				rte_ctz64(slab);
+			if (dp->v == NULL ||
+					dp->rcu_mode == RTE_FIB_QSBR_MODE_SYNC)
+				tbl8_cleanup_and_free(dp, tbl8_idx);
+			else if (rte_rcu_qsbr_dq_enqueue(dp->dq, &tbl8_idx))
+				FIB_LOG(ERR, "Failed to push QSBR FIFO");
+		}
+		dirty[i] = 0;
+	}
+}
+
+
+static int
+tbl8_alloc(struct dir24_8_tbl *dp, uint64_t nh)
+{
+	int64_t	tbl8_idx;
+	uint8_t	*tbl8_ptr;
+
+	tbl8_idx = tbl8_get_idx(dp);
+
+	/* In a bulk update, recycle the modified tbl8 groups first. */
+	if (unlikely(tbl8_idx == -ENOSPC && dp->tbl8_dirty != NULL)) {
+		tbl8_recycle_dirty(dp);
+		tbl8_idx = tbl8_get_idx(dp);
+	}
+
+	/* If there are no tbl8 groups try to reclaim one. */
+	if (unlikely(tbl8_idx == -ENOSPC && dp->dq &&
+			!rte_rcu_qsbr_dq_reclaim(dp->dq, 1, NULL, NULL, NULL)))
+		tbl8_idx = tbl8_get_idx(dp);
+
+	if (tbl8_idx < 0)
+		return tbl8_idx;
+	tbl8_ptr = (uint8_t *)dp->tbl8 +
+		((tbl8_idx * DIR24_8_TBL8_GRP_NUM_ENT) <<
+		dp->nh_sz);
+	/*Init tbl8 entries with nexthop from tbl24*/
+	write_to_fib((void *)tbl8_ptr, nh|
+		DIR24_8_EXT_ENT, dp->nh_sz,
+		DIR24_8_TBL8_GRP_NUM_ENT);
+	dp->cur_tbl8s++;
+	return tbl8_idx;
+}
+
 static int
 install_to_fib(struct dir24_8_tbl *dp, uint32_t ledge, uint32_t redge,
 	uint64_t next_hop)
@@ -338,6 +450,11 @@ install_to_fib(struct dir24_8_tbl *dp, uint32_t ledge, uint32_t redge,
 				 */
 				tbl8_idx = tbl8_alloc(dp, tbl24_tmp);
 				tmp_tbl8_idx = tbl8_get_idx(dp);
+				if (unlikely(tmp_tbl8_idx < 0 && tbl8_idx >= 0 &&
+						dp->tbl8_dirty != NULL)) {
+					tbl8_recycle_dirty(dp);
+					tmp_tbl8_idx = tbl8_get_idx(dp);
+				}
 				if (tbl8_idx < 0)
 					return -ENOSPC;
 				else if (tmp_tbl8_idx < 0) {
@@ -554,6 +671,52 @@ dir24_8_modify(struct rte_fib *fib, uint32_t ip, uint8_t depth,
 	return -EINVAL;
 }
 
+int
+dir24_8_update_bulk(struct rte_fib *fib, const struct rte_fib_route_update *upd,
+	unsigned int n)
+{
+	struct dir24_8_tbl *dp;
+	unsigned int i;
+	int ret = 0;
+
+	dp = rte_fib_get_dp(fib);
+	RTE_ASSERT(dp != NULL);
+
+	/*
+	 * Track the modified tbl8s to recycle them once at the end.
+	 * Without memory for it, every update recycles its own ones.
+	 */
+	dp->tbl8_dirty = rte_zmalloc(NULL,
+		RTE_ALIGN_CEIL(dp->number_tbl8s, 64) >> 3, RTE_CACHE_LINE_SIZE);
+	dp->tbl8_owner = rte_malloc(NULL,
+		dp->number_tbl8s * sizeof(uint32_t), RTE_CACHE_LINE_SIZE);
+	if (dp->tbl8_dirty == NULL || dp->tbl8_owner == NULL) {
+		rte_free(dp->tbl8_dirty);
+		rte_free(dp->tbl8_owner);
+		dp->tbl8_dirty = NULL;
+		dp->tbl8_owner = NULL;
+	}
+
+	for (i = 0; i < n; i++) {
+		ret = dir24_8_modify(fib, upd[i].ip, upd[i].depth,
+			upd[i].next_hop, upd[i].op);
+		if (ret != 0)
+			break;
+	}
+
+	if (dp->tbl8_dirty != NULL) {
+		tbl8_recycle_dirty(dp);
+		rte_free(dp->tbl8_dirty);
+		rte_free(dp->tbl8_owner);
+		dp->tbl8_dirty = NULL;
+		dp->tbl8_owner = NULL;
+	}
+
+	if (ret != 0)
+		rte_errno = -ret;
+	return i;
+}
+
 void *
 dir24_8_create(const char *name, int socket_id, struct rte_fib_conf *fib_conf)
 {
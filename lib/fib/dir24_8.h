@@ -40,6 +40,9 @@ struct dir24_8_tbl {
 	uint64_t	def_nh;		/**< Default next hop */
 	uint64_t	*tbl8;		/**< tbl8 table. */
 	uint64_t	*tbl8_idxes;	/**< bitmap containing free tbl8 idxes*/
+	/** bitmap of the tbl8s to recycle at the end of a bulk update */
+	uint64_t	*tbl8_dirty;
+	uint32_t	*tbl8_owner;	/**< tbl24 index of the dirty tbl8s */
 	/* tbl24 table. */
 	alignas(RTE_CACHE_LINE_SIZE) uint64_t	tbl24[];
 };
@@ -299,6 +302,10 @@ int
 dir24_8_modify(struct rte_fib *fib, uint32_t ip, uint8_t depth,
 	uint64_t next_hop, int op);
 
+int
+dir24_8_update_bulk(struct rte_fib *fib, const struct rte_fib_route_update *upd,
+	unsigned int n);
+
 int
 dir24_8_rcu_qsbr_add(struct dir24_8_tbl *dp, struct rte_fib_rcu_config *cfg,
 	const char *name);
@@ -0,0 +1,308 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_bitops.h>
+#include <rte_prefetch.h>
+#include <rte_vect.h>
+#include <rte_fib.h>
+
+#include "dir24_8.h"
+#include "dir24_8_avx2.h"
+
+/*
+ * The lookup is a software pipeline over batches of addresses:
+ * the tbl24 entries of a batch are prefetched a few batches ahead,
+ * then gathered one batch ahead, prefetching the tbl8 entries of the
+ * extended ones, which are gathered when the next batch is in flight.
+ */
+
+/* Number of addresses of which the tbl24 entries are prefetched ahead. */
+#define DIR24_8_AVX2_PREFETCH_AHEAD	16
+
+static __rte_always_inline __m256i
+dir24_8_avx2_load_ips(const uint32_t *ips, bool be_addr)
+{
+	__m256i ip_vec = _mm256_loadu_si256((const void *)ips);
+
+	if (be_addr) {
+		const __m256i bswap32 = _mm256_set_epi8(
+			12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+			12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3
+		);
+		ip_vec = _mm256_shuffle_epi8(ip_vec, bswap32);
+	}
+
+	return ip_vec;
+}
+
+static __rte_always_inline void
+dir24_8_avx2_prefetch_tbl24(struct dir24_8_tbl *dp, const uint32_t *ips,
+	unsigned int n, uint8_t nh_sz, bool be_addr)
+{
+	unsigned int i;
+
+	for (i = 0; i < n; i++)
+		rte_prefetch0(get_tbl24_p(dp,
+			be_addr ? rte_be_to_cpu_32(ips[i]) : ips[i], nh_sz));
+}
+
+/* Lookup 8 addresses in tbl24, prefetching the tbl8 entries to look up. */
+static __rte_always_inline __m256i
+dir24_8_avx2_tbl24_x8(struct dir24_8_tbl *dp, __m256i ip_vec,
+	__m256i *msk_ext, __m256i *tbl8_idxes, int size)
+{
+	const __m256i lsb = _mm256_set1_epi32(1);
+	const __m256i lsbyte_msk = _mm256_set1_epi32(0xff);
+	uint32_t idxes[8];
+	__m256i idx, res;
+	int msk;
+
+	/* mask 24 most significant bits */
+	idx = _mm256_srli_epi32(ip_vec, 8);
+
+	/* the gather scale must be a constant */
+	if (size == sizeof(uint8_t)) {
+		res = _mm256_i32gather_epi32((const int *)dp->tbl24, idx, 1);
+		res = _mm256_and_si256(res, _mm256_set1_epi32(UINT8_MAX));
+	} else if (size == sizeof(uint16_t)) {
+		res = _mm256_i32gather_epi32((const int *)dp->tbl24, idx, 2);
+		res = _mm256_and_si256(res, _mm256_set1_epi32(UINT16_MAX));
+	} else
+		res = _mm256_i32gather_epi32((const int *)dp->tbl24, idx, 4);
+
+	/* get extended entries indexes */
+	*msk_ext = _mm256_cmpeq_epi32(_mm256_and_si256(res, lsb), lsb);
+	msk = _mm256_movemask_ps(_mm256_castsi256_ps(*msk_ext));
+	if (msk == 0)
+		return res;
+
+	idx = _mm256_slli_epi32(_mm256_srli_epi32(res, 1), 8);
+	*tbl8_idxes = _mm256_add_epi32(idx,
+		_mm256_and_si256(ip_vec, lsbyte_msk));
+
+	_mm256_storeu_si256((void *)idxes, *tbl8_idxes);
+	while (msk != 0) {
+		rte_prefetch0(RTE_PTR_ADD(dp->tbl8,
+			(size_t)idxes[rte_ctz32(msk)] * size));
+		msk &= msk - 1;
+	}
+
+	return res;
+}
+
+/* Lookup the extended entries of 8 addresses in tbl8 and store the next hops. */
+static __rte_always_inline void
+dir24_8_avx2_tbl8_x8(struct dir24_8_tbl *dp, __m256i res, __m256i msk_ext,
+	__m256i tbl8_idxes, uint64_t *next_hops, int size)
+{
+	if (!_mm256_testz_si256(msk_ext, msk_ext)) {
+		if (size == sizeof(uint8_t)) {
+			res = _mm256_mask_i32gather_epi32(res,
+				(const int *)dp->tbl8, tbl8_idxes, msk_ext, 1);
+			res = _mm256_and_si256(res,
+				_mm256_set1_epi32(UINT8_MAX));
+		} else if (size == sizeof(uint16_t)) {
+			res = _mm256_mask_i32gather_epi32(res,
+				(const int *)dp->tbl8, tbl8_idxes, msk_ext, 2);
+			res = _mm256_and_si256(res,
+				_mm256_set1_epi32(UINT16_MAX));
+		} else
+			res = _mm256_mask_i32gather_epi32(res,
+				(const int *)dp->tbl8, tbl8_idxes, msk_ext, 4);
+	}
+
+	res = _mm256_srli_epi32(res, 1);
+	_mm256_storeu_si256((void *)next_hops,
+		_mm256_cvtepu32_epi64(_mm256_castsi256_si128(res)));
+	_mm256_storeu_si256((void *)(next_hops + 4),
+		_mm256_cvtepu32_epi64(_mm256_extracti128_si256(res, 1)));
+}
+
+/* Lookup the addresses by batches of 8, return the number looked up. */
+static __rte_always_inline unsigned int
+dir24_8_avx2_lookup_bulk(void *p, const uint32_t *ips, uint64_t *next_hops,
+	const unsigned int n, int size, bool be_addr)
+{
+	struct dir24_8_tbl *dp = (struct dir24_8_tbl *)p;
+	const uint8_t nh_sz = rte_ctz32(size);
+	__m256i res, msk_ext, tbl8_idxes = _mm256_setzero_si256();
+	__m256i prev_res, prev_msk_ext, prev_tbl8_idxes;
+	unsigned int i, nb = n / 8;
+
+	if (nb == 0)
+		return 0;
+
+	dir24_8_avx2_prefetch_tbl24(dp, ips,
+		RTE_MIN(n, (unsigned int)DIR24_8_AVX2_PREFETCH_AHEAD),
+		nh_sz, be_addr);
+	res = dir24_8_avx2_tbl24_x8(dp, dir24_8_avx2_load_ips(ips, be_addr),
+		&msk_ext, &tbl8_idxes, size);
+
+	for (i = 1; i < nb; i++) {
+		if (i * 8 + DIR24_8_AVX2_PREFETCH_AHEAD < n)
+			dir24_8_avx2_prefetch_tbl24(dp,
+				ips + i * 8 + DIR24_8_AVX2_PREFETCH_AHEAD,
+				RTE_MIN(8U, n - i * 8 -
+					DIR24_8_AVX2_PREFETCH_AHEAD),
+				nh_sz, be_addr);
+
+		prev_res = res;
+		prev_msk_ext = msk_ext;
+		prev_tbl8_idxes = tbl8_idxes;
+		res = dir24_8_avx2_tbl24_x8(dp,
+			dir24_8_avx2_load_ips(ips + i * 8, be_addr),
+			&msk_ext, &tbl8_idxes, size);
+
+		dir24_8_avx2_tbl8_x8(dp, prev_res, prev_msk_ext,
+			prev_tbl8_idxes, next_hops + (i - 1) * 8, size);
+	}
+	dir24_8_avx2_tbl8_x8(dp, res, msk_ext, tbl8_idxes,
+		next_hops + (nb - 1) * 8, size);
+
+	return nb * 8;
+}
+
+/* Lookup 4 addresses with 8B next hops in tbl24. */
+static __rte_always_inline __m256i
+dir24_8_avx2_tbl24_x4_8b(struct dir24_8_tbl *dp, __m128i ip_vec,
+	__m256i *msk_ext, __m256i *tbl8_idxes)
+{
+	const __m256i lsb = _mm256_set1_epi64x(1);
+	const __m256i lsbyte_msk = _mm256_set1_epi64x(0xff);
+	uint64_t idxes[4];
+	__m256i idx, res;
+	int msk;
+
+	/* lookup in tbl24 */
+	res = _mm256_i32gather_epi64((const long long *)dp->tbl24,
+		_mm_srli_epi32(ip_vec, 8), 8);
+
+	/* get extended entries indexes */
+	*msk_ext = _mm256_cmpeq_epi64(_mm256_and_si256(res, lsb), lsb);
+	msk = _mm256_movemask_pd(_mm256_castsi256_pd(*msk_ext));
+	if (msk == 0)
+		return res;
+
+	idx = _mm256_slli_epi64(_mm256_srli_epi64(res, 1), 8);
+	*tbl8_idxes = _mm256_add_epi64(idx, _mm256_and_si256(
+		_mm256_cvtepu32_epi64(ip_vec), lsbyte_msk));
+
+	_mm256_storeu_si256((void *)idxes, *tbl8_idxes);
+	while (msk != 0) {
+		rte_prefetch0(&dp->tbl8[idxes[rte_ctz32(msk)]]);
+		msk &= msk - 1;
+	}
+
+	return res;
+}
+
+static __rte_always_inline void
+dir24_8_avx2_tbl8_x4_8b(struct dir24_8_tbl *dp, __m256i res, __m256i msk_ext,
+	__m256i tbl8_idxes, uint64_t *next_hops)
+{
+	if (!_mm256_testz_si256(msk_ext, msk_ext))
+		res = _mm256_mask_i64gather_epi64(res,
+			(const long long *)dp->tbl8, tbl8_idxes, msk_ext, 8);
+
+	_mm256_storeu_si256((void *)next_hops, _mm256_srli_epi64(res, 1));
+}
+
+/* Lookup 8 addresses with 8B next hops in tbl24, as 2 vectors of 4. */
+static __rte_always_inline void
+dir24_8_avx2_tbl24_x8_8b(struct dir24_8_tbl *dp, const uint32_t *ips,
+	__m256i res[2], __m256i msk_ext[2], __m256i tbl8_idxes[2], bool be_addr)
+{
+	__m256i ip_vec = dir24_8_avx2_load_ips(ips, be_addr);
+
+	res[0] = dir24_8_avx2_tbl24_x4_8b(dp, _mm256_castsi256_si128(ip_vec),
+		&msk_ext[0], &tbl8_idxes[0]);
+	res[1] = dir24_8_avx2_tbl24_x4_8b(dp,
+		_mm256_extracti128_si256(ip_vec, 1),
+		&msk_ext[1], &tbl8_idxes[1]);
+}
+
+static __rte_always_inline unsigned int
+dir24_8_avx2_lookup_bulk_8b(void *p, const uint32_t *ips, uint64_t *next_hops,
+	const unsigned int n, bool be_addr)
+{
+	struct dir24_8_tbl *dp = (struct dir24_8_tbl *)p;
+	__m256i res[2], msk_ext[2], tbl8_idxes[2];
+	__m256i prev_res[2], prev_msk_ext[2], prev_tbl8_idxes[2];
+	unsigned int i, j, nb = n / 8;
+
+	if (nb == 0)
+		return 0;
+
+	tbl8_idxes[0] = _mm256_setzero_si256();
+	tbl8_idxes[1] = _mm256_setzero_si256();
+
+	dir24_8_avx2_prefetch_tbl24(dp, ips,
+		RTE_MIN(n, (unsigned int)DIR24_8_AVX2_PREFETCH_AHEAD),
+		3, be_addr);
+	dir24_8_avx2_tbl24_x8_8b(dp, ips, res, msk_ext, tbl8_idxes, be_addr);
+
+	for (i = 1; i < nb; i++) {
+		if (i * 8 + DIR24_8_AVX2_PREFETCH_AHEAD < n)
+			dir24_8_avx2_prefetch_tbl24(dp,
+				ips + i * 8 + DIR24_8_AVX2_PREFETCH_AHEAD,
+				RTE_MIN(8U, n - i * 8 -
+					DIR24_8_AVX2_PREFETCH_AHEAD),
+				3, be_addr);
+
+		for (j = 0; j < 2; j++) {
+			prev_res[j] = res[j];
+			prev_msk_ext[j] = msk_ext[j];
+			prev_tbl8_idxes[j] = tbl8_idxes[j];
+		}
+		dir24_8_avx2_tbl24_x8_8b(dp, ips + i * 8, res, msk_ext,
+			tbl8_idxes, be_addr);
+
+		for (j = 0; j < 2; j++)
+			dir24_8_avx2_tbl8_x4_8b(dp, prev_res[j],
+				prev_msk_ext[j], prev_tbl8_idxes[j],
+				next_hops + (i - 1) * 8 + j * 4);
+	}
+	for (j = 0; j < 2; j++)
+		dir24_8_avx2_tbl8_x4_8b(dp, res[j], msk_ext[j], tbl8_idxes[j],
+			next_hops + (nb - 1) * 8 + j * 4);
+
+	return nb * 8;
+}
+
+#define DECLARE_AVX2_FN(suffix, nh_type, be_addr) \
+void \
+rte_dir24_8_avx2_lookup_bulk_##suffix(void *p, const uint32_t *ips, uint64_t *next_hops, \
+	const unsigned int n) \
+{ \
+	unsigned int i; \
+	i = dir24_8_avx2_lookup_bulk(p, ips, next_hops, n, sizeof(nh_type), be_addr); \
+	dir24_8_lookup_bulk_##suffix(p, ips + i, next_hops + i, n - i); \
+}
+
+DECLARE_AVX2_FN(1b, uint8_t, false)
+DECLARE_AVX2_FN(1b_be, uint8_t, true)
+DECLARE_AVX2_FN(2b, uint16_t, false)
+DECLARE_AVX2_FN(2b_be, uint16_t, true)
+DECLARE_AVX2_FN(4b, uint32_t, false)
+DECLARE_AVX2_FN(4b_be, uint32_t, true)
+
+void
+rte_dir24_8_avx2_lookup_bulk_8b(void *p, const uint32_t *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	unsigned int i;
+
+	i = dir24_8_avx2_lookup_bulk_8b(p, ips, next_hops, n, false);
+	dir24_8_lookup_bulk_8b(p, ips + i, next_hops + i, n - i);
+}
+
+void
+rte_dir24_8_avx2_lookup_bulk_8b_be(void *p, const uint32_t *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	unsigned int i;
+
+	i = dir24_8_avx2_lookup_bulk_8b(p, ips, next_hops, n, true);
+	dir24_8_lookup_bulk_8b_be(p, ips + i, next_hops + i, n - i);
+}
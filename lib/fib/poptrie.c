@@ -0,0 +1,992 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <rte_debug.h>
+#include <rte_malloc.h>
+#include <rte_cpuflags.h>
+#include <rte_errno.h>
+#include <rte_vect.h>
+
+#include <rte_rib6.h>
+#include <rte_fib6.h>
+#include "fib_log.h"
+#include "poptrie.h"
+
+#ifdef RTE_ARCH_X86_64
+
+#include "poptrie_avx2.h"
+
+#endif /* RTE_ARCH_X86_64 */
+
+#define POPTRIE_NAMESIZE	64
+
+/* End of a list of free runs. */
+#define POPTRIE_RUN_NONE	UINT32_MAX
+
+/* Maximum number of nodes from the root entry to the last bit. */
+#define POPTRIE_MAX_LEVELS	((RTE_IPV6_MAX_DEPTH - POPTRIE_ROOT_STRIDE_MIN + \
+	POPTRIE_STRIDE - 1) / POPTRIE_STRIDE)
+
+/* Child of a node replaced by an update. */
+struct poptrie_child {
+	struct poptrie_node	node;	/**< Child node, if is_node */
+	uint64_t		nh;	/**< Next hop of a leaf */
+	bool			is_node;
+};
+
+static inline rte_fib6_lookup_fn_t
+get_scalar_fn(enum rte_fib_trie_nh_sz nh_sz)
+{
+	switch (nh_sz) {
+	case RTE_FIB6_TRIE_2B:
+		return rte_poptrie_lookup_bulk_2b;
+	case RTE_FIB6_TRIE_4B:
+		return rte_poptrie_lookup_bulk_4b;
+	case RTE_FIB6_TRIE_8B:
+		return rte_poptrie_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+}
+
+static inline rte_fib6_lookup_fn_t
+get_vector_fn(enum rte_fib_trie_nh_sz nh_sz)
+{
+#ifdef RTE_ARCH_X86_64
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2) <= 0 ||
+			rte_vect_get_max_simd_bitwidth() < RTE_VECT_SIMD_256)
+		return NULL;
+	switch (nh_sz) {
+	case RTE_FIB6_TRIE_2B:
+		return rte_poptrie_vec_lookup_bulk_2b;
+	case RTE_FIB6_TRIE_4B:
+		return rte_poptrie_vec_lookup_bulk_4b;
+	case RTE_FIB6_TRIE_8B:
+		return rte_poptrie_vec_lookup_bulk_8b;
+	default:
+		return NULL;
+	}
+#else
+	RTE_SET_USED(nh_sz);
+#endif
+	return NULL;
+}
+
+rte_fib6_lookup_fn_t
+poptrie_get_lookup_fn(void *p, enum rte_fib6_lookup_type type)
+{
+	enum rte_fib_trie_nh_sz nh_sz;
+	rte_fib6_lookup_fn_t ret_fn;
+	struct rte_poptrie_tbl *dp = p;
+
+	if (dp == NULL)
+		return NULL;
+
+	nh_sz = dp->nh_sz;
+
+	switch (type) {
+	case RTE_FIB6_LOOKUP_POPTRIE_SCALAR:
+		return get_scalar_fn(nh_sz);
+	case RTE_FIB6_LOOKUP_POPTRIE_VECTOR_AVX2:
+		return get_vector_fn(nh_sz);
+	case RTE_FIB6_LOOKUP_DEFAULT:
+		ret_fn = get_vector_fn(nh_sz);
+		return (ret_fn != NULL) ? ret_fn : get_scalar_fn(nh_sz);
+	default:
+		return NULL;
+	}
+	return NULL;
+}
+
+static inline uint64_t
+get_max_nh(uint8_t nh_sz)
+{
+	return (1ULL << ((8 << nh_sz) - 1)) - 1;
+}
+
+static void
+write_to_dp(void *ptr, uint64_t val, enum rte_fib_trie_nh_sz size, int n)
+{
+	int i;
+	uint16_t *ptr16 = (uint16_t *)ptr;
+	uint32_t *ptr32 = (uint32_t *)ptr;
+	uint64_t *ptr64 = (uint64_t *)ptr;
+
+	switch (size) {
+	case RTE_FIB6_TRIE_2B:
+		for (i = 0; i < n; i++)
+			ptr16[i] = (uint16_t)val;
+		break;
+	case RTE_FIB6_TRIE_4B:
+		for (i = 0; i < n; i++)
+			ptr32[i] = (uint32_t)val;
+		break;
+	case RTE_FIB6_TRIE_8B:
+		for (i = 0; i < n; i++)
+			ptr64[i] = (uint64_t)val;
+		break;
+	}
+}
+
+static inline uint64_t
+get_val_by_p(void *p, uint8_t nh_sz)
+{
+	uint64_t val = 0;
+
+	switch (nh_sz) {
+	case RTE_FIB6_TRIE_2B:
+		val = *(uint16_t *)p;
+		break;
+	case RTE_FIB6_TRIE_4B:
+		val = *(uint32_t *)p;
+		break;
+	case RTE_FIB6_TRIE_8B:
+		val = *(uint64_t *)p;
+		break;
+	}
+	return val;
+}
+
+static inline void *
+get_root_p(struct rte_poptrie_tbl *dp, uint32_t idx)
+{
+	return RTE_PTR_ADD(dp->root, (size_t)idx << dp->nh_sz);
+}
+
+static inline void *
+get_leaf_p(struct rte_poptrie_tbl *dp, uint32_t idx)
+{
+	return RTE_PTR_ADD(dp->leaves, (size_t)idx << dp->nh_sz);
+}
+
+static inline struct poptrie_node *
+get_child(struct rte_poptrie_tbl *dp, const struct poptrie_node *node,
+	uint32_t v)
+{
+	return &dp->nodes[node->base1 - 1 +
+		rte_popcount64(node->vector & poptrie_child_msk(v))];
+}
+
+static inline uint64_t
+get_leaf(struct rte_poptrie_tbl *dp, const struct poptrie_node *node,
+	uint32_t v)
+{
+	return get_val_by_p(get_leaf_p(dp, node->base0 - 1 +
+		rte_popcount64(node->leafvec & poptrie_child_msk(v))),
+		dp->nh_sz);
+}
+
+/*
+ * Runs of entries are allocated from the never allocated part of a pool,
+ * or taken from lists of free runs of the same length. The first 4 bytes
+ * of a free run link it to the next free run of the list.
+ */
+static void
+pool_init(struct poptrie_pool *pool, uint32_t num_ent, uint32_t unit)
+{
+	uint32_t i;
+
+	pool->num_ent = num_ent;
+	pool->pos = 0;
+	pool->unit = unit;
+	for (i = 0; i <= POPTRIE_NUM_CHILDREN; i++)
+		pool->free[i] = POPTRIE_RUN_NONE;
+}
+
+static inline uint32_t *
+pool_link(void *base, size_t esize, uint32_t idx)
+{
+	return RTE_PTR_ADD(base, idx * esize);
+}
+
+static void
+pool_put(struct poptrie_pool *pool, void *base, size_t esize,
+	uint32_t idx, uint32_t len)
+{
+	len = RTE_ALIGN_CEIL(len, pool->unit);
+	*pool_link(base, esize, idx) = pool->free[len];
+	pool->free[len] = idx;
+}
+
+static int64_t
+pool_get(struct poptrie_pool *pool, void *base, size_t esize, uint32_t len)
+{
+	uint32_t idx, l;
+
+	len = RTE_ALIGN_CEIL(len, pool->unit);
+
+	/* a free run of the same length */
+	idx = pool->free[len];
+	if (idx != POPTRIE_RUN_NONE) {
+		pool->free[len] = *pool_link(base, esize, idx);
+		return idx;
+	}
+
+	/* the never allocated entries */
+	if (pool->num_ent - pool->pos >= len) {
+		idx = pool->pos;
+		pool->pos += len;
+		return idx;
+	}
+
+	/* the head of a longer free run, its tail is freed */
+	for (l = len + pool->unit; l <= POPTRIE_NUM_CHILDREN; l += pool->unit) {
+		idx = pool->free[l];
+		if (idx == POPTRIE_RUN_NONE)
+			continue;
+		pool->free[l] = *pool_link(base, esize, idx);
+		pool_put(pool, base, esize, idx + len, l - len);
+		return idx;
+	}
+
+	return -ENOSPC;
+}
+
+static void
+run_free(struct rte_poptrie_tbl *dp, bool leaf, uint32_t idx, uint32_t len)
+{
+	if (len == 0)
+		return;
+	if (leaf)
+		pool_put(&dp->leaf_pool, dp->leaves, 1 << dp->nh_sz, idx, len);
+	else
+		pool_put(&dp->node_pool, dp->nodes,
+			sizeof(struct poptrie_node), idx, len);
+}
+
+static int64_t
+run_alloc(struct rte_poptrie_tbl *dp, bool leaf, uint32_t len)
+{
+	int64_t idx;
+	int i;
+
+	/* If the pool is exhausted try to reclaim the retired runs. */
+	for (i = 0; i < 2; i++) {
+		if (leaf)
+			idx = pool_get(&dp->leaf_pool, dp->leaves,
+				1 << dp->nh_sz, len);
+		else
+			idx = pool_get(&dp->node_pool, dp->nodes,
+				sizeof(struct poptrie_node), len);
+		if (idx != -ENOSPC || dp->dq == NULL ||
+				rte_rcu_qsbr_dq_reclaim(dp->dq, UINT32_MAX,
+					NULL, NULL, NULL) != 0)
+			break;
+	}
+	return idx;
+}
+
+/* Free the runs of a node. */
+static void
+node_free_runs(struct rte_poptrie_tbl *dp, const struct poptrie_node *node)
+{
+	run_free(dp, false, node->base1, rte_popcount64(node->vector));
+	run_free(dp, true, node->base0, rte_popcount64(node->leafvec));
+}
+
+/* Free the runs of a node and of all the nodes below it. */
+static void
+subtree_free(struct rte_poptrie_tbl *dp, const struct poptrie_node *node)
+{
+	uint32_t i, nb = rte_popcount64(node->vector);
+
+	for (i = 0; i < nb; i++)
+		subtree_free(dp, &dp->nodes[node->base1 + i]);
+	node_free_runs(dp, node);
+}
+
+static void
+__rcu_qsbr_free_resource(void *p, void *data, unsigned int n __rte_unused)
+{
+	struct rte_poptrie_tbl *dp = p;
+	uint64_t run = *(uint64_t *)data;
+
+	run_free(dp, (run >> 40) & 1, (uint32_t)run, (run >> 32) & UINT8_MAX);
+}
+
+/*
+ * Start retiring the runs replaced by an update, return true if they
+ * have to be pushed to the defer queue, false if they can be freed.
+ */
+static bool
+retire_start(struct rte_poptrie_tbl *dp)
+{
+	if (dp->v == NULL)
+		return false;
+	if (dp->rcu_mode == RTE_FIB6_QSBR_MODE_SYNC) {
+		rte_rcu_qsbr_synchronize(dp->v, RTE_QSBR_THRID_INVALID);
+		return false;
+	}
+	return true;
+}
+
+static void
+run_retire(struct rte_poptrie_tbl *dp, bool *defer, bool leaf, uint32_t idx,
+	uint32_t len)
+{
+	uint64_t run;
+
+	if (len == 0)
+		return;
+	if (*defer) {
+		run = idx | (uint64_t)len << 32 | (uint64_t)leaf << 40;
+		if (rte_rcu_qsbr_dq_enqueue(dp->dq, &run) == 0)
+			return;
+		/* defer queue full, wait for the readers to free the rest */
+		rte_rcu_qsbr_synchronize(dp->v, RTE_QSBR_THRID_INVALID);
+		*defer = false;
+	}
+	run_free(dp, leaf, idx, len);
+}
+
+static void
+node_retire_runs(struct rte_poptrie_tbl *dp, bool *defer,
+	const struct poptrie_node *node)
+{
+	run_retire(dp, defer, false, node->base1, rte_popcount64(node->vector));
+	run_retire(dp, defer, true, node->base0, rte_popcount64(node->leafvec));
+}
+
+static void
+subtree_retire(struct rte_poptrie_tbl *dp, bool *defer,
+	const struct poptrie_node *node)
+{
+	uint32_t i, nb = rte_popcount64(node->vector);
+
+	for (i = 0; i < nb; i++)
+		subtree_retire(dp, defer, &dp->nodes[node->base1 + i]);
+	node_retire_runs(dp, defer, node);
+}
+
+/* Set the POPTRIE_STRIDE bits at offset pos, except past the address. */
+static void
+set_chunk(struct rte_ipv6_addr *ip, uint32_t pos, uint32_t val)
+{
+	uint32_t i, bit;
+
+	for (i = 0; i < POPTRIE_STRIDE && pos + i < RTE_IPV6_MAX_DEPTH; i++) {
+		bit = 7 - (pos + i) % 8;
+		if ((val & (1 << (POPTRIE_STRIDE - 1 - i))) != 0)
+			ip->a[(pos + i) / 8] |= 1 << bit;
+		else
+			ip->a[(pos + i) / 8] &= ~(1 << bit);
+	}
+}
+
+/* Get the longest route of at most depth covering ip. */
+static struct rte_rib6_node *
+get_cover(struct rte_rib6 *rib, const struct rte_ipv6_addr *ip, uint8_t depth)
+{
+	struct rte_rib6_node *node;
+	uint8_t node_depth;
+
+	for (node = rte_rib6_lookup(rib, ip); node != NULL;
+			node = rte_rib6_lookup_parent(node)) {
+		rte_rib6_get_depth(node, &node_depth);
+		if (node_depth <= depth)
+			break;
+	}
+	return node;
+}
+
+static uint64_t
+get_cover_nh(struct rte_poptrie_tbl *dp, struct rte_rib6 *rib,
+	const struct rte_ipv6_addr *ip, uint8_t depth)
+{
+	struct rte_rib6_node *node;
+	uint64_t nh;
+
+	node = get_cover(rib, ip, depth);
+	if (node == NULL)
+		return dp->def_nh;
+	rte_rib6_get_nh(node, &nh);
+	return nh;
+}
+
+/* Check if there are routes longer than depth in ip/depth. */
+static inline bool
+has_more_specifics(struct rte_rib6 *rib, const struct rte_ipv6_addr *ip,
+	uint8_t depth)
+{
+	return depth < RTE_IPV6_MAX_DEPTH && rte_rib6_get_nxt(rib, ip, depth,
+		NULL, RTE_RIB6_GET_NXT_ALL) != NULL;
+}
+
+/*
+ * Build the node of ip/depth into node. The children in [lo, hi] are
+ * built from the RIB, or set to repl if not NULL, the other ones are
+ * shared with old. On failure, everything allocated is freed.
+ */
+static int
+node_build(struct rte_poptrie_tbl *dp, struct rte_rib6 *rib,
+	const struct poptrie_node *old, const struct rte_ipv6_addr *ip,
+	uint8_t depth, uint32_t lo, uint32_t hi,
+	const struct poptrie_child *repl, struct poptrie_node *node)
+{
+	uint64_t nhs[POPTRIE_NUM_CHILDREN];
+	struct rte_ipv6_addr child_ip = *ip;
+	uint8_t child_depth;
+	uint64_t vector = 0, leafvec = 0, nh;
+	uint32_t i, j, nb_leaves = 0, nb_nodes;
+	int64_t base0 = 0, base1 = 0;
+	int ret;
+
+	child_depth = RTE_MIN(depth + POPTRIE_STRIDE, RTE_IPV6_MAX_DEPTH);
+
+	for (i = 0; i < POPTRIE_NUM_CHILDREN; i++) {
+		if (i < lo || i > hi) {
+			if ((old->vector & RTE_BIT64(i)) != 0) {
+				vector |= RTE_BIT64(i);
+				continue;
+			}
+			nh = get_leaf(dp, old, i);
+		} else if (repl != NULL) {
+			if (repl->is_node) {
+				vector |= RTE_BIT64(i);
+				continue;
+			}
+			nh = repl->nh;
+		} else {
+			set_chunk(&child_ip, depth, i);
+			if (has_more_specifics(rib, &child_ip, child_depth)) {
+				vector |= RTE_BIT64(i);
+				continue;
+			}
+			nh = get_cover_nh(dp, rib, &child_ip, child_depth);
+		}
+		/* the leaves equal to the previous one are not stored */
+		if (nb_leaves == 0 || nh != nhs[nb_leaves - 1]) {
+			leafvec |= RTE_BIT64(i);
+			nhs[nb_leaves++] = nh;
+		}
+	}
+
+	if (nb_leaves != 0) {
+		base0 = run_alloc(dp, true, nb_leaves);
+		if (base0 < 0)
+			return base0;
+		for (i = 0; i < nb_leaves; i++)
+			write_to_dp(get_leaf_p(dp, base0 + i), nhs[i],
+				dp->nh_sz, 1);
+	}
+
+	nb_nodes = rte_popcount64(vector);
+	if (nb_nodes != 0) {
+		base1 = run_alloc(dp, false, nb_nodes);
+		if (base1 < 0) {
+			run_free(dp, true, base0, nb_leaves);
+			return base1;
+		}
+	}
+
+	for (i = 0, j = 0; i < POPTRIE_NUM_CHILDREN; i++) {
+		if ((vector & RTE_BIT64(i)) == 0)
+			continue;
+		if (i < lo || i > hi) {
+			dp->nodes[base1 + j++] = *get_child(dp, old, i);
+			continue;
+		}
+		if (repl != NULL) {
+			dp->nodes[base1 + j++] = repl->node;
+			continue;
+		}
+		set_chunk(&child_ip, depth, i);
+		ret = node_build(dp, rib, NULL, &child_ip, child_depth,
+			0, POPTRIE_NUM_CHILDREN - 1, NULL,
+			&dp->nodes[base1 + j]);
+		if (ret < 0) {
+			/* free the children built from the RIB */
+			while (j-- > 0) {
+				while ((vector & RTE_BIT64(--i)) == 0)
+					;
+				if (i >= lo && i <= hi)
+					subtree_free(dp, &dp->nodes[base1 + j]);
+			}
+			run_free(dp, false, base1, rte_popcount64(vector));
+			run_free(dp, true, base0, nb_leaves);
+			return ret;
+		}
+		j++;
+	}
+
+	node->vector = vector;
+	node->leafvec = leafvec;
+	node->base0 = base0;
+	node->base1 = base1;
+	return 0;
+}
+
+/* Publish a root entry, then retire its previous subtree. */
+static void
+root_publish(struct rte_poptrie_tbl *dp, uint32_t root_idx, uint64_t val)
+{
+	void *ent = get_root_p(dp, root_idx);
+	uint64_t old = get_val_by_p(ent, dp->nh_sz);
+	bool defer;
+
+	/* the new nodes and leaves are written before they are reachable */
+	rte_atomic_thread_fence(rte_memory_order_release);
+	write_to_dp(ent, val, dp->nh_sz, 1);
+
+	if (!is_poptrie_ext(old))
+		return;
+	defer = retire_start(dp);
+	subtree_retire(dp, &defer, &dp->nodes[old >> 1]);
+	run_retire(dp, &defer, false, old >> 1, 1);
+}
+
+/* Get the root entry value of a child, allocating its node if any. */
+static int
+root_child_val(struct rte_poptrie_tbl *dp, const struct poptrie_child *child,
+	uint64_t *val)
+{
+	int64_t idx;
+
+	if (!child->is_node) {
+		*val = child->nh << 1;
+		return 0;
+	}
+	idx = run_alloc(dp, false, 1);
+	if (idx < 0)
+		return idx;
+	dp->nodes[idx] = child->node;
+	*val = ((uint64_t)idx << 1) | POPTRIE_EXT_ENT;
+	return 0;
+}
+
+/* Collapse a node without child node and with equal leaves into a leaf. */
+static void
+child_set(struct rte_poptrie_tbl *dp, struct poptrie_child *child,
+	struct poptrie_node *node)
+{
+	if (node->vector == 0 && rte_popcount64(node->leafvec) == 1) {
+		child->is_node = false;
+		child->nh = get_val_by_p(get_leaf_p(dp, node->base0),
+			dp->nh_sz);
+		run_free(dp, true, node->base0, 1);
+		node->leafvec = 0;
+	} else {
+		child->is_node = true;
+		child->node = *node;
+	}
+}
+
+/* Rebuild the whole subtree of a root entry from the RIB. */
+static int
+root_rebuild(struct rte_poptrie_tbl *dp, struct rte_rib6 *rib,
+	uint32_t root_idx)
+{
+	struct rte_ipv6_addr ip = RTE_IPV6_ADDR_UNSPEC;
+	struct poptrie_child child;
+	struct poptrie_node node;
+	uint32_t idx;
+	uint64_t val;
+	int ret;
+
+	idx = root_idx << (24 - dp->root_stride);
+	ip.a[0] = idx >> 16;
+	ip.a[1] = idx >> 8;
+	ip.a[2] = idx;
+
+	if (!has_more_specifics(rib, &ip, dp->root_stride)) {
+		val = get_cover_nh(dp, rib, &ip, dp->root_stride) << 1;
+		if (val == get_val_by_p(get_root_p(dp, root_idx), dp->nh_sz))
+			return 0;
+	} else {
+		ret = node_build(dp, rib, NULL, &ip, dp->root_stride,
+			0, POPTRIE_NUM_CHILDREN - 1, NULL, &node);
+		if (ret < 0)
+			return ret;
+		child_set(dp, &child, &node);
+		ret = root_child_val(dp, &child, &val);
+		if (ret < 0) {
+			subtree_free(dp, &node);
+			return ret;
+		}
+	}
+
+	root_publish(dp, root_idx, val);
+	return 0;
+}
+
+/*
+ * Update the nodes covering ip/depth, longer than the root stride.
+ * The children of the deepest node covering ip/depth are rebuilt from
+ * the RIB and its ancestors are copied, the other nodes are shared.
+ */
+static int
+path_update(struct rte_poptrie_tbl *dp, struct rte_rib6 *rib,
+	const struct rte_ipv6_addr *ip, uint8_t depth)
+{
+	const struct poptrie_node *path[POPTRIE_MAX_LEVELS];
+	struct poptrie_node new_nodes[POPTRIE_MAX_LEVELS];
+	uint32_t chunks[POPTRIE_MAX_LEVELS];
+	struct rte_ipv6_addr node_ip;
+	struct poptrie_child child;
+	uint32_t root_idx, lo, hi;
+	uint8_t node_depth;
+	uint64_t val;
+	bool defer;
+	int i, lvl, ret;
+
+	root_idx = poptrie_get_root_idx(ip, dp->root_stride);
+	val = get_val_by_p(get_root_p(dp, root_idx), dp->nh_sz);
+	if (!is_poptrie_ext(val))
+		return root_rebuild(dp, rib, root_idx);
+
+	/* find the deepest node with children covering ip/depth */
+	path[0] = &dp->nodes[val >> 1];
+	node_depth = dp->root_stride;
+	for (lvl = 0; ; lvl++) {
+		chunks[lvl] = poptrie_get_chunk(ip, node_depth);
+		if (depth <= node_depth + POPTRIE_STRIDE ||
+				(path[lvl]->vector & RTE_BIT64(chunks[lvl])) == 0)
+			break;
+		path[lvl + 1] = get_child(dp, path[lvl], chunks[lvl]);
+		node_depth += POPTRIE_STRIDE;
+	}
+
+	lo = chunks[lvl];
+	hi = lo;
+	if (depth <= node_depth + POPTRIE_STRIDE) {
+		lo &= ~((1U << (node_depth + POPTRIE_STRIDE - depth)) - 1);
+		hi = lo + (1U << (node_depth + POPTRIE_STRIDE - depth)) - 1;
+	}
+
+	node_ip = *ip;
+	rte_ipv6_addr_mask(&node_ip, node_depth);
+	ret = node_build(dp, rib, path[lvl], &node_ip, node_depth, lo, hi,
+		NULL, &new_nodes[lvl]);
+	if (ret < 0)
+		return ret;
+
+	/* copy the ancestors, with the new child on the path */
+	for (i = lvl; i > 0; i--) {
+		child_set(dp, &child, &new_nodes[i]);
+		node_depth -= POPTRIE_STRIDE;
+		rte_ipv6_addr_mask(&node_ip, node_depth);
+		ret = node_build(dp, rib, path[i - 1], &node_ip, node_depth,
+			chunks[i - 1], chunks[i - 1], &child, &new_nodes[i - 1]);
+		if (ret < 0)
+			goto free_new;
+	}
+	child_set(dp, &child, &new_nodes[0]);
+	ret = root_child_val(dp, &child, &val);
+	if (ret < 0)
+		goto free_new;
+
+	/* the new nodes and leaves are written before they are reachable */
+	rte_atomic_thread_fence(rte_memory_order_release);
+	write_to_dp(get_root_p(dp, root_idx), val, dp->nh_sz, 1);
+
+	/* retire the replaced runs, the deepest first */
+	defer = retire_start(dp);
+	for (i = lo; i <= (int)hi; i++) {
+		if ((path[lvl]->vector & RTE_BIT64(i)) != 0)
+			subtree_retire(dp, &defer, get_child(dp, path[lvl], i));
+	}
+	for (i = lvl; i >= 0; i--)
+		node_retire_runs(dp, &defer, path[i]);
+	run_retire(dp, &defer, false, path[0] - dp->nodes, 1);
+	return 0;
+
+free_new:
+	/* the new children of the last node were built from the RIB */
+	for (; lo <= hi; lo++) {
+		if ((new_nodes[lvl].vector & RTE_BIT64(lo)) != 0)
+			subtree_free(dp, get_child(dp, &new_nodes[lvl], lo));
+	}
+	for (; lvl >= i; lvl--)
+		node_free_runs(dp, &new_nodes[lvl]);
+	return ret;
+}
+
+/* Set the root entries in [first, last) to a leaf. */
+static void
+root_fill(struct rte_poptrie_tbl *dp, uint32_t first, uint32_t last,
+	uint64_t nh)
+{
+	uint32_t i;
+
+	for (i = first; i < last; i++) {
+		if (is_poptrie_ext(get_val_by_p(get_root_p(dp, i), dp->nh_sz)))
+			root_publish(dp, i, nh << 1);
+		else
+			write_to_dp(get_root_p(dp, i), nh << 1, dp->nh_sz, 1);
+	}
+}
+
+/*
+ * Update the root entries covered by ip/depth, at most the root stride,
+ * to next_hop. The entries covered by a more specific route of at most
+ * the root stride are skipped, the ones with longer routes are rebuilt.
+ */
+static int
+root_update(struct rte_poptrie_tbl *dp, struct rte_rib6 *rib,
+	const struct rte_ipv6_addr *ip, uint8_t depth, uint64_t next_hop)
+{
+	struct rte_rib6_node *tmp = NULL;
+	struct rte_ipv6_addr tmp_ip;
+	uint32_t pos, last, idx;
+	uint8_t tmp_depth;
+	int ret;
+
+	pos = poptrie_get_root_idx(ip, dp->root_stride);
+	last = pos + (1U << (dp->root_stride - depth));
+
+	while ((tmp = rte_rib6_get_nxt(rib, ip, depth, tmp,
+			RTE_RIB6_GET_NXT_COVER)) != NULL) {
+		rte_rib6_get_ip(tmp, &tmp_ip);
+		rte_rib6_get_depth(tmp, &tmp_depth);
+		idx = poptrie_get_root_idx(&tmp_ip, dp->root_stride);
+		/* another longer route in an entry already rebuilt */
+		if (idx < pos)
+			continue;
+		root_fill(dp, pos, idx, next_hop);
+		if (tmp_depth > dp->root_stride) {
+			ret = root_rebuild(dp, rib, idx);
+			if (ret < 0)
+				return ret;
+			pos = idx + 1;
+		} else
+			pos = idx + (1U << (dp->root_stride - tmp_depth));
+	}
+	root_fill(dp, pos, last, next_hop);
+	return 0;
+}
+
+static int
+update_dp(struct rte_poptrie_tbl *dp, struct rte_rib6 *rib,
+	const struct rte_ipv6_addr *ip, uint8_t depth, uint64_t next_hop)
+{
+	if (depth > dp->root_stride)
+		return path_update(dp, rib, ip, depth);
+	return root_update(dp, rib, ip, depth, next_hop);
+}
+
+int
+poptrie_modify(struct rte_fib6 *fib, const struct rte_ipv6_addr *ip,
+	uint8_t depth, uint64_t next_hop, int op)
+{
+	struct rte_poptrie_tbl *dp;
+	struct rte_rib6 *rib;
+	struct rte_rib6_node *node;
+	struct rte_ipv6_addr ip_masked;
+	uint64_t old_nh;
+	bool new_node = false;
+	int ret;
+
+	if ((fib == NULL) || (ip == NULL) || (depth > RTE_IPV6_MAX_DEPTH))
+		return -EINVAL;
+
+	dp = rte_fib6_get_dp(fib);
+	RTE_ASSERT(dp);
+	rib = rte_fib6_get_rib(fib);
+	RTE_ASSERT(rib);
+
+	ip_masked = *ip;
+	rte_ipv6_addr_mask(&ip_masked, depth);
+
+	node = rte_rib6_lookup_exact(rib, &ip_masked, depth);
+	switch (op) {
+	case RTE_FIB6_ADD:
+		if (next_hop > get_max_nh(dp->nh_sz))
+			return -EINVAL;
+		if (node != NULL) {
+			rte_rib6_get_nh(node, &old_nh);
+			if (old_nh == next_hop)
+				return 0;
+		} else {
+			old_nh = get_cover_nh(dp, rib, &ip_masked, depth);
+			node = rte_rib6_insert(rib, &ip_masked, depth);
+			if (node == NULL)
+				return -rte_errno;
+			new_node = true;
+		}
+		rte_rib6_set_nh(node, next_hop);
+
+		ret = update_dp(dp, rib, &ip_masked, depth, next_hop);
+		if (ret == 0)
+			return 0;
+		if (new_node)
+			rte_rib6_remove(rib, &ip_masked, depth);
+		else
+			rte_rib6_set_nh(node, old_nh);
+		break;
+	case RTE_FIB6_DEL:
+		if (node == NULL)
+			return -ENOENT;
+		rte_rib6_get_nh(node, &old_nh);
+		rte_rib6_remove(rib, &ip_masked, depth);
+
+		ret = update_dp(dp, rib, &ip_masked, depth,
+			get_cover_nh(dp, rib, &ip_masked, depth));
+		if (ret == 0)
+			return 0;
+		node = rte_rib6_insert(rib, &ip_masked, depth);
+		if (node == NULL) {
+			FIB_LOG(ERR, "Failed to restore the RIB6 after an update");
+			return ret;
+		}
+		rte_rib6_set_nh(node, old_nh);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	/*
+	 * The update of a route longer than the root stride changes nothing
+	 * on failure, but a shorter one may have changed root entries.
+	 */
+	if (depth <= dp->root_stride) {
+		if (update_dp(dp, rib, &ip_masked, depth, old_nh) != 0)
+			FIB_LOG(ERR, "Failed to restore the FIB6 after an update");
+	}
+	return ret;
+}
+
+void *
+poptrie_create(const char *name, int socket_id, struct rte_fib6_conf *conf)
+{
+	char mem_name[POPTRIE_NAMESIZE];
+	struct rte_poptrie_tbl *dp = NULL;
+	uint64_t	def_nh;
+	uint32_t	num_nodes, num_leaves;
+	uint8_t		root_stride;
+	enum rte_fib_trie_nh_sz	nh_sz;
+
+	if ((name == NULL) || (conf == NULL) ||
+			(conf->poptrie.nh_sz < RTE_FIB6_TRIE_2B) ||
+			(conf->poptrie.nh_sz > RTE_FIB6_TRIE_8B) ||
+			(conf->poptrie.num_nodes == 0) ||
+			(conf->poptrie.num_nodes >
+			get_max_nh(conf->poptrie.nh_sz)) ||
+			(conf->poptrie.num_nodes >
+			UINT32_MAX / POPTRIE_LEAVES_PER_NODE) ||
+			(conf->default_nh >
+			get_max_nh(conf->poptrie.nh_sz))) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	root_stride = conf->poptrie.root_stride;
+	if (root_stride == 0)
+		root_stride = POPTRIE_ROOT_STRIDE_DEFAULT;
+	if (root_stride < POPTRIE_ROOT_STRIDE_MIN ||
+			root_stride > POPTRIE_ROOT_STRIDE_MAX) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	def_nh = conf->default_nh;
+	nh_sz = conf->poptrie.nh_sz;
+	num_nodes = conf->poptrie.num_nodes;
+	num_leaves = num_nodes * POPTRIE_LEAVES_PER_NODE;
+
+	/* the vector lookup reads 4 bytes for 2 bytes entries */
+	snprintf(mem_name, sizeof(mem_name), "DP_%s", name);
+	dp = rte_zmalloc_socket(name, sizeof(struct rte_poptrie_tbl) +
+		((size_t)1 << (root_stride + nh_sz)) + sizeof(uint32_t),
+		RTE_CACHE_LINE_SIZE, socket_id);
+	if (dp == NULL) {
+		rte_errno = ENOMEM;
+		return dp;
+	}
+
+	write_to_dp(dp->root, def_nh << 1, nh_sz, 1 << root_stride);
+
+	snprintf(mem_name, sizeof(mem_name), "NODES_%p", dp);
+	dp->nodes = rte_zmalloc_socket(mem_name,
+		sizeof(struct poptrie_node) * num_nodes,
+		RTE_CACHE_LINE_SIZE, socket_id);
+	if (dp->nodes == NULL) {
+		rte_errno = ENOMEM;
+		rte_free(dp);
+		return NULL;
+	}
+
+	snprintf(mem_name, sizeof(mem_name), "LEAVES_%p", dp);
+	dp->leaves = rte_zmalloc_socket(mem_name,
+		((size_t)num_leaves << nh_sz) + sizeof(uint32_t),
+		RTE_CACHE_LINE_SIZE, socket_id);
+	if (dp->leaves == NULL) {
+		rte_errno = ENOMEM;
+		rte_free(dp->nodes);
+		rte_free(dp);
+		return NULL;
+	}
+
+	dp->def_nh = def_nh;
+	dp->nh_sz = nh_sz;
+	dp->root_stride = root_stride;
+
+	/* free runs are linked by their first 4 bytes */
+	pool_init(&dp->node_pool, num_nodes, 1);
+	pool_init(&dp->leaf_pool, num_leaves,
+		RTE_MAX(1U, sizeof(uint32_t) >> nh_sz));
+
+	return dp;
+}
+
+void
+poptrie_free(void *p)
+{
+	struct rte_poptrie_tbl *dp = (struct rte_poptrie_tbl *)p;
+
+	rte_rcu_qsbr_dq_delete(dp->dq);
+	rte_free(dp->leaves);
+	rte_free(dp->nodes);
+	rte_free(dp);
+}
+
+int
+poptrie_rcu_qsbr_add(struct rte_poptrie_tbl *dp,
+	struct rte_fib6_rcu_config *cfg, const char *name)
+{
+	struct rte_rcu_qsbr_dq_parameters params = {0};
+	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
+
+	if (dp == NULL || cfg == NULL)
+		return -EINVAL;
+
+	if (dp->v != NULL)
+		return -EEXIST;
+
+	switch (cfg->mode) {
+	case RTE_FIB6_QSBR_MODE_DQ:
+		/* Init QSBR defer queue. */
+		snprintf(rcu_dq_name, sizeof(rcu_dq_name),
+			"FIB_RCU_%s", name);
+		params.name = rcu_dq_name;
+		params.size = cfg->dq_size;
+		if (params.size == 0)
+			params.size = RTE_FIB6_RCU_DQ_RECLAIM_SZ;
+		params.trigger_reclaim_limit = cfg->reclaim_thd;
+		params.max_reclaim_size = cfg->reclaim_max;
+		if (params.max_reclaim_size == 0)
+			params.max_reclaim_size = RTE_FIB6_RCU_DQ_RECLAIM_MAX;
+		params.esize = sizeof(uint64_t);
+		params.free_fn = __rcu_qsbr_free_resource;
+		params.p = dp;
+		params.v = cfg->v;
+		dp->dq = rte_rcu_qsbr_dq_create(&params);
+		if (dp->dq == NULL) {
+			FIB_LOG(ERR, "FIB6 defer queue creation failed");
+			return -ENOMEM;
+		}
+		break;
+	case RTE_FIB6_QSBR_MODE_SYNC:
+		/* No other things to do. */
+		break;
+	default:
+		return -EINVAL;
+	}
+	dp->rcu_mode = cfg->mode;
+	dp->v = cfg->v;
+
+	return 0;
+}
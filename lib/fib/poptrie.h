@@ -0,0 +1,159 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _POPTRIE_H_
+#define _POPTRIE_H_
+
+#include <stdalign.h>
+
+#include <rte_common.h>
+#include <rte_bitops.h>
+#include <rte_fib6.h>
+
+/**
+ * @file
+ * RTE IPv6 Longest Prefix Match (LPM) with a compressed multibit trie
+ *
+ * The first bits of the address index a root table, then each next
+ * POPTRIE_STRIDE bits index the 64 children of a node. A node keeps
+ * a bitmap of the children which are nodes, and a bitmap of the children
+ * starting a run of equal leaves. The child nodes and the leaves of a node
+ * are contiguous arrays, indexed by the popcount of the bitmaps.
+ */
+
+/* @internal Default number of bits indexing the root table. */
+#define POPTRIE_ROOT_STRIDE_DEFAULT	16
+/* @internal Minimum number of bits indexing the root table. */
+#define POPTRIE_ROOT_STRIDE_MIN		8
+/* @internal Maximum number of bits indexing the root table. */
+#define POPTRIE_ROOT_STRIDE_MAX		24
+/* @internal Number of bits indexing the children of a node. */
+#define POPTRIE_STRIDE			6
+/* @internal Number of children of a node. */
+#define POPTRIE_NUM_CHILDREN		(1 << POPTRIE_STRIDE)
+/* @internal Number of leaves allocated per node. */
+#define POPTRIE_LEAVES_PER_NODE		16
+/* @internal Bit set in a root entry pointing to a node. */
+#define POPTRIE_EXT_ENT			1
+
+struct poptrie_node {
+	uint64_t	vector;		/**< Children which are nodes */
+	uint64_t	leafvec;	/**< Children starting a run of leaves */
+	uint32_t	base0;		/**< Index of the first leaf */
+	uint32_t	base1;		/**< Index of the first child node */
+};
+
+/* Allocator of runs of contiguous entries. */
+struct poptrie_pool {
+	uint32_t	num_ent;	/**< Total number of entries */
+	uint32_t	pos;		/**< First entry never allocated */
+	uint32_t	unit;		/**< Runs are multiple of this length */
+	/** Heads of the lists of free runs, by length */
+	uint32_t	free[POPTRIE_NUM_CHILDREN + 1];
+};
+
+struct rte_poptrie_tbl {
+	uint64_t	def_nh;		/**< Default next hop */
+	enum rte_fib_trie_nh_sz	nh_sz;	/**< Size of nexthop entry */
+	uint8_t		root_stride;	/**< Bits indexing the root table */
+	struct poptrie_node	*nodes;	/**< Nodes table */
+	void		*leaves;	/**< Leaves table */
+	struct poptrie_pool	node_pool;
+	struct poptrie_pool	leaf_pool;
+	/* RCU config. */
+	enum rte_fib6_qsbr_mode rcu_mode; /**< Blocking, defer queue. */
+	struct rte_rcu_qsbr *v; /**< RCU QSBR variable. */
+	struct rte_rcu_qsbr_dq *dq; /**< RCU QSBR defer queue. */
+	/* root table. */
+	alignas(RTE_CACHE_LINE_SIZE) uint64_t	root[];
+};
+
+static inline uint32_t
+poptrie_get_root_idx(const struct rte_ipv6_addr *ip, uint8_t root_stride)
+{
+	return (ip->a[0] << 16 | ip->a[1] << 8 | ip->a[2]) >>
+		(24 - root_stride);
+}
+
+/* Get the POPTRIE_STRIDE bits at offset pos, zero padded past the address. */
+static inline uint32_t
+poptrie_get_chunk(const struct rte_ipv6_addr *ip, uint32_t pos)
+{
+	uint32_t i = pos / 8;
+	uint32_t w = ip->a[i] << 8;
+
+	if (i + 1 < RTE_IPV6_ADDR_SIZE)
+		w |= ip->a[i + 1];
+	return (w >> (16 - POPTRIE_STRIDE - pos % 8)) &
+		(POPTRIE_NUM_CHILDREN - 1);
+}
+
+/* Mask of the children up to and including the child v. */
+static inline uint64_t
+poptrie_child_msk(uint32_t v)
+{
+	return UINT64_MAX >> (POPTRIE_NUM_CHILDREN - 1 - v);
+}
+
+static inline int
+is_poptrie_ext(uint64_t ent)
+{
+	return (ent & POPTRIE_EXT_ENT) == POPTRIE_EXT_ENT;
+}
+
+#define POPTRIE_LOOKUP_FUNC(suffix, type)				\
+static inline void rte_poptrie_lookup_bulk_##suffix(void *p,		\
+	const struct rte_ipv6_addr *ips,				\
+	uint64_t *next_hops, const unsigned int n)			\
+{									\
+	struct rte_poptrie_tbl *dp = (struct rte_poptrie_tbl *)p;	\
+	const struct poptrie_node *node;				\
+	uint64_t ent, msk;						\
+	uint32_t i, pos, v;						\
+									\
+	for (i = 0; i < n; i++) {					\
+		ent = ((type *)dp->root)[poptrie_get_root_idx(&ips[i],	\
+			dp->root_stride)];				\
+		pos = dp->root_stride;					\
+		while (is_poptrie_ext(ent)) {				\
+			node = &dp->nodes[ent >> 1];			\
+			v = poptrie_get_chunk(&ips[i], pos);		\
+			msk = poptrie_child_msk(v);			\
+			pos += POPTRIE_STRIDE;				\
+			if ((node->vector & RTE_BIT64(v)) != 0)		\
+				ent = ((uint64_t)(node->base1 - 1 +	\
+					rte_popcount64(node->vector & msk)) \
+					<< 1) | POPTRIE_EXT_ENT;	\
+			else						\
+				ent = (uint64_t)((type *)dp->leaves)[	\
+					node->base0 - 1 +		\
+					rte_popcount64(node->leafvec & msk)] \
+					<< 1;				\
+		}							\
+		next_hops[i] = ent >> 1;				\
+	}								\
+}
+POPTRIE_LOOKUP_FUNC(2b, uint16_t)
+POPTRIE_LOOKUP_FUNC(4b, uint32_t)
+POPTRIE_LOOKUP_FUNC(8b, uint64_t)
+
+void
+poptrie_free(void *p);
+
+void *
+poptrie_create(const char *name, int socket_id, struct rte_fib6_conf *conf)
+	__rte_malloc __rte_dealloc(poptrie_free, 1);
+
+rte_fib6_lookup_fn_t
+poptrie_get_lookup_fn(void *p, enum rte_fib6_lookup_type type);
+
+int
+poptrie_modify(struct rte_fib6 *fib, const struct rte_ipv6_addr *ip,
+	uint8_t depth, uint64_t next_hop, int op);
+
+int
+poptrie_rcu_qsbr_add(struct rte_poptrie_tbl *dp,
+	struct rte_fib6_rcu_config *cfg, const char *name);
+
+#endif /* _POPTRIE_H_ */
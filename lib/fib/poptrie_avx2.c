@@ -0,0 +1,160 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_vect.h>
+#include <rte_fib6.h>
+
+#include "poptrie.h"
+#include "poptrie_avx2.h"
+
+/*
+ * The addresses are looked up by batches of 4, one per 64-bit lane.
+ * All the lanes index the nodes with the same bits of their address,
+ * so a batch walks down the levels together until all its lanes
+ * have reached a leaf.
+ */
+
+/* Popcount of each 64-bit lane, by nibble lookups. */
+static __rte_always_inline __m256i
+poptrie_avx2_popcnt64(__m256i x)
+{
+	const __m256i lut = _mm256_setr_epi8(
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+		0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+	const __m256i low_msk = _mm256_set1_epi8(0x0f);
+	__m256i cnt;
+
+	cnt = _mm256_add_epi8(
+		_mm256_shuffle_epi8(lut, _mm256_and_si256(x, low_msk)),
+		_mm256_shuffle_epi8(lut, _mm256_and_si256(
+			_mm256_srli_epi16(x, 4), low_msk)));
+	return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+}
+
+/* Gather 4 entries of size bytes, as 64-bit lanes. */
+static __rte_always_inline __m256i
+poptrie_avx2_gather(const void *tbl, __m256i idx, int size)
+{
+	__m128i res;
+
+	if (size == sizeof(uint64_t))
+		return _mm256_i64gather_epi64((const long long *)tbl, idx, 8);
+
+	/* 2 bytes entries are read as 4 bytes, the tables have room for it */
+	if (size == sizeof(uint32_t))
+		res = _mm256_i64gather_epi32((const int *)tbl, idx, 4);
+	else
+		res = _mm_and_si128(
+			_mm256_i64gather_epi32((const int *)tbl, idx, 2),
+			_mm_set1_epi32(UINT16_MAX));
+	return _mm256_cvtepu32_epi64(res);
+}
+
+static __rte_always_inline void
+poptrie_avx2_lookup_x4(struct rte_poptrie_tbl *dp,
+	const struct rte_ipv6_addr *ips, uint64_t *next_hops, int size)
+{
+	const long long *nodes = (const long long *)dp->nodes;
+	const __m256i one = _mm256_set1_epi64x(1);
+	const __m256i base_msk = _mm256_set1_epi64x(UINT32_MAX);
+	const __m256i last = _mm256_set1_epi64x(POPTRIE_NUM_CHILDREN - 1);
+	__m256i ent, ext, res, idx, vector, leafvec, bases, v, msk, bit;
+	__m256i is_node, is_leaf, leaf;
+	uint32_t pos = dp->root_stride;
+	__m128i root_idx;
+
+	root_idx = _mm_setr_epi32(
+		poptrie_get_root_idx(&ips[0], dp->root_stride),
+		poptrie_get_root_idx(&ips[1], dp->root_stride),
+		poptrie_get_root_idx(&ips[2], dp->root_stride),
+		poptrie_get_root_idx(&ips[3], dp->root_stride));
+	ent = poptrie_avx2_gather(dp->root, _mm256_cvtepu32_epi64(root_idx),
+		size);
+	ext = _mm256_cmpeq_epi64(_mm256_and_si256(ent, one), one);
+	res = ent;
+
+	while (!_mm256_testz_si256(ext, ext)) {
+		/* node index as 3 64-bit words, the first node for done lanes */
+		idx = _mm256_and_si256(_mm256_srli_epi64(ent, 1), ext);
+		idx = _mm256_add_epi64(_mm256_slli_epi64(idx, 1), idx);
+		vector = _mm256_i64gather_epi64(nodes, idx, 8);
+		leafvec = _mm256_i64gather_epi64(nodes + 1, idx, 8);
+		bases = _mm256_i64gather_epi64(nodes + 2, idx, 8);
+
+		v = _mm256_set_epi64x(poptrie_get_chunk(&ips[3], pos),
+			poptrie_get_chunk(&ips[2], pos),
+			poptrie_get_chunk(&ips[1], pos),
+			poptrie_get_chunk(&ips[0], pos));
+		pos += POPTRIE_STRIDE;
+		msk = _mm256_srlv_epi64(_mm256_set1_epi64x(-1),
+			_mm256_sub_epi64(last, v));
+		bit = _mm256_sllv_epi64(one, v);
+
+		is_node = _mm256_and_si256(ext, _mm256_cmpeq_epi64(
+			_mm256_and_si256(vector, bit), bit));
+		is_leaf = _mm256_andnot_si256(is_node, ext);
+
+		/* leaves, lanes else pointing to the first leaf */
+		idx = _mm256_add_epi64(_mm256_and_si256(bases, base_msk),
+			_mm256_sub_epi64(poptrie_avx2_popcnt64(
+				_mm256_and_si256(leafvec, msk)), one));
+		leaf = poptrie_avx2_gather(dp->leaves,
+			_mm256_and_si256(idx, is_leaf), size);
+		res = _mm256_blendv_epi8(res, _mm256_slli_epi64(leaf, 1),
+			is_leaf);
+
+		/* child nodes */
+		idx = _mm256_add_epi64(_mm256_srli_epi64(bases, 32),
+			_mm256_sub_epi64(poptrie_avx2_popcnt64(
+				_mm256_and_si256(vector, msk)), one));
+		ent = _mm256_or_si256(_mm256_slli_epi64(idx, 1), one);
+		ext = is_node;
+	}
+
+	_mm256_storeu_si256((void *)next_hops, _mm256_srli_epi64(res, 1));
+}
+
+static __rte_always_inline void
+poptrie_avx2_lookup_bulk(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n, int size)
+{
+	struct rte_poptrie_tbl *dp = (struct rte_poptrie_tbl *)p;
+	unsigned int i;
+
+	for (i = 0; i + 4 <= n; i += 4)
+		poptrie_avx2_lookup_x4(dp, &ips[i], &next_hops[i], size);
+
+	switch (size) {
+	case sizeof(uint16_t):
+		rte_poptrie_lookup_bulk_2b(p, &ips[i], &next_hops[i], n - i);
+		break;
+	case sizeof(uint32_t):
+		rte_poptrie_lookup_bulk_4b(p, &ips[i], &next_hops[i], n - i);
+		break;
+	default:
+		rte_poptrie_lookup_bulk_8b(p, &ips[i], &next_hops[i], n - i);
+		break;
+	}
+}
+
+void
+rte_poptrie_vec_lookup_bulk_2b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	poptrie_avx2_lookup_bulk(p, ips, next_hops, n, sizeof(uint16_t));
+}
+
+void
+rte_poptrie_vec_lookup_bulk_4b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	poptrie_avx2_lookup_bulk(p, ips, next_hops, n, sizeof(uint32_t));
+}
+
+void
+rte_poptrie_vec_lookup_bulk_8b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n)
+{
+	poptrie_avx2_lookup_bulk(p, ips, next_hops, n, sizeof(uint64_t));
+}
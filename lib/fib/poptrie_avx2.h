@@ -0,0 +1,24 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _POPTRIE_AVX2_H_
+#define _POPTRIE_AVX2_H_
+
+#include <stdint.h>
+
+struct rte_ipv6_addr;
+
+void
+rte_poptrie_vec_lookup_bulk_2b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n);
+
+void
+rte_poptrie_vec_lookup_bulk_4b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n);
+
+void
+rte_poptrie_vec_lookup_bulk_8b(void *p, const struct rte_ipv6_addr *ips,
+	uint64_t *next_hops, const unsigned int n);
+
+#endif /* _POPTRIE_AVX2_H_ */
@@ -3,6 +3,7 @@
  * Copyright(c) 2019 Intel Corporation
  */
 
+#include <limits.h>
 #include <stdint.h>
 #include <string.h>
 #include <sys/queue.h>
@@ -138,6 +139,47 @@ rte_fib_delete(struct rte_fib *fib, uint32_t ip, uint8_t depth)
 	return fib->modify(fib, ip, depth, 0, RTE_FIB_DEL);
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_fib_update_bulk, 26.03)
+int
+rte_fib_update_bulk(struct rte_fib *fib,
+	const struct rte_fib_route_update *upd, unsigned int n)
+{
+	unsigned int nb_valid;
+	int ret, err;
+
+	if ((fib == NULL) || (fib->modify == NULL) ||
+			((upd == NULL) && (n != 0)) || (n > INT_MAX))
+		return -EINVAL;
+
+	/* apply the updates up to the first invalid one */
+	for (nb_valid = 0; nb_valid < n; nb_valid++) {
+		if ((upd[nb_valid].depth > RTE_FIB_MAXDEPTH) ||
+				((upd[nb_valid].op != RTE_FIB_ADD) &&
+				(upd[nb_valid].op != RTE_FIB_DEL)))
+			break;
+	}
+
+	switch (fib->type) {
+	case RTE_FIB_DIR24_8:
+		ret = dir24_8_update_bulk(fib, upd, nb_valid);
+		break;
+	default:
+		for (ret = 0; ret < (int)nb_valid; ret++) {
+			err = fib->modify(fib, upd[ret].ip, upd[ret].depth,
+				upd[ret].next_hop, upd[ret].op);
+			if (err != 0) {
+				rte_errno = -err;
+				break;
+			}
+		}
+		break;
+	}
+
+	if ((ret == (int)nb_valid) && (nb_valid != n))
+		rte_errno = EINVAL;
+	return ret;
+}
+
 RTE_EXPORT_SYMBOL(rte_fib_lookup_bulk)
 int
 rte_fib_lookup_bulk(struct rte_fib *fib, uint32_t *ips,
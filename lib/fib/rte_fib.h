@@ -52,6 +52,14 @@ enum rte_fib_type {
 	RTE_FIB_DIR24_8		/**< DIR24_8 based FIB */
 };
 
+/** Route update of rte_fib_update_bulk() */
+struct rte_fib_route_update {
+	uint32_t	ip;		/**< IPv4 prefix address */
+	uint8_t		depth;		/**< Prefix length */
+	uint8_t		op;		/**< RTE_FIB_ADD or RTE_FIB_DEL */
+	uint64_t	next_hop;	/**< Next hop, unused on RTE_FIB_DEL */
+};
+
 /** Modify FIB function */
 typedef int (*rte_fib_modify_fn_t)(struct rte_fib *fib, uint32_t ip,
 	uint8_t depth, uint64_t next_hop, int op);
@@ -87,8 +95,13 @@ enum rte_fib_lookup_type {
 	/**<
 	 * Unified lookup function for all next hop sizes
 	 */
-	RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512
+	RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX512,
 	/**< Vector implementation using AVX512 */
+	RTE_FIB_LOOKUP_DIR24_8_VECTOR_AVX2
+	/**<
+	 * Vector implementation using AVX2,
+	 * with the tables prefetched ahead for large bursts
+	 */
 };
 
 /** If set, fib lookup is expecting IPv4 address in network byte order */
@@ -204,6 +217,34 @@ rte_fib_add(struct rte_fib *fib, uint32_t ip, uint8_t depth, uint64_t next_hop);
 int
 rte_fib_delete(struct rte_fib *fib, uint32_t ip, uint8_t depth);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Apply a burst of route additions and deletions to the FIB.
+ *
+ * The updates are applied in order. The dataplane tables are updated
+ * as with rte_fib_add() and rte_fib_delete(), but the DIR24_8 tbl8 groups
+ * modified by the burst are recycled once at the end of it, waiting for
+ * a single RCU grace period in the RTE_FIB_QSBR_MODE_SYNC mode.
+ *
+ * @param fib
+ *   FIB object handle
+ * @param upd
+ *   Array of route updates
+ * @param n
+ *   Number of elements in the upd array
+ * @return
+ *   Number of updates applied. When less than n, the update at this index
+ *   failed and rte_errno is set to the positive error code
+ *   rte_fib_add() or rte_fib_delete() would have returned.
+ *   -EINVAL for incorrect arguments.
+ */
+__rte_experimental
+int
+rte_fib_update_bulk(struct rte_fib *fib,
+	const struct rte_fib_route_update *upd, unsigned int n);
+
 /**
  * Lookup multiple IP addresses in the FIB.
  *
@@ -51,7 +51,8 @@ enum rte_fib6_qsbr_mode {
 /** Type of FIB struct */
 enum rte_fib6_type {
 	RTE_FIB6_DUMMY,		/**< RIB6 tree based FIB */
-	RTE_FIB6_TRIE		/**< TRIE based fib  */
+	RTE_FIB6_TRIE,		/**< TRIE based fib  */
+	RTE_FIB6_POPTRIE	/**< Compressed multibit trie based FIB */
 };
 
 /** Modify FIB function */
@@ -80,7 +81,11 @@ enum rte_fib6_lookup_type {
 	RTE_FIB6_LOOKUP_DEFAULT,
 	/**< Selects the best implementation based on the max simd bitwidth */
 	RTE_FIB6_LOOKUP_TRIE_SCALAR, /**< Scalar lookup function implementation*/
-	RTE_FIB6_LOOKUP_TRIE_VECTOR_AVX512 /**< Vector implementation using AVX512 */
+	RTE_FIB6_LOOKUP_TRIE_VECTOR_AVX512, /**< Vector implementation using AVX512 */
+	RTE_FIB6_LOOKUP_POPTRIE_SCALAR,
+	/**< Scalar lookup function implementation for compressed trie */
+	RTE_FIB6_LOOKUP_POPTRIE_VECTOR_AVX2
+	/**< Vector implementation for compressed trie using AVX2 */
 };
 
 /** FIB configuration structure */
@@ -96,6 +101,24 @@ struct rte_fib6_conf {
 			enum rte_fib_trie_nh_sz nh_sz;
 			uint32_t	num_tbl8;
 		} trie;
+		/** Configuration of RTE_FIB6_POPTRIE */
+		struct {
+			/** Size of nexthop, an enum rte_fib_trie_nh_sz value */
+			uint8_t		nh_sz;
+			/**
+			 * Number of first bits of the address looked up
+			 * in the root table, from 8 to 24, 0 for 16.
+			 * Each of the next levels looks up 6 bits.
+			 */
+			uint8_t		root_stride;
+			uint16_t	reserved;
+			/**
+			 * Maximum number of nodes, each having room for
+			 * 16 leaves. Half of it at least must be left free
+			 * to rebuild the largest subtree of a root entry.
+			 */
+			uint32_t	num_nodes;
+		} poptrie;
 	};
 };
 
@@ -1128,3 +1128,212 @@ rte_gpu_comm_cleanup_list(struct rte_gpu_comm_list *comm_list_item)
 
 	return 0;
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_gpu_comm_destroy_ring, 26.03)
+int
+rte_gpu_comm_destroy_ring(struct rte_gpu_comm_ring *ring)
+{
+	uint16_t dev_id;
+
+	if (ring == NULL) {
+		rte_errno = EINVAL;
+		return -rte_errno;
+	}
+
+	dev_id = ring->dev_id;
+
+	if (ring->prod_d != NULL && ring->prod_d != ring->prod_h) {
+		rte_gpu_mem_cpu_unmap(dev_id, ring->prod_d);
+		rte_gpu_mem_free(dev_id, ring->prod_d);
+	} else if (ring->prod_h != NULL) {
+		rte_gpu_mem_unregister(dev_id, ring->prod_h);
+		rte_free(ring->prod_h);
+	}
+
+	if (ring->cons != NULL) {
+		rte_gpu_mem_unregister(dev_id, ring->cons);
+		rte_free(ring->cons);
+	}
+
+	if (ring->status != NULL) {
+		rte_gpu_mem_unregister(dev_id, ring->status);
+		rte_free(ring->status);
+	}
+
+	if (ring->pkt_list != NULL) {
+		rte_gpu_mem_unregister(dev_id, ring->pkt_list);
+		rte_free(ring->pkt_list);
+	}
+
+	rte_free(ring->mbufs);
+	rte_gpu_mem_unregister(dev_id, ring);
+	rte_free(ring);
+
+	return 0;
+}
+
+/* Allocate CPU memory visible from the device. */
+static void *
+gpu_comm_ring_zmalloc(uint16_t dev_id, size_t size)
+{
+	void *ptr;
+
+	ptr = rte_zmalloc(NULL, size, 0);
+	if (ptr == NULL)
+		return NULL;
+
+	if (rte_gpu_mem_register(dev_id, size, ptr) < 0) {
+		rte_free(ptr);
+		return NULL;
+	}
+
+	return ptr;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_gpu_comm_create_ring, 26.03)
+struct rte_gpu_comm_ring *
+rte_gpu_comm_create_ring(uint16_t dev_id, uint32_t size)
+{
+	struct rte_gpu_comm_ring *ring;
+	struct rte_gpu_info info;
+
+	if (size == 0 || !rte_is_power_of_2(size)) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	if (gpu_get_by_id(dev_id) == NULL) {
+		GPU_LOG(ERR, "comm ring for invalid device ID %d", dev_id);
+		rte_errno = ENODEV;
+		return NULL;
+	}
+
+	if (rte_gpu_info_get(dev_id, &info) < 0) {
+		rte_errno = ENODEV;
+		return NULL;
+	}
+
+	ring = gpu_comm_ring_zmalloc(dev_id, sizeof(*ring));
+	if (ring == NULL) {
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+	ring->dev_id = dev_id;
+	ring->size = size;
+
+	ring->pkt_list = gpu_comm_ring_zmalloc(dev_id,
+			sizeof(struct rte_gpu_comm_pkt) * size);
+	ring->status = gpu_comm_ring_zmalloc(dev_id,
+			sizeof(enum rte_gpu_comm_list_status) * size);
+	ring->cons = gpu_comm_ring_zmalloc(dev_id, sizeof(uint32_t));
+	ring->mbufs = rte_zmalloc(NULL, sizeof(struct rte_mbuf *) * size, 0);
+	if (ring->pkt_list == NULL || ring->status == NULL ||
+			ring->cons == NULL || ring->mbufs == NULL)
+		goto error;
+
+	/*
+	 * As for the status flags of the communication list,
+	 * the doorbell polled by the device is allocated in GPU memory
+	 * when the driver can map it for the CPU.
+	 */
+	ring->prod_d = rte_gpu_mem_alloc(dev_id, sizeof(uint32_t),
+			info.page_size);
+	if (ring->prod_d != NULL) {
+		ring->prod_h = rte_gpu_mem_cpu_map(dev_id, sizeof(uint32_t),
+				ring->prod_d);
+		if (ring->prod_h == NULL) {
+			rte_gpu_mem_free(dev_id, ring->prod_d);
+			ring->prod_d = NULL;
+		}
+	}
+	if (ring->prod_h == NULL) {
+		ring->prod_h = gpu_comm_ring_zmalloc(dev_id, sizeof(uint32_t));
+		if (ring->prod_h == NULL)
+			goto error;
+		ring->prod_d = ring->prod_h;
+	}
+
+	RTE_GPU_VOLATILE(*ring->prod_h) = 0;
+	rte_gpu_wmb(dev_id);
+
+	return ring;
+
+error:
+	rte_gpu_comm_destroy_ring(ring);
+	rte_errno = ENOMEM;
+	return NULL;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_gpu_comm_enqueue_burst, 26.03)
+uint32_t
+rte_gpu_comm_enqueue_burst(struct rte_gpu_comm_ring *ring,
+		struct rte_mbuf **mbufs, uint32_t num_mbufs)
+{
+	uint32_t idx, entry;
+
+	if (ring == NULL || mbufs == NULL) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+
+	num_mbufs = RTE_MIN(num_mbufs, ring->size - (ring->head - ring->tail));
+
+	for (idx = 0; idx < num_mbufs; idx++) {
+		/* support only unchained mbufs */
+		if (unlikely((mbufs[idx]->nb_segs > 1) ||
+				(mbufs[idx]->next != NULL) ||
+				(mbufs[idx]->data_len != mbufs[idx]->pkt_len))) {
+			rte_errno = ENOTSUP;
+			break;
+		}
+
+		entry = (ring->head + idx) & (ring->size - 1);
+		ring->pkt_list[entry].addr =
+				rte_pktmbuf_mtod_offset(mbufs[idx], uintptr_t, 0);
+		ring->pkt_list[entry].size = mbufs[idx]->pkt_len;
+		ring->mbufs[entry] = mbufs[idx];
+	}
+
+	if (idx == 0)
+		return 0;
+
+	/* A single doorbell for the whole burst. */
+	ring->head += idx;
+	rte_wmb();
+	RTE_GPU_VOLATILE(*ring->prod_h) = ring->head;
+	rte_gpu_wmb(ring->dev_id);
+
+	return idx;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_gpu_comm_dequeue_burst, 26.03)
+uint32_t
+rte_gpu_comm_dequeue_burst(struct rte_gpu_comm_ring *ring,
+		struct rte_mbuf **mbufs, enum rte_gpu_comm_list_status *status,
+		uint32_t num_mbufs)
+{
+	uint32_t idx, entry;
+
+	if (ring == NULL || mbufs == NULL) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+
+	num_mbufs = RTE_MIN(num_mbufs,
+			RTE_GPU_VOLATILE(*ring->cons) - ring->tail);
+	if (num_mbufs == 0)
+		return 0;
+
+	/* Status of the entries is written before the consumer index. */
+	rte_rmb();
+
+	for (idx = 0; idx < num_mbufs; idx++) {
+		entry = (ring->tail + idx) & (ring->size - 1);
+		mbufs[idx] = ring->mbufs[entry];
+		if (status != NULL)
+			status[idx] = RTE_GPU_VOLATILE(ring->status[entry]);
+	}
+	ring->tail += num_mbufs;
+
+	return num_mbufs;
+}
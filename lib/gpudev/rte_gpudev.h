@@ -132,6 +132,41 @@ struct rte_gpu_comm_list {
 	enum rte_gpu_comm_list_status *status_d;
 };
 
+/**
+ * Communication ring to share packets between CPU and device,
+ * polled by a device workload running for the application lifetime
+ * (e.g. a persistent CUDA kernel).
+ *
+ * The CPU fills the ring entries with packets info
+ * and rings the doorbell once per burst, writing the producer index.
+ * The device processes the entries up to the producer index,
+ * writes their completion status in CPU memory
+ * and then advances the consumer index, possibly once per batch.
+ * The indexes are free-running, the entry of an index is index & (size - 1).
+ */
+struct rte_gpu_comm_ring {
+	/** Device that will use the communication ring. */
+	uint16_t dev_id;
+	/** Number of entries, a power of 2. */
+	uint32_t size;
+	/** Packets info of the entries, populated by the CPU. */
+	struct rte_gpu_comm_pkt *pkt_list;
+	/** Completion status of the entries, written by the device. */
+	enum rte_gpu_comm_list_status *status;
+	/** mbufs of the entries, used by the CPU only. */
+	struct rte_mbuf **mbufs;
+	/** Producer index, the doorbell. CPU pointer. */
+	uint32_t *prod_h;
+	/** Producer index, the doorbell. GPU pointer. */
+	uint32_t *prod_d;
+	/** Consumer index, written by the device in CPU memory. */
+	uint32_t *cons;
+	/** Index of the next entry to populate, used by the CPU only. */
+	uint32_t head;
+	/** Index of the next entry to dequeue, used by the CPU only. */
+	uint32_t tail;
+};
+
 /**
  * @warning
  * @b EXPERIMENTAL: this API may change without prior notice.
@@ -740,6 +775,99 @@ int rte_gpu_comm_get_status(struct rte_gpu_comm_list *comm_list_item,
 __rte_experimental
 int rte_gpu_comm_cleanup_list(struct rte_gpu_comm_list *comm_list_item);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a communication ring that can be used to share packets
+ * between CPU and device, with a single doorbell per burst.
+ *
+ * The doorbell is allocated in device memory mapped for the CPU
+ * if the driver supports it, so the device polls it locally.
+ * The other parts of the ring are allocated in CPU-visible memory,
+ * so the CPU polls the completions locally.
+ *
+ * @param dev_id
+ *   Reference device ID.
+ * @param size
+ *   Number of entries in the ring, must be a power of 2.
+ *
+ * @return
+ *   A pointer to the allocated ring, otherwise NULL and rte_errno is set:
+ *   - ENODEV if invalid dev_id
+ *   - EINVAL if invalid input params
+ *   - ENOMEM if out of space
+ */
+__rte_experimental
+struct rte_gpu_comm_ring *rte_gpu_comm_create_ring(uint16_t dev_id,
+		uint32_t size);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Destroy a communication ring.
+ * The mbufs still in the ring are not freed.
+ *
+ * @param ring
+ *   Communication ring to be destroyed.
+ *
+ * @return
+ *   0 on success, -rte_errno otherwise:
+ *   - EINVAL if invalid input params
+ */
+__rte_experimental
+int rte_gpu_comm_destroy_ring(struct rte_gpu_comm_ring *ring);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Populate the next entries of the communication ring
+ * with info from a list of mbufs, then ring the doorbell once.
+ * The mbufs payload is not accessed.
+ *
+ * @param ring
+ *   Communication ring to fill.
+ * @param mbufs
+ *   List of mbufs.
+ * @param num_mbufs
+ *   Number of mbufs.
+ *
+ * @return
+ *   Number of mbufs added to the ring, which is less than num_mbufs
+ *   if the ring is full or if an mbuf is chained (rte_errno set to ENOTSUP).
+ */
+__rte_experimental
+uint32_t rte_gpu_comm_enqueue_burst(struct rte_gpu_comm_ring *ring,
+		struct rte_mbuf **mbufs, uint32_t num_mbufs);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Retrieve the mbufs of the entries completed by the device,
+ * in the order they were enqueued.
+ * The mbufs are given back to the application to be transmitted,
+ * freed or recycled, their payload is not accessed.
+ *
+ * @param ring
+ *   Communication ring to poll.
+ * @param mbufs
+ *   Array of mbufs to fill.
+ * @param status
+ *   Array filled with the completion status of each mbuf, may be NULL.
+ * @param num_mbufs
+ *   Maximum number of mbufs to retrieve.
+ *
+ * @return
+ *   Number of mbufs retrieved.
+ */
+__rte_experimental
+uint32_t rte_gpu_comm_dequeue_burst(struct rte_gpu_comm_ring *ring,
+		struct rte_mbuf **mbufs, enum rte_gpu_comm_list_status *status,
+		uint32_t num_mbufs);
+
 #ifdef __cplusplus
 }
 #endif
@@ -497,6 +497,8 @@ rte_graph_create(const char *name, struct rte_graph_param *prm)
 	graph->num_pkt_to_capture = prm->num_pkt_to_capture;
 	if (prm->pcap_filename)
 		rte_strscpy(graph->pcap_filename, prm->pcap_filename, RTE_GRAPH_PCAP_FILE_SZ);
+	graph->pcap_async = prm->pcap_async;
+	graph->pcap_snaplen = prm->pcap_snaplen;
 
 	/* Allocate the Graph fast path memory and populate the data */
 	if (graph_fp_mem_create(graph))
@@ -540,6 +542,9 @@ rte_graph_destroy(rte_graph_t id)
 			if (rte_graph_worker_model_get(graph->graph) ==
 			    RTE_GRAPH_MODEL_MCORE_DISPATCH)
 				graph_sched_wq_destroy(graph);
+			else if (rte_graph_worker_model_get(graph->graph) ==
+				 RTE_GRAPH_MODEL_WORK_STEAL)
+				graph_steal_wq_destroy(graph);
 
 			/* Call fini() of the all the nodes in the graph */
 			graph_node_fini(graph);
@@ -562,7 +567,8 @@ rte_graph_destroy(rte_graph_t id)
 }
 
 static rte_graph_t
-graph_clone(struct graph *parent_graph, const char *name, struct rte_graph_param *prm)
+graph_clone(struct graph *parent_graph, const char *name, struct rte_graph_param *prm,
+	    int socket_id)
 {
 	struct graph_node *graph_node;
 	struct graph *graph;
@@ -603,7 +609,10 @@ graph_clone(struct graph *parent_graph, const char *name, struct rte_graph_param
 	graph->node_count = parent_graph->node_count;
 	graph->parent_id = parent_graph->id;
 	graph->lcore_id = parent_graph->lcore_id;
-	graph->socket = parent_graph->socket;
+	graph->pcap_async = parent_graph->pcap_async;
+	graph->pcap_snaplen = parent_graph->pcap_snaplen;
+	/* Fast path memory, node streams and contexts are allocated on it */
+	graph->socket = socket_id == SOCKET_ID_ANY ? parent_graph->socket : socket_id;
 	graph->id = graph_next_free_id();
 
 	/* Allocate the Graph fast path memory and populate the data */
@@ -620,6 +629,9 @@ graph_clone(struct graph *parent_graph, const char *name, struct rte_graph_param
 
 		graph->graph->dispatch.notify_cb = prm->dispatch.notify_cb;
 		graph->graph->dispatch.cb_priv = prm->dispatch.cb_priv;
+	} else if (rte_graph_worker_model_get(graph->graph) == RTE_GRAPH_MODEL_WORK_STEAL) {
+		if (graph_steal_wq_create(graph, parent_graph, prm))
+			goto graph_mem_destroy;
 	}
 
 	/* Call init() of the all the nodes in the graph */
@@ -653,7 +665,30 @@ rte_graph_clone(rte_graph_t id, const char *name, struct rte_graph_param *prm)
 		goto fail;
 	STAILQ_FOREACH(graph, &graph_list, next)
 		if (graph->id == id)
-			return graph_clone(graph, name, prm);
+			return graph_clone(graph, name, prm, SOCKET_ID_ANY);
+
+fail:
+	return RTE_GRAPH_ID_INVALID;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_clone_socket, 26.03)
+rte_graph_t
+rte_graph_clone_socket(rte_graph_t id, const char *name, struct rte_graph_param *prm,
+		       int socket_id)
+{
+	struct graph *graph;
+
+	if (socket_id != SOCKET_ID_ANY &&
+	    (socket_id < 0 || socket_id >= RTE_MAX_NUMA_NODES)) {
+		rte_errno = EINVAL;
+		goto fail;
+	}
+
+	if (graph_from_id(id) == NULL)
+		goto fail;
+	STAILQ_FOREACH(graph, &graph_list, next)
+		if (graph->id == id)
+			return graph_clone(graph, name, prm, socket_id);
 
 fail:
 	return RTE_GRAPH_ID_INVALID;
@@ -735,6 +770,23 @@ rte_graph_node_get_by_name(const char *graph_name, const char *node_name)
 	return NULL;
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_hist_enable, 26.03)
+int
+rte_graph_hist_enable(rte_graph_t id, bool enable)
+{
+	struct graph *graph;
+
+	if (!rte_graph_has_stats_feature())
+		return -ENOTSUP;
+
+	graph = graph_from_id(id);
+	if (graph == NULL)
+		return -EINVAL;
+
+	graph->graph->hist = enable;
+	return 0;
+}
+
 RTE_EXPORT_SYMBOL(__rte_node_stream_alloc)
 void __rte_noinline
 __rte_node_stream_alloc(struct rte_graph *graph, struct rte_node *node)
@@ -91,8 +91,18 @@ rte_graph_obj_dump(FILE *f, struct rte_graph *g, bool all)
 				n->dispatch.total_sched_objs);
 			fprintf(f, "       total_sched_fail=%" PRId64 "\n",
 				n->dispatch.total_sched_fail);
+		} else if (rte_graph_worker_model_get(g) == RTE_GRAPH_MODEL_WORK_STEAL) {
+			fprintf(f, "       total_offered_objs=%" PRId64 "\n",
+				n->steal.total_offered_objs);
+			fprintf(f, "       total_stolen_objs=%" PRId64 "\n",
+				n->steal.total_stolen_objs);
 		}
 		fprintf(f, "       total_calls=%" PRId64 "\n", n->total_calls);
+		if (n->batch.min_objs > 1) {
+			fprintf(f, "       batch_min_objs=%d\n", n->batch.min_objs);
+			fprintf(f, "       total_deferred=%" PRId64 "\n",
+				n->batch.total_deferred);
+		}
 		for (i = 0; i < n->nb_edges; i++)
 			fprintf(f, "          edge[%d] <%s>\n", i,
 				n->nodes[i]->name);
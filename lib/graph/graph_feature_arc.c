@@ -480,6 +480,7 @@ feature_arc_data_reset(struct rte_graph_feature_arc *arc)
 	uint16_t index;
 
 	arc->runtime_enabled_features = 0;
+	arc->fp_uniform_first_feature = UINT64_MAX;
 
 	for (index = 0; index < arc->max_indexes; index++) {
 		f = graph_first_feature_data_ptr_get(arc, index);
@@ -1061,6 +1062,45 @@ refill_fastpath_data(struct rte_graph_feature_arc *arc, uint32_t feature_bit,
 	return 0;
 }
 
+/*
+ * Recompute uniform first feature once enable/disable has rewired fast path
+ * data. It is only valid when features, other than end_feature, are enabled on
+ * exactly one index.
+ */
+static void
+uniform_fastpath_data_update(struct rte_graph_feature_arc *arc)
+{
+	struct rte_graph_feature_data *fdptr = NULL;
+	rte_graph_feature_data_t *first_fd = NULL;
+	uint16_t index, uniform_index = 0;
+	uint64_t uf = UINT64_MAX;
+	uint32_t num_indexes = 0;
+
+	for (index = 0; index < arc->max_indexes; index++) {
+		/* end_feature bit is always set once arc is prepared */
+		if (rte_popcount64(arc->feature_bit_mask_by_index[index]) <= 1)
+			continue;
+
+		uniform_index = index;
+		if (++num_indexes > 1)
+			break;
+	}
+
+	if (num_indexes == 1) {
+		first_fd = graph_first_feature_data_ptr_get(arc, uniform_index);
+		if (rte_graph_feature_data_is_valid(*first_fd)) {
+			fdptr = rte_graph_feature_data_get(arc, *first_fd);
+			uf = ((uint64_t)fdptr->next_feature_data << 32) |
+			     ((uint64_t)fdptr->next_edge << 16) | uniform_index;
+		}
+	}
+
+	feat_dbg("%s: uniform first feature: 0x%" PRIx64, arc->feature_arc_name, uf);
+
+	rte_atomic_store_explicit(&arc->fp_uniform_first_feature, uf,
+				  rte_memory_order_release);
+}
+
 /* feature arc initialization, public API */
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_feature_arc_init, 25.07)
 int
@@ -1645,6 +1685,8 @@ rte_graph_feature_enable(rte_graph_feature_arc_t _arc, uint32_t index,
 	if (refill_fastpath_data(arc, slot, index, 1 /* enable */) < 0)
 		return -1;
 
+	uniform_fastpath_data_update(arc);
+
 	/* On very first feature enable instance */
 	if (!finfo->ref_count) {
 		/* If first time feature getting enabled
@@ -1745,6 +1787,8 @@ rte_graph_feature_disable(rte_graph_feature_arc_t _arc, uint32_t index, const ch
 	if (refill_fastpath_data(arc, slot, index, 0 /* disable */) < 0)
 		return -1;
 
+	uniform_fastpath_data_update(arc);
+
 	finfo->ref_count--;
 
 	/* When last feature is disabled */
@@ -7,9 +7,11 @@
 #include <stdlib.h>
 #include <unistd.h>
 
+#include <eal_export.h>
 #include <rte_ethdev.h>
 #include <rte_mbuf.h>
 #include <rte_pcapng.h>
+#include <rte_ring.h>
 
 #include "rte_graph_worker.h"
 
@@ -18,11 +20,15 @@
 #define GRAPH_PCAP_NUM_PACKETS	1024
 #define GRAPH_PCAP_PKT_POOL	"graph_pcap_pkt_pool"
 #define GRAPH_PCAP_FILE_NAME	"dpdk_graph_pcap_capture_XXXXXX.pcapng"
+#define GRAPH_PCAP_RING		"graph_pcap_ring"
+#define GRAPH_PCAP_RING_SIZE	4096
 
 /* For multi-process, packets are captured in separate files. */
 static rte_pcapng_t *pcapng_fd;
 static bool pcap_enable;
 struct rte_mempool *pkt_mp;
+/* Packets copied by the workers in async mode, written by the drain lcore. */
+static struct rte_ring *pcap_ring;
 
 void
 graph_pcap_enable(bool val)
@@ -36,9 +42,47 @@ graph_pcap_is_enable(void)
 	return pcap_enable;
 }
 
+static int
+graph_pcap_ring_write(void)
+{
+	struct rte_mbuf *mbufs[RTE_GRAPH_BURST_SIZE];
+	unsigned int nb;
+	ssize_t len;
+
+	nb = rte_ring_sc_dequeue_burst(pcap_ring, (void **)mbufs, RTE_DIM(mbufs), NULL);
+	if (nb == 0)
+		return 0;
+
+	len = rte_pcapng_write_packets(pcapng_fd, mbufs, nb);
+	rte_pktmbuf_free_bulk(mbufs, nb);
+	if (len < 0)
+		return -errno;
+
+	return nb;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_graph_pcap_drain, 26.03)
+int
+rte_graph_pcap_drain(void)
+{
+	if (pcap_ring == NULL || pcapng_fd == NULL)
+		return -ENOTSUP;
+
+	return graph_pcap_ring_write();
+}
+
 void
 graph_pcap_exit(struct rte_graph *graph)
 {
+	if (pcap_ring) {
+		/* Write the packets not drained yet */
+		if (pcapng_fd)
+			while (graph_pcap_ring_write() > 0)
+				;
+		rte_ring_free(pcap_ring);
+		pcap_ring = NULL;
+	}
+
 	if (rte_eal_process_type() == RTE_PROC_PRIMARY)
 		rte_mempool_free(pkt_mp);
 
@@ -145,7 +189,8 @@ graph_pcap_mp_init(void)
 
 	/* Make a pool for cloned packets */
 	pkt_mp = rte_pktmbuf_pool_create_by_ops(GRAPH_PCAP_PKT_POOL,
-			IOV_MAX + RTE_GRAPH_BURST_SIZE,	0, 0,
+			IOV_MAX + RTE_GRAPH_BURST_SIZE +
+			(pcap_ring ? GRAPH_PCAP_RING_SIZE : 0), 0, 0,
 			rte_pcapng_mbuf_size(RTE_MBUF_DEFAULT_BUF_SIZE),
 			SOCKET_ID_ANY, "ring_mp_mc");
 	if (pkt_mp == NULL) {
@@ -157,6 +202,23 @@ graph_pcap_mp_init(void)
 	return 0;
 }
 
+static int
+graph_pcap_ring_init(void)
+{
+	if (pcap_ring)
+		return 0;
+
+	/* Any worker enqueues, only the drain lcore dequeues */
+	pcap_ring = rte_ring_create(GRAPH_PCAP_RING, GRAPH_PCAP_RING_SIZE,
+				    SOCKET_ID_ANY, RING_F_SC_DEQ);
+	if (pcap_ring == NULL) {
+		graph_err("Cannot create ring for graph pcap capture.");
+		return -1;
+	}
+
+	return 0;
+}
+
 int
 graph_pcap_init(struct graph *graph)
 {
@@ -165,6 +227,9 @@ graph_pcap_init(struct graph *graph)
 	if (graph_pcap_file_open(graph->pcap_filename) < 0)
 		goto error;
 
+	if (graph->pcap_async && graph_pcap_ring_init() < 0)
+		goto error;
+
 	if (graph_pcap_mp_init() < 0)
 		goto error;
 
@@ -173,6 +238,7 @@ graph_pcap_init(struct graph *graph)
 		graph_data->nb_pkt_to_capture = graph->num_pkt_to_capture;
 	else
 		graph_data->nb_pkt_to_capture = GRAPH_PCAP_NUM_PACKETS;
+	graph_data->pcap_snaplen = graph->pcap_snaplen;
 
 	/* All good. Now populate data for secondary process. */
 	rte_strscpy(graph_data->pcap_filename, graph->pcap_filename, RTE_GRAPH_PCAP_FILE_SZ);
@@ -192,10 +258,11 @@ graph_pcap_dispatch(struct rte_graph *graph,
 			      struct rte_node *node, void **objs,
 			      uint16_t nb_objs)
 {
+	char comment[RTE_GRAPH_NAMESIZE + RTE_NODE_NAMESIZE + 2];
 	struct rte_mbuf *mbuf_clones[RTE_GRAPH_BURST_SIZE];
 	uint64_t i, num_packets;
 	struct rte_mbuf *mbuf;
-	char *comment;
+	uint32_t length;
 	ssize_t len;
 
 	if (!nb_objs || (graph->nb_pkt_captured >= graph->nb_pkt_to_capture))
@@ -207,22 +274,31 @@ graph_pcap_dispatch(struct rte_graph *graph,
 		num_packets = nb_objs;
 
 	/* put a comment on all these packets */
-	if (asprintf(&comment, "%s: %s", graph->name, node->name) < 0) {
-		graph_err("asprintf for comment failed.");
-		comment = NULL;
-	}
+	snprintf(comment, sizeof(comment), "%s: %s", graph->name, node->name);
 
 	for (i = 0; i < num_packets; i++) {
 		struct rte_mbuf *mc;
 		mbuf = (struct rte_mbuf *)objs[i];
 
-		mc = rte_pcapng_copy(mbuf->port, 0, mbuf, pkt_mp, mbuf->pkt_len, 0, comment);
+		length = mbuf->pkt_len;
+		if (graph->pcap_snaplen && length > graph->pcap_snaplen)
+			length = graph->pcap_snaplen;
+
+		mc = rte_pcapng_copy(mbuf->port, 0, mbuf, pkt_mp, length, 0, comment);
 		if (mc == NULL)
 			break;
 
 		mbuf_clones[i] = mc;
 	}
-	free(comment);
+
+	/* In async mode, the drain lcore writes them to capture file */
+	if (pcap_ring) {
+		len = rte_ring_mp_enqueue_burst(pcap_ring, (void **)mbuf_clones, i, NULL);
+		if (unlikely(len < (ssize_t)i))
+			rte_pktmbuf_free_bulk(&mbuf_clones[len], i - len);
+		graph->nb_pkt_captured += len;
+		goto done;
+	}
 
 	/* write it to capture file */
 	len = rte_pcapng_write_packets(pcapng_fd, mbuf_clones, i);
@@ -48,6 +48,11 @@ graph_fp_mem_calc_size(struct graph *graph)
 		sz = RTE_ALIGN(sz, RTE_CACHE_LINE_SIZE);
 		sz += sizeof(uint64_t) * graph_node->node->xstats->nb_xstats;
 	}
+	sz = RTE_ALIGN(sz, RTE_CACHE_LINE_SIZE);
+	graph->hist_start = sz;
+	/* For 0..N node objects with histograms */
+	if (rte_graph_has_stats_feature())
+		sz += graph->node_count * GRAPH_NODE_HIST_SZ;
 
 	graph->mem_sz = sz;
 	return sz;
@@ -74,6 +79,7 @@ static void
 graph_nodes_populate(struct graph *_graph)
 {
 	rte_graph_off_t xstat_off = _graph->xstats_start;
+	rte_graph_off_t hist_off = _graph->hist_start;
 	rte_graph_off_t off = _graph->nodes_start;
 	struct rte_graph *graph = _graph->graph;
 	struct graph_node *graph_node;
@@ -105,6 +111,12 @@ graph_nodes_populate(struct graph *_graph)
 		node->id = graph_node->node->id;
 		node->parent_id = pid;
 		node->dispatch.lcore_id = graph_node->node->lcore_id;
+		if (graph_node->node->batch_min_objs > 1) {
+			node->batch.min_objs = graph_node->node->batch_min_objs;
+			node->batch.wait_cycles = rte_get_tsc_hz() *
+				graph_node->node->batch_max_wait_us / US_PER_S;
+			graph->batch = 1;
+		}
 		nb_edges = graph_node->node->nb_edges;
 		node->nb_edges = nb_edges;
 		off += sizeof(struct rte_node);
@@ -120,6 +132,11 @@ graph_nodes_populate(struct graph *_graph)
 			xstat_off = RTE_ALIGN(xstat_off, RTE_CACHE_LINE_SIZE);
 		}
 
+		if (rte_graph_has_stats_feature()) {
+			node->hist_off = hist_off - node->off;
+			hist_off += GRAPH_NODE_HIST_SZ;
+		}
+
 		off += sizeof(struct rte_node *) * nb_edges;
 		off = RTE_ALIGN(off, RTE_CACHE_LINE_SIZE);
 		node->next = off;
@@ -40,6 +40,12 @@ extern int rte_graph_logtype;
 		goto where;                                                    \
 	} while (0)
 
+/* Size of the cycles and objs histograms of a node in graph reel */
+#define GRAPH_NODE_HIST_SZ                                                     \
+	RTE_ALIGN(sizeof(uint64_t) * (RTE_GRAPH_HIST_CYCLES_BUCKETS +          \
+				      RTE_GRAPH_HIST_OBJS_BUCKETS),            \
+		  RTE_CACHE_LINE_SIZE)
+
 /**
  * @internal
  *
@@ -51,6 +57,8 @@ struct node {
 	uint64_t flags;		      /**< Node configuration flag. */
 	unsigned int lcore_id;
 	/**< Node runs on the Lcore ID used for mcore dispatch model. */
+	uint16_t batch_min_objs;      /**< Minimum stream size to process. */
+	uint32_t batch_max_wait_us;   /**< Maximum deferral of a small stream. */
 	rte_node_process_t process;   /**< Node process function. */
 	rte_node_init_t init;         /**< Node init function. */
 	rte_node_fini_t fini;	      /**< Node fini function. */
@@ -65,7 +73,7 @@ struct node {
  * @internal
  *
  * Structure that holds the graph scheduling workqueue node stream.
- * Used for mcore dispatch model.
+ * Used for mcore dispatch and work-stealing models.
  */
 struct __rte_cache_aligned graph_mcore_dispatch_wq_node {
 	rte_graph_off_t node_off;
@@ -101,6 +109,8 @@ struct graph {
 	/**< Node memory start offset in graph reel. */
 	rte_graph_off_t xstats_start;
 	/**< Node xstats memory start offset in graph reel. */
+	rte_graph_off_t hist_start;
+	/**< Node histograms memory start offset in graph reel. */
 	rte_node_t src_node_count;
 	/**< Number of source nodes in a graph. */
 	struct rte_graph *graph;
@@ -125,6 +135,10 @@ struct graph {
 	/**< Number of packets to be captured per core. */
 	char pcap_filename[RTE_GRAPH_PCAP_FILE_SZ];
 	/**< pcap file name/path. */
+	bool pcap_async;
+	/**< Captured packets are written by rte_graph_pcap_drain(). */
+	uint32_t pcap_snaplen;
+	/**< Maximum length of captured packets, whole packets if 0. */
 	STAILQ_HEAD(gnode_list, graph_node) node_list;
 	/**< Nodes in a graph. */
 };
@@ -467,6 +481,37 @@ int graph_sched_wq_create(struct graph *_graph, struct graph *_parent_graph,
  */
 void graph_sched_wq_destroy(struct graph *_graph);
 
+/**
+ * @internal
+ *
+ * Create the graph steal work queue for work-stealing model.
+ * All cloned graphs attached to the parent graph MUST be destroyed together
+ * since they steal from each other.
+ *
+ * @param _graph
+ *   The graph object
+ * @param _parent_graph
+ *   The parent graph object which holds the steal list head.
+ * @param prm
+ *   Graph parameter, includes model-specific parameters in this graph.
+ *
+ * @return
+ *   - 0: Success.
+ *   - <0: Graph steal work queue related error.
+ */
+int graph_steal_wq_create(struct graph *_graph, struct graph *_parent_graph,
+			  struct rte_graph_param *prm);
+
+/**
+ * @internal
+ *
+ * Destroy the graph steal work queue for work-stealing model.
+ *
+ * @param _graph
+ *   The graph object
+ */
+void graph_steal_wq_destroy(struct graph *_graph);
+
 /**
  * @internal
  *
@@ -10,6 +10,8 @@
 #include <rte_common.h>
 #include <rte_errno.h>
 #include <rte_malloc.h>
+#include <rte_string_fns.h>
+#include <rte_telemetry.h>
 
 #include "graph_private.h"
 
@@ -140,6 +142,66 @@ print_xstat(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispa
 	}
 }
 
+/* Upper bound of the bucket holding the given percentile of the calls */
+static uint64_t
+hist_percentile(const uint64_t *hist, unsigned int nb_buckets, unsigned int pct)
+{
+	uint64_t calls = 0, sum = 0;
+	unsigned int i;
+
+	for (i = 0; i < nb_buckets; i++)
+		calls += hist[i];
+
+	for (i = 0; i < nb_buckets; i++) {
+		sum += hist[i];
+		if (sum * 100 >= calls * pct)
+			break;
+	}
+
+	return i == 0 ? 0 : (UINT64_C(1) << i) - 1;
+}
+
+static inline void
+print_hist(FILE *f, const struct rte_graph_cluster_node_stats *stat, bool dispatch)
+{
+	const struct {
+		const char *desc;
+		const uint64_t *hist;
+		unsigned int nb_buckets;
+		unsigned int pct;
+	} rows[] = {
+		{ "cycles/call p50", stat->cycles_hist, RTE_GRAPH_HIST_CYCLES_BUCKETS, 50 },
+		{ "cycles/call p99", stat->cycles_hist, RTE_GRAPH_HIST_CYCLES_BUCKETS, 99 },
+		{ "objs/call p50", stat->objs_hist, RTE_GRAPH_HIST_OBJS_BUCKETS, 50 },
+	};
+	unsigned int i;
+	uint64_t val;
+
+	for (i = 0; i < RTE_DIM(rows); i++) {
+		val = hist_percentile(rows[i].hist, rows[i].nb_buckets, rows[i].pct);
+		if (dispatch)
+			fprintf(f,
+				"|\t%-24s|%15s|%-15" PRIu64 "|%15s|%15s|%15s|%15s|%15s|%11.4s|\n",
+				rows[i].desc, "", val, "", "", "", "", "", "");
+		else
+			fprintf(f,
+				"|\t%-24s|%15s|%-15" PRIu64 "|%15s|%15.3s|%15.6s|%11.4s|\n",
+				rows[i].desc, "", val, "", "", "", "");
+	}
+}
+
+static bool
+hist_is_empty(const uint64_t *hist, unsigned int nb_buckets)
+{
+	unsigned int i;
+
+	for (i = 0; i < nb_buckets; i++)
+		if (hist[i] != 0)
+			return false;
+
+	return true;
+}
+
 static int
 graph_cluster_stats_cb(bool dispatch, bool is_first, bool is_last, void *cookie,
 		       const struct rte_graph_cluster_node_stats *stat)
@@ -152,6 +214,8 @@ graph_cluster_stats_cb(bool dispatch, bool is_first, bool is_last, void *cookie,
 		print_node(f, stat, dispatch);
 		if (stat->xstat_cntrs)
 			print_xstat(f, stat, dispatch);
+		if (!hist_is_empty(stat->cycles_hist, RTE_GRAPH_HIST_CYCLES_BUCKETS))
+			print_hist(f, stat, dispatch);
 	}
 	if (unlikely(is_last)) {
 		if (dispatch)
@@ -323,6 +387,16 @@ stats_mem_populate(struct rte_graph_cluster_stats *stats,
 		}
 	}
 
+	cluster->stat.cycles_hist = rte_zmalloc_socket(NULL, GRAPH_NODE_HIST_SZ,
+		RTE_CACHE_LINE_SIZE, stats->socket_id);
+	if (cluster->stat.cycles_hist == NULL) {
+		rte_free(cluster->stat.xstat_count);
+		rte_free(cluster->stat.xstat_desc);
+		SET_ERR_JMP(ENOMEM, err, "Failed to allocate memory node %s graph %s",
+			    graph_node->node->name, graph->name);
+	}
+	cluster->stat.objs_hist = cluster->stat.cycles_hist + RTE_GRAPH_HIST_CYCLES_BUCKETS;
+
 	stats->max_nodes++;
 
 	return 0;
@@ -467,6 +541,7 @@ rte_graph_cluster_stats_destroy(struct rte_graph_cluster_stats *stat)
 			rte_free(cluster->stat.xstat_count);
 			rte_free(cluster->stat.xstat_desc);
 		}
+		rte_free(cluster->stat.cycles_hist);
 
 		cluster = RTE_PTR_ADD(cluster, stat->cluster_node_size);
 	}
@@ -482,13 +557,24 @@ cluster_node_arregate_stats(struct cluster_node *cluster, bool dispatch)
 	struct rte_node *node;
 	rte_node_t count;
 	uint64_t *xstat;
+	uint64_t *hist;
 	uint8_t i;
 
 	if (stat->xstat_cntrs != 0)
 		memset(stat->xstat_count, 0, sizeof(uint64_t) * stat->xstat_cntrs);
+	memset(stat->cycles_hist, 0, GRAPH_NODE_HIST_SZ);
 	for (count = 0; count < cluster->nb_nodes; count++) {
 		node = cluster->nodes[count];
 
+		if (node->hist_off != 0) {
+			hist = RTE_PTR_ADD(node, node->hist_off);
+			for (i = 0; i < RTE_GRAPH_HIST_CYCLES_BUCKETS; i++)
+				stat->cycles_hist[i] += hist[i];
+			hist += RTE_GRAPH_HIST_CYCLES_BUCKETS;
+			for (i = 0; i < RTE_GRAPH_HIST_OBJS_BUCKETS; i++)
+				stat->objs_hist[i] += hist[i];
+		}
+
 		if (dispatch) {
 			sched_objs += node->dispatch.total_sched_objs;
 			sched_fail += node->dispatch.total_sched_fail;
@@ -576,6 +662,91 @@ rte_graph_cluster_stats_reset(struct rte_graph_cluster_stats *stat)
 		node->realloc_count = 0;
 		for (i = 0; i < node->xstat_cntrs; i++)
 			node->xstat_count[i] = 0;
+		memset(node->cycles_hist, 0, GRAPH_NODE_HIST_SZ);
 		cluster = RTE_PTR_ADD(cluster, stat->cluster_node_size);
 	}
 }
+
+static int
+graph_handle_list(const char *cmd __rte_unused, const char *params __rte_unused,
+		  struct rte_tel_data *d)
+{
+	struct graph_head *graph_head = graph_list_head_get();
+	struct graph *graph;
+
+	rte_tel_data_start_array(d, RTE_TEL_STRING_VAL);
+	graph_spinlock_lock();
+	STAILQ_FOREACH(graph, graph_head, next)
+		rte_tel_data_add_array_string(d, graph->name);
+	graph_spinlock_unlock();
+
+	return 0;
+}
+
+static int
+graph_handle_node_hist(const char *cmd __rte_unused, const char *params,
+		       struct rte_tel_data *d)
+{
+	char name[RTE_GRAPH_NAMESIZE + RTE_NODE_NAMESIZE];
+	struct rte_tel_data *cycles, *objs;
+	struct rte_node *node;
+	const uint64_t *hist;
+	char *node_name;
+	unsigned int i;
+	int rc = 0;
+
+	if (params == NULL || rte_strscpy(name, params, sizeof(name)) <= 0)
+		return -EINVAL;
+
+	node_name = strchr(name, ',');
+	if (node_name == NULL)
+		return -EINVAL;
+	*node_name++ = '\0';
+
+	cycles = rte_tel_data_alloc();
+	objs = rte_tel_data_alloc();
+	if (cycles == NULL || objs == NULL) {
+		rte_tel_data_free(cycles);
+		rte_tel_data_free(objs);
+		return -ENOMEM;
+	}
+
+	graph_spinlock_lock();
+	node = rte_graph_node_get_by_name(name, node_name);
+	if (node == NULL || node->hist_off == 0) {
+		rc = node == NULL ? -EINVAL : -ENOTSUP;
+		goto unlock;
+	}
+
+	hist = RTE_PTR_ADD(node, node->hist_off);
+	rte_tel_data_start_array(cycles, RTE_TEL_UINT_VAL);
+	for (i = 0; i < RTE_GRAPH_HIST_CYCLES_BUCKETS; i++)
+		rte_tel_data_add_array_uint(cycles, hist[i]);
+	hist += RTE_GRAPH_HIST_CYCLES_BUCKETS;
+	rte_tel_data_start_array(objs, RTE_TEL_UINT_VAL);
+	for (i = 0; i < RTE_GRAPH_HIST_OBJS_BUCKETS; i++)
+		rte_tel_data_add_array_uint(objs, hist[i]);
+
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_uint(d, "calls", node->total_calls);
+	rte_tel_data_add_dict_uint(d, "objs", node->total_objs);
+	rte_tel_data_add_dict_uint(d, "cycles", node->total_cycles);
+	rte_tel_data_add_dict_container(d, "cycles_hist", cycles, 0);
+	rte_tel_data_add_dict_container(d, "objs_hist", objs, 0);
+	cycles = NULL;
+	objs = NULL;
+
+unlock:
+	graph_spinlock_unlock();
+	rte_tel_data_free(cycles);
+	rte_tel_data_free(objs);
+	return rc;
+}
+
+RTE_INIT(graph_init_telemetry)
+{
+	rte_telemetry_register_cmd("/graph/list", graph_handle_list,
+		"Returns list of available graphs. Takes no parameters");
+	rte_telemetry_register_cmd("/graph/node_hist", graph_handle_node_hist,
+		"Returns the cycles and objs histograms of a node. Parameters: graph_name,node_name");
+}
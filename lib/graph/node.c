@@ -546,3 +546,26 @@ rte_node_free(rte_node_t id)
 fail:
 	return rc;
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_batch_set, 26.03)
+int
+rte_node_batch_set(rte_node_t id, uint16_t min_objs, uint32_t max_wait_us)
+{
+	struct node *node;
+	int rc = -EINVAL;
+
+	if (min_objs > RTE_GRAPH_BURST_SIZE)
+		return rc;
+
+	graph_spinlock_lock();
+	STAILQ_FOREACH(node, &node_list, next) {
+		if (id == node->id) {
+			node->batch_min_objs = min_objs;
+			node->batch_max_wait_us = max_wait_us;
+			rc = 0;
+			break;
+		}
+	}
+	graph_spinlock_unlock();
+	return rc;
+}
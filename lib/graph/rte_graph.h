@@ -66,6 +66,19 @@ typedef uint16_t rte_graph_t;      /**< Graph id type. */
 #error "Unsupported burst size"
 #endif
 
+/**
+ * Number of buckets of the node cycles histogram.
+ * Bucket 0 counts the calls of 0 cycle, bucket i the calls of
+ * [2^(i-1), 2^i) cycles; the last bucket also counts the longer calls.
+ */
+#define RTE_GRAPH_HIST_CYCLES_BUCKETS 32U
+/**
+ * Number of buckets of the node objs histogram.
+ * Bucket 0 counts the calls processing no object, bucket i the calls
+ * processing [2^(i-1), 2^i) objects.
+ */
+#define RTE_GRAPH_HIST_OBJS_BUCKETS 17U
+
 /* Forward declaration */
 struct rte_node;  /**< Node object */
 struct rte_graph; /**< Graph object */
@@ -185,7 +198,18 @@ struct rte_graph_param {
 			packets_enqueued_cb notify_cb;
 			uint64_t cb_priv;
 		} dispatch;
+		struct {
+			uint32_t wq_size_max; /**< Maximum size of workqueue for steal model. */
+			uint32_t mp_capacity; /**< Capacity of memory pool for steal model. */
+			uint16_t min_objs;
+			/**< Minimum stream size offered to idle graphs, 0 for default. */
+		} steal;
 	};
+
+	bool pcap_async;
+	/**< Queue captured packets to a ring drained by rte_graph_pcap_drain(). */
+	uint32_t pcap_snaplen;
+	/**< Maximum length of captured packets, whole packets if 0. */
 };
 
 /**
@@ -243,6 +267,11 @@ struct __rte_cache_aligned rte_graph_cluster_node_stats {
 	rte_node_t id;	/**< Node identifier of stats. */
 	uint64_t hz;	/**< Cycles per seconds. */
 	char name[RTE_NODE_NAMESIZE];	/**< Name of the node. */
+
+	/** Calls per cycles bucket, see RTE_GRAPH_HIST_CYCLES_BUCKETS. */
+	uint64_t *cycles_hist;
+	/** Calls per objs bucket, see RTE_GRAPH_HIST_OBJS_BUCKETS. */
+	uint64_t *objs_hist;
 };
 
 /**
@@ -295,6 +324,34 @@ int rte_graph_destroy(rte_graph_t id);
  */
 rte_graph_t rte_graph_clone(rte_graph_t id, const char *name, struct rte_graph_param *prm);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Clone Graph on a socket.
+ *
+ * Same as rte_graph_clone(), except that the fast path memory of the new
+ * graph, including the node contexts and streams, is allocated on the given
+ * socket instead of the socket of the parent graph. Node init() callbacks
+ * see it in rte_graph::socket. It should be the socket of the lcore walking
+ * the new graph, from rte_lcore_to_socket_id().
+ *
+ * @param id
+ *   Static graph id to clone from.
+ * @param name
+ *   Name of the new graph, see rte_graph_clone().
+ * @param prm
+ *   Graph parameter, includes model-specific parameters in this graph.
+ * @param socket_id
+ *   Socket of the new graph memory, SOCKET_ID_ANY for the parent graph one.
+ *
+ * @return
+ *   Valid graph id on success, RTE_GRAPH_ID_INVALID otherwise.
+ */
+__rte_experimental
+rte_graph_t rte_graph_clone_socket(rte_graph_t id, const char *name,
+				   struct rte_graph_param *prm, int socket_id);
+
 /**
  * Get graph id from graph name.
  *
@@ -330,6 +387,23 @@ char *rte_graph_id_to_name(rte_graph_t id);
  */
 int rte_graph_export(const char *name, FILE *f);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Write a burst of the packets captured in pcap async mode to the pcap file.
+ *
+ * In pcap async mode, see rte_graph_param::pcap_async, the workers queue
+ * copies of the captured packets to a ring instead of writing them.
+ * This function must be called in loop by a single lcore, not walking any
+ * graph, until the graphs are destroyed.
+ *
+ * @return
+ *   Number of packets written on success, negative errno otherwise.
+ */
+__rte_experimental
+int rte_graph_pcap_drain(void);
+
 /**
  * Bind graph with specific lcore for mcore dispatch model.
  *
@@ -478,6 +552,29 @@ void rte_graph_cluster_stats_get(struct rte_graph_cluster_stats *stat,
  */
 void rte_graph_cluster_stats_reset(struct rte_graph_cluster_stats *stat);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Enable or disable the node histograms of a graph.
+ *
+ * When enabled, each node call of the graph also updates the histograms
+ * of its cycles and of its processed objects, which are aggregated in
+ * struct rte_graph_cluster_node_stats. It can be changed while the graph
+ * is walked, for instance to profile the hot nodes during an incident.
+ *
+ * @param id
+ *   Graph id to update.
+ * @param enable
+ *   true to update the histograms, false to stop.
+ *
+ * @return
+ *   0 on success, -EINVAL if the graph is invalid,
+ *   -ENOTSUP if the stats feature is not enabled.
+ */
+__rte_experimental
+int rte_graph_hist_enable(rte_graph_t id, bool enable);
+
 /**
  * Structure defines the number of xstats a given node has and each xstat
  * description.
@@ -688,6 +785,33 @@ rte_node_is_invalid(rte_node_t id)
 __rte_experimental
 int rte_node_free(rte_node_t id);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Set the adaptive batching of a node.
+ *
+ * The walk of a graph defers a pending stream of the node with fewer than
+ * min_objs objects to the next walks, so that it grows before the node is
+ * called, until the stream has been deferred for max_wait_us.
+ * It trades latency for fewer node calls with larger bursts at low loads.
+ * The source nodes are never deferred.
+ * The setting applies to the graphs created afterwards.
+ *
+ * @param id
+ *   Node id to update.
+ * @param min_objs
+ *   Minimum number of objects to process the node, 0 or 1 to disable.
+ * @param max_wait_us
+ *   Maximum deferral of a stream in microseconds.
+ *
+ * @return
+ *   - 0: Success.
+ *   - -EINVAL: Invalid node id or min_objs above RTE_GRAPH_BURST_SIZE.
+ */
+__rte_experimental
+int rte_node_batch_set(rte_node_t id, uint16_t min_objs, uint32_t max_wait_us);
+
 /**
  * Test the validity of edge id.
  *
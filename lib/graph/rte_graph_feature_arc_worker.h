@@ -163,6 +163,14 @@ struct __rte_cache_aligned rte_graph_feature_arc {
 	 */
 	int mbuf_dyn_offset;
 
+	/**
+	 * Uniform first feature, valid when exactly one index has features
+	 * enabled. Packs [first fdata:32 | first edge:16 | index:16] so that
+	 * fast path reads it with a single load. UINT64_MAX when invalid.
+	 * See rte_graph_feature_arc_uniform_get()
+	 */
+	RTE_ATOMIC(uint64_t) fp_uniform_first_feature;
+
 	/** Fast path arc data starts */
 	/*
 	 * Arc specific fast path data
@@ -585,6 +593,52 @@ rte_graph_feature_arc_is_any_feature_enabled(struct rte_graph_feature_arc *arc)
 					 rte_memory_order_relaxed));
 }
 
+/**
+ * Fast path API to get the uniform first feature of a feature arc
+ *
+ * Feature arc recomputes it on every rte_graph_feature_enable() and
+ * rte_graph_feature_disable(). It is valid when features are enabled on
+ * exactly one index, which is the common case of a feature chain configured on
+ * a single interface. A start_node may then steer packets of that index by
+ * comparing against the returned index, without looking up first feature data
+ * per packet as rte_graph_feature_data_first_feature_get() does. Packets of
+ * any other index do not enter feature arc.
+ *
+ * @param arc
+ *   Feature arc object
+ * @param[out] index
+ *   Only index with features enabled
+ * @param[out] fdata
+ *  Feature data to be saved in mbuf, same as returned by
+ *  rte_graph_feature_data_first_feature_get() for *index*
+ * @param[out] edge
+ *  Edge from start_node to first enabled feature node
+ *
+ * @return
+ *  1: if uniform first feature is valid
+ *  0: if no feature or features on more than one index are enabled
+ */
+__rte_experimental
+static __rte_always_inline int
+rte_graph_feature_arc_uniform_get(struct rte_graph_feature_arc *arc,
+				  uint16_t *index,
+				  rte_graph_feature_data_t *fdata,
+				  rte_edge_t *edge)
+{
+	uint64_t uf;
+
+	uf = rte_atomic_load_explicit(&arc->fp_uniform_first_feature,
+				      rte_memory_order_relaxed);
+	if (uf == UINT64_MAX)
+		return 0;
+
+	*index = (uint16_t)uf;
+	*edge = (rte_edge_t)(uf >> 16);
+	*fdata = (rte_graph_feature_data_t)(uf >> 32);
+
+	return 1;
+}
+
 /**
  * Prefetch feature arc fast path cache line
  *
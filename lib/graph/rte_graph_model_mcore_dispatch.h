@@ -91,6 +91,7 @@ rte_graph_walk_mcore_dispatch(struct rte_graph *graph)
 	const rte_graph_off_t *cir_start = graph->cir_start;
 	const rte_node_t mask = graph->cir_mask;
 	uint32_t head = graph->head;
+	rte_graph_off_t deferred = 0;
 	struct rte_node *node;
 
 	if (graph->dispatch.wq != NULL)
@@ -103,6 +104,12 @@ rte_graph_walk_mcore_dispatch(struct rte_graph *graph)
 		if ((int32_t)head < 1 && node->dispatch.lcore_id != graph->dispatch.lcore_id)
 			continue;
 
+		if (unlikely(graph->batch) && (int32_t)head > 0 &&
+		    __rte_node_batch_defer(node, &deferred)) {
+			head = head & mask;
+			continue;
+		}
+
 		/* Schedule the node until all task/objs are done */
 		if (node->dispatch.lcore_id != RTE_MAX_LCORE &&
 		    graph->dispatch.lcore_id != node->dispatch.lcore_id &&
@@ -116,6 +123,8 @@ rte_graph_walk_mcore_dispatch(struct rte_graph *graph)
 	}
 
 	graph->tail = 0;
+	if (unlikely(deferred != 0))
+		__rte_node_batch_resume(graph, deferred);
 }
 
 #ifdef __cplusplus
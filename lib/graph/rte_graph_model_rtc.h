@@ -20,6 +20,7 @@ rte_graph_walk_rtc(struct rte_graph *graph)
 	const rte_graph_off_t *cir_start = graph->cir_start;
 	const rte_node_t mask = graph->cir_mask;
 	uint32_t head = graph->head;
+	rte_graph_off_t deferred = 0;
 	struct rte_node *node;
 
 	/*
@@ -36,11 +37,21 @@ rte_graph_walk_rtc(struct rte_graph *graph)
 	 *	| ... | <= pending streams
 	 *	|     |
 	 *	+-----+ <= cir_start + mask
+	 *
+	 * The pending streams smaller than the node batch are deferred and
+	 * put back as the first pending streams of the next walk.
 	 */
 	while (likely(head != graph->tail)) {
 		node = (struct rte_node *)RTE_PTR_ADD(graph, cir_start[(int32_t)head++]);
+		if (unlikely(graph->batch) && (int32_t)head > 0 &&
+		    __rte_node_batch_defer(node, &deferred)) {
+			head = head & mask;
+			continue;
+		}
 		__rte_node_process(graph, node);
 		head = likely((int32_t)head > 0) ? head & mask : head;
 	}
 	graph->tail = 0;
+	if (unlikely(deferred != 0))
+		__rte_node_batch_resume(graph, deferred);
 }
@@ -0,0 +1,172 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2026 Intel Corporation
+ */
+
+#include "graph_private.h"
+#include <eal_export.h>
+#include "rte_graph_model_work_steal.h"
+
+int
+graph_steal_wq_create(struct graph *_graph, struct graph *_parent_graph,
+		      struct rte_graph_param *prm)
+{
+	struct rte_graph *parent_graph = _parent_graph->graph;
+	struct rte_graph *graph = _graph->graph;
+	unsigned int wq_size;
+	unsigned int flags = RING_F_SP_ENQ;
+
+	wq_size = RTE_GRAPH_STEAL_WQ_SIZE(graph->nb_nodes);
+	wq_size = rte_align32pow2(wq_size + 1);
+
+	if (prm->steal.wq_size_max > 0)
+		wq_size = wq_size <= (prm->steal.wq_size_max) ? wq_size :
+			prm->steal.wq_size_max;
+
+	if (!rte_is_power_of_2(wq_size))
+		flags |= RING_F_EXACT_SZ;
+
+	graph->steal.wq = rte_ring_create(graph->name, wq_size, graph->socket,
+					  flags);
+	if (graph->steal.wq == NULL)
+		SET_ERR_JMP(EIO, fail, "Failed to allocate graph steal WQ");
+
+	if (prm->steal.mp_capacity > 0)
+		wq_size = (wq_size <= prm->steal.mp_capacity) ? wq_size :
+			prm->steal.mp_capacity;
+
+	/* Entries are put back by the stealing graphs */
+	graph->steal.mp = rte_mempool_create(graph->name, wq_size,
+					     sizeof(struct graph_mcore_dispatch_wq_node),
+					     0, 0, NULL, NULL, NULL, NULL,
+					     graph->socket, 0);
+	if (graph->steal.mp == NULL)
+		SET_ERR_JMP(EIO, fail_mp,
+			    "Failed to allocate graph steal WQ entry");
+
+	graph->steal.min_objs = prm->steal.min_objs > 0 ? prm->steal.min_objs :
+		RTE_GRAPH_STEAL_MIN_OBJS_DEFAULT;
+	graph->steal.idle = false;
+
+	if (parent_graph->steal.rq == NULL) {
+		parent_graph->steal.rq = &parent_graph->steal.rq_head;
+		SLIST_INIT(parent_graph->steal.rq);
+		parent_graph->steal.nb_idle = &parent_graph->steal.nb_idle_cnt;
+		rte_atomic_store_explicit(parent_graph->steal.nb_idle, 0,
+					  rte_memory_order_relaxed);
+	}
+
+	graph->steal.rq = parent_graph->steal.rq;
+	graph->steal.nb_idle = parent_graph->steal.nb_idle;
+	SLIST_INSERT_HEAD(graph->steal.rq, graph, next);
+
+	return 0;
+
+fail_mp:
+	rte_ring_free(graph->steal.wq);
+	graph->steal.wq = NULL;
+fail:
+	return -rte_errno;
+}
+
+void
+graph_steal_wq_destroy(struct graph *_graph)
+{
+	struct rte_graph *graph = _graph->graph;
+
+	if (graph == NULL || graph->steal.wq == NULL)
+		return;
+
+	__rte_graph_work_steal_idle_update(graph, true);
+	SLIST_REMOVE(graph->steal.rq, graph, rte_graph, next);
+
+	rte_ring_free(graph->steal.wq);
+	graph->steal.wq = NULL;
+
+	rte_mempool_free(graph->steal.mp);
+	graph->steal.mp = NULL;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(__rte_graph_work_steal_node_enqueue, 26.03)
+bool __rte_noinline
+__rte_graph_work_steal_node_enqueue(struct rte_graph *graph, struct rte_node *node)
+{
+	struct graph_mcore_dispatch_wq_node *wq_node;
+	uint16_t size;
+
+	if (rte_mempool_get(graph->steal.mp, (void **)&wq_node) < 0)
+		return false;
+
+	size = RTE_MIN(node->idx, RTE_DIM(wq_node->objs));
+	wq_node->node_off = node->off;
+	wq_node->nb_objs = size;
+	rte_memcpy(wq_node->objs, node->objs, size * sizeof(void *));
+
+	if (rte_ring_sp_enqueue_elem(graph->steal.wq, (void *)&wq_node,
+				     sizeof(wq_node)) != 0) {
+		rte_mempool_put(graph->steal.mp, wq_node);
+		return false;
+	}
+
+	node->steal.total_offered_objs += size;
+	node->idx -= size;
+	if (node->idx == 0)
+		return true;
+
+	/* Keep the rest of a large stream for the owner */
+	memmove(&node->objs[0], &node->objs[size], node->idx * sizeof(void *));
+	return false;
+}
+
+static __rte_always_inline void
+__graph_steal_stream_process(struct rte_graph *graph,
+			     struct graph_mcore_dispatch_wq_node *wq_node)
+{
+	struct rte_node *node;
+	uint16_t idx, free_space;
+
+	node = RTE_PTR_ADD(graph, wq_node->node_off);
+	RTE_ASSERT(node->fence == RTE_GRAPH_FENCE);
+	idx = node->idx;
+	free_space = node->size - idx;
+
+	if (unlikely(free_space < wq_node->nb_objs))
+		__rte_node_stream_alloc_size(graph, node, node->size + wq_node->nb_objs);
+
+	memmove(&node->objs[idx], wq_node->objs, wq_node->nb_objs * sizeof(void *));
+	node->idx = idx + wq_node->nb_objs;
+	node->steal.total_stolen_objs += wq_node->nb_objs;
+
+	__rte_node_process(graph, node);
+
+	node->idx = 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(__rte_graph_work_steal_process, 26.03)
+void
+__rte_graph_work_steal_process(struct rte_graph *graph)
+{
+#define STEAL_SZ 4
+	struct graph_mcore_dispatch_wq_node *wq_nodes[STEAL_SZ];
+	struct rte_graph *peer;
+	unsigned int i, n;
+
+	SLIST_FOREACH(peer, graph->steal.rq, next) {
+		if (peer == graph || peer->steal.wq == NULL)
+			continue;
+
+		n = rte_ring_mc_dequeue_burst_elem(peer->steal.wq, wq_nodes,
+						   sizeof(wq_nodes[0]),
+						   RTE_DIM(wq_nodes), NULL);
+		if (n == 0)
+			continue;
+
+		/* No longer idle, so that stolen streams are not offered back */
+		__rte_graph_work_steal_idle_update(graph, true);
+
+		for (i = 0; i < n; i++)
+			__graph_steal_stream_process(graph, wq_nodes[i]);
+
+		rte_mempool_put_bulk(peer->steal.mp, (void **)wq_nodes, n);
+		return;
+	}
+}
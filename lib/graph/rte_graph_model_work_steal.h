@@ -0,0 +1,188 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_GRAPH_MODEL_WORK_STEAL_H_
+#define _RTE_GRAPH_MODEL_WORK_STEAL_H_
+
+/**
+ * @file rte_graph_model_work_steal.h
+ *
+ * These APIs implement the work-stealing model: each worker walks its own
+ * cloned graph in run-to-completion fashion, and offers pending streams to
+ * the graphs cloned from the same parent when some of them are idle.
+ * An idle graph steals the offered streams and processes them on its own
+ * clone of the nodes, so the objects of a stream may be reordered with
+ * the objects of the streams processed by the owner.
+ */
+
+#include <rte_errno.h>
+#include <rte_mempool.h>
+#include <rte_ring.h>
+
+#include "rte_graph_worker_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RTE_GRAPH_STEAL_WQ_SIZE_MULTIPLIER  8
+#define RTE_GRAPH_STEAL_WQ_SIZE(nb_nodes)   \
+	((typeof(nb_nodes))((nb_nodes) * RTE_GRAPH_STEAL_WQ_SIZE_MULTIPLIER))
+/** Default minimum number of objects in a stream to offer it to a peer. */
+#define RTE_GRAPH_STEAL_MIN_OBJS_DEFAULT (RTE_GRAPH_BURST_SIZE / 2)
+
+/**
+ * @internal
+ *
+ * Offer the pending stream of the node to the idle graphs for work-stealing
+ * model.
+ *
+ * @param graph
+ *   Pointer to the graph object owning the node.
+ * @param node
+ *   Pointer to the node object with a pending stream.
+ *
+ * @return
+ *   True if the whole stream was offered, false if some objects are left
+ *   in the stream.
+ *
+ * @note
+ * This implementation is used by work-stealing model only and user application
+ * should not call it directly.
+ */
+bool __rte_noinline __rte_graph_work_steal_node_enqueue(struct rte_graph *graph,
+							struct rte_node *node);
+
+/**
+ * @internal
+ *
+ * Steal and process the streams offered by the other graphs for work-stealing
+ * model.
+ *
+ * @param graph
+ *   Pointer to the idle graph object.
+ *
+ * @note
+ * This implementation is used by work-stealing model only and user application
+ * should not call it directly.
+ */
+void __rte_graph_work_steal_process(struct rte_graph *graph);
+
+/**
+ * @internal
+ *
+ * Update the idle state of the graph after a walk for work-stealing model.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param busy
+ *   True if the walk processed any pending stream.
+ *
+ * @note
+ * This implementation is used by work-stealing model only and user application
+ * should not call it directly.
+ */
+static __rte_always_inline void
+__rte_graph_work_steal_idle_update(struct rte_graph *graph, bool busy)
+{
+	if (busy == !graph->steal.idle)
+		return;
+
+	graph->steal.idle = !busy;
+	if (busy)
+		rte_atomic_fetch_sub_explicit(graph->steal.nb_idle, 1,
+					      rte_memory_order_relaxed);
+	else
+		rte_atomic_fetch_add_explicit(graph->steal.nb_idle, 1,
+					      rte_memory_order_relaxed);
+}
+
+/**
+ * @internal
+ *
+ * Check whether a pending stream should be offered to the idle graphs.
+ * Only as many streams as idle graphs are kept offered, so that the busy
+ * graph still processes most of its streams.
+ *
+ * @param graph
+ *   Pointer to the graph object owning the node.
+ * @param node
+ *   Pointer to the node object with a pending stream.
+ *
+ * @note
+ * This implementation is used by work-stealing model only and user application
+ * should not call it directly.
+ */
+static __rte_always_inline bool
+__rte_graph_work_steal_offer(struct rte_graph *graph, struct rte_node *node)
+{
+	uint32_t nb_idle;
+
+	if (node->idx < graph->steal.min_objs || graph->steal.wq == NULL)
+		return false;
+
+	nb_idle = rte_atomic_load_explicit(graph->steal.nb_idle,
+					   rte_memory_order_relaxed);
+	return nb_idle != 0 && rte_ring_count(graph->steal.wq) < nb_idle;
+}
+
+/**
+ * Perform graph walk on the circular buffer and invoke the process function
+ * of the nodes and collect the stats. The pending streams may be offered to
+ * the idle graphs and, when the graph itself is idle, the streams offered by
+ * the other graphs are stolen.
+ *
+ * @param graph
+ *   Graph pointer returned from rte_graph_lookup function.
+ *
+ * @see rte_graph_lookup()
+ */
+static inline void
+rte_graph_walk_work_steal(struct rte_graph *graph)
+{
+	const rte_graph_off_t *cir_start = graph->cir_start;
+	const rte_node_t mask = graph->cir_mask;
+	uint32_t head = graph->head;
+	rte_graph_off_t deferred = 0;
+	struct rte_node *node;
+	bool busy = false;
+
+	if (graph->steal.idle)
+		__rte_graph_work_steal_process(graph);
+
+	while (likely(head != graph->tail)) {
+		node = (struct rte_node *)RTE_PTR_ADD(graph, cir_start[(int32_t)head++]);
+
+		/* Only the pending streams, not the source nodes, are offered */
+		if ((int32_t)head > 0) {
+			if (unlikely(graph->batch) && __rte_node_batch_defer(node, &deferred)) {
+				head = head & mask;
+				continue;
+			}
+			busy = true;
+			if (unlikely(__rte_graph_work_steal_offer(graph, node)) &&
+			    __rte_graph_work_steal_node_enqueue(graph, node)) {
+				head = head & mask;
+				continue;
+			}
+		}
+
+		__rte_node_process(graph, node);
+
+		head = likely((int32_t)head > 0) ? head & mask : head;
+	}
+
+	graph->tail = 0;
+	if (unlikely(deferred != 0))
+		__rte_node_batch_resume(graph, deferred);
+
+	if (graph->steal.wq != NULL)
+		__rte_graph_work_steal_idle_update(graph, busy);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_GRAPH_MODEL_WORK_STEAL_H_ */
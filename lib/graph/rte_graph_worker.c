@@ -10,7 +10,7 @@ RTE_EXPORT_SYMBOL(rte_graph_model_is_valid)
 bool
 rte_graph_model_is_valid(uint8_t model)
 {
-	if (model > RTE_GRAPH_MODEL_MCORE_DISPATCH)
+	if (model > RTE_GRAPH_MODEL_WORK_STEAL)
 		return false;
 
 	return true;
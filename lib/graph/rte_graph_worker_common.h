@@ -16,11 +16,13 @@
 #include <stdalign.h>
 #include <stddef.h>
 
+#include <rte_bitops.h>
 #include <rte_common.h>
 #include <rte_cycles.h>
 #include <rte_prefetch.h>
 #include <rte_memcpy.h>
 #include <rte_memory.h>
+#include <rte_stdatomic.h>
 
 #include "rte_graph.h"
 
@@ -33,6 +35,8 @@ extern "C" {
 #define RTE_GRAPH_MODEL_RTC 0 /**< Run-To-Completion model. It is the default model. */
 #define RTE_GRAPH_MODEL_MCORE_DISPATCH 1
 /**< Dispatch model to support cross-core dispatching within core affinity. */
+#define RTE_GRAPH_MODEL_WORK_STEAL 2
+/**< Run-To-Completion model where idle graphs steal pending streams of busy ones. */
 #define RTE_GRAPH_MODEL_DEFAULT RTE_GRAPH_MODEL_RTC /**< Default graph model. */
 
 /**
@@ -56,8 +60,9 @@ struct __rte_cache_aligned rte_graph {
 	rte_graph_off_t *cir_start;  /**< Pointer to circular buffer. */
 	rte_graph_off_t nodes_start; /**< Offset at which node memory starts. */
 	uint8_t model;		     /**< graph model */
-	uint8_t reserved1;	     /**< Reserved for future use. */
-	uint16_t reserved2;	     /**< Reserved for future use. */
+	uint8_t batch;		     /**< Some nodes defer their small streams. */
+	uint8_t hist;		     /**< Node histograms are updated. */
+	uint8_t reserved2;	     /**< Reserved for future use. */
 	union {
 		/* Fast schedule area for mcore dispatch model */
 		struct {
@@ -71,6 +76,19 @@ struct __rte_cache_aligned rte_graph {
 			packets_enqueued_cb notify_cb; /**< Callback when packet crosses lcores. */
 			uint64_t cb_priv;       /**< Opaque parameter for notify_cb. */
 		} dispatch; /** Only used by dispatch model */
+		/* Fast steal area for work-stealing model */
+		struct {
+			alignas(RTE_CACHE_LINE_SIZE) struct rte_graph_rq_head *rq;
+				/* The graphs stealing from each other */
+			struct rte_graph_rq_head rq_head; /* The head for steal list */
+
+			RTE_ATOMIC(uint32_t) *nb_idle; /**< Number of idle graphs. */
+			RTE_ATOMIC(uint32_t) nb_idle_cnt; /* Idle graphs counter storage */
+			uint16_t min_objs;      /**< Minimum stream size to offer. */
+			bool idle;              /**< Graph is counted in nb_idle. */
+			struct rte_ring *wq;    /**< The work-queue of offered streams. */
+			struct rte_mempool *mp; /**< The mempool for offered streams. */
+		} steal; /** Only used by work-stealing model */
 	};
 	SLIST_ENTRY(rte_graph) next;   /* The next for rte_graph list */
 	/* End of Fast path area.*/
@@ -78,6 +96,8 @@ struct __rte_cache_aligned rte_graph {
 	int socket;	/**< Socket ID where memory is allocated. */
 	char name[RTE_GRAPH_NAMESIZE];	/**< Name of the graph. */
 	bool pcap_enable;	        /**< Pcap trace enabled. */
+	/** Maximum length of captured packets, whole packets if 0. */
+	uint32_t pcap_snaplen;
 	/** Number of packets captured per core. */
 	uint64_t nb_pkt_captured;
 	/** Number of packets to capture per core. */
@@ -114,11 +134,25 @@ struct __rte_cache_aligned rte_node {
 			uint64_t total_sched_fail; /**< Number of scheduled failure. */
 			struct rte_graph *graph;  /**< Graph corresponding to lcore_id. */
 		} dispatch;
+		/** Fast steal area for work-stealing model. */
+		alignas(RTE_CACHE_LINE_MIN_SIZE) struct {
+			uint64_t total_offered_objs; /**< Number of objects offered. */
+			uint64_t total_stolen_objs;  /**< Number of objects stolen. */
+		} steal;
 	};
 
 	/** Fast path area cache line 1. */
 	alignas(RTE_CACHE_LINE_MIN_SIZE)
 	rte_graph_off_t xstat_off; /**< Offset to xstat counters. */
+	rte_graph_off_t hist_off;  /**< Offset to cycles and objs histograms. */
+	struct {
+		uint16_t min_objs;     /**< Minimum stream size to process. */
+		uint16_t queued;       /**< Node is in the deferred list. */
+		rte_graph_off_t next;  /**< Offset of next deferred node. */
+		uint64_t wait_cycles;  /**< Maximum deferral of a stream. */
+		uint64_t start;        /**< First deferral of the stream, 0 if none. */
+		uint64_t total_deferred; /**< Number of deferrals. */
+	} batch; /**< Adaptive batching of the pending stream. */
 
 	/** Fast path area cache line 2. */
 	__extension__ struct __rte_cache_aligned {
@@ -184,6 +218,27 @@ void __rte_node_stream_alloc_size(struct rte_graph *graph,
 
 /* Fast path helper functions */
 
+/**
+ * @internal
+ *
+ * Account a node call in the node histograms.
+ *
+ * @param node
+ *   Pointer to the node object.
+ * @param cycles
+ *   Cycles spent in the call.
+ * @param objs
+ *   Number of objects processed by the call.
+ */
+static __rte_always_inline void
+__rte_node_hist_update(struct rte_node *node, uint64_t cycles, uint16_t objs)
+{
+	uint64_t *hist = RTE_PTR_ADD(node, node->hist_off);
+
+	hist[RTE_MIN(rte_fls_u64(cycles), RTE_GRAPH_HIST_CYCLES_BUCKETS - 1)]++;
+	hist[RTE_GRAPH_HIST_CYCLES_BUCKETS + rte_fls_u32(objs)]++;
+}
+
 /**
  * @internal
  *
@@ -197,7 +252,7 @@ void __rte_node_stream_alloc_size(struct rte_graph *graph,
 static __rte_always_inline void
 __rte_node_process(struct rte_graph *graph, struct rte_node *node)
 {
-	uint64_t start;
+	uint64_t start, cycles;
 	uint16_t rc;
 	void **objs;
 
@@ -208,9 +263,12 @@ __rte_node_process(struct rte_graph *graph, struct rte_node *node)
 	if (rte_graph_has_stats_feature()) {
 		start = rte_rdtsc();
 		rc = node->process(graph, node, objs, node->idx);
-		node->total_cycles += rte_rdtsc() - start;
+		cycles = rte_rdtsc() - start;
+		node->total_cycles += cycles;
 		node->total_calls++;
 		node->total_objs += rc;
+		if (unlikely(graph->hist))
+			__rte_node_hist_update(node, cycles, rc);
 	} else {
 		node->process(graph, node, objs, node->idx);
 	}
@@ -237,6 +295,76 @@ __rte_node_enqueue_tail_update(struct rte_graph *graph, struct rte_node *node)
 	graph->tail = tail & graph->cir_mask;
 }
 
+/**
+ * @internal
+ *
+ * Check whether the pending stream of a node is deferred to a later walk,
+ * which is the case when it has fewer objects than the minimum batch of the
+ * node and was not deferred for the maximum wait of the node yet.
+ * A deferred node is added to the deferred list.
+ *
+ * @param node
+ *   Pointer to the node object with a pending stream.
+ * @param deferred
+ *   Offset of the last deferred node, 0 if none.
+ *
+ * @return
+ *   True if the stream is deferred, false if it must be processed now.
+ */
+static __rte_always_inline bool
+__rte_node_batch_defer(struct rte_node *node, rte_graph_off_t *deferred)
+{
+	uint64_t now;
+
+	if (likely(node->idx >= node->batch.min_objs))
+		goto process;
+
+	now = rte_rdtsc();
+	if (node->batch.start == 0)
+		node->batch.start = now;
+	else if (now - node->batch.start >= node->batch.wait_cycles)
+		goto process;
+
+	node->batch.total_deferred++;
+	if (!node->batch.queued) {
+		node->batch.queued = 1;
+		node->batch.next = *deferred;
+		*deferred = node->off;
+	}
+	return true;
+
+process:
+	node->batch.start = 0;
+	return false;
+}
+
+/**
+ * @internal
+ *
+ * Put back the deferred nodes in the pending streams for the next walk.
+ *
+ * @param graph
+ *   Pointer to the graph object.
+ * @param off
+ *   Offset of the last deferred node, linked to the others by batch.next.
+ */
+static __rte_always_inline void
+__rte_node_batch_resume(struct rte_graph *graph, rte_graph_off_t off)
+{
+	struct rte_node *node;
+
+	while (off != 0) {
+		node = (struct rte_node *)RTE_PTR_ADD(graph, off);
+		off = node->batch.next;
+		node->batch.queued = 0;
+		/* The stream may have been processed out of the walk */
+		if (node->idx != 0)
+			__rte_node_enqueue_tail_update(graph, node);
+		else
+			node->batch.start = 0;
+	}
+}
+
 /**
  * @internal
  *
@@ -6,6 +6,7 @@
 
 #define INVALID_ARRAY_INDEX 0xffffffffUL
 
+#include <rte_hash_crc.h>
 #include <rte_tcp.h>
 
 /*
@@ -196,4 +197,14 @@ is_same_common_tcp_key(struct cmn_tcp_key *k1, struct cmn_tcp_key *k2)
 	return (!memcmp(k1, k2, sizeof(struct cmn_tcp_key)));
 }
 
+/*
+ * Hash the ports of a TCP flow, init_val being the hash of its addresses.
+ */
+static inline uint32_t
+hash_common_tcp_key(const struct cmn_tcp_key *k, uint32_t init_val)
+{
+	return rte_hash_crc_4byte((uint32_t)k->src_port << 16 | k->dst_port,
+			init_val);
+}
+
 #endif
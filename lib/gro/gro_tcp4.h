@@ -18,6 +18,13 @@ struct tcp4_flow_key {
 
 struct gro_tcp4_flow {
 	struct tcp4_flow_key key;
+	/* The hash of the flow addresses and ports */
+	uint32_t hash;
+	/*
+	 * The next flow in the same hash bucket, or in the free list
+	 * for an empty flow.
+	 */
+	uint32_t next_flow;
 	/*
 	 * The index of the first packet in the flow.
 	 * INVALID_ARRAY_INDEX indicates an empty flow.
@@ -41,6 +48,12 @@ struct gro_tcp4_tbl {
 	uint32_t max_item_num;
 	/* flow array size */
 	uint32_t max_flow_num;
+	/* first flow of each hash bucket */
+	uint32_t *buckets;
+	/* bucket array size - 1, the array size being a power of 2 */
+	uint32_t bucket_mask;
+	/* first empty flow */
+	uint32_t free_flow;
 };
 
 /**
@@ -61,6 +74,16 @@ void *gro_tcp4_tbl_create(uint16_t socket_id,
 		uint16_t max_flow_num,
 		uint16_t max_item_per_flow);
 
+/**
+ * This function empties the flows of a TCP/IPv4 reassembly table and
+ * initializes its flow hash table. The flow and bucket arrays and their
+ * sizes must be set.
+ *
+ * @param tbl
+ *  Pointer pointing to the TCP/IPv4 reassembly table.
+ */
+void gro_tcp4_tbl_init_flows(struct gro_tcp4_tbl *tbl);
+
 /**
  * This function destroys a TCP/IPv4 reassembly table.
  *
@@ -144,4 +167,14 @@ is_same_tcp4_flow(struct tcp4_flow_key k1, struct tcp4_flow_key k2)
 			is_same_common_tcp_key(&k1.cmn_key, &k2.cmn_key));
 }
 
+/*
+ * Hash the addresses and ports of a TCP/IPv4 flow.
+ */
+static inline uint32_t
+hash_tcp4_flow(const struct tcp4_flow_key *k)
+{
+	return hash_common_tcp_key(&k->cmn_key, rte_hash_crc_8byte(
+			(uint64_t)k->ip_src_addr << 32 | k->ip_dst_addr, 0));
+}
+
 #endif
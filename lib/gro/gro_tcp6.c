@@ -16,7 +16,7 @@ gro_tcp6_tbl_create(uint16_t socket_id,
 {
 	struct gro_tcp6_tbl *tbl;
 	size_t size;
-	uint32_t entries_num, i;
+	uint32_t entries_num;
 
 	entries_num = max_flow_num * max_item_per_flow;
 	entries_num = RTE_MIN(entries_num, GRO_TCP6_TBL_MAX_ITEM_NUM);
@@ -52,14 +52,44 @@ gro_tcp6_tbl_create(uint16_t socket_id,
 		rte_free(tbl);
 		return NULL;
 	}
-	/* INVALID_ARRAY_INDEX indicates an empty flow */
-	for (i = 0; i < entries_num; i++)
-		tbl->flows[i].start_index = INVALID_ARRAY_INDEX;
 	tbl->max_flow_num = entries_num;
 
+	size = sizeof(uint32_t) * rte_align32pow2(entries_num);
+	tbl->buckets = rte_malloc_socket(__func__,
+			size,
+			RTE_CACHE_LINE_SIZE,
+			socket_id);
+	if (tbl->buckets == NULL) {
+		rte_free(tbl->flows);
+		rte_free(tbl->items);
+		rte_free(tbl);
+		return NULL;
+	}
+	tbl->bucket_mask = rte_align32pow2(entries_num) - 1;
+
+	gro_tcp6_tbl_init_flows(tbl);
+
 	return tbl;
 }
 
+void
+gro_tcp6_tbl_init_flows(struct gro_tcp6_tbl *tbl)
+{
+	uint32_t i;
+
+	/* INVALID_ARRAY_INDEX indicates an empty flow */
+	tbl->free_flow = INVALID_ARRAY_INDEX;
+	for (i = tbl->max_flow_num; i-- > 0; ) {
+		tbl->flows[i].start_index = INVALID_ARRAY_INDEX;
+		tbl->flows[i].next_flow = tbl->free_flow;
+		tbl->free_flow = i;
+	}
+	tbl->flow_num = 0;
+
+	for (i = 0; i <= tbl->bucket_mask; i++)
+		tbl->buckets[i] = INVALID_ARRAY_INDEX;
+}
+
 void
 gro_tcp6_tbl_destroy(void *tbl)
 {
@@ -68,33 +98,46 @@ gro_tcp6_tbl_destroy(void *tbl)
 	if (tcp_tbl) {
 		rte_free(tcp_tbl->items);
 		rte_free(tcp_tbl->flows);
+		rte_free(tcp_tbl->buckets);
 	}
 	rte_free(tcp_tbl);
 }
 
 static inline uint32_t
-find_an_empty_flow(struct gro_tcp6_tbl *tbl)
+find_flow(struct gro_tcp6_tbl *tbl,
+		struct tcp6_flow_key *key,
+		uint32_t hash)
 {
 	uint32_t i;
-	uint32_t max_flow_num = tbl->max_flow_num;
 
-	for (i = 0; i < max_flow_num; i++)
-		if (tbl->flows[i].start_index == INVALID_ARRAY_INDEX)
+	for (i = tbl->buckets[hash & tbl->bucket_mask];
+			i != INVALID_ARRAY_INDEX; i = tbl->flows[i].next_flow) {
+		/* Compare the keys of the flows with the same hash only */
+		if (tbl->flows[i].hash == hash &&
+				is_same_tcp6_flow(&tbl->flows[i].key, key))
 			return i;
+	}
 	return INVALID_ARRAY_INDEX;
 }
 
 static inline uint32_t
 insert_new_flow(struct gro_tcp6_tbl *tbl,
 		struct tcp6_flow_key *src,
+		uint32_t hash,
 		uint32_t item_idx)
 {
 	struct tcp6_flow_key *dst;
-	uint32_t flow_idx;
+	uint32_t flow_idx, *bucket;
 
-	flow_idx = find_an_empty_flow(tbl);
+	flow_idx = tbl->free_flow;
 	if (unlikely(flow_idx == INVALID_ARRAY_INDEX))
 		return INVALID_ARRAY_INDEX;
+	tbl->free_flow = tbl->flows[flow_idx].next_flow;
+
+	bucket = &tbl->buckets[hash & tbl->bucket_mask];
+	tbl->flows[flow_idx].hash = hash;
+	tbl->flows[flow_idx].next_flow = *bucket;
+	*bucket = flow_idx;
 
 	dst = &(tbl->flows[flow_idx].key);
 
@@ -109,6 +152,23 @@ insert_new_flow(struct gro_tcp6_tbl *tbl,
 	return flow_idx;
 }
 
+static inline void
+delete_flow(struct gro_tcp6_tbl *tbl, uint32_t flow_idx)
+{
+	uint32_t *prev;
+
+	/* Unlink the flow from its hash bucket */
+	prev = &tbl->buckets[tbl->flows[flow_idx].hash & tbl->bucket_mask];
+	while (*prev != flow_idx)
+		prev = &tbl->flows[*prev].next_flow;
+	*prev = tbl->flows[flow_idx].next_flow;
+
+	tbl->flows[flow_idx].start_index = INVALID_ARRAY_INDEX;
+	tbl->flows[flow_idx].next_flow = tbl->free_flow;
+	tbl->free_flow = flow_idx;
+	tbl->flow_num--;
+}
+
 /*
  * update the packet length for the flushed packet.
  */
@@ -134,10 +194,9 @@ gro_tcp6_reassemble(struct rte_mbuf *pkt,
 	int32_t tcp_dl;
 	uint16_t ip_tlen;
 	struct tcp6_flow_key key;
-	uint32_t i, max_flow_num, remaining_flow_num;
+	uint32_t i, hash;
 	uint32_t sent_seq;
 	struct rte_tcp_hdr *tcp_hdr;
-	uint8_t find;
 	uint32_t item_idx;
 	/*
 	 * Don't process the packet whose TCP header length is greater
@@ -176,27 +235,17 @@ gro_tcp6_reassemble(struct rte_mbuf *pkt,
 	key.vtc_flow = ipv6_hdr->vtc_flow;
 
 	/* Search for a matched flow. */
-	max_flow_num = tbl->max_flow_num;
-	remaining_flow_num = tbl->flow_num;
-	find = 0;
-	for (i = 0; i < max_flow_num && remaining_flow_num; i++) {
-		if (tbl->flows[i].start_index != INVALID_ARRAY_INDEX) {
-			if (is_same_tcp6_flow(&tbl->flows[i].key, &key)) {
-				find = 1;
-				break;
-			}
-			remaining_flow_num--;
-		}
-	}
+	hash = hash_tcp6_flow(&key);
+	i = find_flow(tbl, &key, hash);
 
-	if (find == 0) {
+	if (i == INVALID_ARRAY_INDEX) {
 		sent_seq = rte_be_to_cpu_32(tcp_hdr->sent_seq);
 		item_idx = insert_new_tcp_item(pkt, tbl->items, &tbl->item_num,
 						tbl->max_item_num, start_time,
 						INVALID_ARRAY_INDEX, sent_seq, 0, true);
 		if (item_idx == INVALID_ARRAY_INDEX)
 			return -1;
-		if (insert_new_flow(tbl, &key, item_idx) ==
+		if (insert_new_flow(tbl, &key, hash, item_idx) ==
 			INVALID_ARRAY_INDEX) {
 			/*
 			 * Fail to insert a new flow, so delete the
@@ -241,7 +290,7 @@ gro_tcp6_tbl_timeout_flush(struct gro_tcp6_tbl *tbl,
 						&tbl->item_num, INVALID_ARRAY_INDEX);
 				tbl->flows[i].start_index = j;
 				if (j == INVALID_ARRAY_INDEX)
-					tbl->flow_num--;
+					delete_flow(tbl, i);
 
 				if (unlikely(k == nb_out))
 					return k;
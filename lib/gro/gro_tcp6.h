@@ -21,6 +21,13 @@ struct tcp6_flow_key {
 
 struct gro_tcp6_flow {
 	struct tcp6_flow_key key;
+	/* The hash of the flow addresses and ports */
+	uint32_t hash;
+	/*
+	 * The next flow in the same hash bucket, or in the free list
+	 * for an empty flow.
+	 */
+	uint32_t next_flow;
 	/*
 	 * The index of the first packet in the flow.
 	 * INVALID_ARRAY_INDEX indicates an empty flow.
@@ -44,6 +51,12 @@ struct gro_tcp6_tbl {
 	uint32_t max_item_num;
 	/* flow array size */
 	uint32_t max_flow_num;
+	/* first flow of each hash bucket */
+	uint32_t *buckets;
+	/* bucket array size - 1, the array size being a power of 2 */
+	uint32_t bucket_mask;
+	/* first empty flow */
+	uint32_t free_flow;
 };
 
 /**
@@ -64,6 +77,16 @@ void *gro_tcp6_tbl_create(uint16_t socket_id,
 		uint16_t max_flow_num,
 		uint16_t max_item_per_flow);
 
+/**
+ * This function empties the flows of a TCP/IPv6 reassembly table and
+ * initializes its flow hash table. The flow and bucket arrays and their
+ * sizes must be set.
+ *
+ * @param tbl
+ *  Pointer pointing to the TCP/IPv6 reassembly table.
+ */
+void gro_tcp6_tbl_init_flows(struct gro_tcp6_tbl *tbl);
+
 /**
  * This function destroys a TCP/IPv6 reassembly table.
  *
@@ -159,4 +182,18 @@ is_same_tcp6_flow(struct tcp6_flow_key *k1, struct tcp6_flow_key *k2)
 	return is_same_common_tcp_key(&k1->cmn_key, &k2->cmn_key);
 }
 
+/*
+ * Hash the addresses and ports of a TCP/IPv6 flow.
+ */
+static inline uint32_t
+hash_tcp6_flow(const struct tcp6_flow_key *k)
+{
+	uint32_t hash;
+
+	hash = rte_hash_crc(&k->src_addr, sizeof(k->src_addr), 0);
+	hash = rte_hash_crc(&k->dst_addr, sizeof(k->dst_addr), hash);
+
+	return hash_common_tcp_key(&k->cmn_key, hash);
+}
+
 #endif
@@ -160,10 +160,12 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 	/* allocate a reassembly table for TCP/IPv4 GRO */
 	struct gro_tcp4_tbl tcp_tbl;
 	struct gro_tcp4_flow tcp_flows[RTE_GRO_MAX_BURST_ITEM_NUM];
+	uint32_t tcp_buckets[RTE_GRO_MAX_BURST_ITEM_NUM];
 	struct gro_tcp_item tcp_items[RTE_GRO_MAX_BURST_ITEM_NUM] = {{0} };
 
 	struct gro_tcp6_tbl tcp6_tbl;
 	struct gro_tcp6_flow tcp6_flows[RTE_GRO_MAX_BURST_ITEM_NUM];
+	uint32_t tcp6_buckets[RTE_GRO_MAX_BURST_ITEM_NUM];
 	struct gro_tcp_item tcp6_items[RTE_GRO_MAX_BURST_ITEM_NUM] = {{0} };
 
 	/* allocate a reassembly table for UDP/IPv4 GRO */
@@ -199,6 +201,8 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 	item_num = RTE_MIN(nb_pkts, (param->max_flow_num *
 				param->max_item_per_flow));
 	item_num = RTE_MIN(item_num, RTE_GRO_MAX_BURST_ITEM_NUM);
+	if (unlikely(item_num == 0))
+		return nb_pkts;
 
 	if (param->gro_types & RTE_GRO_IPV4_VXLAN_TCP_IPV4) {
 		for (i = 0; i < item_num; i++)
@@ -227,15 +231,14 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 	}
 
 	if (param->gro_types & RTE_GRO_TCP_IPV4) {
-		for (i = 0; i < item_num; i++)
-			tcp_flows[i].start_index = INVALID_ARRAY_INDEX;
-
 		tcp_tbl.flows = tcp_flows;
 		tcp_tbl.items = tcp_items;
-		tcp_tbl.flow_num = 0;
+		tcp_tbl.buckets = tcp_buckets;
 		tcp_tbl.item_num = 0;
 		tcp_tbl.max_flow_num = item_num;
 		tcp_tbl.max_item_num = item_num;
+		tcp_tbl.bucket_mask = rte_align32pow2(item_num) - 1;
+		gro_tcp4_tbl_init_flows(&tcp_tbl);
 		do_tcp4_gro = 1;
 	}
 
@@ -253,15 +256,14 @@ rte_gro_reassemble_burst(struct rte_mbuf **pkts,
 	}
 
 	if (param->gro_types & RTE_GRO_TCP_IPV6) {
-		for (i = 0; i < item_num; i++)
-			tcp6_flows[i].start_index = INVALID_ARRAY_INDEX;
-
 		tcp6_tbl.flows = tcp6_flows;
 		tcp6_tbl.items = tcp6_items;
-		tcp6_tbl.flow_num = 0;
+		tcp6_tbl.buckets = tcp6_buckets;
 		tcp6_tbl.item_num = 0;
 		tcp6_tbl.max_flow_num = item_num;
 		tcp6_tbl.max_item_num = item_num;
+		tcp6_tbl.bucket_mask = rte_align32pow2(item_num) - 1;
+		gro_tcp6_tbl_init_flows(&tcp6_tbl);
 		do_tcp6_gro = 1;
 	}
 
@@ -37,37 +37,79 @@ free_gso_segment(struct rte_mbuf **pkts, uint16_t nb_pkts)
 		rte_pktmbuf_free(pkts[i]);
 }
 
+/*
+ * Shared information of the external buffer the payload MBUFs are attached
+ * to, stored in a direct MBUF which is freed with the last payload MBUF.
+ */
+struct gso_extbuf_anchor {
+	struct rte_mbuf_ext_shared_info shinfo;
+	struct rte_mbuf *pkt;
+};
+
+static void
+gso_extbuf_free(void *addr __rte_unused, void *opaque)
+{
+	struct rte_mbuf *anchor_mbuf = opaque;
+	struct gso_extbuf_anchor *anchor;
+
+	anchor = rte_pktmbuf_mtod(anchor_mbuf, struct gso_extbuf_anchor *);
+	rte_pktmbuf_free(anchor->pkt);
+	rte_pktmbuf_free(anchor_mbuf);
+}
+
 int
 gso_do_segment(struct rte_mbuf *pkt,
 		uint16_t pkt_hdr_offset,
 		uint16_t pyld_unit_size,
 		struct rte_mempool *direct_pool,
 		struct rte_mempool *indirect_pool,
+		bool extbuf,
 		struct rte_mbuf **pkts_out,
 		uint16_t nb_pkts_out)
 {
 	struct rte_mbuf *pkt_in;
 	struct rte_mbuf *hdr_segment, *pyld_segment, *prev_segment;
+	struct rte_mbuf *anchor_mbuf = NULL;
+	struct gso_extbuf_anchor *anchor = NULL;
 	uint16_t pkt_in_data_pos, segment_bytes_remaining;
-	uint16_t pyld_len, nb_segs;
+	uint16_t pyld_len, nb_segs, nb_pyld_segs;
 	bool more_in_pkt, more_out_segs;
+	int ret;
 
 	pkt_in = pkt;
 	nb_segs = 0;
+	nb_pyld_segs = 0;
 	more_in_pkt = 1;
 	pkt_in_data_pos = pkt_hdr_offset;
+	hdr_segment = NULL;
+
+	if (extbuf) {
+		anchor_mbuf = rte_pktmbuf_alloc(direct_pool);
+		if (unlikely(anchor_mbuf == NULL))
+			return -ENOMEM;
+		if (unlikely(rte_pktmbuf_tailroom(anchor_mbuf) <
+				sizeof(*anchor))) {
+			rte_pktmbuf_free(anchor_mbuf);
+			return -EINVAL;
+		}
+		anchor = rte_pktmbuf_mtod(anchor_mbuf,
+				struct gso_extbuf_anchor *);
+		anchor->shinfo.free_cb = gso_extbuf_free;
+		anchor->shinfo.fcb_opaque = anchor_mbuf;
+		anchor->pkt = pkt;
+	}
 
 	while (more_in_pkt) {
 		if (unlikely(nb_segs >= nb_pkts_out)) {
-			free_gso_segment(pkts_out, nb_segs);
-			return -EINVAL;
+			ret = -EINVAL;
+			goto error;
 		}
 
 		/* Allocate a direct MBUF */
 		hdr_segment = rte_pktmbuf_alloc(direct_pool);
 		if (unlikely(hdr_segment == NULL)) {
-			free_gso_segment(pkts_out, nb_segs);
-			return -ENOMEM;
+			ret = -ENOMEM;
+			goto error;
 		}
 		/* Fill the packet header */
 		hdr_segment_init(hdr_segment, pkt, pkt_hdr_offset);
@@ -80,12 +122,20 @@ gso_do_segment(struct rte_mbuf *pkt,
 			/* Allocate an indirect MBUF */
 			pyld_segment = rte_pktmbuf_alloc(indirect_pool);
 			if (unlikely(pyld_segment == NULL)) {
-				rte_pktmbuf_free(hdr_segment);
-				free_gso_segment(pkts_out, nb_segs);
-				return -ENOMEM;
+				ret = -ENOMEM;
+				goto error;
 			}
 			/* Attach to current MBUF segment of pkt */
-			rte_pktmbuf_attach(pyld_segment, pkt_in);
+			if (extbuf) {
+				rte_pktmbuf_attach_extbuf(pyld_segment,
+						pkt_in->buf_addr,
+						rte_mbuf_iova_get(pkt_in),
+						pkt_in->buf_len,
+						&anchor->shinfo);
+				nb_pyld_segs++;
+			} else {
+				rte_pktmbuf_attach(pyld_segment, pkt_in);
+			}
 
 			prev_segment->next = pyld_segment;
 			prev_segment = pyld_segment;
@@ -118,6 +168,26 @@ gso_do_segment(struct rte_mbuf *pkt,
 				more_out_segs = 0;
 		}
 		pkts_out[nb_segs++] = hdr_segment;
+		hdr_segment = NULL;
 	}
+
+	if (extbuf) {
+		/*
+		 * The input packet is referenced once for all the payload
+		 * MBUFs, whose reference to the external buffer is set at once.
+		 */
+		rte_pktmbuf_refcnt_update(pkt, 1);
+		rte_mbuf_ext_refcnt_set(&anchor->shinfo, nb_pyld_segs);
+	}
+
 	return nb_segs;
+
+error:
+	/* Keep a reference, so that freeing the payload MBUFs doesn't free pkt */
+	if (extbuf)
+		rte_mbuf_ext_refcnt_set(&anchor->shinfo, nb_pyld_segs + 1);
+	rte_pktmbuf_free(hdr_segment);
+	free_gso_segment(pkts_out, nb_segs);
+	rte_pktmbuf_free(anchor_mbuf);
+	return ret;
 }
@@ -5,6 +5,7 @@
 #ifndef _GSO_COMMON_H_
 #define _GSO_COMMON_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <rte_ip.h>
@@ -127,6 +128,9 @@ update_ipv4_header(struct rte_mbuf *pkt, uint16_t l3_offset, uint16_t id)
  *  MBUF pool used for allocating direct buffers for output segments.
  * @param indirect_pool
  *  MBUF pool used for allocating indirect buffers for output segments.
+ * @param extbuf
+ *  Attach the payload MBUFs to the input packet as an external buffer,
+ *  instead of indirect MBUFs.
  * @param pkts_out
  *  Pointer array used to keep the mbuf addresses of output segments. If
  *  the memory space in pkts_out is insufficient, gso_do_segment() fails
@@ -144,6 +148,7 @@ int gso_do_segment(struct rte_mbuf *pkt,
 		uint16_t pyld_unit_size,
 		struct rte_mempool *direct_pool,
 		struct rte_mempool *indirect_pool,
+		bool extbuf,
 		struct rte_mbuf **pkts_out,
 		uint16_t nb_pkts_out);
 #endif
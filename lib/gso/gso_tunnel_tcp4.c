@@ -57,6 +57,7 @@ gso_tunnel_tcp4_segment(struct rte_mbuf *pkt,
 		uint8_t ipid_delta,
 		struct rte_mempool *direct_pool,
 		struct rte_mempool *indirect_pool,
+		bool extbuf,
 		struct rte_mbuf **pkts_out,
 		uint16_t nb_pkts_out)
 {
@@ -85,7 +86,7 @@ gso_tunnel_tcp4_segment(struct rte_mbuf *pkt,
 
 	/* Segment the payload */
 	ret = gso_do_segment(pkt, hdr_offset, pyld_unit_size, direct_pool,
-			indirect_pool, pkts_out, nb_pkts_out);
+			indirect_pool, extbuf, pkts_out, nb_pkts_out);
 	if (ret > 1)
 		update_tunnel_ipv4_tcp_headers(pkt, ipid_delta, pkts_out, ret);
 
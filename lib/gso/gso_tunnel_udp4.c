@@ -59,6 +59,7 @@ gso_tunnel_udp4_segment(struct rte_mbuf *pkt,
 		uint16_t gso_size,
 		struct rte_mempool *direct_pool,
 		struct rte_mempool *indirect_pool,
+		bool extbuf,
 		struct rte_mbuf **pkts_out,
 		uint16_t nb_pkts_out)
 {
@@ -89,7 +90,7 @@ gso_tunnel_udp4_segment(struct rte_mbuf *pkt,
 
 	/* Segment the payload */
 	ret = gso_do_segment(pkt, hdr_offset, pyld_unit_size, direct_pool,
-			indirect_pool, pkts_out, nb_pkts_out);
+			indirect_pool, extbuf, pkts_out, nb_pkts_out);
 	if (ret > 1)
 		update_tunnel_ipv4_udp_headers(pkt, pkts_out, ret);
 
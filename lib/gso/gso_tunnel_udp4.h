@@ -5,6 +5,7 @@
 #ifndef _GSO_TUNNEL_UDP4_H_
 #define _GSO_TUNNEL_UDP4_H_
 
+#include <stdbool.h>
 #include <stdint.h>
 
 /**
@@ -21,6 +22,8 @@
  *  MBUF pool used for allocating direct buffers for output segments.
  * @param indirect_pool
  *  MBUF pool used for allocating indirect buffers for output segments.
+ * @param extbuf
+ *  Attach the payload of output segments as an external buffer.
  * @param pkts_out
  *  Pointer array used to store the MBUF addresses of output GSO
  *  segments, when it succeeds. If the memory space in pkts_out is
@@ -38,6 +41,7 @@ int gso_tunnel_udp4_segment(struct rte_mbuf *pkt,
 		uint16_t gso_size,
 		struct rte_mempool *direct_pool,
 		struct rte_mempool *indirect_pool,
+		bool extbuf,
 		struct rte_mbuf **pkts_out,
 		uint16_t nb_pkts_out);
 #endif
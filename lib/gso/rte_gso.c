@@ -3,6 +3,7 @@
  */
 
 #include <errno.h>
+#include <stdbool.h>
 
 #include <eal_export.h>
 #include <rte_log.h>
@@ -36,6 +37,7 @@ rte_gso_segment(struct rte_mbuf *pkt,
 	uint64_t ol_flags;
 	uint16_t gso_size;
 	uint8_t ipid_delta;
+	bool extbuf;
 	int ret = 1;
 
 	if (pkt == NULL || pkts_out == NULL || gso_ctx == NULL ||
@@ -52,7 +54,8 @@ rte_gso_segment(struct rte_mbuf *pkt,
 	direct_pool = gso_ctx->direct_pool;
 	indirect_pool = gso_ctx->indirect_pool;
 	gso_size = gso_ctx->gso_size;
-	ipid_delta = (gso_ctx->flag != RTE_GSO_FLAG_IPID_FIXED);
+	ipid_delta = !(gso_ctx->flag & RTE_GSO_FLAG_IPID_FIXED);
+	extbuf = !!(gso_ctx->flag & RTE_GSO_FLAG_EXTBUF);
 	ol_flags = pkt->ol_flags;
 
 	if ((IS_IPV4_VXLAN_TCP4(pkt->ol_flags) &&
@@ -61,26 +64,26 @@ rte_gso_segment(struct rte_mbuf *pkt,
 			 (gso_ctx->gso_types & RTE_ETH_TX_OFFLOAD_GRE_TNL_TSO)))) {
 		pkt->ol_flags &= (~RTE_MBUF_F_TX_TCP_SEG);
 		ret = gso_tunnel_tcp4_segment(pkt, gso_size, ipid_delta,
-				direct_pool, indirect_pool,
+				direct_pool, indirect_pool, extbuf,
 				pkts_out, nb_pkts_out);
 	} else if (IS_IPV4_VXLAN_UDP4(pkt->ol_flags) &&
 			(gso_ctx->gso_types & RTE_ETH_TX_OFFLOAD_VXLAN_TNL_TSO) &&
 			(gso_ctx->gso_types & RTE_ETH_TX_OFFLOAD_UDP_TSO)) {
 		pkt->ol_flags &= (~RTE_MBUF_F_TX_UDP_SEG);
 		ret = gso_tunnel_udp4_segment(pkt, gso_size,
-				direct_pool, indirect_pool,
+				direct_pool, indirect_pool, extbuf,
 				pkts_out, nb_pkts_out);
 	} else if (IS_IPV4_TCP(pkt->ol_flags) &&
 			(gso_ctx->gso_types & RTE_ETH_TX_OFFLOAD_TCP_TSO)) {
 		pkt->ol_flags &= (~RTE_MBUF_F_TX_TCP_SEG);
 		ret = gso_tcp4_segment(pkt, gso_size, ipid_delta,
-				direct_pool, indirect_pool,
+				direct_pool, indirect_pool, extbuf,
 				pkts_out, nb_pkts_out);
 	} else if (IS_IPV4_UDP(pkt->ol_flags) &&
 			(gso_ctx->gso_types & RTE_ETH_TX_OFFLOAD_UDP_TSO)) {
 		pkt->ol_flags &= (~RTE_MBUF_F_TX_UDP_SEG);
 		ret = gso_udp4_segment(pkt, gso_size, direct_pool,
-				indirect_pool, pkts_out, nb_pkts_out);
+				indirect_pool, extbuf, pkts_out, nb_pkts_out);
 	} else {
 		ret = -ENOTSUP;	/* only UDP or TCP allowed */
 	}
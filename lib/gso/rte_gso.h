@@ -30,6 +30,16 @@ extern "C" {
 /**< Use fixed IP ids for output GSO segments. Setting
  * 0 indicates using incremental IP ids.
  */
+#define RTE_GSO_FLAG_EXTBUF (1ULL << 1)
+/**< Attach the payload MBUFs of output GSO segments to the input packet
+ * as an external buffer, instead of indirect MBUFs. The input packet is
+ * referenced once per MBUF segment, instead of once per GSO segment, and
+ * the payload MBUFs reference the external buffer without atomic operation
+ * at segmentation time. One more MBUF is allocated from the direct pool to
+ * hold the external buffer information, until all the output GSO segments
+ * are freed. The input packet data must not be released by other means,
+ * e.g. with rte_pktmbuf_detach(), while the output GSO segments are in use.
+ */
 
 /**
  * GSO context structure.
@@ -90,7 +100,8 @@ struct rte_gso_ctx {
  * packets.
  *
  * If the input packet is GSO'd, all the indirect segments are attached to the
- * input packet.
+ * input packet. With RTE_GSO_FLAG_EXTBUF, the payload segments are MBUFs
+ * with an external buffer pointing to the input packet data instead.
  *
  * rte_gso_segment() will not free the input packet no matter whether it is
  * GSO'd or not, the application should free it after calling rte_gso_segment().
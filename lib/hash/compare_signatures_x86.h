@@ -7,11 +7,16 @@
 #define COMPARE_SIGNATURES_X86_H
 
 #include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
 
 #include <rte_common.h>
 #include <rte_vect.h>
 
 #include "rte_cuckoo_hash.h"
+#ifdef CC_AVX512_SUPPORT
+#include "rte_cuckoo_hash_avx512.h"
+#endif
 
 /* x86's version uses a sparsely packed hitmask buffer: every other bit is padding. */
 #define DENSE_HASH_BULK_LOOKUP 0
@@ -29,6 +34,7 @@ compare_signatures_sparse(uint32_t *prim_hash_matches, uint32_t *sec_hash_matche
 	switch (sig_cmp_fn) {
 #if defined(__SSE2__) && RTE_HASH_BUCKET_ENTRIES <= 8
 	case RTE_HASH_COMPARE_SSE:
+	case RTE_HASH_COMPARE_AVX512:
 		/* Compare all signatures in the bucket */
 		*prim_hash_matches = _mm_movemask_epi8(_mm_cmpeq_epi16(_mm_load_si128(
 			(__m128i const *)prim_bkt->sig_current), _mm_set1_epi16(sig)));
@@ -48,4 +54,39 @@ compare_signatures_sparse(uint32_t *prim_hash_matches, uint32_t *sec_hash_matche
 		}
 	}
 }
+
+/*
+ * Compare the signatures of all the keys of a bulk lookup at once.
+ * Return false if not supported, the signatures being compared
+ * key by key with compare_signatures_sparse().
+ */
+static inline bool
+compare_signatures_sparse_bulk(uint32_t *prim_hash_matches, uint32_t *sec_hash_matches,
+			const struct rte_hash_bucket **prim_bkt,
+			const struct rte_hash_bucket **sec_bkt,
+			const uint16_t *sig, int32_t num_keys,
+			enum rte_hash_sig_compare_function sig_cmp_fn)
+{
+#ifdef CC_AVX512_SUPPORT
+	static_assert(offsetof(struct rte_hash_bucket, sig_current) == 0 &&
+		RTE_HASH_BUCKET_ENTRIES == 8,
+		"The AVX512 compare loads the 8 signatures at the bucket start");
+
+	if (sig_cmp_fn == RTE_HASH_COMPARE_AVX512) {
+		compare_signatures_sparse_bulk_avx512(prim_hash_matches,
+			sec_hash_matches, (const void *const *)prim_bkt,
+			(const void *const *)sec_bkt, sig, num_keys);
+		return true;
+	}
+#else
+	RTE_SET_USED(prim_hash_matches);
+	RTE_SET_USED(sec_hash_matches);
+	RTE_SET_USED(prim_bkt);
+	RTE_SET_USED(sec_bkt);
+	RTE_SET_USED(sig);
+	RTE_SET_USED(num_keys);
+	RTE_SET_USED(sig_cmp_fn);
+#endif
+	return false;
+}
 #endif /* COMPARE_SIGNATURES_X86_H */
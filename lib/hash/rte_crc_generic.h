@@ -33,4 +33,14 @@ rte_hash_crc_8byte(uint64_t data, uint32_t init_val)
 	return crc32c_2words(data, init_val);
 }
 
+/* Software crc32 implementation for four 8 byte values. */
+static inline void
+crc32c_8byte_x4(const uint64_t data[4], uint32_t crc[4])
+{
+	crc[0] = crc32c_2words(data[0], crc[0]);
+	crc[1] = crc32c_2words(data[1], crc[1]);
+	crc[2] = crc32c_2words(data[2], crc[2]);
+	crc[3] = crc32c_2words(data[3], crc[3]);
+}
+
 #endif /* _RTE_CRC_GENERIC_H_ */
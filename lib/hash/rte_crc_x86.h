@@ -108,4 +108,37 @@ rte_hash_crc_8byte(uint64_t data, uint32_t init_val)
 	return crc32c_2words(data, init_val);
 }
 
+/*
+ * Use four independent crc32 instructions to perform hashes on four
+ * 8 byte values, so that their latencies overlap.
+ * Fall back to software crc32 implementation in case SSE4.2 is
+ * not supported.
+ */
+static inline void
+crc32c_8byte_x4(const uint64_t data[4], uint32_t crc[4])
+{
+#ifdef RTE_ARCH_X86_64
+	if (likely(rte_hash_crc32_alg == CRC32_SSE42_x64)) {
+		crc[0] = crc32c_sse42_u64(data[0], crc[0]);
+		crc[1] = crc32c_sse42_u64(data[1], crc[1]);
+		crc[2] = crc32c_sse42_u64(data[2], crc[2]);
+		crc[3] = crc32c_sse42_u64(data[3], crc[3]);
+		return;
+	}
+#endif
+
+	if (likely(rte_hash_crc32_alg & CRC32_SSE42)) {
+		crc[0] = crc32c_sse42_u64_mimic(data[0], crc[0]);
+		crc[1] = crc32c_sse42_u64_mimic(data[1], crc[1]);
+		crc[2] = crc32c_sse42_u64_mimic(data[2], crc[2]);
+		crc[3] = crc32c_sse42_u64_mimic(data[3], crc[3]);
+		return;
+	}
+
+	crc[0] = crc32c_2words(data[0], crc[0]);
+	crc[1] = crc32c_2words(data[1], crc[1]);
+	crc[2] = crc32c_2words(data[2], crc[2]);
+	crc[3] = crc32c_2words(data[3], crc[3]);
+}
+
 #endif /* _RTE_CRC_X86_H_ */
@@ -15,6 +15,7 @@
 #include <rte_prefetch.h>
 #include <rte_branch_prediction.h>
 #include <rte_malloc.h>
+#include <rte_pause.h>
 #include <rte_eal_memconfig.h>
 #include <rte_errno.h>
 #include <rte_string_fns.h>
@@ -42,6 +43,7 @@ enum rte_hash_sig_compare_function {
 	RTE_HASH_COMPARE_SSE,
 	RTE_HASH_COMPARE_NEON,
 	RTE_HASH_COMPARE_SVE,
+	RTE_HASH_COMPARE_AVX512,
 };
 
 #if defined(__ARM_NEON)
@@ -58,7 +60,30 @@ enum rte_hash_sig_compare_function {
 				   RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY | \
 				   RTE_HASH_EXTRA_FLAGS_EXT_TABLE |	\
 				   RTE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL | \
-				   RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF)
+				   RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF | \
+				   RTE_HASH_EXTRA_FLAGS_RESIZABLE | \
+				   RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD_LF)
+
+/* Flags not supported by resizable hashes */
+#define RTE_HASH_RESIZE_UNSUPPORTED_FLAGS (RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD | \
+				   RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD_LF | \
+				   RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY | \
+				   RTE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL)
+
+/* Number of positions of the old table migrated by each add or delete */
+#define RTE_HASH_RESIZE_MIGRATE_STEP 8
+
+/* Size of the defer queue of the old tables of a resizable hash */
+#define RTE_HASH_RESIZE_DQ_SIZE 4
+
+/* Iterator flag of the keys of the old table of a resizable hash */
+#define RTE_HASH_RESIZE_ITER_OLD (UINT32_C(1) << 31)
+
+/*
+ * Position flag of the keys of the old table of a resizable hash,
+ * above the positions of the largest table.
+ */
+#define RTE_HASH_RESIZE_POS_OLD (INT32_C(1) << 30)
 
 #define FOR_EACH_BUCKET(CURRENT_BKT, START_BUCKET)                            \
 	for (CURRENT_BKT = START_BUCKET;                                      \
@@ -113,6 +138,12 @@ rte_hash_get_last_bkt(struct rte_hash_bucket *lst_bkt)
 RTE_EXPORT_SYMBOL(rte_hash_set_cmp_func)
 void rte_hash_set_cmp_func(struct rte_hash *h, rte_hash_cmp_eq_t func)
 {
+	if (h->resize != NULL) {
+		rte_hash_set_cmp_func(h->resize->cur, func);
+		if (h->resize->old != NULL)
+			rte_hash_set_cmp_func(h->resize->old, func);
+	}
+
 	h->cmp_jump_table_idx = KEY_CUSTOM;
 	h->rte_hash_custom_cmp_eq = func;
 }
@@ -126,6 +157,61 @@ rte_hash_cmp_eq(const void *key1, const void *key2, const struct rte_hash *h)
 		return cmp_jump_table[h->cmp_jump_table_idx](key1, key2, h->key_len);
 }
 
+/*
+ * Compare keys with the function of a compare case known at compile time,
+ * so that the compare of the fixed size keys is inlined.
+ * Other cases go through the compare function of the table.
+ */
+static __rte_always_inline int
+rte_hash_cmp_eq_key(const void *key1, const void *key2,
+		const struct rte_hash *h, const enum cmp_jump_table_case cmp_idx)
+{
+	switch (cmp_idx) {
+#if defined(RTE_ARCH_X86) || defined(RTE_ARCH_ARM64)
+	case KEY_16_BYTES:
+		return rte_hash_k16_cmp_eq(key1, key2, 16);
+	case KEY_32_BYTES:
+		return rte_hash_k32_cmp_eq(key1, key2, 32);
+	case KEY_48_BYTES:
+		return rte_hash_k48_cmp_eq(key1, key2, 48);
+	case KEY_64_BYTES:
+		return rte_hash_k64_cmp_eq(key1, key2, 64);
+	case KEY_80_BYTES:
+		return rte_hash_k80_cmp_eq(key1, key2, 80);
+	case KEY_96_BYTES:
+		return rte_hash_k96_cmp_eq(key1, key2, 96);
+	case KEY_112_BYTES:
+		return rte_hash_k112_cmp_eq(key1, key2, 112);
+	case KEY_128_BYTES:
+		return rte_hash_k128_cmp_eq(key1, key2, 128);
+#endif
+	default:
+		return rte_hash_cmp_eq(key1, key2, h);
+	}
+}
+
+/*
+ * Get the key slot of an index.
+ * The stride of the key store is a constant for the fixed size keys,
+ * whose compare case is KEY_16_BYTES for 16 bytes, up to KEY_128_BYTES.
+ */
+static __rte_always_inline const struct rte_hash_key *
+rte_hash_key_slot(const struct rte_hash *h, uint32_t key_idx,
+		const enum cmp_jump_table_case cmp_idx)
+{
+	uint32_t key_entry_size = h->key_entry_size;
+
+#if defined(RTE_ARCH_X86) || defined(RTE_ARCH_ARM64)
+	if (cmp_idx >= KEY_16_BYTES && cmp_idx <= KEY_128_BYTES)
+		key_entry_size = RTE_ALIGN(sizeof(struct rte_hash_key) +
+				(cmp_idx - KEY_CUSTOM) * 16, KEY_ALIGNMENT);
+#else
+	RTE_SET_USED(cmp_idx);
+#endif
+	return (const struct rte_hash_key *)((const char *)h->key_store +
+			key_idx * key_entry_size);
+}
+
 /*
  * We use higher 16 bits of hash as the signature value stored in table.
  * We use the lower bits for the primary bucket
@@ -156,6 +242,115 @@ get_alt_bucket_index(const struct rte_hash *h,
 	return (cur_bkt_idx ^ sig) & h->bucket_bitmask;
 }
 
+/*
+ * A resizable hash is a handle holding no key, the keys being stored in
+ * internal tables: the current one, where keys are added, and during a
+ * resize the old one, the keys of which are migrated to the current one.
+ * Lookups check the current table first, then the old one, and a key
+ * deleted during a resize is deleted from the old table first, so that a
+ * key present until the delete is always found in one of them.
+ * The positions of the keys of the old table have RTE_HASH_RESIZE_POS_OLD
+ * set, for them to be resolved in the table they come from.
+ */
+
+static RTE_ATOMIC(uint32_t) hash_resize_id;
+
+/* Create an internal table of a resizable hash. */
+static struct rte_hash *
+hash_resize_new_table(const struct rte_hash *h, struct rte_hash_resize *rs,
+		uint32_t entries)
+{
+	struct rte_hash_parameters params = rs->params;
+	struct rte_hash *t;
+
+	snprintf(rs->name, sizeof(rs->name), "HASH_RSZ_%u",
+		rte_atomic_fetch_add_explicit(&hash_resize_id, 1,
+			rte_memory_order_relaxed));
+	params.entries = entries;
+
+	t = rte_hash_create(&params);
+	if (t == NULL)
+		return NULL;
+
+	if (h != NULL && h->cmp_jump_table_idx == KEY_CUSTOM)
+		rte_hash_set_cmp_func(t, h->rte_hash_custom_cmp_eq);
+	if (rs->rcu_cfg.v != NULL && rte_hash_rcu_qsbr_add(t, &rs->rcu_cfg) != 0) {
+		rte_hash_free(t);
+		return NULL;
+	}
+	rs->params.entries = entries;
+
+	return t;
+}
+
+static struct rte_hash *
+hash_resize_create(const struct rte_hash_parameters *params)
+{
+	struct rte_hash_parameters handle_params = *params;
+	struct rte_hash_resize *rs;
+	struct rte_hash *h, *cur;
+
+	if (params->extra_flag & RTE_HASH_RESIZE_UNSUPPORTED_FLAGS) {
+		rte_errno = EINVAL;
+		HASH_LOG(ERR, "%s: multi-writer, rw concurrency with lock and no free on delete are not supported by resizable hashes",
+			__func__);
+		return NULL;
+	}
+
+	/* the positions must stay below RTE_HASH_RESIZE_POS_OLD */
+	if (params->entries > RTE_HASH_ENTRIES_MAX / 2) {
+		rte_errno = EINVAL;
+		HASH_LOG(ERR, "%s: resizable hash has more than %u entries",
+			__func__, RTE_HASH_ENTRIES_MAX / 2);
+		return NULL;
+	}
+
+	rs = rte_zmalloc_socket(NULL, sizeof(*rs), 0, params->socket_id);
+	if (rs == NULL) {
+		rte_errno = ENOMEM;
+		HASH_LOG(ERR, "memory allocation failed");
+		return NULL;
+	}
+	rs->params = *params;
+	rs->params.name = rs->name;
+	rs->params.extra_flag &= ~RTE_HASH_EXTRA_FLAGS_RESIZABLE;
+
+	cur = hash_resize_new_table(NULL, rs, params->entries);
+	if (cur == NULL) {
+		rte_free(rs);
+		return NULL;
+	}
+
+	/* the handle itself is a minimal table */
+	handle_params.entries = RTE_HASH_BUCKET_ENTRIES;
+	handle_params.extra_flag = rs->params.extra_flag;
+	h = rte_hash_create(&handle_params);
+	if (h == NULL) {
+		rte_hash_free(cur);
+		rte_free(rs);
+		return NULL;
+	}
+
+	rte_atomic_store_explicit(&rs->cur, cur, rte_memory_order_relaxed);
+	h->resize = rs;
+
+	return h;
+}
+
+static void
+hash_resize_free(struct rte_hash *h)
+{
+	struct rte_hash_resize *rs = h->resize;
+
+	if (rs->dq != NULL && rte_rcu_qsbr_dq_delete(rs->dq) != 0)
+		HASH_LOG(ERR, "%s: old tables of hash %s still in use",
+			__func__, h->name);
+	rte_hash_free(rs->old);
+	rte_hash_free(rs->cur);
+	rte_free(rs);
+	h->resize = NULL;
+}
+
 RTE_EXPORT_SYMBOL(rte_hash_create)
 struct rte_hash *
 rte_hash_create(const struct rte_hash_parameters *params)
@@ -175,6 +370,7 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	unsigned int ext_table_support = 0;
 	unsigned int readwrite_concur_support = 0;
 	unsigned int writer_takes_lock = 0;
+	unsigned int writer_add_lf = 0;
 	unsigned int no_free_on_del = 0;
 	uint32_t *ext_bkt_to_free = NULL;
 	RTE_ATOMIC(uint32_t) *tbl_chng_cnt = NULL;
@@ -237,6 +433,17 @@ rte_hash_create(const struct rte_hash_parameters *params)
 		return NULL;
 	}
 
+	if ((params->extra_flag & RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD_LF) &&
+	    !(params->extra_flag & RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF)) {
+		rte_errno = EINVAL;
+		HASH_LOG(ERR, "%s: lock free multi-writer add requires rw concurrency lock free",
+			__func__);
+		return NULL;
+	}
+
+	if (params->extra_flag & RTE_HASH_EXTRA_FLAGS_RESIZABLE)
+		return hash_resize_create(params);
+
 	/* Check extra flags field to check extra options. */
 	if (params->extra_flag & RTE_HASH_EXTRA_FLAGS_TRANS_MEM_SUPPORT)
 		hw_trans_mem_support = 1;
@@ -246,6 +453,12 @@ rte_hash_create(const struct rte_hash_parameters *params)
 		writer_takes_lock = 1;
 	}
 
+	if (params->extra_flag & RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD_LF) {
+		use_local_cache = 1;
+		writer_takes_lock = 1;
+		writer_add_lf = 1;
+	}
+
 	if (params->extra_flag & RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY) {
 		readwrite_concur_support = 1;
 		writer_takes_lock = 1;
@@ -475,6 +688,7 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	h->free_ext_bkts = r_ext;
 	h->hash_func = (params->hash_func == NULL) ?
 		default_hash_func : params->hash_func;
+	h->hash_func_crc = h->hash_func == (rte_hash_function)rte_hash_crc;
 	h->key_store = k;
 	h->free_slots = r;
 	h->ext_bkt_to_free = ext_bkt_to_free;
@@ -486,12 +700,20 @@ rte_hash_create(const struct rte_hash_parameters *params)
 	h->readwrite_concur_support = readwrite_concur_support;
 	h->ext_table_support = ext_table_support;
 	h->writer_takes_lock = writer_takes_lock;
+	h->writer_add_lf = writer_add_lf;
 	h->no_free_on_del = no_free_on_del;
 	h->readwrite_concur_lf_support = readwrite_concur_lf_support;
 
 #if defined(RTE_ARCH_X86)
-	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_SSE2))
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_SSE2)) {
 		h->sig_cmp_fn = RTE_HASH_COMPARE_SSE;
+#ifdef CC_AVX512_SUPPORT
+		if (rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_512 &&
+				rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512F) &&
+				rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX512BW))
+			h->sig_cmp_fn = RTE_HASH_COMPARE_AVX512;
+#endif
+	}
 	else
 #elif defined(RTE_ARCH_ARM64)
 	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_NEON)) {
@@ -507,7 +729,7 @@ rte_hash_create(const struct rte_hash_parameters *params)
 
 	/* Writer threads need to take the lock when:
 	 * 1) RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY is enabled OR
-	 * 2) RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD is enabled
+	 * 2) RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD(_LF) is enabled
 	 */
 	if (h->writer_takes_lock) {
 		h->readwrite_lock = rte_malloc(NULL, sizeof(rte_rwlock_t),
@@ -553,6 +775,9 @@ rte_hash_free(struct rte_hash *h)
 	if (h == NULL)
 		return;
 
+	if (h->resize != NULL)
+		hash_resize_free(h);
+
 	hash_list = RTE_TAILQ_CAST(rte_hash_tailq.head, rte_hash_list);
 
 	rte_mcfg_tailq_write_lock();
@@ -604,6 +829,8 @@ int32_t
 rte_hash_max_key_id(const struct rte_hash *h)
 {
 	RETURN_IF_TRUE((h == NULL), -EINVAL);
+	if (h->resize != NULL)
+		return rte_hash_max_key_id(h->resize->cur);
 	if (h->use_local_cache)
 		/*
 		 * Increase number of slots by total number of indices
@@ -625,6 +852,13 @@ rte_hash_count(const struct rte_hash *h)
 	if (h == NULL)
 		return -EINVAL;
 
+	if (h->resize != NULL) {
+		ret = rte_hash_count(h->resize->cur) - h->resize->nb_dup;
+		if (h->resize->old != NULL)
+			ret += rte_hash_count(h->resize->old);
+		return ret;
+	}
+
 	if (h->use_local_cache) {
 		tot_ring_cnt = h->entries + (RTE_MAX_LCORE - 1) *
 					(LCORE_CACHE_SIZE - 1);
@@ -695,6 +929,16 @@ rte_hash_reset(struct rte_hash *h)
 	if (h == NULL)
 		return;
 
+	if (h->resize != NULL) {
+		/* no reader references the hash, the old table can go */
+		rte_hash_free(h->resize->old);
+		rte_atomic_store_explicit(&h->resize->old, NULL,
+			rte_memory_order_relaxed);
+		h->resize->nb_dup = 0;
+		rte_hash_reset(h->resize->cur);
+		return;
+	}
+
 	__hash_rw_writer_lock(h);
 
 	if (h->dq) {
@@ -1076,6 +1320,123 @@ alloc_slot(const struct rte_hash *h, struct lcore_cache *cached_free_slots)
 	return slot_id;
 }
 
+/*
+ * Lock of a bucket, taken by the lock free multi-writer add on the primary
+ * bucket of the key, so that the adds of a same key are serialized.
+ * The flag of the first entry, otherwise unused, is the lock.
+ */
+static inline void
+__hash_bkt_lock(struct rte_hash_bucket *bkt)
+{
+	uint8_t __rte_atomic *lock = (uint8_t __rte_atomic *)&bkt->flag[0];
+
+	while (rte_atomic_exchange_explicit(lock, 1,
+			rte_memory_order_acquire) != 0) {
+		while (rte_atomic_load_explicit(lock,
+				rte_memory_order_relaxed) != 0)
+			rte_pause();
+	}
+}
+
+static inline void
+__hash_bkt_unlock(struct rte_hash_bucket *bkt)
+{
+	rte_atomic_store_explicit((uint8_t __rte_atomic *)&bkt->flag[0], 0,
+			rte_memory_order_release);
+}
+
+/*
+ * Insert a key index in an empty entry of a bucket, which may be the
+ * secondary bucket of a concurrent writer: the entry is claimed with
+ * a compare-and-swap of its key index, before its signature is set.
+ * Readers ignore the entry until its signature is set.
+ */
+static inline int
+__hash_bkt_insert_lf(struct rte_hash_bucket *bkt, uint16_t sig,
+		uint32_t new_idx)
+{
+	unsigned int i;
+	uint32_t expected;
+
+	for (i = 0; i < RTE_HASH_BUCKET_ENTRIES; i++) {
+		if (rte_atomic_load_explicit(&bkt->key_idx[i],
+				rte_memory_order_relaxed) != EMPTY_SLOT)
+			continue;
+		expected = EMPTY_SLOT;
+		/* Store to key should not leak after the store to key_idx */
+		if (rte_atomic_compare_exchange_strong_explicit(
+				&bkt->key_idx[i], &expected, new_idx,
+				rte_memory_order_release,
+				rte_memory_order_relaxed)) {
+			bkt->sig_current[i] = sig;
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+/*
+ * Lock free multi-writer add: add a key to an empty entry of its primary
+ * or secondary bucket, with the table lock shared with the other writers
+ * adding keys the same way, and the lock of the primary bucket.
+ * Moving keys is left to the locked path, which gets the table lock
+ * exclusively, as do deletes.
+ * Return -EAGAIN if the key must be added by the locked path.
+ */
+static inline int32_t
+__rte_hash_add_key_lf(const struct rte_hash *h, const void *key, void *data,
+		struct rte_hash_bucket *prim_bkt, struct rte_hash_bucket *sec_bkt,
+		uint16_t short_sig)
+	__rte_no_thread_safety_analysis
+{
+	struct rte_hash_key *new_k, *keys = h->key_store;
+	struct lcore_cache *cached_free_slots;
+	struct rte_hash_bucket *cur_bkt;
+	uint32_t slot_id;
+	int32_t ret;
+
+	rte_rwlock_read_lock(h->readwrite_lock);
+	__hash_bkt_lock(prim_bkt);
+
+	/* Only this writer may add the key until the bucket is unlocked */
+	ret = search_and_update(h, data, key, prim_bkt, short_sig);
+	if (ret != -1)
+		goto unlock;
+	FOR_EACH_BUCKET(cur_bkt, sec_bkt) {
+		ret = search_and_update(h, data, key, cur_bkt, short_sig);
+		if (ret != -1)
+			goto unlock;
+	}
+
+	cached_free_slots = &h->local_free_slots[rte_lcore_id()];
+	slot_id = alloc_slot(h, cached_free_slots);
+	if (slot_id == EMPTY_SLOT) {
+		/* reclaiming needs the table lock */
+		ret = -EAGAIN;
+		goto unlock;
+	}
+
+	new_k = RTE_PTR_ADD(keys, slot_id * h->key_entry_size);
+	rte_atomic_store_explicit(&new_k->pdata, data,
+		rte_memory_order_release);
+	memcpy(new_k->key, key, h->key_len);
+
+	if (__hash_bkt_insert_lf(prim_bkt, short_sig, slot_id) == 0 ||
+			__hash_bkt_insert_lf(sec_bkt, short_sig, slot_id) == 0) {
+		ret = slot_id - 1;
+	} else {
+		enqueue_slot_back(h, cached_free_slots, slot_id);
+		ret = -EAGAIN;
+	}
+
+unlock:
+	__hash_bkt_unlock(prim_bkt);
+	rte_rwlock_read_unlock(h->readwrite_lock);
+
+	return ret;
+}
+
 static inline int32_t
 __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 						hash_sig_t sig, void *data)
@@ -1101,6 +1462,13 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 	rte_prefetch0(prim_bkt);
 	rte_prefetch0(sec_bkt);
 
+	if (h->writer_add_lf) {
+		ret = __rte_hash_add_key_lf(h, key, data, prim_bkt, sec_bkt,
+				short_sig);
+		if (ret != -EAGAIN)
+			return ret;
+	}
+
 	/* Check if key is already inserted in primary location */
 	__hash_rw_writer_lock(h);
 	ret = search_and_update(h, data, key, prim_bkt, short_sig);
@@ -1269,12 +1637,260 @@ __rte_hash_add_key_with_hash(const struct rte_hash *h, const void *key,
 
 }
 
+static void
+hash_resize_free_table(void *p, void *e, unsigned int n)
+{
+	RTE_SET_USED(p);
+	RTE_SET_USED(n);
+
+	rte_hash_free(*(struct rte_hash **)e);
+}
+
+/* Free the old table once all its keys are migrated. */
+static void
+hash_resize_retire(const struct rte_hash *h)
+{
+	struct rte_rcu_qsbr_dq_parameters params = {0};
+	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
+	struct rte_hash_resize *rs = h->resize;
+	struct rte_hash *old = rs->old;
+
+	rte_atomic_store_explicit(&rs->old, NULL, rte_memory_order_release);
+	rs->nb_dup = 0;
+
+	if (!h->readwrite_concur_lf_support) {
+		rte_hash_free(old);
+		return;
+	}
+
+	/* lock free readers may still be looking up the old table */
+	if (rs->dq == NULL) {
+		if (snprintf(rcu_dq_name, sizeof(rcu_dq_name), "HASH_RSZ_%s", h->name)
+				>= (int)sizeof(rcu_dq_name))
+			HASH_LOG(NOTICE, "HASH defer queue name truncated to: %s", rcu_dq_name);
+		params.name = rcu_dq_name;
+		params.size = RTE_HASH_RESIZE_DQ_SIZE;
+		params.max_reclaim_size = RTE_HASH_RESIZE_DQ_SIZE;
+		params.esize = sizeof(old);
+		params.free_fn = hash_resize_free_table;
+		params.v = rs->rcu_cfg.v;
+		rs->dq = rte_rcu_qsbr_dq_create(&params);
+	}
+	if (rs->dq == NULL || rte_rcu_qsbr_dq_enqueue(rs->dq, &old) != 0) {
+		rte_rcu_qsbr_synchronize(rs->rcu_cfg.v, RTE_QSBR_THRID_INVALID);
+		rte_hash_free(old);
+	}
+}
+
+/* Migrate the keys of at most n positions of the old table. */
+static void
+hash_resize_migrate(const struct rte_hash *h, uint32_t n)
+{
+	struct rte_hash_resize *rs = h->resize;
+	struct rte_hash *old = rs->old;
+	struct rte_hash *cur = rs->cur;
+	const void *key;
+	uint32_t cursor;
+	hash_sig_t sig;
+	void *data;
+
+	while (n-- > 0) {
+		cursor = rs->cursor;
+		if (rte_hash_iterate(old, &key, &data, &rs->cursor) < 0) {
+			hash_resize_retire(h);
+			return;
+		}
+
+		/* the key may have been added again with new data */
+		sig = rte_hash_hash(old, key);
+		if (rte_hash_lookup_with_hash(cur, key, sig) >= 0)
+			continue;
+		if (__rte_hash_add_key_with_hash(cur, key, sig, data) < 0) {
+			/* no room, retry on the next call */
+			rs->cursor = cursor;
+			return;
+		}
+		rs->nb_dup++;
+	}
+}
+
+/* Replace the current table with a table twice as large. */
+static int
+hash_resize_grow(const struct rte_hash *h)
+{
+	struct rte_hash_resize *rs = h->resize;
+	struct rte_hash *cur, *t;
+	unsigned int pending;
+	uint32_t entries;
+
+	/* lock free readers need RCU to free the old table */
+	if (h->readwrite_concur_lf_support && rs->rcu_cfg.v == NULL)
+		return -ENOSPC;
+
+	/* one resize at a time, complete the one in progress */
+	if (rs->old != NULL) {
+		hash_resize_migrate(h, UINT32_MAX);
+		if (rs->old != NULL)
+			return -ENOSPC;
+	}
+
+	cur = rs->cur;
+	entries = rs->params.entries * 2;
+	if (entries > RTE_HASH_ENTRIES_MAX / 2)
+		return -ENOSPC;
+
+	t = hash_resize_new_table(h, rs, entries);
+	if (t == NULL) {
+		HASH_LOG(ERR, "%s: cannot resize hash %s to %u entries",
+			__func__, h->name, entries);
+		return -ENOSPC;
+	}
+
+	/*
+	 * The data of the keys of the old table is now freed by the new one.
+	 * Let the keys deleted so far be reclaimed with their data first.
+	 */
+	if (cur->dq != NULL) {
+		rte_rcu_qsbr_synchronize(rs->rcu_cfg.v, RTE_QSBR_THRID_INVALID);
+		rte_rcu_qsbr_dq_reclaim(cur->dq, ~0, NULL, &pending, NULL);
+	}
+	cur->migrating = 1;
+
+	rs->cursor = 0;
+	rs->nb_dup = 0;
+	/* readers see the new current table with the old one set */
+	rte_atomic_store_explicit(&rs->old, cur, rte_memory_order_release);
+	rte_atomic_store_explicit(&rs->cur, t, rte_memory_order_release);
+
+	HASH_LOG(DEBUG, "Resizing hash %s to %u entries", h->name, entries);
+
+	return 0;
+}
+
+static inline int32_t
+hash_resize_add_cur(const struct rte_hash *h, const void *key, hash_sig_t sig,
+		void *data)
+{
+	struct rte_hash_resize *rs = h->resize;
+	struct rte_hash *cur = rs->cur;
+	struct rte_hash *old = rs->old;
+	bool dup;
+	int32_t ret;
+
+	dup = old != NULL && rte_hash_lookup_with_hash(old, key, sig) >= 0 &&
+		rte_hash_lookup_with_hash(cur, key, sig) < 0;
+
+	ret = __rte_hash_add_key_with_hash(cur, key, sig, data);
+	if (ret >= 0 && dup)
+		rs->nb_dup++;
+
+	return ret;
+}
+
+static int32_t
+hash_resize_add(const struct rte_hash *h, const void *key, hash_sig_t sig,
+		void *data)
+{
+	int32_t ret;
+
+	ret = hash_resize_add_cur(h, key, sig, data);
+	if (ret == -ENOSPC && hash_resize_grow(h) == 0)
+		ret = hash_resize_add_cur(h, key, sig, data);
+
+	if (h->resize->old != NULL)
+		hash_resize_migrate(h, RTE_HASH_RESIZE_MIGRATE_STEP);
+
+	return ret;
+}
+
+static int32_t
+hash_resize_del(const struct rte_hash *h, const void *key, hash_sig_t sig)
+{
+	struct rte_hash_resize *rs = h->resize;
+	struct rte_hash *cur = rs->cur;
+	struct rte_hash *old = rs->old;
+	void *data;
+	int32_t ret;
+
+	if (old != NULL && rte_hash_lookup_with_hash_data(old, key, sig, &data) >= 0) {
+		/* the data is freed by the current table, add the key to it */
+		if (rte_hash_lookup_with_hash(cur, key, sig) >= 0)
+			rs->nb_dup--;
+		else if (__rte_hash_add_key_with_hash(cur, key, sig, data) < 0)
+			HASH_LOG(ERR, "%s: cannot free the data of a deleted key",
+				__func__);
+		rte_hash_del_key_with_hash(old, key, sig);
+	}
+	ret = rte_hash_del_key_with_hash(cur, key, sig);
+
+	if (rs->old != NULL)
+		hash_resize_migrate(h, RTE_HASH_RESIZE_MIGRATE_STEP);
+
+	return ret;
+}
+
+static int32_t
+hash_resize_lookup(const struct rte_hash *h, const void *key, hash_sig_t sig,
+		void **data)
+{
+	struct rte_hash_resize *rs = h->resize;
+	struct rte_hash *cur, *old;
+	int32_t ret;
+
+	/* the old table is set before the current one is replaced */
+	cur = rte_atomic_load_explicit(&rs->cur, rte_memory_order_acquire);
+	old = rte_atomic_load_explicit(&rs->old, rte_memory_order_acquire);
+
+	ret = rte_hash_lookup_with_hash_data(cur, key, sig, data);
+	if (ret == -ENOENT && old != NULL) {
+		ret = rte_hash_lookup_with_hash_data(old, key, sig, data);
+		if (ret >= 0)
+			ret |= RTE_HASH_RESIZE_POS_OLD;
+	}
+
+	return ret;
+}
+
+static int32_t
+hash_resize_iterate(const struct rte_hash *h, const void **key, void **data,
+		uint32_t *next)
+{
+	struct rte_hash_resize *rs = h->resize;
+	struct rte_hash *cur = rs->cur;
+	struct rte_hash *old = rs->old;
+	uint32_t old_next;
+	int32_t ret;
+
+	if ((*next & RTE_HASH_RESIZE_ITER_OLD) == 0) {
+		ret = rte_hash_iterate(cur, key, data, next);
+		if (ret != -ENOENT || old == NULL)
+			return ret;
+		*next = RTE_HASH_RESIZE_ITER_OLD;
+	}
+	if (old == NULL)
+		return -ENOENT;
+
+	/* keys of the old table not yet in the current one */
+	do {
+		old_next = *next & ~RTE_HASH_RESIZE_ITER_OLD;
+		ret = rte_hash_iterate(old, key, data, &old_next);
+		*next = old_next | RTE_HASH_RESIZE_ITER_OLD;
+	} while (ret >= 0 && rte_hash_lookup(cur, *key) >= 0);
+
+	if (ret >= 0)
+		ret |= RTE_HASH_RESIZE_POS_OLD;
+
+	return ret;
+}
+
 RTE_EXPORT_SYMBOL(rte_hash_add_key_with_hash)
 int32_t
 rte_hash_add_key_with_hash(const struct rte_hash *h,
 			const void *key, hash_sig_t sig)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
+	if (unlikely(h->resize != NULL))
+		return hash_resize_add(h, key, sig, 0);
 	return __rte_hash_add_key_with_hash(h, key, sig, 0);
 }
 
@@ -1283,6 +1899,8 @@ int32_t
 rte_hash_add_key(const struct rte_hash *h, const void *key)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
+	if (unlikely(h->resize != NULL))
+		return hash_resize_add(h, key, rte_hash_hash(h, key), 0);
 	return __rte_hash_add_key_with_hash(h, key, rte_hash_hash(h, key), 0);
 }
 
@@ -1294,7 +1912,10 @@ rte_hash_add_key_with_hash_data(const struct rte_hash *h,
 	int ret;
 
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
-	ret = __rte_hash_add_key_with_hash(h, key, sig, data);
+	if (unlikely(h->resize != NULL))
+		ret = hash_resize_add(h, key, sig, data);
+	else
+		ret = __rte_hash_add_key_with_hash(h, key, sig, data);
 	if (ret >= 0)
 		return 0;
 	else
@@ -1309,7 +1930,10 @@ rte_hash_add_key_data(const struct rte_hash *h, const void *key, void *data)
 
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
 
-	ret = __rte_hash_add_key_with_hash(h, key, rte_hash_hash(h, key), data);
+	if (unlikely(h->resize != NULL))
+		ret = hash_resize_add(h, key, rte_hash_hash(h, key), data);
+	else
+		ret = __rte_hash_add_key_with_hash(h, key, rte_hash_hash(h, key), data);
 	if (ret >= 0)
 		return 0;
 	else
@@ -1501,6 +2125,8 @@ rte_hash_lookup_with_hash(const struct rte_hash *h,
 			const void *key, hash_sig_t sig)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
+	if (unlikely(h->resize != NULL))
+		return hash_resize_lookup(h, key, sig, NULL);
 	return __rte_hash_lookup_with_hash(h, key, sig, NULL);
 }
 
@@ -1509,6 +2135,8 @@ int32_t
 rte_hash_lookup(const struct rte_hash *h, const void *key)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
+	if (unlikely(h->resize != NULL))
+		return hash_resize_lookup(h, key, rte_hash_hash(h, key), NULL);
 	return __rte_hash_lookup_with_hash(h, key, rte_hash_hash(h, key), NULL);
 }
 
@@ -1518,6 +2146,8 @@ rte_hash_lookup_with_hash_data(const struct rte_hash *h,
 			const void *key, hash_sig_t sig, void **data)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
+	if (unlikely(h->resize != NULL))
+		return hash_resize_lookup(h, key, sig, data);
 	return __rte_hash_lookup_with_hash(h, key, sig, data);
 }
 
@@ -1526,6 +2156,8 @@ int
 rte_hash_lookup_data(const struct rte_hash *h, const void *key, void **data)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
+	if (unlikely(h->resize != NULL))
+		return hash_resize_lookup(h, key, rte_hash_hash(h, key), data);
 	return __rte_hash_lookup_with_hash(h, key, rte_hash_hash(h, key), data);
 }
 
@@ -1571,7 +2203,8 @@ __hash_rcu_qsbr_free_resource(void *p, void *e, unsigned int n)
 	k = (struct rte_hash_key *) ((char *)keys +
 				rcu_dq_entry.key_idx * h->key_entry_size);
 	key_data = k->pdata;
-	if (h->hash_rcu_cfg->free_key_data_func)
+	/* the data of a migrating table is freed by the new table */
+	if (h->hash_rcu_cfg->free_key_data_func && !h->migrating)
 		h->hash_rcu_cfg->free_key_data_func(h->hash_rcu_cfg->key_data_ptr,
 						    key_data);
 
@@ -1611,6 +2244,12 @@ rte_hash_rcu_qsbr_add(struct rte_hash *h, struct rte_hash_rcu_config *cfg)
 		return 1;
 	}
 
+	if (h->resize != NULL) {
+		if (rte_hash_rcu_qsbr_add(h->resize->cur, cfg) != 0)
+			return 1;
+		h->resize->rcu_cfg = *cfg;
+	}
+
 	hash_rcu_cfg = rte_zmalloc(NULL, sizeof(struct rte_hash_rcu_config), 0);
 	if (hash_rcu_cfg == NULL) {
 		HASH_LOG(ERR, "memory allocation failed");
@@ -1674,6 +2313,14 @@ int rte_hash_rcu_qsbr_dq_reclaim(struct rte_hash *h, unsigned int *freed, unsign
 		return 1;
 	}
 
+	if (h->resize != NULL) {
+		if (h->resize->dq != NULL)
+			rte_rcu_qsbr_dq_reclaim(h->resize->dq,
+				RTE_HASH_RESIZE_DQ_SIZE, NULL, NULL, NULL);
+		return rte_hash_rcu_qsbr_dq_reclaim(h->resize->cur, freed,
+			pending, available);
+	}
+
 	ret = rte_rcu_qsbr_dq_reclaim(h->dq, h->hash_rcu_cfg->max_reclaim_size, freed, pending,
 				      available);
 	if (ret != 0) {
@@ -1893,6 +2540,8 @@ rte_hash_del_key_with_hash(const struct rte_hash *h,
 			const void *key, hash_sig_t sig)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
+	if (unlikely(h->resize != NULL))
+		return hash_resize_del(h, key, sig);
 	return __rte_hash_del_key_with_hash(h, key, sig);
 }
 
@@ -1901,9 +2550,47 @@ int32_t
 rte_hash_del_key(const struct rte_hash *h, const void *key)
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
+	if (unlikely(h->resize != NULL))
+		return hash_resize_del(h, key, rte_hash_hash(h, key));
 	return __rte_hash_del_key_with_hash(h, key, rte_hash_hash(h, key));
 }
 
+/* Table of a position returned by a resizable hash, NULL if retired. */
+static struct rte_hash *
+hash_resize_position_table(const struct rte_hash *h, int32_t *position)
+{
+	struct rte_hash_resize *rs = h->resize;
+
+	if ((*position & RTE_HASH_RESIZE_POS_OLD) == 0)
+		return rte_atomic_load_explicit(&rs->cur, rte_memory_order_acquire);
+
+	*position &= ~RTE_HASH_RESIZE_POS_OLD;
+	return rte_atomic_load_explicit(&rs->old, rte_memory_order_acquire);
+}
+
+static int
+hash_resize_get_key_with_position(const struct rte_hash *h, int32_t position,
+		void **key)
+{
+	struct rte_hash *t = hash_resize_position_table(h, &position);
+
+	if (t == NULL)
+		return -ENOENT;
+
+	return rte_hash_get_key_with_position(t, position, key);
+}
+
+static int
+hash_resize_free_key_with_position(const struct rte_hash *h, int32_t position)
+{
+	struct rte_hash *t = hash_resize_position_table(h, &position);
+
+	if (t == NULL)
+		return -EINVAL;
+
+	return rte_hash_free_key_with_position(t, position);
+}
+
 RTE_EXPORT_SYMBOL(rte_hash_get_key_with_position)
 int
 rte_hash_get_key_with_position(const struct rte_hash *h, const int32_t position,
@@ -1911,6 +2598,9 @@ rte_hash_get_key_with_position(const struct rte_hash *h, const int32_t position,
 {
 	RETURN_IF_TRUE(((h == NULL) || (key == NULL)), -EINVAL);
 
+	if (h->resize != NULL)
+		return hash_resize_get_key_with_position(h, position, key);
+
 	struct rte_hash_key *k, *keys = h->key_store;
 	k = (struct rte_hash_key *) ((char *) keys + (position + 1) *
 				     h->key_entry_size);
@@ -1935,6 +2625,9 @@ rte_hash_free_key_with_position(const struct rte_hash *h,
 
 	RETURN_IF_TRUE(((h == NULL) || (key_idx == EMPTY_SLOT)), -EINVAL);
 
+	if (h->resize != NULL)
+		return hash_resize_free_key_with_position(h, position);
+
 	const uint32_t total_entries = h->use_local_cache ?
 		h->entries + (RTE_MAX_LCORE - 1) * (LCORE_CACHE_SIZE - 1) + 1
 							: h->entries + 1;
@@ -1957,12 +2650,13 @@ rte_hash_free_key_with_position(const struct rte_hash *h,
 
 }
 
-static inline void
+static __rte_always_inline void
 __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 		const struct rte_hash_bucket **primary_bkt,
 		const struct rte_hash_bucket **secondary_bkt,
 		uint16_t *sig, int32_t num_keys, int32_t *positions,
-		uint64_t *hit_mask, void *data[])
+		uint64_t *hit_mask, void *data[],
+		const enum cmp_jump_table_case cmp_idx)
 {
 	uint64_t hits = 0;
 	int32_t i;
@@ -1976,10 +2670,17 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 	const int hitmask_padding = 1;
 	uint32_t prim_hitmask_buffer[RTE_HASH_LOOKUP_BULK_MAX] = {0};
 	uint32_t sec_hitmask_buffer[RTE_HASH_LOOKUP_BULK_MAX] = {0};
+	bool bulk_sig_cmp;
 #endif
 
 	__hash_rw_reader_lock(h);
 
+#if !DENSE_HASH_BULK_LOOKUP
+	bulk_sig_cmp = compare_signatures_sparse_bulk(prim_hitmask_buffer,
+			sec_hitmask_buffer, primary_bkt, secondary_bkt,
+			sig, num_keys, h->sig_cmp_fn);
+#endif
+
 	/* Compare signatures and prefetch key slot of first hit */
 	for (i = 0; i < num_keys; i++) {
 #if DENSE_HASH_BULK_LOOKUP
@@ -1991,9 +2692,10 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 		const unsigned int prim_hitmask = *(uint8_t *)(hitmask);
 		const unsigned int sec_hitmask = *((uint8_t *)(hitmask)+1);
 #else
-		compare_signatures_sparse(&prim_hitmask_buffer[i], &sec_hitmask_buffer[i],
-			primary_bkt[i], secondary_bkt[i],
-			sig[i], h->sig_cmp_fn);
+		if (!bulk_sig_cmp)
+			compare_signatures_sparse(&prim_hitmask_buffer[i], &sec_hitmask_buffer[i],
+				primary_bkt[i], secondary_bkt[i],
+				sig[i], h->sig_cmp_fn);
 		const unsigned int prim_hitmask = prim_hitmask_buffer[i];
 		const unsigned int sec_hitmask = sec_hitmask_buffer[i];
 #endif
@@ -2005,9 +2707,7 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 			uint32_t key_idx =
 				primary_bkt[i]->key_idx[first_hit];
 			const struct rte_hash_key *key_slot =
-				(const struct rte_hash_key *)(
-				(const char *)h->key_store +
-				key_idx * h->key_entry_size);
+				rte_hash_key_slot(h, key_idx, cmp_idx);
 			rte_prefetch0(key_slot);
 			continue;
 		}
@@ -2019,9 +2719,7 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 			uint32_t key_idx =
 				secondary_bkt[i]->key_idx[first_hit];
 			const struct rte_hash_key *key_slot =
-				(const struct rte_hash_key *)(
-				(const char *)h->key_store +
-				key_idx * h->key_entry_size);
+				rte_hash_key_slot(h, key_idx, cmp_idx);
 			rte_prefetch0(key_slot);
 		}
 	}
@@ -2044,17 +2742,16 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 			uint32_t key_idx =
 				primary_bkt[i]->key_idx[hit_index];
 			const struct rte_hash_key *key_slot =
-				(const struct rte_hash_key *)(
-				(const char *)h->key_store +
-				key_idx * h->key_entry_size);
+				rte_hash_key_slot(h, key_idx, cmp_idx);
 
 			/*
 			 * If key index is 0, do not compare key,
 			 * as it is checking the dummy slot
 			 */
 			if (!!key_idx &
-				!rte_hash_cmp_eq(
-					key_slot->key, keys[i], h)) {
+				!rte_hash_cmp_eq_key(
+					key_slot->key, keys[i], h,
+					cmp_idx)) {
 				if (data != NULL)
 					data[i] = key_slot->pdata;
 
@@ -2072,9 +2769,7 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 			uint32_t key_idx =
 				secondary_bkt[i]->key_idx[hit_index];
 			const struct rte_hash_key *key_slot =
-				(const struct rte_hash_key *)(
-				(const char *)h->key_store +
-				key_idx * h->key_entry_size);
+				rte_hash_key_slot(h, key_idx, cmp_idx);
 
 			/*
 			 * If key index is 0, do not compare key,
@@ -2082,8 +2777,9 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 			 */
 
 			if (!!key_idx &
-				!rte_hash_cmp_eq(
-					key_slot->key, keys[i], h)) {
+				!rte_hash_cmp_eq_key(
+					key_slot->key, keys[i], h,
+					cmp_idx)) {
 				if (data != NULL)
 					data[i] = key_slot->pdata;
 
@@ -2131,12 +2827,13 @@ __bulk_lookup_l(const struct rte_hash *h, const void **keys,
 		*hit_mask = hits;
 }
 
-static inline void
+static __rte_always_inline void
 __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 		const struct rte_hash_bucket **primary_bkt,
 		const struct rte_hash_bucket **secondary_bkt,
 		uint16_t *sig, int32_t num_keys, int32_t *positions,
-		uint64_t *hit_mask, void *data[])
+		uint64_t *hit_mask, void *data[],
+		const enum cmp_jump_table_case cmp_idx)
 {
 	uint64_t hits = 0;
 	int32_t i;
@@ -2153,6 +2850,7 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 	const int hitmask_padding = 1;
 	uint32_t prim_hitmask_buffer[RTE_HASH_LOOKUP_BULK_MAX] = {0};
 	uint32_t sec_hitmask_buffer[RTE_HASH_LOOKUP_BULK_MAX] = {0};
+	bool bulk_sig_cmp;
 #endif
 
 	for (i = 0; i < num_keys; i++)
@@ -2166,6 +2864,12 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 		cnt_b = rte_atomic_load_explicit(h->tbl_chng_cnt,
 					rte_memory_order_acquire);
 
+#if !DENSE_HASH_BULK_LOOKUP
+		bulk_sig_cmp = compare_signatures_sparse_bulk(prim_hitmask_buffer,
+				sec_hitmask_buffer, primary_bkt, secondary_bkt,
+				sig, num_keys, h->sig_cmp_fn);
+#endif
+
 		/* Compare signatures and prefetch key slot of first hit */
 		for (i = 0; i < num_keys; i++) {
 #if DENSE_HASH_BULK_LOOKUP
@@ -2177,9 +2881,11 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 			const unsigned int prim_hitmask = *(uint8_t *)(hitmask);
 			const unsigned int sec_hitmask = *((uint8_t *)(hitmask)+1);
 #else
-			compare_signatures_sparse(&prim_hitmask_buffer[i], &sec_hitmask_buffer[i],
-				primary_bkt[i], secondary_bkt[i],
-				sig[i], h->sig_cmp_fn);
+			if (!bulk_sig_cmp)
+				compare_signatures_sparse(&prim_hitmask_buffer[i],
+					&sec_hitmask_buffer[i],
+					primary_bkt[i], secondary_bkt[i],
+					sig[i], h->sig_cmp_fn);
 			const unsigned int prim_hitmask = prim_hitmask_buffer[i];
 			const unsigned int sec_hitmask = sec_hitmask_buffer[i];
 #endif
@@ -2191,9 +2897,7 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 				uint32_t key_idx =
 					primary_bkt[i]->key_idx[first_hit];
 				const struct rte_hash_key *key_slot =
-					(const struct rte_hash_key *)(
-					(const char *)h->key_store +
-					key_idx * h->key_entry_size);
+					rte_hash_key_slot(h, key_idx, cmp_idx);
 				rte_prefetch0(key_slot);
 				continue;
 			}
@@ -2205,9 +2909,7 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 				uint32_t key_idx =
 					secondary_bkt[i]->key_idx[first_hit];
 				const struct rte_hash_key *key_slot =
-					(const struct rte_hash_key *)(
-					(const char *)h->key_store +
-					key_idx * h->key_entry_size);
+					rte_hash_key_slot(h, key_idx, cmp_idx);
 				rte_prefetch0(key_slot);
 			}
 		}
@@ -2231,17 +2933,16 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 					&primary_bkt[i]->key_idx[hit_index],
 					rte_memory_order_acquire);
 				const struct rte_hash_key *key_slot =
-					(const struct rte_hash_key *)(
-					(const char *)h->key_store +
-					key_idx * h->key_entry_size);
+					rte_hash_key_slot(h, key_idx, cmp_idx);
 
 				/*
 				 * If key index is 0, do not compare key,
 				 * as it is checking the dummy slot
 				 */
 				if (!!key_idx &
-					!rte_hash_cmp_eq(
-						key_slot->key, keys[i], h)) {
+					!rte_hash_cmp_eq_key(
+						key_slot->key, keys[i], h,
+						cmp_idx)) {
 					if (data != NULL)
 						data[i] = rte_atomic_load_explicit(
 							&key_slot->pdata,
@@ -2263,9 +2964,7 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 					&secondary_bkt[i]->key_idx[hit_index],
 					rte_memory_order_acquire);
 				const struct rte_hash_key *key_slot =
-					(const struct rte_hash_key *)(
-					(const char *)h->key_store +
-					key_idx * h->key_entry_size);
+					rte_hash_key_slot(h, key_idx, cmp_idx);
 
 				/*
 				 * If key index is 0, do not compare key,
@@ -2273,8 +2972,9 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 				 */
 
 				if (!!key_idx &
-					!rte_hash_cmp_eq(
-						key_slot->key, keys[i], h)) {
+					!rte_hash_cmp_eq_key(
+						key_slot->key, keys[i], h,
+						cmp_idx)) {
 					if (data != NULL)
 						data[i] = rte_atomic_load_explicit(
 							&key_slot->pdata,
@@ -2339,6 +3039,86 @@ __bulk_lookup_lf(const struct rte_hash *h, const void **keys,
 		*hit_mask = hits;
 }
 
+/* Bulk lookup of the keys whose buckets are already found */
+typedef void (*bulk_lookup_t)(const struct rte_hash *h, const void **keys,
+		const struct rte_hash_bucket **primary_bkt,
+		const struct rte_hash_bucket **secondary_bkt,
+		uint16_t *sig, int32_t num_keys, int32_t *positions,
+		uint64_t *hit_mask, void *data[]);
+
+/*
+ * Generate the bulk lookup functions of a key compare case,
+ * with both locking modes.
+ */
+#define BULK_LOOKUP_GEN(name, cmp_idx) \
+static void \
+bulk_lookup_l_##name(const struct rte_hash *h, const void **keys, \
+		const struct rte_hash_bucket **primary_bkt, \
+		const struct rte_hash_bucket **secondary_bkt, \
+		uint16_t *sig, int32_t num_keys, int32_t *positions, \
+		uint64_t *hit_mask, void *data[]) \
+{ \
+	__bulk_lookup_l(h, keys, primary_bkt, secondary_bkt, sig, num_keys, \
+		positions, hit_mask, data, cmp_idx); \
+} \
+static void \
+bulk_lookup_lf_##name(const struct rte_hash *h, const void **keys, \
+		const struct rte_hash_bucket **primary_bkt, \
+		const struct rte_hash_bucket **secondary_bkt, \
+		uint16_t *sig, int32_t num_keys, int32_t *positions, \
+		uint64_t *hit_mask, void *data[]) \
+{ \
+	__bulk_lookup_lf(h, keys, primary_bkt, secondary_bkt, sig, num_keys, \
+		positions, hit_mask, data, cmp_idx); \
+}
+
+BULK_LOOKUP_GEN(generic, KEY_OTHER_BYTES)
+#if defined(RTE_ARCH_X86) || defined(RTE_ARCH_ARM64)
+BULK_LOOKUP_GEN(k16, KEY_16_BYTES)
+BULK_LOOKUP_GEN(k32, KEY_32_BYTES)
+BULK_LOOKUP_GEN(k48, KEY_48_BYTES)
+BULK_LOOKUP_GEN(k64, KEY_64_BYTES)
+BULK_LOOKUP_GEN(k80, KEY_80_BYTES)
+BULK_LOOKUP_GEN(k96, KEY_96_BYTES)
+BULK_LOOKUP_GEN(k112, KEY_112_BYTES)
+BULK_LOOKUP_GEN(k128, KEY_128_BYTES)
+#endif
+
+/*
+ * Bulk lookup functions of each key compare case,
+ * so that the compare of the fixed size keys is inlined.
+ * Selected by cmp_jump_table_idx (multi-process supported).
+ */
+static const bulk_lookup_t bulk_lookup_l_table[NUM_KEY_CMP_CASES] = {
+	[KEY_CUSTOM] = bulk_lookup_l_generic,
+#if defined(RTE_ARCH_X86) || defined(RTE_ARCH_ARM64)
+	[KEY_16_BYTES] = bulk_lookup_l_k16,
+	[KEY_32_BYTES] = bulk_lookup_l_k32,
+	[KEY_48_BYTES] = bulk_lookup_l_k48,
+	[KEY_64_BYTES] = bulk_lookup_l_k64,
+	[KEY_80_BYTES] = bulk_lookup_l_k80,
+	[KEY_96_BYTES] = bulk_lookup_l_k96,
+	[KEY_112_BYTES] = bulk_lookup_l_k112,
+	[KEY_128_BYTES] = bulk_lookup_l_k128,
+#endif
+	[KEY_OTHER_BYTES] = bulk_lookup_l_generic,
+};
+
+static const bulk_lookup_t bulk_lookup_lf_table[NUM_KEY_CMP_CASES] = {
+	[KEY_CUSTOM] = bulk_lookup_lf_generic,
+#if defined(RTE_ARCH_X86) || defined(RTE_ARCH_ARM64)
+	[KEY_16_BYTES] = bulk_lookup_lf_k16,
+	[KEY_32_BYTES] = bulk_lookup_lf_k32,
+	[KEY_48_BYTES] = bulk_lookup_lf_k48,
+	[KEY_64_BYTES] = bulk_lookup_lf_k64,
+	[KEY_80_BYTES] = bulk_lookup_lf_k80,
+	[KEY_96_BYTES] = bulk_lookup_lf_k96,
+	[KEY_112_BYTES] = bulk_lookup_lf_k112,
+	[KEY_128_BYTES] = bulk_lookup_lf_k128,
+#endif
+	[KEY_OTHER_BYTES] = bulk_lookup_lf_generic,
+};
+
 #define PREFETCH_OFFSET 4
 static inline void
 __bulk_lookup_prefetching_loop(const struct rte_hash *h,
@@ -2347,7 +3127,7 @@ __bulk_lookup_prefetching_loop(const struct rte_hash *h,
 	const struct rte_hash_bucket **primary_bkt,
 	const struct rte_hash_bucket **secondary_bkt)
 {
-	int32_t i;
+	int32_t i, j, n;
 	uint32_t prim_hash[RTE_HASH_LOOKUP_BULK_MAX];
 	uint32_t prim_index[RTE_HASH_LOOKUP_BULK_MAX];
 	uint32_t sec_index[RTE_HASH_LOOKUP_BULK_MAX];
@@ -2356,6 +3136,37 @@ __bulk_lookup_prefetching_loop(const struct rte_hash *h,
 	for (i = 0; i < PREFETCH_OFFSET && i < num_keys; i++)
 		rte_prefetch0(keys[i]);
 
+	if (h->hash_func_crc) {
+		/*
+		 * Hash RTE_HASH_CRC_STREAMS keys together while prefetching
+		 * the next ones, calculate primary and secondary bucket
+		 * and prefetch them
+		 */
+		for (i = 0; i < num_keys; i += n) {
+			n = RTE_MIN(num_keys - i, RTE_HASH_CRC_STREAMS);
+			for (j = i + PREFETCH_OFFSET;
+					j < i + n + PREFETCH_OFFSET && j < num_keys; j++)
+				rte_prefetch0(keys[j]);
+
+			rte_hash_crc_bulk(&keys[i], h->key_len,
+				h->hash_func_init_val, &prim_hash[i], n);
+
+			for (j = i; j < i + n; j++) {
+				sig[j] = get_short_sig(prim_hash[j]);
+				prim_index[j] = get_prim_bucket_index(h, prim_hash[j]);
+				sec_index[j] = get_alt_bucket_index(h, prim_index[j],
+					sig[j]);
+
+				primary_bkt[j] = &h->buckets[prim_index[j]];
+				secondary_bkt[j] = &h->buckets[sec_index[j]];
+
+				rte_prefetch0(primary_bkt[j]);
+				rte_prefetch0(secondary_bkt[j]);
+			}
+		}
+		return;
+	}
+
 	/*
 	 * Prefetch rest of the keys, calculate primary and
 	 * secondary bucket and prefetch them
@@ -2405,8 +3216,8 @@ __rte_hash_lookup_bulk_l(const struct rte_hash *h, const void **keys,
 	__bulk_lookup_prefetching_loop(h, keys, num_keys, sig,
 		primary_bkt, secondary_bkt);
 
-	__bulk_lookup_l(h, keys, primary_bkt, secondary_bkt, sig, num_keys,
-		positions, hit_mask, data);
+	bulk_lookup_l_table[h->cmp_jump_table_idx](h, keys, primary_bkt,
+		secondary_bkt, sig, num_keys, positions, hit_mask, data);
 }
 
 static inline void
@@ -2421,8 +3232,8 @@ __rte_hash_lookup_bulk_lf(const struct rte_hash *h, const void **keys,
 	__bulk_lookup_prefetching_loop(h, keys, num_keys, sig,
 		primary_bkt, secondary_bkt);
 
-	__bulk_lookup_lf(h, keys, primary_bkt, secondary_bkt, sig, num_keys,
-		positions, hit_mask, data);
+	bulk_lookup_lf_table[h->cmp_jump_table_idx](h, keys, primary_bkt,
+		secondary_bkt, sig, num_keys, positions, hit_mask, data);
 }
 
 static inline void
@@ -2438,6 +3249,11 @@ __rte_hash_lookup_bulk(const struct rte_hash *h, const void **keys,
 					 hit_mask, data);
 }
 
+static void
+hash_resize_lookup_bulk(const struct rte_hash *h, const void **keys,
+			hash_sig_t *prim_hash, int32_t num_keys,
+			int32_t *positions, uint64_t *hit_mask, void *data[]);
+
 RTE_EXPORT_SYMBOL(rte_hash_lookup_bulk)
 int
 rte_hash_lookup_bulk(const struct rte_hash *h, const void **keys,
@@ -2447,7 +3263,11 @@ rte_hash_lookup_bulk(const struct rte_hash *h, const void **keys,
 			(num_keys > RTE_HASH_LOOKUP_BULK_MAX) ||
 			(positions == NULL)), -EINVAL);
 
-	__rte_hash_lookup_bulk(h, keys, num_keys, positions, NULL, NULL);
+	if (unlikely(h->resize != NULL))
+		hash_resize_lookup_bulk(h, keys, NULL, num_keys, positions,
+				NULL, NULL);
+	else
+		__rte_hash_lookup_bulk(h, keys, num_keys, positions, NULL, NULL);
 	return 0;
 }
 
@@ -2462,7 +3282,11 @@ rte_hash_lookup_bulk_data(const struct rte_hash *h, const void **keys,
 
 	int32_t positions[RTE_HASH_LOOKUP_BULK_MAX];
 
-	__rte_hash_lookup_bulk(h, keys, num_keys, positions, hit_mask, data);
+	if (unlikely(h->resize != NULL))
+		hash_resize_lookup_bulk(h, keys, NULL, num_keys, positions,
+				hit_mask, data);
+	else
+		__rte_hash_lookup_bulk(h, keys, num_keys, positions, hit_mask, data);
 
 	/* Return number of hits */
 	return rte_popcount64(*hit_mask);
@@ -2500,8 +3324,8 @@ __rte_hash_lookup_with_hash_bulk_l(const struct rte_hash *h,
 		rte_prefetch0(secondary_bkt[i]);
 	}
 
-	__bulk_lookup_l(h, keys, primary_bkt, secondary_bkt, sig, num_keys,
-		positions, hit_mask, data);
+	bulk_lookup_l_table[h->cmp_jump_table_idx](h, keys, primary_bkt,
+		secondary_bkt, sig, num_keys, positions, hit_mask, data);
 }
 
 static inline void
@@ -2535,8 +3359,8 @@ __rte_hash_lookup_with_hash_bulk_lf(const struct rte_hash *h,
 		rte_prefetch0(secondary_bkt[i]);
 	}
 
-	__bulk_lookup_lf(h, keys, primary_bkt, secondary_bkt, sig, num_keys,
-		positions, hit_mask, data);
+	bulk_lookup_lf_table[h->cmp_jump_table_idx](h, keys, primary_bkt,
+		secondary_bkt, sig, num_keys, positions, hit_mask, data);
 }
 
 static inline void
@@ -2552,6 +3376,72 @@ __rte_hash_lookup_with_hash_bulk(const struct rte_hash *h, const void **keys,
 				num_keys, positions, hit_mask, data);
 }
 
+static inline void
+hash_resize_lookup_bulk_table(const struct rte_hash *t, const void **keys,
+			hash_sig_t *prim_hash, int32_t num_keys,
+			int32_t *positions, uint64_t *hit_mask, void *data[])
+{
+	if (prim_hash != NULL)
+		__rte_hash_lookup_with_hash_bulk(t, keys, prim_hash, num_keys,
+				positions, hit_mask, data);
+	else
+		__rte_hash_lookup_bulk(t, keys, num_keys, positions,
+				hit_mask, data);
+}
+
+/* Look up the current table, then the old one for the missed keys. */
+static void
+hash_resize_lookup_bulk(const struct rte_hash *h, const void **keys,
+			hash_sig_t *prim_hash, int32_t num_keys,
+			int32_t *positions, uint64_t *hit_mask, void *data[])
+{
+	struct rte_hash_resize *rs = h->resize;
+	const void *miss_keys[RTE_HASH_LOOKUP_BULK_MAX];
+	hash_sig_t miss_hash[RTE_HASH_LOOKUP_BULK_MAX];
+	int32_t miss_positions[RTE_HASH_LOOKUP_BULK_MAX];
+	void *miss_data[RTE_HASH_LOOKUP_BULK_MAX];
+	int32_t miss_idx[RTE_HASH_LOOKUP_BULK_MAX];
+	uint64_t hits, miss_hits;
+	struct rte_hash *cur, *old;
+	int32_t i, nb_miss;
+
+	cur = rte_atomic_load_explicit(&rs->cur, rte_memory_order_acquire);
+	old = rte_atomic_load_explicit(&rs->old, rte_memory_order_acquire);
+
+	hash_resize_lookup_bulk_table(cur, keys, prim_hash, num_keys,
+			positions, &hits, data);
+
+	if (old != NULL && hits != (UINT64_MAX >> (64 - num_keys))) {
+		nb_miss = 0;
+		for (i = 0; i < num_keys; i++) {
+			if ((hits & RTE_BIT64(i)) != 0)
+				continue;
+			miss_keys[nb_miss] = keys[i];
+			if (prim_hash != NULL)
+				miss_hash[nb_miss] = prim_hash[i];
+			miss_idx[nb_miss++] = i;
+		}
+
+		hash_resize_lookup_bulk_table(old, miss_keys,
+				prim_hash != NULL ? miss_hash : NULL, nb_miss,
+				miss_positions, &miss_hits,
+				data != NULL ? miss_data : NULL);
+
+		for (i = 0; i < nb_miss; i++) {
+			positions[miss_idx[i]] = miss_positions[i];
+			if ((miss_hits & RTE_BIT64(i)) == 0)
+				continue;
+			positions[miss_idx[i]] |= RTE_HASH_RESIZE_POS_OLD;
+			hits |= RTE_BIT64(miss_idx[i]);
+			if (data != NULL)
+				data[miss_idx[i]] = miss_data[i];
+		}
+	}
+
+	if (hit_mask != NULL)
+		*hit_mask = hits;
+}
+
 RTE_EXPORT_SYMBOL(rte_hash_lookup_with_hash_bulk)
 int
 rte_hash_lookup_with_hash_bulk(const struct rte_hash *h, const void **keys,
@@ -2562,8 +3452,12 @@ rte_hash_lookup_with_hash_bulk(const struct rte_hash *h, const void **keys,
 			(num_keys > RTE_HASH_LOOKUP_BULK_MAX) ||
 			(positions == NULL)), -EINVAL);
 
-	__rte_hash_lookup_with_hash_bulk(h, keys, sig, num_keys,
-		positions, NULL, NULL);
+	if (unlikely(h->resize != NULL))
+		hash_resize_lookup_bulk(h, keys, sig, num_keys, positions,
+				NULL, NULL);
+	else
+		__rte_hash_lookup_with_hash_bulk(h, keys, sig, num_keys,
+			positions, NULL, NULL);
 	return 0;
 }
 
@@ -2580,8 +3474,12 @@ rte_hash_lookup_with_hash_bulk_data(const struct rte_hash *h,
 
 	int32_t positions[RTE_HASH_LOOKUP_BULK_MAX];
 
-	__rte_hash_lookup_with_hash_bulk(h, keys, sig, num_keys,
-			positions, hit_mask, data);
+	if (unlikely(h->resize != NULL))
+		hash_resize_lookup_bulk(h, keys, sig, num_keys, positions,
+				hit_mask, data);
+	else
+		__rte_hash_lookup_with_hash_bulk(h, keys, sig, num_keys,
+				positions, hit_mask, data);
 
 	/* Return number of hits */
 	return rte_popcount64(*hit_mask);
@@ -2596,6 +3494,9 @@ rte_hash_iterate(const struct rte_hash *h, const void **key, void **data, uint32
 
 	RETURN_IF_TRUE(((h == NULL) || (next == NULL)), -EINVAL);
 
+	if (h->resize != NULL)
+		return hash_resize_iterate(h, key, data, next);
+
 	const uint32_t total_entries_main = h->num_buckets *
 							RTE_HASH_BUCKET_ENTRIES;
 	const uint32_t total_entries = total_entries_main << 1;
@@ -185,8 +185,22 @@ struct __rte_cache_aligned rte_hash {
 	/**< If read-write concurrency lock free support is enabled */
 	uint8_t writer_takes_lock;
 	/**< Indicates if the writer threads need to take lock */
+	uint8_t writer_add_lf;
+	/**< If writers add keys to free entries without taking the lock */
+	uint8_t migrating;
+	/**< If the keys are being migrated to a larger table of a resizable
+	 * hash, their data is then freed by the larger table.
+	 */
+	struct rte_hash_resize *resize;
+	/**< Resize state if the hash is resizable, the keys being then
+	 * stored in internal tables.
+	 */
 	rte_hash_function hash_func;    /**< Function used to calculate hash. */
 	uint32_t hash_func_init_val;    /**< Init value used by hash_func. */
+	uint8_t hash_func_crc;
+	/**< If hash_func is rte_hash_crc, bulk lookups then hash the keys
+	 * with rte_hash_crc_bulk().
+	 */
 	rte_hash_cmp_eq_t rte_hash_custom_cmp_eq;
 	/**< Custom function used to compare keys. */
 	enum cmp_jump_table_case cmp_jump_table_idx;
@@ -216,6 +230,23 @@ struct __rte_cache_aligned rte_hash {
 	/**< Indicates if the hash table changed from last read. */
 };
 
+/** Resize state of a resizable hash. */
+struct rte_hash_resize {
+	struct rte_hash_parameters params;
+	/**< Parameters of the internal tables. */
+	char name[RTE_HASH_NAMESIZE];   /**< Name of the last internal table. */
+	RTE_ATOMIC(struct rte_hash *) cur;
+	/**< Table of the added keys. */
+	RTE_ATOMIC(struct rte_hash *) old;
+	/**< Table being migrated to the current one, NULL if none. */
+	uint32_t cursor;                /**< Next position to migrate. */
+	uint32_t nb_dup;
+	/**< Number of keys both in the current and old tables. */
+	struct rte_hash_rcu_config rcu_cfg;
+	/**< RCU configuration of the internal tables, if rcu_cfg.v is set. */
+	struct rte_rcu_qsbr_dq *dq;     /**< Defer queue of the old tables. */
+};
+
 struct queue_node {
 	struct rte_hash_bucket *bkt; /* Current bucket on the bfs search */
 	uint32_t cur_bkt_idx;
@@ -0,0 +1,69 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdint.h>
+
+#include <rte_common.h>
+#include <rte_vect.h>
+
+#include "rte_cuckoo_hash_avx512.h"
+
+/* Sparse hitmask of one bucket, the first bit of every two bits is a match. */
+#define SPARSE_BUCKET_MASK 0x5555
+
+void
+compare_signatures_sparse_bulk_avx512(uint32_t *prim_hash_matches,
+		uint32_t *sec_hash_matches,
+		const void *const *prim_bkt,
+		const void *const *sec_bkt,
+		const uint16_t *sig, int32_t num_keys)
+{
+	__m512i bkt_sigs, key_sigs;
+	uint64_t matches;
+	int32_t i;
+
+	/*
+	 * Compare the 16 signatures of the primary and secondary buckets
+	 * of two keys at once, the 128-bit lanes being:
+	 * key i primary, key i secondary, key i+1 primary, key i+1 secondary.
+	 */
+	for (i = 0; i + 1 < num_keys; i += 2) {
+		bkt_sigs = _mm512_castsi128_si512(_mm_load_si128(
+			(__m128i const *)prim_bkt[i]));
+		bkt_sigs = _mm512_inserti32x4(bkt_sigs, _mm_load_si128(
+			(__m128i const *)sec_bkt[i]), 1);
+		bkt_sigs = _mm512_inserti32x4(bkt_sigs, _mm_load_si128(
+			(__m128i const *)prim_bkt[i + 1]), 2);
+		bkt_sigs = _mm512_inserti32x4(bkt_sigs, _mm_load_si128(
+			(__m128i const *)sec_bkt[i + 1]), 3);
+
+		key_sigs = _mm512_inserti64x4(
+			_mm512_castsi256_si512(_mm256_set1_epi16(sig[i])),
+			_mm256_set1_epi16(sig[i + 1]), 1);
+
+		/* expand the 16-bit lane mask into the sparse byte mask */
+		matches = _mm512_movepi8_mask(_mm512_movm_epi16(
+			_mm512_cmpeq_epi16_mask(bkt_sigs, key_sigs)));
+
+		prim_hash_matches[i] = matches & SPARSE_BUCKET_MASK;
+		sec_hash_matches[i] = (matches >> 16) & SPARSE_BUCKET_MASK;
+		prim_hash_matches[i + 1] = (matches >> 32) & SPARSE_BUCKET_MASK;
+		sec_hash_matches[i + 1] = (matches >> 48) & SPARSE_BUCKET_MASK;
+	}
+
+	/* last key of an odd number of keys */
+	if (i < num_keys) {
+		bkt_sigs = _mm512_castsi256_si512(_mm256_set_m128i(
+			_mm_load_si128((__m128i const *)sec_bkt[i]),
+			_mm_load_si128((__m128i const *)prim_bkt[i])));
+		key_sigs = _mm512_set1_epi16(sig[i]);
+
+		matches = _mm512_movepi8_mask(_mm512_movm_epi16(
+			_mm512_mask_cmpeq_epi16_mask(0xffff, bkt_sigs,
+				key_sigs)));
+
+		prim_hash_matches[i] = matches & SPARSE_BUCKET_MASK;
+		sec_hash_matches[i] = (matches >> 16) & SPARSE_BUCKET_MASK;
+	}
+}
@@ -0,0 +1,23 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef RTE_CUCKOO_HASH_AVX512_H
+#define RTE_CUCKOO_HASH_AVX512_H
+
+#include <stdint.h>
+
+/*
+ * Compare the signatures of the primary and secondary buckets of num_keys
+ * keys, filling the sparse hitmasks of the x86 bulk lookup.
+ * The buckets are passed as opaque pointers, as rte_cuckoo_hash.h
+ * defines the key compare table; their signatures are at the start.
+ */
+void
+compare_signatures_sparse_bulk_avx512(uint32_t *prim_hash_matches,
+		uint32_t *sec_hash_matches,
+		const void *const *prim_bkt,
+		const void *const *sec_bkt,
+		const uint16_t *sig, int32_t num_keys);
+
+#endif /* RTE_CUCKOO_HASH_AVX512_H */
@@ -56,6 +56,40 @@ extern "C" {
  */
 #define RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF 0x20
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this flag may change without prior notice.
+ *
+ * Flag to make the hash table resizable.
+ * When a key cannot be added, the keys are stored in a new table twice as
+ * large, and the keys of the previous table are migrated to it a few at a time
+ * by the next add and delete calls, while lookups check both tables.
+ * The previous table is freed once all its keys are migrated, after the RCU
+ * grace period when RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF is enabled:
+ * the hash is then only resized once rte_hash_rcu_qsbr_add() is called.
+ * Key positions are those of the table storing the key, which change when
+ * the key is migrated. The positions of the keys not migrated yet have bit 30
+ * set, and are valid for rte_hash_get_key_with_position() until the previous
+ * table is freed. The number of entries is limited to RTE_HASH_ENTRIES_MAX / 2.
+ * Not supported with RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD,
+ * RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD_LF, RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY
+ * nor RTE_HASH_EXTRA_FLAGS_NO_FREE_ON_DEL.
+ */
+#define RTE_HASH_EXTRA_FLAGS_RESIZABLE 0x40
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this flag may change without prior notice.
+ *
+ * Flag to support concurrent adds by multiple writers without serializing
+ * them on the table lock. A key is added to an empty entry of its buckets
+ * with a compare-and-swap, under a lock of its primary bucket only.
+ * The writers take the table lock when keys must be moved to make room,
+ * or when the extendable buckets are used, as well as to delete keys.
+ * Requires RTE_HASH_EXTRA_FLAGS_RW_CONCURRENCY_LF.
+ */
+#define RTE_HASH_EXTRA_FLAGS_MULTI_WRITER_ADD_LF 0x80
+
 /**
  * The type of hash value of a key.
  * It should be a value of at least 32bit with fully random pattern.
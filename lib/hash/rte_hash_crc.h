@@ -15,6 +15,7 @@
 
 #include <rte_branch_prediction.h>
 #include <rte_common.h>
+#include <rte_compat.h>
 #include <rte_config.h>
 
 #include "rte_crc_sw.h"
@@ -148,6 +149,63 @@ rte_hash_crc(const void *data, uint32_t data_len, uint32_t init_val)
 	return init_val;
 }
 
+/** Number of byte arrays hashed together by rte_hash_crc_bulk(). */
+#define RTE_HASH_CRC_STREAMS 4
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Calculate CRC32 hash on several user-supplied byte arrays of the same length.
+ *
+ * The result for each array is the same as with rte_hash_crc(),
+ * but the arrays are hashed RTE_HASH_CRC_STREAMS at a time,
+ * interleaving the CRC32 instructions of independent arrays
+ * so that their latencies overlap, instead of waiting for each other.
+ *
+ * @param data
+ *   Array of num pointers to the data to perform hash on.
+ * @param data_len
+ *   How many bytes of each array to use to calculate hash value.
+ * @param init_val
+ *   Value to initialise hash generator.
+ * @param hash
+ *   Array of num 32bit calculated hash values.
+ * @param num
+ *   Number of byte arrays.
+ */
+__rte_experimental
+static inline void
+rte_hash_crc_bulk(const void * const data[], uint32_t data_len,
+		uint32_t init_val, uint32_t hash[], uint32_t num)
+{
+	uint64_t words[RTE_HASH_CRC_STREAMS];
+	uint32_t crc[RTE_HASH_CRC_STREAMS];
+	uint32_t i, j, off;
+
+	RTE_BUILD_BUG_ON(RTE_HASH_CRC_STREAMS != 4);
+
+	for (i = 0; i + RTE_HASH_CRC_STREAMS <= num; i += RTE_HASH_CRC_STREAMS) {
+		for (j = 0; j < RTE_HASH_CRC_STREAMS; j++)
+			crc[j] = init_val;
+
+		for (off = 0; off + 8 <= data_len; off += 8) {
+			for (j = 0; j < RTE_HASH_CRC_STREAMS; j++)
+				words[j] = *(const uint64_t *)
+					((uintptr_t)data[i + j] + off);
+			crc32c_8byte_x4(words, crc);
+		}
+
+		for (j = 0; j < RTE_HASH_CRC_STREAMS; j++)
+			hash[i + j] = rte_hash_crc(
+				(const void *)((uintptr_t)data[i + j] + off),
+				data_len - off, crc[j]);
+	}
+
+	for (; i < num; i++)
+		hash[i] = rte_hash_crc(data[i], data_len, init_val);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,266 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdalign.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <eal_export.h>
+#include <rte_errno.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_log.h>
+#include <rte_malloc.h>
+#include <rte_thash.h>
+
+#include "rte_thash_rss.h"
+
+RTE_LOG_REGISTER_SUFFIX(thash_rss_logtype, thash.rss, INFO);
+#define RTE_LOGTYPE_HASH thash_rss_logtype
+#define HASH_LOG(level, ...) \
+	RTE_LOG_LINE(level, HASH, "" __VA_ARGS__)
+
+/* Longest tuple: IPv6 addresses and ports */
+#define THASH_RSS_TUPLE_LEN	(2 * sizeof(struct rte_ipv6_addr) + 2 * sizeof(uint16_t))
+/* Number of packets hashed together */
+#define THASH_RSS_BURST		32
+
+struct rte_thash_rss {
+	alignas(RTE_CACHE_LINE_SIZE) uint64_t matrices[RTE_THASH_KEY_LEN_MAX];
+	/**< matrices used with rte_thash_gfni_bulk(), if supported */
+	uint32_t	key_be[RTE_THASH_KEY_LEN_MAX / sizeof(uint32_t)];
+	/**< key converted for rte_softrss_be() */
+	bool		gfni;
+	uint32_t	flags;
+	uint32_t	reta_mask;
+	uint16_t	nb_queues;
+	uint16_t	reta[];
+};
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_thash_rss_create, 26.03)
+struct rte_thash_rss *
+rte_thash_rss_create(const struct rte_thash_rss_conf *conf)
+{
+	struct rte_thash_rss *rss;
+
+	if (conf == NULL || conf->key == NULL || conf->reta == NULL ||
+			conf->key_len < RTE_THASH_RSS_KEY_LEN_MIN ||
+			conf->key_len > RTE_THASH_KEY_LEN_MAX ||
+			conf->key_len % sizeof(uint32_t) != 0 ||
+			!rte_is_power_of_2(conf->reta_size) ||
+			conf->reta_size > (1U << RTE_THASH_RETA_SZ_MAX) ||
+			conf->nb_queues == 0 ||
+			(conf->flags & ~RTE_THASH_RSS_F_L4) != 0) {
+		HASH_LOG(ERR, "Invalid software RSS configuration");
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	rss = rte_zmalloc_socket(NULL, sizeof(*rss) +
+			conf->reta_size * sizeof(rss->reta[0]),
+			RTE_CACHE_LINE_SIZE, conf->socket_id);
+	if (rss == NULL) {
+		HASH_LOG(ERR, "Cannot allocate software RSS context");
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	rss->flags = conf->flags;
+	rss->reta_mask = conf->reta_size - 1;
+	rss->nb_queues = conf->nb_queues;
+	if (rte_thash_rss_reta_update(rss, conf->reta) < 0) {
+		rte_free(rss);
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	rss->gfni = rte_thash_gfni_supported();
+	if (rss->gfni)
+		rte_thash_complete_matrix(rss->matrices, conf->key,
+			conf->key_len);
+	rte_convert_rss_key((const uint32_t *)conf->key, rss->key_be,
+		conf->key_len);
+
+	return rss;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_thash_rss_free, 26.03)
+void
+rte_thash_rss_free(struct rte_thash_rss *rss)
+{
+	rte_free(rss);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_thash_rss_reta_update, 26.03)
+int
+rte_thash_rss_reta_update(struct rte_thash_rss *rss, const uint16_t *reta)
+{
+	uint32_t i;
+
+	if (rss == NULL || reta == NULL)
+		return -EINVAL;
+
+	for (i = 0; i <= rss->reta_mask; i++) {
+		if (reta[i] >= rss->nb_queues) {
+			HASH_LOG(ERR, "Invalid queue %u in RETA entry %u",
+				reta[i], i);
+			return -EINVAL;
+		}
+	}
+	memcpy(rss->reta, reta, (rss->reta_mask + 1) * sizeof(rss->reta[0]));
+
+	return 0;
+}
+
+/*
+ * Copy the tuple of a packet in network byte order,
+ * returning its length, or 0 for a packet which is not IP.
+ */
+static inline uint32_t
+thash_rss_tuple_get(const struct rte_mbuf *m, uint8_t *tuple, bool l4)
+{
+	const struct rte_ether_hdr *eth;
+	const struct rte_vlan_hdr *vlan;
+	const struct rte_ipv4_hdr *ipv4;
+	const struct rte_ipv6_hdr *ipv6;
+	uint32_t off = sizeof(*eth);
+	uint32_t len, l4_off;
+	uint16_t type;
+	uint8_t proto;
+
+	if (unlikely(m->data_len < off))
+		return 0;
+	eth = rte_pktmbuf_mtod(m, const struct rte_ether_hdr *);
+	type = eth->ether_type;
+
+	while (type == RTE_BE16(RTE_ETHER_TYPE_VLAN) ||
+			type == RTE_BE16(RTE_ETHER_TYPE_QINQ)) {
+		if (unlikely(m->data_len < off + sizeof(*vlan)))
+			return 0;
+		vlan = rte_pktmbuf_mtod_offset(m, const struct rte_vlan_hdr *,
+			off);
+		type = vlan->eth_proto;
+		off += sizeof(*vlan);
+	}
+
+	if (type == RTE_BE16(RTE_ETHER_TYPE_IPV4)) {
+		if (unlikely(m->data_len < off + sizeof(*ipv4)))
+			return 0;
+		ipv4 = rte_pktmbuf_mtod_offset(m, const struct rte_ipv4_hdr *,
+			off);
+		memcpy(tuple, &ipv4->src_addr, 2 * sizeof(ipv4->src_addr));
+		len = 2 * sizeof(ipv4->src_addr);
+		if (!l4 || (ipv4->fragment_offset & RTE_BE16(RTE_IPV4_HDR_MF_FLAG |
+				RTE_IPV4_HDR_OFFSET_MASK)) != 0)
+			return len;
+		proto = ipv4->next_proto_id;
+		l4_off = off + rte_ipv4_hdr_len(ipv4);
+	} else if (type == RTE_BE16(RTE_ETHER_TYPE_IPV6)) {
+		if (unlikely(m->data_len < off + sizeof(*ipv6)))
+			return 0;
+		ipv6 = rte_pktmbuf_mtod_offset(m, const struct rte_ipv6_hdr *,
+			off);
+		memcpy(tuple, &ipv6->src_addr, 2 * sizeof(ipv6->src_addr));
+		len = 2 * sizeof(ipv6->src_addr);
+		if (!l4)
+			return len;
+		proto = ipv6->proto;
+		l4_off = off + sizeof(*ipv6);
+	} else {
+		return 0;
+	}
+
+	/* source and destination ports start both TCP and UDP headers */
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+			likely(m->data_len >= l4_off + 2 * sizeof(uint16_t))) {
+		memcpy(tuple + len, rte_pktmbuf_mtod_offset(m, const uint8_t *,
+			l4_off), 2 * sizeof(uint16_t));
+		len += 2 * sizeof(uint16_t);
+	}
+
+	return len;
+}
+
+/* Hash up to THASH_RSS_BURST packets */
+static inline void
+thash_rss_hash_burst(const struct rte_thash_rss *rss,
+	struct rte_mbuf **pkts, uint16_t nb_pkts, uint32_t hash[])
+{
+	alignas(sizeof(uint32_t)) uint8_t
+		tuples[THASH_RSS_BURST][THASH_RSS_TUPLE_LEN];
+	uint32_t tuple_len[THASH_RSS_BURST];
+	uint32_t words[THASH_RSS_TUPLE_LEN / sizeof(uint32_t)];
+	uint8_t *tuple_ptrs[THASH_RSS_BURST];
+	bool l4 = (rss->flags & RTE_THASH_RSS_F_L4) != 0;
+	uint32_t i, j, max_len = 0;
+
+	for (i = 0; i < nb_pkts; i++) {
+		/* a tuple padded with zeros keeps its Toeplitz hash */
+		memset(tuples[i], 0, THASH_RSS_TUPLE_LEN);
+		tuple_len[i] = thash_rss_tuple_get(pkts[i], tuples[i], l4);
+		tuple_ptrs[i] = tuples[i];
+		max_len = RTE_MAX(max_len, tuple_len[i]);
+	}
+
+	if (max_len == 0) {
+		memset(hash, 0, nb_pkts * sizeof(hash[0]));
+	} else if (rss->gfni) {
+		rte_thash_gfni_bulk(rss->matrices, max_len, tuple_ptrs, hash,
+			nb_pkts);
+	} else {
+		for (i = 0; i < nb_pkts; i++) {
+			for (j = 0; j < tuple_len[i] / sizeof(uint32_t); j++)
+				words[j] = rte_be_to_cpu_32(
+					((const uint32_t *)tuples[i])[j]);
+			hash[i] = rte_softrss_be(words,
+				tuple_len[i] / sizeof(uint32_t),
+				(const uint8_t *)rss->key_be);
+		}
+	}
+
+	for (i = 0; i < nb_pkts; i++) {
+		if (tuple_len[i] == 0) {
+			hash[i] = 0;
+			continue;
+		}
+		pkts[i]->hash.rss = hash[i];
+		pkts[i]->ol_flags |= RTE_MBUF_F_RX_RSS_HASH;
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_thash_rss_hash_bulk, 26.03)
+void
+rte_thash_rss_hash_bulk(const struct rte_thash_rss *rss,
+	struct rte_mbuf **pkts, uint16_t nb_pkts)
+{
+	uint32_t hash[THASH_RSS_BURST];
+	uint16_t i, n;
+
+	for (i = 0; i < nb_pkts; i += n) {
+		n = RTE_MIN(nb_pkts - i, THASH_RSS_BURST);
+		thash_rss_hash_burst(rss, &pkts[i], n, hash);
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_thash_rss_split, 26.03)
+void
+rte_thash_rss_split(const struct rte_thash_rss *rss,
+	struct rte_mbuf **pkts, uint16_t nb_pkts,
+	struct rte_mbuf **queue_pkts[], uint16_t nb_queue_pkts[])
+{
+	uint32_t hash[THASH_RSS_BURST];
+	uint16_t i, j, n, q;
+
+	memset(nb_queue_pkts, 0, rss->nb_queues * sizeof(nb_queue_pkts[0]));
+
+	for (i = 0; i < nb_pkts; i += n) {
+		n = RTE_MIN(nb_pkts - i, THASH_RSS_BURST);
+		thash_rss_hash_burst(rss, &pkts[i], n, hash);
+
+		for (j = 0; j < n; j++) {
+			q = rss->reta[hash[j] & rss->reta_mask];
+			queue_pkts[q][nb_queue_pkts[q]++] = pkts[i + j];
+		}
+	}
+}
@@ -0,0 +1,154 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_THASH_RSS_H_
+#define _RTE_THASH_RSS_H_
+
+/**
+ * @file
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * Software RSS, for ports without hardware RSS.
+ *
+ * Computes the Toeplitz hash of bursts of received packets,
+ * as a NIC would do with the same RSS key,
+ * and distributes them with a redirection table (RETA).
+ * The hash of the IPv4 and IPv6 packets covers the source and destination addresses,
+ * and optionally the source and destination ports of TCP and UDP.
+ * The hash of other packets is 0.
+ *
+ * The tuples of a burst are hashed together with rte_thash_gfni_bulk()
+ * when GFNI is supported, with rte_softrss_be() otherwise.
+ */
+
+#include <stdint.h>
+
+#include <rte_compat.h>
+#include <rte_mbuf.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Minimum length of the RSS key, hashing up to an IPv6 tuple with ports. */
+#define RTE_THASH_RSS_KEY_LEN_MIN	40
+
+/** Include the TCP and UDP ports in the hash, except for IP fragments. */
+#define RTE_THASH_RSS_F_L4	RTE_BIT32(0)
+
+/** Software RSS context. */
+struct rte_thash_rss;
+
+/** Software RSS context configuration. */
+struct rte_thash_rss_conf {
+	const uint8_t *key;
+	/**< RSS hash key. */
+	uint32_t key_len;
+	/**< Length of the key in bytes, multiple of 4,
+	 * from RTE_THASH_RSS_KEY_LEN_MIN to RTE_THASH_KEY_LEN_MAX.
+	 */
+	const uint16_t *reta;
+	/**< Redirection table, queue of each hash value modulo reta_size. */
+	uint32_t reta_size;
+	/**< Number of entries of the redirection table, power of 2 up to 65536. */
+	uint16_t nb_queues;
+	/**< Number of queues, each entry of the redirection table must be lower. */
+	uint32_t flags;
+	/**< RTE_THASH_RSS_F_* flags. */
+	int socket_id;
+	/**< Socket to allocate memory on. */
+};
+
+/**
+ * Create a software RSS context.
+ *
+ * @param conf
+ *   Context configuration.
+ *
+ * @return
+ *   - On success, pointer to the context.
+ *   - On failure, NULL, rte_errno being set.
+ */
+__rte_experimental
+struct rte_thash_rss *
+rte_thash_rss_create(const struct rte_thash_rss_conf *conf);
+
+/**
+ * Free a software RSS context.
+ *
+ * @param rss
+ *   Software RSS context, if NULL then the function does nothing.
+ */
+__rte_experimental
+void
+rte_thash_rss_free(struct rte_thash_rss *rss);
+
+/**
+ * Update the redirection table of a software RSS context.
+ *
+ * Not thread safe with the other functions using the context.
+ *
+ * @param rss
+ *   Software RSS context.
+ * @param reta
+ *   Redirection table, of the size given at creation.
+ *
+ * @return
+ *   0 on success, -EINVAL if an entry is not a valid queue.
+ */
+__rte_experimental
+int
+rte_thash_rss_reta_update(struct rte_thash_rss *rss, const uint16_t *reta);
+
+/**
+ * Compute the RSS hash of a burst of packets.
+ *
+ * The hash is stored in rte_mbuf::hash::rss,
+ * with RTE_MBUF_F_RX_RSS_HASH set for the IPv4 and IPv6 packets.
+ * The headers up to the ports must be in the first segment.
+ *
+ * @param rss
+ *   Software RSS context.
+ * @param pkts
+ *   Array of packets, starting with their Ethernet header.
+ * @param nb_pkts
+ *   Number of packets.
+ */
+__rte_experimental
+void
+rte_thash_rss_hash_bulk(const struct rte_thash_rss *rss,
+	struct rte_mbuf **pkts, uint16_t nb_pkts);
+
+/**
+ * Split a burst of packets into per queue arrays.
+ *
+ * Computes the RSS hash of the packets as rte_thash_rss_hash_bulk(),
+ * then appends each of them to the array of the queue given by the redirection table,
+ * keeping the order of the packets of each queue.
+ *
+ * @param rss
+ *   Software RSS context.
+ * @param pkts
+ *   Array of packets, starting with their Ethernet header.
+ * @param nb_pkts
+ *   Number of packets.
+ * @param queue_pkts
+ *   Array of nb_queues arrays, each with room for nb_pkts packets.
+ * @param nb_queue_pkts
+ *   Array of nb_queues counters, set to the number of packets of each queue.
+ */
+__rte_experimental
+void
+rte_thash_rss_split(const struct rte_thash_rss *rss,
+	struct rte_mbuf **pkts, uint16_t nb_pkts,
+	struct rte_mbuf **queue_pkts[], uint16_t nb_queue_pkts[]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_THASH_RSS_H_ */
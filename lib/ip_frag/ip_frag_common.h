@@ -5,6 +5,7 @@
 #ifndef _IP_FRAG_COMMON_H_
 #define _IP_FRAG_COMMON_H_
 
+#include <string.h>
 #include <sys/queue.h>
 
 #include <rte_common.h>
@@ -61,6 +62,12 @@ struct ip_frag_pkt * ip_frag_lookup(struct rte_ip_frag_tbl *tbl,
 	const struct ip_frag_key *key, uint64_t tms,
 	struct ip_frag_pkt **free, struct ip_frag_pkt **stale);
 
+void ip_frag_key_hash(const struct ip_frag_key *key, uint32_t *v1,
+	uint32_t *v2);
+
+void ip_frag_tbl_prefetch(const struct rte_ip_frag_tbl *tbl,
+	const struct ip_frag_key *key);
+
 /* these functions need to be declared here as ip_frag_process relies on them */
 struct rte_mbuf *ipv4_frag_reassemble(struct ip_frag_pkt *fp);
 struct rte_mbuf *ipv6_frag_reassemble(struct ip_frag_pkt *fp);
@@ -71,6 +78,27 @@ struct rte_mbuf *ipv6_frag_reassemble(struct ip_frag_pkt *fp);
  * misc frag key functions
  */
 
+/* fill the key of an IPv4 fragment */
+static inline void
+ipv4_frag_key_init(struct ip_frag_key *key, const struct rte_ipv4_hdr *ip_hdr)
+{
+	/* use first 8 bytes only */
+	memcpy(&key->src_dst[0], &ip_hdr->src_addr, 8);
+	key->id = ip_hdr->packet_id;
+	key->key_len = IPV4_KEYLEN;
+}
+
+/* fill the key of an IPv6 fragment */
+static inline void
+ipv6_frag_key_init(struct ip_frag_key *key, const struct rte_ipv6_hdr *ip_hdr,
+	const struct rte_ipv6_fragment_ext *frag_hdr)
+{
+	memcpy(&key->src_dst[0], &ip_hdr->src_addr, 16);
+	memcpy(&key->src_dst[2], &ip_hdr->dst_addr, 16);
+	key->id = frag_hdr->id;
+	key->key_len = IPV6_KEYLEN;
+}
+
 /* check if key is empty */
 static inline int
 ip_frag_key_is_empty(const struct ip_frag_key * key)
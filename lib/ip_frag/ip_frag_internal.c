@@ -6,6 +6,7 @@
 
 #include <rte_jhash.h>
 #include <rte_hash_crc.h>
+#include <rte_prefetch.h>
 
 #include "ip_frag_common.h"
 
@@ -87,6 +88,40 @@ ipv6_frag_hash(const struct ip_frag_key *key, uint32_t *v1, uint32_t *v2)
 	*v2 = (v << 7) + (v >> 14);
 }
 
+void
+ip_frag_key_hash(const struct ip_frag_key *key, uint32_t *v1, uint32_t *v2)
+{
+	/* different hashing methods for IPv4 and IPv6 */
+	if (key->key_len == IPV4_KEYLEN)
+		ipv4_frag_hash(key, v1, v2);
+	else
+		ipv6_frag_hash(key, v1, v2);
+}
+
+/*
+ * Prefetch the two buckets where the entry of a key can be,
+ * the key and timestamp of an entry being in its first cache line.
+ */
+void
+ip_frag_tbl_prefetch(const struct rte_ip_frag_tbl *tbl,
+	const struct ip_frag_key *key)
+{
+	const struct ip_frag_pkt *p1, *p2;
+	uint32_t i, sig1, sig2;
+
+	if (tbl->last != NULL && ip_frag_key_cmp(key, &tbl->last->key) == 0)
+		return;
+
+	ip_frag_key_hash(key, &sig1, &sig2);
+	p1 = IP_FRAG_TBL_POS(tbl, sig1);
+	p2 = IP_FRAG_TBL_POS(tbl, sig2);
+
+	for (i = 0; i != tbl->bucket_entries; i++) {
+		rte_prefetch0(p1 + i);
+		rte_prefetch0(p2 + i);
+	}
+}
+
 struct rte_mbuf *
 ip_frag_process(struct ip_frag_pkt *fp, struct rte_ip_frag_death_row *dr,
 	struct rte_mbuf *mb, uint16_t ofs, uint16_t len, uint16_t more_frags)
@@ -299,11 +334,7 @@ ip_frag_lookup(struct rte_ip_frag_tbl *tbl,
 	if (tbl->last != NULL && ip_frag_key_cmp(key, &tbl->last->key) == 0)
 		return tbl->last;
 
-	/* different hashing methods for IPv4 and IPv6 */
-	if (key->key_len == IPV4_KEYLEN)
-		ipv4_frag_hash(key, &sig1, &sig2);
-	else
-		ipv6_frag_hash(key, &sig1, &sig2);
+	ip_frag_key_hash(key, &sig1, &sig2);
 
 	p1 = IP_FRAG_TBL_POS(tbl, sig1);
 	p2 = IP_FRAG_TBL_POS(tbl, sig2);
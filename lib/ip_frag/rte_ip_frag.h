@@ -15,6 +15,7 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <rte_compat.h>
 #include <rte_config.h>
 #include <rte_malloc.h>
 #include <rte_memory.h>
@@ -26,6 +27,7 @@ extern "C" {
 #endif
 
 struct rte_mbuf;
+struct rte_ring;
 
 /** death row size (in packets) */
 #define RTE_IP_FRAG_DEATH_ROW_LEN 32
@@ -254,6 +256,73 @@ rte_ipv4_frag_pkt_is_fragmented(const struct rte_ipv4_hdr *hdr)
 	return ip_flag != 0 || ip_ofs  != 0;
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Reassemble a burst of packets, prefetching the fragment table entries
+ * of all the fragments before processing them.
+ * Incoming mbufs should have their l2_len/l3_len fields setup correctly.
+ * The packets which are not IPv4 or IPv6 fragments are passed through.
+ *
+ * The death row is freed when needed, so that it never overflows,
+ * whatever the number of packets.
+ *
+ * @param tbl
+ *   Table where to lookup/add the fragmented packets.
+ * @param dr
+ *   Death row to free buffers to.
+ * @param pkts
+ *   Array of incoming packets. On return, it contains the packets which are
+ *   not fragments and the reassembled packets, in the order of arrival.
+ * @param nb_pkts
+ *   Number of incoming packets.
+ * @param tms
+ *   Fragments arrival timestamp.
+ * @return
+ *   Number of packets returned in pkts.
+ */
+__rte_experimental
+uint16_t
+rte_ip_frag_reassemble_bulk(struct rte_ip_frag_tbl *tbl,
+		struct rte_ip_frag_death_row *dr, struct rte_mbuf **pkts,
+		uint16_t nb_pkts, uint64_t tms);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Steer the IP fragments to the lcores owning their reassembly.
+ *
+ * The fragments of a datagram carry no L4 ports, so RSS may spread them
+ * over several lcores, each reassembling in its own fragment table.
+ * The owner of each fragment is selected with a hash of its source address,
+ * destination address and IP ID, so that all the fragments of a datagram
+ * are reassembled by the same owner.
+ * Incoming mbufs should have their l2_len field setup correctly.
+ *
+ * @param rings
+ *   Ring of each owner, where the fragments it owns are enqueued.
+ *   The rings must be multi-producer if several lcores steer fragments.
+ * @param nb_rings
+ *   Number of owners.
+ * @param self
+ *   Index of the calling owner in rings, its ring is not used.
+ * @param pkts
+ *   Array of incoming packets. On return, it contains the packets
+ *   which are not fragments and the fragments owned by self,
+ *   in the order of arrival.
+ *   The fragments which cannot be enqueued to a full ring are freed.
+ * @param nb_pkts
+ *   Number of incoming packets.
+ * @return
+ *   Number of packets returned in pkts.
+ */
+__rte_experimental
+uint16_t
+rte_ip_frag_steer_bulk(struct rte_ring * const rings[], uint16_t nb_rings,
+		uint16_t self, struct rte_mbuf **pkts, uint16_t nb_pkts);
+
 /**
  * Free mbufs on a given death row.
  *
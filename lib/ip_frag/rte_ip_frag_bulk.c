@@ -0,0 +1,161 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stddef.h>
+
+#include <eal_export.h>
+#include <rte_mbuf.h>
+#include <rte_ring.h>
+
+#include "ip_frag_common.h"
+
+/* number of packets parsed and prefetched at once */
+#define	IP_FRAG_BULK_SZ	32
+
+/* death row room needed to process one fragment */
+#define	IP_FRAG_DR_ROOM	(2 * (RTE_LIBRTE_IP_FRAG_MAX_FRAG + 1))
+
+enum {
+	IP_FRAG_NONE,
+	IP_FRAG_IPV4,
+	IP_FRAG_IPV6,
+};
+
+/* parsed fragment */
+struct ip_frag_hdr {
+	void *ip_hdr;
+	struct rte_ipv6_fragment_ext *frag_hdr;
+	struct ip_frag_key key;
+	uint32_t type;
+};
+
+/* fill the key of a fragment, return the fragment type */
+static inline uint32_t
+ip_frag_parse(struct rte_mbuf *mb, struct ip_frag_hdr *fh)
+{
+	struct rte_ipv4_hdr *ipv4_hdr;
+	struct rte_ipv6_hdr *ipv6_hdr;
+
+	ipv4_hdr = rte_pktmbuf_mtod_offset(mb, struct rte_ipv4_hdr *,
+		mb->l2_len);
+	fh->ip_hdr = ipv4_hdr;
+
+	if ((ipv4_hdr->version_ihl >> 4) == 4) {
+		if (!rte_ipv4_frag_pkt_is_fragmented(ipv4_hdr))
+			return IP_FRAG_NONE;
+		ipv4_frag_key_init(&fh->key, ipv4_hdr);
+		return IP_FRAG_IPV4;
+	}
+
+	if ((ipv4_hdr->version_ihl >> 4) == 6) {
+		ipv6_hdr = fh->ip_hdr;
+		fh->frag_hdr = rte_ipv6_frag_get_ipv6_fragment_header(ipv6_hdr);
+		if (fh->frag_hdr == NULL)
+			return IP_FRAG_NONE;
+		ipv6_frag_key_init(&fh->key, ipv6_hdr, fh->frag_hdr);
+		return IP_FRAG_IPV6;
+	}
+
+	return IP_FRAG_NONE;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ip_frag_reassemble_bulk, 26.03)
+uint16_t
+rte_ip_frag_reassemble_bulk(struct rte_ip_frag_tbl *tbl,
+	struct rte_ip_frag_death_row *dr, struct rte_mbuf **pkts,
+	uint16_t nb_pkts, uint64_t tms)
+{
+	struct ip_frag_hdr fh[IP_FRAG_BULK_SZ];
+	struct rte_mbuf *mb;
+	uint16_t i, j, k, n;
+
+	k = 0;
+	for (i = 0; i < nb_pkts; i += n) {
+		n = RTE_MIN(nb_pkts - i, IP_FRAG_BULK_SZ);
+
+		/* look for the fragments and prefetch their table entries */
+		for (j = 0; j != n; j++) {
+			fh[j].type = ip_frag_parse(pkts[i + j], &fh[j]);
+			if (fh[j].type != IP_FRAG_NONE)
+				ip_frag_tbl_prefetch(tbl, &fh[j].key);
+		}
+
+		for (j = 0; j != n; j++) {
+			mb = pkts[i + j];
+
+			if (fh[j].type != IP_FRAG_NONE &&
+					dr->cnt + IP_FRAG_DR_ROOM >
+					RTE_IP_FRAG_DEATH_ROW_MBUF_LEN)
+				rte_ip_frag_free_death_row(dr, 0);
+
+			if (fh[j].type == IP_FRAG_IPV4)
+				mb = rte_ipv4_frag_reassemble_packet(tbl, dr,
+					mb, tms, fh[j].ip_hdr);
+			else if (fh[j].type == IP_FRAG_IPV6)
+				mb = rte_ipv6_frag_reassemble_packet(tbl, dr,
+					mb, tms, fh[j].ip_hdr, fh[j].frag_hdr);
+
+			if (mb != NULL)
+				pkts[k++] = mb;
+		}
+	}
+
+	return k;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ip_frag_steer_bulk, 26.03)
+uint16_t
+rte_ip_frag_steer_bulk(struct rte_ring * const rings[], uint16_t nb_rings,
+	uint16_t self, struct rte_mbuf **pkts, uint16_t nb_pkts)
+{
+	struct rte_mbuf *in[IP_FRAG_BULK_SZ], *out[IP_FRAG_BULK_SZ];
+	struct ip_frag_hdr fh;
+	uint16_t owner[IP_FRAG_BULK_SZ];
+	uint32_t sig1, sig2;
+	uint16_t i, j, k, m, n, o, nb_out;
+
+	k = 0;
+	for (i = 0; i < nb_pkts; i += n) {
+		n = RTE_MIN(nb_pkts - i, IP_FRAG_BULK_SZ);
+
+		/* select the owner of each packet */
+		nb_out = 0;
+		for (j = 0; j != n; j++) {
+			in[j] = pkts[i + j];
+			owner[j] = self;
+			if (ip_frag_parse(in[j], &fh) != IP_FRAG_NONE) {
+				ip_frag_key_hash(&fh.key, &sig1, &sig2);
+				owner[j] = ((uint64_t)sig1 * nb_rings) >> 32;
+			}
+			if (owner[j] == self)
+				pkts[k++] = in[j];
+			else
+				nb_out++;
+		}
+
+		/* enqueue the other fragments, one burst per owner */
+		while (nb_out != 0) {
+			o = self;
+			m = 0;
+			for (j = 0; j != n; j++) {
+				if (owner[j] == self)
+					continue;
+				if (o == self)
+					o = owner[j];
+				if (owner[j] == o) {
+					out[m++] = in[j];
+					owner[j] = self;
+				}
+			}
+			nb_out -= m;
+
+			j = rte_ring_enqueue_burst(rings[o], (void **)out, m,
+				NULL);
+			if (j != m)
+				rte_pktmbuf_free_bulk(out + j, m - j);
+		}
+	}
+
+	return k;
+}
@@ -265,7 +265,8 @@ inb_get_sqn(const struct rte_ipsec_sa *sa, const struct replay_sqn *rsn,
 	 */
 	sqn = rte_be_to_cpu_32(esph->seq);
 	if (IS_ESN(sa))
-		sqn = reconstruct_esn(rsn->sqn, sqn, sa->replay.win_sz);
+		sqn = reconstruct_esn(rsn_last_sqn(sa, rsn), sqn,
+			sa->replay.win_sz);
 	*sqc = rte_cpu_to_be_64(sqn);
 
 	/* check IPsec window */
@@ -702,6 +703,20 @@ esp_inb_rsn_update(struct rte_ipsec_sa *sa, const uint32_t sqn[],
 	if (sa->replay.win_sz == 0)
 		return num;
 
+	/* lock-free replay window, no copy */
+	if (SQN_MW(sa)) {
+		rsn = sa->sqn.inb.rsn[0];
+		k = 0;
+		for (i = 0; i != num; i++) {
+			if (esn_inb_mw_update_sqn(rsn, sa,
+					rte_be_to_cpu_32(sqn[i])) == 0)
+				k++;
+			else
+				dr[i - k] = i;
+		}
+		return k;
+	}
+
 	rsn = rsn_update_start(sa);
 
 	k = 0;
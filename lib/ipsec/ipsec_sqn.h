@@ -16,6 +16,20 @@
 #define IS_ESN(sa)	((sa)->sqn_mask == UINT64_MAX)
 
 #define	SQN_ATOMIC(sa)	((sa)->type & RTE_IPSEC_SATP_SQN_ATOM)
+#define	SQN_MW(sa)	((sa)->type & RTE_IPSEC_SATP_SQN_MW_ENABLE)
+
+/*
+ * Lock-free replay window (SQN_MW): each uint64_t bucket holds in its
+ * upper 32 bits the (truncated) index of the window bucket it currently
+ * represents, and in its lower 32 bits the bitmap of this bucket.
+ * A bucket is reset by the first packet of a newer window bucket mapped
+ * to it, so moving the window does not clear anything, and a tag newer
+ * than the one of a packet means that the packet is outside the window.
+ */
+#define WINDOW_MW_BUCKET_BITS		5 /* uint32_t */
+#define WINDOW_MW_BUCKET_SIZE		(1 << WINDOW_MW_BUCKET_BITS)
+#define WINDOW_MW_BIT_LOC_MASK		(WINDOW_MW_BUCKET_SIZE - 1)
+#define WINDOW_MW_TAG_SHIFT		32
 
 /*
  * gets SQN.hi32 bits, SQN supposed to be in network byte order.
@@ -80,6 +94,45 @@ reconstruct_esn(uint64_t t, uint32_t sqn, uint32_t w)
 	return (uint64_t)th << 32 | sqn;
 }
 
+/**
+ * Get the highest sequence number seen.
+ */
+static inline uint64_t
+rsn_last_sqn(const struct rte_ipsec_sa *sa, const struct replay_sqn *rsn)
+{
+	if (SQN_MW(sa))
+		return rte_atomic_load_explicit(
+			(const uint64_t __rte_atomic *)&rsn->sqn,
+			rte_memory_order_relaxed);
+	return rsn->sqn;
+}
+
+/**
+ * For lock-free replay window, check a sequence number against a bucket.
+ * Returns the new bucket value, or 0 if the packet has to be dropped.
+ */
+static inline uint64_t
+esn_inb_mw_bucket_set(uint64_t bucket, uint64_t sqn)
+{
+	uint32_t tag, bit;
+	int32_t diff;
+
+	tag = sqn >> WINDOW_MW_BUCKET_BITS;
+	bit = (uint32_t)1 << (sqn & WINDOW_MW_BIT_LOC_MASK);
+	diff = (int32_t)(tag - (uint32_t)(bucket >> WINDOW_MW_TAG_SHIFT));
+
+	/* bucket is used by a newer part of the window */
+	if (diff < 0)
+		return 0;
+	/* bucket is used by an older part of the window, reset it */
+	if (diff > 0)
+		return (uint64_t)tag << WINDOW_MW_TAG_SHIFT | bit;
+	/* already seen packet */
+	if (bucket & bit)
+		return 0;
+	return bucket | bit;
+}
+
 /**
  * Perform the replay checking.
  *
@@ -100,13 +153,24 @@ esn_inb_check_sqn(const struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
 		return 0;
 
 	/* seq is larger than lastseq */
-	if (sqn > rsn->sqn)
+	if (sqn > rsn_last_sqn(sa, rsn))
 		return 0;
 
 	/* seq is outside window */
-	if (sqn == 0 || sqn + sa->replay.win_sz < rsn->sqn)
+	if (sqn == 0 || sqn + sa->replay.win_sz < rsn_last_sqn(sa, rsn))
 		return -EINVAL;
 
+	/* pre-check only, the window is checked again on update */
+	if (SQN_MW(sa)) {
+		bucket = (sqn >> WINDOW_MW_BUCKET_BITS) &
+			sa->replay.bucket_index_mask;
+		if (esn_inb_mw_bucket_set(rte_atomic_load_explicit(
+				(const uint64_t __rte_atomic *)&rsn->window[bucket],
+				rte_memory_order_relaxed), sqn) == 0)
+			return -EINVAL;
+		return 0;
+	}
+
 	/* seq is inside the window */
 	bit = sqn & WINDOW_BIT_LOC_MASK;
 	bucket = (sqn >> WINDOW_BUCKET_BITS) & sa->replay.bucket_index_mask;
@@ -190,6 +254,68 @@ esn_inb_update_sqn(struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
 	return 0;
 }
 
+/**
+ * For inbound SA with lock-free replay window, perform the sequence number
+ * and replay window update. Can be called by multiple threads at once.
+ */
+static inline int32_t
+esn_inb_mw_update_sqn(struct replay_sqn *rsn, const struct rte_ipsec_sa *sa,
+	uint64_t sqn)
+{
+	uint64_t __rte_atomic *last = (uint64_t __rte_atomic *)&rsn->sqn;
+	uint64_t __rte_atomic *bkt;
+	uint64_t b, nb, t;
+
+	t = rte_atomic_load_explicit(last, rte_memory_order_relaxed);
+
+	/* handle ESN */
+	if (IS_ESN(sa))
+		sqn = reconstruct_esn(t, sqn, sa->replay.win_sz);
+
+	/* seq is outside window*/
+	if (sqn == 0 || sqn + sa->replay.win_sz < t)
+		return -EINVAL;
+
+	/* set the bit, the bucket tag makes it safe against window moves */
+	bkt = (uint64_t __rte_atomic *)&rsn->window[(sqn >>
+		WINDOW_MW_BUCKET_BITS) & sa->replay.bucket_index_mask];
+	b = rte_atomic_load_explicit(bkt, rte_memory_order_relaxed);
+	do {
+		nb = esn_inb_mw_bucket_set(b, sqn);
+		if (nb == 0)
+			return -EINVAL;
+	} while (!rte_atomic_compare_exchange_weak_explicit(bkt, &b, nb,
+			rte_memory_order_relaxed, rte_memory_order_relaxed));
+
+	/* move the window forward */
+	while (sqn > t && !rte_atomic_compare_exchange_weak_explicit(last,
+			&t, sqn, rte_memory_order_relaxed,
+			rte_memory_order_relaxed))
+		;
+
+	return 0;
+}
+
+/**
+ * Init lock-free replay window: tag each bucket with the latest part of
+ * the window it can represent, as if it had been reset.
+ */
+static inline void
+rsn_mw_init(const struct rte_ipsec_sa *sa, struct replay_sqn *rsn)
+{
+	uint64_t last, tag;
+	uint32_t i, mask;
+
+	mask = sa->replay.bucket_index_mask;
+	last = rsn->sqn >> WINDOW_MW_BUCKET_BITS;
+
+	for (i = 0; i != sa->replay.nb_bucket; i++) {
+		tag = last - ((last - i) & mask);
+		rsn->window[i] = (uint32_t)tag;
+		rsn->window[i] <<= WINDOW_MW_TAG_SHIFT;
+	}
+}
+
 /**
  * To achieve ability to do multiple readers single writer for
  * SA replay window information and sequence number (RSN)
@@ -235,7 +361,7 @@ rsn_acquire(struct rte_ipsec_sa *sa)
 	n = sa->sqn.inb.rdidx;
 	rsn = sa->sqn.inb.rsn[n];
 
-	if (!SQN_ATOMIC(sa))
+	if (!SQN_ATOMIC(sa) || SQN_MW(sa))
 		return rsn;
 
 	/* check there are no writers */
@@ -255,7 +381,7 @@ rsn_acquire(struct rte_ipsec_sa *sa)
 static inline void
 rsn_release(struct rte_ipsec_sa *sa, struct replay_sqn *rsn)
 {
-	if (SQN_ATOMIC(sa))
+	if (SQN_ATOMIC(sa) && !SQN_MW(sa))
 		rte_rwlock_read_unlock(&rsn->rwl);
 }
 
@@ -208,6 +208,42 @@ rte_ipsec_pkt_cpu_prepare_stateless(const struct rte_ipsec_session *ss,
 	return ss->pkt_func.prepare_stateless.sync(ss, mb, num, state);
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Same as *rte_ipsec_pkt_crypto_prepare*, but for a burst of packets
+ * belonging to different IPsec sessions, typically as found by
+ * *rte_ipsec_sad_lookup*.
+ * The packets are grouped by session inside the function, so the caller
+ * does not need to sort them, and the SA of the next session is prefetched
+ * while preparing the packets of the current one.
+ * The packets of the same session keep their relative order.
+ * All sessions are expected to be of RTE_SECURITY_ACTION_TYPE_NONE or
+ * RTE_SECURITY_ACTION_TYPE_LOOKASIDE_PROTOCOL type.
+ * Note that on return the *mb* array is reordered to match the *cop* array:
+ * the prepared packets come first, the erroneous ones and the packets
+ * without session are not freed, but are placed beyond them.
+ * It is a user responsibility to handle them further.
+ * @param ss
+ *   The address of an array of *num* pointers to the *rte_ipsec_session*
+ *   objects the packets belong to, NULL for a packet without session.
+ * @param mb
+ *   The address of an array of *num* pointers to *rte_mbuf* structures
+ *   which contain the input packets.
+ * @param cop
+ *   The address of an array of *num* pointers to the output *rte_crypto_op*
+ *   structures.
+ * @param num
+ *   The maximum number of packets to process.
+ * @return
+ *   Number of successfully processed packets, with error code set in rte_errno.
+ */
+__rte_experimental
+uint16_t
+rte_ipsec_pkt_crypto_prepare_multi(struct rte_ipsec_session *ss[],
+	struct rte_mbuf *mb[], struct rte_crypto_op *cop[], uint16_t num);
+
 /**
  * Finalise processing of packets after crypto-dev finished with them or
  * process packets that are subjects to inline IPsec offload.
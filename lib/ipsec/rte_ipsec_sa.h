@@ -69,6 +69,16 @@ struct rte_ipsec_sa_prm {
  */
 #define	RTE_IPSEC_SAFLAG_SQN_ATOM	(1ULL << 0)
 
+/**
+ * Indicates that the replay window of an inbound SA is updated lock-free,
+ * so that rte_ipsec_pkt_process() can be executed for the SA by
+ * multiple threads at once, and a single tunnel can be spread across lcores.
+ * The window words are updated with atomic operations and are never copied,
+ * which suits large replay windows (4096 and more).
+ * Implies RTE_IPSEC_SAFLAG_SQN_ATOM.
+ */
+#define	RTE_IPSEC_SAFLAG_SQN_MW		(1ULL << 1)
+
 /**
  * SA type is an 64-bit value that contain the following information:
  * - IP version (IPv4/IPv6)
@@ -91,7 +101,8 @@ enum {
 	RTE_SATP_LOG2_ESN,
 	RTE_SATP_LOG2_ECN,
 	RTE_SATP_LOG2_DSCP,
-	RTE_SATP_LOG2_NATT
+	RTE_SATP_LOG2_NATT,
+	RTE_SATP_LOG2_SQN_MW
 };
 
 #define RTE_IPSEC_SATP_IPV_MASK		(1ULL << RTE_SATP_LOG2_IPV)
@@ -131,6 +142,10 @@ enum {
 #define RTE_IPSEC_SATP_NATT_DISABLE	(0ULL << RTE_SATP_LOG2_NATT)
 #define RTE_IPSEC_SATP_NATT_ENABLE	(1ULL << RTE_SATP_LOG2_NATT)
 
+#define RTE_IPSEC_SATP_SQN_MW_MASK	(1ULL << RTE_SATP_LOG2_SQN_MW)
+#define RTE_IPSEC_SATP_SQN_MW_DISABLE	(0ULL << RTE_SATP_LOG2_SQN_MW)
+#define RTE_IPSEC_SATP_SQN_MW_ENABLE	(1ULL << RTE_SATP_LOG2_SQN_MW)
+
 
 /**
  * get type of given SA
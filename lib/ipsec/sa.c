@@ -122,6 +122,22 @@ replay_num_bucket(uint32_t wsz)
 	return nb;
 }
 
+/*
+ * for given size, calculate required number of lock-free buckets,
+ * plus one for the bucket being filled.
+ */
+static uint32_t
+replay_mw_num_bucket(uint32_t wsz)
+{
+	uint32_t nb;
+
+	nb = rte_align32pow2(RTE_ALIGN_MUL_CEIL(wsz, WINDOW_MW_BUCKET_SIZE) /
+		WINDOW_MW_BUCKET_SIZE + 1);
+	nb = RTE_MAX(nb, (uint32_t)WINDOW_BUCKET_MIN);
+
+	return nb;
+}
+
 static int32_t
 ipsec_sa_size(uint64_t type, uint32_t *wnd_sz, uint32_t *nb_bucket)
 {
@@ -140,7 +156,10 @@ ipsec_sa_size(uint64_t type, uint32_t *wnd_sz, uint32_t *nb_bucket)
 		wsz = ((type & RTE_IPSEC_SATP_ESN_MASK) ==
 			RTE_IPSEC_SATP_ESN_DISABLE) ?
 			wsz : RTE_MAX(wsz, (uint32_t)WINDOW_BUCKET_SIZE);
-		if (wsz != 0)
+		if (wsz != 0 && (type & RTE_IPSEC_SATP_SQN_MW_MASK) ==
+				RTE_IPSEC_SATP_SQN_MW_ENABLE)
+			n = replay_mw_num_bucket(wsz);
+		else if (wsz != 0)
 			n = replay_num_bucket(wsz);
 	}
 
@@ -151,7 +170,9 @@ ipsec_sa_size(uint64_t type, uint32_t *wnd_sz, uint32_t *nb_bucket)
 	*nb_bucket = n;
 
 	sz = rsn_size(n);
-	if ((type & RTE_IPSEC_SATP_SQN_MASK) == RTE_IPSEC_SATP_SQN_ATOM)
+	if ((type & RTE_IPSEC_SATP_SQN_MASK) == RTE_IPSEC_SATP_SQN_ATOM &&
+			(type & RTE_IPSEC_SATP_SQN_MW_MASK) ==
+			RTE_IPSEC_SATP_SQN_MW_DISABLE)
 		sz *= REPLAY_SQN_NUM;
 
 	sz += sizeof(struct rte_ipsec_sa);
@@ -241,11 +262,19 @@ fill_sa_type(const struct rte_ipsec_sa_prm *prm, uint64_t *type)
 		tp |= RTE_IPSEC_SATP_DSCP_ENABLE;
 
 	/* interpret flags */
-	if (prm->flags & RTE_IPSEC_SAFLAG_SQN_ATOM)
+	if (prm->flags & (RTE_IPSEC_SAFLAG_SQN_ATOM | RTE_IPSEC_SAFLAG_SQN_MW))
 		tp |= RTE_IPSEC_SATP_SQN_ATOM;
 	else
 		tp |= RTE_IPSEC_SATP_SQN_RAW;
 
+	/* lock-free replay window is for inbound only */
+	if ((prm->flags & RTE_IPSEC_SAFLAG_SQN_MW) != 0 &&
+			prm->ipsec_xform.direction ==
+			RTE_SECURITY_IPSEC_SA_DIR_INGRESS)
+		tp |= RTE_IPSEC_SATP_SQN_MW_ENABLE;
+	else
+		tp |= RTE_IPSEC_SATP_SQN_MW_DISABLE;
+
 	*type = tp;
 	return 0;
 }
@@ -521,7 +550,9 @@ fill_sa_replay(struct rte_ipsec_sa *sa, uint32_t wnd_sz, uint32_t nb_bucket,
 	sa->replay.bucket_index_mask = nb_bucket - 1;
 	sa->sqn.inb.rsn[0] = (struct replay_sqn *)(sa + 1);
 	sa->sqn.inb.rsn[0]->sqn = sqn;
-	if ((sa->type & RTE_IPSEC_SATP_SQN_MASK) == RTE_IPSEC_SATP_SQN_ATOM) {
+	if (SQN_MW(sa))
+		rsn_mw_init(sa, sa->sqn.inb.rsn[0]);
+	else if ((sa->type & RTE_IPSEC_SATP_SQN_MASK) == RTE_IPSEC_SATP_SQN_ATOM) {
 		sa->sqn.inb.rsn[1] = (struct replay_sqn *)
 			((uintptr_t)sa->sqn.inb.rsn[0] + rsn_size(nb_bucket));
 		sa->sqn.inb.rsn[1]->sqn = sqn;
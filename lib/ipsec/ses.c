@@ -3,9 +3,15 @@
  */
 
 #include <eal_export.h>
+#include <rte_bitops.h>
+#include <rte_errno.h>
 #include <rte_ipsec.h>
+#include <rte_prefetch.h>
 #include "sa.h"
 
+/* max number of packets grouped at once by rte_ipsec_pkt_crypto_prepare_multi */
+#define PREPARE_MULTI_BURST	64U
+
 static int
 session_check(struct rte_ipsec_session *ss)
 {
@@ -54,3 +60,101 @@ rte_ipsec_session_prepare(struct rte_ipsec_session *ss)
 
 	return 0;
 }
+
+/*
+ * Group the packets of a chunk by session, keeping the order of the packets
+ * of each session. Packets without session are moved to dr[].
+ * Returns the number of groups.
+ */
+static uint32_t
+prepare_multi_group(struct rte_ipsec_session *ss[], struct rte_mbuf *mb[],
+	uint32_t num, struct rte_ipsec_session *gs[], uint32_t gcnt[],
+	struct rte_mbuf *pkt[], struct rte_mbuf *dr[], uint32_t *nb_dr)
+{
+	uint32_t i, j, k, n;
+	uint64_t done[PREPARE_MULTI_BURST / 64] = {0};
+
+	k = 0;
+	n = 0;
+	for (i = 0; i != num; i++) {
+
+		if (done[i / 64] & RTE_BIT64(i % 64))
+			continue;
+
+		if (ss[i] == NULL) {
+			dr[(*nb_dr)++] = mb[i];
+			continue;
+		}
+
+		gs[n] = ss[i];
+		gcnt[n] = 0;
+		for (j = i; j != num; j++) {
+			if (ss[j] == gs[n]) {
+				done[j / 64] |= RTE_BIT64(j % 64);
+				pkt[k++] = mb[j];
+				gcnt[n]++;
+			}
+		}
+		rte_prefetch0(gs[n]);
+		n++;
+	}
+
+	return n;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ipsec_pkt_crypto_prepare_multi, 26.03)
+uint16_t
+rte_ipsec_pkt_crypto_prepare_multi(struct rte_ipsec_session *ss[],
+	struct rte_mbuf *mb[], struct rte_crypto_op *cop[], uint16_t num)
+{
+	struct rte_ipsec_session *gs[PREPARE_MULTI_BURST];
+	uint32_t gcnt[PREPARE_MULTI_BURST];
+	struct rte_mbuf *pkt[PREPARE_MULTI_BURST];
+	struct rte_mbuf *dr[PREPARE_MULTI_BURST];
+	uint32_t i, j, k, l, n, ng, nb_dr, nb_bad, ofs, rc;
+	int32_t err;
+
+	err = 0;
+	k = 0;
+	nb_bad = 0;
+
+	/*
+	 * Chunk after chunk, the packets are copied out of mb[], which is
+	 * then filled with the prepared packets followed by the failed ones.
+	 */
+	for (i = 0; i != num; i += n) {
+		n = RTE_MIN(num - i, PREPARE_MULTI_BURST);
+		nb_dr = 0;
+		ng = prepare_multi_group(ss + i, mb + i, n, gs, gcnt, pkt, dr,
+			&nb_dr);
+		if (nb_dr != 0)
+			err = ENOENT;
+
+		for (j = 0, ofs = 0; j != ng; ofs += gcnt[j], j++) {
+
+			/* the SA of the next group is accessed right after */
+			if (j + 1 != ng)
+				rte_prefetch0(gs[j + 1]->sa);
+
+			rc = gs[j]->pkt_func.prepare.async(gs[j], pkt + ofs,
+				cop + k, gcnt[j]);
+			if (rc != gcnt[j])
+				err = rte_errno;
+
+			/* failed packets are placed beyond the prepared ones */
+			for (l = 0; l != rc; l++) {
+				mb[k + nb_bad] = mb[k];
+				mb[k++] = pkt[ofs + l];
+			}
+			for (; l != gcnt[j]; l++)
+				dr[nb_dr++] = pkt[ofs + l];
+		}
+
+		for (j = 0; j != nb_dr; j++)
+			mb[k + nb_bad++] = dr[j];
+	}
+
+	if (err != 0)
+		rte_errno = err;
+	return k;
+}
@@ -4,16 +4,40 @@
 
 #include <string.h>
 #include <stdlib.h>
+#include <stdbool.h>
 #include <errno.h>
+#include <sys/queue.h>
 
 #include <eal_export.h>
 #include <rte_string_fns.h>
+#include <rte_bitops.h>
 #include <rte_common.h>
 #include <rte_cycles.h>
 #include <rte_branch_prediction.h>
+#include <rte_malloc.h>
+#include <rte_spinlock.h>
+#include <rte_telemetry.h>
 
 #include "rte_jobstats.h"
 
+/* Fixed point one of the PID controller gains */
+#define JOB_PID_ONE 1024
+
+struct rte_jobstats_ext {
+	TAILQ_ENTRY(rte_jobstats_ext) next;
+	struct rte_jobstats *job;
+	bool hist_enabled;
+	bool pid_enabled;
+	uint64_t hist[RTE_JOBSTATS_HIST_BUCKETS];
+	struct rte_jobstats_pid_conf pid;
+	int64_t integral;
+	int64_t prev_err;
+};
+
+/* Jobs reported in the telemetry */
+static TAILQ_HEAD(, rte_jobstats_ext) ext_list = TAILQ_HEAD_INITIALIZER(ext_list);
+static rte_spinlock_t ext_lock = RTE_SPINLOCK_INITIALIZER;
+
 #define ADD_TIME_MIN_MAX(obj, type, value) do {      \
 	typeof(value) tmp = (value);                     \
 	(obj)->type ## _time += tmp;                     \
@@ -64,6 +88,33 @@ default_update_function(struct rte_jobstats *job, int64_t result)
 	}
 }
 
+/*
+ * PID controller, the error is integrated only while the period is not
+ * saturated to avoid overshooting once the job leaves the min, max range.
+ */
+static void
+pid_update_function(struct rte_jobstats *job, int64_t result)
+{
+	struct rte_jobstats_ext *ext = job->ext;
+	const struct rte_jobstats_pid_conf *pid = &ext->pid;
+	int64_t err = job->target - result;
+	int64_t integral = ext->integral + err;
+	int64_t period;
+
+	period = (int64_t)job->period + (pid->kp * err + pid->ki * integral +
+		pid->kd * (err - ext->prev_err)) / JOB_PID_ONE;
+	ext->prev_err = err;
+
+	if (period < (int64_t)job->min_period)
+		period = job->min_period;
+	else if (period > (int64_t)job->max_period)
+		period = job->max_period;
+	else
+		ext->integral = integral;
+
+	job->period = period;
+}
+
 RTE_EXPORT_SYMBOL(rte_jobstats_context_init)
 int
 rte_jobstats_context_init(struct rte_jobstats_context *ctx)
@@ -191,6 +242,8 @@ rte_jobstats_finish(struct rte_jobstats *job, int64_t job_value)
 	exec_time = now - ctx->state_time;
 	ADD_TIME_MIN_MAX(job, exec, exec_time);
 	ADD_TIME_MIN_MAX(ctx, exec, exec_time);
+	if (job->ext != NULL && job->ext->hist_enabled)
+		job->ext->hist[exec_time == 0 ? 0 : rte_fls_u64(exec_time) - 1]++;
 
 	ctx->state_time = now;
 
@@ -253,6 +306,7 @@ rte_jobstats_init(struct rte_jobstats *job, const char *name,
 	rte_jobstats_reset(job);
 	strlcpy(job->name, name == NULL ? "" : name, RTE_DIM(job->name));
 	job->context = NULL;
+	job->ext = NULL;
 
 	return 0;
 }
@@ -274,4 +328,192 @@ rte_jobstats_reset(struct rte_jobstats *job)
 {
 	RESET_TIME_MIN_MAX(job, exec);
 	job->exec_cnt = 0;
+	if (job->ext != NULL)
+		memset(job->ext->hist, 0, sizeof(job->ext->hist));
+}
+
+static struct rte_jobstats_ext *
+jobstats_ext_get(struct rte_jobstats *job)
+{
+	struct rte_jobstats_ext *ext = job->ext;
+
+	if (ext != NULL)
+		return ext;
+
+	ext = rte_zmalloc("jobstats", sizeof(*ext), RTE_CACHE_LINE_SIZE);
+	if (ext == NULL)
+		return NULL;
+
+	ext->job = job;
+	rte_spinlock_lock(&ext_lock);
+	TAILQ_INSERT_TAIL(&ext_list, ext, next);
+	rte_spinlock_unlock(&ext_lock);
+	job->ext = ext;
+
+	return ext;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_jobstats_hist_enable, 26.03)
+int
+rte_jobstats_hist_enable(struct rte_jobstats *job)
+{
+	struct rte_jobstats_ext *ext;
+
+	if (job == NULL)
+		return -EINVAL;
+
+	ext = jobstats_ext_get(job);
+	if (ext == NULL)
+		return -ENOMEM;
+
+	ext->hist_enabled = true;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_jobstats_hist_get, 26.03)
+int
+rte_jobstats_hist_get(const struct rte_jobstats *job, uint64_t *counts,
+		unsigned int n)
+{
+	if (job == NULL || counts == NULL)
+		return -EINVAL;
+
+	if (job->ext == NULL || !job->ext->hist_enabled)
+		return -ENOENT;
+
+	n = RTE_MIN(n, (unsigned int)RTE_JOBSTATS_HIST_BUCKETS);
+	memcpy(counts, job->ext->hist, n * sizeof(*counts));
+
+	return n;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_jobstats_pid_set, 26.03)
+int
+rte_jobstats_pid_set(struct rte_jobstats *job,
+		const struct rte_jobstats_pid_conf *conf)
+{
+	struct rte_jobstats_ext *ext;
+
+	if (job == NULL || conf == NULL)
+		return -EINVAL;
+
+	ext = jobstats_ext_get(job);
+	if (ext == NULL)
+		return -ENOMEM;
+
+	ext->pid = *conf;
+	ext->integral = 0;
+	ext->prev_err = 0;
+	ext->pid_enabled = true;
+	job->target = conf->target;
+	job->update_period_cb = pid_update_function;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_jobstats_release, 26.03)
+void
+rte_jobstats_release(struct rte_jobstats *job)
+{
+	struct rte_jobstats_ext *ext;
+
+	if (job == NULL || job->ext == NULL)
+		return;
+
+	ext = job->ext;
+	rte_spinlock_lock(&ext_lock);
+	TAILQ_REMOVE(&ext_list, ext, next);
+	rte_spinlock_unlock(&ext_lock);
+
+	if (job->update_period_cb == pid_update_function)
+		job->update_period_cb = default_update_function;
+	job->ext = NULL;
+	rte_free(ext);
+}
+
+static int
+jobstats_handle_list(const char *cmd __rte_unused,
+		const char *params __rte_unused, struct rte_tel_data *d)
+{
+	struct rte_jobstats_ext *ext;
+
+	rte_tel_data_start_array(d, RTE_TEL_STRING_VAL);
+	rte_spinlock_lock(&ext_lock);
+	TAILQ_FOREACH(ext, &ext_list, next)
+		rte_tel_data_add_array_string(d, ext->job->name);
+	rte_spinlock_unlock(&ext_lock);
+
+	return 0;
+}
+
+static int
+jobstats_handle_info(const char *cmd __rte_unused, const char *params,
+		struct rte_tel_data *d)
+{
+	struct rte_jobstats_ext *ext;
+	struct rte_tel_data *hist;
+	struct rte_jobstats *job;
+	unsigned long idx;
+	unsigned int i, n;
+	char *end;
+	int ret = -EINVAL;
+
+	if (params == NULL || *params == '\0')
+		return -EINVAL;
+
+	errno = 0;
+	idx = strtoul(params, &end, 0);
+	if (errno != 0 || *end != '\0')
+		return -EINVAL;
+
+	rte_spinlock_lock(&ext_lock);
+	TAILQ_FOREACH(ext, &ext_list, next) {
+		if (idx-- != 0)
+			continue;
+
+		job = ext->job;
+		rte_tel_data_start_dict(d);
+		rte_tel_data_add_dict_string(d, "name", job->name);
+		rte_tel_data_add_dict_uint(d, "period", job->period);
+		rte_tel_data_add_dict_uint(d, "min_period", job->min_period);
+		rte_tel_data_add_dict_uint(d, "max_period", job->max_period);
+		rte_tel_data_add_dict_int(d, "target", job->target);
+		rte_tel_data_add_dict_uint(d, "exec_cnt", job->exec_cnt);
+		rte_tel_data_add_dict_uint(d, "exec_time", job->exec_time);
+		rte_tel_data_add_dict_uint(d, "min_exec_time",
+			job->exec_cnt != 0 ? job->min_exec_time : 0);
+		rte_tel_data_add_dict_uint(d, "max_exec_time", job->max_exec_time);
+		if (ext->pid_enabled) {
+			rte_tel_data_add_dict_int(d, "pid_kp", ext->pid.kp);
+			rte_tel_data_add_dict_int(d, "pid_ki", ext->pid.ki);
+			rte_tel_data_add_dict_int(d, "pid_kd", ext->pid.kd);
+			rte_tel_data_add_dict_int(d, "pid_integral", ext->integral);
+		}
+
+		/* buckets up to the last one counting executions */
+		hist = ext->hist_enabled ? rte_tel_data_alloc() : NULL;
+		if (hist != NULL) {
+			for (n = RTE_JOBSTATS_HIST_BUCKETS; n > 0; n--)
+				if (ext->hist[n - 1] != 0)
+					break;
+			rte_tel_data_start_array(hist, RTE_TEL_UINT_VAL);
+			for (i = 0; i < n; i++)
+				rte_tel_data_add_array_uint(hist, ext->hist[i]);
+			rte_tel_data_add_dict_container(d, "hist", hist, 0);
+		}
+		ret = 0;
+		break;
+	}
+	rte_spinlock_unlock(&ext_lock);
+
+	return ret;
+}
+
+RTE_INIT(jobstats_init_telemetry)
+{
+	rte_telemetry_register_cmd("/jobstats/list", jobstats_handle_list,
+		"Returns the names of the jobs with a histogram or a period controller.");
+	rte_telemetry_register_cmd("/jobstats/info", jobstats_handle_info,
+		"Returns the statistics of a job. Parameters: int job_index");
 }
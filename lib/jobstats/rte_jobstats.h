@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 
+#include <rte_compat.h>
 #include <rte_memory.h>
 
 #ifdef __cplusplus
@@ -15,9 +16,13 @@ extern "C" {
 
 #define RTE_JOBSTATS_NAMESIZE 32
 
+/** Number of buckets of a job execute time histogram. */
+#define RTE_JOBSTATS_HIST_BUCKETS 64
+
 /* Forward declarations. */
 struct rte_jobstats_context;
 struct rte_jobstats;
+struct rte_jobstats_ext;
 
 /**
  * This function should calculate new period and set it using
@@ -65,6 +70,9 @@ struct __rte_cache_aligned rte_jobstats {
 
 	struct rte_jobstats_context *context;
 	/**< Job stats context object that is executing this job. */
+
+	struct rte_jobstats_ext *ext;
+	/**< Histogram and period controller, NULL if none is enabled. */
 };
 
 struct __rte_cache_aligned rte_jobstats_context {
@@ -299,6 +307,111 @@ rte_jobstats_set_update_period_function(struct rte_jobstats *job,
 void
 rte_jobstats_reset(struct rte_jobstats *job);
 
+/**
+ * Configuration of the PID period controller of a job.
+ *
+ * The controller changes the period by a weighted sum of the error between
+ * the target and the job value, of its accumulation and of its change since
+ * the previous execution. The gains are fixed point numbers, 1024 being
+ * one cycle of period per unit of error.
+ */
+struct rte_jobstats_pid_conf {
+	int64_t target; /**< Desired value for the job. */
+	int32_t kp; /**< Proportional gain. */
+	int32_t ki; /**< Integral gain. */
+	int32_t kd; /**< Derivative gain. */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Record the execute times of a job in a histogram,
+ * and report the job in the telemetry.
+ *
+ * The bucket N of the histogram counts the executions of [2^N, 2^(N+1))
+ * timer cycles, the bucket 0 also counting those shorter than one cycle.
+ * The histogram is cleared by rte_jobstats_reset().
+ *
+ * @param job
+ *  Job object, initialized by rte_jobstats_init().
+ *
+ * @return
+ *  0 on success
+ *  -EINVAL if *job* is NULL
+ *  -ENOMEM if the histogram cannot be allocated
+ */
+__rte_experimental
+int
+rte_jobstats_hist_enable(struct rte_jobstats *job);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Copy the execute time histogram of a job.
+ *
+ * @param job
+ *  Job object.
+ * @param counts
+ *  Array receiving the count of each bucket.
+ * @param n
+ *  Size of *counts*, at most RTE_JOBSTATS_HIST_BUCKETS buckets are copied.
+ *
+ * @return
+ *  Number of buckets copied on success
+ *  -EINVAL if *job* or *counts* is NULL
+ *  -ENOENT if the histogram of *job* is not enabled
+ */
+__rte_experimental
+int
+rte_jobstats_hist_get(const struct rte_jobstats *job, uint64_t *counts,
+		unsigned int n);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Adjust the period of a job with a PID controller.
+ *
+ * The controller replaces the update period callback of the job, and its
+ * target replaces the one of the job. It is removed by setting another
+ * update period callback with rte_jobstats_set_update_period_function().
+ * The period is kept in the min, max range of the job.
+ *
+ * @param job
+ *  Job object, initialized by rte_jobstats_init().
+ * @param conf
+ *  Controller configuration.
+ *
+ * @return
+ *  0 on success
+ *  -EINVAL if *job* or *conf* is NULL
+ *  -ENOMEM if the controller state cannot be allocated
+ */
+__rte_experimental
+int
+rte_jobstats_pid_set(struct rte_jobstats *job,
+		const struct rte_jobstats_pid_conf *conf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Release the histogram and the period controller of a job.
+ *
+ * It must be called before freeing or initializing again a job using
+ * rte_jobstats_hist_enable() or rte_jobstats_pid_set(), and not while
+ * the job is executing. The default update period callback is restored
+ * if the controller was set.
+ *
+ * @param job
+ *  Job object.
+ */
+__rte_experimental
+void
+rte_jobstats_release(struct rte_jobstats *job);
+
 #ifdef __cplusplus
 }
 #endif
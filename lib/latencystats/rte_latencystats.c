@@ -2,6 +2,7 @@
  * Copyright(c) 2018 Intel Corporation
  */
 
+#include <ctype.h>
 #include <errno.h>
 #include <math.h>
 #include <stdbool.h>
@@ -10,6 +11,7 @@
 #include <string.h>
 
 #include <eal_export.h>
+#include <rte_bitops.h>
 #include <rte_cycles.h>
 #include <rte_eal.h>
 #include <rte_errno.h>
@@ -20,9 +22,9 @@
 #include <rte_mbuf_dyn.h>
 #include <rte_memzone.h>
 #include <rte_metrics.h>
-#include <rte_spinlock.h>
 #include <rte_string_fns.h>
 #include <rte_stdatomic.h>
+#include <rte_telemetry.h>
 
 #include "rte_latencystats.h"
 
@@ -57,7 +59,6 @@ static inline bool tsc_after(uint64_t t0, uint64_t t1)
 static const char *MZ_RTE_LATENCY_STATS = "rte_latencystats";
 static int latency_stats_index;
 
-static rte_spinlock_t sample_lock = RTE_SPINLOCK_INITIALIZER;
 static uint64_t samp_intvl;
 static RTE_ATOMIC(uint64_t) next_tsc;
 
@@ -70,10 +71,70 @@ struct rte_latency_stats {
 	uint64_t max_latency; /**< Maximum latency */
 	uint64_t jitter; /** Latency variation */
 	uint64_t samples;    /** Number of latency samples */
-	rte_spinlock_t lock; /** Latency calculation lock */
+	uint64_t p50_ns;     /** Median latency of the histograms */
+	uint64_t p99_ns;     /** 99th percentile latency of the histograms */
+	uint64_t p999_ns;    /** 99.9th percentile latency of the histograms */
 };
 
-static struct rte_latency_stats *glob_stats;
+/* Shared by the processes, Tx queues with accumulators of each port. */
+struct latency_stats_shared {
+	uint16_t nb_queues[RTE_MAX_ETHPORTS];
+};
+
+static struct latency_stats_shared *shared;
+
+/*
+ * Latency histogram, with log-linear buckets: the values below
+ * 2^LATENCY_HIST_SUB_BITS ns have one bucket each, then each power of 2 range
+ * is split in 2^LATENCY_HIST_SUB_BITS buckets, i.e. a relative error below 3%.
+ */
+#define LATENCY_HIST_SUB_BITS 5
+#define LATENCY_HIST_SUB_COUNT (1 << LATENCY_HIST_SUB_BITS)
+#define LATENCY_HIST_MSB_MAX 39 /* Latencies up to ~1100 seconds. */
+#define LATENCY_HIST_BUCKETS \
+	((LATENCY_HIST_MSB_MAX - LATENCY_HIST_SUB_BITS + 2) * LATENCY_HIST_SUB_COUNT)
+
+struct latency_hist {
+	uint64_t samples;
+	uint64_t min_ns;
+	uint64_t max_ns;
+	uint64_t buckets[LATENCY_HIST_BUCKETS];
+};
+
+/*
+ * Per Tx queue latency accumulators: the stats of the sampled packets,
+ * in TSC cycles, and the histogram of all the timestamped packets.
+ * Only written by the lcore polling the Tx queue, so neither locked nor
+ * shared with another writer, and merged when the stats are read.
+ */
+struct latency_queue {
+	struct rte_latency_stats stats;
+	uint64_t prev_latency;
+	struct latency_hist hist;
+} __rte_cache_aligned;
+
+#define MZ_RTE_LATENCY_QUEUES "rte_latencystats_q_%u"
+
+/* Per port latency accumulators, one per Tx queue. */
+static struct latency_queue *port_queues[RTE_MAX_ETHPORTS];
+
+static const double latency_percentiles[] = { 0.5, 0.99, 0.999 };
+
+/*
+ * Ports with the Rx timestamp offload enabled: the packets are timestamped
+ * by the hardware, with the device clock, converted to TSC cycles at Tx.
+ */
+struct hw_clock {
+	bool enabled;
+	double cycles_per_tick;
+};
+
+static struct hw_clock hw_clocks[RTE_MAX_ETHPORTS];
+
+#define LATENCY_CLOCK_CALIB_US 10000
+
+/* Global stats sampling of the hardware timestamped packets. */
+static RTE_ATOMIC(uint64_t) next_hw_tsc;
 
 struct rxtx_cbs {
 	const struct rte_eth_rxtx_callback *cb;
@@ -94,18 +155,85 @@ static const struct latency_stats_nameoff lat_stats_strings[] = {
 	{"max_latency_ns", offsetof(struct rte_latency_stats, max_latency), 1},
 	{"jitter_ns", offsetof(struct rte_latency_stats, jitter), LATENCY_JITTER_SCALE},
 	{"samples", offsetof(struct rte_latency_stats, samples), 0},
+	{"p50_latency_ns", offsetof(struct rte_latency_stats, p50_ns), 0},
+	{"p99_latency_ns", offsetof(struct rte_latency_stats, p99_ns), 0},
+	{"p999_latency_ns", offsetof(struct rte_latency_stats, p999_ns), 0},
 };
 
 #define NUM_LATENCY_STATS RTE_DIM(lat_stats_strings)
 
+static struct latency_queue *queues_lookup(uint16_t pid);
+static void latency_hist_percentiles(const uint64_t *buckets, uint64_t total,
+		uint64_t max_ns, uint64_t *values[]);
+
+/* Merge the stats and histograms of all the Tx queues. */
+static void
+latencystats_merge(struct rte_latency_stats *merged)
+{
+	uint64_t buckets[LATENCY_HIST_BUCKETS];
+	uint64_t *percentiles[RTE_DIM(latency_percentiles)];
+	double avg = 0, jitter = 0;
+	uint64_t hist_samples = 0, hist_max = 0;
+	const struct latency_queue *q;
+	uint16_t pid, qid;
+	uint32_t i;
+
+	memset(merged, 0, sizeof(*merged));
+	memset(buckets, 0, sizeof(buckets));
+
+	for (pid = 0; pid < RTE_MAX_ETHPORTS; pid++) {
+		if (shared->nb_queues[pid] == 0)
+			continue;
+		q = queues_lookup(pid);
+		if (q == NULL)
+			continue;
+
+		for (qid = 0; qid < shared->nb_queues[pid]; qid++, q++) {
+			const struct rte_latency_stats *s = &q->stats;
+			uint64_t samples = s->samples;
+
+			if (samples != 0) {
+				if (merged->samples == 0 || s->min_latency < merged->min_latency)
+					merged->min_latency = s->min_latency;
+				if (s->max_latency > merged->max_latency)
+					merged->max_latency = s->max_latency;
+				avg += (double)s->avg_latency * samples;
+				jitter += (double)s->jitter * samples;
+				merged->samples += samples;
+			}
+
+			if (q->hist.samples == 0)
+				continue;
+			hist_samples += q->hist.samples;
+			hist_max = RTE_MAX(hist_max, q->hist.max_ns);
+			for (i = 0; i < LATENCY_HIST_BUCKETS; i++)
+				buckets[i] += q->hist.buckets[i];
+		}
+	}
+
+	/* Averages of the queues, weighted by their samples. */
+	if (merged->samples != 0) {
+		merged->avg_latency = avg / merged->samples;
+		merged->jitter = jitter / merged->samples;
+	}
+
+	percentiles[0] = &merged->p50_ns;
+	percentiles[1] = &merged->p99_ns;
+	percentiles[2] = &merged->p999_ns;
+	latency_hist_percentiles(buckets, hist_samples, hist_max, percentiles);
+}
+
 static void
 latencystats_collect(uint64_t values[])
 {
+	struct rte_latency_stats merged;
 	unsigned int i, scale;
 	const uint64_t *stats;
 
+	latencystats_merge(&merged);
+
 	for (i = 0; i < NUM_LATENCY_STATS; i++) {
-		stats = RTE_PTR_ADD(glob_stats, lat_stats_strings[i].offset);
+		stats = RTE_PTR_ADD(&merged, lat_stats_strings[i].offset);
 		scale = lat_stats_strings[i].scale;
 
 		/* used to mark samples which are not a time interval */
@@ -148,6 +276,24 @@ rte_latencystats_fill_values(struct rte_metric_value *metrics)
 	}
 }
 
+/*
+ * Claim the sample of the current interval, shared by all the queues.
+ * The interval is read without writing in the common case, and only
+ * the lcore winning the compare and swap takes the sample.
+ */
+static inline bool
+latency_sample_claim(RTE_ATOMIC(uint64_t) *next, uint64_t now)
+{
+	uint64_t due = rte_atomic_load_explicit(next, rte_memory_order_relaxed);
+
+	if (likely(tsc_before(now, due)))
+		return false;
+
+	return rte_atomic_compare_exchange_strong_explicit(next, &due,
+			now + samp_intvl, rte_memory_order_relaxed,
+			rte_memory_order_relaxed);
+}
+
 static uint16_t
 add_time_stamps(uint16_t pid __rte_unused,
 		uint16_t qid __rte_unused,
@@ -159,103 +305,293 @@ add_time_stamps(uint16_t pid __rte_unused,
 	unsigned int i;
 	uint64_t now = rte_rdtsc();
 
-	/* Check without locking */
-	if (likely(tsc_before(now, rte_atomic_load_explicit(&next_tsc,
-							    rte_memory_order_relaxed))))
+	if (likely(!latency_sample_claim(&next_tsc, now)))
 		return nb_pkts;
 
-	/* Try and get sample, skip if sample is being done by other core. */
-	if (likely(rte_spinlock_trylock(&sample_lock))) {
-		for (i = 0; i < nb_pkts; i++) {
-			struct rte_mbuf *m = pkts[i];
+	for (i = 0; i < nb_pkts; i++) {
+		struct rte_mbuf *m = pkts[i];
 
-			/* skip if already timestamped */
-			if (unlikely(m->ol_flags & timestamp_dynflag))
-				continue;
+		/* skip if already timestamped */
+		if (unlikely(m->ol_flags & timestamp_dynflag))
+			continue;
 
-			m->ol_flags |= timestamp_dynflag;
-			*timestamp_dynfield(m) = now;
-			rte_atomic_store_explicit(&next_tsc, now + samp_intvl,
-						  rte_memory_order_relaxed);
-			break;
-		}
-		rte_spinlock_unlock(&sample_lock);
+		m->ol_flags |= timestamp_dynflag;
+		*timestamp_dynfield(m) = now;
+		break;
 	}
 
 	return nb_pkts;
 }
 
+static inline uint32_t
+latency_hist_index(uint64_t ns)
+{
+	uint32_t msb;
+
+	if (ns < LATENCY_HIST_SUB_COUNT)
+		return ns;
+
+	msb = rte_fls_u64(ns) - 1;
+	if (msb > LATENCY_HIST_MSB_MAX)
+		return LATENCY_HIST_BUCKETS - 1;
+
+	return (msb - LATENCY_HIST_SUB_BITS + 1) * LATENCY_HIST_SUB_COUNT +
+		((ns >> (msb - LATENCY_HIST_SUB_BITS)) & (LATENCY_HIST_SUB_COUNT - 1));
+}
+
+/* Highest latency of a histogram bucket, in ns. */
+static inline uint64_t
+latency_hist_value(uint32_t index)
+{
+	uint32_t shift;
+
+	if (index < LATENCY_HIST_SUB_COUNT)
+		return index;
+
+	shift = index / LATENCY_HIST_SUB_COUNT - 1;
+	return (((uint64_t)LATENCY_HIST_SUB_COUNT + index % LATENCY_HIST_SUB_COUNT) << shift) +
+		(RTE_BIT64(shift) - 1);
+}
+
+static inline void
+latency_hist_add(struct latency_hist *hist, uint64_t ns)
+{
+	if (hist->samples++ == 0 || ns < hist->min_ns)
+		hist->min_ns = ns;
+	if (ns > hist->max_ns)
+		hist->max_ns = ns;
+
+	hist->buckets[latency_hist_index(ns)]++;
+}
+
+/* Percentiles of latency_percentiles, from total samples in buckets. */
+static void
+latency_hist_percentiles(const uint64_t *buckets, uint64_t total,
+		uint64_t max_ns, uint64_t *values[])
+{
+	uint64_t count = 0;
+	unsigned int p = 0;
+	uint32_t i;
+
+	for (i = 0; i < LATENCY_HIST_BUCKETS && p < RTE_DIM(latency_percentiles); i++) {
+		count += buckets[i];
+
+		while (p < RTE_DIM(latency_percentiles) &&
+		       count >= (uint64_t)ceil(latency_percentiles[p] * total)) {
+			*values[p] = RTE_MIN(latency_hist_value(i), max_ns);
+			p++;
+		}
+	}
+
+	/* Buckets updated after the sample count snapshot. */
+	for ( ; p < RTE_DIM(latency_percentiles); p++)
+		*values[p] = max_ns;
+}
+
+static void
+queue_stats_update(struct latency_queue *q, uint64_t latency)
+{
+	struct rte_latency_stats *stats = &q->stats;
+
+	if (stats->samples++ == 0) {
+		stats->min_latency = latency;
+		stats->max_latency = latency;
+		stats->avg_latency = latency * 4;
+		/* start ad if previous sample had 0 latency */
+		stats->jitter = latency / LATENCY_JITTER_SCALE;
+	} else {
+		/*
+		 * The jitter is calculated as statistical mean of interpacket
+		 * delay variation. The "jitter estimate" is computed by taking
+		 * the absolute values of the ipdv sequence and applying an
+		 * exponential filter with parameter 1/16 to generate the
+		 * estimate. i.e J=J+(|D(i-1,i)|-J)/16. Where J is jitter,
+		 * D(i-1,i) is difference in latency of two consecutive packets
+		 * i-1 and i. Jitter is scaled by 16.
+		 * Reference: Calculated as per RFC 5481, sec 4.1,
+		 * RFC 3393 sec 4.5, RFC 1889 sec.
+		 */
+		long long delta = q->prev_latency - latency;
+		stats->jitter += llabs(delta)
+			- stats->jitter / LATENCY_JITTER_SCALE;
+
+		if (latency < stats->min_latency)
+			stats->min_latency = latency;
+		if (latency > stats->max_latency)
+			stats->max_latency = latency;
+		/*
+		 * The average latency is measured using exponential moving
+		 * average, i.e. using EWMA
+		 * https://en.wikipedia.org/wiki/Moving_average
+		 *
+		 * Alpha is .25, avg_latency is scaled by 4.
+		 */
+		stats->avg_latency += latency
+			- stats->avg_latency / LATENCY_AVG_SCALE;
+	}
+
+	q->prev_latency = latency;
+}
+
+
 static uint16_t
 calc_latency(uint16_t pid __rte_unused,
 		uint16_t qid __rte_unused,
 		struct rte_mbuf **pkts,
 		uint16_t nb_pkts,
-		void *_ __rte_unused)
+		void *user_cb)
 {
+	struct latency_queue *q = user_cb;
 	unsigned int i;
-	uint64_t now, latency;
+	uint64_t now, clock = 0, latency;
 	uint64_t ts_flags = 0;
-	static uint64_t prev_latency;
+	uint16_t clock_port = RTE_MAX_ETHPORTS;
+	bool hw_sample = false;
 
 	for (i = 0; i < nb_pkts; i++)
 		ts_flags |= (pkts[i]->ol_flags & timestamp_dynflag);
 
-	/* no samples in this burst, skip locking */
-	if (likely(ts_flags == 0))
+	/* no samples in this burst */
+	if (likely(ts_flags == 0) || q == NULL)
 		return nb_pkts;
 
 	now = rte_rdtsc();
-	rte_spinlock_lock(&glob_stats->lock);
+
 	for (i = 0; i < nb_pkts; i++) {
-		if (!(pkts[i]->ol_flags & timestamp_dynflag))
+		struct rte_mbuf *m = pkts[i];
+		const struct hw_clock *hwc;
+
+		if (!(m->ol_flags & timestamp_dynflag))
 			continue;
 
-		latency = now - *timestamp_dynfield(pkts[i]);
+		hwc = m->port < RTE_MAX_ETHPORTS ? &hw_clocks[m->port] : NULL;
+		if (hwc != NULL && hwc->enabled) {
+			/* Read the Rx device clock once per burst. */
+			if (clock_port != m->port) {
+				if (rte_eth_read_clock(m->port, &clock))
+					continue;
+				clock_port = m->port;
+			}
+
+			latency = (uint64_t)((int64_t)(clock - *timestamp_dynfield(m)) *
+					     hwc->cycles_per_tick);
 
-		if (glob_stats->samples++ == 0) {
-			glob_stats->min_latency = latency;
-			glob_stats->max_latency = latency;
-			glob_stats->avg_latency = latency * 4;
-			/* start ad if previous sample had 0 latency */
-			glob_stats->jitter = latency / LATENCY_JITTER_SCALE;
-		} else {
-			/*
-			 * The jitter is calculated as statistical mean of interpacket
-			 * delay variation. The "jitter estimate" is computed by taking
-			 * the absolute values of the ipdv sequence and applying an
-			 * exponential filter with parameter 1/16 to generate the
-			 * estimate. i.e J=J+(|D(i-1,i)|-J)/16. Where J is jitter,
-			 * D(i-1,i) is difference in latency of two consecutive packets
-			 * i-1 and i. Jitter is scaled by 16.
-			 * Reference: Calculated as per RFC 5481, sec 4.1,
-			 * RFC 3393 sec 4.5, RFC 1889 sec.
-			 */
-			long long delta = prev_latency - latency;
-			glob_stats->jitter += llabs(delta)
-				- glob_stats->jitter / LATENCY_JITTER_SCALE;
-
-			if (latency < glob_stats->min_latency)
-				glob_stats->min_latency = latency;
-			if (latency > glob_stats->max_latency)
-				glob_stats->max_latency = latency;
 			/*
-			 * The average latency is measured using exponential moving
-			 * average, i.e. using EWMA
-			 * https://en.wikipedia.org/wiki/Moving_average
-			 *
-			 * Alpha is .25, avg_latency is scaled by 4.
+			 * At most one hardware timestamped packet per interval
+			 * updates the stats, as with software timestamps.
 			 */
-			glob_stats->avg_latency += latency
-				- glob_stats->avg_latency / LATENCY_AVG_SCALE;
+			if (!hw_sample && latency_sample_claim(&next_hw_tsc, now)) {
+				hw_sample = true;
+				queue_stats_update(q, latency);
+			}
+		} else {
+			latency = now - *timestamp_dynfield(m);
+			queue_stats_update(q, latency);
 		}
 
-		prev_latency = latency;
+		latency_hist_add(&q->hist, (uint64_t)(latency / cycles_per_ns));
 	}
-	rte_spinlock_unlock(&glob_stats->lock);
 
 	return nb_pkts;
 }
 
+/* Check whether the port has the Rx timestamp offload, calibrate its clock. */
+static void
+hw_clock_setup(uint16_t pid)
+{
+	struct hw_clock *hwc = &hw_clocks[pid];
+	struct rte_eth_conf conf;
+	uint64_t clock0, clock1, tsc0, tsc1;
+
+	hwc->enabled = false;
+
+	if (rte_eth_dev_conf_get(pid, &conf) != 0 ||
+	    !(conf.rxmode.offloads & RTE_ETH_RX_OFFLOAD_TIMESTAMP))
+		return;
+
+	if (rte_eth_read_clock(pid, &clock0) != 0)
+		return;
+	tsc0 = rte_rdtsc();
+
+	rte_delay_us_sleep(LATENCY_CLOCK_CALIB_US);
+
+	if (rte_eth_read_clock(pid, &clock1) != 0)
+		return;
+	tsc1 = rte_rdtsc();
+
+	if (clock1 == clock0)
+		return;
+
+	hwc->cycles_per_tick = (double)(tsc1 - tsc0) / (double)(clock1 - clock0);
+	hwc->enabled = true;
+
+	LATENCY_STATS_LOG(INFO, "Using Rx hardware timestamps for port %u", pid);
+}
+
+static struct latency_queue *
+queues_lookup(uint16_t pid)
+{
+	char name[RTE_MEMZONE_NAMESIZE];
+	const struct rte_memzone *mz;
+
+	if (port_queues[pid] != NULL)
+		return port_queues[pid];
+
+	snprintf(name, sizeof(name), MZ_RTE_LATENCY_QUEUES, pid);
+	mz = rte_memzone_lookup(name);
+	if (mz == NULL)
+		return NULL;
+
+	port_queues[pid] = mz->addr;
+	return port_queues[pid];
+}
+
+static void
+queues_free(uint16_t pid)
+{
+	char name[RTE_MEMZONE_NAMESIZE];
+
+	snprintf(name, sizeof(name), MZ_RTE_LATENCY_QUEUES, pid);
+	rte_memzone_free(rte_memzone_lookup(name));
+	port_queues[pid] = NULL;
+	shared->nb_queues[pid] = 0;
+}
+
+/* Find the stats of a Tx queue, in this process or another one. */
+static struct latency_queue *
+queue_lookup(uint16_t port_id, uint16_t queue_id)
+{
+	struct latency_queue *q;
+
+	if (shared == NULL || port_id >= RTE_MAX_ETHPORTS ||
+	    queue_id >= shared->nb_queues[port_id])
+		return NULL;
+
+	q = queues_lookup(port_id);
+	if (q == NULL)
+		return NULL;
+
+	return &q[queue_id];
+}
+
+/* Attach to the stats of the primary process, from a secondary one. */
+static int
+latencystats_attach(void)
+{
+	const struct rte_memzone *mz;
+
+	if (shared != NULL)
+		return 0;
+
+	mz = rte_memzone_lookup(MZ_RTE_LATENCY_STATS);
+	if (mz == NULL)
+		return -ENOMEM;
+
+	cycles_per_ns = (double)rte_get_tsc_hz() / NS_PER_SEC;
+	shared = mz->addr;
+	return 0;
+}
+
 RTE_EXPORT_SYMBOL(rte_latencystats_init)
 int
 rte_latencystats_init(uint64_t app_samp_intvl,
@@ -278,7 +614,7 @@ rte_latencystats_init(uint64_t app_samp_intvl,
 		return -ENOTSUP;
 
 	/** Allocate stats in shared memory fo multi process support */
-	mz = rte_memzone_reserve(MZ_RTE_LATENCY_STATS, sizeof(*glob_stats),
+	mz = rte_memzone_reserve(MZ_RTE_LATENCY_STATS, sizeof(*shared),
 					rte_socket_id(), flags);
 	if (mz == NULL) {
 		LATENCY_STATS_LOG(ERR, "Cannot reserve memory: %s:%d",
@@ -288,10 +624,11 @@ rte_latencystats_init(uint64_t app_samp_intvl,
 
 	cycles_per_ns = (double)rte_get_tsc_hz() / NS_PER_SEC;
 
-	glob_stats = mz->addr;
-	rte_spinlock_init(&glob_stats->lock);
+	shared = mz->addr;
+	memset(shared, 0, sizeof(*shared));
 	samp_intvl = (uint64_t)(app_samp_intvl * cycles_per_ns);
 	next_tsc = rte_rdtsc();
+	next_hw_tsc = next_tsc;
 
 	/** Register latency stats with stats library */
 	for (i = 0; i < NUM_LATENCY_STATS; i++)
@@ -317,6 +654,7 @@ rte_latencystats_init(uint64_t app_samp_intvl,
 	/** Register Rx/Tx callbacks */
 	RTE_ETH_FOREACH_DEV(pid) {
 		struct rte_eth_dev_info dev_info;
+		struct latency_queue *q = NULL;
 
 		ret = rte_eth_dev_info_get(pid, &dev_info);
 		if (ret != 0) {
@@ -327,7 +665,33 @@ rte_latencystats_init(uint64_t app_samp_intvl,
 			continue;
 		}
 
+		if (dev_info.nb_tx_queues) {
+			char name[RTE_MEMZONE_NAMESIZE];
+
+			snprintf(name, sizeof(name), MZ_RTE_LATENCY_QUEUES, pid);
+			mz = rte_memzone_reserve_aligned(name,
+					dev_info.nb_tx_queues * sizeof(*q),
+					rte_eth_dev_socket_id(pid), flags,
+					RTE_CACHE_LINE_SIZE);
+			if (mz == NULL)
+				LATENCY_STATS_LOG(NOTICE,
+					"Cannot reserve latency stats for pid=%u",
+					pid);
+			else {
+				q = mz->addr;
+				memset(q, 0, dev_info.nb_tx_queues * sizeof(*q));
+				shared->nb_queues[pid] = dev_info.nb_tx_queues;
+			}
+			port_queues[pid] = q;
+		}
+
+		/* No software timestamps needed with hardware timestamps. */
+		hw_clock_setup(pid);
+
 		for (qid = 0; qid < dev_info.nb_rx_queues; qid++) {
+			if (hw_clocks[pid].enabled)
+				break;
+
 			cbs = &rx_cbs[pid][qid];
 			cbs->cb = rte_eth_add_first_rx_callback(pid, qid,
 					add_time_stamps, NULL);
@@ -339,7 +703,7 @@ rte_latencystats_init(uint64_t app_samp_intvl,
 		for (qid = 0; qid < dev_info.nb_tx_queues; qid++) {
 			cbs = &tx_cbs[pid][qid];
 			cbs->cb =  rte_eth_add_tx_callback(pid, qid,
-					calc_latency, NULL);
+					calc_latency, q ? &q[qid] : NULL);
 			if (!cbs->cb)
 				LATENCY_STATS_LOG(NOTICE,
 					"Failed to register Tx callback for pid=%u, qid=%u",
@@ -373,11 +737,14 @@ rte_latencystats_uninit(void)
 
 		for (qid = 0; qid < dev_info.nb_rx_queues; qid++) {
 			cbs = &rx_cbs[pid][qid];
+			if (cbs->cb == NULL)
+				continue;
 			ret = rte_eth_remove_rx_callback(pid, qid, cbs->cb);
 			if (ret)
 				LATENCY_STATS_LOG(NOTICE,
 					"Failed to remove Rx callback for pid=%u, qid=%u",
 					pid, qid);
+			cbs->cb = NULL;
 		}
 		for (qid = 0; qid < dev_info.nb_tx_queues; qid++) {
 			cbs = &tx_cbs[pid][qid];
@@ -387,11 +754,15 @@ rte_latencystats_uninit(void)
 					"Failed to remove Tx callback for pid=%u, qid=%u",
 					pid, qid);
 		}
+
+		hw_clocks[pid].enabled = false;
+		queues_free(pid);
 	}
 
 	/* free up the memzone */
 	mz = rte_memzone_lookup(MZ_RTE_LATENCY_STATS);
 	rte_memzone_free(mz);
+	shared = NULL;
 
 	return 0;
 }
@@ -422,15 +793,10 @@ rte_latencystats_get(struct rte_metric_value *values, uint16_t size)
 	if (size < NUM_LATENCY_STATS || values == NULL)
 		return NUM_LATENCY_STATS;
 
-	if (rte_eal_process_type() == RTE_PROC_SECONDARY) {
-		const struct rte_memzone *mz;
-		mz = rte_memzone_lookup(MZ_RTE_LATENCY_STATS);
-		if (mz == NULL) {
-			LATENCY_STATS_LOG(ERR,
-				"Latency stats memzone not found");
-			return -ENOMEM;
-		}
-		glob_stats =  mz->addr;
+	if (latencystats_attach() != 0) {
+		LATENCY_STATS_LOG(ERR,
+			"Latency stats memzone not found");
+		return -ENOMEM;
 	}
 
 	/* Retrieve latency stats */
@@ -438,3 +804,132 @@ rte_latencystats_get(struct rte_metric_value *values, uint16_t size)
 
 	return NUM_LATENCY_STATS;
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_latencystats_queue_get, 26.03)
+int
+rte_latencystats_queue_get(uint16_t port_id, uint16_t queue_id,
+		struct rte_latencystats_queue *stats)
+{
+	uint64_t *values[RTE_DIM(latency_percentiles)];
+	const struct latency_queue *q;
+	const struct latency_hist *hist;
+	uint64_t total;
+
+	if (stats == NULL)
+		return -EINVAL;
+
+	if (latencystats_attach() != 0)
+		return -ENOENT;
+	if (!rte_eth_dev_is_valid_port(port_id))
+		return -EINVAL;
+	q = queue_lookup(port_id, queue_id);
+	if (q == NULL)
+		return shared->nb_queues[port_id] == 0 ? -ENOENT : -EINVAL;
+	hist = &q->hist;
+
+	memset(stats, 0, sizeof(*stats));
+
+	/* Snapshot of the sample count, the buckets may still move. */
+	total = hist->samples;
+	stats->samples = total;
+	if (total == 0)
+		return 0;
+
+	stats->min_ns = hist->min_ns;
+	stats->max_ns = hist->max_ns;
+
+	values[0] = &stats->p50_ns;
+	values[1] = &stats->p99_ns;
+	values[2] = &stats->p999_ns;
+	latency_hist_percentiles(hist->buckets, total, stats->max_ns, values);
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_latencystats_queue_reset, 26.03)
+int
+rte_latencystats_queue_reset(uint16_t port_id, uint16_t queue_id)
+{
+	struct latency_queue *q;
+
+	if (latencystats_attach() != 0)
+		return -ENOENT;
+	if (!rte_eth_dev_is_valid_port(port_id))
+		return -EINVAL;
+	q = queue_lookup(port_id, queue_id);
+	if (q == NULL)
+		return shared->nb_queues[port_id] == 0 ? -ENOENT : -EINVAL;
+
+	memset(q, 0, sizeof(*q));
+
+	return 0;
+}
+
+static int
+latencystats_handle_stats(const char *cmd __rte_unused,
+		const char *params __rte_unused,
+		struct rte_tel_data *d)
+{
+	uint64_t values[NUM_LATENCY_STATS];
+	unsigned int i;
+
+	if (latencystats_attach() != 0)
+		return -ENOENT;
+
+	latencystats_collect(values);
+
+	rte_tel_data_start_dict(d);
+	for (i = 0; i < NUM_LATENCY_STATS; i++)
+		rte_tel_data_add_dict_uint(d, lat_stats_strings[i].name, values[i]);
+
+	return 0;
+}
+
+static int
+latencystats_handle_queue_stats(const char *cmd __rte_unused,
+		const char *params,
+		struct rte_tel_data *d)
+{
+	struct rte_latencystats_queue stats;
+	unsigned long port_id, queue_id;
+	char *end_param;
+	int ret;
+
+	if (params == NULL || strlen(params) == 0 || !isdigit(*params))
+		return -EINVAL;
+
+	port_id = strtoul(params, &end_param, 0);
+	if (*end_param != ',' || !isdigit(end_param[1]))
+		return -EINVAL;
+
+	queue_id = strtoul(end_param + 1, &end_param, 0);
+	if (*end_param != '\0')
+		LATENCY_STATS_LOG(WARNING,
+			"Extra parameters passed to latencystats telemetry command, ignoring");
+
+	if (port_id >= RTE_MAX_ETHPORTS || queue_id > UINT16_MAX)
+		return -EINVAL;
+
+	ret = rte_latencystats_queue_get(port_id, queue_id, &stats);
+	if (ret != 0)
+		return ret;
+
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_uint(d, "samples", stats.samples);
+	rte_tel_data_add_dict_uint(d, "min_latency_ns", stats.min_ns);
+	rte_tel_data_add_dict_uint(d, "max_latency_ns", stats.max_ns);
+	rte_tel_data_add_dict_uint(d, "p50_latency_ns", stats.p50_ns);
+	rte_tel_data_add_dict_uint(d, "p99_latency_ns", stats.p99_ns);
+	rte_tel_data_add_dict_uint(d, "p999_latency_ns", stats.p999_ns);
+
+	return 0;
+}
+
+RTE_INIT(latencystats_init_telemetry)
+{
+	rte_telemetry_register_cmd("/latencystats", latencystats_handle_stats,
+			"Returns the latency stats merged from all the Tx queues. No parameters.");
+	rte_telemetry_register_cmd("/latencystats/queue",
+			latencystats_handle_queue_stats,
+			"Returns the latency stats of a Tx queue. Parameters: int port_id,int queue_id");
+}
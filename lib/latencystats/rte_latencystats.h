@@ -13,6 +13,7 @@
  */
 
 #include <stdint.h>
+#include <rte_compat.h>
 #include <rte_metrics.h>
 #include <rte_mbuf.h>
 
@@ -121,6 +122,66 @@ int rte_latencystats_get_names(struct rte_metric_name *names,
 int rte_latencystats_get(struct rte_metric_value *values,
 			uint16_t size);
 
+/**
+ * Latency statistics of a Tx queue, from all the sampled packets
+ * transmitted on the queue since the last reset.
+ *
+ * The percentiles are computed from a histogram with a relative error
+ * below 3%.
+ */
+struct rte_latencystats_queue {
+	uint64_t samples; /**< Number of latency samples. */
+	uint64_t min_ns;  /**< Minimum latency, in ns. */
+	uint64_t max_ns;  /**< Maximum latency, in ns. */
+	uint64_t p50_ns;  /**< Median latency, in ns. */
+	uint64_t p99_ns;  /**< 99th percentile latency, in ns. */
+	uint64_t p999_ns; /**< 99.9th percentile latency, in ns. */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Retrieve the latency statistics of a Tx queue.
+ *
+ * When the Rx timestamp offload (RTE_ETH_RX_OFFLOAD_TIMESTAMP) of a port
+ * is enabled before rte_latencystats_init(), the latency of the packets
+ * received on this port is measured from their hardware timestamp.
+ *
+ * @param port_id
+ *   Port identifier of the Tx queue.
+ * @param queue_id
+ *   Tx queue identifier.
+ * @param stats
+ *   Statistics of the queue.
+ * @return
+ *   0 on success, a negative errno value otherwise:
+ *   -EINVAL: invalid queue or NULL stats;
+ *   -ENOENT: no latency statistics for this port.
+ */
+__rte_experimental
+int rte_latencystats_queue_get(uint16_t port_id, uint16_t queue_id,
+			struct rte_latencystats_queue *stats);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Reset the latency statistics of a Tx queue.
+ *
+ * This function must not be called while packets are transmitted
+ * on the queue.
+ *
+ * @param port_id
+ *   Port identifier of the Tx queue.
+ * @param queue_id
+ *   Tx queue identifier.
+ * @return
+ *   0 on success, a negative errno value otherwise.
+ */
+__rte_experimental
+int rte_latencystats_queue_reset(uint16_t port_id, uint16_t queue_id);
+
 #ifdef __cplusplus
 }
 #endif
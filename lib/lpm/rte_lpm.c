@@ -58,6 +58,8 @@ struct __rte_lpm {
 	char name[RTE_LPM_NAMESIZE];        /**< Name of the lpm. */
 	uint32_t max_rules; /**< Max. balanced rules per lpm. */
 	uint32_t number_tbl8s; /**< Number of tbl8s. */
+	int flags; /**< Configuration flags. */
+	int socket_id; /**< Socket of the tbl8s. */
 	/**< Rule info table. */
 	struct rte_lpm_rule_info rule_info[RTE_LPM_MAX_DEPTH];
 	struct rte_lpm_rule *rules_tbl; /**< LPM rules. */
@@ -66,6 +68,7 @@ struct __rte_lpm {
 	struct rte_rcu_qsbr *v;		/* RCU QSBR variable. */
 	enum rte_lpm_qsbr_mode rcu_mode;/* Blocking, defer queue. */
 	struct rte_rcu_qsbr_dq *dq;	/* RCU QSBR defer queue. */
+	struct rte_lpm_rcu_config rcu_cfg; /* RCU config, to resize the dq. */
 };
 
 /* Macro to enable/disable run-time checks. */
@@ -243,6 +246,8 @@ rte_lpm_create(const char *name, int socket_id,
 	/* Save user arguments. */
 	i_lpm->max_rules = config->max_rules;
 	i_lpm->number_tbl8s = config->number_tbl8s;
+	i_lpm->flags = config->flags;
+	i_lpm->socket_id = socket_id;
 	strlcpy(i_lpm->name, name, sizeof(i_lpm->name));
 
 	te->data = i_lpm;
@@ -307,14 +312,46 @@ __lpm_rcu_qsbr_free_resource(void *p, void *data, unsigned int n)
 			zero_tbl8_entry.val, rte_memory_order_relaxed);
 }
 
+/* Create the defer queue of the freed tbl8 groups. */
+static struct rte_rcu_qsbr_dq *
+lpm_rcu_dq_create(struct __rte_lpm *i_lpm,
+		const struct rte_lpm_rcu_config *cfg)
+{
+	struct rte_rcu_qsbr_dq_parameters params = {0};
+	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
+	struct rte_rcu_qsbr_dq *dq;
+
+	if (snprintf(rcu_dq_name, sizeof(rcu_dq_name), "LPM_RCU_%s", i_lpm->name)
+			>= (int)sizeof(rcu_dq_name))
+		LPM_LOG(NOTICE, "LPM rcu defer queue name truncated to '%s'",
+			rcu_dq_name);
+
+	params.name = rcu_dq_name;
+	params.size = cfg->dq_size;
+	if (params.size == 0)
+		params.size = i_lpm->number_tbl8s;
+	params.trigger_reclaim_limit = cfg->reclaim_thd;
+	params.max_reclaim_size = cfg->reclaim_max;
+	if (params.max_reclaim_size == 0)
+		params.max_reclaim_size = RTE_LPM_RCU_DQ_RECLAIM_MAX;
+	params.esize = sizeof(uint32_t);	/* tbl8 group index */
+	params.free_fn = __lpm_rcu_qsbr_free_resource;
+	params.p = i_lpm;
+	params.v = cfg->v;
+	dq = rte_rcu_qsbr_dq_create(&params);
+	if (dq == NULL)
+		LPM_LOG(ERR, "LPM defer queue creation failed: %s",
+			rte_strerror(rte_errno));
+
+	return dq;
+}
+
 /* Associate QSBR variable with an LPM object.
  */
 RTE_EXPORT_SYMBOL(rte_lpm_rcu_qsbr_add)
 int
 rte_lpm_rcu_qsbr_add(struct rte_lpm *lpm, struct rte_lpm_rcu_config *cfg)
 {
-	struct rte_rcu_qsbr_dq_parameters params = {0};
-	char rcu_dq_name[RTE_RCU_QSBR_DQ_NAMESIZE];
 	struct __rte_lpm *i_lpm;
 
 	if (lpm == NULL || cfg == NULL) {
@@ -332,35 +369,16 @@ rte_lpm_rcu_qsbr_add(struct rte_lpm *lpm, struct rte_lpm_rcu_config *cfg)
 		/* No other things to do. */
 	} else if (cfg->mode == RTE_LPM_QSBR_MODE_DQ) {
 		/* Init QSBR defer queue. */
-		if (snprintf(rcu_dq_name, sizeof(rcu_dq_name), "LPM_RCU_%s", i_lpm->name)
-				>= (int)sizeof(rcu_dq_name))
-			LPM_LOG(NOTICE, "LPM rcu defer queue name truncated to '%s'",
-				rcu_dq_name);
-
-		params.name = rcu_dq_name;
-		params.size = cfg->dq_size;
-		if (params.size == 0)
-			params.size = i_lpm->number_tbl8s;
-		params.trigger_reclaim_limit = cfg->reclaim_thd;
-		params.max_reclaim_size = cfg->reclaim_max;
-		if (params.max_reclaim_size == 0)
-			params.max_reclaim_size = RTE_LPM_RCU_DQ_RECLAIM_MAX;
-		params.esize = sizeof(uint32_t);	/* tbl8 group index */
-		params.free_fn = __lpm_rcu_qsbr_free_resource;
-		params.p = i_lpm;
-		params.v = cfg->v;
-		i_lpm->dq = rte_rcu_qsbr_dq_create(&params);
-		if (i_lpm->dq == NULL) {
-			LPM_LOG(ERR, "LPM defer queue creation failed: %s",
-				rte_strerror(rte_errno));
+		i_lpm->dq = lpm_rcu_dq_create(i_lpm, cfg);
+		if (i_lpm->dq == NULL)
 			return 1;
-		}
 	} else {
 		rte_errno = EINVAL;
 		return 1;
 	}
 	i_lpm->rcu_mode = cfg->mode;
 	i_lpm->v = cfg->v;
+	i_lpm->rcu_cfg = *cfg;
 
 	return 0;
 }
@@ -541,10 +559,69 @@ _tbl8_alloc(struct __rte_lpm *i_lpm)
 	return -ENOSPC;
 }
 
+/*
+ * Double the tbl8 groups. The groups in use are copied to a new table,
+ * published to the readers before any new group is referenced from tbl24,
+ * and the previous table is freed once no reader can use it anymore.
+ */
+static int32_t
+tbl8_grow(struct __rte_lpm *i_lpm)
+{
+	struct rte_lpm_tbl_entry *tbl8, *old_tbl8 = i_lpm->lpm.tbl8;
+	uint32_t number_tbl8s;
+
+	if (!(i_lpm->flags & RTE_LPM_F_TBL8_GROW) || i_lpm->v == NULL ||
+			i_lpm->number_tbl8s >= RTE_LPM_MAX_TBL8_NUM_GROUPS)
+		return -ENOSPC;
+
+	number_tbl8s = i_lpm->number_tbl8s == 0 ? 1 :
+		RTE_MIN(i_lpm->number_tbl8s * 2,
+			(uint32_t)RTE_LPM_MAX_TBL8_NUM_GROUPS);
+	tbl8 = rte_zmalloc_socket(NULL, sizeof(struct rte_lpm_tbl_entry) *
+			RTE_LPM_TBL8_GROUP_NUM_ENTRIES * (size_t)number_tbl8s,
+			RTE_CACHE_LINE_SIZE, i_lpm->socket_id);
+	if (tbl8 == NULL) {
+		LPM_LOG(ERR, "LPM tbl8 memory allocation failed, %s keeps %u tbl8s",
+			i_lpm->name, i_lpm->number_tbl8s);
+		return -ENOMEM;
+	}
+	memcpy(tbl8, old_tbl8, sizeof(struct rte_lpm_tbl_entry) *
+			RTE_LPM_TBL8_GROUP_NUM_ENTRIES * i_lpm->number_tbl8s);
+
+	/* The copy of the groups should not leak after the new table. */
+	rte_atomic_store_explicit(
+		(struct rte_lpm_tbl_entry * __rte_atomic *)&i_lpm->lpm.tbl8,
+		tbl8, rte_memory_order_release);
+	/* Wait for the readers which may still index the previous table,
+	 * as they must not find there a group beyond its end.
+	 */
+	rte_rcu_qsbr_synchronize(i_lpm->v, RTE_QSBR_THRID_INVALID);
+	rte_free(old_tbl8);
+	i_lpm->number_tbl8s = number_tbl8s;
+
+	/* The defer queue sized after the tbl8s grows with them. All the
+	 * queued groups are reclaimable after the grace period above.
+	 */
+	if (i_lpm->dq != NULL && i_lpm->rcu_cfg.dq_size == 0 &&
+			rte_rcu_qsbr_dq_delete(i_lpm->dq) == 0) {
+		i_lpm->dq = lpm_rcu_dq_create(i_lpm, &i_lpm->rcu_cfg);
+		if (i_lpm->dq == NULL) {
+			LPM_LOG(WARNING, "LPM %s falls back to RCU sync mode",
+				i_lpm->name);
+			i_lpm->rcu_mode = RTE_LPM_QSBR_MODE_SYNC;
+		}
+	}
+
+	LPM_LOG(DEBUG, "LPM %s grown to %u tbl8s", i_lpm->name, number_tbl8s);
+
+	return 0;
+}
+
 static int32_t
 tbl8_alloc(struct __rte_lpm *i_lpm)
 {
 	int32_t group_idx; /* tbl8 group index. */
+	int32_t ret;
 
 	group_idx = _tbl8_alloc(i_lpm);
 	if (group_idx == -ENOSPC && i_lpm->dq != NULL) {
@@ -553,6 +630,11 @@ tbl8_alloc(struct __rte_lpm *i_lpm)
 				NULL, NULL, NULL) == 0)
 			group_idx = _tbl8_alloc(i_lpm);
 	}
+	if (group_idx == -ENOSPC) {
+		/* If there are still no tbl8 groups try to grow them. */
+		ret = tbl8_grow(i_lpm);
+		group_idx = ret == 0 ? _tbl8_alloc(i_lpm) : ret;
+	}
 
 	return group_idx;
 }
@@ -65,6 +65,18 @@ extern "C" {
 /** @internal Default RCU defer queue entries to reclaim in one go. */
 #define RTE_LPM_RCU_DQ_RECLAIM_MAX	16
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this flag may change without prior notice.
+ *
+ * Configuration flag to grow the tbl8 groups when they are all used,
+ * instead of failing to add the rule. The table of the tbl8 groups is
+ * then doubled, up to RTE_LPM_MAX_TBL8_NUM_GROUPS groups, and the previous
+ * table is freed after the grace period of the RCU QSBR variable,
+ * so the tbl8 groups only grow once rte_lpm_rcu_qsbr_add() is called.
+ */
+#define RTE_LPM_F_TBL8_GROW		0x1
+
 /** RCU reclamation modes */
 enum rte_lpm_qsbr_mode {
 	/** Create defer queue for reclaim. */
@@ -125,7 +137,7 @@ static_assert(sizeof(struct rte_lpm_tbl_entry) == sizeof(uint32_t),
 struct rte_lpm_config {
 	uint32_t max_rules;      /**< Max number of rules. */
 	uint32_t number_tbl8s;   /**< Number of tbl8s to allocate. */
-	int flags;               /**< This field is currently unused. */
+	int flags;               /**< Optional flags, RTE_LPM_F_*. */
 };
 
 /** @internal LPM structure. */
@@ -229,7 +241,9 @@ int rte_lpm_rcu_qsbr_add(struct rte_lpm *lpm, struct rte_lpm_rcu_config *cfg);
  * @param next_hop
  *   Next hop of the rule to be added to the LPM table
  * @return
- *   0 on success, negative value otherwise
+ *   0 on success, negative value otherwise:
+ *   -ENOSPC if the rules or the tbl8 groups are all used,
+ *   -ENOMEM if the tbl8 groups cannot grow.
  */
 int
 rte_lpm_add(struct rte_lpm *lpm, uint32_t ip, uint8_t depth, uint32_t next_hop);
@@ -2,9 +2,12 @@
  * Copyright(c) 2024 NVIDIA Corporation & Affiliates
  */
 
+#include <inttypes.h>
+
 #include <rte_errno.h>
 #include <eal_export.h>
 #include <rte_bitops.h>
+#include <rte_malloc.h>
 #include <rte_mempool.h>
 
 #include "rte_mbuf_history.h"
@@ -16,6 +19,16 @@
 RTE_EXPORT_SYMBOL(rte_mbuf_history_field_offset);
 int rte_mbuf_history_field_offset = -1;
 
+/* Sampled trace, read by the inline marking functions */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mbuf_history_trace_threshold, 26.03)
+RTE_ATOMIC(uint64_t) rte_mbuf_history_trace_threshold;
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mbuf_history_trace_lcores, 26.03)
+struct rte_mbuf_history_trace_lcore rte_mbuf_history_trace_lcores[RTE_MAX_LCORE];
+
+#ifdef RTE_MBUF_HISTORY_TRACE
+static uint32_t trace_sample_rate;
+#endif
+
 #ifdef RTE_MBUF_HISTORY_DEBUG
 
 #define HISTORY_LAST_MASK (RTE_BIT64(RTE_MBUF_HISTORY_BITS) - 1)
@@ -221,3 +234,95 @@ void rte_mbuf_history_init(void)
 	}
 #endif
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mbuf_history_trace_start, 26.03)
+int rte_mbuf_history_trace_start(uint32_t sample_rate, uint32_t ring_size)
+{
+#ifndef RTE_MBUF_HISTORY_TRACE
+	RTE_SET_USED(sample_rate);
+	RTE_SET_USED(ring_size);
+	MBUF_LOG(INFO, "mbuf history trace is not enabled");
+	return -ENOTSUP;
+#else
+	struct rte_mbuf_history_trace_lcore *trace;
+	unsigned int lcore_id;
+
+	if (sample_rate == 0 || ring_size == 0 || ring_size > RTE_BIT32(31))
+		return -EINVAL;
+	ring_size = rte_align32pow2(ring_size);
+
+	RTE_LCORE_FOREACH(lcore_id) {
+		trace = &rte_mbuf_history_trace_lcores[lcore_id];
+		if (trace->records != NULL) {
+			if (trace->mask != ring_size - 1)
+				return -EEXIST;
+			continue;
+		}
+
+		trace->records = rte_zmalloc_socket("mbuf_history_trace",
+				ring_size * sizeof(*trace->records), RTE_CACHE_LINE_SIZE,
+				rte_lcore_to_socket_id(lcore_id));
+		if (trace->records == NULL) {
+			MBUF_LOG(ERR, "Cannot allocate mbuf history trace of lcore %u",
+				lcore_id);
+			return -ENOMEM;
+		}
+		trace->mask = ring_size - 1;
+	}
+
+	trace_sample_rate = sample_rate;
+	rte_atomic_store_explicit(&rte_mbuf_history_trace_threshold,
+			RTE_BIT64(32) / sample_rate, rte_memory_order_relaxed);
+	return 0;
+#endif
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mbuf_history_trace_stop, 26.03)
+void rte_mbuf_history_trace_stop(void)
+{
+	rte_atomic_store_explicit(&rte_mbuf_history_trace_threshold, 0,
+			rte_memory_order_relaxed);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_mbuf_history_trace_dump, 26.03)
+void rte_mbuf_history_trace_dump(FILE *f)
+{
+#ifndef RTE_MBUF_HISTORY_TRACE
+	RTE_SET_USED(f);
+	MBUF_LOG(INFO, "mbuf history trace is not enabled");
+#else
+	const struct rte_mbuf_history_trace_lcore *trace;
+	struct rte_mbuf_history_record rec;
+	uint64_t head, first, i;
+	unsigned int lcore_id;
+
+	if (f == NULL) {
+		MBUF_LOG(ERR, "Invalid mbuf dump file");
+		return;
+	}
+
+	fprintf(f, "mbuf history trace: sample rate %u, tsc hz %" PRIu64 "\n",
+		trace_sample_rate, rte_get_tsc_hz());
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		trace = &rte_mbuf_history_trace_lcores[lcore_id];
+		if (trace->mask == 0)
+			continue;
+
+		head = rte_atomic_load_explicit(&trace->head, rte_memory_order_acquire);
+		first = head > trace->mask ? head - trace->mask - 1 : 0;
+		for (i = first; i < head; i++) {
+			rec = trace->records[i & trace->mask];
+
+			/* Skip the record if overwritten while being copied. */
+			rte_atomic_thread_fence(rte_memory_order_acquire);
+			if (rte_atomic_load_explicit(&trace->head,
+					rte_memory_order_relaxed) > i + trace->mask)
+				continue;
+
+			fprintf(f, "trace %u %" PRIu64 " %p %u 0x%08x\n",
+				lcore_id, rec.tsc, rec.m, rec.op, rec.ctx);
+		}
+	}
+#endif
+}
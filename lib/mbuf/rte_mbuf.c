@@ -19,6 +19,7 @@
 #include <rte_hexdump.h>
 #include <rte_errno.h>
 #include <rte_memcpy.h>
+#include <rte_ptr_compress.h>
 
 #include "mbuf_log.h"
 
@@ -61,7 +62,8 @@ rte_pktmbuf_pool_init(struct rte_mempool *mp, void *opaque_arg)
 			user_mbp_priv->mbuf_data_room_size) +
 		user_mbp_priv->mbuf_priv_size);
 	RTE_ASSERT((user_mbp_priv->flags &
-		    ~RTE_PKTMBUF_POOL_F_PINNED_EXT_BUF) == 0);
+		    ~(RTE_PKTMBUF_POOL_F_PINNED_EXT_BUF |
+		      RTE_PKTMBUF_POOL_F_HDR_SEG)) == 0);
 
 	mbp_priv = rte_mempool_get_priv(mp);
 	memcpy(mbp_priv, user_mbp_priv, sizeof(*mbp_priv));
@@ -584,6 +586,152 @@ void rte_pktmbuf_free_bulk(struct rte_mbuf **mbufs, unsigned int count)
 		rte_mempool_put_bulk(pending[0]->pool, (void **)pending, nb_pending);
 }
 
+/* Helper to create a mbuf pool of header segments. */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pktmbuf_hdr_pool_create, 26.03)
+struct rte_mempool *
+rte_pktmbuf_hdr_pool_create(const char *name, unsigned int n,
+	unsigned int cache_size, int socket_id)
+{
+	struct rte_pktmbuf_pool_private *mbp_priv;
+	struct rte_mempool *mp;
+
+	mp = rte_pktmbuf_pool_create(name, n, cache_size, 0,
+		RTE_PKTMBUF_HDR_SEG_SIZE, socket_id);
+	if (mp == NULL)
+		return NULL;
+
+	mbp_priv = rte_mempool_get_priv(mp);
+	mbp_priv->flags |= RTE_PKTMBUF_POOL_F_HDR_SEG;
+
+	return mp;
+}
+
+/* Attach header segments to a packet, without atomics on the packet. */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pktmbuf_hdr_replicate, 26.03)
+int
+rte_pktmbuf_hdr_replicate(struct rte_mempool *hdr_pool, struct rte_mbuf *m,
+	struct rte_mbuf **hdrs, uint16_t count)
+{
+	uint16_t i;
+	int ret;
+
+	if (1 + m->nb_segs > RTE_MBUF_MAX_NB_SEGS)
+		return -EOVERFLOW;
+
+	ret = rte_pktmbuf_alloc_bulk(hdr_pool, hdrs, count);
+	if (ret != 0)
+		return ret;
+
+	rte_pktmbuf_hdr_share(m, count);
+	for (i = 0; i < count; i++)
+		rte_pktmbuf_hdr_attach(hdrs[i], m);
+
+	return 0;
+}
+
+/* Number of mbufs decompressed at once by the compressed bulk functions */
+#define MBUF_COMPRESSED_BURST 64U
+
+static void
+mbuf_compress(void *ptr_base, struct rte_mbuf **src, void *dst,
+	unsigned int n, unsigned int esize, uint8_t bit_shift)
+{
+	if (esize == sizeof(uint32_t))
+		rte_ptr_compress_32_shift(ptr_base, (void **)src, dst, n,
+			bit_shift);
+	else
+		rte_ptr_compress_16_shift(ptr_base, (void **)src, dst, n,
+			bit_shift);
+}
+
+static void
+mbuf_decompress(void *ptr_base, const void *src, struct rte_mbuf **dst,
+	unsigned int n, unsigned int esize, uint8_t bit_shift)
+{
+	if (esize == sizeof(uint32_t))
+		rte_ptr_decompress_32_shift(ptr_base, src, (void **)dst, n,
+			bit_shift);
+	else
+		rte_ptr_decompress_16_shift(ptr_base, src, (void **)dst, n,
+			bit_shift);
+}
+
+static void
+mbuf_free_bulk_compressed(const void *mbufs, unsigned int count,
+	void *ptr_base, unsigned int esize, uint8_t bit_shift)
+{
+	struct rte_mbuf *m[MBUF_COMPRESSED_BURST];
+	unsigned int done, n;
+
+	for (done = 0; done < count; done += n) {
+		n = RTE_MIN(count - done, MBUF_COMPRESSED_BURST);
+		mbuf_decompress(ptr_base, RTE_PTR_ADD(mbufs, done * esize), m,
+			n, esize, bit_shift);
+		rte_pktmbuf_free_bulk(m, n);
+	}
+}
+
+static int
+mbuf_alloc_bulk_compressed(struct rte_mempool *pool, void *mbufs,
+	unsigned int count, void *ptr_base, unsigned int esize,
+	uint8_t bit_shift)
+{
+	struct rte_mbuf *m[MBUF_COMPRESSED_BURST];
+	unsigned int done, n;
+	int rc;
+
+	for (done = 0; done < count; done += n) {
+		n = RTE_MIN(count - done, MBUF_COMPRESSED_BURST);
+		rc = rte_pktmbuf_alloc_bulk(pool, m, n);
+		if (unlikely(rc != 0)) {
+			/* all or nothing, give back the first bursts */
+			mbuf_free_bulk_compressed(mbufs, done, ptr_base, esize,
+				bit_shift);
+			return rc;
+		}
+		mbuf_compress(ptr_base, m, RTE_PTR_ADD(mbufs, done * esize),
+			n, esize, bit_shift);
+	}
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pktmbuf_alloc_bulk_compressed_32, 26.03)
+int
+rte_pktmbuf_alloc_bulk_compressed_32(struct rte_mempool *pool,
+	uint32_t *mbufs, unsigned int count, void *ptr_base, uint8_t bit_shift)
+{
+	return mbuf_alloc_bulk_compressed(pool, mbufs, count, ptr_base,
+		sizeof(uint32_t), bit_shift);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pktmbuf_free_bulk_compressed_32, 26.03)
+void
+rte_pktmbuf_free_bulk_compressed_32(const uint32_t *mbufs, unsigned int count,
+	void *ptr_base, uint8_t bit_shift)
+{
+	mbuf_free_bulk_compressed(mbufs, count, ptr_base, sizeof(uint32_t),
+		bit_shift);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pktmbuf_alloc_bulk_compressed_16, 26.03)
+int
+rte_pktmbuf_alloc_bulk_compressed_16(struct rte_mempool *pool,
+	uint16_t *mbufs, unsigned int count, void *ptr_base, uint8_t bit_shift)
+{
+	return mbuf_alloc_bulk_compressed(pool, mbufs, count, ptr_base,
+		sizeof(uint16_t), bit_shift);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pktmbuf_free_bulk_compressed_16, 26.03)
+void
+rte_pktmbuf_free_bulk_compressed_16(const uint16_t *mbufs, unsigned int count,
+	void *ptr_base, uint8_t bit_shift)
+{
+	mbuf_free_bulk_compressed(mbufs, count, ptr_base, sizeof(uint16_t),
+		bit_shift);
+}
+
 /* Creates a shallow copy of mbuf */
 RTE_EXPORT_SYMBOL(rte_pktmbuf_clone)
 struct rte_mbuf *
@@ -339,6 +339,23 @@ rte_pktmbuf_priv_flags(struct rte_mempool *mp)
 #define RTE_MBUF_HAS_PINNED_EXTBUF(mb) \
 	(rte_pktmbuf_priv_flags(mb->pool) & RTE_PKTMBUF_POOL_F_PINNED_EXT_BUF)
 
+/**
+ * This flag indicates the mbuf pool is a header segment pool, created
+ * with rte_pktmbuf_hdr_pool_create(). Its mbufs have a small data room,
+ * all of it headroom, to be prepended with headers and attached in front
+ * of a payload with rte_pktmbuf_hdr_attach().
+ */
+#define RTE_PKTMBUF_POOL_F_HDR_SEG (1 << 1)
+
+/**
+ * Returns non zero if given mbuf is a header segment, or zero otherwise.
+ */
+#define RTE_MBUF_IS_HDR_SEG(mb) \
+	(rte_pktmbuf_priv_flags(mb->pool) & RTE_PKTMBUF_POOL_F_HDR_SEG)
+
+/** Data room size of header segment mbufs. */
+#define RTE_PKTMBUF_HDR_SEG_SIZE 128
+
 #if defined RTE_LIBRTE_MBUF_DEBUG || defined __DOXYGEN__
 
 /** Check reinitialized mbuf type in debug mode. */
@@ -673,6 +690,73 @@ rte_mbuf_raw_alloc_bulk(struct rte_mempool *mp, struct rte_mbuf **mbufs, unsigne
 	return rc;
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Allocate uninitialized mbufs by contiguous blocks from mempool *mp*.
+ *
+ * The mbufs of each block are adjacent in memory and returned in address
+ * order, so that a PMD refilling its Rx descriptors with them writes
+ * the descriptors and touches the mbufs sequentially.
+ * The mempool driver must support contiguous blocks dequeue,
+ * see rte_mempool_get_contig_blocks().
+ * The mbufs are initialized as by rte_mbuf_raw_alloc_bulk().
+ *
+ * @param mp
+ *   The mempool from which mbufs are allocated.
+ * @param mbufs
+ *   Array of pointers to mbufs, of size n_blocks * block_size.
+ * @param n_blocks
+ *   Number of blocks to allocate.
+ * @param block_size
+ *   Number of mbufs per block, the contig_block_size
+ *   given by rte_mempool_ops_get_info().
+ * @return
+ *   - 0: Success.
+ *   - -EINVAL: *block_size* is not the block size of the mempool driver.
+ *   - -ENOBUFS: Not enough blocks in the mempool; no mbufs are retrieved.
+ *   - -EOPNOTSUPP: The mempool driver does not support block dequeue.
+ */
+__rte_experimental
+static inline int
+rte_mbuf_raw_alloc_contig_blocks(struct rte_mempool *mp, struct rte_mbuf **mbufs,
+		unsigned int n_blocks, unsigned int block_size)
+{
+	size_t elt_size = mp->header_size + mp->elt_size + mp->trailer_size;
+	struct rte_mempool_info info;
+	unsigned int blk, idx;
+	int rc;
+
+	/* The expansion below must match the blocks of the driver */
+	rc = rte_mempool_ops_get_info(mp, &info);
+	if (unlikely(rc != 0 || info.contig_block_size == 0))
+		return -EOPNOTSUPP;
+	if (unlikely(block_size != info.contig_block_size))
+		return -EINVAL;
+
+	/* First mbufs are stored at the beginning of the array */
+	rc = rte_mempool_get_contig_blocks(mp, (void **)mbufs, n_blocks);
+	if (unlikely(rc != 0))
+		return rc;
+
+	/* Expand from the last block, not to overwrite a first mbuf */
+	for (blk = n_blocks; blk-- > 0; ) {
+		uint8_t *first = (uint8_t *)mbufs[blk];
+		struct rte_mbuf **blk_mbufs = &mbufs[blk * block_size];
+
+		for (idx = block_size; idx-- > 0; ) {
+			blk_mbufs[idx] = (struct rte_mbuf *)(first + idx * elt_size);
+			__rte_mbuf_raw_sanity_check_mp(blk_mbufs[idx], mp);
+		}
+	}
+
+	rte_mbuf_history_mark_bulk(mbufs, n_blocks * block_size,
+			RTE_MBUF_HISTORY_OP_LIB_ALLOC);
+
+	return 0;
+}
+
 /**
  * Put mbuf back into its original mempool.
  *
@@ -905,6 +989,37 @@ rte_pktmbuf_pool_create_extbuf(const char *name, unsigned int n,
 	const struct rte_pktmbuf_extmem *ext_mem,
 	unsigned int ext_num);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a mbuf pool of header segments.
+ *
+ * The mbufs have a data room of RTE_PKTMBUF_HDR_SEG_SIZE bytes, which is
+ * all headroom after reset: headers are written with rte_pktmbuf_prepend()
+ * and the header segment is put in front of a payload with
+ * rte_pktmbuf_hdr_attach().
+ *
+ * @param name
+ *   The name of the mbuf pool.
+ * @param n
+ *   The number of elements in the mbuf pool.
+ * @param cache_size
+ *   Size of the per-core object cache. See rte_mempool_create() for
+ *   details.
+ * @param socket_id
+ *   The socket identifier where the memory should be allocated. The
+ *   value can be *SOCKET_ID_ANY* if there is no NUMA constraint for the
+ *   reserved zone.
+ * @return
+ *   The pointer to the new allocated mempool, on success. NULL on error
+ *   with rte_errno set appropriately, as for rte_pktmbuf_pool_create().
+ */
+__rte_experimental
+struct rte_mempool *
+rte_pktmbuf_hdr_pool_create(const char *name, unsigned int n,
+	unsigned int cache_size, int socket_id);
+
 /**
  * Get the data room size of mbufs stored in a pktmbuf_pool
  *
@@ -1545,6 +1660,106 @@ static inline void rte_pktmbuf_free(struct rte_mbuf *m)
  */
 void rte_pktmbuf_free_bulk(struct rte_mbuf **mbufs, unsigned int count);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Allocate a bulk of mbufs into an array of 32-bit compressed pointers,
+ * as done by rte_pktmbuf_alloc_bulk().
+ *
+ * The mbufs are stored as offsets from ptr_base, right shifted by
+ * bit_shift, see rte_ptr_compress_32_shift().
+ *
+ *  @param pool
+ *    The mempool from which mbufs are allocated.
+ *  @param mbufs
+ *    Array of compressed pointers to mbufs.
+ *  @param count
+ *    Array size.
+ *  @param ptr_base
+ *    Base of the memory region of the pool.
+ *  @param bit_shift
+ *    Number of bits dropped from the offsets, allowed by the alignment of
+ *    the mbufs.
+ *  @return
+ *   - 0: Success
+ *   - -ENOENT: Not enough entries in the mempool; no mbufs are retrieved.
+ */
+__rte_experimental
+int rte_pktmbuf_alloc_bulk_compressed_32(struct rte_mempool *pool,
+	uint32_t *mbufs, unsigned int count, void *ptr_base,
+	uint8_t bit_shift);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free a bulk of packet mbufs given as 32-bit compressed pointers,
+ * as done by rte_pktmbuf_free_bulk().
+ *
+ *  @param mbufs
+ *    Array of compressed pointers to packet mbufs, without NULL pointers.
+ *  @param count
+ *    Array size.
+ *  @param ptr_base
+ *    Base used to compress the pointers.
+ *  @param bit_shift
+ *    Shift used to compress the pointers.
+ */
+__rte_experimental
+void rte_pktmbuf_free_bulk_compressed_32(const uint32_t *mbufs,
+	unsigned int count, void *ptr_base, uint8_t bit_shift);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Allocate a bulk of mbufs into an array of 16-bit compressed pointers,
+ * as done by rte_pktmbuf_alloc_bulk().
+ *
+ * The mbufs are stored as offsets from ptr_base, right shifted by
+ * bit_shift, see rte_ptr_compress_16_shift().
+ *
+ *  @param pool
+ *    The mempool from which mbufs are allocated.
+ *  @param mbufs
+ *    Array of compressed pointers to mbufs.
+ *  @param count
+ *    Array size.
+ *  @param ptr_base
+ *    Base of the memory region of the pool.
+ *  @param bit_shift
+ *    Number of bits dropped from the offsets, allowed by the alignment of
+ *    the mbufs.
+ *  @return
+ *   - 0: Success
+ *   - -ENOENT: Not enough entries in the mempool; no mbufs are retrieved.
+ */
+__rte_experimental
+int rte_pktmbuf_alloc_bulk_compressed_16(struct rte_mempool *pool,
+	uint16_t *mbufs, unsigned int count, void *ptr_base,
+	uint8_t bit_shift);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free a bulk of packet mbufs given as 16-bit compressed pointers,
+ * as done by rte_pktmbuf_free_bulk().
+ *
+ *  @param mbufs
+ *    Array of compressed pointers to packet mbufs, without NULL pointers.
+ *  @param count
+ *    Array size.
+ *  @param ptr_base
+ *    Base used to compress the pointers.
+ *  @param bit_shift
+ *    Shift used to compress the pointers.
+ */
+__rte_experimental
+void rte_pktmbuf_free_bulk_compressed_16(const uint16_t *mbufs,
+	unsigned int count, void *ptr_base, uint8_t bit_shift);
+
 /**
  * Create a "clone" of the given packet mbuf.
  *
@@ -1890,6 +2105,106 @@ static inline int rte_pktmbuf_chain(struct rte_mbuf *head, struct rte_mbuf *tail
 	return 0;
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Give the reference of the caller on a packet to several header segments.
+ *
+ * The reference counter of each segment of the packet is set, instead of
+ * being incremented atomically, when the caller holds the only reference.
+ * Each header segment then takes one of the count references with
+ * rte_pktmbuf_hdr_attach(), and the packet is freed with the last chain.
+ *
+ * @param m
+ *   The packet mbuf, its segments must not be modified until all the
+ *   chains are freed.
+ * @param count
+ *   Number of header segments to be attached, must be strictly positive.
+ */
+__rte_experimental
+static inline void
+rte_pktmbuf_hdr_share(struct rte_mbuf *m, uint16_t count)
+{
+	for (; m != NULL; m = m->next) {
+		if (likely(rte_mbuf_refcnt_read(m) == 1))
+			rte_mbuf_refcnt_set(m, count);
+		else
+			rte_mbuf_refcnt_update(m, (int16_t)(count - 1));
+	}
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Put a header segment in front of a packet.
+ *
+ * The header segment takes one reference on the packet, it is not
+ * incremented: the caller gives its reference, or one of the references
+ * given by rte_pktmbuf_hdr_share(). The packet is not written, so that
+ * the same packet can be attached to several header segments at once.
+ * The metadata of the packet is copied to the header segment, which
+ * becomes the head of the chain.
+ *
+ * @param hdr
+ *   The header segment, a single segment direct mbuf, usually from a pool
+ *   created with rte_pktmbuf_hdr_pool_create().
+ * @param m
+ *   The packet mbuf.
+ * @return
+ *   - 0, on success.
+ *   - -EOVERFLOW, if the chain segment limit exceeded
+ */
+__rte_experimental
+static inline int
+rte_pktmbuf_hdr_attach(struct rte_mbuf *hdr, struct rte_mbuf *m)
+{
+	const uint64_t own_flags = RTE_MBUF_F_INDIRECT | RTE_MBUF_F_EXTERNAL;
+
+	RTE_ASSERT(hdr->next == NULL && hdr->nb_segs == 1);
+
+	if (1 + m->nb_segs > RTE_MBUF_MAX_NB_SEGS)
+		return -EOVERFLOW;
+
+	__rte_pktmbuf_copy_hdr(hdr, m);
+	hdr->ol_flags = (hdr->ol_flags & own_flags) | (m->ol_flags & ~own_flags);
+	hdr->next = m;
+	hdr->nb_segs = (uint16_t)(1 + m->nb_segs);
+	hdr->pkt_len = hdr->data_len + m->pkt_len;
+
+	return 0;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Replicate a packet behind several header segments.
+ *
+ * Allocate count header segments from hdr_pool, give the reference of the
+ * caller on the packet to them with rte_pktmbuf_hdr_share() and attach
+ * them in front of it. The headers are then prepended to each header
+ * segment with rte_pktmbuf_prepend(), e.g. one encapsulation per
+ * destination of a multicast packet.
+ *
+ * @param hdr_pool
+ *   The header segment pool.
+ * @param m
+ *   The packet mbuf.
+ * @param hdrs
+ *   Array filled with the header segments, heads of the chains.
+ * @param count
+ *   Number of header segments, must be strictly positive.
+ * @return
+ *   - 0, on success.
+ *   - -ENOENT, if not enough header segments, the packet is not modified.
+ *   - -EOVERFLOW, if the chain segment limit exceeded.
+ */
+__rte_experimental
+int rte_pktmbuf_hdr_replicate(struct rte_mempool *hdr_pool,
+	struct rte_mbuf *m, struct rte_mbuf **hdrs, uint16_t count);
+
 /**
  * For given input values generate raw tx_offload value.
  * Note that it is caller responsibility to make sure that input parameters
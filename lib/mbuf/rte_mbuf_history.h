@@ -22,10 +22,24 @@
  *
  * After dumping the history in a file,
  * the script dpdk-mbuf-history-parser.py can be used for parsing.
+ *
+ * With RTE_MBUF_HISTORY_TRACE, the same marks can also be traced
+ * in a sampled mode, cheap enough to be enabled in production:
+ * about 1 in N mbufs, selected from their address, are traced
+ * with a timestamp and a context (port and queue, node or ring),
+ * in per-lcore rings of fixed size, keeping the most recent records.
+ * The dumped trace is used by the parser script to reconstruct
+ * the path of the traced mbufs, their dwell time in each stage,
+ * and the mbufs which are never freed.
  */
 
+#include <stdio.h>
+
 #include <rte_common.h>
+#include <rte_cycles.h>
 #include <rte_debug.h>
+#include <rte_lcore.h>
+#include <rte_stdatomic.h>
 
 #include <rte_mbuf_dyn.h>
 
@@ -76,6 +90,42 @@ enum rte_mbuf_history_op {
  */
 extern int rte_mbuf_history_field_offset;
 
+/**
+ * Trace context of the Rx and Tx operations of an ethdev queue.
+ */
+#define RTE_MBUF_HISTORY_CTX_QUEUE(port_id, queue_id) \
+	((uint32_t)(port_id) << 16 | (uint16_t)(queue_id))
+
+/**
+ * Trace record of an mbuf operation.
+ */
+struct rte_mbuf_history_record {
+	uint64_t tsc; /**< TSC cycles of the operation */
+	const struct rte_mbuf *m; /**< Traced mbuf */
+	uint32_t ctx; /**< Context, port and queue or application-defined */
+	uint8_t op; /**< Operation of enum rte_mbuf_history_op */
+};
+
+/**
+ * Per-lcore ring of trace records, only written by its lcore.
+ */
+struct __rte_cache_aligned rte_mbuf_history_trace_lcore {
+	RTE_ATOMIC(uint64_t) head; /**< Number of records written */
+	uint32_t mask; /**< Ring size - 1, the ring is unused if 0 */
+	struct rte_mbuf_history_record *records; /**< Ring of records */
+};
+
+/**
+ * Sampling threshold of the trace, 2^32 / N to trace 1 in N mbufs,
+ * 0 if the trace is disabled.
+ */
+extern RTE_ATOMIC(uint64_t) rte_mbuf_history_trace_threshold;
+
+/**
+ * Trace rings of the lcores.
+ */
+extern struct rte_mbuf_history_trace_lcore rte_mbuf_history_trace_lcores[RTE_MAX_LCORE];
+
 /**
  * Initialize the mbuf history system.
  *
@@ -92,7 +142,46 @@ __rte_experimental
 void rte_mbuf_history_init(void);
 
 /**
- * Mark an mbuf with a history event.
+ * @internal
+ * Record an operation of an mbuf in the trace of the lcore,
+ * if the mbuf is sampled.
+ */
+static inline void
+__rte_mbuf_history_trace(const struct rte_mbuf *m, enum rte_mbuf_history_op op,
+		uint32_t ctx)
+{
+	uint64_t threshold = rte_atomic_load_explicit(&rte_mbuf_history_trace_threshold,
+			rte_memory_order_relaxed);
+	struct rte_mbuf_history_trace_lcore *trace;
+	struct rte_mbuf_history_record *rec;
+	unsigned int lcore_id;
+	uint64_t head;
+
+	if (likely(threshold == 0) || m == NULL)
+		return;
+
+	/* Same selection of the mbuf on every lcore, through all its life. */
+	if (((uint64_t)(uintptr_t)m * UINT64_C(0x9e3779b97f4a7c15) >> 32) >= threshold)
+		return;
+
+	lcore_id = rte_lcore_id();
+	if (unlikely(lcore_id >= RTE_MAX_LCORE))
+		return;
+	trace = &rte_mbuf_history_trace_lcores[lcore_id];
+	if (unlikely(trace->mask == 0))
+		return;
+
+	head = rte_atomic_load_explicit(&trace->head, rte_memory_order_relaxed);
+	rec = &trace->records[head & trace->mask];
+	rec->tsc = rte_rdtsc();
+	rec->m = m;
+	rec->ctx = ctx;
+	rec->op = op;
+	rte_atomic_store_explicit(&trace->head, head + 1, rte_memory_order_release);
+}
+
+/**
+ * Mark an mbuf with a history event, in a given context.
  *
  * @warning
  * @b EXPERIMENTAL: this API may change without prior notice.
@@ -101,9 +190,19 @@ void rte_mbuf_history_init(void);
  *   Pointer to the mbuf.
  * @param op
  *   The operation to record.
+ * @param ctx
+ *   Context of the operation, only recorded in the sampled trace:
+ *   RTE_MBUF_HISTORY_CTX_QUEUE() for Rx and Tx,
+ *   else an application-defined identifier of the node or ring.
  */
-static inline void rte_mbuf_history_mark(struct rte_mbuf *m, enum rte_mbuf_history_op op)
+static inline void rte_mbuf_history_mark_ctx(struct rte_mbuf *m,
+		enum rte_mbuf_history_op op, uint32_t ctx)
 {
+#ifdef RTE_MBUF_HISTORY_TRACE
+	__rte_mbuf_history_trace(m, op, ctx);
+#else
+	RTE_SET_USED(ctx);
+#endif
 #ifndef RTE_MBUF_HISTORY_DEBUG
 	RTE_SET_USED(m);
 	RTE_SET_USED(op);
@@ -127,7 +226,23 @@ static inline void rte_mbuf_history_mark(struct rte_mbuf *m, enum rte_mbuf_histo
 }
 
 /**
- * Mark multiple mbufs with a history event.
+ * Mark an mbuf with a history event.
+ *
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * @param m
+ *   Pointer to the mbuf.
+ * @param op
+ *   The operation to record.
+ */
+static inline void rte_mbuf_history_mark(struct rte_mbuf *m, enum rte_mbuf_history_op op)
+{
+	rte_mbuf_history_mark_ctx(m, op, 0);
+}
+
+/**
+ * Mark multiple mbufs with a history event, in a given context.
  *
  * @warning
  * @b EXPERIMENTAL: this API may change without prior notice.
@@ -138,25 +253,46 @@ static inline void rte_mbuf_history_mark(struct rte_mbuf *m, enum rte_mbuf_histo
  *   Number of mbufs to mark.
  * @param op
  *   The operation to record.
+ * @param ctx
+ *   Context of the operation, see rte_mbuf_history_mark_ctx().
  */
-static inline void rte_mbuf_history_mark_bulk(struct rte_mbuf * const *mbufs,
-		unsigned int count, enum rte_mbuf_history_op op)
+static inline void rte_mbuf_history_mark_bulk_ctx(struct rte_mbuf * const *mbufs,
+		unsigned int count, enum rte_mbuf_history_op op, uint32_t ctx)
 {
-#ifndef RTE_MBUF_HISTORY_DEBUG
+#if !defined(RTE_MBUF_HISTORY_DEBUG) && !defined(RTE_MBUF_HISTORY_TRACE)
 	RTE_SET_USED(mbufs);
 	RTE_SET_USED(count);
 	RTE_SET_USED(op);
+	RTE_SET_USED(ctx);
 #else
-	RTE_ASSERT(rte_mbuf_history_field_offset >= 0);
 	RTE_ASSERT(op < RTE_MBUF_HISTORY_OP_MAX);
 	if (unlikely(mbufs == NULL))
 		return;
 
 	while (count--)
-		rte_mbuf_history_mark(*mbufs++, op);
+		rte_mbuf_history_mark_ctx(*mbufs++, op, ctx);
 #endif
 }
 
+/**
+ * Mark multiple mbufs with a history event.
+ *
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * @param mbufs
+ *   Array of mbuf pointers.
+ * @param count
+ *   Number of mbufs to mark.
+ * @param op
+ *   The operation to record.
+ */
+static inline void rte_mbuf_history_mark_bulk(struct rte_mbuf * const *mbufs,
+		unsigned int count, enum rte_mbuf_history_op op)
+{
+	rte_mbuf_history_mark_bulk_ctx(mbufs, count, op, 0);
+}
+
 /**
  * Dump mbuf history for a single mbuf to a file.
  *
@@ -200,6 +336,56 @@ void rte_mbuf_history_dump_mempool(FILE *f, struct rte_mempool *mp);
 __rte_experimental
 void rte_mbuf_history_dump_all(FILE *f);
 
+/**
+ * Start the sampled trace of the mbuf operations.
+ *
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * The trace rings of the EAL lcores are allocated on the first call,
+ * and never freed, as the lcores write them without synchronization.
+ * Further calls only change the sampling rate.
+ *
+ * @param sample_rate
+ *   Trace about 1 in sample_rate mbufs, through all their operations.
+ * @param ring_size
+ *   Number of records kept per lcore, rounded up to a power of 2.
+ * @return
+ *   - 0 on success.
+ *   - -ENOTSUP if not compiled with RTE_MBUF_HISTORY_TRACE.
+ *   - -EINVAL if sample_rate or ring_size is 0.
+ *   - -EEXIST if the rings were allocated with another size.
+ *   - -ENOMEM if the rings cannot be allocated.
+ */
+__rte_experimental
+int rte_mbuf_history_trace_start(uint32_t sample_rate, uint32_t ring_size);
+
+/**
+ * Stop the sampled trace of the mbuf operations.
+ *
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * The records are kept for rte_mbuf_history_trace_dump().
+ */
+__rte_experimental
+void rte_mbuf_history_trace_stop(void);
+
+/**
+ * Dump the records of the sampled trace to a file.
+ *
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * The trace is better stopped before, else the records being overwritten
+ * during the dump are skipped.
+ *
+ * @param f
+ *   File pointer to write the trace to.
+ */
+__rte_experimental
+void rte_mbuf_history_trace_dump(FILE *f);
+
 #ifdef __cplusplus
 }
 #endif
@@ -17,6 +17,7 @@
 #include "rte_member_ht.h"
 #include "rte_member_vbf.h"
 #include "rte_member_sketch.h"
+#include "rte_member_cf.h"
 
 TAILQ_HEAD(rte_member_list, rte_tailq_entry);
 static struct rte_tailq_elem rte_member_tailq = {
@@ -81,6 +82,9 @@ rte_member_free(struct rte_member_setsum *setsum)
 	case RTE_MEMBER_TYPE_SKETCH:
 		rte_member_free_sketch(setsum);
 		break;
+	case RTE_MEMBER_TYPE_CF:
+		rte_member_free_cf(setsum);
+		break;
 	default:
 		break;
 	}
@@ -170,6 +174,9 @@ rte_member_create(const struct rte_member_parameters *params)
 	case RTE_MEMBER_TYPE_SKETCH:
 		ret = rte_member_create_sketch(setsum, params, sketch_key_ring);
 		break;
+	case RTE_MEMBER_TYPE_CF:
+		ret = rte_member_create_cf(setsum, params);
+		break;
 	default:
 		goto error_unlock_exit;
 	}
@@ -207,6 +214,8 @@ rte_member_add(const struct rte_member_setsum *setsum, const void *key,
 		return rte_member_add_vbf(setsum, key, set_id);
 	case RTE_MEMBER_TYPE_SKETCH:
 		return rte_member_add_sketch(setsum, key, set_id);
+	case RTE_MEMBER_TYPE_CF:
+		return rte_member_add_cf(setsum, key, set_id);
 	default:
 		return -EINVAL;
 	}
@@ -243,6 +252,8 @@ rte_member_lookup(const struct rte_member_setsum *setsum, const void *key,
 		return rte_member_lookup_vbf(setsum, key, set_id);
 	case RTE_MEMBER_TYPE_SKETCH:
 		return rte_member_lookup_sketch(setsum, key, set_id);
+	case RTE_MEMBER_TYPE_CF:
+		return rte_member_lookup_cf(setsum, key, set_id);
 	default:
 		return -EINVAL;
 	}
@@ -264,6 +275,9 @@ rte_member_lookup_bulk(const struct rte_member_setsum *setsum,
 	case RTE_MEMBER_TYPE_VBF:
 		return rte_member_lookup_bulk_vbf(setsum, keys, num_keys,
 				set_ids);
+	case RTE_MEMBER_TYPE_CF:
+		return rte_member_lookup_bulk_cf(setsum, keys, num_keys,
+				set_ids);
 	default:
 		return -EINVAL;
 	}
@@ -344,6 +358,38 @@ rte_member_report_heavyhitter(const struct rte_member_setsum *setsum,
 	}
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_member_set_window, 26.03)
+int
+rte_member_set_window(struct rte_member_setsum *setsum,
+		      uint32_t window_segments, uint64_t window_cycles)
+{
+	if (setsum == NULL || window_segments == 0)
+		return -EINVAL;
+
+	switch (setsum->type) {
+	case RTE_MEMBER_TYPE_SKETCH:
+		return rte_member_set_window_sketch(setsum, window_segments,
+				window_cycles);
+	default:
+		return -EINVAL;
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_member_rotate_window, 26.03)
+int
+rte_member_rotate_window(const struct rte_member_setsum *setsum)
+{
+	if (setsum == NULL)
+		return -EINVAL;
+
+	switch (setsum->type) {
+	case RTE_MEMBER_TYPE_SKETCH:
+		return rte_member_rotate_window_sketch(setsum);
+	default:
+		return -EINVAL;
+	}
+}
+
 RTE_EXPORT_SYMBOL(rte_member_delete)
 int
 rte_member_delete(const struct rte_member_setsum *setsum, const void *key,
@@ -358,6 +404,8 @@ rte_member_delete(const struct rte_member_setsum *setsum, const void *key,
 	/* current vBF implementation does not support delete function */
 	case RTE_MEMBER_TYPE_SKETCH:
 		return rte_member_delete_sketch(setsum, key);
+	case RTE_MEMBER_TYPE_CF:
+		return rte_member_delete_cf(setsum, key);
 	case RTE_MEMBER_TYPE_VBF:
 	default:
 		return -EINVAL;
@@ -380,6 +428,9 @@ rte_member_reset(const struct rte_member_setsum *setsum)
 	case RTE_MEMBER_TYPE_SKETCH:
 		rte_member_reset_sketch(setsum);
 		return;
+	case RTE_MEMBER_TYPE_CF:
+		rte_member_reset_cf(setsum);
+		return;
 	default:
 		return;
 	}
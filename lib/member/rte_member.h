@@ -13,7 +13,8 @@
  * used to test if a key belongs to certain sets. Two types of such
  * "set-summary" structures are implemented: hash-table based (HT) and vector
  * bloom filter (vBF). For HT setsummary, two subtypes or modes are available,
- * cache and non-cache modes. The table below summarize some properties of
+ * cache and non-cache modes. A sketch and a cuckoo filter (CF) are
+ * also available. The table below summarize some properties of
  * the different implementations.
  */
 
@@ -48,6 +49,19 @@
  * |properties| used for heavy hitter       |
  * |          | detection.                  |
  * +----------+-----------------------------+
+ * +==========+=============================+
+ * |   type   |      cf                     |
+ * +==========+=============================+
+ * |structure | cuckoo filter of 8 or 16-bit|
+ * |          | fingerprints                |
+ * +----------+-----------------------------+
+ * |set id    | 1: member, 0: not a member  |
+ * +----------+-----------------------------+
+ * |usages &  | single set, can delete,     |
+ * |properties| no false-negative, small    |
+ * |          | false-positive depend on    |
+ * |          | fingerprint size.           |
+ * +----------+-----------------------------+
  * -->
  */
 
@@ -59,6 +73,7 @@
 #include <inttypes.h>
 
 #include <rte_common.h>
+#include <rte_compat.h>
 
 /** The set ID type that stored internally in hash table based set summary. */
 typedef uint16_t member_set_t;
@@ -86,6 +101,8 @@ typedef uint16_t member_set_t;
 #define RTE_MEMBER_SKETCH_ALWAYS_BOUNDED 0x01
 /** For sketch, use the flag if to count packet size instead of packet count */
 #define RTE_MEMBER_SKETCH_COUNT_BYTE 0x02
+/** For cuckoo filter, use the flag to store 8-bit instead of 16-bit fingerprints */
+#define RTE_MEMBER_CF_FP_8BIT 0x04
 
 #ifdef __cplusplus
 extern "C" {
@@ -106,6 +123,7 @@ enum rte_member_setsum_type {
 	RTE_MEMBER_TYPE_HT = 0,  /**< Hash table based set summary. */
 	RTE_MEMBER_TYPE_VBF,     /**< Vector of bloom filters. */
 	RTE_MEMBER_TYPE_SKETCH,
+	RTE_MEMBER_TYPE_CF,      /**< Cuckoo filter. */
 	RTE_MEMBER_NUM_TYPE
 };
 
@@ -142,6 +160,7 @@ struct __rte_cache_aligned rte_member_setsum {
 	/* For runtime selecting AVX, scalar, etc for signature comparison. */
 	enum rte_member_sig_compare_function sig_cmp_fn;
 	uint8_t cache;			/* If it is cache mode for ht based. */
+	uint8_t fp_bits;		/* Fingerprint size of cuckoo filter. */
 
 	/* Vector bloom filter. */
 	uint32_t num_set;		/* Number of set (bf) in vbf. */
@@ -162,6 +181,7 @@ struct __rte_cache_aligned rte_member_setsum {
 	sketch_update_fn_t sketch_update; /* Pointer to the sketch update function */
 	sketch_lookup_fn_t sketch_lookup; /* Pointer to the sketch lookup function */
 	sketch_delete_fn_t sketch_delete; /* Pointer to the sketch delete function */
+	void *window;	/* Sliding window of the sketch, NULL if none. */
 
 	void *runtime_var;
 	uint32_t mul_shift;  /* vbf internal variable used during bit test. */
@@ -195,6 +215,9 @@ struct __rte_cache_aligned rte_member_parameters {
 	 *
 	 * vBF setsummary is a vector of bloom filters. It is used when number
 	 * of sets is not big (less than 32 for current implementation).
+	 *
+	 * CF setsummary is a cuckoo filter. It is used to test the membership
+	 * of a single set with support for deletion.
 	 */
 	enum rte_member_setsum_type type;
 
@@ -234,6 +257,9 @@ struct __rte_cache_aligned rte_member_parameters {
 	 * number of bits we need for each BF. User does not specify the size of
 	 * each BF directly because the optimal size depends on the num_keys
 	 * and false positive rate.
+	 *
+	 * For CF, num_keys is the expected number of keys. The table is sized
+	 * for a load of 95% at this number of keys.
 	 */
 	uint32_t num_keys;
 
@@ -278,8 +304,8 @@ struct __rte_cache_aligned rte_member_parameters {
 	/**
 	 * We use two seeds to calculate two independent hashes for each key.
 	 *
-	 * For HT type, one hash is used as signature, and the other is used
-	 * for bucket location.
+	 * For HT and CF types, one hash is used as signature, and the other is
+	 * used for bucket location.
 	 * For vBF type, these two hashes and their combinations are used as
 	 * hash locations to index the bit array.
 	 * For Sketch type, these seeds are not used.
@@ -464,6 +490,7 @@ rte_member_lookup_multi_bulk(const struct rte_member_setsum *setsum,
  *   For HT mode, the set_id has range as [1, 0x7FFF], MSB is reserved.
  *   For vBF mode the set id is limited by the num_set parameter when create
  *   the set-summary. For sketch mode, this id is ignored.
+ *   For CF mode, any set_id but 0 adds one more copy of the key.
  * @return
  *   HT (cache mode) and vBF should never fail unless the set_id is not in the
  *   valid range. In such case -EINVAL is returned.
@@ -474,6 +501,8 @@ rte_member_lookup_multi_bulk(const struct rte_member_setsum *setsum,
  *   Return 0 for HT (cache mode) if the add does not cause
  *   eviction, return 1 otherwise. Return 0 for non-cache mode if success,
  *   -ENOSPC for full, and 1 if cuckoo eviction happens.
+ *   For CF the same as non-cache mode applies; on -ENOSPC the filter is left
+ *   unchanged.
  *   Always returns 0 for vBF mode and sketch.
  */
 int
@@ -540,6 +569,59 @@ rte_member_report_heavyhitter(const struct rte_member_setsum *setsum,
 void
 rte_member_reset(const struct rte_member_setsum *setsum);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Add a sliding window to a sketch.
+ *
+ * With a sliding window, the counts cover only the packets added
+ * during the last window_segments segments of time: at each rotation,
+ * the counts of the oldest segment are dropped, and a new segment starts.
+ * It allows tracking the heavy hitters of the last seconds
+ * without resetting the whole sketch.
+ * The counts of the sketch are reset.
+ * Not thread safe with the other operations of the set-summary.
+ *
+ * @param setsum
+ *   Pointer to the set-summary.
+ * @param window_segments
+ *   Number of segments of the sliding window.
+ * @param window_cycles
+ *   Duration of a segment in timer cycles (see rte_get_timer_hz()).
+ *   The segments are rotated by the add, query and heavy hitter report
+ *   operations once this duration elapsed.
+ *   If 0, the segments are rotated only by rte_member_rotate_window().
+ * @return
+ *   0 on success, -EINVAL if the set-summary is not a sketch,
+ *   already has a sliding window or window_segments is 0,
+ *   -ENOMEM if the window cannot be allocated.
+ */
+__rte_experimental
+int
+rte_member_set_window(struct rte_member_setsum *setsum,
+		      uint32_t window_segments, uint64_t window_cycles);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Rotate the segments of a sketch with a sliding window:
+ * drop the counts of the oldest segment and start a new segment.
+ * To be called periodically, for example from a timer,
+ * when the window was set with window_cycles set to 0.
+ * Not thread safe with the other operations of the set-summary.
+ *
+ * @param setsum
+ *   Pointer to the set-summary.
+ * @return
+ *   0 on success, -EINVAL if the set-summary is not a sketch
+ *   with a sliding window.
+ */
+__rte_experimental
+int
+rte_member_rotate_window(const struct rte_member_setsum *setsum);
+
 /**
  * Delete items from the set-summary. Note that vBF does not support deletion
  * in current implementation. For vBF, error code of -EINVAL will be returned.
@@ -552,6 +634,9 @@ rte_member_reset(const struct rte_member_setsum *setsum);
  *   For HT mode, we need both key and its corresponding set_id to
  *   properly delete the key. Without set_id, we may delete other keys with the
  *   same signature.
+ *   For CF mode, set_id is ignored and one copy of the key is deleted.
+ *   Deleting a key that was never added may delete the fingerprint of
+ *   another key, which then gives a false-negative.
  * @return
  *   If no entry found to delete, an error code of -ENOENT could be returned.
  */
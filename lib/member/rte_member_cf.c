@@ -0,0 +1,322 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <string.h>
+
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_prefetch.h>
+#include <rte_random.h>
+#include <rte_log.h>
+#include <rte_vect.h>
+#include <rte_cpuflags.h>
+
+#include "member.h"
+#include "rte_member.h"
+#include "rte_member_cf.h"
+
+#if defined(RTE_ARCH_X86_64)
+#include "rte_member_cf_avx2.h"
+#endif
+
+/* Multiplier used to spread the fingerprint over the bucket index bits. */
+#define CF_ALT_HASH_MUL 0x5bd1e995U
+
+/*
+ * The table is an array of bucket_cnt * RTE_MEMBER_CF_BUCKET_ENTRIES
+ * fingerprints of fp_bits each. A zero fingerprint marks an empty entry.
+ */
+static inline uint16_t
+cf_get(const struct rte_member_setsum *ss, uint32_t idx)
+{
+	if (ss->fp_bits == 8)
+		return ((const uint8_t *)ss->table)[idx];
+	return ((const uint16_t *)ss->table)[idx];
+}
+
+static inline void
+cf_set(const struct rte_member_setsum *ss, uint32_t idx, uint16_t fp)
+{
+	if (ss->fp_bits == 8)
+		((uint8_t *)ss->table)[idx] = fp;
+	else
+		((uint16_t *)ss->table)[idx] = fp;
+}
+
+static inline uint32_t
+cf_alt_bucket(const struct rte_member_setsum *ss, uint32_t bkt, uint16_t fp)
+{
+	return (bkt ^ (fp * CF_ALT_HASH_MUL)) & ss->bucket_mask;
+}
+
+/*
+ * As for the HT non-cache mode, the first hash gives the fingerprint and
+ * the second one the primary bucket. The secondary bucket only depends on
+ * the primary one and the fingerprint so that an entry can be moved without
+ * the key. The fingerprint is hashed before the xor since it is shorter
+ * than the bucket index.
+ */
+static inline void
+get_buckets_index(const struct rte_member_setsum *ss, const void *key,
+		uint32_t *prim_bkt, uint32_t *sec_bkt, uint16_t *fp)
+{
+	uint32_t first_hash = MEMBER_HASH_FUNC(key, ss->key_len,
+						ss->prim_hash_seed);
+	uint32_t sec_hash = MEMBER_HASH_FUNC(&first_hash, sizeof(uint32_t),
+						ss->sec_hash_seed);
+
+	*fp = first_hash >> (32 - ss->fp_bits);
+	if (*fp == 0)
+		*fp = 1;
+	*prim_bkt = sec_hash & ss->bucket_mask;
+	*sec_bkt = cf_alt_bucket(ss, *prim_bkt, *fp);
+}
+
+static inline int
+search_bucket(const struct rte_member_setsum *ss, uint32_t bkt, uint16_t fp)
+{
+	uint32_t i;
+
+	for (i = 0; i < RTE_MEMBER_CF_BUCKET_ENTRIES; i++) {
+		if (cf_get(ss, bkt * RTE_MEMBER_CF_BUCKET_ENTRIES + i) == fp)
+			return i;
+	}
+	return -1;
+}
+
+int
+rte_member_create_cf(struct rte_member_setsum *ss,
+		const struct rte_member_parameters *params)
+{
+	uint32_t num_buckets;
+	size_t fp_size;
+
+	if (params->num_keys == 0 ||
+			params->num_keys > RTE_MEMBER_ENTRIES_MAX) {
+		rte_errno = EINVAL;
+		MEMBER_LOG(ERR,
+			"Membership CF create with invalid parameters");
+		return -EINVAL;
+	}
+
+	/* Size for a 95% load, which 4-entry buckets reach in practice. */
+	num_buckets = ((uint64_t)params->num_keys * 100 / 95 +
+			RTE_MEMBER_CF_BUCKET_ENTRIES - 1) /
+			RTE_MEMBER_CF_BUCKET_ENTRIES;
+	num_buckets = RTE_MAX(rte_align32pow2(num_buckets), 2U);
+
+	ss->fp_bits = (params->extra_flag & RTE_MEMBER_CF_FP_8BIT) ? 8 : 16;
+	fp_size = ss->fp_bits / 8;
+
+	ss->table = rte_zmalloc_socket(NULL,
+			(size_t)num_buckets * RTE_MEMBER_CF_BUCKET_ENTRIES *
+			fp_size, RTE_CACHE_LINE_SIZE, ss->socket_id);
+	if (ss->table == NULL) {
+		MEMBER_LOG(ERR, "memory allocation failed for CF "
+						"setsummary");
+		return -ENOMEM;
+	}
+
+	ss->bucket_cnt = num_buckets;
+	ss->bucket_mask = num_buckets - 1;
+
+#if defined(RTE_ARCH_X86_64)
+	if (rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2) &&
+			rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_256)
+		ss->sig_cmp_fn = RTE_MEMBER_COMPARE_AVX2;
+	else
+#endif
+		ss->sig_cmp_fn = RTE_MEMBER_COMPARE_SCALAR;
+
+	MEMBER_LOG(DEBUG, "Cuckoo filter created, "
+			"the table has %u buckets of %u-bit fingerprints",
+			num_buckets, ss->fp_bits);
+	return 0;
+}
+
+int
+rte_member_lookup_cf(const struct rte_member_setsum *ss,
+		const void *key, member_set_t *set_id)
+{
+	uint32_t prim_bucket, sec_bucket;
+	uint16_t fp;
+
+	get_buckets_index(ss, key, &prim_bucket, &sec_bucket, &fp);
+
+	if (search_bucket(ss, prim_bucket, fp) >= 0 ||
+			search_bucket(ss, sec_bucket, fp) >= 0) {
+		*set_id = RTE_MEMBER_CF_SET;
+		return 1;
+	}
+
+	*set_id = RTE_MEMBER_NO_MATCH;
+	return 0;
+}
+
+static uint32_t
+search_bulk_cf(const struct rte_member_setsum *ss, const uint32_t *bkts,
+		const uint16_t *fps, uint32_t num, member_set_t *set_ids)
+{
+	uint32_t i, num_matches = 0;
+
+	for (i = 0; i < num; i++) {
+		if (search_bucket(ss, bkts[2 * i], fps[i]) >= 0 ||
+				search_bucket(ss, bkts[2 * i + 1], fps[i]) >= 0) {
+			set_ids[i] = RTE_MEMBER_CF_SET;
+			num_matches++;
+		} else
+			set_ids[i] = RTE_MEMBER_NO_MATCH;
+	}
+	return num_matches;
+}
+
+uint32_t
+rte_member_lookup_bulk_cf(const struct rte_member_setsum *ss,
+		const void **keys, uint32_t num_keys, member_set_t *set_ids)
+{
+	uint32_t i, n, num_matches = 0;
+	uint32_t fp_size = ss->fp_bits / 8;
+	const uint8_t *table = ss->table;
+	/* Primary and secondary bucket of each key, interleaved. */
+	uint32_t bkts[2 * RTE_MEMBER_LOOKUP_BULK_MAX];
+	uint16_t fps[RTE_MEMBER_LOOKUP_BULK_MAX];
+
+	for (; num_keys != 0; num_keys -= n) {
+		n = RTE_MIN(num_keys, (uint32_t)RTE_MEMBER_LOOKUP_BULK_MAX);
+
+		for (i = 0; i < n; i++) {
+			get_buckets_index(ss, keys[i], &bkts[2 * i],
+					&bkts[2 * i + 1], &fps[i]);
+			rte_prefetch0(table + bkts[2 * i] *
+				RTE_MEMBER_CF_BUCKET_ENTRIES * fp_size);
+			rte_prefetch0(table + bkts[2 * i + 1] *
+				RTE_MEMBER_CF_BUCKET_ENTRIES * fp_size);
+		}
+
+		switch (ss->sig_cmp_fn) {
+#if defined(RTE_ARCH_X86_64)
+		case RTE_MEMBER_COMPARE_AVX2:
+			if (ss->fp_bits == 8)
+				num_matches += rte_member_search_bulk_cf8_avx2(
+					ss->table, bkts, fps, n, set_ids);
+			else
+				num_matches += rte_member_search_bulk_cf16_avx2(
+					ss->table, bkts, fps, n, set_ids);
+			break;
+#endif
+		default:
+			num_matches += search_bulk_cf(ss, bkts, fps, n,
+					set_ids);
+		}
+
+		keys += n;
+		set_ids += n;
+	}
+	return num_matches;
+}
+
+static inline int
+insert_empty(const struct rte_member_setsum *ss, uint32_t bkt, uint16_t fp)
+{
+	uint32_t i, idx;
+
+	for (i = 0; i < RTE_MEMBER_CF_BUCKET_ENTRIES; i++) {
+		idx = bkt * RTE_MEMBER_CF_BUCKET_ENTRIES + i;
+		if (cf_get(ss, idx) == 0) {
+			cf_set(ss, idx, fp);
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Random walk of displacements: the fingerprint takes the place of a
+ * random victim, which moves to its alternative bucket and so on.
+ * If no empty entry shows up, the swaps are undone so that no
+ * fingerprint already in the table gets lost.
+ */
+static int
+make_space_insert(const struct rte_member_setsum *ss, uint32_t bkt,
+		uint16_t fp)
+{
+	uint32_t path[RTE_MEMBER_CF_MAX_KICKS];
+	uint32_t i, idx;
+	uint16_t victim;
+	int n;
+
+	for (n = 0; n < RTE_MEMBER_CF_MAX_KICKS; n++) {
+		idx = bkt * RTE_MEMBER_CF_BUCKET_ENTRIES +
+			rte_rand_max(RTE_MEMBER_CF_BUCKET_ENTRIES);
+		victim = cf_get(ss, idx);
+		cf_set(ss, idx, fp);
+		path[n] = idx;
+
+		fp = victim;
+		bkt = cf_alt_bucket(ss, bkt, fp);
+		if (insert_empty(ss, bkt, fp))
+			return 1;
+	}
+
+	for (i = n; i-- != 0; ) {
+		victim = cf_get(ss, path[i]);
+		cf_set(ss, path[i], fp);
+		fp = victim;
+	}
+	return -ENOSPC;
+}
+
+int
+rte_member_add_cf(const struct rte_member_setsum *ss,
+		const void *key, member_set_t set_id)
+{
+	uint32_t prim_bucket, sec_bucket;
+	uint16_t fp;
+
+	if (set_id == RTE_MEMBER_NO_MATCH)
+		return -EINVAL;
+
+	get_buckets_index(ss, key, &prim_bucket, &sec_bucket, &fp);
+
+	if (insert_empty(ss, prim_bucket, fp) ||
+			insert_empty(ss, sec_bucket, fp))
+		return 0;
+
+	return make_space_insert(ss, prim_bucket, fp);
+}
+
+void
+rte_member_free_cf(struct rte_member_setsum *ss)
+{
+	rte_free(ss->table);
+}
+
+int
+rte_member_delete_cf(const struct rte_member_setsum *ss, const void *key)
+{
+	uint32_t prim_bucket, sec_bucket;
+	uint16_t fp;
+	int i;
+
+	get_buckets_index(ss, key, &prim_bucket, &sec_bucket, &fp);
+
+	i = search_bucket(ss, prim_bucket, fp);
+	if (i >= 0) {
+		cf_set(ss, prim_bucket * RTE_MEMBER_CF_BUCKET_ENTRIES + i, 0);
+		return 0;
+	}
+	i = search_bucket(ss, sec_bucket, fp);
+	if (i >= 0) {
+		cf_set(ss, sec_bucket * RTE_MEMBER_CF_BUCKET_ENTRIES + i, 0);
+		return 0;
+	}
+	return -ENOENT;
+}
+
+void
+rte_member_reset_cf(const struct rte_member_setsum *ss)
+{
+	memset(ss->table, 0, (size_t)ss->bucket_cnt *
+			RTE_MEMBER_CF_BUCKET_ENTRIES * (ss->fp_bits / 8));
+}
@@ -0,0 +1,128 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <rte_vect.h>
+
+#include "rte_member.h"
+#include "rte_member_cf.h"
+#include "rte_member_cf_avx2.h"
+
+/* Replicates an 8-bit fingerprint over both buckets of a key. */
+#define CF8_BROADCAST	0x0101010101010101ULL
+
+static inline int
+search_bucket_pair_cf8(const uint8_t *fps, uint32_t prim, uint32_t sec,
+		uint8_t sig)
+{
+	uint32_t i;
+
+	for (i = 0; i < RTE_MEMBER_CF_BUCKET_ENTRIES; i++) {
+		if (fps[prim * RTE_MEMBER_CF_BUCKET_ENTRIES + i] == sig ||
+				fps[sec * RTE_MEMBER_CF_BUCKET_ENTRIES + i] ==
+				sig)
+			return 1;
+	}
+	return 0;
+}
+
+static inline int
+search_bucket_pair_cf16(const uint16_t *fps, uint32_t prim, uint32_t sec,
+		uint16_t sig)
+{
+	uint32_t i;
+
+	for (i = 0; i < RTE_MEMBER_CF_BUCKET_ENTRIES; i++) {
+		if (fps[prim * RTE_MEMBER_CF_BUCKET_ENTRIES + i] == sig ||
+				fps[sec * RTE_MEMBER_CF_BUCKET_ENTRIES + i] ==
+				sig)
+			return 1;
+	}
+	return 0;
+}
+
+/*
+ * A bucket of 8-bit fingerprints is gathered as a 32-bit lane,
+ * so the two buckets of 4 keys are compared at once.
+ */
+uint32_t
+rte_member_search_bulk_cf8_avx2(const uint8_t *fps, const uint32_t *bkts,
+		const uint16_t *sigs, uint32_t num, member_set_t *set_ids)
+{
+	uint32_t i, k, hitmask, num_matches;
+	__m256i v_bkt, v_fps, v_sig;
+
+	num_matches = 0;
+	for (i = 0; i + 4 <= num; i += 4) {
+		v_bkt = _mm256_loadu_si256((const __m256i *)&bkts[2 * i]);
+		v_fps = _mm256_i32gather_epi32((const int *)fps, v_bkt,
+			RTE_MEMBER_CF_BUCKET_ENTRIES * sizeof(uint8_t));
+		v_sig = _mm256_set_epi64x(sigs[i + 3] * CF8_BROADCAST,
+			sigs[i + 2] * CF8_BROADCAST,
+			sigs[i + 1] * CF8_BROADCAST,
+			sigs[i] * CF8_BROADCAST);
+		hitmask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(v_fps, v_sig));
+		for (k = 0; k != 4; k++) {
+			if (((hitmask >> (k * 8)) & UINT8_MAX) != 0) {
+				set_ids[i + k] = RTE_MEMBER_CF_SET;
+				num_matches++;
+			} else
+				set_ids[i + k] = RTE_MEMBER_NO_MATCH;
+		}
+	}
+
+	for (; i < num; i++) {
+		if (search_bucket_pair_cf8(fps, bkts[2 * i], bkts[2 * i + 1],
+				sigs[i])) {
+			set_ids[i] = RTE_MEMBER_CF_SET;
+			num_matches++;
+		} else
+			set_ids[i] = RTE_MEMBER_NO_MATCH;
+	}
+	return num_matches;
+}
+
+/*
+ * A bucket of 16-bit fingerprints is gathered as a 64-bit lane,
+ * so the two buckets of 2 keys are compared at once.
+ */
+uint32_t
+rte_member_search_bulk_cf16_avx2(const uint16_t *fps, const uint32_t *bkts,
+		const uint16_t *sigs, uint32_t num, member_set_t *set_ids)
+{
+	uint32_t i, hitmask, num_matches;
+	__m256i v_fps, v_sig;
+	__m128i v_bkt;
+
+	num_matches = 0;
+	for (i = 0; i + 2 <= num; i += 2) {
+		v_bkt = _mm_loadu_si128((const __m128i *)&bkts[2 * i]);
+		v_fps = _mm256_i32gather_epi64((const long long *)fps, v_bkt,
+			RTE_MEMBER_CF_BUCKET_ENTRIES * sizeof(uint16_t));
+		v_sig = _mm256_inserti128_si256(
+			_mm256_castsi128_si256(_mm_set1_epi16(sigs[i])),
+			_mm_set1_epi16(sigs[i + 1]), 1);
+		hitmask = _mm256_movemask_epi8(
+			_mm256_cmpeq_epi16(v_fps, v_sig));
+		if ((hitmask & UINT16_MAX) != 0) {
+			set_ids[i] = RTE_MEMBER_CF_SET;
+			num_matches++;
+		} else
+			set_ids[i] = RTE_MEMBER_NO_MATCH;
+		if ((hitmask >> 16) != 0) {
+			set_ids[i + 1] = RTE_MEMBER_CF_SET;
+			num_matches++;
+		} else
+			set_ids[i + 1] = RTE_MEMBER_NO_MATCH;
+	}
+
+	for (; i < num; i++) {
+		if (search_bucket_pair_cf16(fps, bkts[2 * i], bkts[2 * i + 1],
+				sigs[i])) {
+			set_ids[i] = RTE_MEMBER_CF_SET;
+			num_matches++;
+		} else
+			set_ids[i] = RTE_MEMBER_NO_MATCH;
+	}
+	return num_matches;
+}
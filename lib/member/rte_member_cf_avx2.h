@@ -0,0 +1,28 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_MEMBER_CF_AVX2_H_
+#define _RTE_MEMBER_CF_AVX2_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Search the fingerprints in their two buckets.
+ * bkts holds the primary and secondary bucket of each key, interleaved.
+ */
+uint32_t
+rte_member_search_bulk_cf8_avx2(const uint8_t *fps, const uint32_t *bkts,
+		const uint16_t *sigs, uint32_t num, member_set_t *set_ids);
+
+uint32_t
+rte_member_search_bulk_cf16_avx2(const uint16_t *fps, const uint32_t *bkts,
+		const uint16_t *sigs, uint32_t num, member_set_t *set_ids);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_MEMBER_CF_AVX2_H_ */
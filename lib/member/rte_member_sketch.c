@@ -13,6 +13,7 @@
 #include <rte_random.h>
 #include <rte_prefetch.h>
 #include <rte_cpuflags.h>
+#include <rte_cycles.h>
 #include <rte_ring_elem.h>
 
 #include "member.h"
@@ -109,6 +110,57 @@ medianof5(uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t e)
 		return b > c ? c : b;
 }
 
+int
+rte_member_set_window_sketch(struct rte_member_setsum *ss,
+			     uint32_t num_seg, uint64_t seg_cycles)
+{
+	struct sketch_window *window;
+	size_t table_size = sizeof(uint64_t) * ss->num_col * ss->num_row;
+
+	if (ss->window != NULL)
+		return -EINVAL;
+
+	window = rte_zmalloc_socket(NULL, sizeof(*window),
+			RTE_CACHE_LINE_SIZE, ss->socket_id);
+	if (window == NULL) {
+		MEMBER_LOG(ERR, "Sketch Window allocation failed");
+		return -ENOMEM;
+	}
+
+	window->segments = rte_zmalloc_socket(NULL,
+			table_size * num_seg,
+			RTE_CACHE_LINE_SIZE, ss->socket_id);
+	if (window->segments == NULL) {
+		MEMBER_LOG(ERR, "Sketch Window Segments allocation failed");
+		rte_free(window);
+		return -ENOMEM;
+	}
+
+	window->num_seg = num_seg;
+	window->seg_cycles = seg_cycles;
+	ss->window = window;
+
+	/* the counters of the current segment are updated as well */
+#ifdef CC_AVX512_SUPPORT
+	if (ss->use_avx512 == true) {
+		ss->sketch_update = sketch_update_window_avx512;
+		ss->sketch_delete = sketch_delete_window_avx512;
+	} else
+#endif
+	{
+		ss->sketch_update = sketch_update_window_scalar;
+		ss->sketch_delete = sketch_delete_window_scalar;
+	}
+
+	/* the sum of the segments must match the sketch table */
+	rte_member_reset_sketch(ss);
+
+	MEMBER_LOG(DEBUG, "Sketch sliding window of %u segments",
+		window->num_seg);
+
+	return 0;
+}
+
 int
 rte_member_create_sketch(struct rte_member_setsum *ss,
 			 const struct rte_member_parameters *params,
@@ -315,12 +367,119 @@ sketch_delete_scalar(const struct rte_member_setsum *ss, const void *key)
 	}
 }
 
+void
+sketch_delete_window_scalar(const struct rte_member_setsum *ss, const void *key)
+{
+	const struct sketch_window *window = ss->window;
+	uint32_t table_size = ss->num_col * ss->num_row;
+	uint64_t *count_array = ss->table;
+	uint32_t cur_row, seg, idx;
+
+	for (cur_row = 0; cur_row < ss->num_row; cur_row++) {
+		idx = cur_row * ss->num_col + MEMBER_HASH_FUNC(key, ss->key_len,
+			ss->hash_seeds[cur_row]) % ss->num_col;
+
+		/* set the counter to 0 in the sum and in all the segments */
+		count_array[idx] = 0;
+		for (seg = 0; seg < window->num_seg; seg++)
+			window->segments[seg * table_size + idx] = 0;
+	}
+}
+
+/*
+ * Drop the counts of the oldest segment from the sum of the segments,
+ * and make it the new current segment.
+ */
+static void
+sketch_window_rotate(const struct rte_member_setsum *ss)
+{
+	struct sketch_window *window = ss->window;
+	uint32_t table_size = ss->num_col * ss->num_row;
+	uint64_t *count_array = ss->table;
+	uint64_t *oldest;
+	uint32_t i;
+
+	window->cur_seg = (window->cur_seg + 1) % window->num_seg;
+	oldest = &window->segments[(size_t)window->cur_seg * table_size];
+
+	for (i = 0; i < table_size; i++)
+		count_array[i] -= oldest[i];
+	memset(oldest, 0, sizeof(uint64_t) * table_size);
+	window->cur = oldest;
+}
+
+/*
+ * Update the counts of the top-k keys after some counts were dropped,
+ * removing the keys which are not in the window anymore.
+ */
+static void
+sketch_window_update_heap(const struct rte_member_setsum *ss)
+{
+	struct sketch_runtime *runtime_var = ss->runtime_var;
+	struct minheap *heap = &runtime_var->heap;
+	int i;
+
+	rte_member_update_heap(ss);
+
+	/* the counts decreased differently, restore the heap order */
+	for (i = (int)(heap->size / 2) - 1; i >= 0; i--)
+		rte_member_heapify(heap, i, true);
+
+	while (heap->size > 0 && heap->elem[0].count == 0)
+		rte_member_minheap_delete_node(heap, heap->elem[0].key,
+			runtime_var->key_slots, runtime_var->free_key_slots);
+}
+
+/* Rotate the segments whose duration elapsed */
+static inline void
+sketch_window_check(const struct rte_member_setsum *ss)
+{
+	struct sketch_window *window = ss->window;
+	uint64_t now, num_rotation;
+
+	if (window == NULL || window->seg_cycles == 0)
+		return;
+
+	now = rte_get_timer_cycles();
+	if (likely(now < window->next_rotation))
+		return;
+
+	num_rotation = (now - window->next_rotation) / window->seg_cycles + 1;
+	window->next_rotation += num_rotation * window->seg_cycles;
+
+	/* rotating all the segments clears them */
+	num_rotation = RTE_MIN(num_rotation, (uint64_t)window->num_seg);
+	while (num_rotation-- > 0)
+		sketch_window_rotate(ss);
+	sketch_window_update_heap(ss);
+}
+
+int
+rte_member_rotate_window_sketch(const struct rte_member_setsum *ss)
+{
+	struct sketch_window *window = ss->window;
+
+	if (window == NULL)
+		return -EINVAL;
+
+	sketch_window_rotate(ss);
+	sketch_window_update_heap(ss);
+	if (window->seg_cycles != 0)
+		window->next_rotation = rte_get_timer_cycles() +
+			window->seg_cycles;
+
+	return 0;
+}
+
 int
 rte_member_query_sketch(const struct rte_member_setsum *ss,
 			const void *key,
 			uint64_t *output)
 {
-	uint64_t count = ss->sketch_lookup(ss, key);
+	uint64_t count;
+
+	sketch_window_check(ss);
+	count = ss->sketch_lookup(ss, key);
 	*output = count;
 
 	return 0;
@@ -347,6 +506,7 @@ rte_member_report_heavyhitter_sketch(const struct rte_member_setsum *setsum,
 	uint32_t i;
 	struct sketch_runtime *runtime_var = setsum->runtime_var;
 
+	sketch_window_check(setsum);
 	rte_member_update_heap(setsum);
 	rte_member_heapsort(&(runtime_var->heap), runtime_var->report_array);
 
@@ -401,6 +561,12 @@ sketch_update_row(const struct rte_member_setsum *ss, const void *key,
 	/* sketch counter update */
 	count_array[cur_row * ss->num_col + col] +=
 			ceil(count / (ss->sample_rate));
+	if (ss->window != NULL) {
+		struct sketch_window *window = ss->window;
+
+		window->cur[cur_row * ss->num_col + col] +=
+			ceil(count / (ss->sample_rate));
+	}
 }
 
 void
@@ -419,6 +585,24 @@ sketch_update_scalar(const struct rte_member_setsum *ss,
 	}
 }
 
+void
+sketch_update_window_scalar(const struct rte_member_setsum *ss,
+			    const void *key,
+			    uint32_t count)
+{
+	const struct sketch_window *window = ss->window;
+	uint64_t *count_array = ss->table;
+	uint32_t idx;
+	uint32_t cur_row;
+
+	for (cur_row = 0; cur_row < ss->num_row; cur_row++) {
+		idx = cur_row * ss->num_col + MEMBER_HASH_FUNC(key, ss->key_len,
+				ss->hash_seeds[cur_row]) % ss->num_col;
+		count_array[idx] += count;
+		window->cur[idx] += count;
+	}
+}
+
 static void
 heap_update(const struct rte_member_setsum *ss, const void *key)
 {
@@ -478,6 +662,8 @@ rte_member_add_sketch(const struct rte_member_setsum *ss,
 		return -EINVAL;
 	}
 
+	sketch_window_check(ss);
+
 	if (ss->sample_rate == 1) {
 		ss->sketch_update(ss, key, 1);
 		heap_update(ss, key);
@@ -535,6 +721,8 @@ rte_member_add_sketch_byte_count(const struct rte_member_setsum *ss,
 		return -EINVAL;
 	}
 
+	sketch_window_check(ss);
+
 	/* there's specific optimization for the sketch update */
 	ss->sketch_update(ss, key, byte_count);
 
@@ -573,6 +761,12 @@ rte_member_free_sketch(struct rte_member_setsum *ss)
 	struct sketch_runtime *runtime_var = ss->runtime_var;
 
 	rte_free(ss->table);
+	if (ss->window != NULL) {
+		struct sketch_window *window = ss->window;
+
+		rte_free(window->segments);
+		rte_free(window);
+	}
 	rte_member_minheap_free(&runtime_var->heap);
 	rte_free(runtime_var->key_slots);
 	rte_ring_free(runtime_var->free_key_slots);
@@ -587,6 +781,15 @@ rte_member_reset_sketch(const struct rte_member_setsum *ss)
 	uint32_t i;
 
 	memset(sketch, 0, sizeof(uint64_t) * ss->num_col * ss->num_row);
+	if (ss->window != NULL) {
+		struct sketch_window *window = ss->window;
+
+		memset(window->segments, 0, sizeof(uint64_t) * window->num_seg *
+			ss->num_col * ss->num_row);
+		window->cur_seg = 0;
+		window->cur = window->segments;
+		window->next_rotation = rte_get_timer_cycles() + window->seg_cycles;
+	}
 	rte_member_minheap_reset(&runtime_var->heap);
 	rte_ring_reset(runtime_var->free_key_slots);
 
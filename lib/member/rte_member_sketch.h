@@ -19,6 +19,20 @@ extern "C" {
 #error sketch INTERVAL macro must be a power of 2
 #endif
 
+/*
+ * Sliding window of a sketch.
+ * The counters of each segment are kept apart,
+ * the sketch table holding the sum of all the segments.
+ */
+struct sketch_window {
+	uint64_t *segments;	/* num_seg tables of counters */
+	uint64_t *cur;		/* counters of the current segment */
+	uint32_t num_seg;
+	uint32_t cur_seg;
+	uint64_t seg_cycles;	/* duration of a segment, 0 if manually rotated */
+	uint64_t next_rotation;	/* timer cycles of the next rotation */
+};
+
 int
 rte_member_create_sketch(struct rte_member_setsum *ss,
 			 const struct rte_member_parameters *params,
@@ -42,6 +56,11 @@ sketch_update_scalar(const struct rte_member_setsum *ss,
 		     const void *key,
 		     uint32_t count);
 
+void
+sketch_update_window_scalar(const struct rte_member_setsum *ss,
+			    const void *key,
+			    uint32_t count);
+
 uint64_t
 sketch_lookup_scalar(const struct rte_member_setsum *ss,
 		     const void *key);
@@ -50,6 +69,10 @@ void
 sketch_delete_scalar(const struct rte_member_setsum *ss,
 		     const void *key);
 
+void
+sketch_delete_window_scalar(const struct rte_member_setsum *ss,
+			    const void *key);
+
 int
 rte_member_delete_sketch(const struct rte_member_setsum *setsum,
 			 const void *key);
@@ -64,6 +87,13 @@ rte_member_free_sketch(struct rte_member_setsum *ss);
 void
 rte_member_reset_sketch(const struct rte_member_setsum *setsum);
 
+int
+rte_member_set_window_sketch(struct rte_member_setsum *ss,
+			     uint32_t num_seg, uint64_t seg_cycles);
+
+int
+rte_member_rotate_window_sketch(const struct rte_member_setsum *setsum);
+
 int
 rte_member_report_heavyhitter_sketch(const struct rte_member_setsum *setsum,
 				     void **key, uint64_t *count);
@@ -68,3 +68,55 @@ sketch_delete_avx512(const struct rte_member_setsum *ss, const void *key)
 	for (cur_row = 0; cur_row < ss->num_row; cur_row++)
 		count_array[cur_row * ss->num_col + col[cur_row]] -= min;
 }
+
+void
+sketch_update_window_avx512(const struct rte_member_setsum *ss,
+			    const void *key,
+			    uint32_t count)
+{
+	const struct sketch_window *window = ss->window;
+	uint64_t *count_array = ss->table;
+	uint32_t num_col = ss->num_col;
+	__m256i v_hash_result;
+	__m512i v_count;
+
+	const __m256i v_idx = _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+	const __m256i v_col = _mm256_set1_epi32(num_col);
+
+	v_hash_result = rte_xxh64_sketch_avx512
+		(key, ss->key_len, *(__m512i *)ss->hash_seeds, num_col);
+	v_hash_result = _mm256_add_epi32(_mm256_mullo_epi32(v_idx, v_col),
+			v_hash_result);
+	v_count = _mm512_set1_epi64(count);
+
+	/* same counters in the sum of the segments and the current segment */
+	_mm512_i32scatter_epi64((void *)count_array, v_hash_result,
+		_mm512_add_epi64(_mm512_i32gather_epi64(v_hash_result,
+			(void *)count_array, 8), v_count), 8);
+	_mm512_i32scatter_epi64((void *)window->cur, v_hash_result,
+		_mm512_add_epi64(_mm512_i32gather_epi64(v_hash_result,
+			(void *)window->cur, 8), v_count), 8);
+}
+
+void
+sketch_delete_window_avx512(const struct rte_member_setsum *ss,
+			    const void *key)
+{
+	const struct sketch_window *window = ss->window;
+	uint64_t *count_array = ss->table;
+	uint32_t table_size = ss->num_col * ss->num_row;
+	uint32_t col[ss->num_row];
+	uint32_t cur_row, seg;
+
+	__m256i v_hash_result = rte_xxh64_sketch_avx512
+		(key, ss->key_len, *(__m512i *)ss->hash_seeds, ss->num_col);
+	_mm256_storeu_si256((__m256i *)col, v_hash_result);
+
+	/* set the counters to 0 in the sum and in all the segments */
+	for (cur_row = 0; cur_row < ss->num_row; cur_row++) {
+		count_array[cur_row * ss->num_col + col[cur_row]] = 0;
+		for (seg = 0; seg < window->num_seg; seg++)
+			window->segments[seg * table_size +
+				cur_row * ss->num_col + col[cur_row]] = 0;
+	}
+}
@@ -28,6 +28,15 @@ void
 sketch_delete_avx512(const struct rte_member_setsum *ss,
 		     const void *key);
 
+void
+sketch_update_window_avx512(const struct rte_member_setsum *ss,
+			    const void *key,
+			    uint32_t count);
+
+void
+sketch_delete_window_avx512(const struct rte_member_setsum *ss,
+			    const void *key);
+
 #ifdef __cplusplus
 }
 #endif
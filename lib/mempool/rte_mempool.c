@@ -52,10 +52,19 @@ static void
 mempool_event_callback_invoke(enum rte_mempool_event event,
 			      struct rte_mempool *mp);
 
-/* Note: avoid using floating point since that compiler
- * may not think that is constant.
+#define CALC_CACHE_FLUSHTHRESH(c) RTE_MEMPOOL_CACHE_FLUSHTHRESH(c)
+
+/* Name of the ops wrapping the common pool for RTE_MEMPOOL_F_SOCKET_RETURN. */
+#define SOCKET_RETURN_OPS_NAME "socket_return"
+
+/*
+ * State of the socket return handler. It wraps the ops of the common pool,
+ * which are still used through their index for the actual pool accesses.
  */
-#define CALC_CACHE_FLUSHTHRESH(c) (((c) * 3) / 2)
+struct rte_mempool_socket_return {
+	int32_t ops_index; /* Ops of the common pool. */
+	struct rte_ring *r[RTE_MAX_NUMA_NODES]; /* Return queue per socket. */
+};
 
 #if defined(RTE_ARCH_X86)
 /*
@@ -309,6 +318,16 @@ mempool_ops_alloc_once(struct rte_mempool *mp)
 		ret = rte_mempool_ops_alloc(mp);
 		if (ret != 0)
 			return ret;
+		/* wrap the ops of the common pool for the remote frees */
+		if (mp->socket_return != NULL) {
+			mp->socket_return->ops_index = mp->ops_index;
+			ret = rte_mempool_set_ops_byname(mp,
+				SOCKET_RETURN_OPS_NAME, mp->pool_config);
+			if (ret != 0) {
+				rte_mempool_ops_free(mp);
+				return ret;
+			}
+		}
 		mp->flags |= RTE_MEMPOOL_F_POOL_CREATED;
 	}
 	return 0;
@@ -722,6 +741,247 @@ rte_mempool_populate_anon(struct rte_mempool *mp)
 	return 0;
 }
 
+/* free the socket return queues of a mempool */
+static void
+mempool_socket_return_free(struct rte_mempool *mp)
+{
+	unsigned int socket_id;
+
+	if (mp->socket_return == NULL)
+		return;
+
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++)
+		rte_free(mp->socket_return->r[socket_id]);
+	rte_free(mp->socket_return);
+	mp->socket_return = NULL;
+}
+
+/*
+ * Allocate a return queue on each socket other than the mempool one, in
+ * the memory of that socket, so that remote frees stay local until they
+ * are given back in bursts.
+ */
+static int
+mempool_socket_return_create(struct rte_mempool *mp)
+{
+	const unsigned int count = RTE_MEMPOOL_SOCKET_RETURN_BURST * 4;
+	char name[RTE_RING_NAMESIZE];
+	struct rte_ring *r;
+	unsigned int i;
+	ssize_t size;
+	int socket_id;
+
+	mp->socket_return = rte_zmalloc_socket("MEMPOOL_SOCKET_RETURN",
+		sizeof(*mp->socket_return), 0, mp->socket_id);
+	if (mp->socket_return == NULL)
+		return -ENOMEM;
+
+	size = rte_ring_get_memsize(count);
+	if (size < 0)
+		return size;
+
+	for (i = 0; i < rte_socket_count(); i++) {
+		socket_id = rte_socket_id_by_idx(i);
+		if (socket_id < 0 || socket_id >= RTE_MAX_NUMA_NODES ||
+		    socket_id == mp->socket_id)
+			continue;
+
+		r = rte_zmalloc_socket("MEMPOOL_SOCKET_RETURN", size,
+			RTE_CACHE_LINE_SIZE, socket_id);
+		if (r == NULL)
+			return -ENOMEM;
+
+		/* not registered in the ring list, the name is informative */
+		snprintf(name, sizeof(name), "MP_return_%d", socket_id);
+		rte_ring_init(r, name, count, 0);
+		mp->socket_return->r[socket_id] = r;
+	}
+
+	return 0;
+}
+
+/* count the objects waiting on the socket return queues */
+static unsigned int
+mempool_socket_return_count(const struct rte_mempool *mp)
+{
+	unsigned int socket_id;
+	unsigned int count = 0;
+
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
+		if (mp->socket_return->r[socket_id] != NULL)
+			count += rte_ring_count(mp->socket_return->r[socket_id]);
+	}
+
+	return count;
+}
+
+/* ops of the common pool wrapped by the socket return handler */
+static struct rte_mempool_ops *
+socket_return_ops(const struct rte_mempool *mp)
+{
+	return rte_mempool_get_ops(mp->socket_return->ops_index);
+}
+
+/* give all the objects of the return queues back to the common pool */
+static unsigned int
+socket_return_drain(struct rte_mempool *mp)
+{
+	struct rte_mempool_ops *ops = socket_return_ops(mp);
+	void *objs[RTE_MEMPOOL_SOCKET_RETURN_BURST];
+	unsigned int socket_id;
+	unsigned int count, total = 0;
+	struct rte_ring *r;
+
+	for (socket_id = 0; socket_id < RTE_MAX_NUMA_NODES; socket_id++) {
+		r = mp->socket_return->r[socket_id];
+		if (r == NULL)
+			continue;
+
+		while ((count = rte_ring_dequeue_burst(r, objs,
+				RTE_MEMPOOL_SOCKET_RETURN_BURST, NULL)) > 0) {
+			ops->enqueue(mp, objs, count);
+			total += count;
+		}
+	}
+
+	return total;
+}
+
+/* the handler is only set on populate, over the ops of the common pool */
+static int
+socket_return_alloc(struct rte_mempool *mp __rte_unused)
+{
+	return -ENOTSUP;
+}
+
+static void
+socket_return_free(struct rte_mempool *mp)
+{
+	struct rte_mempool_ops *ops = socket_return_ops(mp);
+
+	if (ops->free != NULL)
+		ops->free(mp);
+}
+
+/*
+ * Queue objects freed on a remote socket on the return queue of that
+ * socket, and give the queued objects back once a burst is available.
+ */
+static int
+socket_return_enqueue(struct rte_mempool *mp, void * const *obj_table,
+		unsigned int n)
+{
+	struct rte_mempool_ops *ops = socket_return_ops(mp);
+	void *objs[RTE_MEMPOOL_SOCKET_RETURN_BURST];
+	unsigned int socket_id = rte_socket_id();
+	struct rte_ring *r = NULL;
+	unsigned int count;
+
+	/* no queue on the mempool socket */
+	if (socket_id < RTE_MAX_NUMA_NODES)
+		r = mp->socket_return->r[socket_id];
+
+	/* local or unknown socket, or queue full: put in the common pool */
+	if (r == NULL || rte_ring_enqueue_bulk(r, obj_table, n, NULL) == 0)
+		return ops->enqueue(mp, obj_table, n);
+
+	/* give the objects back with one remote enqueue per burst */
+	while (rte_ring_count(r) >= RTE_MEMPOOL_SOCKET_RETURN_BURST) {
+		count = rte_ring_dequeue_bulk(r, objs,
+			RTE_MEMPOOL_SOCKET_RETURN_BURST, NULL);
+		if (count == 0)
+			break;
+		ops->enqueue(mp, objs, count);
+	}
+
+	return 0;
+}
+
+/* objects may be waiting on the return queues when the pool is empty */
+static int
+socket_return_dequeue(struct rte_mempool *mp, void **obj_table,
+		unsigned int n)
+{
+	struct rte_mempool_ops *ops = socket_return_ops(mp);
+	int ret;
+
+	ret = ops->dequeue(mp, obj_table, n);
+	if (unlikely(ret < 0) && socket_return_drain(mp) > 0)
+		ret = ops->dequeue(mp, obj_table, n);
+
+	return ret;
+}
+
+static int
+socket_return_dequeue_contig_blocks(struct rte_mempool *mp,
+		void **first_obj_table, unsigned int n)
+{
+	struct rte_mempool_ops *ops = socket_return_ops(mp);
+
+	if (ops->dequeue_contig_blocks == NULL)
+		return -ENOTSUP;
+	return ops->dequeue_contig_blocks(mp, first_obj_table, n);
+}
+
+static unsigned int
+socket_return_get_count(const struct rte_mempool *mp)
+{
+	return socket_return_ops(mp)->get_count(mp) +
+		mempool_socket_return_count(mp);
+}
+
+static ssize_t
+socket_return_calc_mem_size(const struct rte_mempool *mp, uint32_t obj_num,
+		uint32_t pg_shift, size_t *min_chunk_size, size_t *align)
+{
+	struct rte_mempool_ops *ops = socket_return_ops(mp);
+
+	if (ops->calc_mem_size == NULL)
+		return rte_mempool_op_calc_mem_size_default(mp, obj_num,
+				pg_shift, min_chunk_size, align);
+	return ops->calc_mem_size(mp, obj_num, pg_shift, min_chunk_size, align);
+}
+
+static int
+socket_return_populate(struct rte_mempool *mp, unsigned int max_objs,
+		void *vaddr, rte_iova_t iova, size_t len,
+		rte_mempool_populate_obj_cb_t *obj_cb, void *obj_cb_arg)
+{
+	struct rte_mempool_ops *ops = socket_return_ops(mp);
+
+	if (ops->populate == NULL)
+		return rte_mempool_op_populate_default(mp, max_objs, vaddr,
+				iova, len, obj_cb, obj_cb_arg);
+	return ops->populate(mp, max_objs, vaddr, iova, len, obj_cb,
+			obj_cb_arg);
+}
+
+static int
+socket_return_get_info(const struct rte_mempool *mp,
+		struct rte_mempool_info *info)
+{
+	struct rte_mempool_ops *ops = socket_return_ops(mp);
+
+	if (ops->get_info == NULL)
+		return -ENOTSUP;
+	return ops->get_info(mp, info);
+}
+
+static const struct rte_mempool_ops socket_return_handler = {
+	.name = SOCKET_RETURN_OPS_NAME,
+	.alloc = socket_return_alloc,
+	.free = socket_return_free,
+	.enqueue = socket_return_enqueue,
+	.dequeue = socket_return_dequeue,
+	.get_count = socket_return_get_count,
+	.calc_mem_size = socket_return_calc_mem_size,
+	.populate = socket_return_populate,
+	.get_info = socket_return_get_info,
+	.dequeue_contig_blocks = socket_return_dequeue_contig_blocks,
+};
+
+RTE_MEMPOOL_REGISTER_OPS(socket_return_handler);
+
 /* free a mempool */
 RTE_EXPORT_SYMBOL(rte_mempool_free)
 void
@@ -751,6 +1011,7 @@ rte_mempool_free(struct rte_mempool *mp)
 	rte_mempool_trace_free(mp);
 	rte_mempool_free_memchunks(mp);
 	rte_mempool_ops_free(mp);
+	mempool_socket_return_free(mp);
 	rte_memzone_free(mp->mz);
 }
 
@@ -765,6 +1026,9 @@ mempool_cache_init(struct rte_mempool_cache *cache, uint32_t size)
 	cache->size = size;
 	cache->flushthresh = CALC_CACHE_FLUSHTHRESH(size);
 	cache->len = 0;
+	cache->calls = 0;
+	cache->trips = 0;
+	cache->low = 0;
 }
 
 /*
@@ -861,6 +1125,19 @@ rte_mempool_create_empty(const char *name, unsigned n, unsigned elt_size,
 		return NULL;
 	}
 
+	/* adaptive caches are bounded by the cache size */
+	if ((flags & RTE_MEMPOOL_F_ADAPTIVE_CACHE) != 0 && cache_size == 0) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	/* socket return queues need the socket of the objects */
+	if ((flags & RTE_MEMPOOL_F_SOCKET_RETURN) != 0 &&
+	    (socket_id < 0 || socket_id >= RTE_MAX_NUMA_NODES)) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
 	/*
 	 * No objects in the pool can be used for IO until it's populated
 	 * with at least some objects with valid IOVA.
@@ -947,6 +1224,15 @@ rte_mempool_create_empty(const char *name, unsigned n, unsigned elt_size,
 		goto exit_unlock;
 	}
 
+	if (flags & RTE_MEMPOOL_F_SOCKET_RETURN) {
+		ret = mempool_socket_return_create(mp);
+		if (ret < 0) {
+			RTE_MEMPOOL_LOG(ERR, "Cannot allocate socket return queues!");
+			rte_errno = -ret;
+			goto exit_unlock;
+		}
+	}
+
 	/*
 	 * local_cache pointer is set even if cache_size is zero.
 	 * The local_cache points to just past the elt_pa[] array.
@@ -1069,6 +1355,9 @@ rte_mempool_dump_cache(FILE *f, const struct rte_mempool *mp)
 			continue;
 		fprintf(f, "    cache_count[%u]=%"PRIu32"\n",
 			lcore_id, cache_count);
+		if (mp->flags & RTE_MEMPOOL_F_ADAPTIVE_CACHE)
+			fprintf(f, "    cache_size[%u]=%"PRIu32"\n",
+				lcore_id, mp->local_cache[lcore_id].size);
 		count += cache_count;
 	}
 	fprintf(f, "    total_cache_count=%u\n", count);
@@ -1287,6 +1576,9 @@ rte_mempool_dump(FILE *f, struct rte_mempool *mp)
 	if ((cache_count + common_count) > mp->size)
 		common_count = mp->size - cache_count;
 	fprintf(f, "  common_pool_count=%u\n", common_count);
+	if (mp->socket_return != NULL)
+		fprintf(f, "  socket_return_count=%u\n",
+			mempool_socket_return_count(mp));
 
 	/* sum and dump statistics */
 #ifdef RTE_LIBRTE_MEMPOOL_STATS
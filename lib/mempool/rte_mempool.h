@@ -38,6 +38,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <inttypes.h>
+#include <string.h>
 
 #include <rte_compat.h>
 #include <rte_config.h>
@@ -104,6 +105,10 @@ struct __rte_cache_aligned rte_mempool_cache {
 		uint64_t get_success_objs;  /**< Objects successfully allocated. */
 	} stats;                        /**< Statistics */
 #endif
+	/* Adaptive cache state, in the padding before the objects table. */
+	uint32_t calls;       /**< Gets and puts in the adaptive cache window */
+	uint32_t trips;       /**< Flushes and refills in the adaptive cache window */
+	uint32_t low;         /**< Lowest count in the adaptive cache window */
 	/**
 	 * Cache objects
 	 *
@@ -261,6 +266,13 @@ struct __rte_cache_aligned rte_mempool {
 	struct rte_mempool_objhdr_list elt_list; /**< List of objects in pool */
 	uint32_t nb_mem_chunks;          /**< Number of memory chunks */
 	struct rte_mempool_memhdr_list mem_list; /**< List of memory chunks */
+	/**
+	 * Per-socket return queues, when RTE_MEMPOOL_F_SOCKET_RETURN is set.
+	 * NULL otherwise.
+	 * Kept in the padding before the cache aligned statistics, so that
+	 * no member moves.
+	 */
+	struct rte_mempool_socket_return *socket_return;
 
 #ifdef RTE_LIBRTE_MEMPOOL_STATS
 	/** Per-lcore statistics.
@@ -310,6 +322,30 @@ struct __rte_cache_aligned rte_mempool {
 #define MEMPOOL_F_NO_IOVA_CONTIG	RTE_MEMPOOL_F_NO_IOVA_CONTIG
 /** Internal: no object from the pool can be used for device IO (DMA). */
 #define RTE_MEMPOOL_F_NON_IO		0x0040
+/**
+ * Objects freed on another socket than the mempool one are queued on a
+ * return queue of their socket, and given back to the mempool in bursts of
+ * RTE_MEMPOOL_SOCKET_RETURN_BURST objects. The mempool socket id must be
+ * set.
+ * Once the pool is populated, its ops are wrapped by the "socket_return"
+ * handler, so that only the accesses to the common pool are affected.
+ */
+#define RTE_MEMPOOL_F_SOCKET_RETURN	0x0080
+
+/** Number of objects given back at once from a socket return queue. */
+#define RTE_MEMPOOL_SOCKET_RETURN_BURST	512
+/**
+ * The size of each cache is adapted to the pattern of its lcore, between
+ * RTE_MEMPOOL_ADAPTIVE_CACHE_MIN and the cache size given at creation:
+ * it grows when the lcore often flushes or refills it, and shrinks when
+ * it holds idle objects. The cache size must not be zero.
+ */
+#define RTE_MEMPOOL_F_ADAPTIVE_CACHE	0x0100
+
+/** Minimum size of an adaptive cache. */
+#define RTE_MEMPOOL_ADAPTIVE_CACHE_MIN	16
+/** Number of gets and puts after which an adaptive cache is resized. */
+#define RTE_MEMPOOL_ADAPTIVE_CACHE_WINDOW	1024
 
 /**
  * This macro lists all the mempool flags an application may request.
@@ -319,6 +355,8 @@ struct __rte_cache_aligned rte_mempool {
 	| RTE_MEMPOOL_F_SP_PUT \
 	| RTE_MEMPOOL_F_SC_GET \
 	| RTE_MEMPOOL_F_NO_IOVA_CONTIG \
+	| RTE_MEMPOOL_F_SOCKET_RETURN \
+	| RTE_MEMPOOL_F_ADAPTIVE_CACHE \
 	)
 
 /**
@@ -861,6 +899,73 @@ rte_mempool_ops_enqueue_bulk(struct rte_mempool *mp, void * const *obj_table,
 	return ret;
 }
 
+/**
+ * @internal Flush threshold of a cache of the given size.
+ * Avoid floating point, so that the compiler sees a constant.
+ */
+#define RTE_MEMPOOL_CACHE_FLUSHTHRESH(size) (((size) * 3) / 2)
+
+/**
+ * @internal Resize an adaptive cache from the flushes, refills and idle
+ * objects of the last window, and start a new window.
+ * The coldest objects above a reduced size are given back to the mempool.
+ *
+ * @param mp
+ *   Pointer to the memory pool, with RTE_MEMPOOL_F_ADAPTIVE_CACHE set.
+ * @param cache
+ *   Pointer to a cache of the memory pool.
+ */
+static inline void
+rte_mempool_cache_adapt(struct rte_mempool *mp, struct rte_mempool_cache *cache)
+{
+	uint32_t min_size = RTE_MIN_T(RTE_MEMPOOL_ADAPTIVE_CACHE_MIN,
+		mp->cache_size, uint32_t);
+	uint32_t size = cache->size;
+	uint32_t excess;
+
+	if (cache->trips > RTE_MEMPOOL_ADAPTIVE_CACHE_WINDOW / 32)
+		size = RTE_MIN(size * 2, mp->cache_size);
+	else if (cache->low >= size / 2)
+		size = RTE_MAX(size / 2, min_size);
+
+	if (size != cache->size) {
+		cache->size = size;
+		cache->flushthresh = RTE_MEMPOOL_CACHE_FLUSHTHRESH(size);
+
+		if (cache->len > size) {
+			excess = cache->len - size;
+			rte_mempool_ops_enqueue_bulk(mp, cache->objs, excess);
+			memmove(cache->objs, &cache->objs[excess],
+				sizeof(void *) * size);
+			cache->len = size;
+		}
+	}
+
+	cache->calls = 0;
+	cache->trips = 0;
+	cache->low = cache->len;
+}
+
+/**
+ * @internal Account a get or a put in a cache, and resize it at the end of
+ * the window if it is adaptive.
+ *
+ * @param mp
+ *   Pointer to the memory pool.
+ * @param cache
+ *   Pointer to a cache of the memory pool.
+ */
+static __rte_always_inline void
+rte_mempool_cache_track(struct rte_mempool *mp, struct rte_mempool_cache *cache)
+{
+	if (unlikely(mp->flags & RTE_MEMPOOL_F_ADAPTIVE_CACHE)) {
+		if (cache->len < cache->low)
+			cache->low = cache->len;
+		if (unlikely(++cache->calls >= RTE_MEMPOOL_ADAPTIVE_CACHE_WINDOW))
+			rte_mempool_cache_adapt(mp, cache);
+	}
+}
+
 /**
  * @internal wrapper for mempool_ops get_count callback.
  *
@@ -1395,6 +1500,7 @@ rte_mempool_do_generic_put(struct rte_mempool *mp, void * const *obj_table,
 	/* Increment stats now, adding in mempool always succeeds. */
 	RTE_MEMPOOL_CACHE_STAT_ADD(cache, put_bulk, 1);
 	RTE_MEMPOOL_CACHE_STAT_ADD(cache, put_objs, n);
+	rte_mempool_cache_track(mp, cache);
 
 	__rte_assume(cache->flushthresh <= RTE_MEMPOOL_CACHE_MAX_SIZE * 2);
 	__rte_assume(cache->len <= RTE_MEMPOOL_CACHE_MAX_SIZE * 2);
@@ -1412,8 +1518,12 @@ rte_mempool_do_generic_put(struct rte_mempool *mp, void * const *obj_table,
 		cache_objs = &cache->objs[0];
 		rte_mempool_ops_enqueue_bulk(mp, cache_objs, cache->len);
 		cache->len = n;
+		if (unlikely(mp->flags & RTE_MEMPOOL_F_ADAPTIVE_CACHE))
+			cache->trips++;
 	} else {
 		/* The request itself is too big for the cache. */
+		if (unlikely(mp->flags & RTE_MEMPOOL_F_ADAPTIVE_CACHE))
+			cache->trips++;
 		goto driver_enqueue_stats_incremented;
 	}
 
@@ -1527,6 +1637,8 @@ rte_mempool_do_generic_get(struct rte_mempool *mp, void **obj_table,
 		goto driver_dequeue;
 	}
 
+	rte_mempool_cache_track(mp, cache);
+
 	/* The cache is a stack, so copy will be in reverse order. */
 	cache_objs = &cache->objs[cache->len];
 
@@ -1572,6 +1684,9 @@ rte_mempool_do_generic_get(struct rte_mempool *mp, void **obj_table,
 		return 0;
 	}
 
+	if (unlikely(mp->flags & RTE_MEMPOOL_F_ADAPTIVE_CACHE))
+		cache->trips++;
+
 	/* Dequeue below would overflow mem allocated for cache? */
 	if (unlikely(remaining > RTE_MEMPOOL_CACHE_MAX_SIZE))
 		goto driver_dequeue;
@@ -8,6 +8,7 @@
 
 #include <eal_export.h>
 #include <rte_cycles.h>
+#include <rte_prefetch.h>
 
 #include "rte_meter.h"
 
@@ -15,6 +16,9 @@
 #define RTE_METER_TB_PERIOD_MIN      100
 #endif
 
+/* Number of packets the meter of which is prefetched ahead of metering */
+#define RTE_METER_BULK_PREFETCH      4
+
 static void
 rte_meter_get_tb_params(uint64_t hz, uint64_t rate, uint64_t *tb_period, uint64_t *tb_bytes_per_period)
 {
@@ -165,3 +169,140 @@ rte_meter_trtcm_rfc4115_config(
 
 	return 0;
 }
+
+/*
+ * Bucket update of the bulk metering. The division is skipped when no period
+ * elapsed, which is the usual case of the packets of a busy meter.
+ */
+static inline void
+rte_meter_srtcm_update(struct rte_meter_srtcm *m,
+	const struct rte_meter_srtcm_profile *p, uint64_t time)
+{
+	uint64_t time_diff, n_periods, tc;
+
+	time_diff = time - m->time;
+	if (time_diff < p->cir_period)
+		return;
+	n_periods = time_diff / p->cir_period;
+	m->time += n_periods * p->cir_period;
+
+	/* Put the tokens overflowing from tc into te bucket */
+	tc = m->tc + n_periods * p->cir_bytes_per_period;
+	if (tc > p->cbs) {
+		m->te += (tc - p->cbs);
+		if (m->te > p->ebs)
+			m->te = p->ebs;
+		tc = p->cbs;
+	}
+	m->tc = tc;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_meter_srtcm_color_aware_check_bulk, 26.03)
+void
+rte_meter_srtcm_color_aware_check_bulk(struct rte_meter_srtcm **m,
+	struct rte_meter_srtcm_profile **p,
+	uint64_t time,
+	const uint32_t *pkt_len,
+	enum rte_color *pkt_color,
+	uint32_t n_pkts)
+{
+	struct rte_meter_srtcm *mi, *prev = NULL;
+	uint32_t i;
+
+	for (i = 0; i < n_pkts && i < RTE_METER_BULK_PREFETCH; i++)
+		rte_prefetch0(m[i]);
+
+	for (i = 0; i < n_pkts; i++) {
+		if (i + RTE_METER_BULK_PREFETCH < n_pkts)
+			rte_prefetch0(m[i + RTE_METER_BULK_PREFETCH]);
+
+		/* Bucket update, once per run of packets of the same meter */
+		mi = m[i];
+		if (mi != prev) {
+			rte_meter_srtcm_update(mi, p[i], time);
+			prev = mi;
+		}
+
+		/* Color logic */
+		if ((pkt_color[i] == RTE_COLOR_GREEN) && (mi->tc >= pkt_len[i])) {
+			mi->tc -= pkt_len[i];
+			continue;
+		}
+
+		if ((pkt_color[i] != RTE_COLOR_RED) && (mi->te >= pkt_len[i])) {
+			mi->te -= pkt_len[i];
+			pkt_color[i] = RTE_COLOR_YELLOW;
+			continue;
+		}
+
+		pkt_color[i] = RTE_COLOR_RED;
+	}
+}
+
+/* Bucket update of the bulk metering, see rte_meter_srtcm_update() */
+static inline void
+rte_meter_trtcm_update(struct rte_meter_trtcm *m,
+	const struct rte_meter_trtcm_profile *p, uint64_t time)
+{
+	uint64_t time_diff, n_periods;
+
+	time_diff = time - m->time_tc;
+	if (time_diff >= p->cir_period) {
+		n_periods = time_diff / p->cir_period;
+		m->time_tc += n_periods * p->cir_period;
+		m->tc += n_periods * p->cir_bytes_per_period;
+		if (m->tc > p->cbs)
+			m->tc = p->cbs;
+	}
+
+	time_diff = time - m->time_tp;
+	if (time_diff >= p->pir_period) {
+		n_periods = time_diff / p->pir_period;
+		m->time_tp += n_periods * p->pir_period;
+		m->tp += n_periods * p->pir_bytes_per_period;
+		if (m->tp > p->pbs)
+			m->tp = p->pbs;
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_meter_trtcm_color_aware_check_bulk, 26.03)
+void
+rte_meter_trtcm_color_aware_check_bulk(struct rte_meter_trtcm **m,
+	struct rte_meter_trtcm_profile **p,
+	uint64_t time,
+	const uint32_t *pkt_len,
+	enum rte_color *pkt_color,
+	uint32_t n_pkts)
+{
+	struct rte_meter_trtcm *mi, *prev = NULL;
+	uint32_t i;
+
+	for (i = 0; i < n_pkts && i < RTE_METER_BULK_PREFETCH; i++)
+		rte_prefetch0(m[i]);
+
+	for (i = 0; i < n_pkts; i++) {
+		if (i + RTE_METER_BULK_PREFETCH < n_pkts)
+			rte_prefetch0(m[i + RTE_METER_BULK_PREFETCH]);
+
+		/* Bucket update, once per run of packets of the same meter */
+		mi = m[i];
+		if (mi != prev) {
+			rte_meter_trtcm_update(mi, p[i], time);
+			prev = mi;
+		}
+
+		/* Color logic */
+		if ((pkt_color[i] == RTE_COLOR_RED) || (mi->tp < pkt_len[i])) {
+			pkt_color[i] = RTE_COLOR_RED;
+			continue;
+		}
+
+		mi->tp -= pkt_len[i];
+		if ((pkt_color[i] == RTE_COLOR_YELLOW) || (mi->tc < pkt_len[i])) {
+			pkt_color[i] = RTE_COLOR_YELLOW;
+			continue;
+		}
+
+		mi->tc -= pkt_len[i];
+	}
+}
@@ -17,6 +17,8 @@
 
 #include <stdint.h>
 
+#include <rte_compat.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -310,6 +312,70 @@ rte_meter_trtcm_rfc4115_color_aware_check(
 	uint32_t pkt_len,
 	enum rte_color pkt_color);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * srTCM color aware traffic metering of a burst of packets
+ *
+ * The packets are metered in order, each with its own meter and profile,
+ * a meter being always used with the same profile. The bucket update is done
+ * once for the consecutive packets of the same meter, so grouping the packets
+ * by meter saves the most. Color blind metering is done with all the input
+ * colors set to green.
+ *
+ * @param m
+ *    Handles to srTCM instances, one per packet
+ * @param p
+ *    srTCM profiles of the instances, one per packet
+ * @param time
+ *    Current CPU time stamp (measured in CPU cycles), same for all packets
+ * @param pkt_len
+ *    Lengths of the IP packets (measured in bytes)
+ * @param pkt_color
+ *    Input colors of the IP packets, replaced by their assigned colors
+ * @param n_pkts
+ *    Number of packets
+ */
+__rte_experimental
+void
+rte_meter_srtcm_color_aware_check_bulk(struct rte_meter_srtcm **m,
+	struct rte_meter_srtcm_profile **p,
+	uint64_t time,
+	const uint32_t *pkt_len,
+	enum rte_color *pkt_color,
+	uint32_t n_pkts);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * trTCM color aware traffic metering of a burst of packets
+ *
+ * @see rte_meter_srtcm_color_aware_check_bulk()
+ *
+ * @param m
+ *    Handles to trTCM instances, one per packet
+ * @param p
+ *    trTCM profiles of the instances, one per packet
+ * @param time
+ *    Current CPU time stamp (measured in CPU cycles), same for all packets
+ * @param pkt_len
+ *    Lengths of the IP packets (measured in bytes)
+ * @param pkt_color
+ *    Input colors of the IP packets, replaced by their assigned colors
+ * @param n_pkts
+ *    Number of packets
+ */
+__rte_experimental
+void
+rte_meter_trtcm_color_aware_check_bulk(struct rte_meter_trtcm **m,
+	struct rte_meter_trtcm_profile **p,
+	uint64_t time,
+	const uint32_t *pkt_len,
+	enum rte_color *pkt_color,
+	uint32_t n_pkts);
+
 /*
  * Inline implementation of run-time methods
  */
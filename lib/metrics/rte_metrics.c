@@ -8,6 +8,7 @@
 #include <eal_export.h>
 #include <rte_errno.h>
 #include <rte_common.h>
+#include <rte_lcore.h>
 #include <rte_string_fns.h>
 #include <rte_metrics.h>
 #include <rte_memzone.h>
@@ -16,6 +17,10 @@
 int metrics_initialized;
 
 #define RTE_METRICS_MEMZONE_NAME "RTE_METRICS"
+#define RTE_METRICS_LCORE_MEMZONE_NAME "RTE_METRICS_L%u"
+
+/* Row of the per-lcore slots of the global metrics */
+#define METRICS_LCORE_GLOBAL RTE_MAX_ETHPORTS
 
 /**
  * Internal stats metadata and value entry.
@@ -54,8 +59,61 @@ struct rte_metrics_data_s {
 	struct rte_metrics_meta_s metadata[RTE_METRICS_MAX_METRICS];
 	/** Metric data access lock */
 	rte_spinlock_t lock;
+	/** Lcores with per-lcore slots, in their own memzone */
+	uint8_t lcore_slots[RTE_MAX_LCORE];
+};
+
+/**
+ * Per-lcore slots of all the metrics.
+ *
+ * @internal
+ */
+struct rte_metrics_lcore_s {
+	/** Slots of the ports, then of the global metrics */
+	rte_metrics_lcore_slot_t value[RTE_MAX_ETHPORTS + 1][RTE_METRICS_MAX_METRICS];
 };
 
+/* Per-lcore slots mapped in this process */
+static struct rte_metrics_lcore_s *metrics_lcores[RTE_MAX_LCORE];
+
+static struct rte_metrics_lcore_s *
+metrics_lcore_lookup(unsigned int lcore_id)
+{
+	char name[RTE_MEMZONE_NAMESIZE];
+	const struct rte_memzone *memzone;
+
+	if (metrics_lcores[lcore_id] == NULL) {
+		snprintf(name, sizeof(name), RTE_METRICS_LCORE_MEMZONE_NAME,
+			lcore_id);
+		memzone = rte_memzone_lookup(name);
+		if (memzone != NULL)
+			metrics_lcores[lcore_id] = memzone->addr;
+	}
+	return metrics_lcores[lcore_id];
+}
+
+/* Add the per-lcore slots of a port to values, called with lock held */
+static void
+metrics_lcore_sum(struct rte_metrics_data_s *stats, unsigned int row,
+	struct rte_metric_value *values)
+{
+	struct rte_metrics_lcore_s *lcore;
+	unsigned int lcore_id;
+	uint16_t idx_name;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		if (!stats->lcore_slots[lcore_id])
+			continue;
+		lcore = metrics_lcore_lookup(lcore_id);
+		if (lcore == NULL)
+			continue;
+		for (idx_name = 0; idx_name < stats->cnt_stats; idx_name++)
+			values[idx_name].value += rte_atomic_load_explicit(
+				&lcore->value[row][idx_name],
+				rte_memory_order_relaxed);
+	}
+}
+
 RTE_EXPORT_SYMBOL(rte_metrics_init)
 int
 rte_metrics_init(int socket_id)
@@ -86,8 +144,10 @@ RTE_EXPORT_SYMBOL(rte_metrics_deinit)
 int
 rte_metrics_deinit(void)
 {
+	char name[RTE_MEMZONE_NAMESIZE];
 	struct rte_metrics_data_s *stats;
 	const struct rte_memzone *memzone;
+	unsigned int i;
 	int ret;
 
 	if (rte_eal_process_type() != RTE_PROC_PRIMARY)
@@ -98,6 +158,15 @@ rte_metrics_deinit(void)
 		return -EIO;
 
 	stats = memzone->addr;
+
+	for (i = 0; i < RTE_MAX_LCORE; i++) {
+		if (stats->lcore_slots[i] && metrics_lcore_lookup(i) != NULL) {
+			snprintf(name, sizeof(name),
+				RTE_METRICS_LCORE_MEMZONE_NAME, i);
+			rte_memzone_free(rte_memzone_lookup(name));
+		}
+		metrics_lcores[i] = NULL;
+	}
 	memset(stats, 0, sizeof(struct rte_metrics_data_s));
 
 	ret = rte_memzone_free(memzone);
@@ -309,8 +378,66 @@ rte_metrics_get_values(int port_id,
 				values[idx_name].key = idx_name;
 				values[idx_name].value = entry->value[port_id];
 			}
+		metrics_lcore_sum(stats, port_id == RTE_METRICS_GLOBAL ?
+			METRICS_LCORE_GLOBAL : (unsigned int)port_id, values);
 	}
 	return_value = stats->cnt_stats;
 	rte_spinlock_unlock(&stats->lock);
 	return return_value;
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_metrics_lcore_slot_get, 26.03)
+rte_metrics_lcore_slot_t *
+rte_metrics_lcore_slot_get(int port_id, uint16_t key)
+{
+	char name[RTE_MEMZONE_NAMESIZE];
+	struct rte_metrics_lcore_s *lcore;
+	struct rte_metrics_data_s *stats;
+	const struct rte_memzone *memzone;
+	unsigned int lcore_id = rte_lcore_id();
+
+	if ((port_id != RTE_METRICS_GLOBAL &&
+			(port_id < 0 || port_id >= RTE_MAX_ETHPORTS)) ||
+			lcore_id >= RTE_MAX_LCORE) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	memzone = rte_memzone_lookup(RTE_METRICS_MEMZONE_NAME);
+	if (memzone == NULL) {
+		rte_errno = EIO;
+		return NULL;
+	}
+	stats = memzone->addr;
+
+	rte_spinlock_lock(&stats->lock);
+
+	if (key >= stats->cnt_stats) {
+		rte_spinlock_unlock(&stats->lock);
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	lcore = metrics_lcore_lookup(lcore_id);
+	if (lcore == NULL) {
+		snprintf(name, sizeof(name), RTE_METRICS_LCORE_MEMZONE_NAME,
+			lcore_id);
+		memzone = rte_memzone_reserve(name,
+			sizeof(struct rte_metrics_lcore_s),
+			rte_lcore_to_socket_id(lcore_id), 0);
+		if (memzone == NULL) {
+			rte_spinlock_unlock(&stats->lock);
+			rte_errno = ENOMEM;
+			return NULL;
+		}
+		lcore = memzone->addr;
+		memset(lcore, 0, sizeof(struct rte_metrics_lcore_s));
+		metrics_lcores[lcore_id] = lcore;
+		stats->lcore_slots[lcore_id] = 1;
+	}
+
+	rte_spinlock_unlock(&stats->lock);
+
+	return &lcore->value[port_id == RTE_METRICS_GLOBAL ?
+		METRICS_LCORE_GLOBAL : port_id][key];
+}
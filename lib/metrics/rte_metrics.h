@@ -18,6 +18,10 @@
  * metric information by querying the central metric data, which is
  * held in shared memory. Currently only bulk querying of metrics
  * by consumers is supported.
+ *
+ * Fast path producers can instead add to per-lcore slots of a metric,
+ * without lock nor atomic operation; the slots of all the lcores are
+ * summed into the metric value when it is queried.
  */
 
 #ifndef _RTE_METRICS_H_
@@ -25,6 +29,9 @@
 
 #include <stdint.h>
 
+#include <rte_compat.h>
+#include <rte_stdatomic.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -235,6 +242,57 @@ int rte_metrics_update_values(
 	const uint64_t *values,
 	uint32_t count);
 
+/**
+ * Per-lcore slot of a metric, only written by its lcore.
+ */
+typedef RTE_ATOMIC(uint64_t) rte_metrics_lcore_slot_t;
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the slot of the calling lcore for a metric.
+ *
+ * The slot is added to the metric value returned by
+ * rte_metrics_get_values(), summed with the slots of the other lcores.
+ * It stays valid until rte_metrics_deinit(), so that it can be looked up
+ * once and updated with rte_metrics_lcore_slot_add() in the fast path.
+ *
+ * @param port_id
+ *   Port of the metric, or RTE_METRICS_GLOBAL
+ * @param key
+ *   Id of the metric
+ *
+ * @return
+ *   Pointer to the slot, NULL on error with rte_errno set:
+ *   - EINVAL if the port, key or calling thread is invalid
+ *   - EIO if unable to access shared metrics memory
+ *   - ENOMEM if the slots of the lcore cannot be allocated
+ */
+__rte_experimental
+rte_metrics_lcore_slot_t *rte_metrics_lcore_slot_get(int port_id, uint16_t key);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Add to a per-lcore metric slot, without atomic operation.
+ *
+ * Must only be called by the lcore owning the slot.
+ *
+ * @param slot
+ *   Slot returned by rte_metrics_lcore_slot_get()
+ * @param delta
+ *   Value to add
+ */
+__rte_experimental
+static inline void
+rte_metrics_lcore_slot_add(rte_metrics_lcore_slot_t *slot, uint64_t delta)
+{
+	rte_atomic_store_explicit(slot, rte_atomic_load_explicit(slot,
+		rte_memory_order_relaxed) + delta, rte_memory_order_relaxed);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,451 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <string.h>
+
+#include <eal_export.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_errno.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_ring.h>
+#include <rte_stdatomic.h>
+
+#include "rte_mldev.h"
+#include "rte_mldev_batch.h"
+
+/* Maximum number of requests dequeued from the queue pair at once. */
+#define ML_BATCH_DEQUEUE_MAX 32
+
+/* Request aggregating the operations of several lcores. */
+struct __rte_cache_aligned ml_batch_req {
+	struct rte_ml_op op;
+	/* operations gathered in the request */
+	struct rte_ml_op **ops;
+	uint16_t nb_ops;
+	/* TSC cycles when the first operation was gathered */
+	uint64_t start;
+	struct rte_ml_buff_seg **input;
+	struct rte_ml_buff_seg **output;
+	uint8_t *buf;
+};
+
+struct rte_ml_batch {
+	struct rte_ml_batch_conf conf;
+	uint16_t min_batches;
+	uint64_t deadline;
+	/* buffers of the model for one operation, see struct rte_ml_op */
+	uint32_t nb_input;
+	uint32_t nb_output;
+	uint64_t *input_size;
+	uint64_t *output_size;
+	/* operations enqueued and not dequeued yet */
+	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(uint32_t) nb_ops;
+	alignas(RTE_CACHE_LINE_SIZE) struct rte_ring *sq;
+	struct rte_ring *cq[RTE_MAX_LCORE];
+	/* request being gathered */
+	struct ml_batch_req *cur;
+	struct ml_batch_req **reqs;
+	struct ml_batch_req **free_reqs;
+	uint16_t nb_free_reqs;
+};
+
+/* Copy a buffer of the size of one operation from a segment chain. */
+static void
+ml_batch_gather(uint8_t *dst, const struct rte_ml_buff_seg *seg, uint64_t size)
+{
+	uint64_t len;
+
+	while (seg != NULL && size != 0) {
+		len = RTE_MIN(size, seg->length);
+		memcpy(dst, seg->addr, len);
+		dst += len;
+		size -= len;
+		seg = seg->next;
+	}
+}
+
+/* Copy a buffer of the size of one operation to a segment chain. */
+static void
+ml_batch_scatter(struct rte_ml_buff_seg *seg, const uint8_t *src, uint64_t size)
+{
+	uint64_t len;
+
+	while (seg != NULL && size != 0) {
+		len = RTE_MIN(size, seg->length);
+		memcpy(seg->addr, src, len);
+		src += len;
+		size -= len;
+		seg = seg->next;
+	}
+}
+
+/* Return an operation to the lcore that enqueued it. */
+static inline void
+ml_batch_op_done(struct rte_ml_batch *batch, struct rte_ml_op *op)
+{
+	/* cannot be full, the rings are sized for all the operations */
+	rte_ring_sp_enqueue(batch->cq[op->impl_opaque], op);
+}
+
+static uint32_t
+ml_batch_req_done(struct rte_ml_batch *batch, struct ml_batch_req *req)
+{
+	struct rte_ml_op *op;
+	uint16_t i;
+	uint32_t j;
+
+	for (i = 0; i < req->nb_ops; i++) {
+		op = req->ops[i];
+		for (j = 0; j < batch->nb_output; j++)
+			ml_batch_scatter(op->output[j],
+					 RTE_PTR_ADD(req->output[j]->addr,
+						     i * batch->output_size[j]),
+					 batch->output_size[j]);
+		op->status = req->op.status;
+		ml_batch_op_done(batch, op);
+	}
+
+	batch->free_reqs[batch->nb_free_reqs++] = req;
+
+	return req->nb_ops;
+}
+
+static void
+ml_batch_req_free(struct ml_batch_req *req)
+{
+	if (req == NULL)
+		return;
+
+	rte_free(req->buf);
+	rte_free(req);
+}
+
+static struct ml_batch_req *
+ml_batch_req_create(struct rte_ml_batch *batch, uint16_t align_size)
+{
+	const struct rte_ml_batch_conf *conf = &batch->conf;
+	uint32_t nb_segs = batch->nb_input + batch->nb_output;
+	struct rte_ml_buff_seg *segs;
+	struct ml_batch_req *req;
+	uint64_t size, offset;
+	uint32_t i;
+
+	size = sizeof(*req) + sizeof(struct rte_ml_op *) * conf->batch_size +
+		(sizeof(struct rte_ml_buff_seg *) + sizeof(struct rte_ml_buff_seg)) * nb_segs;
+	req = rte_zmalloc_socket(NULL, size, RTE_CACHE_LINE_SIZE, conf->socket_id);
+	if (req == NULL)
+		return NULL;
+
+	req->ops = (struct rte_ml_op **)(req + 1);
+	req->input = (struct rte_ml_buff_seg **)(req->ops + conf->batch_size);
+	req->output = req->input + batch->nb_input;
+	segs = (struct rte_ml_buff_seg *)(req->output + batch->nb_output);
+
+	/* each buffer holds the data of the model for all the operations */
+	size = 0;
+	for (i = 0; i < batch->nb_input; i++)
+		size += RTE_ALIGN_CEIL(batch->input_size[i] * conf->batch_size, align_size);
+	for (i = 0; i < batch->nb_output; i++)
+		size += RTE_ALIGN_CEIL(batch->output_size[i] * conf->batch_size, align_size);
+
+	req->buf = rte_zmalloc_socket(NULL, size, align_size, conf->socket_id);
+	if (req->buf == NULL) {
+		rte_free(req);
+		return NULL;
+	}
+
+	offset = 0;
+	for (i = 0; i < nb_segs; i++) {
+		segs[i].addr = RTE_PTR_ADD(req->buf, offset);
+		segs[i].iova_addr = rte_malloc_virt2iova(segs[i].addr);
+		segs[i].next = NULL;
+		if (i < batch->nb_input) {
+			req->input[i] = &segs[i];
+			size = batch->input_size[i];
+		} else {
+			req->output[i - batch->nb_input] = &segs[i];
+			size = batch->output_size[i - batch->nb_input];
+		}
+		offset += RTE_ALIGN_CEIL(size * conf->batch_size, align_size);
+	}
+
+	req->op.model_id = conf->model_id;
+	req->op.input = req->input;
+	req->op.output = req->output;
+
+	return req;
+}
+
+static int
+ml_batch_io_size_init(struct rte_ml_batch *batch)
+{
+	struct rte_ml_model_info info;
+	uint32_t i;
+	int ret;
+
+	ret = rte_ml_model_info_get(batch->conf.dev_id, batch->conf.model_id, &info);
+	if (ret < 0)
+		return ret;
+
+	if (info.min_batches == 0 ||
+			(uint32_t)batch->conf.batch_size * info.min_batches > info.max_batches) {
+		RTE_MLDEV_LOG(ERR, "Batch size %u exceeds the maximum batches of model %u",
+			      batch->conf.batch_size, batch->conf.model_id);
+		return -EINVAL;
+	}
+	batch->min_batches = info.min_batches;
+
+	if (info.io_layout == RTE_ML_IO_LAYOUT_PACKED) {
+		batch->nb_input = 1;
+		batch->nb_output = 1;
+	} else {
+		batch->nb_input = info.nb_inputs;
+		batch->nb_output = info.nb_outputs;
+	}
+
+	batch->input_size = rte_zmalloc_socket(NULL,
+			sizeof(uint64_t) * (batch->nb_input + batch->nb_output), 0,
+			batch->conf.socket_id);
+	if (batch->input_size == NULL)
+		return -ENOMEM;
+	batch->output_size = batch->input_size + batch->nb_input;
+
+	/* the sizes of the model info are for min_batches, one operation */
+	for (i = 0; i < info.nb_inputs; i++)
+		batch->input_size[RTE_MIN(i, batch->nb_input - 1)] += info.input_info[i].size;
+	for (i = 0; i < info.nb_outputs; i++)
+		batch->output_size[RTE_MIN(i, batch->nb_output - 1)] += info.output_info[i].size;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ml_batch_free, 26.03)
+void
+rte_ml_batch_free(struct rte_ml_batch *batch)
+{
+	uint32_t i;
+
+	if (batch == NULL)
+		return;
+
+	if (batch->reqs != NULL) {
+		for (i = 0; i < batch->conf.nb_requests; i++)
+			ml_batch_req_free(batch->reqs[i]);
+		rte_free(batch->reqs);
+	}
+
+	for (i = 0; i < RTE_MAX_LCORE; i++)
+		rte_ring_free(batch->cq[i]);
+	rte_ring_free(batch->sq);
+	rte_free(batch->input_size);
+	rte_free(batch);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ml_batch_create, 26.03)
+struct rte_ml_batch *
+rte_ml_batch_create(const struct rte_ml_batch_conf *conf)
+{
+	char name[RTE_RING_NAMESIZE];
+	struct rte_ml_dev_info dev_info;
+	struct rte_ml_batch *batch;
+	unsigned int lcore_id;
+	uint16_t i;
+	int ret;
+
+	if (conf == NULL || conf->name == NULL || conf->batch_size == 0 ||
+			conf->nb_requests == 0 || conf->nb_ops == 0) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	ret = rte_ml_dev_info_get(conf->dev_id, &dev_info);
+	if (ret < 0) {
+		rte_errno = -ret;
+		return NULL;
+	}
+
+	batch = rte_zmalloc_socket(NULL, sizeof(*batch), RTE_CACHE_LINE_SIZE, conf->socket_id);
+	if (batch == NULL) {
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+	batch->conf = *conf;
+	batch->deadline = conf->deadline_us * rte_get_tsc_hz() / US_PER_S;
+
+	ret = ml_batch_io_size_init(batch);
+	if (ret < 0)
+		goto error;
+
+	ret = -ENAMETOOLONG;
+	if (snprintf(name, sizeof(name), "MLB_%s", conf->name) >= (int)sizeof(name))
+		goto error;
+	batch->sq = rte_ring_create(name, conf->nb_ops, conf->socket_id,
+				    RING_F_SC_DEQ | RING_F_EXACT_SZ);
+	if (batch->sq == NULL)
+		goto ring_error;
+
+	RTE_LCORE_FOREACH(lcore_id) {
+		if (snprintf(name, sizeof(name), "MLB_%s_%u", conf->name, lcore_id) >=
+				(int)sizeof(name))
+			goto error;
+		batch->cq[lcore_id] = rte_ring_create(name, conf->nb_ops, conf->socket_id,
+				RING_F_SP_ENQ | RING_F_SC_DEQ | RING_F_EXACT_SZ);
+		if (batch->cq[lcore_id] == NULL)
+			goto ring_error;
+	}
+
+	ret = -ENOMEM;
+	batch->reqs = rte_zmalloc_socket(NULL,
+			sizeof(struct ml_batch_req *) * conf->nb_requests * 2, 0, conf->socket_id);
+	if (batch->reqs == NULL)
+		goto error;
+	batch->free_reqs = batch->reqs + conf->nb_requests;
+
+	for (i = 0; i < conf->nb_requests; i++) {
+		batch->reqs[i] = ml_batch_req_create(batch, dev_info.align_size);
+		if (batch->reqs[i] == NULL)
+			goto error;
+		batch->free_reqs[i] = batch->reqs[i];
+	}
+	batch->nb_free_reqs = conf->nb_requests;
+
+	return batch;
+
+ring_error:
+	ret = -rte_errno;
+error:
+	RTE_MLDEV_LOG(ERR, "Failed to create batching context %s", conf->name);
+	rte_ml_batch_free(batch);
+	rte_errno = -ret;
+	return NULL;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ml_batch_enqueue, 26.03)
+uint16_t
+rte_ml_batch_enqueue(struct rte_ml_batch *batch, struct rte_ml_op **ops, uint16_t nb_ops)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	uint32_t count, excess;
+	uint16_t i;
+
+	if (lcore_id >= RTE_MAX_LCORE || batch->cq[lcore_id] == NULL) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+
+	/* reserve room for the operations up to their dequeue */
+	count = rte_atomic_fetch_add_explicit(&batch->nb_ops, nb_ops,
+					      rte_memory_order_relaxed) + nb_ops;
+	if (count > batch->conf.nb_ops) {
+		excess = RTE_MIN(count - batch->conf.nb_ops, nb_ops);
+		rte_atomic_fetch_sub_explicit(&batch->nb_ops, excess,
+					      rte_memory_order_relaxed);
+		nb_ops -= excess;
+	}
+
+	for (i = 0; i < nb_ops; i++)
+		ops[i]->impl_opaque = lcore_id;
+
+	return rte_ring_mp_enqueue_burst(batch->sq, (void **)ops, nb_ops, NULL);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ml_batch_dequeue, 26.03)
+uint16_t
+rte_ml_batch_dequeue(struct rte_ml_batch *batch, struct rte_ml_op **ops, uint16_t nb_ops)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	uint16_t n;
+
+	if (lcore_id >= RTE_MAX_LCORE || batch->cq[lcore_id] == NULL) {
+		rte_errno = EINVAL;
+		return 0;
+	}
+
+	n = rte_ring_sc_dequeue_burst(batch->cq[lcore_id], (void **)ops, nb_ops, NULL);
+	if (n != 0)
+		rte_atomic_fetch_sub_explicit(&batch->nb_ops, n, rte_memory_order_relaxed);
+
+	return n;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_ml_batch_process, 26.03)
+uint32_t
+rte_ml_batch_process(struct rte_ml_batch *batch)
+{
+	const struct rte_ml_batch_conf *conf = &batch->conf;
+	struct rte_ml_op *ops[ML_BATCH_DEQUEUE_MAX];
+	struct ml_batch_req *req;
+	uint32_t nb_done = 0;
+	uint16_t i, k, n, end;
+	uint64_t now;
+	uint32_t j;
+
+	/* scatter the outputs of the processed requests */
+	n = rte_ml_dequeue_burst(conf->dev_id, conf->qp_id, ops, ML_BATCH_DEQUEUE_MAX);
+	for (i = 0; i < n; i++)
+		nb_done += ml_batch_req_done(batch,
+				container_of(ops[i], struct ml_batch_req, op));
+
+	/* gather the enqueued operations into requests */
+	for (;;) {
+		req = batch->cur;
+		if (req == NULL) {
+			if (batch->nb_free_reqs == 0)
+				break;
+			req = batch->free_reqs[--batch->nb_free_reqs];
+			req->nb_ops = 0;
+			batch->cur = req;
+		}
+
+		n = rte_ring_sc_dequeue_burst(batch->sq, (void **)&req->ops[req->nb_ops],
+					      conf->batch_size - req->nb_ops, NULL);
+		now = rte_get_tsc_cycles();
+		if (req->nb_ops == 0)
+			req->start = now;
+
+		end = req->nb_ops + n;
+		for (k = req->nb_ops; k < end; k++) {
+			struct rte_ml_op *op = req->ops[k];
+
+			if (unlikely(op->model_id != conf->model_id ||
+					op->nb_batches != batch->min_batches)) {
+				op->status = RTE_ML_OP_STATUS_ERROR;
+				ml_batch_op_done(batch, op);
+				nb_done++;
+				continue;
+			}
+
+			for (j = 0; j < batch->nb_input; j++)
+				ml_batch_gather(RTE_PTR_ADD(req->input[j]->addr,
+						req->nb_ops * batch->input_size[j]),
+						op->input[j], batch->input_size[j]);
+			req->ops[req->nb_ops++] = op;
+		}
+		/* invalid operations were dropped from the request */
+		k = req->nb_ops;
+
+		if (k == 0)
+			break;
+
+		/* wait for more operations up to the deadline of the first one */
+		if (k < conf->batch_size && now - req->start < batch->deadline)
+			break;
+
+		req->op.nb_batches = k * batch->min_batches;
+		for (j = 0; j < batch->nb_input; j++)
+			req->input[j]->length = k * batch->input_size[j];
+		for (j = 0; j < batch->nb_output; j++)
+			req->output[j]->length = k * batch->output_size[j];
+
+		ops[0] = &req->op;
+		if (rte_ml_enqueue_burst(conf->dev_id, conf->qp_id, ops, 1) == 0)
+			break;
+
+		batch->cur = NULL;
+	}
+
+	return nb_done;
+}
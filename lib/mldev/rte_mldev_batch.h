@@ -0,0 +1,170 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef RTE_MLDEV_BATCH_H
+#define RTE_MLDEV_BATCH_H
+
+/**
+ * @file rte_mldev_batch.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * ML inference batching.
+ *
+ * A batching context aggregates the ML operations enqueued by any number of lcores,
+ * each holding the input of a single batch unit of one model (rte_ml_model_info::min_batches),
+ * into requests of up to a configured number of batch units on one queue pair.
+ *
+ *     +--------+  rte_ml_batch_enqueue()   +----------+  rte_ml_enqueue_burst()  +--------+
+ *     | Core 0 |------------------------->|          |------------------------->|        |
+ *     +--------+                           | Batching |                          | Queue  |
+ *     +--------+                           | context  |                          | pair   |
+ *     | Core 1 |<-------------------------|          |<-------------------------|        |
+ *     +--------+  rte_ml_batch_dequeue()   +----------+  rte_ml_dequeue_burst()  +--------+
+ *                                               ^
+ *                                               |
+ *                                      rte_ml_batch_process()
+ *
+ * The inputs of the operations are gathered into the contiguous buffers of a request,
+ * which is sent to the device once full, or once its first operation waited for the deadline.
+ * A request sent on deadline carries fewer batches, the batch dimension of the model
+ * being set per request by rte_ml_op::nb_batches.
+ * Once the request is processed, its outputs are scattered back into the output buffers
+ * of the operations, which are then returned to the lcore that enqueued them.
+ *
+ * rte_ml_batch_process() must be called by a single thread, which is the only one
+ * using the queue pair.
+ */
+
+#include <stdint.h>
+
+#include <rte_compat.h>
+#include <rte_mldev.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Batching context. */
+struct rte_ml_batch;
+
+/** Batching context configuration. */
+struct rte_ml_batch_conf {
+	const char *name;
+	/**< Name of the context, unique. */
+	int16_t dev_id;
+	/**< Device of the model. */
+	uint16_t qp_id;
+	/**< Queue pair to send the requests to. */
+	uint16_t model_id;
+	/**< Model of the operations, must be started. */
+	uint16_t batch_size;
+	/**< Maximum number of operations per request.
+	 * The batches of a full request must not exceed rte_ml_model_info::max_batches.
+	 */
+	uint16_t nb_requests;
+	/**< Number of requests that can be in the queue pair. */
+	uint32_t nb_ops;
+	/**< Maximum number of operations in the context, from enqueue to dequeue. */
+	uint64_t deadline_us;
+	/**< Maximum time waited by the first operation of a request before it is sent.
+	 * With zero, a request is sent as soon as no more operation is pending.
+	 */
+	int socket_id;
+	/**< Socket to allocate memory on. */
+};
+
+/**
+ * Create a batching context.
+ *
+ * @param conf
+ *   Context configuration.
+ *
+ * @return
+ *   - On success, pointer to the context.
+ *   - On failure, NULL, rte_errno being set.
+ */
+__rte_experimental
+struct rte_ml_batch *
+rte_ml_batch_create(const struct rte_ml_batch_conf *conf);
+
+/**
+ * Free a batching context.
+ *
+ * The context must not have operations in progress.
+ *
+ * @param batch
+ *   Batching context, if NULL then the function does nothing.
+ */
+__rte_experimental
+void
+rte_ml_batch_free(struct rte_ml_batch *batch);
+
+/**
+ * Enqueue a burst of ML operations to a batching context.
+ *
+ * Can be called by any EAL lcore concurrently.
+ * Each operation holds the input and output buffers of one batch unit of the model,
+ * with rte_ml_op::nb_batches set to rte_ml_model_info::min_batches.
+ * The rte_ml_op::impl_opaque field is used by the context.
+ *
+ * @param batch
+ *   Batching context.
+ * @param ops
+ *   Array of operations.
+ * @param nb_ops
+ *   Number of operations.
+ *
+ * @return
+ *   Number of operations enqueued,
+ *   less than *nb_ops* when the context already holds its maximum number of operations.
+ */
+__rte_experimental
+uint16_t
+rte_ml_batch_enqueue(struct rte_ml_batch *batch, struct rte_ml_op **ops, uint16_t nb_ops);
+
+/**
+ * Dequeue a burst of ML operations processed by a batching context.
+ *
+ * Only the operations enqueued by the calling lcore are returned,
+ * their output buffers and status being set.
+ *
+ * @param batch
+ *   Batching context.
+ * @param ops
+ *   Array filled with the operations.
+ * @param nb_ops
+ *   Size of the array.
+ *
+ * @return
+ *   Number of operations dequeued.
+ */
+__rte_experimental
+uint16_t
+rte_ml_batch_dequeue(struct rte_ml_batch *batch, struct rte_ml_op **ops, uint16_t nb_ops);
+
+/**
+ * Run a batching context.
+ *
+ * Scatters the outputs of the processed requests,
+ * then gathers the enqueued operations into requests sent to the queue pair.
+ * To be called periodically by a single thread.
+ *
+ * @param batch
+ *   Batching context.
+ *
+ * @return
+ *   Number of operations made available to rte_ml_batch_dequeue().
+ */
+__rte_experimental
+uint32_t
+rte_ml_batch_process(struct rte_ml_batch *batch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RTE_MLDEV_BATCH_H */
@@ -0,0 +1,327 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdalign.h>
+#include <string.h>
+
+#include <rte_common.h>
+#include <rte_branch_prediction.h>
+#include <rte_vect.h>
+
+#include "net_crc.h"
+
+/* Minimum length folded with 256-bit registers */
+#define CRC_AVX2_FOLD_LEN	128
+
+/** VPCLMULQDQ on 256-bit registers CRC computation context structure */
+struct crc_vpclmulqdq_avx2_ctx {
+	__m256i fold_128b;
+	/**< folding 128 bytes forward, in each lane */
+	__m256i fold_64b;
+	__m256i fold_32b;
+	__m128i fold_16b;
+	__m128i rk5_rk6;
+	__m128i rk7_rk8;
+};
+
+static alignas(32) struct crc_vpclmulqdq_avx2_ctx crc32_eth;
+static alignas(32) struct crc_vpclmulqdq_avx2_ctx crc16_ccitt;
+
+static const alignas(16) uint8_t crc_xmm_shift_tab[48] = {
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff
+};
+
+static const alignas(16) uint8_t shf_table[32] = {
+	0x00, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+	0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+
+static const alignas(16) uint32_t mask1[4] = {
+	0xffffffff, 0xffffffff, 0x00000000, 0x00000000
+};
+
+static const alignas(16) uint32_t mask2[4] = {
+	0x00000000, 0xffffffff, 0xffffffff, 0xffffffff
+};
+
+static const alignas(16) uint32_t mask3[4] = {
+	0x80808080, 0x80808080, 0x80808080, 0x80808080
+};
+
+/* Folding round of the two 128-bit lanes of a 256-bit register */
+static __rte_always_inline __m256i
+crcr32_folding_round_256(__m256i data_block, __m256i precomp, __m256i fold)
+{
+	__m256i tmp0 = _mm256_clmulepi64_epi128(fold, precomp, 0x01);
+	__m256i tmp1 = _mm256_clmulepi64_epi128(fold, precomp, 0x10);
+
+	return _mm256_xor_si256(tmp1, _mm256_xor_si256(data_block, tmp0));
+}
+
+static __rte_always_inline __m128i
+crcr32_folding_round(__m128i data_block, __m128i precomp, __m128i fold)
+{
+	__m128i tmp0 = _mm_clmulepi64_si128(fold, precomp, 0x01);
+	__m128i tmp1 = _mm_clmulepi64_si128(fold, precomp, 0x10);
+
+	return _mm_xor_si128(tmp1, _mm_xor_si128(data_block, tmp0));
+}
+
+static __rte_always_inline __m128i
+crcr32_reduce_128_to_64(__m128i data128, __m128i precomp)
+{
+	__m128i tmp0, tmp1, tmp2;
+
+	/* 64b fold */
+	tmp0 = _mm_clmulepi64_si128(data128, precomp, 0x00);
+	tmp1 = _mm_srli_si128(data128, 8);
+	tmp0 = _mm_xor_si128(tmp0, tmp1);
+
+	/* 32b fold */
+	tmp2 = _mm_slli_si128(tmp0, 4);
+	tmp1 = _mm_clmulepi64_si128(tmp2, precomp, 0x10);
+
+	return _mm_xor_si128(tmp1, tmp0);
+}
+
+static __rte_always_inline uint32_t
+crcr32_reduce_64_to_32(__m128i data64, __m128i precomp)
+{
+	__m128i tmp0, tmp1, tmp2;
+
+	tmp0 = _mm_and_si128(data64, _mm_load_si128((const __m128i *)mask2));
+
+	tmp1 = _mm_clmulepi64_si128(tmp0, precomp, 0x00);
+	tmp1 = _mm_xor_si128(tmp1, tmp0);
+	tmp1 = _mm_and_si128(tmp1, _mm_load_si128((const __m128i *)mask1));
+
+	tmp2 = _mm_clmulepi64_si128(tmp1, precomp, 0x10);
+	tmp2 = _mm_xor_si128(tmp2, tmp1);
+	tmp2 = _mm_xor_si128(tmp2, tmp0);
+
+	return _mm_extract_epi32(tmp2, 2);
+}
+
+static __rte_always_inline __m128i
+xmm_shift_left(__m128i reg, const unsigned int num)
+{
+	const __m128i *p = (const __m128i *)(crc_xmm_shift_tab + 16 - num);
+
+	return _mm_shuffle_epi8(reg, _mm_loadu_si128(p));
+}
+
+/*
+ * Fold the first bytes of the data, multiple of 128 bytes,
+ * with four 256-bit registers, then down to a single 128-bit block.
+ */
+static __rte_always_inline __m128i
+crc32_fold_256(const uint8_t *data, uint32_t data_len, __m128i crc,
+	uint32_t *n, const struct crc_vpclmulqdq_avx2_ctx *params)
+{
+	__m256i fold0, fold1, fold2, fold3, k;
+	uint32_t i;
+
+	fold0 = _mm256_loadu_si256((const __m256i *)data);
+	fold1 = _mm256_loadu_si256((const __m256i *)(data + 32));
+	fold2 = _mm256_loadu_si256((const __m256i *)(data + 64));
+	fold3 = _mm256_loadu_si256((const __m256i *)(data + 96));
+	fold0 = _mm256_xor_si256(fold0, _mm256_zextsi128_si256(crc));
+
+	/* Main folding loop, 4 independent streams of 2 lanes */
+	k = params->fold_128b;
+	for (i = CRC_AVX2_FOLD_LEN; i + CRC_AVX2_FOLD_LEN <= data_len;
+			i += CRC_AVX2_FOLD_LEN) {
+		fold0 = crcr32_folding_round_256(
+			_mm256_loadu_si256((const __m256i *)&data[i]),
+			k, fold0);
+		fold1 = crcr32_folding_round_256(
+			_mm256_loadu_si256((const __m256i *)&data[i + 32]),
+			k, fold1);
+		fold2 = crcr32_folding_round_256(
+			_mm256_loadu_si256((const __m256i *)&data[i + 64]),
+			k, fold2);
+		fold3 = crcr32_folding_round_256(
+			_mm256_loadu_si256((const __m256i *)&data[i + 96]),
+			k, fold3);
+	}
+	*n = i;
+
+	/* 128 to 32 bytes */
+	fold2 = crcr32_folding_round_256(fold2, params->fold_64b, fold0);
+	fold3 = crcr32_folding_round_256(fold3, params->fold_64b, fold1);
+	fold3 = crcr32_folding_round_256(fold3, params->fold_32b, fold2);
+
+	/* 32 to 16 bytes */
+	return crcr32_folding_round(_mm256_extracti128_si256(fold3, 1),
+		params->fold_16b, _mm256_castsi256_si128(fold3));
+}
+
+static __rte_always_inline uint32_t
+crc32_eth_calc_vpclmulqdq(
+	const uint8_t *data,
+	uint32_t data_len,
+	uint32_t crc,
+	const struct crc_vpclmulqdq_avx2_ctx *params)
+{
+	__m128i temp, fold, k;
+	uint32_t n;
+
+	/* Get CRC init value */
+	temp = _mm_cvtsi32_si128(crc);
+
+	if (unlikely(data_len < 32)) {
+		if (unlikely(data_len == 16)) {
+			/* 16 bytes */
+			fold = _mm_loadu_si128((const __m128i *)data);
+			fold = _mm_xor_si128(fold, temp);
+			goto reduction_128_64;
+		}
+
+		if (unlikely(data_len < 16)) {
+			/* 0 to 15 bytes */
+			alignas(16) uint8_t buffer[16];
+
+			memset(buffer, 0, sizeof(buffer));
+			memcpy(buffer, data, data_len);
+
+			fold = _mm_load_si128((const __m128i *)buffer);
+			fold = _mm_xor_si128(fold, temp);
+			if (unlikely(data_len < 4)) {
+				fold = xmm_shift_left(fold, 8 - data_len);
+				goto barret_reduction;
+			}
+			fold = xmm_shift_left(fold, 16 - data_len);
+			goto reduction_128_64;
+		}
+		/* 17 to 31 bytes */
+		fold = _mm_loadu_si128((const __m128i *)data);
+		fold = _mm_xor_si128(fold, temp);
+		n = 16;
+		k = params->fold_16b;
+		goto partial_bytes;
+	}
+
+	if (data_len >= CRC_AVX2_FOLD_LEN) {
+		fold = crc32_fold_256(data, data_len, temp, &n, params);
+	} else {
+		fold = _mm_loadu_si128((const __m128i *)data);
+		fold = _mm_xor_si128(fold, temp);
+		n = 16;
+	}
+
+	/** Folding of the remaining 16 byte blocks */
+	k = params->fold_16b;
+	for (; (n + 16) <= data_len; n += 16) {
+		temp = _mm_loadu_si128((const __m128i *)&data[n]);
+		fold = crcr32_folding_round(temp, k, fold);
+	}
+
+partial_bytes:
+	if (likely(n < data_len)) {
+		__m128i last16, a, b;
+
+		last16 = _mm_loadu_si128((const __m128i *)&data[data_len - 16]);
+
+		temp = _mm_loadu_si128((const __m128i *)
+			&shf_table[data_len & 15]);
+		a = _mm_shuffle_epi8(fold, temp);
+
+		temp = _mm_xor_si128(temp,
+			_mm_load_si128((const __m128i *)mask3));
+		b = _mm_shuffle_epi8(fold, temp);
+		b = _mm_blendv_epi8(b, last16, temp);
+
+		temp = _mm_clmulepi64_si128(a, k, 0x01);
+		fold = _mm_clmulepi64_si128(a, k, 0x10);
+
+		fold = _mm_xor_si128(fold, temp);
+		fold = _mm_xor_si128(fold, b);
+	}
+
+	/** Reduction 128 -> 32 Assumes: fold holds 128bit folded data */
+reduction_128_64:
+	fold = crcr32_reduce_128_to_64(fold, params->rk5_rk6);
+
+barret_reduction:
+	return crcr32_reduce_64_to_32(fold, params->rk7_rk8);
+}
+
+void
+rte_net_crc_avx2_init(void)
+{
+	uint64_t k1, k2, k3, k4, k5, k6, k7, k8;
+	uint64_t k9, k10;
+	uint64_t p, q;
+
+	/** Initialize CRC16 data */
+	k1 = 0x160beLLU;	/* 128 bytes fold */
+	k2 = 0x1bed8LLU;
+	k3 = 0x14ff2LLU;	/* 64 bytes fold */
+	k4 = 0x19a3cLLU;
+	k5 = 0x5b44LLU;		/* 32 bytes fold */
+	k6 = 0x7762LLU;
+	k7 = 0x189aeLLU;	/* 16 bytes fold */
+	k8 = 0x8e10LLU;
+	k9 = 0x189aeLLU;	/* 128b to 64b reduction */
+	k10 = 0x114aaLLU;
+	q =  0x11c581910LLU;	/* Barrett reduction */
+	p =  0x10811LLU;
+
+	/** Save the params in context structure */
+	crc16_ccitt.fold_128b = _mm256_set_epi64x(k2, k1, k2, k1);
+	crc16_ccitt.fold_64b = _mm256_set_epi64x(k4, k3, k4, k3);
+	crc16_ccitt.fold_32b = _mm256_set_epi64x(k6, k5, k6, k5);
+	crc16_ccitt.fold_16b = _mm_set_epi64x(k8, k7);
+	crc16_ccitt.rk5_rk6 = _mm_set_epi64x(k10, k9);
+	crc16_ccitt.rk7_rk8 = _mm_set_epi64x(p, q);
+
+	/** Initialize CRC32 data */
+	k1 = 0x14a7fe880LLU;
+	k2 = 0x1e88ef372LLU;
+	k3 = 0x1c6e41596LLU;
+	k4 = 0x154442bd4LLU;
+	k5 = 0x15a546366LLU;
+	k6 = 0xf1da05aaLLU;
+	k7 = 0xccaa009eLLU;
+	k8 = 0x1751997d0LLU;
+	k9 = 0xccaa009eLLU;
+	k10 = 0x163cd6124LLU;
+	q =  0x1f7011640LLU;
+	p =  0x1db710641LLU;
+
+	/** Save the params in context structure */
+	crc32_eth.fold_128b = _mm256_set_epi64x(k2, k1, k2, k1);
+	crc32_eth.fold_64b = _mm256_set_epi64x(k4, k3, k4, k3);
+	crc32_eth.fold_32b = _mm256_set_epi64x(k6, k5, k6, k5);
+	crc32_eth.fold_16b = _mm_set_epi64x(k8, k7);
+	crc32_eth.rk5_rk6 = _mm_set_epi64x(k10, k9);
+	crc32_eth.rk7_rk8 = _mm_set_epi64x(p, q);
+}
+
+uint32_t
+rte_crc16_ccitt_avx2_handler(const uint8_t *data, uint32_t data_len)
+{
+	/* return 16-bit CRC value */
+	return (uint16_t)~crc32_eth_calc_vpclmulqdq(data,
+		data_len,
+		0xffff,
+		&crc16_ccitt);
+}
+
+uint32_t
+rte_crc32_eth_avx2_handler(const uint8_t *data, uint32_t data_len)
+{
+	/* return 32-bit CRC value */
+	return ~crc32_eth_calc_vpclmulqdq(data,
+		data_len,
+		0xffffffffUL,
+		&crc32_eth);
+}
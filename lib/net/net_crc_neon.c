@@ -13,9 +13,13 @@
 
 #include "net_crc.h"
 
+/* Minimum length folded with 4 independent blocks */
+#define CRC_PMULL_FOLD4_LEN 128
+
 /** PMULL CRC computation context structure */
 struct crc_pmull_ctx {
 	uint64x2_t rk1_rk2;
+	uint64x2_t rk3_rk4;
 	uint64x2_t rk5_rk6;
 	uint64x2_t rk7_rk8;
 };
@@ -122,6 +126,49 @@ crcr32_reduce_64_to_32(uint64x2_t data64,
 	return vgetq_lane_u32(vreinterpretq_u32_u64(tmp2), 2);
 }
 
+/**
+ * Folds 4 blocks of 16 bytes in parallel, 64 bytes forward per round,
+ * to keep several multipliers busy, then merges them into a single block.
+ *
+ * @param data data to be folded
+ * @param data_len data length, at least 128 bytes
+ * @param fold first 16 byte block, with the CRC initial value applied
+ * @param n set to the number of folded bytes
+ * @param params precomputed constants
+ *
+ * @return 16 byte folded data
+ */
+static inline uint64x2_t
+crcr32_fold_4x128(const uint8_t *data, uint32_t data_len, uint64x2_t fold,
+	uint32_t *n, const struct crc_pmull_ctx *params)
+{
+	uint64x2_t fold1, fold2, fold3, k;
+	uint32_t i;
+
+	fold1 = vld1q_u64((const uint64_t *)&data[16]);
+	fold2 = vld1q_u64((const uint64_t *)&data[32]);
+	fold3 = vld1q_u64((const uint64_t *)&data[48]);
+
+	k = params->rk3_rk4;
+	for (i = 64; (i + 64) <= data_len; i += 64) {
+		fold = crcr32_folding_round(
+			vld1q_u64((const uint64_t *)&data[i]), k, fold);
+		fold1 = crcr32_folding_round(
+			vld1q_u64((const uint64_t *)&data[i + 16]), k, fold1);
+		fold2 = crcr32_folding_round(
+			vld1q_u64((const uint64_t *)&data[i + 32]), k, fold2);
+		fold3 = crcr32_folding_round(
+			vld1q_u64((const uint64_t *)&data[i + 48]), k, fold3);
+	}
+	*n = i;
+
+	k = params->rk1_rk2;
+	fold1 = crcr32_folding_round(fold1, k, fold);
+	fold2 = crcr32_folding_round(fold2, k, fold1);
+
+	return crcr32_folding_round(fold3, k, fold2);
+}
+
 static inline uint32_t
 crc32_eth_calc_pmull(
 	const uint8_t *data,
@@ -176,9 +223,13 @@ crc32_eth_calc_pmull(
 	fold = vld1q_u64((const uint64_t *)data);
 	fold = veorq_u64(fold, temp);
 
+	n = 16;
+	if (data_len >= CRC_PMULL_FOLD4_LEN)
+		fold = crcr32_fold_4x128(data, data_len, fold, &n, params);
+
 	/** Main folding loop - the last 16 bytes is processed separately */
 	k = params->rk1_rk2;
-	for (n = 16; (n + 16) <= data_len; n += 16) {
+	for (; (n + 16) <= data_len; n += 16) {
 		temp = vld1q_u64((const uint64_t *)&data[n]);
 		fold = crcr32_folding_round(temp, k, fold);
 	}
@@ -222,21 +273,25 @@ rte_net_crc_neon_init(void)
 {
 	/* Initialize CRC16 data */
 	uint64_t ccitt_k1_k2[2] = {0x189aeLLU, 0x8e10LLU};
+	uint64_t ccitt_k3_k4[2] = {0x14ff2LLU, 0x19a3cLLU};
 	uint64_t ccitt_k5_k6[2] = {0x189aeLLU, 0x114aaLLU};
 	uint64_t ccitt_k7_k8[2] = {0x11c581910LLU, 0x10811LLU};
 
 	/* Initialize CRC32 data */
 	uint64_t eth_k1_k2[2] = {0xccaa009eLLU, 0x1751997d0LLU};
+	uint64_t eth_k3_k4[2] = {0x1c6e41596LLU, 0x154442bd4LLU};
 	uint64_t eth_k5_k6[2] = {0xccaa009eLLU, 0x163cd6124LLU};
 	uint64_t eth_k7_k8[2] = {0x1f7011640LLU, 0x1db710641LLU};
 
 	/** Save the params in context structure */
 	crc16_ccitt_pmull.rk1_rk2 = vld1q_u64(ccitt_k1_k2);
+	crc16_ccitt_pmull.rk3_rk4 = vld1q_u64(ccitt_k3_k4);
 	crc16_ccitt_pmull.rk5_rk6 = vld1q_u64(ccitt_k5_k6);
 	crc16_ccitt_pmull.rk7_rk8 = vld1q_u64(ccitt_k7_k8);
 
 	/** Save the params in context structure */
 	crc32_eth_pmull.rk1_rk2 = vld1q_u64(eth_k1_k2);
+	crc32_eth_pmull.rk3_rk4 = vld1q_u64(eth_k3_k4);
 	crc32_eth_pmull.rk5_rk6 = vld1q_u64(eth_k5_k6);
 	crc32_eth_pmull.rk7_rk8 = vld1q_u64(eth_k7_k8);
 }
@@ -0,0 +1,26 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _NET_PTYPE_H_
+#define _NET_PTYPE_H_
+
+#include <stdint.h>
+
+#include <rte_mbuf.h>
+
+/* Number of packets parsed at once by the vector implementations. */
+#define NET_PTYPE_VEC_BURST 8
+
+/*
+ * Parse the Ethernet, IPv4/IPv6 and TCP/UDP headers of 8 packets.
+ * The packet type and header lengths are written in the mbufs parsed
+ * successfully, with the same result as rte_net_get_ptype().
+ * The other packets are left untouched, for the scalar parser.
+ *
+ * Returns the bit mask of the packets parsed.
+ */
+uint8_t
+rte_net_get_ptype_x8_avx2(struct rte_mbuf **pkts, uint32_t layers);
+
+#endif /* _NET_PTYPE_H_ */
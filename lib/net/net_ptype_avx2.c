@@ -0,0 +1,162 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <stdalign.h>
+
+#include <rte_common.h>
+#include <rte_byteorder.h>
+#include <rte_ether.h>
+#include <rte_ip.h>
+#include <rte_mbuf_ptype.h>
+#include <rte_tcp.h>
+#include <rte_udp.h>
+#include <rte_vect.h>
+
+#include "net_ptype.h"
+
+/* Headers are read as 32-bit little endian words. */
+#define ETH_TYPE_IPV4	RTE_BE16(RTE_ETHER_TYPE_IPV4)
+#define ETH_TYPE_IPV6	RTE_BE16(RTE_ETHER_TYPE_IPV6)
+#define ETH_TYPE_VLAN	RTE_BE16(RTE_ETHER_TYPE_VLAN)
+#define IPV4_FRAG_MASK	RTE_BE16(RTE_IPV4_HDR_OFFSET_MASK | RTE_IPV4_HDR_MF_FLAG)
+
+/* Smallest packet parsed: Ethernet + IPv4 headers. */
+#define PTYPE_MIN_LEN	(RTE_ETHER_HDR_LEN + sizeof(struct rte_ipv4_hdr))
+
+/*
+ * Load the 32-bit words at offset off of the packets data,
+ * for the lanes enabled in mask only.
+ */
+static __rte_always_inline __m256i
+gather_u32(__m256i addr_lo, __m256i addr_hi, __m256i off, __m256i mask)
+{
+	__m256i idx_lo, idx_hi;
+	__m128i lo, hi;
+
+	idx_lo = _mm256_add_epi64(addr_lo,
+			_mm256_cvtepu32_epi64(_mm256_castsi256_si128(off)));
+	idx_hi = _mm256_add_epi64(addr_hi,
+			_mm256_cvtepu32_epi64(_mm256_extracti128_si256(off, 1)));
+	lo = _mm256_mask_i64gather_epi32(_mm_setzero_si128(), NULL, idx_lo,
+			_mm256_castsi256_si128(mask), 1);
+	hi = _mm256_mask_i64gather_epi32(_mm_setzero_si128(), NULL, idx_hi,
+			_mm256_extracti128_si256(mask, 1), 1);
+
+	return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+uint8_t
+rte_net_get_ptype_x8_avx2(struct rte_mbuf **pkts, uint32_t layers)
+{
+	alignas(RTE_CACHE_LINE_MIN_SIZE) uint64_t addr[NET_PTYPE_VEC_BURST];
+	alignas(RTE_CACHE_LINE_MIN_SIZE) uint32_t len[NET_PTYPE_VEC_BURST];
+	alignas(RTE_CACHE_LINE_MIN_SIZE) uint32_t ptype[NET_PTYPE_VEC_BURST];
+	alignas(RTE_CACHE_LINE_MIN_SIZE) uint32_t l2_len[NET_PTYPE_VEC_BURST];
+	alignas(RTE_CACHE_LINE_MIN_SIZE) uint32_t l3_len[NET_PTYPE_VEC_BURST];
+	alignas(RTE_CACHE_LINE_MIN_SIZE) uint32_t l4_len[NET_PTYPE_VEC_BURST];
+	const __m256i lo16 = _mm256_set1_epi32(UINT16_MAX);
+	const __m256i lo8 = _mm256_set1_epi32(UINT8_MAX);
+	__m256i addr_lo, addr_hi, vlen, ok;
+	__m256i w12, w16, etype, vlan, l3type, is4, is6;
+	__m256i l2, w0, w4, w8, vihl, v4ok, frag, proto, l3, tcp, udp;
+	__m256i l4off, need, w_tcp, l4, pt, pt_l3;
+	uint8_t mask;
+	unsigned int i;
+
+	for (i = 0; i < NET_PTYPE_VEC_BURST; i++) {
+		addr[i] = rte_pktmbuf_mtod(pkts[i], uintptr_t);
+		len[i] = pkts[i]->data_len;
+	}
+	addr_lo = _mm256_load_si256((const __m256i *)&addr[0]);
+	addr_hi = _mm256_load_si256((const __m256i *)&addr[4]);
+	vlen = _mm256_load_si256((const __m256i *)len);
+
+	/* L2: Ethernet, optionally followed by one VLAN tag. */
+	ok = _mm256_cmpgt_epi32(vlen, _mm256_set1_epi32(PTYPE_MIN_LEN - 1));
+	w12 = gather_u32(addr_lo, addr_hi, _mm256_set1_epi32(12), ok);
+	w16 = gather_u32(addr_lo, addr_hi, _mm256_set1_epi32(16), ok);
+	etype = _mm256_and_si256(w12, lo16);
+	vlan = _mm256_cmpeq_epi32(etype, _mm256_set1_epi32(ETH_TYPE_VLAN));
+	l3type = _mm256_blendv_epi8(etype, _mm256_and_si256(w16, lo16), vlan);
+	is4 = _mm256_cmpeq_epi32(l3type, _mm256_set1_epi32(ETH_TYPE_IPV4));
+	is6 = _mm256_cmpeq_epi32(l3type, _mm256_set1_epi32(ETH_TYPE_IPV6));
+	ok = _mm256_and_si256(ok, _mm256_or_si256(is4, is6));
+	l2 = _mm256_add_epi32(_mm256_set1_epi32(RTE_ETHER_HDR_LEN),
+			_mm256_and_si256(vlan, _mm256_set1_epi32(sizeof(struct rte_vlan_hdr))));
+
+	/*
+	 * L3: IPv4 without fragmentation, or IPv6 without extension header.
+	 * The first 12 bytes of the header are in the minimum length.
+	 */
+	w0 = gather_u32(addr_lo, addr_hi, l2, ok);
+	w4 = gather_u32(addr_lo, addr_hi,
+			_mm256_add_epi32(l2, _mm256_set1_epi32(4)), ok);
+	w8 = gather_u32(addr_lo, addr_hi,
+			_mm256_add_epi32(l2, _mm256_set1_epi32(8)), ok);
+	vihl = _mm256_and_si256(w0, lo8);
+	v4ok = _mm256_and_si256(is4,
+		_mm256_and_si256(_mm256_cmpgt_epi32(vihl, _mm256_set1_epi32(0x44)),
+			_mm256_cmpgt_epi32(_mm256_set1_epi32(0x50), vihl)));
+	frag = _mm256_and_si256(_mm256_srli_epi32(w4, 16),
+			_mm256_set1_epi32(IPV4_FRAG_MASK));
+	v4ok = _mm256_and_si256(v4ok,
+			_mm256_cmpeq_epi32(frag, _mm256_setzero_si256()));
+	ok = _mm256_and_si256(ok, _mm256_or_si256(v4ok, is6));
+	proto = _mm256_blendv_epi8(
+			_mm256_and_si256(_mm256_srli_epi32(w4, 16), lo8),
+			_mm256_and_si256(_mm256_srli_epi32(w8, 8), lo8), is4);
+	l3 = _mm256_blendv_epi8(_mm256_set1_epi32(sizeof(struct rte_ipv6_hdr)),
+			_mm256_slli_epi32(_mm256_and_si256(vihl,
+				_mm256_set1_epi32(RTE_IPV4_HDR_IHL_MASK)), 2), is4);
+
+	/* L4: TCP, or UDP when no tunnel is looked for. */
+	tcp = _mm256_cmpeq_epi32(proto, _mm256_set1_epi32(IPPROTO_TCP));
+	udp = _mm256_cmpeq_epi32(proto, _mm256_set1_epi32(IPPROTO_UDP));
+	if (layers & RTE_PTYPE_TUNNEL_MASK)
+		udp = _mm256_setzero_si256();
+	l4off = _mm256_add_epi32(l2, l3);
+	need = _mm256_add_epi32(l4off, _mm256_blendv_epi8(
+			_mm256_set1_epi32(sizeof(struct rte_udp_hdr)),
+			_mm256_set1_epi32(sizeof(struct rte_tcp_hdr)), tcp));
+	ok = _mm256_and_si256(ok, _mm256_or_si256(tcp, udp));
+	ok = _mm256_andnot_si256(_mm256_cmpgt_epi32(need, vlen), ok);
+
+	w_tcp = gather_u32(addr_lo, addr_hi,
+			_mm256_add_epi32(l4off, _mm256_set1_epi32(12)),
+			_mm256_and_si256(ok, tcp));
+	l4 = _mm256_blendv_epi8(_mm256_set1_epi32(sizeof(struct rte_udp_hdr)),
+			_mm256_srli_epi32(_mm256_and_si256(w_tcp,
+				_mm256_set1_epi32(0xf0)), 2), tcp);
+
+	/* Same packet types as rte_net_get_ptype(). */
+	pt_l3 = _mm256_blendv_epi8(_mm256_set1_epi32(RTE_PTYPE_L3_IPV4_EXT),
+			_mm256_set1_epi32(RTE_PTYPE_L3_IPV4),
+			_mm256_cmpeq_epi32(vihl, _mm256_set1_epi32(0x45)));
+	pt_l3 = _mm256_blendv_epi8(_mm256_set1_epi32(RTE_PTYPE_L3_IPV6),
+			pt_l3, is4);
+	pt = _mm256_or_si256(_mm256_set1_epi32(RTE_PTYPE_L2_ETHER),
+			_mm256_and_si256(vlan,
+				_mm256_set1_epi32(RTE_PTYPE_L2_ETHER_VLAN)));
+	pt = _mm256_or_si256(pt, pt_l3);
+	pt = _mm256_or_si256(pt, _mm256_blendv_epi8(
+			_mm256_set1_epi32(RTE_PTYPE_L4_UDP),
+			_mm256_set1_epi32(RTE_PTYPE_L4_TCP), tcp));
+
+	_mm256_store_si256((__m256i *)ptype, pt);
+	_mm256_store_si256((__m256i *)l2_len, l2);
+	_mm256_store_si256((__m256i *)l3_len, l3);
+	_mm256_store_si256((__m256i *)l4_len, l4);
+	mask = _mm256_movemask_ps(_mm256_castsi256_ps(ok));
+
+	for (i = 0; i < NET_PTYPE_VEC_BURST; i++) {
+		if ((mask & (1 << i)) == 0)
+			continue;
+		pkts[i]->packet_type = ptype[i];
+		pkts[i]->l2_len = l2_len[i];
+		pkts[i]->l3_len = l3_len[i];
+		pkts[i]->l4_len = l4_len[i];
+	}
+
+	return mask;
+}
@@ -19,12 +19,108 @@
 
 #include <rte_byteorder.h>
 #include <rte_common.h>
+#include <rte_compat.h>
 #include <rte_mbuf.h>
+#include <rte_vect.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/*
+ * Vector implementations of the raw checksum, used for the buffers of
+ * at least RTE_CKSUM_VEC_MIN_LEN bytes. As for rte_memcpy(), the AVX512
+ * version is only used when RTE_CKSUM_AVX512 is defined.
+ */
+#if defined(__AVX512F__) && defined(RTE_CKSUM_AVX512)
+#define RTE_CKSUM_VEC_BLOCK 64
+#elif defined(__AVX2__)
+#define RTE_CKSUM_VEC_BLOCK 32
+#elif defined(RTE_ARCH_ARM64) && defined(__ARM_NEON)
+#define RTE_CKSUM_VEC_BLOCK 16
+#endif
+
+#ifdef RTE_CKSUM_VEC_BLOCK
+
+/** Minimum length of the buffers summed with vector instructions. */
+#define RTE_CKSUM_VEC_MIN_LEN 256
+
+/*
+ * Each 32-bit lane of the accumulator grows by at most 2 * UINT16_MAX
+ * per block, so the lanes are folded every 32768 blocks.
+ */
+#define RTE_CKSUM_VEC_CHUNK (32768 * RTE_CKSUM_VEC_BLOCK)
+
+/**
+ * @internal Sum the 16-bit words of a buffer with vector instructions.
+ * Helper routine for the __rte_raw_cksum().
+ *
+ * @param buf
+ *   Pointer to the buffer.
+ * @param len
+ *   Length of the buffer, multiple of RTE_CKSUM_VEC_BLOCK.
+ * @return
+ *   The sum of all words in the buffer, reduced to 16 bits.
+ */
+static inline uint32_t
+__rte_raw_cksum_vec(const void *buf, size_t len)
+{
+	uint32_t lanes[RTE_CKSUM_VEC_BLOCK / sizeof(uint32_t)];
+	uint64_t sum = 0;
+	const void *end;
+	size_t n;
+	unsigned int i;
+
+	for (; len != 0; len -= n) {
+#if defined(__AVX512F__) && defined(RTE_CKSUM_AVX512)
+		const __m512i mask = _mm512_set1_epi32(UINT16_MAX);
+		__m512i acc = _mm512_setzero_si512();
+#elif defined(__AVX2__)
+		const __m256i mask = _mm256_set1_epi32(UINT16_MAX);
+		__m256i acc = _mm256_setzero_si256();
+#else
+		uint32x4_t acc = vdupq_n_u32(0);
+#endif
+
+		n = RTE_MIN(len, (size_t)RTE_CKSUM_VEC_CHUNK);
+		end = RTE_PTR_ADD(buf, n);
+		for (; buf != end; buf = RTE_PTR_ADD(buf, RTE_CKSUM_VEC_BLOCK)) {
+#if defined(__AVX512F__) && defined(RTE_CKSUM_AVX512)
+			__m512i v = _mm512_loadu_si512(buf);
+
+			acc = _mm512_add_epi32(acc, _mm512_and_si512(v, mask));
+			acc = _mm512_add_epi32(acc, _mm512_srli_epi32(v, 16));
+#elif defined(__AVX2__)
+			__m256i v = _mm256_loadu_si256((const __m256i *)buf);
+
+			acc = _mm256_add_epi32(acc, _mm256_and_si256(v, mask));
+			acc = _mm256_add_epi32(acc, _mm256_srli_epi32(v, 16));
+#else
+			acc = vpadalq_u16(acc, vld1q_u16((const uint16_t *)buf));
+#endif
+		}
+#if defined(__AVX512F__) && defined(RTE_CKSUM_AVX512)
+		_mm512_storeu_si512(lanes, acc);
+#elif defined(__AVX2__)
+		_mm256_storeu_si256((__m256i *)lanes, acc);
+#else
+		vst1q_u32(lanes, acc);
+#endif
+
+		for (i = 0; i < RTE_DIM(lanes); i++)
+			sum += lanes[i];
+	}
+
+	/* fold the sum, 2^32 being 1 modulo 2^16 - 1 */
+	sum = (sum & UINT32_MAX) + (sum >> 32);
+	sum = (sum & UINT32_MAX) + (sum >> 32);
+	sum = (sum & UINT16_MAX) + (sum >> 16);
+	sum = (sum & UINT16_MAX) + (sum >> 16);
+	return (uint32_t)sum;
+}
+
+#endif /* RTE_CKSUM_VEC_BLOCK */
+
 
 /**
  * @internal Calculate a sum of all words in the buffer.
@@ -44,6 +140,16 @@ __rte_raw_cksum(const void *buf, size_t len, uint32_t sum)
 {
 	const void *end;
 
+#ifdef RTE_CKSUM_VEC_BLOCK
+	if (len >= RTE_CKSUM_VEC_MIN_LEN) {
+		size_t vec_len = RTE_ALIGN_FLOOR(len, RTE_CKSUM_VEC_BLOCK);
+
+		sum += __rte_raw_cksum_vec(buf, vec_len);
+		buf = RTE_PTR_ADD(buf, vec_len);
+		len -= vec_len;
+	}
+#endif
+
 	for (end = RTE_PTR_ADD(buf, RTE_ALIGN_FLOOR(len, sizeof(uint16_t)));
 	     buf != end; buf = RTE_PTR_ADD(buf, sizeof(uint16_t))) {
 		uint16_t v;
@@ -173,6 +279,95 @@ rte_raw_cksum_mbuf(const struct rte_mbuf *m, uint32_t off, uint32_t len,
 	return 0;
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Update a checksum after the change of a 16-bit word of the data,
+ * as described in RFC 1624.
+ *
+ * The checksum and the word values are given in the same byte order,
+ * usually the network one. For UDP, the caller must handle the case of
+ * a zero checksum, meaning that no checksum is present.
+ *
+ * @param cksum
+ *   The checksum, as stored in the header.
+ * @param old_val
+ *   The old value of the word.
+ * @param new_val
+ *   The new value of the word.
+ * @return
+ *   The updated checksum.
+ */
+__rte_experimental
+static inline uint16_t
+rte_cksum_update16(uint16_t cksum, uint16_t old_val, uint16_t new_val)
+{
+	uint32_t sum;
+
+	sum = (uint16_t)~cksum + (uint16_t)~old_val + new_val;
+	return (uint16_t)~__rte_raw_cksum_reduce(sum);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Update a checksum after the change of a 32-bit word of the data,
+ * e.g. an IPv4 address, as described in RFC 1624.
+ *
+ * @param cksum
+ *   The checksum, as stored in the header.
+ * @param old_val
+ *   The old value of the word.
+ * @param new_val
+ *   The new value of the word.
+ * @return
+ *   The updated checksum.
+ */
+__rte_experimental
+static inline uint16_t
+rte_cksum_update32(uint16_t cksum, uint32_t old_val, uint32_t new_val)
+{
+	uint32_t sum;
+
+	sum = (uint16_t)~cksum;
+	sum += (uint16_t)~(old_val >> 16) + (uint16_t)~(old_val & 0xffff);
+	sum += (new_val >> 16) + (new_val & 0xffff);
+	return (uint16_t)~__rte_raw_cksum_reduce(sum);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Update a checksum after the change of a part of the data,
+ * e.g. an IPv6 address, as described in RFC 1624.
+ *
+ * @param cksum
+ *   The checksum, as stored in the header.
+ * @param old_data
+ *   Pointer to the old data.
+ * @param new_data
+ *   Pointer to the new data.
+ * @param len
+ *   Length of the data, must be even.
+ * @return
+ *   The updated checksum.
+ */
+__rte_experimental
+static inline uint16_t
+rte_cksum_update(uint16_t cksum, const void *old_data, const void *new_data,
+	size_t len)
+{
+	uint32_t sum;
+
+	sum = (uint16_t)~cksum;
+	sum += (uint16_t)~rte_raw_cksum(old_data, len);
+	sum += rte_raw_cksum(new_data, len);
+	return (uint16_t)~__rte_raw_cksum_reduce(sum);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,6 +8,8 @@
 #include <rte_mbuf.h>
 #include <rte_mbuf_ptype.h>
 #include <rte_byteorder.h>
+#include <rte_cpuflags.h>
+#include <rte_errno.h>
 #include <rte_ether.h>
 #include <rte_ip.h>
 #include <rte_tcp.h>
@@ -20,6 +22,10 @@
 #include <rte_gtp.h>
 #include <rte_net.h>
 #include <rte_os_shim.h>
+#include <rte_prefetch.h>
+#include <rte_vect.h>
+
+#include "net_ptype.h"
 
 /* get l3 packet type from ip6 next protocol */
 static uint32_t
@@ -615,3 +621,161 @@ uint32_t rte_net_get_ptype(const struct rte_mbuf *m,
 
 	return pkt_type;
 }
+
+/* set the packet type and header lengths of one mbuf */
+static void
+net_ptype_set(struct rte_mbuf *m, uint32_t layers)
+{
+	struct rte_net_hdr_lens hdr_lens = { 0 };
+
+	m->packet_type = rte_net_get_ptype(m, &hdr_lens, layers);
+	m->l2_len = hdr_lens.l2_len;
+	m->l3_len = hdr_lens.l3_len;
+	m->l4_len = hdr_lens.l4_len;
+}
+
+#ifdef RTE_ARCH_X86_64
+/* check once whether the AVX2 parser can be used */
+static bool
+net_ptype_avx2_enabled(void)
+{
+	static int enabled = -1;
+
+	if (unlikely(enabled < 0))
+		enabled = rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2) > 0 &&
+			rte_vect_get_max_simd_bitwidth() >= RTE_VECT_SIMD_256;
+	return enabled;
+}
+#endif
+
+/* parse a burst of mbufs to set their packet type */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_net_get_ptype_bulk, 26.03)
+void
+rte_net_get_ptype_bulk(struct rte_mbuf **pkts, uint16_t nb_pkts,
+	uint32_t layers)
+{
+	uint16_t i = 0;
+
+#ifdef RTE_ARCH_X86_64
+	const uint32_t vec_layers = RTE_PTYPE_L2_MASK | RTE_PTYPE_L3_MASK |
+		RTE_PTYPE_L4_MASK;
+	unsigned int j;
+	uint8_t mask;
+
+	/* the vector parser only handles the outer layers up to L4 */
+	if ((layers & vec_layers) == vec_layers && net_ptype_avx2_enabled()) {
+		for (; i + NET_PTYPE_VEC_BURST <= nb_pkts;
+				i += NET_PTYPE_VEC_BURST) {
+			mask = rte_net_get_ptype_x8_avx2(&pkts[i], layers);
+			for (j = 0; mask != UINT8_MAX && j < NET_PTYPE_VEC_BURST; j++)
+				if ((mask & (1 << j)) == 0)
+					net_ptype_set(pkts[i + j], layers);
+		}
+	}
+#endif
+
+	for (; i < nb_pkts; i++)
+		net_ptype_set(pkts[i], layers);
+}
+
+/* offset of the inner L3 header of a packet to transmit */
+static inline uint32_t
+net_cksum_l3_offset(const struct rte_mbuf *m)
+{
+	uint32_t off = m->l2_len;
+
+	if (m->ol_flags & (RTE_MBUF_F_TX_OUTER_IPV4 | RTE_MBUF_F_TX_OUTER_IPV6))
+		off += m->outer_l2_len + m->outer_l3_len;
+	return off;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_net_ipv4_cksum_bulk, 26.03)
+uint16_t
+rte_net_ipv4_cksum_bulk(struct rte_mbuf **pkts, uint16_t nb_pkts)
+{
+	struct rte_ipv4_hdr *ip4h;
+	struct rte_mbuf *m;
+	uint32_t off;
+	uint16_t i;
+
+	for (i = 0; i < nb_pkts; i++) {
+		m = pkts[i];
+		if (i + 1 < nb_pkts)
+			rte_prefetch0(rte_pktmbuf_mtod(pkts[i + 1], void *));
+		if ((m->ol_flags & RTE_MBUF_F_TX_IP_CKSUM) == 0)
+			continue;
+
+		off = net_cksum_l3_offset(m);
+		if (unlikely(rte_pktmbuf_data_len(m) < off + m->l3_len ||
+				m->l3_len < sizeof(*ip4h))) {
+			rte_errno = ENOTSUP;
+			return i;
+		}
+		ip4h = rte_pktmbuf_mtod_offset(m, struct rte_ipv4_hdr *, off);
+		ip4h->hdr_checksum = 0;
+		ip4h->hdr_checksum = rte_ipv4_cksum(ip4h);
+	}
+
+	return i;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_net_l4_cksum_bulk, 26.03)
+uint16_t
+rte_net_l4_cksum_bulk(struct rte_mbuf **pkts, uint16_t nb_pkts)
+{
+	const uint64_t seg_flags = RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_UDP_SEG;
+	struct rte_mbuf *m;
+	uint64_t l4_flags;
+	uint32_t off, l4_off, l4_hlen;
+	struct rte_tcp_hdr *th;
+	struct rte_udp_hdr *uh;
+	uint16_t cksum;
+	void *l3h;
+	uint16_t i;
+
+	for (i = 0; i < nb_pkts; i++) {
+		m = pkts[i];
+		if (i + 1 < nb_pkts)
+			rte_prefetch0(rte_pktmbuf_mtod(pkts[i + 1], void *));
+		l4_flags = m->ol_flags & RTE_MBUF_F_TX_L4_MASK;
+		if ((l4_flags != RTE_MBUF_F_TX_TCP_CKSUM &&
+				l4_flags != RTE_MBUF_F_TX_UDP_CKSUM) ||
+				(m->ol_flags & seg_flags) != 0)
+			continue;
+
+		if (unlikely((m->ol_flags &
+				(RTE_MBUF_F_TX_IPV4 | RTE_MBUF_F_TX_IPV6)) == 0)) {
+			rte_errno = EINVAL;
+			return i;
+		}
+
+		off = net_cksum_l3_offset(m);
+		l4_off = off + m->l3_len;
+		l4_hlen = l4_flags == RTE_MBUF_F_TX_TCP_CKSUM ?
+			sizeof(struct rte_tcp_hdr) : sizeof(struct rte_udp_hdr);
+		if (unlikely(rte_pktmbuf_data_len(m) < l4_off + l4_hlen)) {
+			rte_errno = ENOTSUP;
+			return i;
+		}
+
+		l3h = rte_pktmbuf_mtod_offset(m, void *, off);
+		th = rte_pktmbuf_mtod_offset(m, struct rte_tcp_hdr *, l4_off);
+		uh = rte_pktmbuf_mtod_offset(m, struct rte_udp_hdr *, l4_off);
+		if (l4_flags == RTE_MBUF_F_TX_TCP_CKSUM)
+			th->cksum = 0;
+		else
+			uh->dgram_cksum = 0;
+
+		if (m->ol_flags & RTE_MBUF_F_TX_IPV4)
+			cksum = rte_ipv4_udptcp_cksum_mbuf(m, l3h, l4_off);
+		else
+			cksum = rte_ipv6_udptcp_cksum_mbuf(m, l3h, l4_off);
+
+		if (l4_flags == RTE_MBUF_F_TX_TCP_CKSUM)
+			th->cksum = cksum;
+		else
+			uh->dgram_cksum = cksum;
+	}
+
+	return i;
+}
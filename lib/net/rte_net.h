@@ -5,6 +5,7 @@
 #ifndef _RTE_NET_PTYPE_H_
 #define _RTE_NET_PTYPE_H_
 
+#include <rte_compat.h>
 #include <rte_ip.h>
 #include <rte_udp.h>
 #include <rte_tcp.h>
@@ -87,6 +88,82 @@ rte_net_skip_ip6_ext(uint16_t proto, const struct rte_mbuf *m, uint32_t *off,
 uint32_t rte_net_get_ptype(const struct rte_mbuf *m,
 	struct rte_net_hdr_lens *hdr_lens, uint32_t layers);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Parse a burst of Ethernet packets to set their packet type.
+ *
+ * This function sets the packet_type, l2_len, l3_len and l4_len fields
+ * of each mbuf, with the same values as returned by rte_net_get_ptype().
+ * It is intended for the drivers and applications receiving packets
+ * without packet type from the hardware.
+ *
+ * When the CPU supports it, the most common packets (Ethernet with at most
+ * one VLAN tag, IPv4 without fragmentation or IPv6 without extension
+ * header, TCP or UDP, headers in the first segment) are parsed 8 at a time
+ * with vector instructions. The other packets are parsed one by one.
+ *
+ * @param pkts
+ *   The packets to be parsed.
+ * @param nb_pkts
+ *   The number of packets.
+ * @param layers
+ *   List of layers to parse, as for rte_net_get_ptype().
+ */
+__rte_experimental
+void rte_net_get_ptype_bulk(struct rte_mbuf **pkts, uint16_t nb_pkts,
+	uint32_t layers);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Compute in software the IPv4 header checksum of a burst of packets.
+ *
+ * The checksum is computed for the packets with RTE_MBUF_F_TX_IP_CKSUM
+ * only, using the l2_len and l3_len fields, and outer_l2_len and
+ * outer_l3_len for tunnel packets. The offload flags are not changed.
+ * The IPv4 header must be in the first segment.
+ *
+ * @param pkts
+ *   The packets to be processed.
+ * @param nb_pkts
+ *   The number of packets.
+ * @return
+ *   The number of packets processed. If lower than nb_pkts,
+ *   rte_errno is set for pkts[return value]:
+ *   - ENOTSUP: the header is not in the first segment.
+ */
+__rte_experimental
+uint16_t rte_net_ipv4_cksum_bulk(struct rte_mbuf **pkts, uint16_t nb_pkts);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Compute in software the TCP or UDP checksum of a burst of packets,
+ * including the pseudo-header.
+ *
+ * The checksum is computed for the packets with RTE_MBUF_F_TX_TCP_CKSUM
+ * or RTE_MBUF_F_TX_UDP_CKSUM and without segmentation offload only,
+ * using the same header lengths as rte_net_ipv4_cksum_bulk(). The payload
+ * may span several segments. The large payloads are summed with vector
+ * instructions when available. The offload flags are not changed.
+ *
+ * @param pkts
+ *   The packets to be processed.
+ * @param nb_pkts
+ *   The number of packets.
+ * @return
+ *   The number of packets processed. If lower than nb_pkts,
+ *   rte_errno is set for pkts[return value]:
+ *   - EINVAL: neither RTE_MBUF_F_TX_IPV4 nor RTE_MBUF_F_TX_IPV6 is set.
+ *   - ENOTSUP: the headers are not in the first segment.
+ */
+__rte_experimental
+uint16_t rte_net_l4_cksum_bulk(struct rte_mbuf **pkts, uint16_t nb_pkts);
+
 /**
  * Prepare pseudo header checksum
  *
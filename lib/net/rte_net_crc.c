@@ -11,6 +11,7 @@
 #include <rte_net_crc.h>
 #include <rte_vect.h>
 #include <rte_malloc.h>
+#include <rte_prefetch.h>
 
 #include "net_crc.h"
 
@@ -20,6 +21,9 @@
 
 #define CRC_LUT_SIZE 256
 
+/* Distance of the buffers prefetched by the bulk API */
+#define CRC_BULK_PREFETCH 4
+
 /* crc tables */
 static uint32_t crc32_eth_lut[CRC_LUT_SIZE];
 static uint32_t crc16_ccitt_lut[CRC_LUT_SIZE];
@@ -30,9 +34,21 @@ rte_crc16_ccitt_handler(const uint8_t *data, uint32_t data_len);
 static uint32_t
 rte_crc32_eth_handler(const uint8_t *data, uint32_t data_len);
 
+static void
+rte_crc16_ccitt_bulk_handler(const void * const data[],
+	const uint32_t data_len[], uint32_t crc[], uint32_t num);
+
+static void
+rte_crc32_eth_bulk_handler(const void * const data[],
+	const uint32_t data_len[], uint32_t crc[], uint32_t num);
+
 typedef uint32_t
 (*rte_net_crc_handler)(const uint8_t *data, uint32_t data_len);
 
+typedef void
+(*rte_net_crc_bulk_handler)(const void * const data[],
+	const uint32_t data_len[], uint32_t crc[], uint32_t num);
+
 struct rte_net_crc {
 	enum rte_net_crc_alg alg;
 	enum rte_net_crc_type type;
@@ -40,7 +56,9 @@ struct rte_net_crc {
 
 static struct {
 	rte_net_crc_handler f[RTE_NET_CRC_REQS];
-} handlers[RTE_NET_CRC_AVX512 + 1];
+	rte_net_crc_bulk_handler bulk[RTE_NET_CRC_REQS];
+	/**< NULL if the buffers are processed one by one with f */
+} handlers[RTE_NET_CRC_AVX2 + 1];
 
 /* Scalar handling */
 
@@ -96,6 +114,52 @@ crc32_eth_calc_lut(const uint8_t *data,
 	return crc;
 }
 
+/*
+ * Process the buffers by groups of 4, interleaving the table lookups
+ * of their common length to hide the latency of each lookup.
+ */
+static __rte_always_inline void
+crc32_eth_calc_lut_bulk(const void * const data[],
+	const uint32_t data_len[],
+	uint32_t crc[],
+	uint32_t num,
+	uint32_t init,
+	const uint32_t *lut)
+{
+	const uint8_t *p0, *p1, *p2, *p3;
+	uint32_t c0, c1, c2, c3;
+	uint32_t i, j, len;
+
+	for (i = 0; i + 4 <= num; i += 4) {
+		p0 = data[i];
+		p1 = data[i + 1];
+		p2 = data[i + 2];
+		p3 = data[i + 3];
+		len = RTE_MIN(data_len[i], data_len[i + 1]);
+		len = RTE_MIN(len, data_len[i + 2]);
+		len = RTE_MIN(len, data_len[i + 3]);
+
+		c0 = c1 = c2 = c3 = init;
+		for (j = 0; j < len; j++) {
+			c0 = lut[(c0 ^ p0[j]) & 0xffL] ^ (c0 >> 8);
+			c1 = lut[(c1 ^ p1[j]) & 0xffL] ^ (c1 >> 8);
+			c2 = lut[(c2 ^ p2[j]) & 0xffL] ^ (c2 >> 8);
+			c3 = lut[(c3 ^ p3[j]) & 0xffL] ^ (c3 >> 8);
+		}
+
+		crc[i] = crc32_eth_calc_lut(p0 + len, data_len[i] - len, c0, lut);
+		crc[i + 1] = crc32_eth_calc_lut(p1 + len, data_len[i + 1] - len,
+			c1, lut);
+		crc[i + 2] = crc32_eth_calc_lut(p2 + len, data_len[i + 2] - len,
+			c2, lut);
+		crc[i + 3] = crc32_eth_calc_lut(p3 + len, data_len[i + 3] - len,
+			c3, lut);
+	}
+
+	for (; i < num; i++)
+		crc[i] = crc32_eth_calc_lut(data[i], data_len[i], init, lut);
+}
+
 static void
 rte_net_crc_scalar_init(void)
 {
@@ -126,6 +190,32 @@ rte_crc32_eth_handler(const uint8_t *data, uint32_t data_len)
 		crc32_eth_lut);
 }
 
+static void
+rte_crc16_ccitt_bulk_handler(const void * const data[],
+	const uint32_t data_len[], uint32_t crc[], uint32_t num)
+{
+	uint32_t i;
+
+	crc32_eth_calc_lut_bulk(data, data_len, crc, num, 0xffff,
+		crc16_ccitt_lut);
+	/* return 16-bit CRC values */
+	for (i = 0; i < num; i++)
+		crc[i] = (uint16_t)~crc[i];
+}
+
+static void
+rte_crc32_eth_bulk_handler(const void * const data[],
+	const uint32_t data_len[], uint32_t crc[], uint32_t num)
+{
+	uint32_t i;
+
+	crc32_eth_calc_lut_bulk(data, data_len, crc, num, 0xffffffffUL,
+		crc32_eth_lut);
+	/* return 32-bit CRC values */
+	for (i = 0; i < num; i++)
+		crc[i] = ~crc[i];
+}
+
 /* AVX512/VPCLMULQDQ handling */
 
 #define AVX512_VPCLMULQDQ_CPU_SUPPORTED ( \
@@ -146,6 +236,23 @@ avx512_vpclmulqdq_init(void)
 #endif
 }
 
+/* AVX2/VPCLMULQDQ handling */
+
+#define AVX2_VPCLMULQDQ_CPU_SUPPORTED ( \
+	rte_cpu_get_flag_enabled(RTE_CPUFLAG_AVX2) && \
+	rte_cpu_get_flag_enabled(RTE_CPUFLAG_PCLMULQDQ) && \
+	rte_cpu_get_flag_enabled(RTE_CPUFLAG_VPCLMULQDQ) \
+)
+
+static void
+avx2_vpclmulqdq_init(void)
+{
+#ifdef CC_AVX2_VPCLMULQDQ_SUPPORT
+	if (AVX2_VPCLMULQDQ_CPU_SUPPORTED)
+		rte_net_crc_avx2_init();
+#endif
+}
+
 /* SSE4.2/PCLMULQDQ handling */
 
 #define SSE42_PCLMULQDQ_CPU_SUPPORTED \
@@ -188,6 +295,15 @@ handlers_init(enum rte_net_crc_alg alg)
 			handlers[alg].f[RTE_NET_CRC32_ETH] = rte_crc32_eth_avx512_handler;
 			break;
 		}
+#endif
+		/* fall-through */
+	case RTE_NET_CRC_AVX2:
+#ifdef CC_AVX2_VPCLMULQDQ_SUPPORT
+		if (AVX2_VPCLMULQDQ_CPU_SUPPORTED) {
+			handlers[alg].f[RTE_NET_CRC16_CCITT] = rte_crc16_ccitt_avx2_handler;
+			handlers[alg].f[RTE_NET_CRC32_ETH] = rte_crc32_eth_avx2_handler;
+			break;
+		}
 #endif
 		/* fall-through */
 	case RTE_NET_CRC_SSE42:
@@ -212,6 +328,12 @@ handlers_init(enum rte_net_crc_alg alg)
 	default:
 		break;
 	}
+
+	/* the scalar handlers have their interleaved bulk variant */
+	if (handlers[alg].f[RTE_NET_CRC16_CCITT] == rte_crc16_ccitt_handler)
+		handlers[alg].bulk[RTE_NET_CRC16_CCITT] = rte_crc16_ccitt_bulk_handler;
+	if (handlers[alg].f[RTE_NET_CRC32_ETH] == rte_crc32_eth_handler)
+		handlers[alg].bulk[RTE_NET_CRC32_ETH] = rte_crc32_eth_bulk_handler;
 }
 
 /* Public API */
@@ -236,6 +358,12 @@ struct rte_net_crc *rte_net_crc_set_alg(enum rte_net_crc_alg alg, enum rte_net_c
 			return crc;
 		}
 		/* fall-through */
+	case RTE_NET_CRC_AVX2:
+		if (max_simd_bitwidth >= RTE_VECT_SIMD_256) {
+			crc->alg = RTE_NET_CRC_AVX2;
+			return crc;
+		}
+		/* fall-through */
 	case RTE_NET_CRC_SSE42:
 		if (max_simd_bitwidth >= RTE_VECT_SIMD_128) {
 			crc->alg = RTE_NET_CRC_SSE42;
@@ -268,15 +396,40 @@ uint32_t rte_net_crc_calc(const struct rte_net_crc *ctx, const void *data, const
 	return handlers[ctx->alg].f[ctx->type](data, data_len);
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_net_crc_calc_bulk, 26.03)
+void rte_net_crc_calc_bulk(const struct rte_net_crc *ctx,
+	const void * const data[], const uint32_t data_len[],
+	uint32_t crc[], uint32_t num)
+{
+	rte_net_crc_handler f = handlers[ctx->alg].f[ctx->type];
+	uint32_t i;
+
+	if (handlers[ctx->alg].bulk[ctx->type] != NULL) {
+		handlers[ctx->alg].bulk[ctx->type](data, data_len, crc, num);
+		return;
+	}
+
+	/* the CRC of the buffers are independent, only prefetch ahead */
+	for (i = 0; i < num && i < CRC_BULK_PREFETCH; i++)
+		rte_prefetch0(data[i]);
+	for (i = 0; i < num; i++) {
+		if (i + CRC_BULK_PREFETCH < num)
+			rte_prefetch0(data[i + CRC_BULK_PREFETCH]);
+		crc[i] = f(data[i], data_len[i]);
+	}
+}
+
 /* Call initialisation helpers for all crc algorithm handlers */
 RTE_INIT(rte_net_crc_init)
 {
 	rte_net_crc_scalar_init();
 	sse42_pclmulqdq_init();
+	avx2_vpclmulqdq_init();
 	avx512_vpclmulqdq_init();
 	neon_pmull_init();
 	handlers_init(RTE_NET_CRC_SCALAR);
 	handlers_init(RTE_NET_CRC_NEON);
 	handlers_init(RTE_NET_CRC_SSE42);
+	handlers_init(RTE_NET_CRC_AVX2);
 	handlers_init(RTE_NET_CRC_AVX512);
 }
@@ -7,6 +7,7 @@
 
 #include <stdint.h>
 #include <rte_common.h>
+#include <rte_compat.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,6 +26,7 @@ enum rte_net_crc_alg {
 	RTE_NET_CRC_SSE42,
 	RTE_NET_CRC_NEON,
 	RTE_NET_CRC_AVX512,
+	RTE_NET_CRC_AVX2,
 };
 
 /** CRC context (algorithm, type) */
@@ -51,6 +53,7 @@ rte_net_crc_free(struct rte_net_crc *crc);
  *   - RTE_NET_CRC_SSE42 (Use 64-bit SSE4.2 intrinsic)
  *   - RTE_NET_CRC_NEON (Use ARM Neon intrinsic)
  *   - RTE_NET_CRC_AVX512 (Use 512-bit AVX intrinsic)
+ *   - RTE_NET_CRC_AVX2 (Use 256-bit AVX intrinsic)
  * @param type
  *   CRC type (enum rte_net_crc_type)
  *
@@ -82,6 +85,33 @@ uint32_t
 rte_net_crc_calc(const struct rte_net_crc *ctx,
 	const void *data, const uint32_t data_len);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * CRC compute API for many buffers
+ *
+ * Computes the CRC of each buffer as rte_net_crc_calc(),
+ * with a cheaper per buffer cost for small buffers,
+ * such as the headers protected by eCPRI or PDCP.
+ *
+ * @param ctx
+ *   Pointer to the CRC context
+ * @param data
+ *   Array of pointers to the data of each buffer
+ * @param data_len
+ *   Array of data lengths of each buffer
+ * @param crc
+ *   Array of CRC values, filled by the function
+ * @param num
+ *   Number of buffers
+ */
+__rte_experimental
+void
+rte_net_crc_calc_bulk(const struct rte_net_crc *ctx,
+	const void * const data[], const uint32_t data_len[],
+	uint32_t crc[], uint32_t num);
+
 #ifdef __cplusplus
 }
 #endif
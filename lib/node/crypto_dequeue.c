@@ -0,0 +1,117 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2026 Marvell.
+ */
+
+#include <rte_cryptodev.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_ip.h>
+#include <rte_ipsec.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+
+#include "rte_node_ipsec_api.h"
+
+#include "ipsec_priv.h"
+#include "node_private.h"
+
+/* Give back the room of Ethernet header and classify the packet for pkt_cls */
+static __rte_always_inline void
+crypto_dequeue_pkt_finalize(struct rte_mbuf *mbuf)
+{
+	const struct rte_ipv4_hdr *ipv4_hdr;
+
+	ipv4_hdr = rte_pktmbuf_mtod(mbuf, const struct rte_ipv4_hdr *);
+	if ((ipv4_hdr->version_ihl >> 4) == IPVERSION)
+		mbuf->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV4_EXT_UNKNOWN;
+	else
+		mbuf->packet_type = RTE_PTYPE_L2_ETHER | RTE_PTYPE_L3_IPV6_EXT_UNKNOWN;
+
+	/* Headroom is at least the size of the stripped headers */
+	rte_pktmbuf_prepend(mbuf, sizeof(struct rte_ether_hdr));
+}
+
+static uint16_t
+crypto_dequeue_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+			    uint16_t cnt)
+{
+	struct rte_ipsec_group grp[IPSEC_CRYPTO_BURST];
+	struct rte_crypto_op *cops[IPSEC_CRYPTO_BURST];
+	struct rte_mbuf *mb[IPSEC_CRYPTO_BURST];
+	uint16_t i, j, n, ng, k, done = 0;
+	struct ipsec_crypto_qp *qp;
+	unsigned int lcore;
+	uint16_t drops = 0;
+
+	RTE_SET_USED(objs);
+	RTE_SET_USED(cnt);
+
+	lcore = rte_lcore_id();
+	if (unlikely(lcore >= RTE_MAX_LCORE))
+		return 0;
+
+	qp = &ipsec_crypto_qps[lcore];
+	if (unlikely(qp->cop_pool == NULL))
+		return 0;
+
+	n = rte_cryptodev_dequeue_burst(qp->dev_id, qp->qp_id, cops, IPSEC_CRYPTO_BURST);
+	if (n == 0)
+		return 0;
+
+	ng = rte_ipsec_pkt_crypto_group((const struct rte_crypto_op **)(uintptr_t)cops,
+					mb, grp, n);
+	rte_mempool_put_bulk(qp->cop_pool, (void **)cops, n);
+
+	for (i = 0; i < ng; i++) {
+		/* Invalid packets are moved after the k processed ones */
+		k = rte_ipsec_pkt_process(grp[i].id.ptr, grp[i].m, grp[i].cnt);
+
+		for (j = 0; j < k; j++)
+			crypto_dequeue_pkt_finalize(grp[i].m[j]);
+
+		if (likely(k != 0))
+			rte_node_enqueue(graph, node, RTE_NODE_CRYPTO_DEQUEUE_NEXT_PKT_CLS,
+					 (void **)grp[i].m, k);
+		if (unlikely(k != grp[i].cnt)) {
+			rte_node_enqueue(graph, node, RTE_NODE_CRYPTO_DEQUEUE_NEXT_PKT_DROP,
+					 (void **)&grp[i].m[k], grp[i].cnt - k);
+			drops += grp[i].cnt - k;
+		}
+		done += grp[i].cnt;
+	}
+
+	/* Packets without session are placed after the groups */
+	if (unlikely(done != n)) {
+		rte_node_enqueue(graph, node, RTE_NODE_CRYPTO_DEQUEUE_NEXT_PKT_DROP,
+				 (void **)&mb[done], n - done);
+		drops += n - done;
+	}
+
+	NODE_INCREMENT_XSTAT_ID(node, 0, drops != 0, drops);
+
+	return n;
+}
+
+static struct rte_node_xstats crypto_dequeue_xstats = {
+	.nb_xstats = 1,
+	.xstat_desc = {
+		[0] = "crypto_dequeue_drop",
+	},
+};
+
+static struct rte_node_register crypto_dequeue_node = {
+	.process = crypto_dequeue_node_process,
+	.flags = RTE_NODE_SOURCE_F,
+	.name = "crypto_dequeue",
+
+	.xstats = &crypto_dequeue_xstats,
+
+	.nb_edges = RTE_NODE_CRYPTO_DEQUEUE_NEXT_MAX,
+	.next_nodes = {
+		[RTE_NODE_CRYPTO_DEQUEUE_NEXT_PKT_DROP] = "pkt_drop",
+		[RTE_NODE_CRYPTO_DEQUEUE_NEXT_PKT_CLS] = "pkt_cls",
+	},
+};
+
+RTE_NODE_REGISTER(crypto_dequeue_node);
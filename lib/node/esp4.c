@@ -0,0 +1,181 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2026 Marvell.
+ */
+
+#include <rte_cryptodev.h>
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_ip.h>
+#include <rte_ipsec.h>
+#include <rte_lcore.h>
+#include <rte_mbuf.h>
+
+#include "rte_node_ipsec_api.h"
+
+#include "ipsec_priv.h"
+#include "node_private.h"
+
+struct esp_node_ctx {
+	/* Dynamic offset to mbuf priv1 */
+	int mbuf_priv1_off;
+};
+
+#define ESP_NODE_PRIV1_OFF(ctx) \
+	(((struct esp_node_ctx *)ctx)->mbuf_priv1_off)
+
+/* Strip Ethernet header and set the L3 header length for IPsec library */
+static __rte_always_inline void
+esp_pkt_prepare(struct rte_mbuf *mbuf)
+{
+	const struct rte_ipv4_hdr *ipv4_hdr;
+
+	rte_pktmbuf_adj(mbuf, sizeof(struct rte_ether_hdr));
+
+	ipv4_hdr = rte_pktmbuf_mtod(mbuf, const struct rte_ipv4_hdr *);
+	mbuf->l2_len = 0;
+	if ((ipv4_hdr->version_ihl >> 4) == IPVERSION)
+		mbuf->l3_len = rte_ipv4_hdr_len(ipv4_hdr);
+	else
+		mbuf->l3_len = sizeof(struct rte_ipv6_hdr);
+}
+
+static __rte_always_inline uint16_t
+esp_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+		 uint16_t nb_objs, const uint64_t dir)
+{
+	const int dyn = ESP_NODE_PRIV1_OFF(node->ctx);
+	struct rte_crypto_op *cops[IPSEC_CRYPTO_BURST];
+	struct rte_mbuf **pkts, **mb;
+	struct ipsec_crypto_qp *qp;
+	struct ipsec_node_sa *sa;
+	uint16_t i, j, n, k, enq;
+	uint16_t drops = 0;
+	unsigned int lcore;
+	uint32_t sa_idx;
+
+	lcore = rte_lcore_id();
+	qp = lcore < RTE_MAX_LCORE ? &ipsec_crypto_qps[lcore] : NULL;
+	if (unlikely(qp == NULL || qp->cop_pool == NULL)) {
+		rte_node_enqueue(graph, node, RTE_NODE_ESP_NEXT_PKT_DROP, objs, nb_objs);
+		NODE_INCREMENT_XSTAT_ID(node, 0, true, nb_objs);
+		return nb_objs;
+	}
+
+	pkts = (struct rte_mbuf **)objs;
+
+	for (i = 0; i < nb_objs; i += n) {
+		/* Group the consecutive packets of the same SA */
+		sa_idx = node_mbuf_priv1(pkts[i], dyn)->sa_idx;
+		for (n = 1; i + n < nb_objs && n < IPSEC_CRYPTO_BURST; n++)
+			if (node_mbuf_priv1(pkts[i + n], dyn)->sa_idx != sa_idx)
+				break;
+		mb = &pkts[i];
+
+		sa = sa_idx < RTE_NODE_IPSEC_SA_MAX ? &ipsec_node_sas[sa_idx] : NULL;
+		if (unlikely(sa == NULL || sa->ss == NULL ||
+			     (sa->type & RTE_IPSEC_SATP_DIR_MASK) != dir ||
+			     rte_crypto_op_bulk_alloc(qp->cop_pool,
+						      RTE_CRYPTO_OP_TYPE_SYMMETRIC,
+						      cops, n) == 0)) {
+			rte_node_enqueue(graph, node, RTE_NODE_ESP_NEXT_PKT_DROP,
+					 (void **)mb, n);
+			drops += n;
+			continue;
+		}
+
+		for (j = 0; j < n; j++) {
+			if (likely(j + 4 < n))
+				rte_prefetch0(rte_pktmbuf_mtod(mb[j + 4], void *));
+			esp_pkt_prepare(mb[j]);
+		}
+
+		/* Invalid packets are moved after the k prepared ones */
+		k = rte_ipsec_pkt_crypto_prepare(sa->ss, mb, cops, n);
+		enq = rte_cryptodev_enqueue_burst(qp->dev_id, qp->qp_id, cops, k);
+
+		/* Packets enqueued are owned by cryptodev until dequeued */
+		if (unlikely(enq != n)) {
+			rte_mempool_put_bulk(qp->cop_pool, (void **)&cops[enq], n - enq);
+			rte_node_enqueue(graph, node, RTE_NODE_ESP_NEXT_PKT_DROP,
+					 (void **)&mb[enq], n - enq);
+			drops += n - enq;
+		}
+	}
+
+	NODE_INCREMENT_XSTAT_ID(node, 0, drops != 0, drops);
+
+	return nb_objs;
+}
+
+static uint16_t
+esp4_encrypt_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+			  uint16_t nb_objs)
+{
+	return esp_node_process(graph, node, objs, nb_objs, RTE_IPSEC_SATP_DIR_OB);
+}
+
+static uint16_t
+esp4_decrypt_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+			  uint16_t nb_objs)
+{
+	return esp_node_process(graph, node, objs, nb_objs, RTE_IPSEC_SATP_DIR_IB);
+}
+
+static int
+esp_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	int dyn;
+
+	RTE_SET_USED(graph);
+	RTE_BUILD_BUG_ON(sizeof(struct esp_node_ctx) > RTE_NODE_CTX_SZ);
+
+	dyn = rte_node_mbuf_dynfield_register();
+	if (dyn < 0) {
+		node_err("esp", "Failed to register mbuf dynfield, rc=%d", -rte_errno);
+		return -rte_errno;
+	}
+
+	ESP_NODE_PRIV1_OFF(node->ctx) = dyn;
+
+	node_dbg("esp", "Initialized %s node", node->name);
+
+	return 0;
+}
+
+static struct rte_node_xstats esp_xstats = {
+	.nb_xstats = 1,
+	.xstat_desc = {
+		[0] = "esp_crypto_drop",
+	},
+};
+
+static struct rte_node_register esp4_encrypt_node = {
+	.process = esp4_encrypt_node_process,
+	.name = "esp4_encrypt",
+
+	.init = esp_node_init,
+	.xstats = &esp_xstats,
+
+	.nb_edges = RTE_NODE_ESP_NEXT_MAX,
+	.next_nodes = {
+		[RTE_NODE_ESP_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(esp4_encrypt_node);
+
+static struct rte_node_register esp4_decrypt_node = {
+	.process = esp4_decrypt_node_process,
+	.name = "esp4_decrypt",
+
+	.init = esp_node_init,
+	.xstats = &esp_xstats,
+
+	.nb_edges = RTE_NODE_ESP_NEXT_MAX,
+	.next_nodes = {
+		[RTE_NODE_ESP_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+RTE_NODE_REGISTER(esp4_decrypt_node);
@@ -13,6 +13,7 @@
 
 #include "ethdev_rx_priv.h"
 #include "ethdev_tx_priv.h"
+#include "gso_priv.h"
 #include "ip4_rewrite_priv.h"
 #include "ip6_rewrite_priv.h"
 #include "interface_tx_feature_priv.h"
@@ -30,6 +31,7 @@ rte_node_eth_config(struct rte_node_ethdev_config *conf, uint16_t nb_confs,
 	struct rte_node_register *if_tx_feature_node;
 	struct rte_node_register *ip4_rewrite_node;
 	struct rte_node_register *ip6_rewrite_node;
+	struct rte_node_register *gso_node;
 	struct ethdev_tx_node_main *tx_node_data;
 	uint16_t tx_q_used, rx_q_used, port_id;
 	struct rte_node_register *tx_node;
@@ -42,6 +44,7 @@ rte_node_eth_config(struct rte_node_ethdev_config *conf, uint16_t nb_confs,
 	if_tx_feature_node = if_tx_feature_node_get();
 	ip4_rewrite_node = ip4_rewrite_node_get();
 	ip6_rewrite_node = ip6_rewrite_node_get();
+	gso_node = gso_node_get();
 	tx_node_data = ethdev_tx_node_data_get();
 	tx_node = ethdev_tx_node_get();
 	for (i = 0; i < nb_confs; i++) {
@@ -135,6 +138,15 @@ rte_node_eth_config(struct rte_node_ethdev_config *conf, uint16_t nb_confs,
 				     &next_nodes, 1);
 		rc = if_tx_feature_node_set_next(port_id,
 						 rte_node_edge_count(if_tx_feature_node->id) - 1);
+		if (rc < 0)
+			return rc;
+
+		/* Add this tx port node as next to gso_node */
+		rte_node_edge_update(gso_node->id, RTE_EDGE_ID_INVALID,
+				     &next_nodes, 1);
+		rc = gso_node_set_next(port_id, rte_node_edge_count(gso_node->id) - 1);
+		if (rc < 0)
+			return rc;
 	}
 
 	ctrl.nb_graphs = nb_graphs;
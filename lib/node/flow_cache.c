@@ -0,0 +1,352 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2026 Marvell.
+ */
+
+#include <eal_export.h>
+#include <rte_errno.h>
+#include <rte_ether.h>
+#include <rte_fib.h>
+#include <rte_fib6.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_hash_crc.h>
+#include <rte_ip.h>
+#include <rte_malloc.h>
+#include <rte_stdatomic.h>
+
+#include "rte_node_flow_cache_api.h"
+#include "rte_node_ip4_api.h"
+#include "rte_node_ip6_api.h"
+
+#include "node_private.h"
+
+#define FLOW_CACHE_MASK (RTE_NODE_FLOW_CACHE_SIZE - 1)
+
+/*
+ * The next hop only depends on the destination, so an entry stays valid
+ * for any flow to the same destination: the full 5-tuple is compared
+ * only to keep the flows from evicting each other.
+ */
+struct flow_cache_ip4_entry {
+	uint32_t src;
+	uint32_t dst;
+	uint32_t ports;
+	uint8_t proto;
+	uint16_t nh;
+	/* Generation of the entry, 0 if invalid */
+	uint32_t gen;
+};
+
+struct flow_cache_ip6_entry {
+	struct rte_ipv6_addr src;
+	struct rte_ipv6_addr dst;
+	uint32_t ports;
+	uint8_t proto;
+	uint16_t nh;
+	/* Generation of the entry, 0 if invalid */
+	uint32_t gen;
+};
+
+/* Per graph flow cache */
+struct flow_cache {
+	struct flow_cache_ip4_entry ip4[RTE_NODE_FLOW_CACHE_SIZE];
+	struct flow_cache_ip6_entry ip6[RTE_NODE_FLOW_CACHE_SIZE];
+	/* Socket's FIBs of the lookup nodes */
+	struct rte_fib *fib;
+	struct rte_fib6 *fib6;
+};
+
+struct flow_cache_node_ctx {
+	/* Graph's flow cache */
+	struct flow_cache *fc;
+	/* Dynamic offset to mbuf priv1 */
+	int mbuf_priv1_off;
+	/* Cached next index */
+	uint16_t next_index;
+};
+
+/* Generation of the valid entries, bumped to invalidate all the caches */
+static RTE_ATOMIC(uint32_t) flow_cache_gen = 1;
+
+#define FLOW_CACHE_NODE(ctx) \
+	(((struct flow_cache_node_ctx *)ctx)->fc)
+
+#define FLOW_CACHE_NODE_PRIV1_OFF(ctx) \
+	(((struct flow_cache_node_ctx *)ctx)->mbuf_priv1_off)
+
+#define FLOW_CACHE_NODE_NEXT_INDEX(ctx) \
+	(((struct flow_cache_node_ctx *)ctx)->next_index)
+
+#define FLOW_CACHE_L4_PORTS(proto) \
+	((proto) == IPPROTO_TCP || (proto) == IPPROTO_UDP)
+
+static __rte_always_inline uint16_t
+flow_cache_ip4_process(struct flow_cache *fc, struct rte_mbuf *mbuf, const int dyn,
+		       uint32_t gen, uint16_t *hits)
+{
+	struct flow_cache_ip4_entry *e;
+	struct rte_ipv4_hdr *ipv4_hdr;
+	uint32_t dst, hash, ports = 0;
+	uint64_t next_hop;
+
+	ipv4_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv4_hdr *,
+			sizeof(struct rte_ether_hdr));
+	/* Extract cksum, ttl as ipv4 hdr is in cache */
+	node_mbuf_priv1(mbuf, dyn)->cksum = ipv4_hdr->hdr_checksum;
+	node_mbuf_priv1(mbuf, dyn)->ttl = ipv4_hdr->time_to_live;
+
+	/* Only the first fragment has the ports */
+	if (FLOW_CACHE_L4_PORTS(ipv4_hdr->next_proto_id) &&
+	    !(ipv4_hdr->fragment_offset &
+	      rte_cpu_to_be_16(RTE_IPV4_HDR_OFFSET_MASK | RTE_IPV4_HDR_MF_FLAG)))
+		ports = *(const unaligned_uint32_t *)RTE_PTR_ADD(ipv4_hdr,
+				rte_ipv4_hdr_len(ipv4_hdr));
+
+	hash = rte_hash_crc_4byte(ports, ipv4_hdr->next_proto_id);
+	hash = rte_hash_crc_4byte(ipv4_hdr->src_addr, hash);
+	hash = rte_hash_crc_4byte(ipv4_hdr->dst_addr, hash);
+	e = &fc->ip4[hash & FLOW_CACHE_MASK];
+
+	if (likely(e->gen == gen && e->dst == ipv4_hdr->dst_addr &&
+		   e->src == ipv4_hdr->src_addr && e->ports == ports &&
+		   e->proto == ipv4_hdr->next_proto_id)) {
+		node_mbuf_priv1(mbuf, dyn)->nh = e->nh;
+		*hits += 1;
+		return RTE_NODE_FLOW_CACHE_NEXT_IP4_REWRITE;
+	}
+
+	dst = rte_be_to_cpu_32(ipv4_hdr->dst_addr);
+	rte_fib_lookup_bulk(fc->fib, &dst, &next_hop, 1);
+	/* Local and dropped packets take the regular path */
+	if ((next_hop >> 16) != RTE_NODE_IP4_LOOKUP_NEXT_REWRITE)
+		return RTE_NODE_FLOW_CACHE_NEXT_IP4_LOOKUP;
+
+	e->src = ipv4_hdr->src_addr;
+	e->dst = ipv4_hdr->dst_addr;
+	e->ports = ports;
+	e->proto = ipv4_hdr->next_proto_id;
+	e->nh = (uint16_t)next_hop;
+	e->gen = gen;
+
+	node_mbuf_priv1(mbuf, dyn)->nh = e->nh;
+	return RTE_NODE_FLOW_CACHE_NEXT_IP4_REWRITE;
+}
+
+static __rte_always_inline uint16_t
+flow_cache_ip6_process(struct flow_cache *fc, struct rte_mbuf *mbuf, const int dyn,
+		       uint32_t gen, uint16_t *hits)
+{
+	struct flow_cache_ip6_entry *e;
+	struct rte_ipv6_hdr *ipv6_hdr;
+	uint32_t hash, ports = 0;
+	uint64_t next_hop;
+
+	ipv6_hdr = rte_pktmbuf_mtod_offset(mbuf, struct rte_ipv6_hdr *,
+			sizeof(struct rte_ether_hdr));
+	/* Extract hop_limits as ipv6 hdr is in cache */
+	node_mbuf_priv1(mbuf, dyn)->ttl = ipv6_hdr->hop_limits;
+
+	/* Extension headers are not parsed, their flows share the entry */
+	if (FLOW_CACHE_L4_PORTS(ipv6_hdr->proto))
+		ports = *(const unaligned_uint32_t *)RTE_PTR_ADD(ipv6_hdr,
+				sizeof(struct rte_ipv6_hdr));
+
+	hash = rte_hash_crc_4byte(ports, ipv6_hdr->proto);
+	hash = rte_hash_crc(&ipv6_hdr->src_addr, 2 * sizeof(struct rte_ipv6_addr), hash);
+	e = &fc->ip6[hash & FLOW_CACHE_MASK];
+
+	if (likely(e->gen == gen && rte_ipv6_addr_eq(&e->dst, &ipv6_hdr->dst_addr) &&
+		   rte_ipv6_addr_eq(&e->src, &ipv6_hdr->src_addr) && e->ports == ports &&
+		   e->proto == ipv6_hdr->proto)) {
+		node_mbuf_priv1(mbuf, dyn)->nh = e->nh;
+		*hits += 1;
+		return RTE_NODE_FLOW_CACHE_NEXT_IP6_REWRITE;
+	}
+
+	rte_fib6_lookup_bulk(fc->fib6, &ipv6_hdr->dst_addr, &next_hop, 1);
+	/* Dropped packets take the regular path */
+	if ((next_hop >> 16) != RTE_NODE_IP6_LOOKUP_NEXT_REWRITE)
+		return RTE_NODE_FLOW_CACHE_NEXT_IP6_LOOKUP;
+
+	e->src = ipv6_hdr->src_addr;
+	e->dst = ipv6_hdr->dst_addr;
+	e->ports = ports;
+	e->proto = ipv6_hdr->proto;
+	e->nh = (uint16_t)next_hop;
+	e->gen = gen;
+
+	node_mbuf_priv1(mbuf, dyn)->nh = e->nh;
+	return RTE_NODE_FLOW_CACHE_NEXT_IP6_REWRITE;
+}
+
+static uint16_t
+flow_cache_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+			uint16_t nb_objs)
+{
+	const int dyn = FLOW_CACHE_NODE_PRIV1_OFF(node->ctx);
+	struct flow_cache *fc = FLOW_CACHE_NODE(node->ctx);
+	struct rte_mbuf *mbuf0, **pkts;
+	void **to_next, **from;
+	uint16_t last_spec = 0;
+	rte_edge_t next_index;
+	uint16_t held = 0;
+	uint16_t hits = 0;
+	uint32_t gen;
+	uint16_t next;
+	int i;
+
+	gen = rte_atomic_load_explicit(&flow_cache_gen, rte_memory_order_relaxed);
+
+	/* Speculative next */
+	next_index = FLOW_CACHE_NODE_NEXT_INDEX(node->ctx);
+	next = next_index;
+
+	pkts = (struct rte_mbuf **)objs;
+	from = objs;
+
+	/* Get stream for the speculated next node */
+	to_next = rte_node_next_stream_get(graph, node, next_index, nb_objs);
+
+	for (i = 0; i < 4 && i < nb_objs; i++)
+		rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[i], void *,
+					sizeof(struct rte_ether_hdr)));
+
+	for (i = 0; i < nb_objs; i++) {
+		mbuf0 = pkts[i];
+
+		/* Prefetch next mbuf data */
+		if (likely(i + 4 < nb_objs))
+			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[i + 4], void *,
+						sizeof(struct rte_ether_hdr)));
+
+		if (RTE_ETH_IS_IPV4_HDR(mbuf0->packet_type))
+			next = flow_cache_ip4_process(fc, mbuf0, dyn, gen, &hits);
+		else if (RTE_ETH_IS_IPV6_HDR(mbuf0->packet_type))
+			next = flow_cache_ip6_process(fc, mbuf0, dyn, gen, &hits);
+		else
+			next = RTE_NODE_FLOW_CACHE_NEXT_PKT_DROP;
+
+		if (unlikely(next_index ^ next)) {
+			/* Copy things successfully speculated till now */
+			rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+			from += last_spec;
+			to_next += last_spec;
+			held += last_spec;
+			last_spec = 0;
+
+			rte_node_enqueue_x1(graph, node, next, from[0]);
+			from += 1;
+		} else {
+			last_spec += 1;
+		}
+	}
+
+	NODE_INCREMENT_XSTAT_ID(node, 0, hits != 0, hits);
+	NODE_INCREMENT_XSTAT_ID(node, 1, hits != nb_objs, nb_objs - hits);
+
+	/* !!! Home run !!! */
+	if (likely(last_spec == nb_objs)) {
+		rte_node_next_stream_move(graph, node, next_index);
+		return nb_objs;
+	}
+
+	held += last_spec;
+	rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+	rte_node_next_stream_put(graph, node, next_index, held);
+
+	/* Speculate the next of the last packet for the next burst */
+	FLOW_CACHE_NODE_NEXT_INDEX(node->ctx) = next;
+
+	return nb_objs;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_flow_cache_flush, 26.03)
+void
+rte_node_flow_cache_flush(void)
+{
+	uint32_t gen;
+
+	/* Generation 0 marks the invalid entries */
+	gen = rte_atomic_fetch_add_explicit(&flow_cache_gen, 1, rte_memory_order_relaxed) + 1;
+	if (unlikely(gen == 0))
+		rte_atomic_fetch_add_explicit(&flow_cache_gen, 1, rte_memory_order_relaxed);
+}
+
+static int
+flow_cache_node_init(const struct rte_graph *graph, struct rte_node *node)
+{
+	struct flow_cache *fc;
+	int dyn;
+
+	RTE_BUILD_BUG_ON(sizeof(struct flow_cache_node_ctx) > RTE_NODE_CTX_SZ);
+	RTE_BUILD_BUG_ON(RTE_NODE_FLOW_CACHE_SIZE & FLOW_CACHE_MASK);
+
+	dyn = rte_node_mbuf_dynfield_register();
+	if (dyn < 0) {
+		node_err("flow_cache", "Failed to register mbuf dynfield, rc=%d",
+			 -rte_errno);
+		return -rte_errno;
+	}
+
+	fc = rte_zmalloc_socket("flow_cache", sizeof(*fc), RTE_CACHE_LINE_SIZE,
+				graph->socket);
+	if (fc == NULL) {
+		node_err("flow_cache", "Failed to allocate flow cache for graph %s",
+			 graph->name);
+		return -ENOMEM;
+	}
+
+	fc->fib = node_ip4_fib_get(graph->socket);
+	fc->fib6 = node_ip6_fib_get(graph->socket);
+	if (fc->fib == NULL || fc->fib6 == NULL) {
+		node_err("flow_cache", "Failed to setup fibs for sock %d, rc=%d",
+			 graph->socket, -rte_errno);
+		rte_free(fc);
+		return -rte_errno;
+	}
+
+	FLOW_CACHE_NODE(node->ctx) = fc;
+	FLOW_CACHE_NODE_PRIV1_OFF(node->ctx) = dyn;
+	FLOW_CACHE_NODE_NEXT_INDEX(node->ctx) = RTE_NODE_FLOW_CACHE_NEXT_IP4_REWRITE;
+
+	node_dbg("flow_cache", "Initialized flow_cache node");
+
+	return 0;
+}
+
+static void
+flow_cache_node_fini(const struct rte_graph *graph, struct rte_node *node)
+{
+	RTE_SET_USED(graph);
+
+	rte_free(FLOW_CACHE_NODE(node->ctx));
+	FLOW_CACHE_NODE(node->ctx) = NULL;
+}
+
+static struct rte_node_xstats flow_cache_xstats = {
+	.nb_xstats = 2,
+	.xstat_desc = {
+		[0] = "flow_cache_hit",
+		[1] = "flow_cache_miss",
+	},
+};
+
+static struct rte_node_register flow_cache_node = {
+	.process = flow_cache_node_process,
+	.name = "flow_cache",
+
+	.init = flow_cache_node_init,
+	.fini = flow_cache_node_fini,
+	.xstats = &flow_cache_xstats,
+
+	.nb_edges = RTE_NODE_FLOW_CACHE_NEXT_MAX,
+	.next_nodes = {
+		[RTE_NODE_FLOW_CACHE_NEXT_PKT_DROP] = "pkt_drop",
+		[RTE_NODE_FLOW_CACHE_NEXT_IP4_LOOKUP] = "ip4_lookup_fib",
+		[RTE_NODE_FLOW_CACHE_NEXT_IP6_LOOKUP] = "ip6_lookup_fib",
+		[RTE_NODE_FLOW_CACHE_NEXT_IP4_REWRITE] = "ip4_rewrite",
+		[RTE_NODE_FLOW_CACHE_NEXT_IP6_REWRITE] = "ip6_rewrite",
+	},
+};
+
+RTE_NODE_REGISTER(flow_cache_node);
@@ -0,0 +1,151 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2026 Marvell.
+ */
+
+#include <eal_export.h>
+#include <rte_ethdev.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_gso.h>
+#include <rte_malloc.h>
+#include <rte_mbuf.h>
+
+#include "rte_node_gro_gso_api.h"
+
+#include "gso_priv.h"
+#include "node_private.h"
+
+/* Maximum number of segments of a packet */
+#define GSO_MAX_SEGS 64
+
+/*
+ * @internal array for mapping port to next node index
+ */
+struct gso_node_main {
+	uint16_t next_index[RTE_MAX_ETHPORTS];
+	/* GSO context, valid if gso_size is not 0 */
+	struct rte_gso_ctx ctx;
+};
+
+static struct gso_node_main *gso_nm;
+
+static int
+gso_node_main_alloc(void)
+{
+	if (gso_nm == NULL) {
+		gso_nm = rte_zmalloc("gso_nm", sizeof(struct gso_node_main),
+				     RTE_CACHE_LINE_SIZE);
+		if (gso_nm == NULL)
+			return -ENOMEM;
+	}
+
+	return 0;
+}
+
+int
+gso_node_set_next(uint16_t port_id, uint16_t next_index)
+{
+	if (gso_node_main_alloc() < 0)
+		return -ENOMEM;
+
+	gso_nm->next_index[port_id] = next_index;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_gso_configure, 26.03)
+int
+rte_node_gso_configure(const struct rte_gso_ctx *ctx)
+{
+	if (ctx == NULL || ctx->direct_pool == NULL || ctx->indirect_pool == NULL ||
+	    ctx->gso_size == 0)
+		return -EINVAL;
+
+	if (gso_node_main_alloc() < 0)
+		return -ENOMEM;
+
+	gso_nm->ctx = *ctx;
+
+	return 0;
+}
+
+static uint16_t
+gso_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+		 uint16_t nb_objs)
+{
+	struct rte_mbuf *segs[GSO_MAX_SEGS];
+	struct rte_mbuf *mbuf0, **pkts;
+	uint16_t segmented = 0;
+	uint16_t next0, i;
+	int nb_segs;
+
+	pkts = (struct rte_mbuf **)objs;
+
+	if (unlikely(gso_nm == NULL)) {
+		rte_node_enqueue(graph, node, RTE_NODE_GSO_NEXT_PKT_DROP, objs, nb_objs);
+		return nb_objs;
+	}
+
+	for (i = 0; i < nb_objs; i++) {
+		mbuf0 = pkts[i];
+
+		if (likely(i + 4 < nb_objs))
+			rte_prefetch0(pkts[i + 4]);
+
+		next0 = gso_nm->next_index[mbuf0->port];
+
+		if (likely(!(mbuf0->ol_flags & (RTE_MBUF_F_TX_TCP_SEG | RTE_MBUF_F_TX_UDP_SEG)))) {
+			rte_node_enqueue_x1(graph, node, next0, mbuf0);
+			continue;
+		}
+
+		if (unlikely(gso_nm->ctx.gso_size == 0)) {
+			rte_node_enqueue_x1(graph, node, RTE_NODE_GSO_NEXT_PKT_DROP, mbuf0);
+			continue;
+		}
+
+		nb_segs = rte_gso_segment(mbuf0, &gso_nm->ctx, segs, GSO_MAX_SEGS);
+		if (nb_segs == 0) {
+			/* Small enough to be sent as is */
+			rte_node_enqueue_x1(graph, node, next0, mbuf0);
+		} else if (likely(nb_segs > 0)) {
+			/* Segments hold references to the packet data */
+			rte_pktmbuf_free(mbuf0);
+			rte_node_enqueue(graph, node, next0, (void **)segs, nb_segs);
+			segmented++;
+		} else {
+			rte_node_enqueue_x1(graph, node, RTE_NODE_GSO_NEXT_PKT_DROP, mbuf0);
+		}
+	}
+
+	NODE_INCREMENT_XSTAT_ID(node, 0, segmented != 0, segmented);
+
+	return nb_objs;
+}
+
+static struct rte_node_xstats gso_xstats = {
+	.nb_xstats = 1,
+	.xstat_desc = {
+		[0] = "gso_segmented",
+	},
+};
+
+static struct rte_node_register gso_node = {
+	.process = gso_node_process,
+	.name = "gso",
+
+	.xstats = &gso_xstats,
+
+	.nb_edges = RTE_NODE_GSO_NEXT_MAX,
+	.next_nodes = {
+		[RTE_NODE_GSO_NEXT_PKT_DROP] = "pkt_drop",
+	},
+};
+
+struct rte_node_register *
+gso_node_get(void)
+{
+	return &gso_node;
+}
+
+RTE_NODE_REGISTER(gso_node);
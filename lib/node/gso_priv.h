@@ -0,0 +1,31 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2026 Marvell.
+ */
+#ifndef __INCLUDE_GSO_PRIV_H__
+#define __INCLUDE_GSO_PRIV_H__
+
+#include <rte_common.h>
+
+/**
+ * @internal
+ *
+ * Get the GSO node.
+ *
+ * @return
+ *   Pointer to the GSO node.
+ */
+struct rte_node_register *gso_node_get(void);
+
+/**
+ * @internal
+ *
+ * Set the Edge index of a given port_id.
+ *
+ * @param port_id
+ *   Ethernet port identifier.
+ * @param next_index
+ *   Edge index of the Given Tx node.
+ */
+int gso_node_set_next(uint16_t port_id, uint16_t next_index);
+
+#endif /* __INCLUDE_GSO_PRIV_H__ */
@@ -12,6 +12,7 @@
 #include <rte_graph_worker.h>
 #include <rte_ip.h>
 
+#include "rte_node_flow_cache_api.h"
 #include "rte_node_ip4_api.h"
 
 #include "node_private.h"
@@ -245,6 +246,9 @@ rte_node_ip4_fib_route_add(uint32_t ip, uint8_t depth, uint16_t next_hop,
 		}
 	}
 
+	/* Flows to the new route may be cached with another next hop */
+	rte_node_flow_cache_flush();
+
 	return 0;
 }
 
@@ -274,6 +278,20 @@ setup_fib(int socket)
 	return 0;
 }
 
+struct rte_fib *
+node_ip4_fib_get(int socket)
+{
+	int rc;
+
+	rc = setup_fib(socket);
+	if (rc) {
+		rte_errno = -rc;
+		return NULL;
+	}
+
+	return ip4_lookup_fib_nm.fib[socket];
+}
+
 static int
 ip4_lookup_fib_node_init(const struct rte_graph *graph, struct rte_node *node)
 {
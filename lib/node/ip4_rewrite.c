@@ -52,6 +52,11 @@ static int port_to_next_index_diff = -1;
 #define IP4_REWRITE_NODE_LAST_TX_IF(ctx) \
 	(((struct ip4_rewrite_node_ctx *)ctx)->last_tx_if)
 
+/* Values of check_enabled_features in __ip4_rewrite_node_process() */
+#define IP4_REWRITE_FEATURES_NONE	0
+#define IP4_REWRITE_FEATURES_PER_PORT	1
+#define IP4_REWRITE_FEATURES_UNIFORM	2
+
 static __rte_always_inline void
 check_output_feature_arc_x1(struct rte_graph_feature_arc *arc, uint16_t *tx_if,
 			    struct rte_mbuf *mbuf0, uint16_t *next0,
@@ -181,11 +186,33 @@ check_output_feature_arc_x4(struct rte_graph_feature_arc *arc, uint16_t *tx_if,
 	}
 }
 
+/*
+ * Features are enabled only on uniform_port. Steer its packets with the
+ * uniform first feature of arc, no per packet first feature lookup needed.
+ */
+static __rte_always_inline void
+check_output_feature_arc_uniform_x1(struct rte_mbuf *mbuf0, uint16_t *next0,
+				    uint16_t uniform_port, rte_edge_t uniform_edge,
+				    rte_graph_feature_data_t uniform_fdata,
+				    const int feat_dyn)
+{
+	struct rte_graph_feature_arc_mbuf_dynfields *d0 = NULL;
+
+	if (unlikely(*next0 == (uniform_port + port_to_next_index_diff))) {
+		d0 = rte_graph_feature_arc_mbuf_dynfields_get(mbuf0, feat_dyn);
+		d0->feature_data = uniform_fdata;
+		mbuf0->port = uniform_port;
+		*next0 = uniform_edge;
+	}
+}
+
 static __rte_always_inline uint16_t
 __ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 			   void **objs, uint16_t nb_objs,
 			   const int dyn, const int feat_dyn, const int check_enabled_features,
-			   struct rte_graph_feature_arc *out_feature_arc)
+			   struct rte_graph_feature_arc *out_feature_arc,
+			   uint16_t uniform_port, rte_edge_t uniform_edge,
+			   rte_graph_feature_data_t uniform_fdata)
 {
 	rte_graph_feature_data_t feature_data = RTE_GRAPH_FEATURE_DATA_INVALID;
 	struct rte_mbuf *mbuf0, *mbuf1, *mbuf2, *mbuf3, **pkts;
@@ -211,7 +238,7 @@ __ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 	for (i = 0; i < 4 && i < n_left_from; i++)
 		rte_prefetch0(pkts[i]);
 
-	if (check_enabled_features) {
+	if (check_enabled_features == IP4_REWRITE_FEATURES_PER_PORT) {
 		rte_graph_feature_arc_prefetch(out_feature_arc);
 
 		last_tx_if = IP4_REWRITE_NODE_LAST_TX_IF(node->ctx);
@@ -313,11 +340,25 @@ __ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		 * check if any feature is enabled to override
 		 * next edges
 		 */
-		if (check_enabled_features)
+		if (check_enabled_features == IP4_REWRITE_FEATURES_UNIFORM) {
+			check_output_feature_arc_uniform_x1(mbuf0, &next0, uniform_port,
+							    uniform_edge, uniform_fdata,
+							    feat_dyn);
+			check_output_feature_arc_uniform_x1(mbuf1, &next1, uniform_port,
+							    uniform_edge, uniform_fdata,
+							    feat_dyn);
+			check_output_feature_arc_uniform_x1(mbuf2, &next2, uniform_port,
+							    uniform_edge, uniform_fdata,
+							    feat_dyn);
+			check_output_feature_arc_uniform_x1(mbuf3, &next3, uniform_port,
+							    uniform_edge, uniform_fdata,
+							    feat_dyn);
+		} else if (check_enabled_features) {
 			check_output_feature_arc_x4(out_feature_arc, &last_tx_if,
 						    mbuf0, mbuf1, mbuf2, mbuf3,
 						    &next0, &next1, &next2, &next3,
 						    &last_next_index, &feature_data, feat_dyn);
+		}
 
 		/* Enqueue four to next node */
 		rte_edge_t fix_spec =
@@ -412,7 +453,11 @@ __ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 		ip0->hdr_checksum = chksum;
 		ip0->time_to_live = node_mbuf_priv1(mbuf0, dyn)->ttl - 1;
 
-		if (check_enabled_features)
+		if (check_enabled_features == IP4_REWRITE_FEATURES_UNIFORM)
+			check_output_feature_arc_uniform_x1(mbuf0, &next0, uniform_port,
+							    uniform_edge, uniform_fdata,
+							    feat_dyn);
+		else if (check_enabled_features)
 			check_output_feature_arc_x1(out_feature_arc, &last_tx_if,
 						    mbuf0, &next0, &last_next_index,
 						    &feature_data, feat_dyn);
@@ -444,7 +489,7 @@ __ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 	/* Save the last next used */
 	IP4_REWRITE_NODE_LAST_NEXT(node->ctx) = next_index;
 
-	if (check_enabled_features)
+	if (check_enabled_features == IP4_REWRITE_FEATURES_PER_PORT)
 		IP4_REWRITE_NODE_LAST_TX_IF(node->ctx) = last_tx_if;
 
 	return nb_objs;
@@ -456,17 +501,30 @@ ip4_rewrite_feature_node_process(struct rte_graph *graph, struct rte_node *node,
 {
 	const int dyn = IP4_REWRITE_NODE_PRIV1_OFF(node->ctx);
 	const int feat_dyn = IP4_REWRITE_NODE_FEAT_OFF(node->ctx);
+	rte_graph_feature_data_t uniform_fdata;
 	struct rte_graph_feature_arc *arc = NULL;
+	rte_edge_t uniform_edge;
+	uint16_t uniform_port;
 
 	arc = rte_graph_feature_arc_get(IP4_REWRITE_NODE_OUTPUT_FEATURE_ARC(node->ctx));
 	if (unlikely(rte_graph_feature_arc_is_any_feature_enabled(arc) &&
-		     (port_to_next_index_diff > 0)))
+		     (port_to_next_index_diff > 0))) {
+		/* Features enabled on a single port, skip per port lookups */
+		if (rte_graph_feature_arc_uniform_get(arc, &uniform_port,
+						      &uniform_fdata, &uniform_edge))
+			return __ip4_rewrite_node_process(graph, node, objs, nb_objs, dyn,
+							  feat_dyn, IP4_REWRITE_FEATURES_UNIFORM,
+							  arc, uniform_port, uniform_edge,
+							  uniform_fdata);
+
 		return __ip4_rewrite_node_process(graph, node, objs, nb_objs, dyn, feat_dyn,
-						  1 /* check features */, arc);
+						  IP4_REWRITE_FEATURES_PER_PORT, arc,
+						  0, 0, 0 /* don't care */);
+	}
 
 	return __ip4_rewrite_node_process(graph, node, objs, nb_objs, dyn, 0,
-					  0/* don't check features*/,
-					  arc /* don't care*/);
+					  IP4_REWRITE_FEATURES_NONE,
+					  arc /* don't care*/, 0, 0, 0);
 }
 
 static uint16_t
@@ -476,8 +534,8 @@ ip4_rewrite_node_process(struct rte_graph *graph, struct rte_node *node,
 	const int dyn = IP4_REWRITE_NODE_PRIV1_OFF(node->ctx);
 
 	return __ip4_rewrite_node_process(graph, node, objs, nb_objs, dyn, 0,
-					  0/* don't check features*/,
-					  NULL/* don't care */);
+					  IP4_REWRITE_FEATURES_NONE,
+					  NULL/* don't care */, 0, 0, 0);
 }
 
 
@@ -12,6 +12,7 @@
 #include <rte_graph_worker.h>
 #include <rte_ip.h>
 
+#include "rte_node_flow_cache_api.h"
 #include "rte_node_ip6_api.h"
 
 #include "node_private.h"
@@ -33,6 +34,8 @@ static struct ip6_lookup_fib_node_main ip6_lookup_fib_nm;
 #define FIB6_DEFAULT_MAX_ROUTES (UINT16_MAX)
 #define FIB6_DEFAULT_NUM_TBL8   (UINT16_MAX / 2)
 #define FIB6_DEFAULT_NH (RTE_NODE_IP6_LOOKUP_NEXT_PKT_DROP << 16)
+/* Number of DIPs given at once to the FIB, a multiple of the AVX-512 lookup width */
+#define IP6_LOOKUP_FIB_BATCH 32
 
 #define IP6_LOOKUP_FIB_NODE(ctx) \
 	(((struct ip6_lookup_fib_node_ctx *)ctx)->fib6)
@@ -44,133 +47,87 @@ static uint16_t
 ip6_lookup_fib_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
 			    uint16_t nb_objs)
 {
-	struct rte_mbuf *mbuf0, *mbuf1, *mbuf2, *mbuf3, **pkts;
 	const int dyn = IP6_LOOKUP_FIB_NODE_PRIV1_OFF(node->ctx);
 	struct rte_fib6 *fib = IP6_LOOKUP_FIB_NODE(node->ctx);
-	struct rte_ipv6_addr ip[RTE_GRAPH_BURST_SIZE] = { 0 };
-	uint64_t next_hop[RTE_GRAPH_BURST_SIZE];
+	struct rte_ipv6_addr ip[IP6_LOOKUP_FIB_BATCH];
+	uint64_t next_hop[IP6_LOOKUP_FIB_BATCH];
+	struct rte_mbuf *mbuf0, **pkts;
 	struct rte_ipv6_hdr *ipv6_hdr;
+	uint16_t i, j, n, pf_end;
 	uint16_t lookup_err = 0;
 	void **to_next, **from;
 	uint16_t last_spec = 0;
 	rte_edge_t next_index;
-	uint16_t n_left_from;
 	uint16_t held = 0;
 	uint16_t next;
-	int i;
 
 	/* Speculative next */
 	next_index = RTE_NODE_IP6_LOOKUP_NEXT_REWRITE;
 
 	pkts = (struct rte_mbuf **)objs;
 	from = objs;
-	n_left_from = nb_objs;
 
 	/* Get stream for the speculated next node */
 	to_next = rte_node_next_stream_get(graph, node, next_index, nb_objs);
 
-	for (i = 0; i < 4 && i < n_left_from; i++)
-		rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[i], void *,
-					sizeof(struct rte_ether_hdr)));
-
-	i = 0;
-	while (n_left_from >= 4) {
-		if (likely(n_left_from > 7)) {
-
-			/* Prefetch next-next mbufs */
-			if (likely(n_left_from > 11)) {
-				rte_prefetch0(pkts[8]);
-				rte_prefetch0(pkts[9]);
-				rte_prefetch0(pkts[10]);
-				rte_prefetch0(pkts[11]);
-			}
-
-			/* Prefetch next mbuf data */
-			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[4], void *,
-					sizeof(struct rte_ether_hdr)));
-			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[5], void *,
-					sizeof(struct rte_ether_hdr)));
-			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[6], void *,
-					sizeof(struct rte_ether_hdr)));
-			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[7], void *,
+	n = RTE_MIN(nb_objs, IP6_LOOKUP_FIB_BATCH);
+	for (j = 0; j < n; j++)
+		rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[j], void *,
 					sizeof(struct rte_ether_hdr)));
+	pf_end = RTE_MIN(nb_objs, 2 * IP6_LOOKUP_FIB_BATCH);
+	for (j = n; j < pf_end; j++)
+		rte_prefetch0(pkts[j]);
+
+	/*
+	 * The stream is looked up in batches. While the FIB looks up a batch,
+	 * the headers of the next batch and the mbufs of the one after are
+	 * prefetched, so that extracting the next DIPs does not stall.
+	 */
+	for (i = 0; i < nb_objs; i += n) {
+		n = RTE_MIN(nb_objs - i, IP6_LOOKUP_FIB_BATCH);
+
+		for (j = 0; j < n; j++) {
+			mbuf0 = pkts[i + j];
+			/* Extract DIP of mbuf0 */
+			ipv6_hdr = rte_pktmbuf_mtod_offset(mbuf0, struct rte_ipv6_hdr *,
+					sizeof(struct rte_ether_hdr));
+			/* Extract hop_limits as ipv6 hdr is in cache */
+			node_mbuf_priv1(mbuf0, dyn)->ttl = ipv6_hdr->hop_limits;
+
+			ip[j] = ipv6_hdr->dst_addr;
 		}
 
-		mbuf0 = pkts[0];
-		mbuf1 = pkts[1];
-		mbuf2 = pkts[2];
-		mbuf3 = pkts[3];
-		pkts += 4;
-		n_left_from -= 4;
-		/* Extract DIP of mbuf0 */
-		ipv6_hdr = rte_pktmbuf_mtod_offset(mbuf0, struct rte_ipv6_hdr *,
-				sizeof(struct rte_ether_hdr));
-		/* Extract hop_limits as ipv6 hdr is in cache */
-		node_mbuf_priv1(mbuf0, dyn)->ttl = ipv6_hdr->hop_limits;
-
-		ip[i++] = ipv6_hdr->dst_addr;
-
-		/* Extract DIP of mbuf1 */
-		ipv6_hdr = rte_pktmbuf_mtod_offset(mbuf1, struct rte_ipv6_hdr *,
-				sizeof(struct rte_ether_hdr));
-		/* Extract hop_limits as ipv6 hdr is in cache */
-		node_mbuf_priv1(mbuf1, dyn)->ttl = ipv6_hdr->hop_limits;
-
-		ip[i++] = ipv6_hdr->dst_addr;
-
-		/* Extract DIP of mbuf2 */
-		ipv6_hdr = rte_pktmbuf_mtod_offset(mbuf2, struct rte_ipv6_hdr *,
-				sizeof(struct rte_ether_hdr));
-		/* Extract hop_limits as ipv6 hdr is in cache */
-		node_mbuf_priv1(mbuf2, dyn)->ttl = ipv6_hdr->hop_limits;
-
-		ip[i++] = ipv6_hdr->dst_addr;
-
-		/* Extract DIP of mbuf3 */
-		ipv6_hdr = rte_pktmbuf_mtod_offset(mbuf3, struct rte_ipv6_hdr *,
-				sizeof(struct rte_ether_hdr));
-		/* Extract hop_limits as ipv6 hdr is in cache */
-		node_mbuf_priv1(mbuf3, dyn)->ttl = ipv6_hdr->hop_limits;
-
-		ip[i++] = ipv6_hdr->dst_addr;
-	}
-	while (n_left_from > 0) {
-		mbuf0 = pkts[0];
-		pkts += 1;
-		n_left_from -= 1;
-
-		/* Extract DIP of mbuf0 */
-		ipv6_hdr = rte_pktmbuf_mtod_offset(mbuf0, struct rte_ipv6_hdr *,
-				sizeof(struct rte_ether_hdr));
-		/* Extract hop_limits as ipv6 hdr is in cache */
-		node_mbuf_priv1(mbuf0, dyn)->ttl = ipv6_hdr->hop_limits;
-
-		ip[i++] = ipv6_hdr->dst_addr;
-	}
+		pf_end = RTE_MIN(nb_objs, i + n + IP6_LOOKUP_FIB_BATCH);
+		for (j = i + n; j < pf_end; j++)
+			rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[j], void *,
+						sizeof(struct rte_ether_hdr)));
+		for (j = pf_end; j < RTE_MIN(nb_objs, pf_end + IP6_LOOKUP_FIB_BATCH); j++)
+			rte_prefetch0(pkts[j]);
+
+		rte_fib6_lookup_bulk(fib, ip, next_hop, n);
+
+		for (j = 0; j < n; j++) {
+			mbuf0 = pkts[i + j];
+			node_mbuf_priv1(mbuf0, dyn)->nh = (uint16_t)next_hop[j];
+			next = (uint16_t)(next_hop[j] >> 16);
+
+			if (unlikely(next_index ^ next)) {
+				/* Copy things successfully speculated till now */
+				rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
+				from += last_spec;
+				to_next += last_spec;
+				held += last_spec;
+				last_spec = 0;
+
+				rte_node_enqueue_x1(graph, node, next, from[0]);
+				from += 1;
+			} else {
+				last_spec += 1;
+			}
 
-	rte_fib6_lookup_bulk(fib, ip, next_hop, nb_objs);
-
-	for (i = 0; i < nb_objs; i++) {
-		mbuf0 = (struct rte_mbuf *)objs[i];
-		node_mbuf_priv1(mbuf0, dyn)->nh = (uint16_t)next_hop[i];
-		next = (uint16_t)(next_hop[i] >> 16);
-
-		if (unlikely(next_index ^ next)) {
-			/* Copy things successfully speculated till now */
-			rte_memcpy(to_next, from, last_spec * sizeof(from[0]));
-			from += last_spec;
-			to_next += last_spec;
-			held += last_spec;
-			last_spec = 0;
-
-			rte_node_enqueue_x1(graph, node, next, from[0]);
-			from += 1;
-		} else {
-			last_spec += 1;
+			if (unlikely(next_hop[j] == FIB6_DEFAULT_NH))
+				lookup_err += 1;
 		}
-
-		if (unlikely(next_hop[i] == FIB6_DEFAULT_NH))
-			lookup_err += 1;
 	}
 
 	/* !!! Home run !!! */
@@ -237,6 +194,9 @@ rte_node_ip6_fib_route_add(const struct rte_ipv6_addr *ip, uint8_t depth, uint16
 		}
 	}
 
+	/* Flows to the new route may be cached with another next hop */
+	rte_node_flow_cache_flush();
+
 	return 0;
 }
 
@@ -265,6 +225,20 @@ setup_fib6(int socket)
 	return 0;
 }
 
+struct rte_fib6 *
+node_ip6_fib_get(int socket)
+{
+	int rc;
+
+	rc = setup_fib6(socket);
+	if (rc) {
+		rte_errno = -rc;
+		return NULL;
+	}
+
+	return ip6_lookup_fib_nm.fib6[socket];
+}
+
 static int
 ip6_lookup_fib_node_init(const struct rte_graph *graph, struct rte_node *node)
 {
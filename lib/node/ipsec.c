@@ -0,0 +1,80 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2026 Marvell.
+ */
+
+#include <eal_export.h>
+#include <rte_cryptodev.h>
+#include <rte_errno.h>
+#include <rte_ipsec.h>
+#include <rte_lcore.h>
+#include <rte_security.h>
+
+#include "rte_node_ipsec_api.h"
+
+#include "ipsec_priv.h"
+#include "node_private.h"
+
+struct ipsec_crypto_qp ipsec_crypto_qps[RTE_MAX_LCORE];
+
+struct ipsec_node_sa ipsec_node_sas[RTE_NODE_IPSEC_SA_MAX];
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ipsec_crypto_configure, 26.03)
+int
+rte_node_ipsec_crypto_configure(struct rte_node_ipsec_crypto_cfg *cfg, uint16_t cnt)
+{
+	uint16_t i;
+
+	if (cfg == NULL)
+		return -EINVAL;
+
+	for (i = 0; i < cnt; i++) {
+		if (cfg[i].lcore_id >= RTE_MAX_LCORE || cfg[i].cop_pool == NULL ||
+		    !rte_cryptodev_is_valid_dev(cfg[i].dev_id) ||
+		    cfg[i].qp_id >= rte_cryptodev_queue_pair_count(cfg[i].dev_id)) {
+			node_err("ipsec", "Invalid crypto config for lcore %u",
+				 cfg[i].lcore_id);
+			return -EINVAL;
+		}
+	}
+
+	for (i = 0; i < cnt; i++) {
+		ipsec_crypto_qps[cfg[i].lcore_id].dev_id = cfg[i].dev_id;
+		ipsec_crypto_qps[cfg[i].lcore_id].qp_id = cfg[i].qp_id;
+		ipsec_crypto_qps[cfg[i].lcore_id].cop_pool = cfg[i].cop_pool;
+	}
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ipsec_sa_add, 26.03)
+int
+rte_node_ipsec_sa_add(uint32_t sa_idx, struct rte_ipsec_session *ss)
+{
+	if (sa_idx >= RTE_NODE_IPSEC_SA_MAX || ss == NULL || ss->sa == NULL)
+		return -EINVAL;
+
+	/* Only the sessions processed through a cryptodev */
+	if (ss->type != RTE_SECURITY_ACTION_TYPE_NONE &&
+	    ss->type != RTE_SECURITY_ACTION_TYPE_LOOKASIDE_PROTOCOL) {
+		node_err("ipsec", "SA %u: unsupported session action type %d",
+			 sa_idx, ss->type);
+		return -ENOTSUP;
+	}
+
+	ipsec_node_sas[sa_idx].type = rte_ipsec_sa_type(ss->sa);
+	ipsec_node_sas[sa_idx].ss = ss;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_node_ipsec_sa_del, 26.03)
+int
+rte_node_ipsec_sa_del(uint32_t sa_idx)
+{
+	if (sa_idx >= RTE_NODE_IPSEC_SA_MAX || ipsec_node_sas[sa_idx].ss == NULL)
+		return -ENOENT;
+
+	ipsec_node_sas[sa_idx].ss = NULL;
+
+	return 0;
+}
@@ -0,0 +1,54 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2026 Marvell.
+ */
+#ifndef __INCLUDE_IPSEC_PRIV_H__
+#define __INCLUDE_IPSEC_PRIV_H__
+
+#include <rte_common.h>
+#include <rte_ipsec.h>
+#include <rte_mempool.h>
+
+/* Maximum number of crypto ops enqueued or dequeued at once */
+#define IPSEC_CRYPTO_BURST 64
+
+/**
+ * @internal
+ *
+ * Cryptodev queue pair of the IPsec nodes on an lcore.
+ */
+struct __rte_cache_aligned ipsec_crypto_qp {
+	struct rte_mempool *cop_pool;
+	/**< Crypto op pool, NULL if the lcore has no queue pair. */
+	uint16_t qp_id;
+	/**< Queue pair identifier. */
+	uint8_t dev_id;
+	/**< Cryptodev identifier. */
+};
+
+/**
+ * @internal
+ *
+ * SA of the IPsec nodes.
+ */
+struct ipsec_node_sa {
+	struct rte_ipsec_session *ss;
+	/**< IPsec session, NULL if SA index is unused. */
+	uint64_t type;
+	/**< SA type, see rte_ipsec_sa_type(). */
+};
+
+/**
+ * @internal
+ *
+ * Cryptodev queue pairs of the IPsec nodes, indexed by lcore.
+ */
+extern struct ipsec_crypto_qp ipsec_crypto_qps[RTE_MAX_LCORE];
+
+/**
+ * @internal
+ *
+ * SAs of the IPsec nodes, indexed by SA index.
+ */
+extern struct ipsec_node_sa ipsec_node_sas[];
+
+#endif /* __INCLUDE_IPSEC_PRIV_H__ */
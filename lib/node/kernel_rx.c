@@ -3,8 +3,8 @@
  */
 
 #include <fcntl.h>
-#include <poll.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <unistd.h>
@@ -23,25 +23,24 @@
 #include "kernel_rx_priv.h"
 #include "node_private.h"
 
-static inline struct rte_mbuf *
-alloc_rx_mbuf(kernel_rx_node_ctx_t *ctx)
+/* Number of cached mbufs available to receive, after a refill if empty. */
+static inline uint16_t
+rx_mbufs_avail(kernel_rx_node_ctx_t *ctx)
 {
 	kernel_rx_info_t *rx = ctx->recv_info;
 
 	if (rx->idx >= rx->cnt) {
-		uint16_t cnt;
-
 		rx->idx = 0;
 		rx->cnt = 0;
 
-		cnt = rte_pktmbuf_alloc_bulk(ctx->pktmbuf_pool, rx->rx_bufs, KERN_RX_CACHE_COUNT);
-		if (cnt <= 0)
-			return NULL;
+		if (rte_pktmbuf_alloc_bulk(ctx->pktmbuf_pool, rx->rx_bufs,
+					   KERN_RX_CACHE_COUNT) != 0)
+			return 0;
 
-		rx->cnt = cnt;
+		rx->cnt = KERN_RX_CACHE_COUNT;
 	}
 
-	return rx->rx_bufs[rx->idx++];
+	return rx->cnt - rx->idx;
 }
 
 static inline void
@@ -105,59 +104,53 @@ recv_pkt_parse(void **objs, uint16_t nb_pkts)
 	return nb_pkts;
 }
 
+/* Receive a burst of packets in the cached mbufs with a single system call. */
 static uint16_t
 kernel_rx_node_do(struct rte_graph *graph, struct rte_node *node, kernel_rx_node_ctx_t *ctx)
 {
+	struct mmsghdr msgs[KERN_RX_CACHE_COUNT];
+	struct iovec iov[KERN_RX_CACHE_COUNT];
+	struct rte_mbuf **mbufs, *m;
 	kernel_rx_info_t *rx;
 	uint16_t next_index;
-	int fd;
+	int nb_cnt, ret, i;
 
 	rx = ctx->recv_info;
 	next_index = rx->node_next;
 
-	fd = rx->sock;
-	if (fd > 0) {
-		struct rte_mbuf **mbufs;
-		uint16_t len = 0, count = 0;
-		int nb_cnt, i;
-
-		nb_cnt = (node->size >= RTE_GRAPH_BURST_SIZE) ? RTE_GRAPH_BURST_SIZE : node->size;
-
-		mbufs = (struct rte_mbuf **)node->objs;
-		for (i = 0; i < nb_cnt; i++) {
-			struct rte_mbuf *m = alloc_rx_mbuf(ctx);
-
-			if (!m)
-				break;
-
-			len = read(fd, rte_pktmbuf_mtod(m, char *), rte_pktmbuf_tailroom(m));
-			if (len == 0 || len == 0xFFFF) {
-				rte_pktmbuf_free(m);
-				if (rx->idx <= 0)
-					node_dbg("kernel_rx", "rx_mbuf array is empty");
-				rx->idx--;
-				break;
-			}
-			*mbufs++ = m;
+	nb_cnt = RTE_MIN(node->size, rx_mbufs_avail(ctx));
+	if (nb_cnt == 0)
+		return 0;
 
-			m->port = node->id;
-			rte_pktmbuf_data_len(m) = len;
+	mbufs = &rx->rx_bufs[rx->idx];
+	memset(msgs, 0, nb_cnt * sizeof(msgs[0]));
+	for (i = 0; i < nb_cnt; i++) {
+		iov[i].iov_base = rte_pktmbuf_mtod(mbufs[i], void *);
+		iov[i].iov_len = rte_pktmbuf_tailroom(mbufs[i]);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
 
-			count++;
-		}
+	ret = recvmmsg(rx->sock, msgs, nb_cnt, MSG_DONTWAIT, NULL);
+	if (ret <= 0)
+		return 0;
 
-		if (count) {
-			recv_pkt_parse(node->objs, count);
-			node->idx = count;
+	for (i = 0; i < ret; i++) {
+		m = mbufs[i];
+		m->port = node->id;
+		rte_pktmbuf_data_len(m) = msgs[i].msg_len;
+		rte_pktmbuf_pkt_len(m) = msgs[i].msg_len;
+		node->objs[i] = m;
+	}
+	rx->idx += ret;
 
-			/* Enqueue to next node */
-			rte_node_next_stream_move(graph, node, next_index);
-		}
+	recv_pkt_parse(node->objs, ret);
+	node->idx = ret;
 
-		return count;
-	}
+	/* Enqueue to next node */
+	rte_node_next_stream_move(graph, node, next_index);
 
-	return 0;
+	return ret;
 }
 
 static uint16_t
@@ -165,7 +158,6 @@ kernel_rx_node_process(struct rte_graph *graph, struct rte_node *node, void **ob
 			 uint16_t nb_objs)
 {
 	kernel_rx_node_ctx_t *ctx = (kernel_rx_node_ctx_t *)node->ctx;
-	int fd;
 
 	RTE_SET_USED(objs);
 	RTE_SET_USED(nb_objs);
@@ -173,15 +165,9 @@ kernel_rx_node_process(struct rte_graph *graph, struct rte_node *node, void **ob
 	if (!ctx)
 		return 0;
 
-	fd = ctx->recv_info->sock;
-	if (fd > 0) {
-		struct pollfd fds = {.fd = fd, .events = POLLIN};
-
-		if (poll(&fds, 1, 0) > 0) {
-			if (fds.revents & POLLIN)
-				return kernel_rx_node_do(graph, node, ctx);
-		}
-	}
+	/* The non-blocking receive replaces a poll of the socket. */
+	if (ctx->recv_info->sock > 0)
+		return kernel_rx_node_do(graph, node, ctx);
 
 	return 0;
 }
@@ -236,6 +222,10 @@ kernel_rx_node_fini(const struct rte_graph *graph __rte_unused, struct rte_node
 	kernel_rx_node_ctx_t *ctx = (kernel_rx_node_ctx_t *)node->ctx;
 
 	if (ctx->recv_info) {
+		kernel_rx_info_t *rx = ctx->recv_info;
+
+		if (rx->idx < rx->cnt)
+			rte_pktmbuf_free_bulk(&rx->rx_bufs[rx->idx], rx->cnt - rx->idx);
 		close(ctx->recv_info->sock);
 		ctx->recv_info->sock = -1;
 		rte_free(ctx->recv_info);
@@ -3,6 +3,7 @@
  */
 
 #include <fcntl.h>
+#include <string.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <unistd.h>
@@ -16,64 +17,103 @@
 #include "kernel_tx_priv.h"
 #include "node_private.h"
 
-static __rte_always_inline void
-kernel_tx_process_mbuf(struct rte_node *node, struct rte_mbuf **mbufs, uint16_t cnt)
+/* Maximum number of segments of a packet */
+#define KERNEL_TX_MAX_SEGS 64
+
+/* Maximum number of packets and segments sent in a single system call */
+#define KERNEL_TX_BATCH 64
+#define KERNEL_TX_BATCH_SEGS (KERNEL_TX_BATCH * 4)
+
+struct kernel_tx_batch {
+	struct mmsghdr msgs[KERNEL_TX_BATCH];
+	struct sockaddr_in sins[KERNEL_TX_BATCH];
+	struct iovec iov[KERNEL_TX_BATCH_SEGS];
+	unsigned int nb_msgs;
+	unsigned int nb_segs;
+};
+
+static void
+kernel_tx_flush(int sock, struct kernel_tx_batch *batch)
 {
-	kernel_tx_node_ctx_t *ctx = (kernel_tx_node_ctx_t *)node->ctx;
-	struct sockaddr_in sin = {0};
-	struct rte_ipv4_hdr *ip4;
-	size_t len;
-	char *buf;
-	int i;
-
-	for (i = 0; i < cnt; i++) {
-		ip4 = rte_pktmbuf_mtod(mbufs[i], struct rte_ipv4_hdr *);
-		len = rte_pktmbuf_data_len(mbufs[i]);
-		buf = (char *)ip4;
-
-		sin.sin_family = AF_INET;
-		sin.sin_port = 0;
-		sin.sin_addr.s_addr = ip4->dst_addr;
-
-		if (sendto(ctx->sock, buf, len, 0, (struct sockaddr *)&sin, sizeof(sin)) < 0)
+	unsigned int sent = 0;
+	int ret;
+
+	while (sent < batch->nb_msgs) {
+		ret = sendmmsg(sock, &batch->msgs[sent], batch->nb_msgs - sent, 0);
+		if (ret < 0) {
 			node_err("kernel_tx", "Unable to send packets: %s", strerror(errno));
+			/* Drop the failing packet and send the next ones. */
+			sent++;
+			continue;
+		}
+		sent += ret;
 	}
+
+	batch->nb_msgs = 0;
+	batch->nb_segs = 0;
+}
+
+static __rte_always_inline void
+kernel_tx_process_mbuf(int sock, struct kernel_tx_batch *batch, struct rte_mbuf *m)
+{
+	struct rte_ipv4_hdr *ip4 = rte_pktmbuf_mtod(m, struct rte_ipv4_hdr *);
+	struct sockaddr_in *sin;
+	struct msghdr *msg;
+	struct iovec *iov;
+	struct rte_mbuf *seg;
+
+	/* Send packets chained by GRO in a single message */
+	if (unlikely(m->nb_segs > KERNEL_TX_MAX_SEGS)) {
+		node_err("kernel_tx", "Unable to send packet of %u segments", m->nb_segs);
+		return;
+	}
+
+	if (batch->nb_msgs == KERNEL_TX_BATCH ||
+	    batch->nb_segs + m->nb_segs > KERNEL_TX_BATCH_SEGS)
+		kernel_tx_flush(sock, batch);
+
+	sin = &batch->sins[batch->nb_msgs];
+	sin->sin_family = AF_INET;
+	sin->sin_port = 0;
+	sin->sin_addr.s_addr = ip4->dst_addr;
+
+	iov = &batch->iov[batch->nb_segs];
+	for (seg = m; seg != NULL; seg = seg->next, batch->nb_segs++) {
+		batch->iov[batch->nb_segs].iov_base = rte_pktmbuf_mtod(seg, void *);
+		batch->iov[batch->nb_segs].iov_len = rte_pktmbuf_data_len(seg);
+	}
+
+	msg = &batch->msgs[batch->nb_msgs++].msg_hdr;
+	memset(msg, 0, sizeof(*msg));
+	msg->msg_name = sin;
+	msg->msg_namelen = sizeof(*sin);
+	msg->msg_iov = iov;
+	msg->msg_iovlen = &batch->iov[batch->nb_segs] - iov;
 }
 
 static uint16_t
 kernel_tx_node_process(struct rte_graph *graph __rte_unused, struct rte_node *node, void **objs,
 			 uint16_t nb_objs)
 {
+	kernel_tx_node_ctx_t *ctx = (kernel_tx_node_ctx_t *)node->ctx;
 	struct rte_mbuf **pkts = (struct rte_mbuf **)objs;
-	uint16_t obj_left = nb_objs;
+	struct kernel_tx_batch batch;
+	uint16_t i;
 
 #define PREFETCH_CNT 4
 
-	while (obj_left >= 12) {
-		/* Prefetch next-next mbufs */
-		rte_prefetch0(pkts[8]);
-		rte_prefetch0(pkts[9]);
-		rte_prefetch0(pkts[10]);
-		rte_prefetch0(pkts[11]);
-
-		/* Prefetch next mbuf data */
-		rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[4], void *, pkts[4]->l2_len));
-		rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[5], void *, pkts[5]->l2_len));
-		rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[6], void *, pkts[6]->l2_len));
-		rte_prefetch0(rte_pktmbuf_mtod_offset(pkts[7], void *, pkts[7]->l2_len));
+	batch.nb_msgs = 0;
+	batch.nb_segs = 0;
 
-		kernel_tx_process_mbuf(node, pkts, PREFETCH_CNT);
+	for (i = 0; i < nb_objs; i++) {
+		if (i + PREFETCH_CNT < nb_objs)
+			rte_prefetch0(rte_pktmbuf_mtod(pkts[i + PREFETCH_CNT], void *));
 
-		obj_left -= PREFETCH_CNT;
-		pkts += PREFETCH_CNT;
+		kernel_tx_process_mbuf(ctx->sock, &batch, pkts[i]);
 	}
 
-	while (obj_left > 0) {
-		kernel_tx_process_mbuf(node, pkts, 1);
-
-		obj_left--;
-		pkts++;
-	}
+	if (batch.nb_msgs > 0)
+		kernel_tx_flush(ctx->sock, &batch);
 
 	rte_pktmbuf_free_bulk((struct rte_mbuf **)objs, nb_objs);
 
@@ -57,6 +57,31 @@ node_mbuf_priv2(struct rte_mbuf *m)
 	return (struct node_mbuf_priv2 *)rte_mbuf_to_priv(m);
 }
 
+struct rte_fib;
+struct rte_fib6;
+
+/**
+ * Get the FIB of ip4_lookup_fib node on a socket, created if needed.
+ *
+ * @param socket
+ *   Socket of the FIB.
+ *
+ * @return
+ *   Pointer to the FIB, NULL with rte_errno set otherwise.
+ */
+struct rte_fib *node_ip4_fib_get(int socket);
+
+/**
+ * Get the FIB of ip6_lookup_fib node on a socket, created if needed.
+ *
+ * @param socket
+ *   Socket of the FIB.
+ *
+ * @return
+ *   Pointer to the FIB, NULL with rte_errno set otherwise.
+ */
+struct rte_fib6 *node_ip6_fib_get(int socket);
+
 #define NODE_INCREMENT_XSTAT_ID(node, id, cond, cnt) \
 do { \
 	if (unlikely(rte_graph_has_stats_feature() && (cond))) \
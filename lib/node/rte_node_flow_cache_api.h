@@ -0,0 +1,70 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2026 Marvell.
+ */
+
+#ifndef __INCLUDE_RTE_NODE_FLOW_CACHE_API_H__
+#define __INCLUDE_RTE_NODE_FLOW_CACHE_API_H__
+
+/**
+ * @file rte_node_flow_cache_api.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * This API allows to do control path functions of flow_cache node.
+ *
+ * The flow_cache node is meant to be placed after pkt_cls, in place of the
+ * ip4_lookup_fib and ip6_lookup_fib nodes. It keeps a direct-mapped cache
+ * of the flows per graph, indexed by a hash of their 5-tuple, with the next
+ * hop resolved by the FIB of the lookup nodes. The packets of a cached flow
+ * are sent straight to ip4_rewrite or ip6_rewrite. On a miss, the FIB is
+ * looked up by the node itself and the flow is cached if it is forwarded;
+ * the other packets go on to the lookup node.
+ */
+#include <rte_common.h>
+#include <rte_compat.h>
+
+#include <rte_graph.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of entries of the flow cache of each graph, per address family. */
+#define RTE_NODE_FLOW_CACHE_SIZE 4096
+
+/**
+ * Flow cache next nodes.
+ */
+enum rte_node_flow_cache_next {
+	RTE_NODE_FLOW_CACHE_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+	RTE_NODE_FLOW_CACHE_NEXT_IP4_LOOKUP,
+	/**< IP4 lookup node, for the packets not forwarded. */
+	RTE_NODE_FLOW_CACHE_NEXT_IP6_LOOKUP,
+	/**< IP6 lookup node, for the packets not forwarded. */
+	RTE_NODE_FLOW_CACHE_NEXT_IP4_REWRITE,
+	/**< IP4 rewrite node. */
+	RTE_NODE_FLOW_CACHE_NEXT_IP6_REWRITE,
+	/**< IP6 rewrite node. */
+	RTE_NODE_FLOW_CACHE_NEXT_MAX,
+	/**< Number of next nodes of flow cache node. */
+};
+
+/**
+ * Invalidate the flow caches of all the graphs.
+ *
+ * The caches are invalidated when a route is added with
+ * rte_node_ip4_fib_route_add() or rte_node_ip6_fib_route_add().
+ * This must be called after any other change of the FIBs. The rewrite data
+ * is not cached, only the next hop id, so its updates need no flush.
+ */
+__rte_experimental
+void rte_node_flow_cache_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_RTE_NODE_FLOW_CACHE_API_H__ */
@@ -0,0 +1,82 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2026 Marvell.
+ */
+
+#ifndef __INCLUDE_RTE_NODE_GRO_GSO_API_H__
+#define __INCLUDE_RTE_NODE_GRO_GSO_API_H__
+
+/**
+ * @file rte_node_gro_gso_api.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * This API allows to do control path functions of tcp_gro and gso nodes.
+ *
+ * The tcp_gro node merges the TCP segments of each flow found in a stream
+ * with rte_gro_reassemble_burst(), before the packets are sent to a node
+ * taking large packets, like kernel_tx. Its packets start at their Ethernet
+ * header if their packet type has RTE_PTYPE_L2_ETHER, at their IP header
+ * otherwise.
+ *
+ * The gso node segments the packets requesting TCP or UDP segmentation
+ * offload, through RTE_MBUF_F_TX_TCP_SEG or RTE_MBUF_F_TX_UDP_SEG, with
+ * rte_gso_segment() before sending them to the ethdev_tx node of their
+ * mbuf port.
+ */
+#include <rte_common.h>
+#include <rte_compat.h>
+
+#include <rte_graph.h>
+#include <rte_gso.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * TCP GRO next nodes.
+ */
+enum rte_node_tcp_gro_next {
+	RTE_NODE_TCP_GRO_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+	RTE_NODE_TCP_GRO_NEXT_KERNEL_TX,
+	/**< Kernel Tx node, default next node. */
+	RTE_NODE_TCP_GRO_NEXT_MAX,
+	/**< Number of next nodes of TCP GRO node. */
+};
+
+/**
+ * GSO next nodes.
+ *
+ * The edges to the ethdev_tx node of each port are added by
+ * rte_node_eth_config() after these ones.
+ */
+enum rte_node_gso_next {
+	RTE_NODE_GSO_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+	RTE_NODE_GSO_NEXT_MAX,
+	/**< Number of static next nodes of GSO node. */
+};
+
+/**
+ * Set the GSO context of gso node.
+ *
+ * The context is copied, its mempools are shared by all the graphs.
+ * The gso node drops the packets to segment until it is set.
+ *
+ * @param ctx
+ *   GSO context, see rte_gso_segment().
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_gso_configure(const struct rte_gso_ctx *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_RTE_NODE_GRO_GSO_API_H__ */
@@ -0,0 +1,137 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2026 Marvell.
+ */
+
+#ifndef __INCLUDE_RTE_NODE_IPSEC_API_H__
+#define __INCLUDE_RTE_NODE_IPSEC_API_H__
+
+/**
+ * @file rte_node_ipsec_api.h
+ *
+ * @warning
+ * @b EXPERIMENTAL:
+ * All functions in this file may be changed or removed without prior notice.
+ *
+ * This API allows to do control path functions of IPsec ESP nodes.
+ *
+ * The esp4_encrypt and esp4_decrypt nodes process the packets of the
+ * lookaside IPsec sessions given by rte_node_ipsec_sa_add(). The SA index
+ * of each packet is set in the node mbuf dynamic field by a preceding node,
+ * like an application SPD or SAD lookup node. The Ethernet header is
+ * stripped, the crypto operations are prepared with
+ * rte_ipsec_pkt_crypto_prepare() and enqueued to the cryptodev queue pair
+ * of the lcore, without waiting for their completion.
+ *
+ * The crypto_dequeue source node collects the completed operations of the
+ * lcore queue pair, finalizes the packets with rte_ipsec_pkt_process() and
+ * sends them, with room for an Ethernet header, to pkt_cls. So the crypto
+ * latency is overlapped with the other nodes of the graph walk.
+ */
+#include <rte_common.h>
+#include <rte_compat.h>
+
+#include <rte_graph.h>
+#include <rte_ipsec.h>
+#include <rte_mempool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of SAs of the IPsec nodes. */
+#define RTE_NODE_IPSEC_SA_MAX 4096
+
+/**
+ * ESP encrypt and decrypt next nodes.
+ */
+enum rte_node_esp_next {
+	RTE_NODE_ESP_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+	RTE_NODE_ESP_NEXT_MAX,
+	/**< Number of next nodes of ESP nodes. */
+};
+
+/**
+ * Crypto dequeue next nodes.
+ */
+enum rte_node_crypto_dequeue_next {
+	RTE_NODE_CRYPTO_DEQUEUE_NEXT_PKT_DROP,
+	/**< Packet drop node. */
+	RTE_NODE_CRYPTO_DEQUEUE_NEXT_PKT_CLS,
+	/**< Packet classification node. */
+	RTE_NODE_CRYPTO_DEQUEUE_NEXT_MAX,
+	/**< Number of next nodes of crypto dequeue node. */
+};
+
+/**
+ * IPsec nodes crypto configuration of an lcore.
+ * @see rte_node_ipsec_crypto_configure
+ */
+struct rte_node_ipsec_crypto_cfg {
+	unsigned int lcore_id;
+	/**< Lcore running the graph of the IPsec nodes. */
+	uint8_t dev_id;
+	/**< Cryptodev identifier. */
+	uint16_t qp_id;
+	/**< Queue pair identifier, used only by this lcore. */
+	struct rte_mempool *cop_pool;
+	/**< Symmetric crypto op pool, with private room for the IVs. */
+};
+
+/**
+ * Set the cryptodev queue pairs of the IPsec nodes.
+ *
+ * The ESP nodes and the crypto_dequeue node running on an lcore use its
+ * queue pair. The nodes drop the packets on the lcores without one.
+ *
+ * @param cfg
+ *   Pointer to the configuration structures.
+ * @param cnt
+ *   Number of configuration structures passed.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ipsec_crypto_configure(struct rte_node_ipsec_crypto_cfg *cfg, uint16_t cnt);
+
+/**
+ * Add an SA to the IPsec nodes.
+ *
+ * The session must be a lookaside session, of action type
+ * RTE_SECURITY_ACTION_TYPE_NONE or RTE_SECURITY_ACTION_TYPE_LOOKASIDE_PROTOCOL,
+ * already prepared with rte_ipsec_session_prepare(). Outbound SAs are used
+ * by esp4_encrypt, inbound ones by esp4_decrypt. The tunnel header of an
+ * outbound SA starts at its L3 header, as the nodes strip the Ethernet header.
+ *
+ * @param sa_idx
+ *   SA index set in node mbuf dynamic field, less than RTE_NODE_IPSEC_SA_MAX.
+ * @param ss
+ *   IPsec session of the SA.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ipsec_sa_add(uint32_t sa_idx, struct rte_ipsec_session *ss);
+
+/**
+ * Delete an SA from the IPsec nodes.
+ *
+ * The packets of the SA still in the cryptodev queue pairs keep using the
+ * session, so it must not be destroyed before their dequeue.
+ *
+ * @param sa_idx
+ *   SA index.
+ *
+ * @return
+ *   0 on success, negative otherwise.
+ */
+__rte_experimental
+int rte_node_ipsec_sa_del(uint32_t sa_idx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_RTE_NODE_IPSEC_API_H__ */
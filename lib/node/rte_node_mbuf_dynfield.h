@@ -56,6 +56,10 @@ typedef struct rte_node_mbuf_overload_fields {
 			};
 			uint64_t u;
 		};
+		/* Following field used by esp4_encrypt and esp4_decrypt nodes */
+		struct {
+			uint32_t sa_idx;
+		};
 		uint8_t data[RTE_NODE_MBUF_OVERLOADABLE_FIELDS_SIZE];
 	};
 } rte_node_mbuf_overload_fields_t;
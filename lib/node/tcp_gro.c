@@ -0,0 +1,115 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2026 Marvell.
+ */
+
+#include <rte_ether.h>
+#include <rte_graph.h>
+#include <rte_graph_worker.h>
+#include <rte_gro.h>
+#include <rte_ip.h>
+#include <rte_mbuf.h>
+#include <rte_tcp.h>
+
+#include "rte_node_gro_gso_api.h"
+
+#include "node_private.h"
+
+/* Flows and segments per flow merged in each burst */
+#define TCP_GRO_MAX_FLOW_NUM 8
+#define TCP_GRO_MAX_ITEM_PER_FLOW \
+	(RTE_GRO_MAX_BURST_ITEM_NUM / TCP_GRO_MAX_FLOW_NUM)
+
+static const struct rte_gro_param tcp_gro_param = {
+	.gro_types = RTE_GRO_TCP_IPV4 | RTE_GRO_TCP_IPV6,
+	.max_flow_num = TCP_GRO_MAX_FLOW_NUM,
+	.max_item_per_flow = TCP_GRO_MAX_ITEM_PER_FLOW,
+};
+
+/* Set packet type and header lengths of TCP packets, as GRO needs them */
+static __rte_always_inline void
+tcp_gro_pkt_parse(struct rte_mbuf *mbuf)
+{
+	const struct rte_ipv4_hdr *ipv4_hdr;
+	const struct rte_ipv6_hdr *ipv6_hdr;
+	const struct rte_tcp_hdr *tcp_hdr;
+	uint32_t ptype;
+	uint16_t l2_len;
+
+	ptype = mbuf->packet_type & RTE_PTYPE_L2_MASK;
+	l2_len = ptype == RTE_PTYPE_L2_ETHER ? sizeof(struct rte_ether_hdr) : 0;
+
+	ipv4_hdr = rte_pktmbuf_mtod_offset(mbuf, const struct rte_ipv4_hdr *, l2_len);
+	if ((ipv4_hdr->version_ihl >> 4) == IPVERSION) {
+		if (ipv4_hdr->next_proto_id != IPPROTO_TCP)
+			return;
+		mbuf->l3_len = rte_ipv4_hdr_len(ipv4_hdr);
+		ptype |= RTE_PTYPE_L3_IPV4_EXT_UNKNOWN;
+	} else {
+		ipv6_hdr = (const struct rte_ipv6_hdr *)ipv4_hdr;
+		/* Extension headers are not parsed */
+		if (ipv6_hdr->proto != IPPROTO_TCP)
+			return;
+		mbuf->l3_len = sizeof(struct rte_ipv6_hdr);
+		ptype |= RTE_PTYPE_L3_IPV6;
+	}
+
+	tcp_hdr = rte_pktmbuf_mtod_offset(mbuf, const struct rte_tcp_hdr *,
+					  l2_len + mbuf->l3_len);
+	mbuf->l2_len = l2_len;
+	mbuf->l4_len = (tcp_hdr->data_off & 0xf0) >> 2;
+	mbuf->packet_type = ptype | RTE_PTYPE_L4_TCP;
+}
+
+static uint16_t
+tcp_gro_node_process(struct rte_graph *graph, struct rte_node *node, void **objs,
+		     uint16_t nb_objs)
+{
+	struct rte_mbuf **pkts = (struct rte_mbuf **)objs;
+	uint16_t i, n, nb_gro;
+	uint16_t merged = 0;
+
+	for (i = 0; i < 4 && i < nb_objs; i++)
+		rte_prefetch0(rte_pktmbuf_mtod(pkts[i], void *));
+
+	for (i = 0; i < nb_objs; i++) {
+		if (likely(i + 4 < nb_objs))
+			rte_prefetch0(rte_pktmbuf_mtod(pkts[i + 4], void *));
+		tcp_gro_pkt_parse(pkts[i]);
+	}
+
+	/* Lightweight mode merges at most RTE_GRO_MAX_BURST_ITEM_NUM at once */
+	for (i = 0; i < nb_objs; i += n) {
+		n = RTE_MIN(nb_objs - i, (uint16_t)RTE_GRO_MAX_BURST_ITEM_NUM);
+		nb_gro = rte_gro_reassemble_burst(&pkts[i], n, &tcp_gro_param);
+
+		rte_node_enqueue(graph, node, RTE_NODE_TCP_GRO_NEXT_KERNEL_TX,
+				 (void **)&pkts[i], nb_gro);
+		merged += n - nb_gro;
+	}
+
+	NODE_INCREMENT_XSTAT_ID(node, 0, merged != 0, merged);
+
+	return nb_objs;
+}
+
+static struct rte_node_xstats tcp_gro_xstats = {
+	.nb_xstats = 1,
+	.xstat_desc = {
+		[0] = "tcp_gro_merged",
+	},
+};
+
+static struct rte_node_register tcp_gro_node = {
+	.process = tcp_gro_node_process,
+	.name = "tcp_gro",
+
+	.xstats = &tcp_gro_xstats,
+
+	.nb_edges = RTE_NODE_TCP_GRO_NEXT_MAX,
+	.next_nodes = {
+		[RTE_NODE_TCP_GRO_NEXT_PKT_DROP] = "pkt_drop",
+		[RTE_NODE_TCP_GRO_NEXT_KERNEL_TX] = "kernel_tx",
+	},
+};
+
+RTE_NODE_REGISTER(tcp_gro_node);
@@ -11,6 +11,7 @@
 #include <unistd.h>
 
 #ifndef RTE_EXEC_ENV_WINDOWS
+#include <fcntl.h>
 #include <net/if.h>
 #include <sys/uio.h>
 #endif
@@ -23,6 +24,7 @@
 #include <rte_errno.h>
 #include <rte_ethdev.h>
 #include <rte_ether.h>
+#include <rte_malloc.h>
 #include <rte_mbuf.h>
 #include <rte_os_shim.h>
 #include <rte_pcapng.h>
@@ -37,6 +39,9 @@
 /* upper bound for section, stats and interface blocks (in uint32_t) */
 #define PCAPNG_BLKSIZ	(2048 / sizeof(uint32_t))
 
+/* alignment of buffer, file offset and size of direct I/O writes */
+#define PCAPNG_DIRECT_ALIGN	4096
+
 /* Format of the capture file handle */
 struct rte_pcapng {
 	int  outfd;		/* output file */
@@ -44,6 +49,12 @@ struct rte_pcapng {
 	uint64_t offset_ns;	/* ns since 1/1/1970 when initialized */
 	uint64_t tsc_base;	/* TSC when started */
 
+	/* optional write buffer */
+	uint8_t *buf;
+	uint32_t buf_size;
+	uint32_t buf_len;
+	bool direct;		/* file opened for direct I/O */
+
 	/* DPDK port id to interface index in file */
 	uint32_t port_index[RTE_MAX_ETHPORTS];
 };
@@ -115,6 +126,98 @@ pcapng_timestamp(const rte_pcapng_t *self, uint64_t cycles)
 	return secs * NS_PER_S + ns + self->offset_ns;
 }
 
+/* Enable or disable direct I/O on the output file */
+static int
+pcapng_set_direct(int fd, bool on)
+{
+#ifdef O_DIRECT
+	int flags = fcntl(fd, F_GETFL);
+
+	if (flags < 0)
+		return -1;
+	flags = on ? (flags | O_DIRECT) : (flags & ~O_DIRECT);
+	return fcntl(fd, F_SETFL, flags);
+#else
+	RTE_SET_USED(fd);
+	if (on) {
+		errno = ENOTSUP;
+		return -1;
+	}
+	return 0;
+#endif
+}
+
+/*
+ * Write the buffer to the file.
+ * Direct I/O only writes whole aligned blocks, keeping the rest buffered,
+ * unless all is requested which turns it off for the last partial block.
+ */
+static int
+pcapng_flush(rte_pcapng_t *self, bool all)
+{
+	uint32_t len = self->buf_len;
+	uint32_t off = 0;
+	ssize_t ret;
+
+	if (self->direct && len % PCAPNG_DIRECT_ALIGN != 0) {
+		if (!all) {
+			len = RTE_ALIGN_FLOOR(len, PCAPNG_DIRECT_ALIGN);
+		} else if (pcapng_set_direct(self->outfd, false) == 0) {
+			self->direct = false;
+		} else {
+			rte_errno = errno;
+			return -1;
+		}
+	}
+
+	while (off < len) {
+		ret = write(self->outfd, self->buf + off, len - off);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			rte_errno = errno;
+			return -1;
+		}
+		off += ret;
+	}
+
+	self->buf_len -= len;
+	memmove(self->buf, self->buf + len, self->buf_len);
+	return 0;
+}
+
+/* Add data to the buffer, writing it out when full */
+static int
+pcapng_buffer(rte_pcapng_t *self, const void *data, uint32_t len)
+{
+	uint32_t n;
+
+	while (len > 0) {
+		n = RTE_MIN(len, self->buf_size - self->buf_len);
+		memcpy(self->buf + self->buf_len, data, n);
+		self->buf_len += n;
+		data = RTE_PTR_ADD(data, n);
+		len -= n;
+
+		if (self->buf_len == self->buf_size &&
+		    pcapng_flush(self, false) < 0)
+			return -1;
+	}
+	return 0;
+}
+
+/* Write a block directly or through the buffer */
+static ssize_t
+pcapng_write(rte_pcapng_t *self, const void *data, uint32_t len)
+{
+	if (self->buf == NULL)
+		return write(self->outfd, data, len);
+
+	if (pcapng_buffer(self, data, len) < 0)
+		return -1;
+	return len;
+}
+
 /* length of option including padding */
 static uint16_t pcapng_optlen(uint16_t len)
 {
@@ -196,7 +299,7 @@ pcapng_section_block(rte_pcapng_t *self,
 	/* clone block_length after option */
 	memcpy(opt, &hdr->block_length, sizeof(uint32_t));
 
-	return write(self->outfd, buf, len);
+	return pcapng_write(self, buf, len);
 }
 
 /* Write an interface block for a DPDK port */
@@ -315,7 +418,7 @@ rte_pcapng_add_interface(rte_pcapng_t *self, uint16_t port, uint16_t link_type,
 	/* remember the file index */
 	self->port_index[port] = self->ports++;
 
-	return write(self->outfd, buf, len);
+	return pcapng_write(self, buf, len);
 }
 
 /*
@@ -384,7 +487,7 @@ rte_pcapng_write_stats(rte_pcapng_t *self, uint16_t port_id,
 	/* clone block_length after option */
 	memcpy(opt, &len, sizeof(uint32_t));
 
-	return write(self->outfd, buf, len);
+	return pcapng_write(self, buf, len);
 }
 
 RTE_EXPORT_SYMBOL(rte_pcapng_mbuf_size)
@@ -468,53 +571,19 @@ pcapng_vlan_insert(struct rte_mbuf *m, uint16_t ether_type, uint16_t tci)
  *    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
  */
 
-/* Make a copy of original mbuf with pcapng header and options */
-RTE_EXPORT_SYMBOL(rte_pcapng_copy)
-struct rte_mbuf *
-rte_pcapng_copy(uint16_t port_id, uint32_t queue,
-		const struct rte_mbuf *md,
-		struct rte_mempool *mp,
-		uint32_t length,
-		enum rte_pcapng_direction direction,
-		const char *comment)
+/* Add the pcapng header and options around the packet data of mc */
+static struct rte_mbuf *
+pcapng_format(struct rte_mbuf *mc, const struct rte_mbuf *md,
+	      uint16_t port_id, uint32_t queue, uint32_t orig_len,
+	      enum rte_pcapng_direction direction, const char *comment)
 {
 	struct pcapng_enhance_packet_block *epb;
-	uint32_t orig_len, pkt_len, padding, flags;
+	uint32_t pkt_len, padding, flags;
 	struct pcapng_option *opt;
 	uint64_t timestamp;
 	uint16_t optlen;
-	struct rte_mbuf *mc;
 	bool rss_hash;
 
-#ifdef RTE_LIBRTE_ETHDEV_DEBUG
-	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, NULL);
-#endif
-	orig_len = rte_pktmbuf_pkt_len(md);
-
-	/* Take snapshot of the data */
-	mc = rte_pktmbuf_copy(md, mp, 0, length);
-	if (unlikely(mc == NULL))
-		return NULL;
-
-	/* Expand any offloaded VLAN information */
-	if ((direction == RTE_PCAPNG_DIRECTION_IN &&
-	     (md->ol_flags & RTE_MBUF_F_RX_VLAN_STRIPPED)) ||
-	    (direction == RTE_PCAPNG_DIRECTION_OUT &&
-	     (md->ol_flags & RTE_MBUF_F_TX_VLAN))) {
-		if (pcapng_vlan_insert(mc, RTE_ETHER_TYPE_VLAN,
-				       md->vlan_tci) != 0)
-			goto fail;
-	}
-
-	if ((direction == RTE_PCAPNG_DIRECTION_IN &&
-	     (md->ol_flags & RTE_MBUF_F_RX_QINQ_STRIPPED)) ||
-	    (direction == RTE_PCAPNG_DIRECTION_OUT &&
-	     (md->ol_flags & RTE_MBUF_F_TX_QINQ))) {
-		if (pcapng_vlan_insert(mc, RTE_ETHER_TYPE_QINQ,
-				       md->vlan_tci_outer) != 0)
-			goto fail;
-	}
-
 	/* record HASH on incoming packets */
 	rss_hash = (direction == RTE_PCAPNG_DIRECTION_IN &&
 		    (md->ol_flags & RTE_MBUF_F_RX_RSS_HASH));
@@ -610,6 +679,121 @@ rte_pcapng_copy(uint16_t port_id, uint32_t queue,
 	return NULL;
 }
 
+/* Make a copy of original mbuf with pcapng header and options */
+RTE_EXPORT_SYMBOL(rte_pcapng_copy)
+struct rte_mbuf *
+rte_pcapng_copy(uint16_t port_id, uint32_t queue,
+		const struct rte_mbuf *md,
+		struct rte_mempool *mp,
+		uint32_t length,
+		enum rte_pcapng_direction direction,
+		const char *comment)
+{
+	uint32_t orig_len;
+	struct rte_mbuf *mc;
+
+#ifdef RTE_LIBRTE_ETHDEV_DEBUG
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, NULL);
+#endif
+	orig_len = rte_pktmbuf_pkt_len(md);
+
+	/* Take snapshot of the data */
+	mc = rte_pktmbuf_copy(md, mp, 0, length);
+	if (unlikely(mc == NULL))
+		return NULL;
+
+	/* Expand any offloaded VLAN information */
+	if ((direction == RTE_PCAPNG_DIRECTION_IN &&
+	     (md->ol_flags & RTE_MBUF_F_RX_VLAN_STRIPPED)) ||
+	    (direction == RTE_PCAPNG_DIRECTION_OUT &&
+	     (md->ol_flags & RTE_MBUF_F_TX_VLAN))) {
+		if (pcapng_vlan_insert(mc, RTE_ETHER_TYPE_VLAN,
+				       md->vlan_tci) != 0)
+			goto fail;
+	}
+
+	if ((direction == RTE_PCAPNG_DIRECTION_IN &&
+	     (md->ol_flags & RTE_MBUF_F_RX_QINQ_STRIPPED)) ||
+	    (direction == RTE_PCAPNG_DIRECTION_OUT &&
+	     (md->ol_flags & RTE_MBUF_F_TX_QINQ))) {
+		if (pcapng_vlan_insert(mc, RTE_ETHER_TYPE_QINQ,
+				       md->vlan_tci_outer) != 0)
+			goto fail;
+	}
+
+	return pcapng_format(mc, md, port_id, queue, orig_len,
+			     direction, comment);
+
+fail:
+	rte_pktmbuf_free(mc);
+	return NULL;
+}
+
+/* Reference the original mbuf data between pcapng header and options */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pcapng_clone, 26.03)
+struct rte_mbuf *
+rte_pcapng_clone(uint16_t port_id, uint32_t queue,
+		 struct rte_mbuf *md,
+		 struct rte_mempool *mp,
+		 uint32_t length,
+		 enum rte_pcapng_direction direction,
+		 const char *comment)
+{
+	struct rte_mbuf *mc, *mi, *seg, *tail;
+	uint32_t orig_len, len;
+
+#ifdef RTE_LIBRTE_ETHDEV_DEBUG
+	RTE_ETH_VALID_PORTID_OR_ERR_RET(port_id, NULL);
+#endif
+	/* The shared data can not be modified to expand the VLAN tags */
+	if ((direction == RTE_PCAPNG_DIRECTION_IN &&
+	     (md->ol_flags & (RTE_MBUF_F_RX_VLAN_STRIPPED |
+			      RTE_MBUF_F_RX_QINQ_STRIPPED))) ||
+	    (direction == RTE_PCAPNG_DIRECTION_OUT &&
+	     (md->ol_flags & (RTE_MBUF_F_TX_VLAN | RTE_MBUF_F_TX_QINQ))))
+		return rte_pcapng_copy(port_id, queue, md, mp, length,
+				       direction, comment);
+
+	orig_len = rte_pktmbuf_pkt_len(md);
+	len = RTE_MIN(orig_len, length);
+
+	/* The header is prepended to an empty first segment */
+	mc = rte_pktmbuf_alloc(mp);
+	if (unlikely(mc == NULL))
+		return NULL;
+
+	/* Segments attached to the data, truncated to the length */
+	tail = mc;
+	for (seg = md; seg != NULL && len > 0; seg = seg->next) {
+		mi = rte_pktmbuf_alloc(mp);
+		if (unlikely(mi == NULL))
+			goto fail;
+
+		rte_pktmbuf_attach(mi, seg);
+		mi->data_len = RTE_MIN(len, seg->data_len);
+		len -= mi->data_len;
+
+		tail->next = mi;
+		tail = mi;
+		mc->nb_segs++;
+		mc->pkt_len += mi->data_len;
+	}
+
+	/* The padding and options are appended to a last own segment */
+	mi = rte_pktmbuf_alloc(mp);
+	if (unlikely(mi == NULL))
+		goto fail;
+	tail->next = mi;
+	mc->nb_segs++;
+
+	return pcapng_format(mc, md, port_id, queue, orig_len,
+			     direction, comment);
+
+fail:
+	rte_pktmbuf_free(mc);
+	return NULL;
+}
+
 /* Write pre-formatted packets to file. */
 RTE_EXPORT_SYMBOL(rte_pcapng_write_packets)
 ssize_t
@@ -647,6 +831,17 @@ rte_pcapng_write_packets(rte_pcapng_t *self,
 		epb->timestamp_hi = timestamp >> 32;
 		epb->timestamp_lo = (uint32_t)timestamp;
 
+		/* Accumulate in the buffer, if any */
+		if (self->buf != NULL) {
+			total += rte_pktmbuf_pkt_len(m);
+			do {
+				if (pcapng_buffer(self, rte_pktmbuf_mtod(m, void *),
+						  rte_pktmbuf_data_len(m)) < 0)
+					return -1;
+			} while ((m = m->next));
+			continue;
+		}
+
 		/*
 		 * Handle case of highly fragmented and large burst size
 		 * Note: this assumes that max segments per mbuf < IOV_MAX
@@ -672,6 +867,9 @@ rte_pcapng_write_packets(rte_pcapng_t *self,
 		} while ((m = m->next));
 	}
 
+	if (cnt == 0)
+		return total;
+
 	ret = writev(self->outfd, iov, cnt);
 	if (unlikely(ret < 0)) {
 		rte_errno = errno;
@@ -680,12 +878,10 @@ rte_pcapng_write_packets(rte_pcapng_t *self,
 	return total + ret;
 }
 
-/* Create new pcapng writer handle */
-RTE_EXPORT_SYMBOL(rte_pcapng_fdopen)
-rte_pcapng_t *
-rte_pcapng_fdopen(int fd,
-		  const char *osname, const char *hardware,
-		  const char *appname, const char *comment)
+static rte_pcapng_t *
+pcapng_open(int fd, uint32_t buf_size, uint32_t flags,
+	    const char *osname, const char *hardware,
+	    const char *appname, const char *comment)
 {
 	unsigned int i;
 	rte_pcapng_t *self;
@@ -700,6 +896,28 @@ rte_pcapng_fdopen(int fd,
 
 	self->outfd = fd;
 	self->ports = 0;
+	self->buf = NULL;
+	self->buf_size = 0;
+	self->buf_len = 0;
+	self->direct = false;
+
+	if (buf_size != 0) {
+		self->buf_size = RTE_ALIGN_CEIL(buf_size, PCAPNG_DIRECT_ALIGN);
+		self->buf = rte_malloc("pcapng", self->buf_size,
+				       PCAPNG_DIRECT_ALIGN);
+		if (self->buf == NULL) {
+			rte_errno = ENOMEM;
+			goto fail;
+		}
+
+		if (flags & RTE_PCAPNG_F_DIRECT_IO) {
+			if (pcapng_set_direct(fd, true) < 0) {
+				rte_errno = errno;
+				goto fail;
+			}
+			self->direct = true;
+		}
+	}
 
 	/* record start time in ns since 1/1/1970 */
 	cycles = rte_get_tsc_cycles();
@@ -715,16 +933,56 @@ rte_pcapng_fdopen(int fd,
 
 	return self;
 fail:
+	rte_free(self->buf);
 	free(self);
 	return NULL;
 }
 
+/* Create new pcapng writer handle */
+RTE_EXPORT_SYMBOL(rte_pcapng_fdopen)
+rte_pcapng_t *
+rte_pcapng_fdopen(int fd,
+		  const char *osname, const char *hardware,
+		  const char *appname, const char *comment)
+{
+	return pcapng_open(fd, 0, 0, osname, hardware, appname, comment);
+}
+
+/* Create new pcapng writer handle accumulating writes in a buffer */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pcapng_fdopen_buffered, 26.03)
+rte_pcapng_t *
+rte_pcapng_fdopen_buffered(int fd, uint32_t buf_size, uint32_t flags,
+			   const char *osname, const char *hardware,
+			   const char *appname, const char *comment)
+{
+	if (buf_size == 0 || (flags & ~RTE_PCAPNG_F_DIRECT_IO) != 0) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	return pcapng_open(fd, buf_size, flags, osname, hardware,
+			   appname, comment);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pcapng_flush, 26.03)
+int
+rte_pcapng_flush(rte_pcapng_t *self)
+{
+	if (self->buf == NULL)
+		return 0;
+
+	return pcapng_flush(self, true);
+}
+
 RTE_EXPORT_SYMBOL(rte_pcapng_close)
 void
 rte_pcapng_close(rte_pcapng_t *self)
 {
 	if (self) {
+		if (self->buf != NULL)
+			pcapng_flush(self, true);
 		close(self->outfd);
+		rte_free(self->buf);
 		free(self);
 	}
 }
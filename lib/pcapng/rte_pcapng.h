@@ -22,6 +22,8 @@
 #include <stdint.h>
 #include <sys/types.h>
 
+#include <rte_bitops.h>
+#include <rte_compat.h>
 #include <rte_mempool.h>
 
 #ifdef __cplusplus
@@ -60,6 +62,61 @@ rte_pcapng_fdopen(int fd,
 		  const char *osname, const char *hardware,
 		  const char *appname, const char *comment);
 
+/** Open the file for direct I/O, bypassing the page cache. */
+#define RTE_PCAPNG_F_DIRECT_IO	RTE_BIT32(0)
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Write data to existing open file, accumulating it in a buffer.
+ *
+ * The blocks and packets are copied to a buffer which is written
+ * to the file when full, reducing the number of system calls.
+ * Data is written on rte_pcapng_flush() or rte_pcapng_close().
+ *
+ * With RTE_PCAPNG_F_DIRECT_IO, the file is switched to direct I/O and
+ * written by whole aligned blocks. The file must be empty and support it.
+ * Direct I/O is turned off by the first flush of a partial block.
+ *
+ * @param fd
+ *   file descriptor
+ * @param buf_size
+ *   Size of the write buffer in bytes, rounded up to the page size.
+ * @param flags
+ *   Zero or RTE_PCAPNG_F_DIRECT_IO.
+ * @param osname
+ *   Optional description of the operating system.
+ * @param hardware
+ *   Optional description of the hardware used to create this file.
+ * @param appname
+ *   Optional: application name recorded in the pcapng file.
+ * @param comment
+ *   Optional comment to add to file header.
+ * @return
+ *   handle to library, or NULL in case of error (and rte_errno is set).
+ */
+__rte_experimental
+rte_pcapng_t *
+rte_pcapng_fdopen_buffered(int fd, uint32_t buf_size, uint32_t flags,
+			   const char *osname, const char *hardware,
+			   const char *appname, const char *comment);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Write the buffered data to the capture file.
+ *
+ * @param self
+ *  handle to library
+ * @return
+ *  0 on success, -1 on failure to write file (and rte_errno is set).
+ */
+__rte_experimental
+int
+rte_pcapng_flush(rte_pcapng_t *self);
+
 /**
  * Close capture file
  *
@@ -136,6 +193,50 @@ rte_pcapng_copy(uint16_t port_id, uint32_t queue,
 		uint32_t length,
 		enum rte_pcapng_direction direction, const char *comment);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Format an mbuf for writing to file, without copying its data.
+ *
+ * Unlike rte_pcapng_copy(), the packet data is referenced by indirect mbufs
+ * attached to the segments of the original mbuf, which is therefore held
+ * until the returned mbuf is freed. The data must not be modified meanwhile.
+ * Only the pcapng header and options are written to mbufs of the mempool,
+ * which can be sized with rte_pcapng_mbuf_size(0).
+ *
+ * Packets with offloaded VLAN tags are copied, as the tags must be
+ * inserted in the data.
+ *
+ * @param port_id
+ *   The Ethernet port on which packet was received
+ *   or is going to be transmitted.
+ * @param queue
+ *   The queue on the Ethernet port where packet was received
+ *   or is going to be transmitted.
+ * @param m
+ *   The mbuf to reference.
+ * @param mp
+ *   The mempool from which the "clone" mbufs are allocated.
+ * @param length
+ *   The upper limit on bytes to reference.  Passing UINT32_MAX
+ *   means all data.
+ * @param direction
+ *   The direction of the packer: receive, transmit or unknown.
+ * @param comment
+ *   Packet comment.
+ *
+ * @return
+ *   - The pointer to the new mbuf formatted for pcapng_write
+ *   - NULL if allocation fails.
+ */
+__rte_experimental
+struct rte_mbuf *
+rte_pcapng_clone(uint16_t port_id, uint32_t queue,
+		 struct rte_mbuf *m, struct rte_mempool *mp,
+		 uint32_t length,
+		 enum rte_pcapng_direction direction, const char *comment);
+
 
 /**
  * Determine optimum mbuf data size.
@@ -167,7 +268,9 @@ rte_pcapng_mbuf_size(uint32_t length);
  * @param nb_pkts
  *  The number of packets to write to the file.
  * @return
- *  The number of bytes written to file, -1 on failure to write file.
+ *  The number of bytes written to file, or buffered when the handle
+ *  was opened by rte_pcapng_fdopen_buffered(),
+ *  -1 on failure to write file.
  *  The mbuf's in *pkts* are always freed.
  */
 ssize_t
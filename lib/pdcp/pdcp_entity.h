@@ -111,19 +111,6 @@ union cipher_iv_partial {
 	uint64_t u64[2];
 };
 
-enum timer_state {
-	TIMER_STOP,
-	TIMER_RUNNING,
-	TIMER_EXPIRED,
-};
-
-struct pdcp_t_reordering {
-	/** Represent timer state */
-	enum timer_state state;
-	/** User defined callback handles */
-	struct rte_pdcp_t_reordering handle;
-};
-
 struct pdcp_cnt_bitmap {
 	/** Number of entries that can be stored. */
 	uint32_t size;
@@ -4,6 +4,7 @@
 
 #include <rte_errno.h>
 #include <rte_reorder.h>
+#include <rte_timer_wheel.h>
 
 #include "pdcp_reorder.h"
 
@@ -18,3 +19,30 @@ pdcp_reorder_create(struct pdcp_reorder *reorder, size_t nb_elem, void *mem, siz
 
 	return 0;
 }
+
+void
+pdcp_t_reordering_init(struct pdcp_t_reordering *t_reorder,
+		       const struct rte_pdcp_t_reordering *conf,
+		       struct rte_pdcp_entity *entity)
+{
+	t_reorder->state = TIMER_STOP;
+	t_reorder->handle = *conf;
+
+	/*
+	 * With a timer wheel, the t-Reordering timer is embedded in the entity,
+	 * instead of a timer per entity managed by the application.
+	 */
+	if (conf->wheel != NULL)
+		rte_timer_wheel_timer_init(&t_reorder->tim, entity);
+}
+
+void
+pdcp_t_reordering_release(struct pdcp_t_reordering *t_reorder)
+{
+	if (t_reorder->handle.wheel == NULL)
+		return;
+
+	/* The timer embedded in the entity must not expire after its release */
+	rte_timer_wheel_stop(t_reorder->handle.wheel, &t_reorder->tim);
+	t_reorder->state = TIMER_STOP;
+}
@@ -5,15 +5,38 @@
 #ifndef PDCP_REORDER_H
 #define PDCP_REORDER_H
 
+#include <rte_pdcp.h>
 #include <rte_reorder.h>
+#include <rte_timer_wheel.h>
 
 struct pdcp_reorder {
 	struct rte_reorder_buffer *buf;
 	bool is_active;
 };
 
+enum timer_state {
+	TIMER_STOP,
+	TIMER_RUNNING,
+	TIMER_EXPIRED,
+};
+
+struct pdcp_t_reordering {
+	/** Represent timer state */
+	enum timer_state state;
+	/** User defined callback handles */
+	struct rte_pdcp_t_reordering handle;
+	/** Timer of the timer wheel, if handle.wheel is set */
+	struct rte_timer_wheel_timer tim;
+};
+
 int pdcp_reorder_create(struct pdcp_reorder *reorder, size_t nb_elem, void *mem, size_t mem_size);
 
+void pdcp_t_reordering_init(struct pdcp_t_reordering *t_reorder,
+			    const struct rte_pdcp_t_reordering *conf,
+			    struct rte_pdcp_entity *entity);
+
+void pdcp_t_reordering_release(struct pdcp_t_reordering *t_reorder);
+
 /* NOTE: replace with `rte_reorder_memory_footprint_get` after DPDK 23.07 */
 #define SIZE_OF_REORDER_BUFFER (4 * RTE_CACHE_LINE_SIZE)
 static inline size_t
@@ -65,4 +88,32 @@ pdcp_reorder_insert(struct pdcp_reorder *reorder, struct rte_mbuf *mbuf,
 	RTE_VERIFY(ret == 0);
 }
 
+static inline void
+pdcp_t_reordering_start(struct pdcp_t_reordering *t_reorder)
+{
+	int ret;
+
+	if (t_reorder->handle.wheel == NULL) {
+		t_reorder->handle.start(t_reorder->handle.timer, t_reorder->handle.args);
+		return;
+	}
+
+	/* The timer is stopped, or pending on this lcore and restarted */
+	ret = rte_timer_wheel_arm(t_reorder->handle.wheel, &t_reorder->tim,
+				  t_reorder->handle.wheel_ticks, SINGLE, LCORE_ID_ANY);
+	RTE_ASSERT(ret == 0);
+	RTE_SET_USED(ret);
+}
+
+static inline void
+pdcp_t_reordering_stop(struct pdcp_t_reordering *t_reorder)
+{
+	if (t_reorder->handle.wheel == NULL) {
+		t_reorder->handle.stop(t_reorder->handle.timer, t_reorder->handle.args);
+		return;
+	}
+
+	rte_timer_wheel_stop(t_reorder->handle.wheel, &t_reorder->tim);
+}
+
 #endif /* PDCP_REORDER_H */
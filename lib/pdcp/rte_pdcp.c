@@ -17,6 +17,9 @@
 
 #define RTE_PDCP_DYNFIELD_NAME "rte_pdcp_dynfield"
 
+/* Maximum number of packets grouped by entity at once */
+#define PDCP_MULTI_BURST 64
+
 struct entity_layout {
 	size_t bitmap_offset;
 	size_t bitmap_size;
@@ -83,7 +86,7 @@ pdcp_dl_establish(struct rte_pdcp_entity *entity, const struct rte_pdcp_entity_c
 	int ret;
 
 	entity->max_pkt_cache = RTE_MAX(entity->max_pkt_cache, window_size);
-	dl->t_reorder.handle = conf->t_reordering;
+	pdcp_t_reordering_init(&dl->t_reorder, &conf->t_reordering, entity);
 
 	memory = RTE_PTR_ADD(entity, layout->reorder_buf_offset);
 	ret = pdcp_reorder_create(&dl->reorder, window_size, memory, layout->reorder_buf_size);
@@ -193,6 +196,8 @@ pdcp_dl_release(struct rte_pdcp_entity *entity, struct rte_mbuf *out_mb[])
 	struct entity_priv *en_priv = entity_priv_get(entity);
 	int nb_out;
 
+	pdcp_t_reordering_release(&dl->t_reorder);
+
 	nb_out = pdcp_reorder_up_to_get(&dl->reorder, out_mb, entity->max_pkt_cache,
 			en_priv->state.rx_next);
 
@@ -240,6 +245,7 @@ rte_pdcp_entity_suspend(struct rte_pdcp_entity *pdcp_entity,
 		en_priv->state.tx_next = 0;
 	} else {
 		dl = entity_dl_part_get(pdcp_entity);
+		pdcp_t_reordering_release(&dl->t_reorder);
 		nb_out = pdcp_reorder_up_to_get(&dl->reorder, out_mb, pdcp_entity->max_pkt_cache,
 				en_priv->state.rx_next);
 		pdcp_reorder_stop(&dl->reorder);
@@ -291,6 +297,77 @@ rte_pdcp_control_pdu_create(struct rte_pdcp_entity *pdcp_entity,
 	return m;
 }
 
+/*
+ * Pre-process a chunk of up to PDCP_MULTI_BURST packets of several entities:
+ * the packets of each entity are pre-processed together, in order of first
+ * appearance of the entity. The error packets are returned in err_mb.
+ */
+static uint16_t
+pdcp_pre_process_multi_chunk(const struct rte_pdcp_entity *entity[], struct rte_mbuf *mb[],
+			     struct rte_crypto_op *cop[], uint16_t num, struct rte_mbuf *err_mb[],
+			     uint16_t *nb_err)
+{
+	struct rte_mbuf *grp_mb[PDCP_MULTI_BURST], *in_mb[PDCP_MULTI_BURST];
+	const struct rte_pdcp_entity *en;
+	uint16_t i, j, k, n, p, nb_cop = 0, nb_bad = 0, nb_grp_err;
+	uint64_t done = 0;
+
+	for (i = 0; i != num; i++) {
+		if (done & RTE_BIT64(i))
+			continue;
+
+		en = entity[i];
+		k = 0;
+		for (j = i; j != num; j++) {
+			if (entity[j] != en)
+				continue;
+			done |= RTE_BIT64(j);
+			in_mb[k] = mb[j];
+			grp_mb[k++] = mb[j];
+		}
+
+		n = rte_pdcp_pkt_pre_process(en, grp_mb, &cop[nb_cop], k, &nb_grp_err);
+
+		/* The crypto ops are prepared in order of the packets */
+		if (unlikely(n != k)) {
+			for (j = 0, p = 0; j != k; j++) {
+				if (p != n && cop[nb_cop + p]->sym->m_src == in_mb[j])
+					p++;
+				else
+					err_mb[nb_bad++] = in_mb[j];
+			}
+		}
+		nb_cop += n;
+	}
+
+	*nb_err = nb_bad;
+
+	return nb_cop;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pdcp_pkt_pre_process_multi, 26.03)
+uint16_t
+rte_pdcp_pkt_pre_process_multi(const struct rte_pdcp_entity *entity[], struct rte_mbuf *mb[],
+			       struct rte_crypto_op *cop[], uint16_t num, uint16_t *nb_err)
+{
+	struct rte_mbuf *err_mb[PDCP_MULTI_BURST];
+	uint16_t i, n, nb_cop = 0, nb_bad = 0, nb_chunk_err;
+
+	for (i = 0; i < num; i += n) {
+		n = RTE_MIN(num - i, PDCP_MULTI_BURST);
+		nb_cop += pdcp_pre_process_multi_chunk(&entity[i], &mb[i], &cop[nb_cop], n,
+				err_mb, &nb_chunk_err);
+
+		/* The packets of the chunk are read, move the error ones */
+		memcpy(&mb[nb_bad], err_mb, nb_chunk_err * sizeof(mb[0]));
+		nb_bad += nb_chunk_err;
+	}
+
+	*nb_err = nb_bad;
+
+	return nb_cop;
+}
+
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pdcp_t_reordering_expiry_handle, 23.07)
 uint16_t
 rte_pdcp_t_reordering_expiry_handle(const struct rte_pdcp_entity *entity, struct rte_mbuf *out_mb[])
@@ -333,7 +410,7 @@ rte_pdcp_t_reordering_expiry_handle(const struct rte_pdcp_entity *entity, struct
 	if (en_priv->state.rx_deliv < en_priv->state.rx_next) {
 		en_priv->state.rx_reord = en_priv->state.rx_next;
 		dl->t_reorder.state = TIMER_RUNNING;
-		dl->t_reorder.handle.start(dl->t_reorder.handle.timer, dl->t_reorder.handle.args);
+		pdcp_t_reordering_start(&dl->t_reorder);
 	} else {
 		dl->t_reorder.state = TIMER_EXPIRED;
 	}
@@ -21,6 +21,7 @@
 
 /* Forward declarations. */
 struct rte_pdcp_entity;
+struct rte_timer_wheel;
 
 /* PDCP pre-process function based on entity configuration. */
 typedef uint16_t (*rte_pdcp_pre_p_t)(const struct rte_pdcp_entity *entity,
@@ -108,6 +109,16 @@ struct rte_pdcp_t_reordering {
 	rte_pdcp_t_reordering_start_cb_t start;
 	/** Timer stop callback handle. */
 	rte_pdcp_t_reordering_stop_cb_t stop;
+	/**
+	 * Timer wheel used instead of the callbacks, if not NULL.
+	 * The PDCP library arms its own timer of the wheel, on the lcore
+	 * processing the entity, and the expiry callback of the wheel
+	 * receives it with the entity as *rte_timer_wheel_timer.arg*.
+	 * @see rte_timer_wheel_create()
+	 */
+	struct rte_timer_wheel *wheel;
+	/** t-Reordering duration in ticks of the timer wheel. */
+	uint64_t wheel_ticks;
 };
 /* >8 End of structure rte_pdcp_t_reordering. */
 
@@ -293,6 +304,40 @@ rte_pdcp_pkt_pre_process(const struct rte_pdcp_entity *entity,
 	return entity->pre_process(entity, mb, cop, num, nb_err);
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ * For input mbufs of several PDCP entities, pre-process the mbufs and prepare
+ * crypto ops, as *rte_pdcp_pkt_pre_process* does for each entity.
+ * The mbufs are grouped by entity, so that the crypto ops of an entity are
+ * contiguous and can be regrouped with *rte_pdcp_pkt_crypto_group()*
+ * after processing, and all the crypto ops can be enqueued at once
+ * to a cryptodev shared by the entities.
+ * Only error packets would be returned in the input buffer, *mb*,
+ * and it is the responsibility of the application to free the same.
+ * @param entity
+ *   The address of an array of *num* pointers to the *rte_pdcp_entity*
+ *   objects the packets belong to.
+ * @param[in, out] mb
+ *   The address of an array of *num* pointers to *rte_mbuf* structures
+ *   which contain the input packets.
+ *   Any error packets would be returned in the same buffer.
+ * @param[out] cop
+ *   The address of an array that can hold up to *num* pointers to
+ *   *rte_crypto_op* structures.
+ * @param num
+ *   The maximum number of packets to process.
+ * @param[out] nb_err
+ *   Pointer to return the number of error packets returned in *mb*.
+ * @return
+ *   Count of crypto_ops prepared.
+ */
+__rte_experimental
+uint16_t
+rte_pdcp_pkt_pre_process_multi(const struct rte_pdcp_entity *entity[],
+			       struct rte_mbuf *mb[], struct rte_crypto_op *cop[],
+			       uint16_t num, uint16_t *nb_err);
+
 /**
  * @warning
  * @b EXPERIMENTAL: this API may change without prior notice.
@@ -347,7 +392,8 @@ rte_pdcp_pkt_post_process(const struct rte_pdcp_entity *entity,
  * based on the state variables and conditions described.
  *
  * The expiry handle need to be invoked by the application when t-Reordering
- * timer expires. In addition to returning buffered packets, it may also restart
+ * timer expires, or by the expiry callback of the timer wheel given in
+ * *rte_pdcp_t_reordering.wheel*. In addition to returning buffered packets, it may also restart
  * timer based on the state variables.
  *
  * @param entity
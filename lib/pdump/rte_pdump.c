@@ -88,6 +88,7 @@ static struct pdump_rxtx_cbs {
 	const struct rte_bpf *filter;
 	enum pdump_version ver;
 	uint32_t snaplen;
+	bool zerocopy;
 	RTE_ATOMIC(uint32_t) use_count;
 } rx_cbs[RTE_MAX_ETHPORTS][RTE_MAX_QUEUES_PER_PORT],
 tx_cbs[RTE_MAX_ETHPORTS][RTE_MAX_QUEUES_PER_PORT];
@@ -135,6 +136,32 @@ pdump_cb_release(struct pdump_rxtx_cbs *cbs)
 	rte_atomic_store_explicit(&cbs->use_count, count, rte_memory_order_release);
 }
 
+/* Reference the data of mbuf, truncated to snaplen. */
+static struct rte_mbuf *
+pdump_clone(struct rte_mbuf *m, struct rte_mempool *mp, uint32_t snaplen)
+{
+	struct rte_mbuf *mc, *seg;
+	uint32_t len;
+
+	mc = rte_pktmbuf_clone(m, mp);
+	if (mc == NULL || snaplen >= rte_pktmbuf_pkt_len(mc))
+		return mc;
+
+	/* only the clone is truncated, the data is shared */
+	len = snaplen;
+	mc->nb_segs = 1;
+	for (seg = mc; len > seg->data_len; seg = seg->next) {
+		len -= seg->data_len;
+		mc->nb_segs++;
+	}
+	seg->data_len = len;
+	rte_pktmbuf_free(seg->next);
+	seg->next = NULL;
+	mc->pkt_len = snaplen;
+
+	return mc;
+}
+
 /* Create a clone of mbuf to be placed into ring. */
 static void
 pdump_copy_burst(uint16_t port_id, uint16_t queue_id,
@@ -173,10 +200,16 @@ pdump_copy_burst(uint16_t port_id, uint16_t queue_id,
 		/*
 		 * If using pcapng then want to wrap packets
 		 * otherwise a simple copy.
+		 * In zero copy mode, the data is referenced instead.
 		 */
-		if (cbs->ver == V2)
+		if (cbs->ver == V2 && cbs->zerocopy)
+			p = rte_pcapng_clone(port_id, queue_id, pkts[i], mp, cbs->snaplen,
+					     direction, NULL);
+		else if (cbs->ver == V2)
 			p = rte_pcapng_copy(port_id, queue_id, pkts[i], mp, cbs->snaplen,
 					    direction, NULL);
+		else if (cbs->zerocopy)
+			p = pdump_clone(pkts[i], mp, cbs->snaplen);
 		else
 			p = rte_pktmbuf_copy(pkts[i], mp, 0, cbs->snaplen);
 
@@ -255,7 +288,7 @@ pdump_register_rx_callbacks(enum pdump_version ver,
 			    uint16_t end_q, uint16_t port, uint16_t queue,
 			    struct rte_ring *ring, struct rte_mempool *mp,
 			    struct rte_bpf *filter,
-			    uint16_t operation, uint32_t snaplen)
+			    uint16_t operation, uint32_t snaplen, bool zerocopy)
 {
 	uint16_t qid;
 
@@ -275,6 +308,7 @@ pdump_register_rx_callbacks(enum pdump_version ver,
 			cbs->ring = ring;
 			cbs->mp = mp;
 			cbs->snaplen = snaplen;
+			cbs->zerocopy = zerocopy;
 			cbs->filter = filter;
 
 			cbs->cb = rte_eth_add_first_rx_callback(port, qid,
@@ -311,12 +345,27 @@ pdump_register_rx_callbacks(enum pdump_version ver,
 	return 0;
 }
 
+/* Fast free of transmitted mbufs ignores the references held by the capture */
+static bool
+pdump_tx_fast_free(uint16_t port, uint16_t queue)
+{
+	struct rte_eth_txq_info qinfo;
+	struct rte_eth_conf conf;
+
+	if (rte_eth_tx_queue_info_get(port, queue, &qinfo) == 0)
+		return qinfo.conf.offloads & RTE_ETH_TX_OFFLOAD_MBUF_FAST_FREE;
+
+	if (rte_eth_dev_conf_get(port, &conf) != 0)
+		return true;
+	return conf.txmode.offloads & RTE_ETH_TX_OFFLOAD_MBUF_FAST_FREE;
+}
+
 static int
 pdump_register_tx_callbacks(enum pdump_version ver,
 			    uint16_t end_q, uint16_t port, uint16_t queue,
 			    struct rte_ring *ring, struct rte_mempool *mp,
 			    struct rte_bpf *filter,
-			    uint16_t operation, uint32_t snaplen)
+			    uint16_t operation, uint32_t snaplen, bool zerocopy)
 {
 
 	uint16_t qid;
@@ -332,11 +381,18 @@ pdump_register_tx_callbacks(enum pdump_version ver,
 					port, qid);
 				return -EEXIST;
 			}
+			if (zerocopy && pdump_tx_fast_free(port, qid)) {
+				PDUMP_LOG_LINE(ERR,
+					"zero copy not supported with mbuf fast free on port=%d queue=%d",
+					port, qid);
+				return -ENOTSUP;
+			}
 			cbs->use_count = 0;
 			cbs->ver = ver;
 			cbs->ring = ring;
 			cbs->mp = mp;
 			cbs->snaplen = snaplen;
+			cbs->zerocopy = zerocopy;
 			cbs->filter = filter;
 
 			cbs->cb = rte_eth_add_tx_callback(port, qid, pdump_tx,
@@ -447,7 +503,7 @@ set_pdump_rxtx_cbs(const struct pdump_request *p)
 			return -EINVAL;
 		}
 		if ((nb_tx_q == 0 || nb_rx_q == 0) &&
-			flags == RTE_PDUMP_FLAG_RXTX) {
+			(flags & RTE_PDUMP_FLAG_RXTX) == RTE_PDUMP_FLAG_RXTX) {
 			PDUMP_LOG_LINE(ERR,
 				"both tx&rx queues must be non zero");
 			return -EINVAL;
@@ -459,7 +515,8 @@ set_pdump_rxtx_cbs(const struct pdump_request *p)
 		end_q = (queue == RTE_PDUMP_ALL_QUEUES) ? nb_rx_q : queue + 1;
 		ret = pdump_register_rx_callbacks(p->ver, end_q, port, queue,
 						  ring, mp, filter,
-						  operation, p->snaplen);
+						  operation, p->snaplen,
+						  flags & RTE_PDUMP_FLAG_ZEROCOPY);
 		if (ret < 0)
 			return ret;
 	}
@@ -469,7 +526,8 @@ set_pdump_rxtx_cbs(const struct pdump_request *p)
 		end_q = (queue == RTE_PDUMP_ALL_QUEUES) ? nb_tx_q : queue + 1;
 		ret = pdump_register_tx_callbacks(p->ver, end_q, port, queue,
 						  ring, mp, filter,
-						  operation, p->snaplen);
+						  operation, p->snaplen,
+						  flags & RTE_PDUMP_FLAG_ZEROCOPY);
 		if (ret < 0)
 			return ret;
 	}
@@ -715,7 +773,8 @@ pdump_validate_flags(uint32_t flags)
 	}
 
 	/* mask off the flags we know about */
-	if (flags & ~(RTE_PDUMP_FLAG_RXTX | RTE_PDUMP_FLAG_PCAPNG)) {
+	if (flags & ~(RTE_PDUMP_FLAG_RXTX | RTE_PDUMP_FLAG_PCAPNG |
+		      RTE_PDUMP_FLAG_ZEROCOPY)) {
 		PDUMP_LOG_LINE(ERR,
 			  "unknown flags: %#x", flags);
 		rte_errno = ENOTSUP;
@@ -772,7 +831,7 @@ pdump_prepare_client_request(const char *device, uint16_t queue,
 	memset(req, 0, sizeof(*req));
 
 	req->ver = (flags & RTE_PDUMP_FLAG_PCAPNG) ? V2 : V1;
-	req->flags = flags & RTE_PDUMP_FLAG_RXTX;
+	req->flags = flags & (RTE_PDUMP_FLAG_RXTX | RTE_PDUMP_FLAG_ZEROCOPY);
 	req->op = operation;
 	req->queue = queue;
 	rte_strscpy(req->device, device, sizeof(req->device));
@@ -29,6 +29,11 @@ enum {
 	RTE_PDUMP_FLAG_RXTX = (RTE_PDUMP_FLAG_RX|RTE_PDUMP_FLAG_TX),
 
 	RTE_PDUMP_FLAG_PCAPNG = 4, /* format for pcapng */
+	/*
+	 * reference the packet data instead of copying it,
+	 * the packets are held until the captured mbufs are freed
+	 */
+	RTE_PDUMP_FLAG_ZEROCOPY = 8,
 };
 
 /**
@@ -93,6 +98,9 @@ rte_pdump_enable(uint16_t port, uint16_t queue, uint32_t flags,
  *  queues of a given port.
  * @param flags
  *  Pdump library flags that specify direction and packet format.
+ *  With RTE_PDUMP_FLAG_ZEROCOPY, the captured packets reference the data
+ *  of the original packets, which are held until they are freed by the user.
+ *  Transmit queues using RTE_ETH_TX_OFFLOAD_MBUF_FAST_FREE are not supported.
  * @param snaplen
  *  The upper limit on bytes to copy.
  *  Passing UINT32_MAX means capture all the possible data.
@@ -100,6 +108,7 @@ rte_pdump_enable(uint16_t port, uint16_t queue, uint32_t flags,
  *  The ring on which captured packets will be enqueued for user.
  * @param mp
  *  The mempool on to which original packets will be mirrored or duplicated.
+ *  In zero copy mode, its size bounds the number of packets held.
  * @param prm
  *  Use BPF program to run to filter packes (can be NULL)
  *
@@ -11,6 +11,7 @@
 #include <eal_export.h>
 #include <rte_common.h>
 #include <rte_byteorder.h>
+#include <rte_hash.h>
 #include <rte_tailq.h>
 #include <rte_eal_memconfig.h>
 
@@ -89,6 +90,14 @@ struct table {
 	 */
 	struct rte_swx_table_entry *pending_default;
 
+	/* Index of the table->entries list by key, only used for the exact match tables. When
+	 * NULL, the table->entries list is searched linearly.
+	 */
+	struct rte_hash *entries_index;
+
+	/* Buffer for the masked key used as the index key. */
+	uint8_t *entries_index_key;
+
 	int is_stub;
 	uint32_t n_add;
 	uint32_t n_modify;
@@ -140,6 +149,12 @@ struct learner {
 	struct rte_swx_table_entry *pending_default;
 };
 
+struct instance {
+	struct rte_swx_pipeline *p;
+	struct rte_swx_table_state *ts;
+	struct rte_swx_table_state *ts_next;
+};
+
 struct rte_swx_ctl_pipeline {
 	struct rte_swx_ctl_pipeline_info info;
 	struct rte_swx_pipeline *p;
@@ -149,6 +164,11 @@ struct rte_swx_ctl_pipeline {
 	struct learner *learners;
 	struct rte_swx_table_state *ts;
 	struct rte_swx_table_state *ts_next;
+
+	/* Pipeline instances sharing the regular and selector tables of the above pipeline. */
+	struct instance *instances;
+	uint32_t n_instances;
+
 	int numa_node;
 };
 
@@ -531,11 +551,115 @@ table_entry_keycmp(struct table *table,
 	return 0; /* Equal. */
 }
 
+static uint8_t *
+table_entries_index_key(struct table *table, struct rte_swx_table_entry *entry)
+{
+	uint8_t *key_mask0 = table->params.key_mask0;
+	uint8_t *key = table->entries_index_key;
+	uint32_t i;
+
+	for (i = 0; i < table->params.key_size; i++)
+		key[i] = entry->key[i] & key_mask0[i];
+
+	return key;
+}
+
+static void
+table_entries_index_free(struct table *table)
+{
+	rte_hash_free(table->entries_index);
+	table->entries_index = NULL;
+
+	free(table->entries_index_key);
+	table->entries_index_key = NULL;
+}
+
+static void
+table_entries_index_create(struct rte_swx_ctl_pipeline *ctl, uint32_t table_id)
+{
+	struct table *table = &ctl->tables[table_id];
+	char name[RTE_HASH_NAMESIZE];
+	struct rte_hash_parameters params = {
+		.name = name,
+		.entries = RTE_MAX(table->params.n_keys_max, 8U),
+		.key_len = table->params.key_size,
+		.socket_id = ctl->numa_node,
+		.extra_flag = RTE_HASH_EXTRA_FLAGS_EXT_TABLE,
+	};
+
+	/* The index is optional, so any failure to create it is not an error. */
+	if (table->is_stub || (table->params.match_type != RTE_SWX_TABLE_MATCH_EXACT))
+		return;
+
+	snprintf(name, sizeof(name), "swx_ctl_%p_%u", (void *)ctl, table_id);
+
+	table->entries_index_key = calloc(1, table->params.key_size);
+	table->entries_index = rte_hash_create(&params);
+	if (!table->entries_index_key || !table->entries_index)
+		table_entries_index_free(table);
+}
+
+static void
+table_entries_index_add(struct table *table, struct rte_swx_table_entry *entry)
+{
+	if (!table->entries_index)
+		return;
+
+	/* Fall back to the linear search when the index is full. */
+	if (rte_hash_add_key_data(table->entries_index,
+				  table_entries_index_key(table, entry),
+				  entry))
+		table_entries_index_free(table);
+}
+
+static void
+table_entries_index_del(struct table *table, struct rte_swx_table_entry *entry)
+{
+	if (!table->entries_index)
+		return;
+
+	rte_hash_del_key(table->entries_index, table_entries_index_key(table, entry));
+}
+
+static void
+table_entries_index_add_list(struct table *table, struct rte_swx_table_entry_list *list)
+{
+	struct rte_swx_table_entry *entry;
+
+	TAILQ_FOREACH(entry, list, node)
+		table_entries_index_add(table, entry);
+}
+
+static void
+table_entries_insert(struct table *table, struct rte_swx_table_entry *entry)
+{
+	TAILQ_INSERT_TAIL(&table->entries, entry, node);
+	table_entries_index_add(table, entry);
+}
+
+static void
+table_entries_remove(struct table *table, struct rte_swx_table_entry *entry)
+{
+	TAILQ_REMOVE(&table->entries, entry, node);
+	table_entries_index_del(table, entry);
+}
+
 static struct rte_swx_table_entry *
 table_entries_find(struct table *table, struct rte_swx_table_entry *entry)
 {
 	struct rte_swx_table_entry *e;
 
+	if (table->entries_index) {
+		void *data;
+
+		if (rte_hash_lookup_data(table->entries_index,
+					 table_entries_index_key(table, entry),
+					 &data) < 0)
+			return NULL; /* Not found. */
+
+		return data; /* Found. */
+	}
+
 	TAILQ_FOREACH(e, &table->entries, node)
 		if (!table_entry_keycmp(table, entry, e))
 			return e; /* Found. */
@@ -553,7 +677,7 @@ table_entries_free(struct table *table)
 		if (!entry)
 			break;
 
-		TAILQ_REMOVE(&table->entries, entry, node);
+		table_entries_remove(table, entry);
 		table_entry_free(entry);
 	}
 }
@@ -573,6 +697,7 @@ table_pending_add_find(struct table *table, struct rte_swx_table_entry *entry)
 static void
 table_pending_add_admit(struct table *table)
 {
+	table_entries_index_add_list(table, &table->pending_add);
 	TAILQ_CONCAT(&table->entries, &table->pending_add, node);
 }
 
@@ -607,6 +732,7 @@ table_pending_modify0_find(struct table *table,
 static void
 table_pending_modify0_admit(struct table *table)
 {
+	table_entries_index_add_list(table, &table->pending_modify0);
 	TAILQ_CONCAT(&table->entries, &table->pending_modify0, node);
 }
 
@@ -641,6 +767,7 @@ table_pending_modify1_find(struct table *table,
 static void
 table_pending_modify1_admit(struct table *table)
 {
+	table_entries_index_add_list(table, &table->pending_modify1);
 	TAILQ_CONCAT(&table->entries, &table->pending_modify1, node);
 }
 
@@ -675,6 +802,7 @@ table_pending_delete_find(struct table *table,
 static void
 table_pending_delete_admit(struct table *table)
 {
+	table_entries_index_add_list(table, &table->pending_delete);
 	TAILQ_CONCAT(&table->entries, &table->pending_delete, node);
 }
 
@@ -744,6 +872,7 @@ table_free(struct rte_swx_ctl_pipeline *ctl)
 		free(table->actions);
 		free(table->params.key_mask0);
 
+		table_entries_index_free(table);
 		table_entries_free(table);
 		table_pending_add_free(table);
 		table_pending_modify0_free(table);
@@ -1161,6 +1290,99 @@ table_state_create(struct rte_swx_ctl_pipeline *ctl)
 	return status;
 }
 
+/* The regular and selector table entries of the instance table state point to the table
+ * objects and to the default action data of the ctl table state, while the learner table
+ * entries point to the instance learner table objects and default action data.
+ */
+static void
+instance_table_state_sync(struct rte_swx_ctl_pipeline *ctl,
+			  struct rte_swx_table_state *dst,
+			  struct rte_swx_table_state *src)
+{
+	uint32_t n_shared = ctl->info.n_tables + ctl->info.n_selectors, i;
+
+	memcpy(dst, src, n_shared * sizeof(struct rte_swx_table_state));
+
+	for (i = 0; i < ctl->info.n_learners; i++) {
+		struct learner *l = &ctl->learners[i];
+		struct rte_swx_table_state *ts_dst = &dst[n_shared + i];
+		struct rte_swx_table_state *ts_src = &src[n_shared + i];
+
+		memcpy(ts_dst->default_action_data, ts_src->default_action_data, l->action_data_size);
+		ts_dst->default_action_id = ts_src->default_action_id;
+	}
+}
+
+static void
+instance_table_state_free(struct rte_swx_ctl_pipeline *ctl, struct rte_swx_table_state *ts)
+{
+	uint32_t learner_base_index = ctl->info.n_tables + ctl->info.n_selectors, i;
+
+	if (!ts)
+		return;
+
+	for (i = 0; i < ctl->info.n_learners; i++)
+		free(ts[learner_base_index + i].default_action_data);
+
+	free(ts);
+}
+
+static void
+instance_free(struct rte_swx_ctl_pipeline *ctl)
+{
+	uint32_t i;
+
+	/* The instance table state currently in use is owned by the instance. */
+	for (i = 0; i < ctl->n_instances; i++)
+		instance_table_state_free(ctl, ctl->instances[i].ts_next);
+
+	free(ctl->instances);
+	ctl->instances = NULL;
+	ctl->n_instances = 0;
+}
+
+static int
+instance_check(struct rte_swx_ctl_pipeline *ctl, struct rte_swx_pipeline *p)
+{
+	struct rte_swx_ctl_pipeline_info info;
+	uint32_t i;
+
+	CHECK(!rte_swx_ctl_pipeline_info_get(p, &info), EINVAL);
+	CHECK(info.n_actions == ctl->info.n_actions, EINVAL);
+	CHECK(info.n_tables == ctl->info.n_tables, EINVAL);
+	CHECK(info.n_selectors == ctl->info.n_selectors, EINVAL);
+	CHECK(info.n_learners == ctl->info.n_learners, EINVAL);
+
+	for (i = 0; i < ctl->info.n_tables; i++) {
+		struct rte_swx_ctl_table_info table_info;
+
+		CHECK(!rte_swx_ctl_table_info_get(p, i, &table_info), EINVAL);
+		CHECK(!strcmp(table_info.name, ctl->tables[i].info.name), EINVAL);
+		CHECK(table_info.size == ctl->tables[i].info.size, EINVAL);
+	}
+
+	for (i = 0; i < ctl->info.n_selectors; i++) {
+		struct rte_swx_ctl_selector_info selector_info;
+
+		CHECK(!rte_swx_ctl_selector_info_get(p, i, &selector_info), EINVAL);
+		CHECK(!strcmp(selector_info.name, ctl->selectors[i].info.name), EINVAL);
+	}
+
+	for (i = 0; i < ctl->info.n_learners; i++) {
+		struct rte_swx_ctl_learner_info learner_info;
+
+		CHECK(!rte_swx_ctl_learner_info_get(p, i, &learner_info), EINVAL);
+		CHECK(!strcmp(learner_info.name, ctl->learners[i].info.name), EINVAL);
+	}
+
+	for (i = 0; i < ctl->n_instances; i++)
+		CHECK(ctl->instances[i].p != p, EINVAL);
+
+	CHECK(p != ctl->p, EINVAL);
+
+	return 0;
+}
+
 /* Global list of pipeline instances. */
 TAILQ_HEAD(rte_swx_ctl_pipeline_list, rte_tailq_entry);
 
@@ -1262,6 +1484,8 @@ rte_swx_ctl_pipeline_free(struct rte_swx_ctl_pipeline *ctl)
 
 	action_free(ctl);
 
+	instance_free(ctl);
+
 	table_state_free(ctl);
 
 	learner_free(ctl);
@@ -1408,6 +1632,9 @@ rte_swx_ctl_pipeline_create(struct rte_swx_pipeline *p)
 		status = table_params_get(ctl, i);
 		if (status)
 			goto error;
+
+		/* entries_index. */
+		table_entries_index_create(ctl, i);
 	}
 
 	/* selector tables. */
@@ -1552,6 +1779,82 @@ rte_swx_ctl_pipeline_create(struct rte_swx_pipeline *p)
 	return NULL;
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_swx_ctl_pipeline_instance_add, 26.03)
+int
+rte_swx_ctl_pipeline_instance_add(struct rte_swx_ctl_pipeline *ctl,
+				  struct rte_swx_pipeline *p)
+{
+	struct rte_swx_table_state *ts = NULL, *ts_next = NULL;
+	struct instance *instances;
+	uint32_t n_ts, learner_base_index, i;
+	int status;
+
+	CHECK(ctl, EINVAL);
+	CHECK(p, EINVAL);
+
+	status = instance_check(ctl, p);
+	if (status)
+		return status;
+
+	status = rte_swx_pipeline_table_state_get(p, &ts);
+	if (status)
+		return status;
+
+	n_ts = ctl->info.n_tables + ctl->info.n_selectors + ctl->info.n_learners;
+	learner_base_index = ctl->info.n_tables + ctl->info.n_selectors;
+
+	/* Memory allocation. */
+	instances = realloc(ctl->instances, (ctl->n_instances + 1) * sizeof(struct instance));
+	CHECK(instances, ENOMEM);
+	ctl->instances = instances;
+
+	ts_next = calloc(n_ts, sizeof(struct rte_swx_table_state));
+	CHECK(ts_next, ENOMEM);
+
+	for (i = 0; i < ctl->info.n_learners; i++) {
+		struct learner *l = &ctl->learners[i];
+		struct rte_swx_table_state *src = &ts[learner_base_index + i];
+		struct rte_swx_table_state *dst = &ts_next[learner_base_index + i];
+
+		dst->obj = src->obj;
+
+		dst->default_action_data = calloc(1, RTE_MAX(l->action_data_size, 1U));
+		if (!dst->default_action_data) {
+			instance_table_state_free(ctl, ts_next);
+			return -ENOMEM;
+		}
+	}
+
+	/* Free the private copy of the regular and selector tables of the instance. Nothing can
+	 * fail from this point onwards.
+	 */
+	for (i = 0; i < ctl->info.n_tables; i++) {
+		struct table *table = &ctl->tables[i];
+		struct rte_swx_table_state *t = &ts[i];
+
+		if (!table->is_stub && table->ops.free && t->obj)
+			table->ops.free(t->obj);
+
+		free(t->default_action_data);
+	}
+
+	for (i = 0; i < ctl->info.n_selectors; i++)
+		rte_swx_table_selector_free(ts[ctl->info.n_tables + i].obj);
+
+	rte_swx_pipeline_table_state_shared_set(p);
+
+	/* Point the instance to the shared tables. */
+	instance_table_state_sync(ctl, ts, ctl->ts);
+	instance_table_state_sync(ctl, ts_next, ctl->ts_next);
+
+	ctl->instances[ctl->n_instances].p = p;
+	ctl->instances[ctl->n_instances].ts = ts;
+	ctl->instances[ctl->n_instances].ts_next = ts_next;
+	ctl->n_instances++;
+
+	return 0;
+}
+
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_swx_ctl_pipeline_table_entry_add, 20.11)
 int
 rte_swx_ctl_pipeline_table_entry_add(struct rte_swx_ctl_pipeline *ctl,
@@ -1586,9 +1889,7 @@ rte_swx_ctl_pipeline_table_entry_add(struct rte_swx_ctl_pipeline *ctl,
 				  new_entry,
 				  node);
 
-		TAILQ_REMOVE(&table->entries,
-			     existing_entry,
-			     node);
+		table_entries_remove(table, existing_entry);
 
 		TAILQ_INSERT_TAIL(&table->pending_modify0,
 				  existing_entry,
@@ -1693,9 +1994,7 @@ rte_swx_ctl_pipeline_table_entry_delete(struct rte_swx_ctl_pipeline *ctl,
 	 */
 	existing_entry = table_entries_find(table, entry);
 	if (existing_entry) {
-		TAILQ_REMOVE(&table->entries,
-			     existing_entry,
-			     node);
+		table_entries_remove(table, existing_entry);
 
 		TAILQ_INSERT_TAIL(&table->pending_delete,
 				  existing_entry,
@@ -2600,14 +2899,29 @@ rte_swx_ctl_pipeline_commit(struct rte_swx_ctl_pipeline *ctl, int abort_on_fail)
 		learner_rollfwd(ctl, i);
 
 	/* Swap the table state for the data plane. The current ts and ts_next
-	 * become the new ts_next and ts, respectively.
+	 * become the new ts_next and ts, respectively. The pipeline instances
+	 * sharing the tables are switched at the same time.
 	 */
 	rte_swx_pipeline_table_state_set(ctl->p, ctl->ts_next);
+	for (i = 0; i < ctl->n_instances; i++) {
+		struct instance *inst = &ctl->instances[i];
+
+		instance_table_state_sync(ctl, inst->ts_next, ctl->ts_next);
+		rte_swx_pipeline_table_state_set(inst->p, inst->ts_next);
+	}
 	usleep(100);
 	ts = ctl->ts;
 	ctl->ts = ctl->ts_next;
 	ctl->ts_next = ts;
 
+	for (i = 0; i < ctl->n_instances; i++) {
+		struct instance *inst = &ctl->instances[i];
+
+		ts = inst->ts;
+		inst->ts = inst->ts_next;
+		inst->ts_next = ts;
+	}
+
 	/* Operate the changes on the current ts_next, which is the previous ts, in order to get
 	 * the current ts_next in sync with the current ts. Since the changes that can fail did
 	 * not fail on the previous ts_next, it is guaranteed that they will not fail on the
@@ -691,6 +691,9 @@ struct rte_swx_learner_stats {
 	/** Number of packets with forget event. */
 	uint64_t n_pkts_forget;
 
+	/** Number of keys removed on expiry by rte_swx_pipeline_learner_scan(). */
+	uint64_t n_keys_expired;
+
 	/** Number of packets (with either lookup hit or miss) per pipeline action. Array of
 	 * pipeline *n_actions* elements indexed by the pipeline-level *action_id*, therefore this
 	 * array has the same size for all the tables within the same pipeline.
@@ -814,6 +817,24 @@ int
 rte_swx_pipeline_table_state_set(struct rte_swx_pipeline *p,
 				 struct rte_swx_table_state *table_state);
 
+/**
+ * Pipeline table state shared flag set
+ *
+ * Mark the regular and selector table objects referenced by the table state of the current
+ * pipeline as owned by another pipeline instance, so that they are not freed when the current
+ * pipeline is freed. The learner table objects and the learner table default action data are
+ * still owned by the current pipeline.
+ *
+ * @param[in] p
+ *   Pipeline handle.
+ * @return
+ *   0 on success or the following error codes otherwise:
+ *   -EINVAL: Invalid argument.
+ */
+__rte_experimental
+int
+rte_swx_pipeline_table_state_shared_set(struct rte_swx_pipeline *p);
+
 /*
  * High Level Reference Table Update API.
  */
@@ -1038,6 +1059,33 @@ rte_swx_ctl_pipeline_learner_default_entry_add(struct rte_swx_ctl_pipeline *ctl,
 					       const char *learner_name,
 					       struct rte_swx_table_entry *entry);
 
+/**
+ * Pipeline control instance add
+ *
+ * Add a pipeline instance that shares the regular and selector tables of the pipeline
+ * controlled by *ctl*, so that N instances of the same pipeline (e.g. one per RSS queue) use
+ * a single copy of the table memory. The table updates are published to all the instances on
+ * each commit. The per-instance state, i.e. the learner tables, the register arrays and the
+ * meter arrays, is not shared.
+ *
+ * The instance must be built from the same specification as the pipeline controlled by *ctl*
+ * and it must not be running yet. Its private copy of the shared tables is freed. The instance
+ * must stop running before *ctl* and its pipeline are freed.
+ *
+ * @param[in] ctl
+ *   Pipeline control handle.
+ * @param[in] p
+ *   Pipeline instance handle.
+ * @return
+ *   0 on success or the following error codes otherwise:
+ *   -EINVAL: Invalid argument;
+ *   -ENOMEM: Not enough memory.
+ */
+__rte_experimental
+int
+rte_swx_ctl_pipeline_instance_add(struct rte_swx_ctl_pipeline *ctl,
+				  struct rte_swx_pipeline *p);
+
 /**
  * Pipeline commit
  *
@@ -15,6 +15,7 @@
 #include <rte_swx_port_ethdev.h>
 #include <rte_swx_port_fd.h>
 #include <rte_swx_port_ring.h>
+#include <rte_swx_port_xsk.h>
 #include "rte_swx_port_source_sink.h"
 
 #include <rte_swx_table_em.h>
@@ -9890,7 +9891,7 @@ table_state_build_free(struct rte_swx_pipeline *p)
 	if (!p->table_state)
 		return;
 
-	for (i = 0; i < p->n_tables; i++) {
+	for (i = 0; !p->table_state_shared && (i < p->n_tables); i++) {
 		struct rte_swx_table_state *ts = &p->table_state[i];
 		struct table *table = table_find_by_id(p, i);
 
@@ -9902,7 +9903,7 @@ table_state_build_free(struct rte_swx_pipeline *p)
 		free(ts->default_action_data);
 	}
 
-	for (i = 0; i < p->n_selectors; i++) {
+	for (i = 0; !p->table_state_shared && (i < p->n_selectors); i++) {
 		struct rte_swx_table_state *ts = &p->table_state[p->n_tables + i];
 
 		/* ts->obj. */
@@ -10399,6 +10400,14 @@ port_in_types_register(struct rte_swx_pipeline *p)
 	if (status)
 		return status;
 
+#ifdef RTE_PORT_XSK
+	status = rte_swx_pipeline_port_in_type_register(p,
+		"xsk",
+		&rte_swx_port_xsk_reader_ops);
+	if (status)
+		return status;
+#endif
+
 	return 0;
 }
 
@@ -10431,6 +10440,14 @@ port_out_types_register(struct rte_swx_pipeline *p)
 	if (status)
 		return status;
 
+#ifdef RTE_PORT_XSK
+	status = rte_swx_pipeline_port_out_type_register(p,
+		"xsk",
+		&rte_swx_port_xsk_writer_ops);
+	if (status)
+		return status;
+#endif
+
 	return 0;
 }
 
@@ -10453,6 +10470,13 @@ table_types_register(struct rte_swx_pipeline *p)
 	if (status)
 		return status;
 
+	status = rte_swx_pipeline_table_type_register(p,
+		"wildcard_tss",
+		RTE_SWX_TABLE_MATCH_WILDCARD,
+		&rte_swx_table_wildcard_match_tss_ops);
+	if (status)
+		return status;
+
 	return 0;
 }
 
@@ -10701,6 +10725,21 @@ rte_swx_pipeline_run(struct rte_swx_pipeline *p, uint32_t n_instructions)
 		instr_exec(p);
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_swx_pipeline_learner_scan, 26.03)
+void
+rte_swx_pipeline_learner_scan(struct rte_swx_pipeline *p, uint32_t n_buckets)
+{
+	uint64_t time = rte_get_tsc_cycles();
+	struct learner *l;
+
+	TAILQ_FOREACH(l, &p->learners, node) {
+		struct rte_swx_table_state *ts = &p->table_state[p->n_tables + p->n_selectors + l->id];
+
+		p->learner_stats[l->id].n_keys_expired +=
+			rte_swx_table_learner_scan(ts->obj, time, &l->scan_pos, n_buckets);
+	}
+}
+
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_swx_pipeline_flush, 20.11)
 void
 rte_swx_pipeline_flush(struct rte_swx_pipeline *p)
@@ -11161,6 +11200,17 @@ rte_swx_pipeline_table_state_set(struct rte_swx_pipeline *p,
 	return 0;
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_swx_pipeline_table_state_shared_set, 26.03)
+int
+rte_swx_pipeline_table_state_shared_set(struct rte_swx_pipeline *p)
+{
+	if (!p || !p->build_done)
+		return -EINVAL;
+
+	p->table_state_shared = 1;
+	return 0;
+}
+
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_swx_ctl_pipeline_port_in_stats_read, 20.11)
 int
 rte_swx_ctl_pipeline_port_in_stats_read(struct rte_swx_pipeline *p,
@@ -11277,6 +11327,7 @@ rte_swx_ctl_pipeline_learner_stats_read(struct rte_swx_pipeline *p,
 
 	stats->n_pkts_rearm = learner_stats->n_pkts_rearm;
 	stats->n_pkts_forget = learner_stats->n_pkts_forget;
+	stats->n_keys_expired = learner_stats->n_keys_expired;
 
 	return 0;
 }
@@ -14802,3 +14853,72 @@ rte_swx_pipeline_build_from_lib(struct rte_swx_pipeline **pipeline,
 
 	return status;
 }
+
+static void
+action_inproc_run(struct rte_swx_pipeline *p)
+{
+	struct thread *t = &p->threads[p->thread_id];
+	struct instruction *ret = t->ip;
+
+	/* The table instruction already moved the thread past itself. */
+	t->ip = p->action_instructions[t->action_id];
+
+	for ( ; ; ) {
+		struct instruction *ip = t->ip;
+
+		switch (ip->type) {
+		case INSTR_RETURN:
+			t->ip = ret;
+			return;
+
+		/* The thread must not yield in the middle of the action. */
+		case INSTR_EXTERN_OBJ:
+			while (!__instr_extern_obj_exec(p, t, ip))
+				;
+			t->ip++;
+			break;
+
+		case INSTR_EXTERN_FUNC:
+			while (!__instr_extern_func_exec(p, t, ip))
+				;
+			t->ip++;
+			break;
+
+		default:
+			p->instruction_table[ip->type](p);
+
+			/* The thread moved to the next packet. */
+			if (instruction_does_tx(ip))
+				return;
+		}
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_swx_pipeline_build_inproc, 26.03)
+int
+rte_swx_pipeline_build_inproc(struct rte_swx_pipeline *p)
+{
+	struct action *a;
+	uint32_t i;
+
+	CHECK(p, EINVAL);
+	CHECK(p->build_done, EINVAL);
+	CHECK(!p->lib, EEXIST);
+
+	/* Action instructions. */
+	TAILQ_FOREACH(a, &p->actions, node)
+		p->action_funcs[a->id] = action_inproc_run;
+
+	/* Pipeline table instructions. */
+	for (i = 0; i < p->n_instructions; i++) {
+		struct instruction *instr = &p->instructions[i];
+
+		if (instr->type == INSTR_TABLE)
+			instr->type = INSTR_TABLE_AF;
+
+		if (instr->type == INSTR_LEARNER)
+			instr->type = INSTR_LEARNER_AF;
+	}
+
+	return 0;
+}
@@ -1034,6 +1034,28 @@ rte_swx_pipeline_build_from_lib(struct rte_swx_pipeline **p,
 				FILE *iospec_file,
 				int numa_node);
 
+/**
+ * Pipeline in-process build
+ *
+ * Once called on a pipeline built with rte_swx_pipeline_build(), the pipeline
+ * runs the instructions of each action to completion when its table lookup is
+ * done, like the action functions of rte_swx_pipeline_build_from_lib(), but
+ * without any C code to generate and compile.
+ *
+ * Each table lookup, including its action, counts as a single instruction of
+ * rte_swx_pipeline_run().
+ *
+ * @param[in] p
+ *   Pipeline handle.
+ * @return
+ *   0 on success or the following error codes otherwise:
+ *   -EINVAL: Invalid argument or pipeline not built;
+ *   -EEXIST: Pipeline was built from a shared object library.
+ */
+__rte_experimental
+int
+rte_swx_pipeline_build_inproc(struct rte_swx_pipeline *p);
+
 /**
  * Pipeline run
  *
@@ -1047,6 +1069,22 @@ void
 rte_swx_pipeline_run(struct rte_swx_pipeline *p,
 		     uint32_t n_instructions);
 
+/**
+ * Pipeline learner tables expiry scan
+ *
+ * Scan the next batch of buckets of each learner table of the pipeline to remove the keys found
+ * expired, see rte_swx_table_learner_scan(). Must be called by the thread running the pipeline,
+ * typically after each call to rte_swx_pipeline_run().
+ *
+ * @param[in] p
+ *   Pipeline handle.
+ * @param[in] n_buckets
+ *   Number of buckets to scan per learner table.
+ */
+__rte_experimental
+void
+rte_swx_pipeline_learner_scan(struct rte_swx_pipeline *p, uint32_t n_buckets);
+
 /**
  * Pipeline flush
  *
@@ -981,6 +981,7 @@ struct learner {
 	uint32_t timeout[RTE_SWX_TABLE_LEARNER_N_KEY_TIMEOUTS_MAX];
 	uint32_t n_timeouts;
 	uint32_t id;
+	size_t scan_pos;
 };
 
 TAILQ_HEAD(learner_tailq, learner);
@@ -995,6 +996,7 @@ struct learner_statistics {
 	uint64_t n_pkts_learn[2]; /* 0 = Learn OK, 1 = Learn error. */
 	uint64_t n_pkts_rearm;
 	uint64_t n_pkts_forget;
+	uint64_t n_keys_expired;
 	uint64_t *n_pkts_action;
 };
 
@@ -1604,6 +1606,11 @@ struct rte_swx_pipeline {
 	uint32_t n_instructions;
 	int build_done;
 	int numa_node;
+
+	/* When set, the regular and selector table objects referenced by the table state are
+	 * owned by another pipeline instance.
+	 */
+	int table_state_shared;
 };
 
 /*
@@ -15,6 +15,7 @@
 #include <rte_swx_port_ring.h>
 #include <rte_swx_port_source_sink.h>
 #include <rte_swx_port_fd.h>
+#include <rte_swx_port_xsk.h>
 
 #include "rte_swx_pipeline_spec.h"
 
@@ -3704,6 +3705,10 @@ port_in_params_free(void *params, const char *port_type)
 		struct rte_swx_port_source_params *p = params;
 
 		dev_name = (uintptr_t)p->file_name;
+	} else if (!strcmp(port_type, "xsk")) {
+		struct rte_swx_port_xsk_reader_params *p = params;
+
+		dev_name = (uintptr_t)p->ifname;
 	} else
 		dev_name = (uintptr_t)NULL;
 
@@ -3731,6 +3736,10 @@ port_out_params_free(void *params, const char *port_type)
 		struct rte_swx_port_sink_params *p = params;
 
 		dev_name = (uintptr_t)p->file_name;
+	} else if (!strcmp(port_type, "xsk")) {
+		struct rte_swx_port_xsk_writer_params *p = params;
+
+		dev_name = (uintptr_t)p->ifname;
 	} else
 		dev_name = (uintptr_t)NULL;
 
@@ -4035,6 +4044,81 @@ port_in_fd_parse(char **tokens,
 	return p;
 }
 
+static void *
+port_in_xsk_parse(char **tokens, uint32_t n_tokens, const char **err_msg)
+{
+	struct rte_swx_port_xsk_reader_params *p = NULL;
+	struct rte_mempool *mempool = NULL;
+	char *token, *ifname = NULL;
+	uint32_t queue_id, n_frames, burst_size;
+
+	if ((n_tokens != 9) ||
+	    strcmp(tokens[1], "rxq") ||
+	    strcmp(tokens[3], "frames") ||
+	    strcmp(tokens[5], "mempool") ||
+	    strcmp(tokens[7], "bsz")) {
+		if (err_msg)
+			*err_msg = "Invalid statement.";
+		return NULL;
+	}
+
+	/* <queue_id>. */
+	token = tokens[2];
+	queue_id = strtoul(token, &token, 0);
+	if (token[0]) {
+		if (err_msg)
+			*err_msg = "Invalid <queue_id> parameter.";
+		return NULL;
+	}
+
+	/* <n_frames>. */
+	token = tokens[4];
+	n_frames = strtoul(token, &token, 0);
+	if (token[0]) {
+		if (err_msg)
+			*err_msg = "Invalid <n_frames> parameter.";
+		return NULL;
+	}
+
+	/* <mempool_name>. */
+	mempool = rte_mempool_lookup(tokens[6]);
+	if (!mempool) {
+		if (err_msg)
+			*err_msg = "Invalid <mempool_name> parameter.";
+		return NULL;
+	}
+
+	/* <burst_size>. */
+	token = tokens[8];
+	burst_size = strtoul(token, &token, 0);
+	if (token[0]) {
+		if (err_msg)
+			*err_msg = "Invalid <burst_size> parameter.";
+		return NULL;
+	}
+
+	/* Memory allocation. */
+	ifname = strdup(tokens[0]);
+	p = malloc(sizeof(struct rte_swx_port_xsk_reader_params));
+	if (!ifname || !p) {
+		free(ifname);
+		free(p);
+
+		if (err_msg)
+			*err_msg = "Memory allocation failed.";
+		return NULL;
+	}
+
+	/* Initialization. */
+	p->ifname = ifname;
+	p->queue_id = queue_id;
+	p->n_frames = n_frames;
+	p->mempool = mempool;
+	p->burst_size = burst_size;
+
+	return p;
+}
+
 static void *
 port_out_ethdev_parse(char **tokens, uint32_t n_tokens, const char **err_msg)
 {
@@ -4211,6 +4295,70 @@ port_out_fd_parse(char **tokens,
 	return p;
 }
 
+static void *
+port_out_xsk_parse(char **tokens, uint32_t n_tokens, const char **err_msg)
+{
+	struct rte_swx_port_xsk_writer_params *p = NULL;
+	char *token, *ifname = NULL;
+	uint32_t queue_id, n_frames, burst_size;
+
+	if ((n_tokens != 7) ||
+	    strcmp(tokens[1], "txq") ||
+	    strcmp(tokens[3], "frames") ||
+	    strcmp(tokens[5], "bsz")) {
+		if (err_msg)
+			*err_msg = "Invalid statement.";
+		return NULL;
+	}
+
+	/* <queue_id>. */
+	token = tokens[2];
+	queue_id = strtoul(token, &token, 0);
+	if (token[0]) {
+		if (err_msg)
+			*err_msg = "Invalid <queue_id> parameter.";
+		return NULL;
+	}
+
+	/* <n_frames>. */
+	token = tokens[4];
+	n_frames = strtoul(token, &token, 0);
+	if (token[0]) {
+		if (err_msg)
+			*err_msg = "Invalid <n_frames> parameter.";
+		return NULL;
+	}
+
+	/* <burst_size>. */
+	token = tokens[6];
+	burst_size = strtoul(token, &token, 0);
+	if (token[0]) {
+		if (err_msg)
+			*err_msg = "Invalid <burst_size> parameter.";
+		return NULL;
+	}
+
+	/* Memory allocation. */
+	ifname = strdup(tokens[0]);
+	p = malloc(sizeof(struct rte_swx_port_xsk_writer_params));
+	if (!ifname || !p) {
+		free(ifname);
+		free(p);
+
+		if (err_msg)
+			*err_msg = "Memory allocation failed.";
+		return NULL;
+	}
+
+	/* Initialization. */
+	p->ifname = ifname;
+	p->queue_id = queue_id;
+	p->n_frames = n_frames;
+	p->burst_size = burst_size;
+
+	return p;
+}
+
 struct pipeline_iospec *
 pipeline_iospec_parse(FILE *spec,
 		      uint32_t *err_line,
@@ -4339,6 +4487,8 @@ pipeline_iospec_parse(FILE *spec,
 				p = port_in_source_parse(&tokens[4], n_tokens - 4, err_msg);
 			else if (!strcmp(tokens[3], "fd"))
 				p = port_in_fd_parse(&tokens[4], n_tokens - 4, err_msg);
+			else if (!strcmp(tokens[3], "xsk"))
+				p = port_in_xsk_parse(&tokens[4], n_tokens - 4, err_msg);
 			else {
 				p = NULL;
 				if (err_msg)
@@ -4414,6 +4564,8 @@ pipeline_iospec_parse(FILE *spec,
 				p = port_out_sink_parse(&tokens[4], n_tokens - 4, err_msg);
 			else if (!strcmp(tokens[3], "fd"))
 				p = port_out_fd_parse(&tokens[4], n_tokens - 4, err_msg);
+			else if (!strcmp(tokens[3], "xsk"))
+				p = port_out_xsk_parse(&tokens[4], n_tokens - 4, err_msg);
 			else {
 				p = NULL;
 				if (err_msg)
@@ -2881,7 +2881,8 @@ pkt_work(struct rte_mbuf *mbuf,
 	struct rte_pipeline_table_entry *table_entry,
 	uint64_t time,
 	struct rte_table_action *action,
-	struct ap_config *cfg)
+	struct ap_config *cfg,
+	uint64_t action_mask)
 {
 	uint64_t drop_mask = 0;
 
@@ -2904,7 +2905,7 @@ pkt_work(struct rte_mbuf *mbuf,
 			sizeof(struct rte_ipv6_hdr);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_LB)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_LB)) {
 		void *data =
 			action_data_get(table_entry, action, RTE_TABLE_ACTION_LB);
 
@@ -2912,7 +2913,7 @@ pkt_work(struct rte_mbuf *mbuf,
 			data,
 			&cfg->lb);
 	}
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_MTR)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_MTR)) {
 		void *data =
 			action_data_get(table_entry, action, RTE_TABLE_ACTION_MTR);
 
@@ -2925,7 +2926,7 @@ pkt_work(struct rte_mbuf *mbuf,
 			total_length);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_TM)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_TM)) {
 		void *data =
 			action_data_get(table_entry, action, RTE_TABLE_ACTION_TM);
 
@@ -2935,7 +2936,7 @@ pkt_work(struct rte_mbuf *mbuf,
 			dscp);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_DECAP)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_DECAP)) {
 		void *data = action_data_get(table_entry,
 			action,
 			RTE_TABLE_ACTION_DECAP);
@@ -2943,7 +2944,7 @@ pkt_work(struct rte_mbuf *mbuf,
 		pkt_work_decap(mbuf, data);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_ENCAP)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_ENCAP)) {
 		void *data =
 			action_data_get(table_entry, action, RTE_TABLE_ACTION_ENCAP);
 
@@ -2955,7 +2956,7 @@ pkt_work(struct rte_mbuf *mbuf,
 			ip_offset);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_NAT)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_NAT)) {
 		void *data =
 			action_data_get(table_entry, action, RTE_TABLE_ACTION_NAT);
 
@@ -2965,7 +2966,7 @@ pkt_work(struct rte_mbuf *mbuf,
 			pkt_ipv6_work_nat(ip, data, &cfg->nat);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_TTL)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_TTL)) {
 		void *data =
 			action_data_get(table_entry, action, RTE_TABLE_ACTION_TTL);
 
@@ -2975,21 +2976,21 @@ pkt_work(struct rte_mbuf *mbuf,
 			drop_mask |= pkt_ipv6_work_ttl(ip, data);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_STATS)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_STATS)) {
 		void *data =
 			action_data_get(table_entry, action, RTE_TABLE_ACTION_STATS);
 
 		pkt_work_stats(data, total_length);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_TIME)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_TIME)) {
 		void *data =
 			action_data_get(table_entry, action, RTE_TABLE_ACTION_TIME);
 
 		pkt_work_time(data, time);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_SYM_CRYPTO)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_SYM_CRYPTO)) {
 		void *data = action_data_get(table_entry, action,
 				RTE_TABLE_ACTION_SYM_CRYPTO);
 
@@ -2997,7 +2998,7 @@ pkt_work(struct rte_mbuf *mbuf,
 				ip_offset);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_TAG)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_TAG)) {
 		void *data = action_data_get(table_entry,
 			action,
 			RTE_TABLE_ACTION_TAG);
@@ -3013,7 +3014,8 @@ pkt4_work(struct rte_mbuf **mbufs,
 	struct rte_pipeline_table_entry **table_entries,
 	uint64_t time,
 	struct rte_table_action *action,
-	struct ap_config *cfg)
+	struct ap_config *cfg,
+	uint64_t action_mask)
 {
 	uint64_t drop_mask0 = 0;
 	uint64_t drop_mask1 = 0;
@@ -3075,7 +3077,7 @@ pkt4_work(struct rte_mbuf **mbufs,
 			sizeof(struct rte_ipv6_hdr);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_LB)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_LB)) {
 		void *data0 =
 			action_data_get(table_entry0, action, RTE_TABLE_ACTION_LB);
 		void *data1 =
@@ -3102,7 +3104,7 @@ pkt4_work(struct rte_mbuf **mbufs,
 			&cfg->lb);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_MTR)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_MTR)) {
 		void *data0 =
 			action_data_get(table_entry0, action, RTE_TABLE_ACTION_MTR);
 		void *data1 =
@@ -3145,7 +3147,7 @@ pkt4_work(struct rte_mbuf **mbufs,
 			total_length3);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_TM)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_TM)) {
 		void *data0 =
 			action_data_get(table_entry0, action, RTE_TABLE_ACTION_TM);
 		void *data1 =
@@ -3176,7 +3178,7 @@ pkt4_work(struct rte_mbuf **mbufs,
 			dscp3);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_DECAP)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_DECAP)) {
 		void *data0 = action_data_get(table_entry0,
 			action,
 			RTE_TABLE_ACTION_DECAP);
@@ -3194,7 +3196,7 @@ pkt4_work(struct rte_mbuf **mbufs,
 			data0, data1, data2, data3);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_ENCAP)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_ENCAP)) {
 		void *data0 =
 			action_data_get(table_entry0, action, RTE_TABLE_ACTION_ENCAP);
 		void *data1 =
@@ -3233,7 +3235,7 @@ pkt4_work(struct rte_mbuf **mbufs,
 			ip_offset);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_NAT)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_NAT)) {
 		void *data0 =
 			action_data_get(table_entry0, action, RTE_TABLE_ACTION_NAT);
 		void *data1 =
@@ -3256,7 +3258,7 @@ pkt4_work(struct rte_mbuf **mbufs,
 		}
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_TTL)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_TTL)) {
 		void *data0 =
 			action_data_get(table_entry0, action, RTE_TABLE_ACTION_TTL);
 		void *data1 =
@@ -3279,7 +3281,7 @@ pkt4_work(struct rte_mbuf **mbufs,
 		}
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_STATS)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_STATS)) {
 		void *data0 =
 			action_data_get(table_entry0, action, RTE_TABLE_ACTION_STATS);
 		void *data1 =
@@ -3295,7 +3297,7 @@ pkt4_work(struct rte_mbuf **mbufs,
 		pkt_work_stats(data3, total_length3);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_TIME)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_TIME)) {
 		void *data0 =
 			action_data_get(table_entry0, action, RTE_TABLE_ACTION_TIME);
 		void *data1 =
@@ -3311,7 +3313,7 @@ pkt4_work(struct rte_mbuf **mbufs,
 		pkt_work_time(data3, time);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_SYM_CRYPTO)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_SYM_CRYPTO)) {
 		void *data0 = action_data_get(table_entry0, action,
 				RTE_TABLE_ACTION_SYM_CRYPTO);
 		void *data1 = action_data_get(table_entry1, action,
@@ -3331,7 +3333,7 @@ pkt4_work(struct rte_mbuf **mbufs,
 				ip_offset);
 	}
 
-	if (cfg->action_mask & (1LLU << RTE_TABLE_ACTION_TAG)) {
+	if (action_mask & (1LLU << RTE_TABLE_ACTION_TAG)) {
 		void *data0 = action_data_get(table_entry0,
 			action,
 			RTE_TABLE_ACTION_TAG);
@@ -3361,12 +3363,13 @@ ah(struct rte_pipeline *p,
 	uint64_t pkts_mask,
 	struct rte_pipeline_table_entry **entries,
 	struct rte_table_action *action,
-	struct ap_config *cfg)
+	struct ap_config *cfg,
+	uint64_t action_mask)
 {
 	uint64_t pkts_drop_mask = 0;
 	uint64_t time = 0;
 
-	if (cfg->action_mask & ((1LLU << RTE_TABLE_ACTION_MTR) |
+	if (action_mask & ((1LLU << RTE_TABLE_ACTION_MTR) |
 		(1LLU << RTE_TABLE_ACTION_TIME)))
 		time = rte_rdtsc();
 
@@ -3381,7 +3384,8 @@ ah(struct rte_pipeline *p,
 				&entries[i],
 				time,
 				action,
-				cfg);
+				cfg,
+				action_mask);
 
 			pkts_drop_mask |= drop_mask << i;
 		}
@@ -3393,7 +3397,8 @@ ah(struct rte_pipeline *p,
 				entries[i],
 				time,
 				action,
-				cfg);
+				cfg,
+				action_mask);
 
 			pkts_drop_mask |= drop_mask << i;
 		}
@@ -3407,7 +3412,8 @@ ah(struct rte_pipeline *p,
 				entries[pos],
 				time,
 				action,
-				cfg);
+				cfg,
+				action_mask);
 
 			pkts_mask &= ~pkt_mask;
 			pkts_drop_mask |= drop_mask << pos;
@@ -3432,15 +3438,77 @@ ah_default(struct rte_pipeline *p,
 		pkts_mask,
 		entries,
 		action,
-		&action->cfg);
+		&action->cfg,
+		action->cfg.action_mask);
 }
 
+/*
+ * Action handlers specialized for the most common action sets. The action mask
+ * is a compile time constant for these handlers, so the per action checks are
+ * resolved at build time and all the actions of each packet run back to back
+ * while its headers are still in cache.
+ */
+#define AH_MASK(a) (1LLU << RTE_TABLE_ACTION_##a)
+
+#define AH_FUSED(name, mask)						\
+static int								\
+ah_##name(struct rte_pipeline *p,					\
+	struct rte_mbuf **pkts,						\
+	uint64_t pkts_mask,						\
+	struct rte_pipeline_table_entry **entries,			\
+	void *arg)							\
+{									\
+	struct rte_table_action *action = arg;				\
+									\
+	return ah(p,							\
+		pkts,							\
+		pkts_mask,						\
+		entries,						\
+		action,							\
+		&action->cfg,						\
+		mask);							\
+}
+
+#define AH_FWD_STATS \
+	(AH_MASK(FWD) | AH_MASK(STATS))
+#define AH_FWD_TTL_STATS \
+	(AH_MASK(FWD) | AH_MASK(TTL) | AH_MASK(STATS))
+#define AH_FWD_NAT_TTL_STATS \
+	(AH_MASK(FWD) | AH_MASK(NAT) | AH_MASK(TTL) | AH_MASK(STATS))
+#define AH_FWD_ENCAP_TTL_STATS \
+	(AH_MASK(FWD) | AH_MASK(ENCAP) | AH_MASK(TTL) | AH_MASK(STATS))
+#define AH_FWD_ENCAP_NAT_TTL_STATS \
+	(AH_MASK(FWD) | AH_MASK(ENCAP) | AH_MASK(NAT) | AH_MASK(TTL) | AH_MASK(STATS))
+
+AH_FUSED(fwd_stats, AH_FWD_STATS)
+AH_FUSED(fwd_ttl_stats, AH_FWD_TTL_STATS)
+AH_FUSED(fwd_nat_ttl_stats, AH_FWD_NAT_TTL_STATS)
+AH_FUSED(fwd_encap_ttl_stats, AH_FWD_ENCAP_TTL_STATS)
+AH_FUSED(fwd_encap_nat_ttl_stats, AH_FWD_ENCAP_NAT_TTL_STATS)
+
+static const struct {
+	uint64_t action_mask;
+	rte_pipeline_table_action_handler_hit f_action_hit;
+} ah_fused[] = {
+	{AH_FWD_STATS, ah_fwd_stats},
+	{AH_FWD_TTL_STATS, ah_fwd_ttl_stats},
+	{AH_FWD_NAT_TTL_STATS, ah_fwd_nat_ttl_stats},
+	{AH_FWD_ENCAP_TTL_STATS, ah_fwd_encap_ttl_stats},
+	{AH_FWD_ENCAP_NAT_TTL_STATS, ah_fwd_encap_nat_ttl_stats},
+};
+
 static rte_pipeline_table_action_handler_hit
 ah_selector(struct rte_table_action *action)
 {
+	uint32_t i;
+
 	if (action->cfg.action_mask == (1LLU << RTE_TABLE_ACTION_FWD))
 		return NULL;
 
+	for (i = 0; i < RTE_DIM(ah_fused); i++)
+		if (action->cfg.action_mask == ah_fused[i].action_mask)
+			return ah_fused[i].f_action_hit;
+
 	return ah_default;
 }
 
@@ -16,12 +16,18 @@
 #include <rte_bitops.h>
 #include <rte_tailq.h>
 #include <rte_log.h>
+#include <rte_telemetry.h>
 
 #include "rte_pmu.h"
 #include "pmu_private.h"
 
 #define EVENT_SOURCE_DEVICES_PATH "/sys/bus/event_source/devices"
 
+/* events of the derived metrics reported by telemetry, if any */
+#ifdef RTE_PMU_EVENT_CYCLES
+#define PMU_TEL_METRICS
+#endif
+
 #define FIELD_PREP(m, v) (((uint64_t)(v) << (rte_ffs64(m) - 1)) & (m))
 
 RTE_LOG_REGISTER_DEFAULT(rte_pmu_logtype, INFO)
@@ -270,6 +276,7 @@ cleanup_events(struct rte_pmu_event_group *group)
 	}
 
 	group->enabled = false;
+	group->tsc = 0;
 }
 
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(__rte_pmu_enable_group, 25.07)
@@ -478,3 +485,146 @@ rte_pmu_fini(void)
 	rte_pmu.name = NULL;
 	rte_pmu.num_group_events = 0;
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_pmu_lcore_read, 26.03)
+int
+rte_pmu_lcore_read(unsigned int lcore_id, uint64_t *tsc, uint64_t *values,
+	unsigned int num)
+{
+	struct rte_pmu_event_group *group;
+	uint64_t pub_tsc;
+	uint32_t sn;
+
+	if (lcore_id >= RTE_MAX_LCORE || values == NULL)
+		return -EINVAL;
+
+	if (!rte_pmu.initialized)
+		return -ENODEV;
+
+	group = &rte_pmu.event_groups[lcore_id];
+	num = RTE_MIN(num, rte_pmu.num_group_events);
+	do {
+		sn = rte_seqcount_read_begin(&group->seqcount);
+		pub_tsc = group->tsc;
+		memcpy(values, group->values, num * sizeof(values[0]));
+	} while (rte_seqcount_read_retry(&group->seqcount, sn));
+
+	if (pub_tsc == 0)
+		return 0;
+
+	if (tsc != NULL)
+		*tsc = pub_tsc;
+
+	return num;
+}
+
+static int
+handle_lcores(const char *cmd __rte_unused, const char *params __rte_unused,
+	struct rte_tel_data *d)
+{
+	unsigned int lcore_id;
+
+	rte_tel_data_start_array(d, RTE_TEL_INT_VAL);
+	if (!rte_pmu.initialized)
+		return 0;
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		if (rte_pmu.event_groups[lcore_id].tsc != 0)
+			rte_tel_data_add_array_int(d, lcore_id);
+	}
+
+	return 0;
+}
+
+#ifdef PMU_TEL_METRICS
+/* Get the published value of an event, false if not in the group */
+static bool
+event_value(const char *name, const uint64_t *values, unsigned int num,
+	uint64_t *val)
+{
+	struct rte_pmu_event *event;
+
+	TAILQ_FOREACH(event, &rte_pmu.event_list, next) {
+		if (strcmp(event->name, name) != 0)
+			continue;
+		if (event->index >= num)
+			return false;
+
+		*val = values[event->index];
+		return true;
+	}
+
+	return false;
+}
+
+/* Add the ratio of two events if both are in the group */
+static void
+add_ratio(struct rte_tel_data *d, const char *name, const char *event,
+	const char *per_event, unsigned int scale, const uint64_t *values,
+	unsigned int num)
+{
+	char str[RTE_TEL_MAX_STRING_LEN];
+	uint64_t val, per_val;
+
+	if (!event_value(event, values, num, &val) ||
+			!event_value(per_event, values, num, &per_val) ||
+			per_val == 0)
+		return;
+
+	snprintf(str, sizeof(str), "%.3f", (double)val * scale / per_val);
+	rte_tel_data_add_dict_string(d, name, str);
+}
+#endif
+
+static int
+handle_lcore(const char *cmd __rte_unused, const char *params,
+	struct rte_tel_data *d)
+{
+	uint64_t values[RTE_MAX_NUM_GROUP_EVENTS];
+	struct rte_pmu_event *event;
+	unsigned long lcore_id;
+	char *endptr;
+	uint64_t tsc;
+	int num;
+
+	if (params == NULL)
+		return -EINVAL;
+	errno = 0;
+	lcore_id = strtoul(params, &endptr, 10);
+	if (errno)
+		return -errno;
+	if (*params == '\0' || *endptr != '\0' || lcore_id >= RTE_MAX_LCORE)
+		return -EINVAL;
+
+	num = rte_pmu_lcore_read(lcore_id, &tsc, values, RTE_DIM(values));
+	if (num < 0)
+		return num;
+	if (num == 0)
+		return -ENOENT;
+
+	/* counters are cumulative, rates are over the lifetime of the group */
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_uint(d, "tsc", tsc);
+	TAILQ_FOREACH(event, &rte_pmu.event_list, next) {
+		if (event->index < (unsigned int)num)
+			rte_tel_data_add_dict_uint(d, event->name, values[event->index]);
+	}
+#ifdef PMU_TEL_METRICS
+	add_ratio(d, "ipc", RTE_PMU_EVENT_INSTRUCTIONS, RTE_PMU_EVENT_CYCLES, 1,
+		values, num);
+	add_ratio(d, "llc_mpki", RTE_PMU_EVENT_LLC_MISSES,
+		RTE_PMU_EVENT_INSTRUCTIONS, 1000, values, num);
+	add_ratio(d, "branch_mpki", RTE_PMU_EVENT_BRANCH_MISSES,
+		RTE_PMU_EVENT_INSTRUCTIONS, 1000, values, num);
+#endif
+
+	return 0;
+}
+
+RTE_INIT(pmu_telemetry)
+{
+	rte_telemetry_register_cmd("/pmu/lcores", handle_lcores,
+		"Returns the lcores publishing PMU counters. No parameters");
+	rte_telemetry_register_cmd("/pmu/lcore", handle_lcore,
+		"Returns the PMU counters published by an lcore, with IPC and misses per thousand instructions. Parameters: int lcore_id");
+}
@@ -22,17 +22,30 @@
  * rte_pmu_init()
  * rte_pmu_add_event()
  *
- * Afterwards all threads can read events by calling rte_pmu_read().
+ * Afterwards all threads can read events by calling rte_pmu_read()
+ * or rte_pmu_read_group().
+ *
+ * Counters can only be read by the lcore they count for. An lcore calling
+ * rte_pmu_publish() makes its counters available to other threads,
+ * through rte_pmu_lcore_read() and the /pmu telemetry commands.
+ *
+ * The architecture headers name common events, for use with
+ * rte_pmu_add_event(): RTE_PMU_EVENT_CYCLES, RTE_PMU_EVENT_INSTRUCTIONS,
+ * RTE_PMU_EVENT_LLC_MISSES and RTE_PMU_EVENT_BRANCH_MISSES.
  */
 
+#include <string.h>
+
 #include <linux/perf_event.h>
 
 #include <rte_atomic.h>
 #include <rte_branch_prediction.h>
 #include <rte_common.h>
 #include <rte_compat.h>
+#include <rte_cycles.h>
 #include <rte_debug.h>
 #include <rte_lcore.h>
+#include <rte_seqcount.h>
 
 #if defined(RTE_ARCH_ARM64)
 #include "rte_pmu_pmc_arm64.h"
@@ -56,6 +69,9 @@ struct __rte_cache_aligned rte_pmu_event_group {
 	int fds[RTE_MAX_NUM_GROUP_EVENTS]; /**< array of event descriptors */
 	TAILQ_ENTRY(rte_pmu_event_group) next; /**< list entry */
 	bool enabled; /**< true if group was enabled on particular lcore */
+	rte_seqcount_t seqcount; /**< sequence counter of the published values */
+	uint64_t tsc; /**< TSC of the published values, 0 if none */
+	uint64_t values[RTE_MAX_NUM_GROUP_EVENTS]; /**< published values */
 };
 
 /**
@@ -230,6 +246,116 @@ rte_pmu_read(unsigned int index)
 #endif
 }
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Read the hardware counters of all the events of the group.
+ *
+ * The events of a group are scheduled together on the CPU, and the
+ * counters are read back to back, so that the values are consistent
+ * with each other, e.g. to compute the instructions per cycle.
+ * Same constraints as rte_pmu_read() apply.
+ *
+ * @param values
+ *   Array receiving the counters, indexed by the event index.
+ * @param num
+ *   Size of the values array.
+ * @return
+ *   Number of counters read, 0 in case of errors or lack of support.
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_pmu_read_group(uint64_t *values, unsigned int num)
+{
+#ifdef ALLOW_EXPERIMENTAL_API
+	unsigned int lcore_id = rte_lcore_id();
+	struct rte_pmu_event_group *group;
+	unsigned int i;
+
+	if (unlikely(!rte_pmu.initialized))
+		return 0;
+
+	/* non-EAL threads are not supported */
+	if (unlikely(lcore_id >= RTE_MAX_LCORE))
+		return 0;
+
+	group = &rte_pmu.event_groups[lcore_id];
+	if (unlikely(!group->enabled)) {
+		if (__rte_pmu_enable_group(group))
+			return 0;
+	}
+
+	num = RTE_MIN(num, rte_pmu.num_group_events);
+	for (i = 0; i < num; i++)
+		values[i] = __rte_pmu_read_userpage(group->mmap_pages[i]);
+
+	return num;
+#else
+	RTE_SET_USED(values);
+	RTE_SET_USED(num);
+	RTE_VERIFY(false);
+#endif
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Publish the counters of the calling lcore.
+ *
+ * The counters of all the events are read and stored with the current TSC,
+ * for other threads to read them with rte_pmu_lcore_read().
+ * This is typically called once per iteration of a processing loop.
+ * Same constraints as rte_pmu_read() apply.
+ */
+__rte_experimental
+static __rte_always_inline void
+rte_pmu_publish(void)
+{
+#ifdef ALLOW_EXPERIMENTAL_API
+	unsigned int lcore_id = rte_lcore_id();
+	struct rte_pmu_event_group *group;
+	uint64_t values[RTE_MAX_NUM_GROUP_EVENTS];
+	unsigned int num;
+
+	num = rte_pmu_read_group(values, RTE_DIM(values));
+	if (unlikely(num == 0))
+		return;
+
+	group = &rte_pmu.event_groups[lcore_id];
+	rte_seqcount_write_begin(&group->seqcount);
+	group->tsc = rte_get_tsc_cycles();
+	memcpy(group->values, values, num * sizeof(values[0]));
+	rte_seqcount_write_end(&group->seqcount);
+#else
+	RTE_VERIFY(false);
+#endif
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Read the counters last published by an lcore.
+ *
+ * @param lcore_id
+ *   The lcore which published the counters.
+ * @param tsc
+ *   Pointer receiving the TSC of the publication, may be NULL.
+ * @param values
+ *   Array receiving the counters, indexed by the event index.
+ * @param num
+ *   Size of the values array.
+ * @return
+ *   Number of counters read, 0 if the lcore did not publish any,
+ *   negative value otherwise.
+ */
+__rte_experimental
+int
+rte_pmu_lcore_read(unsigned int lcore_id, uint64_t *tsc, uint64_t *values,
+	unsigned int num);
+
 #ifdef __cplusplus
 }
 #endif
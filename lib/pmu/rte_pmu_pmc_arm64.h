@@ -7,6 +7,11 @@
 
 #include <rte_common.h>
 
+#define RTE_PMU_EVENT_CYCLES		"cpu_cycles"
+#define RTE_PMU_EVENT_INSTRUCTIONS	"inst_retired"
+#define RTE_PMU_EVENT_LLC_MISSES	"ll_cache_miss_rd"
+#define RTE_PMU_EVENT_BRANCH_MISSES	"br_mis_pred"
+
 static __rte_always_inline uint64_t
 rte_pmu_pmc_read(int index)
 {
@@ -7,6 +7,11 @@
 
 #include <rte_common.h>
 
+#define RTE_PMU_EVENT_CYCLES		"cpu-cycles"
+#define RTE_PMU_EVENT_INSTRUCTIONS	"instructions"
+#define RTE_PMU_EVENT_LLC_MISSES	"cache-misses"
+#define RTE_PMU_EVENT_BRANCH_MISSES	"branch-misses"
+
 static __rte_always_inline uint64_t
 rte_pmu_pmc_read(int index)
 {
@@ -5,6 +5,7 @@
 #include <stdint.h>
 
 #include <eal_export.h>
+#include <rte_cycles.h>
 #include <rte_mbuf.h>
 #include <rte_ring.h>
 #include <rte_malloc.h>
@@ -736,6 +737,239 @@ rte_port_ring_writer_nodrop_stats_read(void *port,
 	return 0;
 }
 
+/*
+ * Port RING Writer Group
+ */
+#ifdef RTE_PORT_STATS_COLLECT
+
+#define RTE_PORT_RING_WRITER_GROUP_STATS_PKTS_IN_ADD(port, val) \
+	port->stats.n_pkts_in += val
+#define RTE_PORT_RING_WRITER_GROUP_STATS_PKTS_DROP_ADD(port, val) \
+	port->stats.n_pkts_drop += val
+
+#else
+
+#define RTE_PORT_RING_WRITER_GROUP_STATS_PKTS_IN_ADD(port, val)
+#define RTE_PORT_RING_WRITER_GROUP_STATS_PKTS_DROP_ADD(port, val)
+
+#endif
+
+struct __rte_cache_aligned rte_port_ring_writer_group_buf {
+	struct rte_mbuf *tx_buf[RTE_PORT_IN_BURST_SIZE_MAX];
+	struct rte_ring *ring;
+	uint32_t tx_buf_count;
+};
+
+struct rte_port_ring_writer_group {
+	struct rte_port_out_stats stats;
+
+	uint64_t flush_cycles;
+	uint64_t flush_tsc;
+	uint32_t tx_burst_sz;
+	uint32_t ring_id_offset;
+	uint32_t n_rings;
+
+	/* Bitmap of the rings with packets buffered. */
+	uint64_t *pending;
+
+	struct rte_port_ring_writer_group_buf bufs[];
+};
+
+static void *
+rte_port_ring_writer_group_create(void *params, int socket_id)
+{
+	struct rte_port_ring_writer_group_params *conf =
+			params;
+	struct rte_port_ring_writer_group *port;
+	uint32_t n_pending, i;
+	size_t size;
+
+	/* Check input parameters */
+	if ((conf == NULL) ||
+		(conf->rings == NULL) ||
+		(conf->n_rings == 0) ||
+		(conf->tx_burst_sz == 0) ||
+		(conf->tx_burst_sz > RTE_PORT_IN_BURST_SIZE_MAX)) {
+		PORT_LOG(ERR, "%s: Invalid Parameters", __func__);
+		return NULL;
+	}
+
+	for (i = 0; i < conf->n_rings; i++)
+		if (conf->rings[i] == NULL) {
+			PORT_LOG(ERR, "%s: Invalid Parameters", __func__);
+			return NULL;
+		}
+
+	/* Memory allocation */
+	n_pending = RTE_ALIGN_CEIL(conf->n_rings, 64) / 64;
+	size = sizeof(*port) +
+		conf->n_rings * sizeof(struct rte_port_ring_writer_group_buf);
+
+	port = rte_zmalloc_socket("PORT", size, RTE_CACHE_LINE_SIZE, socket_id);
+	if (port == NULL) {
+		PORT_LOG(ERR, "%s: Failed to allocate port", __func__);
+		return NULL;
+	}
+
+	port->pending = rte_zmalloc_socket("PORT", n_pending * sizeof(uint64_t),
+			RTE_CACHE_LINE_SIZE, socket_id);
+	if (port->pending == NULL) {
+		PORT_LOG(ERR, "%s: Failed to allocate port", __func__);
+		rte_free(port);
+		return NULL;
+	}
+
+	/* Initialization */
+	port->flush_cycles = conf->flush_cycles;
+	port->flush_tsc = rte_rdtsc();
+	port->tx_burst_sz = conf->tx_burst_sz;
+	port->ring_id_offset = conf->ring_id_offset;
+	port->n_rings = conf->n_rings;
+
+	for (i = 0; i < conf->n_rings; i++)
+		port->bufs[i].ring = conf->rings[i];
+
+	return port;
+}
+
+static inline void
+send_burst_group(struct rte_port_ring_writer_group *p, uint32_t ring_id)
+{
+	struct rte_port_ring_writer_group_buf *b = &p->bufs[ring_id];
+	uint32_t nb_tx;
+
+	nb_tx = rte_ring_enqueue_burst(b->ring, (void **)b->tx_buf,
+			b->tx_buf_count, NULL);
+
+	RTE_PORT_RING_WRITER_GROUP_STATS_PKTS_DROP_ADD(p, b->tx_buf_count - nb_tx);
+	for ( ; nb_tx < b->tx_buf_count; nb_tx++)
+		rte_pktmbuf_free(b->tx_buf[nb_tx]);
+
+	b->tx_buf_count = 0;
+	p->pending[ring_id / 64] &= ~(1LLU << (ring_id % 64));
+}
+
+static inline void
+rte_port_ring_writer_group_buffer(struct rte_port_ring_writer_group *p,
+		struct rte_mbuf *pkt)
+{
+	struct rte_port_ring_writer_group_buf *b;
+	uint32_t ring_id;
+
+	RTE_PORT_RING_WRITER_GROUP_STATS_PKTS_IN_ADD(p, 1);
+
+	ring_id = RTE_MBUF_METADATA_UINT32(pkt, p->ring_id_offset);
+	if (unlikely(ring_id >= p->n_rings)) {
+		RTE_PORT_RING_WRITER_GROUP_STATS_PKTS_DROP_ADD(p, 1);
+		rte_pktmbuf_free(pkt);
+		return;
+	}
+
+	b = &p->bufs[ring_id];
+	b->tx_buf[b->tx_buf_count++] = pkt;
+	p->pending[ring_id / 64] |= 1LLU << (ring_id % 64);
+
+	if (b->tx_buf_count >= p->tx_burst_sz)
+		send_burst_group(p, ring_id);
+}
+
+static int
+rte_port_ring_writer_group_tx(void *port, struct rte_mbuf *pkt)
+{
+	struct rte_port_ring_writer_group *p = port;
+
+	rte_port_ring_writer_group_buffer(p, pkt);
+
+	return 0;
+}
+
+static int
+rte_port_ring_writer_group_tx_bulk(void *port,
+		struct rte_mbuf **pkts,
+		uint64_t pkts_mask)
+{
+	struct rte_port_ring_writer_group *p = port;
+
+	for ( ; pkts_mask; ) {
+		uint32_t pkt_index = rte_ctz64(pkts_mask);
+		uint64_t pkt_mask = 1LLU << pkt_index;
+
+		rte_port_ring_writer_group_buffer(p, pkts[pkt_index]);
+		pkts_mask &= ~pkt_mask;
+	}
+
+	return 0;
+}
+
+static void
+rte_port_ring_writer_group_flush_all(struct rte_port_ring_writer_group *p)
+{
+	uint32_t n_pending = RTE_ALIGN_CEIL(p->n_rings, 64) / 64, i;
+
+	for (i = 0; i < n_pending; i++) {
+		uint64_t pending = p->pending[i];
+
+		for ( ; pending; pending &= pending - 1)
+			send_burst_group(p, i * 64 + rte_ctz64(pending));
+	}
+}
+
+static int
+rte_port_ring_writer_group_flush(void *port)
+{
+	struct rte_port_ring_writer_group *p = port;
+
+	/* Keep filling up the partial buffers until the flush period expires,
+	 * so that the rings get fewer and bigger bursts.
+	 */
+	if (p->flush_cycles) {
+		uint64_t tsc = rte_rdtsc();
+
+		if (tsc - p->flush_tsc < p->flush_cycles)
+			return 0;
+
+		p->flush_tsc = tsc;
+	}
+
+	rte_port_ring_writer_group_flush_all(p);
+
+	return 0;
+}
+
+static int
+rte_port_ring_writer_group_free(void *port)
+{
+	struct rte_port_ring_writer_group *p = port;
+
+	if (port == NULL) {
+		PORT_LOG(ERR, "%s: Port is NULL", __func__);
+		return -EINVAL;
+	}
+
+	rte_port_ring_writer_group_flush_all(p);
+
+	rte_free(p->pending);
+	rte_free(port);
+
+	return 0;
+}
+
+static int
+rte_port_ring_writer_group_stats_read(void *port,
+		struct rte_port_out_stats *stats, int clear)
+{
+	struct rte_port_ring_writer_group *p =
+		port;
+
+	if (stats != NULL)
+		memcpy(stats, &p->stats, sizeof(p->stats));
+
+	if (clear)
+		memset(&p->stats, 0, sizeof(p->stats));
+
+	return 0;
+}
+
 /*
  * Summary of port operations
  */
@@ -794,3 +1028,13 @@ struct rte_port_out_ops rte_port_ring_multi_writer_nodrop_ops = {
 	.f_flush = rte_port_ring_multi_writer_nodrop_flush,
 	.f_stats = rte_port_ring_writer_nodrop_stats_read,
 };
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_port_ring_writer_group_ops, 26.03)
+struct rte_port_out_ops rte_port_ring_writer_group_ops = {
+	.f_create = rte_port_ring_writer_group_create,
+	.f_free = rte_port_ring_writer_group_free,
+	.f_tx = rte_port_ring_writer_group_tx,
+	.f_tx_bulk = rte_port_ring_writer_group_tx_bulk,
+	.f_flush = rte_port_ring_writer_group_flush,
+	.f_stats = rte_port_ring_writer_group_stats_read,
+};
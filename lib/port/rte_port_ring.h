@@ -17,6 +17,9 @@
  *      input port built on top of pre-initialized multi consumers ring
  * ring_multi_writer:
  *      output port built on top of pre-initialized multi producers ring
+ * ring_writer_group:
+ *      output port built on top of a group of pre-initialized rings, with the
+ *      destination ring of each packet read from the packet meta-data
  */
 
 #include <stdint.h>
@@ -84,6 +87,33 @@ extern struct rte_port_out_ops rte_port_ring_multi_writer_ops;
 /** ring_multi_writer_nodrop port operations */
 extern struct rte_port_out_ops rte_port_ring_multi_writer_nodrop_ops;
 
+/** ring_writer_group port parameters */
+struct rte_port_ring_writer_group_params {
+	/** Underlying producer rings that have to be pre-initialized. Each ring
+		can be either single or multi producer. */
+	struct rte_ring **rings;
+
+	/** Number of rings */
+	uint32_t n_rings;
+
+	/** Burst size per ring. The packets buffered for a ring are written
+		to the ring as soon as there are this many of them. */
+	uint32_t tx_burst_sz;
+
+	/** Offset within the packet meta-data of the 32-bit index of the
+		destination ring. Packets with invalid index are dropped. */
+	uint32_t ring_id_offset;
+
+	/** Minimum number of CPU cycles between two flush operations of the
+		partially filled buffers. The flush requests issued sooner are
+		ignored, so the buffers keep filling up. When 0, every flush
+		request is served. */
+	uint64_t flush_cycles;
+};
+
+/** ring_writer_group port operations */
+extern struct rte_port_out_ops rte_port_ring_writer_group_ops;
+
 #ifdef __cplusplus
 }
 #endif
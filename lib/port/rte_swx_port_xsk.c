@@ -0,0 +1,550 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <linux/if_xdp.h>
+
+#include <eal_export.h>
+#include <rte_atomic.h>
+#include <rte_common.h>
+#include <rte_mbuf.h>
+#include <rte_hexdump.h>
+
+/* Fix the xsk.h dependency on asm/barrier.h. */
+#define smp_rmb() rte_rmb()
+#define smp_wmb() rte_wmb()
+
+#include <xdp/xsk.h>
+
+#include "rte_swx_port_xsk.h"
+
+#ifndef TRACE_LEVEL
+#define TRACE_LEVEL 0
+#endif
+
+#if TRACE_LEVEL
+#define TRACE(...) printf(__VA_ARGS__)
+#else
+#define TRACE(...)
+#endif
+
+#define XSK_FRAME_SIZE XSK_UMEM__DEFAULT_FRAME_SIZE
+
+/*
+ * AF_XDP socket with its private UMEM.
+ */
+struct xsk {
+	void *buffer;
+	struct xsk_umem *umem;
+	struct xsk_socket *socket;
+	struct xsk_ring_prod fq;
+	struct xsk_ring_cons cq;
+	struct xsk_ring_cons rx;
+	struct xsk_ring_prod tx;
+	uint32_t n_frames;
+	int fd;
+};
+
+static void
+xsk_close(struct xsk *x)
+{
+	if (x->socket)
+		xsk_socket__delete(x->socket);
+
+	if (x->umem)
+		xsk_umem__delete(x->umem);
+
+	free(x->buffer);
+}
+
+static int
+xsk_open(struct xsk *x, const char *ifname, uint32_t queue_id, uint32_t n_frames, int reader)
+{
+	struct xsk_umem_config umem_cfg = {
+		.fill_size = n_frames,
+		.comp_size = n_frames,
+		.frame_size = XSK_FRAME_SIZE,
+		.frame_headroom = 0,
+		.flags = 0,
+	};
+	struct xsk_socket_config socket_cfg = {
+		.rx_size = n_frames,
+		.tx_size = n_frames,
+		/* Only the reader needs the XDP program redirecting the queue to the socket. */
+		.libxdp_flags = reader ? 0 : XSK_LIBXDP_FLAGS__INHIBIT_PROG_LOAD,
+		.xdp_flags = 0,
+		.bind_flags = XDP_USE_NEED_WAKEUP,
+	};
+	uint64_t size = (uint64_t)n_frames * XSK_FRAME_SIZE;
+	int status;
+
+	memset(x, 0, sizeof(struct xsk));
+	x->n_frames = n_frames;
+
+	if (posix_memalign(&x->buffer, getpagesize(), size))
+		goto error;
+
+	status = xsk_umem__create(&x->umem, x->buffer, size, &x->fq, &x->cq, &umem_cfg);
+	if (status)
+		goto error;
+
+	status = xsk_socket__create(&x->socket,
+				    ifname,
+				    queue_id,
+				    x->umem,
+				    reader ? &x->rx : NULL,
+				    reader ? NULL : &x->tx,
+				    &socket_cfg);
+	if (status)
+		goto error;
+
+	x->fd = xsk_socket__fd(x->socket);
+
+	return 0;
+
+error:
+	xsk_close(x);
+	memset(x, 0, sizeof(struct xsk));
+	return -1;
+}
+
+/*
+ * XSK Reader
+ */
+struct reader {
+	struct {
+		uint32_t burst_size;
+		struct rte_mempool *mempool;
+	} params;
+
+	struct xsk xsk;
+	struct rte_swx_port_in_stats stats;
+	struct rte_mbuf **pkts;
+	uint32_t n_pkts;
+	uint32_t pos;
+};
+
+static void *
+reader_create(void *args)
+{
+	struct rte_swx_port_xsk_reader_params *conf = args;
+	struct reader *p;
+	uint32_t idx = 0, i;
+
+	/* Check input parameters. */
+	if (!conf ||
+	    !conf->ifname ||
+	    !conf->n_frames ||
+	    !rte_is_power_of_2(conf->n_frames) ||
+	    !conf->mempool ||
+	    !conf->burst_size ||
+	    conf->burst_size > conf->n_frames)
+		return NULL;
+
+	/* Memory allocation. */
+	p = calloc(1, sizeof(struct reader));
+	if (!p)
+		return NULL;
+
+	p->pkts = calloc(conf->burst_size, sizeof(struct rte_mbuf *));
+	if (!p->pkts) {
+		free(p);
+		return NULL;
+	}
+
+	if (xsk_open(&p->xsk, conf->ifname, conf->queue_id, conf->n_frames, 1)) {
+		free(p->pkts);
+		free(p);
+		return NULL;
+	}
+
+	/* Initialization. */
+	p->params.burst_size = conf->burst_size;
+	p->params.mempool = conf->mempool;
+
+	/* Hand all the UMEM frames to the kernel for packet reception. */
+	xsk_ring_prod__reserve(&p->xsk.fq, conf->n_frames, &idx);
+	for (i = 0; i < conf->n_frames; i++)
+		*xsk_ring_prod__fill_addr(&p->xsk.fq, idx + i) = (uint64_t)i * XSK_FRAME_SIZE;
+	xsk_ring_prod__submit(&p->xsk.fq, conf->n_frames);
+
+	return p;
+}
+
+static void
+reader_free(void *port)
+{
+	struct reader *p = port;
+	uint32_t i;
+
+	if (!p)
+		return;
+
+	for (i = p->pos; i < p->n_pkts; i++)
+		rte_pktmbuf_free(p->pkts[i]);
+
+	xsk_close(&p->xsk);
+	free(p->pkts);
+	free(p);
+}
+
+static int
+reader_pkt_rx(void *port, struct rte_swx_pkt *pkt)
+{
+	struct reader *p = port;
+	struct rte_mbuf *m;
+
+	if (p->n_pkts == p->pos) {
+		uint32_t n_rx, idx_rx = 0, idx_fq = 0, i, j;
+
+		if (rte_pktmbuf_alloc_bulk(p->params.mempool, p->pkts, p->params.burst_size) != 0)
+			return 0;
+
+		n_rx = xsk_ring_cons__peek(&p->xsk.rx, p->params.burst_size, &idx_rx);
+		if (!n_rx) {
+			rte_pktmbuf_free_bulk(p->pkts, p->params.burst_size);
+
+			if (xsk_ring_prod__needs_wakeup(&p->xsk.fq))
+				recvfrom(p->xsk.fd, NULL, 0, MSG_DONTWAIT, NULL, NULL);
+
+			p->n_pkts = 0;
+			p->pos = 0;
+			p->stats.n_empty++;
+			return 0;
+		}
+
+		/* The fill queue is sized to hold all the frames, so there is always room for the
+		 * frames received.
+		 */
+		xsk_ring_prod__reserve(&p->xsk.fq, n_rx, &idx_fq);
+
+		for (i = 0, j = 0; i < n_rx; i++) {
+			const struct xdp_desc *desc = xsk_ring_cons__rx_desc(&p->xsk.rx, idx_rx + i);
+			uint64_t addr = desc->addr;
+			uint32_t len = desc->len;
+
+			*xsk_ring_prod__fill_addr(&p->xsk.fq, idx_fq + i) =
+				addr & ~((uint64_t)XSK_FRAME_SIZE - 1);
+
+			m = p->pkts[j];
+			if (len > rte_pktmbuf_tailroom(m))
+				continue;
+
+			memcpy(rte_pktmbuf_mtod(m, void *), xsk_umem__get_data(p->xsk.buffer, addr), len);
+			m->data_len = len;
+			m->pkt_len = len;
+
+			p->stats.n_pkts++;
+			p->stats.n_bytes += len;
+			j++;
+		}
+
+		xsk_ring_prod__submit(&p->xsk.fq, n_rx);
+		xsk_ring_cons__release(&p->xsk.rx, n_rx);
+
+		for (i = j; i < p->params.burst_size; i++)
+			rte_pktmbuf_free(p->pkts[i]);
+
+		p->n_pkts = j;
+		p->pos = 0;
+
+		if (!p->n_pkts)
+			return 0;
+	}
+
+	m = p->pkts[p->pos++];
+	pkt->handle = m;
+	pkt->pkt = m->buf_addr;
+	pkt->offset = m->data_off;
+	pkt->length = m->pkt_len;
+
+	TRACE("[XSK %d] Pkt %d (%u bytes at offset %u)\n",
+		p->xsk.fd,
+		p->pos - 1,
+		pkt->length,
+		pkt->offset);
+
+	if (TRACE_LEVEL)
+		rte_hexdump(stdout, NULL,
+			&((uint8_t *)m->buf_addr)[m->data_off], m->data_len);
+
+	return 1;
+}
+
+static void
+reader_stats_read(void *port, struct rte_swx_port_in_stats *stats)
+{
+	struct reader *p = port;
+
+	memcpy(stats, &p->stats, sizeof(p->stats));
+}
+
+/*
+ * XSK Writer
+ */
+struct writer {
+	struct {
+		uint32_t burst_size;
+	} params;
+
+	struct xsk xsk;
+	struct rte_swx_port_out_stats stats;
+	struct rte_mbuf **pkts;
+	uint32_t n_pkts;
+
+	/* Stack of the UMEM frames not owned by the kernel. */
+	uint64_t *frames;
+	uint32_t n_frames_free;
+};
+
+static void *
+writer_create(void *args)
+{
+	struct rte_swx_port_xsk_writer_params *conf = args;
+	struct writer *p;
+	uint32_t i;
+
+	/* Check input parameters. */
+	if (!conf ||
+	    !conf->ifname ||
+	    !conf->n_frames ||
+	    !rte_is_power_of_2(conf->n_frames) ||
+	    !conf->burst_size ||
+	    conf->burst_size > conf->n_frames)
+		return NULL;
+
+	/* Memory allocation. */
+	p = calloc(1, sizeof(struct writer));
+	if (!p)
+		return NULL;
+
+	p->pkts = calloc(conf->burst_size, sizeof(struct rte_mbuf *));
+	p->frames = calloc(conf->n_frames, sizeof(uint64_t));
+	if (!p->pkts || !p->frames) {
+		free(p->frames);
+		free(p->pkts);
+		free(p);
+		return NULL;
+	}
+
+	if (xsk_open(&p->xsk, conf->ifname, conf->queue_id, conf->n_frames, 0)) {
+		free(p->frames);
+		free(p->pkts);
+		free(p);
+		return NULL;
+	}
+
+	/* Initialization. */
+	p->params.burst_size = conf->burst_size;
+
+	for (i = 0; i < conf->n_frames; i++)
+		p->frames[i] = (uint64_t)i * XSK_FRAME_SIZE;
+	p->n_frames_free = conf->n_frames;
+
+	return p;
+}
+
+static void
+__writer_flush(struct writer *p)
+{
+	uint32_t n_cq, n_tx_max, n_tx, idx_cq = 0, idx_tx = 0, i;
+
+	/* Reclaim the frames of the packets already transmitted. */
+	n_cq = xsk_ring_cons__peek(&p->xsk.cq, p->xsk.n_frames, &idx_cq);
+	for (i = 0; i < n_cq; i++)
+		p->frames[p->n_frames_free++] = *xsk_ring_cons__comp_addr(&p->xsk.cq, idx_cq + i);
+	xsk_ring_cons__release(&p->xsk.cq, n_cq);
+
+	/* Packet TX. */
+	for (i = 0, n_tx_max = 0; i < p->n_pkts; i++)
+		if (rte_pktmbuf_data_len(p->pkts[i]) <= XSK_FRAME_SIZE)
+			n_tx_max++;
+
+	n_tx_max = RTE_MIN(n_tx_max, p->n_frames_free);
+	if (n_tx_max)
+		n_tx_max = xsk_ring_prod__reserve(&p->xsk.tx, n_tx_max, &idx_tx);
+	n_tx = n_tx_max;
+
+	for (i = 0; i < p->n_pkts; i++) {
+		struct rte_mbuf *m = p->pkts[i];
+		uint32_t len = rte_pktmbuf_data_len(m);
+
+		if (n_tx && len <= XSK_FRAME_SIZE) {
+			struct xdp_desc *desc = xsk_ring_prod__tx_desc(&p->xsk.tx, idx_tx++);
+			uint64_t addr = p->frames[--p->n_frames_free];
+
+			memcpy(xsk_umem__get_data(p->xsk.buffer, addr),
+			       rte_pktmbuf_mtod(m, void *),
+			       len);
+			desc->addr = addr;
+			desc->len = len;
+			n_tx--;
+		} else {
+			p->stats.n_pkts--;
+			p->stats.n_bytes -= m->pkt_len;
+			p->stats.n_pkts_drop++;
+			p->stats.n_bytes_drop += m->pkt_len;
+		}
+
+		rte_pktmbuf_free(m);
+	}
+
+	if (n_tx_max) {
+		xsk_ring_prod__submit(&p->xsk.tx, n_tx_max);
+
+		if (xsk_ring_prod__needs_wakeup(&p->xsk.tx))
+			sendto(p->xsk.fd, NULL, 0, MSG_DONTWAIT, NULL, 0);
+	}
+
+	TRACE("[XSK %d] %u packets out\n",
+		p->xsk.fd,
+		p->n_pkts);
+
+	p->n_pkts = 0;
+}
+
+static void
+writer_pkt_tx(void *port, struct rte_swx_pkt *pkt)
+{
+	struct writer *p = port;
+	struct rte_mbuf *m = pkt->handle;
+
+	TRACE("[XSK %d] Pkt %u (%u bytes at offset %u)\n",
+		p->xsk.fd,
+		p->n_pkts - 1,
+		pkt->length,
+		pkt->offset);
+
+	if (TRACE_LEVEL)
+		rte_hexdump(stdout, NULL, &pkt->pkt[pkt->offset], pkt->length);
+
+	m->data_len = (uint16_t)(pkt->length + m->data_len - m->pkt_len);
+	m->pkt_len = pkt->length;
+	m->data_off = (uint16_t)pkt->offset;
+
+	p->stats.n_pkts++;
+	p->stats.n_bytes += pkt->length;
+
+	p->pkts[p->n_pkts++] = m;
+	if (p->n_pkts == p->params.burst_size)
+		__writer_flush(p);
+}
+
+static void
+writer_pkt_fast_clone_tx(void *port, struct rte_swx_pkt *pkt)
+{
+	struct writer *p = port;
+	struct rte_mbuf *m = pkt->handle;
+
+	TRACE("[XSK %d] Pkt %u (%u bytes at offset %u) (fast clone)\n",
+		p->xsk.fd,
+		p->n_pkts - 1,
+		pkt->length,
+		pkt->offset);
+	if (TRACE_LEVEL)
+		rte_hexdump(stdout, NULL, &pkt->pkt[pkt->offset], pkt->length);
+
+	m->data_len = (uint16_t)(pkt->length + m->data_len - m->pkt_len);
+	m->pkt_len = pkt->length;
+	m->data_off = (uint16_t)pkt->offset;
+	rte_pktmbuf_refcnt_update(m, 1);
+
+	p->stats.n_pkts++;
+	p->stats.n_bytes += pkt->length;
+	p->stats.n_pkts_clone++;
+
+	p->pkts[p->n_pkts++] = m;
+	if (p->n_pkts == p->params.burst_size)
+		__writer_flush(p);
+}
+
+static void
+writer_pkt_clone_tx(void *port, struct rte_swx_pkt *pkt, uint32_t truncation_length)
+{
+	struct writer *p = port;
+	struct rte_mbuf *m = pkt->handle, *m_clone;
+
+	TRACE("[XSK %d] Pkt %u (%u bytes at offset %u) (clone)\n",
+		p->xsk.fd,
+		p->n_pkts - 1,
+		pkt->length,
+		pkt->offset);
+	if (TRACE_LEVEL)
+		rte_hexdump(stdout, NULL, &pkt->pkt[pkt->offset], pkt->length);
+
+	m->data_len = (uint16_t)(pkt->length + m->data_len - m->pkt_len);
+	m->pkt_len = pkt->length;
+	m->data_off = (uint16_t)pkt->offset;
+
+	m_clone = rte_pktmbuf_copy(m, m->pool, 0, truncation_length);
+	if (!m_clone) {
+		p->stats.n_pkts_clone_err++;
+		return;
+	}
+
+	p->stats.n_pkts++;
+	p->stats.n_bytes += m_clone->pkt_len;
+	p->stats.n_pkts_clone++;
+
+	p->pkts[p->n_pkts++] = m_clone;
+	if (p->n_pkts == p->params.burst_size)
+		__writer_flush(p);
+}
+
+static void
+writer_flush(void *port)
+{
+	struct writer *p = port;
+
+	if (p->n_pkts)
+		__writer_flush(p);
+}
+
+static void
+writer_free(void *port)
+{
+	struct writer *p = port;
+
+	if (!p)
+		return;
+
+	writer_flush(p);
+	xsk_close(&p->xsk);
+	free(p->frames);
+	free(p->pkts);
+	free(p);
+}
+
+static void
+writer_stats_read(void *port, struct rte_swx_port_out_stats *stats)
+{
+	struct writer *p = port;
+
+	memcpy(stats, &p->stats, sizeof(p->stats));
+}
+
+/*
+ * Summary of port operations
+ */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_swx_port_xsk_reader_ops, 26.03)
+struct rte_swx_port_in_ops rte_swx_port_xsk_reader_ops = {
+	.create = reader_create,
+	.free = reader_free,
+	.pkt_rx = reader_pkt_rx,
+	.stats_read = reader_stats_read,
+};
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_swx_port_xsk_writer_ops, 26.03)
+struct rte_swx_port_out_ops rte_swx_port_xsk_writer_ops = {
+	.create = writer_create,
+	.free = writer_free,
+	.pkt_tx = writer_pkt_tx,
+	.pkt_fast_clone_tx = writer_pkt_fast_clone_tx,
+	.pkt_clone_tx = writer_pkt_clone_tx,
+	.flush = writer_flush,
+	.stats_read = writer_stats_read,
+};
@@ -0,0 +1,71 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef __INCLUDE_RTE_SWX_PORT_XSK_H__
+#define __INCLUDE_RTE_SWX_PORT_XSK_H__
+
+/**
+ * @file
+ * RTE SWX AF_XDP Socket (XSK) Input and Output Ports
+ *
+ * These ports read and write packets directly from/to a kernel network
+ * interface queue through an AF_XDP socket, without an ethdev in between.
+ * Each port owns its socket and its UMEM buffer area. The reader and the
+ * writer of the same interface must be bound to different queues.
+ *
+ * These ports are only available when DPDK is built with libxdp and libbpf.
+ */
+
+#include <stdint.h>
+
+#include "rte_swx_port.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** xsk_reader port parameters */
+struct rte_swx_port_xsk_reader_params {
+	/** Name of the kernel network interface. */
+	const char *ifname;
+
+	/** Interface queue ID. */
+	uint32_t queue_id;
+
+	/** Number of UMEM frames. Must be a power of 2. */
+	uint32_t n_frames;
+
+	/** Pre-initialized buffer pool */
+	struct rte_mempool *mempool;
+
+	/** RX burst size */
+	uint32_t burst_size;
+};
+
+/** xsk_reader port operations */
+extern struct rte_swx_port_in_ops rte_swx_port_xsk_reader_ops;
+
+/** xsk_writer port parameters */
+struct rte_swx_port_xsk_writer_params {
+	/** Name of the kernel network interface. */
+	const char *ifname;
+
+	/** Interface queue ID. */
+	uint32_t queue_id;
+
+	/** Number of UMEM frames. Must be a power of 2. */
+	uint32_t n_frames;
+
+	/** TX burst size */
+	uint32_t burst_size;
+};
+
+/** xsk_writer port operations */
+extern struct rte_swx_port_out_ops rte_swx_port_xsk_writer_ops;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_RTE_SWX_PORT_XSK_H__ */
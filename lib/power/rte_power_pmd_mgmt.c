@@ -14,12 +14,21 @@
 #include <rte_power_intrinsics.h>
 
 #include "rte_power_pmd_mgmt.h"
+#include "rte_power_qos.h"
 #include "power_common.h"
 
+/* weight of a new inter-arrival time in the average, as a power of 2 */
+#define PREDICT_EWMA_SHIFT	3
+/* traffic is considered stopped after that many average inter-arrival times */
+#define PREDICT_STOP_GAPS	4
+/* predicted idle time above which the frequency is scaled down */
+#define PREDICT_SCALE_IDLE_US	1000
+
 unsigned int emptypoll_max;
 unsigned int pause_duration;
 unsigned int scale_freq_min[RTE_MAX_LCORE];
 unsigned int scale_freq_max[RTE_MAX_LCORE];
+static unsigned int wake_latency[RTE_MAX_LCORE];
 
 /* store some internal state */
 static struct pmd_conf_data {
@@ -54,6 +63,10 @@ struct queue_list_entry {
 	union queue queue;
 	uint64_t n_empty_polls;
 	uint64_t n_sleeps;
+	uint64_t last_rx_tsc;
+	/**< Time of the last non-empty poll, in predict mode */
+	uint64_t ewma_gap;
+	/**< Average time between non-empty polls, in predict mode */
 	const struct rte_eth_rxtx_callback *cb;
 };
 
@@ -70,6 +83,14 @@ struct pmd_core_cfg {
 	/**< Number of queues ready to enter power optimized state */
 	uint64_t sleep_target;
 	/**< Prevent a queue from triggering sleep multiple times */
+	bool predict_monitor;
+	/**< All queues are monitored in predict mode, rather than paused */
+	bool predict_scale;
+	/**< Frequency scaling is available in predict mode */
+	bool freq_scaled;
+	/**< Frequency was scaled down in predict mode */
+	int qos_latency;
+	/**< Resume latency to restore when disabling predict mode, if >= 0 */
 };
 static RTE_LCORE_VAR_HANDLE(struct pmd_core_cfg, lcore_cfgs);
 
@@ -224,15 +245,8 @@ queue_reset(struct pmd_core_cfg *cfg, struct queue_list_entry *qcfg)
 }
 
 static inline bool
-queue_can_sleep(struct pmd_core_cfg *cfg, struct queue_list_entry *qcfg)
+queue_mark_ready(struct pmd_core_cfg *cfg, struct queue_list_entry *qcfg)
 {
-	/* this function is called - that means we have an empty poll */
-	qcfg->n_empty_polls++;
-
-	/* if we haven't reached threshold for empty polls, we can't sleep */
-	if (qcfg->n_empty_polls <= emptypoll_max)
-		return false;
-
 	/*
 	 * we've reached a point where we are able to sleep, but we still need
 	 * to check if this queue has already been marked for sleeping.
@@ -247,6 +261,19 @@ queue_can_sleep(struct pmd_core_cfg *cfg, struct queue_list_entry *qcfg)
 	return true;
 }
 
+static inline bool
+queue_can_sleep(struct pmd_core_cfg *cfg, struct queue_list_entry *qcfg)
+{
+	/* this function is called - that means we have an empty poll */
+	qcfg->n_empty_polls++;
+
+	/* if we haven't reached threshold for empty polls, we can't sleep */
+	if (qcfg->n_empty_polls <= emptypoll_max)
+		return false;
+
+	return queue_mark_ready(cfg, qcfg);
+}
+
 static inline bool
 lcore_can_sleep(struct pmd_core_cfg *cfg)
 {
@@ -399,6 +426,121 @@ clb_scale_freq(uint16_t port_id __rte_unused, uint16_t qidx __rte_unused,
 	return nb_rx;
 }
 
+static inline void
+queue_predict_update(struct queue_list_entry *qcfg, const uint64_t now)
+{
+	const uint64_t gap = now - qcfg->last_rx_tsc;
+
+	/* exponentially weighted moving average of the inter-arrival time */
+	if (qcfg->last_rx_tsc != 0)
+		qcfg->ewma_gap = qcfg->ewma_gap == 0 ? gap :
+			qcfg->ewma_gap - (qcfg->ewma_gap >> PREDICT_EWMA_SHIFT) +
+			(gap >> PREDICT_EWMA_SHIFT);
+	qcfg->last_rx_tsc = now;
+}
+
+/* predicted time until traffic arrives on any queue, UINT64_MAX if unknown */
+static inline uint64_t
+lcore_predict_idle(const struct pmd_core_cfg *cfg, const uint64_t now)
+{
+	const struct queue_list_entry *qle;
+	uint64_t elapsed, idle = UINT64_MAX;
+
+	TAILQ_FOREACH(qle, &cfg->head, next) {
+		/* no traffic seen yet */
+		if (qle->ewma_gap == 0)
+			continue;
+
+		elapsed = now - qle->last_rx_tsc;
+		/* traffic late for too long is considered stopped */
+		if (elapsed >= PREDICT_STOP_GAPS * qle->ewma_gap)
+			continue;
+		/* traffic is expected at any time */
+		if (elapsed >= qle->ewma_gap)
+			return 0;
+
+		idle = RTE_MIN(idle, qle->ewma_gap - elapsed);
+	}
+	return idle;
+}
+
+static inline void
+predict_pause(const uint64_t duration)
+{
+	/* use tpause if we have it */
+	if (global_data.intrinsics_support.power_pause) {
+		rte_power_pause(rte_rdtsc() + duration);
+	} else {
+		const uint64_t n = global_data.pause_per_us * duration /
+			global_data.tsc_per_us;
+		uint64_t i;
+
+		for (i = 0; i < n; i++)
+			rte_pause();
+	}
+}
+
+static uint16_t
+clb_predict(uint16_t port_id __rte_unused, uint16_t qidx __rte_unused,
+		struct rte_mbuf **pkts __rte_unused, uint16_t nb_rx,
+		uint16_t max_pkts __rte_unused, void *arg)
+{
+	struct queue_list_entry *queue_conf = arg;
+	struct pmd_core_cfg *lcore_conf = RTE_LCORE_VAR(lcore_cfgs);
+	const unsigned int lcore_id = rte_lcore_id();
+	const uint64_t now = rte_rdtsc();
+	uint64_t idle, latency;
+
+	if (likely(nb_rx != 0)) {
+		queue_predict_update(queue_conf, now);
+		queue_reset(lcore_conf, queue_conf);
+
+		/* scale up freq immediately */
+		if (unlikely(lcore_conf->freq_scaled)) {
+			rte_power_freq_max(lcore_id);
+			lcore_conf->freq_scaled = false;
+		}
+		return nb_rx;
+	}
+
+	/* the prediction replaces the empty poll threshold */
+	queue_conf->n_empty_polls++;
+	queue_mark_ready(lcore_conf, queue_conf);
+	if (!lcore_can_sleep(lcore_conf))
+		return nb_rx;
+
+	/*
+	 * Sleeping is only worth it if the traffic is not expected before
+	 * the wake latency target, otherwise the burst would be delayed.
+	 */
+	latency = global_data.tsc_per_us * (wake_latency[lcore_id] != 0 ?
+		wake_latency[lcore_id] : rte_power_pmd_mgmt_get_pause_duration());
+	idle = lcore_predict_idle(lcore_conf, now);
+	if (idle < latency)
+		return nb_rx;
+
+	if (lcore_conf->predict_scale && !lcore_conf->freq_scaled &&
+			idle >= global_data.tsc_per_us * PREDICT_SCALE_IDLE_US) {
+		rte_power_freq_min(lcore_id);
+		lcore_conf->freq_scaled = true;
+	}
+
+	if (lcore_conf->predict_monitor) {
+		struct rte_power_monitor_cond pmc[lcore_conf->n_queues];
+
+		/* the monitor wakes up on traffic, the latency is the C-state exit */
+		if (get_monitor_addresses(lcore_conf, pmc,
+				lcore_conf->n_queues) == 0)
+			rte_power_monitor_multi(pmc, lcore_conf->n_queues,
+				UINT64_MAX);
+	} else {
+		/* the pause is not interrupted by traffic, bound it to the target */
+		predict_pause(latency);
+	}
+
+	return nb_rx;
+}
+
 static int
 queue_stopped(const uint16_t port_id, const uint16_t queue_id)
 {
@@ -490,6 +632,36 @@ check_monitor(struct pmd_core_cfg *cfg, const union queue *qdata)
 	return 0;
 }
 
+static void
+check_predict(struct pmd_core_cfg *cfg, unsigned int lcore, const union queue *qdata)
+{
+	struct rte_power_monitor_cond dummy;
+	int ret;
+
+	/* monitor the queues if all of them support it, pause otherwise */
+	cfg->predict_monitor = (cfg->n_queues == 0 || cfg->predict_monitor) &&
+		global_data.intrinsics_support.power_monitor_multi &&
+		rte_eth_get_monitor_addr(qdata->portid, qdata->qid,
+			&dummy) != -ENOTSUP;
+
+	/* the lcore setup is done when enabling the first queue */
+	if (cfg->pwr_mgmt_state != PMD_MGMT_DISABLED)
+		return;
+
+	cfg->predict_scale = check_scale(lcore) == 0;
+	cfg->freq_scaled = false;
+
+	/* bound the C-state selected by the kernel to the wake latency target */
+	cfg->qos_latency = -1;
+	if (wake_latency[lcore] == 0)
+		return;
+	ret = rte_power_qos_get_cpu_resume_latency(lcore);
+	if (ret < 0)
+		return;
+	if (rte_power_qos_set_cpu_resume_latency(lcore, wake_latency[lcore]) == 0)
+		cfg->qos_latency = ret;
+}
+
 static inline rte_rx_callback_fn
 get_monitor_callback(void)
 {
@@ -583,6 +755,13 @@ rte_power_ethdev_pmgmt_queue_enable(unsigned int lcore_id, uint16_t port_id,
 
 		clb = clb_pause;
 		break;
+	case RTE_POWER_MGMT_TYPE_PREDICT:
+		if (global_data.tsc_per_us == 0)
+			calc_tsc();
+
+		check_predict(lcore_cfg, lcore_id, &qdata);
+		clb = clb_predict;
+		break;
 	default:
 		POWER_LOG(DEBUG, "Invalid power management type");
 		ret = -EINVAL;
@@ -679,6 +858,18 @@ rte_power_ethdev_pmgmt_queue_disable(unsigned int lcore_id,
 			rte_power_exit(lcore_id);
 		}
 		break;
+	case RTE_POWER_MGMT_TYPE_PREDICT:
+		rte_eth_remove_rx_callback(port_id, queue_id, queue_cfg->cb);
+		if (lcore_cfg->pwr_mgmt_state != PMD_MGMT_DISABLED)
+			break;
+		if (lcore_cfg->predict_scale) {
+			rte_power_freq_max(lcore_id);
+			rte_power_exit(lcore_id);
+		}
+		if (lcore_cfg->qos_latency >= 0)
+			rte_power_qos_set_cpu_resume_latency(lcore_id,
+				lcore_cfg->qos_latency);
+		break;
 	}
 	/*
 	 * the API doc mandates that the user stops all processing on affected
@@ -797,6 +988,36 @@ rte_power_pmd_mgmt_get_scaling_freq_max(unsigned int lcore)
 	return scale_freq_max[lcore];
 }
 
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_power_pmd_mgmt_set_wake_latency, 26.03)
+int
+rte_power_pmd_mgmt_set_wake_latency(unsigned int lcore, unsigned int latency)
+{
+	if (lcore >= RTE_MAX_LCORE) {
+		POWER_LOG(ERR, "Invalid lcore ID: %u", lcore);
+		return -EINVAL;
+	}
+	if (latency > RTE_POWER_QOS_RESUME_LATENCY_NO_CONSTRAINT) {
+		POWER_LOG(ERR, "Invalid wake latency: %u", latency);
+		return -EINVAL;
+	}
+
+	wake_latency[lcore] = latency;
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_power_pmd_mgmt_get_wake_latency, 26.03)
+int
+rte_power_pmd_mgmt_get_wake_latency(unsigned int lcore)
+{
+	if (lcore >= RTE_MAX_LCORE) {
+		POWER_LOG(ERR, "Invalid lcore ID: %u", lcore);
+		return -EINVAL;
+	}
+
+	return wake_latency[lcore];
+}
+
 RTE_INIT(rte_power_ethdev_pmgmt_init) {
 	int i;
 
@@ -12,6 +12,7 @@
 
 #include <stdint.h>
 
+#include <rte_compat.h>
 #include <rte_log.h>
 #include <rte_power_cpufreq.h>
 
@@ -29,6 +30,13 @@ enum rte_power_pmd_mgmt_type {
 	RTE_POWER_MGMT_TYPE_PAUSE,
 	/** Use frequency scaling when traffic is low */
 	RTE_POWER_MGMT_TYPE_SCALE,
+	/**
+	 * Predict the arrival of traffic from the average inter-arrival time
+	 * of each queue, to monitor or pause only when the traffic is not
+	 * expected before the wake latency target.
+	 * Frequency scaling is used when the traffic is sparse.
+	 */
+	RTE_POWER_MGMT_TYPE_PREDICT,
 };
 
 /**
@@ -185,6 +193,48 @@ rte_power_pmd_mgmt_get_scaling_freq_min(unsigned int lcore);
 int
 rte_power_pmd_mgmt_get_scaling_freq_max(unsigned int lcore);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Set the wake latency target used in predict mode.
+ * The lcore does not sleep when traffic is expected within this time,
+ * and does not pause for longer when it cannot be woken up by traffic.
+ * When enabling the first queue of the lcore, the target is also set as
+ * its PM QoS resume latency, limiting the idle states selected by the kernel,
+ * and restored when disabling the last queue.
+ *
+ * @param lcore
+ *   The ID of the lcore to set the wake latency target for.
+ * @param latency
+ *   The wake latency target, in microseconds.
+ *   If 'latency' is 0, it is considered 'not set': the pause duration
+ *   is used and the PM QoS resume latency is left unchanged.
+ * @return
+ *   0 on success
+ *   <0 on error
+ */
+__rte_experimental
+int
+rte_power_pmd_mgmt_set_wake_latency(unsigned int lcore, unsigned int latency);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the wake latency target used in predict mode.
+ *
+ * @param lcore
+ *   The ID of the lcore to get the wake latency target for.
+ * @return
+ *   0 if no value has been configured via the 'set' API.
+ *   >0 the wake latency target, in microseconds.
+ *   <0 on error
+ */
+__rte_experimental
+int
+rte_power_pmd_mgmt_get_wake_latency(unsigned int lcore);
+
 #ifdef __cplusplus
 }
 #endif
@@ -253,6 +253,88 @@ unsigned int rte_power_uncore_get_num_pkgs(void);
  */
 unsigned int rte_power_uncore_get_num_dies(unsigned int pkg);
 
+/**
+ * Uncore frequency auto tuning configuration.
+ */
+struct rte_power_uncore_auto_conf {
+	/** Tuning period in milliseconds, 0 for the default of 100 ms. */
+	uint32_t period_ms;
+	/**
+	 * LLC misses per thousand cycles of the lcores of a package
+	 * from which the datapath is considered memory-bound,
+	 * raising the uncore frequency of the package to its maximum.
+	 * 0 for the defaults of 5 and 1 for miss_low.
+	 */
+	uint32_t miss_high;
+	/**
+	 * LLC misses per thousand cycles below which
+	 * the uncore frequency is lowered one step per period.
+	 */
+	uint32_t miss_low;
+	/** PMU event counting LLC misses, NULL for the architecture default. */
+	const char *miss_event;
+	/** PMU event counting cycles, NULL for the architecture default. */
+	const char *cycle_event;
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Start tuning the uncore frequency from the LLC misses of the lcores,
+ * read with the PMU library, as an approximation of their memory bandwidth.
+ * The uncore frequency of the dies of a package is raised
+ * when its lcores are memory-bound, and lowered otherwise.
+ * The package of an lcore is its socket ID.
+ *
+ * The tuning runs periodically from an EAL alarm,
+ * on the dies initialized with rte_power_uncore_init().
+ * The application must not set their frequency while the tuning runs.
+ * The datapath lcores must call rte_power_uncore_auto_update()
+ * to publish their counters.
+ *
+ * This function should NOT be called in the fast path.
+ *
+ * @param conf
+ *  Tuning configuration.
+ *
+ * @return
+ *  - 0 on success.
+ *  - -EINVAL if the uncore environment is not set or the configuration is invalid.
+ *  - -EBUSY if the tuning is already started.
+ *  - -ENOTSUP if the PMU library is not available.
+ *  - Other negative values if the PMU events cannot be read.
+ */
+__rte_experimental
+int rte_power_uncore_auto_start(const struct rte_power_uncore_auto_conf *conf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Stop tuning the uncore frequency.
+ * The frequencies are left as last set by the tuning.
+ *
+ * This function should NOT be called in the fast path.
+ *
+ * @return
+ *  - 0 on success.
+ *  - Negative on error.
+ */
+__rte_experimental
+int rte_power_uncore_auto_stop(void);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Publish the PMU counters of the calling lcore for the uncore tuning.
+ * It should be called by the datapath lcores at least once per tuning period,
+ * e.g. once per loop iteration, and does nothing if the tuning is stopped.
+ */
+__rte_experimental
+void rte_power_uncore_auto_update(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,250 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+
+#include <eal_export.h>
+#include <rte_alarm.h>
+#include <rte_common.h>
+#include <rte_lcore.h>
+#include <rte_stdatomic.h>
+
+#include "power_common.h"
+#include "rte_power_uncore.h"
+
+#ifdef RTE_LIB_PMU
+
+#include <rte_pmu.h>
+
+#define UNCORE_AUTO_PERIOD_MS	100
+#define UNCORE_AUTO_MISS_HIGH	5
+#define UNCORE_AUTO_MISS_LOW	1
+
+#ifdef RTE_PMU_EVENT_CYCLES
+#define UNCORE_AUTO_MISS_EVENT	RTE_PMU_EVENT_LLC_MISSES
+#define UNCORE_AUTO_CYCLE_EVENT	RTE_PMU_EVENT_CYCLES
+#else
+#define UNCORE_AUTO_MISS_EVENT	"cache-misses"
+#define UNCORE_AUTO_CYCLE_EVENT	"cpu-cycles"
+#endif
+
+/* counters published by a datapath lcore */
+struct __rte_cache_aligned uncore_auto_lcore {
+	RTE_ATOMIC(uint64_t) misses;
+	RTE_ATOMIC(uint64_t) cycles;
+	/* values at the previous period, used by the tuning only */
+	uint64_t prev_misses;
+	uint64_t prev_cycles;
+};
+
+static struct uncore_auto {
+	struct uncore_auto_lcore lcores[RTE_MAX_LCORE];
+	struct rte_power_uncore_auto_conf conf;
+	unsigned int miss_idx;
+	unsigned int cycle_idx;
+	RTE_ATOMIC(bool) running;
+} uncore_auto;
+
+static void
+uncore_auto_set(unsigned int pkg, unsigned int die, uint64_t miss_rate)
+{
+	const struct rte_power_uncore_auto_conf *conf = &uncore_auto.conf;
+	uint32_t idx;
+	int num;
+
+	/* dies not initialized by the application are left alone */
+	idx = rte_power_get_uncore_freq(pkg, die);
+	num = rte_power_uncore_get_num_freqs(pkg, die);
+	if (idx == (uint32_t)RTE_POWER_INVALID_FREQ_INDEX || num <= 0)
+		return;
+
+	/* memory-bound, raise at once; lower one step at a time otherwise */
+	if (miss_rate >= conf->miss_high)
+		rte_power_uncore_freq_max(pkg, die);
+	else if (miss_rate < conf->miss_low && idx + 1 < (uint32_t)num)
+		rte_power_set_uncore_freq(pkg, die, idx + 1);
+}
+
+static void
+uncore_auto_tune(void *arg __rte_unused)
+{
+	uint64_t misses[RTE_MAX_NUMA_NODES] = {0};
+	uint64_t cycles[RTE_MAX_NUMA_NODES] = {0};
+	unsigned int lcore_id, pkg, die, num_dies;
+
+	if (!rte_atomic_load_explicit(&uncore_auto.running,
+			rte_memory_order_acquire))
+		return;
+
+	RTE_LCORE_FOREACH(lcore_id) {
+		struct uncore_auto_lcore *l = &uncore_auto.lcores[lcore_id];
+		uint64_t m, c;
+
+		m = rte_atomic_load_explicit(&l->misses, rte_memory_order_relaxed);
+		c = rte_atomic_load_explicit(&l->cycles, rte_memory_order_relaxed);
+		pkg = rte_lcore_to_socket_id(lcore_id);
+
+		/* the first values of an lcore are only a reference */
+		if (pkg < RTE_MAX_NUMA_NODES && l->prev_cycles != 0 &&
+				c > l->prev_cycles) {
+			misses[pkg] += m - l->prev_misses;
+			cycles[pkg] += c - l->prev_cycles;
+		}
+		l->prev_misses = m;
+		l->prev_cycles = c;
+	}
+
+	/* LLC misses per thousand cycles of the lcores of each package */
+	for (pkg = 0; pkg < RTE_MAX_NUMA_NODES; pkg++) {
+		if (cycles[pkg] == 0)
+			continue;
+
+		num_dies = rte_power_uncore_get_num_dies(pkg);
+		for (die = 0; die < num_dies; die++)
+			uncore_auto_set(pkg, die, misses[pkg] * 1000 / cycles[pkg]);
+	}
+
+	if (rte_eal_alarm_set(uncore_auto.conf.period_ms * 1000ULL,
+			uncore_auto_tune, NULL) != 0) {
+		POWER_LOG(ERR, "Failed to schedule uncore auto tuning");
+		rte_atomic_store_explicit(&uncore_auto.running, false,
+			rte_memory_order_release);
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_power_uncore_auto_start, 26.03)
+int
+rte_power_uncore_auto_start(const struct rte_power_uncore_auto_conf *conf)
+{
+	const char *event;
+	unsigned int i;
+	int ret;
+
+	if (conf == NULL || conf->miss_low > conf->miss_high)
+		return -EINVAL;
+
+	if (rte_power_get_uncore_env() == RTE_UNCORE_PM_ENV_NOT_SET) {
+		POWER_LOG(ERR, "Uncore Env has not been set");
+		return -EINVAL;
+	}
+
+	if (rte_atomic_load_explicit(&uncore_auto.running,
+			rte_memory_order_acquire))
+		return -EBUSY;
+
+	uncore_auto.conf = *conf;
+	if (uncore_auto.conf.period_ms == 0)
+		uncore_auto.conf.period_ms = UNCORE_AUTO_PERIOD_MS;
+	if (uncore_auto.conf.miss_high == 0) {
+		uncore_auto.conf.miss_high = UNCORE_AUTO_MISS_HIGH;
+		uncore_auto.conf.miss_low = UNCORE_AUTO_MISS_LOW;
+	}
+
+	ret = rte_pmu_init();
+	if (ret < 0) {
+		POWER_LOG(ERR, "Failed to initialize PMU: %d", ret);
+		return ret;
+	}
+
+	event = conf->miss_event != NULL ? conf->miss_event : UNCORE_AUTO_MISS_EVENT;
+	ret = rte_pmu_add_event(event);
+	if (ret < 0) {
+		POWER_LOG(ERR, "Failed to add PMU event %s", event);
+		goto fini;
+	}
+	uncore_auto.miss_idx = ret;
+
+	event = conf->cycle_event != NULL ? conf->cycle_event : UNCORE_AUTO_CYCLE_EVENT;
+	ret = rte_pmu_add_event(event);
+	if (ret < 0) {
+		POWER_LOG(ERR, "Failed to add PMU event %s", event);
+		goto fini;
+	}
+	uncore_auto.cycle_idx = ret;
+
+	for (i = 0; i < RTE_MAX_LCORE; i++) {
+		uncore_auto.lcores[i].prev_misses = 0;
+		uncore_auto.lcores[i].prev_cycles = 0;
+	}
+
+	rte_atomic_store_explicit(&uncore_auto.running, true,
+		rte_memory_order_release);
+	ret = rte_eal_alarm_set(uncore_auto.conf.period_ms * 1000ULL,
+		uncore_auto_tune, NULL);
+	if (ret != 0) {
+		rte_atomic_store_explicit(&uncore_auto.running, false,
+			rte_memory_order_release);
+		goto fini;
+	}
+
+	return 0;
+
+fini:
+	rte_pmu_fini();
+	return ret;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_power_uncore_auto_stop, 26.03)
+int
+rte_power_uncore_auto_stop(void)
+{
+	if (!rte_atomic_load_explicit(&uncore_auto.running,
+			rte_memory_order_acquire))
+		return -EINVAL;
+
+	rte_atomic_store_explicit(&uncore_auto.running, false,
+		rte_memory_order_release);
+	/* waits for a running tuning to complete */
+	rte_eal_alarm_cancel(uncore_auto_tune, NULL);
+	rte_pmu_fini();
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_power_uncore_auto_update, 26.03)
+void
+rte_power_uncore_auto_update(void)
+{
+	unsigned int lcore_id = rte_lcore_id();
+	struct uncore_auto_lcore *l;
+
+	if (!rte_atomic_load_explicit(&uncore_auto.running,
+			rte_memory_order_relaxed) || lcore_id >= RTE_MAX_LCORE)
+		return;
+
+	l = &uncore_auto.lcores[lcore_id];
+	rte_atomic_store_explicit(&l->misses, rte_pmu_read(uncore_auto.miss_idx),
+		rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&l->cycles, rte_pmu_read(uncore_auto.cycle_idx),
+		rte_memory_order_relaxed);
+}
+
+#else /* !RTE_LIB_PMU */
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_power_uncore_auto_start, 26.03)
+int
+rte_power_uncore_auto_start(const struct rte_power_uncore_auto_conf *conf)
+{
+	RTE_SET_USED(conf);
+
+	POWER_LOG(ERR, "Uncore auto tuning requires lib/pmu");
+
+	return -ENOTSUP;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_power_uncore_auto_stop, 26.03)
+int
+rte_power_uncore_auto_stop(void)
+{
+	return -ENOTSUP;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_power_uncore_auto_update, 26.03)
+void
+rte_power_uncore_auto_update(void)
+{
+}
+
+#endif /* RTE_LIB_PMU */
@@ -44,6 +44,14 @@ struct rte_rcu_qsbr_dq {
 	 *   pointer to the data structure to which the resource to free
 	 *   belongs.
 	 */
+	uint32_t flags;
+	/**< Flags given when creating the queue. */
+	uint32_t service_id;
+	/**< Id of the reclaim service, if any. */
+	bool service;
+	/**< Set if a reclaim service is registered. */
+	struct rte_ring *lr[RTE_MAX_LCORE];
+	/**< Per lcore defer queues, with RTE_RCU_QSBR_DQ_LCORE. */
 };
 
 /* Internal structure to represent the element on the defer queue.
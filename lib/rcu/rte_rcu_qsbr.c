@@ -16,6 +16,8 @@
 #include <rte_malloc.h>
 #include <rte_errno.h>
 #include <rte_ring_elem.h>
+#include <rte_ring_peek.h>
+#include <rte_service_component.h>
 
 #include "rte_rcu_qsbr.h"
 #include "rcu_qsbr_pvt.h"
@@ -23,6 +25,9 @@
 #define RCU_LOG(level, ...) \
 	RTE_LOG_LINE_PREFIX(level, RCU, "%s(): ", __func__, __VA_ARGS__)
 
+/* Number of resources reclaimed after a single check of the grace period */
+#define RCU_DQ_RECLAIM_BATCH	32U
+
 /* Get the memory size of QSBR variable */
 RTE_EXPORT_SYMBOL(rte_rcu_qsbr_get_memsize)
 size_t
@@ -305,7 +310,34 @@ rte_rcu_qsbr_dq_create(const struct rte_rcu_qsbr_dq_parameters *params)
 		return NULL;
 	}
 
+	/* The queue of a lcore has a single producer, the lcore itself,
+	 * and is reclaimed by the lcore and the reclaim service.
+	 */
+	if (params->flags & RTE_RCU_QSBR_DQ_LCORE) {
+		char name[RTE_RING_NAMESIZE];
+		unsigned int lcore_id;
+
+		RTE_LCORE_FOREACH(lcore_id) {
+			snprintf(name, sizeof(name), "%s_%u", params->name,
+				lcore_id);
+			dq->lr[lcore_id] = rte_ring_create_elem(name,
+				__RTE_QSBR_TOKEN_SIZE + params->esize,
+				qs_fifo_size, rte_lcore_to_socket_id(lcore_id),
+				RING_F_SP_ENQ | RING_F_MC_HTS_DEQ);
+			if (dq->lr[lcore_id] == NULL) {
+				RCU_LOG(ERR, "lcore %u defer queue create failed",
+					lcore_id);
+				RTE_LCORE_FOREACH(lcore_id)
+					rte_ring_free(dq->lr[lcore_id]);
+				rte_ring_free(dq->r);
+				rte_free(dq);
+				return NULL;
+			}
+		}
+	}
+
 	dq->v = params->v;
+	dq->flags = params->flags;
 	dq->size = params->size;
 	dq->esize = __RTE_QSBR_TOKEN_SIZE + params->esize;
 	dq->trigger_reclaim_limit = params->trigger_reclaim_limit;
@@ -316,6 +348,92 @@ rte_rcu_qsbr_dq_create(const struct rte_rcu_qsbr_dq_parameters *params)
 	return dq;
 }
 
+/* Get the queue of the calling thread. */
+static inline struct rte_ring *
+dq_ring(const struct rte_rcu_qsbr_dq *dq)
+{
+	unsigned int lcore_id = rte_lcore_id();
+
+	if ((dq->flags & RTE_RCU_QSBR_DQ_LCORE) && lcore_id < RTE_MAX_LCORE &&
+			dq->lr[lcore_id] != NULL)
+		return dq->lr[lcore_id];
+
+	return dq->r;
+}
+
+/* Get the number of resources on all the queues. */
+static uint32_t
+dq_count(const struct rte_rcu_qsbr_dq *dq)
+{
+	unsigned int lcore_id;
+	uint32_t cnt;
+
+	cnt = rte_ring_count(dq->r);
+	if (dq->flags & RTE_RCU_QSBR_DQ_LCORE) {
+		RTE_LCORE_FOREACH(lcore_id)
+			cnt += rte_ring_count(dq->lr[lcore_id]);
+	}
+
+	return cnt;
+}
+
+/* Reclaim at most n resources from a queue.
+ * The resources are peeked in batches and the grace period is checked
+ * once for a batch, against its most recent token. The tokens of a shared
+ * queue may be out of order, so on failure each resource of the batch is
+ * checked in turn.
+ */
+static uint32_t
+dq_ring_reclaim(struct rte_rcu_qsbr_dq *dq, struct rte_ring *r, uint32_t n)
+{
+	__rte_rcu_qsbr_dq_elem_t *dq_elem;
+	uint32_t cnt, i, k, m;
+	uint64_t token;
+
+	char *data = alloca(dq->esize * RCU_DQ_RECLAIM_BATCH);
+
+	cnt = 0;
+	while (cnt < n) {
+		m = rte_ring_dequeue_burst_elem_start(r, data, dq->esize,
+			RTE_MIN(n - cnt, RCU_DQ_RECLAIM_BATCH), NULL);
+		if (m == 0)
+			break;
+
+		token = 0;
+		for (i = 0; i != m; i++) {
+			dq_elem = RTE_PTR_ADD(data, i * dq->esize);
+			token = RTE_MAX(token, dq_elem->token);
+		}
+
+		/* Check reader threads quiescent state */
+		if (rte_rcu_qsbr_check(dq->v, token, false) == 1)
+			k = m;
+		else {
+			for (k = 0; k != m; k++) {
+				dq_elem = RTE_PTR_ADD(data, k * dq->esize);
+				if (rte_rcu_qsbr_check(dq->v, dq_elem->token,
+						false) != 1)
+					break;
+			}
+		}
+		rte_ring_dequeue_elem_finish(r, k);
+
+		/* Reclaim the resources */
+		for (i = 0; i != k; i++) {
+			dq_elem = RTE_PTR_ADD(data, i * dq->esize);
+			RCU_LOG(INFO, "Reclaimed token = %" PRIu64,
+				dq_elem->token);
+			dq->free_fn(dq->p, dq_elem->elem, 1);
+		}
+
+		cnt += k;
+		if (k != m)
+			break;
+	}
+
+	return cnt;
+}
+
 /* Enqueue one resource to the defer queue to free after the grace
  * period is over.
  */
@@ -323,6 +441,7 @@ RTE_EXPORT_SYMBOL(rte_rcu_qsbr_dq_enqueue)
 int rte_rcu_qsbr_dq_enqueue(struct rte_rcu_qsbr_dq *dq, void *e)
 {
 	__rte_rcu_qsbr_dq_elem_t *dq_elem;
+	struct rte_ring *r;
 	uint32_t cur_size;
 
 	if (dq == NULL || e == NULL) {
@@ -332,6 +451,8 @@ int rte_rcu_qsbr_dq_enqueue(struct rte_rcu_qsbr_dq *dq, void *e)
 		return 1;
 	}
 
+	r = dq_ring(dq);
+
 	char *data = alloca(dq->esize);
 	dq_elem = (__rte_rcu_qsbr_dq_elem_t *)data;
 	/* Start the grace period */
@@ -341,11 +462,21 @@ int rte_rcu_qsbr_dq_enqueue(struct rte_rcu_qsbr_dq *dq, void *e)
 	 * limit. This helps the queue from growing too large and
 	 * allows time for reader threads to report their quiescent state.
 	 */
-	cur_size = rte_ring_count(dq->r);
+	cur_size = rte_ring_count(r);
 	if (cur_size > dq->trigger_reclaim_limit) {
 		RCU_LOG(INFO, "Triggering reclamation");
-		rte_rcu_qsbr_dq_reclaim(dq, dq->max_reclaim_size,
-						NULL, NULL, NULL);
+		dq_ring_reclaim(dq, r, dq->max_reclaim_size);
+	}
+
+	/* Bound the memory held by the queue: wait for the grace period
+	 * of the resources enqueued before this one, and free them.
+	 */
+	if ((dq->flags & RTE_RCU_QSBR_DQ_WAIT_ON_FULL) &&
+			rte_ring_full(r)) {
+		RCU_LOG(INFO, "Waiting for token = %" PRIu64,
+			dq_elem->token - 1);
+		rte_rcu_qsbr_check(dq->v, dq_elem->token - 1, true);
+		dq_ring_reclaim(dq, r, UINT32_MAX);
 	}
 
 	/* Enqueue the token and resource. Generating the token and
@@ -360,7 +491,7 @@ int rte_rcu_qsbr_dq_enqueue(struct rte_rcu_qsbr_dq *dq, void *e)
 	 * might have used up the freed space.
 	 * Enqueue uses the configured flags when the DQ was created.
 	 */
-	if (rte_ring_enqueue_elem(dq->r, data, dq->esize) != 0) {
+	if (rte_ring_enqueue_elem(r, data, dq->esize) != 0) {
 		RCU_LOG(ERR, "Enqueue failed");
 		/* Note that the token generated above is not used.
 		 * Other than wasting tokens, it should not cause any
@@ -384,8 +515,8 @@ rte_rcu_qsbr_dq_reclaim(struct rte_rcu_qsbr_dq *dq, unsigned int n,
 			unsigned int *freed, unsigned int *pending,
 			unsigned int *available)
 {
+	unsigned int lcore_id;
 	uint32_t cnt;
-	__rte_rcu_qsbr_dq_elem_t *dq_elem;
 
 	if (dq == NULL || n == 0) {
 		RCU_LOG(ERR, "Invalid input parameter");
@@ -394,35 +525,22 @@ rte_rcu_qsbr_dq_reclaim(struct rte_rcu_qsbr_dq *dq, unsigned int n,
 		return 1;
 	}
 
-	cnt = 0;
-
-	char *data = alloca(dq->esize);
 	/* Check reader threads quiescent state and reclaim resources */
-	while (cnt < n &&
-		rte_ring_dequeue_bulk_elem_start(dq->r, data,
-					dq->esize, 1, available) != 0) {
-		dq_elem = (__rte_rcu_qsbr_dq_elem_t *)data;
-
-		/* Reclaim the resource */
-		if (rte_rcu_qsbr_check(dq->v, dq_elem->token, false) != 1) {
-			rte_ring_dequeue_elem_finish(dq->r, 0);
-			break;
-		}
-		rte_ring_dequeue_elem_finish(dq->r, 1);
-
-		RCU_LOG(INFO, "Reclaimed token = %" PRIu64, dq_elem->token);
-
-		dq->free_fn(dq->p, dq_elem->elem, 1);
-
-		cnt++;
+	cnt = 0;
+	if (dq->flags & RTE_RCU_QSBR_DQ_LCORE) {
+		RTE_LCORE_FOREACH(lcore_id)
+			cnt += dq_ring_reclaim(dq, dq->lr[lcore_id], n - cnt);
 	}
+	cnt += dq_ring_reclaim(dq, dq->r, n - cnt);
 
 	RCU_LOG(INFO, "Reclaimed %u resources", cnt);
 
 	if (freed != NULL)
 		*freed = cnt;
 	if (pending != NULL)
-		*pending = rte_ring_count(dq->r);
+		*pending = dq_count(dq);
+	if (available != NULL)
+		*available = rte_ring_free_count(dq_ring(dq));
 
 	return 0;
 }
@@ -448,11 +566,78 @@ rte_rcu_qsbr_dq_delete(struct rte_rcu_qsbr_dq *dq)
 		return 1;
 	}
 
+	if (dq->service) {
+		rte_service_component_runstate_set(dq->service_id, 0);
+		rte_service_component_unregister(dq->service_id);
+	}
+
+	if (dq->flags & RTE_RCU_QSBR_DQ_LCORE) {
+		unsigned int lcore_id;
+
+		RTE_LCORE_FOREACH(lcore_id)
+			rte_ring_free(dq->lr[lcore_id]);
+	}
 	rte_ring_free(dq->r);
 	rte_free(dq);
 
 	return 0;
 }
 
+static int32_t
+dq_reclaim_service(void *arg)
+{
+	struct rte_rcu_qsbr_dq *dq = arg;
+	unsigned int freed;
+
+	rte_rcu_qsbr_dq_reclaim(dq, UINT32_MAX, &freed, NULL, NULL);
+
+	return freed != 0 ? 0 : -EAGAIN;
+}
+
+/* Register a service reclaiming the resources of a defer queue. */
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_rcu_qsbr_dq_service_register, 26.03)
+int
+rte_rcu_qsbr_dq_service_register(struct rte_rcu_qsbr_dq *dq,
+	uint32_t *service_id)
+{
+	struct rte_service_spec spec;
+	int ret;
+
+	/* The service and the writers free resources concurrently */
+	if (dq == NULL || service_id == NULL ||
+			(dq->flags & RTE_RCU_QSBR_DQ_MT_UNSAFE)) {
+		RCU_LOG(ERR, "Invalid input parameter");
+		rte_errno = EINVAL;
+
+		return 1;
+	}
+
+	if (dq->service) {
+		rte_errno = EEXIST;
+
+		return 1;
+	}
+
+	memset(&spec, 0, sizeof(spec));
+	snprintf(spec.name, sizeof(spec.name), "rcu_dq_%s", dq->r->name);
+	spec.callback = dq_reclaim_service;
+	spec.callback_userdata = dq;
+	spec.capabilities = RTE_SERVICE_CAP_MT_SAFE;
+
+	ret = rte_service_component_register(&spec, &dq->service_id);
+	if (ret != 0) {
+		RCU_LOG(ERR, "reclaim service register failed");
+		rte_errno = -ret;
+
+		return 1;
+	}
+	rte_service_component_runstate_set(dq->service_id, 1);
+
+	dq->service = true;
+	*service_id = dq->service_id;
+
+	return 0;
+}
+
 RTE_EXPORT_SYMBOL(rte_rcu_log_type)
 RTE_LOG_REGISTER_DEFAULT(rte_rcu_log_type, ERR);
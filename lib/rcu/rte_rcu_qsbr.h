@@ -28,6 +28,7 @@
 #include <stdint.h>
 
 #include <rte_common.h>
+#include <rte_compat.h>
 #include <rte_debug.h>
 #include <rte_atomic.h>
 #include <rte_ring.h>
@@ -141,6 +142,19 @@ typedef void (*rte_rcu_qsbr_free_resource_t)(void *p, void *e, unsigned int n);
  *   Set this flag if multi-thread safety is not required.
  */
 #define RTE_RCU_QSBR_DQ_MT_UNSAFE 1
+/**< Use a defer queue of 'size' entries per EAL lcore, so that the
+ *   writers running on different lcores do not contend on a shared
+ *   queue. The non-EAL threads use a shared queue of 'size' entries.
+ *   The reclamation is done on all the queues.
+ */
+#define RTE_RCU_QSBR_DQ_LCORE 2
+/**< Bound the memory held by the defer queue: when the queue of the
+ *   writer is full, rte_rcu_qsbr_dq_enqueue waits for the end of the
+ *   grace period of the resources on it and frees them, instead of
+ *   failing. The writer must not be in a read-side critical section
+ *   on the RCU QSBR variable of the queue.
+ */
+#define RTE_RCU_QSBR_DQ_WAIT_ON_FULL 4
 
 /**
  * Parameters used when creating the defer queue.
@@ -820,6 +834,37 @@ rte_rcu_qsbr_dq_reclaim(struct rte_rcu_qsbr_dq *dq, unsigned int n,
 int
 rte_rcu_qsbr_dq_delete(struct rte_rcu_qsbr_dq *dq);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Register a service reclaiming the resources of a defer queue in the
+ * background, so that the writers do not have to.
+ *
+ * Each run of the service reclaims all the resources that completed
+ * their grace period, checking the grace period once per batch of
+ * resources. The service must be mapped to a service lcore and started
+ * by the application, it is unregistered when the queue is deleted.
+ * The queue must be multi-thread safe, i.e. not created with
+ * RTE_RCU_QSBR_DQ_MT_UNSAFE.
+ *
+ * @param dq
+ *   Defer queue to reclaim the resources of.
+ * @param service_id
+ *   Set to the id of the service on success.
+ * @return
+ *   On success - 0
+ *   On error - 1 with rte_errno set to
+ *   - EINVAL - NULL parameters are passed or the queue is not
+ *		multi-thread safe
+ *   - EEXIST - A service is already registered for the queue
+ *   - ENOSPC - No more services can be registered
+ */
+__rte_experimental
+int
+rte_rcu_qsbr_dq_service_register(struct rte_rcu_qsbr_dq *dq,
+	uint32_t *service_id);
+
 #ifdef __cplusplus
 }
 #endif
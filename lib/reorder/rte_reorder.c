@@ -54,10 +54,33 @@ struct __rte_cache_aligned rte_reorder_buffer {
 	unsigned int memsize; /**< memory area size of reorder buffer */
 	bool is_initialized; /**< flag indicates that buffer was initialized */
 
+	/** Sequence number up to which the multi-producer drain skips gaps */
+	RTE_ATOMIC(uint32_t) mp_skip_seqn;
+
 	struct cir_buffer ready_buf; /**< temp buffer for dequeued entries */
 	struct cir_buffer order_buf; /**< buffer used to reorder entries */
 };
 
+/*
+ * In multi-producer mode, the order buffer entry of a sequence number
+ * skipped by the drain is marked with its lap parity, so that a late insert
+ * of this sequence number fails, while an insert in the next lap succeeds.
+ */
+#define REORDER_MP_SKIPPED 0x1
+#define REORDER_MP_SKIPPED_LAP 0x2
+
+static inline uintptr_t
+reorder_mp_skipped(uint32_t seqn, uint32_t size)
+{
+	return REORDER_MP_SKIPPED | ((seqn & size) ? REORDER_MP_SKIPPED_LAP : 0);
+}
+
+static inline bool
+reorder_entry_is_mbuf(const struct rte_mbuf *m)
+{
+	return m != NULL && ((uintptr_t)m & REORDER_MP_SKIPPED) == 0;
+}
+
 static void
 rte_reorder_free_mbufs(struct rte_reorder_buffer *b);
 
@@ -234,7 +257,8 @@ rte_reorder_free_mbufs(struct rte_reorder_buffer *b)
 
 	/* Free up the mbufs of order buffer & ready buffer */
 	for (i = 0; i < b->order_buf.size; i++) {
-		rte_pktmbuf_free(b->order_buf.entries[i]);
+		if (reorder_entry_is_mbuf(b->order_buf.entries[i]))
+			rte_pktmbuf_free(b->order_buf.entries[i]);
 		rte_pktmbuf_free(b->ready_buf.entries[i]);
 	}
 }
@@ -546,7 +570,7 @@ rte_reorder_is_empty(const struct rte_reorder_buffer *b)
 
 	/* Order buffer could have gaps, iterate */
 	for (i = 0; i < order_buf->size; i++) {
-		if (order_buf->entries[i] != NULL)
+		if (reorder_entry_is_mbuf(order_buf->entries[i]))
 			return false;
 	}
 
@@ -561,7 +585,114 @@ rte_reorder_min_seqn_set(struct rte_reorder_buffer *b, rte_reorder_seqn_t min_se
 		return -ENOTEMPTY;
 
 	b->min_seqn = min_seqn;
+	rte_atomic_store_explicit(&b->mp_skip_seqn, min_seqn,
+			rte_memory_order_relaxed);
 	b->is_initialized = true;
 
 	return 0;
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_insert_mp, 26.03)
+int
+rte_reorder_insert_mp(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf)
+{
+	uintptr_t __rte_atomic *entry;
+	uint32_t seqn, min_seqn, offset, size, skip_seqn;
+	uintptr_t old;
+
+	if (b == NULL || mbuf == NULL || !b->is_initialized) {
+		rte_errno = EINVAL;
+		return -1;
+	}
+
+	size = b->order_buf.size;
+	seqn = *rte_reorder_seqn(mbuf);
+	min_seqn = rte_atomic_load_explicit((uint32_t __rte_atomic *)&b->min_seqn,
+			rte_memory_order_acquire);
+	offset = seqn - min_seqn;
+
+	if (offset >= size) {
+		if (offset >= 2 * size) {
+			rte_errno = ERANGE;
+			return -1;
+		}
+		/* ask the drain to skip the gaps up to make room for this one */
+		skip_seqn = rte_atomic_load_explicit(&b->mp_skip_seqn,
+				rte_memory_order_relaxed);
+		while ((int32_t)(seqn - size + 1 - skip_seqn) > 0 &&
+				!rte_atomic_compare_exchange_weak_explicit(
+					&b->mp_skip_seqn, &skip_seqn,
+					seqn - size + 1,
+					rte_memory_order_relaxed,
+					rte_memory_order_relaxed))
+			;
+		rte_errno = ENOSPC;
+		return -1;
+	}
+
+	/*
+	 * The entry is either empty, or marked as skipped in the previous lap,
+	 * the previous sequence numbers being out of the window.
+	 */
+	entry = (uintptr_t __rte_atomic *)&b->order_buf.entries[seqn &
+			b->order_buf.mask];
+	old = 0;
+	if (!rte_atomic_compare_exchange_strong_explicit(entry, &old,
+			(uintptr_t)mbuf, rte_memory_order_release,
+			rte_memory_order_relaxed) &&
+			(old != reorder_mp_skipped(seqn - size, size) ||
+			 !rte_atomic_compare_exchange_strong_explicit(entry, &old,
+				(uintptr_t)mbuf, rte_memory_order_release,
+				rte_memory_order_relaxed))) {
+		/* skipped by the drain, or a duplicate sequence number */
+		rte_errno = ERANGE;
+		return -1;
+	}
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_reorder_drain_mp, 26.03)
+unsigned int
+rte_reorder_drain_mp(struct rte_reorder_buffer *b, struct rte_mbuf **mbufs,
+		unsigned int max_mbufs)
+{
+	struct cir_buffer *order_buf = &b->order_buf;
+	uintptr_t __rte_atomic *entry;
+	unsigned int drain_cnt = 0;
+	uint32_t seqn, skip_seqn;
+	uintptr_t val;
+
+	seqn = b->min_seqn;
+	skip_seqn = rte_atomic_load_explicit(&b->mp_skip_seqn,
+			rte_memory_order_relaxed);
+
+	while (drain_cnt < max_mbufs) {
+		entry = (uintptr_t __rte_atomic *)&order_buf->entries[seqn &
+				order_buf->mask];
+		val = rte_atomic_load_explicit(entry, rte_memory_order_acquire);
+
+		if (reorder_entry_is_mbuf((struct rte_mbuf *)val)) {
+			mbufs[drain_cnt++] = (struct rte_mbuf *)val;
+			rte_atomic_store_explicit(entry, 0,
+					rte_memory_order_relaxed);
+			seqn++;
+			continue;
+		}
+
+		/* a missing packet blocks the drain, unless it must be skipped */
+		if ((int32_t)(skip_seqn - seqn) <= 0)
+			break;
+		if (rte_atomic_compare_exchange_strong_explicit(entry, &val,
+				reorder_mp_skipped(seqn, order_buf->size),
+				rte_memory_order_relaxed,
+				rte_memory_order_relaxed))
+			seqn++;
+	}
+
+	/* let the inserts see the emptied entries in the new window */
+	rte_atomic_store_explicit((uint32_t __rte_atomic *)&b->min_seqn, seqn,
+			rte_memory_order_release);
+
+	return drain_cnt;
+}
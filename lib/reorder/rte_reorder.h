@@ -214,6 +214,67 @@ __rte_experimental
 unsigned int
 rte_reorder_min_seqn_set(struct rte_reorder_buffer *b, rte_reorder_seqn_t min_seqn);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Insert given mbuf in reorder buffer, from one of several threads.
+ *
+ * Unlike rte_reorder_insert(), this function may be called concurrently
+ * by several threads, while a single thread drains the buffer with
+ * rte_reorder_drain_mp(). The mbuf is stored in its entry of the reorder
+ * window with an atomic operation, the window being moved by the drain only.
+ * These functions must not be mixed with the other insert and drain
+ * functions on the same buffer.
+ *
+ * The minimum sequence number must be set with rte_reorder_min_seqn_set()
+ * before the first insert.
+ *
+ * @param b
+ *   Reorder buffer where the mbuf has to be inserted.
+ * @param mbuf
+ *   mbuf of packet that needs to be inserted in reorder buffer.
+ * @return
+ *   0 on success
+ *   -1 on error
+ *   On error case, rte_errno will be set appropriately:
+ *    - ENOSPC - The mbuf is early, beyond the reorder window. The next drain
+ *      skips the missing mbufs to make room for it, the insert can be retried
+ *      after the drain.
+ *    - ERANGE - Too early or late mbuf which is vastly out of range of expected
+ *      window, or mbuf whose sequence number was skipped by the drain.
+ *    - EINVAL - Invalid parameter, or minimum sequence number not set.
+ */
+__rte_experimental
+int
+rte_reorder_insert_mp(struct rte_reorder_buffer *b, struct rte_mbuf *mbuf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice
+ *
+ * Fetch reordered buffers inserted with rte_reorder_insert_mp().
+ *
+ * Returns a set of in-order buffers from the reorder buffer structure.
+ * The drain stops at the first missing mbuf, unless an early insert failed
+ * for lack of room, in which case the missing mbufs are skipped up to make
+ * room for the early mbuf.
+ * Only one thread may drain the buffer.
+ *
+ * @param b
+ *   Reorder buffer instance from which packets are to be drained
+ * @param mbufs
+ *   array of mbufs where reordered packets will be inserted from reorder buffer
+ * @param max_mbufs
+ *   the number of elements in the mbufs array.
+ * @return
+ *   number of mbuf pointers written to mbufs. 0 <= N < max_mbufs.
+ */
+__rte_experimental
+unsigned int
+rte_reorder_drain_mp(struct rte_reorder_buffer *b, struct rte_mbuf **mbufs,
+		unsigned int max_mbufs);
+
 /**
  * @warning
  * @b EXPERIMENTAL: this API may change without prior notice
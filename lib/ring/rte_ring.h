@@ -839,4 +839,6 @@ rte_ring_dequeue_burst(struct rte_ring *r, void **obj_table,
 }
 #endif
 
+#include <rte_ring_multi.h>
+
 #endif /* _RTE_RING_H_ */
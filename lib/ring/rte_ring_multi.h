@@ -0,0 +1,240 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_RING_MULTI_H_
+#define _RTE_RING_MULTI_H_
+
+/**
+ * @file
+ * It is not recommended to include this file directly.
+ * Please include <rte_ring.h> instead.
+ *
+ * Ring Multi Dequeue API
+ * Dequeue from a set of rings in one call, filling one output array.
+ * A consumer polling many rings in round-robin pays a load of the producer
+ * tail for each empty ring. Here the tails of all the rings of the set are
+ * prefetched before the first ring is checked, so the loads overlap,
+ * and the rings are polled from a position kept by the caller,
+ * for the next call to start after the last ring dequeued from.
+ *
+ * Optionally, producers can ring a doorbell after each enqueue,
+ * i.e. set the bit of their ring in a bitmap shared with the consumer.
+ * The consumer then only touches the rings with their bit set.
+ * As an example:
+ * // producer of ring 3:
+ * if (rte_ring_enqueue_burst(rings[3], objs, n, NULL) != 0)
+ *    rte_ring_doorbell_ring(&db, 3);
+ * // consumer:
+ * n = rte_ring_dequeue_burst_multi(rings, nb_rings, &db, objs,
+ *       RTE_DIM(objs), &pos);
+ */
+
+#include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_prefetch.h>
+#include <rte_stdatomic.h>
+#include <rte_ring.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of rings sharing a doorbell. */
+#define RTE_RING_DOORBELL_MAX 64
+
+/**
+ * Doorbell of a set of rings, with one bit per ring of the set,
+ * set by the producers when the ring is not empty.
+ */
+struct __rte_cache_aligned rte_ring_doorbell {
+	RTE_ATOMIC(uint64_t) bits; /**< Bit i set if ring i may have objects. */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Initialize a doorbell, with no ring set.
+ *
+ * @param db
+ *   A pointer to the doorbell.
+ */
+__rte_experimental
+static inline void
+rte_ring_doorbell_init(struct rte_ring_doorbell *db)
+{
+	rte_atomic_store_explicit(&db->bits, 0, rte_memory_order_relaxed);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Ring the doorbell of a ring, after enqueuing objects on it.
+ *
+ * The bit is set even if it is already set: testing it first could miss
+ * the consumer clearing it in between, and the objects would not be seen
+ * until another enqueue on the ring.
+ *
+ * @param db
+ *   A pointer to the doorbell.
+ * @param idx
+ *   The index of the ring in the set given to rte_ring_dequeue_burst_multi(),
+ *   less than @c RTE_RING_DOORBELL_MAX.
+ */
+__rte_experimental
+static inline void
+rte_ring_doorbell_ring(struct rte_ring_doorbell *db, unsigned int idx)
+{
+	RTE_ASSERT(idx < RTE_RING_DOORBELL_MAX);
+
+	/* release the enqueued objects to the consumer reading the bit */
+	rte_atomic_fetch_or_explicit(&db->bits, RTE_BIT64(idx),
+			rte_memory_order_release);
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Dequeue objects from a set of rings, up to a maximum number in total.
+ *
+ * The rings are polled in round-robin, starting at the ring at *pos,
+ * and empty rings are skipped without taking their consumer head.
+ * Each ring is dequeued with rte_ring_dequeue_burst_elem(), as per its
+ * consumer sync type, so a ring may be shared with other consumers.
+ *
+ * With a doorbell, only the rings with their bit set are polled.
+ * The bits are taken by the call, and set again for the rings which were
+ * not polled or not drained, so a ring does not need another enqueue
+ * to be polled again.
+ *
+ * @param rings
+ *   An array of pointers to the rings, all with the same element size.
+ * @param nb_rings
+ *   The number of rings in the set, at most @c RTE_RING_DOORBELL_MAX
+ *   with a doorbell.
+ * @param db
+ *   A pointer to the doorbell rung by the producers of the rings,
+ *   or NULL to poll all the rings.
+ * @param obj_table
+ *   A pointer to an array of objects that will be filled.
+ * @param esize
+ *   The size of ring element, in bytes. It must be a multiple of 4.
+ *   This must be the same value used while creating the rings. Otherwise
+ *   the results are undefined.
+ * @param n
+ *   The maximum number of objects to dequeue from the rings.
+ * @param pos
+ *   If non-NULL, the index of the first ring to poll, updated to the ring
+ *   following the last one dequeued from. If NULL, polling starts at the
+ *   first ring.
+ * @return
+ *   - Number of objects dequeued
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_ring_dequeue_burst_multi_elem(struct rte_ring *const rings[],
+		unsigned int nb_rings, struct rte_ring_doorbell *db,
+		void *obj_table, unsigned int esize, unsigned int n,
+		unsigned int *pos)
+{
+	uint64_t pending, drained;
+	unsigned int i, idx, start, last, nb, avail;
+
+	RTE_ASSERT(db == NULL || nb_rings <= RTE_RING_DOORBELL_MAX);
+
+	if (unlikely(nb_rings == 0 || n == 0))
+		return 0;
+
+	if (db != NULL) {
+		pending = rte_atomic_exchange_explicit(&db->bits, 0,
+				rte_memory_order_acquire);
+		if (pending == 0)
+			return 0;
+	} else {
+		pending = UINT64_MAX;
+	}
+
+	/* overlap the loads of the tails of all the rings to poll */
+	for (i = 0; i < nb_rings; i++) {
+		if ((pending & RTE_BIT64(i % RTE_RING_DOORBELL_MAX)) == 0)
+			continue;
+		rte_prefetch0(&rings[i]->prod.tail);
+		rte_prefetch0(&rings[i]->cons.tail);
+	}
+
+	start = (pos != NULL && *pos < nb_rings) ? *pos : 0;
+	last = nb_rings;
+	drained = 0;
+	nb = 0;
+	for (i = 0, idx = start; i < nb_rings && nb < n; i++) {
+		if ((pending & RTE_BIT64(idx % RTE_RING_DOORBELL_MAX)) != 0 &&
+				!rte_ring_empty(rings[idx])) {
+			nb += rte_ring_dequeue_burst_elem(rings[idx],
+					RTE_PTR_ADD(obj_table, (size_t)nb * esize),
+					esize, n - nb, &avail);
+			last = idx;
+			if (avail == 0)
+				drained |= RTE_BIT64(idx % RTE_RING_DOORBELL_MAX);
+		} else {
+			/* nothing to dequeue: polled and drained */
+			drained |= RTE_BIT64(idx % RTE_RING_DOORBELL_MAX);
+		}
+		if (++idx == nb_rings)
+			idx = 0;
+	}
+
+	if (pos != NULL && last != nb_rings)
+		*pos = (last + 1 == nb_rings) ? 0 : last + 1;
+
+	/* set again the bits of rings not polled, or with objects left */
+	if (db != NULL && (pending & ~drained) != 0)
+		rte_atomic_fetch_or_explicit(&db->bits, pending & ~drained,
+				rte_memory_order_relaxed);
+
+	return nb;
+}
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Dequeue pointers from a set of rings, up to a maximum number in total.
+ *
+ * @see rte_ring_dequeue_burst_multi_elem()
+ *
+ * @param rings
+ *   An array of pointers to the rings.
+ * @param nb_rings
+ *   The number of rings in the set, at most @c RTE_RING_DOORBELL_MAX
+ *   with a doorbell.
+ * @param db
+ *   A pointer to the doorbell rung by the producers of the rings,
+ *   or NULL to poll all the rings.
+ * @param obj_table
+ *   A pointer to a table of void * pointers (objects) that will be filled.
+ * @param n
+ *   The maximum number of objects to dequeue from the rings.
+ * @param pos
+ *   If non-NULL, the index of the first ring to poll, updated to the ring
+ *   following the last one dequeued from.
+ * @return
+ *   - Number of objects dequeued
+ */
+__rte_experimental
+static __rte_always_inline unsigned int
+rte_ring_dequeue_burst_multi(struct rte_ring *const rings[],
+		unsigned int nb_rings, struct rte_ring_doorbell *db,
+		void **obj_table, unsigned int n, unsigned int *pos)
+{
+	return rte_ring_dequeue_burst_multi_elem(rings, nb_rings, db,
+			obj_table, sizeof(void *), n, pos);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_RING_MULTI_H_ */
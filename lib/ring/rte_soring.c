@@ -3,12 +3,26 @@
  */
 
 #include <inttypes.h>
+#include <stdlib.h>
+#include <sys/queue.h>
 
 #include <eal_export.h>
+#include <rte_spinlock.h>
 #include <rte_string_fns.h>
+#include <rte_telemetry.h>
 
 #include "soring.h"
 
+/* sorings registered with telemetry */
+struct soring_tel_entry {
+	TAILQ_ENTRY(soring_tel_entry) next;
+	const struct rte_soring *r;
+};
+
+static TAILQ_HEAD(, soring_tel_entry) soring_tel_list =
+	TAILQ_HEAD_INITIALIZER(soring_tel_list);
+static rte_spinlock_t soring_tel_lock = RTE_SPINLOCK_INITIALIZER;
+
 RTE_LOG_REGISTER_DEFAULT(soring_logtype, INFO);
 
 static uint32_t
@@ -90,6 +104,8 @@ soring_dump_stage_headtail(FILE *f, const char *prefix,
 	fprintf(f, "%stail.pos=%"PRIu32"\n", prefix, st->sht.tail.pos);
 	fprintf(f, "%stail.sync=%"PRIu32"\n", prefix, st->sht.tail.sync);
 	fprintf(f, "%shead=%"PRIu32"\n", prefix, st->sht.head);
+	fprintf(f, "%sburst=%"PRIu32"\n", prefix, st->stats.burst);
+	fprintf(f, "%sstalls=%"PRIu64"\n", prefix, st->stats.stalls);
 }
 
 RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_soring_dump, 25.03)
@@ -113,6 +129,7 @@ rte_soring_dump(FILE *f, const struct rte_soring *r)
 	rte_ring_headtail_dump(f, "  cons.", &(r->cons.ht));
 	rte_ring_headtail_dump(f, "  prod.", &(r->prod.ht));
 
+	fprintf(f, "  flags=%#"PRIx32"\n", r->flags);
 	fprintf(f, "  nb_stage=%"PRIu32"\n", r->nb_stage);
 	for (i = 0; i < r->nb_stage; i++) {
 		snprintf(buf, sizeof(buf), "  stage[%u].", i);
@@ -186,6 +203,8 @@ rte_soring_init(struct rte_soring *r, const struct rte_soring_param *prm)
 	r->esize = prm->elem_size;
 	r->msize = prm->meta_size;
 
+	r->flags = prm->flags;
+
 	r->prod.ht.sync_type = prm->prod_synt;
 	r->cons.ht.sync_type = prm->cons_synt;
 
@@ -201,3 +220,183 @@ rte_soring_init(struct rte_soring *r, const struct rte_soring_param *prm)
 
 	return 0;
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_soring_stage_stats_get, 26.03)
+int
+rte_soring_stage_stats_get(const struct rte_soring *r, uint32_t stage,
+	struct rte_soring_stage_stats *stats)
+{
+	const struct soring_stage *stg;
+	uint32_t head, prev_tail, tail;
+
+	if (r == NULL || stats == NULL || stage >= r->nb_stage)
+		return -EINVAL;
+
+	stg = r->stage + stage;
+	if (stage == 0)
+		prev_tail = rte_atomic_load_explicit(&r->prod.ht.tail,
+				rte_memory_order_acquire);
+	else
+		prev_tail = rte_atomic_load_explicit(&r->stage[stage - 1].sht.tail.pos,
+				rte_memory_order_acquire);
+	head = rte_atomic_load_explicit(&stg->sht.head, rte_memory_order_relaxed);
+	tail = rte_atomic_load_explicit(&stg->sht.tail.pos,
+			rte_memory_order_relaxed);
+
+	stats->depth = RTE_MIN((prev_tail - head) & r->mask, r->capacity);
+	stats->inflight = RTE_MIN((head - tail) & r->mask, r->capacity);
+	stats->burst = rte_atomic_load_explicit(&stg->stats.burst,
+			rte_memory_order_relaxed);
+	stats->stalls = rte_atomic_load_explicit(&stg->stats.stalls,
+			rte_memory_order_relaxed);
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_soring_stats_reset, 26.03)
+void
+rte_soring_stats_reset(struct rte_soring *r)
+{
+	uint32_t i;
+
+	if (r == NULL)
+		return;
+
+	for (i = 0; i < r->nb_stage; i++)
+		rte_atomic_store_explicit(&r->stage[i].stats.stalls, 0,
+			rte_memory_order_relaxed);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_soring_telemetry_register, 26.03)
+int
+rte_soring_telemetry_register(const struct rte_soring *r)
+{
+	struct soring_tel_entry *te;
+
+	if (r == NULL)
+		return -EINVAL;
+
+	rte_spinlock_lock(&soring_tel_lock);
+	TAILQ_FOREACH(te, &soring_tel_list, next) {
+		if (te->r == r) {
+			rte_spinlock_unlock(&soring_tel_lock);
+			return -EEXIST;
+		}
+	}
+
+	te = malloc(sizeof(*te));
+	if (te == NULL) {
+		rte_spinlock_unlock(&soring_tel_lock);
+		return -ENOMEM;
+	}
+	te->r = r;
+	TAILQ_INSERT_TAIL(&soring_tel_list, te, next);
+	rte_spinlock_unlock(&soring_tel_lock);
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_soring_telemetry_unregister, 26.03)
+int
+rte_soring_telemetry_unregister(const struct rte_soring *r)
+{
+	struct soring_tel_entry *te;
+
+	rte_spinlock_lock(&soring_tel_lock);
+	TAILQ_FOREACH(te, &soring_tel_list, next) {
+		if (te->r == r)
+			break;
+	}
+	if (te != NULL)
+		TAILQ_REMOVE(&soring_tel_list, te, next);
+	rte_spinlock_unlock(&soring_tel_lock);
+
+	if (te == NULL)
+		return -ENOENT;
+
+	free(te);
+	return 0;
+}
+
+static int
+soring_handle_list(const char *cmd __rte_unused,
+		const char *params __rte_unused, struct rte_tel_data *d)
+{
+	const struct soring_tel_entry *te;
+
+	rte_tel_data_start_array(d, RTE_TEL_STRING_VAL);
+
+	rte_spinlock_lock(&soring_tel_lock);
+	TAILQ_FOREACH(te, &soring_tel_list, next)
+		rte_tel_data_add_array_string(d, te->r->name);
+	rte_spinlock_unlock(&soring_tel_lock);
+
+	return 0;
+}
+
+static void
+soring_info_stages(const struct rte_soring *r, struct rte_tel_data *d)
+{
+	struct rte_soring_stage_stats stats;
+	struct rte_tel_data *c;
+	char name[32];
+	uint32_t i;
+
+	for (i = 0; i < r->nb_stage; i++) {
+		c = rte_tel_data_alloc();
+		if (c == NULL)
+			return;
+
+		rte_soring_stage_stats_get(r, i, &stats);
+		rte_tel_data_start_dict(c);
+		rte_tel_data_add_dict_uint(c, "depth", stats.depth);
+		rte_tel_data_add_dict_uint(c, "inflight", stats.inflight);
+		rte_tel_data_add_dict_uint(c, "burst", stats.burst);
+		rte_tel_data_add_dict_uint(c, "stalls", stats.stalls);
+
+		snprintf(name, sizeof(name), "stage%u", i);
+		if (rte_tel_data_add_dict_container(d, name, c, 0) != 0)
+			rte_tel_data_free(c);
+	}
+}
+
+static int
+soring_handle_info(const char *cmd __rte_unused, const char *params,
+		struct rte_tel_data *d)
+{
+	const struct soring_tel_entry *te;
+	const struct rte_soring *r;
+
+	if (params == NULL || strlen(params) == 0 ||
+		strlen(params) >= RTE_RING_NAMESIZE)
+		return -EINVAL;
+
+	rte_tel_data_start_dict(d);
+
+	rte_spinlock_lock(&soring_tel_lock);
+	TAILQ_FOREACH(te, &soring_tel_list, next) {
+		r = te->r;
+		if (strcmp(r->name, params) != 0)
+			continue;
+
+		rte_tel_data_add_dict_string(d, "name", r->name);
+		rte_tel_data_add_dict_uint(d, "size", r->size);
+		rte_tel_data_add_dict_uint(d, "capacity", r->capacity);
+		rte_tel_data_add_dict_uint(d, "used_count", rte_soring_count(r));
+		rte_tel_data_add_dict_uint(d, "flags", r->flags);
+		rte_tel_data_add_dict_uint(d, "nb_stage", r->nb_stage);
+		soring_info_stages(r, d);
+		break;
+	}
+	rte_spinlock_unlock(&soring_tel_lock);
+
+	return 0;
+}
+
+RTE_INIT(soring_init_telemetry)
+{
+	rte_telemetry_register_cmd("/soring/list", soring_handle_list,
+		"Returns list of sorings registered with telemetry. Takes no parameters");
+	rte_telemetry_register_cmd("/soring/info", soring_handle_info,
+		"Returns soring info and per-stage statistics. Parameters: soring_name.");
+}
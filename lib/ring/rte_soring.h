@@ -35,6 +35,14 @@ extern "C" {
 /** max possible number of elements in the soring */
 #define RTE_SORING_ELEM_MAX	(RTE_BIT32(RTE_SORING_ST_BIT) - 1)
 
+/**
+ * Adapt the number of objects acquired by the burst acquire functions.
+ * For each stage, the burst size grows while a backlog remains after
+ * acquire and shrinks when fewer objects than the burst are available.
+ * The 'num' parameter of the burst acquire functions is the upper bound.
+ */
+#define RTE_SORING_F_ADAPTIVE_BURST	RTE_BIT32(0)
+
 struct rte_soring_param {
 	/** expected name of the soring */
 	const char *name;
@@ -63,6 +71,22 @@ struct rte_soring_param {
 	enum rte_ring_sync_type prod_synt;
 	/** sync type for consumer */
 	enum rte_ring_sync_type cons_synt;
+	/** RTE_SORING_F_* flags */
+	uint32_t flags;
+};
+
+/**
+ * Statistics of a soring stage.
+ */
+struct rte_soring_stage_stats {
+	/** number of objects ready for the stage and not yet acquired */
+	uint32_t depth;
+	/** number of objects acquired by the stage and not yet finalized */
+	uint32_t inflight;
+	/** current adaptive burst size, 0 if adaptive burst is disabled */
+	uint32_t burst;
+	/** number of acquire calls which got no object */
+	uint64_t stalls;
 };
 
 struct rte_soring;
@@ -157,6 +181,76 @@ __rte_experimental
 void
 rte_soring_dump(FILE *f, const struct rte_soring *r);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the statistics of a soring stage.
+ *
+ * Depth and in-flight counts are a snapshot and may be stale by the time
+ * they are returned if other threads are using the soring.
+ *
+ * @param r
+ *   Pointer to the soring structure.
+ * @param stage
+ *   Stage to get statistics for.
+ * @param stats
+ *   Pointer to the structure to fill.
+ * @return
+ *   - 0 on success, or -EINVAL if parameters are invalid.
+ */
+__rte_experimental
+int
+rte_soring_stage_stats_get(const struct rte_soring *r, uint32_t stage,
+	struct rte_soring_stage_stats *stats);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Reset the stall counters of all stages of a soring.
+ *
+ * @param r
+ *   Pointer to the soring structure.
+ */
+__rte_experimental
+void
+rte_soring_stats_reset(struct rte_soring *r);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Make a soring visible through the "/soring/list" and "/soring/info"
+ * telemetry commands.
+ *
+ * As the soring memory is provided by the user, sorings are not known to
+ * the library unless registered.
+ *
+ * @param r
+ *   Pointer to the soring structure.
+ * @return
+ *   - 0 on success, -EEXIST if already registered, -ENOMEM on failure.
+ */
+__rte_experimental
+int
+rte_soring_telemetry_register(const struct rte_soring *r);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Remove a soring from telemetry, before its memory is freed.
+ *
+ * @param r
+ *   Pointer to the soring structure.
+ * @return
+ *   - 0 on success, -ENOENT if not registered.
+ */
+__rte_experimental
+int
+rte_soring_telemetry_unregister(const struct rte_soring *r);
+
 /**
  * @warning
  * @b EXPERIMENTAL: this API may change without prior notice.
@@ -377,19 +377,55 @@ acquire_state_update(const struct rte_soring *r, uint32_t stage, uint32_t idx,
 			rte_memory_order_relaxed);
 }
 
+/*
+ * Adapt the burst size of a stage to the backlog observed by acquire():
+ * double it while a full burst still leaves at least another burst behind,
+ * halve it when less than half a burst was available.
+ */
+static __rte_always_inline void
+soring_stage_adapt_burst(struct soring_stage *stg, uint32_t burst,
+	uint32_t n, uint32_t backlog, uint32_t max)
+{
+	uint32_t nb;
+
+	nb = (burst == 0 || burst > max) ? max : burst;
+	if (n == nb && backlog >= nb)
+		nb = RTE_MIN(nb * 2, max);
+	else if (n < nb / 2)
+		nb = RTE_MAX(nb / 2, 1U);
+
+	if (nb != burst)
+		rte_atomic_store_explicit(&stg->stats.burst, nb,
+			rte_memory_order_relaxed);
+}
+
 static __rte_always_inline uint32_t
 soring_acquire(struct rte_soring *r, void *objs, void *meta,
 	uint32_t stage, uint32_t num, enum rte_ring_queue_behavior behavior,
 	uint32_t *ftoken, uint32_t *available)
 {
-	uint32_t avail, head, idx, n, next, reqn;
-	struct soring_stage *pstg;
+	uint32_t avail, burst, head, idx, max, n, next, reqn;
+	struct soring_stage *pstg, *stg;
 	struct soring_stage_headtail *cons;
+	bool adaptive;
 
 	RTE_ASSERT(r != NULL && stage < r->nb_stage);
 	RTE_ASSERT(meta == NULL || r->meta != NULL);
 
-	cons = &r->stage[stage].sht;
+	stg = &r->stage[stage];
+	cons = &stg->sht;
+
+	/* with adaptive burst, @num is only the upper bound */
+	max = num;
+	burst = 0;
+	adaptive = (r->flags & RTE_SORING_F_ADAPTIVE_BURST) != 0 &&
+		behavior == RTE_RING_QUEUE_VARIABLE;
+	if (adaptive) {
+		burst = rte_atomic_load_explicit(&stg->stats.burst,
+				rte_memory_order_relaxed);
+		if (burst != 0 && burst < num)
+			num = burst;
+	}
 
 	if (stage == 0)
 		n = __rte_soring_stage_move_head(cons, &r->prod.ht, 0, num,
@@ -433,6 +469,13 @@ soring_acquire(struct rte_soring *r, void *objs, void *meta,
 				r->size, idx, r->msize, n);
 	}
 
+	if (n == 0)
+		rte_atomic_fetch_add_explicit(&stg->stats.stalls, 1,
+			rte_memory_order_relaxed);
+
+	if (adaptive)
+		soring_stage_adapt_burst(stg, burst, n, avail - n, max);
+
 	if (available != NULL)
 		*available = avail - n;
 	return n;
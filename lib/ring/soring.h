@@ -92,6 +92,15 @@ struct soring_stage {
 	};
 
 	RTE_CACHE_GUARD;
+
+	/**
+	 * Stage statistics and adaptive burst size, kept apart from
+	 * head/tail as they are only written on stalls and burst changes.
+	 */
+	struct __rte_cache_aligned {
+		RTE_ATOMIC(uint64_t) stalls;
+		RTE_ATOMIC(uint32_t) burst;
+	} stats;
 };
 
 /**
@@ -112,6 +121,9 @@ struct  __rte_cache_aligned rte_soring {
 	struct soring_stage *stage;
 	uint32_t nb_stage;
 
+	/** RTE_SORING_F_* flags */
+	uint32_t flags;
+
 	/** Ring of states (one per element) */
 	union soring_state *state;
 
@@ -2,19 +2,36 @@
  * Copyright(c) 2024 Intel Corporation
  */
 
+#include <pthread.h>
 #include <string.h>
 #include <rte_common.h>
 #include <rte_malloc.h>
 #include <rte_log.h>
 #include <rte_string_fns.h>
 #include <rte_cycles.h>
+#include <rte_pause.h>
+#include <rte_spinlock.h>
+#include <rte_stdatomic.h>
+#include <rte_thread.h>
+#include <rte_service_component.h>
 #include <rte_sampler.h>
 
+#include "sampler_filter.h"
+
 /* Initial capacities for dynamic arrays */
 #define INITIAL_SESSIONS_CAPACITY 32
 #define INITIAL_SOURCES_PER_SESSION 8
 #define INITIAL_SINKS_PER_SESSION 4
 
+/* Service component name used by rte_sampler_service_register() */
+#define SAMPLER_SERVICE_NAME "sampler_service"
+
+/* Marker for a session that is not in the schedule heap */
+#define SCHED_IDX_NONE UINT32_MAX
+
+/* Maximum number of due sessions taken off the schedule at once */
+#define SAMPLER_POLL_BURST 32
+
 /**
  * Sampler source structure
  */
@@ -34,8 +51,21 @@ struct rte_sampler_source {
 	unsigned int num_filter_patterns;
 	unsigned int filter_patterns_capacity;          /**< Allocated capacity */
 	uint64_t *filtered_ids;                         /**< Dynamically allocated */
+	struct rte_sampler_xstats_name *filtered_names; /**< Names of filtered_ids */
+	struct sampler_filter *filter;                  /**< Compiled filter patterns */
 	unsigned int filtered_count;
 	uint8_t filter_active;
+/* Transform stage, arrays of xstats_capacity */
+	uint64_t *prev_values;                          /**< Values of previous sample */
+	uint64_t *delta_values;                         /**< Change since previous sample */
+	uint64_t *rate_values;                          /**< Per-second rate */
+	uint64_t *ewma_values;                          /**< EWMA of per-second rate */
+	uint64_t prev_time;                             /**< Timer cycles of previous sample */
+	uint8_t have_prev;                              /**< prev_values is valid */
+/* Result of the read of the current tick */
+	uint64_t sample_tsc;                            /**< TSC of the xstats read */
+	uint8_t sampled;                                /**< Values read in this tick */
+	uint8_t transformed;                            /**< Transformed values are valid */
 	uint8_t valid;
 };
 
@@ -50,6 +80,26 @@ struct rte_sampler_sink {
 	uint8_t valid;
 };
 
+/**
+ * Pool of control threads reading the sources of a session in parallel
+ *
+ * At each tick, the sources are claimed one by one through next_source
+ * by the workers and the thread processing the session, which then waits
+ * for all the workers to be done before running the sinks.
+ */
+struct sampler_workers {
+	pthread_mutex_t lock;
+	pthread_cond_t tick_cond;             /**< Signaled on new tick or stop */
+	pthread_cond_t done_cond;             /**< Signaled when pending is zero */
+	uint64_t tick;                        /**< Tick counter, protected by lock */
+	unsigned int pending;                 /**< Workers not done with the tick */
+	uint8_t stop;
+	uint32_t xform_flags;                 /**< Transforms of the tick */
+	RTE_ATOMIC(unsigned int) next_source; /**< Next source to claim */
+	unsigned int num_threads;
+	rte_thread_t threads[];
+};
+
 /**
  * Sampler session structure
  */
@@ -59,37 +109,206 @@ struct rte_sampler_session {
 	uint64_t duration_ms;
 	uint64_t start_time;
 	uint64_t last_sample_time;
+	uint64_t sample_tsc;                  /**< TSC of the last source read */
+	uint32_t ewma_shift;                  /**< EWMA weight shift */
+	uint64_t interval_cycles;             /**< sample_interval_ms in timer cycles */
+	uint64_t next_due;                    /**< Next sample time in timer cycles */
+	uint32_t sched_idx;                   /**< Index in schedule heap */
+	uint8_t polling;                      /**< Being processed by a poll */
 	uint8_t active;
 	uint8_t valid;
-	struct rte_sampler_source *sources;   /**< Dynamically allocated array */
-	struct rte_sampler_sink *sinks;       /**< Dynamically allocated array */
+	struct rte_sampler_source **sources;  /**< Dynamically allocated array */
+	struct rte_sampler_sink **sinks;      /**< Dynamically allocated array */
 	unsigned int num_sources;
 	unsigned int num_sinks;
 	unsigned int sources_capacity;        /**< Allocated capacity */
 	unsigned int sinks_capacity;          /**< Allocated capacity */
+	struct sampler_workers *workers;      /**< NULL if sources read serially */
 };
 
 /**
  * Global session registry
+ *
+ * Active periodic sessions are also kept in a binary min-heap ordered by
+ * their next due time, so that finding the next session to sample is O(1)
+ * and an idle poll does not walk the whole registry.
  */
 static struct {
 	struct rte_sampler_session **sessions;  /**< Dynamically allocated array */
 	unsigned int num_sessions;
 	unsigned int capacity;                  /**< Allocated capacity */
+	struct rte_sampler_session **sched;     /**< Schedule min-heap */
+	uint32_t sched_len;
+	uint32_t sched_capacity;                /**< Allocated capacity */
+	rte_spinlock_t sched_lock;              /**< Protects the schedule heap */
+	uint32_t service_id;
+	uint8_t service_registered;
 } sampler_global = {
 	.sessions = NULL,
 	.num_sessions = 0,
-	.capacity = 0
+	.capacity = 0,
+	.sched = NULL,
+	.sched_len = 0,
+	.sched_capacity = 0,
+	.sched_lock = RTE_SPINLOCK_INITIALIZER,
+	.service_registered = 0
 };
 
 /* Forward declarations */
 static void apply_filter(struct rte_sampler_source *source);
-static int matches_filter(struct rte_sampler_source *source, const char *name);
-static int match_pattern(const char *pattern, const char *str);
+static int session_workers_start(struct rte_sampler_session *session,
+				 unsigned int num_threads);
+static void session_workers_stop(struct rte_sampler_session *session);
+
+/*
+ * Schedule heap helpers, called with sched_lock held.
+ */
+static void
+sched_swap(uint32_t a, uint32_t b)
+{
+	struct rte_sampler_session *tmp = sampler_global.sched[a];
+
+	sampler_global.sched[a] = sampler_global.sched[b];
+	sampler_global.sched[b] = tmp;
+	sampler_global.sched[a]->sched_idx = a;
+	sampler_global.sched[b]->sched_idx = b;
+}
+
+static void
+sched_sift_up(uint32_t idx)
+{
+	while (idx > 0) {
+		uint32_t parent = (idx - 1) / 2;
+
+		if (sampler_global.sched[parent]->next_due <=
+		    sampler_global.sched[idx]->next_due)
+			break;
+		sched_swap(idx, parent);
+		idx = parent;
+	}
+}
+
+static void
+sched_sift_down(uint32_t idx)
+{
+	for (;;) {
+		uint32_t left = 2 * idx + 1;
+		uint32_t right = left + 1;
+		uint32_t min = idx;
+
+		if (left < sampler_global.sched_len &&
+		    sampler_global.sched[left]->next_due <
+		    sampler_global.sched[min]->next_due)
+			min = left;
+		if (right < sampler_global.sched_len &&
+		    sampler_global.sched[right]->next_due <
+		    sampler_global.sched[min]->next_due)
+			min = right;
+		if (min == idx)
+			break;
+		sched_swap(idx, min);
+		idx = min;
+	}
+}
+
+static int
+sched_push(struct rte_sampler_session *session)
+{
+	if (sampler_global.sched_len == sampler_global.sched_capacity) {
+		struct rte_sampler_session **new_sched;
+		uint32_t new_capacity = sampler_global.sched_capacity == 0 ?
+			INITIAL_SESSIONS_CAPACITY : sampler_global.sched_capacity * 2;
+
+		new_sched = rte_zmalloc(NULL,
+			new_capacity * sizeof(struct rte_sampler_session *),
+			RTE_CACHE_LINE_SIZE);
+		if (new_sched == NULL)
+			return -ENOMEM;
+
+		if (sampler_global.sched != NULL)
+			memcpy(new_sched, sampler_global.sched,
+				sampler_global.sched_len * sizeof(*new_sched));
+		rte_free(sampler_global.sched);
+		sampler_global.sched = new_sched;
+		sampler_global.sched_capacity = new_capacity;
+	}
 
+	session->sched_idx = sampler_global.sched_len;
+	sampler_global.sched[sampler_global.sched_len++] = session;
+	sched_sift_up(session->sched_idx);
+
+	return 0;
+}
+
+static void
+sched_remove(struct rte_sampler_session *session)
+{
+	uint32_t idx = session->sched_idx;
+	uint32_t last;
+
+	if (idx == SCHED_IDX_NONE)
+		return;
+
+	last = --sampler_global.sched_len;
+	if (idx != last) {
+		sched_swap(idx, last);
+		sched_sift_down(idx);
+		sched_sift_up(idx);
+	}
+	session->sched_idx = SCHED_IDX_NONE;
+}
+
+
+/**
+ * Free the dynamic arrays of a source
+ */
+static void
+source_release(struct rte_sampler_source *source)
+{
+	unsigned int j;
+
+	if (source == NULL)
+		return;
+
+	rte_free(source->xstats_names);
+	rte_free(source->ids);
+	rte_free(source->values);
+	rte_free(source->filtered_ids);
+	rte_free(source->filtered_names);
+	sampler_filter_free(source->filter);
+	rte_free(source->prev_values);
+	source->xstats_names = NULL;
+	source->ids = NULL;
+	source->values = NULL;
+	source->filtered_ids = NULL;
+	source->filtered_names = NULL;
+	source->filter = NULL;
+	source->prev_values = NULL;
+	source->xstats_count = 0;
+	source->xstats_capacity = 0;
+	source->filtered_count = 0;
+
+	/* Free filter patterns */
+	if (source->filter_patterns != NULL) {
+		for (j = 0; j < source->num_filter_patterns; j++)
+			rte_free(source->filter_patterns[j]);
+		rte_free(source->filter_patterns);
+		source->filter_patterns = NULL;
+	}
+	source->num_filter_patterns = 0;
+	source->filter_patterns_capacity = 0;
+	source->filter_active = 0;
+}
 
 struct rte_sampler_session *
 		rte_sampler_session_create(const struct rte_sampler_session_conf *conf)
+{
+	return rte_sampler_session_create_ext(conf, NULL);
+}
+
+struct rte_sampler_session *
+		rte_sampler_session_create_ext(const struct rte_sampler_session_conf *conf,
+					       const struct rte_sampler_session_ext_conf *ext_conf)
 {
 	struct rte_sampler_session *session;
 	unsigned int i;
@@ -101,7 +320,7 @@ struct rte_sampler_session *
 
 	/* Allocate initial capacity for sources and sinks */
 	session->sources = rte_zmalloc(NULL,
-		INITIAL_SOURCES_PER_SESSION * sizeof(struct rte_sampler_source),
+		INITIAL_SOURCES_PER_SESSION * sizeof(struct rte_sampler_source *),
 		RTE_CACHE_LINE_SIZE);
 	if (session->sources == NULL) {
 		rte_free(session);
@@ -110,7 +329,7 @@ struct rte_sampler_session *
 	session->sources_capacity = INITIAL_SOURCES_PER_SESSION;
 
 	session->sinks = rte_zmalloc(NULL,
-		INITIAL_SINKS_PER_SESSION * sizeof(struct rte_sampler_sink),
+		INITIAL_SINKS_PER_SESSION * sizeof(struct rte_sampler_sink *),
 		RTE_CACHE_LINE_SIZE);
 	if (session->sinks == NULL) {
 		rte_free(session->sources);
@@ -134,6 +353,24 @@ struct rte_sampler_session *
 		snprintf(session->name, sizeof(session->name), "session_%p", session);
 	}
 
+	session->ewma_shift = RTE_SAMPLER_EWMA_SHIFT_DEFAULT;
+	if (ext_conf != NULL && ext_conf->ewma_shift > 0 && ext_conf->ewma_shift < 64)
+		session->ewma_shift = ext_conf->ewma_shift;
+	if (ext_conf != NULL && ext_conf->sample_interval_us > 0)
+		session->interval_cycles = ext_conf->sample_interval_us *
+			rte_get_timer_hz() / US_PER_S;
+	else
+		session->interval_cycles = session->sample_interval_ms *
+			rte_get_timer_hz() / MS_PER_S;
+	session->sched_idx = SCHED_IDX_NONE;
+
+	if (ext_conf != NULL && ext_conf->num_workers > 0 &&
+	    session_workers_start(session, ext_conf->num_workers) != 0) {
+		rte_free(session->sinks);
+		rte_free(session->sources);
+		rte_free(session);
+		return NULL;
+	}
 	session->valid = 1;
 
 	/* Register session globally - grow array if needed */
@@ -143,6 +380,7 @@ struct rte_sampler_session *
 			INITIAL_SESSIONS_CAPACITY * sizeof(struct rte_sampler_session *),
 			RTE_CACHE_LINE_SIZE);
 		if (sampler_global.sessions == NULL) {
+			session_workers_stop(session);
 			rte_free(session->sinks);
 			rte_free(session->sources);
 			rte_free(session);
@@ -201,34 +439,25 @@ rte_sampler_session_free(struct rte_sampler_session *session)
 	if (session == NULL)
 		return;
 
-	/* Stop session if active */
-	if (session->active)
-		rte_sampler_session_stop(session);
+	/* Stop session, an expired session may still be scheduled */
+	rte_sampler_session_stop(session);
+	session_workers_stop(session);
 
 	/* Free all sources */
 	if (session->sources != NULL) {
 		for (i = 0; i < session->num_sources; i++) {
-			struct rte_sampler_source *source = &session->sources[i];
-			if (source->valid) {
-				/* Free dynamic arrays in source */
-				rte_free(source->xstats_names);
-				rte_free(source->ids);
-				rte_free(source->values);
-				rte_free(source->filtered_ids);
-				/* Free filter patterns */
-				if (source->filter_patterns != NULL) {
-					unsigned int j;
-					for (j = 0; j < source->num_filter_patterns; j++)
-						rte_free(source->filter_patterns[j]);
-					rte_free(source->filter_patterns);
-				}
-			}
+			source_release(session->sources[i]);
+			rte_free(session->sources[i]);
 		}
 		rte_free(session->sources);
 	}
 
 	/* Free all sinks */
-	rte_free(session->sinks);
+	if (session->sinks != NULL) {
+		for (i = 0; i < session->num_sinks; i++)
+			rte_free(session->sinks[i]);
+		rte_free(session->sinks);
+	}
 
 	/* Unregister from global registry */
 	for (i = 0; i < sampler_global.num_sessions; i++) {
@@ -244,31 +473,53 @@ rte_sampler_session_free(struct rte_sampler_session *session)
 }
 
 int
-		rte_sampler_session_start(struct rte_sampler_session *session, uint64_t duration)
+rte_sampler_session_start(struct rte_sampler_session *session, uint64_t duration)
 {
-if (session == NULL || !session->valid)
-return -EINVAL;
+	int ret = 0;
 
-/* Override duration if specified (0 means infinite) */
-if (duration > 0)
-	session->duration_ms = duration;
+	if (session == NULL || !session->valid)
+		return -EINVAL;
 
-session->active = 1;
-session->start_time = rte_get_timer_cycles();
-session->last_sample_time = session->start_time;
+	/* Override duration if specified (0 means infinite) */
+	if (duration > 0)
+		session->duration_ms = duration;
+
+	session->active = 1;
+	session->start_time = rte_get_timer_cycles();
+	session->last_sample_time = session->start_time;
+
+	/* Periodic sessions are scheduled by rte_sampler_poll() */
+	if (session->interval_cycles > 0) {
+		rte_spinlock_lock(&sampler_global.sched_lock);
+		sched_remove(session);
+		session->next_due = session->start_time + session->interval_cycles;
+		ret = sched_push(session);
+		rte_spinlock_unlock(&sampler_global.sched_lock);
+		if (ret < 0)
+			session->active = 0;
+	}
 
-return 0;
+	return ret;
 }
 
 int
-		rte_sampler_session_stop(struct rte_sampler_session *session)
+rte_sampler_session_stop(struct rte_sampler_session *session)
 {
-if (session == NULL || !session->valid)
-return -EINVAL;
+	if (session == NULL || !session->valid)
+		return -EINVAL;
 
-session->active = 0;
+	/* Drop session from the schedule and wait for an in-progress poll */
+	rte_spinlock_lock(&sampler_global.sched_lock);
+	sched_remove(session);
+	session->active = 0;
+	while (session->polling) {
+		rte_spinlock_unlock(&sampler_global.sched_lock);
+		rte_pause();
+		rte_spinlock_lock(&sampler_global.sched_lock);
+	}
+	rte_spinlock_unlock(&sampler_global.sched_lock);
 
-return 0;
+	return 0;
 }
 
 int
@@ -325,24 +576,24 @@ struct rte_sampler_source *
 
 	/* Find free slot or grow array */
 	for (i = 0; i < session->sources_capacity; i++) {
-		if (!session->sources[i].valid)
+		if (session->sources[i] == NULL || !session->sources[i]->valid)
 			break;
 	}
 
 	if (i >= session->sources_capacity) {
-		/* Need to grow the array */
-		struct rte_sampler_source *new_sources;
+		/* Need to grow the array, sources themselves do not move */
+		struct rte_sampler_source **new_sources;
 		unsigned int new_capacity = session->sources_capacity * 2;
 
 		new_sources = rte_zmalloc(NULL,
-			new_capacity * sizeof(struct rte_sampler_source),
+			new_capacity * sizeof(struct rte_sampler_source *),
 			RTE_CACHE_LINE_SIZE);
 		if (new_sources == NULL)
 			return NULL;
 
 		/* Copy old sources */
 		memcpy(new_sources, session->sources,
-			session->sources_capacity * sizeof(struct rte_sampler_source));
+			session->sources_capacity * sizeof(struct rte_sampler_source *));
 
 		/* Free old array and use new one */
 		rte_free(session->sources);
@@ -350,7 +601,15 @@ struct rte_sampler_source *
 		session->sources_capacity = new_capacity;
 	}
 
-	source = &session->sources[i];
+	if (session->sources[i] == NULL) {
+		session->sources[i] = rte_zmalloc(NULL,
+			sizeof(struct rte_sampler_source), RTE_CACHE_LINE_SIZE);
+		if (session->sources[i] == NULL)
+			return NULL;
+	}
+
+	source = session->sources[i];
+	source_release(source);
 	memset(source, 0, sizeof(*source));
 
 	source->session = session;
@@ -378,6 +637,7 @@ return -EINVAL;
 (void)session;
 
 source->valid = 0;
+	source_release(source);
 
 return 0;
 }
@@ -410,24 +670,24 @@ struct rte_sampler_sink *
 
 	/* Find free slot or grow array */
 	for (i = 0; i < session->sinks_capacity; i++) {
-		if (!session->sinks[i].valid)
+		if (session->sinks[i] == NULL || !session->sinks[i]->valid)
 			break;
 	}
 
 	if (i >= session->sinks_capacity) {
-		/* Need to grow the array */
-		struct rte_sampler_sink *new_sinks;
+		/* Need to grow the array, sinks themselves do not move */
+		struct rte_sampler_sink **new_sinks;
 		unsigned int new_capacity = session->sinks_capacity * 2;
 
 		new_sinks = rte_zmalloc(NULL,
-			new_capacity * sizeof(struct rte_sampler_sink),
+			new_capacity * sizeof(struct rte_sampler_sink *),
 			RTE_CACHE_LINE_SIZE);
 		if (new_sinks == NULL)
 			return NULL;
 
 		/* Copy old sinks */
 		memcpy(new_sinks, session->sinks,
-			session->sinks_capacity * sizeof(struct rte_sampler_sink));
+			session->sinks_capacity * sizeof(struct rte_sampler_sink *));
 
 		/* Free old array and use new one */
 		rte_free(session->sinks);
@@ -435,7 +695,14 @@ struct rte_sampler_sink *
 		session->sinks_capacity = new_capacity;
 	}
 
-	sink = &session->sinks[i];
+	if (session->sinks[i] == NULL) {
+		session->sinks[i] = rte_zmalloc(NULL,
+			sizeof(struct rte_sampler_sink), RTE_CACHE_LINE_SIZE);
+		if (session->sinks[i] == NULL)
+			return NULL;
+	}
+
+	sink = session->sinks[i];
 	memset(sink, 0, sizeof(*sink));
 
 	sink->session = session;
@@ -466,136 +733,428 @@ sink->valid = 0;
 return 0;
 }
 
-int
-		rte_sampler_session_process(struct rte_sampler_session *session)
+#define SAMPLER_SINK_F_TRANSFORM \
+	(RTE_SAMPLER_SINK_F_DELTA | RTE_SAMPLER_SINK_F_RATE | RTE_SAMPLER_SINK_F_EWMA)
+
+/**
+ * Compute delta, rate and EWMA of the latest values of a source
+ *
+ * Only the transforms requested by at least one sink are computed.
+ * The loops have no cross-iteration dependency so that the compiler
+ * vectorizes them over the uint64_t arrays.
+ */
+static int
+source_transform(struct rte_sampler_source *source, uint32_t flags,
+		 uint32_t ewma_shift, uint64_t now)
+{
+	const uint64_t *restrict cur = source->values;
+	uint64_t *restrict prev, *restrict delta, *restrict rate, *restrict ewma;
+	unsigned int i, n = source->filtered_count;
+	uint64_t elapsed, hz;
+
+	if (source->prev_values == NULL) {
+		/* One block for the four arrays, allocated on first use */
+		source->prev_values = rte_zmalloc(NULL,
+			4 * source->xstats_capacity * sizeof(uint64_t),
+			RTE_CACHE_LINE_SIZE);
+		if (source->prev_values == NULL)
+			return -ENOMEM;
+		source->delta_values = source->prev_values + source->xstats_capacity;
+		source->rate_values = source->delta_values + source->xstats_capacity;
+		source->ewma_values = source->rate_values + source->xstats_capacity;
+		source->have_prev = 0;
+	}
+
+	prev = source->prev_values;
+	delta = source->delta_values;
+	rate = source->rate_values;
+	ewma = source->ewma_values;
+
+	if (!source->have_prev) {
+		memset(delta, 0, n * sizeof(uint64_t));
+		memset(rate, 0, n * sizeof(uint64_t));
+		memset(ewma, 0, n * sizeof(uint64_t));
+		goto save;
+	}
+
+	/* A counter going backwards restarted from zero */
+	for (i = 0; i < n; i++)
+		delta[i] = cur[i] >= prev[i] ? cur[i] - prev[i] : cur[i];
+
+	if (flags & (RTE_SAMPLER_SINK_F_RATE | RTE_SAMPLER_SINK_F_EWMA)) {
+		elapsed = now - source->prev_time;
+		hz = rte_get_timer_hz();
+		for (i = 0; i < n; i++)
+			rate[i] = elapsed > 0 ? (uint64_t)((double)delta[i] * hz / elapsed) : 0;
+	}
+
+	if (flags & RTE_SAMPLER_SINK_F_EWMA) {
+		for (i = 0; i < n; i++)
+			ewma[i] = (uint64_t)((int64_t)ewma[i] +
+				(((int64_t)rate[i] - (int64_t)ewma[i]) >> ewma_shift));
+	}
+
+save:
+	memcpy(prev, cur, n * sizeof(uint64_t));
+	source->prev_time = now;
+	source->have_prev = 1;
+
+	return 0;
+}
+
+/**
+ * Select the values array to pass to a sink
+ */
+static const uint64_t *
+sink_values(const struct rte_sampler_sink *sink,
+	    const struct rte_sampler_source *source, int transformed)
+{
+	if (!transformed)
+		return source->values;
+	if (sink->ops.flags & RTE_SAMPLER_SINK_F_EWMA)
+		return source->ewma_values;
+	if (sink->ops.flags & RTE_SAMPLER_SINK_F_RATE)
+		return source->rate_values;
+	if (sink->ops.flags & RTE_SAMPLER_SINK_F_DELTA)
+		return source->delta_values;
+	return source->values;
+}
+
+/**
+ * Read the xstats values of a source, getting its names on first use
+ */
+static int
+source_read_values(struct rte_sampler_source *source)
 {
-	unsigned int i, j;
 	int ret;
 
-	if (session == NULL || !session->valid)
-		return -EINVAL;
+	/* Get xstats names if not already cached */
+	if (source->xstats_count == 0) {
+		/* First, query the size */
+		ret = source->ops.xstats_names_get(
+			source->source_id,
+			NULL,
+			NULL,
+			0,
+			source->user_data);
+		if (ret < 0)
+			return -1;
+
+		if (ret == 0)
+			return -1;
+
+		/* Allocate arrays based on actual size needed */
+		source->xstats_capacity = ret;
+		source->xstats_names = rte_zmalloc(NULL,
+			ret * sizeof(struct rte_sampler_xstats_name),
+			RTE_CACHE_LINE_SIZE);
+		if (source->xstats_names == NULL)
+			return -1;
 
-	/* Sample from all sources */
-	for (i = 0; i < session->num_sources; i++) {
-		struct rte_sampler_source *source = &session->sources[i];
+		source->ids = rte_zmalloc(NULL,
+			ret * sizeof(uint64_t),
+			RTE_CACHE_LINE_SIZE);
+		if (source->ids == NULL) {
+			rte_free(source->xstats_names);
+			source->xstats_names = NULL;
+			return -1;
+		}
 
-		if (!source->valid)
-			continue;
+		source->values = rte_zmalloc(NULL,
+			ret * sizeof(uint64_t),
+			RTE_CACHE_LINE_SIZE);
+		if (source->values == NULL) {
+			rte_free(source->xstats_names);
+			rte_free(source->ids);
+			source->xstats_names = NULL;
+			source->ids = NULL;
+			return -1;
+		}
 
-		/* Get xstats names if not already cached */
-		if (source->xstats_count == 0) {
-			/* First, query the size */
-			ret = source->ops.xstats_names_get(
-				source->source_id,
-				NULL,
-				NULL,
-				0,
-				source->user_data);
-			if (ret < 0)
-				continue;
+		source->filtered_ids = rte_zmalloc(NULL,
+			ret * sizeof(uint64_t),
+			RTE_CACHE_LINE_SIZE);
+		source->filtered_names = rte_zmalloc(NULL,
+			ret * sizeof(struct rte_sampler_xstats_name),
+			RTE_CACHE_LINE_SIZE);
+		if (source->filtered_ids == NULL || source->filtered_names == NULL) {
+			rte_free(source->filtered_ids);
+			rte_free(source->filtered_names);
+			source->filtered_ids = NULL;
+			source->filtered_names = NULL;
+			rte_free(source->xstats_names);
+			rte_free(source->ids);
+			rte_free(source->values);
+			source->xstats_names = NULL;
+			source->ids = NULL;
+			source->values = NULL;
+			return -1;
+		}
 
-			if (ret == 0)
-				continue;
+		/* Now get the actual names and IDs */
+		ret = source->ops.xstats_names_get(
+			source->source_id,
+			source->xstats_names,
+			source->ids,
+			source->xstats_capacity,
+			source->user_data);
+		if (ret < 0) {
+			rte_free(source->xstats_names);
+			rte_free(source->ids);
+			rte_free(source->values);
+			rte_free(source->filtered_ids);
+			rte_free(source->filtered_names);
+			source->xstats_names = NULL;
+			source->ids = NULL;
+			source->values = NULL;
+			source->filtered_ids = NULL;
+			source->filtered_names = NULL;
+			source->xstats_capacity = 0;
+			return -1;
+		}
 
-			/* Allocate arrays based on actual size needed */
-			source->xstats_capacity = ret;
-			source->xstats_names = rte_zmalloc(NULL,
-				ret * sizeof(struct rte_sampler_xstats_name),
-				RTE_CACHE_LINE_SIZE);
-			if (source->xstats_names == NULL)
-				continue;
+		source->xstats_count = ret;
 
-			source->ids = rte_zmalloc(NULL,
-				ret * sizeof(uint64_t),
-				RTE_CACHE_LINE_SIZE);
-			if (source->ids == NULL) {
-				rte_free(source->xstats_names);
-				source->xstats_names = NULL;
-				continue;
-			}
-
-			source->values = rte_zmalloc(NULL,
-				ret * sizeof(uint64_t),
-				RTE_CACHE_LINE_SIZE);
-			if (source->values == NULL) {
-				rte_free(source->xstats_names);
-				rte_free(source->ids);
-				source->xstats_names = NULL;
-				source->ids = NULL;
-				continue;
-			}
-
-			source->filtered_ids = rte_zmalloc(NULL,
-				ret * sizeof(uint64_t),
-				RTE_CACHE_LINE_SIZE);
-			if (source->filtered_ids == NULL) {
-				rte_free(source->xstats_names);
-				rte_free(source->ids);
-				rte_free(source->values);
-				source->xstats_names = NULL;
-				source->ids = NULL;
-				source->values = NULL;
-				continue;
-			}
-
-			/* Now get the actual names and IDs */
-			ret = source->ops.xstats_names_get(
-				source->source_id,
-				source->xstats_names,
-				source->ids,
-				source->xstats_capacity,
-				source->user_data);
-			if (ret < 0) {
-				rte_free(source->xstats_names);
-				rte_free(source->ids);
-				rte_free(source->values);
-				rte_free(source->filtered_ids);
-				source->xstats_names = NULL;
-				source->ids = NULL;
-				source->values = NULL;
-				source->filtered_ids = NULL;
-				source->xstats_capacity = 0;
-				continue;
-			}
+		/* Apply filter to determine which stats to sample */
+		apply_filter(source);
+	}
 
-			source->xstats_count = ret;
+	/* Get xstats values (using filtered IDs if filter is active) */
+	source->sample_tsc = rte_get_tsc_cycles();
+	if (source->filtered_count > 0) {
+		ret = source->ops.xstats_get(
+			source->source_id,
+			source->filtered_ids,
+			source->values,
+			source->filtered_count,
+			source->user_data);
+		if (ret < 0)
+			return -1;
+	}
 
-			/* Apply filter to determine which stats to sample */
-			apply_filter(source);
+	return 0;
+}
+
+/**
+ * Read the xstats of a source, and transform them if needed
+ *
+ * Called for each source at each tick, by the session workers if any.
+ */
+static void
+source_read(struct rte_sampler_session *session,
+	    struct rte_sampler_source *source, uint32_t xform_flags)
+{
+	if (source_read_values(source) < 0)
+		return;
+
+	source->transformed = 0;
+	if (xform_flags != 0)
+		source->transformed = source_transform(source, xform_flags,
+			session->ewma_shift, rte_get_timer_cycles()) == 0;
+	source->sampled = 1;
+}
+
+/**
+ * Read the sources of the current tick not yet claimed by another thread
+ */
+static void
+session_read_sources(struct rte_sampler_session *session)
+{
+	struct sampler_workers *workers = session->workers;
+	unsigned int i;
+
+	while ((i = rte_atomic_fetch_add_explicit(&workers->next_source, 1,
+			rte_memory_order_relaxed)) < session->num_sources) {
+		struct rte_sampler_source *source = session->sources[i];
+
+		if (source != NULL && source->valid)
+			source_read(session, source, workers->xform_flags);
+	}
+}
+
+static uint32_t
+sampler_worker_main(void *arg)
+{
+	struct rte_sampler_session *session = arg;
+	struct sampler_workers *workers = session->workers;
+	uint64_t seen_tick = 0;
+
+	for (;;) {
+		pthread_mutex_lock(&workers->lock);
+		while (!workers->stop && workers->tick == seen_tick)
+			pthread_cond_wait(&workers->tick_cond, &workers->lock);
+		if (workers->stop) {
+			pthread_mutex_unlock(&workers->lock);
+			break;
 		}
+		seen_tick = workers->tick;
+		pthread_mutex_unlock(&workers->lock);
 
-		/* Get xstats values (using filtered IDs if filter is active) */
-		if (source->filtered_count > 0) {
-			ret = source->ops.xstats_get(
-				source->source_id,
-				source->filtered_ids,
-				source->values,
-				source->filtered_count,
-				source->user_data);
-			if (ret < 0)
-				continue;
+		session_read_sources(session);
+
+		pthread_mutex_lock(&workers->lock);
+		if (--workers->pending == 0)
+			pthread_cond_signal(&workers->done_cond);
+		pthread_mutex_unlock(&workers->lock);
+	}
+
+	return 0;
+}
+
+static void
+session_workers_stop(struct rte_sampler_session *session)
+{
+	struct sampler_workers *workers = session->workers;
+	unsigned int i;
+
+	if (workers == NULL)
+		return;
+
+	pthread_mutex_lock(&workers->lock);
+	workers->stop = 1;
+	pthread_cond_broadcast(&workers->tick_cond);
+	pthread_mutex_unlock(&workers->lock);
+
+	for (i = 0; i < workers->num_threads; i++)
+		rte_thread_join(workers->threads[i], NULL);
+
+	pthread_cond_destroy(&workers->done_cond);
+	pthread_cond_destroy(&workers->tick_cond);
+	pthread_mutex_destroy(&workers->lock);
+	rte_free(workers);
+	session->workers = NULL;
+}
+
+static int
+session_workers_start(struct rte_sampler_session *session,
+		      unsigned int num_threads)
+{
+	struct sampler_workers *workers;
+	char name[RTE_THREAD_INTERNAL_NAME_SIZE];
+	int ret;
+
+	workers = rte_zmalloc(NULL, sizeof(*workers) +
+		num_threads * sizeof(rte_thread_t), RTE_CACHE_LINE_SIZE);
+	if (workers == NULL)
+		return -ENOMEM;
+
+	pthread_mutex_init(&workers->lock, NULL);
+	pthread_cond_init(&workers->tick_cond, NULL);
+	pthread_cond_init(&workers->done_cond, NULL);
+	session->workers = workers;
+
+	for (; workers->num_threads < num_threads; workers->num_threads++) {
+		snprintf(name, sizeof(name), "smpl-%u", workers->num_threads);
+		ret = rte_thread_create_internal_control(
+			&workers->threads[workers->num_threads], name,
+			sampler_worker_main, session);
+		if (ret != 0) {
+			RTE_LOG(ERR, USER1,
+				"Failed to create sampler worker thread: %d\n", ret);
+			session_workers_stop(session);
+			return ret;
 		}
+	}
+
+	return 0;
+}
+
+/**
+ * Read all the sources of a session, in parallel if it has workers
+ *
+ * Returns once all the sources are read, so that sinks run after
+ * a barrier and see the values of a single tick.
+ */
+static void
+session_read(struct rte_sampler_session *session, uint32_t xform_flags)
+{
+	struct sampler_workers *workers = session->workers;
+	unsigned int i;
+
+	for (i = 0; i < session->num_sources; i++) {
+		if (session->sources[i] != NULL)
+			session->sources[i]->sampled = 0;
+	}
+
+	if (workers == NULL || session->num_sources < 2) {
+		for (i = 0; i < session->num_sources; i++) {
+			struct rte_sampler_source *source = session->sources[i];
+
+			if (source != NULL && source->valid)
+				source_read(session, source, xform_flags);
+		}
+		return;
+	}
+
+	workers->xform_flags = xform_flags;
+	rte_atomic_store_explicit(&workers->next_source, 0,
+		rte_memory_order_relaxed);
+
+	pthread_mutex_lock(&workers->lock);
+	workers->pending = workers->num_threads;
+	workers->tick++;
+	pthread_cond_broadcast(&workers->tick_cond);
+	pthread_mutex_unlock(&workers->lock);
+
+	/* The calling thread reads sources too */
+	session_read_sources(session);
+
+	/* Tick barrier */
+	pthread_mutex_lock(&workers->lock);
+	while (workers->pending > 0)
+		pthread_cond_wait(&workers->done_cond, &workers->lock);
+	pthread_mutex_unlock(&workers->lock);
+}
+
+int
+		rte_sampler_session_process(struct rte_sampler_session *session)
+{
+	uint32_t xform_flags = 0;
+	unsigned int i, j;
+	int ret;
+
+	if (session == NULL || !session->valid)
+		return -EINVAL;
+
+	/* Transforms needed by at least one sink */
+	for (j = 0; j < session->num_sinks; j++) {
+		if (session->sinks[j] != NULL && session->sinks[j]->valid)
+			xform_flags |= session->sinks[j]->ops.flags;
+	}
+	xform_flags &= SAMPLER_SINK_F_TRANSFORM;
+
+	/* Sample from all sources */
+	session_read(session, xform_flags);
+
+	for (i = 0; i < session->num_sources; i++) {
+		struct rte_sampler_source *source = session->sources[i];
+
+		if (source == NULL || !source->valid || !source->sampled)
+			continue;
+
+		/* Sinks stamp the values with the read time of the source */
+		session->sample_tsc = source->sample_tsc;
 
 		/* Send to all sinks */
 		for (j = 0; j < session->num_sinks; j++) {
-			struct rte_sampler_sink *sink = &session->sinks[j];
+			struct rte_sampler_sink *sink = session->sinks[j];
 			const struct rte_sampler_xstats_name *names_to_pass;
 
-if (!sink->valid)
+if (sink == NULL || !sink->valid)
 continue;
 
 /* Optimization: don't pass names if sink doesn't want them */
 if (sink->ops.flags & RTE_SAMPLER_SINK_F_NO_NAMES)
 names_to_pass = NULL;
 else
-names_to_pass = source->xstats_names;
+names_to_pass = source->filtered_names;
 
 ret = sink->ops.output(
 source->name,
 source->source_id,
 names_to_pass,
 source->filtered_ids,
-source->values,
+sink_values(sink, source, source->transformed),
 source->filtered_count,
 sink->user_data);
 if (ret < 0) {
@@ -611,39 +1170,130 @@ session->last_sample_time = rte_get_timer_cycles();
 return 0;
 }
 
+uint64_t
+rte_sampler_session_get_sample_tsc(const struct rte_sampler_session *session)
+{
+	if (session == NULL || !session->valid)
+		return 0;
+
+	return session->sample_tsc;
+}
+
 int
 rte_sampler_poll(void)
 {
-unsigned int i;
-int polled = 0;
-uint64_t current_time, elapsed_ms;
+	struct rte_sampler_session *due[SAMPLER_POLL_BURST];
+	struct rte_sampler_session *session;
+	unsigned int i, n;
+	uint64_t now;
+	int polled = 0;
+
+	now = rte_get_timer_cycles();
+	do {
+		/* Take the due sessions off the schedule */
+		n = 0;
+		rte_spinlock_lock(&sampler_global.sched_lock);
+		while (n < RTE_DIM(due) && sampler_global.sched_len > 0 &&
+		       sampler_global.sched[0]->next_due <= now) {
+			session = sampler_global.sched[0];
+			sched_remove(session);
+
+			/* Expired sessions are dropped from the schedule */
+			if (rte_sampler_session_is_active(session) != 1)
+				continue;
 
-for (i = 0; i < sampler_global.num_sessions; i++) {
-struct rte_sampler_session *session = sampler_global.sessions[i];
+			session->polling = 1;
+			due[n++] = session;
+		}
+		rte_spinlock_unlock(&sampler_global.sched_lock);
 
-if (session == NULL || !session->valid)
-continue;
+		/* Sources and sinks run without holding the schedule lock */
+		for (i = 0; i < n; i++)
+			rte_sampler_session_process(due[i]);
+		polled += n;
 
-/* Skip inactive sessions */
-if (!rte_sampler_session_is_active(session))
-continue;
+		rte_spinlock_lock(&sampler_global.sched_lock);
+		for (i = 0; i < n; i++) {
+			session = due[i];
+			session->polling = 0;
 
-/* Skip manual sessions (interval == 0) */
-if (session->sample_interval_ms == 0)
-continue;
+			/* Stopped or restarted while being processed */
+			if (!session->active ||
+			    session->sched_idx != SCHED_IDX_NONE)
+				continue;
 
-/* Check if it's time to sample */
-current_time = rte_get_timer_cycles();
-elapsed_ms = (current_time - session->last_sample_time) * 1000 /
-     rte_get_timer_hz();
+			/* Skip missed periods rather than sampling in a burst */
+			session->next_due += session->interval_cycles;
+			if (session->next_due <= now)
+				session->next_due = now + session->interval_cycles;
+			if (sched_push(session) < 0)
+				session->active = 0;
+		}
+		rte_spinlock_unlock(&sampler_global.sched_lock);
+	} while (n == RTE_DIM(due));
+
+	return polled;
+}
+
+static int32_t
+sampler_service_func(void *args)
+{
+	RTE_SET_USED(args);
 
-if (elapsed_ms >= session->sample_interval_ms) {
-rte_sampler_session_process(session);
-polled++;
+	return rte_sampler_poll() > 0 ? 0 : -EAGAIN;
 }
+
+int
+rte_sampler_service_register(uint32_t *service_id)
+{
+	struct rte_service_spec service = {
+		.callback = sampler_service_func,
+		.callback_userdata = NULL,
+		.capabilities = RTE_SERVICE_CAP_MT_SAFE,
+		.socket_id = SOCKET_ID_ANY
+	};
+	int ret;
+
+	if (sampler_global.service_registered)
+		return -EEXIST;
+
+	snprintf(service.name, sizeof(service.name), SAMPLER_SERVICE_NAME);
+
+	ret = rte_service_component_register(&service, &sampler_global.service_id);
+	if (ret < 0) {
+		RTE_LOG(ERR, USER1, "Failed to register sampler service: %d\n", ret);
+		return ret;
+	}
+
+	ret = rte_service_component_runstate_set(sampler_global.service_id, 1);
+	if (ret < 0) {
+		rte_service_component_unregister(sampler_global.service_id);
+		return ret;
+	}
+
+	sampler_global.service_registered = 1;
+	if (service_id != NULL)
+		*service_id = sampler_global.service_id;
+
+	return 0;
 }
 
-return polled;
+int
+rte_sampler_service_unregister(void)
+{
+	int ret;
+
+	if (!sampler_global.service_registered)
+		return -ENOENT;
+
+	rte_service_component_runstate_set(sampler_global.service_id, 0);
+	ret = rte_service_component_unregister(sampler_global.service_id);
+	if (ret < 0)
+		return ret;
+
+	sampler_global.service_registered = 0;
+
+	return 0;
 }
 
 int
@@ -675,9 +1325,9 @@ return i;
 
 /* Get from all sources */
 for (i = 0; i < session->num_sources; i++) {
-struct rte_sampler_source *src = &session->sources[i];
+struct rte_sampler_source *src = session->sources[i];
 
-if (!src->valid)
+if (src == NULL || !src->valid)
 continue;
 
 if (xstats_names != NULL) {
@@ -734,9 +1384,9 @@ return n;
 
 /* Get from all sources */
 for (i = 0; i < session->num_sources; i++) {
-struct rte_sampler_source *src = &session->sources[i];
+struct rte_sampler_source *src = session->sources[i];
 
-if (!src->valid)
+if (src == NULL || !src->valid)
 continue;
 
 for (j = 0; j < src->xstats_count; j++) {
@@ -785,9 +1435,9 @@ return 0;
 
 /* Reset all sources */
 for (i = 0; i < session->num_sources; i++) {
-struct rte_sampler_source *src = &session->sources[i];
+struct rte_sampler_source *src = session->sources[i];
 
-if (!src->valid)
+if (src == NULL || !src->valid)
 continue;
 
 if (src->ops.xstats_reset != NULL) {
@@ -828,86 +1478,39 @@ return 0;
 return -ENOENT;
 }
 
-/**
- * Simple wildcard pattern matching
- * Supports * (match any) and ? (match one character)
- */
-static int
-		match_pattern(const char *pattern, const char *str)
-{
-while (*pattern && *str) {
-if (*pattern == '*') {
-/* Skip consecutive asterisks */
-while (*(pattern + 1) == '*')
-pattern++;
-
-/* If asterisk is last character, match */
-if (!*(pattern + 1))
-return 1;
-
-/* Try matching rest of pattern with rest of string */
-while (*str) {
-if (match_pattern(pattern + 1, str))
-return 1;
-str++;
-}
-return 0;
-} else if (*pattern == '?' || *pattern == *str) {
-pattern++;
-str++;
-} else {
-return 0;
-}
-}
-
-/* Handle trailing asterisks */
-while (*pattern == '*')
-pattern++;
-
-return (*pattern == '\0' && *str == '\0');
-}
-
-/**
- * Check if a stat name matches any filter pattern
- */
-static int
-		matches_filter(struct rte_sampler_source *source, const char *name)
-{
-unsigned int i;
-
-if (!source->filter_active || source->num_filter_patterns == 0)
-return 1;  /* No filter, include all */
-
-for (i = 0; i < source->num_filter_patterns; i++) {
-if (match_pattern(source->filter_patterns[i], name))
-return 1;
-}
-
-return 0;
-}
-
 /**
  * Apply filter to cached xstats
+ *
+ * Builds the IDs and names to sample from the compiled filter. This only
+ * runs when the filter changes or when the source stats are discovered,
+ * never on the sampling path.
+ *
+ * The xstats set of a source is only discovered once, so filtered_ids is
+ * the precomputed match set of the source and no separate ID bitset is
+ * kept. Should sources be rediscovered when their xstats count changes,
+ * that is where this must be called again.
  */
 static void
-		apply_filter(struct rte_sampler_source *source)
+apply_filter(struct rte_sampler_source *source)
 {
-unsigned int i, j;
+	unsigned int i, j;
 
-if (!source->filter_active) {
-source->filtered_count = source->xstats_count;
-for (i = 0; i < source->xstats_count; i++)
-source->filtered_ids[i] = source->ids[i];
-return;
-}
+	/* Values are reordered, restart the transform stage */
+	source->have_prev = 0;
 
-j = 0;
-for (i = 0; i < source->xstats_count; i++) {
-if (matches_filter(source, source->xstats_names[i].name)) {
-source->filtered_ids[j++] = source->ids[i];
-}
-}
-source->filtered_count = j;
+	if (source->filtered_ids == NULL || source->filtered_names == NULL)
+		return;
+
+	j = 0;
+	for (i = 0; i < source->xstats_count; i++) {
+		if (source->filter_active &&
+		    !sampler_filter_match(source->filter, source->xstats_names[i].name))
+			continue;
+		source->filtered_ids[j] = source->ids[i];
+		source->filtered_names[j] = source->xstats_names[i];
+		j++;
+	}
+	source->filtered_count = j;
 }
 
 int
@@ -959,6 +1562,15 @@ int
 		source->num_filter_patterns++;
 	}
 
+	/* Compile patterns once, matching is then a walk along each name */
+	sampler_filter_free(source->filter);
+	source->filter = sampler_filter_compile(
+		(const char * const *)source->filter_patterns, num_patterns);
+	if (source->filter == NULL) {
+		rte_sampler_source_clear_filter(source);
+		return -ENOMEM;
+	}
+
 	source->filter_active = 1;
 
 	/* Apply filter to existing stats */
@@ -969,28 +1581,28 @@ int
 }
 
 int
-		rte_sampler_source_clear_filter(struct rte_sampler_source *source)
+rte_sampler_source_clear_filter(struct rte_sampler_source *source)
 {
-unsigned int i;
+	unsigned int i;
 
-if (source == NULL || !source->valid)
-return -EINVAL;
+	if (source == NULL || !source->valid)
+		return -EINVAL;
 
-/* Free all patterns */
-for (i = 0; i < source->num_filter_patterns; i++) {
-rte_free(source->filter_patterns[i]);
-source->filter_patterns[i] = NULL;
-}
+	/* Free all patterns */
+	for (i = 0; i < source->num_filter_patterns; i++) {
+		rte_free(source->filter_patterns[i]);
+		source->filter_patterns[i] = NULL;
+	}
 
-source->num_filter_patterns = 0;
-source->filter_active = 0;
-source->filtered_count = source->xstats_count;
+	source->num_filter_patterns = 0;
+	source->filter_active = 0;
+	sampler_filter_free(source->filter);
+	source->filter = NULL;
 
-/* Reset filtered IDs to include all */
-for (i = 0; i < source->xstats_count; i++)
-source->filtered_ids[i] = source->ids[i];
+	/* Reset filtered IDs to include all */
+	apply_filter(source);
 
-return 0;
+	return 0;
 }
 
 int
@@ -1030,3 +1642,21 @@ rte_sampler_source_get_xstats_count(struct rte_sampler_source *source)
 
 	return source->xstats_count;
 }
+
+void *
+rte_sampler_source_get_user_data(struct rte_sampler_source *source)
+{
+	if (source == NULL || !source->valid)
+		return NULL;
+
+	return source->user_data;
+}
+
+void *
+rte_sampler_sink_get_user_data(struct rte_sampler_sink *sink)
+{
+	if (sink == NULL || !sink->valid)
+		return NULL;
+
+	return sink->user_data;
+}
@@ -23,6 +23,7 @@
 
 #include <stdint.h>
 #include <rte_common.h>
+#include <rte_compat.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -39,6 +40,15 @@ extern "C" {
  */
 #define RTE_SAMPLER_SINK_F_NO_NAMES  0x0001
 /**< Don't pass stat names to sink (optimization to avoid large data transfer) */
+#define RTE_SAMPLER_SINK_F_DELTA     0x0002
+/**< Pass the change of each stat since the previous sample instead of its value */
+#define RTE_SAMPLER_SINK_F_RATE      0x0004
+/**< Pass the per-second rate of each stat over the last interval */
+#define RTE_SAMPLER_SINK_F_EWMA      0x0008
+/**< Pass the exponentially weighted moving average of the per-second rate */
+
+/** Default EWMA weight shift, the new rate is weighted 1/2^shift */
+#define RTE_SAMPLER_EWMA_SHIFT_DEFAULT 3
 
 /**
  * Sampler xstats name structure
@@ -74,6 +84,24 @@ struct rte_sampler_session_conf {
 	const char *name;             /**< Optional session name for identification */
 };
 
+/**
+ * Extended session configuration
+ *
+ * Passed to rte_sampler_session_create_ext() along with the session
+ * configuration, for the settings added after it.
+ */
+struct rte_sampler_session_ext_conf {
+	uint64_t sample_interval_us;  /**< Sampling interval in microseconds, overrides
+				       *   sample_interval_ms if non-zero
+				       */
+	uint32_t ewma_shift;          /**< EWMA weight 1/2^shift for RTE_SAMPLER_SINK_F_EWMA
+				       *   (0 = RTE_SAMPLER_EWMA_SHIFT_DEFAULT)
+				       */
+	uint32_t num_workers;         /**< Control threads reading the sources in parallel
+				       *   with the processing thread (0 = serial reads)
+				       */
+};
+
 /**
  * Sample data structure
  */
@@ -329,6 +357,14 @@ typedef int (*rte_sampler_sink_stop_t)(void *user_data);
 
 /**
  * Sampler sink operations structure
+ *
+ * By default a sink receives the raw, cumulative values of the stats.
+ * With one of RTE_SAMPLER_SINK_F_DELTA, RTE_SAMPLER_SINK_F_RATE or
+ * RTE_SAMPLER_SINK_F_EWMA, the session computes the transformed values once
+ * per source and sample, and passes them to the sink instead.
+ * On the first sample of a source, or after its stats set changed,
+ * transformed values are zero. A counter going backwards (e.g. reset)
+ * is treated as restarting from zero.
  */
 struct rte_sampler_sink_ops {
 	rte_sampler_sink_output_t output;               /**< Output callback */
@@ -363,6 +399,28 @@ struct rte_sampler_session *rte_sampler_session_create(
 const struct rte_sampler_session_conf *conf)
 __rte_malloc __rte_dealloc(rte_sampler_session_free, 1);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Allocate a sampler session with extended configuration
+ *
+ * @param conf
+ *   Pointer to session configuration. If NULL, uses default config
+ *   (manual sampling, infinite duration).
+ * @param ext_conf
+ *   Pointer to extended session configuration. If NULL, same as
+ *   rte_sampler_session_create().
+ * @return
+ *   - Pointer to session structure on success
+ *   - NULL on error (zmalloc failure, worker threads creation failure)
+ */
+__rte_experimental
+struct rte_sampler_session *rte_sampler_session_create_ext(
+const struct rte_sampler_session_conf *conf,
+const struct rte_sampler_session_ext_conf *ext_conf)
+__rte_malloc __rte_dealloc(rte_sampler_session_free, 1);
+
 /**
  * Start a sampling session
  *
@@ -382,6 +440,9 @@ int rte_sampler_session_start(struct rte_sampler_session *session, uint64_t dura
  * Stop a sampling session
  *
  * Stops automatic sampling and marks the session as inactive.
+ * If the session is being processed by rte_sampler_poll() on another
+ * thread, waits for that to complete. Must not be called from a source
+ * or sink callback of the session.
  *
  * @param session
  *   Pointer to session structure
@@ -497,6 +558,12 @@ int rte_sampler_session_unregister_sink(struct rte_sampler_session *session,
  * automatically for sessions with non-zero sample_interval_ms after calling
  * rte_sampler_session_start().
  *
+ * All the sources are read first, then the sinks are called.
+ * If the session has num_workers (see rte_sampler_session_ext_conf),
+ * the sources are read in parallel by its
+ * worker threads and the calling thread, so that slow sources do not delay
+ * each other.
+ *
  * @param session
  *   Pointer to session structure
  * @return
@@ -504,6 +571,26 @@ int rte_sampler_session_unregister_sink(struct rte_sampler_session *session,
  */
 int rte_sampler_session_process(struct rte_sampler_session *session);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the TSC timestamp of the current sample
+ *
+ * While rte_sampler_session_process() runs, the raw TSC is read right
+ * before the values of each source are read. Sink output callbacks,
+ * which run once all the sources are read, get the TSC of the source
+ * being delivered. They call this function to stamp the values they receive, so that samples of
+ * different sources and sessions can be lined up at cycle granularity.
+ *
+ * @param session
+ *   Pointer to session structure
+ * @return
+ *   TSC of the last source read of the session, zero if none
+ */
+__rte_experimental
+uint64_t rte_sampler_session_get_sample_tsc(const struct rte_sampler_session *session);
+
 /**
  * Poll all active sessions for automatic sampling
  *
@@ -511,11 +598,50 @@ int rte_sampler_session_process(struct rte_sampler_session *session);
  * automatic sampling for sessions that have sample_interval_ms > 0.
  * It's a no-op for manual sessions.
  *
+ * Started periodic sessions are kept ordered by their next due time,
+ * so a poll where no session is due only checks the earliest one.
+ * The due sessions are taken off the schedule under a lock and their
+ * sources and sinks are run without it, so concurrent polls can process
+ * different sessions in parallel.
+ *
  * @return
  *   Number of sessions polled, or negative on error
  */
 int rte_sampler_poll(void);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Register the sampler as a service component
+ *
+ * Instead of calling rte_sampler_poll() from the application main loop,
+ * periodic sessions can be sampled by a service core. Once registered,
+ * the application maps the service to a service lcore and enables it
+ * with the rte_service API. The service component run state is set.
+ *
+ * @param service_id
+ *   Pointer to store the service ID (can be NULL)
+ * @return
+ *   Zero on success, -EEXIST if already registered, negative on error
+ */
+__rte_experimental
+int rte_sampler_service_register(uint32_t *service_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Unregister the sampler service component
+ *
+ * The service must be stopped on all service lcores before this call.
+ *
+ * @return
+ *   Zero on success, -ENOENT if not registered, negative on error
+ */
+__rte_experimental
+int rte_sampler_service_unregister(void);
+
 /**
  * Get xstats names from session
  *
@@ -656,6 +782,40 @@ int rte_sampler_source_get_filter(struct rte_sampler_source *source,
  */
 int rte_sampler_source_get_xstats_count(struct rte_sampler_source *source);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the user data of a source
+ *
+ * Allows source implementations to retrieve their private data, e.g. to
+ * release it when the source is unregistered.
+ *
+ * @param source
+ *   Pointer to source structure
+ * @return
+ *   User data passed at registration, or NULL if source is invalid
+ */
+__rte_experimental
+void *rte_sampler_source_get_user_data(struct rte_sampler_source *source);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the user data of a sink
+ *
+ * Allows sink implementations to retrieve their private data from the
+ * sink pointer, without a lookup of their own.
+ *
+ * @param sink
+ *   Pointer to sink structure
+ * @return
+ *   User data passed at registration, or NULL if sink is invalid
+ */
+__rte_experimental
+void *rte_sampler_sink_get_user_data(struct rte_sampler_sink *sink);
+
 #ifdef __cplusplus
 }
 #endif
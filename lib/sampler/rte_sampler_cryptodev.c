@@ -0,0 +1,159 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <rte_common.h>
+#include <rte_cryptodev.h>
+#include <rte_string_fns.h>
+#include <rte_sampler.h>
+#include <rte_sampler_cryptodev.h>
+
+/* Stat IDs, in the order of cryptodev_stat_names */
+enum {
+	CRYPTODEV_STAT_ENQUEUED,
+	CRYPTODEV_STAT_DEQUEUED,
+	CRYPTODEV_STAT_ENQUEUE_ERR,
+	CRYPTODEV_STAT_DEQUEUE_ERR,
+	CRYPTODEV_STAT_QP_ACTIVE,
+	CRYPTODEV_STAT_MAX,
+};
+
+static const char * const cryptodev_stat_names[CRYPTODEV_STAT_MAX] = {
+	[CRYPTODEV_STAT_ENQUEUED] = "enqueued_count",
+	[CRYPTODEV_STAT_DEQUEUED] = "dequeued_count",
+	[CRYPTODEV_STAT_ENQUEUE_ERR] = "enqueue_err_count",
+	[CRYPTODEV_STAT_DEQUEUE_ERR] = "dequeue_err_count",
+	[CRYPTODEV_STAT_QP_ACTIVE] = "active_qp_count",
+};
+
+/**
+ * Count queue pairs which are set up
+ */
+static uint64_t
+cryptodev_active_qps(uint8_t dev_id)
+{
+	uint16_t qp, nb_qps = rte_cryptodev_queue_pair_count(dev_id);
+	uint64_t active = 0;
+
+	for (qp = 0; qp < nb_qps; qp++) {
+		if (rte_cryptodev_get_qp_status(dev_id, qp) == 1)
+			active++;
+	}
+
+	return active;
+}
+
+/**
+ * Cryptodev xstats_names_get callback
+ */
+static int
+cryptodev_xstats_names_get(uint16_t source_id,
+		struct rte_sampler_xstats_name *xstats_names,
+		uint64_t *ids,
+		unsigned int size,
+		void *user_data)
+{
+	unsigned int i;
+
+	RTE_SET_USED(source_id);
+	RTE_SET_USED(user_data);
+
+	if (xstats_names == NULL || ids == NULL)
+		return CRYPTODEV_STAT_MAX;
+
+	for (i = 0; i < CRYPTODEV_STAT_MAX && i < size; i++) {
+		rte_strscpy(xstats_names[i].name, cryptodev_stat_names[i],
+			    RTE_SAMPLER_XSTATS_NAME_SIZE);
+		ids[i] = i;
+	}
+
+	return CRYPTODEV_STAT_MAX;
+}
+
+/**
+ * Cryptodev xstats_get callback
+ */
+static int
+cryptodev_xstats_get(uint16_t source_id,
+		const uint64_t *ids,
+		uint64_t *values,
+		unsigned int n,
+		void *user_data)
+{
+	struct rte_cryptodev_stats stats;
+	unsigned int i;
+	int ret;
+
+	RTE_SET_USED(user_data);
+
+	ret = rte_cryptodev_stats_get((uint8_t)source_id, &stats);
+	if (ret < 0)
+		return ret;
+
+	for (i = 0; i < n; i++) {
+		switch (ids[i]) {
+		case CRYPTODEV_STAT_ENQUEUED:
+			values[i] = stats.enqueued_count;
+			break;
+		case CRYPTODEV_STAT_DEQUEUED:
+			values[i] = stats.dequeued_count;
+			break;
+		case CRYPTODEV_STAT_ENQUEUE_ERR:
+			values[i] = stats.enqueue_err_count;
+			break;
+		case CRYPTODEV_STAT_DEQUEUE_ERR:
+			values[i] = stats.dequeue_err_count;
+			break;
+		case CRYPTODEV_STAT_QP_ACTIVE:
+			values[i] = cryptodev_active_qps((uint8_t)source_id);
+			break;
+		default:
+			return -EINVAL;
+		}
+	}
+
+	return n;
+}
+
+/**
+ * Cryptodev xstats_reset callback
+ */
+static int
+cryptodev_xstats_reset(uint16_t source_id,
+		const uint64_t *ids,
+		unsigned int n,
+		void *user_data)
+{
+	RTE_SET_USED(ids);
+	RTE_SET_USED(n);
+	RTE_SET_USED(user_data);
+
+	rte_cryptodev_stats_reset((uint8_t)source_id);
+
+	return 0;
+}
+
+struct rte_sampler_source *
+rte_sampler_cryptodev_source_register(struct rte_sampler_session *session,
+		uint8_t dev_id)
+{
+	struct rte_sampler_source_ops ops;
+	char source_name[RTE_SAMPLER_XSTATS_NAME_SIZE];
+
+	if (session == NULL || !rte_cryptodev_is_valid_dev(dev_id))
+		return NULL;
+
+	/* Setup operations */
+	memset(&ops, 0, sizeof(ops));
+	ops.xstats_names_get = cryptodev_xstats_names_get;
+	ops.xstats_get = cryptodev_xstats_get;
+	ops.xstats_reset = cryptodev_xstats_reset;
+
+	/* Create source name */
+	snprintf(source_name, sizeof(source_name), "cryptodev_%u", dev_id);
+
+	return rte_sampler_session_register_source(session, source_name, dev_id,
+		&ops, NULL);
+}
@@ -0,0 +1,46 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#ifndef _RTE_SAMPLER_CRYPTODEV_H_
+#define _RTE_SAMPLER_CRYPTODEV_H_
+
+/**
+ * @file
+ * RTE Sampler Cryptodev Source
+ *
+ * Cryptodev source implementation for the sampler library.
+ * Samples the basic statistics of a crypto device (rte_cryptodev_stats_get())
+ * and the number of configured queue pairs.
+ */
+
+#include <stdint.h>
+#include <rte_sampler.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Register a cryptodev as a sampler source
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param dev_id
+ *   Cryptodev device identifier
+ * @return
+ *   Pointer to source structure on success, NULL on error
+ */
+__rte_experimental
+struct rte_sampler_source *rte_sampler_cryptodev_source_register(
+				struct rte_sampler_session *session,
+				uint8_t dev_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_SAMPLER_CRYPTODEV_H_ */
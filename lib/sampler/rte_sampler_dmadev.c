@@ -0,0 +1,186 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <rte_common.h>
+#include <rte_dmadev.h>
+#include <rte_malloc.h>
+#include <rte_sampler.h>
+#include <rte_sampler_dmadev.h>
+
+/* Stats per virtual channel, the ID is vchan * DMADEV_STAT_MAX + stat */
+enum {
+	DMADEV_STAT_SUBMITTED,
+	DMADEV_STAT_COMPLETED,
+	DMADEV_STAT_ERRORS,
+	DMADEV_STAT_MAX,
+};
+
+static const char * const dmadev_stat_names[DMADEV_STAT_MAX] = {
+	[DMADEV_STAT_SUBMITTED] = "submitted",
+	[DMADEV_STAT_COMPLETED] = "completed",
+	[DMADEV_STAT_ERRORS] = "errors",
+};
+
+/**
+ * Dmadev source user data
+ */
+struct dmadev_source_data {
+	uint16_t nb_vchans;
+};
+
+/**
+ * Dmadev xstats_names_get callback
+ */
+static int
+dmadev_xstats_names_get(uint16_t source_id,
+		struct rte_sampler_xstats_name *xstats_names,
+		uint64_t *ids,
+		unsigned int size,
+		void *user_data)
+{
+	struct dmadev_source_data *data = user_data;
+	unsigned int count = data->nb_vchans * DMADEV_STAT_MAX;
+	unsigned int i;
+
+	RTE_SET_USED(source_id);
+
+	if (xstats_names == NULL || ids == NULL)
+		return count;
+
+	for (i = 0; i < count && i < size; i++) {
+		snprintf(xstats_names[i].name, RTE_SAMPLER_XSTATS_NAME_SIZE,
+			 "vchan%u_%s", i / DMADEV_STAT_MAX,
+			 dmadev_stat_names[i % DMADEV_STAT_MAX]);
+		ids[i] = i;
+	}
+
+	return count;
+}
+
+/**
+ * Dmadev xstats_get callback
+ *
+ * The stats of a virtual channel are read once for all its requested IDs.
+ */
+static int
+dmadev_xstats_get(uint16_t source_id,
+		const uint64_t *ids,
+		uint64_t *values,
+		unsigned int n,
+		void *user_data)
+{
+	struct dmadev_source_data *data = user_data;
+	struct rte_dma_stats stats;
+	uint64_t vchan, cur_vchan = UINT64_MAX;
+	unsigned int i;
+	int ret;
+
+	for (i = 0; i < n; i++) {
+		vchan = ids[i] / DMADEV_STAT_MAX;
+		if (vchan >= data->nb_vchans)
+			return -EINVAL;
+
+		if (vchan != cur_vchan) {
+			ret = rte_dma_stats_get((int16_t)source_id, (uint16_t)vchan,
+						&stats);
+			if (ret < 0)
+				return ret;
+			cur_vchan = vchan;
+		}
+
+		switch (ids[i] % DMADEV_STAT_MAX) {
+		case DMADEV_STAT_SUBMITTED:
+			values[i] = stats.submitted;
+			break;
+		case DMADEV_STAT_COMPLETED:
+			values[i] = stats.completed;
+			break;
+		default:
+			values[i] = stats.errors;
+			break;
+		}
+	}
+
+	return n;
+}
+
+/**
+ * Dmadev xstats_reset callback
+ */
+static int
+dmadev_xstats_reset(uint16_t source_id,
+		const uint64_t *ids,
+		unsigned int n,
+		void *user_data)
+{
+	RTE_SET_USED(ids);
+	RTE_SET_USED(n);
+	RTE_SET_USED(user_data);
+
+	return rte_dma_stats_reset((int16_t)source_id, RTE_DMA_ALL_VCHAN);
+}
+
+struct rte_sampler_source *
+rte_sampler_dmadev_source_register(struct rte_sampler_session *session,
+		int16_t dev_id)
+{
+	struct rte_sampler_source_ops ops;
+	struct dmadev_source_data *data;
+	struct rte_sampler_source *source;
+	char source_name[RTE_SAMPLER_XSTATS_NAME_SIZE];
+	struct rte_dma_info info;
+
+	if (session == NULL || !rte_dma_is_valid(dev_id))
+		return NULL;
+
+	if (rte_dma_info_get(dev_id, &info) < 0 || info.nb_vchans == 0)
+		return NULL;
+
+	/* Allocate user data */
+	data = rte_zmalloc(NULL, sizeof(*data), 0);
+	if (data == NULL)
+		return NULL;
+	data->nb_vchans = info.nb_vchans;
+
+	/* Setup operations */
+	memset(&ops, 0, sizeof(ops));
+	ops.xstats_names_get = dmadev_xstats_names_get;
+	ops.xstats_get = dmadev_xstats_get;
+	ops.xstats_reset = dmadev_xstats_reset;
+
+	/* Create source name */
+	snprintf(source_name, sizeof(source_name), "dmadev_%d", dev_id);
+
+	/* Register source */
+	source = rte_sampler_session_register_source(session, source_name,
+		(uint16_t)dev_id, &ops, data);
+	if (source == NULL) {
+		rte_free(data);
+		return NULL;
+	}
+
+	return source;
+}
+
+int
+rte_sampler_dmadev_source_unregister(struct rte_sampler_session *session,
+				     struct rte_sampler_source *source)
+{
+	struct dmadev_source_data *data;
+	int ret;
+
+	data = rte_sampler_source_get_user_data(source);
+	if (data == NULL)
+		return -EINVAL;
+
+	ret = rte_sampler_session_unregister_source(session, source);
+	if (ret < 0)
+		return ret;
+
+	rte_free(data);
+
+	return 0;
+}
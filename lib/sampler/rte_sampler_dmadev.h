@@ -0,0 +1,67 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#ifndef _RTE_SAMPLER_DMADEV_H_
+#define _RTE_SAMPLER_DMADEV_H_
+
+/**
+ * @file
+ * RTE Sampler DMA Device Source
+ *
+ * Dmadev source implementation for the sampler library.
+ * Samples the submitted, completed and errors statistics of each virtual
+ * channel of a DMA device, named "vchan<N>_submitted" and so on.
+ *
+ * The number of virtual channels is read at registration time. If the
+ * device is reconfigured, the source must be unregistered and registered
+ * again.
+ */
+
+#include <stdint.h>
+#include <rte_sampler.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Register a DMA device as a sampler source
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param dev_id
+ *   DMA device identifier
+ * @return
+ *   Pointer to source structure on success, NULL on error
+ */
+__rte_experimental
+struct rte_sampler_source *rte_sampler_dmadev_source_register(
+				struct rte_sampler_session *session,
+				int16_t dev_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Unregister a DMA device source
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param source
+ *   Pointer returned by rte_sampler_dmadev_source_register()
+ * @return
+ *   Zero on success, negative on error
+ */
+__rte_experimental
+int rte_sampler_dmadev_source_unregister(struct rte_sampler_session *session,
+					 struct rte_sampler_source *source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_SAMPLER_DMADEV_H_ */
@@ -0,0 +1,255 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <rte_common.h>
+#include <rte_ethdev.h>
+#include <rte_malloc.h>
+#include <rte_string_fns.h>
+#include <rte_sampler.h>
+#include <rte_sampler_ethdev.h>
+
+/**
+ * Ethdev source user data
+ *
+ * Holds the xstats names and ethdev xstats IDs resolved at registration.
+ */
+struct ethdev_source_data {
+	struct rte_sampler_xstats_name *names;
+	uint64_t *ids;
+	unsigned int count;
+};
+
+/**
+ * Check if an ethdev xstat name belongs to the given queue
+ *
+ * Per-queue xstats are named "rx_q<N>_<stat>" or "tx_q<N>_<stat>".
+ */
+static int
+ethdev_name_is_queue(const char *name, uint16_t queue_id)
+{
+	char rx_prefix[RTE_ETH_XSTATS_NAME_SIZE];
+	char tx_prefix[RTE_ETH_XSTATS_NAME_SIZE];
+
+	snprintf(rx_prefix, sizeof(rx_prefix), "rx_q%u_", queue_id);
+	snprintf(tx_prefix, sizeof(tx_prefix), "tx_q%u_", queue_id);
+
+	return strncmp(name, rx_prefix, strlen(rx_prefix)) == 0 ||
+		strncmp(name, tx_prefix, strlen(tx_prefix)) == 0;
+}
+
+/**
+ * Check if an ethdev xstat name is in the configured name list
+ */
+static int
+ethdev_name_is_listed(const char *name, const struct rte_sampler_ethdev_conf *conf)
+{
+	unsigned int i;
+
+	if (conf->xstats_names == NULL || conf->num_xstats_names == 0)
+		return 1;
+
+	for (i = 0; i < conf->num_xstats_names; i++) {
+		if (conf->xstats_names[i] != NULL &&
+		    strcmp(name, conf->xstats_names[i]) == 0)
+			return 1;
+	}
+
+	return 0;
+}
+
+/**
+ * Resolve the selected xstats names to IDs, once
+ */
+static int
+ethdev_resolve_xstats(uint16_t port_id, const struct rte_sampler_ethdev_conf *conf,
+		      struct ethdev_source_data *data)
+{
+	struct rte_eth_xstat_name *eth_names;
+	unsigned int i, n;
+	int ret;
+
+	ret = rte_eth_xstats_get_names(port_id, NULL, 0);
+	if (ret <= 0)
+		return ret < 0 ? ret : -ENOENT;
+	n = ret;
+
+	eth_names = rte_malloc(NULL, sizeof(*eth_names) * n, 0);
+	if (eth_names == NULL)
+		return -ENOMEM;
+
+	ret = rte_eth_xstats_get_names(port_id, eth_names, n);
+	if (ret < 0 || (unsigned int)ret > n) {
+		rte_free(eth_names);
+		return ret < 0 ? ret : -EAGAIN;
+	}
+	n = ret;
+
+	data->names = rte_zmalloc(NULL, sizeof(*data->names) * n, RTE_CACHE_LINE_SIZE);
+	data->ids = rte_zmalloc(NULL, sizeof(*data->ids) * n, RTE_CACHE_LINE_SIZE);
+	if (data->names == NULL || data->ids == NULL) {
+		rte_free(data->names);
+		rte_free(data->ids);
+		rte_free(eth_names);
+		return -ENOMEM;
+	}
+
+	/* The ethdev xstats ID is the index in the names array */
+	data->count = 0;
+	for (i = 0; i < n; i++) {
+		if (conf->mode == RTE_SAMPLER_ETHDEV_QUEUE &&
+		    !ethdev_name_is_queue(eth_names[i].name, conf->queue_id))
+			continue;
+		if (!ethdev_name_is_listed(eth_names[i].name, conf))
+			continue;
+
+		rte_strscpy(data->names[data->count].name, eth_names[i].name,
+			    RTE_SAMPLER_XSTATS_NAME_SIZE);
+		data->ids[data->count] = i;
+		data->count++;
+	}
+
+	rte_free(eth_names);
+
+	if (data->count == 0) {
+		rte_free(data->names);
+		rte_free(data->ids);
+		return -ENOENT;
+	}
+
+	return 0;
+}
+
+/**
+ * Ethdev xstats_names_get callback
+ *
+ * Served from the names and IDs cached at registration.
+ */
+static int
+ethdev_xstats_names_get(uint16_t source_id,
+		struct rte_sampler_xstats_name *xstats_names,
+		uint64_t *ids,
+		unsigned int size,
+		void *user_data)
+{
+	struct ethdev_source_data *data = user_data;
+	unsigned int i;
+
+	RTE_SET_USED(source_id);
+
+	if (xstats_names == NULL || ids == NULL)
+		return data->count;
+
+	for (i = 0; i < data->count && i < size; i++) {
+		xstats_names[i] = data->names[i];
+		ids[i] = data->ids[i];
+	}
+
+	return data->count;
+}
+
+/**
+ * Ethdev xstats_get callback
+ */
+static int
+ethdev_xstats_get(uint16_t source_id,
+		const uint64_t *ids,
+		uint64_t *values,
+		unsigned int n,
+		void *user_data)
+{
+	RTE_SET_USED(user_data);
+
+	return rte_eth_xstats_get_by_id(source_id, ids, values, n);
+}
+
+/**
+ * Ethdev xstats_reset callback
+ *
+ * Ethdev only supports resetting all xstats of a port.
+ */
+static int
+ethdev_xstats_reset(uint16_t source_id,
+		const uint64_t *ids,
+		unsigned int n,
+		void *user_data)
+{
+	RTE_SET_USED(ids);
+	RTE_SET_USED(n);
+	RTE_SET_USED(user_data);
+
+	return rte_eth_xstats_reset(source_id);
+}
+
+struct rte_sampler_source *
+rte_sampler_ethdev_source_register(struct rte_sampler_session *session,
+		uint16_t port_id,
+		const struct rte_sampler_ethdev_conf *conf)
+{
+	struct rte_sampler_source_ops ops;
+	struct ethdev_source_data *data;
+	char source_name[RTE_SAMPLER_XSTATS_NAME_SIZE];
+	struct rte_sampler_source *source;
+
+	if (session == NULL || conf == NULL || !rte_eth_dev_is_valid_port(port_id))
+		return NULL;
+
+	/* Allocate user data */
+	data = rte_zmalloc(NULL, sizeof(*data), 0);
+	if (data == NULL)
+		return NULL;
+
+	if (ethdev_resolve_xstats(port_id, conf, data) < 0) {
+		rte_free(data);
+		return NULL;
+	}
+
+	/* Setup operations */
+	memset(&ops, 0, sizeof(ops));
+	ops.xstats_names_get = ethdev_xstats_names_get;
+	ops.xstats_get = ethdev_xstats_get;
+	ops.xstats_reset = ethdev_xstats_reset;
+
+	/* Create source name */
+	if (conf->mode == RTE_SAMPLER_ETHDEV_QUEUE)
+		snprintf(source_name, sizeof(source_name), "ethdev_%u_q%u",
+			 port_id, conf->queue_id);
+	else
+		snprintf(source_name, sizeof(source_name), "ethdev_%u", port_id);
+
+	/* Register source */
+	source = rte_sampler_session_register_source(session, source_name, port_id,
+		&ops, data);
+	if (source == NULL) {
+		rte_free(data->names);
+		rte_free(data->ids);
+		rte_free(data);
+		return NULL;
+	}
+
+	return source;
+}
+
+int
+rte_sampler_ethdev_source_unregister(struct rte_sampler_session *session,
+				     struct rte_sampler_source *source)
+{
+	struct ethdev_source_data *data;
+	int ret;
+
+	data = rte_sampler_source_get_user_data(source);
+	if (data == NULL)
+		return -EINVAL;
+
+	ret = rte_sampler_session_unregister_source(session, source);
+	if (ret < 0)
+		return ret;
+
+	rte_free(data->names);
+	rte_free(data->ids);
+	rte_free(data);
+
+	return 0;
+}
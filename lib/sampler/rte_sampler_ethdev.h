@@ -0,0 +1,92 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#ifndef _RTE_SAMPLER_ETHDEV_H_
+#define _RTE_SAMPLER_ETHDEV_H_
+
+/**
+ * @file
+ * RTE Sampler Ethdev Source
+ *
+ * Ethdev source implementation for the sampler library.
+ * Provides functions to register an ethdev port as a sampler source.
+ *
+ * The xstats names of the port are resolved to xstats IDs once, at
+ * registration time. Each sample then only reads the cached IDs with
+ * rte_eth_xstats_get_by_id(), so no name scan is done while sampling.
+ * If the number of queues of the port changes, the source must be
+ * unregistered and registered again.
+ */
+
+#include <stdint.h>
+#include <rte_sampler.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Ethdev sampler mode
+ */
+enum rte_sampler_ethdev_mode {
+	RTE_SAMPLER_ETHDEV_PORT = 0,  /**< Sample all xstats of the port */
+	RTE_SAMPLER_ETHDEV_QUEUE,     /**< Sample xstats of a single Rx/Tx queue */
+};
+
+/**
+ * Ethdev sampler configuration
+ */
+struct rte_sampler_ethdev_conf {
+	enum rte_sampler_ethdev_mode mode;  /**< Sampling mode */
+	uint16_t queue_id;                  /**< Queue ID (RTE_SAMPLER_ETHDEV_QUEUE mode) */
+	const char **xstats_names;          /**< Optional list of xstats names to sample */
+	unsigned int num_xstats_names;      /**< Number of entries in xstats_names */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Register an ethdev port as a sampler source
+ *
+ * The xstats to sample are selected according to the mode and, if given,
+ * the explicit name list. The selected names are resolved to IDs once.
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param port_id
+ *   Ethdev port identifier
+ * @param conf
+ *   Pointer to ethdev sampler configuration
+ * @return
+ *   Pointer to source structure on success, NULL on error
+ */
+__rte_experimental
+struct rte_sampler_source *rte_sampler_ethdev_source_register(
+				struct rte_sampler_session *session,
+				uint16_t port_id,
+				const struct rte_sampler_ethdev_conf *conf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Unregister an ethdev source and release the cached xstats IDs
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param source
+ *   Pointer returned by rte_sampler_ethdev_source_register()
+ * @return
+ *   Zero on success, negative on error
+ */
+__rte_experimental
+int rte_sampler_ethdev_source_unregister(struct rte_sampler_session *session,
+					 struct rte_sampler_source *source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_SAMPLER_ETHDEV_H_ */
@@ -193,3 +193,359 @@ return NULL;
 
 return source;
 }
+
+/**
+ * Eventdev multi-device source segment
+ *
+ * The xstats of one device, port or queue, read with a single eventdev call.
+ */
+struct eventdev_segment {
+	uint8_t dev_id;
+	enum rte_event_dev_xstats_mode mode;
+	uint8_t queue_port_id;
+};
+
+/**
+ * Eventdev multi-device source user data
+ *
+ * The sampler xstats ID is the index in the names array. The segment and
+ * the eventdev xstats ID of each sampler xstats ID are resolved at
+ * registration, the consecutive IDs of a segment being read at once.
+ */
+struct eventdev_multi_source_data {
+	struct eventdev_segment *segments;
+	unsigned int num_segments;
+	struct rte_sampler_xstats_name *names;
+	uint64_t *evt_ids;       /**< Eventdev xstats ID of each xstat */
+	uint32_t *segment_of;    /**< Segment index of each xstat */
+	uint64_t *scratch;       /**< Eventdev xstats IDs of a segment read */
+	unsigned int count;
+};
+
+static const enum rte_event_dev_xstats_mode eventdev_modes[] = {
+	[RTE_SAMPLER_EVENTDEV_DEVICE] = RTE_EVENT_DEV_XSTATS_DEVICE,
+	[RTE_SAMPLER_EVENTDEV_PORT] = RTE_EVENT_DEV_XSTATS_PORT,
+	[RTE_SAMPLER_EVENTDEV_QUEUE] = RTE_EVENT_DEV_XSTATS_QUEUE,
+};
+
+static const char * const eventdev_mode_names[] = {
+	[RTE_SAMPLER_EVENTDEV_DEVICE] = "",
+	[RTE_SAMPLER_EVENTDEV_PORT] = "port",
+	[RTE_SAMPLER_EVENTDEV_QUEUE] = "queue",
+};
+
+static void
+eventdev_multi_data_free(struct eventdev_multi_source_data *data)
+{
+	rte_free(data->segments);
+	rte_free(data->names);
+	rte_free(data->evt_ids);
+	rte_free(data->segment_of);
+	rte_free(data->scratch);
+	rte_free(data);
+}
+
+/**
+ * Get the number of ports or queues of a device to sample in a mode
+ */
+static uint32_t
+eventdev_mode_count(uint8_t dev_id, enum rte_sampler_eventdev_mode mode)
+{
+	uint32_t count = 0;
+
+	switch (mode) {
+	case RTE_SAMPLER_EVENTDEV_DEVICE:
+		return 1;
+	case RTE_SAMPLER_EVENTDEV_PORT:
+		if (rte_event_dev_attr_get(dev_id, RTE_EVENT_DEV_ATTR_PORT_COUNT, &count) < 0)
+			return 0;
+		return count;
+	case RTE_SAMPLER_EVENTDEV_QUEUE:
+		if (rte_event_dev_attr_get(dev_id, RTE_EVENT_DEV_ATTR_QUEUE_COUNT, &count) < 0)
+			return 0;
+		return count;
+	}
+
+	return 0;
+}
+
+/**
+ * Resolve the xstats of all the devices, ports and queues, once
+ *
+ * The first pass counts the segments and xstats, the second one fills them.
+ */
+static int
+eventdev_multi_resolve(const struct rte_sampler_eventdev_multi_conf *conf,
+		       struct eventdev_multi_source_data *data)
+{
+	struct rte_event_dev_xstats_name *evt_names = NULL;
+	unsigned int count = 0, num_segments = 0, max = 0;
+	unsigned int pass, size, d, i;
+	int mode, ret;
+
+	for (pass = 0; pass < 2; pass++) {
+		for (d = 0; d < conf->num_devs; d++) {
+			uint8_t dev_id = conf->dev_ids[d];
+
+			for (mode = RTE_SAMPLER_EVENTDEV_DEVICE;
+			     mode <= RTE_SAMPLER_EVENTDEV_QUEUE; mode++) {
+				uint32_t qp, nb_qp;
+
+				if (!(conf->modes & RTE_BIT32(mode)))
+					continue;
+
+				nb_qp = eventdev_mode_count(dev_id, mode);
+				for (qp = 0; qp < nb_qp; qp++) {
+					struct eventdev_segment *seg;
+
+					if (pass == 0) {
+						ret = rte_event_dev_xstats_names_get(dev_id,
+							eventdev_modes[mode], qp, NULL, NULL, 0);
+						if (ret <= 0)
+							continue;
+						count += ret;
+						num_segments++;
+						max = RTE_MAX(max, (unsigned int)ret);
+						continue;
+					}
+
+					size = RTE_MIN(max, count - data->count);
+					ret = rte_event_dev_xstats_names_get(dev_id,
+						eventdev_modes[mode], qp, evt_names,
+						&data->evt_ids[data->count], size);
+					if (ret <= 0)
+						continue;
+					/* The xstats changed since the first pass. */
+					if ((unsigned int)ret > size ||
+					    data->num_segments == num_segments)
+						goto error_again;
+
+					seg = &data->segments[data->num_segments];
+					seg->dev_id = dev_id;
+					seg->mode = eventdev_modes[mode];
+					seg->queue_port_id = qp;
+
+					for (i = 0; i < (unsigned int)ret; i++) {
+						char *name = data->names[data->count + i].name;
+
+						if (mode == RTE_SAMPLER_EVENTDEV_DEVICE)
+							snprintf(name, RTE_SAMPLER_XSTATS_NAME_SIZE,
+								 "dev%u_%s", dev_id,
+								 evt_names[i].name);
+						else
+							snprintf(name, RTE_SAMPLER_XSTATS_NAME_SIZE,
+								 "dev%u_%s%u_%s", dev_id,
+								 eventdev_mode_names[mode], qp,
+								 evt_names[i].name);
+						data->segment_of[data->count + i] =
+							data->num_segments;
+					}
+
+					data->count += ret;
+					data->num_segments++;
+				}
+			}
+		}
+
+		if (pass == 1)
+			break;
+
+		if (count == 0)
+			return -ENOENT;
+
+		evt_names = rte_malloc(NULL, sizeof(*evt_names) * max, 0);
+		data->segments = rte_zmalloc(NULL, sizeof(*data->segments) * num_segments,
+					     RTE_CACHE_LINE_SIZE);
+		data->names = rte_zmalloc(NULL, sizeof(*data->names) * count,
+					  RTE_CACHE_LINE_SIZE);
+		data->evt_ids = rte_zmalloc(NULL, sizeof(*data->evt_ids) * count,
+					    RTE_CACHE_LINE_SIZE);
+		data->segment_of = rte_zmalloc(NULL, sizeof(*data->segment_of) * count,
+					       RTE_CACHE_LINE_SIZE);
+		data->scratch = rte_zmalloc(NULL, sizeof(*data->scratch) * max,
+					    RTE_CACHE_LINE_SIZE);
+		if (evt_names == NULL || data->segments == NULL || data->names == NULL ||
+		    data->evt_ids == NULL || data->segment_of == NULL ||
+		    data->scratch == NULL) {
+			rte_free(evt_names);
+			return -ENOMEM;
+		}
+	}
+
+	rte_free(evt_names);
+	return data->count ? 0 : -ENOENT;
+
+error_again:
+	rte_free(evt_names);
+	return -EAGAIN;
+}
+
+/**
+ * Eventdev multi-device xstats_names_get callback
+ *
+ * Served from the names cached at registration.
+ */
+static int
+eventdev_multi_xstats_names_get(uint16_t source_id,
+		struct rte_sampler_xstats_name *xstats_names,
+		uint64_t *ids,
+		unsigned int size,
+		void *user_data)
+{
+	struct eventdev_multi_source_data *data = user_data;
+	unsigned int i;
+
+	RTE_SET_USED(source_id);
+
+	if (xstats_names == NULL || ids == NULL)
+		return data->count;
+
+	for (i = 0; i < data->count && i < size; i++) {
+		xstats_names[i] = data->names[i];
+		ids[i] = i;
+	}
+
+	return data->count;
+}
+
+/**
+ * Read or reset, when values is NULL, the given xstats
+ *
+ * Each run of consecutive IDs of the same segment is handled with one
+ * eventdev call, writing its values in place in the values array.
+ */
+static int
+eventdev_multi_xstats_run(struct eventdev_multi_source_data *data,
+		const uint64_t *ids,
+		uint64_t *values,
+		unsigned int n)
+{
+	unsigned int i = 0, j;
+	int ret;
+
+	while (i < n) {
+		const struct eventdev_segment *seg;
+		uint32_t s;
+
+		if (ids[i] >= data->count)
+			return -EINVAL;
+		s = data->segment_of[ids[i]];
+		seg = &data->segments[s];
+
+		for (j = i; j < n && ids[j] < data->count &&
+		     data->segment_of[ids[j]] == s; j++)
+			data->scratch[j - i] = data->evt_ids[ids[j]];
+
+		if (values != NULL)
+			ret = rte_event_dev_xstats_get(seg->dev_id, seg->mode,
+				seg->queue_port_id, data->scratch, &values[i], j - i);
+		else
+			ret = rte_event_dev_xstats_reset(seg->dev_id, seg->mode,
+				seg->mode == RTE_EVENT_DEV_XSTATS_DEVICE ?
+				-1 : seg->queue_port_id, data->scratch, j - i);
+		if (ret < 0)
+			return ret;
+
+		i = j;
+	}
+
+	return n;
+}
+
+/**
+ * Eventdev multi-device xstats_get callback
+ */
+static int
+eventdev_multi_xstats_get(uint16_t source_id,
+		const uint64_t *ids,
+		uint64_t *values,
+		unsigned int n,
+		void *user_data)
+{
+	RTE_SET_USED(source_id);
+
+	return eventdev_multi_xstats_run(user_data, ids, values, n);
+}
+
+/**
+ * Eventdev multi-device xstats_reset callback
+ */
+static int
+eventdev_multi_xstats_reset(uint16_t source_id,
+		const uint64_t *ids,
+		unsigned int n,
+		void *user_data)
+{
+	int ret;
+
+	RTE_SET_USED(source_id);
+
+	ret = eventdev_multi_xstats_run(user_data, ids, NULL, n);
+
+	return ret < 0 ? ret : 0;
+}
+
+struct rte_sampler_source *
+rte_sampler_eventdev_multi_source_register(struct rte_sampler_session *session,
+		const char *name,
+		const struct rte_sampler_eventdev_multi_conf *conf)
+{
+	struct rte_sampler_source_ops ops;
+	struct eventdev_multi_source_data *data;
+	struct rte_sampler_source *source;
+	unsigned int d;
+
+	if (session == NULL || name == NULL || conf == NULL ||
+	    conf->dev_ids == NULL || conf->num_devs == 0 || conf->modes == 0)
+		return NULL;
+
+	for (d = 0; d < conf->num_devs; d++)
+		if (rte_event_dev_socket_id(conf->dev_ids[d]) == -EINVAL)
+			return NULL;
+
+	/* Allocate user data */
+	data = rte_zmalloc(NULL, sizeof(*data), 0);
+	if (data == NULL)
+		return NULL;
+
+	if (eventdev_multi_resolve(conf, data) < 0) {
+		eventdev_multi_data_free(data);
+		return NULL;
+	}
+
+	/* Setup operations */
+	memset(&ops, 0, sizeof(ops));
+	ops.xstats_names_get = eventdev_multi_xstats_names_get;
+	ops.xstats_get = eventdev_multi_xstats_get;
+	ops.xstats_reset = eventdev_multi_xstats_reset;
+
+	/* Register source */
+	source = rte_sampler_session_register_source(session, name,
+		conf->dev_ids[0], &ops, data);
+	if (source == NULL) {
+		eventdev_multi_data_free(data);
+		return NULL;
+	}
+
+	return source;
+}
+
+int
+rte_sampler_eventdev_multi_source_unregister(struct rte_sampler_session *session,
+					     struct rte_sampler_source *source)
+{
+	struct eventdev_multi_source_data *data;
+	int ret;
+
+	data = rte_sampler_source_get_user_data(source);
+	if (data == NULL)
+		return -EINVAL;
+
+	ret = rte_sampler_session_unregister_source(session, source);
+	if (ret < 0)
+		return ret;
+
+	eventdev_multi_data_free(data);
+
+	return 0;
+}
@@ -11,9 +11,17 @@
  *
  * Eventdev source implementation for the sampler library.
  * Provides functions to register eventdev as a sampler source.
+ *
+ * A multi-device source samples the device, port and queue xstats of
+ * several eventdevs in one source. Its xstats are resolved once, at
+ * registration time, and each sample reads them into one contiguous values
+ * array, with one eventdev call per device, port or queue. If the
+ * configuration of a device changes, the source must be unregistered and
+ * registered again.
  */
 
 #include <stdint.h>
+#include <rte_bitops.h>
 #include <rte_sampler.h>
 
 #ifdef __cplusplus
@@ -37,6 +45,22 @@ struct rte_sampler_eventdev_conf {
 	uint8_t queue_port_id;                 /**< Queue or port ID (mode dependent) */
 };
 
+/** Sample the device-level xstats in a multi-device source */
+#define RTE_SAMPLER_EVENTDEV_F_DEVICE RTE_BIT32(RTE_SAMPLER_EVENTDEV_DEVICE)
+/** Sample the xstats of all the ports in a multi-device source */
+#define RTE_SAMPLER_EVENTDEV_F_PORT RTE_BIT32(RTE_SAMPLER_EVENTDEV_PORT)
+/** Sample the xstats of all the queues in a multi-device source */
+#define RTE_SAMPLER_EVENTDEV_F_QUEUE RTE_BIT32(RTE_SAMPLER_EVENTDEV_QUEUE)
+
+/**
+ * Eventdev multi-device sampler configuration
+ */
+struct rte_sampler_eventdev_multi_conf {
+	const uint8_t *dev_ids;   /**< Eventdev device identifiers */
+	unsigned int num_devs;    /**< Number of entries in dev_ids */
+	uint32_t modes;           /**< RTE_SAMPLER_EVENTDEV_F_* flags */
+};
+
 /**
  * Register an eventdev as a sampler source
  *
@@ -54,6 +78,49 @@ struct rte_sampler_source *rte_sampler_eventdev_source_register(
 				uint8_t dev_id,
 				const struct rte_sampler_eventdev_conf *conf);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Register several eventdevs as a single sampler source
+ *
+ * The xstats of the selected modes of each device are sampled: the device
+ * xstats and the xstats of each configured port and queue. They are named
+ * "dev<dev_id>_<name>", "dev<dev_id>_port<port_id>_<name>" and
+ * "dev<dev_id>_queue<queue_id>_<name>".
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param name
+ *   Source name
+ * @param conf
+ *   Pointer to eventdev multi-device sampler configuration
+ * @return
+ *   Pointer to source structure on success, NULL on error
+ */
+__rte_experimental
+struct rte_sampler_source *rte_sampler_eventdev_multi_source_register(
+				struct rte_sampler_session *session,
+				const char *name,
+				const struct rte_sampler_eventdev_multi_conf *conf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Unregister an eventdev multi-device source and release its cached xstats
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param source
+ *   Pointer returned by rte_sampler_eventdev_multi_source_register()
+ * @return
+ *   Zero on success, negative on error
+ */
+__rte_experimental
+int rte_sampler_eventdev_multi_source_unregister(struct rte_sampler_session *session,
+						 struct rte_sampler_source *source);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,160 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <rte_common.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_mempool.h>
+#include <rte_sampler.h>
+#include <rte_sampler_mempool.h>
+
+/* Fixed stat IDs, per-lcore cache IDs follow as MEMPOOL_STAT_CACHE + lcore */
+enum {
+	MEMPOOL_STAT_AVAIL,
+	MEMPOOL_STAT_IN_USE,
+	MEMPOOL_STAT_CACHE,
+};
+
+/**
+ * Mempool source user data
+ */
+struct mempool_source_data {
+	struct rte_mempool *mp;
+	unsigned int count;
+	uint64_t ids[MEMPOOL_STAT_CACHE + RTE_MAX_LCORE];
+};
+
+/**
+ * Mempool xstats_names_get callback
+ */
+static int
+mempool_xstats_names_get(uint16_t source_id,
+		struct rte_sampler_xstats_name *xstats_names,
+		uint64_t *ids,
+		unsigned int size,
+		void *user_data)
+{
+	struct mempool_source_data *data = user_data;
+	unsigned int i;
+
+	RTE_SET_USED(source_id);
+
+	if (xstats_names == NULL || ids == NULL)
+		return data->count;
+
+	for (i = 0; i < data->count && i < size; i++) {
+		ids[i] = data->ids[i];
+		if (ids[i] == MEMPOOL_STAT_AVAIL)
+			strcpy(xstats_names[i].name, "avail_count");
+		else if (ids[i] == MEMPOOL_STAT_IN_USE)
+			strcpy(xstats_names[i].name, "in_use_count");
+		else
+			snprintf(xstats_names[i].name, RTE_SAMPLER_XSTATS_NAME_SIZE,
+				 "cache_len_lcore%u",
+				 (unsigned int)(ids[i] - MEMPOOL_STAT_CACHE));
+	}
+
+	return data->count;
+}
+
+/**
+ * Mempool xstats_get callback
+ *
+ * Cache lengths are read without synchronization with the owning lcore,
+ * so they are a snapshot only.
+ */
+static int
+mempool_xstats_get(uint16_t source_id,
+		const uint64_t *ids,
+		uint64_t *values,
+		unsigned int n,
+		void *user_data)
+{
+	struct mempool_source_data *data = user_data;
+	struct rte_mempool *mp = data->mp;
+	unsigned int i;
+
+	RTE_SET_USED(source_id);
+
+	for (i = 0; i < n; i++) {
+		if (ids[i] == MEMPOOL_STAT_AVAIL)
+			values[i] = rte_mempool_avail_count(mp);
+		else if (ids[i] == MEMPOOL_STAT_IN_USE)
+			values[i] = rte_mempool_in_use_count(mp);
+		else if (ids[i] < MEMPOOL_STAT_CACHE + RTE_MAX_LCORE &&
+			 mp->cache_size > 0)
+			values[i] = mp->local_cache[ids[i] - MEMPOOL_STAT_CACHE].len;
+		else
+			return -EINVAL;
+	}
+
+	return n;
+}
+
+struct rte_sampler_source *
+rte_sampler_mempool_source_register(struct rte_sampler_session *session,
+		struct rte_mempool *mp)
+{
+	struct rte_sampler_source_ops ops;
+	struct mempool_source_data *data;
+	struct rte_sampler_source *source;
+	char source_name[RTE_SAMPLER_XSTATS_NAME_SIZE];
+	unsigned int lcore_id;
+
+	if (session == NULL || mp == NULL)
+		return NULL;
+
+	/* Allocate user data */
+	data = rte_zmalloc(NULL, sizeof(*data), 0);
+	if (data == NULL)
+		return NULL;
+
+	data->mp = mp;
+	data->ids[data->count++] = MEMPOOL_STAT_AVAIL;
+	data->ids[data->count++] = MEMPOOL_STAT_IN_USE;
+	if (mp->cache_size > 0) {
+		RTE_LCORE_FOREACH(lcore_id)
+			data->ids[data->count++] = MEMPOOL_STAT_CACHE + lcore_id;
+	}
+
+	/* Setup operations, mempool counters cannot be reset */
+	memset(&ops, 0, sizeof(ops));
+	ops.xstats_names_get = mempool_xstats_names_get;
+	ops.xstats_get = mempool_xstats_get;
+
+	/* Create source name */
+	snprintf(source_name, sizeof(source_name), "mempool_%s", mp->name);
+
+	/* Register source */
+	source = rte_sampler_session_register_source(session, source_name, 0,
+		&ops, data);
+	if (source == NULL) {
+		rte_free(data);
+		return NULL;
+	}
+
+	return source;
+}
+
+int
+rte_sampler_mempool_source_unregister(struct rte_sampler_session *session,
+				      struct rte_sampler_source *source)
+{
+	struct mempool_source_data *data;
+	int ret;
+
+	data = rte_sampler_source_get_user_data(source);
+	if (data == NULL)
+		return -EINVAL;
+
+	ret = rte_sampler_session_unregister_source(session, source);
+	if (ret < 0)
+		return ret;
+
+	rte_free(data);
+
+	return 0;
+}
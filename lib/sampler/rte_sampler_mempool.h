@@ -0,0 +1,67 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#ifndef _RTE_SAMPLER_MEMPOOL_H_
+#define _RTE_SAMPLER_MEMPOOL_H_
+
+/**
+ * @file
+ * RTE Sampler Mempool Source
+ *
+ * Mempool source implementation for the sampler library.
+ * Samples the number of available and in-use objects of a mempool and,
+ * if the mempool has per-lcore caches, the fill level of the cache of
+ * each enabled lcore ("cache_len_lcore<N>").
+ *
+ * The mempool must remain valid until the source is unregistered.
+ */
+
+#include <stdint.h>
+#include <rte_mempool.h>
+#include <rte_sampler.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Register a mempool as a sampler source
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param mp
+ *   Pointer to the mempool
+ * @return
+ *   Pointer to source structure on success, NULL on error
+ */
+__rte_experimental
+struct rte_sampler_source *rte_sampler_mempool_source_register(
+				struct rte_sampler_session *session,
+				struct rte_mempool *mp);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Unregister a mempool source
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param source
+ *   Pointer returned by rte_sampler_mempool_source_register()
+ * @return
+ *   Zero on success, negative on error
+ */
+__rte_experimental
+int rte_sampler_mempool_source_unregister(struct rte_sampler_session *session,
+					  struct rte_sampler_source *source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_SAMPLER_MEMPOOL_H_ */
@@ -0,0 +1,390 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_lcore.h>
+#include <rte_log.h>
+#include <rte_malloc.h>
+#include <rte_seqcount.h>
+#include <rte_string_fns.h>
+#include <rte_sampler.h>
+#include <rte_sampler_pmu.h>
+
+#ifdef RTE_LIB_PMU
+
+#include <rte_pmu.h>
+
+#define PMU_SLOT_NONE UINT16_MAX
+
+/**
+ * Metrics derived from two events, over the sampling interval
+ */
+enum pmu_metric {
+	PMU_METRIC_IPC,
+	PMU_METRIC_LLC_MPKI,
+	PMU_METRIC_BRANCH_MPKI,
+	PMU_METRIC_MAX,
+};
+
+static const struct {
+	const char *name;
+	const char *event;
+	const char *per_event;
+	uint64_t scale;
+} pmu_metrics[PMU_METRIC_MAX] = {
+#ifdef RTE_PMU_EVENT_CYCLES
+	/* fixed point values, in thousandths */
+	[PMU_METRIC_IPC] = { "ipc_milli", RTE_PMU_EVENT_INSTRUCTIONS,
+		RTE_PMU_EVENT_CYCLES, 1000 },
+	[PMU_METRIC_LLC_MPKI] = { "llc_mpki_milli", RTE_PMU_EVENT_LLC_MISSES,
+		RTE_PMU_EVENT_INSTRUCTIONS, 1000 * 1000 },
+	[PMU_METRIC_BRANCH_MPKI] = { "branch_mpki_milli", RTE_PMU_EVENT_BRANCH_MISSES,
+		RTE_PMU_EVENT_INSTRUCTIONS, 1000 * 1000 },
+#else
+	/* no common events on this architecture */
+	[PMU_METRIC_IPC] = { NULL, NULL, NULL, 0 },
+#endif
+};
+
+/**
+ * Counters published by one lcore
+ */
+struct __rte_cache_aligned pmu_lcore_slot {
+	rte_seqcount_t seqcount;
+	uint64_t tsc;
+	uint64_t values[RTE_MAX_NUM_GROUP_EVENTS];
+};
+
+/**
+ * PMU source user data
+ *
+ * Stat IDs are slot * stride + k, where k is 0 for the TSC of the last
+ * update, 1 + event position for the events, and follows with the metrics.
+ */
+struct pmu_source_data {
+	unsigned int num_events;
+	unsigned int events[RTE_MAX_NUM_GROUP_EVENTS];  /* lib/pmu indexes */
+	char event_names[RTE_MAX_NUM_GROUP_EVENTS][RTE_SAMPLER_XSTATS_NAME_SIZE];
+	unsigned int num_metrics;
+	unsigned int metrics[PMU_METRIC_MAX];           /* Metric of each position */
+	unsigned int metric_events[PMU_METRIC_MAX][2];  /* Event positions */
+	unsigned int stride;
+	unsigned int num_lcores;
+	unsigned int lcores[RTE_MAX_LCORE];             /* Lcore of each slot */
+	uint16_t slot_of[RTE_MAX_LCORE];                /* Slot of each lcore */
+	struct pmu_lcore_slot slots[RTE_MAX_LCORE];
+	/* Values of each slot at the previous sample, for the metrics */
+	uint64_t prev_values[RTE_MAX_LCORE][RTE_MAX_NUM_GROUP_EVENTS];
+	uint64_t metric_values[RTE_MAX_LCORE][PMU_METRIC_MAX];
+};
+
+/**
+ * Read the counters of the calling lcore into its slot
+ */
+static inline void
+pmu_slot_update(struct pmu_source_data *data, struct pmu_lcore_slot *slot)
+{
+	uint64_t values[RTE_MAX_NUM_GROUP_EVENTS];
+	unsigned int i, num;
+
+	/* The whole group is read at once for consistent metrics */
+	num = rte_pmu_read_group(values, RTE_DIM(values));
+
+	rte_seqcount_write_begin(&slot->seqcount);
+	slot->tsc = rte_get_tsc_cycles();
+	for (i = 0; i < data->num_events; i++)
+		slot->values[i] = data->events[i] < num ? values[data->events[i]] : 0;
+	rte_seqcount_write_end(&slot->seqcount);
+}
+
+/**
+ * Compute the metrics of a slot since its previous sample
+ */
+static void
+pmu_metrics_update(struct pmu_source_data *data, unsigned int idx,
+		const uint64_t *values)
+{
+	uint64_t *prev = data->prev_values[idx];
+	unsigned int i, m;
+	uint64_t val, per_val;
+
+	for (i = 0; i < data->num_metrics; i++) {
+		m = data->metrics[i];
+		val = values[data->metric_events[i][0]] -
+			prev[data->metric_events[i][0]];
+		per_val = values[data->metric_events[i][1]] -
+			prev[data->metric_events[i][1]];
+		data->metric_values[idx][i] = per_val == 0 ? 0 :
+			val * pmu_metrics[m].scale / per_val;
+	}
+
+	memcpy(prev, values, sizeof(uint64_t) * data->num_events);
+}
+
+/**
+ * Find the metrics whose events are all sampled
+ */
+static void
+pmu_metrics_init(struct pmu_source_data *data)
+{
+	unsigned int i, m;
+	int event, per_event;
+
+	for (m = 0; m < PMU_METRIC_MAX; m++) {
+		if (pmu_metrics[m].name == NULL)
+			continue;
+
+		event = per_event = -1;
+		for (i = 0; i < data->num_events; i++) {
+			if (strcmp(data->event_names[i], pmu_metrics[m].event) == 0)
+				event = i;
+			if (strcmp(data->event_names[i], pmu_metrics[m].per_event) == 0)
+				per_event = i;
+		}
+		if (event < 0 || per_event < 0)
+			continue;
+
+		data->metrics[data->num_metrics] = m;
+		data->metric_events[data->num_metrics][0] = event;
+		data->metric_events[data->num_metrics][1] = per_event;
+		data->num_metrics++;
+	}
+}
+
+/**
+ * PMU xstats_names_get callback
+ */
+static int
+pmu_xstats_names_get(uint16_t source_id,
+		struct rte_sampler_xstats_name *xstats_names,
+		uint64_t *ids,
+		unsigned int size,
+		void *user_data)
+{
+	struct pmu_source_data *data = user_data;
+	unsigned int stride = data->stride;
+	unsigned int count = data->num_lcores * stride;
+	unsigned int i, lcore_id, k;
+
+	RTE_SET_USED(source_id);
+
+	if (xstats_names == NULL || ids == NULL)
+		return count;
+
+	for (i = 0; i < count && i < size; i++) {
+		lcore_id = data->lcores[i / stride];
+		k = i % stride;
+		if (k == 0)
+			snprintf(xstats_names[i].name, RTE_SAMPLER_XSTATS_NAME_SIZE,
+				 "lcore%u_tsc", lcore_id);
+		else if (k <= data->num_events)
+			snprintf(xstats_names[i].name, RTE_SAMPLER_XSTATS_NAME_SIZE,
+				 "lcore%u_%s", lcore_id, data->event_names[k - 1]);
+		else
+			snprintf(xstats_names[i].name, RTE_SAMPLER_XSTATS_NAME_SIZE,
+				 "lcore%u_%s", lcore_id,
+				 pmu_metrics[data->metrics[k - 1 - data->num_events]].name);
+		ids[i] = i;
+	}
+
+	return count;
+}
+
+/**
+ * PMU xstats_get callback
+ *
+ * Each slot is copied once under its sequence counter, so all values of
+ * an lcore come from the same update. The metrics are computed over the
+ * interval since the previous copy of the slot.
+ */
+static int
+pmu_xstats_get(uint16_t source_id,
+		const uint64_t *ids,
+		uint64_t *values,
+		unsigned int n,
+		void *user_data)
+{
+	struct pmu_source_data *data = user_data;
+	unsigned int stride = data->stride;
+	unsigned int lcore_id = rte_lcore_id();
+	struct pmu_lcore_slot *slot, snap;
+	uint64_t idx, cur_idx = UINT64_MAX;
+	unsigned int i, k;
+	uint32_t sn;
+
+	RTE_SET_USED(source_id);
+
+	/* Counters of the sampling lcore are read directly */
+	if (lcore_id < RTE_MAX_LCORE && data->slot_of[lcore_id] != PMU_SLOT_NONE)
+		pmu_slot_update(data, &data->slots[data->slot_of[lcore_id]]);
+
+	for (i = 0; i < n; i++) {
+		idx = ids[i] / stride;
+		if (idx >= data->num_lcores)
+			return -EINVAL;
+
+		if (idx != cur_idx) {
+			slot = &data->slots[idx];
+			do {
+				sn = rte_seqcount_read_begin(&slot->seqcount);
+				snap.tsc = slot->tsc;
+				memcpy(snap.values, slot->values,
+				       sizeof(uint64_t) * data->num_events);
+			} while (rte_seqcount_read_retry(&slot->seqcount, sn));
+			pmu_metrics_update(data, idx, snap.values);
+			cur_idx = idx;
+		}
+
+		k = ids[i] % stride;
+		if (k == 0)
+			values[i] = snap.tsc;
+		else if (k <= data->num_events)
+			values[i] = snap.values[k - 1];
+		else
+			values[i] = data->metric_values[idx][k - 1 - data->num_events];
+	}
+
+	return n;
+}
+
+struct rte_sampler_source *
+rte_sampler_pmu_source_register(struct rte_sampler_session *session,
+		const struct rte_sampler_pmu_conf *conf)
+{
+	struct rte_sampler_source_ops ops;
+	struct pmu_source_data *data;
+	struct rte_sampler_source *source;
+	unsigned int i, lcore_id;
+	int ret;
+
+	if (session == NULL || conf == NULL || conf->events == NULL ||
+	    conf->num_events == 0 || conf->num_events > RTE_MAX_NUM_GROUP_EVENTS ||
+	    conf->lcores == NULL || conf->num_lcores == 0 ||
+	    conf->num_lcores > RTE_MAX_LCORE)
+		return NULL;
+
+	ret = rte_pmu_init();
+	if (ret < 0) {
+		RTE_LOG(ERR, USER1, "Failed to initialize PMU: %d\n", ret);
+		return NULL;
+	}
+
+	/* Allocate user data */
+	data = rte_zmalloc(NULL, sizeof(*data), RTE_CACHE_LINE_SIZE);
+	if (data == NULL)
+		return NULL;
+
+	for (i = 0; i < conf->num_events; i++) {
+		ret = rte_pmu_add_event(conf->events[i]);
+		if (ret < 0) {
+			RTE_LOG(ERR, USER1, "Failed to add PMU event %s: %d\n",
+				conf->events[i], ret);
+			rte_free(data);
+			return NULL;
+		}
+		data->events[i] = ret;
+		rte_strscpy(data->event_names[i], conf->events[i],
+			    RTE_SAMPLER_XSTATS_NAME_SIZE);
+	}
+	data->num_events = conf->num_events;
+	pmu_metrics_init(data);
+	data->stride = 1 + data->num_events + data->num_metrics;
+
+	for (i = 0; i < RTE_MAX_LCORE; i++)
+		data->slot_of[i] = PMU_SLOT_NONE;
+
+	for (i = 0; i < conf->num_lcores; i++) {
+		lcore_id = conf->lcores[i];
+		if (lcore_id >= RTE_MAX_LCORE || data->slot_of[lcore_id] != PMU_SLOT_NONE) {
+			rte_free(data);
+			return NULL;
+		}
+		data->slot_of[lcore_id] = i;
+		data->lcores[i] = lcore_id;
+		rte_seqcount_init(&data->slots[i].seqcount);
+	}
+	data->num_lcores = conf->num_lcores;
+
+	/* Setup operations, PMU counters cannot be reset */
+	memset(&ops, 0, sizeof(ops));
+	ops.xstats_names_get = pmu_xstats_names_get;
+	ops.xstats_get = pmu_xstats_get;
+
+	/* Register source */
+	source = rte_sampler_session_register_source(session, "pmu", 0, &ops, data);
+	if (source == NULL) {
+		rte_free(data);
+		return NULL;
+	}
+
+	return source;
+}
+
+int
+rte_sampler_pmu_source_unregister(struct rte_sampler_session *session,
+				  struct rte_sampler_source *source)
+{
+	struct pmu_source_data *data;
+	int ret;
+
+	data = rte_sampler_source_get_user_data(source);
+	if (data == NULL)
+		return -EINVAL;
+
+	ret = rte_sampler_session_unregister_source(session, source);
+	if (ret < 0)
+		return ret;
+
+	rte_free(data);
+
+	return 0;
+}
+
+void
+rte_sampler_pmu_update(struct rte_sampler_source *source)
+{
+	struct pmu_source_data *data = rte_sampler_source_get_user_data(source);
+	unsigned int lcore_id = rte_lcore_id();
+
+	if (data == NULL || lcore_id >= RTE_MAX_LCORE ||
+	    data->slot_of[lcore_id] == PMU_SLOT_NONE)
+		return;
+
+	pmu_slot_update(data, &data->slots[data->slot_of[lcore_id]]);
+}
+
+#else /* !RTE_LIB_PMU */
+
+struct rte_sampler_source *
+rte_sampler_pmu_source_register(struct rte_sampler_session *session,
+		const struct rte_sampler_pmu_conf *conf)
+{
+	RTE_SET_USED(session);
+	RTE_SET_USED(conf);
+
+	RTE_LOG(ERR, USER1, "PMU sampler source requires lib/pmu\n");
+
+	return NULL;
+}
+
+int
+rte_sampler_pmu_source_unregister(struct rte_sampler_session *session,
+				  struct rte_sampler_source *source)
+{
+	RTE_SET_USED(session);
+	RTE_SET_USED(source);
+
+	return -ENOTSUP;
+}
+
+void
+rte_sampler_pmu_update(struct rte_sampler_source *source)
+{
+	RTE_SET_USED(source);
+}
+
+#endif /* RTE_LIB_PMU */
@@ -0,0 +1,114 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#ifndef _RTE_SAMPLER_PMU_H_
+#define _RTE_SAMPLER_PMU_H_
+
+/**
+ * @file
+ * RTE Sampler PMU Source
+ *
+ * PMU source implementation for the sampler library.
+ * Samples hardware performance counters (lib/pmu) of a set of lcores,
+ * such as cache misses or branch mispredictions, so that they can be
+ * lined up with device statistics sampled in the same session.
+ *
+ * PMU counters can only be read by the lcore they count for. Each listed
+ * lcore therefore calls rte_sampler_pmu_update() from its processing loop,
+ * which publishes its counters and their TSC timestamp. The source reads
+ * the last published values; if the sampling lcore is itself listed, its
+ * counters are read directly.
+ *
+ * For each listed lcore N, the stats are "lcoreN_tsc", the TSC of the last
+ * update, and "lcoreN_<event>" for each event.
+ * When the events named in rte_pmu.h are sampled, they are followed by
+ * metrics over the interval since the previous sample, in thousandths:
+ * "lcoreN_ipc_milli", the instructions per cycle, "lcoreN_llc_mpki_milli"
+ * and "lcoreN_branch_mpki_milli", the LLC and branch misses per thousand
+ * instructions.
+ *
+ * The source must be registered before the listed lcores first read PMU
+ * counters, since lib/pmu enables the event group of an lcore on its first
+ * read. The application remains responsible for rte_pmu_fini().
+ *
+ * This source is only available when lib/pmu is built, otherwise
+ * registration fails.
+ */
+
+#include <stdint.h>
+#include <rte_sampler.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * PMU sampler configuration
+ */
+struct rte_sampler_pmu_conf {
+	const char **events;        /**< PMU event names, see rte_pmu_add_event() */
+	unsigned int num_events;    /**< Number of entries in events */
+	const unsigned int *lcores; /**< Lcores to sample */
+	unsigned int num_lcores;    /**< Number of entries in lcores */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Register PMU counters of a set of lcores as a sampler source
+ *
+ * Initializes lib/pmu if needed and adds the configured events.
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param conf
+ *   Pointer to PMU sampler configuration
+ * @return
+ *   Pointer to source structure on success, NULL on error
+ */
+__rte_experimental
+struct rte_sampler_source *rte_sampler_pmu_source_register(
+				struct rte_sampler_session *session,
+				const struct rte_sampler_pmu_conf *conf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Unregister a PMU source
+ *
+ * The listed lcores must no longer call rte_sampler_pmu_update().
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param source
+ *   Pointer returned by rte_sampler_pmu_source_register()
+ * @return
+ *   Zero on success, negative on error
+ */
+__rte_experimental
+int rte_sampler_pmu_source_unregister(struct rte_sampler_session *session,
+				      struct rte_sampler_source *source);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Publish the PMU counters of the calling lcore
+ *
+ * Called periodically by each lcore listed in the configuration, typically
+ * once per iteration of its processing loop. Does nothing on other lcores.
+ *
+ * @param source
+ *   Pointer returned by rte_sampler_pmu_source_register()
+ */
+__rte_experimental
+void rte_sampler_pmu_update(struct rte_sampler_source *source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_SAMPLER_PMU_H_ */
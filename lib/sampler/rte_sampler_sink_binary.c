@@ -0,0 +1,331 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_log.h>
+#include <rte_malloc.h>
+#include <rte_string_fns.h>
+#include <rte_sampler.h>
+#include "rte_sampler_sink_binary.h"
+
+#define DEFAULT_SEGMENT_SIZE (64 * 1024 * 1024)
+#define INITIAL_STREAMS_CAPACITY 4
+
+/**
+ * Per-source output stream, maps the current segment file
+ */
+struct binary_stream {
+	char source_name[64];
+	uint16_t source_id;
+	int fd;                    /* Current segment, -1 if none */
+	uint8_t *base;             /* Mapping of the current segment */
+	size_t map_size;
+	struct rte_sampler_binary_header *hdr;
+	uint64_t *ids;             /* Columns of the current segment */
+	uint32_t num_columns;
+	uint64_t max_rows;         /* Rows fitting in the current segment */
+	uint32_t segment;          /* Segment sequence number */
+};
+
+/**
+ * Binary sink user data structure
+ */
+struct binary_sink_data {
+	char path_prefix[PATH_MAX];
+	uint64_t segment_size;
+	uint32_t max_segments;
+	uint64_t tsc_hz;
+	struct rte_sampler_session *session;
+	struct binary_stream *streams;
+	unsigned int num_streams;
+	unsigned int streams_capacity;
+};
+
+/**
+ * Truncate the current segment to its used size and unmap it
+ */
+static void
+stream_close_segment(struct binary_stream *stream)
+{
+	uint64_t used;
+
+	if (stream->fd < 0)
+		return;
+
+	used = stream->hdr->data_offset + stream->hdr->num_rows * stream->hdr->row_size;
+	munmap(stream->base, stream->map_size);
+	if (ftruncate(stream->fd, used) < 0)
+		RTE_LOG(WARNING, USER1, "Failed to truncate sampler segment: %s\n",
+			strerror(errno));
+	close(stream->fd);
+
+	rte_free(stream->ids);
+	stream->ids = NULL;
+	stream->fd = -1;
+	stream->base = NULL;
+	stream->hdr = NULL;
+	stream->segment++;
+}
+
+/**
+ * Start a new segment and write its header and columns
+ */
+static int
+stream_open_segment(struct binary_sink_data *data, struct binary_stream *stream,
+		    const struct rte_sampler_xstats_name *xstats_names,
+		    const uint64_t *ids, unsigned int n)
+{
+	struct rte_sampler_binary_column *cols;
+	char path[PATH_MAX];
+	uint64_t data_offset, row_size, size;
+	uint32_t seq;
+	unsigned int i;
+	int ret;
+
+	row_size = sizeof(uint64_t) * (n + 1);
+	data_offset = RTE_ALIGN_CEIL(sizeof(struct rte_sampler_binary_header) +
+		n * sizeof(struct rte_sampler_binary_column), RTE_CACHE_LINE_SIZE);
+	size = RTE_MAX(data->segment_size, data_offset + row_size);
+
+	seq = data->max_segments > 0 ? stream->segment % data->max_segments :
+		stream->segment;
+	if (snprintf(path, sizeof(path), "%s_%s_%u_%06u.bin", data->path_prefix,
+		     stream->source_name, stream->source_id, seq) >= (int)sizeof(path))
+		return -ENAMETOOLONG;
+
+	stream->ids = rte_malloc(NULL, sizeof(uint64_t) * RTE_MAX(n, 1U), 0);
+	if (stream->ids == NULL)
+		return -ENOMEM;
+
+	stream->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (stream->fd < 0) {
+		ret = -errno;
+		goto fail;
+	}
+
+	/* Preallocate the whole segment so appending never extends the file */
+	if (ftruncate(stream->fd, size) < 0) {
+		ret = -errno;
+		goto fail_close;
+	}
+
+	stream->base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+		stream->fd, 0);
+	if (stream->base == MAP_FAILED) {
+		ret = -errno;
+		goto fail_close;
+	}
+
+	stream->map_size = size;
+	stream->hdr = (struct rte_sampler_binary_header *)stream->base;
+	memcpy(stream->hdr->magic, RTE_SAMPLER_BINARY_MAGIC, sizeof(stream->hdr->magic));
+	stream->hdr->version = RTE_SAMPLER_BINARY_VERSION;
+	stream->hdr->num_columns = n;
+	stream->hdr->row_size = row_size;
+	stream->hdr->data_offset = data_offset;
+	stream->hdr->num_rows = 0;
+	stream->hdr->tsc_hz = data->tsc_hz;
+	stream->hdr->source_id = stream->source_id;
+	rte_strscpy(stream->hdr->source_name, stream->source_name,
+		sizeof(stream->hdr->source_name));
+
+	cols = (struct rte_sampler_binary_column *)(stream->hdr + 1);
+	for (i = 0; i < n; i++) {
+		cols[i].id = ids[i];
+		if (xstats_names != NULL)
+			rte_strscpy(cols[i].name, xstats_names[i].name,
+				sizeof(cols[i].name));
+		else
+			snprintf(cols[i].name, sizeof(cols[i].name), "%"PRIu64, ids[i]);
+	}
+
+	memcpy(stream->ids, ids, sizeof(uint64_t) * n);
+	stream->num_columns = n;
+	stream->max_rows = (size - data_offset) / row_size;
+
+	return 0;
+
+fail_close:
+	close(stream->fd);
+fail:
+	RTE_LOG(ERR, USER1, "Failed to create sampler segment %s: %s\n",
+		path, strerror(-ret));
+	stream->fd = -1;
+	stream->base = NULL;
+	rte_free(stream->ids);
+	stream->ids = NULL;
+	return ret;
+}
+
+/**
+ * Find or add the stream of a source
+ */
+static struct binary_stream *
+find_stream(struct binary_sink_data *data, const char *source_name,
+	    uint16_t source_id)
+{
+	struct binary_stream *stream;
+	unsigned int i;
+
+	for (i = 0; i < data->num_streams; i++) {
+		stream = &data->streams[i];
+		if (stream->source_id == source_id &&
+		    strcmp(stream->source_name, source_name) == 0)
+			return stream;
+	}
+
+	if (data->num_streams == data->streams_capacity) {
+		struct binary_stream *new_streams;
+		unsigned int new_capacity = data->streams_capacity * 2;
+
+		new_streams = rte_zmalloc(NULL,
+			new_capacity * sizeof(struct binary_stream), 0);
+		if (new_streams == NULL)
+			return NULL;
+
+		memcpy(new_streams, data->streams,
+			data->num_streams * sizeof(struct binary_stream));
+		rte_free(data->streams);
+		data->streams = new_streams;
+		data->streams_capacity = new_capacity;
+	}
+
+	stream = &data->streams[data->num_streams++];
+	memset(stream, 0, sizeof(*stream));
+	rte_strscpy(stream->source_name, source_name, sizeof(stream->source_name));
+	stream->source_id = source_id;
+	stream->fd = -1;
+
+	return stream;
+}
+
+/**
+ * Binary sink output callback
+ */
+static int
+binary_sink_output(const char *source_name,
+		uint16_t source_id,
+		const struct rte_sampler_xstats_name *xstats_names,
+		const uint64_t *ids,
+		const uint64_t *values,
+		unsigned int n,
+		void *user_data)
+{
+	struct binary_sink_data *data = user_data;
+	struct binary_stream *stream;
+	uint64_t *row;
+	int ret;
+
+	if (data == NULL)
+		return -EINVAL;
+
+	stream = find_stream(data, source_name, source_id);
+	if (stream == NULL)
+		return -ENOMEM;
+
+	/* Columns are written once per segment, restart if they change */
+	if (stream->fd >= 0 && (stream->num_columns != n ||
+	    memcmp(stream->ids, ids, sizeof(uint64_t) * n) != 0))
+		stream_close_segment(stream);
+
+	if (stream->fd >= 0 && stream->hdr->num_rows == stream->max_rows)
+		stream_close_segment(stream);
+
+	if (stream->fd < 0) {
+		ret = stream_open_segment(data, stream, xstats_names, ids, n);
+		if (ret < 0)
+			return ret;
+	}
+
+	row = (uint64_t *)(stream->base + stream->hdr->data_offset +
+		stream->hdr->num_rows * stream->hdr->row_size);
+	row[0] = rte_sampler_session_get_sample_tsc(data->session);
+	memcpy(&row[1], values, sizeof(uint64_t) * n);
+
+	/* Publish the row to concurrent readers of the mapping */
+	rte_wmb();
+	stream->hdr->num_rows++;
+
+	return 0;
+}
+
+struct rte_sampler_sink *
+rte_sampler_sink_binary_create(struct rte_sampler_session *session,
+		const char *name,
+		const struct rte_sampler_sink_binary_conf *conf)
+{
+	struct rte_sampler_sink_ops ops;
+	struct binary_sink_data *data;
+	struct rte_sampler_sink *sink;
+
+	if (session == NULL || name == NULL || conf == NULL ||
+	    conf->path_prefix == NULL)
+		return NULL;
+
+	/* Allocate sink data */
+	data = rte_zmalloc(NULL, sizeof(*data), 0);
+	if (data == NULL)
+		return NULL;
+
+	data->streams = rte_zmalloc(NULL,
+		INITIAL_STREAMS_CAPACITY * sizeof(struct binary_stream), 0);
+	if (data->streams == NULL) {
+		rte_free(data);
+		return NULL;
+	}
+	data->streams_capacity = INITIAL_STREAMS_CAPACITY;
+
+	rte_strscpy(data->path_prefix, conf->path_prefix, sizeof(data->path_prefix));
+	data->segment_size = conf->segment_size > 0 ? conf->segment_size :
+		DEFAULT_SEGMENT_SIZE;
+	data->segment_size = RTE_ALIGN_CEIL(data->segment_size, sysconf(_SC_PAGESIZE));
+	data->max_segments = conf->max_segments;
+	data->tsc_hz = rte_get_tsc_hz();
+	data->session = session;
+
+	/* Setup sink operations, names are only needed for segment headers */
+	memset(&ops, 0, sizeof(ops));
+	ops.output = binary_sink_output;
+	ops.flags = 0;
+
+	/* Register sink */
+	sink = rte_sampler_session_register_sink(session, name, &ops, data);
+	if (sink == NULL) {
+		rte_free(data->streams);
+		rte_free(data);
+		return NULL;
+	}
+
+	return sink;
+}
+
+int
+rte_sampler_sink_binary_destroy(struct rte_sampler_sink *sink)
+{
+	struct binary_sink_data *data;
+	unsigned int i;
+
+	data = rte_sampler_sink_get_user_data(sink);
+	if (data == NULL)
+		return -EINVAL;
+
+	rte_sampler_sink_free(sink);
+
+	for (i = 0; i < data->num_streams; i++)
+		stream_close_segment(&data->streams[i]);
+
+	rte_free(data->streams);
+	rte_free(data);
+
+	return 0;
+}
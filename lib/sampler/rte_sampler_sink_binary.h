@@ -0,0 +1,117 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#ifndef _RTE_SAMPLER_SINK_BINARY_H_
+#define _RTE_SAMPLER_SINK_BINARY_H_
+
+/**
+ * @file
+ * RTE Sampler Binary Columnar Sink
+ *
+ * Binary sink implementation for the sampler library.
+ * Each source is written to its own series of segment files. A segment
+ * starts with a header and the list of columns (xstats IDs and names),
+ * written once, followed by fixed-width rows of uint64_t values:
+ * the TSC timestamp of the sample, then one value per column.
+ *
+ * Segments are preallocated and memory-mapped, so appending a row is
+ * a memory copy without formatting or system call. When a segment is full,
+ * or when the set of columns of a source changes, a new segment is started.
+ * Segments are reused in a round-robin fashion if max_segments is set.
+ *
+ * Segments are in host byte order and can be converted to CSV offline
+ * with usertools/dpdk-sampler-decode.py.
+ */
+
+#include <stdint.h>
+#include <rte_sampler.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Magic string at the start of each segment file */
+#define RTE_SAMPLER_BINARY_MAGIC "DPDKSMPL"
+
+/** Segment format version */
+#define RTE_SAMPLER_BINARY_VERSION 1
+
+/**
+ * Binary segment file header
+ */
+struct rte_sampler_binary_header {
+	char magic[8];          /**< RTE_SAMPLER_BINARY_MAGIC, not NUL terminated */
+	uint32_t version;       /**< RTE_SAMPLER_BINARY_VERSION */
+	uint32_t num_columns;   /**< Number of value columns */
+	uint64_t row_size;      /**< Size of a row in bytes */
+	uint64_t data_offset;   /**< Offset of the first row in the file */
+	uint64_t num_rows;      /**< Number of valid rows, updated after each row */
+	uint64_t tsc_hz;        /**< TSC frequency of the row timestamps */
+	uint16_t source_id;     /**< Source identifier */
+	uint8_t reserved[6];    /**< Reserved, zero */
+	char source_name[64];   /**< Source name */
+};
+
+/**
+ * Binary segment column descriptor, follows the header
+ */
+struct rte_sampler_binary_column {
+	uint64_t id;                                /**< Stat ID */
+	char name[RTE_SAMPLER_XSTATS_NAME_SIZE];    /**< Stat name */
+};
+
+/**
+ * Binary sink configuration
+ */
+struct rte_sampler_sink_binary_conf {
+	const char *path_prefix;  /**< Segment files path prefix */
+	uint64_t segment_size;    /**< Segment file size in bytes (0=default) */
+	uint32_t max_segments;    /**< Segments per source before reuse (0=no limit) */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create and register a binary columnar sink
+ *
+ * Segment files are named
+ * "<path_prefix>_<source_name>_<source_id>_<segment>.bin".
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param name
+ *   Name for this sink instance
+ * @param conf
+ *   Pointer to binary sink configuration
+ * @return
+ *   Pointer to sink structure on success, NULL on error
+ */
+__rte_experimental
+struct rte_sampler_sink *rte_sampler_sink_binary_create(
+		struct rte_sampler_session *session,
+		const char *name,
+		const struct rte_sampler_sink_binary_conf *conf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Destroy a binary sink
+ *
+ * Open segments are truncated to their used size and closed.
+ *
+ * @param sink
+ *   Pointer to sink structure
+ * @return
+ *   Zero on success, negative on error
+ */
+__rte_experimental
+int rte_sampler_sink_binary_destroy(struct rte_sampler_sink *sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_SAMPLER_SINK_BINARY_H_ */
@@ -0,0 +1,152 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <rte_common.h>
+#include <rte_ethdev.h>
+#include <rte_malloc.h>
+#include <rte_sampler.h>
+#include "rte_sampler_sink_bitrate.h"
+
+#define BITRATE_RX_XSTAT "rx_good_bytes"
+#define BITRATE_TX_XSTAT "tx_good_bytes"
+
+/**
+ * Position of the byte counters in the samples of a port
+ */
+struct bitrate_port {
+	uint64_t rx_id;
+	uint64_t tx_id;
+	unsigned int rx_idx;
+	unsigned int tx_idx;
+	uint8_t valid;
+};
+
+/**
+ * Bitrate sink user data structure
+ */
+struct bitrate_sink_data {
+	struct rte_stats_bitrates *bitrate_data;
+	struct bitrate_port ports[RTE_MAX_ETHPORTS];
+};
+
+/**
+ * Find the byte counters in the samples of a port, when its stats change
+ */
+static int
+bitrate_port_resolve(struct bitrate_port *port,
+		const struct rte_sampler_xstats_name *xstats_names,
+		const uint64_t *ids, unsigned int n)
+{
+	unsigned int i;
+	int found = 0;
+
+	if (port->valid && port->rx_idx < n && port->tx_idx < n &&
+	    ids[port->rx_idx] == port->rx_id && ids[port->tx_idx] == port->tx_id)
+		return 0;
+
+	port->valid = 0;
+	if (xstats_names == NULL)
+		return -EINVAL;
+
+	for (i = 0; i < n; i++) {
+		if (strcmp(xstats_names[i].name, BITRATE_RX_XSTAT) == 0) {
+			port->rx_idx = i;
+			port->rx_id = ids[i];
+			found |= 1;
+		} else if (strcmp(xstats_names[i].name, BITRATE_TX_XSTAT) == 0) {
+			port->tx_idx = i;
+			port->tx_id = ids[i];
+			found |= 2;
+		}
+	}
+	if (found != 3)
+		return -ENOENT;
+
+	port->valid = 1;
+	return 0;
+}
+
+/**
+ * Bitrate sink output callback
+ */
+static int
+bitrate_sink_output(const char *source_name,
+		uint16_t source_id,
+		const struct rte_sampler_xstats_name *xstats_names,
+		const uint64_t *ids,
+		const uint64_t *values,
+		unsigned int n,
+		void *user_data)
+{
+	struct bitrate_sink_data *data = user_data;
+	char port_source_name[RTE_SAMPLER_XSTATS_NAME_SIZE];
+	struct bitrate_port *port;
+
+	if (data == NULL)
+		return -EINVAL;
+
+	/* Only the ethdev port sources, not the queue ones */
+	if (source_id >= RTE_MAX_ETHPORTS)
+		return 0;
+	snprintf(port_source_name, sizeof(port_source_name), "ethdev_%u",
+		 source_id);
+	if (strcmp(source_name, port_source_name) != 0)
+		return 0;
+
+	port = &data->ports[source_id];
+	if (bitrate_port_resolve(port, xstats_names, ids, n) < 0)
+		return 0;
+
+	return rte_stats_bitrate_calc_bytes(data->bitrate_data, source_id,
+		values[port->rx_idx], values[port->tx_idx]);
+}
+
+struct rte_sampler_sink *
+rte_sampler_sink_bitrate_create(struct rte_sampler_session *session,
+		const char *name,
+		struct rte_stats_bitrates *bitrate_data)
+{
+	struct rte_sampler_sink_ops ops;
+	struct bitrate_sink_data *data;
+	struct rte_sampler_sink *sink;
+
+	if (session == NULL || name == NULL || bitrate_data == NULL)
+		return NULL;
+
+	data = rte_zmalloc(NULL, sizeof(*data), 0);
+	if (data == NULL)
+		return NULL;
+	data->bitrate_data = bitrate_data;
+
+	/* Raw cumulative values, names are needed to find the counters */
+	memset(&ops, 0, sizeof(ops));
+	ops.output = bitrate_sink_output;
+	ops.flags = 0;
+
+	sink = rte_sampler_session_register_sink(session, name, &ops, data);
+	if (sink == NULL) {
+		rte_free(data);
+		return NULL;
+	}
+
+	return sink;
+}
+
+int
+rte_sampler_sink_bitrate_destroy(struct rte_sampler_sink *sink)
+{
+	struct bitrate_sink_data *data;
+
+	data = rte_sampler_sink_get_user_data(sink);
+	if (data == NULL)
+		return -EINVAL;
+
+	rte_sampler_sink_free(sink);
+	rte_free(data);
+
+	return 0;
+}
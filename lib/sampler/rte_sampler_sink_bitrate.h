@@ -0,0 +1,69 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_SAMPLER_SINK_BITRATE_H_
+#define _RTE_SAMPLER_SINK_BITRATE_H_
+
+/**
+ * @file
+ * RTE Sampler Bitrate Sink
+ *
+ * Sink calculating the bit-rate statistics of the bitratestats library
+ * from the samples of the ethdev port sources of a session, instead of
+ * reading the ethdev basic statistics from an application lcore.
+ * The "rx_good_bytes" and "tx_good_bytes" xstats of each port are passed
+ * to rte_stats_bitrate_calc_bytes() at each sample, so that the sampling
+ * interval of the session is the bit-rate window.
+ */
+
+#include <rte_bitrate.h>
+#include <rte_sampler.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create and register a bitrate sink
+ *
+ * The ethdev sources of the session must sample the
+ * "rx_good_bytes" and "tx_good_bytes" xstats, other sources are ignored.
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param name
+ *   Name for this sink instance
+ * @param bitrate_data
+ *   Bitrate statistics registered with rte_stats_bitrate_reg()
+ * @return
+ *   Pointer to sink structure on success, NULL on error
+ */
+__rte_experimental
+struct rte_sampler_sink *rte_sampler_sink_bitrate_create(
+		struct rte_sampler_session *session,
+		const char *name,
+		struct rte_stats_bitrates *bitrate_data);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Destroy a bitrate sink
+ *
+ * @param sink
+ *   Pointer to sink structure
+ * @return
+ *   Zero on success, negative on error
+ */
+__rte_experimental
+int rte_sampler_sink_bitrate_destroy(struct rte_sampler_sink *sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_SAMPLER_SINK_BITRATE_H_ */
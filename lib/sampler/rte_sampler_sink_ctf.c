@@ -2,12 +2,17 @@
  * Copyright(c) 2024 Intel Corporation
  */
 
+#include <ctype.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <time.h>
+#include <rte_byteorder.h>
 #include <rte_common.h>
 #include <rte_malloc.h>
 #include <rte_cycles.h>
@@ -15,6 +20,31 @@
 #include <rte_sampler.h>
 #include "rte_sampler_sink_ctf.h"
 
+#define CTF_MAGIC 0xC1FC1FC1
+#define CTF_STREAM_ID 0
+
+/* Packet header: magic, stream_id */
+#define CTF_PACKET_HEADER_SIZE (2 * sizeof(uint32_t))
+/* Packet context: timestamp_begin, timestamp_end, content_size, packet_size, events_discarded */
+#define CTF_PACKET_CONTEXT_SIZE (5 * sizeof(uint64_t))
+#define CTF_PACKET_START (CTF_PACKET_HEADER_SIZE + CTF_PACKET_CONTEXT_SIZE)
+/* Event header: id, timestamp */
+#define CTF_EVENT_HEADER_SIZE (sizeof(uint32_t) + sizeof(uint64_t))
+
+/* Buffer of the unbuffered mode, holding the packet of a single sample */
+#define DEFAULT_PACKET_SIZE (64 * 1024)
+#define INITIAL_CLASSES_CAPACITY 4
+
+/**
+ * Event class, declared in the metadata for a source and set of stats
+ */
+struct ctf_event_class {
+	char source_name[64];
+	uint16_t source_id;
+	uint32_t num_stats;
+	uint64_t *ids;
+};
+
 /**
  * CTF sink user data structure
  */
@@ -23,216 +53,390 @@ struct ctf_sink_data {
 	FILE *stream_fp;
 	char trace_dir[256];
 	char trace_name[64];
+	struct rte_sampler_session *session;
+	struct ctf_event_class *classes;
+	unsigned int num_classes;
+	unsigned int classes_capacity;
+	uint8_t *packet;           /* Packet being filled */
+	uint32_t packet_size;      /* Size of the packet buffer */
+	uint32_t packet_used;      /* Bytes used, CTF_PACKET_START if no event */
+	uint8_t buffered;
+	uint64_t flush_cycles;     /* Buffering time limit, 0 if none */
+	uint64_t timestamp_begin;
+	uint64_t timestamp_end;
 	uint64_t event_count;
-	uint8_t metadata_written;
+	uint64_t events_discarded;
 };
 
 /**
- * Write CTF metadata (simplified version)
+ * Write CTF metadata header, event classes are appended when sampled
  */
 static int
 write_ctf_metadata(struct ctf_sink_data *data)
 {
-FILE *fp = data->metadata_fp;
-
-if (data->metadata_written)
-return 0;
-
-/* CTF metadata header */
-fprintf(fp, "/* CTF 1.8 */\n\n");
-
-/* Typealias declarations */
-		fprintf(fp, "typealias integer { size = 8; align = 8; signed = false; } := uint8_t;\n");
-		fprintf(fp, "typealias integer { size = 16; align = 16; signed = false; } := uint16_t;\n");
-		fprintf(fp, "typealias integer { size = 32; align = 32; signed = false; } := uint32_t;\n");
-		fprintf(fp, "typealias integer { size = 64; align = 64; signed = false; } := uint64_t;\n\n");
-
-/* Trace block */
-fprintf(fp, "trace {\n");
-fprintf(fp, "  major = 1;\n");
-fprintf(fp, "  minor = 8;\n");
-fprintf(fp, "  byte_order = le;\n");
-fprintf(fp, "  packet.header := struct {\n");
-		fprintf(fp, "    uint32_t magic;\n");
-		fprintf(fp, "    uint64_t stream_id;\n");
-fprintf(fp, "  };\n");
-fprintf(fp, "};\n\n");
-
-/* Clock */
-fprintf(fp, "clock {\n");
-fprintf(fp, "  name = monotonic;\n");
-fprintf(fp, "  freq = 1000000000;\n");
-fprintf(fp, "};\n\n");
-
-/* Stream */
-fprintf(fp, "stream {\n");
-fprintf(fp, "  packet.context := struct {\n");
-		fprintf(fp, "    uint64_t timestamp_begin;\n");
-		fprintf(fp, "    uint64_t timestamp_end;\n");
-		fprintf(fp, "    uint64_t events_discarded;\n");
-fprintf(fp, "  };\n");
-fprintf(fp, "  event.header := struct {\n");
-		fprintf(fp, "    uint64_t timestamp;\n");
-		fprintf(fp, "    uint32_t id;\n");
-fprintf(fp, "  };\n");
-fprintf(fp, "};\n\n");
-
-/* Event definition */
-fprintf(fp, "event {\n");
-fprintf(fp, "  name = \"sampler_stats\";\n");
-fprintf(fp, "  id = 0;\n");
-fprintf(fp, "  fields := struct {\n");
-fprintf(fp, "    string source_name;\n");
-		fprintf(fp, "    uint16_t source_id;\n");
-		fprintf(fp, "    uint32_t num_stats;\n");
-		fprintf(fp, "    uint64_t stat_id;\n");
-		fprintf(fp, "    uint64_t stat_value;\n");
-fprintf(fp, "  };\n");
-fprintf(fp, "};\n");
-
-fflush(fp);
-data->metadata_written = 1;
-
-return 0;
+	FILE *fp = data->metadata_fp;
+	uint64_t tsc_hz = rte_get_tsc_hz();
+	uint64_t tsc = rte_get_tsc_cycles();
+	struct timespec ts;
+	uint64_t epoch_ns;
+
+	/* Realtime of TSC zero, for the viewers to show absolute times */
+	clock_gettime(CLOCK_REALTIME, &ts);
+	epoch_ns = (uint64_t)ts.tv_sec * NS_PER_S + ts.tv_nsec;
+	epoch_ns -= (tsc / tsc_hz) * NS_PER_S + (tsc % tsc_hz) * NS_PER_S / tsc_hz;
+
+	fprintf(fp, "/* CTF 1.8 */\n\n");
+
+	/* All fields are byte aligned, so that the stream is packed */
+	fprintf(fp, "typealias integer { size = 16; align = 8; signed = false; } := uint16_t;\n");
+	fprintf(fp, "typealias integer { size = 32; align = 8; signed = false; } := uint32_t;\n");
+	fprintf(fp, "typealias integer { size = 64; align = 8; signed = false; } := uint64_t;\n\n");
+
+	fprintf(fp, "trace {\n");
+	fprintf(fp, "\tmajor = 1;\n");
+	fprintf(fp, "\tminor = 8;\n");
+	fprintf(fp, "\tbyte_order = %s;\n",
+		RTE_BYTE_ORDER == RTE_LITTLE_ENDIAN ? "le" : "be");
+	fprintf(fp, "\tpacket.header := struct {\n");
+	fprintf(fp, "\t\tuint32_t magic;\n");
+	fprintf(fp, "\t\tuint32_t stream_id;\n");
+	fprintf(fp, "\t};\n");
+	fprintf(fp, "};\n\n");
+
+	fprintf(fp, "env {\n");
+	fprintf(fp, "\ttrace_name = \"%s\";\n", data->trace_name);
+	fprintf(fp, "};\n\n");
+
+	fprintf(fp, "clock {\n");
+	fprintf(fp, "\tname = tsc;\n");
+	fprintf(fp, "\tfreq = %" PRIu64 ";\n", tsc_hz);
+	fprintf(fp, "\toffset_s = %" PRIu64 ";\n", epoch_ns / NS_PER_S);
+	fprintf(fp, "\toffset = %" PRIu64 ";\n",
+		(epoch_ns % NS_PER_S) * tsc_hz / NS_PER_S);
+	fprintf(fp, "};\n\n");
+
+	fprintf(fp, "typealias integer { size = 64; align = 8; signed = false;"
+		" map = clock.tsc.value; } := uint64_clock_tsc_t;\n\n");
+
+	fprintf(fp, "stream {\n");
+	fprintf(fp, "\tid = %u;\n", CTF_STREAM_ID);
+	fprintf(fp, "\tpacket.context := struct {\n");
+	fprintf(fp, "\t\tuint64_clock_tsc_t timestamp_begin;\n");
+	fprintf(fp, "\t\tuint64_clock_tsc_t timestamp_end;\n");
+	fprintf(fp, "\t\tuint64_t content_size;\n");
+	fprintf(fp, "\t\tuint64_t packet_size;\n");
+	fprintf(fp, "\t\tuint64_t events_discarded;\n");
+	fprintf(fp, "\t};\n");
+	fprintf(fp, "\tevent.header := struct {\n");
+	fprintf(fp, "\t\tuint32_t id;\n");
+	fprintf(fp, "\t\tuint64_clock_tsc_t timestamp;\n");
+	fprintf(fp, "\t};\n");
+	fprintf(fp, "};\n");
+
+	if (fflush(fp) != 0)
+		return -EIO;
+
+	return 0;
 }
 
 /**
- * Write event to CTF stream (binary format - simplified)
+ * Copy a name into the metadata, as a CTF identifier
  */
-static int
-write_ctf_event(struct ctf_sink_data *data,
-const char *source_name,
-uint16_t source_id,
-const uint64_t *ids,
-const uint64_t *values,
-unsigned int n)
+static void
+ctf_identifier(char *dst, size_t size, const char *name)
 {
-uint64_t timestamp;
-uint32_t event_id = 0;
-unsigned int i;
-uint16_t name_len;
-
-timestamp = rte_get_timer_cycles();
-
-for (i = 0; i < n; i++) {
-/* Event header */
-		fwrite(&timestamp, sizeof(uint64_t), 1, data->stream_fp);
-		fwrite(&event_id, sizeof(uint32_t), 1, data->stream_fp);
-
-/* Event payload */
-name_len = strlen(source_name) + 1;
-		fwrite(&name_len, sizeof(uint16_t), 1, data->stream_fp);
-fwrite(source_name, 1, name_len, data->stream_fp);
-		fwrite(&source_id, sizeof(uint16_t), 1, data->stream_fp);
-		fwrite(&n, sizeof(uint32_t), 1, data->stream_fp);
-		fwrite(&ids[i], sizeof(uint64_t), 1, data->stream_fp);
-		fwrite(&values[i], sizeof(uint64_t), 1, data->stream_fp);
-
-data->event_count++;
-}
+	size_t i;
 
-fflush(data->stream_fp);
-return 0;
+	/* Leading underscore is removed by readers, and avoids keywords */
+	dst[0] = '_';
+	for (i = 1; i < size - 1 && name[i - 1] != '\0'; i++)
+		dst[i] = isalnum((unsigned char)name[i - 1]) ? name[i - 1] : '_';
+	dst[i] = '\0';
 }
 
 /**
- * CTF sink output callback
+ * Find the event class of a source and set of stats, declare it if new
  */
 static int
-		ctf_sink_output(const char *source_name,
-uint16_t source_id,
-const struct rte_sampler_xstats_name *xstats_names,
-const uint64_t *ids,
-const uint64_t *values,
-unsigned int n,
-void *user_data)
+find_event_class(struct ctf_sink_data *data, const char *source_name,
+		 uint16_t source_id,
+		 const struct rte_sampler_xstats_name *xstats_names,
+		 const uint64_t *ids, unsigned int n)
 {
-struct ctf_sink_data *data = user_data;
-
-(void)xstats_names;  /* Names in metadata, not in stream */
-
-if (data == NULL)
-return -EINVAL;
+	char field[RTE_SAMPLER_XSTATS_NAME_SIZE + 1];
+	struct ctf_event_class *cls;
+	FILE *fp = data->metadata_fp;
+	unsigned int i;
+
+	for (i = 0; i < data->num_classes; i++) {
+		cls = &data->classes[i];
+		if (cls->source_id == source_id && cls->num_stats == n &&
+		    strcmp(cls->source_name, source_name) == 0 &&
+		    memcmp(cls->ids, ids, sizeof(uint64_t) * n) == 0)
+			return i;
+	}
+
+	if (data->num_classes == data->classes_capacity) {
+		struct ctf_event_class *new_classes;
+		unsigned int new_capacity = data->classes_capacity * 2;
+
+		new_classes = rte_zmalloc(NULL,
+			new_capacity * sizeof(struct ctf_event_class), 0);
+		if (new_classes == NULL)
+			return -ENOMEM;
+
+		memcpy(new_classes, data->classes,
+			data->num_classes * sizeof(struct ctf_event_class));
+		rte_free(data->classes);
+		data->classes = new_classes;
+		data->classes_capacity = new_capacity;
+	}
+
+	cls = &data->classes[data->num_classes];
+	cls->ids = rte_malloc(NULL, sizeof(uint64_t) * RTE_MAX(n, 1U), 0);
+	if (cls->ids == NULL)
+		return -ENOMEM;
+	memcpy(cls->ids, ids, sizeof(uint64_t) * n);
+	rte_strscpy(cls->source_name, source_name, sizeof(cls->source_name));
+	cls->source_id = source_id;
+	cls->num_stats = n;
+
+	/* Names are written once here, events only hold the values */
+	ctf_identifier(field, sizeof(field), source_name);
+	fprintf(fp, "\nevent {\n");
+	fprintf(fp, "\tname = \"%s_%u\";\n", field + 1, source_id);
+	fprintf(fp, "\tid = %u;\n", data->num_classes);
+	fprintf(fp, "\tstream_id = %u;\n", CTF_STREAM_ID);
+	fprintf(fp, "\tfields := struct {\n");
+	for (i = 0; i < n; i++) {
+		if (xstats_names != NULL)
+			ctf_identifier(field, sizeof(field), xstats_names[i].name);
+		else
+			snprintf(field, sizeof(field), "_%" PRIu64, ids[i]);
+		fprintf(fp, "\t\tuint64_t %s;\n", field);
+	}
+	fprintf(fp, "\t};\n");
+	fprintf(fp, "};\n");
+	if (fflush(fp) != 0) {
+		rte_free(cls->ids);
+		return -EIO;
+	}
+
+	return data->num_classes++;
+}
 
-/* Write metadata on first event */
-if (!data->metadata_written) {
-write_ctf_metadata(data);
+/**
+ * Write the packet being filled, if it holds any event
+ */
+static int
+flush_ctf_packet(struct ctf_sink_data *data)
+{
+	uint64_t context[CTF_PACKET_CONTEXT_SIZE / sizeof(uint64_t)];
+	uint32_t header[CTF_PACKET_HEADER_SIZE / sizeof(uint32_t)];
+	uint32_t used = data->packet_used;
+	int ret = 0;
+
+	if (used == CTF_PACKET_START)
+		return 0;
+
+	header[0] = CTF_MAGIC;
+	header[1] = CTF_STREAM_ID;
+	context[0] = data->timestamp_begin;
+	context[1] = data->timestamp_end;
+	context[2] = (uint64_t)used * CHAR_BIT;   /* content_size in bits */
+	context[3] = (uint64_t)used * CHAR_BIT;   /* packet_size in bits */
+	context[4] = data->events_discarded;
+	memcpy(data->packet, header, sizeof(header));
+	memcpy(data->packet + sizeof(header), context, sizeof(context));
+
+	if (fwrite(data->packet, used, 1, data->stream_fp) != 1 ||
+	    fflush(data->stream_fp) != 0)
+		ret = -EIO;
+
+	data->packet_used = CTF_PACKET_START;
+
+	return ret;
 }
 
-/* Write events */
-return write_ctf_event(data, source_name, source_id, ids, values, n);
+/**
+ * CTF sink output callback
+ */
+static int
+ctf_sink_output(const char *source_name,
+		uint16_t source_id,
+		const struct rte_sampler_xstats_name *xstats_names,
+		const uint64_t *ids,
+		const uint64_t *values,
+		unsigned int n,
+		void *user_data)
+{
+	struct ctf_sink_data *data = user_data;
+	size_t event_size = CTF_EVENT_HEADER_SIZE + sizeof(uint64_t) * n;
+	uint64_t timestamp;
+	uint32_t event_id;
+	uint8_t *ev;
+	int ret;
+
+	if (data == NULL)
+		return -EINVAL;
+
+	ret = find_event_class(data, source_name, source_id, xstats_names,
+			       ids, n);
+	if (ret < 0)
+		return ret;
+	event_id = ret;
+
+	if (data->packet_used + event_size > data->packet_size) {
+		ret = flush_ctf_packet(data);
+		if (ret < 0)
+			return ret;
+		if (CTF_PACKET_START + event_size > data->packet_size) {
+			data->events_discarded++;
+			return -ENOSPC;
+		}
+	}
+
+	timestamp = rte_sampler_session_get_sample_tsc(data->session);
+	if (timestamp == 0)
+		timestamp = rte_get_tsc_cycles();
+	if (data->packet_used == CTF_PACKET_START)
+		data->timestamp_begin = timestamp;
+	data->timestamp_end = timestamp;
+
+	ev = data->packet + data->packet_used;
+	memcpy(ev, &event_id, sizeof(event_id));
+	memcpy(ev + sizeof(event_id), &timestamp, sizeof(timestamp));
+	memcpy(ev + CTF_EVENT_HEADER_SIZE, values, sizeof(uint64_t) * n);
+	data->packet_used += event_size;
+	data->event_count++;
+
+	if (!data->buffered || (data->flush_cycles != 0 &&
+	    timestamp - data->timestamp_begin >= data->flush_cycles))
+		return flush_ctf_packet(data);
+
+	return 0;
 }
 
 struct rte_sampler_sink *
-		rte_sampler_sink_ctf_create(struct rte_sampler_session *session,
+rte_sampler_sink_ctf_create(struct rte_sampler_session *session,
 		const char *name,
 		const struct rte_sampler_sink_ctf_conf *conf)
 {
-struct rte_sampler_sink_ops ops;
-struct ctf_sink_data *data;
-struct rte_sampler_sink *sink;
-char metadata_path[512];
-char stream_path[512];
-
-if (session == NULL || name == NULL || conf == NULL ||
-    conf->trace_dir == NULL || conf->trace_name == NULL)
-return NULL;
-
-/* Allocate sink data */
-data = rte_zmalloc(NULL, sizeof(*data), 0);
-if (data == NULL)
-return NULL;
-
-/* Create trace directory */
-mkdir(conf->trace_dir, 0755);
-
-rte_strscpy(data->trace_dir, conf->trace_dir, sizeof(data->trace_dir));
-rte_strscpy(data->trace_name, conf->trace_name, sizeof(data->trace_name));
-
-/* Open metadata file */
-snprintf(metadata_path, sizeof(metadata_path), "%s/metadata",
- conf->trace_dir);
-data->metadata_fp = fopen(metadata_path, "w");
-if (data->metadata_fp == NULL) {
-rte_free(data);
-return NULL;
+	return rte_sampler_sink_ctf_create_buffered(session, name, conf, NULL);
 }
 
-/* Open stream file */
-snprintf(stream_path, sizeof(stream_path), "%s/%s_0",
- conf->trace_dir, conf->trace_name);
-data->stream_fp = fopen(stream_path, "wb");
-if (data->stream_fp == NULL) {
-fclose(data->metadata_fp);
-rte_free(data);
-return NULL;
+struct rte_sampler_sink *
+rte_sampler_sink_ctf_create_buffered(struct rte_sampler_session *session,
+		const char *name,
+		const struct rte_sampler_sink_ctf_conf *conf,
+		const struct rte_sampler_sink_ctf_buffer_conf *buffer_conf)
+{
+	const struct rte_sampler_sink_ctf_buffer_conf no_buffer = {0};
+	struct rte_sampler_sink_ops ops;
+	struct ctf_sink_data *data;
+	struct rte_sampler_sink *sink;
+	char metadata_path[512];
+	char stream_path[512];
+
+	if (session == NULL || name == NULL || conf == NULL ||
+	    conf->trace_dir == NULL || conf->trace_name == NULL)
+		return NULL;
+
+	if (buffer_conf == NULL)
+		buffer_conf = &no_buffer;
+
+	/* A buffered packet must hold at least an event without stats */
+	if (buffer_conf->packet_size != 0 &&
+	    buffer_conf->packet_size < CTF_PACKET_START + CTF_EVENT_HEADER_SIZE)
+		return NULL;
+
+	/* Allocate sink data */
+	data = rte_zmalloc(NULL, sizeof(*data), 0);
+	if (data == NULL)
+		return NULL;
+
+	data->buffered = buffer_conf->packet_size != 0;
+	data->packet_size = data->buffered ? buffer_conf->packet_size :
+		DEFAULT_PACKET_SIZE;
+	data->packet_used = CTF_PACKET_START;
+	data->flush_cycles = (uint64_t)buffer_conf->flush_interval_us *
+		rte_get_tsc_hz() / US_PER_S;
+	data->session = session;
+
+	data->packet = rte_malloc(NULL, data->packet_size, 0);
+	data->classes = rte_zmalloc(NULL,
+		INITIAL_CLASSES_CAPACITY * sizeof(struct ctf_event_class), 0);
+	if (data->packet == NULL || data->classes == NULL)
+		goto fail_free;
+	data->classes_capacity = INITIAL_CLASSES_CAPACITY;
+
+	/* Create trace directory */
+	mkdir(conf->trace_dir, 0755);
+
+	rte_strscpy(data->trace_dir, conf->trace_dir, sizeof(data->trace_dir));
+	rte_strscpy(data->trace_name, conf->trace_name, sizeof(data->trace_name));
+
+	/* Open metadata file */
+	snprintf(metadata_path, sizeof(metadata_path), "%s/metadata",
+		conf->trace_dir);
+	data->metadata_fp = fopen(metadata_path, "w");
+	if (data->metadata_fp == NULL)
+		goto fail_free;
+
+	/* Open stream file */
+	snprintf(stream_path, sizeof(stream_path), "%s/%s_0",
+		conf->trace_dir, conf->trace_name);
+	data->stream_fp = fopen(stream_path, "wb");
+	if (data->stream_fp == NULL)
+		goto fail_close_metadata;
+
+	if (write_ctf_metadata(data) < 0)
+		goto fail_close_stream;
+
+	/* Setup sink operations, names are only needed for new event classes */
+	memset(&ops, 0, sizeof(ops));
+	ops.output = ctf_sink_output;
+	ops.flags = 0;
+
+	/* Register sink */
+	sink = rte_sampler_session_register_sink(session, name, &ops, data);
+	if (sink == NULL)
+		goto fail_close_stream;
+
+	return sink;
+
+fail_close_stream:
+	fclose(data->stream_fp);
+fail_close_metadata:
+	fclose(data->metadata_fp);
+fail_free:
+	rte_free(data->classes);
+	rte_free(data->packet);
+	rte_free(data);
+	return NULL;
 }
 
-data->event_count = 0;
-data->metadata_written = 0;
+int
+rte_sampler_sink_ctf_destroy(struct rte_sampler_sink *sink)
+{
+	struct ctf_sink_data *data;
+	unsigned int i;
 
-/* Setup sink operations */
-ops.output = ctf_sink_output;
-ops.flags = RTE_SAMPLER_SINK_F_NO_NAMES;  /* Names in metadata */
+	data = rte_sampler_sink_get_user_data(sink);
+	if (data == NULL)
+		return -EINVAL;
 
-/* Register sink */
-sink = rte_sampler_session_register_sink(session, name, &ops, data);
-if (sink == NULL) {
-fclose(data->metadata_fp);
-fclose(data->stream_fp);
-rte_free(data);
-return NULL;
-}
+	rte_sampler_sink_free(sink);
 
-return sink;
-}
+	flush_ctf_packet(data);
+	fclose(data->stream_fp);
+	fclose(data->metadata_fp);
 
-int
-		rte_sampler_sink_ctf_destroy(struct rte_sampler_sink *sink)
-{
-if (sink == NULL)
-return -EINVAL;
+	for (i = 0; i < data->num_classes; i++)
+		rte_free(data->classes[i].ids);
+	rte_free(data->classes);
+	rte_free(data->packet);
+	rte_free(data);
 
-rte_sampler_sink_free(sink);
-return 0;
+	return 0;
 }
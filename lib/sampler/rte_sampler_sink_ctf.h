@@ -10,7 +10,21 @@
  * RTE Sampler CTF Sink
  *
  * CTF (Common Trace Format) sink implementation for the sampler library.
- * Writes sampled statistics in CTF format compatible with trace viewers.
+ * Writes sampled statistics in CTF 1.8 format compatible with trace viewers
+ * such as babeltrace2 and Trace Compass.
+ *
+ * Each sample of a source is one event with fixed-size binary fields:
+ * the uint64_t values of its stats. The names of the sources and stats are
+ * only written in the metadata, as one event class per source and set of
+ * stats, declared when first sampled.
+ * Events are stamped with the sample TSC of the session.
+ *
+ * Events are gathered in packets, whose context holds the timestamps of
+ * their first and last events. By default a packet is written per sample.
+ * In buffered mode, set by rte_sampler_sink_ctf_create_buffered(),
+ * a packet holds as many samples as fit in packet_size
+ * bytes, and is written when full or flush_interval_us after its first
+ * event, so that the output costs a write per packet instead of per sample.
  */
 
 #include <stdint.h>
@@ -28,6 +42,14 @@ struct rte_sampler_sink_ctf_conf {
 	const char *trace_name;    /**< Trace name */
 };
 
+/**
+ * CTF sink buffering configuration
+ */
+struct rte_sampler_sink_ctf_buffer_conf {
+	uint32_t packet_size;      /**< Buffered packet size in bytes (0=packet per sample) */
+	uint32_t flush_interval_us; /**< Max buffering time of a packet (0=until full) */
+};
+
 /**
  * Create and register a CTF sink
  *
@@ -45,9 +67,36 @@ struct rte_sampler_session *session,
 const char *name,
 const struct rte_sampler_sink_ctf_conf *conf);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create and register a CTF sink writing buffered packets
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param name
+ *   Name for this sink instance
+ * @param conf
+ *   Pointer to CTF configuration
+ * @param buffer_conf
+ *   Pointer to buffering configuration. If NULL, same as
+ *   rte_sampler_sink_ctf_create().
+ * @return
+ *   Pointer to sink structure on success, NULL on error
+ */
+__rte_experimental
+struct rte_sampler_sink *rte_sampler_sink_ctf_create_buffered(
+struct rte_sampler_session *session,
+const char *name,
+const struct rte_sampler_sink_ctf_conf *conf,
+const struct rte_sampler_sink_ctf_buffer_conf *buffer_conf);
+
 /**
  * Destroy a CTF sink
  *
+ * The buffered packet is written and the trace files are closed.
+ *
  * @param sink
  *   Pointer to sink structure
  * @return
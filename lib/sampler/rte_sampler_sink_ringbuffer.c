@@ -2,15 +2,21 @@
  * Copyright(c) 2024 Intel Corporation
  */
 
+#include <stdio.h>
 #include <string.h>
 #include <rte_common.h>
 #include <rte_malloc.h>
 #include <rte_cycles.h>
+#include <rte_ring.h>
 #include <rte_spinlock.h>
+#include <rte_stdatomic.h>
 #include <rte_string_fns.h>
 #include <rte_sampler.h>
 #include "rte_sampler_sink_ringbuffer.h"
 
+/* Entries dequeued at once when clearing a lock-free ring buffer */
+#define RINGBUFFER_CLEAR_BURST 32
+
 /**
  * Internal ring buffer entry
  */
@@ -19,6 +25,7 @@ struct ringbuffer_entry {
 	char source_name[64];
 	uint16_t source_id;
 	uint16_t num_stats;
+	uint16_t capacity;       /* Allocated size of ids and values */
 	uint64_t *ids;
 	uint64_t *values;
 	uint8_t valid;
@@ -26,90 +33,140 @@ struct ringbuffer_entry {
 
 /**
  * Ring buffer sink data structure
+ *
+ * In the default mode, entries is a circular array protected by lock.
+ * In lock-free mode, each entry is owned by exactly one side at a time:
+ * the sampler takes entries from free_ring and passes filled entries to
+ * the reader through used_ring, which returns them to free_ring.
+ * Both the sampler, on a fill error, and the reader put entries back in
+ * free_ring, which is therefore multi-producer.
  */
 struct ringbuffer_sink_data {
 	struct ringbuffer_entry *entries;
 	uint32_t max_entries;
+	uint32_t flags;
 	uint32_t head;           /* Write position */
 	uint32_t tail;           /* Read position */
 	uint32_t count;          /* Current number of entries */
 	rte_spinlock_t lock;     /* Thread safety */
+	struct rte_ring *free_ring;  /* Lock-free mode: empty entries */
+	struct rte_ring *used_ring;  /* Lock-free mode: filled entries */
+	RTE_ATOMIC(uint64_t) dropped;  /* Lock-free mode: samples dropped */
 	struct rte_sampler_sink *sink;  /* Back pointer for API functions */
+	struct rte_sampler_session *session;  /* Session providing timestamps */
 };
 
-/* Global registry for finding sink data from sink pointer */
-#define MAX_RINGBUFFER_SINKS 16
-static struct {
-struct rte_sampler_sink *sink;
-struct ringbuffer_sink_data *data;
-} ringbuffer_registry[MAX_RINGBUFFER_SINKS];
-static rte_spinlock_t registry_lock = RTE_SPINLOCK_INITIALIZER;
+/**
+ * Find sink data from sink pointer
+ */
+static struct ringbuffer_sink_data *
+find_sink_data(struct rte_sampler_sink *sink)
+{
+	return rte_sampler_sink_get_user_data(sink);
+}
 
 /**
- * Register sink in global registry
+ * Copy a sample into an entry, growing the entry arrays if needed
  */
 static int
-		register_sink(struct rte_sampler_sink *sink, struct ringbuffer_sink_data *data)
+fill_entry(struct ringbuffer_entry *entry, uint64_t timestamp,
+	   const char *source_name, uint16_t source_id, const uint64_t *ids,
+	   const uint64_t *values, unsigned int n)
 {
-unsigned int i;
-
-rte_spinlock_lock(&registry_lock);
-for (i = 0; i < MAX_RINGBUFFER_SINKS; i++) {
-if (ringbuffer_registry[i].sink == NULL) {
-ringbuffer_registry[i].sink = sink;
-ringbuffer_registry[i].data = data;
-rte_spinlock_unlock(&registry_lock);
-return 0;
-}
-}
-rte_spinlock_unlock(&registry_lock);
-return -ENOSPC;
+	if (n > UINT16_MAX)
+		return -E2BIG;
+
+	if (n > 0 && (entry->ids == NULL || n > entry->capacity)) {
+		uint64_t *new_ids, *new_values;
+
+		new_ids = rte_malloc(NULL, sizeof(uint64_t) * n, 0);
+		new_values = rte_malloc(NULL, sizeof(uint64_t) * n, 0);
+		if (new_ids == NULL || new_values == NULL) {
+			rte_free(new_ids);
+			rte_free(new_values);
+			return -ENOMEM;
+		}
+
+		rte_free(entry->ids);
+		rte_free(entry->values);
+		entry->ids = new_ids;
+		entry->values = new_values;
+		entry->capacity = n;
+	}
+
+	entry->timestamp = timestamp;
+	rte_strscpy(entry->source_name, source_name, sizeof(entry->source_name));
+	entry->source_id = source_id;
+	entry->num_stats = n;
+	memcpy(entry->ids, ids, sizeof(uint64_t) * n);
+	memcpy(entry->values, values, sizeof(uint64_t) * n);
+	entry->valid = 1;
+
+	return 0;
 }
 
 /**
- * Unregister sink from global registry
+ * Copy an entry to a caller entry, allocating the caller arrays
  */
 static void
-		unregister_sink(struct rte_sampler_sink *sink)
+copy_entry(struct rte_sampler_ringbuffer_entry *dst,
+	   const struct ringbuffer_entry *src)
 {
-unsigned int i;
-
-rte_spinlock_lock(&registry_lock);
-for (i = 0; i < MAX_RINGBUFFER_SINKS; i++) {
-if (ringbuffer_registry[i].sink == sink) {
-ringbuffer_registry[i].sink = NULL;
-ringbuffer_registry[i].data = NULL;
-break;
-}
-}
-rte_spinlock_unlock(&registry_lock);
+	dst->timestamp = src->timestamp;
+	rte_strscpy(dst->source_name, src->source_name, sizeof(dst->source_name));
+	dst->source_id = src->source_id;
+	dst->num_stats = src->num_stats;
+
+	/* Caller needs to free arrays */
+	dst->ids = rte_malloc(NULL, sizeof(uint64_t) * src->num_stats, 0);
+	dst->values = rte_malloc(NULL, sizeof(uint64_t) * src->num_stats, 0);
+
+	if (dst->ids != NULL && dst->values != NULL) {
+		memcpy(dst->ids, src->ids, sizeof(uint64_t) * src->num_stats);
+		memcpy(dst->values, src->values, sizeof(uint64_t) * src->num_stats);
+	}
 }
 
 /**
- * Find sink data from sink pointer
+ * Lock-free ring buffer output, runs on the sampler (single producer)
  */
-static struct ringbuffer_sink_data *
-		find_sink_data(struct rte_sampler_sink *sink)
+static int
+ringbuffer_sink_output_lockfree(struct ringbuffer_sink_data *data,
+		const char *source_name,
+		uint16_t source_id,
+		const uint64_t *ids,
+		const uint64_t *values,
+		unsigned int n)
 {
-struct ringbuffer_sink_data *data = NULL;
-unsigned int i;
-
-rte_spinlock_lock(&registry_lock);
-for (i = 0; i < MAX_RINGBUFFER_SINKS; i++) {
-if (ringbuffer_registry[i].sink == sink) {
-data = ringbuffer_registry[i].data;
-break;
-}
-}
-rte_spinlock_unlock(&registry_lock);
-return data;
+	struct ringbuffer_entry *entry;
+	int ret;
+
+	if (rte_ring_sc_dequeue(data->free_ring, (void **)&entry) != 0) {
+		/* Reader is behind, never wait for it */
+		rte_atomic_fetch_add_explicit(&data->dropped, 1,
+			rte_memory_order_relaxed);
+		return -ENOBUFS;
+	}
+
+	ret = fill_entry(entry, rte_sampler_session_get_sample_tsc(data->session),
+			 source_name, source_id, ids, values, n);
+	if (ret < 0) {
+		entry->valid = 0;
+		rte_ring_mp_enqueue(data->free_ring, entry);
+		return ret;
+	}
+
+	/* Cannot fail, the rings are sized for all entries */
+	rte_ring_sp_enqueue(data->used_ring, entry);
+
+	return 0;
 }
 
 /**
  * Ring buffer sink output callback
  */
 static int
-		ringbuffer_sink_output(const char *source_name,
+ringbuffer_sink_output(const char *source_name,
 		uint16_t source_id,
 		const struct rte_sampler_xstats_name *xstats_names,
 		const uint64_t *ids,
@@ -117,239 +174,311 @@ static int
 		unsigned int n,
 		void *user_data)
 {
-struct ringbuffer_sink_data *data = user_data;
-struct ringbuffer_entry *entry;
-uint32_t pos;
+	struct ringbuffer_sink_data *data = user_data;
+	struct ringbuffer_entry *entry;
+	int ret;
 
-(void)xstats_names;  /* Not stored in ring buffer */
+	RTE_SET_USED(xstats_names);  /* Not stored in ring buffer */
 
-if (data == NULL)
-return -EINVAL;
+	if (data == NULL)
+		return -EINVAL;
 
-rte_spinlock_lock(&data->lock);
+	if (data->flags & RTE_SAMPLER_SINK_RINGBUFFER_F_LOCKFREE)
+		return ringbuffer_sink_output_lockfree(data, source_name,
+			source_id, ids, values, n);
 
-/* Get write position */
-pos = data->head;
-entry = &data->entries[pos];
+	rte_spinlock_lock(&data->lock);
 
-/* Free old entry if overwriting */
-if (entry->valid) {
-rte_free(entry->ids);
-rte_free(entry->values);
-}
+	/* Get write position, arrays of an overwritten entry are reused */
+	entry = &data->entries[data->head];
 
-/* Allocate and copy data */
-		entry->ids = rte_malloc(NULL, sizeof(uint64_t) * n, 0);
-		entry->values = rte_malloc(NULL, sizeof(uint64_t) * n, 0);
+	ret = fill_entry(entry, rte_sampler_session_get_sample_tsc(data->session),
+			 source_name, source_id, ids, values, n);
+	if (ret < 0) {
+		rte_spinlock_unlock(&data->lock);
+		return ret;
+	}
 
-if (entry->ids == NULL || entry->values == NULL) {
-rte_free(entry->ids);
-rte_free(entry->values);
-rte_spinlock_unlock(&data->lock);
-return -ENOMEM;
-}
+	/* Advance head */
+	data->head = (data->head + 1) % data->max_entries;
 
-/* Fill entry */
-entry->timestamp = rte_get_timer_cycles();
-rte_strscpy(entry->source_name, source_name, sizeof(entry->source_name));
-entry->source_id = source_id;
-entry->num_stats = n;
-		memcpy(entry->ids, ids, sizeof(uint64_t) * n);
-		memcpy(entry->values, values, sizeof(uint64_t) * n);
-entry->valid = 1;
-
-/* Advance head */
-data->head = (data->head + 1) % data->max_entries;
-
-/* Update count */
-if (data->count < data->max_entries) {
-data->count++;
-} else {
-/* Buffer full, advance tail (overwrite oldest) */
-data->tail = (data->tail + 1) % data->max_entries;
-}
+	/* Update count */
+	if (data->count < data->max_entries) {
+		data->count++;
+	} else {
+		/* Buffer full, advance tail (overwrite oldest) */
+		data->tail = (data->tail + 1) % data->max_entries;
+	}
 
-rte_spinlock_unlock(&data->lock);
+	rte_spinlock_unlock(&data->lock);
 
-return 0;
+	return 0;
 }
 
-struct rte_sampler_sink *
-		rte_sampler_sink_ringbuffer_create(struct rte_sampler_session *session,
-		const char *name,
-		const struct rte_sampler_sink_ringbuffer_conf *conf)
+/**
+ * Free ring buffer data and all entry arrays
+ */
+static void
+ringbuffer_data_free(struct ringbuffer_sink_data *data)
 {
-struct rte_sampler_sink_ops ops;
-struct ringbuffer_sink_data *data;
-struct rte_sampler_sink *sink;
-
-if (session == NULL || name == NULL || conf == NULL ||
-    conf->max_entries == 0)
-return NULL;
-
-/* Allocate sink data */
-data = rte_zmalloc(NULL, sizeof(*data), 0);
-if (data == NULL)
-return NULL;
-
-/* Allocate ring buffer entries */
-data->entries = rte_zmalloc(NULL,
-    sizeof(struct ringbuffer_entry) * conf->max_entries,
-    0);
-if (data->entries == NULL) {
-rte_free(data);
-return NULL;
-}
+	uint32_t i;
+
+	for (i = 0; i < data->max_entries; i++) {
+		rte_free(data->entries[i].ids);
+		rte_free(data->entries[i].values);
+	}
 
-data->max_entries = conf->max_entries;
-data->head = 0;
-data->tail = 0;
-data->count = 0;
-rte_spinlock_init(&data->lock);
-
-/* Setup sink operations */
-ops.output = ringbuffer_sink_output;
-ops.flags = RTE_SAMPLER_SINK_F_NO_NAMES;  /* Don't need names in ring buffer */
-
-/* Register sink */
-sink = rte_sampler_session_register_sink(session, name, &ops, data);
-if (sink == NULL) {
-rte_free(data->entries);
-rte_free(data);
-return NULL;
+	rte_ring_free(data->free_ring);
+	rte_ring_free(data->used_ring);
+	rte_free(data->entries);
+	rte_free(data);
 }
 
-data->sink = sink;
+/**
+ * Create the rings used by the lock-free mode
+ */
+static int
+ringbuffer_lockfree_init(struct ringbuffer_sink_data *data)
+{
+	const unsigned int ring_flags = RING_F_SP_ENQ | RING_F_SC_DEQ | RING_F_EXACT_SZ;
+	const unsigned int free_ring_flags = RING_F_SC_DEQ | RING_F_EXACT_SZ;
+	char ring_name[RTE_RING_NAMESIZE];
+	uint32_t i;
+
+	snprintf(ring_name, sizeof(ring_name), "smpl_rbf_%p", data);
+	data->free_ring = rte_ring_create(ring_name, data->max_entries,
+		SOCKET_ID_ANY, free_ring_flags);
+	if (data->free_ring == NULL)
+		return -ENOMEM;
+
+	snprintf(ring_name, sizeof(ring_name), "smpl_rbu_%p", data);
+	data->used_ring = rte_ring_create(ring_name, data->max_entries,
+		SOCKET_ID_ANY, ring_flags);
+	if (data->used_ring == NULL)
+		return -ENOMEM;
+
+	for (i = 0; i < data->max_entries; i++)
+		rte_ring_mp_enqueue(data->free_ring, &data->entries[i]);
+
+	return 0;
+}
 
-/* Register in global registry */
-if (register_sink(sink, data) < 0) {
-rte_sampler_sink_free(sink);
-rte_free(data->entries);
-rte_free(data);
-return NULL;
+struct rte_sampler_sink *
+rte_sampler_sink_ringbuffer_create(struct rte_sampler_session *session,
+		const char *name,
+		const struct rte_sampler_sink_ringbuffer_conf *conf)
+{
+	return rte_sampler_sink_ringbuffer_create_flags(session, name, conf, 0);
 }
 
-return sink;
+struct rte_sampler_sink *
+rte_sampler_sink_ringbuffer_create_flags(struct rte_sampler_session *session,
+		const char *name,
+		const struct rte_sampler_sink_ringbuffer_conf *conf,
+		uint32_t flags)
+{
+	struct rte_sampler_sink_ops ops;
+	struct ringbuffer_sink_data *data;
+	struct rte_sampler_sink *sink;
+
+	if (session == NULL || name == NULL || conf == NULL ||
+	    conf->max_entries == 0)
+		return NULL;
+
+	/* Allocate sink data */
+	data = rte_zmalloc(NULL, sizeof(*data), 0);
+	if (data == NULL)
+		return NULL;
+
+	/* Allocate ring buffer entries */
+	data->entries = rte_zmalloc(NULL,
+		sizeof(struct ringbuffer_entry) * conf->max_entries, 0);
+	if (data->entries == NULL) {
+		rte_free(data);
+		return NULL;
+	}
+
+	data->max_entries = conf->max_entries;
+	data->flags = flags;
+	data->session = session;
+	data->head = 0;
+	data->tail = 0;
+	data->count = 0;
+	rte_spinlock_init(&data->lock);
+
+	if ((data->flags & RTE_SAMPLER_SINK_RINGBUFFER_F_LOCKFREE) &&
+	    ringbuffer_lockfree_init(data) < 0) {
+		ringbuffer_data_free(data);
+		return NULL;
+	}
+
+	/* Setup sink operations */
+	memset(&ops, 0, sizeof(ops));
+	ops.output = ringbuffer_sink_output;
+	ops.flags = RTE_SAMPLER_SINK_F_NO_NAMES;  /* Don't need names in ring buffer */
+
+	/* Register sink, the data is found back through the sink user data */
+	sink = rte_sampler_session_register_sink(session, name, &ops, data);
+	if (sink == NULL) {
+		ringbuffer_data_free(data);
+		return NULL;
+	}
+
+	data->sink = sink;
+
+	return sink;
 }
 
 int
-		rte_sampler_sink_ringbuffer_count(struct rte_sampler_sink *sink)
+rte_sampler_sink_ringbuffer_count(struct rte_sampler_sink *sink)
 {
-struct ringbuffer_sink_data *data;
-int count;
+	struct ringbuffer_sink_data *data;
+	int count;
+
+	data = find_sink_data(sink);
+	if (data == NULL)
+		return -EINVAL;
+
+	if (data->flags & RTE_SAMPLER_SINK_RINGBUFFER_F_LOCKFREE)
+		return rte_ring_count(data->used_ring);
 
-data = find_sink_data(sink);
-if (data == NULL)
-return -EINVAL;
+	rte_spinlock_lock(&data->lock);
+	count = data->count;
+	rte_spinlock_unlock(&data->lock);
 
-rte_spinlock_lock(&data->lock);
-count = data->count;
-rte_spinlock_unlock(&data->lock);
+	return count;
+}
 
-return count;
+/**
+ * Lock-free read, runs on the reader (single consumer)
+ */
+static int
+ringbuffer_read_lockfree(struct ringbuffer_sink_data *data,
+		struct rte_sampler_ringbuffer_entry *entries,
+		uint32_t max_entries)
+{
+	struct ringbuffer_entry *src[RINGBUFFER_CLEAR_BURST];
+	uint32_t num_read = 0;
+	unsigned int i, n;
+
+	while (num_read < max_entries) {
+		n = rte_ring_sc_dequeue_burst(data->used_ring, (void **)src,
+			RTE_MIN(max_entries - num_read, (uint32_t)RINGBUFFER_CLEAR_BURST),
+			NULL);
+		if (n == 0)
+			break;
+
+		for (i = 0; i < n; i++) {
+			copy_entry(&entries[num_read++], src[i]);
+			src[i]->valid = 0;
+		}
+
+		rte_ring_mp_enqueue_bulk(data->free_ring, (void **)src, n, NULL);
+	}
+
+	return num_read;
 }
 
 int
-		rte_sampler_sink_ringbuffer_read(struct rte_sampler_sink *sink,
+rte_sampler_sink_ringbuffer_read(struct rte_sampler_sink *sink,
 		struct rte_sampler_ringbuffer_entry *entries,
 		uint32_t max_entries)
 {
-struct ringbuffer_sink_data *data;
-uint32_t i, pos, num_read;
+	struct ringbuffer_sink_data *data;
+	uint32_t i, pos, num_read;
 
-data = find_sink_data(sink);
-if (data == NULL || entries == NULL)
-return -EINVAL;
+	data = find_sink_data(sink);
+	if (data == NULL || entries == NULL)
+		return -EINVAL;
 
-rte_spinlock_lock(&data->lock);
+	if (data->flags & RTE_SAMPLER_SINK_RINGBUFFER_F_LOCKFREE)
+		return ringbuffer_read_lockfree(data, entries, max_entries);
 
-num_read = (max_entries < data->count) ? max_entries : data->count;
+	rte_spinlock_lock(&data->lock);
 
-for (i = 0; i < num_read; i++) {
-pos = (data->tail + i) % data->max_entries;
-struct ringbuffer_entry *src = &data->entries[pos];
+	num_read = (max_entries < data->count) ? max_entries : data->count;
 
-if (!src->valid)
-continue;
+	for (i = 0; i < num_read; i++) {
+		struct ringbuffer_entry *src;
 
-entries[i].timestamp = src->timestamp;
-rte_strscpy(entries[i].source_name, src->source_name,
-   sizeof(entries[i].source_name));
-entries[i].source_id = src->source_id;
-entries[i].num_stats = src->num_stats;
+		pos = (data->tail + i) % data->max_entries;
+		src = &data->entries[pos];
 
-/* Caller needs to allocate arrays */
-		entries[i].ids = rte_malloc(NULL, sizeof(uint64_t) * src->num_stats, 0);
-		entries[i].values = rte_malloc(NULL, sizeof(uint64_t) * src->num_stats, 0);
+		if (!src->valid)
+			continue;
 
-if (entries[i].ids && entries[i].values) {
-memcpy(entries[i].ids, src->ids,
-		sizeof(uint64_t) * src->num_stats);
-memcpy(entries[i].values, src->values,
-		sizeof(uint64_t) * src->num_stats);
-}
-}
+		copy_entry(&entries[i], src);
+	}
 
-rte_spinlock_unlock(&data->lock);
+	rte_spinlock_unlock(&data->lock);
 
-return num_read;
+	return num_read;
 }
 
 int
-		rte_sampler_sink_ringbuffer_clear(struct rte_sampler_sink *sink)
+rte_sampler_sink_ringbuffer_clear(struct rte_sampler_sink *sink)
 {
-struct ringbuffer_sink_data *data;
-uint32_t i;
+	struct ringbuffer_sink_data *data;
+	uint32_t i;
 
-data = find_sink_data(sink);
-if (data == NULL)
-return -EINVAL;
+	data = find_sink_data(sink);
+	if (data == NULL)
+		return -EINVAL;
 
-rte_spinlock_lock(&data->lock);
+	if (data->flags & RTE_SAMPLER_SINK_RINGBUFFER_F_LOCKFREE) {
+		struct ringbuffer_entry *burst[RINGBUFFER_CLEAR_BURST];
+		unsigned int n;
 
-/* Free all allocated data */
-for (i = 0; i < data->max_entries; i++) {
-if (data->entries[i].valid) {
-rte_free(data->entries[i].ids);
-rte_free(data->entries[i].values);
-data->entries[i].valid = 0;
-}
-}
+		/* Hand all filled entries back to the producer */
+		while ((n = rte_ring_sc_dequeue_burst(data->used_ring,
+				(void **)burst, RINGBUFFER_CLEAR_BURST, NULL)) > 0) {
+			for (i = 0; i < n; i++)
+				burst[i]->valid = 0;
+			rte_ring_mp_enqueue_bulk(data->free_ring, (void **)burst,
+				n, NULL);
+		}
+		return 0;
+	}
+
+	rte_spinlock_lock(&data->lock);
 
-data->head = 0;
-data->tail = 0;
-data->count = 0;
+	/* Entry arrays are kept for reuse */
+	for (i = 0; i < data->max_entries; i++)
+		data->entries[i].valid = 0;
 
-rte_spinlock_unlock(&data->lock);
+	data->head = 0;
+	data->tail = 0;
+	data->count = 0;
 
-return 0;
+	rte_spinlock_unlock(&data->lock);
+
+	return 0;
 }
 
-int
-		rte_sampler_sink_ringbuffer_destroy(struct rte_sampler_sink *sink)
+int64_t
+rte_sampler_sink_ringbuffer_dropped(struct rte_sampler_sink *sink)
 {
-struct ringbuffer_sink_data *data;
-uint32_t i;
+	struct ringbuffer_sink_data *data;
 
-data = find_sink_data(sink);
-if (data == NULL)
-return -EINVAL;
+	data = find_sink_data(sink);
+	if (data == NULL)
+		return -EINVAL;
 
-/* Unregister from global registry */
-unregister_sink(sink);
-
-/* Clear and free all entries */
-for (i = 0; i < data->max_entries; i++) {
-if (data->entries[i].valid) {
-rte_free(data->entries[i].ids);
-rte_free(data->entries[i].values);
-}
+	return rte_atomic_load_explicit(&data->dropped, rte_memory_order_relaxed);
 }
 
-rte_free(data->entries);
-rte_free(data);
+int
+rte_sampler_sink_ringbuffer_destroy(struct rte_sampler_sink *sink)
+{
+	struct ringbuffer_sink_data *data;
+
+	data = find_sink_data(sink);
+	if (data == NULL)
+		return -EINVAL;
+
+	rte_sampler_sink_free(sink);
 
-rte_sampler_sink_free(sink);
+	ringbuffer_data_free(data);
 
-return 0;
+	return 0;
 }
@@ -24,7 +24,7 @@ extern "C" {
  * Ring buffer sample entry
  */
 struct rte_sampler_ringbuffer_entry {
-	uint64_t timestamp;                  /**< Sample timestamp (cycles) */
+	uint64_t timestamp;                  /**< Sample timestamp (TSC) */
 	char source_name[64];                /**< Source name */
 	uint16_t source_id;                  /**< Source ID */
 	uint16_t num_stats;                  /**< Number of stats in this entry */
@@ -32,6 +32,17 @@ struct rte_sampler_ringbuffer_entry {
 	uint64_t *values;                    /**< Stat values */
 };
 
+/**
+ * Ring buffer sink flags
+ */
+#define RTE_SAMPLER_SINK_RINGBUFFER_F_LOCKFREE 0x0001
+/**< Lock-free single producer/single consumer mode.
+ * Entries are passed between the sampler and one reader thread through
+ * rte_ring, so neither side ever waits for the other. When the buffer is
+ * full, new samples are dropped instead of overwriting the oldest entry,
+ * and rte_sampler_sink_ringbuffer_read() consumes the entries it returns.
+ */
+
 /**
  * Ring buffer sink configuration
  */
@@ -56,6 +67,30 @@ struct rte_sampler_session *session,
 const char *name,
 const struct rte_sampler_sink_ringbuffer_conf *conf);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create and register a ring buffer sink with flags
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param name
+ *   Name for this sink instance
+ * @param conf
+ *   Pointer to ring buffer configuration
+ * @param flags
+ *   RTE_SAMPLER_SINK_RINGBUFFER_F_* flags
+ * @return
+ *   Pointer to sink structure on success, NULL on error
+ */
+__rte_experimental
+struct rte_sampler_sink *rte_sampler_sink_ringbuffer_create_flags(
+struct rte_sampler_session *session,
+const char *name,
+const struct rte_sampler_sink_ringbuffer_conf *conf,
+uint32_t flags);
+
 /**
  * Get number of entries currently in ring buffer
  *
@@ -69,6 +104,9 @@ int rte_sampler_sink_ringbuffer_count(struct rte_sampler_sink *sink);
 /**
  * Read entries from ring buffer
  *
+ * The ids and values arrays of each returned entry are allocated with
+ * rte_malloc() and must be freed by the caller.
+ *
  * @param sink
  *   Pointer to sink structure
  * @param entries
@@ -92,6 +130,23 @@ int rte_sampler_sink_ringbuffer_read(struct rte_sampler_sink *sink,
  */
 int rte_sampler_sink_ringbuffer_clear(struct rte_sampler_sink *sink);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get number of samples dropped because the ring buffer was full
+ *
+ * Only lock-free mode drops samples, the default mode overwrites
+ * the oldest entry.
+ *
+ * @param sink
+ *   Pointer to sink structure
+ * @return
+ *   Number of dropped samples, or negative on error
+ */
+__rte_experimental
+int64_t rte_sampler_sink_ringbuffer_dropped(struct rte_sampler_sink *sink);
+
 /**
  * Destroy a ring buffer sink
  *
@@ -0,0 +1,248 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_malloc.h>
+#include <rte_memzone.h>
+#include <rte_string_fns.h>
+#include <rte_sampler.h>
+#include "rte_sampler_sink_shm.h"
+
+/**
+ * Shared memory sink user data structure
+ */
+struct shm_sink_data {
+	const struct rte_memzone *mz;
+	struct rte_sampler_shm_header *hdr;
+	struct rte_sampler_session *session;
+};
+
+static inline struct rte_sampler_shm_slot *
+shm_slot(const struct rte_sampler_shm_header *hdr, uint64_t seq)
+{
+	return (struct rte_sampler_shm_slot *)((uintptr_t)hdr + hdr->slots_offset +
+		(seq % hdr->num_slots) * hdr->slot_size);
+}
+
+static int
+shm_mz_name(char *mz_name, const char *name)
+{
+	if (snprintf(mz_name, RTE_MEMZONE_NAMESIZE, RTE_SAMPLER_SHM_MZ_PREFIX "%s",
+		     name) >= RTE_MEMZONE_NAMESIZE)
+		return -ENAMETOOLONG;
+
+	return 0;
+}
+
+/**
+ * Shared memory sink output callback
+ */
+static int
+shm_sink_output(const char *source_name,
+		uint16_t source_id,
+		const struct rte_sampler_xstats_name *xstats_names,
+		const uint64_t *ids,
+		const uint64_t *values,
+		unsigned int n,
+		void *user_data)
+{
+	struct shm_sink_data *data = user_data;
+	struct rte_sampler_shm_header *hdr;
+	struct rte_sampler_shm_slot *slot;
+	uint64_t seq;
+
+	RTE_SET_USED(xstats_names);
+
+	if (data == NULL)
+		return -EINVAL;
+
+	hdr = data->hdr;
+	n = RTE_MIN(n, hdr->max_stats);
+
+	seq = rte_atomic_load_explicit(&hdr->head, rte_memory_order_relaxed);
+	slot = shm_slot(hdr, seq);
+
+	rte_seqlock_write_lock(&slot->lock);
+	slot->seq = seq;
+	slot->tsc = rte_sampler_session_get_sample_tsc(data->session);
+	rte_strscpy(slot->source_name, source_name, sizeof(slot->source_name));
+	slot->source_id = source_id;
+	slot->num_stats = n;
+	memcpy(&slot->data[0], ids, sizeof(uint64_t) * n);
+	memcpy(&slot->data[hdr->max_stats], values, sizeof(uint64_t) * n);
+	rte_seqlock_write_unlock(&slot->lock);
+
+	rte_atomic_store_explicit(&hdr->head, seq + 1, rte_memory_order_release);
+
+	return 0;
+}
+
+struct rte_sampler_sink *
+rte_sampler_sink_shm_create(struct rte_sampler_session *session,
+		const char *name,
+		const struct rte_sampler_sink_shm_conf *conf)
+{
+	struct rte_sampler_sink_ops ops;
+	struct rte_sampler_shm_header *hdr;
+	struct shm_sink_data *data;
+	struct rte_sampler_sink *sink;
+	char mz_name[RTE_MEMZONE_NAMESIZE];
+	uint64_t slot_size, slots_offset;
+	uint32_t i;
+
+	if (session == NULL || name == NULL || conf == NULL ||
+	    conf->num_slots == 0 || conf->max_stats == 0 ||
+	    conf->max_stats > UINT16_MAX || shm_mz_name(mz_name, name) < 0)
+		return NULL;
+
+	/* Allocate sink data */
+	data = rte_zmalloc(NULL, sizeof(*data), 0);
+	if (data == NULL)
+		return NULL;
+
+	slot_size = RTE_ALIGN_CEIL(sizeof(struct rte_sampler_shm_slot) +
+		2 * sizeof(uint64_t) * conf->max_stats, RTE_CACHE_LINE_SIZE);
+	slots_offset = RTE_ALIGN_CEIL(sizeof(struct rte_sampler_shm_header),
+		RTE_CACHE_LINE_SIZE);
+
+	data->mz = rte_memzone_reserve_aligned(mz_name,
+		slots_offset + slot_size * conf->num_slots, conf->socket_id, 0,
+		RTE_CACHE_LINE_SIZE);
+	if (data->mz == NULL) {
+		rte_free(data);
+		return NULL;
+	}
+
+	hdr = data->mz->addr;
+	memset(hdr, 0, data->mz->len);
+	hdr->version = RTE_SAMPLER_SHM_VERSION;
+	hdr->num_slots = conf->num_slots;
+	hdr->max_stats = conf->max_stats;
+	hdr->slot_size = slot_size;
+	hdr->slots_offset = slots_offset;
+	hdr->tsc_hz = rte_get_tsc_hz();
+	for (i = 0; i < conf->num_slots; i++)
+		rte_seqlock_init(&shm_slot(hdr, i)->lock);
+
+	/* Readers check the magic last */
+	rte_atomic_thread_fence(rte_memory_order_release);
+	hdr->magic = RTE_SAMPLER_SHM_MAGIC;
+
+	data->hdr = hdr;
+	data->session = session;
+
+	/* Setup sink operations, names are not stored */
+	memset(&ops, 0, sizeof(ops));
+	ops.output = shm_sink_output;
+	ops.flags = RTE_SAMPLER_SINK_F_NO_NAMES;
+
+	/* Register sink */
+	sink = rte_sampler_session_register_sink(session, name, &ops, data);
+	if (sink == NULL) {
+		rte_memzone_free(data->mz);
+		rte_free(data);
+		return NULL;
+	}
+
+	return sink;
+}
+
+int
+rte_sampler_sink_shm_destroy(struct rte_sampler_sink *sink)
+{
+	struct shm_sink_data *data;
+
+	data = rte_sampler_sink_get_user_data(sink);
+	if (data == NULL)
+		return -EINVAL;
+
+	rte_sampler_sink_free(sink);
+
+	data->hdr->magic = 0;
+	rte_memzone_free(data->mz);
+	rte_free(data);
+
+	return 0;
+}
+
+const struct rte_sampler_shm_header *
+rte_sampler_shm_lookup(const char *name)
+{
+	const struct rte_sampler_shm_header *hdr;
+	const struct rte_memzone *mz;
+	char mz_name[RTE_MEMZONE_NAMESIZE];
+
+	if (name == NULL || shm_mz_name(mz_name, name) < 0)
+		return NULL;
+
+	mz = rte_memzone_lookup(mz_name);
+	if (mz == NULL || mz->len < sizeof(*hdr))
+		return NULL;
+
+	hdr = mz->addr;
+	if (hdr->magic != RTE_SAMPLER_SHM_MAGIC ||
+	    hdr->version != RTE_SAMPLER_SHM_VERSION)
+		return NULL;
+
+	return hdr;
+}
+
+uint64_t
+rte_sampler_shm_head(const struct rte_sampler_shm_header *shm)
+{
+	if (shm == NULL)
+		return 0;
+
+	return rte_atomic_load_explicit(&shm->head, rte_memory_order_acquire);
+}
+
+int
+rte_sampler_shm_read(const struct rte_sampler_shm_header *shm, uint64_t seq,
+		     struct rte_sampler_shm_sample *sample,
+		     uint64_t *ids, uint64_t *values, unsigned int size)
+{
+	const struct rte_sampler_shm_slot *slot;
+	uint64_t head;
+	unsigned int n;
+	uint32_t sn;
+
+	if (shm == NULL || sample == NULL || (values == NULL && size > 0))
+		return -EINVAL;
+
+	head = rte_atomic_load_explicit(&shm->head, rte_memory_order_acquire);
+	if (seq >= head)
+		return -EAGAIN;
+	if (head - seq > shm->num_slots)
+		return -ENOENT;
+
+	slot = shm_slot(shm, seq);
+	do {
+		sn = rte_seqlock_read_begin(&slot->lock);
+		sample->seq = slot->seq;
+		sample->tsc = slot->tsc;
+		memcpy(sample->source_name, slot->source_name,
+		       sizeof(sample->source_name));
+		sample->source_id = slot->source_id;
+		sample->num_stats = slot->num_stats;
+		n = RTE_MIN(size, shm->max_stats);
+		n = RTE_MIN(sample->num_stats, n);
+		if (ids != NULL)
+			memcpy(ids, &slot->data[0], sizeof(uint64_t) * n);
+		if (values != NULL)
+			memcpy(values, &slot->data[shm->max_stats],
+			       sizeof(uint64_t) * n);
+	} while (rte_seqlock_read_retry(&slot->lock, sn));
+
+	/* Overwritten while the head was read */
+	if (sample->seq != seq)
+		return -ENOENT;
+
+	sample->source_name[sizeof(sample->source_name) - 1] = '\0';
+
+	return sample->num_stats;
+}
@@ -0,0 +1,199 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#ifndef _RTE_SAMPLER_SINK_SHM_H_
+#define _RTE_SAMPLER_SINK_SHM_H_
+
+/**
+ * @file
+ * RTE Sampler Shared Memory Sink
+ *
+ * Shared memory sink implementation for the sampler library.
+ * Samples are written into a ring of fixed-size slots in a memzone, each
+ * slot protected by a sequence lock. Secondary processes look the memzone
+ * up by name and read live samples directly, without IPC with the primary
+ * process and without reading device registers.
+ *
+ * The writer never waits for readers: a reader which is too slow sees that
+ * the slot it wants has been overwritten and skips ahead.
+ *
+ * Slots hold stat IDs and values. Stat names are not stored, a reader gets
+ * them once from the IDs, e.g. with rte_eth_xstats_get_names_by_id().
+ */
+
+#include <stdint.h>
+#include <rte_common.h>
+#include <rte_seqlock.h>
+#include <rte_stdatomic.h>
+#include <rte_sampler.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Magic value at the start of the memzone */
+#define RTE_SAMPLER_SHM_MAGIC 0x4d48534c504d5344ULL /* "DSMPLSHM" */
+
+/** Shared memory layout version */
+#define RTE_SAMPLER_SHM_VERSION 1
+
+/** Prefix of the memzone name, followed by the sink name */
+#define RTE_SAMPLER_SHM_MZ_PREFIX "smplr_"
+
+/**
+ * Shared memory header, at the start of the memzone
+ */
+struct __rte_cache_aligned rte_sampler_shm_header {
+	uint64_t magic;              /**< RTE_SAMPLER_SHM_MAGIC */
+	uint32_t version;            /**< RTE_SAMPLER_SHM_VERSION */
+	uint32_t num_slots;          /**< Number of slots in the ring */
+	uint32_t max_stats;          /**< Maximum number of stats per slot */
+	uint32_t reserved;           /**< Reserved, zero */
+	uint64_t slot_size;          /**< Size of a slot in bytes */
+	uint64_t slots_offset;       /**< Offset of the first slot */
+	uint64_t tsc_hz;             /**< TSC frequency of the sample timestamps */
+	RTE_ATOMIC(uint64_t) head;   /**< Number of samples written */
+};
+
+/**
+ * Shared memory slot
+ *
+ * The slot is followed by max_stats IDs, then max_stats values.
+ */
+struct __rte_cache_aligned rte_sampler_shm_slot {
+	rte_seqlock_t lock;          /**< Protects the slot */
+	uint64_t seq;                /**< Sequence number of the sample */
+	uint64_t tsc;                /**< Sample timestamp (TSC) */
+	char source_name[64];        /**< Source name */
+	uint16_t source_id;          /**< Source ID */
+	uint16_t num_stats;          /**< Number of stats in the slot */
+	uint64_t data[];             /**< IDs then values */
+};
+
+/**
+ * Sample read from shared memory
+ */
+struct rte_sampler_shm_sample {
+	uint64_t seq;                /**< Sequence number of the sample */
+	uint64_t tsc;                /**< Sample timestamp (TSC) */
+	char source_name[64];        /**< Source name */
+	uint16_t source_id;          /**< Source ID */
+	uint16_t num_stats;          /**< Number of stats of the sample */
+};
+
+/**
+ * Shared memory sink configuration
+ */
+struct rte_sampler_sink_shm_conf {
+	uint32_t num_slots;          /**< Number of slots in the ring */
+	uint32_t max_stats;          /**< Maximum number of stats per sample,
+				      *   further stats are not written
+				      */
+	int socket_id;               /**< Memzone socket (SOCKET_ID_ANY allowed) */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create and register a shared memory sink
+ *
+ * Reserves memzone RTE_SAMPLER_SHM_MZ_PREFIX followed by the sink name,
+ * which must fit in RTE_MEMZONE_NAMESIZE.
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param name
+ *   Name for this sink instance
+ * @param conf
+ *   Pointer to shared memory sink configuration
+ * @return
+ *   Pointer to sink structure on success, NULL on error
+ */
+__rte_experimental
+struct rte_sampler_sink *rte_sampler_sink_shm_create(
+		struct rte_sampler_session *session,
+		const char *name,
+		const struct rte_sampler_sink_shm_conf *conf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Destroy a shared memory sink and free its memzone
+ *
+ * Readers must have stopped using the memzone.
+ *
+ * @param sink
+ *   Pointer to sink structure
+ * @return
+ *   Zero on success, negative on error
+ */
+__rte_experimental
+int rte_sampler_sink_shm_destroy(struct rte_sampler_sink *sink);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Look up the shared memory of a sink, from any process
+ *
+ * @param name
+ *   Sink name given to rte_sampler_sink_shm_create()
+ * @return
+ *   Pointer to the shared memory header, NULL if not found or invalid
+ */
+__rte_experimental
+const struct rte_sampler_shm_header *rte_sampler_shm_lookup(const char *name);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the sequence number of the next sample to be written
+ *
+ * The samples which can still be read are in
+ * [head - num_slots, head - 1].
+ *
+ * @param shm
+ *   Pointer returned by rte_sampler_shm_lookup()
+ * @return
+ *   Number of samples written so far
+ */
+__rte_experimental
+uint64_t rte_sampler_shm_head(const struct rte_sampler_shm_header *shm);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Read a sample from shared memory
+ *
+ * @param shm
+ *   Pointer returned by rte_sampler_shm_lookup()
+ * @param seq
+ *   Sequence number of the sample to read
+ * @param sample
+ *   Filled with the sample metadata
+ * @param ids
+ *   Array filled with the stat IDs (can be NULL)
+ * @param values
+ *   Array filled with the stat values
+ * @param size
+ *   Size of the ids and values arrays
+ * @return
+ *   Number of stats of the sample (may be larger than size),
+ *   -EAGAIN if the sample is not written yet,
+ *   -ENOENT if it has been overwritten, other negative on error
+ */
+__rte_experimental
+int rte_sampler_shm_read(const struct rte_sampler_shm_header *shm, uint64_t seq,
+			 struct rte_sampler_shm_sample *sample,
+			 uint64_t *ids, uint64_t *values, unsigned int size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_SAMPLER_SINK_SHM_H_ */
@@ -0,0 +1,653 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#include <ctype.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_log.h>
+#include <rte_malloc.h>
+#include <rte_spinlock.h>
+#include <rte_stdatomic.h>
+#include <rte_string_fns.h>
+#include <rte_telemetry.h>
+#include <rte_sampler.h>
+#include "rte_sampler_sink_telemetry.h"
+
+#define TELEMETRY_CMD_PREFIX "/sampler/"
+#define TELEMETRY_STREAM_SUFFIX "/stream"
+#define DEFAULT_STREAM_TIMEOUT_MS 1000
+#define STREAM_POLL_US 1000
+#define INITIAL_SOURCES_CAPACITY 4
+
+/**
+ * Latest sample of one source
+ */
+struct telemetry_source {
+	char name[RTE_SAMPLER_XSTATS_NAME_SIZE];  /* Telemetry key of the source */
+	uint64_t tsc;
+	unsigned int n;
+	unsigned int capacity;                    /* Allocated size of arrays */
+	uint64_t *ids;
+	struct rte_sampler_xstats_name *names;
+	uint64_t *values;
+};
+
+/**
+ * Telemetry sink user data structure
+ */
+struct telemetry_sink_data {
+	struct rte_sampler_session *session;
+	uint32_t stream_timeout_ms;
+	rte_spinlock_t lock;                      /* Protects sources */
+	struct telemetry_source **sources;
+	unsigned int num_sources;
+	unsigned int sources_capacity;
+	RTE_ATOMIC(uint64_t) generation;          /* Number of samples received */
+	struct telemetry_endpoint *endpoint;
+};
+
+#define TELEMETRY_EP_CMD_LATEST RTE_BIT32(0)
+#define TELEMETRY_EP_CMD_STREAM RTE_BIT32(1)
+
+/**
+ * Telemetry endpoint, kept for the lifetime of the process since
+ * telemetry commands cannot be unregistered
+ *
+ * A slot is bound to its name as soon as one of its commands is
+ * registered, as that command keeps pointing to it.
+ */
+struct telemetry_endpoint {
+	char name[RTE_SAMPLER_XSTATS_NAME_SIZE];
+	struct telemetry_sink_data *data;         /* NULL if no sink attached */
+	uint32_t cmds;                            /* TELEMETRY_EP_CMD_* registered */
+};
+
+static struct {
+	struct telemetry_endpoint endpoints[RTE_SAMPLER_TELEMETRY_MAX_ENDPOINTS];
+	unsigned int num_endpoints;
+	rte_spinlock_t lock;                      /* Protects endpoints */
+	uint8_t list_registered;
+} telemetry_global = {
+	.lock = RTE_SPINLOCK_INITIALIZER,
+};
+
+/**
+ * Copy a name, replacing characters telemetry does not accept in keys
+ */
+static void
+telemetry_key(char *dst, size_t size, const char *src)
+{
+	size_t i;
+
+	for (i = 0; i + 1 < size && src[i] != '\0'; i++)
+		dst[i] = isalnum((unsigned char)src[i]) || src[i] == '/' ?
+			src[i] : '_';
+	dst[i] = '\0';
+}
+
+/**
+ * Find or add the entry of a source
+ *
+ * Only the sink output callback changes the sources, so they are looked
+ * up without the data lock. Memory is allocated before the lock is taken,
+ * which only covers publishing the new entry to telemetry readers.
+ */
+static struct telemetry_source *
+find_source(struct telemetry_sink_data *data, const char *key)
+{
+	struct telemetry_source **new_sources = NULL, **old_sources = NULL;
+	struct telemetry_source *src;
+	unsigned int new_capacity = 0;
+	unsigned int i;
+
+	for (i = 0; i < data->num_sources; i++) {
+		if (strcmp(data->sources[i]->name, key) == 0)
+			return data->sources[i];
+	}
+
+	if (data->num_sources == data->sources_capacity) {
+		new_capacity = data->sources_capacity * 2;
+		new_sources = rte_zmalloc(NULL,
+			new_capacity * sizeof(struct telemetry_source *), 0);
+		if (new_sources == NULL)
+			return NULL;
+
+		memcpy(new_sources, data->sources,
+			data->num_sources * sizeof(struct telemetry_source *));
+	}
+
+	src = rte_zmalloc(NULL, sizeof(*src), 0);
+	if (src == NULL) {
+		rte_free(new_sources);
+		return NULL;
+	}
+	rte_strscpy(src->name, key, sizeof(src->name));
+
+	rte_spinlock_lock(&data->lock);
+	if (new_sources != NULL) {
+		old_sources = data->sources;
+		data->sources = new_sources;
+		data->sources_capacity = new_capacity;
+	}
+	data->sources[data->num_sources++] = src;
+	rte_spinlock_unlock(&data->lock);
+
+	rte_free(old_sources);
+
+	return src;
+}
+
+/**
+ * Arrays of a source entry, allocated before the data lock is taken and
+ * freed once it is released
+ */
+struct source_arrays {
+	uint64_t *ids;
+	struct rte_sampler_xstats_name *names;
+	uint64_t *values;
+};
+
+static void
+source_arrays_free(struct source_arrays *arr)
+{
+	rte_free(arr->ids);
+	rte_free(arr->names);
+	rte_free(arr->values);
+}
+
+static int
+source_alloc(struct source_arrays *arr, unsigned int n)
+{
+	arr->ids = rte_malloc(NULL, sizeof(*arr->ids) * n, 0);
+	arr->names = rte_malloc(NULL, sizeof(*arr->names) * n, 0);
+	arr->values = rte_malloc(NULL, sizeof(*arr->values) * n, 0);
+	if (arr->ids == NULL || arr->names == NULL || arr->values == NULL) {
+		source_arrays_free(arr);
+		return -ENOMEM;
+	}
+
+	return 0;
+}
+
+/**
+ * Install the arrays of a source entry, called with data lock held
+ *
+ * The replaced arrays are returned in arr.
+ */
+static void
+source_swap(struct telemetry_source *src, struct source_arrays *arr,
+	    unsigned int n)
+{
+	struct source_arrays old = {
+		.ids = src->ids, .names = src->names, .values = src->values,
+	};
+
+	src->ids = arr->ids;
+	src->names = arr->names;
+	src->values = arr->values;
+	src->capacity = n;
+	src->n = 0;
+	*arr = old;
+}
+
+/**
+ * Telemetry sink output callback
+ *
+ * Stat names are only copied when the stats set of the source changes.
+ */
+static int
+telemetry_sink_output(const char *source_name,
+		uint16_t source_id,
+		const struct rte_sampler_xstats_name *xstats_names,
+		const uint64_t *ids,
+		const uint64_t *values,
+		unsigned int n,
+		void *user_data)
+{
+	struct telemetry_sink_data *data = user_data;
+	struct telemetry_source *src;
+	char name[RTE_SAMPLER_XSTATS_NAME_SIZE];
+	char key[RTE_SAMPLER_XSTATS_NAME_SIZE];
+	struct source_arrays arr = { 0 };
+	unsigned int i;
+
+	if (data == NULL)
+		return -EINVAL;
+
+	snprintf(name, sizeof(name), "%s_%u", source_name, source_id);
+	telemetry_key(key, sizeof(key), name);
+
+	src = find_source(data, key);
+	if (src == NULL)
+		return -ENOMEM;
+	if (n > src->capacity && source_alloc(&arr, n) < 0)
+		return -ENOMEM;
+
+	rte_spinlock_lock(&data->lock);
+
+	if (n > src->capacity)
+		source_swap(src, &arr, n);
+
+	if (src->n != n || memcmp(src->ids, ids, sizeof(uint64_t) * n) != 0) {
+		for (i = 0; i < n; i++) {
+			if (xstats_names != NULL)
+				telemetry_key(src->names[i].name,
+					RTE_SAMPLER_XSTATS_NAME_SIZE, xstats_names[i].name);
+			else
+				snprintf(src->names[i].name, RTE_SAMPLER_XSTATS_NAME_SIZE,
+					"%"PRIu64, ids[i]);
+		}
+		memcpy(src->ids, ids, sizeof(uint64_t) * n);
+		src->n = n;
+	}
+
+	memcpy(src->values, values, sizeof(uint64_t) * n);
+	src->tsc = rte_sampler_session_get_sample_tsc(data->session);
+
+	rte_spinlock_unlock(&data->lock);
+
+	source_arrays_free(&arr);
+
+	rte_atomic_fetch_add_explicit(&data->generation, 1,
+		rte_memory_order_release);
+
+	return 0;
+}
+
+/**
+ * Copy source idx of the endpoint sink, if any
+ *
+ * Sources are copied one at a time, so the sampler is only held off for
+ * a memory copy and never while telemetry data is being built. If the
+ * copy is too small, it is grown with the locks released and the copy
+ * is retried.
+ *
+ * @return
+ *   1 if copied, 0 past the last source, negative if no sink is attached
+ */
+static int
+endpoint_copy_source(struct telemetry_endpoint *ep, unsigned int idx,
+		     struct telemetry_source *copy)
+{
+	struct telemetry_sink_data *data;
+	struct telemetry_source *src;
+	struct source_arrays arr;
+	unsigned int n;
+	int ret;
+
+	do {
+		ret = 0;
+		n = 0;
+
+		rte_spinlock_lock(&telemetry_global.lock);
+
+		data = ep->data;
+		if (data == NULL) {
+			rte_spinlock_unlock(&telemetry_global.lock);
+			return -ENOENT;
+		}
+
+		rte_spinlock_lock(&data->lock);
+		if (idx < data->num_sources) {
+			src = data->sources[idx];
+			if (src->n > copy->capacity) {
+				n = src->n;
+			} else {
+				memcpy(copy->name, src->name, sizeof(copy->name));
+				memcpy(copy->ids, src->ids, sizeof(uint64_t) * src->n);
+				memcpy(copy->names, src->names,
+				       sizeof(*src->names) * src->n);
+				memcpy(copy->values, src->values,
+				       sizeof(uint64_t) * src->n);
+				copy->tsc = src->tsc;
+				copy->n = src->n;
+				ret = 1;
+			}
+		}
+		rte_spinlock_unlock(&data->lock);
+
+		rte_spinlock_unlock(&telemetry_global.lock);
+
+		if (n != 0) {
+			if (source_alloc(&arr, n) < 0)
+				return -ENOMEM;
+			source_swap(copy, &arr, n);
+			source_arrays_free(&arr);
+		}
+	} while (n != 0);
+
+	return ret;
+}
+
+/**
+ * Get the generation of the endpoint sink
+ */
+static int
+endpoint_generation(struct telemetry_endpoint *ep, uint64_t *generation)
+{
+	int ret = 0;
+
+	rte_spinlock_lock(&telemetry_global.lock);
+	if (ep->data != NULL)
+		*generation = rte_atomic_load_explicit(&ep->data->generation,
+			rte_memory_order_acquire);
+	else
+		ret = -ENOENT;
+	rte_spinlock_unlock(&telemetry_global.lock);
+
+	return ret;
+}
+
+/**
+ * Build the reply with the latest sample of all sources
+ */
+static int
+endpoint_reply(struct telemetry_endpoint *ep, struct rte_tel_data *d)
+{
+	struct telemetry_source copy;
+	struct rte_tel_data *c;
+	uint64_t generation;
+	unsigned int idx, i;
+	int ret;
+
+	ret = endpoint_generation(ep, &generation);
+	if (ret < 0)
+		return ret;
+
+	rte_tel_data_start_dict(d);
+	rte_tel_data_add_dict_uint(d, "generation", generation);
+
+	memset(&copy, 0, sizeof(copy));
+	for (idx = 0; ; idx++) {
+		ret = endpoint_copy_source(ep, idx, &copy);
+		if (ret <= 0)
+			break;
+
+		c = rte_tel_data_alloc();
+		if (c == NULL) {
+			ret = -ENOMEM;
+			break;
+		}
+
+		rte_tel_data_start_dict(c);
+		rte_tel_data_add_dict_uint(c, "tsc", copy.tsc);
+		for (i = 0; i < copy.n; i++)
+			rte_tel_data_add_dict_uint(c, copy.names[i].name, copy.values[i]);
+
+		if (rte_tel_data_add_dict_container(d, copy.name, c, 0) != 0)
+			rte_tel_data_free(c);
+	}
+
+	rte_free(copy.ids);
+	rte_free(copy.names);
+	rte_free(copy.values);
+
+	return ret < 0 ? ret : 0;
+}
+
+/**
+ * Telemetry callback for "/sampler/<endpoint>"
+ */
+static int
+telemetry_handle_endpoint(const char *cmd, const char *params, void *arg,
+			  struct rte_tel_data *d)
+{
+	RTE_SET_USED(cmd);
+	RTE_SET_USED(params);
+
+	return endpoint_reply(arg, d);
+}
+
+/**
+ * Telemetry callback for "/sampler/<endpoint>/stream"
+ *
+ * Runs in the telemetry thread of the client, so waiting here does not
+ * delay other clients nor the sampler.
+ */
+static int
+telemetry_handle_stream(const char *cmd, const char *params, void *arg,
+			struct rte_tel_data *d)
+{
+	struct telemetry_endpoint *ep = arg;
+	uint64_t last, generation, deadline;
+	uint32_t timeout_ms = DEFAULT_STREAM_TIMEOUT_MS;
+	char *end;
+	int ret;
+
+	RTE_SET_USED(cmd);
+
+	ret = endpoint_generation(ep, &generation);
+	if (ret < 0)
+		return ret;
+
+	/* Without a generation, wait for the next sample */
+	last = generation;
+	if (params != NULL && *params != '\0') {
+		last = strtoull(params, &end, 0);
+		if (*end != '\0')
+			return -EINVAL;
+	}
+
+	rte_spinlock_lock(&telemetry_global.lock);
+	if (ep->data != NULL)
+		timeout_ms = ep->data->stream_timeout_ms;
+	rte_spinlock_unlock(&telemetry_global.lock);
+
+	deadline = rte_get_timer_cycles() + timeout_ms * rte_get_timer_hz() / MS_PER_S;
+	while (generation <= last && rte_get_timer_cycles() < deadline) {
+		rte_delay_us_sleep(STREAM_POLL_US);
+		ret = endpoint_generation(ep, &generation);
+		if (ret < 0)
+			return ret;
+	}
+
+	return endpoint_reply(ep, d);
+}
+
+/**
+ * Telemetry callback for "/sampler/list"
+ */
+static int
+telemetry_handle_list(const char *cmd, const char *params,
+		      struct rte_tel_data *d)
+{
+	unsigned int i;
+
+	RTE_SET_USED(cmd);
+	RTE_SET_USED(params);
+
+	rte_tel_data_start_array(d, RTE_TEL_STRING_VAL);
+
+	rte_spinlock_lock(&telemetry_global.lock);
+	for (i = 0; i < telemetry_global.num_endpoints; i++) {
+		if (telemetry_global.endpoints[i].data != NULL)
+			rte_tel_data_add_array_string(d,
+				telemetry_global.endpoints[i].name);
+	}
+	rte_spinlock_unlock(&telemetry_global.lock);
+
+	return 0;
+}
+
+/**
+ * Attach sink data to the endpoint of the given name, registering its
+ * telemetry commands on first use
+ */
+static int
+endpoint_attach(const char *name, struct telemetry_sink_data *data)
+{
+	struct telemetry_endpoint *ep = NULL;
+	char cmd[RTE_SAMPLER_XSTATS_NAME_SIZE + sizeof(TELEMETRY_CMD_PREFIX) +
+		 sizeof(TELEMETRY_STREAM_SUFFIX)];
+	unsigned int i;
+	int ret = 0;
+
+	if (name[0] == '\0')
+		return -EINVAL;
+	for (i = 0; name[i] != '\0'; i++) {
+		if (!isalnum((unsigned char)name[i]) && name[i] != '_')
+			return -EINVAL;
+	}
+
+	rte_spinlock_lock(&telemetry_global.lock);
+
+	for (i = 0; i < telemetry_global.num_endpoints; i++) {
+		if (strcmp(telemetry_global.endpoints[i].name, name) == 0) {
+			ep = &telemetry_global.endpoints[i];
+			break;
+		}
+	}
+
+	if (ep != NULL && ep->data != NULL) {
+		ret = -EEXIST;
+		goto out;
+	}
+
+	if (ep == NULL) {
+		if (telemetry_global.num_endpoints == RTE_SAMPLER_TELEMETRY_MAX_ENDPOINTS) {
+			ret = -ENOSPC;
+			goto out;
+		}
+
+		ep = &telemetry_global.endpoints[telemetry_global.num_endpoints];
+		rte_strscpy(ep->name, name, sizeof(ep->name));
+		ep->cmds = 0;
+	}
+
+	/* Register the commands missing after an earlier partial failure */
+	if (!(ep->cmds & TELEMETRY_EP_CMD_LATEST)) {
+		snprintf(cmd, sizeof(cmd), TELEMETRY_CMD_PREFIX "%s", name);
+		ret = rte_telemetry_register_cmd_arg(cmd, telemetry_handle_endpoint, ep,
+			"Returns the latest sample of a sampler session. No parameters");
+		if (ret == 0)
+			ep->cmds |= TELEMETRY_EP_CMD_LATEST;
+	}
+
+	if (ret == 0 && !(ep->cmds & TELEMETRY_EP_CMD_STREAM)) {
+		snprintf(cmd, sizeof(cmd), TELEMETRY_CMD_PREFIX "%s" TELEMETRY_STREAM_SUFFIX,
+			 name);
+		ret = rte_telemetry_register_cmd_arg(cmd, telemetry_handle_stream, ep,
+			"Waits for and returns a sample newer than the given generation. "
+			"Parameters: int generation (optional)");
+		if (ret == 0)
+			ep->cmds |= TELEMETRY_EP_CMD_STREAM;
+	}
+
+	/* Keep the slot once a command points to it, even on failure */
+	if (ep == &telemetry_global.endpoints[telemetry_global.num_endpoints] &&
+	    ep->cmds != 0)
+		telemetry_global.num_endpoints++;
+
+	if (ret < 0)
+		goto out;
+
+	if (!telemetry_global.list_registered &&
+	    rte_telemetry_register_cmd(TELEMETRY_CMD_PREFIX "list",
+			telemetry_handle_list,
+			"Returns the list of sampler endpoints. No parameters") == 0)
+		telemetry_global.list_registered = 1;
+
+	ep->data = data;
+	data->endpoint = ep;
+
+out:
+	rte_spinlock_unlock(&telemetry_global.lock);
+
+	return ret;
+}
+
+static void
+telemetry_data_free(struct telemetry_sink_data *data)
+{
+	unsigned int i;
+
+	for (i = 0; i < data->num_sources; i++) {
+		rte_free(data->sources[i]->ids);
+		rte_free(data->sources[i]->names);
+		rte_free(data->sources[i]->values);
+		rte_free(data->sources[i]);
+	}
+	rte_free(data->sources);
+	rte_free(data);
+}
+
+struct rte_sampler_sink *
+rte_sampler_sink_telemetry_create(struct rte_sampler_session *session,
+		const char *name,
+		const struct rte_sampler_sink_telemetry_conf *conf)
+{
+	struct rte_sampler_sink_ops ops;
+	struct telemetry_sink_data *data;
+	struct rte_sampler_sink *sink;
+	int ret;
+
+	if (session == NULL || name == NULL || conf == NULL)
+		return NULL;
+
+	/* Allocate sink data */
+	data = rte_zmalloc(NULL, sizeof(*data), 0);
+	if (data == NULL)
+		return NULL;
+
+	data->sources = rte_zmalloc(NULL,
+		INITIAL_SOURCES_CAPACITY * sizeof(struct telemetry_source *), 0);
+	if (data->sources == NULL) {
+		rte_free(data);
+		return NULL;
+	}
+	data->sources_capacity = INITIAL_SOURCES_CAPACITY;
+	data->session = session;
+	data->stream_timeout_ms = conf->stream_timeout_ms > 0 ?
+		conf->stream_timeout_ms : DEFAULT_STREAM_TIMEOUT_MS;
+	rte_spinlock_init(&data->lock);
+
+	/* Setup sink operations, names are used as telemetry keys */
+	memset(&ops, 0, sizeof(ops));
+	ops.output = telemetry_sink_output;
+	ops.flags = 0;
+
+	/* Register sink */
+	sink = rte_sampler_session_register_sink(session, name, &ops, data);
+	if (sink == NULL) {
+		telemetry_data_free(data);
+		return NULL;
+	}
+
+	ret = endpoint_attach(conf->endpoint != NULL ? conf->endpoint : name, data);
+	if (ret < 0) {
+		RTE_LOG(ERR, USER1, "Failed to add sampler telemetry endpoint: %d\n",
+			ret);
+		rte_sampler_session_unregister_sink(session, sink);
+		telemetry_data_free(data);
+		return NULL;
+	}
+
+	return sink;
+}
+
+int
+rte_sampler_sink_telemetry_destroy(struct rte_sampler_sink *sink)
+{
+	struct telemetry_sink_data *data;
+
+	data = rte_sampler_sink_get_user_data(sink);
+	if (data == NULL)
+		return -EINVAL;
+
+	rte_sampler_sink_free(sink);
+
+	/* Detach from the endpoint, telemetry readers hold the global lock */
+	rte_spinlock_lock(&telemetry_global.lock);
+	data->endpoint->data = NULL;
+	rte_spinlock_unlock(&telemetry_global.lock);
+
+	telemetry_data_free(data);
+
+	return 0;
+}
@@ -0,0 +1,92 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#ifndef _RTE_SAMPLER_SINK_TELEMETRY_H_
+#define _RTE_SAMPLER_SINK_TELEMETRY_H_
+
+/**
+ * @file
+ * RTE Sampler Telemetry Sink
+ *
+ * Telemetry sink implementation for the sampler library.
+ * Keeps the latest sample of each source of a session and publishes it
+ * through lib/telemetry, so that a collector gets all the stats of a
+ * session with one request instead of one request per device:
+ *
+ * - "/sampler/list" lists the endpoints.
+ * - "/sampler/<endpoint>" returns the latest sample, as a dictionary with
+ *   the sample generation and one dictionary of stats per source.
+ * - "/sampler/<endpoint>/stream,<generation>" is a streaming subscription:
+ *   the request is held until a sample newer than the given generation is
+ *   available, or the stream timeout expires, and then returns it like
+ *   "/sampler/<endpoint>". A collector issues it again with the returned
+ *   generation to receive each update as soon as it is sampled.
+ *
+ * Telemetry commands cannot be unregistered: after the sink is destroyed
+ * the commands of its endpoint return an error, and a new sink may reuse
+ * the endpoint name.
+ */
+
+#include <stdint.h>
+#include <rte_sampler.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of telemetry sink endpoints */
+#define RTE_SAMPLER_TELEMETRY_MAX_ENDPOINTS 32
+
+/**
+ * Telemetry sink configuration
+ */
+struct rte_sampler_sink_telemetry_conf {
+	const char *endpoint;        /**< Endpoint name, alphanumeric or '_'
+				      *   (NULL = sink name)
+				      */
+	uint32_t stream_timeout_ms;  /**< Maximum wait of a stream request
+				      *   (0 = 1000 ms)
+				      */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create and register a telemetry sink
+ *
+ * @param session
+ *   Pointer to sampler session structure
+ * @param name
+ *   Name for this sink instance
+ * @param conf
+ *   Pointer to telemetry sink configuration
+ * @return
+ *   Pointer to sink structure on success, NULL on error
+ */
+__rte_experimental
+struct rte_sampler_sink *rte_sampler_sink_telemetry_create(
+		struct rte_sampler_session *session,
+		const char *name,
+		const struct rte_sampler_sink_telemetry_conf *conf);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Destroy a telemetry sink
+ *
+ * @param sink
+ *   Pointer to sink structure
+ * @return
+ *   Zero on success, negative on error
+ */
+__rte_experimental
+int rte_sampler_sink_telemetry_destroy(struct rte_sampler_sink *sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_SAMPLER_SINK_TELEMETRY_H_ */
@@ -0,0 +1,201 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <rte_common.h>
+#include <rte_malloc.h>
+#include "sampler_filter.h"
+
+#define FILTER_NONE UINT32_MAX
+
+/* Trie node, one per distinct literal prefix */
+struct filter_node {
+	uint32_t first_child;
+	uint32_t next_sibling;
+	uint32_t first_tail;   /* Patterns with a wildcard after this prefix */
+	uint8_t terminal;      /* A pattern without wildcard ends here */
+	char c;
+};
+
+/* Remainder of a pattern, starting at its first wildcard */
+struct filter_tail {
+	const char *rest;
+	uint32_t next;
+};
+
+struct sampler_filter {
+	struct filter_node *nodes;
+	uint32_t num_nodes;
+	struct filter_tail *tails;
+	uint32_t num_tails;
+	char *strings;         /* Copy of all patterns */
+};
+
+/**
+ * Simple wildcard pattern matching
+ * Supports * (match any) and ? (match one character)
+ */
+static int
+match_pattern(const char *pattern, const char *str)
+{
+	while (*pattern && *str) {
+		if (*pattern == '*') {
+			/* Skip consecutive asterisks */
+			while (*(pattern + 1) == '*')
+				pattern++;
+
+			/* If asterisk is last character, match */
+			if (!*(pattern + 1))
+				return 1;
+
+			/* Try matching rest of pattern with rest of string */
+			while (*str) {
+				if (match_pattern(pattern + 1, str))
+					return 1;
+				str++;
+			}
+			return 0;
+		} else if (*pattern == '?' || *pattern == *str) {
+			pattern++;
+			str++;
+		} else {
+			return 0;
+		}
+	}
+
+	/* Handle trailing asterisks */
+	while (*pattern == '*')
+		pattern++;
+
+	return (*pattern == '\0' && *str == '\0');
+}
+
+static uint32_t
+filter_child(const struct sampler_filter *filter, uint32_t node, char c)
+{
+	uint32_t child;
+
+	for (child = filter->nodes[node].first_child; child != FILTER_NONE;
+	     child = filter->nodes[child].next_sibling) {
+		if (filter->nodes[child].c == c)
+			return child;
+	}
+
+	return FILTER_NONE;
+}
+
+static uint32_t
+filter_add_child(struct sampler_filter *filter, uint32_t node, char c)
+{
+	struct filter_node *child = &filter->nodes[filter->num_nodes];
+
+	child->first_child = FILTER_NONE;
+	child->first_tail = FILTER_NONE;
+	child->terminal = 0;
+	child->c = c;
+	child->next_sibling = filter->nodes[node].first_child;
+	filter->nodes[node].first_child = filter->num_nodes;
+
+	return filter->num_nodes++;
+}
+
+struct sampler_filter *
+sampler_filter_compile(const char * const *patterns, unsigned int num_patterns)
+{
+	struct sampler_filter *filter;
+	size_t total_len = 0;
+	unsigned int i;
+	char *str;
+
+	for (i = 0; i < num_patterns; i++)
+		total_len += strlen(patterns[i]) + 1;
+
+	filter = rte_zmalloc(NULL, sizeof(*filter), 0);
+	if (filter == NULL)
+		return NULL;
+
+	/* At most one node per pattern character, plus the root */
+	filter->nodes = rte_malloc(NULL, sizeof(*filter->nodes) * (total_len + 1), 0);
+	filter->tails = rte_malloc(NULL, sizeof(*filter->tails) * RTE_MAX(num_patterns, 1U), 0);
+	filter->strings = rte_malloc(NULL, RTE_MAX(total_len, (size_t)1), 0);
+	if (filter->nodes == NULL || filter->tails == NULL || filter->strings == NULL) {
+		sampler_filter_free(filter);
+		return NULL;
+	}
+
+	filter->nodes[0].first_child = FILTER_NONE;
+	filter->nodes[0].next_sibling = FILTER_NONE;
+	filter->nodes[0].first_tail = FILTER_NONE;
+	filter->nodes[0].terminal = 0;
+	filter->nodes[0].c = '\0';
+	filter->num_nodes = 1;
+
+	str = filter->strings;
+	for (i = 0; i < num_patterns; i++) {
+		uint32_t node = 0, child;
+		const char *p;
+
+		strcpy(str, patterns[i]);
+
+		/* Insert the literal prefix in the trie */
+		for (p = str; *p != '\0' && *p != '*' && *p != '?'; p++) {
+			child = filter_child(filter, node, *p);
+			if (child == FILTER_NONE)
+				child = filter_add_child(filter, node, *p);
+			node = child;
+		}
+
+		if (*p == '\0') {
+			filter->nodes[node].terminal = 1;
+		} else {
+			struct filter_tail *tail = &filter->tails[filter->num_tails];
+
+			tail->rest = p;
+			tail->next = filter->nodes[node].first_tail;
+			filter->nodes[node].first_tail = filter->num_tails++;
+		}
+
+		str += strlen(str) + 1;
+	}
+
+	return filter;
+}
+
+int
+sampler_filter_match(const struct sampler_filter *filter, const char *name)
+{
+	uint32_t node = 0, tail;
+	const char *s = name;
+
+	for (;;) {
+		const struct filter_node *n = &filter->nodes[node];
+
+		for (tail = n->first_tail; tail != FILTER_NONE;
+		     tail = filter->tails[tail].next) {
+			if (match_pattern(filter->tails[tail].rest, s))
+				return 1;
+		}
+
+		if (*s == '\0')
+			return n->terminal;
+
+		node = filter_child(filter, node, *s);
+		if (node == FILTER_NONE)
+			return 0;
+		s++;
+	}
+}
+
+void
+sampler_filter_free(struct sampler_filter *filter)
+{
+	if (filter == NULL)
+		return;
+
+	rte_free(filter->nodes);
+	rte_free(filter->tails);
+	rte_free(filter->strings);
+	rte_free(filter);
+}
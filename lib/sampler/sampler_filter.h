@@ -0,0 +1,49 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2024 Intel Corporation
+ */
+
+#ifndef _SAMPLER_FILTER_H_
+#define _SAMPLER_FILTER_H_
+
+/**
+ * @file
+ * Compiled xstats name filter
+ *
+ * Wildcard patterns are compiled once into a trie of their literal
+ * prefixes (the characters before the first '*' or '?'). Matching a name
+ * walks the trie along the name, so only the patterns whose literal prefix
+ * matches the name are evaluated, and patterns without wildcard are
+ * matched by the walk alone.
+ */
+
+#include <stdint.h>
+
+struct sampler_filter;
+
+/**
+ * Compile filter patterns
+ *
+ * @param patterns
+ *   Array of patterns, supporting wildcards * and ?
+ * @param num_patterns
+ *   Number of patterns
+ * @return
+ *   Compiled filter, or NULL on allocation failure
+ */
+struct sampler_filter *sampler_filter_compile(const char * const *patterns,
+		unsigned int num_patterns);
+
+/**
+ * Check if a name matches any pattern of a compiled filter
+ *
+ * @return
+ *   1 if the name matches, 0 otherwise
+ */
+int sampler_filter_match(const struct sampler_filter *filter, const char *name);
+
+/**
+ * Free a compiled filter
+ */
+void sampler_filter_free(struct sampler_filter *filter);
+
+#endif /* _SAMPLER_FILTER_H_ */
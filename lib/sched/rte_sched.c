@@ -142,6 +142,23 @@ struct rte_sched_grinder {
 	uint8_t wrr_cost[RTE_SCHED_BE_QUEUES_PER_PIPE];
 };
 
+/* Dequeue state of the subports scheduled by one lcore */
+struct __rte_cache_aligned rte_sched_shard {
+	/* Timing */
+	uint64_t time_cpu_cycles;     /* Current CPU time measured in CPU cycles */
+	uint64_t time_cpu_bytes;      /* Current CPU time measured in bytes */
+	uint64_t time;                /* Current NIC TX time measured in bytes */
+
+	/* Port credits taken from the port token bucket for this dequeue */
+	uint64_t credits;
+
+	/* Grinders */
+	struct rte_mbuf **pkts_out;
+	uint32_t n_pkts_out;
+	uint32_t subport_id;
+	uint32_t n_subports;
+};
+
 struct __rte_cache_aligned rte_sched_subport {
 	/* Token bucket (TB) */
 	uint64_t tb_time; /* time of last update */
@@ -188,6 +205,9 @@ struct __rte_cache_aligned rte_sched_subport {
 	uint32_t pipe_loop;
 	uint32_t pipe_exhaustion;
 
+	/* Shard scheduling the subport */
+	struct rte_sched_shard *shard;
+
 	/* Bitmap */
 	struct rte_bitmap *bmp;
 	alignas(16) uint32_t grinder_base_bmp_pos[RTE_SCHED_PORT_N_GRINDERS];
@@ -228,16 +248,18 @@ struct __rte_cache_aligned rte_sched_port {
 	int socket;
 
 	/* Timing */
-	uint64_t time_cpu_cycles;     /* Current CPU time measured in CPU cycles */
-	uint64_t time_cpu_bytes;      /* Current CPU time measured in bytes */
-	uint64_t time;                /* Current NIC TX time measured in bytes */
 	struct rte_reciprocal inv_cycles_per_byte; /* CPU cycles per byte */
 	uint64_t cycles_per_byte;
 
-	/* Grinders */
-	struct rte_mbuf **pkts_out;
-	uint32_t n_pkts_out;
-	uint32_t subport_id;
+	/* Shards, subport i being scheduled by shard (i % n_shards) */
+	uint32_t n_shards;
+	struct rte_sched_shard *shards;
+	struct rte_sched_shard shard; /* Single shard of a port not sharded */
+
+	/* Port token bucket shared by the shards */
+	alignas(RTE_CACHE_LINE_SIZE) RTE_ATOMIC(uint64_t) tb_time;
+	RTE_ATOMIC(uint64_t) tb_credits;
+	uint64_t tb_size;
 
 	/* Large data structures */
 	struct rte_sched_subport_profile *subport_profiles;
@@ -999,9 +1021,9 @@ rte_sched_port_config(struct rte_sched_port_params *params)
 	port->frame_overhead = params->frame_overhead;
 
 	/* Timing */
-	port->time_cpu_cycles = rte_get_tsc_cycles();
-	port->time_cpu_bytes = 0;
-	port->time = 0;
+	port->shard.time_cpu_cycles = rte_get_tsc_cycles();
+	port->shard.time_cpu_bytes = 0;
+	port->shard.time = 0;
 
 	/* Subport profile table */
 	rte_sched_port_config_subport_profile_table(port, params, port->rate);
@@ -1012,9 +1034,12 @@ rte_sched_port_config(struct rte_sched_port_params *params)
 	port->cycles_per_byte = cycles_per_byte;
 
 	/* Grinders */
-	port->pkts_out = NULL;
-	port->n_pkts_out = 0;
-	port->subport_id = 0;
+	port->shard.pkts_out = NULL;
+	port->shard.n_pkts_out = 0;
+	port->shard.subport_id = 0;
+	port->shard.n_subports = port->n_subports_per_port;
+	port->n_shards = 1;
+	port->shards = &port->shard;
 
 	return port;
 }
@@ -1062,6 +1087,8 @@ rte_sched_port_free(struct rte_sched_port *port)
 	for (i = 0; i < port->n_subports_per_port; i++)
 		rte_sched_subport_free(port, port->subports[i]);
 
+	if (port->shards != &port->shard)
+		rte_free(port->shards);
 	rte_free(port->subport_profiles);
 	rte_free(port);
 }
@@ -1263,7 +1290,8 @@ rte_sched_subport_config(struct rte_sched_port *port,
 		/* Port */
 		port->subports[subport_id] = s;
 
-		s->tb_time = port->time;
+		s->shard = &port->shards[subport_id % port->n_shards];
+		s->tb_time = s->shard->time;
 
 		/* compile time checks */
 		RTE_BUILD_BUG_ON(RTE_SCHED_PORT_N_GRINDERS == 0);
@@ -1357,7 +1385,7 @@ rte_sched_subport_config(struct rte_sched_port *port,
 
 		s->tb_credits = profile->tb_size / 2;
 
-		s->tc_time = port->time + profile->tc_period;
+		s->tc_time = s->shard->time + profile->tc_period;
 
 		for (i = 0; i < RTE_SCHED_TRAFFIC_CLASSES_PER_PIPE; i++)
 			if (s->qsize[i])
@@ -1467,11 +1495,11 @@ rte_sched_pipe_config(struct rte_sched_port *port,
 	params = s->pipe_profiles + p->profile;
 
 	/* Token Bucket (TB) */
-	p->tb_time = port->time;
+	p->tb_time = s->shard->time;
 	p->tb_credits = params->tb_size / 2;
 
 	/* Traffic Classes (TCs) */
-	p->tc_time = port->time + params->tc_period;
+	p->tc_time = s->shard->time + params->tc_period;
 
 	for (i = 0; i < RTE_SCHED_TRAFFIC_CLASSES_PER_PIPE; i++)
 		if (s->qsize[i])
@@ -1891,25 +1919,26 @@ rte_sched_port_cman_drop(struct rte_sched_port *port,
 
 		red = &qe->red;
 
-		return rte_red_enqueue(red_cfg, red, qlen, port->time);
+		return rte_red_enqueue(red_cfg, red, qlen, subport->shard->time);
 	}
 
 	/* PIE */
 	struct rte_pie_config *pie_cfg = &subport->pie_config[tc_index];
 	struct rte_pie *pie = &qe->pie;
 
-	return rte_pie_enqueue(pie_cfg, pie, qlen, pkt->pkt_len, port->time_cpu_cycles);
+	return rte_pie_enqueue(pie_cfg, pie, qlen, pkt->pkt_len,
+		subport->shard->time_cpu_cycles);
 }
 
 static inline void
-rte_sched_port_red_set_queue_empty_timestamp(struct rte_sched_port *port,
-	struct rte_sched_subport *subport, uint32_t qindex)
+rte_sched_port_red_set_queue_empty_timestamp(struct rte_sched_subport *subport,
+	uint32_t qindex)
 {
 	if (subport->cman_enabled && subport->cman == RTE_SCHED_CMAN_RED) {
 		struct rte_sched_queue_extra *qe = subport->queue_extra + qindex;
 		struct rte_red *red = &qe->red;
 
-		rte_red_mark_queue_empty(red, port->time);
+		rte_red_mark_queue_empty(red, subport->shard->time);
 	}
 }
 
@@ -2299,8 +2328,7 @@ grinder_tc_ov_credits_update(struct rte_sched_port *port,
 }
 
 static inline void
-grinder_credits_update(struct rte_sched_port *port,
-	struct rte_sched_subport *subport, uint32_t pos)
+grinder_credits_update(struct rte_sched_subport *subport, uint32_t pos)
 {
 	struct rte_sched_grinder *grinder = subport->grinder + pos;
 	struct rte_sched_pipe *pipe = grinder->pipe;
@@ -2310,30 +2338,30 @@ grinder_credits_update(struct rte_sched_port *port,
 	uint32_t i;
 
 	/* Subport TB */
-	n_periods = (port->time - subport->tb_time) / sp->tb_period;
+	n_periods = (subport->shard->time - subport->tb_time) / sp->tb_period;
 	subport->tb_credits += n_periods * sp->tb_credits_per_period;
 	subport->tb_credits = RTE_MIN(subport->tb_credits, sp->tb_size);
 	subport->tb_time += n_periods * sp->tb_period;
 
 	/* Pipe TB */
-	n_periods = (port->time - pipe->tb_time) / params->tb_period;
+	n_periods = (subport->shard->time - pipe->tb_time) / params->tb_period;
 	pipe->tb_credits += n_periods * params->tb_credits_per_period;
 	pipe->tb_credits = RTE_MIN(pipe->tb_credits, params->tb_size);
 	pipe->tb_time += n_periods * params->tb_period;
 
 	/* Subport TCs */
-	if (unlikely(port->time >= subport->tc_time)) {
+	if (unlikely(subport->shard->time >= subport->tc_time)) {
 		for (i = 0; i < RTE_SCHED_TRAFFIC_CLASSES_PER_PIPE; i++)
 			subport->tc_credits[i] = sp->tc_credits_per_period[i];
 
-		subport->tc_time = port->time + sp->tc_period;
+		subport->tc_time = subport->shard->time + sp->tc_period;
 	}
 
 	/* Pipe TCs */
-	if (unlikely(port->time >= pipe->tc_time)) {
+	if (unlikely(subport->shard->time >= pipe->tc_time)) {
 		for (i = 0; i < RTE_SCHED_TRAFFIC_CLASSES_PER_PIPE; i++)
 			pipe->tc_credits[i] = params->tc_credits_per_period[i];
-		pipe->tc_time = port->time + params->tc_period;
+		pipe->tc_time = subport->shard->time + params->tc_period;
 	}
 }
 
@@ -2349,34 +2377,34 @@ grinder_credits_update_with_tc_ov(struct rte_sched_port *port,
 	uint32_t i;
 
 	/* Subport TB */
-	n_periods = (port->time - subport->tb_time) / sp->tb_period;
+	n_periods = (subport->shard->time - subport->tb_time) / sp->tb_period;
 	subport->tb_credits += n_periods * sp->tb_credits_per_period;
 	subport->tb_credits = RTE_MIN(subport->tb_credits, sp->tb_size);
 	subport->tb_time += n_periods * sp->tb_period;
 
 	/* Pipe TB */
-	n_periods = (port->time - pipe->tb_time) / params->tb_period;
+	n_periods = (subport->shard->time - pipe->tb_time) / params->tb_period;
 	pipe->tb_credits += n_periods * params->tb_credits_per_period;
 	pipe->tb_credits = RTE_MIN(pipe->tb_credits, params->tb_size);
 	pipe->tb_time += n_periods * params->tb_period;
 
 	/* Subport TCs */
-	if (unlikely(port->time >= subport->tc_time)) {
+	if (unlikely(subport->shard->time >= subport->tc_time)) {
 		subport->tc_ov_wm =
 			grinder_tc_ov_credits_update(port, subport, pos);
 
 		for (i = 0; i < RTE_SCHED_TRAFFIC_CLASSES_PER_PIPE; i++)
 			subport->tc_credits[i] = sp->tc_credits_per_period[i];
 
-		subport->tc_time = port->time + sp->tc_period;
+		subport->tc_time = subport->shard->time + sp->tc_period;
 		subport->tc_ov_period_id++;
 	}
 
 	/* Pipe TCs */
-	if (unlikely(port->time >= pipe->tc_time)) {
+	if (unlikely(subport->shard->time >= pipe->tc_time)) {
 		for (i = 0; i < RTE_SCHED_TRAFFIC_CLASSES_PER_PIPE; i++)
 			pipe->tc_credits[i] = params->tc_credits_per_period[i];
-		pipe->tc_time = port->time + params->tc_period;
+		pipe->tc_time = subport->shard->time + params->tc_period;
 	}
 
 	/* Pipe TCs - Oversubscription */
@@ -2475,9 +2503,14 @@ grinder_schedule(struct rte_sched_port *port,
 	struct rte_sched_queue *queue = grinder->queue[grinder->qpos];
 	uint32_t qindex = grinder->qindex[grinder->qpos];
 	struct rte_mbuf *pkt = grinder->pkt;
+	struct rte_sched_shard *shard = subport->shard;
 	uint32_t pkt_len = pkt->pkt_len + port->frame_overhead;
 	uint32_t be_tc_active;
 
+	/* Check port credits */
+	if (unlikely(pkt_len > shard->credits))
+		return 0;
+
 	if (subport->tc_ov_enabled) {
 		if (!grinder_credits_check_with_tc_ov(port, subport, pos))
 			return 0;
@@ -2487,10 +2520,11 @@ grinder_schedule(struct rte_sched_port *port,
 	}
 
 	/* Advance port time */
-	port->time += pkt_len;
+	shard->time += pkt_len;
+	shard->credits -= pkt_len;
 
 	/* Send packet */
-	port->pkts_out[port->n_pkts_out++] = pkt;
+	shard->pkts_out[shard->n_pkts_out++] = pkt;
 	queue->qr++;
 
 	be_tc_active = (grinder->tc_index == RTE_SCHED_TRAFFIC_CLASS_BE) ? ~0x0 : 0x0;
@@ -2503,10 +2537,10 @@ grinder_schedule(struct rte_sched_port *port,
 		if (be_tc_active)
 			grinder->wrr_mask[grinder->qpos] = 0;
 
-		rte_sched_port_red_set_queue_empty_timestamp(port, subport, qindex);
+		rte_sched_port_red_set_queue_empty_timestamp(subport, qindex);
 	}
 
-	rte_sched_port_pie_dequeue(subport, qindex, pkt_len, port->time_cpu_cycles);
+	rte_sched_port_pie_dequeue(subport, qindex, pkt_len, shard->time_cpu_cycles);
 
 	/* Reset pipe loop detection */
 	subport->pipe_loop = RTE_SCHED_PIPE_INVALID;
@@ -2854,7 +2888,7 @@ grinder_handle(struct rte_sched_port *port,
 		if (subport->tc_ov_enabled)
 			grinder_credits_update_with_tc_ov(port, subport, pos);
 		else
-			grinder_credits_update(port, subport, pos);
+			grinder_credits_update(subport, pos);
 
 		grinder->state = e_GRINDER_PREFETCH_MBUF;
 		return 0;
@@ -2925,33 +2959,86 @@ grinder_handle(struct rte_sched_port *port,
 }
 
 static inline void
-rte_sched_port_time_resync(struct rte_sched_port *port)
+rte_sched_port_time_resync(struct rte_sched_port *port, uint32_t shard_id)
 {
+	struct rte_sched_shard *shard = &port->shards[shard_id];
 	uint64_t cycles = rte_get_tsc_cycles();
 	uint64_t cycles_diff;
 	uint64_t bytes_diff;
 	uint32_t i;
 
-	if (cycles < port->time_cpu_cycles)
-		port->time_cpu_cycles = 0;
+	if (cycles < shard->time_cpu_cycles)
+		shard->time_cpu_cycles = 0;
 
-	cycles_diff = cycles - port->time_cpu_cycles;
+	cycles_diff = cycles - shard->time_cpu_cycles;
 	/* Compute elapsed time in bytes */
 	bytes_diff = rte_reciprocal_divide(cycles_diff << RTE_SCHED_TIME_SHIFT,
 					   port->inv_cycles_per_byte);
 
 	/* Advance port time */
-	port->time_cpu_cycles +=
+	shard->time_cpu_cycles +=
 		(bytes_diff * port->cycles_per_byte) >> RTE_SCHED_TIME_SHIFT;
-	port->time_cpu_bytes += bytes_diff;
-	if (port->time < port->time_cpu_bytes)
-		port->time = port->time_cpu_bytes;
+	shard->time_cpu_bytes += bytes_diff;
+	if (shard->time < shard->time_cpu_bytes)
+		shard->time = shard->time_cpu_bytes;
 
 	/* Reset pipe loop detection */
-	for (i = 0; i < port->n_subports_per_port; i++)
+	for (i = shard_id; i < port->n_subports_per_port; i += port->n_shards)
 		port->subports[i]->pipe_loop = RTE_SCHED_PIPE_INVALID;
 }
 
+/*
+ * Take the port credits of a shard dequeue from the port token bucket,
+ * refilled at the port rate by whichever shard comes first.
+ */
+static inline void
+rte_sched_port_credits_take(struct rte_sched_port *port,
+	struct rte_sched_shard *shard, uint32_t n_pkts)
+{
+	uint64_t cycles = rte_get_tsc_cycles();
+	uint64_t tb_time, tb_time_new, cycles_diff, bytes, credits, take;
+
+	tb_time = rte_atomic_load_explicit(&port->tb_time,
+		rte_memory_order_relaxed);
+	if (cycles > tb_time) {
+		cycles_diff = cycles - tb_time;
+		if (cycles_diff < rte_get_tsc_hz()) {
+			bytes = rte_reciprocal_divide(
+				cycles_diff << RTE_SCHED_TIME_SHIFT,
+				port->inv_cycles_per_byte);
+			tb_time_new = tb_time + ((bytes * port->cycles_per_byte)
+				>> RTE_SCHED_TIME_SHIFT);
+		} else {
+			bytes = port->tb_size;
+			tb_time_new = cycles;
+		}
+
+		if (bytes != 0 && rte_atomic_compare_exchange_strong_explicit(
+				&port->tb_time, &tb_time, tb_time_new,
+				rte_memory_order_relaxed,
+				rte_memory_order_relaxed)) {
+			credits = rte_atomic_load_explicit(&port->tb_credits,
+				rte_memory_order_relaxed);
+			while (!rte_atomic_compare_exchange_weak_explicit(
+					&port->tb_credits, &credits,
+					RTE_MIN(credits + bytes, port->tb_size),
+					rte_memory_order_relaxed,
+					rte_memory_order_relaxed))
+				;
+		}
+	}
+
+	credits = rte_atomic_load_explicit(&port->tb_credits,
+		rte_memory_order_relaxed);
+	do {
+		take = RTE_MIN(credits, (uint64_t)n_pkts * port->mtu);
+	} while (take != 0 && !rte_atomic_compare_exchange_weak_explicit(
+			&port->tb_credits, &credits, credits - take,
+			rte_memory_order_relaxed, rte_memory_order_relaxed));
+
+	shard->credits = take;
+}
+
 static inline int
 rte_sched_port_exceptions(struct rte_sched_subport *subport, int second_pass)
 {
@@ -2967,18 +3054,24 @@ rte_sched_port_exceptions(struct rte_sched_subport *subport, int second_pass)
 	return exceptions;
 }
 
-RTE_EXPORT_SYMBOL(rte_sched_port_dequeue)
-int
-rte_sched_port_dequeue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint32_t n_pkts)
+static inline int
+rte_sched_port_shard_grind(struct rte_sched_port *port, uint32_t shard_id,
+	struct rte_mbuf **pkts, uint32_t n_pkts)
 {
+	struct rte_sched_shard *shard = &port->shards[shard_id];
 	struct rte_sched_subport *subport;
-	uint32_t subport_id = port->subport_id;
+	uint32_t subport_id = shard->subport_id;
 	uint32_t i, n_subports = 0, count;
 
-	port->pkts_out = pkts;
-	port->n_pkts_out = 0;
+	shard->pkts_out = pkts;
+	shard->n_pkts_out = 0;
 
-	rte_sched_port_time_resync(port);
+	rte_sched_port_time_resync(port, shard_id);
+
+	if (port->n_shards == 1)
+		shard->credits = UINT64_MAX;
+	else
+		rte_sched_port_credits_take(port, shard, n_pkts);
 
 	/* Take each queue in the grinder one step further */
 	for (i = 0, count = 0; ; i++)  {
@@ -2987,32 +3080,123 @@ rte_sched_port_dequeue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint
 		count += grinder_handle(port, subport,
 				i & (RTE_SCHED_PORT_N_GRINDERS - 1));
 
-		if (count == n_pkts) {
-			subport_id++;
+		if (count == n_pkts || shard->credits < port->mtu) {
+			subport_id += port->n_shards;
 
-			if (subport_id == port->n_subports_per_port)
-				subport_id = 0;
+			if (subport_id >= port->n_subports_per_port)
+				subport_id = shard_id;
 
-			port->subport_id = subport_id;
+			shard->subport_id = subport_id;
 			break;
 		}
 
 		if (rte_sched_port_exceptions(subport, i >= RTE_SCHED_PORT_N_GRINDERS)) {
 			i = 0;
-			subport_id++;
+			subport_id += port->n_shards;
 			n_subports++;
 		}
 
-		if (subport_id == port->n_subports_per_port)
-			subport_id = 0;
+		if (subport_id >= port->n_subports_per_port)
+			subport_id = shard_id;
 
-		if (n_subports == port->n_subports_per_port) {
-			port->subport_id = subport_id;
+		if (n_subports == shard->n_subports) {
+			shard->subport_id = subport_id;
 			break;
 		}
 	}
 
+	/* Give the unused port credits back */
+	if (port->n_shards != 1 && shard->credits != 0)
+		rte_atomic_fetch_add_explicit(&port->tb_credits, shard->credits,
+			rte_memory_order_relaxed);
+
 	return count;
 }
 
+RTE_EXPORT_SYMBOL(rte_sched_port_dequeue)
+int
+rte_sched_port_dequeue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint32_t n_pkts)
+{
+	return rte_sched_port_shard_grind(port, 0, pkts, n_pkts);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_sched_port_shards_config, 26.03)
+int
+rte_sched_port_shards_config(struct rte_sched_port *port, uint32_t n_shards)
+{
+	struct rte_sched_shard *shards;
+	uint32_t i;
+
+	/* Check user parameters */
+	if (port == NULL || n_shards == 0 ||
+	    n_shards > port->n_subports_per_port) {
+		SCHED_LOG(ERR,
+			"%s: Incorrect value for parameter n_shards", __func__);
+		return -EINVAL;
+	}
+
+	if (port->shards != &port->shard) {
+		SCHED_LOG(ERR, "%s: Port already sharded", __func__);
+		return -EEXIST;
+	}
+
+	if (n_shards == 1)
+		return 0;
+
+	shards = rte_zmalloc_socket("sched_shards",
+		n_shards * sizeof(struct rte_sched_shard),
+		RTE_CACHE_LINE_SIZE, port->socket);
+	if (shards == NULL) {
+		SCHED_LOG(ERR, "%s: Memory allocation fails", __func__);
+		return -ENOMEM;
+	}
+
+	/*
+	 * All the shards start from the current time, the time of the
+	 * subports and pipes already configured being relative to it.
+	 */
+	for (i = 0; i < n_shards; i++) {
+		shards[i] = port->shard;
+		shards[i].subport_id = i;
+		shards[i].n_subports =
+			(port->n_subports_per_port - i + n_shards - 1) /
+			n_shards;
+	}
+
+	port->n_shards = n_shards;
+	port->shards = shards;
+	for (i = 0; i < port->n_subports_per_port; i++)
+		if (port->subports[i] != NULL)
+			port->subports[i]->shard = &shards[i % n_shards];
+
+	/* Port token bucket, up to 1 ms of traffic */
+	port->tb_size = RTE_MAX(port->rate / 1000,
+		(uint64_t)RTE_SCHED_PORT_N_GRINDERS * port->mtu);
+	rte_atomic_store_explicit(&port->tb_credits, port->tb_size,
+		rte_memory_order_relaxed);
+	rte_atomic_store_explicit(&port->tb_time, rte_get_tsc_cycles(),
+		rte_memory_order_relaxed);
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_sched_port_pkt_shard_get, 26.03)
+uint32_t
+rte_sched_port_pkt_shard_get(struct rte_sched_port *port,
+	const struct rte_mbuf *pkt)
+{
+	uint32_t queue_id = rte_mbuf_sched_queue_get(pkt);
+	uint32_t subport_id = queue_id >> (port->n_pipes_per_subport_log2 + 4);
+
+	return subport_id % port->n_shards;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_sched_port_shard_dequeue, 26.03)
+int
+rte_sched_port_shard_dequeue(struct rte_sched_port *port, uint32_t shard_id,
+	struct rte_mbuf **pkts, uint32_t n_pkts)
+{
+	return rte_sched_port_shard_grind(port, shard_id, pkts, n_pkts);
+}
+
 RTE_LOG_REGISTER_DEFAULT(sched_logtype, INFO);
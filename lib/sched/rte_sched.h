@@ -52,6 +52,7 @@
  */
 
 #include <rte_common.h>
+#include <rte_compat.h>
 #include <rte_mbuf.h>
 #include <rte_meter.h>
 
@@ -594,6 +595,78 @@ rte_sched_port_dequeue(struct rte_sched_port *port, struct rte_mbuf **pkts, uint
 int
 rte_sched_subport_tc_ov_config(struct rte_sched_port *port, uint32_t subport_id, bool tc_ov_enable);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Hierarchical scheduler port sharding. The subports of the port are split
+ * into n_shards shards, subport i belonging to shard (i % n_shards), each
+ * shard being dequeued by its own lcore with rte_sched_port_shard_dequeue().
+ * The port rate is shared by the shards through a token bucket.
+ *
+ * A shard owns its subports: the packets of a subport must be enqueued by
+ * the lcore dequeuing its shard, see rte_sched_port_pkt_shard_get().
+ *
+ * This function must be called after the port configuration, and before
+ * any packet is enqueued.
+ *
+ * @param port
+ *   Handle to port scheduler instance
+ * @param n_shards
+ *   Number of shards, from 1 to the number of subports of the port
+ * @return
+ *   0 upon success, error code otherwise
+ */
+__rte_experimental
+int
+rte_sched_port_shards_config(struct rte_sched_port *port, uint32_t n_shards);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the shard of the queue a packet is written to, as set in the packet
+ * descriptor by rte_sched_port_pkt_write().
+ *
+ * @param port
+ *   Handle to port scheduler instance
+ * @param pkt
+ *   Packet descriptor handle
+ * @return
+ *   Shard ID
+ */
+__rte_experimental
+uint32_t
+rte_sched_port_pkt_shard_get(struct rte_sched_port *port,
+	const struct rte_mbuf *pkt);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Hierarchical scheduler shard dequeue. Reads up to n_pkts from the
+ * subports of a shard, within the port credits left to the shard.
+ * Different shards can be dequeued concurrently.
+ *
+ * @param port
+ *   Handle to port scheduler instance
+ * @param shard_id
+ *   Shard ID
+ * @param pkts
+ *   Pre-allocated packet descriptor array where the packets dequeued
+ *   from the shard should be stored
+ * @param n_pkts
+ *   Number of packets to dequeue from the shard
+ * @return
+ *   Number of packets successfully dequeued and placed in the pkts array
+ *
+ * @see rte_sched_port_dequeue()
+ */
+__rte_experimental
+int
+rte_sched_port_shard_dequeue(struct rte_sched_port *port, uint32_t shard_id,
+	struct rte_mbuf **pkts, uint32_t n_pkts);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,271 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include <eal_export.h>
+#include <rte_common.h>
+#include <rte_errno.h>
+#include <rte_malloc.h>
+#include <rte_stdatomic.h>
+
+#include "rte_security_tier.h"
+
+/* Fixed point precision of the SA load */
+#define TIER_LOAD_SHIFT		4
+/* Weight of the last period in the SA load: 1/4 */
+#define TIER_EWMA_SHIFT		2
+#define TIER_DEFAULT_HYSTERESIS	150
+
+struct tier_sa {
+	RTE_ATOMIC(uint64_t) count; /* packets counted by the data path */
+	uint64_t last;              /* count at the previous rebalance */
+	uint64_t load;              /* average packets per period */
+	RTE_ATOMIC(uint8_t) tier;
+};
+
+/* SA sorted by load during a rebalance */
+struct tier_entry {
+	uint64_t load;
+	uint32_t sa_id;
+};
+
+struct rte_security_tier {
+	uint32_t nb_sa;
+	uint32_t hot_capacity;
+	uint32_t max_promotions;
+	uint32_t hysteresis;
+	rte_security_tier_migrate_t migrate;
+	void *migrate_arg;
+	struct rte_security_tier_stats stats;
+	struct tier_entry *cold;  /* promotion candidates, nb_sa entries */
+	struct tier_entry *hot;   /* demotion candidates, hot_capacity entries */
+	struct tier_sa *sa;
+};
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_security_tier_create, 26.03)
+struct rte_security_tier *
+rte_security_tier_create(const struct rte_security_tier_params *params)
+{
+	struct rte_security_tier *st;
+
+	if (params == NULL || params->nb_sa == 0 || params->migrate == NULL ||
+			params->hot_capacity > params->nb_sa) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	st = rte_zmalloc_socket(params->name, sizeof(*st), 0, params->socket_id);
+	if (st == NULL)
+		goto nomem;
+	st->sa = rte_zmalloc_socket(params->name,
+			sizeof(*st->sa) * params->nb_sa, RTE_CACHE_LINE_SIZE,
+			params->socket_id);
+	st->cold = rte_malloc_socket(params->name,
+			sizeof(*st->cold) * params->nb_sa, 0, params->socket_id);
+	st->hot = rte_malloc_socket(params->name,
+			sizeof(*st->hot) * RTE_MAX(params->hot_capacity, 1U), 0,
+			params->socket_id);
+	if (st->sa == NULL || st->cold == NULL || st->hot == NULL)
+		goto nomem;
+
+	st->nb_sa = params->nb_sa;
+	st->hot_capacity = params->hot_capacity;
+	st->max_promotions = params->max_promotions;
+	st->hysteresis = params->hysteresis != 0 ? params->hysteresis :
+			TIER_DEFAULT_HYSTERESIS;
+	st->migrate = params->migrate;
+	st->migrate_arg = params->migrate_arg;
+
+	return st;
+
+nomem:
+	rte_security_tier_free(st);
+	rte_errno = ENOMEM;
+	return NULL;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_security_tier_free, 26.03)
+void
+rte_security_tier_free(struct rte_security_tier *st)
+{
+	if (st == NULL)
+		return;
+
+	rte_free(st->hot);
+	rte_free(st->cold);
+	rte_free(st->sa);
+	rte_free(st);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_security_tier_count, 26.03)
+void
+rte_security_tier_count(struct rte_security_tier *st, const uint32_t sa_id[],
+		const uint32_t nb_pkts[], uint32_t num)
+{
+	uint32_t i;
+
+	for (i = 0; i != num; i++) {
+		if (unlikely(sa_id[i] >= st->nb_sa))
+			continue;
+		rte_atomic_fetch_add_explicit(&st->sa[sa_id[i]].count,
+				nb_pkts[i], rte_memory_order_relaxed);
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_security_tier_get, 26.03)
+enum rte_security_tier_type
+rte_security_tier_get(const struct rte_security_tier *st, uint32_t sa_id)
+{
+	if (sa_id >= st->nb_sa)
+		return RTE_SECURITY_TIER_COLD;
+
+	return rte_atomic_load_explicit(&st->sa[sa_id].tier,
+			rte_memory_order_relaxed);
+}
+
+static int
+tier_migrate(struct rte_security_tier *st, uint32_t sa_id,
+		enum rte_security_tier_type tier)
+{
+	int ret;
+
+	ret = st->migrate(sa_id, tier, st->migrate_arg);
+	if (ret != 0) {
+		st->stats.migrate_errors++;
+		return ret;
+	}
+
+	rte_atomic_store_explicit(&st->sa[sa_id].tier, tier,
+			rte_memory_order_relaxed);
+	if (tier == RTE_SECURITY_TIER_HOT) {
+		st->stats.nb_hot++;
+		st->stats.promotions++;
+	} else {
+		st->stats.nb_hot--;
+		st->stats.demotions++;
+	}
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_security_tier_set, 26.03)
+int
+rte_security_tier_set(struct rte_security_tier *st, uint32_t sa_id,
+		enum rte_security_tier_type tier)
+{
+	if (sa_id >= st->nb_sa || (tier != RTE_SECURITY_TIER_COLD &&
+			tier != RTE_SECURITY_TIER_HOT))
+		return -EINVAL;
+	if (rte_atomic_load_explicit(&st->sa[sa_id].tier,
+			rte_memory_order_relaxed) == tier)
+		return 0;
+	if (tier == RTE_SECURITY_TIER_HOT &&
+			st->stats.nb_hot == st->hot_capacity)
+		return -ENOSPC;
+
+	return tier_migrate(st, sa_id, tier);
+}
+
+/* Sort the promotion candidates, busiest first */
+static int
+tier_entry_cmp_desc(const void *a, const void *b)
+{
+	const struct tier_entry *ea = a;
+	const struct tier_entry *eb = b;
+
+	return (ea->load < eb->load) - (ea->load > eb->load);
+}
+
+/* Sort the demotion candidates, idlest first */
+static int
+tier_entry_cmp_asc(const void *a, const void *b)
+{
+	return tier_entry_cmp_desc(b, a);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_security_tier_rebalance, 26.03)
+int
+rte_security_tier_rebalance(struct rte_security_tier *st)
+{
+	uint64_t count, threshold, min_hot_load = UINT64_MAX;
+	uint32_t i, nb_cold = 0, nb_hot = 0, cold_idx, hot_idx;
+	uint32_t promoted = 0;
+	struct tier_sa *sa;
+
+	/* Update the loads, and list the SAs of each tier */
+	for (i = 0; i != st->nb_sa; i++) {
+		sa = &st->sa[i];
+		count = rte_atomic_load_explicit(&sa->count,
+				rte_memory_order_relaxed);
+		sa->load += (int64_t)(((count - sa->last) << TIER_LOAD_SHIFT) -
+				sa->load) >> TIER_EWMA_SHIFT;
+		sa->last = count;
+
+		if (rte_atomic_load_explicit(&sa->tier,
+				rte_memory_order_relaxed) == RTE_SECURITY_TIER_HOT) {
+			st->hot[nb_hot].load = sa->load;
+			st->hot[nb_hot].sa_id = i;
+			nb_hot++;
+			min_hot_load = RTE_MIN(min_hot_load, sa->load);
+		} else {
+			st->cold[nb_cold].load = sa->load;
+			st->cold[nb_cold].sa_id = i;
+			nb_cold++;
+		}
+	}
+
+	/*
+	 * Only the cold SAs able to replace a hot SA are candidates,
+	 * or any active cold SA while the hot tier is not full.
+	 */
+	if (nb_hot < st->hot_capacity)
+		threshold = 0;
+	else if (min_hot_load > UINT64_MAX / st->hysteresis)
+		return 0;
+	else
+		threshold = min_hot_load * st->hysteresis / 100;
+	for (i = 0, cold_idx = 0; i != nb_cold; i++) {
+		if (st->cold[i].load > threshold)
+			st->cold[cold_idx++] = st->cold[i];
+	}
+	nb_cold = cold_idx;
+	if (nb_cold == 0)
+		return 0;
+
+	qsort(st->cold, nb_cold, sizeof(st->cold[0]), tier_entry_cmp_desc);
+	qsort(st->hot, nb_hot, sizeof(st->hot[0]), tier_entry_cmp_asc);
+
+	cold_idx = 0;
+	hot_idx = 0;
+	while (cold_idx != nb_cold && (st->max_promotions == 0 ||
+			promoted != st->max_promotions)) {
+		/* Free an entry of the hot tier from its idlest SA */
+		if (st->stats.nb_hot == st->hot_capacity) {
+			if (hot_idx == nb_hot || st->cold[cold_idx].load * 100 <=
+					st->hot[hot_idx].load * st->hysteresis)
+				break;
+			tier_migrate(st, st->hot[hot_idx++].sa_id,
+					RTE_SECURITY_TIER_COLD);
+			continue;
+		}
+
+		/* Stop on a failure, the SA table of the NIC may be full */
+		if (tier_migrate(st, st->cold[cold_idx++].sa_id,
+				RTE_SECURITY_TIER_HOT) != 0)
+			break;
+		promoted++;
+	}
+
+	return promoted;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_security_tier_stats_get, 26.03)
+void
+rte_security_tier_stats_get(const struct rte_security_tier *st,
+		struct rte_security_tier_stats *stats)
+{
+	*stats = st->stats;
+}
@@ -0,0 +1,220 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_SECURITY_TIER_H_
+#define _RTE_SECURITY_TIER_H_
+
+/**
+ * @file
+ * RTE Security SA tiers
+ *
+ * Helper placing the SAs of an application in two tiers, when the inline
+ * protocol SA table of the NIC cannot hold all of them:
+ * - the hot tier, of a limited capacity, for the SAs offloaded inline,
+ * - the cold tier, for the other SAs, processed by lookaside protocol
+ *   or CPU crypto.
+ *
+ * The data path counts the packets of each SA, and the control path
+ * periodically calls rte_security_tier_rebalance() to promote the busiest
+ * cold SAs to the hot tier, in place of the idlest hot SAs. The migration
+ * of an SA itself, i.e. creating and destroying its sessions, is done by
+ * an application callback.
+ */
+
+#include <stdint.h>
+
+#include <rte_compat.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Tier of an SA. */
+enum rte_security_tier_type {
+	RTE_SECURITY_TIER_COLD, /**< Lookaside protocol or CPU crypto. */
+	RTE_SECURITY_TIER_HOT,  /**< Inline protocol. */
+};
+
+/** Handle of a set of SA tiers. */
+struct rte_security_tier;
+
+/**
+ * Callback migrating an SA to another tier.
+ *
+ * It is called by rte_security_tier_rebalance(), on the control thread.
+ * On success, the application must have switched the data path of the SA
+ * to its new tier.
+ *
+ * @param sa_id
+ *   The SA index.
+ * @param tier
+ *   The tier the SA is migrated to.
+ * @param arg
+ *   The argument given at the creation of the SA tiers.
+ * @return
+ *   0 on success, a negative errno value otherwise, e.g. -ENOSPC if the SA
+ *   table of the NIC is full. The SA then remains in its current tier.
+ */
+typedef int (*rte_security_tier_migrate_t)(uint32_t sa_id,
+		enum rte_security_tier_type tier, void *arg);
+
+/** SA tiers parameters. */
+struct rte_security_tier_params {
+	const char *name;      /**< Name of the SA tiers. */
+	int socket_id;         /**< Socket of the SA tiers memory. */
+	uint32_t nb_sa;        /**< Number of SAs, indexed from 0. */
+	uint32_t hot_capacity; /**< Maximum number of SAs in the hot tier. */
+	/**
+	 * Maximum number of promotions per rebalance, to bound the session
+	 * churn of the NIC. 0 for no limit.
+	 */
+	uint32_t max_promotions;
+	/**
+	 * Load ratio, in percent, a cold SA must exceed to replace a hot SA,
+	 * to avoid SAs bouncing between the tiers. 0 for the default of 150.
+	 */
+	uint32_t hysteresis;
+	rte_security_tier_migrate_t migrate; /**< SA migration callback. */
+	void *migrate_arg;     /**< Argument of the migration callback. */
+};
+
+/** SA tiers statistics. */
+struct rte_security_tier_stats {
+	uint32_t nb_hot;          /**< SAs in the hot tier. */
+	uint64_t promotions;      /**< SAs migrated to the hot tier. */
+	uint64_t demotions;       /**< SAs migrated to the cold tier. */
+	uint64_t migrate_errors;  /**< Failed migrations. */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a set of SA tiers. All the SAs are in the cold tier.
+ *
+ * @param params
+ *   The SA tiers parameters.
+ * @return
+ *   The SA tiers, or NULL on error with rte_errno set.
+ */
+__rte_experimental
+struct rte_security_tier *
+rte_security_tier_create(const struct rte_security_tier_params *params);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free a set of SA tiers. The SAs are not migrated.
+ *
+ * @param st
+ *   The SA tiers, can be NULL.
+ */
+__rte_experimental
+void
+rte_security_tier_free(struct rte_security_tier *st);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Count the packets of some SAs. Thread safe, to be called from the data
+ * path of both tiers.
+ *
+ * @param st
+ *   The SA tiers.
+ * @param sa_id
+ *   The SA indexes, an SA can be repeated.
+ * @param nb_pkts
+ *   The number of packets of each SA index.
+ * @param num
+ *   The number of SA indexes.
+ */
+__rte_experimental
+void
+rte_security_tier_count(struct rte_security_tier *st, const uint32_t sa_id[],
+		const uint32_t nb_pkts[], uint32_t num);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the tier of an SA.
+ *
+ * @param st
+ *   The SA tiers.
+ * @param sa_id
+ *   The SA index.
+ * @return
+ *   The tier of the SA.
+ */
+__rte_experimental
+enum rte_security_tier_type
+rte_security_tier_get(const struct rte_security_tier *st, uint32_t sa_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Migrate an SA to a tier, e.g. to place the SAs known to be busy at start.
+ * The migration callback is called if the tier of the SA changes.
+ *
+ * @param st
+ *   The SA tiers.
+ * @param sa_id
+ *   The SA index.
+ * @param tier
+ *   The tier to migrate the SA to.
+ * @return
+ *   - 0 on success.
+ *   - -EINVAL if the SA index is invalid.
+ *   - -ENOSPC if the hot tier is full.
+ *   - the error of the migration callback.
+ */
+__rte_experimental
+int
+rte_security_tier_set(struct rte_security_tier *st, uint32_t sa_id,
+		enum rte_security_tier_type tier);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Update the load of the SAs from their packets counted since the previous
+ * call, then migrate the busiest cold SAs to the hot tier, first to its
+ * free entries, then in place of the idlest hot SAs they exceed by the
+ * hysteresis ratio.
+ *
+ * To be called periodically from a single control thread.
+ *
+ * @param st
+ *   The SA tiers.
+ * @return
+ *   The number of SAs promoted to the hot tier, or a negative errno value.
+ */
+__rte_experimental
+int
+rte_security_tier_rebalance(struct rte_security_tier *st);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Get the statistics of the SA tiers.
+ *
+ * @param st
+ *   The SA tiers.
+ * @param stats
+ *   The statistics to fill.
+ */
+__rte_experimental
+void
+rte_security_tier_stats_get(const struct rte_security_tier *st,
+		struct rte_security_tier_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_SECURITY_TIER_H_ */
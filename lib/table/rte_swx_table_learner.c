@@ -596,3 +596,54 @@ rte_swx_table_learner_delete(void *table __rte_unused,
 		m->hit = 0;
 	}
 }
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_swx_table_learner_scan, 26.03)
+uint32_t
+rte_swx_table_learner_scan(void *table,
+			   uint64_t input_time,
+			   size_t *bucket_pos,
+			   uint32_t n_buckets)
+{
+	struct table *t = table;
+	size_t bucket_id;
+	uint32_t i, n_expired = 0;
+
+	if (!t || !bucket_pos)
+		return 0;
+
+	bucket_id = *bucket_pos & t->params.bucket_mask;
+
+	for ( ; n_buckets; n_buckets--) {
+		struct table_bucket *b = table_bucket_get(t, bucket_id);
+
+		bucket_id = (bucket_id + 1) & t->params.bucket_mask;
+		rte_prefetch0(table_bucket_get(t, bucket_id));
+
+		for (i = 0; i < TABLE_KEYS_PER_BUCKET; i++) {
+			uint64_t time = b->time[i];
+			uint64_t key_timeout;
+
+			/* Free position. */
+			if (!time)
+				continue;
+
+			time <<= 32;
+
+			/* Expired key: remove it. */
+			if (time < input_time) {
+				b->time[i] = 0;
+				n_expired++;
+				continue;
+			}
+
+			/* Key timeout decreased since the key timer was armed: rearm it. */
+			key_timeout = t->params.key_timeout[b->key_timeout_id[i]];
+			if (time - input_time > key_timeout)
+				b->time[i] = (input_time + key_timeout) >> 32;
+		}
+	}
+
+	*bucket_pos = bucket_id;
+
+	return n_expired;
+}
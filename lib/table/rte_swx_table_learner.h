@@ -306,6 +306,39 @@ void
 rte_swx_table_learner_delete(void *table,
 			     void *mailbox);
 
+/**
+ * Learner table expiry scan
+ *
+ * This operation scans a batch of consecutive table buckets, starting from the one given by the
+ * scan position, which is then moved past the batch, wrapping around at the end of the table.
+ *
+ * The keys found expired are removed from the table, so their positions are free for the keys
+ * added later on. The expiration time of the keys is lowered to the current time plus the current
+ * value of their key timeout, when longer, so the key timeout updates done with
+ * rte_swx_table_learner_timeout_update() also apply to the keys already in the table.
+ *
+ * Calling this operation with a small batch size after each burst of lookups spreads the scan of
+ * the full table over time. It must be called by the thread doing the lookup and add operations on
+ * this table.
+ *
+ * @param[in] table
+ *   Table handle.
+ * @param[in] input_time
+ *   Current time measured in CPU clock cycles.
+ * @param[in,out] bucket_pos
+ *   Scan position, 0 initially.
+ * @param[in] n_buckets
+ *   Number of buckets to scan.
+ * @return
+ *   Number of keys removed from the table.
+ */
+__rte_experimental
+uint32_t
+rte_swx_table_learner_scan(void *table,
+			   uint64_t input_time,
+			   size_t *bucket_pos,
+			   uint32_t n_buckets);
+
 /**
  * Learner table free
  *
@@ -19,6 +19,15 @@ extern "C" {
 /** Wildcard match table operations. */
 extern struct rte_swx_table_ops rte_swx_table_wildcard_match_ops;
 
+/**
+ * Wildcard match table operations, tuple space search implementation.
+ *
+ * The entries are stored in one exact match subtable per distinct key mask. Unlike the above
+ * implementation, entries can be added and deleted without rebuilding the table, which fits the
+ * tables updated frequently with a moderate number of distinct key masks.
+ */
+extern struct rte_swx_table_ops rte_swx_table_wildcard_match_tss_ops;
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,480 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(C) 2026 Marvell.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+#include <eal_export.h>
+#include <rte_common.h>
+#include <rte_hash.h>
+#include <rte_hash_crc.h>
+#include <rte_malloc.h>
+
+#include "rte_swx_table_wm.h"
+
+/* Tuple Space Search (TSS): the table entries are grouped in subtables by key mask, with each
+ * subtable being an exact match table of the masked keys. The lookup searches the subtables by
+ * decreasing order of their highest entry priority, so it can stop as soon as the remaining
+ * subtables cannot hold a better match. The subtables with the same highest entry priority are
+ * searched by decreasing number of lookup hits.
+ */
+
+struct subtable {
+	/* Exact match table: masked key -> entry ID. */
+	struct rte_hash *hash;
+
+	/* Highest priority of the subtable entries, i.e. the lowest *key_priority* value. */
+	uint32_t priority;
+
+	/* Number of entries. */
+	uint32_t n_entries;
+
+	/* Number of lookup hits. */
+	uint64_t n_hits;
+
+	/* Key mask, i.e. the table *key_mask0* and'ed with the entry key mask. */
+	uint8_t mask[];
+};
+
+struct entry {
+	/* Subtable of the entry, NULL when the entry is free. */
+	struct subtable *subtable;
+
+	/* Entry priority. */
+	uint32_t priority;
+
+	/* Next free entry. */
+	uint32_t next_free;
+};
+
+struct table {
+	/* Table parameters. */
+	uint32_t key_size;
+	uint32_t key_offset;
+	uint32_t action_data_size;
+	uint32_t n_keys_max;
+	rte_swx_hash_func_t hash_func;
+	uint8_t *key_mask0;
+	int numa_node;
+
+	/* Subtables, sorted in lookup order. */
+	struct subtable **subtables;
+	uint32_t n_subtables;
+	uint32_t subtable_name_id;
+
+	/* Entries. */
+	struct entry *entries;
+	uint32_t free_entry_id;
+
+	/* Entry data, i.e. the 8-byte action ID followed by the action data. */
+	uint8_t *data;
+	size_t entry_data_size;
+
+	/* Masked key scratch buffer. */
+	uint8_t *key_buf;
+};
+
+static inline uint8_t *
+table_entry_data_get(struct table *t, uint32_t entry_id)
+{
+	return &t->data[entry_id * t->entry_data_size];
+}
+
+static inline void
+table_key_mask(struct table *t, uint8_t *dst, const uint8_t *key, const uint8_t *mask)
+{
+	uint32_t i;
+
+	for (i = 0; i < t->key_size; i++)
+		dst[i] = key[i] & mask[i];
+}
+
+static void
+table_entry_mask_get(struct table *t, uint8_t *mask, struct rte_swx_table_entry *entry)
+{
+	uint32_t i;
+
+	for (i = 0; i < t->key_size; i++)
+		mask[i] = (t->key_mask0 ? t->key_mask0[i] : 0xFF) &
+			  (entry->key_mask ? entry->key_mask[i] : 0xFF);
+}
+
+static int
+subtable_cmp(const void *a, const void *b)
+{
+	const struct subtable *sa = *(const struct subtable * const *)a;
+	const struct subtable *sb = *(const struct subtable * const *)b;
+
+	if (sa->priority != sb->priority)
+		return sa->priority < sb->priority ? -1 : 1;
+
+	if (sa->n_hits != sb->n_hits)
+		return sa->n_hits > sb->n_hits ? -1 : 1;
+
+	return 0;
+}
+
+static void
+table_subtables_sort(struct table *t)
+{
+	qsort(t->subtables, t->n_subtables, sizeof(struct subtable *), subtable_cmp);
+}
+
+static void
+subtable_free(struct subtable *s)
+{
+	if (!s)
+		return;
+
+	rte_hash_free(s->hash);
+	rte_free(s);
+}
+
+static struct subtable *
+subtable_create(struct table *t, const uint8_t *mask)
+{
+	struct rte_hash_parameters hash_params = {0};
+	char name[RTE_HASH_NAMESIZE];
+	struct subtable *s;
+
+	s = rte_zmalloc_socket(NULL, sizeof(struct subtable) + t->key_size, RTE_CACHE_LINE_SIZE,
+			       t->numa_node);
+	if (!s)
+		return NULL;
+
+	snprintf(name, sizeof(name), "tss_%p_%u", (void *)t, t->subtable_name_id++);
+
+	hash_params.name = name;
+	hash_params.entries = RTE_MAX(t->n_keys_max, 8U);
+	hash_params.key_len = t->key_size;
+	hash_params.hash_func = t->hash_func;
+	hash_params.socket_id = t->numa_node;
+	hash_params.extra_flag = RTE_HASH_EXTRA_FLAGS_EXT_TABLE;
+
+	s->hash = rte_hash_create(&hash_params);
+	if (!s->hash) {
+		rte_free(s);
+		return NULL;
+	}
+
+	s->priority = UINT32_MAX;
+	memcpy(s->mask, mask, t->key_size);
+
+	return s;
+}
+
+static struct subtable *
+table_subtable_find(struct table *t, const uint8_t *mask)
+{
+	uint32_t i;
+
+	for (i = 0; i < t->n_subtables; i++) {
+		struct subtable *s = t->subtables[i];
+
+		if (!memcmp(s->mask, mask, t->key_size))
+			return s;
+	}
+
+	return NULL;
+}
+
+/* Recompute the subtable priority after one of its highest priority entries is deleted. */
+static void
+subtable_priority_update(struct table *t, struct subtable *s)
+{
+	const void *key;
+	uint32_t iter = 0;
+	void *data;
+
+	s->priority = UINT32_MAX;
+	while (rte_hash_iterate(s->hash, &key, &data, &iter) >= 0) {
+		struct entry *e = &t->entries[(uintptr_t)data];
+
+		if (e->priority < s->priority)
+			s->priority = e->priority;
+	}
+}
+
+static void
+table_entry_data_set(struct table *t, uint32_t entry_id, struct rte_swx_table_entry *entry)
+{
+	uint64_t *d = (uint64_t *)table_entry_data_get(t, entry_id);
+
+	d[0] = entry->action_id;
+	if (t->action_data_size && entry->action_data)
+		memcpy(&d[1], entry->action_data, t->action_data_size);
+}
+
+static int
+table_add(void *table, struct rte_swx_table_entry *entry)
+{
+	struct table *t = table;
+	struct subtable *s;
+	struct entry *e;
+	uint32_t entry_id;
+	uint8_t *mask;
+	void *data;
+	int status;
+
+	if (!t || !entry || !entry->key)
+		return -EINVAL;
+
+	mask = t->key_buf + t->key_size;
+	table_entry_mask_get(t, mask, entry);
+	table_key_mask(t, t->key_buf, entry->key, mask);
+
+	/* Existing entry: update its data and priority. */
+	s = table_subtable_find(t, mask);
+	if (s && rte_hash_lookup_data(s->hash, t->key_buf, &data) >= 0) {
+		entry_id = (uintptr_t)data;
+		e = &t->entries[entry_id];
+
+		table_entry_data_set(t, entry_id, entry);
+
+		if (e->priority != entry->key_priority) {
+			uint32_t priority = e->priority;
+
+			e->priority = entry->key_priority;
+			if (e->priority < s->priority)
+				s->priority = e->priority;
+			else if (priority == s->priority)
+				subtable_priority_update(t, s);
+			table_subtables_sort(t);
+		}
+
+		return 0;
+	}
+
+	/* New entry. */
+	if (t->free_entry_id == UINT32_MAX)
+		return -ENOSPC;
+
+	if (!s) {
+		if (t->n_subtables == t->n_keys_max)
+			return -ENOSPC;
+
+		s = subtable_create(t, mask);
+		if (!s)
+			return -ENOMEM;
+
+		t->subtables[t->n_subtables++] = s;
+	}
+
+	entry_id = t->free_entry_id;
+	status = rte_hash_add_key_data(s->hash, t->key_buf, (void *)(uintptr_t)entry_id);
+	if (status) {
+		if (!s->n_entries) {
+			t->n_subtables--;
+			subtable_free(s);
+		}
+		return status == -ENOSPC ? -ENOSPC : -EINVAL;
+	}
+
+	e = &t->entries[entry_id];
+	t->free_entry_id = e->next_free;
+	e->subtable = s;
+	e->priority = entry->key_priority;
+
+	table_entry_data_set(t, entry_id, entry);
+
+	s->n_entries++;
+	if (e->priority < s->priority)
+		s->priority = e->priority;
+	table_subtables_sort(t);
+
+	return 0;
+}
+
+static int
+table_del(void *table, struct rte_swx_table_entry *entry)
+{
+	struct table *t = table;
+	struct subtable *s;
+	struct entry *e;
+	uint32_t entry_id, i;
+	uint8_t *mask;
+	void *data;
+
+	if (!t || !entry || !entry->key)
+		return -EINVAL;
+
+	mask = t->key_buf + t->key_size;
+	table_entry_mask_get(t, mask, entry);
+	table_key_mask(t, t->key_buf, entry->key, mask);
+
+	s = table_subtable_find(t, mask);
+	if (!s || rte_hash_lookup_data(s->hash, t->key_buf, &data) < 0)
+		return 0;
+
+	rte_hash_del_key(s->hash, t->key_buf);
+
+	entry_id = (uintptr_t)data;
+	e = &t->entries[entry_id];
+	e->subtable = NULL;
+	e->next_free = t->free_entry_id;
+	t->free_entry_id = entry_id;
+
+	s->n_entries--;
+	if (s->n_entries) {
+		if (e->priority == s->priority)
+			subtable_priority_update(t, s);
+		table_subtables_sort(t);
+		return 0;
+	}
+
+	/* Empty subtable: remove it, the order of the other ones is unchanged. */
+	for (i = 0; i < t->n_subtables; i++)
+		if (t->subtables[i] == s)
+			break;
+
+	memmove(&t->subtables[i], &t->subtables[i + 1],
+		(t->n_subtables - i - 1) * sizeof(struct subtable *));
+	t->n_subtables--;
+	subtable_free(s);
+
+	return 0;
+}
+
+static void
+table_free(void *table)
+{
+	struct table *t = table;
+	uint32_t i;
+
+	if (!t)
+		return;
+
+	for (i = 0; i < t->n_subtables; i++)
+		subtable_free(t->subtables[i]);
+
+	rte_free(t->subtables);
+	rte_free(t->entries);
+	rte_free(t->data);
+	rte_free(t->key_buf);
+	rte_free(t->key_mask0);
+	rte_free(t);
+}
+
+static void *
+table_create(struct rte_swx_table_params *params,
+	     struct rte_swx_table_entry_list *entries,
+	     const char *args __rte_unused,
+	     int numa_node)
+{
+	struct rte_swx_table_entry *entry;
+	struct table *t;
+	uint32_t i;
+
+	/* Check input arguments. */
+	if (!params || !params->key_size || !params->n_keys_max)
+		return NULL;
+
+	/* Memory allocation and initialization. */
+	t = rte_zmalloc_socket(NULL, sizeof(struct table), RTE_CACHE_LINE_SIZE, numa_node);
+	if (!t)
+		return NULL;
+
+	t->key_size = params->key_size;
+	t->key_offset = params->key_offset;
+	t->action_data_size = params->action_data_size;
+	t->n_keys_max = params->n_keys_max;
+	t->hash_func = params->hash_func ? params->hash_func : rte_hash_crc;
+	t->numa_node = numa_node;
+	t->entry_data_size = RTE_ALIGN_CEIL(8 + params->action_data_size, 8);
+
+	t->subtables = rte_zmalloc_socket(NULL, t->n_keys_max * sizeof(struct subtable *),
+					  RTE_CACHE_LINE_SIZE, numa_node);
+	t->entries = rte_zmalloc_socket(NULL, t->n_keys_max * sizeof(struct entry), 0, numa_node);
+	t->data = rte_zmalloc_socket(NULL, t->n_keys_max * t->entry_data_size,
+				     RTE_CACHE_LINE_SIZE, numa_node);
+	t->key_buf = rte_zmalloc_socket(NULL, 2 * t->key_size, RTE_CACHE_LINE_SIZE, numa_node);
+	if (!t->subtables || !t->entries || !t->data || !t->key_buf)
+		goto error;
+
+	if (params->key_mask0) {
+		t->key_mask0 = rte_malloc_socket(NULL, t->key_size, 0, numa_node);
+		if (!t->key_mask0)
+			goto error;
+
+		memcpy(t->key_mask0, params->key_mask0, t->key_size);
+	}
+
+	for (i = 0; i < t->n_keys_max; i++)
+		t->entries[i].next_free = i + 1;
+	t->entries[t->n_keys_max - 1].next_free = UINT32_MAX;
+	t->free_entry_id = 0;
+
+	if (entries)
+		TAILQ_FOREACH(entry, entries, node)
+			if (table_add(t, entry))
+				goto error;
+
+	return t;
+
+error:
+	table_free(t);
+	return NULL;
+}
+
+static int
+table_lookup(void *table,
+	     void *mailbox __rte_unused,
+	     uint8_t **key,
+	     uint64_t *action_id,
+	     uint8_t **action_data,
+	     size_t *entry_id,
+	     int *hit)
+{
+	struct table *t = table;
+	const uint8_t *input_key = &(*key)[t->key_offset];
+	struct subtable *s_hit = NULL;
+	uint32_t priority = UINT32_MAX;
+	uint32_t id = 0, i;
+	uint8_t *data;
+
+	for (i = 0; i < t->n_subtables; i++) {
+		struct subtable *s = t->subtables[i];
+		void *d;
+
+		/* No better match in this subtable and the next ones. */
+		if (s_hit && s->priority >= priority)
+			break;
+
+		table_key_mask(t, t->key_buf, input_key, s->mask);
+		if (rte_hash_lookup_data(s->hash, t->key_buf, &d) < 0)
+			continue;
+
+		if (!s_hit || t->entries[(uintptr_t)d].priority < priority) {
+			s_hit = s;
+			id = (uintptr_t)d;
+			priority = t->entries[id].priority;
+		}
+	}
+
+	if (!s_hit) {
+		*hit = 0;
+		return 1;
+	}
+
+	s_hit->n_hits++;
+
+	data = table_entry_data_get(t, id);
+	*action_id = ((uint64_t *)data)[0];
+	*action_data = &data[8];
+	*entry_id = id;
+	*hit = 1;
+	return 1;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_swx_table_wildcard_match_tss_ops, 26.03)
+struct rte_swx_table_ops rte_swx_table_wildcard_match_tss_ops = {
+	.footprint_get = NULL,
+	.mailbox_size_get = NULL,
+	.create = table_create,
+	.add = table_add,
+	.del = table_del,
+	.lkp = table_lookup,
+	.free = table_free,
+};
@@ -115,7 +115,7 @@ check_params_create(struct rte_table_hash_params *params)
 
 	/* key_size */
 	if ((params->key_size < sizeof(uint64_t)) ||
-		(!rte_is_power_of_2(params->key_size))) {
+		(params->key_size % sizeof(uint64_t))) {
 		TABLE_LOG(ERR, "%s: key_size invalid value", __func__);
 		return -EINVAL;
 	}
@@ -184,7 +184,8 @@ rte_table_hash_lru_create(void *params, int socket_id, uint32_t entry_size)
 	table_meta_sz = RTE_CACHE_LINE_ROUNDUP(sizeof(struct rte_table_hash));
 	key_mask_sz = RTE_CACHE_LINE_ROUNDUP(p->key_size);
 	bucket_sz = RTE_CACHE_LINE_ROUNDUP(n_buckets * sizeof(struct bucket));
-	key_sz = RTE_CACHE_LINE_ROUNDUP(p->n_keys * p->key_size);
+	/* Keys are stored with a power of 2 stride */
+	key_sz = RTE_CACHE_LINE_ROUNDUP(p->n_keys * rte_align32pow2(p->key_size));
 	key_stack_sz = RTE_CACHE_LINE_ROUNDUP(p->n_keys * sizeof(uint32_t));
 	data_sz = RTE_CACHE_LINE_ROUNDUP(p->n_keys * entry_size);
 	total_size = table_meta_sz + key_mask_sz + bucket_sz + key_sz +
@@ -224,7 +225,7 @@ rte_table_hash_lru_create(void *params, int socket_id, uint32_t entry_size)
 
 	/* Internal */
 	t->bucket_mask = t->n_buckets - 1;
-	t->key_size_shl = rte_ctz32(p->key_size);
+	t->key_size_shl = rte_ctz32(rte_align32pow2(p->key_size));
 	t->data_size_shl = rte_ctz32(entry_size);
 
 	/* Tables */
@@ -575,6 +576,22 @@ static int rte_table_hash_lru_lookup_unoptimized(
 		if (or == 0)						\
 			match_key = 1;					\
 	}								\
+	break;								\
+									\
+	case 40:							\
+	{								\
+		uint64_t xor[5], or;					\
+									\
+		xor[0] = (pkt_key[0] & key_mask[0]) ^ bkt_key[0];		\
+		xor[1] = (pkt_key[1] & key_mask[1]) ^ bkt_key[1];		\
+		xor[2] = (pkt_key[2] & key_mask[2]) ^ bkt_key[2];		\
+		xor[3] = (pkt_key[3] & key_mask[3]) ^ bkt_key[3];		\
+		xor[4] = (pkt_key[4] & key_mask[4]) ^ bkt_key[4];		\
+		or = xor[0] | xor[1] | xor[2] | xor[3] | xor[4];	\
+		match_key = 0;						\
+		if (or == 0)						\
+			match_key = 1;					\
+	}								\
 	break;								\
 									\
 	case 64:							\
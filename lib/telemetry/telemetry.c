@@ -22,12 +22,15 @@
 #include <rte_log.h>
 
 #include "rte_telemetry.h"
+#include "telemetry_cbor.h"
 #include "telemetry_json.h"
 #include "telemetry_data.h"
 #include "telemetry_internal.h"
 
 #define MAX_CMD_LEN 56
 #define MAX_OUTPUT_LEN (1024 * 16)
+#define MAX_INPUT_LEN 4096
+#define MAX_BATCH_OUTPUT_LEN (1024 * 64)
 #define MAX_CONNECTIONS 10
 
 #ifndef RTE_EXEC_ENV_WINDOWS
@@ -35,6 +38,17 @@ static void *
 client_handler(void *socket);
 #endif /* !RTE_EXEC_ENV_WINDOWS */
 
+/* output encodings, negotiated per connection */
+enum tel_encoding {
+	TEL_ENC_JSON,
+	TEL_ENC_CBOR,
+};
+
+static const char * const tel_encoding_names[] = {
+	[TEL_ENC_JSON] = "json",
+	[TEL_ENC_CBOR] = "cbor",
+};
+
 struct cmd_callback {
 	char cmd[MAX_CMD_LEN];
 	telemetry_cb fn;
@@ -255,22 +269,20 @@ container_to_json(const struct rte_tel_data *d, char *out_buf, size_t buf_len)
 	return used;
 }
 
-static void
-output_json(const char *cmd, const struct rte_tel_data *d, int s)
+static int
+output_json(const char *cmd, const struct rte_tel_data *d, char *out_buf)
 {
-	char out_buf[MAX_OUTPUT_LEN];
-
 	char *cb_data_buf;
 	size_t buf_len, prefix_used, used = 0;
 	unsigned int i;
 
-	RTE_BUILD_BUG_ON(sizeof(out_buf) < MAX_CMD_LEN +
+	RTE_BUILD_BUG_ON(MAX_OUTPUT_LEN < MAX_CMD_LEN +
 			RTE_TEL_MAX_SINGLE_STRING_LEN + 10);
 
-	prefix_used = snprintf(out_buf, sizeof(out_buf), "{\"%.*s\":",
+	prefix_used = snprintf(out_buf, MAX_OUTPUT_LEN, "{\"%.*s\":",
 			MAX_CMD_LEN, cmd);
 	cb_data_buf = &out_buf[prefix_used];
-	buf_len = sizeof(out_buf) - prefix_used - 1; /* space for '}' */
+	buf_len = MAX_OUTPUT_LEN - prefix_used - 1; /* space for '}' */
 
 	switch (d->type) {
 	case TEL_NULL:
@@ -363,13 +375,107 @@ output_json(const char *cmd, const struct rte_tel_data *d, int s)
 		break;
 	}
 	used += prefix_used;
-	used += strlcat(out_buf + used, "}", sizeof(out_buf) - used);
-	if (write(s, out_buf, used) < 0)
-		TMTY_LOG_LINE(ERR, "Error writing to socket: %s", strerror(errno));
+	used += strlcat(out_buf + used, "}", MAX_OUTPUT_LEN - used);
+	return used;
 }
 
-static void
-perform_command(const struct cmd_callback *cb, const char *cmd, const char *param, int s)
+static int
+container_to_cbor(const struct rte_tel_data *d, uint8_t *buf, int len, int used)
+{
+	const int start = used;
+	unsigned int i;
+	int prev, vstart;
+
+	if (d->type == TEL_STRING)
+		return rte_tel_cbor_str(buf, len, used, d->data.str);
+	if (d->type == TEL_NULL)
+		return rte_tel_cbor_null(buf, len, used);
+
+	/* reserve the byte closing the array or map */
+	len--;
+	if (d->type == TEL_DICT)
+		used = rte_tel_cbor_start_map(buf, len, used);
+	else
+		used = rte_tel_cbor_start_array(buf, len, used);
+	if (used == start)
+		len = start; /* nothing fits, the containers are only freed */
+
+	/* values which don't fit are dropped, containers are still freed */
+	for (i = 0; i < d->data_len; i++) {
+		const union tel_value *v;
+		enum rte_tel_value_type type;
+
+		prev = used;
+		if (d->type == TEL_DICT) {
+			const struct tel_dict_entry *e = &d->data.dict[i];
+
+			used = rte_tel_cbor_str(buf, len, used, e->name);
+			v = &e->value;
+			type = e->type;
+		} else {
+			v = &d->data.array[i];
+			type = d->type == TEL_ARRAY_STRING ? RTE_TEL_STRING_VAL :
+				d->type == TEL_ARRAY_INT ? RTE_TEL_INT_VAL :
+				d->type == TEL_ARRAY_UINT ? RTE_TEL_UINT_VAL :
+				RTE_TEL_CONTAINER;
+		}
+
+		vstart = used;
+		switch (type) {
+		case RTE_TEL_STRING_VAL:
+			used = rte_tel_cbor_str(buf, len, used, v->sval);
+			break;
+		case RTE_TEL_INT_VAL:
+			used = rte_tel_cbor_int(buf, len, used, v->ival);
+			break;
+		case RTE_TEL_UINT_VAL:
+			used = rte_tel_cbor_uint(buf, len, used, v->uval);
+			break;
+		case RTE_TEL_CONTAINER:
+			used = container_to_cbor(v->container.data, buf, len, used);
+			if (!v->container.keep)
+				rte_tel_data_free(v->container.data);
+			break;
+		}
+
+		/* either the name or the value of the entry did not fit */
+		if (used == vstart || (d->type == TEL_DICT && vstart == prev))
+			used = prev;
+	}
+
+	return used == start ? start : rte_tel_cbor_end(buf, used);
+}
+
+static int
+output_cbor(const char *cmd, const struct rte_tel_data *d, uint8_t *out_buf)
+{
+	char name[MAX_CMD_LEN];
+	int prefix_used, used;
+
+	/* map of a single entry, named after the command */
+	strlcpy(name, cmd, sizeof(name));
+	out_buf[0] = (CBOR_MAJOR_MAP << 5) | 1;
+	prefix_used = rte_tel_cbor_str(out_buf, MAX_OUTPUT_LEN, 1, name);
+
+	/* space for a null value, if the data does not fit */
+	used = container_to_cbor(d, out_buf, MAX_OUTPUT_LEN - 1, prefix_used);
+	if (used == prefix_used)
+		used = rte_tel_cbor_null(out_buf, MAX_OUTPUT_LEN, used);
+	return used;
+}
+
+static int
+output_reply(const char *cmd, const struct rte_tel_data *d,
+		enum tel_encoding enc, char *out_buf)
+{
+	if (enc == TEL_ENC_CBOR)
+		return output_cbor(cmd, d, (uint8_t *)out_buf);
+	return output_json(cmd, d, out_buf);
+}
+
+static int
+perform_command(const struct cmd_callback *cb, const char *cmd, const char *param,
+		enum tel_encoding enc, char *out_buf)
 {
 	struct rte_tel_data data = {0};
 	int ret;
@@ -379,15 +485,9 @@ perform_command(const struct cmd_callback *cb, const char *cmd, const char *para
 	else
 		ret = cb->fn(cmd, param, &data);
 
-	if (ret < 0) {
-		char out_buf[MAX_CMD_LEN + 10];
-		int used = snprintf(out_buf, sizeof(out_buf), "{\"%.*s\":null}",
-				MAX_CMD_LEN, cmd ? cmd : "none");
-		if (write(s, out_buf, used) < 0)
-			TMTY_LOG_LINE(ERR, "Error writing to socket: %s", strerror(errno));
-		return;
-	}
-	output_json(cmd, &data, s);
+	if (ret < 0)
+		data.type = TEL_NULL;
+	return output_reply(cmd ? cmd : "none", &data, enc, out_buf);
 }
 
 static int
@@ -397,11 +497,98 @@ unknown_command(const char *cmd __rte_unused, const char *params __rte_unused,
 	return d->type = TEL_NULL;
 }
 
+/* commands handled by the client handler, as they depend on the connection */
+static int
+connection_command(const char *cmd __rte_unused, const char *params __rte_unused,
+		struct rte_tel_data *d __rte_unused)
+{
+	return -1;
+}
+
+static void
+find_command(const char *cmd, struct cmd_callback *cb)
+{
+	int i;
+
+	if (cmd == NULL || strlen(cmd) >= MAX_CMD_LEN)
+		return;
+
+	rte_spinlock_lock(&callback_sl);
+	for (i = 0; i < num_callbacks; i++)
+		if (strcmp(cmd, callbacks[i].cmd) == 0) {
+			*cb = callbacks[i];
+			break;
+		}
+	rte_spinlock_unlock(&callback_sl);
+}
+
+static int
+perform_encoding(const char *param, enum tel_encoding *enc, char *out_buf)
+{
+	struct rte_tel_data data = {0};
+	unsigned int i;
+
+	/* without parameter, the current encoding is returned */
+	if (param != NULL) {
+		for (i = 0; i < RTE_DIM(tel_encoding_names); i++)
+			if (strcmp(param, tel_encoding_names[i]) == 0)
+				break;
+		if (i == RTE_DIM(tel_encoding_names))
+			return output_reply("/encoding", &data, *enc, out_buf);
+		*enc = i;
+	}
+
+	/* the reply is in the new encoding */
+	rte_tel_data_string(&data, tel_encoding_names[*enc]);
+	return output_reply("/encoding", &data, *enc, out_buf);
+}
+
+static int
+perform_batch(char *cmds, enum tel_encoding enc, char *out_buf, char *batch_buf)
+{
+	char *cmd, *param, *sp = NULL;
+	int len, used = 1;
+
+	/* the replies are returned as an array, in the order of the commands */
+	batch_buf[0] = enc == TEL_ENC_CBOR ?
+		(CBOR_MAJOR_ARRAY << 5) | CBOR_INDEFINITE : '[';
+
+	cmd = cmds == NULL ? NULL : strtok_r(cmds, ";", &sp);
+	for (; cmd != NULL; cmd = strtok_r(NULL, ";", &sp)) {
+		struct cmd_callback cb = {.fn = unknown_command};
+
+		param = strchr(cmd, ',');
+		if (param != NULL) {
+			*param++ = '\0';
+			if (*param == '\0')
+				param = NULL;
+		}
+
+		/* nested batches or encoding changes get a null reply */
+		find_command(cmd, &cb);
+		len = perform_command(&cb, cmd, param, enc, out_buf);
+
+		/* stop at the first reply not fitting, the client can resend the rest */
+		if (used + len + 2 > MAX_BATCH_OUTPUT_LEN)
+			break;
+		if (enc == TEL_ENC_JSON && used > 1)
+			batch_buf[used++] = ',';
+		memcpy(batch_buf + used, out_buf, len);
+		used += len;
+	}
+
+	batch_buf[used++] = enc == TEL_ENC_CBOR ? CBOR_BREAK : ']';
+	return used;
+}
+
 static void *
 client_handler(void *sock_id)
 {
 	int s = (int)(uintptr_t)sock_id;
-	char buffer[1024];
+	enum tel_encoding enc = TEL_ENC_JSON;
+	char out_buf[MAX_OUTPUT_LEN];
+	char buffer[MAX_INPUT_LEN];
+	char *batch_buf = NULL;
 	char info_str[1024];
 	snprintf(info_str, sizeof(info_str),
 			"{\"version\":\"%s\",\"pid\":%d,\"max_output_len\":%d}",
@@ -416,24 +603,29 @@ client_handler(void *sock_id)
 	while (bytes > 0) {
 		buffer[bytes] = 0;
 		const char *cmd = strtok(buffer, ",");
-		const char *param = strtok(NULL, "\0");
+		char *param = strtok(NULL, "\0");
 		struct cmd_callback cb = {.fn = unknown_command};
-		int i;
-
-		if (cmd && strlen(cmd) < MAX_CMD_LEN) {
-			rte_spinlock_lock(&callback_sl);
-			for (i = 0; i < num_callbacks; i++)
-				if (strcmp(cmd, callbacks[i].cmd) == 0) {
-					cb = callbacks[i];
-					break;
-				}
-			rte_spinlock_unlock(&callback_sl);
+		const char *reply = out_buf;
+		int used;
+
+		find_command(cmd, &cb);
+		if (cb.fn == connection_command && strcmp(cmd, "/encoding") == 0) {
+			used = perform_encoding(param, &enc, out_buf);
+		} else if (cb.fn == connection_command && strcmp(cmd, "/batch") == 0 &&
+				(batch_buf != NULL ||
+				(batch_buf = malloc(MAX_BATCH_OUTPUT_LEN)) != NULL)) {
+			used = perform_batch(param, enc, out_buf, batch_buf);
+			reply = batch_buf;
+		} else {
+			used = perform_command(&cb, cmd, param, enc, out_buf);
 		}
-		perform_command(&cb, cmd, param, s);
+		if (write(s, reply, used) < 0)
+			TMTY_LOG_LINE(ERR, "Error writing to socket: %s", strerror(errno));
 
 		bytes = read(s, buffer, sizeof(buffer) - 1);
 	}
 exit:
+	free(batch_buf);
 	close(s);
 	rte_atomic_fetch_sub_explicit(&v2_clients, 1, rte_memory_order_relaxed);
 	return NULL;
@@ -613,6 +805,10 @@ telemetry_v2_init(void)
 			"Returns DPDK Telemetry information. Takes no parameters");
 	rte_telemetry_register_cmd("/help", command_help,
 			"Returns help text for a command. Parameters: string command");
+	rte_telemetry_register_cmd("/batch", connection_command,
+			"Returns the replies of several commands. Parameters: commands separated by ';'");
+	rte_telemetry_register_cmd("/encoding", connection_command,
+			"Returns or sets the encoding of the replies. Parameters: string json or cbor");
 	v2_socket.fn = client_handler;
 	if (strlcpy(spath, get_socket_path(socket_dir, 2), sizeof(spath)) >= sizeof(spath)) {
 		TMTY_LOG_LINE(ERR, "Error with socket binding, path too long");
@@ -0,0 +1,144 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_TELEMETRY_CBOR_H_
+#define _RTE_TELEMETRY_CBOR_H_
+
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @file
+ * Internal Telemetry Utility functions
+ *
+ * This file contains small inline functions to build up CBOR (RFC 8949)
+ * responses to telemetry requests, a compact binary alternative to JSON.
+ *
+ * As with the JSON functions, nothing is written to the buffer if a value
+ * does not fit, and the number of bytes used is returned unchanged.
+ * Arrays and maps use indefinite lengths, so that values not fitting
+ * can be dropped, the caller reserving one byte to close each of them.
+ */
+
+#define CBOR_MAJOR_UINT		0
+#define CBOR_MAJOR_NEGINT	1
+#define CBOR_MAJOR_TEXT		3
+#define CBOR_MAJOR_ARRAY	4
+#define CBOR_MAJOR_MAP		5
+#define CBOR_MAJOR_SIMPLE	7
+
+#define CBOR_INDEFINITE		31
+#define CBOR_NULL		0xf6
+#define CBOR_BREAK		0xff
+
+/* Returns the size of the head of a data item with the given argument. */
+static inline int
+__cbor_head_len(uint64_t val)
+{
+	if (val < 24)
+		return 1;
+	if (val <= UINT8_MAX)
+		return 2;
+	if (val <= UINT16_MAX)
+		return 3;
+	if (val <= UINT32_MAX)
+		return 5;
+	return 9;
+}
+
+/* Writes the head of a data item, the caller checks there is room for it. */
+static inline int
+__cbor_head(uint8_t *buf, uint8_t major, uint64_t val)
+{
+	int i, n = __cbor_head_len(val);
+
+	if (n == 1) {
+		buf[0] = (major << 5) | val;
+		return 1;
+	}
+
+	/* additional info 24 to 27 for 1, 2, 4 and 8 bytes arguments */
+	buf[0] = (major << 5) | (n == 2 ? 24 : n == 3 ? 25 : n == 5 ? 26 : 27);
+	for (i = n - 1; i > 0; i--) {
+		buf[i] = val & 0xff;
+		val >>= 8;
+	}
+	return n;
+}
+
+/* Copies a null value into the provided buffer. */
+static inline int
+rte_tel_cbor_null(uint8_t *buf, const int len, const int used)
+{
+	if (used + 1 > len)
+		return used;
+	buf[used] = CBOR_NULL;
+	return used + 1;
+}
+
+/* Copies an unsigned integer into the provided buffer. */
+static inline int
+rte_tel_cbor_uint(uint8_t *buf, const int len, const int used, uint64_t val)
+{
+	if (used + __cbor_head_len(val) > len)
+		return used;
+	return used + __cbor_head(buf + used, CBOR_MAJOR_UINT, val);
+}
+
+/* Copies a signed integer into the provided buffer. */
+static inline int
+rte_tel_cbor_int(uint8_t *buf, const int len, const int used, int64_t val)
+{
+	/* negative integers are encoded as -1 - val */
+	uint64_t arg = val < 0 ? ~(uint64_t)val : (uint64_t)val;
+	uint8_t major = val < 0 ? CBOR_MAJOR_NEGINT : CBOR_MAJOR_UINT;
+
+	if (used + __cbor_head_len(arg) > len)
+		return used;
+	return used + __cbor_head(buf + used, major, arg);
+}
+
+/* Copies a string into the provided buffer, as a CBOR text string. */
+static inline int
+rte_tel_cbor_str(uint8_t *buf, const int len, const int used, const char *str)
+{
+	size_t slen = strlen(str);
+	int n;
+
+	if (used + __cbor_head_len(slen) + slen > (size_t)len)
+		return used;
+	n = __cbor_head(buf + used, CBOR_MAJOR_TEXT, slen);
+	memcpy(buf + used + n, str, slen);
+	return used + n + slen;
+}
+
+/* Starts an indefinite length array in the provided buffer. */
+static inline int
+rte_tel_cbor_start_array(uint8_t *buf, const int len, const int used)
+{
+	if (used + 1 > len)
+		return used;
+	buf[used] = (CBOR_MAJOR_ARRAY << 5) | CBOR_INDEFINITE;
+	return used + 1;
+}
+
+/* Starts an indefinite length map in the provided buffer. */
+static inline int
+rte_tel_cbor_start_map(uint8_t *buf, const int len, const int used)
+{
+	if (used + 1 > len)
+		return used;
+	buf[used] = (CBOR_MAJOR_MAP << 5) | CBOR_INDEFINITE;
+	return used + 1;
+}
+
+/* Closes an indefinite length array or map, the byte is always reserved. */
+static inline int
+rte_tel_cbor_end(uint8_t *buf, const int used)
+{
+	buf[used] = CBOR_BREAK;
+	return used + 1;
+}
+
+#endif /*_RTE_TELEMETRY_CBOR_H_*/
@@ -0,0 +1,321 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#include <errno.h>
+#include <stdint.h>
+
+#include <eal_export.h>
+#include <rte_bitops.h>
+#include <rte_common.h>
+#include <rte_cycles.h>
+#include <rte_errno.h>
+#include <rte_lcore.h>
+#include <rte_malloc.h>
+#include <rte_reciprocal.h>
+
+#include "rte_timer_wheel.h"
+
+/*
+ * A timer expiring in d ticks is queued in the level l for which
+ * 2^(WHEEL_LEVEL_BITS * l) <= d < 2^(WHEEL_LEVEL_BITS * (l + 1)),
+ * and the slots of the upper levels are cascaded to the lower levels
+ * as the wheel turns.
+ */
+#define WHEEL_LEVEL_BITS 6
+#define WHEEL_LEVEL_SLOTS (1 << WHEEL_LEVEL_BITS)
+#define WHEEL_LEVEL_MASK (WHEEL_LEVEL_SLOTS - 1)
+#define WHEEL_LEVELS 6
+/* The timers further away are queued at this distance, and cascaded again */
+#define WHEEL_MAX_DELTA ((UINT64_C(1) << (WHEEL_LEVEL_BITS * WHEEL_LEVELS)) - 1)
+
+#define TIMER_STOPPED   0
+#define TIMER_PENDING   1
+#define TIMER_REQUESTED 2 /* being armed, or in the requests of an lcore */
+
+/* Timer wheel of an lcore, only accessed by this lcore, except requests. */
+struct __rte_cache_aligned wheel {
+	/* Timers armed from other lcores */
+	RTE_ATOMIC(struct rte_timer_wheel_timer *) requests;
+	alignas(RTE_CACHE_LINE_SIZE) uint64_t cur; /* last tick processed */
+	uint32_t nb_timers;
+	struct rte_timer_wheel_timer *slots[WHEEL_LEVELS][WHEEL_LEVEL_SLOTS];
+};
+
+struct rte_timer_wheel {
+	uint64_t start_cycles;
+	uint64_t tick_cycles;
+	struct rte_reciprocal_u64 tick_cycles_inverse;
+	rte_timer_wheel_expire_cb_t expire_cb;
+	void *expire_cb_arg;
+	struct wheel wheels[RTE_MAX_LCORE];
+};
+
+static inline uint64_t
+timer_wheel_now(const struct rte_timer_wheel *tw)
+{
+	return rte_reciprocal_divide_u64(rte_get_timer_cycles() -
+			tw->start_cycles, &tw->tick_cycles_inverse);
+}
+
+static inline void
+wheel_list_add(struct rte_timer_wheel_timer **head,
+	       struct rte_timer_wheel_timer *tim)
+{
+	tim->next = *head;
+	if (tim->next != NULL)
+		tim->next->pprev = &tim->next;
+	*head = tim;
+	tim->pprev = head;
+}
+
+static inline void
+wheel_list_del(struct rte_timer_wheel_timer *tim)
+{
+	*tim->pprev = tim->next;
+	if (tim->next != NULL)
+		tim->next->pprev = tim->pprev;
+}
+
+static inline void
+wheel_add(struct wheel *w, struct rte_timer_wheel_timer *tim)
+{
+	uint64_t delta;
+	unsigned int level = 0;
+
+	if (tim->expire <= w->cur)
+		tim->expire = w->cur + 1;
+	delta = RTE_MIN(tim->expire - w->cur, WHEEL_MAX_DELTA);
+	if (delta >= WHEEL_LEVEL_SLOTS)
+		level = (rte_fls_u64(delta) - 1) / WHEEL_LEVEL_BITS;
+
+	wheel_list_add(&w->slots[level][((w->cur + delta) >>
+			(level * WHEEL_LEVEL_BITS)) & WHEEL_LEVEL_MASK], tim);
+}
+
+/* Apply the timers armed from other lcores. */
+static void
+wheel_requests_apply(struct wheel *w)
+{
+	struct rte_timer_wheel_timer *tim, *next;
+
+	tim = rte_atomic_exchange_explicit(&w->requests, NULL,
+					   rte_memory_order_acquire);
+	for (; tim != NULL; tim = next) {
+		next = tim->next;
+		wheel_add(w, tim);
+		w->nb_timers++;
+		rte_atomic_store_explicit(&tim->state, TIMER_PENDING,
+					  rte_memory_order_release);
+	}
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_wheel_create, 26.03)
+struct rte_timer_wheel *
+rte_timer_wheel_create(const struct rte_timer_wheel_params *params)
+{
+	struct rte_timer_wheel *tw;
+
+	if (params == NULL || params->tick_ns == 0 || params->expire_cb == NULL) {
+		rte_errno = EINVAL;
+		return NULL;
+	}
+
+	tw = rte_zmalloc_socket(params->name, sizeof(*tw), RTE_CACHE_LINE_SIZE,
+				params->socket_id);
+	if (tw == NULL) {
+		rte_errno = ENOMEM;
+		return NULL;
+	}
+
+	tw->tick_cycles = RTE_MAX((uint64_t)((double)params->tick_ns *
+			rte_get_timer_hz() / NS_PER_S), UINT64_C(1));
+	tw->tick_cycles_inverse = rte_reciprocal_value_u64(tw->tick_cycles);
+	tw->expire_cb = params->expire_cb;
+	tw->expire_cb_arg = params->expire_cb_arg;
+	tw->start_cycles = rte_get_timer_cycles();
+
+	return tw;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_wheel_free, 26.03)
+void
+rte_timer_wheel_free(struct rte_timer_wheel *tw)
+{
+	rte_free(tw);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_wheel_timer_init, 26.03)
+void
+rte_timer_wheel_timer_init(struct rte_timer_wheel_timer *tim, void *arg)
+{
+	tim->next = NULL;
+	tim->pprev = NULL;
+	tim->expire = 0;
+	tim->period = 0;
+	tim->lcore_id = 0;
+	tim->arg = arg;
+	rte_atomic_store_explicit(&tim->state, TIMER_STOPPED,
+				  rte_memory_order_relaxed);
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_wheel_arm, 26.03)
+int
+rte_timer_wheel_arm(struct rte_timer_wheel *tw, struct rte_timer_wheel_timer *tim,
+		uint64_t ticks, enum rte_timer_type type, unsigned int lcore_id)
+{
+	unsigned int self = rte_lcore_id();
+	uint16_t state = TIMER_STOPPED;
+	struct rte_timer_wheel_timer *head;
+	struct wheel *w;
+	uint64_t now;
+
+	if (lcore_id == LCORE_ID_ANY)
+		lcore_id = self;
+	if (lcore_id >= RTE_MAX_LCORE || (type == PERIODICAL && ticks == 0))
+		return -EINVAL;
+
+	w = &tw->wheels[lcore_id];
+	now = timer_wheel_now(tw);
+
+	if (!rte_atomic_compare_exchange_strong_explicit(&tim->state, &state,
+			TIMER_REQUESTED, rte_memory_order_acquire,
+			rte_memory_order_acquire)) {
+		/* Only the lcore of a pending timer can restart it */
+		if (state != TIMER_PENDING || tim->lcore_id != self ||
+				lcore_id != self)
+			return -EBUSY;
+		wheel_list_del(tim);
+		w->nb_timers--;
+	}
+
+	/* Round up to the next tick, not to expire early */
+	tim->expire = now + ticks + 1;
+	tim->period = type == PERIODICAL ? ticks : 0;
+	tim->lcore_id = lcore_id;
+
+	if (lcore_id != self) {
+		head = rte_atomic_load_explicit(&w->requests,
+						rte_memory_order_relaxed);
+		do {
+			tim->next = head;
+		} while (!rte_atomic_compare_exchange_weak_explicit(&w->requests,
+				&head, tim, rte_memory_order_release,
+				rte_memory_order_relaxed));
+		return 0;
+	}
+
+	/* The wheel is not turned while empty, catch up */
+	if (w->nb_timers == 0)
+		w->cur = RTE_MAX(w->cur, now);
+	wheel_add(w, tim);
+	w->nb_timers++;
+	rte_atomic_store_explicit(&tim->state, TIMER_PENDING,
+				  rte_memory_order_release);
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_wheel_stop, 26.03)
+int
+rte_timer_wheel_stop(struct rte_timer_wheel *tw, struct rte_timer_wheel_timer *tim)
+{
+	uint16_t state;
+
+	state = rte_atomic_load_explicit(&tim->state, rte_memory_order_acquire);
+	if (state == TIMER_STOPPED)
+		return 0;
+	if (state != TIMER_PENDING || tim->lcore_id != rte_lcore_id())
+		return -EBUSY;
+
+	wheel_list_del(tim);
+	tw->wheels[tim->lcore_id].nb_timers--;
+	rte_atomic_store_explicit(&tim->state, TIMER_STOPPED,
+				  rte_memory_order_release);
+
+	return 0;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_wheel_pending, 26.03)
+int
+rte_timer_wheel_pending(const struct rte_timer_wheel_timer *tim)
+{
+	return rte_atomic_load_explicit(&tim->state,
+					rte_memory_order_relaxed) != TIMER_STOPPED;
+}
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_timer_wheel_manage, 26.03)
+int
+rte_timer_wheel_manage(struct rte_timer_wheel *tw)
+{
+	struct rte_timer_wheel_timer *burst[RTE_TIMER_WHEEL_BURST_MAX];
+	struct rte_timer_wheel_timer *expired, *tim, **slot;
+	unsigned int lcore_id = rte_lcore_id();
+	unsigned int n = 0;
+	int nb_expired = 0;
+	struct wheel *w;
+	uint64_t now;
+	int level;
+
+	if (lcore_id >= RTE_MAX_LCORE)
+		return -EINVAL;
+
+	w = &tw->wheels[lcore_id];
+	now = timer_wheel_now(tw);
+
+	/* The wheel is not turned while empty, catch up */
+	if (w->nb_timers == 0)
+		w->cur = RTE_MAX(w->cur, now);
+	if (rte_atomic_load_explicit(&w->requests, rte_memory_order_relaxed) != NULL)
+		wheel_requests_apply(w);
+
+	while (w->cur < now && w->nb_timers != 0) {
+		w->cur++;
+
+		for (level = WHEEL_LEVELS - 1; level > 0; level--) {
+			if (w->cur & ((UINT64_C(1) << (level * WHEEL_LEVEL_BITS)) - 1))
+				continue;
+			slot = &w->slots[level][(w->cur >>
+					(level * WHEEL_LEVEL_BITS)) & WHEEL_LEVEL_MASK];
+			while ((tim = *slot) != NULL) {
+				wheel_list_del(tim);
+				wheel_add(w, tim);
+			}
+		}
+
+		/*
+		 * Detach the expired timers, the callback can still stop
+		 * the ones not passed to it yet.
+		 */
+		slot = &w->slots[0][w->cur & WHEEL_LEVEL_MASK];
+		expired = *slot;
+		if (expired == NULL)
+			continue;
+		*slot = NULL;
+		expired->pprev = &expired;
+
+		while ((tim = expired) != NULL) {
+			wheel_list_del(tim);
+			if (tim->period != 0) {
+				tim->expire += tim->period;
+				wheel_add(w, tim);
+			} else {
+				w->nb_timers--;
+				rte_atomic_store_explicit(&tim->state, TIMER_STOPPED,
+							  rte_memory_order_release);
+			}
+			burst[n++] = tim;
+			nb_expired++;
+			if (n == RTE_TIMER_WHEEL_BURST_MAX) {
+				tw->expire_cb(burst, n, tw->expire_cb_arg);
+				n = 0;
+			}
+		}
+	}
+	if (n != 0)
+		tw->expire_cb(burst, n, tw->expire_cb_arg);
+	if (w->nb_timers == 0)
+		w->cur = RTE_MAX(w->cur, now);
+
+	return nb_expired;
+}
@@ -0,0 +1,212 @@
+/* SPDX-License-Identifier: BSD-3-Clause
+ * Copyright(c) 2026 Intel Corporation
+ */
+
+#ifndef _RTE_TIMER_WHEEL_H_
+#define _RTE_TIMER_WHEEL_H_
+
+/**
+ * @file
+ * RTE Timer Wheel
+ *
+ * Coarse timers, expiring on a tick of a fixed granularity, for applications
+ * handling millions of timers such as connection timeouts.
+ *
+ * - Each lcore has its own hierarchical timing wheel: arming, stopping and
+ *   expiring a timer are O(1), without lock.
+ * - A timer can be armed from one lcore to expire on another: the request is
+ *   pushed to a lock-free multi-producer single-consumer list of the target
+ *   lcore, and applied by its next call to rte_timer_wheel_manage().
+ * - The expired timers are passed in bursts to a single callback per wheel.
+ * - A timer expires on the first tick after its timeout, so up to a tick
+ *   late, but never early.
+ *
+ * The rte_timer API remains the one for precise timers.
+ */
+
+#include <stdint.h>
+
+#include <rte_common.h>
+#include <rte_compat.h>
+#include <rte_timer.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of timers passed at once to the expiry callback. */
+#define RTE_TIMER_WHEEL_BURST_MAX 32
+
+/**
+ * A timer of a timer wheel, to be embedded in the application objects.
+ * The fields are private, except arg.
+ */
+struct rte_timer_wheel_timer {
+	struct rte_timer_wheel_timer *next; /**< Next timer in the list. */
+	struct rte_timer_wheel_timer **pprev; /**< Previous next pointer. */
+	uint64_t expire;   /**< Expiry tick. */
+	uint64_t period;   /**< Period in ticks, 0 if single. */
+	RTE_ATOMIC(uint16_t) state; /**< Stopped, pending or requested. */
+	uint16_t lcore_id; /**< The lcore the timer is armed on. */
+	void *arg;         /**< Argument of the application. */
+};
+
+/** Handle of a set of per-lcore timer wheels. */
+struct rte_timer_wheel;
+
+/**
+ * Callback of the expired timers.
+ *
+ * It is called by rte_timer_wheel_manage() on the lcore of the timers.
+ * The single timers are stopped before the call, and can be armed again.
+ * The periodic timers are armed again before the call, and can be stopped.
+ *
+ * @param timers
+ *   The expired timers.
+ * @param nb_timers
+ *   The number of expired timers, up to RTE_TIMER_WHEEL_BURST_MAX.
+ * @param arg
+ *   The argument given at the creation of the timer wheel.
+ */
+typedef void (*rte_timer_wheel_expire_cb_t)(struct rte_timer_wheel_timer **timers,
+		unsigned int nb_timers, void *arg);
+
+/**
+ * Timer wheel parameters.
+ */
+struct rte_timer_wheel_params {
+	const char *name;        /**< Name of the timer wheel. */
+	int socket_id;           /**< Socket of the timer wheel memory. */
+	uint64_t tick_ns;        /**< Granularity of the timers in ns. */
+	rte_timer_wheel_expire_cb_t expire_cb; /**< Expiry callback. */
+	void *expire_cb_arg;     /**< Argument of the expiry callback. */
+};
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Create a set of timer wheels, one per lcore.
+ *
+ * @param params
+ *   The timer wheel parameters.
+ * @return
+ *   The timer wheel, or NULL on error with rte_errno set.
+ */
+__rte_experimental
+struct rte_timer_wheel *
+rte_timer_wheel_create(const struct rte_timer_wheel_params *params);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Free a set of timer wheels. The pending timers are not expired.
+ *
+ * @param tw
+ *   The timer wheel, can be NULL.
+ */
+__rte_experimental
+void
+rte_timer_wheel_free(struct rte_timer_wheel *tw);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Initialize a timer before its first use.
+ *
+ * @param tim
+ *   The timer.
+ * @param arg
+ *   The argument of the application, stored in the timer.
+ */
+__rte_experimental
+void
+rte_timer_wheel_timer_init(struct rte_timer_wheel_timer *tim, void *arg);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Arm a timer.
+ *
+ * The timer must be stopped, or pending on the calling lcore, in which
+ * case it is restarted. When armed for another lcore, the timer is
+ * pending only after the next rte_timer_wheel_manage() call on that lcore.
+ *
+ * @param tw
+ *   The timer wheel.
+ * @param tim
+ *   The timer.
+ * @param ticks
+ *   The number of ticks before the expiry, and the period of a periodic timer.
+ * @param type
+ *   The type of timer, single or periodic.
+ * @param lcore_id
+ *   The lcore the timer expires on, LCORE_ID_ANY for the calling lcore.
+ * @return
+ *   - 0 on success.
+ *   - -EINVAL if the lcore or the ticks are invalid.
+ *   - -EBUSY if the timer is pending on another lcore, or being armed.
+ */
+__rte_experimental
+int
+rte_timer_wheel_arm(struct rte_timer_wheel *tw, struct rte_timer_wheel_timer *tim,
+		uint64_t ticks, enum rte_timer_type type, unsigned int lcore_id);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Stop a timer.
+ *
+ * @param tw
+ *   The timer wheel.
+ * @param tim
+ *   The timer.
+ * @return
+ *   - 0 on success, or if the timer was already stopped.
+ *   - -EBUSY if the timer is pending on another lcore, or being armed.
+ */
+__rte_experimental
+int
+rte_timer_wheel_stop(struct rte_timer_wheel *tw, struct rte_timer_wheel_timer *tim);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Check if a timer is pending, or being armed.
+ *
+ * @param tim
+ *   The timer.
+ * @return
+ *   1 if the timer is pending or being armed, 0 otherwise.
+ */
+__rte_experimental
+int
+rte_timer_wheel_pending(const struct rte_timer_wheel_timer *tim);
+
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change without prior notice.
+ *
+ * Manage the timer wheel of the calling lcore: apply the timers armed from
+ * other lcores, then turn the wheel up to the current tick and pass the
+ * expired timers to the expiry callback.
+ *
+ * @param tw
+ *   The timer wheel.
+ * @return
+ *   The number of expired timers, or -EINVAL if called from a non-EAL thread.
+ */
+__rte_experimental
+int
+rte_timer_wheel_manage(struct rte_timer_wheel *tw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _RTE_TIMER_WHEEL_H_ */
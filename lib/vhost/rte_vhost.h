@@ -775,6 +775,30 @@ uint16_t rte_vhost_enqueue_burst(int vid, uint16_t queue_id,
 uint16_t rte_vhost_dequeue_burst(int vid, uint16_t queue_id,
 	struct rte_mempool *mbuf_pool, struct rte_mbuf **pkts, uint16_t count);
 
+/**
+ * @warning
+ * @b EXPERIMENTAL: this API may change, or be removed, without prior notice.
+ *
+ * Register the mempool used to allocate the dequeued mbufs of the
+ * virtqueues located on a NUMA node, instead of the mempool given to
+ * rte_vhost_dequeue_burst() or rte_vhost_async_try_dequeue_burst().
+ *
+ * A virtqueue is located on the NUMA node of its guest memory, so the
+ * copies from the guest buffers to the mbufs stay on the same node.
+ *
+ * The mempool must not be freed while it may be used by a dequeue,
+ * and the registration should be done before starting to dequeue.
+ *
+ * @param socket_id
+ *  NUMA node
+ * @param mp
+ *  mempool to use for this node, or NULL to use the caller's mempool
+ * @return
+ *  0 on success, -1 on invalid socket_id
+ */
+__rte_experimental
+int rte_vhost_dequeue_mempool_register(int socket_id, struct rte_mempool *mp);
+
 /**
  * Get guest mem table: a list of memory regions.
  *
@@ -57,6 +57,10 @@ static const struct vhost_vq_stats_name_off vhost_vq_stat_strings[] = {
 	{"inflight_submitted",     offsetof(struct vhost_virtqueue, stats.inflight_submitted)},
 	{"inflight_completed",     offsetof(struct vhost_virtqueue, stats.inflight_completed)},
 	{"mbuf_alloc_failed",      offsetof(struct vhost_virtqueue, stats.mbuf_alloc_failed)},
+	{"async_dma_packets",      offsetof(struct vhost_virtqueue, stats.async_dma_packets)},
+	{"async_cpu_packets",      offsetof(struct vhost_virtqueue, stats.async_cpu_packets)},
+	{"async_dma_full",         offsetof(struct vhost_virtqueue, stats.async_dma_full)},
+	{"async_dma_latency_cycles", offsetof(struct vhost_virtqueue, stats.async_dma_latency)},
 };
 
 #define VHOST_NB_VQ_STATS RTE_DIM(vhost_vq_stat_strings)
@@ -865,6 +869,21 @@ rte_vhost_get_mtu(int vid, uint16_t *mtu)
 	return 0;
 }
 
+RTE_ATOMIC(struct rte_mempool *) vhost_dequeue_mempools[RTE_MAX_NUMA_NODES];
+
+RTE_EXPORT_EXPERIMENTAL_SYMBOL(rte_vhost_dequeue_mempool_register, 26.03)
+int
+rte_vhost_dequeue_mempool_register(int socket_id, struct rte_mempool *mp)
+{
+	if (socket_id < 0 || socket_id >= RTE_MAX_NUMA_NODES)
+		return -1;
+
+	rte_atomic_store_explicit(&vhost_dequeue_mempools[socket_id], mp,
+			rte_memory_order_release);
+
+	return 0;
+}
+
 RTE_EXPORT_SYMBOL(rte_vhost_get_numa_node)
 int
 rte_vhost_get_numa_node(int vid)
@@ -1847,6 +1866,9 @@ async_channel_register(struct virtio_net *dev, struct vhost_virtqueue *vq)
 		}
 	}
 
+	/* The CPU copies use the DMA addresses, which must be virtual. */
+	async->cpu_copy = rte_eal_iova_mode() == RTE_IOVA_VA;
+
 	vq->async = async;
 
 	return 0;
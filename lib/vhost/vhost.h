@@ -149,6 +149,10 @@ struct virtqueue_stats {
 	uint64_t inflight_completed;
 	uint64_t mbuf_alloc_failed;
 	uint64_t guest_notifications_suppressed;
+	uint64_t async_dma_packets;
+	uint64_t async_cpu_packets;
+	uint64_t async_dma_full;
+	uint64_t async_dma_latency; /* moving average, in TSC cycles */
 	/* Counters below are atomic, and should be incremented as such. */
 	RTE_ATOMIC(uint64_t) guest_notifications;
 	RTE_ATOMIC(uint64_t) guest_notifications_offloaded;
@@ -207,6 +211,9 @@ struct async_dma_info {
 
 extern struct async_dma_info dma_copy_track[RTE_DMADEV_DEFAULT_MAX];
 
+/* Dequeue mempools per NUMA node, see rte_vhost_dequeue_mempool_register(). */
+extern RTE_ATOMIC(struct rte_mempool *) vhost_dequeue_mempools[RTE_MAX_NUMA_NODES];
+
 /**
  * inflight async packet information
  */
@@ -215,6 +222,7 @@ struct async_inflight_info {
 	uint16_t descs; /* num of descs inflight */
 	uint16_t nr_buffers; /* num of buffers inflight for packed ring */
 	struct virtio_net_hdr nethdr;
+	uint64_t dma_tsc; /* DMA submission time, 0 if copied by CPU */
 };
 
 struct vhost_async {
@@ -258,6 +266,16 @@ struct vhost_async {
 		uint16_t last_desc_idx_split;
 		uint16_t last_buffer_idx_packed;
 	};
+
+	/*
+	 * Adaptive copy policy: small packets are copied by the CPU
+	 * when the DMA completion latency exceeds the CPU copy cost.
+	 * Only possible when IOVAs are virtual addresses.
+	 */
+	bool cpu_copy;
+	uint16_t dma_probe_cnt;
+	uint64_t dma_lat_cycles; /* moving average of DMA completion latency */
+	uint64_t cpu_cycles_per_kb; /* moving average of CPU copy cost */
 };
 
 #define VHOST_RECONNECT_VERSION		0x0
@@ -7,6 +7,7 @@
 #include <linux/virtio_net.h>
 
 #include <eal_export.h>
+#include <rte_cycles.h>
 #include <rte_mbuf.h>
 #include <rte_memcpy.h>
 #include <rte_net.h>
@@ -27,6 +28,13 @@
 
 #define MAX_BATCH_LEN 256
 
+/* Largest packet the async data path may copy with the CPU. */
+#define VHOST_ASYNC_CPU_COPY_MAX_LEN 1024
+/* One small packet in this many still goes to DMA, to refresh its latency. */
+#define VHOST_ASYNC_DMA_PROBE_INTERVAL 32
+/* Weight of a new sample in the async moving averages, as a shift. */
+#define VHOST_ASYNC_EWMA_SHIFT 4
+
 static __rte_always_inline uint16_t
 async_poll_dequeue_completed(struct virtio_net *dev, struct vhost_virtqueue *vq,
 		struct rte_mbuf **pkts, uint16_t count, int16_t dma_id,
@@ -47,6 +55,21 @@ virtio_net_is_inorder(struct virtio_net *dev)
 	return dev->features & (1ULL << VIRTIO_F_IN_ORDER);
 }
 
+/* Mempool registered for the NUMA node of the virtqueue, if any. */
+static __rte_always_inline struct rte_mempool *
+vhost_dequeue_mempool(struct vhost_virtqueue *vq, struct rte_mempool *mbuf_pool)
+{
+	struct rte_mempool *mp;
+
+	if (unlikely(vq->numa_node < 0 || vq->numa_node >= RTE_MAX_NUMA_NODES))
+		return mbuf_pool;
+
+	mp = rte_atomic_load_explicit(&vhost_dequeue_mempools[vq->numa_node],
+			rte_memory_order_acquire);
+
+	return mp != NULL ? mp : mbuf_pool;
+}
+
 static bool
 is_valid_virt_queue_idx(uint32_t idx, int is_tx, uint32_t nr_vring)
 {
@@ -137,6 +160,70 @@ vhost_async_dma_transfer_one(struct virtio_net *dev, struct vhost_virtqueue *vq,
 	return nr_segs;
 }
 
+static __rte_always_inline void
+vhost_async_ewma_update(uint64_t *avg, uint64_t sample)
+{
+	if (unlikely(*avg == 0))
+		*avg = sample;
+	else
+		*avg = *avg - (*avg >> VHOST_ASYNC_EWMA_SHIFT) +
+			(sample >> VHOST_ASYNC_EWMA_SHIFT);
+}
+
+static __rte_always_inline uint32_t
+vhost_async_iter_len(const struct vhost_iov_iter *pkt)
+{
+	uint32_t len = 0;
+	unsigned long i;
+
+	for (i = 0; i < pkt->nr_segs; i++)
+		len += pkt->iov[i].len;
+
+	return len;
+}
+
+/*
+ * Copy a small packet with the CPU rather than with the DMA device
+ * when the DMA completions are slower than the CPU copy would be,
+ * i.e. when the DMA device is backlogged.
+ */
+static __rte_always_inline bool
+vhost_async_cpu_copy_preferred(struct vhost_async *async, uint32_t len)
+{
+	if (len > VHOST_ASYNC_CPU_COPY_MAX_LEN)
+		return false;
+
+	if (++async->dma_probe_cnt >= VHOST_ASYNC_DMA_PROBE_INTERVAL) {
+		async->dma_probe_cnt = 0;
+		return false;
+	}
+
+	return ((async->cpu_cycles_per_kb * len) >> 10) < async->dma_lat_cycles;
+}
+
+static __rte_always_inline void
+vhost_async_cpu_transfer_one(struct virtio_net *dev, struct vhost_virtqueue *vq,
+		uint16_t flag_idx, struct vhost_iov_iter *pkt, uint32_t len)
+	__rte_requires_shared_capability(&vq->access_lock)
+{
+	struct vhost_async *async = vq->async;
+	struct vhost_iovec *iov = pkt->iov;
+	uint64_t start = rte_rdtsc();
+	unsigned long i;
+
+	for (i = 0; i < pkt->nr_segs; i++)
+		rte_memcpy(iov[i].dst_addr, iov[i].src_addr, iov[i].len);
+
+	vhost_async_ewma_update(&async->cpu_cycles_per_kb,
+			((rte_rdtsc() - start) << 10) / RTE_MAX(len, 1U));
+
+	async->pkts_info[flag_idx].dma_tsc = 0;
+	async->pkts_cmpl_flag[flag_idx] = true;
+
+	if (dev->flags & VIRTIO_DEV_STATS_ENABLED)
+		vq->stats.async_cpu_packets++;
+}
+
 static __rte_always_inline uint16_t
 vhost_async_dma_transfer(struct virtio_net *dev, struct vhost_virtqueue *vq,
 		int16_t dma_id, uint16_t vchan_id, uint16_t head_idx,
@@ -144,18 +231,45 @@ vhost_async_dma_transfer(struct virtio_net *dev, struct vhost_virtqueue *vq,
 	__rte_requires_shared_capability(&vq->access_lock)
 {
 	struct async_dma_vchan_info *dma_info = &dma_copy_track[dma_id].vchans[vchan_id];
+	struct vhost_async *async = vq->async;
 	int64_t ret, nr_copies = 0;
+	uint64_t now = 0;
+	uint32_t len = 0;
 	uint16_t pkt_idx;
 
+	if (async->cpu_copy)
+		now = rte_rdtsc();
+
 	rte_spinlock_lock(&dma_info->dma_lock);
 
 	for (pkt_idx = 0; pkt_idx < nr_pkts; pkt_idx++) {
+		if (async->cpu_copy) {
+			len = vhost_async_iter_len(&pkts[pkt_idx]);
+			if (vhost_async_cpu_copy_preferred(async, len)) {
+				vhost_async_cpu_transfer_one(dev, vq, head_idx,
+						&pkts[pkt_idx], len);
+				goto next;
+			}
+		}
+
 		ret = vhost_async_dma_transfer_one(dev, vq, dma_id, vchan_id, head_idx,
 				&pkts[pkt_idx]);
-		if (unlikely(ret < 0))
-			break;
+		if (unlikely(ret < 0)) {
+			/* DMA ring full, copy the small packets with the CPU */
+			if (!async->cpu_copy || len > VHOST_ASYNC_CPU_COPY_MAX_LEN)
+				break;
+			vhost_async_cpu_transfer_one(dev, vq, head_idx,
+					&pkts[pkt_idx], len);
+			if (dev->flags & VIRTIO_DEV_STATS_ENABLED)
+				vq->stats.async_dma_full++;
+			goto next;
+		}
 
+		async->pkts_info[head_idx].dma_tsc = now;
+		if (dev->flags & VIRTIO_DEV_STATS_ENABLED)
+			vq->stats.async_dma_packets++;
 		nr_copies += ret;
+next:
 		head_idx++;
 		if (head_idx >= vq->size)
 			head_idx -= vq->size;
@@ -169,6 +283,31 @@ vhost_async_dma_transfer(struct virtio_net *dev, struct vhost_virtqueue *vq,
 	return pkt_idx;
 }
 
+/* Sample the DMA completion latency of the completed packets. */
+static __rte_always_inline void
+vhost_async_dma_latency_update(struct virtio_net *dev, struct vhost_virtqueue *vq,
+		uint16_t start_idx, uint16_t nr_cpl_pkts)
+	__rte_requires_shared_capability(&vq->access_lock)
+{
+	struct vhost_async *async = vq->async;
+	uint64_t now;
+	uint16_t i, from;
+
+	if (!async->cpu_copy)
+		return;
+
+	now = rte_rdtsc();
+	for (i = 0; i < nr_cpl_pkts; i++) {
+		from = (start_idx + i) % vq->size;
+		if (async->pkts_info[from].dma_tsc != 0)
+			vhost_async_ewma_update(&async->dma_lat_cycles,
+					now - async->pkts_info[from].dma_tsc);
+	}
+
+	if (dev->flags & VIRTIO_DEV_STATS_ENABLED)
+		vq->stats.async_dma_latency = async->dma_lat_cycles;
+}
+
 static __rte_always_inline uint16_t
 vhost_async_dma_check_completed(struct virtio_net *dev, int16_t dma_id, uint16_t vchan_id,
 		uint16_t max_pkts)
@@ -2316,6 +2455,8 @@ vhost_poll_enqueue_completed(struct virtio_net *dev, struct vhost_virtqueue *vq,
 		pkts[i] = pkts_info[from].mbuf;
 	}
 
+	vhost_async_dma_latency_update(dev, vq, start_idx, nr_cpl_pkts);
+
 	async->pkts_inflight_n -= nr_cpl_pkts;
 
 	if (likely(vq->enabled && vq->access_ok)) {
@@ -3643,6 +3784,8 @@ rte_vhost_dequeue_burst(int vid, uint16_t queue_id,
 		goto out_no_unlock;
 	}
 
+	mbuf_pool = vhost_dequeue_mempool(vq, mbuf_pool);
+
 	/*
 	 * Construct a RARP broadcast packet, and inject it to the "pkts"
 	 * array, to looks like that guest actually send such packet.
@@ -3735,6 +3878,8 @@ async_poll_dequeue_completed(struct virtio_net *dev, struct vhost_virtqueue *vq,
 					      legacy_ol_flags);
 	}
 
+	vhost_async_dma_latency_update(dev, vq, start_idx, nr_cpl_pkts);
+
 	/* write back completed descs to used ring and update used idx */
 	if (vq_is_packed(dev)) {
 		write_back_completed_descs_packed(vq, nr_cpl_pkts);
@@ -4272,6 +4417,8 @@ rte_vhost_async_try_dequeue_burst(int vid, uint16_t queue_id,
 		goto out_no_unlock;
 	}
 
+	mbuf_pool = vhost_dequeue_mempool(vq, mbuf_pool);
+
 	/*
 	 * Construct a RARP broadcast packet, and inject it to the "pkts"
 	 * array, to looks like that guest actually send such packet.
@@ -5,6 +5,8 @@
 """
 Parse the mbuf history dump generated by rte_mbuf_history_dump()
 and related functions, and present it in a human-readable format.
+The sampled trace dumped by rte_mbuf_history_trace_dump() is parsed
+to report the dwell time between the stages and the likely leaked mbufs.
 """
 
 import argparse
@@ -19,6 +21,11 @@
 HEADER_FILE = os.path.join(
     os.path.dirname(os.path.dirname(__file__)), "lib/mbuf/rte_mbuf_history.h"
 )
+TRACE_HEADER = "mbuf history trace:"
+# Operations below are free, the others mean the mbuf is allocated.
+FIRST_ALLOCATED_OP = 4
+# Operations whose context is the port and queue.
+QUEUE_OPS = ("RX", "TX", "TX_PREP", "TX_BUSY")
 
 
 def print_history_sequence(address: str, sequence: list[str]):
@@ -130,6 +137,104 @@ def _parse(self, history: int) -> list[str]:
         return ops
 
 
+class TraceRecord:
+    def __init__(self, lcore: int, tsc: int, address: str, op, ctx: int):
+        self.lcore = lcore
+        self.tsc = tsc
+        self.address = address
+        self.op = op
+        self.ctx = ctx
+
+    def stage(self) -> str:
+        name = self.op.name.replace("HISTORY_OP_", "")
+        if name in QUEUE_OPS:
+            return f"{name} {self.ctx >> 16}/{self.ctx & 0xFFFF}"
+        if self.ctx != 0:
+            return f"{name} {self.ctx:#x}"
+        return name
+
+    def allocated(self) -> bool:
+        return self.op.value >= FIRST_ALLOCATED_OP
+
+
+class TraceParser:
+    def __init__(self):
+        self.history_enum = HistoryEnum.from_header(HEADER_FILE)
+
+    def parse(self, dump_file: str) -> tuple[int, list[TraceRecord]]:
+        # Parse the format "trace <lcore> <tsc> <mbuf> <op> <ctx>"
+        hz = 0
+        records = []
+        with open(dump_file, "r") as f:
+            for line in f:
+                if line.startswith(TRACE_HEADER):
+                    hz = int(line.split("tsc hz")[1])
+                    continue
+                fields = line.split()
+                if len(fields) != 6 or fields[0] != "trace":
+                    continue
+                records.append(
+                    TraceRecord(
+                        lcore=int(fields[1]),
+                        tsc=int(fields[2]),
+                        address=fields[3],
+                        op=self.history_enum.ops(int(fields[4])),
+                        ctx=int(fields[5], 16),
+                    )
+                )
+        records.sort(key=lambda rec: rec.tsc)
+        return hz, records
+
+
+def percentile(values: list[float], ratio: float) -> float:
+    return values[min(len(values) - 1, int(ratio * len(values)))]
+
+
+def print_trace(hz: int, records: list[TraceRecord], leak_age: float):
+    if hz == 0 or not records:
+        print("No trace records")
+        return
+
+    paths = {}
+    for rec in records:
+        paths.setdefault(rec.address, []).append(rec)
+
+    # The time spent in the pool, from a free to an allocation, is not dwell time.
+    dwells = {}
+    for path in paths.values():
+        for prev, cur in zip(path, path[1:]):
+            if not prev.allocated():
+                continue
+            key = (prev.stage(), cur.stage())
+            dwells.setdefault(key, []).append((cur.tsc - prev.tsc) * 1e6 / hz)
+
+    print("=== Dwell Time (us) ===")
+    print(f"{'from':<24} {'to':<24} {'count':>8} {'avg':>10} {'p99':>10} {'max':>10}")
+    for (src, dst), values in sorted(dwells.items()):
+        values.sort()
+        print(
+            f"{src:<24} {dst:<24} {len(values):>8} "
+            f"{sum(values) / len(values):>10.2f} "
+            f"{percentile(values, 0.99):>10.2f} {values[-1]:>10.2f}"
+        )
+
+    end_tsc = records[-1].tsc
+    print()
+    print(f"=== Leaks (allocated for more than {leak_age} s) ===")
+    for address, path in paths.items():
+        last = path[-1]
+        age = (end_tsc - last.tsc) / hz
+        if not last.allocated() or age < leak_age:
+            continue
+        stages = " -> ".join(rec.stage() for rec in path[-8:])
+        print(f"mbuf {address}: {RED}{age:.3f} s{RESET} on lcore {last.lcore}: {stages}")
+
+
+def is_trace(dump_file: str) -> bool:
+    with open(dump_file, "r") as f:
+        return any(line.startswith(TRACE_HEADER) for line in f)
+
+
 def print_history_lines(history_lines: list[HistoryLine]):
     lines = [(line.address, line.repeats()) for line in history_lines]
 
@@ -151,8 +256,16 @@ def print_metrics(metrics: HistoryMetrics):
 def main():
     parser = argparse.ArgumentParser(description=__doc__)
     parser.add_argument('history_file')
+    parser.add_argument('--leak-age', type=float, default=1.0,
+                        help='seconds after the last operation of an allocated mbuf '
+                        'to report it as leaked in a trace (default: %(default)s)')
     args = parser.parse_args()
 
+    if is_trace(args.history_file):
+        hz, records = TraceParser().parse(args.history_file)
+        print_trace(hz, records, args.leak_age)
+        return
+
     history_parser = HistoryParser()
     history_lines, metrics = history_parser.parse(args.history_file)
 
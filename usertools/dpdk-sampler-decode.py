@@ -0,0 +1,87 @@
+#! /usr/bin/env python3
+# SPDX-License-Identifier: BSD-3-Clause
+# Copyright(c) 2024 Intel Corporation
+
+"""
+Convert segment files written by the sampler binary sink to CSV.
+"""
+
+import argparse
+import csv
+import struct
+import sys
+
+MAGIC = b"DPDKSMPL"
+VERSION = 1
+# struct rte_sampler_binary_header
+HEADER = struct.Struct("=8sIIQQQQH6x64s")
+# struct rte_sampler_binary_column, RTE_SAMPLER_XSTATS_NAME_SIZE is 128
+COLUMN = struct.Struct("=Q128s")
+
+
+def cstr(raw):
+    """Decode a NUL terminated string"""
+    return raw.split(b"\0", 1)[0].decode(errors="replace")
+
+
+def decode_segment(path, writer, header_written, seconds):
+    """Write the rows of one segment, return the column names"""
+    with open(path, "rb") as f:
+        data = f.read()
+
+    (magic, version, num_columns, row_size, data_offset, num_rows,
+     tsc_hz, source_id, source_name) = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        sys.exit("{}: not a sampler binary segment".format(path))
+    if version != VERSION:
+        sys.exit("{}: unsupported segment version {}".format(path, version))
+
+    names = []
+    for i in range(num_columns):
+        _, name = COLUMN.unpack_from(data, HEADER.size + i * COLUMN.size)
+        names.append(cstr(name))
+
+    if not header_written:
+        writer.writerow(["timestamp", "source_name", "source_id"] + names)
+
+    # rows of a truncated or still open segment are bounded by the file size
+    num_rows = min(num_rows, (len(data) - data_offset) // row_size)
+    row = struct.Struct("={}Q".format(num_columns + 1))
+    name = cstr(source_name)
+    for i in range(num_rows):
+        values = row.unpack_from(data, data_offset + i * row_size)
+        tsc = values[0]
+        timestamp = "{:.9f}".format(tsc / tsc_hz) if seconds and tsc_hz else tsc
+        writer.writerow([timestamp, name, source_id] + list(values[1:]))
+
+    return names
+
+
+def main():
+    """Parse arguments and convert segments"""
+    parser = argparse.ArgumentParser(
+        description="Convert sampler binary sink segments to CSV")
+    parser.add_argument("segments", nargs="+",
+                        help="segment files of one source, in order")
+    parser.add_argument("-o", "--output", default="-",
+                        help="output CSV file (default: stdout)")
+    parser.add_argument("-s", "--seconds", action="store_true",
+                        help="print timestamps in seconds instead of TSC cycles")
+    args = parser.parse_args()
+
+    out = sys.stdout if args.output == "-" else open(args.output, "w", newline="")
+    writer = csv.writer(out)
+    columns = None
+    for path in args.segments:
+        names = decode_segment(path, writer, columns is not None, args.seconds)
+        if columns is not None and names != columns:
+            print("{}: columns changed, new header written".format(path),
+                  file=sys.stderr)
+            writer.writerow(["timestamp", "source_name", "source_id"] + names)
+        columns = names
+    if out is not sys.stdout:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()